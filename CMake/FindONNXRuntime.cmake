@@ -0,0 +1,70 @@
+# - Find ONNX Runtime
+# ONNX Runtime is an inference engine for models in the ONNX format
+# available at https://onnxruntime.ai/
+#
+# The module defines the following variables:
+#  ONNXRUNTIME_FOUND - the system has ONNX Runtime
+#  ONNXRUNTIME_INCLUDE_DIR - where to find onnxruntime_cxx_api.h
+#  ONNXRUNTIME_LIBRARY - where to find the ONNX Runtime library
+#  ONNXRUNTIME_VERSION_STRING - version (ex. 1.14.1), if known
+#
+# The C++ API of version 1.13 or later is required.
+
+#
+# Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+find_path( ONNXRUNTIME_INCLUDE_DIR
+  NAMES
+    onnxruntime_cxx_api.h
+  PATH_SUFFIXES
+    onnxruntime
+    onnxruntime/core/session
+  DOC
+    "ONNX Runtime include directory"
+)
+
+find_library( ONNXRUNTIME_LIBRARY
+  NAMES
+    onnxruntime
+  DOC
+    "ONNX Runtime library location"
+)
+
+set( _VERSION_FILE ${ONNXRUNTIME_INCLUDE_DIR}/onnxruntime_c_api.h )
+if( EXISTS ${_VERSION_FILE} )
+  file( STRINGS ${_VERSION_FILE} _API_VERSION_STRING REGEX "^#define ORT_API_VERSION [0-9]+" )
+  if( _API_VERSION_STRING )
+    # ORT_API_VERSION is the minor version of the release
+    string( REGEX REPLACE ".*ORT_API_VERSION ([0-9]+).*" "\\1" ONNXRUNTIME_API_VERSION "${_API_VERSION_STRING}" )
+    set( ONNXRUNTIME_VERSION_STRING "1.${ONNXRUNTIME_API_VERSION}" )
+  endif()
+endif()
+
+include( FindPackageHandleStandardArgs )
+find_package_handle_standard_args( ONNXRuntime
+  REQUIRED_VARS ONNXRUNTIME_LIBRARY ONNXRUNTIME_INCLUDE_DIR
+  VERSION_VAR ONNXRUNTIME_VERSION_STRING )
+
+mark_as_advanced(
+  ONNXRUNTIME_INCLUDE_DIR
+  ONNXRUNTIME_LIBRARY
+  ONNXRUNTIME_API_VERSION
+  ONNXRUNTIME_VERSION_STRING
+)
@@ -50,6 +50,9 @@ endif()
 if(NOT OTB_USE_LIBSVM)
 	SET(BANNED_HEADERS "${BANNED_HEADERS} otbLibSVMMachineLearningModel.h otbLibSVMMachineLearningModelFactory.h")
 endif()
+if(NOT OTB_USE_ONNXRUNTIME)
+  SET(BANNED_HEADERS "${BANNED_HEADERS} otbONNXMachineLearningModel.h otbONNXMachineLearningModelFactory.h")
+endif()
 
 if(NOT OTB_USE_SIFTFAST)
   SET(BANNED_HEADERS "${BANNED_HEADERS} otbSiftFastImageFilter.h")
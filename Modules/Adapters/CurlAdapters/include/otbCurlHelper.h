@@ -59,18 +59,40 @@ public:
 
   int RetrieveUrlInMemory(const std::string& urlString, std::string& output) const override;
 
+  /** Download each url of listURLs to the file of listFiles with the
+   * same position, running up to maxConnect transfers in parallel.
+   *
+   * Data is first written to "<file>.part", which is renamed once the
+   * transfer succeeds: an interrupted transfer is resumed from the end
+   * of its partial file, by the next attempt or the next call. Failed
+   * transfers are attempted again NumberOfRetries times, except when the
+   * server answers that the file does not exist. When SkipExistingFiles
+   * is on, the files already present are not downloaded again.
+   *
+   * Returns the number of files that could not be retrieved. */
   int RetrieveFileMulti(const std::vector<std::string>& listURLs, const std::vector<std::string>& listFiles, int maxConnect) const override;
 
   itkGetMacro(Timeout, long int);
 
   itkSetMacro(Timeout, long int);
 
+  /** Number of new attempts of a failed transfer in RetrieveFileMulti */
+  itkGetMacro(NumberOfRetries, unsigned int);
+  itkSetMacro(NumberOfRetries, unsigned int);
+
+  /** Skip the files already downloaded in RetrieveFileMulti (on by default) */
+  itkGetMacro(SkipExistingFiles, bool);
+  itkSetMacro(SkipExistingFiles, bool);
+  itkBooleanMacro(SkipExistingFiles);
+
 protected:
   CurlHelper()
     : m_Browser(
           "Mozilla/5.0 (Windows; U; Windows NT 6.0; en-GB; rv:1.8.1.11) "
           "Gecko/20071127 Firefox/2.0.0.11"),
-      m_Timeout(10)
+      m_Timeout(10),
+      m_NumberOfRetries(3),
+      m_SkipExistingFiles(true)
   {
   }
   ~CurlHelper() override
@@ -93,6 +115,9 @@ private:
   // Browser Agent used
   std::string m_Browser;
   long int    m_Timeout;
+
+  unsigned int m_NumberOfRetries;
+  bool         m_SkipExistingFiles;
 };
 }
 #endif
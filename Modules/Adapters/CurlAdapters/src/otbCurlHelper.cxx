@@ -21,8 +21,11 @@
 
 #include <cstdio>
 #include <cstring>
+#include <deque>
+#include <memory>
 #include <sstream>
 #include <itkLightObject.h>
+#include "itksys/SystemTools.hxx"
 #include "otbConfigure.h" // for OTB_USE_CURL
 #include "otbMacro.h"
 #include "otbCurlHelper.h"
@@ -206,6 +209,69 @@ private:
   CurlFileDescriptorResource& operator=(const CurlFileDescriptorResource&) = delete;
 }; // end of class FileResource
 
+/**
+ * State of one transfer of RetrieveFileMulti: the data is written to a
+ * partial file, which is renamed to the destination file on success
+ */
+struct CurlTransfer
+{
+  std::string           Url;
+  std::string           FileName;
+  std::string           PartFileName;
+  CurlResource::Pointer Curl;
+  FILE*                 File       = nullptr;
+  curl_off_t            ResumeFrom = 0;
+  bool                  FirstWrite = true;
+  unsigned int          Attempts   = 0;
+
+  ~CurlTransfer()
+  {
+    CloseFile();
+  }
+
+  void CloseFile()
+  {
+    if (File != nullptr)
+    {
+      fclose(File);
+      File = nullptr;
+    }
+  }
+
+  long GetResponseCode() const
+  {
+    long code = 0;
+    if (Curl.IsNotNull())
+    {
+      curl_easy_getinfo(Curl->GetCurlResource(), CURLINFO_RESPONSE_CODE, &code);
+    }
+    return code;
+  }
+};
+
+// Write callback of RetrieveFileMulti. When a resumed transfer is
+// answered with the whole file, the partial file is written again from
+// its start
+static size_t CallbackWriteDataToTransfer(void* ptr, size_t size, size_t nmemb, void* data)
+{
+  CurlTransfer* transfer = static_cast<CurlTransfer*>(data);
+  if (transfer->FirstWrite)
+  {
+    transfer->FirstWrite = false;
+    if (transfer->ResumeFrom > 0 && transfer->GetResponseCode() == 200)
+    {
+      transfer->CloseFile();
+      transfer->File       = fopen(transfer->PartFileName.c_str(), "wb");
+      transfer->ResumeFrom = 0;
+    }
+  }
+  if (transfer->File == nullptr)
+  {
+    return 0;
+  }
+  return fwrite(ptr, size, nmemb, transfer->File);
+}
+
 #endif // OTB_USE_CURL
 
 bool CurlHelper::TestUrlAvailability(const std::string& url) const
@@ -362,150 +428,166 @@ int CurlHelper::RetrieveFile(const std::string& urlString, std::string filename)
 
 int CurlHelper::RetrieveFileMulti(const std::vector<std::string>& listURLs, const std::vector<std::string>& listFilename, int maxConnect) const
 {
-
 #ifdef OTB_USE_CURL
-#if 0
-//#ifdef OTB_CURL_MULTI_AVAILABLE
-  otbMsgDevMacro(<< "Using curl multi");
-
-  // Initialize curl handle resource
-  CurlMultiResource::Pointer  multiHandle = CurlMultiResource::New();
+  std::vector<std::unique_ptr<CurlTransfer>> transfers;
+  std::deque<CurlTransfer*>                  queue;
 
-  std::vector<CurlResource::Pointer> listCurlHandles;
-  std::vector<CurlFileDescriptorResource::Pointer> listFiles;
-
-  std::vector<std::string>::const_iterator filename;
-  filename = listFilename.begin();
-  while (filename != listFilename.end())
+  std::vector<std::string>::const_iterator url  = listURLs.begin();
+  std::vector<std::string>::const_iterator file = listFilename.begin();
+  for (; url != listURLs.end() && file != listFilename.end(); ++url, ++file)
+  {
+    // Local cache check
+    if (m_SkipExistingFiles && itksys::SystemTools::FileExists(*file, true) && itksys::SystemTools::FileLength(*file) > 0)
     {
-    CurlFileDescriptorResource::Pointer lOutputFile = CurlFileDescriptorResource::New();
-    lOutputFile->OpenFile((*filename).c_str());
-
-    // Add file to vector
-    listFiles.push_back(lOutputFile);
-    ++filename;
+      otbMsgDevMacro(<< "File " << *file << " already downloaded, skipping " << *url);
+      continue;
     }
+    std::unique_ptr<CurlTransfer> transfer(new CurlTransfer);
+    transfer->Url          = *url;
+    transfer->FileName     = *file;
+    transfer->PartFileName = *file + ".part";
+    queue.push_back(transfer.get());
+    transfers.push_back(std::move(transfer));
+  }
 
-  listCurlHandles.clear();
-
-  std::vector<std::string>::const_iterator url;
-  std::vector<CurlFileDescriptorResource::Pointer>::const_iterator      file;
-  url = listURLs.begin();
-  file = listFiles.begin();
-  while ((url != listURLs.end()) && (file != listFiles.end()))
+  // Prepare a transfer, resuming it from its partial file if any
+  auto start = [this](CurlTransfer& transfer) {
+    transfer.CloseFile();
+    transfer.ResumeFrom = 0;
+    if (itksys::SystemTools::FileExists(transfer.PartFileName, true))
     {
-    otbMsgDevMacro(<< "Retrieving: " << (*url).data());
-    CurlResource::Pointer lEasyHandle = CurlResource::New();
-
-    // Param easy handle
-    CurlHandleError::ProcessCURLcode(curl_easy_setopt(lEasyHandle->GetCurlResource(), CURLOPT_USERAGENT, m_Browser.data()));
-    CurlHandleError::ProcessCURLcode(curl_easy_setopt(lEasyHandle->GetCurlResource(), CURLOPT_URL, (*url).data()));
-    CurlHandleError::ProcessCURLcode(curl_easy_setopt(lEasyHandle->GetCurlResource(), CURLOPT_WRITEFUNCTION,
-                                 &Self::CallbackWriteDataToFile));
-    CurlHandleError::ProcessCURLcode(curl_easy_setopt(lEasyHandle->GetCurlResource(), CURLOPT_WRITEDATA,
-                                 (void*) (*file)->GetFileResource()));
-
-    // Add easy handle to multi handle
-    CurlHandleError::ProcessCURLcode(curl_multi_add_handle(multiHandle->GetCurlMultiResource(), lEasyHandle->GetCurlResource()));
-
-    // Add handle to vector
-    listCurlHandles.push_back(lEasyHandle);
-    ++url;
-    ++file;
+      transfer.ResumeFrom = static_cast<curl_off_t>(itksys::SystemTools::FileLength(transfer.PartFileName));
     }
-
-  //fetch tiles
-  // Configure multi handle - set the maximum connections
-  CurlHandleError::ProcessCURLcode(curl_multi_setopt(multiHandle->GetCurlMultiResource(), CURLMOPT_MAXCONNECTS, maxConnect));
-  CurlHandleError::ProcessCURLcode(curl_multi_setopt(multiHandle->GetCurlMultiResource(), CURLMOPT_PIPELINING, 0));
-
-  // Perform
-  int lStillRunning;
-
-  while (CURLM_CALL_MULTI_PERFORM == curl_multi_perform(multiHandle->GetCurlMultiResource(), &lStillRunning));
-
-  // Now get that URL
-  while (lStillRunning)
+    transfer.File = fopen(transfer.PartFileName.c_str(), transfer.ResumeFrom > 0 ? "ab" : "wb");
+    if (transfer.File == nullptr)
     {
-    struct timeval timeout;
-    int            rc; // Return code
-
-    fd_set fdread;
-    fd_set fdwrite;
-    fd_set fdexcep;
-    int    maxfd;
+      itkExceptionMacro(<< "otbCurlHelper: failed to open the file " << transfer.PartFileName);
+    }
+    transfer.FirstWrite = true;
+    ++transfer.Attempts;
+
+    otbMsgDevMacro(<< "Retrieving ( CurlHelper::RetrieveFileMulti ): " << transfer.Url << " (attempt " << transfer.Attempts << ", from byte "
+                   << transfer.ResumeFrom << ")");
+
+    transfer.Curl = CurlResource::New();
+    CURL* handle  = transfer.Curl->GetCurlResource();
+    CurlHandleError::ProcessCURLcode(curl_easy_setopt(handle, CURLOPT_USERAGENT, m_Browser.data()));
+    CurlHandleError::ProcessCURLcode(curl_easy_setopt(handle, CURLOPT_URL, transfer.Url.c_str()));
+    CurlHandleError::ProcessCURLcode(curl_easy_setopt(handle, CURLOPT_TIMEOUT, m_Timeout));
+    CurlHandleError::ProcessCURLcode(curl_easy_setopt(handle, CURLOPT_NOSIGNAL, 1));
+    CurlHandleError::ProcessCURLcode(curl_easy_setopt(handle, CURLOPT_FAILONERROR, 1));
+    CurlHandleError::ProcessCURLcode(curl_easy_setopt(handle, CURLOPT_WRITEFUNCTION, &CallbackWriteDataToTransfer));
+    CurlHandleError::ProcessCURLcode(curl_easy_setopt(handle, CURLOPT_WRITEDATA, (void*)&transfer));
+    CurlHandleError::ProcessCURLcode(curl_easy_setopt(handle, CURLOPT_PRIVATE, (void*)&transfer));
+    if (transfer.ResumeFrom > 0)
+    {
+      CurlHandleError::ProcessCURLcode(curl_easy_setopt(handle, CURLOPT_RESUME_FROM_LARGE, transfer.ResumeFrom));
+    }
+  };
+
+  // Conclude a transfer: publish the file on success, queue a new attempt
+  // on a transient failure
+  int  failures = 0;
+  auto finish   = [this, &queue, &failures](CurlTransfer& transfer, CURLcode result) {
+    transfer.CloseFile();
+    const long responseCode = transfer.GetResponseCode();
+    if (result == CURLE_OK)
+    {
+      std::remove(transfer.FileName.c_str());
+      if (std::rename(transfer.PartFileName.c_str(), transfer.FileName.c_str()) != 0)
+      {
+        itkExceptionMacro(<< "otbCurlHelper: failed to rename " << transfer.PartFileName << " to " << transfer.FileName);
+      }
+      return;
+    }
 
-    FD_ZERO(&fdread);
-    FD_ZERO(&fdwrite);
-    FD_ZERO(&fdexcep);
+    // A range past the end of the partial file: the next attempt starts
+    // again from scratch
+    if (result == CURLE_RANGE_ERROR || responseCode == 416)
+    {
+      std::remove(transfer.PartFileName.c_str());
+    }
+    // Other client errors (missing file, forbidden access...) are final
+    const bool permanent = responseCode >= 400 && responseCode < 500 && responseCode != 408 && responseCode != 416 && responseCode != 429;
+    if (!permanent && transfer.Attempts <= m_NumberOfRetries)
+    {
+      otbMsgDevMacro(<< "Transfer of " << transfer.Url << " failed (" << curl_easy_strerror(result) << "), trying again");
+      queue.push_back(&transfer);
+      return;
+    }
 
-    /* set a suitable timeout to play around with */
-    timeout.tv_sec = 0;
-    timeout.tv_usec = 1;
+    // Keep a partial file only if some data can be resumed from it
+    if (itksys::SystemTools::FileExists(transfer.PartFileName, true) && itksys::SystemTools::FileLength(transfer.PartFileName) == 0)
+    {
+      std::remove(transfer.PartFileName.c_str());
+    }
+    otbLogMacro(Warning, << "Failed to retrieve " << transfer.Url << " : " << curl_easy_strerror(result));
+    ++failures;
+  };
 
-    /* get file descriptors from the transfers */
-    CurlHandleError::ProcessCURLcode(curl_multi_fdset(multiHandle->GetCurlMultiResource(), &fdread, &fdwrite, &fdexcep, &maxfd));
+#ifdef OTB_CURL_MULTI_AVAILABLE
+  otbMsgDevMacro(<< "Using curl multi");
 
-    rc = select(maxfd + 1, &fdread, &fdwrite, &fdexcep, &timeout);
+  // Declared after the transfers, so that the multi handle is cleaned up
+  // before the easy handles
+  CurlMultiResource::Pointer multiHandle    = CurlMultiResource::New();
+  CURLM*                     multi          = multiHandle->GetCurlMultiResource();
+  const std::size_t          maxConnections = maxConnect > 0 ? static_cast<std::size_t>(maxConnect) : 1;
+  CurlHandleError::ProcessCURLcode(curl_multi_setopt(multi, CURLMOPT_MAXCONNECTS, static_cast<long>(maxConnections)));
 
-    switch (rc)
-      {
-      case -1:
-        /* select error */
-        break;
-      case 0:
-        /* timeout */
-      default:
-        /* timeout or readable/writable sockets */
-        while (CURLM_CALL_MULTI_PERFORM == curl_multi_perform(multiHandle->GetCurlMultiResource(), &lStillRunning));
-        break;
-      }
+  std::size_t running = 0;
+  while (!queue.empty() || running > 0)
+  {
+    while (running < maxConnections && !queue.empty())
+    {
+      CurlTransfer* transfer = queue.front();
+      queue.pop_front();
+      start(*transfer);
+      CurlHandleError::ProcessCURLcode(curl_multi_add_handle(multi, transfer->Curl->GetCurlResource()));
+      ++running;
     }
 
-  int      remaining_msgs = 1;
-  int      error = 0;
-  CURLMsg *msg;
-  while (remaining_msgs)
+    int stillRunning = 0;
+    CurlHandleError::ProcessCURLcode(curl_multi_perform(multi, &stillRunning));
+
+    int      remainingMessages = 0;
+    CURLMsg* msg               = nullptr;
+    while ((msg = curl_multi_info_read(multi, &remainingMessages)) != nullptr)
     {
-    msg = curl_multi_info_read(multiHandle->GetCurlMultiResource(), &remaining_msgs);
-    if (msg != NULL)
+      if (msg->msg != CURLMSG_DONE)
       {
-      if (CURLE_OK != msg->data.result) error = 1;
+        continue;
       }
+      // The message does not survive the removal of its handle
+      CURL*         handle   = msg->easy_handle;
+      CURLcode      result   = msg->data.result;
+      CurlTransfer* transfer = nullptr;
+      curl_easy_getinfo(handle, CURLINFO_PRIVATE, reinterpret_cast<char**>(&transfer));
+      CurlHandleError::ProcessCURLcode(curl_multi_remove_handle(multi, handle));
+      --running;
+      finish(*transfer, result);
     }
 
-  if (error != 0)
+    if (running > 0)
     {
-    itkExceptionMacro(<< "otbCurlHelper: Error occurs while perform Multi handle");
+      CurlHandleError::ProcessCURLcode(curl_multi_wait(multi, nullptr, 0, 1000, nullptr));
     }
-
-  // Cleanup
-  listFiles.clear();
-  listCurlHandles.clear();
-
-  return 0;
+  }
 #else
   (void)maxConnect;
   // fallback on non curl multi
   otbMsgDevMacro(<< "Curl multi is not available, fallback on standard");
 
-  std::vector<std::string>::const_iterator url;
-  std::vector<std::string>::const_iterator file;
-  url        = listURLs.begin();
-  file       = listFilename.begin();
-  int res    = 0;
-  int resTmp = -1;
-  while ((url != listURLs.end()) && (file != listFilename.end()))
+  while (!queue.empty())
   {
-    resTmp = RetrieveFile(*url, *file);
-    if (res == 0)
-      res = resTmp;
-    ++url;
-    ++file;
+    CurlTransfer* transfer = queue.front();
+    queue.pop_front();
+    start(*transfer);
+    finish(*transfer, curl_easy_perform(transfer->Curl->GetCurlResource()));
   }
-
-  return res;
 #endif
+
+  return failures;
 #else
   (void)maxConnect;
   (void)listURLs;
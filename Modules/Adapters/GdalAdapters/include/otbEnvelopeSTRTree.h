@@ -0,0 +1,194 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbEnvelopeSTRTree_h
+#define otbEnvelopeSTRTree_h
+
+#include "ogr_core.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace otb
+{
+
+/** \class EnvelopeSTRTree
+ *  \brief Static R-tree of envelopes, packed with the Sort-Tile-Recursive algorithm.
+ *
+ *  Items (integer identifiers) are inserted with their envelope, then
+ *  Build() packs the tree once. The tree can not be modified after it is
+ *  built, except by clearing it.
+ *
+ * \ingroup OTBGdalAdapters
+ */
+class EnvelopeSTRTree
+{
+public:
+  typedef std::size_t           ItemType;
+  typedef std::vector<ItemType> ItemListType;
+
+  explicit EnvelopeSTRTree(std::size_t nodeCapacity = 8) : m_NodeCapacity(std::max<std::size_t>(2, nodeCapacity))
+  {
+  }
+
+  /** Adds an item. Must be called before Build(). */
+  void Insert(const OGREnvelope& envelope, ItemType item)
+  {
+    Entry entry;
+    entry.envelope = envelope;
+    entry.first    = item;
+    entry.count    = 0;
+    m_Items.push_back(entry);
+    m_Levels.clear();
+  }
+
+  /** Packs the inserted items */
+  void Build()
+  {
+    m_Levels.clear();
+    if (m_Items.empty())
+    {
+      return;
+    }
+
+    m_Levels.push_back(Pack(m_Items));
+    while (m_Levels.back().size() > 1)
+    {
+      std::vector<Entry> upper = Pack(m_Levels.back());
+      m_Levels.push_back(upper);
+    }
+  }
+
+  /** Items whose envelope intersects envelope (borders included), sorted */
+  ItemListType Query(const OGREnvelope& envelope) const
+  {
+    ItemListType result;
+    if (m_Levels.empty())
+    {
+      return result;
+    }
+
+    // Pending nodes, as (level, index) pairs
+    std::vector<std::pair<std::size_t, std::size_t>> stack;
+    for (std::size_t i = 0; i < m_Levels.back().size(); ++i)
+    {
+      stack.push_back(std::make_pair(m_Levels.size() - 1, i));
+    }
+
+    while (!stack.empty())
+    {
+      const std::size_t level = stack.back().first;
+      const Entry&      node  = m_Levels[level][stack.back().second];
+      stack.pop_back();
+
+      if (!node.envelope.Intersects(envelope))
+      {
+        continue;
+      }
+
+      for (std::size_t child = node.first; child < node.first + node.count; ++child)
+      {
+        if (level == 0)
+        {
+          if (m_Items[child].envelope.Intersects(envelope))
+          {
+            result.push_back(m_Items[child].first);
+          }
+        }
+        else
+        {
+          stack.push_back(std::make_pair(level - 1, child));
+        }
+      }
+    }
+
+    std::sort(result.begin(), result.end());
+    return result;
+  }
+
+  std::size_t GetNumberOfItems() const
+  {
+    return m_Items.size();
+  }
+
+  void Clear()
+  {
+    m_Items.clear();
+    m_Levels.clear();
+  }
+
+private:
+  /** Item (with count = 0) or node covering the children [first, first + count)
+   * of the level below */
+  struct Entry
+  {
+    OGREnvelope envelope;
+    std::size_t first;
+    std::size_t count;
+  };
+
+  static double CenterX(const Entry& entry)
+  {
+    return 0.5 * (entry.envelope.MinX + entry.envelope.MaxX);
+  }
+  static double CenterY(const Entry& entry)
+  {
+    return 0.5 * (entry.envelope.MinY + entry.envelope.MaxY);
+  }
+
+  /** Sorts entries in STR order (vertical slices of nodes sorted along x, then
+   * along y within each slice) and returns the nodes grouping them */
+  std::vector<Entry> Pack(std::vector<Entry>& entries) const
+  {
+    const std::size_t nbNodes   = (entries.size() + m_NodeCapacity - 1) / m_NodeCapacity;
+    const std::size_t nbSlices  = static_cast<std::size_t>(std::ceil(std::sqrt(static_cast<double>(nbNodes))));
+    const std::size_t sliceSize = nbSlices * m_NodeCapacity;
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return CenterX(a) < CenterX(b); });
+    for (std::size_t start = 0; start < entries.size(); start += sliceSize)
+    {
+      const std::size_t stop = std::min(start + sliceSize, entries.size());
+      std::sort(entries.begin() + start, entries.begin() + stop, [](const Entry& a, const Entry& b) { return CenterY(a) < CenterY(b); });
+    }
+
+    std::vector<Entry> nodes(nbNodes);
+    for (std::size_t n = 0; n < nbNodes; ++n)
+    {
+      Entry& node   = nodes[n];
+      node.first    = n * m_NodeCapacity;
+      node.count    = std::min(m_NodeCapacity, entries.size() - node.first);
+      node.envelope = entries[node.first].envelope;
+      for (std::size_t child = node.first + 1; child < node.first + node.count; ++child)
+      {
+        node.envelope.Merge(entries[child].envelope);
+      }
+    }
+    return nodes;
+  }
+
+  std::size_t                     m_NodeCapacity;
+  std::vector<Entry>              m_Items;
+  std::vector<std::vector<Entry>> m_Levels;
+};
+
+} // end namespace otb
+
+#endif
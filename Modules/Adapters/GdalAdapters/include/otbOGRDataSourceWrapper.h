@@ -154,6 +154,8 @@ public:
    * \throw itk::ExceptionObject if the inner \c GDALDataset cannot be
    * opened.
    * \note \c OGRRegisterAll() is implicitly called on construction
+   * \note Names starting with "memory:" designate in-memory data sources
+   * shared by the whole process, see \c IsInMemoryName().
    * \see \c DataSource(GDALDataset *)
    */
   static Pointer New(std::string const& datasourcename, Modes::type mode = Modes::Read);
@@ -171,6 +173,33 @@ public:
   static Pointer New(GDALDataset* sourcemode, Modes::type mode = Modes::Read, const std::vector<std::string>& layerOptions = std::vector<std::string>());
 //@}
 
+  /**\name In-memory data sources shared by name
+   * A data source named "memory:<name>" is not a file: it is kept in
+   * memory by the process, so that chained applications can exchange
+   * vector data without writing intermediate files. \c New() in \c
+   * Overwrite mode creates an empty in-memory data source under this name
+   * (replacing the previous one), the other modes return the data source
+   * registered under this name (in update modes, an empty one is created
+   * if needed). The data source is kept alive until it is released, and
+   * written to a file only when \c SaveInMemory() is called.
+   */
+  //@{
+  /** Tells whether a data source name designates an in-memory data source */
+  static bool IsInMemoryName(std::string const& datasourceName);
+
+  /** Writes all the layers of an in-memory data source to a file
+   * \throw itk::ExceptionObject if no data source is registered under this
+   * name, or if the file cannot be written.
+   */
+  static void SaveInMemory(std::string const& datasourceName, std::string const& fileName);
+
+  /** Releases the in-memory data source registered under this name */
+  static void ReleaseInMemory(std::string const& datasourceName);
+
+  /** Releases all the in-memory data sources */
+  static void ReleaseAllInMemory();
+  //@}
+
 /**\name Projection Reference property */
 //@{
 #if 0
@@ -530,6 +559,10 @@ protected:
 
   static Pointer OpenDataSource(std::string const& datasourceName, Modes::type mode);
 
+  /** Returns the in-memory data source registered under this name, created
+   * according to the mode */
+  static Pointer OpenInMemoryDataSource(std::string const& datasourceName, Modes::type mode);
+
   /** Prints self into stream. */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -558,11 +591,19 @@ private:
   /** Get a string describing the dataset */
   std::string GetDatasetDescription() const;
 
+  /** Create a layer, deferring the creation of its spatial index when the
+   * driver maintains it on each insertion (GPKG) */
+  OGRLayer* CreateOGRLayer(std::string const& name, OGRSpatialReference* poSpatialRef, OGRwkbGeometryType eGType, std::vector<std::string> layerOptions);
+
+  /** Build the spatial indexes deferred by CreateOGRLayer() */
+  void BuildDeferredSpatialIndexes();
+
 private:
   GDALDataset*             m_DataSource;
   std::vector<std::string> m_LayerOptions;
   Modes::type              m_OpenMode;
   int                      m_FirstModifiableLayerID;
+  std::vector<std::string> m_DeferredSpatialIndexes;
 }; // end class DataSource
 }
 } // end namespace otb::ogr
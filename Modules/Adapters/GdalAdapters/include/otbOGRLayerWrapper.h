@@ -152,6 +152,54 @@ public:
    */
   void CreateFeature(Feature feature);
 
+  /**
+   * Adds a range of features to the layer.
+   * \param[in] first, last  range of \c Feature to add.
+   * \param[in] transactionSize  number of features written by each
+   * transaction, 0 for automatic.
+   *
+   * Unless the caller has already started a transaction on the layer, the
+   * features are written by transactions of \c transactionSize features,
+   * which avoids both the per-feature commits of the transactional drivers
+   * and an ever growing journal.
+   *
+   * \throw itk::ExceptionObject if a feature can't be added. The pending
+   * transaction is then rolled back.
+   */
+  template <class InputIterator>
+  void CreateFeatures(InputIterator first, InputIterator last, size_t transactionSize = 0)
+  {
+    const bool ownsTransaction = StartBatchTransaction();
+    if (transactionSize == 0)
+    {
+      transactionSize = GetDefaultTransactionSize();
+    }
+    try
+    {
+      for (size_t count = 1; first != last; ++first, ++count)
+      {
+        CreateFeature(*first);
+        if (ownsTransaction && count % transactionSize == 0)
+        {
+          EndBatchTransaction(true);
+          StartBatchTransaction();
+        }
+      }
+    }
+    catch (...)
+    {
+      if (ownsTransaction)
+      {
+        EndBatchTransaction(false);
+      }
+      throw;
+    }
+    if (ownsTransaction)
+    {
+      EndBatchTransaction(true);
+    }
+  }
+
   /**
    * Removes a feature identified by its id from the \c Layer.
    * \param[in] nFID  feature id.
@@ -561,6 +609,16 @@ private:
    */
   Feature GetNextFeature();
 
+  /** Starts a transaction for CreateFeatures(), and returns whether it
+   * succeeded, i.e. whether none was already started */
+  bool StartBatchTransaction();
+
+  /** Commits or rolls back the transaction started by CreateFeatures() */
+  void EndBatchTransaction(bool commit);
+
+  /** Transaction size for the driver of the layer */
+  size_t GetDefaultTransactionSize() const;
+
   /** Data implementation.
    * \internal
    * The actual %layer implementation belongs to the \c otb::Layer object,
@@ -25,6 +25,9 @@
 #include <numeric>
 #include <algorithm>
 #include <clocale> // toupper
+#include <map>
+#include <mutex>
+#include <sstream>
 // ITK includes
 #include "itkMacro.h" // itkExceptionMacro
 #include "itkExceptionObject.h"
@@ -51,6 +54,7 @@ void otb::ogr::DataSource::Reset(GDALDataset* source)
     // OGR makes a pointless check for non-nullity in
     // GDALDataset::DestroyDataSource (pointless because "delete 0" is
     // perfectly valid -> it's a no-op)
+    BuildDeferredSpatialIndexes();
     GDALClose(m_DataSource); // void, noexcept
   }
   m_DataSource = source;
@@ -77,7 +81,8 @@ struct ExtensionDriverAssociation
  */
 const ExtensionDriverAssociation k_ExtensionDriverMap[] = {
     {".SHP", "ESRI Shapefile"}, {".TAB", "MapInfo File"}, {".GML", "GML"}, {".GMT", "OGR_GMT"}, {".GPX", "GPX"},
-    {".SQLITE", "SQLite"},      {".KML", "KML"},          {".CSV", "CSV"}, {".GPKG", "GPKG"}};
+    {".SQLITE", "SQLite"},      {".KML", "KML"},          {".CSV", "CSV"}, {".GPKG", "GPKG"}, {".FGB", "FlatGeobuf"},
+    {".PARQUET", "Parquet"}};
 /**\ingroup GeometryInternals
  * \brief Returns the OGR driver name associated to a filename.
  * \since OTB v 3.14.0
@@ -102,6 +107,26 @@ char const* DeduceDriverName(std::string filename)
   }
   return whichIt->driverName;
 }
+
+/**\ingroup GeometryInternals
+ * \brief Prefix of the names of the in-memory data sources.
+ */
+const std::string k_InMemoryPrefix = "memory:";
+
+/**\ingroup GeometryInternals
+ * \brief In-memory data sources of the process, by name.
+ */
+struct InMemoryRegistry
+{
+  std::mutex                                           Mutex;
+  std::map<std::string, otb::ogr::DataSource::Pointer> DataSources;
+};
+
+InMemoryRegistry& GetInMemoryRegistry()
+{
+  static InMemoryRegistry registry;
+  return registry;
+}
 } // Anonymous namespace
 
 
@@ -168,6 +193,78 @@ otb::ogr::DataSource::Pointer otb::ogr::DataSource::OpenDataSource(std::string c
   return otb::ogr::DataSource::New(source, mode, fileNameHelper->GetGDALLayerOptions());
 }
 
+/*static*/
+bool otb::ogr::DataSource::IsInMemoryName(std::string const& datasourceName)
+{
+  return datasourceName.compare(0, k_InMemoryPrefix.size(), k_InMemoryPrefix) == 0;
+}
+
+/*static*/
+otb::ogr::DataSource::Pointer otb::ogr::DataSource::OpenInMemoryDataSource(std::string const& datasourceName, Modes::type mode)
+{
+  InMemoryRegistry&           registry = GetInMemoryRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+
+  auto it = registry.DataSources.find(datasourceName);
+  if (mode == Modes::Overwrite || it == registry.DataSources.end())
+  {
+    if (mode == Modes::Read)
+    {
+      itkGenericExceptionMacro(<< "No in-memory data source named " << datasourceName);
+    }
+    Pointer ds                           = DataSource::New();
+    ds->m_OpenMode                       = mode;
+    registry.DataSources[datasourceName] = ds;
+    return ds;
+  }
+
+  if (mode != Modes::Read)
+  {
+    it->second->m_OpenMode = mode;
+  }
+  return it->second;
+}
+
+/*static*/
+void otb::ogr::DataSource::SaveInMemory(std::string const& datasourceName, std::string const& fileName)
+{
+  Pointer source;
+  {
+    InMemoryRegistry&           registry = GetInMemoryRegistry();
+    std::lock_guard<std::mutex> lock(registry.Mutex);
+    auto                        it = registry.DataSources.find(datasourceName);
+    if (it == registry.DataSources.end())
+    {
+      itkGenericExceptionMacro(<< "No in-memory data source named " << datasourceName);
+    }
+    source = it->second;
+  }
+
+  Pointer destination = DataSource::New(fileName, Modes::Overwrite);
+  for (int i = 0; i < source->GetLayersCount(); ++i)
+  {
+    Layer layer = source->GetLayer(i);
+    destination->CopyLayer(layer, layer.GetName());
+  }
+  destination->SyncToDisk();
+}
+
+/*static*/
+void otb::ogr::DataSource::ReleaseInMemory(std::string const& datasourceName)
+{
+  InMemoryRegistry&           registry = GetInMemoryRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  registry.DataSources.erase(datasourceName);
+}
+
+/*static*/
+void otb::ogr::DataSource::ReleaseAllInMemory()
+{
+  InMemoryRegistry&           registry = GetInMemoryRegistry();
+  std::lock_guard<std::mutex> lock(registry.Mutex);
+  registry.DataSources.clear();
+}
+
 void DeleteDataSource(std::string const& datasourceName)
 {
   otb::OGRExtendedFilenameToOptions::Pointer fileNameHelper = otb::OGRExtendedFilenameToOptions::New();
@@ -212,6 +309,11 @@ otb::ogr::DataSource::Pointer otb::ogr::DataSource::New(std::string const& datas
     itkGenericExceptionMacro(<< "Wrong mode when opening " << simpleFileName);
   }
 
+  if (IsInMemoryName(simpleFileName))
+  {
+    return OpenInMemoryDataSource(simpleFileName, mode);
+  }
+
   Drivers::Init();
   GDALDataset* ds        = (GDALDataset*)GDALOpenEx(simpleFileName.c_str(), GDAL_OF_READONLY | GDAL_OF_VECTOR, NULL, NULL, NULL);
   bool         ds_exists = (ds != nullptr);
@@ -296,7 +398,7 @@ otb::ogr::Layer otb::ogr::DataSource::CreateLayer(std::string const& name, OGRSp
     }
 
     // Then create it
-    OGRLayer* ol = m_DataSource->CreateLayer(name.c_str(), poSpatialRef, eGType, otb::ogr::StringListConverter(layerOptions).to_ogr());
+    OGRLayer* ol = CreateOGRLayer(name, poSpatialRef, eGType, layerOptions);
 
     if (!ol)
     {
@@ -318,7 +420,7 @@ otb::ogr::Layer otb::ogr::DataSource::CreateLayer(std::string const& name, OGRSp
     else
     {
       // Then create it
-      OGRLayer* ol = m_DataSource->CreateLayer(name.c_str(), poSpatialRef, eGType, otb::ogr::StringListConverter(layerOptions).to_ogr());
+      OGRLayer* ol = CreateOGRLayer(name, poSpatialRef, eGType, layerOptions);
 
       if (!ol)
       {
@@ -341,7 +443,7 @@ otb::ogr::Layer otb::ogr::DataSource::CreateLayer(std::string const& name, OGRSp
     }
 
     // Case where the layer does not exists
-    OGRLayer* ol = m_DataSource->CreateLayer(name.c_str(), poSpatialRef, eGType, otb::ogr::StringListConverter(layerOptions).to_ogr());
+    OGRLayer* ol = CreateOGRLayer(name, poSpatialRef, eGType, layerOptions);
 
     if (!ol)
     {
@@ -363,6 +465,49 @@ otb::ogr::Layer otb::ogr::DataSource::CreateLayer(std::string const& name, OGRSp
   return Layer(nullptr, false); // keep compiler happy
 }
 
+OGRLayer* otb::ogr::DataSource::CreateOGRLayer(std::string const& name, OGRSpatialReference* poSpatialRef, OGRwkbGeometryType eGType,
+                                               std::vector<std::string> layerOptions)
+{
+  // Updating the R-tree of a GeoPackage on each insertion dominates the
+  // writing time of large layers: unless requested otherwise, it is built
+  // once, when the dataset is synced or closed
+  const bool isGPKG = std::string(m_DataSource->GetDriverName()) == "GPKG";
+  const bool deferSpatialIndex =
+      isGPKG && eGType != wkbNone &&
+      std::none_of(layerOptions.begin(), layerOptions.end(), [](std::string const& option) { return option.compare(0, 14, "SPATIAL_INDEX=") == 0; });
+  if (deferSpatialIndex)
+  {
+    layerOptions.push_back("SPATIAL_INDEX=NO");
+  }
+
+  OGRLayer* ol = m_DataSource->CreateLayer(name.c_str(), poSpatialRef, eGType, otb::ogr::StringListConverter(layerOptions).to_ogr());
+  if (ol && deferSpatialIndex)
+  {
+    m_DeferredSpatialIndexes.push_back(name);
+  }
+  return ol;
+}
+
+void otb::ogr::DataSource::BuildDeferredSpatialIndexes()
+{
+  for (std::string const& name : m_DeferredSpatialIndexes)
+  {
+    OGRLayer* ol = m_DataSource->GetLayerByName(name.c_str());
+    if (!ol || std::string(ol->GetGeometryColumn()).empty())
+    {
+      continue;
+    }
+    std::ostringstream sql;
+    sql << "SELECT CreateSpatialIndex('" << name << "', '" << ol->GetGeometryColumn() << "')";
+    OGRLayer* result = m_DataSource->ExecuteSQL(sql.str().c_str(), nullptr, nullptr);
+    if (result)
+    {
+      m_DataSource->ReleaseResultSet(result);
+    }
+  }
+  m_DeferredSpatialIndexes.clear();
+}
+
 otb::ogr::Layer otb::ogr::DataSource::CopyLayer(Layer& srcLayer, std::string const& newName, std::vector<std::string> const& papszOptions /* = NULL */)
 {
   assert(m_DataSource && "Datasource not initialized");
@@ -708,6 +853,7 @@ bool otb::ogr::DataSource::HasCapability(std::string const& capabilityName) cons
 void otb::ogr::DataSource::SyncToDisk()
 {
   assert(m_DataSource && "Datasource not initialized");
+  BuildDeferredSpatialIndexes();
   m_DataSource->FlushCache();
 }
 
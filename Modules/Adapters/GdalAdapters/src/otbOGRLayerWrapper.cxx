@@ -135,6 +135,40 @@ void otb::ogr::Layer::CreateFeature(Feature feature)
   }
 }
 
+bool otb::ogr::Layer::StartBatchTransaction()
+{
+  assert(m_Layer && "OGRLayer not initialized");
+
+  if (!m_Layer->TestCapability(OLCTransactions))
+  {
+    return false;
+  }
+  // Fails quietly when the caller already started a transaction
+  CPLPushErrorHandler(CPLQuietErrorHandler);
+  const OGRErr res = m_Layer->StartTransaction();
+  CPLPopErrorHandler();
+  return res == OGRERR_NONE;
+}
+
+void otb::ogr::Layer::EndBatchTransaction(bool commit)
+{
+  assert(m_Layer && "OGRLayer not initialized");
+
+  const OGRErr res = commit ? m_Layer->CommitTransaction() : m_Layer->RollbackTransaction();
+  if (res != OGRERR_NONE)
+  {
+    itkGenericExceptionMacro(<< "Unable to " << (commit ? "commit" : "roll back") << " transaction for OGR layer <" << GetName()
+                             << ">: " << CPLGetLastErrorMsg());
+  }
+}
+
+size_t otb::ogr::Layer::GetDefaultTransactionSize() const
+{
+  // Large enough to make the cost of a commit negligible, small enough to
+  // keep the journal of GPKG, SQLite and PostgreSQL within memory
+  return 100000;
+}
+
 void otb::ogr::Layer::DeleteFeature(long nFID)
 {
   assert(m_Layer && "OGRLayer not initialized");
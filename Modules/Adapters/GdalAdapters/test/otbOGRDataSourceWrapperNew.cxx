@@ -778,6 +778,41 @@ BOOST_AUTO_TEST_CASE(OGRDataSource_new_shp_with_features)
   l.CreateFeature(g0);
 }
 
+BOOST_AUTO_TEST_CASE(OGRDataSource_new_in_memory)
+{
+  const std::string k_mem = "memory:SomeInMemoryDataSource";
+  BOOST_CHECK(ogr::DataSource::IsInMemoryName(k_mem));
+  BOOST_CHECK(!ogr::DataSource::IsInMemoryName(k_one + ".shp"));
+  BOOST_CHECK_THROW(ogr::DataSource::New(k_mem, ogr::DataSource::Modes::Read), itk::ExceptionObject);
+
+  ogr::DataSource::Pointer ds = ogr::DataSource::New(k_mem, ogr::DataSource::Modes::Overwrite);
+  ogr::Layer               l  = ds->CreateLayer(k_one, nullptr, wkbPoint);
+  l.CreateField(k_f0);
+  ogr::Feature g0(l.GetLayerDefn());
+  g0[0].SetValue(42);
+  l.CreateFeature(g0);
+
+  // The same data source is shared by name
+  ogr::DataSource::Pointer shared = ogr::DataSource::New(k_mem, ogr::DataSource::Modes::Read);
+  BOOST_CHECK_EQUAL(shared.GetPointer(), ds.GetPointer());
+  BOOST_CHECK_EQUAL(shared->GetLayer(k_one).GetFeatureCount(true), 1);
+
+  // Written to disk on request only
+  const std::string k_shp = "SomeSavedInMemoryDataSource.shp";
+  ogr::DataSource::SaveInMemory(k_mem, k_shp);
+  ogr::DataSource::Pointer saved = ogr::DataSource::New(k_shp, ogr::DataSource::Modes::Read);
+  BOOST_CHECK_EQUAL(saved->GetLayersCount(), 1);
+  BOOST_CHECK_EQUAL(saved->GetLayer(0).GetFeatureCount(true), 1);
+
+  // Overwrite replaces the registered data source
+  ogr::DataSource::Pointer other = ogr::DataSource::New(k_mem, ogr::DataSource::Modes::Overwrite);
+  BOOST_CHECK(other.GetPointer() != ds.GetPointer());
+  BOOST_CHECK_EQUAL(other->GetLayersCount(), 0);
+
+  ogr::DataSource::ReleaseInMemory(k_mem);
+  BOOST_CHECK_THROW(ogr::DataSource::New(k_mem, ogr::DataSource::Modes::Read), itk::ExceptionObject);
+}
+
 BOOST_AUTO_TEST_CASE(Local_Geometries)
 {
   ogr::UniqueGeometryPtr gp(OGRGeometryFactory::createGeometry(wkbPoint));
@@ -833,6 +868,49 @@ BOOST_AUTO_TEST_CASE(Add_n_Read_Geometries)
   }
 }
 
+BOOST_AUTO_TEST_CASE(Create_Features_GPKG)
+{
+  const std::string k_gpkg = "SomeGeoPackageWithFeatures.gpkg";
+  {
+    ogr::DataSource::Pointer ds   = ogr::DataSource::New(k_gpkg, ogr::DataSource::Modes::Overwrite);
+    ogr::Layer               l    = ds->CreateLayer(k_one, nullptr, wkbPoint);
+    OGRFeatureDefn&          defn = l.GetLayerDefn();
+    l.CreateField(k_f0);
+
+    std::vector<ogr::Feature> features;
+    for (int u = 0; u != 20; ++u)
+    {
+      ogr::Feature   f(defn);
+      const OGRPoint p(u, u);
+      f.SetGeometry(&p);
+      f[0].SetValue(u);
+      features.push_back(f);
+    }
+    // Several transactions, the last one being partial
+    l.CreateFeatures(features.begin(), features.end(), 7);
+    BOOST_CHECK_EQUAL(l.GetFeatureCount(true), 20);
+
+    // Within a transaction of the caller
+    for (ogr::Feature& f : features)
+    {
+      f.SetFID(OGRNullFID);
+    }
+    BOOST_CHECK(l.ogr().StartTransaction() == OGRERR_NONE);
+    l.CreateFeatures(features.begin(), features.begin() + 5, 2);
+    BOOST_CHECK(l.ogr().CommitTransaction() == OGRERR_NONE);
+    BOOST_CHECK_EQUAL(l.GetFeatureCount(true), 25);
+  }
+
+  // The spatial index is built when the data source is closed
+  ogr::DataSource::Pointer ds     = ogr::DataSource::New(k_gpkg, ogr::DataSource::Modes::Read);
+  ogr::Layer               result = ds->ExecuteSQL("SELECT HasSpatialIndex('" + k_one + "', 'geom')", nullptr, nullptr);
+  BOOST_REQUIRE(result);
+  OGRFeature* hasIndex = result.ogr().GetNextFeature();
+  BOOST_REQUIRE(hasIndex);
+  BOOST_CHECK_EQUAL(hasIndex->GetFieldAsInteger(0), 1);
+  OGRFeature::DestroyFeature(hasIndex);
+}
+
 #if 0
 BOOST_AUTO_TEST_CASE(OGRDataSource_new_shp_with_features_raw)
 {
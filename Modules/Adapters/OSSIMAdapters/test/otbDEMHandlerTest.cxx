@@ -92,6 +92,21 @@ int otbDEMHandlerTest(int argc, char* argv[])
   {
     height = demHandler.GetHeightAboveEllipsoid(point);
     std::cout << "height above ellipsoid (" << longitude << ", " << latitude << ") = " << height << " meters" << std::endl;
+
+    // The batched lookup must give the same heights
+    const double lons[3] = {longitude, longitude + 0.001, longitude};
+    const double lats[3] = {latitude, latitude, latitude - 0.001};
+    double       heights[3];
+    demHandler.GetHeightAboveEllipsoid(lons, lats, heights, 3);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (heights[i] != demHandler.GetHeightAboveEllipsoid(lons[i], lats[i]))
+      {
+        std::cerr << "Batched height above ellipsoid (" << lons[i] << ", " << lats[i] << ") = " << heights[i] << " differs from "
+                  << demHandler.GetHeightAboveEllipsoid(lons[i], lats[i]) << std::endl;
+        fail = true;
+      }
+    }
   }
 
   // Check for Nan
@@ -22,6 +22,8 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbMultivariateAlterationDetectorImageFilter.h"
+#include "otbStatisticsXMLFileReader.h"
+#include "otbStatisticsXMLFileWriter.h"
 
 namespace otb
 {
@@ -75,6 +77,14 @@ private:
         " input image 1 and input image 2 to build the change map,\n"
         "- Rho, the vector of correlation associated to each change map.\n"
         " \n"
+        "The joint statistics of both images can be computed on a random"
+        " sample of pixels (samples parameter), saved to a file (outstats) and"
+        " reused to process images with the same statistics (instats), in"
+        " which case the images are read only once. With the iterations"
+        " parameter, the iteratively reweighted MAD (IR-MAD) [3] is computed on"
+        " the pixel sample: the statistics are weighted by the probability of"
+        " no change of each pixel until the canonical correlations converge.\n"
+        " \n"
         "The OTB filter used in this application has been implemented from the"
         " Matlab code kindly made available by the authors here [2]. Both cases"
         " (same and different number of bands) have been validated"
@@ -89,7 +99,9 @@ private:
         "[1] Nielsen, A. A., & Conradsen, K. (1997). Multivariate alteration"
         "detection (MAD) in multispectral, bi-temporal image data: A new"
         "approach to change detection studies.\n"
-        "[2] http://www2.imm.dtu.dk/~aa/software.html");
+        "[2] http://www2.imm.dtu.dk/~aa/software.html\n"
+        "[3] Nielsen, A. A. (2007). The regularized iteratively reweighted MAD"
+        " method for change detection in multi- and hyperspectral data.");
 
     AddDocTag(Tags::ChangeDetection);
 
@@ -100,6 +112,32 @@ private:
     AddParameter(ParameterType_OutputImage, "out", "Change Map");
     SetParameterDescription("out", "Multiband image containing change maps.");
 
+    AddParameter(ParameterType_Int, "samples", "Number of samples");
+    SetParameterDescription("samples",
+                            "Number of pixels randomly sampled to compute the statistics. "
+                            "0 uses all the pixels.");
+    SetDefaultParameterInt("samples", 0);
+    SetMinimumParameterIntValue("samples", 0);
+    MandatoryOff("samples");
+
+    AddParameter(ParameterType_Int, "iterations", "IR-MAD iterations");
+    SetParameterDescription("iterations",
+                            "Maximum number of iterations of the iteratively reweighted MAD. "
+                            "0 computes the MAD. Requires the samples parameter.");
+    SetDefaultParameterInt("iterations", 0);
+    SetMinimumParameterIntValue("iterations", 0);
+    MandatoryOff("iterations");
+
+    AddParameter(ParameterType_InputFilename, "instats", "Input statistics file");
+    SetParameterDescription("instats",
+                            "XML file containing the joint statistics of both images, as written by outstats. "
+                            "The statistics are not computed from the images.");
+    MandatoryOff("instats");
+
+    AddParameter(ParameterType_OutputFilename, "outstats", "Output statistics file");
+    SetParameterDescription("outstats", "XML file where the joint statistics of both images are written.");
+    MandatoryOff("outstats");
+
     AddRAMParameter();
 
     // Doc example parameter settings
@@ -122,8 +160,59 @@ private:
 
     changeFilter->SetInput1(GetParameterImage("in1"));
     changeFilter->SetInput2(GetParameterImage("in2"));
+    changeFilter->SetNumberOfSamples(GetParameterInt("samples"));
+    changeFilter->SetNumberOfIterations(GetParameterInt("iterations"));
+
+    // The covariance matrix is stored row by row
+    typedef ChangeFilterType::VectorType                  MeasurementType;
+    typedef otb::StatisticsXMLFileReader<MeasurementType> StatisticsReader;
+    typedef otb::StatisticsXMLFileWriter<MeasurementType> StatisticsWriter;
+
+    if (IsParameterEnabled("instats") && HasValue("instats"))
+    {
+      StatisticsReader::Pointer statisticsReader = StatisticsReader::New();
+      statisticsReader->SetFileName(GetParameterString("instats"));
+      const MeasurementType mean       = statisticsReader->GetStatisticVectorByName("mean");
+      const MeasurementType covariance = statisticsReader->GetStatisticVectorByName("covariance");
+
+      const unsigned int nbBands = mean.GetSize();
+      if (covariance.GetSize() != nbBands * nbBands)
+      {
+        otbAppLogFATAL("The covariance in " << GetParameterString("instats") << " is not a " << nbBands << "x" << nbBands << " matrix");
+      }
+      ChangeFilterType::MatrixType covarianceMatrix(nbBands, nbBands);
+      for (unsigned int r = 0; r < nbBands; ++r)
+      {
+        for (unsigned int c = 0; c < nbBands; ++c)
+        {
+          covarianceMatrix(r, c) = covariance[r * nbBands + c];
+        }
+      }
+      changeFilter->SetStatistics(mean, covarianceMatrix);
+    }
+
     changeFilter->GetOutput()->UpdateOutputInformation();
 
+    if (IsParameterEnabled("outstats") && HasValue("outstats"))
+    {
+      const ChangeFilterType::MatrixType& covarianceMatrix = changeFilter->GetCovarianceMatrix();
+      const unsigned int                  nbBands          = covarianceMatrix.Rows();
+      MeasurementType                     covariance(nbBands * nbBands);
+      for (unsigned int r = 0; r < nbBands; ++r)
+      {
+        for (unsigned int c = 0; c < nbBands; ++c)
+        {
+          covariance[r * nbBands + c] = covarianceMatrix(r, c);
+        }
+      }
+
+      StatisticsWriter::Pointer statisticsWriter = StatisticsWriter::New();
+      statisticsWriter->SetFileName(GetParameterString("outstats"));
+      statisticsWriter->AddInput("mean", changeFilter->GetMeanValues());
+      statisticsWriter->AddInput("covariance", covariance);
+      statisticsWriter->Update();
+    }
+
     otbAppLogINFO("Input 1 mean: " << changeFilter->GetMean1());
     otbAppLogINFO("Input 2 mean: " << changeFilter->GetMean2());
     otbAppLogINFO("Input 1 transform: " << changeFilter->GetV1());
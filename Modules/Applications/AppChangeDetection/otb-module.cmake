@@ -25,6 +25,7 @@ otb_module(OTBAppChangeDetection
   DEPENDS
     OTBApplicationEngine
     OTBChangeDetection
+    OTBIOXML
   TEST_DEPENDS
     OTBTestKernel
     OTBCommandLine
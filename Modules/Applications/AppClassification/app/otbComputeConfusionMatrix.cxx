@@ -28,6 +28,7 @@
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
 
 #include "otbConfusionMatrixMeasurements.h"
+#include "otbStreamingConfusionMatrixImageFilter.h"
 #include "otbContingencyTableCalculator.h"
 #include "otbContingencyTable.h"
 
@@ -66,6 +67,8 @@ public:
 
   typedef std::map<ClassLabelType, std::map<ClassLabelType, ConfusionMatrixEltType>> OutputConfusionMatrixType;
 
+  typedef otb::StreamingConfusionMatrixImageFilter<Int32ImageType> ConfusionMatrixFilterType;
+
 
   // filter type
   typedef otb::ConfusionMatrixMeasurements<ConfusionMatrixType, ClassLabelType> ConfusionMatrixMeasurementsType;
@@ -411,51 +414,43 @@ private:
     MapOfClassesType           mapOfClassesRef, mapOfClassesProd;
     MapOfClassesType::iterator itMapOfClassesRef, itMapOfClassesProd;
     ClassLabelType             labelRef = 0, labelProd = 0;
-    int                        itLabelRef = 0, itLabelProd = 0;
 
-    for (unsigned int index = 0; index < sid.numberOfStreamDivisions; index++)
+    ConfusionMatrixFilterType::Pointer confusionFilter = ConfusionMatrixFilterType::New();
+    confusionFilter->SetInput(m_Input);
+    confusionFilter->SetReferenceImage(m_Reference);
+    if (sid.prodhasnodata)
     {
-      RegionType streamRegion = m_StreamingManager->GetSplit(index);
-
-      m_Input->SetRequestedRegion(streamRegion);
-      m_Input->PropagateRequestedRegion();
-      m_Input->UpdateOutputData();
-
-      m_Reference->SetRequestedRegion(streamRegion);
-      m_Reference->PropagateRequestedRegion();
-      m_Reference->UpdateOutputData();
-
-      ImageIteratorType itInput(m_Input, streamRegion);
-      itInput.GoToBegin();
-
-      ImageIteratorType itRef(m_Reference, streamRegion);
-      itRef.GoToBegin();
-
-      while (!itRef.IsAtEnd())
+      confusionFilter->SetNoDataLabel(sid.prodnodata);
+    }
+    if (sid.refhasnodata)
+    {
+      confusionFilter->SetReferenceNoDataLabel(sid.refnodata);
+    }
+    confusionFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    AddProcess(confusionFilter->GetStreamer(), "Computing confusion matrix");
+    confusionFilter->Update();
+
+    const ConfusionMatrixFilterType::LabelListType& refLabels  = confusionFilter->GetReferenceLabels();
+    const ConfusionMatrixFilterType::LabelListType& prodLabels = confusionFilter->GetProducedLabels();
+    const ConfusionMatrixFilterType::MatrixType&    counts     = confusionFilter->GetMatrix();
+    for (unsigned int r = 0; r < refLabels.size(); ++r)
+    {
+      mapOfClassesRef[refLabels[r]] = r;
+    }
+    for (unsigned int p = 0; p < prodLabels.size(); ++p)
+    {
+      mapOfClassesProd[prodLabels[p]] = p;
+    }
+    for (unsigned int r = 0; r < refLabels.size(); ++r)
+    {
+      for (unsigned int p = 0; p < prodLabels.size(); ++p)
       {
-        labelRef  = static_cast<ClassLabelType>(itRef.Get());
-        labelProd = static_cast<ClassLabelType>(itInput.Get());
-
-        // Extraction of the reference/produced class labels
-        if ((!sid.refhasnodata || labelRef != sid.refnodata) && (!sid.prodhasnodata || labelProd != sid.prodnodata))
+        if (counts(r, p) != 0)
         {
-          // If the current labels have not been added to their respective mapOfClasses yet
-          if (mapOfClassesRef.insert(MapOfClassesType::value_type(labelRef, itLabelRef)).second)
-          {
-            ++itLabelRef;
-          }
-          if (mapOfClassesProd.insert(MapOfClassesType::value_type(labelProd, itLabelProd)).second)
-          {
-            ++itLabelProd;
-          }
-
-          // Filling of m_Matrix
-          m_Matrix[labelRef][labelProd]++;
-        } // END if ((labelRef != nodata) && (labelProd != nodata))
-        ++itRef;
-        ++itInput;
+          m_Matrix[refLabels[r]][prodLabels[p]] = counts(r, p);
+        }
       }
-    } // END of for (unsigned int index = 0; index < numberOfStreamDivisions; index++)
+    }
 
 
     /////////////////////////////////////////////
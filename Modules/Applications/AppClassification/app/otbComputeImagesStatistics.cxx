@@ -22,6 +22,7 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbStatisticsXMLFileWriter.h"
+#include "otbProcessGroup.h"
 #include "otbStreamingStatisticsVectorImageFilter.h"
 #include <sstream>
 
@@ -214,6 +215,14 @@ private:
       stddev[i] = std::sqrt(totalVariancePerBand[i]);
     }
 
+    // With distributed streaming, every process holds the statistics: only
+    // the first one writes them
+    const ProcessGroup* group = ProcessGroup::GetDefault();
+    if (group && group->GetRank() != 0)
+    {
+      return;
+    }
+
     if (HasValue("out"))
     {
       // Write the Statistics via the statistic writer
@@ -0,0 +1,110 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperApplication.h"
+#include "otbWrapperApplicationFactory.h"
+
+#include "otbRandomForestsMachineLearningModel.h"
+
+namespace otb
+{
+namespace Wrapper
+{
+
+class ConvertRandomForestsModel : public Application
+{
+public:
+  /** Standard class typedefs. */
+  typedef ConvertRandomForestsModel     Self;
+  typedef Application                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Standard macro */
+  itkNewMacro(Self);
+
+  itkTypeMacro(ConvertRandomForestsModel, otb::Application);
+
+  /** The binary format does not depend on the sample and label types */
+  typedef otb::RandomForestsMachineLearningModel<float, int> RandomForestType;
+
+private:
+  void DoInit() override
+  {
+    SetName("ConvertRandomForestsModel");
+    SetDescription("Converts an OpenCV random forests model to the compact binary format.");
+
+    SetDocLongDescription(
+        "This application converts a random forests classification model produced by TrainImagesClassifier or TrainVectorClassifier "
+        "(classifier rf) to a compact binary format. Binary models are read by ImageClassifier and VectorClassifier much faster than "
+        "the default text models, which is useful for large forests applied to many images. The split thresholds can optionally be "
+        "stored as half precision floats to make the model smaller.");
+    SetDocLimitations(
+        "Only classification forests can be converted. The binary model can only be used for prediction: variable importance and "
+        "training error are not available anymore.");
+    SetDocAuthors("OTB-Team");
+    SetDocSeeAlso("TrainImagesClassifier, TrainVectorClassifier, ImageClassifier");
+
+    AddDocTag(Tags::Learning);
+
+    AddParameter(ParameterType_InputFilename, "in", "Input model");
+    SetParameterDescription("in", "OpenCV random forests model to convert.");
+
+    AddParameter(ParameterType_OutputFilename, "out", "Output model");
+    SetParameterDescription("out", "Converted binary model.");
+
+    AddParameter(ParameterType_Bool, "half", "Half precision thresholds");
+    SetParameterDescription("half",
+                            "Store the split thresholds as half precision floats. "
+                            "Decisions may change for feature values very close to a threshold.");
+
+    // Doc example parameter settings
+    SetDocExampleParameterValue("in", "clsvmModelQB1.rf");
+    SetDocExampleParameterValue("out", "clModelQB1.rfb");
+
+    SetOfficialDocLink();
+  }
+
+  void DoUpdateParameters() override
+  {
+    // Nothing to do here : all parameters are independent
+  }
+
+  void DoExecute() override
+  {
+    RandomForestType::Pointer model = RandomForestType::New();
+
+    if (!model->CanReadFile(GetParameterString("in")))
+    {
+      otbAppLogFATAL(<< "Error when loading model " << GetParameterString("in") << " : not a random forests model");
+    }
+
+    model->Load(GetParameterString("in"));
+    otbAppLogINFO("Model loaded");
+
+    model->SetBinaryModel(true);
+    model->SetHalfPrecisionThresholds(GetParameterInt("half"));
+    model->Save(GetParameterString("out"));
+  }
+};
+}
+}
+
+OTB_APPLICATION_EXPORT(otb::Wrapper::ConvertRandomForestsModel)
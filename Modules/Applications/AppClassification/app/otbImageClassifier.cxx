@@ -26,10 +26,18 @@
 #include "otbStatisticsXMLFileReader.h"
 #include "otbShiftScaleVectorImageFilter.h"
 #include "otbImageClassificationFilter.h"
+#include "otbMultiModelImageClassificationFilter.h"
 #include "otbMultiToMonoChannelExtractROI.h"
 #include "otbImageToVectorImageCastFilter.h"
 #include "otbMachineLearningModelFactory.h"
 
+#ifdef OTB_USE_OPENCV
+#include "otbRandomForestsMachineLearningModel.h"
+#endif
+#ifdef OTB_USE_SHARK
+#include "otbSharkRandomForestsMachineLearningModel.h"
+#endif
+
 namespace otb
 {
 namespace Wrapper
@@ -65,6 +73,7 @@ public:
   typedef otb::MachineLearningModelFactory<ValueType, LabelType> MachineLearningModelFactoryType;
   typedef ClassificationFilterType::ConfidenceImageType ConfidenceImageType;
   typedef ClassificationFilterType::ProbaImageType      ProbaImageType;
+  typedef otb::MultiModelImageClassificationFilter<FloatVectorImageType, Int32VectorImageType, MaskImageType> MultiClassificationFilterType;
 
 protected:
   ~ImageClassifier() override
@@ -105,6 +114,13 @@ private:
     AddParameter(ParameterType_InputFilename, "model", "Model file");
     SetParameterDescription("model", "A model file (produced by TrainImagesClassifier application, maximal class label = 65535).");
 
+    AddParameter(ParameterType_InputFilenameList, "models", "Additional model files");
+    SetParameterDescription("models",
+                            "Other models to apply to the input image in the same pass. When set, the output image is the fusion by majority voting of the "
+                            "labels of all the models (see FusionOfClassifications), and the labels of each model can be written with the outmodels "
+                            "parameter. Confidence and probability maps are not available in this mode.");
+    MandatoryOff("models");
+
     AddParameter(ParameterType_InputFilename, "imstat", "Statistics file");
     SetParameterDescription("imstat",
                             "An XML file containing mean and standard deviation to center and reduce samples before classification (produced by "
@@ -122,10 +138,23 @@ private:
     MandatoryOff("nodatalabel");
 
 
+    AddParameter(ParameterType_Int, "undecidedlabel", "Label for the Undecided class");
+    SetParameterDescription("undecidedlabel",
+                            "When several models are used, label of the pixels with a tie in the majority voting. It should be different from existing labels.");
+    SetDefaultParameterInt("undecidedlabel", 0);
+    MandatoryOff("undecidedlabel");
+
     AddParameter(ParameterType_OutputImage, "out", "Output Image");
     SetParameterDescription("out", "Output image containing class labels");
     SetDefaultOutputPixelType("out", ImagePixelType_uint8);
 
+    AddParameter(ParameterType_OutputImage, "outmodels", "Labels of each model");
+    SetParameterDescription("outmodels",
+                            "When several models are used, image with one band per model (model, then models in the given order) containing the labels "
+                            "decided by each model.");
+    SetDefaultOutputPixelType("outmodels", ImagePixelType_uint8);
+    MandatoryOff("outmodels");
+
     AddParameter(ParameterType_OutputImage, "confmap", "Confidence map");
     SetParameterDescription("confmap",
                             "Confidence map of the produced classification. The confidence index depends on the model: \n\n"
@@ -142,6 +171,19 @@ private:
     SetDefaultOutputPixelType("confmap", ImagePixelType_double);
     MandatoryOff("confmap");
 
+    AddParameter(ParameterType_Choice, "confmode", "Confidence of random forests");
+    SetParameterDescription("confmode", "Confidence index written in the confidence map for random forest models (OpenCV and Shark).");
+    AddChoice("confmode.max", "Proportion of votes");
+    SetParameterDescription("confmode.max", "Proportion of the votes (or probability) of the majority class.");
+    AddChoice("confmode.margin", "Margin");
+    SetParameterDescription("confmode.margin", "Normalized difference of the votes (or probabilities) of the 2 majority classes.");
+
+    AddParameter(ParameterType_Bool, "earlystop", "Early termination of random forests");
+    SetParameterDescription("earlystop",
+                            "For OpenCV random forest models, stop evaluating the trees for a pixel once its label can no longer change. Labels are "
+                            "unchanged, but the confidence is then computed on the trees evaluated so far. Homogeneous areas only go through a fraction "
+                            "of the trees.");
+
     AddParameter(ParameterType_OutputImage, "probamap", "Probability map");
     SetParameterDescription("probamap",
                             "Probability of each class for each pixel. This is an image having a number of bands equal to the number of classes in the model. "
@@ -171,6 +213,42 @@ private:
     // Nothing to do here : all parameters are independent
   }
 
+  ModelPointerType LoadModel(const std::string& fileName)
+  {
+    ModelPointerType model = MachineLearningModelFactoryType::CreateMachineLearningModel(fileName, MachineLearningModelFactoryType::ReadMode);
+
+    if (model.IsNull())
+    {
+      otbAppLogFATAL(<< "Error when loading model " << fileName << " : unsupported model type");
+    }
+
+    model->Load(fileName);
+    return model;
+  }
+
+  /** Set the confidence mode and early termination of random forests */
+  void ConfigureRandomForests(ModelType* model)
+  {
+    const bool computeMargin = GetParameterString("confmode") == "margin";
+#ifdef OTB_USE_OPENCV
+    typedef otb::RandomForestsMachineLearningModel<ValueType, LabelType> RandomForestsType;
+    if (RandomForestsType* rf = dynamic_cast<RandomForestsType*>(model))
+    {
+      rf->SetComputeMargin(computeMargin);
+      rf->SetEarlyTermination(GetParameterInt("earlystop"));
+    }
+#endif
+#ifdef OTB_USE_SHARK
+    typedef otb::SharkRandomForestsMachineLearningModel<ValueType, LabelType> SharkRandomForestsType;
+    if (SharkRandomForestsType* rf = dynamic_cast<SharkRandomForestsType*>(model))
+    {
+      rf->SetComputeMargin(computeMargin);
+    }
+#endif
+    (void)model;
+    (void)computeMargin;
+  }
+
   void DoExecute() override
   {
     // Load input image
@@ -179,27 +257,18 @@ private:
 
     // Load svm model
     otbAppLogINFO("Loading model");
-    m_Model = MachineLearningModelFactoryType::CreateMachineLearningModel(GetParameterString("model"), MachineLearningModelFactoryType::ReadMode);
-
-    if (m_Model.IsNull())
-    {
-      otbAppLogFATAL(<< "Error when loading model " << GetParameterString("model") << " : unsupported model type");
-    }
-
-    m_Model->Load(GetParameterString("model"));
+    m_Model = LoadModel(GetParameterString("model"));
     otbAppLogINFO("Model loaded");
 
+    ConfigureRandomForests(m_Model);
+
     // Normalize input image (optional)
     StatisticsReader::Pointer statisticsReader = StatisticsReader::New();
     MeasurementType           meanMeasurementVector;
     MeasurementType           stddevMeasurementVector;
     m_Rescaler = RescalerType::New();
 
-    // Classify
-    m_ClassificationFilter = ClassificationFilterType::New();
-    m_ClassificationFilter->SetModel(m_Model);
-
-    m_ClassificationFilter->SetDefaultLabel(GetParameterInt("nodatalabel"));
+    FloatVectorImageType::Pointer classifierInput = inImage;
 
     // Normalize input image if asked
     if (IsParameterEnabled("imstat"))
@@ -216,23 +285,66 @@ private:
       m_Rescaler->SetShift(meanMeasurementVector);
       m_Rescaler->SetInput(inImage);
 
-      m_ClassificationFilter->SetInput(m_Rescaler->GetOutput());
+      classifierInput = m_Rescaler->GetOutput();
     }
     else
     {
       otbAppLogINFO("Input image normalization deactivated.");
-      m_ClassificationFilter->SetInput(inImage);
     }
 
-
+    MaskImageType::Pointer inMask;
     if (IsParameterEnabled("mask"))
     {
       otbAppLogINFO("Using input mask");
       // Load mask image and cast into LabeledImageType
-      MaskImageType::Pointer inMask = GetParameterUInt8Image("mask");
+      inMask = GetParameterUInt8Image("mask");
+    }
 
-      m_ClassificationFilter->SetInputMask(inMask);
+    if (IsParameterEnabled("models") && HasValue("models") && !GetParameterStringList("models").empty())
+    {
+      // All the models classify each tile of the (normalized) input in one pass
+      m_MultiClassificationFilter = MultiClassificationFilterType::New();
+      m_MultiClassificationFilter->AddModel(m_Model);
+      for (const auto& fileName : GetParameterStringList("models"))
+      {
+        otbAppLogINFO("Loading model " << fileName);
+        ModelPointerType model = LoadModel(fileName);
+        ConfigureRandomForests(model);
+        m_MultiClassificationFilter->AddModel(model);
+      }
+      m_MultiClassificationFilter->SetNoDataLabel(GetParameterInt("nodatalabel"));
+      m_MultiClassificationFilter->SetUndecidedLabel(GetParameterInt("undecidedlabel"));
+      m_MultiClassificationFilter->SetInput(classifierInput);
+      if (inMask)
+        m_MultiClassificationFilter->SetInputMask(inMask);
+
+      SetParameterOutputImage<OutputImageType>("out", m_MultiClassificationFilter->GetFusedOutput());
+      if (IsParameterEnabled("outmodels") && HasValue("outmodels"))
+        SetParameterOutputImage<Int32VectorImageType>("outmodels", m_MultiClassificationFilter->GetOutput());
+
+      if ((IsParameterEnabled("confmap") && HasValue("confmap")) || (IsParameterEnabled("probamap") && HasValue("probamap")))
+      {
+        otbAppLogWARNING("Confidence and probability maps are not available with several models!");
+        this->DisableParameter("confmap");
+        this->DisableParameter("probamap");
+      }
+      return;
     }
+
+    if (IsParameterEnabled("outmodels") && HasValue("outmodels"))
+    {
+      otbAppLogWARNING("Labels of each model requested with a single model, use the out parameter instead!");
+      this->DisableParameter("outmodels");
+    }
+
+    // Classify
+    m_ClassificationFilter = ClassificationFilterType::New();
+    m_ClassificationFilter->SetModel(m_Model);
+    m_ClassificationFilter->SetDefaultLabel(GetParameterInt("nodatalabel"));
+    m_ClassificationFilter->SetInput(classifierInput);
+    if (inMask)
+      m_ClassificationFilter->SetInputMask(inMask);
+
     SetParameterOutputImage<OutputImageType>("out", m_ClassificationFilter->GetOutput());
 
 
@@ -266,9 +378,10 @@ private:
     }
   }
 
-  ClassificationFilterType::Pointer m_ClassificationFilter;
-  ModelPointerType                  m_Model;
-  RescalerType::Pointer             m_Rescaler;
+  ClassificationFilterType::Pointer      m_ClassificationFilter;
+  MultiClassificationFilterType::Pointer m_MultiClassificationFilter;
+  ModelPointerType                       m_Model;
+  RescalerType::Pointer                  m_Rescaler;
 };
 }
 }
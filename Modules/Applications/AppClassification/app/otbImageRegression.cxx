@@ -27,6 +27,7 @@
 #include "otbStatisticsXMLFileReader.h"
 #include "otbShiftScaleVectorImageFilter.h"
 #include "otbImageClassificationFilter.h"
+#include "otbMultiModelImageClassificationFilter.h"
 #include "otbMultiToMonoChannelExtractROI.h"
 #include "otbImageToVectorImageCastFilter.h"
 #include "otbMachineLearningModelFactory.h"
@@ -95,6 +96,8 @@ public:
   typedef ClassificationFilterType::ValueType ValueType;
   typedef ClassificationFilterType::LabelType LabelType;
   typedef otb::MachineLearningModelFactory<ValueType, LabelType> MachineLearningModelFactoryType;
+  typedef otb::MultiModelImageClassificationFilter<FloatVectorImageType, FloatVectorImageType, MaskImageType> MultiRegressionFilterType;
+  typedef otb::ShiftScaleVectorImageFilter<FloatVectorImageType, FloatVectorImageType> OutputVectorRescalerType;
 
 protected:
   ~ImageRegression() override
@@ -114,7 +117,8 @@ private:
         "image, based on a regression model file produced either by "
         "TrainVectorRegression or TrainImagesRegression. "
         "Pixels of the output image will contain the predicted values from "
-        "the regression model (single band). The input pixels "
+        "the regression model (single band), or from each of the regression "
+        "models (one band per model) when several models are given. The input pixels "
         "can be optionally centered and reduced according "
         "to the statistics file produced by the "
         "ComputeImagesStatistics application. An optional "
@@ -151,13 +155,21 @@ private:
                             "A regression model file (produced either by "
                             "TrainVectorRegression application or the TrainImagesRegression application).");
 
+    AddParameter(ParameterType_InputFilenameList, "models", "Additional model files");
+    SetParameterDescription("models",
+                            "Other regression models to apply to the input image in the same pass, for instance one model per "
+                            "biophysical variable. When set, the output image has one band per model (model, then models in the given order).");
+    MandatoryOff("models");
+
     AddParameter(ParameterType_InputFilename, "imstat", "Statistics file");
     SetParameterDescription("imstat",
                             "An XML file containing mean and standard"
                             " deviation to center and reduce samples before prediction "
                             "(produced by the ComputeImagesStatistics application). If this file contains "
                             "one more band than the sample size, the last stat of the last band will be"
-                            "applied to expand the output predicted value.");
+                            "applied to expand the output predicted value. With several models, this stat "
+                            "is applied to all the output bands, or the file can contain one extra band per model, "
+                            "applied to the band of that model.");
     MandatoryOff("imstat");
 
     AddParameter(ParameterType_OutputImage, "out", "Output Image");
@@ -179,6 +191,20 @@ private:
     // Nothing to do here : all parameters are independent
   }
 
+  ModelPointerType LoadModel(const std::string& fileName)
+  {
+    ModelPointerType model = MachineLearningModelFactoryType::CreateMachineLearningModel(fileName, MachineLearningModelFactoryType::ReadMode);
+
+    if (model.IsNull())
+    {
+      otbAppLogFATAL(<< "Error when loading model " << fileName << " : unsupported model type");
+    }
+
+    model->Load(fileName);
+    model->SetRegressionMode(true);
+    return model;
+  }
+
   void DoExecute() override
   {
     // Load input image
@@ -188,17 +214,15 @@ private:
 
     // Load svm model
     otbAppLogINFO("Loading model");
-    auto model = MachineLearningModelFactoryType::CreateMachineLearningModel(GetParameterString("model"), MachineLearningModelFactoryType::ReadMode);
+    auto model = LoadModel(GetParameterString("model"));
+    otbAppLogINFO("Model loaded");
 
-    if (model.IsNull())
+    if (IsParameterEnabled("models") && HasValue("models") && !GetParameterStringList("models").empty())
     {
-      otbAppLogFATAL(<< "Error when loading model " << GetParameterString("model") << " : unsupported model type");
+      ExecuteMultiRegression(inImage, model);
+      return;
     }
 
-    model->Load(GetParameterString("model"));
-    model->SetRegressionMode(true);
-    otbAppLogINFO("Model loaded");
-
     // Classify
     auto classificationFilter = ClassificationFilterType::New();
     classificationFilter->SetModel(model);
@@ -263,6 +287,80 @@ private:
     SetParameterOutputImage<FloatImageType>("out", outputImage);
     RegisterPipeline();
   }
+
+  /** Predict all the variables from one read of each tile of the input */
+  void ExecuteMultiRegression(FloatVectorImageType* inImage, ModelType* model)
+  {
+    const unsigned int nbFeatures = inImage->GetNumberOfComponentsPerPixel();
+
+    auto regressionFilter = MultiRegressionFilterType::New();
+    regressionFilter->AddModel(model);
+    for (const auto& fileName : GetParameterStringList("models"))
+    {
+      otbAppLogINFO("Loading model " << fileName);
+      regressionFilter->AddModel(LoadModel(fileName));
+    }
+    regressionFilter->FuseLabelsOff();
+    const unsigned int nbModels = regressionFilter->GetNumberOfModels();
+
+    FloatVectorImageType* outputImage = regressionFilter->GetOutput();
+
+    // Normalize input image if asked
+    if (IsParameterEnabled("imstat"))
+    {
+      otbAppLogINFO("Input image normalization activated.");
+      auto statisticsReader = StatisticsReader::New();
+      statisticsReader->SetFileName(GetParameterString("imstat"));
+      MeasurementType meanMeasurementVector   = statisticsReader->GetStatisticVectorByName("mean");
+      MeasurementType stddevMeasurementVector = statisticsReader->GetStatisticVectorByName("stddev");
+      otbAppLogINFO("mean used: " << meanMeasurementVector);
+      otbAppLogINFO("standard deviation used: " << stddevMeasurementVector);
+      if (meanMeasurementVector.Size() == nbFeatures + 1 || meanMeasurementVector.Size() == nbFeatures + nbModels)
+      {
+        // Expand each predicted variable: y = x * stddev + mean
+        const bool      sharedStat = meanMeasurementVector.Size() == nbFeatures + 1;
+        MeasurementType outShift(nbModels);
+        MeasurementType outScale(nbModels);
+        for (unsigned int k = 0; k < nbModels; ++k)
+        {
+          const unsigned int band = nbFeatures + (sharedStat ? 0 : k);
+          outShift[k]             = -meanMeasurementVector[band] / stddevMeasurementVector[band];
+          outScale[k]             = 1.0 / stddevMeasurementVector[band];
+        }
+        meanMeasurementVector.SetSize(nbFeatures, false);
+        stddevMeasurementVector.SetSize(nbFeatures, false);
+        auto outRescaler = OutputVectorRescalerType::New();
+        outRescaler->SetInput(regressionFilter->GetOutput());
+        outRescaler->SetShift(outShift);
+        outRescaler->SetScale(outScale);
+        outputImage = outRescaler->GetOutput();
+      }
+      else if (meanMeasurementVector.Size() != nbFeatures)
+      {
+        otbAppLogFATAL("Wrong number of components in statistics file : " << meanMeasurementVector.Size());
+      }
+
+      auto rescaler = RescalerType::New();
+      rescaler->SetScale(stddevMeasurementVector);
+      rescaler->SetShift(meanMeasurementVector);
+      rescaler->SetInput(inImage);
+      regressionFilter->SetInput(rescaler->GetOutput());
+    }
+    else
+    {
+      otbAppLogINFO("Input image normalization deactivated.");
+      regressionFilter->SetInput(inImage);
+    }
+
+    if (IsParameterEnabled("mask"))
+    {
+      otbAppLogINFO("Using input mask");
+      regressionFilter->SetInputMask(GetParameterUInt8Image("mask"));
+    }
+
+    SetParameterOutputImage<FloatVectorImageType>("out", outputImage);
+    RegisterPipeline();
+  }
 };
 }
 }
@@ -23,6 +23,7 @@
 
 #include "otbOGRDataToClassStatisticsFilter.h"
 #include "otbStatisticsXMLFileWriter.h"
+#include "otbProcessGroup.h"
 #include "otbGeometriesProjectionFilter.h"
 #include "otbGeometriesSet.h"
 #include "otbWrapperElevationParametersHandler.h"
@@ -93,7 +94,9 @@ private:
     MandatoryOff("mask");
 
     AddParameter(ParameterType_InputVectorData, "vec", "Input vectors");
-    SetParameterDescription("vec", "Input geometries to analyze");
+    SetParameterDescription("vec",
+                            "Input geometries to analyze. "
+                            "A name starting with memory: designates an in-memory vector data shared with the other applications of the process.");
 
     AddParameter(ParameterType_OutputFilename, "out", "Output XML statistics file");
     SetParameterDescription("out", "Output file to store statistics (XML format)");
@@ -237,6 +240,14 @@ private:
     FilterType::ClassCountMapType&  classCount = filter->GetClassCountOutput()->Get();
     FilterType::PolygonSizeMapType& polySize   = filter->GetPolygonSizeOutput()->Get();
 
+    // With distributed streaming, every process holds the counts: only the
+    // first one writes them
+    const ProcessGroup* group = ProcessGroup::GetDefault();
+    if (group && group->GetRank() != 0)
+    {
+      return;
+    }
+
     StatWriterType::Pointer statWriter = StatWriterType::New();
     statWriter->SetFileName(this->GetParameterString("out"));
     statWriter->AddInputMap<FilterType::ClassCountMapType>("samplesPerClass", classCount);
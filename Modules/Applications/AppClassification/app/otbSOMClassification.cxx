@@ -145,6 +145,11 @@ private:
     SetParameterDescription("iv", "Maximum initial neuron weight");
     MandatoryOff("iv");
 
+    AddParameter(ParameterType_Bool, "batch", "Batch training");
+    SetParameterDescription("batch",
+                            "Learn the training set by epochs instead of sample after sample: the winners of all the samples are searched in parallel, "
+                            "then each neuron moves towards the weighted mean of the samples won by its neighborhood.");
+
     AddRANDParameter();
 
     AddRAMParameter();
@@ -366,6 +371,7 @@ private:
     estimator->SetBetaInit(GetParameterFloat("bi"));
     estimator->SetBetaEnd(GetParameterFloat("bf"));
     estimator->SetMaxWeight(GetParameterFloat("iv"));
+    estimator->SetBatchTraining(GetParameterInt("batch"));
 
     AddProcess(estimator, "Learning");
     estimator->Update();
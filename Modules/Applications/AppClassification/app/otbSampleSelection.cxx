@@ -122,10 +122,14 @@ private:
     MandatoryOff("mask");
 
     AddParameter(ParameterType_InputVectorData, "vec", "Input vectors");
-    SetParameterDescription("vec", "Input geometries to analyse");
+    SetParameterDescription("vec",
+                            "Input geometries to analyse. "
+                            "A name starting with memory: designates an in-memory vector data shared with the other applications of the process.");
 
     AddParameter(ParameterType_OutputFilename, "out", "Output vectors");
-    SetParameterDescription("out", "Output resampled geometries");
+    SetParameterDescription("out",
+                            "Output resampled geometries. "
+                            "A name starting with memory: designates an in-memory vector data shared with the other applications of the process.");
 
     AddParameter(ParameterType_InputFilename, "instats", "Input Statistics");
     SetParameterDescription("instats", "Input file storing statistics (XML format)");
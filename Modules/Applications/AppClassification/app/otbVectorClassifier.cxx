@@ -91,6 +91,13 @@ void VectorClassifier::DoInitSpecialization()
                           "majority classes) is not available for now.\n"
                           "* SVM: distance to margin (only works for 2-class models)\n");
 
+  AddParameter(ParameterType_Int, "chunk", "Number of features per chunk");
+  SetParameterDescription("chunk",
+                          "The features are read, predicted and written by chunks of this number of features, "
+                          "so that the memory used does not depend on the size of the layer.");
+  SetDefaultParameterInt("chunk", 100000);
+  SetMinimumParameterIntValue("chunk", 1);
+
   AddParameter(ParameterType_OutputFilename, "out", "Output vector data file");
   MandatoryOff("out");
   SetParameterDescription("out",
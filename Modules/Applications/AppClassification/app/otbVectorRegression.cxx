@@ -76,6 +76,13 @@ void VectorRegression::DoInitSpecialization()
   SetVectorData("feat", "in");
   SetTypeFilter("feat", {OFTInteger, OFTInteger64, OFTReal});
 
+  AddParameter(ParameterType_Int, "chunk", "Number of features per chunk");
+  SetParameterDescription("chunk",
+                          "The features are read, predicted and written by chunks of this number of features, "
+                          "so that the memory used does not depend on the size of the layer.");
+  SetDefaultParameterInt("chunk", 100000);
+  SetMinimumParameterIntValue("chunk", 1);
+
   AddParameter(ParameterType_OutputFilename, "out", "Output vector data file");
   MandatoryOff("out");
 
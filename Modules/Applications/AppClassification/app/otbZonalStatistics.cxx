@@ -32,7 +32,10 @@
 #include "otbVectorDataToLabelImageFilter.h"
 #include "otbVectorDataIntoImageProjectionFilter.h"
 #include "otbStreamingStatisticsMapFromLabelImageFilter.h"
+#include "otbOGRDataToZonalStatisticsFilter.h"
 #include "otbStatisticsXMLFileWriter.h"
+#include "otbGeometriesProjectionFilter.h"
+#include "otbGeometriesSet.h"
 
 // Raster --> Vector
 #include "otbLabelImageToVectorDataFilter.h"
@@ -69,6 +72,9 @@ public:
   typedef otb::StatisticsXMLFileWriter<FloatVectorImageType::PixelType> StatsWriterType;
   typedef otb::LabelImageToVectorDataFilter<LabelImageType>             LabelImageToVectorFilterType;
   typedef itk::BinaryThresholdImageFilter<LabelImageType, LabelImageType> ThresholdFilterType;
+  typedef otb::OGRDataToZonalStatisticsFilter<FloatVectorImageType>       TiledStatsFilterType;
+  typedef otb::GeometriesSet                                              GeometriesType;
+  typedef otb::GeometriesProjectionFilter                                 ProjectionFilterType;
 
   template <class TInput, class TOutput>
   struct EncoderFunctorType
@@ -141,11 +147,15 @@ public:
         "Zones can be defined with a label image (inzone.labelimage.in) or a vector data layer "
         "(inzone.vector.in). The following statistics are computed over each zones: mean, min, max, "
         "and standard deviation. Statistics can be exported in a vector layer (if the input zone "
-        "definition is a label image, it will be vectorized) or in a XML file");
+        "definition is a label image, it will be vectorized) or in a XML file. "
+        "With inzone.vector.tiled, the polygons are not rasterized over the whole image: each tile only "
+        "reads the polygons it intersects, and overlapping polygons get all the pixels they cover. "
+        "Statistics are then indexed by the FID of the features.");
     SetDocLimitations(
-        "1) The inzone.vector.in must fit in memory (if \"inzone\" is \"vector\"). 2) The vectorized label "
+        "1) The inzone.vector.in must fit in memory (if \"inzone\" is \"vector\", unless "
+        "\"inzone.vector.tiled\" is on and the vectors are in the image projection). 2) The vectorized label "
         "image must also fit in memory (if \"out\" is \"vector\"): if not, consider using \"out\" to "
-        "\"xml\"");
+        "\"xml\". 3) The raster output is not available with \"inzone.vector.tiled\".");
     SetDocAuthors("Remi Cresson, Jordi Inglada");
     SetDocSeeAlso("ComputeImagesStatistics");
 
@@ -165,6 +175,9 @@ public:
     // Input for vector mode
     AddParameter(ParameterType_InputVectorData, "inzone.vector.in", "Input vector data");
     AddParameter(ParameterType_Bool, "inzone.vector.reproject", "Reproject the input vector");
+    AddParameter(ParameterType_Bool, "inzone.vector.tiled", "Compute the statistics tile by tile, without rasterizing the polygons");
+    SetParameterDescription("inzone.vector.tiled",
+                            "Statistics are accumulated per feature while streaming the image, which supports overlapping polygons");
 
 
     // Input for label image mode
@@ -254,6 +267,128 @@ public:
     GetStats();
   }
 
+  /** Tiled vector mode: the features are read from the OGR layer through
+   * the spatial filter of each tile, and their statistics are accumulated
+   * directly, indexed by FID */
+  void ComputeTiledStatistics()
+  {
+    otbAppLogINFO("Zone definition: vector, tile by tile");
+    if (GetParameterAsString("out") == "raster")
+    {
+      otbAppLogFATAL("The raster output is not available with inzone.vector.tiled (polygons may overlap)");
+    }
+
+    m_OGRDataSrc = otb::ogr::DataSource::New(GetParameterAsString("inzone.vector.in"), otb::ogr::DataSource::Modes::Read);
+
+    // Reproject geometries (they are then held in memory)
+    const std::string         imageProjectionRef  = m_InputImage->GetProjectionRef();
+    const std::string         vectorProjectionRef = m_OGRDataSrc->GetLayer(0).GetProjectionRef();
+    const OGRSpatialReference imgOGRSref          = OGRSpatialReference(imageProjectionRef.c_str());
+    const OGRSpatialReference vectorOGRSref       = OGRSpatialReference(vectorProjectionRef.c_str());
+    if (GetParameterInt("inzone.vector.reproject") != 0 && !vectorProjectionRef.empty() && !imageProjectionRef.empty() &&
+        !imgOGRSref.IsSame(&vectorOGRSref))
+    {
+      otbAppLogINFO("Vector data reprojection enabled");
+      otb::ogr::DataSource::Pointer reprojVector  = otb::ogr::DataSource::New();
+      GeometriesType::Pointer       inputGeomSet  = GeometriesType::New(m_OGRDataSrc);
+      GeometriesType::Pointer       outputGeomSet = GeometriesType::New(reprojVector);
+      ProjectionFilterType::Pointer projFilter    = ProjectionFilterType::New();
+      projFilter->SetInput(inputGeomSet);
+      projFilter->SetOutputProjectionRef(imageProjectionRef);
+      projFilter->SetOutput(outputGeomSet);
+      projFilter->Update();
+      m_OGRDataSrc = reprojVector;
+    }
+
+    m_TiledStatsFilter = TiledStatsFilterType::New();
+    m_TiledStatsFilter->SetInput(m_InputImage);
+    m_TiledStatsFilter->SetOGRData(m_OGRDataSrc);
+    m_TiledStatsFilter->SetLayerIndex(0);
+    if (HasUserValue("inbv"))
+    {
+      m_TiledStatsFilter->SetUseNoDataValue(true);
+      m_TiledStatsFilter->SetNoDataValue(GetParameterFloat("inbv"));
+    }
+    m_TiledStatsFilter->GetStreamer()->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+    AddProcess(m_TiledStatsFilter->GetStreamer(), "Computing statistics");
+    m_TiledStatsFilter->Update();
+  }
+
+  void WriteTiledXMLStatsFile()
+  {
+    const std::string outXMLFile = this->GetParameterString("out.xml.filename");
+    otbAppLogINFO("Writing " + outXMLFile);
+    StatsWriterType::Pointer statWriter = StatsWriterType::New();
+    statWriter->SetFileName(outXMLFile);
+    statWriter->AddInputMap<TiledStatsFilterType::FeaturePopulationMapType>("count", m_TiledStatsFilter->GetFeaturePopulationMap());
+    statWriter->AddInputMap<TiledStatsFilterType::PixelValueMapType>("mean", m_TiledStatsFilter->GetMeanValueMap());
+    statWriter->AddInputMap<TiledStatsFilterType::PixelValueMapType>("std", m_TiledStatsFilter->GetStandardDeviationValueMap());
+    statWriter->AddInputMap<TiledStatsFilterType::PixelValueMapType>("min", m_TiledStatsFilter->GetMinValueMap());
+    statWriter->AddInputMap<TiledStatsFilterType::PixelValueMapType>("max", m_TiledStatsFilter->GetMaxValueMap());
+    statWriter->Update();
+  }
+
+  /** Copy the features with statistics and the new fields, one by one */
+  void WriteTiledVectorData()
+  {
+    otbAppLogINFO("Writing output vector data");
+    TiledStatsFilterType::FeaturePopulationMapType countMap = m_TiledStatsFilter->GetFeaturePopulationMap();
+    TiledStatsFilterType::PixelValueMapType        meanMap  = m_TiledStatsFilter->GetMeanValueMap();
+    TiledStatsFilterType::PixelValueMapType        stdMap   = m_TiledStatsFilter->GetStandardDeviationValueMap();
+    TiledStatsFilterType::PixelValueMapType        minMap   = m_TiledStatsFilter->GetMinValueMap();
+    TiledStatsFilterType::PixelValueMapType        maxMap   = m_TiledStatsFilter->GetMaxValueMap();
+
+    otb::ogr::Layer               inLayer  = m_OGRDataSrc->GetLayer(0);
+    otb::ogr::DataSource::Pointer outDS    = otb::ogr::DataSource::New(GetParameterString("out.vector.filename"), otb::ogr::DataSource::Modes::Overwrite);
+    OGRSpatialReference*          oSRS     = inLayer.GetSpatialRef() ? inLayer.GetSpatialRef()->Clone() : nullptr;
+    otb::ogr::Layer               outLayer = outDS->CreateLayer(inLayer.GetName(), oSRS, inLayer.GetGeomType());
+    if (oSRS)
+    {
+      oSRS->Release();
+    }
+
+    OGRFeatureDefn& layerDefn = inLayer.GetLayerDefn();
+    for (int k = 0; k < layerDefn.GetFieldCount(); k++)
+    {
+      OGRFieldDefn fieldDefn(layerDefn.GetFieldDefn(k));
+      outLayer.CreateField(fieldDefn);
+    }
+    std::vector<std::string> statFields(1, "count");
+    for (unsigned int band = 0; band < m_InputImage->GetNumberOfComponentsPerPixel(); band++)
+    {
+      statFields.push_back(CreateFieldName("mean", band));
+      statFields.push_back(CreateFieldName("stdev", band));
+      statFields.push_back(CreateFieldName("min", band));
+      statFields.push_back(CreateFieldName("max", band));
+    }
+    for (const auto& name : statFields)
+    {
+      OGRFieldDefn fieldDefn(name.c_str(), OFTReal);
+      outLayer.CreateField(fieldDefn);
+    }
+
+    for (otb::ogr::Layer::const_iterator featIt = inLayer.begin(); featIt != inLayer.end(); ++featIt)
+    {
+      const unsigned long fid = featIt->GetFID();
+      if (countMap.count(fid) == 0)
+      {
+        continue;
+      }
+      otb::ogr::Feature dstFeature(outLayer.GetLayerDefn());
+      dstFeature.SetFrom(*featIt, TRUE);
+      dstFeature["count"].SetValue(countMap[fid]);
+      for (unsigned int band = 0; band < m_InputImage->GetNumberOfComponentsPerPixel(); band++)
+      {
+        dstFeature[CreateFieldName("mean", band)].SetValue(meanMap[fid][band]);
+        dstFeature[CreateFieldName("stdev", band)].SetValue(stdMap[fid][band]);
+        dstFeature[CreateFieldName("min", band)].SetValue(minMap[fid][band]);
+        dstFeature[CreateFieldName("max", band)].SetValue(maxMap[fid][band]);
+      }
+      outLayer.CreateFeature(dstFeature);
+    }
+    outDS->SyncToDisk();
+  }
+
   void ReprojectVectorDataIntoInputImage()
   {
     otbAppLogINFO("Vector data reprojection enabled");
@@ -430,6 +565,25 @@ public:
   {
     // Get input image
     m_InputImage = GetParameterImage("in");
+
+    // Tiled vector mode, with its own filter and outputs
+    if (GetParameterAsString("inzone") == "vector" && GetParameterInt("inzone.vector.tiled") != 0)
+    {
+      ComputeTiledStatistics();
+      if (GetParameterAsString("out") == "xml")
+      {
+        DisableParameter("out.vector.filename");
+        WriteTiledXMLStatsFile();
+      }
+      else
+      {
+        WriteTiledVectorData();
+        // Already written
+        DisableParameter("out.vector.filename");
+      }
+      DisableParameter("out.raster.filename");
+      return;
+    }
     // Statistics filter
     m_StatsFilter = StatsFilterType::New();
     m_StatsFilter->SetInput(m_InputImage);
@@ -485,6 +639,8 @@ public:
   VectorDataType::Pointer                 m_NewVectorData;
   VectorDataReprojFilterType::Pointer     m_VectorDataReprojectionFilter;
   RasterizeFilterType::Pointer            m_RasterizeFilter;
+  TiledStatsFilterType::Pointer           m_TiledStatsFilter;
+  otb::ogr::DataSource::Pointer           m_OGRDataSrc;
   StatsFilterType::Pointer                m_StatsFilter;
   LabelImageToVectorFilterType::Pointer   m_LabelImageToVectorFilter;
   ThresholdFilterType::Pointer            m_InputThresholdFilter;
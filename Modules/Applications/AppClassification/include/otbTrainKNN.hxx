@@ -39,6 +39,13 @@ void LearningApplicationBase<TInputValue, TOutputValue>::InitKNNParams()
   SetParameterInt("classifier.knn.k", 32);
   SetParameterDescription("classifier.knn.k", "The number of neighbors to use.");
 
+  AddParameter(ParameterType_Bool, "classifier.knn.kdtree", "Index the samples in a KD-tree");
+  SetParameterDescription("classifier.knn.kdtree",
+                          "Find the neighbors with a KD-tree of the training samples instead of "
+                          "comparing each sample to all of them. The result is the same, and the "
+                          "prediction is much faster for a large number of training samples with "
+                          "few features.");
+
   if (this->m_RegressionFlag)
   {
     // Decision rule : mean / median
@@ -63,6 +70,7 @@ void LearningApplicationBase<TInputValue, TOutputValue>::TrainKNN(typename ListS
   knnClassifier->SetInputListSample(trainingListSample);
   knnClassifier->SetTargetListSample(trainingLabeledListSample);
   knnClassifier->SetK(GetParameterInt("classifier.knn.k"));
+  knnClassifier->SetUseKDTree(GetParameterInt("classifier.knn.kdtree"));
   if (this->m_RegressionFlag)
   {
     std::string decision = this->GetParameterString("classifier.knn.rule");
@@ -86,6 +86,18 @@ void LearningApplicationBase<TInputValue, TOutputValue>::InitRandomForestsParams
 
 
   // TerminationCriteria not exposed
+
+  // BinaryModel
+  AddParameter(ParameterType_Bool, "classifier.rf.binary", "Save the model in binary format");
+  SetParameterDescription("classifier.rf.binary",
+                          "Save the trained forest in a compact binary format, which loads much faster than the default text format. "
+                          "Only available for classification.");
+
+  // HalfPrecisionThresholds
+  AddParameter(ParameterType_Bool, "classifier.rf.half", "Half precision thresholds");
+  SetParameterDescription("classifier.rf.half",
+                          "Store the split thresholds of the binary model as half precision floats, which makes the model smaller. "
+                          "Decisions may change for feature values very close to a threshold.");
 }
 
 template <class TInputValue, class TOutputValue>
@@ -106,6 +118,14 @@ void LearningApplicationBase<TInputValue, TOutputValue>::TrainRandomForests(type
   classifier->SetMaxNumberOfTrees(GetParameterInt("classifier.rf.nbtrees"));
   classifier->SetForestAccuracy(GetParameterFloat("classifier.rf.acc"));
 
+  if (GetParameterInt("classifier.rf.binary"))
+  {
+    if (this->m_RegressionFlag)
+      otbAppLogFATAL("Binary random forest models are only available for classification");
+    classifier->SetBinaryModel(true);
+    classifier->SetHalfPrecisionThresholds(GetParameterInt("classifier.rf.half"));
+  }
+
   classifier->Train();
   classifier->Save(modelPath);
 }
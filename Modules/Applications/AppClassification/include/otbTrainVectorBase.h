@@ -26,6 +26,8 @@
 
 #include "otbOGRDataSourceWrapper.h"
 #include "otbOGRFeatureWrapper.h"
+#include "otbSampleTable.h"
+#include "otbDenseSampleMatrix.h"
 #include "otbStatisticsXMLFileWriter.h"
 
 #include "itkVariableLengthVector.h"
@@ -67,6 +69,8 @@ public:
 
   typedef otb::Statistics::ShiftScaleSampleListFilter<ListSampleType, ListSampleType> ShiftScaleFilterType;
 
+  typedef otb::DenseSampleMatrix<typename ListSampleType::MeasurementVectorType::ValueType> SampleMatrixType;
+
 protected:
   /** Class used to store statistics Measurement (mean/stddev) */
   class ShiftScaleParameters
@@ -163,6 +167,10 @@ protected:
    */
   SamplesWithLabel ExtractSamplesWithLabel(std::string parameterName, std::string parameterLayer, const ShiftScaleParameters& measurement);
 
+  /** Append the selected features and label of the samples of a sample file
+   * (see SampleTable) to input and target */
+  void ReadSampleTable(const std::string& fileName, SampleMatrixType* input, TargetListSampleType* target);
+
 
   /**
    * Retrieve statistics mean and standard deviation if input statistics are provided.
@@ -35,7 +35,10 @@ void TrainVectorBase<TInputValue, TOutputValue>::DoInit()
   this->SetParameterDescription("io", "This group of parameters allows setting input and output data.");
 
   this->AddParameter(ParameterType_InputVectorDataList, "io.vd", "Input Vector Data");
-  this->SetParameterDescription("io.vd", "Input geometries used for training (note: all geometries from the layer will be used)");
+  this->SetParameterDescription("io.vd",
+                                "Input geometries used for training (note: all geometries from the layer will be used). "
+                                "Sample files (.samples) written by SampleExtraction are also accepted. "
+                                "A name starting with memory: designates an in-memory vector data shared with the other applications of the process.");
 
   this->AddParameter(ParameterType_InputFilename, "io.stats", "Input XML image statistics file");
   this->MandatoryOff("io.stats");
@@ -101,7 +104,22 @@ template <class TInputValue, class TOutputValue>
 void TrainVectorBase<TInputValue, TOutputValue>::DoUpdateParameters()
 {
   // if vector data is present and updated then reload fields
-  if (this->HasValue("io.vd"))
+  if (this->HasValue("io.vd") && SampleTable::CanRead(this->GetParameterStringList("io.vd")[0]))
+  {
+    // Sample files only hold numerical columns
+    this->ClearChoices("feat");
+    this->ClearChoices("cfield");
+    for (const auto& item : SampleTable::ReadColumnNames(this->GetParameterStringList("io.vd")[0]))
+    {
+      std::string           key = item;
+      std::string::iterator end = std::remove_if(key.begin(), key.end(), [](char c) { return !std::isalnum(c); });
+      std::transform(key.begin(), end, key.begin(), tolower);
+      key = key.substr(0, static_cast<unsigned long>(end - key.begin()));
+      this->AddChoice("feat." + key, item);
+      this->AddChoice("cfield." + key, item);
+    }
+  }
+  else if (this->HasValue("io.vd"))
   {
     std::vector<std::string> vectorFileList = this->GetParameterStringList("io.vd");
     ogr::DataSource::Pointer ogrDS          = ogr::DataSource::New(vectorFileList[0], ogr::DataSource::Modes::Read);
@@ -228,13 +246,22 @@ TrainVectorBase<TInputValue, TOutputValue>::ExtractSamplesWithLabel(std::string
   SamplesWithLabel samplesWithLabel;
   if (this->HasValue(parameterName) && this->IsParameterEnabled(parameterName))
   {
-    typename ListSampleType::Pointer       input  = ListSampleType::New();
+    // Samples are gathered in one contiguous buffer and normalized in place,
+    // the ListSample is only built once at the end.
+    typename SampleMatrixType::Pointer     input  = SampleMatrixType::New();
     typename TargetListSampleType::Pointer target = TargetListSampleType::New();
-    input->SetMeasurementVectorSize(m_FeaturesInfo.m_NbFeatures);
+    input->SetNumberOfFeatures(m_FeaturesInfo.m_NbFeatures);
 
     std::vector<std::string> fileList = this->GetParameterStringList(parameterName);
     for (unsigned int k = 0; k < fileList.size(); k++)
     {
+      if (SampleTable::CanRead(fileList[k]))
+      {
+        otbAppLogINFO("Reading sample file " << k + 1 << "/" << fileList.size());
+        ReadSampleTable(fileList[k], input, target);
+        continue;
+      }
+
       otbAppLogINFO("Reading vector file " << k + 1 << "/" << fileList.size());
       ogr::DataSource::Pointer source  = ogr::DataSource::New(fileList[k], ogr::DataSource::Modes::Read);
       ogr::Layer               layer   = source->GetLayer(static_cast<size_t>(this->GetParameterInt(parameterLayer)));
@@ -264,31 +291,32 @@ TrainVectorBase<TInputValue, TOutputValue>::ExtractSamplesWithLabel(std::string
       }
 
 
+      const GIntBig featureCount = layer.ogr().GetFeatureCount(FALSE);
+      if (featureCount > 0)
+        input->Reserve(input->GetNumberOfSamples() + featureCount);
+
       while (goesOn)
       {
         // Retrieve all the features for each field in the ogr layer.
-        MeasurementType mv;
-        mv.SetSize(m_FeaturesInfo.m_NbFeatures);
+        typename SampleMatrixType::ValueType* mv = input->PushBack();
         for (unsigned int idx = 0; idx < m_FeaturesInfo.m_NbFeatures; ++idx)
         {
           switch (feature[featureFieldIndex[idx]].GetType())
           {
           case OFTInteger:
-            mv[idx] = static_cast<ValueType>(feature[featureFieldIndex[idx]].GetValue<int>());
+            mv[idx] = static_cast<typename SampleMatrixType::ValueType>(feature[featureFieldIndex[idx]].GetValue<int>());
             break;
           case OFTInteger64:
-            mv[idx] = static_cast<ValueType>(feature[featureFieldIndex[idx]].GetValue<int>());
+            mv[idx] = static_cast<typename SampleMatrixType::ValueType>(feature[featureFieldIndex[idx]].GetValue<int>());
             break;
           case OFTReal:
-            mv[idx] = static_cast<ValueType>(feature[featureFieldIndex[idx]].GetValue<double>());
+            mv[idx] = static_cast<typename SampleMatrixType::ValueType>(feature[featureFieldIndex[idx]].GetValue<double>());
             break;
           default:
             itkExceptionMacro(<< "incorrect field type: " << feature[featureFieldIndex[idx]].GetType() << ".");
           }
         }
 
-        input->PushBack(mv);
-
         if (cFieldIndex >= 0 && ogr::Field(feature, cFieldIndex).HasBeenSet())
         {
           switch (feature[cFieldIndex].GetType())
@@ -318,19 +346,46 @@ TrainVectorBase<TInputValue, TOutputValue>::ExtractSamplesWithLabel(std::string
     }
 
 
-    typename ShiftScaleFilterType::Pointer shiftScaleFilter = ShiftScaleFilterType::New();
-    shiftScaleFilter->SetInput(input);
-    shiftScaleFilter->SetShifts(measurement.meanMeasurementVector);
-    shiftScaleFilter->SetScales(measurement.stddevMeasurementVector);
-    shiftScaleFilter->Update();
+    input->ShiftScale(measurement.meanMeasurementVector, measurement.stddevMeasurementVector);
 
-    samplesWithLabel.listSample        = shiftScaleFilter->GetOutput();
+    samplesWithLabel.listSample        = input->ToListSample();
     samplesWithLabel.labeledListSample = target;
-    samplesWithLabel.listSample->DisconnectPipeline();
   }
 
   return samplesWithLabel;
 }
+template <class TInputValue, class TOutputValue>
+void TrainVectorBase<TInputValue, TOutputValue>::ReadSampleTable(const std::string& fileName, SampleMatrixType* input, TargetListSampleType* target)
+{
+  SampleTable::Pointer table = SampleTable::New();
+  table->Read(fileName);
+
+  const int cFieldIndex = table->GetColumnIndex(m_FeaturesInfo.m_SelectedCFieldName);
+  if (cFieldIndex < 0 && !m_FeaturesInfo.m_SelectedCFieldName.empty())
+  {
+    otbAppLogFATAL("The field name for class label (" << m_FeaturesInfo.m_SelectedCFieldName << ") has not been found in the sample file " << fileName);
+  }
+
+  std::vector<const SampleTable::ColumnType*> featureColumns(m_FeaturesInfo.m_NbFeatures);
+  for (unsigned int i = 0; i < m_FeaturesInfo.m_NbFeatures; i++)
+  {
+    const int index = table->GetColumnIndex(m_FeaturesInfo.m_SelectedNames[i]);
+    if (index < 0)
+      otbAppLogFATAL("The field name for feature " << m_FeaturesInfo.m_SelectedNames[i] << " has not been found in the sample file " << fileName);
+    featureColumns[i] = &table->GetColumn(index);
+  }
+
+  input->Reserve(input->GetNumberOfSamples() + table->GetNumberOfRows());
+  for (unsigned long row = 0; row < table->GetNumberOfRows(); ++row)
+  {
+    typename SampleMatrixType::ValueType* mv = input->PushBack();
+    for (unsigned int idx = 0; idx < m_FeaturesInfo.m_NbFeatures; ++idx)
+    {
+      mv[idx] = static_cast<typename SampleMatrixType::ValueType>((*featureColumns[idx])[row]);
+    }
+    target->PushBack(cFieldIndex >= 0 ? static_cast<ValueType>(table->GetColumn(cFieldIndex)[row]) : 0.);
+  }
+}
 }
 }
 
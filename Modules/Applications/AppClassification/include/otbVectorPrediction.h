@@ -38,6 +38,7 @@
 #include "otbMachineLearningModel.h"
 
 #include <time.h>
+#include <vector>
 
 namespace otb
 {
@@ -98,16 +99,18 @@ private:
   /** Method returning whether the confidence map should be computed, depending on the regression mode and input parameters */
   bool shouldComputeConfidenceMap() const;
 
-  /** Method returning the input list sample from the input layer */
-  typename ListSampleType::Pointer ReadInputListSample(otb::ogr::Layer const& layer);
+  /** Method returning the indices of the feature fields in the input layer */
+  std::vector<int> GetFeatureFieldIndices(otb::ogr::Layer const& layer);
+
+  /** Method returning the input list sample of a chunk of features */
+  typename ListSampleType::Pointer ReadInputListSample(std::vector<ogr::Feature> const& features, std::vector<int> const& featureFieldIndex);
+
+  /** Read the shift and scale of the features from the statistic file given */
+  void ReadStatistics();
 
   /** Normalize a list sample using the statistic file given  */
   typename ListSampleType::Pointer NormalizeListSample(ListSampleType::Pointer input);
 
-  /** Update the output DataSource : the input layer is buffered and the input data source is re opened in update mode. */
-  otb::ogr::DataSource::Pointer ReopenDataSourceInUpdateMode(ogr::DataSource::Pointer source, ogr::Layer& layer,
-                                                             ogr::DataSource::Pointer buffer);
-
   /** Create the output DataSource. */
   otb::ogr::DataSource::Pointer CreateOutputDataSource(ogr::Layer& layer);
 
@@ -116,12 +119,23 @@ private:
    * added. */
   void AddPredictionField(otb::ogr::Layer& outLayer, otb::ogr::Layer const& layer, bool computeConfidenceMap);
 
-  /** Fill the output layer with the predicted values and optionally the confidence */
-  void FillOutputLayer(otb::ogr::Layer& outLayer, otb::ogr::Layer const& layer, typename LabelListSampleType::Pointer target,
+  /** Fill the output layer with the predicted values of a chunk of features and optionally the confidence.
+   * In update mode, the features are updated in place. */
+  void FillOutputLayer(otb::ogr::Layer& outLayer, std::vector<ogr::Feature>& features, typename LabelListSampleType::Pointer target,
                        typename ConfidenceListSampleType::Pointer quality, bool updateMode, bool computeConfidenceMap);
 
+  /** Start a transaction on the layer */
+  void StartTransaction(otb::ogr::Layer& layer);
+
+  /** Commit the transaction started on the layer, if the layer supports transactions */
+  void CommitTransaction(otb::ogr::Layer& layer);
+
   ModelPointerType m_Model;
 
+  /** Shift and scale of the features */
+  MeasurementType m_MeanMeasurementVector;
+  MeasurementType m_StddevMeasurementVector;
+
   /** Name used for the confidence field */
   std::string confFieldName = "confidence";
 };
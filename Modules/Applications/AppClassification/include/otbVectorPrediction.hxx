@@ -39,6 +39,7 @@ void           VectorPrediction<RegressionMode>::DoInit()
   assert(GetParameterByKey("model") != nullptr);
   assert(GetParameterByKey("cfield") != nullptr);
   assert(GetParameterByKey("feat") != nullptr);
+  assert(GetParameterByKey("chunk") != nullptr);
   assert(GetParameterByKey("out") != nullptr);
 }
 
@@ -75,30 +76,34 @@ void           VectorPrediction<RegressionMode>::DoUpdateParameters()
 }
 
 template <bool RegressionMode>
-typename VectorPrediction<RegressionMode>::ListSampleType::Pointer
-VectorPrediction<RegressionMode>
-::ReadInputListSample(otb::ogr::Layer const& layer)
+std::vector<int> VectorPrediction<RegressionMode>::GetFeatureFieldIndices(otb::ogr::Layer const& layer)
 {
-  typename ListSampleType::Pointer input = ListSampleType::New();
-
-  const auto nbFeatures = GetSelectedItems("feat").size();
-  input->SetMeasurementVectorSize(nbFeatures);
+  const auto       nbFeatures = GetSelectedItems("feat").size();
   std::vector<int> featureFieldIndex(nbFeatures, -1);
 
-  ogr::Layer::const_iterator it_feat = layer.cbegin();
+  OGRFeatureDefn& layerDefn = layer.GetLayerDefn();
   for (unsigned int i = 0; i < nbFeatures; i++)
   {
-    try
+    const std::string fieldName = GetChoiceNames("feat")[GetSelectedItems("feat")[i]];
+    featureFieldIndex[i]        = layerDefn.GetFieldIndex(fieldName.c_str());
+    if (featureFieldIndex[i] < 0)
     {
-    featureFieldIndex[i] = (*it_feat).GetFieldIndex(GetChoiceNames("feat")[GetSelectedItems("feat")[i]]);
-    }
-    catch(...)
-    {
-    otbAppLogFATAL("The field name for feature " << GetChoiceNames("feat")[GetSelectedItems("feat")[i]] << " has not been found" << std::endl);
+      otbAppLogFATAL("The field name for feature " << fieldName << " has not been found" << std::endl);
     }
   }
+  return featureFieldIndex;
+}
 
-  for (auto const& feature : layer)
+template <bool RegressionMode>
+typename VectorPrediction<RegressionMode>::ListSampleType::Pointer
+VectorPrediction<RegressionMode>::ReadInputListSample(std::vector<ogr::Feature> const& features, std::vector<int> const& featureFieldIndex)
+{
+  typename ListSampleType::Pointer input = ListSampleType::New();
+
+  const auto nbFeatures = featureFieldIndex.size();
+  input->SetMeasurementVectorSize(nbFeatures);
+
+  for (auto const& feature : features)
   {
     MeasurementType mv(nbFeatures);
     for (unsigned int idx = 0; idx < nbFeatures; ++idx)
@@ -122,62 +127,43 @@ VectorPrediction<RegressionMode>
   return input;
 }
 
-
-template <bool                                                     RegressionMode>
-typename VectorPrediction<RegressionMode>::ListSampleType::Pointer VectorPrediction<RegressionMode>::NormalizeListSample(ListSampleType::Pointer input)
+template <bool RegressionMode>
+void VectorPrediction<RegressionMode>::ReadStatistics()
 {
   const int nbFeatures = GetSelectedItems("feat").size();
 
   // Statistics for shift/scale
-  MeasurementType meanMeasurementVector;
-  MeasurementType stddevMeasurementVector;
   if (HasValue("instat") && IsParameterEnabled("instat"))
   {
     typename StatisticsReader::Pointer statisticsReader = StatisticsReader::New();
     std::string                        XMLfile          = GetParameterString("instat");
     statisticsReader->SetFileName(XMLfile);
-    meanMeasurementVector   = statisticsReader->GetStatisticVectorByName("mean");
-    stddevMeasurementVector = statisticsReader->GetStatisticVectorByName("stddev");
+    m_MeanMeasurementVector   = statisticsReader->GetStatisticVectorByName("mean");
+    m_StddevMeasurementVector = statisticsReader->GetStatisticVectorByName("stddev");
   }
   else
   {
-    meanMeasurementVector.SetSize(nbFeatures);
-    meanMeasurementVector.Fill(0.);
-    stddevMeasurementVector.SetSize(nbFeatures);
-    stddevMeasurementVector.Fill(1.);
+    m_MeanMeasurementVector.SetSize(nbFeatures);
+    m_MeanMeasurementVector.Fill(0.);
+    m_StddevMeasurementVector.SetSize(nbFeatures);
+    m_StddevMeasurementVector.Fill(1.);
   }
+  otbAppLogINFO("mean used: " << m_MeanMeasurementVector);
+  otbAppLogINFO("standard deviation used: " << m_StddevMeasurementVector);
+}
 
+template <bool                                                     RegressionMode>
+typename VectorPrediction<RegressionMode>::ListSampleType::Pointer VectorPrediction<RegressionMode>::NormalizeListSample(ListSampleType::Pointer input)
+{
   typename ShiftScaleFilterType::Pointer trainingShiftScaleFilter = ShiftScaleFilterType::New();
   trainingShiftScaleFilter->SetInput(input);
-  trainingShiftScaleFilter->SetShifts(meanMeasurementVector);
-  trainingShiftScaleFilter->SetScales(stddevMeasurementVector);
+  trainingShiftScaleFilter->SetShifts(m_MeanMeasurementVector);
+  trainingShiftScaleFilter->SetScales(m_StddevMeasurementVector);
   trainingShiftScaleFilter->Update();
-  otbAppLogINFO("mean used: " << meanMeasurementVector);
-  otbAppLogINFO("standard deviation used: " << stddevMeasurementVector);
-
-  otbAppLogINFO("Loading model");
 
   return trainingShiftScaleFilter->GetOutput();
 }
 
-
-template <bool                RegressionMode>
-otb::ogr::DataSource::Pointer VectorPrediction<RegressionMode>::ReopenDataSourceInUpdateMode(ogr::DataSource::Pointer source, ogr::Layer& layer,
-                                                                                             ogr::DataSource::Pointer buffer)
-{
-  ogr::DataSource::Pointer output;
-  // Update mode
-  otbAppLogINFO("Update input vector data.");
-  // fill temporary buffer for the transfer
-  otb::ogr::Layer inputLayer = layer;
-  layer                      = buffer->CopyLayer(inputLayer, std::string("Buffer"));
-  // close input data source
-  source->Clear();
-  // Re-open input data source in update mode
-  output = otb::ogr::DataSource::New(GetParameterString("in"), otb::ogr::DataSource::Modes::Update_LayerUpdate);
-  return output;
-}
-
 template <bool                RegressionMode>
 otb::ogr::DataSource::Pointer VectorPrediction<RegressionMode>::CreateOutputDataSource(ogr::Layer& layer)
 {
@@ -236,16 +222,22 @@ void VectorPrediction<RegressionMode>::AddPredictionField(otb::ogr::Layer& outLa
 }
 
 template <bool RegressionMode>
-void VectorPrediction<RegressionMode>::FillOutputLayer(otb::ogr::Layer& outLayer, otb::ogr::Layer const& layer, typename LabelListSampleType::Pointer target,
-                                                       typename ConfidenceListSampleType::Pointer quality, bool updateMode, bool computeConfidenceMap)
+void VectorPrediction<RegressionMode>::FillOutputLayer(otb::ogr::Layer& outLayer, std::vector<ogr::Feature>& features,
+                                                       typename LabelListSampleType::Pointer target, typename ConfidenceListSampleType::Pointer quality,
+                                                       bool updateMode, bool computeConfidenceMap)
 {
   unsigned int count          = 0;
   std::string  classfieldname = GetParameterString("cfield");
-  for (auto const& feature : layer)
+  for (auto& feature : features)
   {
-    ogr::Feature dstFeature(outLayer.GetLayerDefn());
-    dstFeature.SetFrom(feature, TRUE);
-    dstFeature.SetFID(feature.GetFID());
+    // In update mode, the features read from the layer already have the prediction fields
+    ogr::Feature dstFeature = feature;
+    if (!updateMode)
+    {
+      dstFeature = ogr::Feature(outLayer.GetLayerDefn());
+      dstFeature.SetFrom(feature, TRUE);
+      dstFeature.SetFID(feature.GetFID());
+    }
     auto field = dstFeature[classfieldname];
     switch (field.GetType())
     {
@@ -276,6 +268,29 @@ void VectorPrediction<RegressionMode>::FillOutputLayer(otb::ogr::Layer& outLayer
   }
 }
 
+template <bool RegressionMode>
+void VectorPrediction<RegressionMode>::StartTransaction(otb::ogr::Layer& layer)
+{
+  OGRErr errStart = layer.ogr().StartTransaction();
+  if (errStart != OGRERR_NONE)
+  {
+    itkExceptionMacro(<< "Unable to start transaction for OGR layer " << layer.ogr().GetName() << ".");
+  }
+}
+
+template <bool RegressionMode>
+void VectorPrediction<RegressionMode>::CommitTransaction(otb::ogr::Layer& layer)
+{
+  if (layer.ogr().TestCapability("Transactions"))
+  {
+    const OGRErr errCommitX = layer.ogr().CommitTransaction();
+    if (errCommitX != OGRERR_NONE)
+    {
+      itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << layer.ogr().GetName() << ".");
+    }
+  }
+}
+
 template <bool RegressionMode>
 void           VectorPrediction<RegressionMode>::DoExecute()
 {
@@ -291,65 +306,90 @@ void           VectorPrediction<RegressionMode>::DoExecute()
   m_Model->Load(GetParameterString("model"));
   otbAppLogINFO("Model loaded");
 
-  auto shapefileName = GetParameterString("in");
-
-  ogr::DataSource::Pointer source  = ogr::DataSource::New(shapefileName, ogr::DataSource::Modes::Read);
-  auto layer  = source->GetLayer(0);
-  auto input = ReadInputListSample(layer);
+  ReadStatistics();
 
-  ListSampleType::Pointer listSample = NormalizeListSample(input);
-  typename LabelListSampleType::Pointer target;
+  // The quality listSample containing confidence values is only used when
+  // computeConfidenceMap evaluates to true. It is also used in FillOutputLayer(...)
+  const bool computeConfidenceMap = shouldComputeConfidenceMap();
+  const bool updateMode           = !(IsParameterEnabled("out") && HasValue("out"));
 
-  // The quality listSample containing confidence values is defined here, but is only used when
-  // computeConfidenceMap evaluates to true. This listSample is also used in FillOutputLayer(...)
-  const bool                                 computeConfidenceMap = shouldComputeConfidenceMap();
-  typename ConfidenceListSampleType::Pointer quality;
+  auto shapefileName = GetParameterString("in");
 
-  if (computeConfidenceMap)
+  ogr::DataSource::Pointer source;
+  ogr::DataSource::Pointer output;
+  if (updateMode)
   {
-    quality = ConfidenceListSampleType::New();
-    target  = m_Model->PredictBatch(listSample, quality);
+    // in update mode, the predictions are written in place in the input layer
+    otbAppLogINFO("Update input vector data.");
+    source = ogr::DataSource::New(shapefileName, ogr::DataSource::Modes::Update_LayerUpdate);
+    output = source;
   }
   else
   {
-    target = m_Model->PredictBatch(listSample);
+    source          = ogr::DataSource::New(shapefileName, ogr::DataSource::Modes::Read);
+    auto inputLayer = source->GetLayer(0);
+    output          = CreateOutputDataSource(inputLayer);
   }
 
-  const bool updateMode = !(IsParameterEnabled("out") && HasValue("out"));
+  auto                   layer             = source->GetLayer(0);
+  otb::ogr::Layer        outLayer          = output->GetLayer(0);
+  const std::vector<int> featureFieldIndex = GetFeatureFieldIndices(layer);
 
-  ogr::DataSource::Pointer buffer;
-  ogr::DataSource::Pointer output;
+  AddPredictionField(outLayer, layer, computeConfidenceMap);
 
+  // In update mode, a commit may reset the reading of the layer with some
+  // drivers (e.g. SQLite), so a single transaction covers all the chunks
   if (updateMode)
   {
-    // in update mode, output is added to input data source.
-    // buffer needs to be allocated here, as its life-cycle is bound to "layer"
-    buffer = ogr::DataSource::New();
-    output = ReopenDataSourceInUpdateMode(source, layer, buffer);
-  }
-  else
-  {
-    output = CreateOutputDataSource(layer);
+    StartTransaction(outLayer);
   }
 
-  otb::ogr::Layer outLayer = output->GetLayer(0);
+  // Chunks of features are read, normalized, predicted (in parallel by
+  // PredictBatch) and written in turn, so that the memory footprint is bounded
+  const std::size_t         chunkSize = GetParameterInt("chunk");
+  std::vector<ogr::Feature> features;
+  features.reserve(chunkSize);
+  std::size_t nbPredicted = 0;
 
-  OGRErr errStart = outLayer.ogr().StartTransaction();
-  if (errStart != OGRERR_NONE)
+  for (auto featIt = layer.begin(); featIt != layer.end();)
   {
-    itkExceptionMacro(<< "Unable to start transaction for OGR layer " << outLayer.ogr().GetName() << ".");
-  }
+    features.clear();
+    for (; featIt != layer.end() && features.size() < chunkSize; ++featIt)
+    {
+      features.push_back(*featIt);
+    }
 
-  AddPredictionField(outLayer, layer, computeConfidenceMap);
-  FillOutputLayer(outLayer, layer, target, quality, updateMode, computeConfidenceMap);
+    ListSampleType::Pointer               listSample = NormalizeListSample(ReadInputListSample(features, featureFieldIndex));
+    typename LabelListSampleType::Pointer target;
 
-  if (outLayer.ogr().TestCapability("Transactions"))
-  {
-    const OGRErr errCommitX = outLayer.ogr().CommitTransaction();
-    if (errCommitX != OGRERR_NONE)
+    typename ConfidenceListSampleType::Pointer quality;
+    if (computeConfidenceMap)
+    {
+      quality = ConfidenceListSampleType::New();
+      target  = m_Model->PredictBatch(listSample, quality);
+    }
+    else
     {
-      itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << outLayer.ogr().GetName() << ".");
+      target = m_Model->PredictBatch(listSample);
     }
+
+    if (!updateMode)
+    {
+      StartTransaction(outLayer);
+    }
+    FillOutputLayer(outLayer, features, target, quality, updateMode, computeConfidenceMap);
+    if (!updateMode)
+    {
+      CommitTransaction(outLayer);
+    }
+
+    nbPredicted += features.size();
+    otbAppLogINFO(<< nbPredicted << " features predicted");
+  }
+
+  if (updateMode)
+  {
+    CommitTransaction(outLayer);
   }
 
   output->SyncToDisk();
@@ -29,6 +29,9 @@
 #include "otbImageToSIFTKeyPointSetFilter.h"
 #endif
 #include "otbImageToSURFKeyPointSetFilter.h"
+#include "otbStructureTensorHarrisImageFilter.h"
+#include "otbStreamingLocalMaximaImageToPointSetFilter.h"
+#include "otbHistogramOfOrientedGradientCovariantImageFunction.h"
 #include "otbKeyPointSetsMatchingFilter.h"
 #include "otbMultiToMonoChannelExtractROI.h"
 #include "otbKeyPointSetsMatchingFilter.h"
@@ -37,6 +40,9 @@
 #include "otbOGRDataSourceWrapper.h"
 #include "ogrsf_frmts.h"
 
+#include <future>
+#include <vector>
+
 namespace otb
 {
 namespace Wrapper
@@ -64,6 +70,10 @@ public:
 
   typedef ImageToSURFKeyPointSetFilter<FloatImageType, PointSetType> SurfFilterType;
 
+  typedef StructureTensorHarrisImageFilter<FloatImageType, FloatImageType> HarrisFilterType;
+  typedef StreamingLocalMaximaImageToPointSetFilter<FloatImageType>         HarrisMaximaFilterType;
+  typedef HistogramOfOrientedGradientCovariantImageFunction<FloatImageType> HarrisDescriptorFunctionType;
+
   typedef itk::Statistics::EuclideanDistanceMetric<RealVectorType> DistanceType;
   typedef otb::KeyPointSetsMatchingFilter<PointSetType, DistanceType> MatchingFilterType;
 
@@ -84,7 +94,7 @@ private:
     SetDescription("Compute homologous points between images using keypoints");
     SetDocLongDescription(
         "This application computes homologous points between images using keypoints. "
-        " SIFT or SURF keypoints can be used and the band on which keypoints are computed can be set independently for both images."
+        " SIFT, SURF or Harris keypoints can be used and the band on which keypoints are computed can be set independently for both images."
         " The application offers two modes:"
         " the first is the full mode where keypoints are extracted from the full extent of both images"
         " (please note that in this mode large image file are not supported). "
@@ -134,6 +144,41 @@ private:
 
     AddChoice("algorithm.surf", "SURF algorithm");
     AddChoice("algorithm.sift", "SIFT algorithm");
+    AddChoice("algorithm.harris", "Harris corners");
+    SetParameterDescription("algorithm.harris",
+                            "Corners detected by the Harris detector and a non-maximum suppression, both computed tile by tile, "
+                            "and described by the histograms of oriented gradients around them. "
+                            "Much faster than SIFT and SURF, but neither scale nor rotation invariant.");
+
+    AddParameter(ParameterType_Float, "algorithm.harris.sigmad", "Derivation scale");
+    SetParameterDescription("algorithm.harris.sigmad", "Standard deviation of the gaussian derivation kernel, in pixels");
+    SetDefaultParameterFloat("algorithm.harris.sigmad", 1.);
+    SetMinimumParameterFloatValue("algorithm.harris.sigmad", 0.1);
+
+    AddParameter(ParameterType_Float, "algorithm.harris.sigmai", "Integration scale");
+    SetParameterDescription("algorithm.harris.sigmai", "Standard deviation of the gaussian smoothing of the structure tensor, in pixels");
+    SetDefaultParameterFloat("algorithm.harris.sigmai", 1.5);
+    SetMinimumParameterFloatValue("algorithm.harris.sigmai", 0.1);
+
+    AddParameter(ParameterType_Float, "algorithm.harris.alpha", "Alpha");
+    SetParameterDescription("algorithm.harris.alpha", "Weight of the squared trace in the Harris response");
+    SetDefaultParameterFloat("algorithm.harris.alpha", 0.04);
+    SetMinimumParameterFloatValue("algorithm.harris.alpha", 0.);
+
+    AddParameter(ParameterType_Int, "algorithm.harris.radius", "Non-maximum suppression radius");
+    SetParameterDescription("algorithm.harris.radius", "Corners closer than this radius to a stronger one are discarded");
+    SetDefaultParameterInt("algorithm.harris.radius", 3);
+    SetMinimumParameterIntValue("algorithm.harris.radius", 1);
+
+    AddParameter(ParameterType_Int, "algorithm.harris.nbpoints", "Maximum number of corners");
+    SetParameterDescription("algorithm.harris.nbpoints", "Number of strongest corners kept in each image (or bin), all of them when 0");
+    SetDefaultParameterInt("algorithm.harris.nbpoints", 1000);
+    SetMinimumParameterIntValue("algorithm.harris.nbpoints", 0);
+
+    AddParameter(ParameterType_Int, "algorithm.harris.descradius", "Descriptor radius");
+    SetParameterDescription("algorithm.harris.descradius", "Radius of the neighborhood of the histograms of oriented gradients");
+    SetDefaultParameterInt("algorithm.harris.descradius", 8);
+    SetMinimumParameterIntValue("algorithm.harris.descradius", 2);
 
     AddParameter(ParameterType_Float, "threshold", "Distance threshold for matching");
     SetParameterDescription("threshold", "The distance threshold for matching.");
@@ -143,6 +188,28 @@ private:
     AddParameter(ParameterType_Bool, "backmatching", "Use back-matching to filter matches");
     SetParameterDescription("backmatching", "If set to true, matches should be consistent in both ways.");
 
+    AddParameter(ParameterType_Choice, "matcher", "Keypoints matching method");
+    SetParameterDescription("matcher", "Choice of the nearest neighbor search used to match keypoints");
+
+    AddChoice("matcher.exact", "Exhaustive search");
+    SetParameterDescription("matcher.exact", "Compare each keypoint of image 1 with all the keypoints of image 2");
+
+    AddChoice("matcher.kdforest", "Randomized kd-trees");
+    SetParameterDescription("matcher.kdforest",
+                            "Approximate search in a forest of randomized kd-trees built on keypoint descriptors, "
+                            "much faster than the exhaustive search with many keypoints");
+
+    AddParameter(ParameterType_Int, "matcher.kdforest.trees", "Number of trees");
+    SetParameterDescription("matcher.kdforest.trees", "Number of randomized kd-trees");
+    SetDefaultParameterInt("matcher.kdforest.trees", 4);
+    SetMinimumParameterIntValue("matcher.kdforest.trees", 1);
+
+    AddParameter(ParameterType_Int, "matcher.kdforest.checks", "Maximum number of checks");
+    SetParameterDescription("matcher.kdforest.checks",
+                            "Maximum number of keypoints compared to each keypoint. Higher values give matches closer to the exhaustive search.");
+    SetDefaultParameterInt("matcher.kdforest.checks", 256);
+    SetMinimumParameterIntValue("matcher.kdforest.checks", 1);
+
     AddParameter(ParameterType_Choice, "mode", "Keypoints search mode");
 
     AddChoice("mode.full", "Extract and match all keypoints (no streaming)");
@@ -206,27 +273,94 @@ private:
   {
   }
 
-  void Match(FloatImageType* im1, FloatImageType* im2, RSTransformType* rsTransform, RSTransformType* rsTransform1ToWGS84, RSTransformType* rsTransform2ToWGS84,
-             std::ofstream& file, OGRMultiLineString* mls = nullptr)
+  /** Keypoints and matches of a pair of (tiles of) images */
+  struct MatchingResult
+  {
+    FloatImageType::Pointer   Image1;
+    FloatImageType::Pointer   Image2;
+    unsigned int              NumberOfPoints1 = 0;
+    unsigned int              NumberOfPoints2 = 0;
+    LandmarkListType::Pointer Landmarks;
+  };
+
+  /** Detect the Harris corners of an image and describe them */
+  PointSetType::Pointer ExtractHarrisKeyPoints(FloatImageType* image)
+  {
+    // The descriptors need the whole image, the corners are then detected
+    // tile by tile from the buffered pixels
+    image->UpdateOutputInformation();
+    image->SetRequestedRegionToLargestPossibleRegion();
+    image->Update();
+
+    HarrisFilterType::Pointer harris = HarrisFilterType::New();
+    harris->SetInput(image);
+    harris->SetSigmaD(GetParameterFloat("algorithm.harris.sigmad"));
+    harris->SetSigmaI(GetParameterFloat("algorithm.harris.sigmai"));
+    harris->SetAlpha(GetParameterFloat("algorithm.harris.alpha"));
+
+    HarrisMaximaFilterType::Pointer maxima = HarrisMaximaFilterType::New();
+    maxima->SetInput(harris->GetOutput());
+    maxima->GetFilter()->SetRadius(GetParameterInt("algorithm.harris.radius"));
+    maxima->GetFilter()->SetMaximumNumberOfPoints(GetParameterInt("algorithm.harris.nbpoints"));
+    maxima->Update();
+
+    HarrisDescriptorFunctionType::Pointer descriptor = HarrisDescriptorFunctionType::New();
+    descriptor->SetInputImage(image);
+    descriptor->SetNeighborhoodRadius(GetParameterInt("algorithm.harris.descradius"));
+
+    HarrisMaximaFilterType::OutputPointSetType* corners  = maxima->GetPointSet();
+    PointSetType::Pointer                       points   = PointSetType::New();
+    unsigned long                               nbPoints = 0;
+    for (unsigned long i = 0; i < corners->GetNumberOfPoints(); ++i)
+    {
+      PointType point;
+      corners->GetPoint(i, &point);
+
+      FloatImageType::IndexType index;
+      image->TransformPhysicalPointToIndex(point, index);
+
+      // The histograms are concatenated in a single descriptor
+      const HarrisDescriptorFunctionType::OutputType histograms = descriptor->EvaluateAtIndex(index);
+      if (histograms.empty())
+      {
+        continue;
+      }
+      RealVectorType values(histograms.size() * histograms[0].size());
+      unsigned int   k = 0;
+      for (const auto& histogram : histograms)
+      {
+        for (double value : histogram)
+        {
+          values[k++] = value;
+        }
+      }
+
+      points->SetPoint(nbPoints, point);
+      points->SetPointData(nbPoints, values);
+      ++nbPoints;
+    }
+    return points;
+  }
+
+  /** Extract keypoints from both images and match them. This only reads parameters, so that several pairs
+   * can be processed in parallel */
+  void ComputeMatches(MatchingResult& result)
   {
     MatchingFilterType::Pointer matchingFilter = MatchingFilterType::New();
 
     if (GetParameterString("algorithm") == "sift")
     {
-      otbAppLogINFO("Using SIFT points");
       SiftFilterType::Pointer sift1 = SiftFilterType::New();
-      sift1->SetInput(im1);
+      sift1->SetInput(result.Image1);
 
       SiftFilterType::Pointer sift2 = SiftFilterType::New();
-      sift2->SetInput(im2);
+      sift2->SetInput(result.Image2);
 
       sift1->Update();
-
-      otbAppLogINFO("Found " << sift1->GetOutput()->GetNumberOfPoints() << " sift points in image 1.");
-
       sift2->Update();
 
-      otbAppLogINFO("Found " << sift2->GetOutput()->GetNumberOfPoints() << " sift points in image 2.");
+      result.NumberOfPoints1 = sift1->GetOutput()->GetNumberOfPoints();
+      result.NumberOfPoints2 = sift2->GetOutput()->GetNumberOfPoints();
 
       matchingFilter->SetInput1(sift1->GetOutput());
       matchingFilter->SetInput2(sift2->GetOutput());
@@ -234,32 +368,69 @@ private:
     else if (GetParameterString("algorithm") == "surf")
     {
       SurfFilterType::Pointer surf1 = SurfFilterType::New();
-      surf1->SetInput(im1);
+      surf1->SetInput(result.Image1);
 
       SurfFilterType::Pointer surf2 = SurfFilterType::New();
-      surf2->SetInput(im2);
+      surf2->SetInput(result.Image2);
 
-      otbAppLogINFO("Doing update");
       surf1->Update();
-
-      otbAppLogINFO("Found " << surf1->GetOutput()->GetNumberOfPoints() << " surf points in image 1.");
-
       surf2->Update();
 
-      otbAppLogINFO("Found " << surf2->GetOutput()->GetNumberOfPoints() << " surf points in image 2.");
+      result.NumberOfPoints1 = surf1->GetOutput()->GetNumberOfPoints();
+      result.NumberOfPoints2 = surf2->GetOutput()->GetNumberOfPoints();
 
       matchingFilter->SetInput1(surf1->GetOutput());
       matchingFilter->SetInput2(surf2->GetOutput());
       matchingFilter->SetDistanceThreshold(GetParameterFloat("threshold"));
       matchingFilter->SetUseBackMatching(GetParameterInt("backmatching"));
     }
+    else if (GetParameterString("algorithm") == "harris")
+    {
+      PointSetType::Pointer points1 = ExtractHarrisKeyPoints(result.Image1);
+      PointSetType::Pointer points2 = ExtractHarrisKeyPoints(result.Image2);
 
-    try
+      result.NumberOfPoints1 = points1->GetNumberOfPoints();
+      result.NumberOfPoints2 = points2->GetNumberOfPoints();
+
+      matchingFilter->SetInput1(points1);
+      matchingFilter->SetInput2(points2);
+      matchingFilter->SetDistanceThreshold(GetParameterFloat("threshold"));
+      matchingFilter->SetUseBackMatching(GetParameterInt("backmatching"));
+    }
+
+    if (GetParameterString("matcher") == "kdforest")
     {
+      matchingFilter->UseKdForestOn();
+      matchingFilter->SetNumberOfKdTrees(GetParameterInt("matcher.kdforest.trees"));
+      matchingFilter->SetMaxChecks(GetParameterInt("matcher.kdforest.checks"));
+    }
 
+    try
+    {
       matchingFilter->Update();
+      result.Landmarks = matchingFilter->GetOutput();
+    }
+    catch (itk::ExceptionObject&)
+    {
+      // silent catch
+    }
+  }
+
+  /** Write the matches of a pair of images */
+  void WriteMatches(const MatchingResult& result, RSTransformType* rsTransform, RSTransformType* rsTransform1ToWGS84, RSTransformType* rsTransform2ToWGS84,
+                    std::ofstream& file, OGRMultiLineString* mls)
+  {
+    otbAppLogINFO("Found " << result.NumberOfPoints1 << " " << GetParameterString("algorithm") << " points in image 1.");
+    otbAppLogINFO("Found " << result.NumberOfPoints2 << " " << GetParameterString("algorithm") << " points in image 2.");
 
-      LandmarkListType::Pointer landmarks = matchingFilter->GetOutput();
+    if (result.Landmarks.IsNull())
+    {
+      return;
+    }
+
+    try
+    {
+      LandmarkListType* landmarks = result.Landmarks.GetPointer();
 
       otbAppLogINFO("Found " << landmarks->Size() << " homologous points.");
 
@@ -280,7 +451,7 @@ private:
           pprime1 = rsTransform->TransformPoint(point1);
           error   = std::sqrt((point2[0] - pprime1[0]) * (point2[0] - pprime1[0]) + (point2[1] - pprime1[1]) * (point2[1] - pprime1[1]));
 
-          if (error > GetParameterFloat("precision") * std::sqrt(std::abs(im2->GetSignedSpacing()[0] * im2->GetSignedSpacing()[1])))
+          if (error > GetParameterFloat("precision") * std::sqrt(std::abs(result.Image2->GetSignedSpacing()[0] * result.Image2->GetSignedSpacing()[1])))
           {
             filtered = true;
           }
@@ -323,6 +494,37 @@ private:
     }
   }
 
+  void Match(FloatImageType* im1, FloatImageType* im2, RSTransformType* rsTransform, RSTransformType* rsTransform1ToWGS84, RSTransformType* rsTransform2ToWGS84,
+             std::ofstream& file, OGRMultiLineString* mls = nullptr)
+  {
+    MatchingResult result;
+    result.Image1 = im1;
+    result.Image2 = im2;
+    ComputeMatches(result);
+    WriteMatches(result, rsTransform, rsTransform1ToWGS84, rsTransform2ToWGS84, file, mls);
+  }
+
+  /** Match a batch of bins in parallel, then write their matches in order */
+  void MatchBins(std::vector<MatchingResult>& bins, RSTransformType* rsTransform, RSTransformType* rsTransform1ToWGS84, RSTransformType* rsTransform2ToWGS84,
+                 std::ofstream& file, OGRMultiLineString* mls)
+  {
+    std::vector<std::future<void>> tasks;
+    for (MatchingResult& bin : bins)
+    {
+      tasks.push_back(std::async(std::launch::async, [this, &bin]() { this->ComputeMatches(bin); }));
+    }
+    for (std::future<void>& task : tasks)
+    {
+      task.get();
+    }
+
+    for (const MatchingResult& bin : bins)
+    {
+      WriteMatches(bin, rsTransform, rsTransform1ToWGS84, rsTransform2ToWGS84, file, mls);
+    }
+    bins.clear();
+  }
+
 
   void DoExecute() override
   {
@@ -399,6 +601,16 @@ private:
       unsigned int nb_bins_x = static_cast<unsigned int>(std::ceil(static_cast<float>(size[0] - 2 * image_border_margin) / (bin_size_x + bin_step_x)));
       unsigned int nb_bins_y = static_cast<unsigned int>(std::ceil(static_cast<float>(size[1] - 2 * image_border_margin) / (bin_size_y + bin_step_y)));
 
+      // Bins are matched in parallel batches. The SiftFast library is not thread-safe.
+      std::vector<MatchingResult> bins;
+      unsigned int                nbParallelBins = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+#ifdef OTB_USE_SIFTFAST
+      if (GetParameterString("algorithm") == "sift")
+      {
+        nbParallelBins = 1;
+      }
+#endif
+
       for (unsigned int i = 0; i < nb_bins_x; ++i)
       {
         for (unsigned int j = 0; j < nb_bins_y; ++j)
@@ -490,7 +702,20 @@ private:
 
             extractChannel2->SetExtractionRegion(region2);
 
-            Match(extractChannel1->GetOutput(), extractChannel2->GetOutput(), rsTransform, rsTransform1ToWGS84, rsTransform2ToWGS84, file, &mls);
+            // Read both tiles here, since the reader pipelines can not be updated concurrently
+            MatchingResult bin;
+            extractChannel1->Update();
+            bin.Image1 = extractChannel1->GetOutput();
+            bin.Image1->DisconnectPipeline();
+            extractChannel2->Update();
+            bin.Image2 = extractChannel2->GetOutput();
+            bin.Image2->DisconnectPipeline();
+
+            bins.push_back(bin);
+            if (bins.size() >= nbParallelBins)
+            {
+              MatchBins(bins, rsTransform, rsTransform1ToWGS84, rsTransform2ToWGS84, file, &mls);
+            }
           }
           else
           {
@@ -498,6 +723,7 @@ private:
           }
         }
       }
+      MatchBins(bins, rsTransform, rsTransform1ToWGS84, rsTransform2ToWGS84, file, &mls);
     }
     file.close();
 
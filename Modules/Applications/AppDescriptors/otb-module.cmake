@@ -24,6 +24,7 @@ otb_module(OTBAppDescriptors
   DEPENDS
     OTBGdalAdapters
     OTBDescriptors
+    OTBCorner
     OTBTransform
     OTBApplicationEngine
     OTBImageBase
@@ -159,6 +159,15 @@ private:
     SetDefaultParameterFloat("method.ica.mu", 1.);
     MandatoryOff("method.ica.mu");
 
+    AddParameter(ParameterType_Int, "method.ica.samples", "Number of sampled pixels");
+    SetParameterDescription("method.ica.samples",
+                            "When positive, the iterations are computed on this number of "
+                            "randomly sampled pixels, gathered in a single pass. 0 "
+                            "processes the whole image at each iteration.");
+    SetMinimumParameterIntValue("method.ica.samples", 0);
+    SetDefaultParameterInt("method.ica.samples", 0);
+    MandatoryOff("method.ica.samples");
+
     AddParameter(ParameterType_Choice, "method.ica.g", "Nonlinearity");
     SetParameterDescription("method.ica.g", "Nonlinearity used in the FastICA algorithm");
     AddChoice("method.ica.g.tanh", "tanh");
@@ -403,6 +412,7 @@ private:
       filter->SetNumberOfPrincipalComponentsRequired(nbComp);
       filter->SetNumberOfIterations(nbIterations);
       filter->SetMu(mu);
+      filter->SetNumberOfSamples(GetParameterInt("method.ica.samples"));
 
       switch (GetParameterInt("method.ica.g"))
       {
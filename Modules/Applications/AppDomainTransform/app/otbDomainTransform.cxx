@@ -24,6 +24,7 @@
 #include "otbWaveletImageFilter.h"
 #include "otbWaveletInverseImageFilter.h"
 #include "otbWaveletGenerator.h"
+#include "otbLiftingWaveletImageFilter.h"
 
 #include <itkConfigure.h>
 #include <itkForwardFFTImageFilter.h>
@@ -89,7 +90,7 @@ private:
     SetDocLongDescription("Domain Transform application for wavelet and fourier.");
     SetDocLimitations("This application is not streamed, check your system resources when processing large images");
     SetDocAuthors("OTB-Team");
-    SetDocSeeAlso("otbWaveletImageFilter, otbWaveletInverseImageFilter, otbWaveletTransform");
+    SetDocSeeAlso("otbWaveletImageFilter, otbWaveletInverseImageFilter, otbWaveletTransform, otbLiftingWaveletImageFilter");
     AddDocTag(Tags::Filter);
 
     // Parameters
@@ -133,6 +134,12 @@ private:
     AddChoice("mode.wavelet.form.sb24", "SPLINE_BIORTHOGONAL_2_4");
     AddChoice("mode.wavelet.form.sb44", "SPLINE_BIORTHOGONAL_4_4");
     AddChoice("mode.wavelet.form.sym8", "SYMLET8");
+    AddChoice("mode.wavelet.form.liftinghaar", "HAAR (lifting scheme)");
+    AddChoice("mode.wavelet.form.cdf53", "CDF 5/3 (lifting scheme)");
+    AddChoice("mode.wavelet.form.cdf97", "CDF 9/7 (lifting scheme)");
+    SetParameterDescription("mode.wavelet.form",
+                            "The lifting scheme forms are computed in place on the"
+                            " multi-resolution image, with a symmetric extension at the borders.");
 
     // Default values for mode
     SetParameterString("mode", "wavelet");
@@ -179,65 +186,90 @@ private:
 
     if (mode == 1)
     {
-      int          wavelet_type = GetParameterInt("mode.wavelet.form");
-      unsigned int nlevels      = GetParameterInt("mode.wavelet.nlevels");
-      switch (wavelet_type)
+      int               wavelet_type = GetParameterInt("mode.wavelet.form");
+      unsigned int      nlevels      = GetParameterInt("mode.wavelet.nlevels");
+      const std::string form         = GetParameterString("mode.wavelet.form");
+      if (form == "liftinghaar" || form == "cdf53" || form == "cdf97")
       {
-      case 0:
-      {
-        DoWaveletTransform<otb::Wavelet::HAAR>(dir, nlevels);
-        break;
-      }
-      case 1:
-      {
-        DoWaveletTransform<otb::Wavelet::DB4>(dir, nlevels);
-        break;
-      }
-      case 2:
-      {
-        DoWaveletTransform<otb::Wavelet::DB4>(dir, nlevels);
-        break;
-      }
-      case 3:
-      {
-        DoWaveletTransform<otb::Wavelet::DB6>(dir, nlevels);
-        break;
-      }
-      case 4:
-      {
-        DoWaveletTransform<otb::Wavelet::DB8>(dir, nlevels);
-        break;
-      }
-      case 5:
-      {
-        DoWaveletTransform<otb::Wavelet::DB12>(dir, nlevels);
-        break;
-      }
-      case 6:
-      {
-        DoWaveletTransform<otb::Wavelet::DB20>(dir, nlevels);
-        break;
-      }
-      case 7:
-      {
-        DoWaveletTransform<otb::Wavelet::SPLINE_BIORTHOGONAL_2_4>(dir, nlevels);
-        break;
-      }
-      case 8:
-      {
-        DoWaveletTransform<otb::Wavelet::SPLINE_BIORTHOGONAL_4_4>(dir, nlevels);
-        break;
-      }
-      case 9:
-      {
-        DoWaveletTransform<otb::Wavelet::SYMLET8>(dir, nlevels);
-        break;
+        otb::Wavelet::LiftingScheme scheme = otb::Wavelet::LIFTING_HAAR;
+        if (form == "cdf53")
+        {
+          scheme = otb::Wavelet::LIFTING_CDF_5_3;
+        }
+        else if (form == "cdf97")
+        {
+          scheme = otb::Wavelet::LIFTING_CDF_9_7;
+        }
+
+        if (dir == 0)
+        {
+          DoLiftingTransform<otb::Wavelet::FORWARD>(nlevels, scheme);
+        }
+        else
+        {
+          DoLiftingTransform<otb::Wavelet::INVERSE>(nlevels, scheme);
+        }
       }
-      default:
+      else
       {
-        itkExceptionMacro(<< "Invalid wavelet type: '" << wavelet_type << "'");
-        break;
-      }
+        switch (wavelet_type)
+        {
+        case 0:
+        {
+          DoWaveletTransform<otb::Wavelet::HAAR>(dir, nlevels);
+          break;
+        }
+        case 1:
+        {
+          DoWaveletTransform<otb::Wavelet::DB4>(dir, nlevels);
+          break;
+        }
+        case 2:
+        {
+          DoWaveletTransform<otb::Wavelet::DB4>(dir, nlevels);
+          break;
+        }
+        case 3:
+        {
+          DoWaveletTransform<otb::Wavelet::DB6>(dir, nlevels);
+          break;
+        }
+        case 4:
+        {
+          DoWaveletTransform<otb::Wavelet::DB8>(dir, nlevels);
+          break;
+        }
+        case 5:
+        {
+          DoWaveletTransform<otb::Wavelet::DB12>(dir, nlevels);
+          break;
+        }
+        case 6:
+        {
+          DoWaveletTransform<otb::Wavelet::DB20>(dir, nlevels);
+          break;
+        }
+        case 7:
+        {
+          DoWaveletTransform<otb::Wavelet::SPLINE_BIORTHOGONAL_2_4>(dir, nlevels);
+          break;
+        }
+        case 8:
+        {
+          DoWaveletTransform<otb::Wavelet::SPLINE_BIORTHOGONAL_4_4>(dir, nlevels);
+          break;
+        }
+        case 9:
+        {
+          DoWaveletTransform<otb::Wavelet::SYMLET8>(dir, nlevels);
+          break;
+        }
+        default:
+        {
+          itkExceptionMacro(<< "Invalid wavelet type: '" << wavelet_type << "'");
+          break;
+        }
+        }
       }
     }
     else
@@ -379,6 +411,23 @@ private:
       SetParameterOutputImage<TOutputImage>(outkey, waveletImageFilter->GetOutput());
     }
   }
+
+  template <otb::Wavelet::WaveletDirection TDirection>
+  void DoLiftingTransform(const unsigned int nlevels, const otb::Wavelet::LiftingScheme scheme)
+  {
+    typedef otb::Image<InputPixelType>  TInputImage;
+    typedef otb::Image<OutputPixelType> TOutputImage;
+    typedef otb::LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirection> TLiftingImageFilter;
+
+    typename TLiftingImageFilter::Pointer liftingImageFilter = TLiftingImageFilter::New();
+
+    liftingImageFilter->SetInput(GetParameterImage<TInputImage>("in"));
+    liftingImageFilter->SetScheme(scheme);
+    liftingImageFilter->SetNumberOfDecompositions(nlevels);
+    liftingImageFilter->Update();
+
+    SetParameterOutputImage<TOutputImage>("out", liftingImageFilter->GetOutput());
+  }
 };
 
 } // end of namespace Wrapper
@@ -32,6 +32,7 @@
 #include "otbComputeHistoFilter.h"
 #include "otbComputeGainLutFilter.h"
 #include "otbApplyGainFilter.h"
+#include "otbStreamingCLAHEImageFilter.h"
 #include "otbImageFileWriter.h"
 #include "itkImageRegionIterator.h"
 #include <string>
@@ -104,6 +105,7 @@ public:
   typedef otb::ComputeHistoFilter<FloatImageType, HistogramType> HistoFilterType;
   typedef otb::ComputeGainLutFilter<HistogramType, LutType>      GainLutFilterType;
   typedef otb::ApplyGainFilter<FloatImageType, LutType, FloatImageType> ApplyFilterType;
+  typedef otb::StreamingCLAHEImageFilter<FloatImageType, FloatImageType> CLAHEFilterType;
   typedef otb::ImageList<FloatImageType> ImageListType;
 
   typedef otb::VectorImageToImageListFilter<FloatVectorImageType, ImageListType> VectorToImageListFilterType;
@@ -592,27 +594,42 @@ private:
     max.Fill(0);
     ComputeVectorMinMax(inImage, max, min);
 
-    if (m_SpatialMode == "global")
-      PersistentComputation(inImage, nbChannel, max, min);
-    else
+    if (m_SpatialMode == "local")
     {
+      // The fused filter streams the histogram pass, then the gain
+      // application, without intermediate images
       float thresh(-1);
       if (HasValue("hfact"))
       {
         thresh = GetParameterInt("hfact");
       }
 
-      m_HistoFilter.resize(nbChannel);
-      m_Histogram.resize(nbChannel);
+      m_CLAHEFilter.resize(nbChannel);
       for (unsigned int channel = 0; channel < nbChannel; channel++)
       {
-        m_HistoFilter[channel] = HistoFilterType::New();
-        m_HistoFilter[channel]->SetInput(inputImageList->GetNthElement(channel));
-        SetHistoFilterParameter(m_HistoFilter[channel], min[channel], max[channel], GetParameterInt("bins"), thresh);
-        m_Histogram[channel] = m_HistoFilter[channel]->GetHistoOutput();
+        if (min[channel] == max[channel])
+        {
+          std::ostringstream oss;
+          oss << "Channel " << channel << " is constant : "
+              << "min = " << min[channel] << " and max = " << max[channel];
+          otbAppLogINFO(<< oss.str());
+          m_BufferFilter[channel] = BufferFilterType::New();
+          m_BufferFilter[channel]->SetInput(inputImageList->GetNthElement(channel));
+          outputImageList->PushBack(m_BufferFilter[channel]->GetOutput());
+          continue;
+        }
+
+        m_CLAHEFilter[channel] = CLAHEFilterType::New();
+        m_CLAHEFilter[channel]->SetInput(inputImageList->GetNthElement(channel));
+        SetCLAHEFilterParameter(m_CLAHEFilter[channel], min[channel], max[channel], GetParameterInt("bins"), thresh);
+        AddProcess(m_CLAHEFilter[channel]->GetHistogramFilter()->GetStreamer(), "Computing histograms");
+        outputImageList->PushBack(m_CLAHEFilter[channel]->GetOutput());
       }
+      return;
     }
 
+    PersistentComputation(inImage, nbChannel, max, min);
+
     for (unsigned int channel = 0; channel < nbChannel; channel++)
     {
       SetUpPipeline(channel, inputImageList->GetNthElement(channel));
@@ -842,6 +859,21 @@ private:
     }
   }
 
+  // Set correct parameters for the StreamingCLAHEImageFilter
+  void SetCLAHEFilterParameter(CLAHEFilterType::Pointer claheFilter, float min, float max, unsigned int nbBin, float thresh)
+  {
+    claheFilter->SetMin(min);
+    claheFilter->SetMax(max);
+    claheFilter->SetNbBin(nbBin);
+    claheFilter->SetThumbSize(m_ThumbSize);
+    claheFilter->SetThreshold(thresh);
+    if (IsParameterEnabled("nodata"))
+    {
+      claheFilter->SetNoData(GetParameterFloat("nodata"));
+      claheFilter->SetNoDataFlag(true);
+    }
+  }
+
   // Set correct parameters for the ComputeGainLutFilter
   void SetGainLutFilterParameter(GainLutFilterType::Pointer gainLutFilter, ImagePixelType min, ImagePixelType max)
   {
@@ -875,6 +907,7 @@ private:
   std::vector<ApplyFilterType::Pointer>          m_ApplyFilter;
   std::vector<StreamingImageFilterType::Pointer> m_StreamingFilter;
   std::vector<BufferFilterType::Pointer>         m_BufferFilter;
+  std::vector<CLAHEFilterType::Pointer>          m_CLAHEFilter;
 };
 
 
@@ -69,6 +69,7 @@ private:
     ShareParameter("elev", "superimpose.elev");
     ShareParameter("mode", "superimpose.mode");
     ShareParameter("method", "pansharp.method");
+    ShareParameter("fused", "pansharp.fused");
     ShareParameter("lms", "superimpose.lms", "Spacing of the deformation field",
                    "Spacing of the deformation field. Default is 10 times the PAN image spacing.");
     ShareParameter("interpolator", "superimpose.interpolator");
@@ -32,6 +32,7 @@
 #include "otbBCOInterpolateImageFunction.h"
 
 #include "otbLmvmPanSharpeningFusionImageFilter.h"
+#include "otbFusedPanSharpeningImageFilter.h"
 
 #include "itkFixedArray.h"
 
@@ -57,6 +58,10 @@ public:
 
   typedef otb::LmvmPanSharpeningFusionImageFilter<FloatImageType, FloatVectorImageType, FloatVectorImageType, double> LmvmFilterType;
 
+  typedef otb::FusedPanSharpeningImageFilter<FloatImageType, FloatVectorImageType, FloatVectorImageType> FusedRCSFilterType;
+
+  typedef otb::FusedPanSharpeningImageFilter<FloatImageType, FloatVectorImageType, FloatVectorImageType, double> FusedLmvmFilterType;
+
   typedef otb::BayesianFusionFilter<FloatVectorImageType, FloatVectorImageType, FloatImageType, FloatVectorImageType> BayesianFilterType;
 
   typedef otb::BCOInterpolateImageFunction<FloatVectorImageType> InterpolatorType;
@@ -125,6 +130,12 @@ private:
     SetMinimumParameterFloatValue("method.bayes.s", 1);
     SetDefaultParameterFloat("method.bayes.s", 1);
 
+    AddParameter(ParameterType_Bool, "fused", "Single pass fusion");
+    SetParameterDescription("fused",
+                            "Compute the RCS and LMVM fusions in a single pass over small blocks, without intermediate smoothed images. "
+                            "The XS image may then also be given at its own resolution, it is resampled on the fly by bilinear interpolation "
+                            "from the origins and spacings of both images, which must therefore be in the same geometry.");
+
     AddRAMParameter();
 
     // Doc example parameter settings
@@ -165,6 +176,20 @@ private:
     {
     case 0:
     {
+      if (GetParameterInt("fused"))
+      {
+        FusedRCSFilterType::Pointer filter = FusedRCSFilterType::New();
+        filter->SetPanInput(panchro);
+        filter->SetXsInput(xs);
+        filter->SetMethod(FusedRCSFilterType::RCS);
+
+        filter->UpdateOutputInformation();
+        otbAppLogINFO(<< "Simple RCS algorithm (single pass)");
+        m_Ref.push_back(filter.GetPointer());
+        SetParameterOutputImage("out", filter->GetOutput());
+        break;
+      }
+
       SimpleRCSFilterType::Pointer filter = SimpleRCSFilterType::New();
       m_Ref.push_back(filter.GetPointer());
 
@@ -180,11 +205,6 @@ private:
     }
     case 1:
     {
-      LmvmFilterType::Pointer filter = LmvmFilterType::New();
-
-      filter->SetXsInput(xs);
-      filter->SetPanInput(panchro);
-
       double radiusx = static_cast<unsigned int>(GetParameterInt("method.lmvm.radiusx"));
       double radiusy = static_cast<unsigned int>(GetParameterInt("method.lmvm.radiusy"));
 
@@ -192,6 +212,26 @@ private:
       radius[0] = radiusx;
       radius[1] = radiusy;
 
+      if (GetParameterInt("fused"))
+      {
+        FusedLmvmFilterType::Pointer filter = FusedLmvmFilterType::New();
+        filter->SetPanInput(panchro);
+        filter->SetXsInput(xs);
+        filter->SetMethod(FusedLmvmFilterType::LMVM);
+        filter->SetRadius(radius);
+
+        filter->UpdateOutputInformation();
+        otbAppLogINFO(<< "Lmvm algorithm (single pass)");
+        m_Ref.push_back(filter.GetPointer());
+        SetParameterOutputImage("out", filter->GetOutput());
+        break;
+      }
+
+      LmvmFilterType::Pointer filter = LmvmFilterType::New();
+
+      filter->SetXsInput(xs);
+      filter->SetPanInput(panchro);
+
       filter->SetRadius(radius);
 
       itk::Array<double> filterCoeffs;
@@ -187,7 +187,6 @@ private:
 
       unmixer->SetInput(inputImage);
       unmixer->GetModifiableFunctor().SetMatrix(endMembersMatrix);
-      unmixer->SetNumberOfThreads(1); // FIXME : currently buggy
 
       abundanceMap = unmixer->GetOutput();
       m_ProcessObjects.push_back(unmixer.GetPointer());
@@ -47,6 +47,8 @@ public:
   typedef DoubleVectorImageType VectorImageType;
   typedef DoubleImageType       ImageType;
 
+  typedef otb::LocalRxDetectorFilter<VectorImageType, ImageType> LocalRxDetectorFilterType;
+
 private:
   void DoInit() override
   {
@@ -105,18 +107,14 @@ private:
     auto inputImage = GetParameterDoubleVectorImage("in");
     inputImage->UpdateOutputInformation();
 
-    Functor::LocalRxDetectionFunctor<double> detectorFunctor;
-
-    unsigned int externalRadius = GetParameterInt("er");
-    unsigned int internalRadius = GetParameterInt("ir");
-
-    detectorFunctor.SetInternalRadius(internalRadius, internalRadius);
-
-    // Create a functorImageFilter with the localRx functor and the appropriate
-    // external radius.
-    auto localRxDetectionFilter = otb::NewFunctorFilter(detectorFunctor, {{externalRadius, externalRadius}});
+    LocalRxDetectorFilterType::SizeType externalRadius, internalRadius;
+    externalRadius.Fill(GetParameterInt("er"));
+    internalRadius.Fill(GetParameterInt("ir"));
 
-    localRxDetectionFilter->SetInputs(inputImage);
+    auto localRxDetectionFilter = LocalRxDetectorFilterType::New();
+    localRxDetectionFilter->SetExternalRadius(externalRadius);
+    localRxDetectionFilter->SetInternalRadius(internalRadius);
+    localRxDetectionFilter->SetInput(inputImage);
 
     SetParameterOutputImage("out", localRxDetectionFilter->GetOutput());
     RegisterPipeline();
@@ -21,7 +21,8 @@
 #include "otbWrapperApplication.h"
 #include "otbWrapperApplicationFactory.h"
 
-#include "otbSpectralAngleFunctor.h"
+#include "otbSpectralAngleMapperImageFilter.h"
+#include "otbSpectralAngleClassificationImageFilter.h"
 #include "otbFunctorImageFilter.h"
 #include "otbSpectralInformationDivergenceFunctor.h"
 
@@ -52,7 +53,9 @@ public:
   using ValueType = float;
   using ImageType = otb::VectorImage<ValueType>;
   using PixelType = ImageType::PixelType;
-  using SAMFilterType = otb::FunctorImageFilter<otb::Functor::SpectralAngleMapperFunctor<PixelType, PixelType, PixelType>>;
+  using LabelImageType = otb::Image<int>;
+  using SAMFilterType = otb::SpectralAngleMapperImageFilter<ImageType, ImageType>;
+  using SAMClassificationFilterType = otb::SpectralAngleClassificationImageFilter<ImageType, LabelImageType>;
   using SIDFilterType = otb::FunctorImageFilter<otb::Functor::SpectralInformationDivergenceFunctor<PixelType, PixelType, PixelType>>;
 
 private:
@@ -161,12 +164,33 @@ private:
     itk::LightObject::Pointer filter;
     ImageType::Pointer filterOutput;
     
+    auto threshold = HasValue("threshold") ? GetParameterFloat("threshold") 
+                                            : std::numeric_limits<ValueType>::max();
+    auto bv = GetParameterInt("bv");
+
     auto mode = GetParameterString("mode");
+    if (mode == "sam" && !HasValue("measure"))
+    {
+      // The angles are not written: only the arc cosine of the
+      // closest endmember is computed
+      if (HasValue("out"))
+      {
+        auto classificationFilter = SAMClassificationFilterType::New();
+        classificationFilter->SetReferencePixels(endmembers);
+        classificationFilter->SetThreshold(threshold);
+        classificationFilter->SetBackgroundValue(bv);
+        classificationFilter->SetInput(GetParameterImage("in"));
+        SetParameterOutputImage("out", classificationFilter->GetOutput());
+      }
+      RegisterPipeline();
+      return;
+    }
+
     if (mode == "sam")
     {
       auto SAMFilter = SAMFilterType::New();
       
-      SAMFilter->GetModifiableFunctor().SetReferencePixels(endmembers);
+      SAMFilter->SetReferencePixels(endmembers);
       SAMFilter->SetInput(GetParameterImage("in"));
       filter = SAMFilter;
       filterOutput = SAMFilter->GetOutput();
@@ -188,10 +212,6 @@ private:
 
     if (HasValue("out"))
     {
-      auto threshold = HasValue("threshold") ? GetParameterFloat("threshold") 
-                                              : std::numeric_limits<ValueType>::max();
-      auto bv = GetParameterInt("bv");
-      
       // This lambda return the index of the minimum value in a pixel, values above threshold are classified as background values.
       auto minIndexLambda = [threshold, bv](PixelType const & pixel)
       {
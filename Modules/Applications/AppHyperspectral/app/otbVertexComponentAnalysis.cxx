@@ -92,6 +92,16 @@ private:
     SetParameterInt("ne", 1);
     MandatoryOn("ne");
 
+    AddParameter(ParameterType_Int, "samples", "Number of sampled pixels");
+    SetParameterDescription("samples",
+                            "When positive, the image is read only once to gather this "
+                            "number of randomly sampled pixels, and the endmembers are "
+                            "extracted from this sample. 0 processes the whole image "
+                            "at each iteration.");
+    SetDefaultParameterInt("samples", 0);
+    SetMinimumParameterIntValue("samples", 0);
+    MandatoryOff("samples");
+
     AddRANDParameter();
     // Doc example parameter settings
     SetDocExampleParameterValue("in", "cupriteSubHsi.tif");
@@ -114,6 +124,7 @@ private:
     const unsigned int     nbEndmembers = GetParameterInt("ne");
     VCAFilterType::Pointer vca          = VCAFilterType::New();
     vca->SetNumberOfEndmembers(nbEndmembers);
+    vca->SetNumberOfSamples(GetParameterInt("samples"));
     vca->SetInput(inputImage);
 
     endmembersImage = vca->GetOutput();
@@ -24,6 +24,9 @@
 #include "otbImageListToVectorImageFilter.h"
 #include "otbMultiToMonoChannelExtractROI.h"
 #include "otbImageList.h"
+#include "otbImageFileStackReader.h"
+
+#include <algorithm>
 
 namespace otb
 {
@@ -50,6 +53,7 @@ public:
   typedef ImageListToVectorImageFilter<ImageListType, FloatVectorImageType>                                ListConcatenerFilterType;
   typedef MultiToMonoChannelExtractROI<FloatVectorImageType::InternalPixelType, FloatImageType::PixelType> ExtractROIFilterType;
   typedef ObjectList<ExtractROIFilterType> ExtractROIFilterListType;
+  typedef ImageFileStackReader<FloatVectorImageType> StackReaderType;
 
 private:
   void DoInit() override
@@ -92,6 +96,27 @@ private:
 
   void DoExecute() override
   {
+    // Images given by plain file names are read by a single reader, that
+    // reads them concurrently straight into the output buffer
+    std::vector<std::string> fileNames = GetParameterStringList("il");
+    auto                     notAFile  = [](const std::string& fileName) { return fileName.empty() || fileName.find('?') != std::string::npos; };
+    if (!fileNames.empty() && std::none_of(fileNames.begin(), fileNames.end(), notAFile))
+    {
+      StackReaderType::Pointer stackReader = StackReaderType::New();
+      stackReader->SetFileNames(fileNames);
+      try
+      {
+        stackReader->UpdateOutputInformation();
+        SetParameterOutputImage("out", stackReader->GetOutput());
+        RegisterPipeline();
+        return;
+      }
+      catch (itk::ExceptionObject& err)
+      {
+        otbAppLogDEBUG(<< "Images can not be stacked by a single reader, reading them one by one: " << err.GetDescription());
+      }
+    }
+
     ListConcatenerFilterType::Pointer m_Concatener    = ListConcatenerFilterType::New();
     ExtractROIFilterListType::Pointer m_ExtractorList = ExtractROIFilterListType::New();
     ImageListType::Pointer            m_ImageList     = ImageListType::New();
@@ -243,6 +243,13 @@ private:
     AddChoice("mode.download", "Download");
     SetParameterDescription("mode.download", "Download corresponding tiles on USGE server.");
 
+    AddParameter(ParameterType_Int, "mode.download.connections", "Parallel downloads");
+    SetParameterDescription("mode.download.connections",
+                            "Number of tiles downloaded at the same time. "
+                            "Interrupted downloads are resumed by the next run of the application.");
+    SetDefaultParameterInt("mode.download.connections", 4);
+    SetMinimumParameterIntValue("mode.download.connections", 1);
+
     AddChoice("mode.list", "List tiles");
     SetParameterDescription("mode.list", "List tiles in an existing local directory.");
 
@@ -496,21 +503,23 @@ private:
       std::vector<std::string>::const_iterator it, itConti;
       auto                                     curl = CurlHelper::New();
       curl->SetTimeout(0);
-      std::string request;
       if (!tileDir.empty() && tileDir.back() != Sep)
       {
         tileDir += Sep;
       }
+      std::vector<std::string> requests;
+      std::vector<std::string> files;
       for (it = missingTiles.begin(), itConti = continentList.begin(); it != missingTiles.end() && itConti != continentList.end(); ++it, ++itConti)
       {
-        otbAppLogINFO(<< "Downloading tile " << *it << " ...");
-        request = SRTMServerPath + *itConti + "/" + *it + HGTZIPExtension;
-        if (curl->IsCurlReturnHttpError(request))
-        {
-          otbAppLogWARNING(<< "Can't access tile : " << request);
-          continue;
-        }
-        curl->RetrieveFile(request, std::string(tileDir + *it + HGTZIPExtension));
+        requests.push_back(SRTMServerPath + *itConti + "/" + *it + HGTZIPExtension);
+        files.push_back(tileDir + *it + HGTZIPExtension);
+      }
+      const int connections = GetParameterInt("mode.download.connections");
+      otbAppLogINFO(<< "Downloading " << requests.size() << " tiles (" << connections << " at a time) ...");
+      const int failures = curl->RetrieveFileMulti(requests, files, connections);
+      if (failures != 0)
+      {
+        otbAppLogWARNING(<< failures << " tiles could not be downloaded, run the application again to resume their download");
       }
     }
   }
@@ -41,6 +41,7 @@
 #include "otbStreamingLargeFeatherMosaicFilter.h"
 #include "otbStreamingSimpleMosaicFilter.h"
 #include "otbStreamingFeatherMosaicFilter.h"
+#include "otbStreamingFootprintDistanceImageFilter.h"
 
 // Resample filter
 #include "otbStreamingResampleImageFilter.h"
@@ -138,6 +139,9 @@ public:
   /* Distance map image writer typedef */
   typedef otb::ImageFileReader<DoubleImageType> DistanceMapImageReaderType;
 
+  /* Streamed distance map typedef */
+  typedef otb::StreamingFootprintDistanceImageFilter<FloatVectorImageType, DoubleImageType> FootprintDistanceFilterType;
+
   /* Vector data filters typedefs */
   typedef otb::VectorDataIntoImageProjectionFilter<VectorDataType, FloatVectorImageType> VectorDataReprojFilterType;
   typedef otb::VectorDataToLabelImageFilter<VectorDataType, LabelImageType>              RasterizerType;
@@ -216,7 +220,7 @@ private:
     SetDocLimitations(
         "1. When \"comp\" parameter is different than \"none\", the sampling ratio for "
         "distance map computation can be adjusted to make input images fit into memory (distance map "
-        "computation is not streamable)."
+        "computation is not streamable, unless distancemap.streamed is enabled)."
         "2. When \"harmo\" method is not \"none\", an algorithm performs the color harmonization of "
         "the input images using quadratic programming (QP). The objective function of the QP is a set "
         "of matrices, each one with size NxN (N being the number of input images). Hence, a large number "
@@ -367,6 +371,19 @@ private:
                             "or in order to speed up the process");
     SetDefaultParameterFloat("distancemap.sr", 10);
 
+    AddParameter(ParameterType_Bool, "distancemap.streamed", "Compute the distance maps on the fly");
+    SetParameterDescription("distancemap.streamed",
+                            "Distance maps are computed tile by tile during the compositing, from the no-data footprints of the "
+                            "input images, instead of being written in temporary files. Distances are only computed up to "
+                            "distancemap.margin. Cutlines (vdcut) still use temporary distance maps.");
+
+    AddParameter(ParameterType_Float, "distancemap.margin", "Streamed distance maps margin (In cartographic units)");
+    SetParameterDescription("distancemap.margin",
+                            "Distance up to which the streamed distance maps are computed. If not set, the transition length "
+                            "is used for the slim composition, and 100 distance maps pixels for the large composition.");
+    SetMinimumParameterFloatValue("distancemap.margin", 0);
+    MandatoryOff("distancemap.margin");
+
     // no-data value
     AddParameter(ParameterType_Float, "nodata", "no-data value");
     SetParameterDescription("nodata",
@@ -878,6 +895,61 @@ private:
     }
   }
 
+  /*
+   * Prepare distance maps computed on the fly from the images footprints
+   */
+  void ComputeStreamedDistanceMaps()
+  {
+    otbAppLogINFO("Distance maps will be computed on the fly");
+
+    // Distance offset (largest distance maps spacing) and margin, in
+    // cartographic units
+    const double sr     = GetParameterFloat("distancemap.sr");
+    double       offset = 0;
+    for (unsigned int i = 0; i < m_SourcesForCompositing->Size(); i++)
+    {
+      FloatVectorImageType* image = m_SourcesForCompositing->GetNthElement(i);
+      image->UpdateOutputInformation();
+      offset = vnl_math_max(offset, sr * vnl_math_max(vnl_math_abs(image->GetSignedSpacing()[0]), vnl_math_abs(image->GetSignedSpacing()[1])));
+    }
+    double margin = 100 * offset;
+    if (HasValue("distancemap.margin"))
+    {
+      margin = GetParameterFloat("distancemap.margin");
+    }
+    else if (GetParameterInt("comp.feather") == Composition_Method_slim)
+    {
+      margin = GetParameterFloat("comp.feather.slim.length");
+    }
+
+    FloatVectorImageType::PixelType nodatapix;
+    nodatapix.SetSize(m_SourcesForCompositing->GetNthElement(0)->GetNumberOfComponentsPerPixel());
+    nodatapix.Fill(GetParameterFloat("nodata"));
+
+    m_FootprintDistanceFilters.clear();
+    for (unsigned int i = 0; i < m_SourcesForCompositing->Size(); i++)
+    {
+      FootprintDistanceFilterType::Pointer distanceFilter = FootprintDistanceFilterType::New();
+      distanceFilter->SetInput(m_SourcesForCompositing->GetNthElement(i));
+      distanceFilter->SetNoDataInputPixel(nodatapix);
+      distanceFilter->SetSamplingRatio(sr);
+      distanceFilter->SetMargin(margin + offset);
+      m_FootprintDistanceFilters.push_back(distanceFilter);
+    }
+  }
+
+  /*
+   * Distance map of the input image #i
+   */
+  DoubleImageType* GetDistanceMap(unsigned int i)
+  {
+    if (!m_FootprintDistanceFilters.empty())
+    {
+      return m_FootprintDistanceFilters[i]->GetOutput();
+    }
+    return m_DistanceMapImageReader[i]->GetOutput();
+  }
+
   /*
    * Prepare the sources for compositing.
    * In the specific case of no feathering + cutlines, crop the input images with
@@ -947,7 +1019,7 @@ private:
       m_LargeFeatherMosaicFilter = LargeFeatherMosaicFilterType::New();
       for (unsigned int i = 0; i < m_SourcesForCompositing->Size(); i++)
       {
-        m_LargeFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), m_DistanceMapImageReader[i]->GetOutput());
+        m_LargeFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), GetDistanceMap(i));
       }
       ComputeDistanceOffset<LargeFeatherMosaicFilterType>(m_LargeFeatherMosaicFilter);
       mosaicFilter = static_cast<MosaicFilterType*>(m_LargeFeatherMosaicFilter);
@@ -963,7 +1035,7 @@ private:
       m_SlimFeatherMosaicFilter = SlimFeatherMosaicFilterType::New();
       for (unsigned int i = 0; i < m_SourcesForCompositing->Size(); i++)
       {
-        m_SlimFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), m_DistanceMapImageReader[i]->GetOutput());
+        m_SlimFeatherMosaicFilter->PushBackInputs(m_SourcesForCompositing->GetNthElement(i), GetDistanceMap(i));
       }
       ComputeDistanceOffset<SlimFeatherMosaicFilterType>(m_SlimFeatherMosaicFilter);
 
@@ -1039,9 +1111,17 @@ private:
     PrepareSourcesForCompositing();
 
     // Compute distance maps if needed
+    m_FootprintDistanceFilters.clear();
     if (GetParameterInt("comp.feather") != Composition_Method_none)
     {
-      ComputeDistanceMaps();
+      if (GetParameterInt("distancemap.streamed") && !GetParameterByKey("vdcut")->HasValue())
+      {
+        ComputeStreamedDistanceMaps();
+      }
+      else
+      {
+        ComputeDistanceMaps();
+      }
     }
 
     // Compute statistics if needed
@@ -1087,6 +1167,9 @@ private:
   // Distance images reader
   vector<DistanceMapImageReaderType::Pointer> m_DistanceMapImageReader;
 
+  // Streamed distance maps
+  vector<FootprintDistanceFilterType::Pointer> m_FootprintDistanceFilters;
+
   // Parameters
   string         m_TempFilesPrefix; // Temp. directory
   vector<string> m_TemporaryFiles;  // Temp. filenames for distance images, masks, etc.
@@ -22,6 +22,8 @@
 #include "otbWrapperApplicationFactory.h"
 
 #include "otbPerBandVectorImageFilter.h"
+#include "otbCascadedPyramidImageFilter.h"
+#include "otbMultiImageFileWriter.h"
 #include "itkDiscreteGaussianImageFilter.h"
 #include "itkShrinkImageFilter.h"
 
@@ -53,6 +55,8 @@ public:
 
   typedef itk::ShrinkImageFilter<FloatVectorImageType, FloatVectorImageType> ShrinkFilterType;
 
+  typedef otb::CascadedPyramidImageFilter<FloatVectorImageType> PyramidFilterType;
+
 private:
   void DoInit() override
   {
@@ -95,7 +99,8 @@ private:
     AddParameter(ParameterType_Bool, "fast", "Use Fast Scheme");
     std::ostringstream desc;
     desc << "If used, this option allows one to speed-up computation by iteratively"
-         << " subsampling previous level of pyramid instead of processing the full input.";
+         << " subsampling previous level of pyramid instead of processing the full input."
+         << " All the levels are then computed and written from a single read of the input.";
     SetParameterDescription("fast", desc.str());
 
     AddRAMParameter();
@@ -131,18 +136,15 @@ private:
 
     bool fastScheme = GetParameterInt("fast");
 
+    if (fastScheme)
+    {
+      WriteCascadedPyramid(nbLevels, shrinkFactor, varianceFactor);
+      return;
+    }
+
     // Get the input image
     FloatVectorImageType::Pointer inImage = GetParameterImage("in");
 
-    // Get the Initial Output Image FileName
-    std::string path, fname, ext;
-    std::string ofname = GetParameterString("out");
-
-    // Get the extension and the prefix of the filename
-    path  = itksys::SystemTools::GetFilenamePath(ofname);
-    fname = itksys::SystemTools::GetFilenameWithoutExtension(ofname);
-    ext   = itksys::SystemTools::GetFilenameExtension(ofname);
-
     unsigned int currentLevel  = 1;
     unsigned int currentFactor = shrinkFactor;
 
@@ -161,32 +163,17 @@ private:
       m_ShrinkFilter->SetInput(m_SmoothingFilter->GetOutput());
       m_ShrinkFilter->SetShrinkFactors(currentFactor);
 
-      if (!fastScheme)
-      {
-        currentFactor *= shrinkFactor;
-      }
-      else
-      {
-        otbAppLogWARNING("fast scheme enabled : not implemented for the moment ");
-      }
+      currentFactor *= shrinkFactor;
 
       // Create an output parameter to write the current output image
       OutputImageParameter::Pointer paramOut = OutputImageParameter::New();
 
-      // build the current image filename
-      std::ostringstream oss;
-      if (!path.empty())
-      {
-        oss << path << "/";
-      }
-      oss << fname << "_" << currentLevel << ext;
-
       // writer label
       std::ostringstream osswriter;
       osswriter << "writer (level " << currentLevel << ")";
 
       // Set the filename of the current output image
-      paramOut->SetFileName(oss.str());
+      paramOut->SetFileName(GetLevelFileName(currentLevel));
       otbAppLogINFO(<< "File: " << paramOut->GetFileName() << " will be written.");
       paramOut->SetValue(m_ShrinkFilter->GetOutput());
       paramOut->SetPixelType(this->GetParameterOutputImagePixelType("out"));
@@ -202,8 +189,57 @@ private:
     DisableParameter("out");
   }
 
+  /** Build the file name of a level from the out parameter */
+  std::string GetLevelFileName(unsigned int level)
+  {
+    const std::string ofname = GetParameterString("out");
+
+    std::ostringstream oss;
+    const std::string  path = itksys::SystemTools::GetFilenamePath(ofname);
+    if (!path.empty())
+    {
+      oss << path << "/";
+    }
+    oss << itksys::SystemTools::GetFilenameWithoutExtension(ofname) << "_" << level << itksys::SystemTools::GetFilenameExtension(ofname);
+    return oss.str();
+  }
+
+  /** Compute each level from the previous one, and stream all of them
+   *  together so that the input is read only once */
+  void WriteCascadedPyramid(unsigned int nbLevels, unsigned int shrinkFactor, double varianceFactor)
+  {
+    m_PyramidFilter = PyramidFilterType::New();
+    m_PyramidFilter->SetInput(GetParameterImage("in"));
+    m_PyramidFilter->SetNumberOfLevels(nbLevels);
+    m_PyramidFilter->SetShrinkFactor(shrinkFactor);
+    m_PyramidFilter->SetVarianceFactor(varianceFactor);
+
+    // The cached rows of each level assume strips from top to bottom
+    otb::MultiImageFileWriter::Pointer writer = otb::MultiImageFileWriter::New();
+    writer->SetAutomaticStrippedStreaming(GetParameterInt("ram"));
+
+    std::vector<OutputImageParameter::Pointer> outputs;
+    for (unsigned int level = 1; level <= nbLevels; ++level)
+    {
+      OutputImageParameter::Pointer paramOut = OutputImageParameter::New();
+      paramOut->SetFileName(GetLevelFileName(level));
+      otbAppLogINFO(<< "File: " << paramOut->GetFileName() << " will be written.");
+      paramOut->SetValue(m_PyramidFilter->GetOutput(level - 1));
+      paramOut->SetPixelType(this->GetParameterOutputImagePixelType("out"));
+      paramOut->InitializeWriters(writer);
+      outputs.push_back(paramOut);
+    }
+
+    AddProcess(writer, "writer (all levels)");
+    writer->Update();
+
+    // Disable this parameter since the images have already been produced
+    DisableParameter("out");
+  }
+
   SmoothingVectorImageFilterType::Pointer m_SmoothingFilter;
   ShrinkFilterType::Pointer               m_ShrinkFilter;
+  PyramidFilterType::Pointer              m_PyramidFilter;
 };
 }
 }
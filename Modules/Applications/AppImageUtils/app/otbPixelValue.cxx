@@ -23,6 +23,16 @@
 
 #include "otbMultiChannelExtractROI.h"
 #include "otbGenericRSTransform.h"
+#include "otbBCOInterpolateImageFunction.h"
+#include "otbMetaDataKey.h"
+#include "itkLinearInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "itkPreOrderTreeIterator.h"
+#include "itkMetaDataObject.h"
+
+#include <algorithm>
+#include <fstream>
+#include <cmath>
 
 namespace otb
 {
@@ -41,6 +51,22 @@ public:
   typedef otb::MultiChannelExtractROI<FloatVectorImageType::InternalPixelType, FloatVectorImageType::InternalPixelType> ExtractROIFilterType;
 
   typedef otb::GenericRSTransform<> RSTransformType;
+
+  typedef itk::InterpolateImageFunction<FloatVectorImageType, double>                InterpolatorType;
+  typedef itk::LinearInterpolateImageFunction<FloatVectorImageType, double>          LinInterpolatorType;
+  typedef itk::NearestNeighborInterpolateImageFunction<FloatVectorImageType, double> NNInterpolatorType;
+  typedef otb::BCOInterpolateImageFunction<FloatVectorImageType> BCOInterpolatorType;
+  typedef InterpolatorType::ContinuousIndexType ContinuousIndexType;
+
+  /** A point of the batch mode: its coordinates as given, and its
+   * position in the input image */
+  struct QueryPoint
+  {
+    std::string         CoordX;
+    std::string         CoordY;
+    ContinuousIndexType Index;
+    bool                IsInside;
+  };
   /** Standard macro */
   itkNewMacro(Self);
 
@@ -58,7 +84,14 @@ private:
         "pixel. There are three ways to designate a pixel, with its index, "
         "its physical coordinate (in the physical space attached to the image), "
         "and with geographical coordinate system. Coordinates will be "
-        "interpreted differently depending on which mode is chosen.");
+        "interpreted differently depending on which mode is chosen.\n\n"
+        "In batch mode, the values at many points are sampled at once: the "
+        "points are read from a CSV file (whose first two columns are the "
+        "coordinates, interpreted according to the mode) or from a vector data "
+        "file holding point features. The points are sorted by block of the "
+        "input image, so that each block is read once, and the values of the "
+        "selected channels are interpolated at each point. The values are "
+        "written to an output CSV table, one line per point in the input order.");
     SetDocLimitations("None");
     SetDocAuthors("OTB-Team");
     SetDocSeeAlso(" ");
@@ -102,6 +135,40 @@ private:
     SetRasterData("cl", "in");
     MandatoryOff("cl");
 
+    AddParameter(ParameterType_InputFilename, "incsv", "Input points table");
+    SetParameterDescription("incsv",
+                            "CSV file of the points to sample in batch mode. The first two fields of "
+                            "each line are the X and Y coordinates, interpreted depending on the chosen "
+                            "mode. Fields are separated by commas, semicolons or blanks, and the lines "
+                            "which do not start with two numbers (headers, comments) are ignored.");
+    MandatoryOff("incsv");
+
+    AddParameter(ParameterType_InputVectorData, "invec", "Input points vector data");
+    SetParameterDescription("invec",
+                            "Vector data file of the points to sample in batch mode. The point features "
+                            "are reprojected to the input image, the mode is ignored.");
+    MandatoryOff("invec");
+
+    AddParameter(ParameterType_OutputFilename, "outcsv", "Output values table");
+    SetParameterDescription("outcsv",
+                            "CSV file receiving the X and Y coordinates and the values of the selected "
+                            "channels at each point of the batch mode. The values of the points outside "
+                            "of the image are nan. If not set, the table is logged.");
+    MandatoryOff("outcsv");
+
+    AddParameter(ParameterType_Choice, "interpolator", "Interpolation");
+    SetParameterDescription("interpolator", "Interpolation of the values between the pixel centers in batch mode.");
+    AddChoice("interpolator.nn", "Nearest Neighbor interpolation");
+    SetParameterDescription("interpolator.nn", "The value of the pixel containing the point.");
+    AddChoice("interpolator.linear", "Linear interpolation");
+    SetParameterDescription("interpolator.linear", "Bilinear interpolation of the 4 nearest pixels.");
+    AddChoice("interpolator.bco", "Bicubic interpolation");
+    SetParameterDescription("interpolator.bco", "Bicubic interpolation of the pixels in the given radius.");
+    AddParameter(ParameterType_Radius, "interpolator.bco.radius", "Radius for bicubic interpolation");
+    SetParameterDescription("interpolator.bco.radius", "This parameter allows controlling the size of the bicubic interpolation filter.");
+    SetDefaultParameterInt("interpolator.bco.radius", 2);
+    SetParameterString("interpolator", "nn");
+
     AddParameter(ParameterType_String, "value", "Pixel Value");
     SetParameterDescription("value", "Pixel radiometric value");
     SetParameterRole("value", Role_Output);
@@ -117,6 +184,18 @@ private:
 
   void DoUpdateParameters() override
   {
+    // The single pixel coordinates are not needed in batch mode
+    if (IsBatchMode())
+    {
+      MandatoryOff("coordx");
+      MandatoryOff("coordy");
+    }
+    else
+    {
+      MandatoryOn("coordx");
+      MandatoryOn("coordy");
+    }
+
     if (HasValue("in"))
     {
       ExtractROIFilterType::InputImageType* inImage = GetParameterImage("in");
@@ -200,8 +279,307 @@ private:
     return box;
   }
 
+  bool IsBatchMode()
+  {
+    return (IsParameterEnabled("incsv") && HasValue("incsv")) || (IsParameterEnabled("invec") && HasValue("invec"));
+  }
+
+  /** Read the two first numbers of each line of a CSV file */
+  std::vector<QueryPoint> ReadCsvPoints(const std::string& fileName)
+  {
+    std::ifstream ifs(fileName);
+    if (!ifs)
+    {
+      otbAppLogFATAL(<< "Unable to open " << fileName);
+    }
+
+    std::vector<QueryPoint> points;
+    unsigned int            ignored = 0;
+    std::string             line;
+    while (std::getline(ifs, line))
+    {
+      std::vector<std::string> fields;
+      std::size_t              start = line.find_first_not_of(",; \t\r");
+      while (start != std::string::npos && fields.size() < 2)
+      {
+        const std::size_t end = line.find_first_of(",; \t\r", start);
+        fields.push_back(line.substr(start, end == std::string::npos ? std::string::npos : end - start));
+        start = line.find_first_not_of(",; \t\r", end);
+      }
+
+      QueryPoint point;
+      try
+      {
+        if (fields.size() < 2 || fields[0][0] == '#')
+        {
+          throw std::invalid_argument(line);
+        }
+        point.Index[0] = std::stod(fields[0]);
+        point.Index[1] = std::stod(fields[1]);
+      }
+      catch (std::exception&)
+      {
+        ignored += !line.empty();
+        continue;
+      }
+      point.CoordX = fields[0];
+      point.CoordY = fields[1];
+      points.push_back(point);
+    }
+    if (ignored > 0)
+    {
+      otbAppLogINFO(<< ignored << " lines of " << fileName << " are not points and have been ignored");
+    }
+    return points;
+  }
+
+  /** Collect the point features of a vector data, with their coordinates
+   * in the physical space of the image */
+  std::vector<QueryPoint> ReadVectorPoints(VectorDataType* vectorData, FloatVectorImageType* image)
+  {
+    RSTransformType::Pointer rsTransform = RSTransformType::New();
+    rsTransform->SetInputProjectionRef(vectorData->GetProjectionRef());
+    rsTransform->SetOutputImageMetadata(&(image->GetImageMetadata()));
+    rsTransform->SetOutputProjectionRef(image->GetProjectionRef());
+    rsTransform->InstantiateTransform();
+
+    std::vector<QueryPoint>                                  points;
+    itk::PreOrderTreeIterator<VectorDataType::DataTreeType> it(vectorData->GetDataTree());
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      if (!it.Get()->IsPointFeature())
+      {
+        continue;
+      }
+      const VectorDataType::PointType vectorPoint = it.Get()->GetPoint();
+      RSTransformType::InputPointType inPoint;
+      inPoint[0] = vectorPoint[0];
+      inPoint[1] = vectorPoint[1];
+      const RSTransformType::OutputPointType outPoint = rsTransform->TransformPoint(inPoint);
+
+      QueryPoint point;
+      point.CoordX   = std::to_string(vectorPoint[0]);
+      point.CoordY   = std::to_string(vectorPoint[1]);
+      point.Index[0] = outPoint[0];
+      point.Index[1] = outPoint[1];
+      points.push_back(point);
+    }
+    return points;
+  }
+
+  /** Sample the values of the selected channels at many points, reading
+   * each block of the input image once */
+  void ExecuteBatch(FloatVectorImageType* inImage, ExtractROIFilterType* extractor)
+  {
+    const std::string mode = GetParameterString("mode");
+
+    // Compute the continuous index of each point
+    std::vector<QueryPoint> points;
+    if (IsParameterEnabled("invec") && HasValue("invec"))
+    {
+      points = ReadVectorPoints(GetParameterVectorData("invec"), inImage);
+      for (auto& point : points)
+      {
+        itk::Point<double, 2> physical;
+        physical[0] = point.Index[0];
+        physical[1] = point.Index[1];
+        inImage->TransformPhysicalPointToContinuousIndex(physical, point.Index);
+      }
+    }
+    if (IsParameterEnabled("incsv") && HasValue("incsv"))
+    {
+      std::vector<QueryPoint> csvPoints = ReadCsvPoints(GetParameterString("incsv"));
+      RSTransformType::Pointer rsTransform;
+      if (mode == "epsg")
+      {
+        rsTransform = RSTransformType::New();
+        if (HasUserValue("mode.epsg.code"))
+        {
+          rsTransform->SetInputProjectionRef(otb::SpatialReference::FromEPSG(GetParameterInt("mode.epsg.code")).ToWkt());
+        }
+        rsTransform->SetOutputImageMetadata(&(inImage->GetImageMetadata()));
+        rsTransform->SetOutputProjectionRef(inImage->GetProjectionRef());
+        rsTransform->InstantiateTransform();
+      }
+      for (auto& point : csvPoints)
+      {
+        if (mode == "index")
+        {
+          point.Index[0] += inImage->GetLargestPossibleRegion().GetIndex(0);
+          point.Index[1] += inImage->GetLargestPossibleRegion().GetIndex(1);
+          continue;
+        }
+        RSTransformType::InputPointType physical;
+        physical[0] = point.Index[0];
+        physical[1] = point.Index[1];
+        if (rsTransform)
+        {
+          physical = rsTransform->TransformPoint(physical);
+        }
+        inImage->TransformPhysicalPointToContinuousIndex(physical, point.Index);
+      }
+      points.insert(points.end(), csvPoints.begin(), csvPoints.end());
+    }
+
+    const FloatVectorImageType::RegionType largestRegion = inImage->GetLargestPossibleRegion();
+    unsigned int                           nbOutside     = 0;
+    for (auto& point : points)
+    {
+      point.IsInside = largestRegion.IsInside(point.Index);
+      nbOutside += !point.IsInside;
+    }
+
+    // Neighbourhood of the points needed by the interpolator
+    InterpolatorType::Pointer interpolator;
+    long                      radius = 0;
+    const std::string         method = GetParameterString("interpolator");
+    if (method == "linear")
+    {
+      interpolator = LinInterpolatorType::New();
+      radius       = 1;
+    }
+    else if (method == "bco")
+    {
+      BCOInterpolatorType::Pointer bcoInterpolator = BCOInterpolatorType::New();
+      bcoInterpolator->SetRadius(GetParameterInt("interpolator.bco.radius"));
+      interpolator = bcoInterpolator;
+      radius       = GetParameterInt("interpolator.bco.radius");
+    }
+    else
+    {
+      interpolator = NNInterpolatorType::New();
+    }
+
+    // Group the points by block of the input file
+    unsigned int blockSizeX(0), blockSizeY(0);
+    itk::ExposeMetaData<unsigned int>(inImage->GetMetaDataDictionary(), MetaDataKey::TileHintX, blockSizeX);
+    itk::ExposeMetaData<unsigned int>(inImage->GetMetaDataDictionary(), MetaDataKey::TileHintY, blockSizeY);
+    blockSizeX = blockSizeX != 0 ? blockSizeX : 256;
+    blockSizeY = blockSizeY != 0 ? blockSizeY : 256;
+
+    auto blockOf = [&](const QueryPoint& point) {
+      const long x = static_cast<long>(std::floor(point.Index[0] + 0.5)) - largestRegion.GetIndex(0);
+      const long y = static_cast<long>(std::floor(point.Index[1] + 0.5)) - largestRegion.GetIndex(1);
+      return std::make_pair(y / blockSizeY, x / blockSizeX);
+    };
+
+    std::vector<std::size_t> order;
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      if (points[i].IsInside)
+      {
+        order.push_back(i);
+      }
+    }
+    std::sort(order.begin(), order.end(), [&](std::size_t a, std::size_t b) { return blockOf(points[a]) < blockOf(points[b]); });
+
+    // Read the neighbourhood of the points of each block, and interpolate
+    std::vector<InterpolatorType::OutputType> values(points.size());
+    unsigned int                              nbReadRegions = 0;
+    for (auto first = order.begin(); first != order.end();)
+    {
+      const auto block = blockOf(points[*first]);
+      auto       last  = first;
+      double     minX = points[*first].Index[0], maxX = minX, minY = points[*first].Index[1], maxY = minY;
+      for (; last != order.end() && blockOf(points[*last]) == block; ++last)
+      {
+        minX = std::min(minX, points[*last].Index[0]);
+        maxX = std::max(maxX, points[*last].Index[0]);
+        minY = std::min(minY, points[*last].Index[1]);
+        maxY = std::max(maxY, points[*last].Index[1]);
+      }
+
+      FloatVectorImageType::IndexType start, end;
+      start[0] = static_cast<long>(std::floor(minX)) - radius;
+      start[1] = static_cast<long>(std::floor(minY)) - radius;
+      end[0]   = static_cast<long>(std::ceil(maxX)) + radius;
+      end[1]   = static_cast<long>(std::ceil(maxY)) + radius;
+      FloatVectorImageType::RegionType region;
+      region.SetIndex(start);
+      region.SetSize(0, end[0] - start[0] + 1);
+      region.SetSize(1, end[1] - start[1] + 1);
+      region.Crop(largestRegion);
+
+      extractor->SetExtractionRegion(region);
+      extractor->Update();
+      interpolator->SetInputImage(extractor->GetOutput());
+      ++nbReadRegions;
+
+      // The extracted image starts at index 0
+      for (; first != last; ++first)
+      {
+        ContinuousIndexType index = points[*first].Index;
+        index[0] -= region.GetIndex(0);
+        index[1] -= region.GetIndex(1);
+        values[*first] = interpolator->EvaluateAtContinuousIndex(index);
+      }
+    }
+
+    otbAppLogINFO(<< points.size() << " points sampled by reading " << nbReadRegions << " regions of the image, " << nbOutside
+                  << " points are outside of the image");
+
+    // Write the table in the order of the input points
+    const unsigned int nbChannels = extractor->GetOutput()->GetNumberOfComponentsPerPixel();
+    std::ostringstream table;
+    table << "x,y";
+    for (unsigned int channel = 0; channel < nbChannels; ++channel)
+    {
+      table << ",b" << channel + 1;
+    }
+    table << "\n";
+    table.precision(10);
+    for (std::size_t i = 0; i < points.size(); ++i)
+    {
+      table << points[i].CoordX << "," << points[i].CoordY;
+      for (unsigned int channel = 0; channel < nbChannels; ++channel)
+      {
+        if (points[i].IsInside)
+        {
+          table << "," << values[i][channel];
+        }
+        else
+        {
+          table << ",nan";
+        }
+      }
+      table << "\n";
+    }
+
+    if (IsParameterEnabled("outcsv") && HasValue("outcsv"))
+    {
+      std::ofstream ofs(GetParameterString("outcsv"));
+      if (!ofs)
+      {
+        otbAppLogFATAL(<< "Unable to write " << GetParameterString("outcsv"));
+      }
+      ofs << table.str();
+    }
+    else
+    {
+      otbAppLogINFO(<< "Pixel values:\n" << table.str());
+    }
+  }
+
   void DoExecute() override
   {
+    if (IsBatchMode())
+    {
+      FloatVectorImageType::Pointer inImage   = GetParameterImage("in");
+      ExtractROIFilterType::Pointer extractor = ExtractROIFilterType::New();
+      extractor->SetInput(inImage);
+      if (GetParameterByKey("cl")->GetActive())
+      {
+        for (unsigned int idx = 0; idx < GetSelectedItems("cl").size(); ++idx)
+        {
+          extractor->SetChannel(GetSelectedItems("cl")[idx] + 1);
+        }
+      }
+      // Sets the number of output channels, even without any point
+      extractor->UpdateOutputInformation();
+      ExecuteBatch(inImage, extractor);
+      return;
+    }
+
     std::string                     mode    = GetParameterString("mode");
     FloatVectorImageType::Pointer   inImage = GetParameterImage("in");
     FloatVectorImageType::IndexType id;
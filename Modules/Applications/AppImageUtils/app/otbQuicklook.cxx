@@ -23,6 +23,7 @@
 
 #include "otbMultiChannelExtractROI.h"
 #include "otbStreamingShrinkImageFilter.h"
+#include "otbImageFileReader.h"
 
 namespace otb
 {
@@ -50,6 +51,7 @@ public:
   typedef ExtractROIFilterType::InputImageType  InputImageType;
   typedef ExtractROIFilterType::OutputImageType OutputImageType;
   typedef otb::StreamingShrinkImageFilter<ExtractROIFilterType::OutputImageType, ExtractROIFilterType::OutputImageType> ShrinkImageFilterType;
+  typedef otb::ImageFileReader<InputImageType> ReaderType;
 
 private:
   void DoInit() override
@@ -110,6 +112,20 @@ private:
     MandatoryOff("sy");
     DisableParameter("sy");
 
+    AddParameter(ParameterType_Bool, "fast", "Read at a coarser resolution");
+    SetParameterDescription("fast",
+                            "Read the input directly at the coarsest power of two resolution compatible with the sampling ratio and the ROI origin, "
+                            "so that GDAL can use the overviews of the image, then subsample the remaining ratio");
+
+    AddParameter(ParameterType_Choice, "resampling", "Resampling of coarser resolution reads");
+    SetParameterDescription("resampling", "Resampling method used by GDAL when the fast option reads the input at a coarser resolution");
+    AddChoice("resampling.average", "Average");
+    AddChoice("resampling.nearest", "Nearest neighbour");
+    AddChoice("resampling.bilinear", "Bilinear");
+    AddChoice("resampling.cubic", "Cubic");
+    AddChoice("resampling.lanczos", "Lanczos");
+    AddChoice("resampling.mode", "Mode");
+
     SetDefaultParameterInt("rox", 0);
     SetDefaultParameterInt("roy", 0);
     SetDefaultParameterInt("rsx", 0);
@@ -203,45 +219,53 @@ private:
     return false;
   }
 
-  void DoExecute() override
+  /** Coarsest resolution level 2^level dividing both the sampling ratio
+   *  and the ROI origin, so that the quicklook grid is unchanged */
+  unsigned int SelectResolutionLevel(unsigned int ratio)
   {
-    InputImageType::Pointer inImage = GetParameterImage("in");
+    const unsigned int origin = static_cast<unsigned int>(GetParameterInt("rox") | GetParameterInt("roy"));
+    unsigned int       level  = 0;
+    while (ratio % (2u << level) == 0 && origin % (2u << level) == 0)
+    {
+      ++level;
+    }
+    return level;
+  }
 
-    ExtractROIFilterType::Pointer  extractROIFilter = ExtractROIFilterType::New();
-    ShrinkImageFilterType::Pointer resamplingFilter = ShrinkImageFilterType::New();
+  /** Read the input image at the given resolution level, returns a null
+   *  pointer if the format does not support it */
+  InputImageType::Pointer ReadAtResolutionLevel(unsigned int level)
+  {
+    std::string fileName = GetParameterString("in");
+    if (fileName.empty() || fileName.find("resol=") != std::string::npos)
+    {
+      otbAppLogWARNING(<< "The input can not be read at a coarser resolution, the fast option is ignored.");
+      return nullptr;
+    }
 
-    // The image on which the quicklook will be generated
-    // Will eventually be the extractROIFilter output
+    std::ostringstream extended;
+    extended << fileName << (fileName.find('?') == std::string::npos ? "?" : "") << "&resol=" << level
+             << "&resample=" << GetParameterString("resampling");
 
-    if (HasUserValue("rox") || HasUserValue("roy") || HasUserValue("rsx") || HasUserValue("rsy") || (GetSelectedItems("cl").size() > 0))
-    {
-      extractROIFilter->SetInput(inImage);
-      extractROIFilter->SetStartX(GetParameterInt("rox"));
-      extractROIFilter->SetStartY(GetParameterInt("roy"));
-      extractROIFilter->SetSizeX(GetParameterInt("rsx"));
-      extractROIFilter->SetSizeY(GetParameterInt("rsy"));
+    m_Reader = ReaderType::New();
+    m_Reader->SetFileName(extended.str());
+    m_Reader->UpdateOutputInformation();
 
-      if ((GetSelectedItems("cl").size() > 0))
-      {
-        for (unsigned int idx = 0; idx < GetSelectedItems("cl").size(); ++idx)
-        {
-          extractROIFilter->SetChannel(GetSelectedItems("cl")[idx] + 1);
-        }
-      }
-      else
-      {
-        unsigned int nbComponents = inImage->GetNumberOfComponentsPerPixel();
-        for (unsigned int idx = 0; idx < nbComponents; ++idx)
-        {
-          extractROIFilter->SetChannel(idx + 1);
-        }
-      }
-      resamplingFilter->SetInput(extractROIFilter->GetOutput());
-    }
-    else
+    // Only the formats honouring the resolution factor give a coarser image
+    const InputImageType::SizeType fullSize = GetParameterImage("in")->GetLargestPossibleRegion().GetSize();
+    const InputImageType::SizeType size     = m_Reader->GetOutput()->GetLargestPossibleRegion().GetSize();
+    if (size[0] != (fullSize[0] + (1u << level) - 1) >> level || size[1] != (fullSize[1] + (1u << level) - 1) >> level)
     {
-      resamplingFilter->SetInput(inImage);
+      otbAppLogWARNING(<< "The input format does not support reading at a coarser resolution, the fast option is ignored.");
+      m_Reader = nullptr;
+      return nullptr;
     }
+    return m_Reader->GetOutput();
+  }
+
+  void DoExecute() override
+  {
+    InputImageType::Pointer inImage = GetParameterImage("in");
 
     unsigned int Ratio          = static_cast<unsigned int>(GetParameterInt("sr"));
     unsigned int SamplingRatioX = 1;
@@ -278,12 +302,67 @@ private:
     }
     otbAppLogINFO(<< "Ratio used: " << Ratio << ".");
 
+    // Read the input at a coarser resolution when possible
+    unsigned int level = GetParameterInt("fast") ? this->SelectResolutionLevel(Ratio) : 0;
+    if (level > 0)
+    {
+      inImage = this->ReadAtResolutionLevel(level);
+      if (inImage.IsNull())
+      {
+        level   = 0;
+        inImage = GetParameterImage("in");
+      }
+      else
+      {
+        otbAppLogINFO(<< "Input read at resolution level " << level << ", remaining ratio: " << (Ratio >> level) << ".");
+        Ratio >>= level;
+      }
+    }
+
+    ExtractROIFilterType::Pointer  extractROIFilter = ExtractROIFilterType::New();
+    ShrinkImageFilterType::Pointer resamplingFilter = ShrinkImageFilterType::New();
+
+    // The image on which the quicklook will be generated
+    // Will eventually be the extractROIFilter output
+
+    if (HasUserValue("rox") || HasUserValue("roy") || HasUserValue("rsx") || HasUserValue("rsy") || (GetSelectedItems("cl").size() > 0))
+    {
+      extractROIFilter->SetInput(inImage);
+      extractROIFilter->SetStartX(GetParameterInt("rox") >> level);
+      extractROIFilter->SetStartY(GetParameterInt("roy") >> level);
+      extractROIFilter->SetSizeX(std::max(GetParameterInt("rsx") >> level, 1));
+      extractROIFilter->SetSizeY(std::max(GetParameterInt("rsy") >> level, 1));
+
+      if ((GetSelectedItems("cl").size() > 0))
+      {
+        for (unsigned int idx = 0; idx < GetSelectedItems("cl").size(); ++idx)
+        {
+          extractROIFilter->SetChannel(GetSelectedItems("cl")[idx] + 1);
+        }
+      }
+      else
+      {
+        unsigned int nbComponents = inImage->GetNumberOfComponentsPerPixel();
+        for (unsigned int idx = 0; idx < nbComponents; ++idx)
+        {
+          extractROIFilter->SetChannel(idx + 1);
+        }
+      }
+      resamplingFilter->SetInput(extractROIFilter->GetOutput());
+    }
+    else
+    {
+      resamplingFilter->SetInput(inImage);
+    }
+
     resamplingFilter->SetShrinkFactor(Ratio);
     resamplingFilter->Update();
 
     SetParameterOutputImage("out", resamplingFilter->GetOutput());
     RegisterPipeline();
   }
+
+  ReaderType::Pointer m_Reader;
 };
 }
 }
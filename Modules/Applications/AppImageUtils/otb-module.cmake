@@ -32,6 +32,7 @@ otb_module(OTBAppImageUtils
     OTBITK
     OTBImageBase
     OTBImageManipulation
+    OTBInterpolation
     OTBOSSIMAdapters
     OTBObjectList
     OTBProjection
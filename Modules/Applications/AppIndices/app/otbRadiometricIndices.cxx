@@ -26,7 +26,7 @@
 #include "otbWaterIndicesFunctor.h"
 #include "otbBuiltUpIndicesFunctor.h"
 #include "otbSoilIndicesFunctor.h"
-#include "otbIndicesStackFunctor.h"
+#include "otbMultiIndicesFunctor.h"
 #include "otbFunctorImageFilter.h"
 
 namespace otb
@@ -51,18 +51,25 @@ public:
   using InputType  = FloatVectorImageType::InternalPixelType;
   using OutputType = FloatImageType::PixelType;
 
-  using RadiometricIndexType    = otb::Functor::RadiometricIndex<InputType, OutputType>;
-  using IndicesStackFunctorType = otb::Functor::IndicesStackFunctor<RadiometricIndexType>;
+  // All available indices, in the order of m_Map
+  using IndicesFunctorType = otb::Functor::MultiIndicesFunctor<
+      otb::Functor::NDVI<InputType, OutputType>, otb::Functor::TNDVI<InputType, OutputType>, otb::Functor::RVI<InputType, OutputType>,
+      otb::Functor::SAVI<InputType, OutputType>, otb::Functor::TSAVI<InputType, OutputType>, otb::Functor::MSAVI<InputType, OutputType>,
+      otb::Functor::MSAVI2<InputType, OutputType>, otb::Functor::GEMI<InputType, OutputType>, otb::Functor::IPVI<InputType, OutputType>,
+      otb::Functor::LAIFromNDVILogarithmic<InputType, OutputType>, otb::Functor::LAIFromReflectancesLinear<InputType, OutputType>,
+      otb::Functor::LAIFromNDVIFormosat2Functor<InputType, OutputType>, otb::Functor::NDWI<InputType, OutputType>,
+      otb::Functor::NDWI2<InputType, OutputType>, otb::Functor::MNDWI<InputType, OutputType>, otb::Functor::NDTI<InputType, OutputType>,
+      otb::Functor::RI<InputType, OutputType>, otb::Functor::CI<InputType, OutputType>, otb::Functor::BI<InputType, OutputType>,
+      otb::Functor::BI2<InputType, OutputType>, otb::Functor::ISU<InputType, OutputType>>;
 
   class indiceSpec
   {
   public:
-    indiceSpec(std::string k, std::string i, RadiometricIndexType* ind) : key(k), item(i), indice(ind)
+    indiceSpec(std::string k, std::string i) : key(k), item(i)
     {
     }
-    std::string                           key;
-    std::string                           item;
-    std::unique_ptr<RadiometricIndexType> indice;
+    std::string key;
+    std::string item;
   };
 
 
@@ -153,27 +160,29 @@ private:
 
     m_Map.clear();
 
-    m_Map.push_back({"list.ndvi", "Vegetation:NDVI", new otb::Functor::NDVI<InputType, OutputType>()});
-    m_Map.push_back({"list.tndvi", "Vegetation:TNDVI", new otb::Functor::TNDVI<InputType, OutputType>()});
-    m_Map.push_back({"list.rdvi", "Vegetation:RVI", new otb::Functor::RVI<InputType, OutputType>()});
-    m_Map.push_back({"list.savi", "Vegetation:SAVI", new otb::Functor::SAVI<InputType, OutputType>()});
-    m_Map.push_back({"list.tsavi", "Vegetation:TSAVI", new otb::Functor::TSAVI<InputType, OutputType>()});
-    m_Map.push_back({"list.msavi", "Vegetation:MSAVI", new otb::Functor::MSAVI<InputType, OutputType>()});
-    m_Map.push_back({"list.msavi2", "Vegetation:MSAVI2", new otb::Functor::MSAVI2<InputType, OutputType>()});
-    m_Map.push_back({"list.gemi", "Vegetation:GEMI", new otb::Functor::GEMI<InputType, OutputType>()});
-    m_Map.push_back({"list.ipvi", "Vegetation:IPVI", new otb::Functor::IPVI<InputType, OutputType>()});
-    m_Map.push_back({"list.laindvilog", "Vegetation:LAIFromNDVILog", new otb::Functor::LAIFromNDVILogarithmic<InputType, OutputType>()});
-    m_Map.push_back({"list.lairefl", "Vegetation:LAIFromReflLinear", new otb::Functor::LAIFromReflectancesLinear<InputType, OutputType>()});
-    m_Map.push_back({"list.laindviformo", "Vegetation:LAIFromNDVIFormo", new otb::Functor::LAIFromNDVIFormosat2Functor<InputType, OutputType>()});
-    m_Map.push_back({"list.ndwi", "Water:NDWI", new otb::Functor::NDWI<InputType, OutputType>()});
-    m_Map.push_back({"list.ndwi2", "Water:NDWI2", new otb::Functor::NDWI2<InputType, OutputType>()});
-    m_Map.push_back({"list.mndwi", "Water:MNDWI", new otb::Functor::MNDWI<InputType, OutputType>()});
-    m_Map.push_back({"list.ndti", "Water:NDTI", new otb::Functor::NDTI<InputType, OutputType>()});
-    m_Map.push_back({"list.ri", "Soil:RI", new otb::Functor::RI<InputType, OutputType>()});
-    m_Map.push_back({"list.ci", "Soil:CI", new otb::Functor::CI<InputType, OutputType>()});
-    m_Map.push_back({"list.bi", "Soil:BI", new otb::Functor::BI<InputType, OutputType>()});
-    m_Map.push_back({"list.bi2", "Soil:BI2", new otb::Functor::BI2<InputType, OutputType>()});
-    m_Map.push_back({"list.isu", "BuiltUp:ISU", new otb::Functor::ISU<InputType, OutputType>()});
+    m_Map.push_back({"list.ndvi", "Vegetation:NDVI"});
+    m_Map.push_back({"list.tndvi", "Vegetation:TNDVI"});
+    m_Map.push_back({"list.rdvi", "Vegetation:RVI"});
+    m_Map.push_back({"list.savi", "Vegetation:SAVI"});
+    m_Map.push_back({"list.tsavi", "Vegetation:TSAVI"});
+    m_Map.push_back({"list.msavi", "Vegetation:MSAVI"});
+    m_Map.push_back({"list.msavi2", "Vegetation:MSAVI2"});
+    m_Map.push_back({"list.gemi", "Vegetation:GEMI"});
+    m_Map.push_back({"list.ipvi", "Vegetation:IPVI"});
+    m_Map.push_back({"list.laindvilog", "Vegetation:LAIFromNDVILog"});
+    m_Map.push_back({"list.lairefl", "Vegetation:LAIFromReflLinear"});
+    m_Map.push_back({"list.laindviformo", "Vegetation:LAIFromNDVIFormo"});
+    m_Map.push_back({"list.ndwi", "Water:NDWI"});
+    m_Map.push_back({"list.ndwi2", "Water:NDWI2"});
+    m_Map.push_back({"list.mndwi", "Water:MNDWI"});
+    m_Map.push_back({"list.ndti", "Water:NDTI"});
+    m_Map.push_back({"list.ri", "Soil:RI"});
+    m_Map.push_back({"list.ci", "Soil:CI"});
+    m_Map.push_back({"list.bi", "Soil:BI"});
+    m_Map.push_back({"list.bi2", "Soil:BI2"});
+    m_Map.push_back({"list.isu", "BuiltUp:ISU"});
+
+    assert(m_Map.size() == IndicesFunctorType::NumberOfIndices && "m_Map must follow the indices of IndicesFunctorType");
 
     ClearChoices("list");
 
@@ -183,19 +192,6 @@ private:
     }
   }
 
-  // Compute required bands for selected indices
-  std::set<CommonBandNames> GetRequiredBands()
-  {
-    std::set<CommonBandNames> required;
-
-    for (unsigned int idx = 0; idx < GetSelectedItems("list").size(); ++idx)
-    {
-      auto requiredForCurrentIndice = m_Map[GetSelectedItems("list")[idx]].indice->GetRequiredBands();
-      required.insert(requiredForCurrentIndice.begin(), requiredForCurrentIndice.end());
-    }
-    return required;
-  }
-
   void DoUpdateParameters() override
   {
     // Nothing to do here
@@ -206,8 +202,17 @@ private:
     // Retrieve number of bands of input image
     unsigned int nbChan = GetParameterImage("in")->GetNumberOfComponentsPerPixel();
 
+    // Select the indices to compute, in the order of the list
+    const std::vector<int> selectedItems = GetSelectedItems("list");
+    if (selectedItems.empty())
+    {
+      otbAppLogFATAL(<< "No radiometric index selected");
+    }
+    IndicesFunctorType indicesFunctor;
+    indicesFunctor.SetSelectedIndices(std::vector<size_t>(selectedItems.begin(), selectedItems.end()));
+
     // Derive required bands from selected indices
-    auto requiredBands = GetRequiredBands();
+    auto requiredBands = indicesFunctor.GetRequiredBands();
 
     // Map to store association between bands and indices
     std::map<CommonBandNames, size_t> bandIndicesMap;
@@ -239,24 +244,11 @@ private:
     bandChecker(bandIndicesMap, CommonBandNames::NIR, "channels.nir");
     bandChecker(bandIndicesMap, CommonBandNames::MIR, "channels.mir");
 
-    std::vector<RadiometricIndexType*> indices;
-
-    // Find selected indices
-    for (unsigned int idx = 0; idx < GetSelectedItems("list").size(); ++idx)
-    {
-      // Retrieve the indice instance
-      indices.push_back(m_Map[GetSelectedItems("list")[idx]].indice.get());
-
-      // And set bands using the band map
-      indices.back()->SetBandsIndices(bandIndicesMap);
-    }
-
-    // Build a composite indices functor to compute all indices at
-    // once
-    auto compositeFunctor = IndicesStackFunctorType(indices);
+    // Set bands using the band map
+    indicesFunctor.SetBandsIndices(bandIndicesMap);
 
-    // Build and plug functor filter
-    auto filter = NewFunctorFilter(compositeFunctor);
+    // Build and plug functor filter, computing all indices at once
+    auto filter = NewFunctorFilter(indicesFunctor);
     filter->SetInputs(GetParameterImage("in"));
     SetParameterOutputImage("out", filter->GetOutput());
 
@@ -218,6 +218,12 @@ private:
     SetParameterDescription("outcontext", "A txt file where to save user's constants and expressions.");
     MandatoryOff("outcontext");
 
+    AddParameter(ParameterType_Bool, "compiled", "Compiled evaluation");
+    SetParameterDescription("compiled",
+                            "Evaluate scalar expressions line by line with a compiled program instead of pixel by pixel with muParserX. "
+                            "Expressions using features the compiled evaluation does not support (vectors, matrices, neighborhoods, "
+                            "or functions other than the usual scalar ones and ndvi) are still evaluated by muParserX.");
+
     AddRAMParameter();
 
     // Doc example parameter settings
@@ -353,6 +359,7 @@ private:
     std::string expStr = GetParameterString("exp");
     otbAppLogINFO("Using expression: " << expStr);
     math_filter->SetExpression(expStr);
+    math_filter->SetCompiledEvaluation(GetParameterInt("compiled"));
 
     if (IsParameterEnabled("outcontext") && HasValue("outcontext"))
       math_filter->ExportContext(GetParameterString("outcontext"));
@@ -22,6 +22,7 @@
 #include "otbWrapperApplicationRegistry.h"
 #include "otbWrapperTypes.h"
 #include <string>
+#include <cmath>
 
 typedef otb::VectorImage<unsigned char> VectorImageType;
 typedef VectorImageType::PixelType      PixelType;
@@ -168,5 +169,27 @@ int main(int, char* argv[])
   {
     std::cout << "Case three passed" << std::endl;
   }
+
+  // Case four: compiled evaluation
+  app->SetParameterString("exp", "ndvi(im2b1, im1b1) + (im1b2 > 0 ? im2b1 : 0)");
+  app->SetParameterInt("compiled", 1);
+  app->UpdateParameters();
+  std::cout << "Case four: compiled evaluation" << std::endl;
+  app->Execute();
+  output = app->GetParameterImageBase("out");
+  output->Update();
+  // We need to be careful as we are taking the direct output of the underlying
+  // filter in the application
+  dyn_cast(output, output_int) im_val = output_int->GetPixel(index).GetElement(0);
+  // ndvi(2, 1) = -1/3
+  if (std::abs(im_val - (2. - 1. / 3.)) > 1e-6)
+  {
+    std::cout << "Wrong value in test, was expecting " << 2. - 1. / 3. << ", got " << im_val << std::endl;
+    return_val++;
+  }
+  else
+  {
+    std::cout << "Case four passed" << std::endl;
+  }
   return return_val;
 }
\ No newline at end of file
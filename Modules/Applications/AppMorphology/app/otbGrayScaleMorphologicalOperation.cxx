@@ -29,6 +29,9 @@
 #include "itkGrayscaleMorphologicalOpeningImageFilter.h"
 #include "itkGrayscaleMorphologicalClosingImageFilter.h"
 
+#include "otbVanHerkGilWermanErodeImageFilter.h"
+#include "otbVanHerkGilWermanDilateImageFilter.h"
+
 #include "otbMultiToMonoChannelExtractROI.h"
 #include "otbImageList.h"
 #include "otbImageListToVectorImageFilter.h"
@@ -57,6 +60,10 @@ public:
   typedef itk::GrayscaleMorphologicalOpeningImageFilter<FloatImageType, FloatImageType, StructuringType> OpeningFilterType;
   typedef itk::GrayscaleMorphologicalClosingImageFilter<FloatImageType, FloatImageType, StructuringType> ClosingFilterType;
 
+  typedef VanHerkGilWermanErodeImageFilter<FloatImageType, FloatImageType>  FastErodeFilterType;
+  typedef VanHerkGilWermanDilateImageFilter<FloatImageType, FloatImageType> FastDilateFilterType;
+  typedef FastErodeFilterType::KernelType                                   FastStructuringType;
+
   typedef ImageList<FloatImageType> ImageListType;
   typedef ImageListToVectorImageFilter<ImageListType, FloatVectorImageType> ImageListToVectorImageFilterType;
 
@@ -76,7 +83,7 @@ private:
     SetDocAuthors("OTB-Team");
     SetDocSeeAlso(
         "itkGrayscaleDilateImageFilter, itkGrayscaleErodeImageFilter, itkGrayscaleMorphologicalOpeningImageFilter and "
-        "itkGrayscaleMorphologicalClosingImageFilter classes");
+        "itkGrayscaleMorphologicalClosingImageFilter, otbVanHerkGilWermanErodeImageFilter and otbVanHerkGilWermanDilateImageFilter classes");
 
     AddDocTag(Tags::FeatureExtraction);
     AddDocTag("Morphology");
@@ -104,6 +111,11 @@ private:
     AddChoice("structype.box", "Box");
     AddChoice("structype.ball", "Ball");
     AddChoice("structype.cross", "Cross");
+    AddChoice("structype.octagon", "Octagon");
+    SetParameterDescription("structype.octagon",
+                            "Octagonal approximation of a ball, decomposed in lines. "
+                            "Erosions and dilations use the van Herk/Gil-Werman algorithm, whose cost does not depend on the radius. "
+                            "Openings and closings are the composition of an erosion and a dilation.");
 
     AddParameter(ParameterType_Choice, "filter", "Morphological Operation");
     SetParameterDescription("filter", "Choice of the morphological operation");
@@ -155,6 +167,15 @@ private:
     rad[0] = this->GetParameterInt("xradius");
     rad[1] = this->GetParameterInt("yradius");
 
+    if (GetParameterString("structype") == "octagon")
+    {
+      FastStructuringType::RadiusType fastRad;
+      fastRad[0] = rad[0];
+      fastRad[1] = rad[1];
+      ExecuteFastOperation(FastStructuringType::Disk(fastRad));
+      return;
+    }
+
     StructuringType se;
     if (GetParameterString("structype") == "box")
     {
@@ -199,12 +220,45 @@ private:
     }
   }
 
+  void ExecuteFastOperation(const FastStructuringType& se)
+  {
+    const std::string filter  = GetParameterString("filter");
+    FloatImageType*   current = m_ExtractorFilter->GetOutput();
+
+    // Opening is an erosion followed by a dilation, closing the converse
+    if (filter == "dilate" || filter == "closing")
+    {
+      m_FastDilFilter = FastDilateFilterType::New();
+      m_FastDilFilter->SetKernel(se);
+      m_FastDilFilter->SetInput(current);
+      current = m_FastDilFilter->GetOutput();
+    }
+    if (filter == "erode" || filter == "opening" || filter == "closing")
+    {
+      m_FastEroFilter = FastErodeFilterType::New();
+      m_FastEroFilter->SetKernel(se);
+      m_FastEroFilter->SetInput(current);
+      current = m_FastEroFilter->GetOutput();
+    }
+    if (filter == "opening")
+    {
+      m_FastDilFilter = FastDilateFilterType::New();
+      m_FastDilFilter->SetKernel(se);
+      m_FastDilFilter->SetInput(current);
+      current = m_FastDilFilter->GetOutput();
+    }
+    SetParameterOutputImage("out", current);
+  }
+
   ExtractorFilterType::Pointer m_ExtractorFilter;
 
   DilateFilterType::Pointer  m_DilFilter;
   ErodeFilterType::Pointer   m_EroFilter;
   OpeningFilterType::Pointer m_OpeFilter;
   ClosingFilterType::Pointer m_CloFilter;
+
+  FastErodeFilterType::Pointer  m_FastEroFilter;
+  FastDilateFilterType::Pointer m_FastDilFilter;
 };
 }
 }
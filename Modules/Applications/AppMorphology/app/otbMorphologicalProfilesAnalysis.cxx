@@ -38,6 +38,11 @@
 #include "otbConvexOrConcaveClassificationFilter.h"
 #include "otbMorphologicalProfilesSegmentationFilter.h"
 #include "otbGeodesicMorphologyIterativeDecompositionImageFilter.h"
+#include "otbLineDecomposedStructuringElement.h"
+#include "otbVanHerkGilWermanOpeningByReconstructionImageFilter.h"
+#include "otbVanHerkGilWermanClosingByReconstructionImageFilter.h"
+#include "otbComponentTreeOpeningByReconstructionImageFilter.h"
+#include "otbComponentTreeClosingByReconstructionImageFilter.h"
 
 namespace otb
 {
@@ -62,6 +67,10 @@ public:
 
   typedef itk::BinaryBallStructuringElement<InputPixelType, 2>  BallStructuringElementType;
   typedef itk::BinaryCrossStructuringElement<InputPixelType, 2> CrossStructuringElementType;
+  typedef otb::LineDecomposedStructuringElement<2>              OctagonStructuringElementType;
+
+  typedef otb::VanHerkGilWermanOpeningByReconstructionImageFilter<FloatImageType, FloatImageType> FastOpeningFilterType;
+  typedef otb::VanHerkGilWermanClosingByReconstructionImageFilter<FloatImageType, FloatImageType> FastClosingFilterType;
 
   /** Standard macro */
   itkNewMacro(Self);
@@ -125,11 +134,15 @@ private:
     SetDefaultParameterInt("channel", 1);
     SetMinimumParameterIntValue("channel", 1);
 
-    // Structuring Element (Ball | Cross)
+    // Structuring Element (Ball | Cross | Octagon)
     AddParameter(ParameterType_Choice, "structype", "Structuring Element Type");
     SetParameterDescription("structype", "Choice of the structuring element type");
     AddChoice("structype.ball", "Ball");
     AddChoice("structype.cross", "Cross");
+    AddChoice("structype.octagon", "Octagon");
+    SetParameterDescription("structype.octagon",
+                            "Octagonal approximation of a ball, decomposed in lines. The cost of the erosions and dilations does not depend "
+                            "on the radius, and each scale of the profile is derived from the previous one.");
 
     AddParameter(ParameterType_Int, "size", "Profile Size");
     SetParameterDescription("size", "Size of the profiles");
@@ -212,20 +225,32 @@ private:
 
     if (GetParameterString("structype") == "ball")
     {
-      performProfileAnalysis<BallStructuringElementType>(profile, profileSize, initValue, step, sigma);
+      performProfileAnalysis<BallStructuringElementType,
+                             otb::ComponentTreeOpeningByReconstructionImageFilter<FloatImageType, FloatImageType, BallStructuringElementType>,
+                             otb::ComponentTreeClosingByReconstructionImageFilter<FloatImageType, FloatImageType, BallStructuringElementType>>(
+          profile, profileSize, initValue, step, sigma);
+    }
+    else if (GetParameterString("structype") == "octagon")
+    {
+      performProfileAnalysis<OctagonStructuringElementType, FastOpeningFilterType, FastClosingFilterType>(profile, profileSize, initValue, step, sigma);
     }
     else // Cross
     {
-      performProfileAnalysis<CrossStructuringElementType>(profile, profileSize, initValue, step, sigma);
+      performProfileAnalysis<CrossStructuringElementType,
+                             otb::ComponentTreeOpeningByReconstructionImageFilter<FloatImageType, FloatImageType, CrossStructuringElementType>,
+                             otb::ComponentTreeClosingByReconstructionImageFilter<FloatImageType, FloatImageType, CrossStructuringElementType>>(
+          profile, profileSize, initValue, step, sigma);
     }
   }
 
-  template <typename StructuringElementType>
+  template <typename StructuringElementType,
+            typename OpeningFilterType = itk::OpeningByReconstructionImageFilter<FloatImageType, FloatImageType, StructuringElementType>,
+            typename ClosingFilterType = itk::ClosingByReconstructionImageFilter<FloatImageType, FloatImageType, StructuringElementType>>
   void performProfileAnalysis(std::string profile, unsigned int profileSize, unsigned short initValue, unsigned short step, float sigma)
   {
 
-    typedef otb::MorphologicalOpeningProfileFilter<FloatImageType, FloatImageType, StructuringElementType> OpeningProfileFilterType;
-    typedef otb::MorphologicalClosingProfileFilter<FloatImageType, FloatImageType, StructuringElementType> ClosingProfileFilterType;
+    typedef otb::MorphologicalOpeningProfileFilter<FloatImageType, FloatImageType, StructuringElementType, OpeningFilterType> OpeningProfileFilterType;
+    typedef otb::MorphologicalClosingProfileFilter<FloatImageType, FloatImageType, StructuringElementType, ClosingFilterType> ClosingProfileFilterType;
     typedef otb::ProfileToProfileDerivativeFilter<FloatImageType, FloatImageType> DerivativeFilterType;
 
     typedef otb::MultiScaleConvexOrConcaveClassificationFilter<FloatImageType, LabeledImageType> MultiScaleClassificationFilterType;
@@ -28,11 +28,13 @@
 #include "otbRadianceToImageImageFilter.h"
 #include "otbReflectanceToRadianceImageFilter.h"
 #include "otbReflectanceToSurfaceReflectanceImageFilter.h"
+#include "otbImageToSurfaceReflectanceLookUpTableImageFilter.h"
 #include "itkMultiplyImageFilter.h"
 #include "otbClampImageFilter.h"
 #include "otbSurfaceAdjacencyEffectCorrectionSchemeFilter.h"
 #include "otbGroundSpacingImageFunction.h"
 #include "vnl/vnl_random.h"
+#include "itksys/SystemTools.hxx"
 
 
 #include <fstream>
@@ -102,6 +104,8 @@ public:
 
   typedef otb::SurfaceAdjacencyEffectCorrectionSchemeFilter<DoubleVectorImageType, DoubleVectorImageType> SurfaceAdjacencyEffectCorrectionSchemeFilterType;
 
+  typedef otb::ImageToSurfaceReflectanceLookUpTableImageFilter<FloatVectorImageType, DoubleVectorImageType> LookUpTableFilterType;
+
   typedef otb::GroundSpacingImageFunction<FloatVectorImageType> GroundSpacingImageType;
 
   typedef DoubleVectorImageType::IndexType  IndexType;
@@ -211,6 +215,12 @@ private:
     SetParameterDescription("clamp", "Clamping in the range [0, 1]. It can be useful to preserve area with specular reflectance.");
     SetParameterInt("clamp", 1);
 
+    AddParameter(ParameterType_Bool, "lut", "Use lookup tables for integer inputs");
+    SetParameterDescription("lut",
+                            "Compute the conversion of every integer value in [0, 65535] once per band, and apply it with a table lookup "
+                            "(TOA and TOC levels). The TOA and TOC steps are then done in a single filter, unless adjacency effects are corrected. "
+                            "Other values are converted as usual, and the results are the same as without this option.");
+
     // Acquisition parameters
     AddParameter(ParameterType_Group, "acqui", "Acquisition parameters");
     SetParameterDescription("acqui", "This group allows setting the parameters related to the acquisition conditions.");
@@ -331,6 +341,34 @@ private:
     SetParameterDescription("atmo.aeronet", "Aeronet file containing atmospheric parameters");
     MandatoryOff("atmo.aeronet");
 
+    // Cache of the 6S radiative terms
+    AddParameter(ParameterType_String, "atmo.cache", "Radiative terms cache file");
+    SetParameterDescription("atmo.cache",
+                            "Text file storing the radiative terms computed by 6S. "
+                            "Its entries are reused when the parameters match, and new ones are added to it.");
+    MandatoryOff("atmo.cache");
+
+    AddParameter(ParameterType_Float, "atmo.anglestep", "Angle step for the radiative terms (in degrees)");
+    SetParameterDescription("atmo.anglestep",
+                            "The solar and viewing angles are rounded to this step before running 6S, "
+                            "so that acquisitions with close geometries share their radiative terms. 0 keeps the exact angles.");
+    SetMinimumParameterFloatValue("atmo.anglestep", 0.0);
+    SetDefaultParameterFloat("atmo.anglestep", 0.);
+    MandatoryOff("atmo.anglestep");
+
+    AddParameter(ParameterType_Float, "atmo.optstep", "Aerosol optical thickness step for the radiative terms");
+    SetParameterDescription("atmo.optstep",
+                            "The aerosol optical thickness is rounded to this step before running 6S, or defines the "
+                            "interpolation grid when atmo.optinterp is on. 0 keeps the exact thickness.");
+    SetMinimumParameterFloatValue("atmo.optstep", 0.0);
+    SetDefaultParameterFloat("atmo.optstep", 0.);
+    MandatoryOff("atmo.optstep");
+
+    AddParameter(ParameterType_Bool, "atmo.optinterp", "Interpolate the radiative terms in aerosol optical thickness");
+    SetParameterDescription("atmo.optinterp",
+                            "Linearly interpolate the radiative terms between the cached aerosol optical thicknesses "
+                            "surrounding the requested one, or between the atmo.optstep grid nodes.");
+
     AddParameter(ParameterType_InputFilename, "atmo.rsr", "Relative Spectral Response File");
     std::ostringstream oss;
     oss << "Sensor relative spectral response file" << std::endl;
@@ -803,7 +841,16 @@ private:
 
       m_RadianceToReflectanceFilter->SetUseClamp(GetParameterInt("clamp"));
       m_RadianceToReflectanceFilter->UpdateOutputInformation();
-      m_ScaleFilter->SetInput(m_RadianceToReflectanceFilter->GetOutput());
+
+      if (GetParameterInt("lut"))
+      {
+        otbAppLogINFO("Use lookup tables\n");
+        SetupLookUpTableFilter(inImage);
+        m_LookUpTableFilter->UpdateOutputInformation();
+        m_ScaleFilter->SetInput(m_LookUpTableFilter->GetOutput());
+      }
+      else
+        m_ScaleFilter->SetInput(m_RadianceToReflectanceFilter->GetOutput());
     }
     break;
     case Level_TOA_IM:
@@ -905,12 +952,31 @@ private:
                                        GetParameterInt("acqui.hour"), GetParameterInt("acqui.minute"), 0.4);
       }
 
+      // 6S radiative terms cache
+      m_RadiativeTermsCache = SIXSRadiativeTermsCache::New();
+      m_RadiativeTermsCache->SetAngleStep(GetParameterFloat("atmo.anglestep"));
+      m_RadiativeTermsCache->SetAerosolOpticalStep(GetParameterFloat("atmo.optstep"));
+      m_RadiativeTermsCache->SetInterpolateAerosolOptical(GetParameterInt("atmo.optinterp"));
+      const bool useCacheFile = HasValue("atmo.cache");
+      if (useCacheFile && itksys::SystemTools::FileExists(GetParameterString("atmo.cache")))
+      {
+        m_RadiativeTermsCache->Load(GetParameterString("atmo.cache"));
+        otbAppLogINFO("Loaded " << m_RadiativeTermsCache->GetNumberOfEntries() << " radiative terms from " << GetParameterString("atmo.cache"));
+      }
+      m_ReflectanceToSurfaceReflectanceFilter->SetRadiativeTermsCache(m_RadiativeTermsCache);
+
       m_ReflectanceToSurfaceReflectanceFilter->UpdateOutputInformation();
       m_ReflectanceToSurfaceReflectanceFilter->SetIsSetAtmosphericRadiativeTerms(false);
       m_ReflectanceToSurfaceReflectanceFilter->SetUseGenerateParameters(true);
       m_ReflectanceToSurfaceReflectanceFilter->GenerateParameters();
       m_ReflectanceToSurfaceReflectanceFilter->SetUseGenerateParameters(false);
 
+      otbAppLogINFO("Number of 6S runs: " << m_RadiativeTermsCache->GetNumberOfSIXSRuns());
+      if (useCacheFile)
+      {
+        m_RadiativeTermsCache->Save(GetParameterString("atmo.cache"));
+      }
+
       // std::ostringstream oss_atmo;
       // oss_atmo << "Atmospheric parameters: " << std::endl;
       // oss_atmo << m_AtmosphericParam;
@@ -942,22 +1008,29 @@ private:
         m_SurfaceAdjacencyEffectCorrectionSchemeFilter->UpdateOutputInformation();
       }
 
+      DoubleVectorImageType* surfaceReflectance = m_ReflectanceToSurfaceReflectanceFilter->GetOutput();
+      if (adjComputation)
+        surfaceReflectance = m_SurfaceAdjacencyEffectCorrectionSchemeFilter->GetOutput();
+      else if (GetParameterInt("lut"))
+      {
+        otbAppLogINFO("Use lookup tables\n");
+        // TOA and TOC steps are done by the same filter
+        SetupLookUpTableFilter(inImage);
+        m_LookUpTableFilter->SetSurfaceReflectanceFunctorVector(m_ReflectanceToSurfaceReflectanceFilter->GetFunctorVector());
+        m_LookUpTableFilter->UpdateOutputInformation();
+        surfaceReflectance = m_LookUpTableFilter->GetOutput();
+      }
+
       // Rescale the surface reflectance in milli-reflectance
       if (!GetParameterInt("clamp"))
       {
-        if (!adjComputation)
-          m_ScaleFilter->SetInput(m_ReflectanceToSurfaceReflectanceFilter->GetOutput());
-        else
-          m_ScaleFilter->SetInput(m_SurfaceAdjacencyEffectCorrectionSchemeFilter->GetOutput());
+        m_ScaleFilter->SetInput(surfaceReflectance);
       }
       else
       {
         otbAppLogINFO("Clamp values between [0, 100]\n");
 
-        if (!adjComputation)
-          m_ClampFilter->SetInput(m_ReflectanceToSurfaceReflectanceFilter->GetOutput());
-        else
-          m_ClampFilter->SetInput(m_SurfaceAdjacencyEffectCorrectionSchemeFilter->GetOutput());
+        m_ClampFilter->SetInput(surfaceReflectance);
 
         m_ClampFilter->ClampOutside(0.0, 1.0);
         m_ScaleFilter->SetInput(m_ClampFilter->GetOutput());
@@ -982,6 +1055,28 @@ private:
     SetParameterOutputImage("out", m_ScaleFilter->GetOutput());
   }
 
+  /** Set up the lookup table filter with the TOA parameters of the filter chain */
+  void SetupLookUpTableFilter(FloatVectorImageType* inImage)
+  {
+    m_LookUpTableFilter = LookUpTableFilterType::New();
+    m_LookUpTableFilter->SetInput(inImage);
+    m_LookUpTableFilter->SetAlpha(m_ImageToRadianceFilter->GetAlpha());
+    m_LookUpTableFilter->SetBeta(m_ImageToRadianceFilter->GetBeta());
+    m_LookUpTableFilter->SetSolarIllumination(m_RadianceToReflectanceFilter->GetSolarIllumination());
+    m_LookUpTableFilter->SetZenithalSolarAngle(m_RadianceToReflectanceFilter->GetZenithalSolarAngle());
+    m_LookUpTableFilter->SetUseClamp(m_RadianceToReflectanceFilter->GetUseClamp());
+
+    if (m_RadianceToReflectanceFilter->GetIsSetFluxNormalizationCoefficient())
+      m_LookUpTableFilter->SetFluxNormalizationCoefficient(m_RadianceToReflectanceFilter->GetFluxNormalizationCoefficient());
+    else if (m_RadianceToReflectanceFilter->GetIsSetSolarDistance())
+      m_LookUpTableFilter->SetSolarDistance(m_RadianceToReflectanceFilter->GetSolarDistance());
+    else
+    {
+      m_LookUpTableFilter->SetDay(m_RadianceToReflectanceFilter->GetDay());
+      m_LookUpTableFilter->SetMonth(m_RadianceToReflectanceFilter->GetMonth());
+    }
+  }
+
   // Keep object references as a members of the class, else the pipeline will be broken after exiting DoExecute().
   ImageToRadianceImageFilterType::Pointer                 m_ImageToRadianceFilter;
   RadianceToReflectanceImageFilterType::Pointer           m_RadianceToReflectanceFilter;
@@ -992,6 +1087,8 @@ private:
   AtmoCorrectionParametersPointerType                     m_paramAtmo;
   AcquiCorrectionParametersPointerType                    m_paramAcqui;
   ClampFilterType::Pointer                                m_ClampFilter;
+  LookUpTableFilterType::Pointer                          m_LookUpTableFilter;
+  SIXSRadiativeTermsCache::Pointer                        m_RadiativeTermsCache;
 
   SurfaceAdjacencyEffectCorrectionSchemeFilterType::Pointer m_SurfaceAdjacencyEffectCorrectionSchemeFilter;
 };
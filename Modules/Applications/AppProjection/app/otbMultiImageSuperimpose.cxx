@@ -0,0 +1,316 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperApplicationFactory.h"
+
+#include "otbGenericRSResampleImageFilter.h"
+#include "otbGenericRSTransform.h"
+#include "otbComposeTransformDisplacementFieldFilter.h"
+#include "itkTransformToDisplacementFieldSource.h"
+#include "otbMultiImageFileWriter.h"
+
+#include "otbBCOInterpolateImageFunction.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+
+// Elevation handler
+#include "otbWrapperElevationParametersHandler.h"
+
+namespace otb
+{
+
+enum
+{
+  Interpolator_BCO,
+  Interpolator_NNeighbor,
+  Interpolator_Linear
+};
+
+namespace Wrapper
+{
+
+class MultiImageSuperimpose : public Application
+{
+public:
+  /** Standard class typedefs. */
+  typedef MultiImageSuperimpose         Self;
+  typedef Application                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Standard macro */
+  itkNewMacro(Self);
+
+  itkTypeMacro(MultiImageSuperimpose, Application);
+
+  typedef itk::LinearInterpolateImageFunction<FloatVectorImageType, double>          LinInterpolatorType;
+  typedef itk::NearestNeighborInterpolateImageFunction<FloatVectorImageType, double> NNInterpolatorType;
+  typedef otb::BCOInterpolateImageFunction<FloatVectorImageType> BCOInterpolatorType;
+
+  typedef otb::GenericRSResampleImageFilter<FloatVectorImageType, FloatVectorImageType> ResamplerType;
+  typedef ResamplerType::DisplacementFieldType                                          DisplacementFieldType;
+
+  typedef otb::GenericRSTransform<double, 2, 2>                                      RSTransformType;
+  typedef itk::TransformToDisplacementFieldSource<DisplacementFieldType, double>      GroundGridSourceType;
+  typedef otb::ComposeTransformDisplacementFieldFilter<DisplacementFieldType, double> ComposeFilterType;
+
+private:
+  void DoInit() override
+  {
+    SetName("MultiImageSuperimpose");
+    SetDescription("Using available image metadata, project several images onto the geometry of a reference one");
+
+    // Documentation
+    SetDocLongDescription(
+        "This application performs the projection of a list of images into the geometry of a reference image, "
+        "as the Superimpose application does for a single image. The ground coordinates of the reference "
+        "deformation grid are computed once per tile and shared by all the images to reproject, and all the "
+        "outputs are written in a single streaming pass.");
+    SetDocLimitations(
+        "Only the default superimposition mode is available. Outputs are written as float images: "
+        "use extended filenames to tune the writing.");
+    SetDocAuthors("OTB-Team");
+    SetDocSeeAlso("Superimpose");
+
+    AddDocTag(Tags::Geometry);
+    AddDocTag("Superimposition");
+
+    AddParameter(ParameterType_InputImage, "inr", "Reference input");
+    SetParameterDescription("inr", "The input reference image.");
+    AddParameter(ParameterType_InputImageList, "il", "The images to reproject");
+    SetParameterDescription("il", "The images to reproject into the geometry of the reference input.");
+
+    AddParameter(ParameterType_StringList, "out", "Output images");
+    SetParameterDescription("out", "Output reprojected images, one filename per image to reproject.");
+
+    // Elevation
+    ElevationParametersHandler::AddElevationParameters(this, "elev");
+
+    AddParameter(ParameterType_Float, "lms", "Spacing of the deformation field");
+    SetParameterDescription("lms", "Generate a coarser deformation field with the given spacing");
+    SetDefaultParameterFloat("lms", 4.);
+    DisableParameter("lms");
+    MandatoryOff("lms");
+
+    AddParameter(ParameterType_Float, "fv", "Fill Value");
+    SetParameterDescription("fv", "Fill value for area outside the reprojected images");
+    SetDefaultParameterFloat("fv", 0.);
+    MandatoryOff("fv");
+
+    // Interpolators
+    AddParameter(ParameterType_Choice, "interpolator", "Interpolation");
+    SetParameterDescription("interpolator", "This group of parameters allows defining how the input images will be interpolated during resampling.");
+
+    AddChoice("interpolator.bco", "Bicubic interpolation");
+    SetParameterDescription("interpolator.bco", "Bicubic interpolation leads to very good image quality but is slow.");
+
+    AddParameter(ParameterType_Radius, "interpolator.bco.radius", "Radius for bicubic interpolation");
+    SetParameterDescription("interpolator.bco.radius",
+                            "This parameter allows controlling the size of the bicubic interpolation filter. If the target pixel size is higher than the input "
+                            "pixel size, increasing this parameter will reduce aliasing artifacts.");
+    SetDefaultParameterInt("interpolator.bco.radius", 2);
+
+    AddChoice("interpolator.nn", "Nearest Neighbor interpolation");
+    SetParameterDescription("interpolator.nn", "Nearest neighbor interpolation leads to poor image quality, but it is very fast.");
+
+    AddChoice("interpolator.linear", "Linear interpolation");
+    SetParameterDescription("interpolator.linear", "Linear interpolation leads to average image quality but is quite fast");
+
+    AddRAMParameter();
+
+    // Doc example parameter settings
+    SetDocExampleParameterValue("inr", "QB_Toulouse_Ortho_PAN.tif");
+    SetDocExampleParameterValue("il", "QB_Toulouse_Ortho_XS_1.tif QB_Toulouse_Ortho_XS_2.tif");
+    SetDocExampleParameterValue("out", "SuperimposedXS_1_to_PAN.tif SuperimposedXS_2_to_PAN.tif");
+
+    SetOfficialDocLink();
+  }
+
+  void DoUpdateParameters() override
+  {
+  }
+
+  void DoExecute() override
+  {
+    // Get the inputs
+    FloatVectorImageType*     refImage    = GetParameterImage("inr");
+    FloatVectorImageListType* movingList  = GetParameterImageList("il");
+    std::vector<std::string>  outputFiles = GetParameterStringList("out");
+
+    if (outputFiles.size() != movingList->Size())
+    {
+      otbAppLogFATAL("The number of output images (" << outputFiles.size() << ") does not match the number of images to reproject (" << movingList->Size()
+                                                     << ")");
+    }
+    if (outputFiles.empty())
+    {
+      otbAppLogFATAL("No image to reproject");
+    }
+
+    // Setup the DEM Handler
+    otb::Wrapper::ElevationParametersHandler::SetupDEMHandlerFromElevationParameters(this, "elev");
+
+    // Set up output image information
+    FloatVectorImageType::SpacingType spacing = refImage->GetSignedSpacing();
+    FloatVectorImageType::IndexType   start   = refImage->GetLargestPossibleRegion().GetIndex();
+    FloatVectorImageType::SizeType    size    = refImage->GetLargestPossibleRegion().GetSize();
+    FloatVectorImageType::PointType   origin  = refImage->GetOrigin();
+
+    FloatVectorImageType::SpacingType defSpacing;
+    if (IsParameterEnabled("lms"))
+    {
+      float defScalarSpacing = std::abs(GetParameterFloat("lms"));
+      otbAppLogDEBUG("Generating coarse deformation field (spacing=" << defScalarSpacing << ")");
+
+      defSpacing[0] = defScalarSpacing;
+      defSpacing[1] = defScalarSpacing;
+
+      if (spacing[0] < 0.0)
+        defSpacing[0] *= -1.0;
+      if (spacing[1] < 0.0)
+        defSpacing[1] *= -1.0;
+    }
+    else
+    {
+      defSpacing[0] = 10 * spacing[0];
+      defSpacing[1] = 10 * spacing[1];
+    }
+
+    m_Resamplers.clear();
+    m_Composers.clear();
+
+    for (unsigned int i = 0; i < movingList->Size(); ++i)
+    {
+      FloatVectorImageType* movingImage = movingList->GetNthElement(i);
+
+      ResamplerType::Pointer resampler = ResamplerType::New();
+
+      // Get Interpolator
+      switch (GetParameterInt("interpolator"))
+      {
+      case Interpolator_Linear:
+      {
+        LinInterpolatorType::Pointer interpolator = LinInterpolatorType::New();
+        resampler->SetInterpolator(interpolator);
+      }
+      break;
+      case Interpolator_NNeighbor:
+      {
+        NNInterpolatorType::Pointer interpolator = NNInterpolatorType::New();
+        resampler->SetInterpolator(interpolator);
+      }
+      break;
+      case Interpolator_BCO:
+      {
+        BCOInterpolatorType::Pointer interpolator = BCOInterpolatorType::New();
+        interpolator->SetRadius(GetParameterInt("interpolator.bco.radius"));
+        resampler->SetInterpolator(interpolator);
+      }
+      break;
+      }
+
+      FloatVectorImageType::PixelType defaultValue;
+      itk::NumericTraits<FloatVectorImageType::PixelType>::SetLength(defaultValue, movingImage->GetNumberOfComponentsPerPixel());
+      defaultValue.Fill(GetParameterFloat("fv"));
+
+      resampler->SetDisplacementFieldSpacing(defSpacing);
+
+      // Setup transform through projRef and ImageMetadata
+      resampler->SetInputImageMetadata(&(movingImage->GetImageMetadata()));
+      resampler->SetInputProjectionRef(movingImage->GetProjectionRef());
+
+      resampler->SetOutputImageMetadata(&(refImage->GetImageMetadata()));
+      resampler->SetOutputProjectionRef(refImage->GetProjectionRef());
+
+      resampler->SetInput(movingImage);
+
+      resampler->SetOutputOrigin(origin);
+      resampler->SetOutputSpacing(spacing);
+      resampler->SetOutputSize(size);
+      resampler->SetOutputStartIndex(start);
+
+      resampler->SetEdgePaddingValue(defaultValue);
+
+      m_Resamplers.push_back(resampler);
+    }
+
+    // The deformation grid only depends on the reference geometry and
+    // on the grid spacing: it is shared by all the resamplers. Its
+    // geometry is taken from the grid the first resampler would compute.
+    m_Resamplers.front()->UpdateOutputInformation();
+    const DisplacementFieldType* grid = m_Resamplers.front()->GetDisplacementField();
+
+    // Reference image to ground transform, evaluated once per grid node
+    m_GroundTransform = RSTransformType::New();
+    m_GroundTransform->SetInputImageMetadata(&(refImage->GetImageMetadata()));
+    m_GroundTransform->SetInputProjectionRef(refImage->GetProjectionRef());
+    m_GroundTransform->InstantiateTransform();
+
+    m_GroundGrid = GroundGridSourceType::New();
+    m_GroundGrid->SetTransform(m_GroundTransform);
+    m_GroundGrid->SetOutputOrigin(grid->GetOrigin());
+    m_GroundGrid->SetOutputSpacing(grid->GetSpacing());
+    m_GroundGrid->SetOutputDirection(grid->GetDirection());
+    m_GroundGrid->SetOutputRegion(grid->GetLargestPossibleRegion());
+    // Same threading as the displacement field generator of GenericRSResampleImageFilter
+    m_GroundGrid->SetNumberOfThreads(1);
+
+    m_Writer = otb::MultiImageFileWriter::New();
+    m_Writer->SetAutomaticAdaptativeStreaming(GetParameterInt("ram"));
+
+    for (unsigned int i = 0; i < m_Resamplers.size(); ++i)
+    {
+      FloatVectorImageType* movingImage = movingList->GetNthElement(i);
+
+      // Ground to moving image transform, composed with the shared grid
+      RSTransformType::Pointer imageTransform = RSTransformType::New();
+      imageTransform->SetOutputImageMetadata(&(movingImage->GetImageMetadata()));
+      imageTransform->SetOutputProjectionRef(movingImage->GetProjectionRef());
+      imageTransform->InstantiateTransform();
+
+      ComposeFilterType::Pointer composer = ComposeFilterType::New();
+      composer->SetInput(m_GroundGrid->GetOutput());
+      composer->SetTransform(imageTransform);
+      composer->SetNumberOfThreads(1);
+      m_Composers.push_back(composer);
+
+      m_Resamplers[i]->SetDisplacementField(composer->GetOutput());
+
+      m_Writer->AddInputImage(m_Resamplers[i]->GetOutput(), outputFiles[i]);
+    }
+
+    std::ostringstream progressId;
+    progressId << "Writing " << m_Resamplers.size() << " output images ...";
+    AddProcess(m_Writer, progressId.str());
+    m_Writer->Update();
+  }
+
+  std::vector<ResamplerType::Pointer>     m_Resamplers;
+  std::vector<ComposeFilterType::Pointer> m_Composers;
+
+  RSTransformType::Pointer      m_GroundTransform;
+  GroundGridSourceType::Pointer m_GroundGrid;
+
+  otb::MultiImageFileWriter::Pointer m_Writer;
+};
+
+} // end namespace Wrapper
+} // end namespace otb
+
+OTB_APPLICATION_EXPORT(otb::Wrapper::MultiImageSuperimpose)
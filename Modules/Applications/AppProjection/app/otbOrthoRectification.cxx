@@ -36,6 +36,15 @@
 
 #include "otbGeographicalDistance.h"
 
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+#include "itksys/SystemTools.hxx"
+
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
 namespace otb
 {
 
@@ -83,6 +92,11 @@ public:
   typedef itk::NearestNeighborInterpolateImageFunction<FloatVectorImageType, double> NearestNeighborInterpolationType;
   typedef otb::BCOInterpolateImageFunction<FloatVectorImageType> BCOInterpolationType;
 
+  /** Resampling grid cache typedefs */
+  typedef ResampleFilterType::DisplacementFieldType   DisplacementFieldType;
+  typedef otb::ImageFileReader<DisplacementFieldType> DisplacementFieldReaderType;
+  typedef otb::ImageFileWriter<DisplacementFieldType> DisplacementFieldWriterType;
+
 private:
   void DoInit() override
   {
@@ -242,6 +256,15 @@ private:
                             "but increasing this parameter will reduce processing time.");
     MandatoryOff("opt.gridspacing");
 
+    // Resampling grid cache
+    AddParameter(ParameterType_Directory, "opt.gridcache", "Resampling grid cache directory");
+    SetParameterDescription("opt.gridcache",
+                            "If set, the deformation grid is saved in this directory the first time it is computed, and read back by later runs "
+                            "sharing the same sensor model, elevation settings, output grid and grid spacing, instead of evaluating the sensor model "
+                            "again. Cached grids are deformation grids in the output geometry, and can also be used as grid.in of the "
+                            "GridBasedImageResampling application with grid.type def.");
+    MandatoryOff("opt.gridcache");
+
     // Doc example parameter settings
     SetDocExampleParameterValue("io.in", "QB_TOULOUSE_MUL_Extract_500_500.tif");
     SetDocExampleParameterValue("io.out", "QB_Toulouse_ortho.tif");
@@ -684,12 +707,111 @@ private:
       m_ResampleFilter->SetDisplacementFieldSpacing(gridSpacing);
     }
 
+    // Re-use or fill the resampling grid cache
+    if (IsParameterEnabled("opt.gridcache") && HasValue("opt.gridcache"))
+    {
+      this->UseResamplingGridCache(inImage);
+    }
+
     // Output Image
     SetParameterOutputImage("io.out", m_ResampleFilter->GetOutput());
   }
 
-  ResampleFilterType::Pointer m_ResampleFilter;
-  std::string                 m_OutputProjectionRef;
+  /** Describe everything the deformation grid depends on */
+  std::string GetResamplingGridKey(const FloatVectorImageType* inImage)
+  {
+    std::ostringstream oss;
+    oss << std::setprecision(17);
+
+    // Sensor model
+    const ImageMetadata& imd = inImage->GetImageMetadata();
+    oss << "input.projection: " << inImage->GetProjectionRef() << "\n";
+    oss << "input.size: " << inImage->GetLargestPossibleRegion().GetSize() << "\n";
+    oss << "input.metadata: " << imd.ToJSON() << "\n";
+    if (imd.Has(MDGeom::RPC))
+    {
+      oss << "input.rpc: " << boost::any_cast<Projection::RPCParam>(imd[MDGeom::RPC]).ToJSON() << "\n";
+    }
+    if (IsParameterEnabled("opt.rpc"))
+    {
+      oss << "opt.rpc: " << GetParameterInt("opt.rpc") << "\n";
+    }
+
+    // Elevation settings
+    for (const std::string& key : {"elev.dem", "elev.geoid", "elev.default"})
+    {
+      if (HasValue(key))
+      {
+        oss << key << ": " << GetParameterAsString(key) << "\n";
+      }
+    }
+
+    // Output grid
+    oss << "output.projection: " << m_OutputProjectionRef << "\n";
+    oss << "output.origin: " << m_ResampleFilter->GetOutputOrigin() << "\n";
+    oss << "output.spacing: " << m_ResampleFilter->GetOutputSpacing() << "\n";
+    oss << "output.size: " << m_ResampleFilter->GetOutputSize() << "\n";
+    oss << "grid.spacing: " << m_ResampleFilter->GetDisplacementFieldSpacing() << "\n";
+
+    return oss.str();
+  }
+
+  /** Read the deformation grid from the cache directory, computing and
+   * saving it first if needed */
+  void UseResamplingGridCache(const FloatVectorImageType* inImage)
+  {
+    const std::string key = GetResamplingGridKey(inImage);
+
+    std::ostringstream name;
+    name << "orthogrid_" << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>()(key);
+    const std::string gridFile = GetParameterString("opt.gridcache") + "/" + name.str() + ".tif";
+    // The key file is written last, so that it also marks complete grids
+    const std::string keyFile = GetParameterString("opt.gridcache") + "/" + name.str() + ".key";
+
+    bool               hit = false;
+    std::ifstream      keyStream(keyFile);
+    std::ostringstream cachedKey;
+    if (keyStream && itksys::SystemTools::FileExists(gridFile))
+    {
+      cachedKey << keyStream.rdbuf();
+      hit = cachedKey.str() == key;
+    }
+    keyStream.close();
+
+    if (hit)
+    {
+      otbAppLogINFO("Re-using resampling grid " << gridFile);
+    }
+    else
+    {
+      otbAppLogINFO("Computing resampling grid " << gridFile);
+      itksys::SystemTools::MakeDirectory(GetParameterString("opt.gridcache"));
+
+      m_ResampleFilter->UpdateOutputInformation();
+
+      DisplacementFieldWriterType::Pointer writer = DisplacementFieldWriterType::New();
+      writer->SetInput(m_ResampleFilter->GetDisplacementField());
+      writer->SetFileName(gridFile);
+      writer->SetAutomaticAdaptativeStreaming(GetParameterInt("opt.ram"));
+      AddProcess(writer, "Computing resampling grid");
+      writer->Update();
+
+      std::ofstream out(keyFile);
+      out << key;
+      if (!out)
+      {
+        otbAppLogWARNING("Unable to write resampling grid key " << keyFile);
+      }
+    }
+
+    m_GridReader = DisplacementFieldReaderType::New();
+    m_GridReader->SetFileName(gridFile);
+    m_ResampleFilter->SetDisplacementField(m_GridReader->GetOutput());
+  }
+
+  ResampleFilterType::Pointer          m_ResampleFilter;
+  DisplacementFieldReaderType::Pointer m_GridReader;
+  std::string                          m_OutputProjectionRef;
 };
 
 } // namespace Wrapper
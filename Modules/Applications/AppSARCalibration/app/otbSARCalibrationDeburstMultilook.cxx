@@ -0,0 +1,154 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperApplication.h"
+#include "otbWrapperApplicationFactory.h"
+
+#include "otbSarCalibrationDeburstMultilookImageFilter.h"
+
+namespace otb
+{
+namespace Wrapper
+{
+class SARCalibrationDeburstMultilook : public Application
+{
+public:
+  /** Standard class typedefs. */
+  typedef SARCalibrationDeburstMultilook Self;
+  typedef Application                    Superclass;
+  typedef itk::SmartPointer<Self>        Pointer;
+  typedef itk::SmartPointer<const Self>  ConstPointer;
+
+  /** Standard macro */
+  itkNewMacro(Self);
+
+  itkTypeMacro(SARCalibrationDeburstMultilook, otb::Application);
+
+  typedef otb::SarCalibrationDeburstMultilookImageFilter<ComplexFloatImageType, FloatImageType> FilterType;
+
+private:
+  void DoInit() override
+  {
+    SetName("SARCalibrationDeburstMultilook");
+    SetDescription("Calibrates, debursts and multilooks a SAR image in a single pass.");
+
+    // Documentation
+    SetDocLongDescription(
+        "This application chains the radiometric calibration of the SARCalibration"
+        " application, the deburst of the SARDeburst application and a multilook"
+        " averaging of the calibrated intensity. Each input line is read and"
+        " calibrated once, and no intermediate image is produced.\n\n"
+
+        "The deburst step is optional, so that detected products can also be"
+        " calibrated and multilooked. The output spacing and origin are updated"
+        " according to the number of looks, so that the output image can be"
+        " further used by the OrthoRectification application.");
+
+    SetDocLimitations(
+        "Deburst is only supported for Sentinel1 IW SLC products. Only complete"
+        " looks are computed: the last lines and samples of the image are dropped"
+        " when its size is not a multiple of the number of looks.");
+
+    SetDocAuthors("OTB-Team");
+    SetDocSeeAlso("SARCalibration, SARDeburst");
+
+    AddDocTag(Tags::Calibration);
+    AddDocTag(Tags::SAR);
+
+    AddParameter(ParameterType_InputImage, "in", "Input Image");
+    SetParameterDescription("in", "Input complex image");
+
+    AddParameter(ParameterType_OutputImage, "out", "Output Image");
+    SetParameterDescription("out", "Output multilooked image. This image contains the mean backscatter of each look.");
+
+    AddParameter(ParameterType_Bool, "removenoise", "Remove Noise");
+    SetParameterDescription("removenoise", "Remove the noise of the input product (see SARCalibration application).");
+
+    AddParameter(ParameterType_Choice, "lut", "Lookup table");
+    SetParameterDescription(
+        "lut", "Lookup table values are not available with all SAR products. Products that provide lookup table with metadata are: Sentinel1, Radarsat2.");
+    AddChoice("lut.sigma", "Use sigma nought lookup");
+    SetParameterDescription("lut.sigma", "Use Sigma nought lookup value from product metadata");
+    AddChoice("lut.beta", "Use beta nought lookup");
+    SetParameterDescription("lut.beta", "Use Beta nought lookup value from product metadata");
+    AddChoice("lut.gamma", "Use gamma nought lookup");
+    SetParameterDescription("lut.gamma", "Use Gamma nought lookup value from product metadata");
+    AddChoice("lut.dn", "Use DN value lookup");
+    SetParameterDescription("lut.dn", "Use DN value lookup value from product metadata");
+    SetDefaultParameterInt("lut", 0);
+
+    AddParameter(ParameterType_Bool, "deburst", "Deburst");
+    SetParameterDescription("deburst", "Remove the redundant lines between bursts (Sentinel1 IW SLC products).");
+
+    AddParameter(ParameterType_Bool, "onlyvalidsamples", "Only valid samples");
+    SetParameterDescription("onlyvalidsamples", "If true, only the valid samples of the bursts are kept. Requires deburst.");
+
+    AddParameter(ParameterType_Int, "azimuthlooks", "Azimuth looks");
+    SetParameterDescription("azimuthlooks", "Number of lines averaged in azimuth");
+    SetDefaultParameterInt("azimuthlooks", 1);
+    SetMinimumParameterIntValue("azimuthlooks", 1);
+
+    AddParameter(ParameterType_Int, "rangelooks", "Range looks");
+    SetParameterDescription("rangelooks", "Number of samples averaged in range");
+    SetDefaultParameterInt("rangelooks", 1);
+    SetMinimumParameterIntValue("rangelooks", 1);
+
+    AddRAMParameter();
+
+    // Doc example parameter settings
+    SetDocExampleParameterValue("in", "s1_iw_slc.tif");
+    SetDocExampleParameterValue("out", "s1_iw_slc_sigma_ml.tif");
+    SetDocExampleParameterValue("deburst", "1");
+    SetDocExampleParameterValue("azimuthlooks", "2");
+    SetDocExampleParameterValue("rangelooks", "8");
+
+    SetOfficialDocLink();
+  }
+
+  void DoUpdateParameters() override
+  {
+  }
+
+  void DoExecute() override
+  {
+    // Get the input complex image
+    ComplexFloatImageType* floatComplexImage = GetParameterComplexFloatImage("in");
+
+    // Set the filter input
+    m_Filter = FilterType::New();
+    m_Filter->SetInput(floatComplexImage);
+
+    m_Filter->SetEnableNoise(GetParameterInt("removenoise"));
+    m_Filter->SetLookupSelected(GetParameterInt("lut"));
+    m_Filter->SetDeburst(GetParameterInt("deburst"));
+    m_Filter->SetOnlyValidSample(GetParameterInt("onlyvalidsamples"));
+    m_Filter->SetAzimuthLooks(GetParameterInt("azimuthlooks"));
+    m_Filter->SetRangeLooks(GetParameterInt("rangelooks"));
+
+    // Set the output image
+    SetParameterOutputImage("out", m_Filter->GetOutput());
+  }
+
+  FilterType::Pointer m_Filter;
+};
+}
+}
+
+OTB_APPLICATION_EXPORT(otb::Wrapper::SARCalibrationDeburstMultilook)
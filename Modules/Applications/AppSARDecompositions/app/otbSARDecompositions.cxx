@@ -32,6 +32,7 @@
 #include "otbImageList.h"
 
 #include "otbSinclairToReciprocalCoherencyMatrixImageFilter.h"
+#include "otbSinclairToReciprocalHAlphaImageFilter.h"
 
 namespace otb
 {
@@ -62,7 +63,9 @@ public:
   typedef ImageListToVectorImageFilter<ImageListType, ComplexDoubleVectorImageType> ListConcatenerFilterType;
 
 
-  typedef otb::ReciprocalHAlphaImageFilter<ComplexDoubleVectorImageType, ComplexDoubleVectorImageType>       HAFilterType;
+  typedef otb::Functor::SinclairToReciprocalHAlphaFunctor<ComplexDoubleImageType, ComplexDoubleVectorImageType::PixelType> HAFunctorType;
+  using HAFilterType = otb::SinclairToReciprocalHAlphaImageFilter<ComplexDoubleImageType, ComplexDoubleVectorImageType>;
+
   typedef otb::ReciprocalBarnesDecompImageFilter<ComplexDoubleVectorImageType, ComplexDoubleVectorImageType> BarnesFilterType;
   typedef otb::ReciprocalHuynenDecompImageFilter<ComplexDoubleVectorImageType, ComplexDoubleVectorImageType> HuynenFilterType;
   typedef otb::ReciprocalPauliDecompImageFilter<ComplexDoubleVectorImageType, ComplexDoubleVectorImageType>  PauliFilterType;
@@ -164,7 +167,6 @@ private:
       otbAppLogFATAL(<< "Parameter inhv or invh not set. Please provide a HV or a VH complex image.");
 
     m_SRFilter   = SRFilterType::New();
-    m_HAFilter   = HAFilterType::New();
     m_MeanFilter = PerBandMeanFilterType::New();
     MeanFilterType::InputSizeType radius;
     m_BarnesFilter = BarnesFilterType::New();
@@ -177,19 +179,19 @@ private:
     {
     case 0: // H-alpha-A
 
+      // Coherency matrices are averaged on the fly, without the intermediate 6-band image
+      radius.Fill(GetParameterInt("inco.kernelsize"));
+      m_HAFilter =
+          otb::NewFunctorFilter<HAFunctorType, std::tuple<polarimetry_tags::hh, polarimetry_tags::hv_or_vh, polarimetry_tags::vv>>(HAFunctorType{}, radius);
+
       if (inhv)
-        m_SRFilter->SetInput<polarimetry_tags::hv_or_vh>(GetParameterComplexDoubleImage("inhv"));
+        m_HAFilter->SetInput<polarimetry_tags::hv_or_vh>(GetParameterComplexDoubleImage("inhv"));
       else if (invh)
-        m_SRFilter->SetInput<polarimetry_tags::hv_or_vh>(GetParameterComplexDoubleImage("invh"));
+        m_HAFilter->SetInput<polarimetry_tags::hv_or_vh>(GetParameterComplexDoubleImage("invh"));
 
-      m_SRFilter->SetInput<polarimetry_tags::hh>(GetParameterComplexDoubleImage("inhh"));
-      m_SRFilter->SetInput<polarimetry_tags::vv>(GetParameterComplexDoubleImage("invv"));
+      m_HAFilter->SetInput<polarimetry_tags::hh>(GetParameterComplexDoubleImage("inhh"));
+      m_HAFilter->SetInput<polarimetry_tags::vv>(GetParameterComplexDoubleImage("invv"));
 
-      radius.Fill(GetParameterInt("inco.kernelsize"));
-      m_MeanFilter->GetFilter()->SetRadius(radius);
-
-      m_MeanFilter->SetInput(m_SRFilter->GetOutput());
-      m_HAFilter->SetInput<0>(m_MeanFilter->GetOutput());
       SetParameterOutputImage("out", m_HAFilter->GetOutput());
 
       break;
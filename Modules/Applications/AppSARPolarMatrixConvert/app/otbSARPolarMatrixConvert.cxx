@@ -29,6 +29,7 @@
 #include "otbSinclairToReciprocalCoherencyMatrixImageFilter.h"
 #include "otbSinclairToReciprocalCovarianceMatrixImageFilter.h"
 #include "otbSinclairToReciprocalCircularCovarianceMatrixImageFilter.h"
+#include "otbSinclairToReciprocalBoxcarMatrixImageFilter.h"
 
 #include "otbMuellerToReciprocalCovarianceImageFilter.h"
 #include "otbMuellerToPolarisationDegreeAndPowerImageFilter.h"
@@ -57,6 +58,11 @@ public:
   using RCovSRFilterType = SinclairToReciprocalCovarianceMatrixImageFilter<ComplexDoubleImageType, ComplexDoubleVectorImageType>;
   using RCCSRFilterType  = SinclairToReciprocalCircularCovarianceMatrixImageFilter<ComplexDoubleImageType, ComplexDoubleVectorImageType>;
 
+  // Monostatic case, averaged over a boxcar window
+  using RCohBoxcarFilterType = SinclairToReciprocalBoxcarMatrixImageFilter<ComplexDoubleImageType, ComplexDoubleVectorImageType, RCohSRFilterType::FunctorType>;
+  using RCovBoxcarFilterType = SinclairToReciprocalBoxcarMatrixImageFilter<ComplexDoubleImageType, ComplexDoubleVectorImageType, RCovSRFilterType::FunctorType>;
+  using RCCBoxcarFilterType  = SinclairToReciprocalBoxcarMatrixImageFilter<ComplexDoubleImageType, ComplexDoubleVectorImageType, RCCSRFilterType::FunctorType>;
+
   using RCRMFilterType = otb::ReciprocalCoherencyToReciprocalMuellerImageFilter<ComplexDoubleVectorImageType, DoubleVectorImageType>;
   using RCCDFilterType = otb::ReciprocalCovarianceToCoherencyDegreeImageFilter<ComplexDoubleVectorImageType, ComplexDoubleVectorImageType>;
   using RCRCFilterType = otb::ReciprocalCovarianceToReciprocalCoherencyImageFilter<ComplexDoubleVectorImageType, ComplexDoubleVectorImageType>;
@@ -119,7 +125,10 @@ private:
 
         "11 sinclairtomueller --> Sinclair matrix to Mueller matrix (input: 4 x 1 complex channel (HH, HV, VH, VV) | output: 16 real channels)\n"
         "12 muellertomcovariance --> Mueller matrix to covariance matrix (input: 16 real channels | output: 6 complex channels)\n"
-        "13 muellertopoldegandpower --> Mueller matrix to polarization degree and power (input: 16 real channels | output: 4 real channels)"
+        "13 muellertopoldegandpower --> Mueller matrix to polarization degree and power (input: 16 real channels | output: 4 real channels)\n"
+        "\n"
+        "For the monostatic conversions from the Sinclair matrix (1 to 3), the 'radius' parameter averages the matrices over a boxcar window "
+        "in the same pass, so that the unaveraged matrix image does not need to be written and filtered afterwards."
 
         );
     SetDocLimitations("None");
@@ -236,6 +245,14 @@ private:
     AddChoice("conv.muellertopoldegandpower", "13 Bi/mono: Mueller matrix to polarisation degree and power");
     SetParameterDescription("conv.muellertopoldegandpower", "13 Bi/mono: Mueller matrix to polarisation degree and power");
 
+    AddParameter(ParameterType_Int, "radius", "Averaging radius");
+    SetParameterDescription("radius",
+                            "Radius of the boxcar window used to average the monostatic matrices computed from the Sinclair matrix "
+                            "(conversions 1 to 3). 0 means no averaging.");
+    SetDefaultParameterInt("radius", 0);
+    SetMinimumParameterIntValue("radius", 0);
+    MandatoryOff("radius");
+
     AddRAMParameter();
 
     // Default values
@@ -256,6 +273,8 @@ private:
 
     int convType = GetParameterInt("conv");
 
+    GetParameterByKey("radius")->SetActive(false);
+
     if ((convType >= 0) && (convType <= 2)) // msinclairtocoherency msinclairtocovariance msinclairtocircovariance
     {
       GetParameterByKey("inc")->SetActive(false);
@@ -266,6 +285,7 @@ private:
       GetParameterByKey("invv")->SetActive(true);
       GetParameterByKey("outc")->SetActive(true);
       GetParameterByKey("outf")->SetActive(false);
+      GetParameterByKey("radius")->SetActive(true);
     }
     else if ((convType >= 3) &&
              (convType <= 6)) // mcoherencytomueller mcovariancetocoherencydegree mcovariancetocoherency mlinearcovariancetocircularcovariance
@@ -350,6 +370,10 @@ private:
 
     int convType = GetParameterInt("conv");
 
+    ComplexDoubleImageType::SizeType radius;
+    radius.Fill(GetParameterInt("radius"));
+    const bool boxcar = GetParameterInt("radius") > 0;
+
 
     if ((!outc) && (!outf))
       otbAppLogFATAL(<< "No output image provided; please, set the parameter 'outc' or 'outf'.");
@@ -391,6 +415,24 @@ private:
     //***************************************
 
     case 0: // SinclairToReciprocalCoherency
+
+      if (boxcar)
+      {
+        m_RCohBoxcarFilter = RCohBoxcarFilterType::New();
+        m_RCohBoxcarFilter->SetRadius(radius);
+
+        if (inhv)
+          m_RCohBoxcarFilter->SetInput(polarimetry_tags::hv_or_vh{}, GetParameterComplexDoubleImage("inhv"));
+        else if (invh)
+          m_RCohBoxcarFilter->SetInput(polarimetry_tags::hv_or_vh{}, GetParameterComplexDoubleImage("invh"));
+
+        m_RCohBoxcarFilter->SetInput(polarimetry_tags::hh{}, GetParameterComplexDoubleImage("inhh"));
+        m_RCohBoxcarFilter->SetInput(polarimetry_tags::vv{}, GetParameterComplexDoubleImage("invv"));
+
+        SetParameterOutputImage("outc", m_RCohBoxcarFilter->GetOutput()); // input: 3 x 1 complex channel | output :  6 complex channels
+        break;
+      }
+
       m_RCohSRFilter = RCohSRFilterType::New();
 
       if (inhv)
@@ -408,6 +450,23 @@ private:
 
     case 1: // SinclairToReciprocalCovariance
 
+      if (boxcar)
+      {
+        m_RCovBoxcarFilter = RCovBoxcarFilterType::New();
+        m_RCovBoxcarFilter->SetRadius(radius);
+
+        if (inhv)
+          m_RCovBoxcarFilter->SetInput(polarimetry_tags::hv_or_vh{}, GetParameterComplexDoubleImage("inhv"));
+        else if (invh)
+          m_RCovBoxcarFilter->SetInput(polarimetry_tags::hv_or_vh{}, GetParameterComplexDoubleImage("invh"));
+
+        m_RCovBoxcarFilter->SetInput(polarimetry_tags::hh{}, GetParameterComplexDoubleImage("inhh"));
+        m_RCovBoxcarFilter->SetInput(polarimetry_tags::vv{}, GetParameterComplexDoubleImage("invv"));
+
+        SetParameterOutputImage("outc", m_RCovBoxcarFilter->GetOutput()); // input: 3 x 1 complex channel | output :  6 complex channels
+        break;
+      }
+
       m_RCovSRFilter = RCovSRFilterType::New();
 
       if (inhv)
@@ -425,6 +484,23 @@ private:
 
     case 2: // SinclairToReciprocalCircularCovariance
 
+      if (boxcar)
+      {
+        m_RCCBoxcarFilter = RCCBoxcarFilterType::New();
+        m_RCCBoxcarFilter->SetRadius(radius);
+
+        if (inhv)
+          m_RCCBoxcarFilter->SetInput(polarimetry_tags::hv_or_vh{}, GetParameterComplexDoubleImage("inhv"));
+        else if (invh)
+          m_RCCBoxcarFilter->SetInput(polarimetry_tags::hv_or_vh{}, GetParameterComplexDoubleImage("invh"));
+
+        m_RCCBoxcarFilter->SetInput(polarimetry_tags::hh{}, GetParameterComplexDoubleImage("inhh"));
+        m_RCCBoxcarFilter->SetInput(polarimetry_tags::vv{}, GetParameterComplexDoubleImage("invv"));
+
+        SetParameterOutputImage("outc", m_RCCBoxcarFilter->GetOutput()); // input: 3 x 1 complex channel | output :  6 complex channels
+        break;
+      }
+
       m_RCCSRFilter = RCCSRFilterType::New();
 
       if (inhv)
@@ -564,13 +640,16 @@ private:
   }
 
   // Monostatic
-  RCohSRFilterType::Pointer m_RCohSRFilter;
-  RCovSRFilterType::Pointer m_RCovSRFilter;
-  RCCSRFilterType::Pointer  m_RCCSRFilter;
-  RCRMFilterType::Pointer   m_RCRMFilter;
-  RCCDFilterType::Pointer   m_RCCDFilter;
-  RCRCFilterType::Pointer   m_RCRCFilter;
-  RLCRCCFilterType::Pointer m_RLCRCCFilter;
+  RCohSRFilterType::Pointer     m_RCohSRFilter;
+  RCovSRFilterType::Pointer     m_RCovSRFilter;
+  RCCSRFilterType::Pointer      m_RCCSRFilter;
+  RCohBoxcarFilterType::Pointer m_RCohBoxcarFilter;
+  RCovBoxcarFilterType::Pointer m_RCovBoxcarFilter;
+  RCCBoxcarFilterType::Pointer  m_RCCBoxcarFilter;
+  RCRMFilterType::Pointer       m_RCRMFilter;
+  RCCDFilterType::Pointer       m_RCCDFilter;
+  RCRCFilterType::Pointer       m_RCRCFilter;
+  RLCRCCFilterType::Pointer     m_RLCRCCFilter;
 
   // Bistatic
   CohSRFilterType::Pointer m_CohSRFilter;
@@ -25,7 +25,9 @@
 #include "otbLeeImageFilter.h"
 #include "otbGammaMAPImageFilter.h"
 #include "otbKuanImageFilter.h"
-#include "otbMultiToMonoChannelExtractROI.h"
+#include "otbQueganImageFilter.h"
+#include "otbComplexToIntensityMultilookImageFilter.h"
+#include "otbPerBandVectorImageFilter.h"
 
 namespace otb
 {
@@ -41,13 +43,22 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef itk::ImageToImageFilter<FloatImageType, FloatImageType> SpeckleFilterType;
+  typedef itk::ImageToImageFilter<FloatVectorImageType, FloatVectorImageType> SpeckleFilterType;
 
   typedef LeeImageFilter<FloatImageType, FloatImageType>      LeeFilterType;
   typedef FrostImageFilter<FloatImageType, FloatImageType>    FrostFilterType;
   typedef GammaMAPImageFilter<FloatImageType, FloatImageType> GammaMAPFilterType;
   typedef KuanImageFilter<FloatImageType, FloatImageType>     KuanFilterType;
 
+  typedef PerBandVectorImageFilter<FloatVectorImageType, FloatVectorImageType, LeeFilterType>      PerBandLeeFilterType;
+  typedef PerBandVectorImageFilter<FloatVectorImageType, FloatVectorImageType, FrostFilterType>    PerBandFrostFilterType;
+  typedef PerBandVectorImageFilter<FloatVectorImageType, FloatVectorImageType, GammaMAPFilterType> PerBandGammaMAPFilterType;
+  typedef PerBandVectorImageFilter<FloatVectorImageType, FloatVectorImageType, KuanFilterType>     PerBandKuanFilterType;
+
+  typedef QueganImageFilter<FloatVectorImageType, FloatVectorImageType> QueganFilterType;
+
+  typedef ComplexToIntensityMultilookImageFilter<ComplexFloatVectorImageType, FloatVectorImageType> IntensityFilterType;
+
   /** Standard macro */
   itkNewMacro(Self);
 
@@ -67,16 +78,21 @@ private:
         " and it increases the mean Grey level of a local area. \n\n"
         "Reducing the speckle noise enhances radiometric resolution but tend to decrease the spatial resolution."
         "Several different methods are used to eliminate speckle noise, based upon"
-        " different mathematical models of the phenomenon. The application includes four"
-        " methods: Lee [1], Frost [2], GammaMAP [3] and Kuan [4]. \n\n"
-        "We sum up below the basic principle of this four methods:\n\n"
+        " different mathematical models of the phenomenon. The application includes five"
+        " methods: Lee [1], Frost [2], GammaMAP [3], Kuan [4] and the multitemporal filter of Quegan [5]. \n\n"
+        "We sum up below the basic principle of these methods:\n\n"
         "* Lee: Estimate the signal by mean square error minimization (MMSE) on a sliding window.\n"
         "* Frost: Also derived from the MMSE criteria with a weighted sum of the values within the window. The weighting factors decrease with distance from "
         "the pixel of interest.\n"
         "* GammaMAP: Derived under the assumption of the image follows a Gamma distribution.\n"
-        "* Kuan: Also derived from the MMSE criteria under the assumption of non stationary mean and variance. It is quite similar to Lee filter in form.");
+        "* Kuan: Also derived from the MMSE criteria under the assumption of non stationary mean and variance. It is quite similar to Lee filter in form.\n"
+        "* Quegan: Multitemporal filter for a time series of co-registered images, given as the bands of the input image. Each date is the local "
+        "mean of that date weighted by the temporal average of the ratios of each date to its own local mean.\n\n"
+        "Except with Quegan, all the bands of the input image are filtered independently, in a single pass over the image.\n\n"
+        "A complex (SLC) input can be given with the complex option: the speckle filter is then applied to the intensity of each band, "
+        "optionally multilooked, which is computed on the fly from the complex values.");
 
-    SetDocLimitations("The application does not handle complex image as input.");
+    SetDocLimitations("The multilook is only available for complex inputs.");
 
     SetDocAuthors("OTB-Team");
 
@@ -97,13 +113,30 @@ private:
         "[4] Kuan, D.  T., Sawchuk, A.  A., Strand, T.  C, and Chavel,"
         "P., 1987.  Adaptive restoration of image with speckle.  IEEE"
         "Trans on Acoustic Speech and Signal Processing, 35,"
-        "pp. 373-383.");
+        "pp. 373-383.\n"
+        "[5] S. Quegan and J. J. Yu, Filtering of multichannel SAR images,"
+        " IEEE Transactions on Geoscience and Remote Sensing, vol. 39,"
+        " no. 11, pp. 2373-2379, Nov. 2001.");
 
     AddDocTag(Tags::Filter);
     AddDocTag(Tags::SAR);
 
     AddParameter(ParameterType_InputImage, "in", "Input Image");
     SetParameterDescription("in", "Input image.");
+
+    AddParameter(ParameterType_Bool, "complex", "Complex input");
+    SetParameterDescription("complex", "If true, the input image is complex and its intensity is filtered.");
+
+    AddParameter(ParameterType_Int, "azimuthlooks", "Azimuth looks");
+    SetParameterDescription("azimuthlooks", "Number of lines averaged in azimuth in the intensity of a complex input");
+    SetDefaultParameterInt("azimuthlooks", 1);
+    SetMinimumParameterIntValue("azimuthlooks", 1);
+
+    AddParameter(ParameterType_Int, "rangelooks", "Range looks");
+    SetParameterDescription("rangelooks", "Number of samples averaged in range in the intensity of a complex input");
+    SetDefaultParameterInt("rangelooks", 1);
+    SetMinimumParameterIntValue("rangelooks", 1);
+
     AddParameter(ParameterType_OutputImage, "out", "Output Image");
     SetParameterDescription("out", "Output image.");
 
@@ -121,6 +154,9 @@ private:
     AddChoice("filter.kuan", "Kuan");
     SetParameterDescription("filter.kuan", "Kuan filter");
 
+    AddChoice("filter.quegan", "Quegan");
+    SetParameterDescription("filter.quegan", "Quegan multitemporal filter, each band of the input image being one date");
+
     AddParameter(ParameterType_Int, "filter.lee.rad", "Radius");
     SetParameterDescription("filter.lee.rad", "Radius in pixel");
 
@@ -150,6 +186,9 @@ private:
     AddParameter(ParameterType_Float, "filter.kuan.nblooks", "Number of looks");
     SetParameterDescription("filter.kuan.nblooks", "Number of looks in the input image.");
 
+    AddParameter(ParameterType_Int, "filter.quegan.rad", "Radius");
+    SetParameterDescription("filter.quegan.rad", "Radius in pixel of the neighborhood used to compute the local means.");
+
     // Default values
     SetDefaultParameterInt("filter.lee.rad", 1);
     SetDefaultParameterFloat("filter.lee.nblooks", 1.);
@@ -157,6 +196,7 @@ private:
     SetDefaultParameterFloat("filter.frost.deramp", 0.1);
     SetDefaultParameterInt("filter.gammamap.rad", 1);
     SetDefaultParameterFloat("filter.gammamap.nblooks", 1.);
+    SetDefaultParameterInt("filter.quegan.rad", 1);
 
     AddRAMParameter();
 
@@ -176,25 +216,30 @@ private:
 
   void DoExecute() override
   {
-    FloatVectorImageType* inVImage = GetParameterImage("in");
-
-    // Transform to otb::Image
-    typedef otb::Image<FloatVectorImageType::InternalPixelType> InternalFloatImageType;
-    typedef otb::MultiToMonoChannelExtractROI<float, float> ExtractFilterType;
+    FloatVectorImageType* inImage = nullptr;
 
-    ExtractFilterType::Pointer channelSelect = ExtractFilterType::New();
-    m_Ref.push_back(channelSelect.GetPointer());
-    channelSelect->SetChannel(1);
-    channelSelect->SetInput(inVImage);
-    channelSelect->UpdateOutputInformation();
-    InternalFloatImageType::Pointer inImage = channelSelect->GetOutput();
-    inImage->UpdateOutputInformation();
+    if (GetParameterInt("complex"))
+    {
+      // Intensity and multilook of the complex input, in a single pass
+      m_IntensityFilter = IntensityFilterType::New();
+      m_IntensityFilter->SetInput(GetParameterComplexFloatVectorImage("in"));
+      m_IntensityFilter->SetAzimuthLooks(GetParameterInt("azimuthlooks"));
+      m_IntensityFilter->SetRangeLooks(GetParameterInt("rangelooks"));
+
+      otbAppLogINFO(<< "Intensity of the complex input with " << GetParameterInt("azimuthlooks") << " x " << GetParameterInt("rangelooks") << " looks");
+      inImage = m_IntensityFilter->GetOutput();
+    }
+    else
+    {
+      inImage = GetParameterImage("in");
+    }
 
+    // Except for Quegan, each band goes through its own speckle filter
     switch (GetParameterInt("filter"))
     {
     case 0:
     {
-      LeeFilterType::Pointer filter = LeeFilterType::New();
+      PerBandLeeFilterType::Pointer filter = PerBandLeeFilterType::New();
       m_Ref.push_back(filter.GetPointer());
 
       filter->SetInput(inImage);
@@ -202,8 +247,8 @@ private:
       LeeFilterType::SizeType lradius;
       lradius.Fill(GetParameterInt("filter.lee.rad"));
 
-      filter->SetRadius(lradius);
-      filter->SetNbLooks(GetParameterFloat("filter.lee.nblooks"));
+      filter->GetFilter()->SetRadius(lradius);
+      filter->GetFilter()->SetNbLooks(GetParameterFloat("filter.lee.nblooks"));
 
       otbAppLogINFO(<< "Lee filter");
       m_SpeckleFilter = filter;
@@ -211,7 +256,7 @@ private:
     }
     case 1:
     {
-      FrostFilterType::Pointer filter = FrostFilterType::New();
+      PerBandFrostFilterType::Pointer filter = PerBandFrostFilterType::New();
       m_Ref.push_back(filter.GetPointer());
 
       filter->SetInput(inImage);
@@ -219,8 +264,8 @@ private:
       FrostFilterType::SizeType lradius;
       lradius.Fill(GetParameterInt("filter.frost.rad"));
 
-      filter->SetRadius(lradius);
-      filter->SetDeramp(GetParameterFloat("filter.frost.deramp"));
+      filter->GetFilter()->SetRadius(lradius);
+      filter->GetFilter()->SetDeramp(GetParameterFloat("filter.frost.deramp"));
 
       otbAppLogINFO(<< "Frost filter");
       m_SpeckleFilter = filter;
@@ -228,7 +273,7 @@ private:
     }
     case 2:
     {
-      GammaMAPFilterType::Pointer filter = GammaMAPFilterType::New();
+      PerBandGammaMAPFilterType::Pointer filter = PerBandGammaMAPFilterType::New();
       m_Ref.push_back(filter.GetPointer());
 
       filter->SetInput(inImage);
@@ -236,8 +281,8 @@ private:
       GammaMAPFilterType::SizeType lradius;
       lradius.Fill(GetParameterInt("filter.gammamap.rad"));
 
-      filter->SetRadius(lradius);
-      filter->SetNbLooks(GetParameterFloat("filter.gammamap.nblooks"));
+      filter->GetFilter()->SetRadius(lradius);
+      filter->GetFilter()->SetNbLooks(GetParameterFloat("filter.gammamap.nblooks"));
 
       otbAppLogINFO(<< "GammaMAP filter");
       m_SpeckleFilter = filter;
@@ -245,7 +290,7 @@ private:
     }
     case 3:
     {
-      KuanFilterType::Pointer filter = KuanFilterType::New();
+      PerBandKuanFilterType::Pointer filter = PerBandKuanFilterType::New();
       m_Ref.push_back(filter.GetPointer());
 
       filter->SetInput(inImage);
@@ -253,13 +298,29 @@ private:
       KuanFilterType::SizeType lradius;
       lradius.Fill(GetParameterInt("filter.kuan.rad"));
 
-      filter->SetRadius(lradius);
-      filter->SetNbLooks(GetParameterFloat("filter.kuan.nblooks"));
+      filter->GetFilter()->SetRadius(lradius);
+      filter->GetFilter()->SetNbLooks(GetParameterFloat("filter.kuan.nblooks"));
 
       otbAppLogINFO(<< "Kuan filter");
       m_SpeckleFilter = filter;
       break;
     }
+    case 4:
+    {
+      QueganFilterType::Pointer filter = QueganFilterType::New();
+      m_Ref.push_back(filter.GetPointer());
+
+      filter->SetInput(inImage);
+
+      QueganFilterType::SizeType lradius;
+      lradius.Fill(GetParameterInt("filter.quegan.rad"));
+
+      filter->SetRadius(lradius);
+
+      otbAppLogINFO(<< "Quegan filter");
+      m_SpeckleFilter = filter;
+      break;
+    }
     default:
     {
       otbAppLogFATAL(<< "non defined speckle reduction filter " << GetParameterInt("filter") << std::endl);
@@ -272,6 +333,7 @@ private:
   }
   std::vector<itk::ProcessObject::Pointer> m_Ref;
   SpeckleFilterType::Pointer               m_SpeckleFilter;
+  IntensityFilterType::Pointer             m_IntensityFilter;
 };
 
 } // end namespace Wrapper
@@ -25,6 +25,7 @@ otb_module(OTBAppSARUtils
     OTBApplicationEngine
     OTBImageNoise
     OTBImageBase
+    OTBImageManipulation
     OTBITK
     
   TEST_DEPENDS
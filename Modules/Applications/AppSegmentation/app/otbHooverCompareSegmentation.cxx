@@ -21,7 +21,7 @@
 #include "otbWrapperApplication.h"
 #include "otbWrapperApplicationFactory.h"
 
-#include "otbHooverMatrixFilter.h"
+#include "otbStreamingHooverOverlapImageFilter.h"
 #include "otbHooverInstanceFilter.h"
 #include "otbLabelMapToAttributeImageFilter.h"
 
@@ -115,14 +115,13 @@ public:
 
   typedef otb::AttributesMapLabelObject<unsigned int, 2, float> LabelObjectType;
   typedef itk::LabelMap<LabelObjectType>        LabelMapType;
-  typedef otb::HooverMatrixFilter<LabelMapType> HooverMatrixFilterType;
   typedef UInt32ImageType                       ImageType;
+  typedef otb::StreamingHooverOverlapImageFilter<ImageType> HooverOverlapFilterType;
   typedef FloatVectorImageType::PixelType       FloatPixelType;
   typedef Int16VectorImageType::PixelType       Int16PixelType;
   // typedef otb::VectorImage<float, 2>                VectorImageType;
   typedef itk::LabelImageToLabelMapFilter<ImageType, LabelMapType> ImageToLabelMapFilterType;
-  typedef otb::ImageFileReader<ImageType>    ImageReaderType;
-  typedef HooverMatrixFilterType::MatrixType MatrixType;
+  typedef otb::ImageFileReader<ImageType> ImageReaderType;
 
   typedef otb::HooverInstanceFilter<LabelMapType> InstanceFilterType;
   typedef otb::LabelMapToAttributeImageFilter<LabelMapType, FloatVectorImageType>             AttributeImageFilterType;
@@ -143,6 +142,8 @@ private:
         "The application can output the overall Hoover scores along with colored"
         "images of the MS and GT segmentation showing the state of each region "
         "(correct detection, over-segmentation, under-segmentation, missed).\n\n"
+        "The overlaps between GT and MS regions are counted by streaming the "
+        "input images, and only the intersecting couples of regions are stored.\n\n"
 	"The legend for the colored images is as follow:\n\n"
 	"- **white**:   background\n\n"
 	"- **green**:   correct detection\n\n"
@@ -153,7 +154,7 @@ private:
         " comparison of range image segmentation algorithms\", IEEE PAMI vol. 18, no. 7, July 1996.");
     SetDocLimitations("None");
     SetDocAuthors("OTB-Team");
-    SetDocSeeAlso("otbHooverMatrixFilter, otbHooverInstanceFilter, otbLabelMapToAttributeImageFilter");
+    SetDocSeeAlso("otbStreamingHooverOverlapImageFilter, otbHooverInstanceFilter, otbLabelMapToAttributeImageFilter");
 
     AddDocTag(Tags::Segmentation);
 
@@ -227,17 +228,19 @@ private:
     m_MSFilter->SetInput(inputMS);
     m_MSFilter->SetBackgroundValue(GetParameterInt("bg"));
 
-    m_HooverFilter = HooverMatrixFilterType::New();
-    m_HooverFilter->SetGroundTruthLabelMap(m_GTFilter->GetOutput());
-    m_HooverFilter->SetMachineSegmentationLabelMap(m_MSFilter->GetOutput());
+    m_HooverFilter = HooverOverlapFilterType::New();
+    m_HooverFilter->SetGroundTruthImage(inputGT);
+    m_HooverFilter->SetMachineSegmentationImage(inputMS);
+    m_HooverFilter->SetBackgroundValue(GetParameterInt("bg"));
 
+    AddProcess(m_HooverFilter->GetStreamer(), "Counting region overlaps");
     m_HooverFilter->Update();
 
     m_InstanceFilter = InstanceFilterType::New();
     m_InstanceFilter->SetGroundTruthLabelMap(m_GTFilter->GetOutput());
     m_InstanceFilter->SetMachineSegmentationLabelMap(m_MSFilter->GetOutput());
     m_InstanceFilter->SetThreshold(GetParameterFloat("th"));
-    m_InstanceFilter->SetHooverMatrix(m_HooverFilter->GetHooverConfusionMatrix());
+    m_InstanceFilter->SetHooverSparseMatrix(m_HooverFilter->GetHooverSparseMatrix());
     m_InstanceFilter->SetUseExtendedAttributes(false);
 
     m_AttributeImageGT = AttributeImageFilterType::New();
@@ -313,8 +316,8 @@ private:
   ImageToLabelMapFilterType::Pointer m_GTFilter;
   ImageToLabelMapFilterType::Pointer m_MSFilter;
 
-  HooverMatrixFilterType::Pointer m_HooverFilter;
-  InstanceFilterType::Pointer     m_InstanceFilter;
+  HooverOverlapFilterType::Pointer m_HooverFilter;
+  InstanceFilterType::Pointer      m_InstanceFilter;
 
   AttributeImageFilterType::Pointer m_AttributeImageGT;
   AttributeImageFilterType::Pointer m_AttributeImageMS;
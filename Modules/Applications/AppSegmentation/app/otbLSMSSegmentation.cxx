@@ -43,6 +43,10 @@
 #include "otbStandardWriterWatcher.h"
 #include <itksys/SystemTools.hxx>
 
+#ifdef OTB_USE_MPI
+#include "otbMPIConfig.h"
+#endif
+
 
 namespace otb
 {
@@ -243,6 +247,8 @@ private:
         " set and tmpdir does not exists before running the application, it will"
         " be removed as well during cleanup). The tmpdir option allows defining"
         " a directory where to write the temporary files.\n\n"
+        "When run with MPI, the tiles are segmented by all the processes, the"
+        " temporary files must then be on a file system shared by them.\n\n"
         "Please also note that the output image type should be set to uint32 to"
         " ensure that there are enough labels available.\n\n"
         "The output of this application can be passed to the"
@@ -389,15 +395,38 @@ private:
 
     otbAppLogINFO(<< "Number of tiles: " << nbTilesX << " x " << nbTilesY);
 
-    unsigned long regionCount = 0;
+    unsigned int rank    = 0;
+    unsigned int nbProcs = 1;
+#ifdef OTB_USE_MPI
+    otb::MPIConfig::Pointer mpiConfig = otb::MPIConfig::Instance();
+    if (mpiConfig->GetNbProcs() > 1)
+    {
+      rank    = mpiConfig->GetMyRank();
+      nbProcs = mpiConfig->GetNbProcs();
+    }
+#endif
+
+    // With MPI, each process segments a contiguous range of tiles (in
+    // row-major order), the first one stitches and relabels them.
+    const unsigned long nbTiles   = static_cast<unsigned long>(nbTilesX) * nbTilesY;
+    const unsigned long firstTile = (nbTiles * rank) / nbProcs;
+    const unsigned long lastTile  = (nbTiles * (rank + 1)) / nbProcs;
 
-    // Segmentation by the connected component per tile and label
-    // shifting
-    otbAppLogINFO(<< "Tile shifting ...");
+    // Maximum label of each tile, for the label shifting
+    std::vector<LabelImagePixelType> tileMaximum(nbTiles, 0);
+
+    // Segmentation by the connected component per tile
+    otbAppLogINFO(<< "Tile segmentation ...");
 
     for (unsigned int row = 0; row < nbTilesY; ++row)
       for (unsigned int column = 0; column < nbTilesX; ++column)
       {
+        const unsigned long tileIndex = static_cast<unsigned long>(row) * nbTilesX + column;
+        if (tileIndex < firstTile || tileIndex >= lastTile)
+        {
+          continue;
+        }
+
         // Compute extraction parameters
         unsigned long startX = column * sizeTilesX;
         unsigned long startY = row * sizeTilesY;
@@ -460,22 +489,71 @@ private:
         ccFilter->GetFunctor().SetExpression(expr.str());
         ccFilter->Update();
 
-        // Shifting
-        LabelShiftFilterType::Pointer labelShiftFilter = LabelShiftFilterType::New();
-        labelShiftFilter->SetInput(ccFilter->GetOutput());
-        labelShiftFilter->GetFunctor().SetA(1);
-        labelShiftFilter->GetFunctor().SetB(regionCount);
-        labelShiftFilter->Update();
-
         // Maximum label calculation for the shifting
         StatisticsImageFilterType::Pointer stats = StatisticsImageFilterType::New();
         stats->SetInput(ccFilter->GetOutput());
         stats->Update();
-        regionCount += stats->GetMaximum();
+        tileMaximum[tileIndex] = stats->GetMaximum();
 
-        std::string filename = WriteTile(labelShiftFilter->GetOutput(), row, column, "SEG");
+        // Labels are shifted when tiles are read back
+        std::string filename = WriteTile(ccFilter->GetOutput(), row, column, "SEG");
+      }
+
+#ifdef OTB_USE_MPI
+    if (nbProcs > 1)
+    {
+      std::string localMaximum(reinterpret_cast<const char*>(tileMaximum.data() + firstTile), (lastTile - firstTile) * sizeof(LabelImagePixelType));
+      std::vector<std::string> allMaximum = mpiConfig->gather(localMaximum, 0);
+      for (unsigned int r = 0; r < allMaximum.size(); ++r)
+      {
+        std::copy(allMaximum[r].begin(), allMaximum[r].end(), reinterpret_cast<char*>(tileMaximum.data() + (nbTiles * r) / nbProcs));
       }
+    }
+#endif
+
+    std::string vrtfile;
+    if (rank == 0)
+    {
+      vrtfile = StitchTiles(nbTilesX, nbTilesY, sizeTilesX, sizeTilesY, sizeImageX, sizeImageY, minRegionSize, tileMaximum);
+    }
+
+#ifdef OTB_USE_MPI
+    // Wait for the final tiles: all the processes write a part of the output
+    if (nbProcs > 1)
+    {
+      mpiConfig->broadcast(vrtfile, 0);
+    }
+#endif
+
+    clock_t toc = clock();
+
+    otbAppLogINFO(<< "Elapsed time: " << (double)(toc - tic) / CLOCKS_PER_SEC << " seconds");
 
+    // Final writing
+    LabelImageReaderType::Pointer finalReader = LabelImageReaderType::New();
+    finalReader->SetFileName(vrtfile);
+
+    ImportGeoInformationImageFilterType::Pointer importGeoInformationFilter = ImportGeoInformationImageFilterType::New();
+    importGeoInformationFilter->SetInput(finalReader->GetOutput());
+    importGeoInformationFilter->SetSource(imageIn);
+
+    SetParameterOutputImage("out", importGeoInformationFilter->GetOutput());
+    RegisterPipeline();
+  }
+
+  /** Merges the labels of the segmented tiles across their borders, removes
+   * the small regions and returns the vrt file stitching the final tiles */
+  std::string StitchTiles(unsigned int nbTilesX, unsigned int nbTilesY, unsigned long sizeTilesX, unsigned long sizeTilesY, unsigned long sizeImageX,
+                          unsigned long sizeImageY, unsigned int minRegionSize, const std::vector<LabelImagePixelType>& tileMaximum)
+  {
+    // Label shift of each tile, so that labels are unique over the image
+    unsigned long                    regionCount = 0;
+    std::vector<LabelImagePixelType> tileShift(tileMaximum.size());
+    for (std::size_t tile = 0; tile < tileMaximum.size(); ++tile)
+    {
+      tileShift[tile] = regionCount;
+      regionCount += tileMaximum[tile];
+    }
 
     // Step 2: create the look-up table for all overlaps
     otbAppLogINFO(<< "LUT creation ...");
@@ -519,12 +597,12 @@ private:
           {
             pixelIndexUp[0] = pixelIndexIn[0];
 
-            LabelImagePixelType curCanLabel = tileInReader->GetOutput()->GetPixel(pixelIndexIn);
+            LabelImagePixelType curCanLabel = tileInReader->GetOutput()->GetPixel(pixelIndexIn) + tileShift[row * nbTilesX + column];
             while (LUT[curCanLabel] != curCanLabel)
             {
               curCanLabel = LUT[curCanLabel];
             }
-            LabelImagePixelType adjCanLabel = tileUpReader->GetOutput()->GetPixel(pixelIndexUp);
+            LabelImagePixelType adjCanLabel = tileUpReader->GetOutput()->GetPixel(pixelIndexUp) + tileShift[(row - 1) * nbTilesX + column];
 
             while (LUT[adjCanLabel] != adjCanLabel)
             {
@@ -560,12 +638,12 @@ private:
           {
             pixelIndexUp[1] = pixelIndexIn[1];
 
-            LabelImagePixelType curCanLabel = tileInReader->GetOutput()->GetPixel(pixelIndexIn);
+            LabelImagePixelType curCanLabel = tileInReader->GetOutput()->GetPixel(pixelIndexIn) + tileShift[row * nbTilesX + column];
             while (LUT[curCanLabel] != curCanLabel)
             {
               curCanLabel = LUT[curCanLabel];
             }
-            LabelImagePixelType adjCanLabel = tileLeftReader->GetOutput()->GetPixel(pixelIndexUp);
+            LabelImagePixelType adjCanLabel = tileLeftReader->GetOutput()->GetPixel(pixelIndexUp) + tileShift[row * nbTilesX + column - 1];
             while (LUT[adjCanLabel] != adjCanLabel)
             {
               adjCanLabel = LUT[adjCanLabel];
@@ -615,9 +693,15 @@ private:
         LabelImageReaderType::Pointer readerIn = LabelImageReaderType::New();
         readerIn->SetFileName(tileIn);
 
+        // Shifting
+        LabelShiftFilterType::Pointer labelShiftFilter = LabelShiftFilterType::New();
+        labelShiftFilter->SetInput(readerIn->GetOutput());
+        labelShiftFilter->GetFunctor().SetA(1);
+        labelShiftFilter->GetFunctor().SetB(tileShift[row * nbTilesX + column]);
+
         // Remove extra margin now that lut is built
         ExtractROIFilterType::Pointer labelImage = ExtractROIFilterType::New();
-        labelImage->SetInput(readerIn->GetOutput());
+        labelImage->SetInput(labelShiftFilter->GetOutput());
         labelImage->SetStartX(0);
         labelImage->SetStartY(0);
         labelImage->SetSizeX(sizeX);
@@ -722,20 +806,7 @@ private:
 
     m_FilesToRemoveAfterExecute.push_back(vrtfile);
 
-    clock_t toc = clock();
-
-    otbAppLogINFO(<< "Elapsed time: " << (double)(toc - tic) / CLOCKS_PER_SEC << " seconds");
-
-    // Final writing
-    LabelImageReaderType::Pointer finalReader = LabelImageReaderType::New();
-    finalReader->SetFileName(vrtfile);
-
-    ImportGeoInformationImageFilterType::Pointer importGeoInformationFilter = ImportGeoInformationImageFilterType::New();
-    importGeoInformationFilter->SetInput(finalReader->GetOutput());
-    importGeoInformationFilter->SetSource(imageIn);
-
-    SetParameterOutputImage("out", importGeoInformationFilter->GetOutput());
-    RegisterPipeline();
+    return vrtfile;
   }
 
   void AfterExecuteAndWriteOutputs() override
@@ -743,6 +814,15 @@ private:
     // Release input files
     // finalReader = nullptr;
 
+#ifdef OTB_USE_MPI
+    // The final tiles are read by all the processes writing the output
+    otb::MPIConfig::Pointer mpiConfig = otb::MPIConfig::Instance();
+    if (mpiConfig->GetNbProcs() > 1)
+    {
+      mpiConfig->barrier();
+    }
+#endif
+
     if (GetParameterInt("cleanup"))
     {
       otbAppLogINFO(<< "Final clean-up ...");
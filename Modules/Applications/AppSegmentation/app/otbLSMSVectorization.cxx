@@ -26,10 +26,17 @@
 
 #include "otbStreamingStatisticsImageFilter.h"
 #include "otbLabelImageToOGRDataSourceFilter.h"
+#include "otbLabelImageBoundaryTracer.h"
 #include "otbOGRFeatureWrapper.h"
 
+#ifdef OTB_USE_MPI
+#include "otbMPIConfig.h"
+#endif
+
 #include <time.h>
 #include <algorithm>
+#include <cstdint>
+#include <unordered_map>
 
 namespace otb
 {
@@ -59,6 +66,7 @@ public:
   typedef itk::ImageRegionConstIterator<ImageType>      ImageIterator;
 
   typedef otb::LabelImageToOGRDataSourceFilter<LabelImageType> LabelImageToOGRDataSourceFilterType;
+  typedef otb::LabelImageBoundaryTracer<LabelImageType>         BoundaryTracerType;
 
 
   itkNewMacro(Self);
@@ -115,6 +123,23 @@ private:
     SetDefaultParameterInt("tilesizey", 500);
     SetMinimumParameterIntValue("tilesizey", 1);
 
+    AddParameter(ParameterType_Choice, "mode", "Vectorization mode");
+    SetParameterDescription("mode", "How polygons spanning several tiles are built.");
+
+    AddChoice("mode.union", "Polygonize and merge");
+    SetParameterDescription("mode.union",
+                            "Each tile is polygonized separately, then the polygons of a segment found in several tiles are merged. This needs the whole "
+                            "layer to be sorted and merged at the end.");
+
+    AddChoice("mode.trace", "Boundary tracing");
+    SetParameterDescription("mode.trace",
+                            "Segment boundaries are traced across tiles, in a single pass over the images, and each polygon is written as soon as its "
+                            "segment is complete. Segments are expected to be connected, as the ones produced by the LSMS workflow. Geometries are the "
+                            "same as in union mode, up to the order of the features and of the ring vertices. With MPI, each process traces a band of tile rows "
+                            "and the first process stitches the segments crossing the bands and writes the output: this is the only mode available "
+                            "with several processes.");
+    SetParameterString("mode", "union");
+
     AddRAMParameter();
 
     // Doc example parameter settings
@@ -140,10 +165,408 @@ private:
     unsigned long sizeTilesX = GetParameterInt("tilesizex");
     unsigned long sizeTilesY = GetParameterInt("tilesizey");
 
+    unsigned int rank    = 0;
+    unsigned int nbProcs = 1;
+#ifdef OTB_USE_MPI
+    otb::MPIConfig::Pointer mpiConfig = otb::MPIConfig::Instance();
+    if (mpiConfig->GetNbProcs() > 1)
+    {
+      rank    = mpiConfig->GetMyRank();
+      nbProcs = mpiConfig->GetNbProcs();
+    }
+#endif
+
+    bool traceMode = (GetParameterString("mode") == "trace");
+    if (nbProcs > 1 && !traceMode)
+    {
+      otbAppLogWARNING(<< "The union mode can not be distributed over MPI processes, the trace mode is used instead.");
+      traceMode = true;
+    }
 
     LabelImageType::Pointer labelIn = GetParameterUInt32Image("inseg");
     labelIn->UpdateOutputInformation();
 
+    ImageType::Pointer imageIn = GetParameterImage("in");
+    imageIn->UpdateOutputInformation();
+
+    unsigned long numberOfComponentsPerPixel = imageIn->GetNumberOfComponentsPerPixel();
+    std::string   projRef                    = imageIn->GetProjectionRef();
+
+    otb::ogr::DataSource::Pointer ogrDS;
+    otb::ogr::Layer               layer(nullptr, false);
+
+    std::string layername = itksys::SystemTools::GetFilenameName(shapefile);
+    std::string extension = itksys::SystemTools::GetFilenameLastExtension(shapefile);
+    layername             = layername.substr(0, layername.size() - (extension.size()));
+
+    // With MPI, the first process gathers the polygons and writes them
+    if (rank == 0)
+    {
+      OGRSpatialReference      oSRS(projRef.c_str());
+      std::vector<std::string> options;
+
+      ogrDS = otb::ogr::DataSource::New(shapefile, otb::ogr::DataSource::Modes::Overwrite);
+      layer = ogrDS->CreateLayer(layername, &oSRS, wkbMultiPolygon, options);
+
+      OGRFieldDefn labelField("label", OFTInteger);
+      layer.CreateField(labelField, true);
+      OGRFieldDefn nbPixelsField("nbPixels", OFTInteger);
+      layer.CreateField(nbPixelsField, true);
+
+      for (unsigned int comp = 0; comp < numberOfComponentsPerPixel; ++comp)
+      {
+        std::ostringstream fieldoss;
+        fieldoss << "meanB" << comp;
+        OGRFieldDefn field(fieldoss.str().c_str(), OFTReal);
+        layer.CreateField(field, true);
+      }
+
+      for (unsigned int comp = 0; comp < numberOfComponentsPerPixel; ++comp)
+      {
+        std::ostringstream fieldoss;
+        fieldoss << "varB" << comp;
+        OGRFieldDefn field(fieldoss.str().c_str(), OFTReal);
+        layer.CreateField(field, true);
+      }
+    }
+
+    if (traceMode)
+    {
+      VectorizeByBoundaryTracing(layer, labelIn, imageIn, sizeTilesX, sizeTilesY, rank, nbProcs);
+    }
+    else
+    {
+      VectorizeByUnion(ogrDS, layer, layername, labelIn, imageIn, sizeTilesX, sizeTilesY);
+    }
+
+    if (rank == 0)
+    {
+      const OGRErr err = layer.ogr().CommitTransaction();
+
+      if (err != OGRERR_NONE)
+      {
+        itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << layer.ogr().GetName() << ".");
+      }
+
+      if (extension == ".shp")
+      {
+        std::ostringstream sqloss;
+        sqloss << "REPACK " << layername;
+        ogrDS->ogr().ExecuteSQL(sqloss.str().c_str(), nullptr, nullptr);
+      }
+
+      ogrDS->SyncToDisk();
+    }
+
+    clock_t toc = clock();
+
+    otbAppLogINFO(<< "Elapsed time: " << (double)(toc - tic) / CLOCKS_PER_SEC << " seconds");
+  }
+
+  /** Sums of the pixels of a segment not written yet */
+  struct SegmentStatistics
+  {
+    int                  nbPixels;
+    ImageType::PixelType sum;
+    ImageType::PixelType sum2;
+  };
+  typedef std::unordered_map<LabelImagePixelType, SegmentStatistics> SegmentStatisticsMapType;
+
+  void CreateSegmentFeature(otb::ogr::Layer& layer, LabelImagePixelType label, const SegmentStatistics& stats, otb::ogr::UniqueGeometryPtr geometry)
+  {
+    otb::ogr::Feature feature(layer.GetLayerDefn());
+    feature.ogr().SetField("label", static_cast<int>(label));
+    feature.ogr().SetField("nbPixels", stats.nbPixels);
+
+    const unsigned int numberOfComponentsPerPixel = stats.sum.GetSize();
+
+    // Radiometric means per label
+    for (unsigned int comp = 0; comp < numberOfComponentsPerPixel; ++comp)
+    {
+      std::ostringstream fieldoss;
+      fieldoss << "meanB" << comp;
+      feature.ogr().SetField(fieldoss.str().c_str(), stats.sum[comp] / stats.nbPixels);
+    }
+
+    // Variances per label
+    for (unsigned int comp = 0; comp < numberOfComponentsPerPixel; ++comp)
+    {
+      std::ostringstream fieldoss;
+      fieldoss << "varB" << comp;
+      float var = 0;
+      if (stats.nbPixels != 1)
+        var = (stats.sum2[comp] - stats.sum[comp] * stats.sum[comp] / stats.nbPixels) / (stats.nbPixels - 1);
+      feature.ogr().SetField(fieldoss.str().c_str(), var);
+    }
+
+    feature.SetGeometryDirectly(std::move(geometry));
+    layer.CreateFeature(feature);
+  }
+
+  static void WriteSegmentStatistics(std::ostream& os, LabelImagePixelType label, const SegmentStatistics& stats)
+  {
+    const unsigned int nbComp = stats.sum.GetSize();
+    os.write(reinterpret_cast<const char*>(&label), sizeof(LabelImagePixelType));
+    os.write(reinterpret_cast<const char*>(&stats.nbPixels), sizeof(int));
+    os.write(reinterpret_cast<const char*>(stats.sum.GetDataPointer()), nbComp * sizeof(ImagePixelType));
+    os.write(reinterpret_cast<const char*>(stats.sum2.GetDataPointer()), nbComp * sizeof(ImagePixelType));
+  }
+
+  static bool ReadSegmentStatistics(std::istream& is, unsigned int nbComp, LabelImagePixelType& label, SegmentStatistics& stats)
+  {
+    stats.sum.SetSize(nbComp);
+    stats.sum2.SetSize(nbComp);
+    is.read(reinterpret_cast<char*>(&label), sizeof(LabelImagePixelType));
+    is.read(reinterpret_cast<char*>(&stats.nbPixels), sizeof(int));
+    is.read(reinterpret_cast<char*>(stats.sum.GetDataPointer()), nbComp * sizeof(ImagePixelType));
+    is.read(reinterpret_cast<char*>(stats.sum2.GetDataPointer()), nbComp * sizeof(ImagePixelType));
+    return static_cast<bool>(is);
+  }
+
+  void VectorizeByBoundaryTracing(otb::ogr::Layer& layer, LabelImageType* labelIn, ImageType* imageIn, unsigned long sizeTilesX, unsigned long sizeTilesY,
+                                  unsigned int rank, unsigned int nbProcs)
+  {
+    unsigned long sizeImageX = labelIn->GetLargestPossibleRegion().GetSize()[0];
+    unsigned long sizeImageY = labelIn->GetLargestPossibleRegion().GetSize()[1];
+
+    unsigned int nbTilesX = sizeImageX / sizeTilesX + (sizeImageX % sizeTilesX > 0 ? 1 : 0);
+    unsigned int nbTilesY = sizeImageY / sizeTilesY + (sizeImageY % sizeTilesY > 0 ? 1 : 0);
+
+    otbAppLogINFO(<< "Number of tiles: " << nbTilesX << " x " << nbTilesY);
+
+    // Each process traces a band of tile rows
+    const unsigned int firstTileRow = static_cast<unsigned int>((static_cast<unsigned long>(nbTilesY) * rank) / nbProcs);
+    const unsigned int lastTileRow  = static_cast<unsigned int>((static_cast<unsigned long>(nbTilesY) * (rank + 1)) / nbProcs);
+
+    unsigned long numberOfComponentsPerPixel = imageIn->GetNumberOfComponentsPerPixel();
+
+    ImageType::PixelType defaultValue(numberOfComponentsPerPixel);
+    defaultValue.Fill(0);
+
+    // Statistics of the labels not yet written
+    SegmentStatisticsMapType statistics;
+
+    BoundaryTracerType tracer;
+    tracer.SetImageInformation(labelIn);
+
+    const LabelImageType::RegionType largestRegion = labelIn->GetLargestPossibleRegion();
+
+    // Regions touching the first row of the band may extend in the band above
+    const BoundaryTracerType::IndexValueType bandStartRow =
+        (firstTileRow > 0) ? largestRegion.GetIndex(1) + firstTileRow * sizeTilesY : largestRegion.GetIndex(1) - 1;
+
+    // Polygons of the other processes, sent to the first one
+    std::ostringstream completeSegments;
+
+    // Vectorization per tile
+    otbAppLogINFO(<< "Vectorization ...");
+    for (unsigned int row = firstTileRow; row < lastTileRow; row++)
+    {
+      unsigned long startY = row * sizeTilesY;
+      unsigned long sizeY  = std::min(sizeTilesY, sizeImageY - startY);
+
+      for (unsigned int column = 0; column < nbTilesX; column++)
+      {
+        unsigned long startX = column * sizeTilesX;
+        unsigned long sizeX  = std::min(sizeTilesX, sizeImageX - startX);
+
+        LabelImageType::RegionType tile;
+        tile.SetIndex(0, largestRegion.GetIndex(0) + startX);
+        tile.SetIndex(1, largestRegion.GetIndex(1) + startY);
+        tile.SetSize(0, sizeX);
+        tile.SetSize(1, sizeY);
+
+        // One more column and row of labels to find the tile border edges
+        LabelImageType::RegionType paddedTile = tile;
+        paddedTile.SetSize(0, sizeX + 1);
+        paddedTile.SetSize(1, sizeY + 1);
+        paddedTile.Crop(largestRegion);
+
+        labelIn->SetRequestedRegion(paddedTile);
+        labelIn->PropagateRequestedRegion();
+        labelIn->UpdateOutputData();
+
+        ImageType::RegionType imageTile;
+        imageTile.SetIndex(0, imageIn->GetLargestPossibleRegion().GetIndex(0) + startX);
+        imageTile.SetIndex(1, imageIn->GetLargestPossibleRegion().GetIndex(1) + startY);
+        imageTile.SetSize(0, sizeX);
+        imageTile.SetSize(1, sizeY);
+
+        imageIn->SetRequestedRegion(imageTile);
+        imageIn->PropagateRequestedRegion();
+        imageIn->UpdateOutputData();
+
+        // Sums calculation for the mean and the variance calculation per label
+        LabelImageIterator itLabel(labelIn, tile);
+        ImageIterator      itImage(imageIn, imageTile);
+        for (itLabel.GoToBegin(), itImage.GoToBegin(); !itImage.IsAtEnd(); ++itLabel, ++itImage)
+        {
+          const LabelImagePixelType label = itLabel.Value();
+          if (label == 0)
+          {
+            continue;
+          }
+
+          auto statsIt = statistics.find(label);
+          if (statsIt == statistics.end())
+          {
+            SegmentStatistics stats;
+            stats.nbPixels = 0;
+            stats.sum      = defaultValue;
+            stats.sum2     = defaultValue;
+            statsIt        = statistics.emplace(label, stats).first;
+          }
+
+          SegmentStatistics& stats = statsIt->second;
+          stats.nbPixels++;
+          for (unsigned int comp = 0; comp < numberOfComponentsPerPixel; ++comp)
+          {
+            stats.sum[comp] += itImage.Get()[comp];
+            stats.sum2[comp] += itImage.Get()[comp] * itImage.Get()[comp];
+          }
+        }
+
+        tracer.AddTile(labelIn, tile);
+      }
+
+      // Write the segments which do not extend below this tile row (regions
+      // continuing below have been seen in the extra row of the tiles)
+      BoundaryTracerType::LabelListType completeLabels;
+      if (row + 1 < lastTileRow)
+      {
+        completeLabels = tracer.GetCompleteLabels(largestRegion.GetIndex(1) + startY + sizeY, bandStartRow);
+      }
+      else if (row + 1 == nbTilesY)
+      {
+        completeLabels = tracer.GetCompleteLabels(itk::NumericTraits<BoundaryTracerType::IndexValueType>::max(), bandStartRow);
+      }
+
+      for (LabelImagePixelType curLabel : completeLabels)
+      {
+        auto statsIt = statistics.find(curLabel);
+        if (rank == 0)
+        {
+          CreateSegmentFeature(layer, curLabel, statsIt->second, tracer.TakeGeometry(curLabel));
+        }
+        else
+        {
+          otb::ogr::UniqueGeometryPtr geometry = tracer.TakeGeometry(curLabel);
+          std::vector<unsigned char>  wkb(geometry ? geometry->WkbSize() : 0);
+          if (geometry)
+          {
+            geometry->exportToWkb(wkbNDR, wkb.data());
+          }
+          const std::uint64_t wkbSize = wkb.size();
+          WriteSegmentStatistics(completeSegments, curLabel, statsIt->second);
+          completeSegments.write(reinterpret_cast<const char*>(&wkbSize), sizeof(std::uint64_t));
+          completeSegments.write(reinterpret_cast<const char*>(wkb.data()), wkbSize);
+        }
+        statistics.erase(statsIt);
+      }
+    }
+
+    if (nbProcs > 1)
+    {
+      GatherSegments(layer, tracer, statistics, completeSegments.str(), numberOfComponentsPerPixel, rank);
+    }
+  }
+
+  /** Sends the polygons and the open segments of each process to the first
+   * one, which writes them after stitching the open segments */
+  void GatherSegments(otb::ogr::Layer& layer, BoundaryTracerType& tracer, SegmentStatisticsMapType& statistics, const std::string& completeSegments,
+                      unsigned int nbComp, unsigned int rank)
+  {
+#ifdef OTB_USE_MPI
+    std::ostringstream openEdges;
+    std::ostringstream openStatistics;
+    if (rank != 0)
+    {
+      // Regions seen in the extra row below the band may have no pixel here
+      SegmentStatistics empty;
+      empty.nbPixels = 0;
+      empty.sum.SetSize(nbComp);
+      empty.sum.Fill(0);
+      empty.sum2 = empty.sum;
+
+      for (LabelImagePixelType label : tracer.GetOpenLabels())
+      {
+        tracer.ExportLabel(label, openEdges);
+        auto statsIt = statistics.find(label);
+        WriteSegmentStatistics(openStatistics, label, statsIt != statistics.end() ? statsIt->second : empty);
+      }
+      statistics.clear();
+    }
+
+    otb::MPIConfig::Pointer  mpiConfig         = otb::MPIConfig::Instance();
+    std::vector<std::string> allComplete       = mpiConfig->gather(completeSegments, 0);
+    std::vector<std::string> allOpenEdges      = mpiConfig->gather(openEdges.str(), 0);
+    std::vector<std::string> allOpenStatistics = mpiConfig->gather(openStatistics.str(), 0);
+
+    if (rank != 0)
+    {
+      return;
+    }
+
+    otbAppLogINFO(<< "Gathering polygons from " << allComplete.size() << " processes ...");
+    for (std::size_t r = 1; r < allComplete.size(); ++r)
+    {
+      std::istringstream  is(allComplete[r]);
+      LabelImagePixelType label;
+      SegmentStatistics   stats;
+      while (ReadSegmentStatistics(is, nbComp, label, stats))
+      {
+        std::uint64_t wkbSize = 0;
+        is.read(reinterpret_cast<char*>(&wkbSize), sizeof(std::uint64_t));
+        std::vector<unsigned char> wkb(wkbSize);
+        is.read(reinterpret_cast<char*>(wkb.data()), wkbSize);
+
+        OGRGeometry* geometry = nullptr;
+        if (wkbSize > 0 && OGRGeometryFactory::createFromWkb(wkb.data(), nullptr, &geometry, static_cast<int>(wkbSize)) != OGRERR_NONE)
+        {
+          otbAppLogFATAL(<< "Unable to read the polygon of segment " << label << " sent by process " << r);
+        }
+        CreateSegmentFeature(layer, label, stats, otb::ogr::UniqueGeometryPtr(geometry));
+      }
+
+      // Segments crossing the limits between processes
+      std::istringstream edges(allOpenEdges[r]);
+      tracer.ImportLabels(edges);
+
+      std::istringstream openStats(allOpenStatistics[r]);
+      while (ReadSegmentStatistics(openStats, nbComp, label, stats))
+      {
+        auto statsIt = statistics.find(label);
+        if (statsIt == statistics.end())
+        {
+          statistics.emplace(label, stats);
+        }
+        else
+        {
+          statsIt->second.nbPixels += stats.nbPixels;
+          statsIt->second.sum += stats.sum;
+          statsIt->second.sum2 += stats.sum2;
+        }
+      }
+    }
+
+    otbAppLogINFO(<< "Stitching " << tracer.GetNumberOfOpenLabels() << " segments across processes ...");
+    for (LabelImagePixelType label : tracer.GetOpenLabels())
+    {
+      CreateSegmentFeature(layer, label, statistics[label], tracer.TakeGeometry(label));
+    }
+#else
+    (void)layer;
+    (void)tracer;
+    (void)statistics;
+    (void)completeSegments;
+    (void)nbComp;
+    (void)rank;
+#endif
+  }
+
+  void VectorizeByUnion(otb::ogr::DataSource::Pointer ogrDS, otb::ogr::Layer& layer, const std::string& layername, LabelImageType* labelIn,
+                        ImageType* imageIn, unsigned long sizeTilesX, unsigned long sizeTilesY)
+  {
     unsigned long sizeImageX = labelIn->GetLargestPossibleRegion().GetSize()[0];
     unsigned long sizeImageY = labelIn->GetLargestPossibleRegion().GetSize()[1];
 
@@ -159,11 +582,7 @@ private:
     stats->Update();
     unsigned int regionCount = stats->GetMaximum();
 
-    ImageType::Pointer imageIn = GetParameterImage("in");
-    imageIn->UpdateOutputInformation();
-
     unsigned long numberOfComponentsPerPixel = imageIn->GetNumberOfComponentsPerPixel();
-    std::string   projRef                    = imageIn->GetProjectionRef();
 
     std::vector<int> nbPixels;
     nbPixels.clear();
@@ -180,39 +599,6 @@ private:
     std::vector<ImageType::PixelType> sum(regionCount + 1, defaultValue);
     std::vector<ImageType::PixelType> sum2(regionCount + 1, defaultValue);
 
-    otb::ogr::DataSource::Pointer ogrDS;
-    otb::ogr::Layer               layer(nullptr, false);
-
-    OGRSpatialReference      oSRS(projRef.c_str());
-    std::vector<std::string> options;
-
-    ogrDS                 = otb::ogr::DataSource::New(shapefile, otb::ogr::DataSource::Modes::Overwrite);
-    std::string layername = itksys::SystemTools::GetFilenameName(shapefile);
-    std::string extension = itksys::SystemTools::GetFilenameLastExtension(shapefile);
-    layername             = layername.substr(0, layername.size() - (extension.size()));
-    layer                 = ogrDS->CreateLayer(layername, &oSRS, wkbMultiPolygon, options);
-
-    OGRFieldDefn labelField("label", OFTInteger);
-    layer.CreateField(labelField, true);
-    OGRFieldDefn nbPixelsField("nbPixels", OFTInteger);
-    layer.CreateField(nbPixelsField, true);
-
-    for (unsigned int comp = 0; comp < numberOfComponentsPerPixel; ++comp)
-    {
-      std::ostringstream fieldoss;
-      fieldoss << "meanB" << comp;
-      OGRFieldDefn field(fieldoss.str().c_str(), OFTReal);
-      layer.CreateField(field, true);
-    }
-
-    for (unsigned int comp = 0; comp < numberOfComponentsPerPixel; ++comp)
-    {
-      std::ostringstream fieldoss;
-      fieldoss << "varB" << comp;
-      OGRFieldDefn field(fieldoss.str().c_str(), OFTReal);
-      layer.CreateField(field, true);
-    }
-
     // Vectorization per tile
     otbAppLogINFO(<< "Vectorization ...");
     for (unsigned int row = 0; row < nbTilesY; row++)
@@ -365,26 +751,6 @@ private:
       // Next geometry
       firstFeature = nextFeature;
     }
-
-    const OGRErr err = layer.ogr().CommitTransaction();
-
-    if (err != OGRERR_NONE)
-    {
-      itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << layer.ogr().GetName() << ".");
-    }
-
-    if (extension == ".shp")
-    {
-      sqloss.str("");
-      sqloss << "REPACK " << layername;
-      ogrDS->ogr().ExecuteSQL(sqloss.str().c_str(), nullptr, nullptr);
-    }
-
-    ogrDS->SyncToDisk();
-
-    clock_t toc = clock();
-
-    otbAppLogINFO(<< "Elapsed time: " << (double)(toc - tic) / CLOCKS_PER_SEC << " seconds");
   }
 
   void AddValidGeometry(OGRMultiPolygon& multi, OGRGeometry const* g)
@@ -21,6 +21,10 @@
 #include "otbWrapperCompositeApplication.h"
 #include "otbWrapperApplicationFactory.h"
 
+#ifdef OTB_USE_MPI
+#include "otbMPIConfig.h"
+#endif
+
 namespace otb
 {
 namespace Wrapper
@@ -71,7 +75,12 @@ private:
         "are additional fields to describe each region. In particular the mean "
         "and standard deviation (for each band) is computed for each region "
         "using the input image as support. If an optional 'imfield' image is "
-        "given, it will be used as support image instead.");
+        "given, it will be used as support image instead.\n\n"
+        "When run with MPI, the tiles are segmented by all the processes, the "
+        "temporary label images are written in parallel (the output path must "
+        "then be on a file system shared by the processes), and the polygons "
+        "are traced by bands of tiles then gathered and written by the first "
+        "process.");
     SetDocLimitations("None");
     SetDocAuthors("OTB-Team");
     SetDocSeeAlso(
@@ -196,7 +205,18 @@ private:
     }
     DisableParameter("mode.raster.out");
 
-    if (GetParameterInt("cleanup"))
+    bool isMaster = true;
+#ifdef OTB_USE_MPI
+    otb::MPIConfig::Pointer mpiConfig = otb::MPIConfig::Instance();
+    if (mpiConfig->GetNbProcs() > 1)
+    {
+      // The temporary files are shared by the processes
+      mpiConfig->barrier();
+      isMaster = (mpiConfig->GetMyRank() == 0);
+    }
+#endif
+
+    if (GetParameterInt("cleanup") && isMaster)
     {
       otbAppLogINFO(<< "Final clean-up ...");
       for (unsigned int i = 0; i < tmpFilenames.size(); ++i)
@@ -175,6 +175,19 @@ private:
                             "If activated pixel iterative convergence is stopped if the path crosses an already converged pixel. Be careful, with this option, "
                             "the result will slightly depend on thread number and the results will not be stable (see [4] for more details).");
 
+    AddParameter(ParameterType_Bool, "basin", "Basin of attraction");
+    SetParameterDescription("basin",
+                            "Only used with modesearch. When a pixel converges to a new mode, the unprocessed pixels close enough to this mode "
+                            "(according to modetol) are assigned to it without iterating. This gives a large speed-up on homogeneous areas.");
+
+    AddParameter(ParameterType_Float, "modetol", "Mode search tolerance");
+    SetParameterDescription("modetol",
+                            "Only used with modesearch. Squared distance, normalized by the radii, under which a pixel is considered to share the mode of "
+                            "a trajectory. Lower values give results closer to the exact mean shift, with less speed-up.");
+    SetDefaultParameterFloat("modetol", 0.5);
+    SetMinimumParameterFloatValue("modetol", 0.0);
+    MandatoryOff("modetol");
+
     AddRAMParameter();
     SetMultiWriting(true);
 
@@ -208,6 +221,8 @@ private:
     filter->SetMaxIterationNumber(GetParameterInt("maxiter"));
     filter->SetRangeBandwidthRamp(GetParameterFloat("rangeramp"));
     filter->SetModeSearch(GetParameterInt("modesearch"));
+    filter->SetModeSearchTolerance(GetParameterFloat("modetol"));
+    filter->SetBasinOfAttraction(GetParameterInt("basin"));
 
     // Compute the margin used to ensure exact results (tile wise smoothing)
     // This margin is valid for the default uniform kernel used by the
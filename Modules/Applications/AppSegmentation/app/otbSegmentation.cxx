@@ -30,6 +30,7 @@
 #include "otbVectorImageToAmplitudeImageFilter.h"
 #include "itkGradientMagnitudeImageFilter.h"
 #include "otbWatershedSegmentationFilter.h"
+#include "otbPriorityFloodWatershedImageFilter.h"
 #include "otbMorphologicalProfilesSegmentationFilter.h"
 
 // Large scale vectorization framework
@@ -82,6 +83,8 @@ public:
 
   typedef otb::WatershedSegmentationFilter<FloatImageType, LabelImageType> WatershedSegmentationFilterType;
 
+  typedef otb::PriorityFloodWatershedImageFilter<FloatImageType, LabelImageType> PriorityFloodWatershedFilterType;
+
   // Geodesic morphology multiscale segmentation
   typedef otb::MorphologicalProfilesSegmentationFilter<FloatImageType, LabelImageType> MorphologicalProfilesSegmentationFilterType;
 
@@ -108,6 +111,8 @@ public:
   // Watershed
   typedef otb::StreamingImageToOGRLayerSegmentationFilter<FloatImageType, WatershedSegmentationFilterType> StreamingVectorizedWatershedFilterType;
 
+  typedef otb::StreamingImageToOGRLayerSegmentationFilter<FloatImageType, PriorityFloodWatershedFilterType> StreamingVectorizedPriorityFloodWatershedFilterType;
+
   typedef otb::ClampImageFilter<FloatImageType, UInt32ImageType> ClampFilterType;
 
   /** Standard macro */
@@ -125,12 +130,12 @@ private:
         "This application allows one to perform various segmentation algorithms on a multispectral image."
         " Available segmentation algorithms are two different versions of Mean-Shift segmentation algorithm (one being multi-threaded),"
         " simple pixel based connected components according to a user-defined criterion, and watershed from the gradient of the intensity"
-        " (norm of spectral bands vector). The application has two different modes that affects the nature of its output.\n\n"
+        " (norm of spectral bands vector), either with the ITK implementation or with a tiled, multi-threaded priority flood. The application has two different modes that affects the nature of its output.\n\n"
 
         "In raster mode, the output of the application is a classical image of unique labels identifying the segmented regions. The labeled output can be "
         "passed to the"
         " ColorMapping application to render regions with contrasted colours. Please note that this mode loads the whole input image into memory, and as such"
-        " can not handle large images.\n\n"
+        " can not handle large images, except with the priority flood watershed which is streamed.\n\n"
 
         "To segment large data, one can use the vector mode. In this case, the output of the application is a"
         " vector file or database. The input image is split into tiles (whose size can be set using the tilesize parameter), and each tile is loaded, segmented"
@@ -248,6 +253,24 @@ private:
     SetDefaultParameterFloat("filter.mprofiles.sigma", 1.);
     SetMinimumParameterFloatValue("filter.mprofiles.sigma", 0.);
 
+    // Priority flood watershed
+    AddChoice("filter.pfwatershed", "Priority flood watershed");
+    SetParameterDescription("filter.pfwatershed",
+                            "Watershed by priority flood, on the same height function as the watershed method. Tiles are flooded in parallel with an "
+                            "overlap, and the basins split by the tiles are merged, so that large images can be processed in both modes.");
+
+    AddParameter(ParameterType_Float, "filter.pfwatershed.depth", "Minimum basin depth");
+    SetParameterDescription("filter.pfwatershed.depth",
+                            "Basins shallower than this depth below the pass where they meet a neighbour are merged into it. Expressed in gradient "
+                            "magnitude units (0 keeps all the regional minima).");
+    SetDefaultParameterFloat("filter.pfwatershed.depth", 1.);
+    SetMinimumParameterFloatValue("filter.pfwatershed.depth", 0.);
+
+    AddParameter(ParameterType_Int, "filter.pfwatershed.margin", "Tile overlap");
+    SetParameterDescription("filter.pfwatershed.margin", "Number of pixels each tile is padded with before flooding.");
+    SetDefaultParameterInt("filter.pfwatershed.margin", 32);
+    SetMinimumParameterIntValue("filter.pfwatershed.margin", 1);
+
     // Raster mode parameters
     AddParameter(ParameterType_OutputImage, "mode.raster.out", "Output labeled image");
     SetParameterDescription("mode.raster.out", "The output labeled image.");
@@ -446,7 +469,11 @@ private:
       //            "Computing " + (dynamic_cast <ChoiceParameter *>
       //                            (this->GetParameterByKey("filter")))->GetChoiceKey(GetParameterInt("filter"))
       //            + " segmentation");
-      streamingVectorizedFilter->GetSegmentationFilter()->Update();
+      // The priority flood watershed is streamed by the writer
+      if (GetParameterString("filter") != "pfwatershed")
+      {
+        streamingVectorizedFilter->GetSegmentationFilter()->Update();
+      }
     }
     return streamingVectorizedFilter->GetStreamSize();
   }
@@ -624,6 +651,25 @@ private:
       streamSize = this->GenericApplySegmentation<FloatImageType, WatershedSegmentationFilterType>(watershedVectorizedFilter,
                                                                                                    gradientMagnitudeFilter->GetOutput(), layer, 0);
     }
+    else if (segType == "pfwatershed")
+    {
+      otbAppLogINFO("Using priority flood watershed segmentation.");
+
+      AmplitudeFilterType::Pointer amplitudeFilter = AmplitudeFilterType::New();
+
+      amplitudeFilter->SetInput(this->GetParameterFloatVectorImage("in"));
+
+      GradientMagnitudeFilterType::Pointer gradientMagnitudeFilter = GradientMagnitudeFilterType::New();
+      gradientMagnitudeFilter->SetInput(amplitudeFilter->GetOutput());
+
+      StreamingVectorizedPriorityFloodWatershedFilterType::Pointer watershedVectorizedFilter = StreamingVectorizedPriorityFloodWatershedFilterType::New();
+
+      watershedVectorizedFilter->GetSegmentationFilter()->SetDepth(GetParameterFloat("filter.pfwatershed.depth"));
+      watershedVectorizedFilter->GetSegmentationFilter()->SetMargin(GetParameterInt("filter.pfwatershed.margin"));
+
+      streamSize = this->GenericApplySegmentation<FloatImageType, PriorityFloodWatershedFilterType>(watershedVectorizedFilter,
+                                                                                                    gradientMagnitudeFilter->GetOutput(), layer, 0);
+    }
     else if (segType == "mprofiles")
     {
       otbAppLogINFO("Using multiscale geodesic morphology segmentation.");
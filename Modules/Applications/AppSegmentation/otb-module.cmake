@@ -43,6 +43,9 @@ otb_module(OTBAppSegmentation
     OTBLabelMap
     OTBProjection
 
+  OPTIONAL_DEPENDS
+    OTBMPIConfig
+
   TEST_DEPENDS
     OTBTestKernel
     OTBCommandLine
@@ -28,6 +28,7 @@
 
 #include "otbSubPixelDisparityImageFilter.h"
 #include "otbDisparityMapMedianFilter.h"
+#include "otbSemiGlobalMatchingImageFilter.h"
 
 namespace otb
 {
@@ -76,6 +77,8 @@ public:
 
   typedef otb::DisparityMapMedianFilter<FloatImageType, FloatImageType, FloatImageType> MedianFilterType;
 
+  typedef otb::SemiGlobalMatchingImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType> SGMFilterType;
+
   /** Standard macro */
   itkNewMacro(Self);
 
@@ -93,6 +96,7 @@ private:
     m_SSDSubPixFilter = SSDSubPixelDisparityFilterType::New();
     m_NCCSubPixFilter = NCCSubPixelDisparityFilterType::New();
     m_LPSubPixFilter  = LPSubPixelDisparityFilterType::New();
+    m_SGMFilter       = SGMFilterType::New();
     m_LVarianceFilter = VarianceFilterType::New();
     m_RVarianceFilter = VarianceFilterType::New();
     m_LBandMathFilter = BandMathFilterType::New();
@@ -265,6 +269,31 @@ private:
     SetDefaultParameterFloat("bm.metric.lp.p", 1.0);
     SetMinimumParameterFloatValue("bm.metric.lp.p", 0.0);
 
+    AddChoice("bm.metric.sgm", "Semi-Global Matching");
+    SetParameterDescription("bm.metric.sgm",
+                            "Semi-Global Matching of census transforms computed over the"
+                            " blocks (radius at most 3). Only horizontal disparities are"
+                            " estimated, on every pixel, and initial disparities are ignored.");
+
+    AddParameter(ParameterType_Int, "bm.metric.sgm.p1", "Small penalty");
+    SetParameterDescription("bm.metric.sgm.p1", "Penalty for disparity changes of one pixel along a path");
+    SetDefaultParameterInt("bm.metric.sgm.p1", 8);
+    SetMinimumParameterIntValue("bm.metric.sgm.p1", 0);
+
+    AddParameter(ParameterType_Int, "bm.metric.sgm.p2", "Large penalty");
+    SetParameterDescription("bm.metric.sgm.p2", "Penalty for larger disparity changes along a path (at least the small penalty)");
+    SetDefaultParameterInt("bm.metric.sgm.p2", 64);
+    SetMinimumParameterIntValue("bm.metric.sgm.p2", 0);
+
+    AddParameter(ParameterType_Int, "bm.metric.sgm.paths", "Number of paths");
+    SetParameterDescription("bm.metric.sgm.paths", "Number of aggregation paths (4, 8 or 16)");
+    SetDefaultParameterInt("bm.metric.sgm.paths", 8);
+
+    AddParameter(ParameterType_Bool, "bm.metric.sgm.lrcheck", "Left-right consistency check");
+    SetParameterDescription("bm.metric.sgm.lrcheck",
+                            "Invalidate pixels whose right to left disparity does not match."
+                            " Invalid pixels are written as 0 in the output mask.");
+
     AddParameter(ParameterType_Int, "bm.radius", "Radius of blocks");
     SetParameterDescription("bm.radius", "The radius (in pixels) of blocks in Block-Matching");
     SetDefaultParameterInt("bm.radius", 3);
@@ -353,6 +382,14 @@ private:
     MandatoryOff("bm.medianfilter.incoherence");
     DisableParameter("bm.medianfilter.incoherence");
 
+    AddParameter(ParameterType_Float, "bm.medianfilter.binsize", "Histogram bin size");
+    SetParameterDescription("bm.medianfilter.binsize",
+                            "Quantisation step of the disparities for a faster median computed "
+                            "with a sliding histogram (0 to compute the exact median)");
+    SetDefaultParameterFloat("bm.medianfilter.binsize", 0.0);
+    SetMinimumParameterFloatValue("bm.medianfilter.binsize", 0.0);
+    MandatoryOff("bm.medianfilter.binsize");
+
     AddParameter(ParameterType_Choice, "bm.initdisp", "Initial disparities");
     AddChoice("bm.initdisp.none", "None");
     SetParameterDescription("bm.initdisp.none", "No initial disparity used");
@@ -764,7 +801,7 @@ private:
       }
     }
     // Lp case
-    else
+    else if (GetParameterInt("bm.metric") == 2)
     {
       m_LPBlockMatcher->SetLeftInput(leftImage);
       m_LPBlockMatcher->SetRightInput(rightImage);
@@ -835,6 +872,45 @@ private:
         metricImage = m_LPBlockMatcher->GetMetricOutput();
       }
     }
+    // SGM case
+    else
+    {
+      if (minvdisp != 0 || maxvdisp != 0)
+      {
+        otbAppLogWARNING("Semi-Global Matching only estimates horizontal disparities, the vertical range is ignored.");
+      }
+      if (step > 1 || useInitialDispUniform || useInitialDispMap)
+      {
+        otbAppLogWARNING("Semi-Global Matching processes every pixel, step and initial disparities are ignored.");
+      }
+
+      m_SGMFilter->SetLeftInput(leftImage);
+      m_SGMFilter->SetRightInput(rightImage);
+      m_SGMFilter->SetRadius(radius);
+      m_SGMFilter->SetMinimumHorizontalDisparity(minhdisp);
+      m_SGMFilter->SetMaximumHorizontalDisparity(maxhdisp);
+      m_SGMFilter->SetP1(GetParameterInt("bm.metric.sgm.p1"));
+      m_SGMFilter->SetP2(GetParameterInt("bm.metric.sgm.p2"));
+      m_SGMFilter->SetNumberOfPaths(GetParameterInt("bm.metric.sgm.paths"));
+      m_SGMFilter->SetLeftRightCheck(GetParameterInt("bm.metric.sgm.lrcheck"));
+      m_SGMFilter->SetSubPixelInterpolation(GetParameterInt("bm.subpixel") > 0);
+
+      AddProcess(m_SGMFilter, "Semi-global matching");
+
+      if (maskingLeft)
+      {
+        m_SGMFilter->SetLeftMaskInput(maskLeftImage);
+      }
+      if (maskingRight)
+      {
+        m_SGMFilter->SetRightMaskInput(maskRightImage);
+      }
+
+      hdispImage    = m_SGMFilter->GetHorizontalDisparityOutput();
+      vdispImage    = m_SGMFilter->GetVerticalDisparityOutput();
+      metricImage   = m_SGMFilter->GetMetricOutput();
+      maskLeftImage = m_SGMFilter->GetOutputMask();
+    }
 
     if (IsParameterEnabled("bm.medianfilter.radius") && IsParameterEnabled("bm.medianfilter.incoherence"))
     {
@@ -844,6 +920,7 @@ private:
         m_HMedianFilter->SetInput(hdispImage);
         m_HMedianFilter->SetRadius(GetParameterInt("bm.medianfilter.radius"));
         m_HMedianFilter->SetIncoherenceThreshold(GetParameterFloat("bm.medianfilter.incoherence"));
+        m_HMedianFilter->SetHistogramBinSize(GetParameterFloat("bm.medianfilter.binsize"));
         if (maskingLeft)
         {
           m_HMedianFilter->SetMaskInput(maskLeftImage);
@@ -856,6 +933,7 @@ private:
         m_VMedianFilter->SetInput(vdispImage);
         m_VMedianFilter->SetRadius(GetParameterInt("bm.medianfilter.radius"));
         m_VMedianFilter->SetIncoherenceThreshold(GetParameterFloat("bm.medianfilter.incoherence"));
+        m_VMedianFilter->SetHistogramBinSize(GetParameterFloat("bm.medianfilter.binsize"));
         if (maskingLeft)
         {
           m_VMedianFilter->SetMaskInput(maskLeftImage);
@@ -903,6 +981,9 @@ private:
   // LP sub-pixel disparity filter
   LPSubPixelDisparityFilterType::Pointer m_LPSubPixFilter;
 
+  // Semi-global matching filter
+  SGMFilterType::Pointer m_SGMFilter;
+
   // Variance filter for left image
   VarianceFilterType::Pointer m_LVarianceFilter;
 
@@ -221,7 +221,9 @@ private:
                             "Choose the metric used for block matching. "
                             "Available metrics are cross-correlation (CC), cross-correlation with "
                             "subtracted mean (CCSM), mean-square difference (MSD), mean reciprocal "
-                            "square difference (MRSD) and mutual information (MI). Default is "
+                            "square difference (MRSD), mutual information (MI) and cross-correlation with "
+                            "subtracted mean computed over the whole exploration area with FFTs (CCFFT), which is "
+                            "much faster for large exploration radii and ignores spa, cva. Default is "
                             "cross-correlation");
     MandatoryOff("m");
 
@@ -410,9 +412,14 @@ private:
       m_Registration->SetMetric(m_MetricPtr);
       m_Registration->MinimizeOn();
     }
+    else if (metricId == "CCFFT")
+    {
+      otbAppLogINFO("Metric : Cross-correlation (mean subtracted) with FFT");
+      m_Registration->UseFFTOn();
+    }
     else
     {
-      itkExceptionMacro("Metric not recognized. Possible choices are: CC, CCSM, MSD, MRSD, MI");
+      itkExceptionMacro("Metric not recognized. Possible choices are: CC, CCSM, MSD, MRSD, MI, CCFFT");
     }
 
     m_XExtractor = VectorImageToImageFilterType::New();
@@ -41,10 +41,18 @@
 #include "itkInverseDisplacementFieldImageFilter.h"
 
 #include "itkRescaleIntensityImageFilter.h"
+#include "itkResampleImageFilter.h"
+#include "itkNearestNeighborInterpolateImageFunction.h"
+#include "otbStreamingShrinkImageFilter.h"
 #include "otbStreamingMinMaxImageFilter.h"
 #include "otbExtractROI.h"
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
+#include "itksys/SystemTools.hxx"
+#include <fstream>
+#include <functional>
+#include <iomanip>
+#include <sstream>
 
 
 #include "otbMultiToMonoChannelExtractROI.h"
@@ -62,6 +70,7 @@
 #include "otbImageList.h"
 #include "otbImageListToVectorImageFilter.h"
 #include "otbBijectionCoherencyFilter.h"
+#include "otbSemiGlobalMatchingImageFilter.h"
 
 namespace otb
 {
@@ -116,6 +125,8 @@ public:
   typedef otb::PixelWiseBlockMatchingImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType, LPBlockMatchingFunctorType>
       LPBlockMatchingFilterType;
 
+  typedef otb::SemiGlobalMatchingImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType> SGMFilterType;
+
   typedef otb::BandMathImageFilter<FloatImageType> BandMathFilterType;
 
   typedef otb::SubPixelDisparityImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType, SSDBlockMatchingFunctorType> SSDSubPixelFilterType;
@@ -174,6 +185,11 @@ public:
 
   typedef otb::ImageToNoDataMaskFilter<FloatImageType, FloatImageType> NoDataMaskFilterType;
 
+  typedef otb::StreamingShrinkImageFilter<FloatVectorImageType, FloatVectorImageType> ShrinkFilterType;
+
+  typedef itk::ResampleImageFilter<FloatImageType, FloatImageType>             UpsampleFilterType;
+  typedef itk::NearestNeighborInterpolateImageFunction<FloatImageType, double> NearestNeighborInterpolatorType;
+
 private:
   StereoFramework()
   {
@@ -426,6 +442,13 @@ private:
     SetMinimumParameterIntValue("stereorect.invgridssrate", 1);
     MandatoryOff("stereorect.invgridssrate");
 
+    AddParameter(ParameterType_Directory, "stereorect.cache", "Stereo-rectification grids cache directory");
+    SetParameterDescription("stereorect.cache",
+                            "If set, the stereo-rectification grids of each couple are saved in this directory the first time they are "
+                            "computed, and read back by later runs sharing the same images, elevation settings and grid step, for instance "
+                            "to try other matching parameters without evaluating the sensor models again.");
+    MandatoryOff("stereorect.cache");
+
     AddParameter(ParameterType_Group, "bm", "Block matching parameters");
     SetParameterDescription("bm",
                             "This group of parameters allow tuning the "
@@ -459,6 +482,28 @@ private:
     SetDefaultParameterFloat("bm.metric.lp.p", 1.0);
     SetMinimumParameterFloatValue("bm.metric.lp.p", 0.0);
 
+    AddChoice("bm.metric.sgm", "Semi-Global Matching");
+    SetParameterDescription("bm.metric.sgm",
+                            "Semi-Global Matching of census transforms "
+                            "(computed over the correlation window, whose radius should be at most 3). "
+                            "Matching costs are aggregated along several paths with penalties on "
+                            "disparity changes. Right to left consistency is checked instead of a "
+                            "reverse block-matching when bijection consistency is used.");
+
+    AddParameter(ParameterType_Int, "bm.metric.sgm.p1", "Small penalty");
+    SetParameterDescription("bm.metric.sgm.p1", "Penalty for disparity changes of one pixel along a path");
+    SetDefaultParameterInt("bm.metric.sgm.p1", 8);
+    SetMinimumParameterIntValue("bm.metric.sgm.p1", 0);
+
+    AddParameter(ParameterType_Int, "bm.metric.sgm.p2", "Large penalty");
+    SetParameterDescription("bm.metric.sgm.p2", "Penalty for larger disparity changes along a path (at least the small penalty)");
+    SetDefaultParameterInt("bm.metric.sgm.p2", 64);
+    SetMinimumParameterIntValue("bm.metric.sgm.p2", 0);
+
+    AddParameter(ParameterType_Int, "bm.metric.sgm.paths", "Number of paths");
+    SetParameterDescription("bm.metric.sgm.paths", "Number of aggregation paths (4, 8 or 16)");
+    SetDefaultParameterInt("bm.metric.sgm.paths", 8);
+
     AddParameter(ParameterType_Int, "bm.radius", "Correlation window radius (in pixels)");
     SetParameterDescription("bm.radius", "The radius of blocks in Block-Matching (in pixels)");
     SetDefaultParameterInt("bm.radius", 2);
@@ -481,6 +526,28 @@ private:
     SetDefaultParameterFloat("bm.maxhoffset", 20.0);
     DisableParameter("bm.maxhoffset");
 
+    AddParameter(ParameterType_Group, "bm.pyramid", "Coarse to fine search");
+    SetParameterDescription("bm.pyramid",
+                            "Block-matching is first performed on epipolar images "
+                            "shrunk by a factor, and the full resolution search is then "
+                            "restricted around the disparities found at low resolution.");
+
+    AddParameter(ParameterType_Int, "bm.pyramid.factor", "Shrink factor");
+    SetParameterDescription("bm.pyramid.factor",
+                            "Shrink factor of the low resolution "
+                            "block-matching (disabled by default)");
+    SetDefaultParameterInt("bm.pyramid.factor", 4);
+    SetMinimumParameterIntValue("bm.pyramid.factor", 2);
+    MandatoryOff("bm.pyramid.factor");
+    DisableParameter("bm.pyramid.factor");
+
+    AddParameter(ParameterType_Int, "bm.pyramid.margin", "Disparity margin");
+    SetParameterDescription("bm.pyramid.margin",
+                            "Disparities explored at full resolution on each side of "
+                            "the upsampled low resolution disparity (in pixels)");
+    SetDefaultParameterInt("bm.pyramid.margin", 8);
+    SetMinimumParameterIntValue("bm.pyramid.margin", 1);
+
     AddParameter(ParameterType_Group, "postproc", "Postprocessing parameters");
     SetParameterDescription("postproc", "This group of parameters allow use optional filters.");
 
@@ -608,12 +675,234 @@ private:
         invBlockMatcherFilter->MinimizeOff();
     }
 
+    if (IsParameterEnabled("bm.pyramid.factor"))
+    {
+      this->SetCoarseDisparities<TMetricFunctor>(blockMatcherFilter, invBlockMatcherFilter, leftImage, rightImage);
+    }
+
     subPixelFilter->SetInputsFromBlockMatchingFilter(blockMatcherFilter);
     subPixelFilter->SetRefineMethod(SubPixelFilterType::DICHOTOMY);
     subPixelFilter->SetLeftMaskInput(finalMask);
     subPixelFilter->UpdateOutputInformation();
   }
 
+  /** Restrict the search of the block matchers around the disparities
+   *  found on the epipolar images shrunk by bm.pyramid.factor */
+  template <class TMetricFunctor>
+  void
+  SetCoarseDisparities(
+      otb::PixelWiseBlockMatchingImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType, TMetricFunctor>* blockMatcherFilter,
+      otb::PixelWiseBlockMatchingImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType, TMetricFunctor>* invBlockMatcherFilter,
+      FloatImageType* leftImage, FloatImageType* rightImage)
+  {
+    const unsigned int factor = this->GetParameterInt("bm.pyramid.factor");
+
+    // Both epipolar images are shrunk in a single pass
+    ImageListType::Pointer imageList = ImageListType::New();
+    imageList->PushBack(leftImage);
+    imageList->PushBack(rightImage);
+
+    ImageListToVectorImageFilterType::Pointer concatenateFilter = ImageListToVectorImageFilterType::New();
+    concatenateFilter->SetInput(imageList);
+    m_Filters.push_back(concatenateFilter.GetPointer());
+
+    ShrinkFilterType::Pointer shrinkFilter = ShrinkFilterType::New();
+    shrinkFilter->SetInput(concatenateFilter->GetOutput());
+    shrinkFilter->SetShrinkFactor(factor);
+    m_Filters.push_back(shrinkFilter.GetPointer());
+
+    AddProcess(shrinkFilter->GetStreamer(), "Shrinking epipolar images...");
+    shrinkFilter->Update();
+
+    ExtractROIFilterType::Pointer coarseLeftFilter = ExtractROIFilterType::New();
+    coarseLeftFilter->SetInput(shrinkFilter->GetOutput());
+    coarseLeftFilter->SetChannel(1);
+    m_Filters.push_back(coarseLeftFilter.GetPointer());
+
+    ExtractROIFilterType::Pointer coarseRightFilter = ExtractROIFilterType::New();
+    coarseRightFilter->SetInput(shrinkFilter->GetOutput());
+    coarseRightFilter->SetChannel(2);
+    m_Filters.push_back(coarseRightFilter.GetPointer());
+
+    FloatImageType::SizeType explorationRadius;
+    explorationRadius[0] = this->GetParameterInt("bm.pyramid.margin");
+    explorationRadius[1] = 0;
+
+    blockMatcherFilter->SetHorizontalDisparityInput(
+        this->ComputeCoarseDisparities<TMetricFunctor>(blockMatcherFilter, coarseLeftFilter->GetOutput(), coarseRightFilter->GetOutput(), leftImage));
+    blockMatcherFilter->SetExplorationRadius(explorationRadius);
+
+    if (GetParameterInt("postproc.bij"))
+    {
+      invBlockMatcherFilter->SetHorizontalDisparityInput(
+          this->ComputeCoarseDisparities<TMetricFunctor>(invBlockMatcherFilter, coarseRightFilter->GetOutput(), coarseLeftFilter->GetOutput(), rightImage));
+      invBlockMatcherFilter->SetExplorationRadius(explorationRadius);
+    }
+  }
+
+  /** Disparities of a block matcher computed on shrunk images, upsampled
+   *  to the grid of its full resolution left image */
+  template <class TMetricFunctor>
+  FloatImageType*
+  ComputeCoarseDisparities(
+      otb::PixelWiseBlockMatchingImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType, TMetricFunctor>* blockMatcherFilter,
+      FloatImageType* coarseLeftImage, FloatImageType* coarseRightImage, FloatImageType* leftImage)
+  {
+    typedef otb::PixelWiseBlockMatchingImageFilter<FloatImageType, FloatImageType, FloatImageType, FloatImageType, TMetricFunctor> BlockMatchingFilterType;
+
+    const unsigned int factor = this->GetParameterInt("bm.pyramid.factor");
+
+    const int coarseMinDisp = std::floor(static_cast<double>(blockMatcherFilter->GetMinimumHorizontalDisparity()) / factor);
+    const int coarseMaxDisp = std::ceil(static_cast<double>(blockMatcherFilter->GetMaximumHorizontalDisparity()) / factor);
+    otbAppLogINFO(<< "Coarse disparity range : [" << coarseMinDisp << ", " << coarseMaxDisp << "] at 1/" << factor << " resolution");
+
+    // Masks are not shrunk: each full resolution pixel gets an initial disparity
+    typename BlockMatchingFilterType::Pointer coarseMatcherFilter = BlockMatchingFilterType::New();
+    coarseMatcherFilter->GetFunctor() = blockMatcherFilter->GetFunctor();
+    coarseMatcherFilter->SetLeftInput(coarseLeftImage);
+    coarseMatcherFilter->SetRightInput(coarseRightImage);
+    coarseMatcherFilter->SetRadius(blockMatcherFilter->GetRadius());
+    coarseMatcherFilter->SetMinimumHorizontalDisparity(coarseMinDisp);
+    coarseMatcherFilter->SetMaximumHorizontalDisparity(coarseMaxDisp);
+    coarseMatcherFilter->SetMinimumVerticalDisparity(0);
+    coarseMatcherFilter->SetMaximumVerticalDisparity(0);
+    coarseMatcherFilter->SetMinimize(blockMatcherFilter->GetMinimize());
+    m_Filters.push_back(coarseMatcherFilter.GetPointer());
+
+    BandMathFilterType::Pointer scaleFilter = BandMathFilterType::New();
+    scaleFilter->SetNthInput(0, coarseMatcherFilter->GetHorizontalDisparityOutput(), "hdisp");
+    std::ostringstream scaleExpression;
+    scaleExpression << "hdisp * " << factor;
+    scaleFilter->SetExpression(scaleExpression.str());
+    m_Filters.push_back(scaleFilter.GetPointer());
+
+    leftImage->UpdateOutputInformation();
+
+    UpsampleFilterType::Pointer upsampleFilter = UpsampleFilterType::New();
+    upsampleFilter->SetInput(scaleFilter->GetOutput());
+    upsampleFilter->SetInterpolator(NearestNeighborInterpolatorType::New());
+    upsampleFilter->SetOutputParametersFromImage(leftImage);
+    m_Filters.push_back(upsampleFilter.GetPointer());
+
+    return upsampleFilter->GetOutput();
+  }
+
+
+  /** Describe everything the stereo-rectification grids of a couple depend on */
+  std::string GetEpipolarGridKey(const FloatImageType* inleft, const FloatImageType* inright, const DisplacementFieldSourceType* epipolarGridSource)
+  {
+    std::ostringstream oss;
+    oss << std::setprecision(17);
+
+    // Sensor models
+    for (const auto& image : {std::make_pair("left", inleft), std::make_pair("right", inright)})
+    {
+      const ImageMetadata& imd = image.second->GetImageMetadata();
+      oss << image.first << ".projection: " << image.second->GetProjectionRef() << "\n";
+      oss << image.first << ".origin: " << image.second->GetOrigin() << "\n";
+      oss << image.first << ".spacing: " << image.second->GetSignedSpacing() << "\n";
+      oss << image.first << ".size: " << image.second->GetLargestPossibleRegion().GetSize() << "\n";
+      oss << image.first << ".metadata: " << imd.ToJSON() << "\n";
+      if (imd.Has(MDGeom::RPC))
+      {
+        oss << image.first << ".rpc: " << boost::any_cast<Projection::RPCParam>(imd[MDGeom::RPC]).ToJSON() << "\n";
+      }
+    }
+
+    // Elevation settings
+    for (const std::string& key : {"elev.dem", "elev.geoid", "elev.default"})
+    {
+      if (HasValue(key))
+      {
+        oss << key << ": " << GetParameterAsString(key) << "\n";
+      }
+    }
+
+    // Grid
+    oss << "grid.step: " << epipolarGridSource->GetGridStep() << "\n";
+    oss << "grid.scale: " << epipolarGridSource->GetScale() << "\n";
+    oss << "grid.usedem: " << epipolarGridSource->GetUseDEM() << "\n";
+
+    return oss.str();
+  }
+
+  /** Compute the stereo-rectification grids of a couple. If stereorect.cache is set, the grids
+   * are read from the cache directory, and computed and saved there first if needed */
+  void UpdateEpipolarGrids(const FloatImageType* inleft, const FloatImageType* inright, DisplacementFieldSourceType* epipolarGridSource,
+                           FloatVectorImageType::Pointer& leftGrid, FloatVectorImageType::Pointer& rightGrid, FloatImageType::SizeType& epiSize,
+                           double& meanBaseline)
+  {
+    std::string leftGridFile, rightGridFile, keyFile, key;
+    bool        hit = false;
+
+    if (IsParameterEnabled("stereorect.cache") && HasValue("stereorect.cache"))
+    {
+      key = GetEpipolarGridKey(inleft, inright, epipolarGridSource);
+
+      std::ostringstream name;
+      name << GetParameterString("stereorect.cache") << "/stereogrid_" << std::hex << std::setw(16) << std::setfill('0') << std::hash<std::string>()(key);
+      leftGridFile  = name.str() + "_left.tif";
+      rightGridFile = name.str() + "_right.tif";
+      // The key file is written last, so that it also marks complete grids. It
+      // holds the key, then the rectified size and mean baseline ratio.
+      keyFile = name.str() + ".key";
+
+      std::ifstream keyStream(keyFile);
+      if (keyStream && itksys::SystemTools::FileExists(leftGridFile) && itksys::SystemTools::FileExists(rightGridFile))
+      {
+        std::string cachedKey(key.size(), '\0');
+        keyStream.read(&cachedKey[0], key.size());
+        hit = keyStream && cachedKey == key && keyStream >> epiSize[0] >> epiSize[1] >> meanBaseline;
+      }
+    }
+
+    if (hit)
+    {
+      otbAppLogINFO("Re-using epipolar grids " << leftGridFile << " and " << rightGridFile);
+
+      ReaderType::Pointer leftReader = ReaderType::New();
+      leftReader->SetFileName(leftGridFile);
+      leftReader->Update();
+      leftGrid = leftReader->GetOutput();
+      m_Filters.push_back(leftReader.GetPointer());
+
+      ReaderType::Pointer rightReader = ReaderType::New();
+      rightReader->SetFileName(rightGridFile);
+      rightReader->Update();
+      rightGrid = rightReader->GetOutput();
+      m_Filters.push_back(rightReader.GetPointer());
+      return;
+    }
+
+    AddProcess(epipolarGridSource, "Computing epipolar grids...");
+    epipolarGridSource->Update();
+
+    leftGrid     = epipolarGridSource->GetLeftDisplacementFieldOutput();
+    rightGrid    = epipolarGridSource->GetRightDisplacementFieldOutput();
+    epiSize      = epipolarGridSource->GetRectifiedImageSize();
+    meanBaseline = epipolarGridSource->GetMeanBaselineRatio();
+
+    if (!key.empty())
+    {
+      otbAppLogINFO("Saving epipolar grids " << leftGridFile << " and " << rightGridFile);
+      itksys::SystemTools::MakeDirectory(GetParameterString("stereorect.cache"));
+
+      for (const auto& grid : {std::make_pair(leftGrid, leftGridFile), std::make_pair(rightGrid, rightGridFile)})
+      {
+        WriterType::Pointer writer = WriterType::New();
+        writer->SetInput(grid.first);
+        writer->SetFileName(grid.second);
+        writer->Update();
+      }
+
+      std::ofstream out(keyFile);
+      out << std::setprecision(17) << key << epiSize[0] << " " << epiSize[1] << " " << meanBaseline << "\n";
+      if (!out)
+      {
+        otbAppLogWARNING("Unable to write epipolar grid key " << keyFile);
+      }
+    }
+  }
 
   void DoExecute() override
   {
@@ -703,23 +992,21 @@ private:
         otbAppLogWARNING(<< "Grid step value" << this->GetParameterInt("stereorect.fwdgridstep") << " seems too be to high.");
       }
 
-      AddProcess(epipolarGridSource, "Computing epipolar grids...");
-      epipolarGridSource->Update();
+      FloatVectorImageType::Pointer leftGrid, rightGrid;
+      FloatImageType::SizeType      epiSize;
+      double                        meanBaseline = 0;
+      this->UpdateEpipolarGrids(inleft, inright, epipolarGridSource, leftGrid, rightGrid, epiSize, meanBaseline);
 
       FloatImageType::SpacingType epiSpacing;
       epiSpacing[0] = 0.5 * (std::abs(inleft->GetSignedSpacing()[0]) + std::abs(inleft->GetSignedSpacing()[1]));
       epiSpacing[1] = 0.5 * (std::abs(inleft->GetSignedSpacing()[0]) + std::abs(inleft->GetSignedSpacing()[1]));
 
-      FloatImageType::SizeType epiSize;
-      epiSize = epipolarGridSource->GetRectifiedImageSize();
       FloatImageType::PointType epiOrigin;
       epiOrigin[0] = 0.0;
       epiOrigin[1] = 0.0;
 
       FloatImageType::PixelType defaultValue = 0;
 
-      double meanBaseline = epipolarGridSource->GetMeanBaselineRatio();
-
       double minDisp = std::floor((-1.0) * overElev * meanBaseline / epiSpacing[0]);
       double maxDisp = std::ceil((-1.0) * underElev * meanBaseline / epiSpacing[0]);
       otbAppLogINFO(<< "Minimum disparity : " << minDisp);
@@ -727,7 +1014,7 @@ private:
 
       // Compute rectification grids (left/right and left inverse (for disparity translate filter)).
       DisplacementFieldCastFilterType::Pointer leftGridCaster = DisplacementFieldCastFilterType::New();
-      leftGridCaster->SetInput(epipolarGridSource->GetLeftDisplacementFieldOutput());
+      leftGridCaster->SetInput(leftGrid);
       leftGridCaster->Update();
 
       DisplacementFieldType::Pointer leftDisplacement;
@@ -773,7 +1060,7 @@ private:
       m_Filters.push_back(leftResampleFilter.GetPointer());
 
       DisplacementFieldCastFilterType::Pointer rightGridCaster = DisplacementFieldCastFilterType::New();
-      rightGridCaster->SetInput(epipolarGridSource->GetRightDisplacementFieldOutput());
+      rightGridCaster->SetInput(rightGrid);
       rightGridCaster->Update();
 
       DisplacementFieldType::Pointer rightDisplacement;
@@ -941,6 +1228,8 @@ private:
       LPBlockMatchingFilterType::Pointer invLPBlockMatcherFilter;
       LPSubPixelFilterType::Pointer      LPSubPixelFilter;
 
+      SGMFilterType::Pointer SGMFilter;
+
       switch (GetParameterInt("bm.metric"))
       {
       case 0: // SSDDivMean
@@ -1045,11 +1334,49 @@ private:
             lBandMathFilter->GetOutput(), rBandMathFilter->GetOutput(), finalMaskFilter->GetOutput(), minimize, minDisp, maxDisp);
 
         break;
+
+      case 4: // SGM
+        otbAppLogINFO(<< "Using Semi-Global Matching.");
+        if (IsParameterEnabled("bm.pyramid.factor"))
+        {
+          otbAppLogWARNING(<< "Coarse to fine search is not used with Semi-Global Matching.");
+        }
+
+        SGMFilter = SGMFilterType::New();
+        SGMFilter->SetLeftInput(leftResampleFilter->GetOutput());
+        SGMFilter->SetRightInput(rightResampleFilter->GetOutput());
+        SGMFilter->SetLeftMaskInput(lBandMathFilter->GetOutput());
+        SGMFilter->SetRightMaskInput(rBandMathFilter->GetOutput());
+        SGMFilter->SetRadius(this->GetParameterInt("bm.radius"));
+        SGMFilter->SetMinimumHorizontalDisparity(minDisp);
+        SGMFilter->SetMaximumHorizontalDisparity(maxDisp);
+        SGMFilter->SetP1(this->GetParameterInt("bm.metric.sgm.p1"));
+        SGMFilter->SetP2(this->GetParameterInt("bm.metric.sgm.p2"));
+        SGMFilter->SetNumberOfPaths(this->GetParameterInt("bm.metric.sgm.paths"));
+        SGMFilter->SetLeftRightCheck(GetParameterInt("postproc.bij"));
+        SGMFilter->UpdateOutputInformation();
+        blockMatcherFilterPointer = SGMFilter.GetPointer();
+        m_Filters.push_back(blockMatcherFilterPointer);
+
+        minimize = true;
+        break;
       default:
         break;
       }
 
-      if (GetParameterInt("postproc.bij"))
+      if (GetParameterInt("postproc.bij") && SGMFilter)
+      {
+        otbAppLogINFO(<< "Using right to left consistency of Semi-Global Matching to filter incoherent disparity values.");
+        finalMaskFilter->SetNthInput(1, SGMFilter->GetOutputMask(), "lrrl");
+
+#ifdef OTB_MUPARSER_HAS_CXX_LOGICAL_OPERATORS
+        finalMaskFilter->SetExpression("(inmask > 0 and lrrl > 0) ? 255 : 0");
+#else
+        finalMaskFilter->SetExpression("if(inmask > 0 and lrrl > 0, 255, 0)");
+#endif
+        m_Filters.push_back(finalMaskFilter.GetPointer());
+      }
+      else if (GetParameterInt("postproc.bij"))
       {
         otbAppLogINFO(<< "Using reverse block-matching to filter incoherent disparity values.");
         bijectFilter = BijectionFilterType::New();
@@ -1077,12 +1404,17 @@ private:
       }
 
 
-      FloatImageType::Pointer hDispOutput    = subPixelFilterPointer->GetOutput(0);
+      // Semi-Global Matching refines its disparities itself
+      FloatImageType* hDispImage  = SGMFilter ? SGMFilter->GetHorizontalDisparityOutput() : subPixelFilterPointer->GetOutput(0);
+      FloatImageType* vDispImage  = SGMFilter ? SGMFilter->GetVerticalDisparityOutput() : subPixelFilterPointer->GetOutput(1);
+      FloatImageType* metricImage = SGMFilter ? SGMFilter->GetMetricOutput() : subPixelFilterPointer->GetOutput(2);
+
+      FloatImageType::Pointer hDispOutput    = hDispImage;
       FloatImageType::Pointer finalMaskImage = finalMaskFilter->GetOutput();
       if (GetParameterInt("postproc.med"))
       {
         MedianFilterType::Pointer hMedianFilter = MedianFilterType::New();
-        hMedianFilter->SetInput(subPixelFilterPointer->GetOutput(0));
+        hMedianFilter->SetInput(hDispImage);
         hMedianFilter->SetRadius(2);
         hMedianFilter->SetIncoherenceThreshold(2.0);
         hMedianFilter->SetMaskInput(finalMaskFilter->GetOutput());
@@ -1094,7 +1426,7 @@ private:
 
       DisparityTranslateFilter::Pointer disparityTranslateFilter = DisparityTranslateFilter::New();
       disparityTranslateFilter->SetHorizontalDisparityMapInput(hDispOutput);
-      disparityTranslateFilter->SetVerticalDisparityMapInput(subPixelFilterPointer->GetOutput(1));
+      disparityTranslateFilter->SetVerticalDisparityMapInput(vDispImage);
       disparityTranslateFilter->SetInverseEpipolarLeftGrid(leftInverseDisplacement);
       disparityTranslateFilter->SetDirectEpipolarRightGrid(rightDisplacement);
       // disparityTranslateFilter->SetDisparityMaskInput()
@@ -1210,7 +1542,7 @@ private:
       maskCondition << "(hdisp > " << minDisp << ") and (hdisp < " << maxDisp << ") and (mask>0)";
       if (IsParameterEnabled("postproc.metrict"))
       {
-        dispMaskFilter->SetNthInput(2, subPixelFilterPointer->GetOutput(2), "metric");
+        dispMaskFilter->SetNthInput(2, metricImage, "metric");
         maskCondition << " and (metric ";
         if (minimize == true)
         {
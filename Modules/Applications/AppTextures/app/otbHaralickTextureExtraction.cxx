@@ -25,6 +25,7 @@
 #include "otbScalarImageToTexturesFilter.h"
 #include "otbScalarImageToAdvancedTexturesFilter.h"
 #include "otbScalarImageToHigherOrderTexturesFilter.h"
+#include "otbScalarImageToMultiOffsetTexturesFilter.h"
 
 #include "otbMultiToMonoChannelExtractROI.h"
 #include "otbClampImageFilter.h"
@@ -48,9 +49,10 @@ public:
   typedef MultiToMonoChannelExtractROI<FloatVectorImageType::InternalPixelType, FloatVectorImageType::InternalPixelType> ExtractorFilterType;
   typedef ClampImageFilter<FloatImageType, FloatImageType>                                                               ClampFilterType;
 
-  typedef ScalarImageToTexturesFilter<FloatImageType, FloatImageType>            HarTexturesFilterType;
-  typedef ScalarImageToAdvancedTexturesFilter<FloatImageType, FloatImageType>    AdvTexturesFilterType;
-  typedef ScalarImageToHigherOrderTexturesFilter<FloatImageType, FloatImageType> HigTexturesFilterType;
+  typedef ScalarImageToTexturesFilter<FloatImageType, FloatImageType>                  HarTexturesFilterType;
+  typedef ScalarImageToAdvancedTexturesFilter<FloatImageType, FloatImageType>          AdvTexturesFilterType;
+  typedef ScalarImageToHigherOrderTexturesFilter<FloatImageType, FloatImageType>       HigTexturesFilterType;
+  typedef ScalarImageToMultiOffsetTexturesFilter<FloatImageType, FloatVectorImageType> AllTexturesFilterType;
 
   typedef HarTexturesFilterType::SizeType   RadiusType;
   typedef HarTexturesFilterType::OffsetType OffsetType;
@@ -185,6 +187,12 @@ private:
                             "Short Run High Grey-Level Emphasis, Long Run Low Grey-Level Emphasis and "
                             "Long Run High Grey-Level Emphasis");
 
+    AddChoice("texture.all", "All Texture Features");
+    SetParameterDescription("texture.all",
+                            "This group of parameters defines the "
+                            "28 texture feature output image, computed in a single pass: the 8 simple, "
+                            "the 10 advanced and the 10 higher order features, in this order");
+
     AddParameter(ParameterType_OutputImage, "out", "Output Image");
     SetParameterDescription("out", "Output image containing the selected texture features.");
     MandatoryOff("out");
@@ -277,6 +285,7 @@ private:
       m_HarTexFilter->SetNumberOfBinsPerAxis(GetParameterInt("parameters.nbbin"));
       m_HarTexFilter->SetSubsampleFactor(stepping);
       m_HarTexFilter->SetSubsampleOffset(stepOffset);
+      m_HarTexFilter->IncrementalOn();
       m_HarTexFilter->UpdateOutputInformation();
       m_HarImageList->PushBack(m_HarTexFilter->GetEnergyOutput());
       m_HarImageList->PushBack(m_HarTexFilter->GetEntropyOutput());
@@ -300,6 +309,7 @@ private:
       m_AdvTexFilter->SetNumberOfBinsPerAxis(GetParameterInt("parameters.nbbin"));
       m_AdvTexFilter->SetSubsampleFactor(stepping);
       m_AdvTexFilter->SetSubsampleOffset(stepOffset);
+      m_AdvTexFilter->IncrementalOn();
       m_AdvImageList->PushBack(m_AdvTexFilter->GetMeanOutput());
       m_AdvImageList->PushBack(m_AdvTexFilter->GetVarianceOutput());
       m_AdvImageList->PushBack(m_AdvTexFilter->GetDissimilarityOutput());
@@ -337,6 +347,20 @@ private:
       m_HigConcatener->SetInput(m_HigImageList);
       SetParameterOutputImage("out", m_HigConcatener->GetOutput());
     }
+
+    if (texType == "all")
+    {
+      m_AllTexFilter = AllTexturesFilterType::New();
+      m_AllTexFilter->SetInput(const_cast<FloatImageType*>(m_ClampFilter->GetOutput()));
+      m_AllTexFilter->SetRadius(radius);
+      m_AllTexFilter->SetOffset(offset);
+      m_AllTexFilter->SetInputImageMinimum(GetParameterFloat("parameters.min"));
+      m_AllTexFilter->SetInputImageMaximum(GetParameterFloat("parameters.max"));
+      m_AllTexFilter->SetNumberOfBinsPerAxis(GetParameterInt("parameters.nbbin"));
+      m_AllTexFilter->SetSubsampleFactor(stepping);
+      m_AllTexFilter->SetSubsampleOffset(stepOffset);
+      SetParameterOutputImage("out", m_AllTexFilter->GetOutput());
+    }
   }
   ExtractorFilterType::Pointer m_ExtractorFilter;
   ClampFilterType::Pointer     m_ClampFilter;
@@ -350,6 +374,7 @@ private:
   HigTexturesFilterType::Pointer            m_HigTexFilter;
   ImageListType::Pointer                    m_HigImageList;
   ImageListToVectorImageFilterType::Pointer m_HigConcatener;
+  AllTexturesFilterType::Pointer            m_AllTexFilter;
 };
 }
 }
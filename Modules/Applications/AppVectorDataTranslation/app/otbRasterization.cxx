@@ -70,11 +70,11 @@ private:
         "setting all parameters (origin, size, spacing) by hand. In the latter case, at least the spacing (ground sampling distance) is needed (other "
         "parameters are computed automatically). The rasterized output can also be in a different projection reference system than the input dataset.\n\n"
 
-        "There are two rasterize mode available in the application. The first is the binary mode: it allows rendering all pixels belonging to a geometry of "
+        "There are three rasterize modes available in the application. The first is the binary mode: it allows rendering all pixels belonging to a geometry of "
         "the "
         "input dataset in the foreground color, while rendering the other in background color. The second one allows rendering pixels belonging to a geometry "
         "with respect to an attribute of this geometry. The field of the attribute to render can be set by the user. In the second mode, the background value "
-        "is still used for unassociated pixels.");
+        "is still used for unassociated pixels. The third one renders the fraction of each pixel covered by the geometries.");
     SetDocLimitations("None");
     SetDocAuthors("OTB-Team");
     SetDocSeeAlso("For now, support of input dataset with multiple layers having different projection reference system is limited.");
@@ -144,6 +144,24 @@ private:
     SetParameterDescription("mode.attribute.field", "Name of the attribute field to burn");
     SetParameterString("mode.attribute.field", "DN");
 
+    AddChoice("mode.coverage", "Coverage fraction mode");
+    SetParameterDescription("mode.coverage",
+                            "In this mode, pixels hold the fraction of their area covered by the geometries, multiplied by the foreground value. The fraction "
+                            "is estimated on a grid of sub-pixels.");
+
+    AddParameter(ParameterType_Float, "mode.coverage.foreground", "Foreground value");
+    SetParameterDescription("mode.coverage.foreground", "Value for pixels fully covered by the geometries");
+    SetDefaultParameterFloat("mode.coverage.foreground", 1.);
+
+    AddParameter(ParameterType_Int, "mode.coverage.subdivision", "Sub-pixels per pixel side");
+    SetParameterDescription("mode.coverage.subdivision", "Number of sub-pixels along each side of a pixel to estimate the fraction");
+    SetDefaultParameterInt("mode.coverage.subdivision", 4);
+    SetMinimumParameterIntValue("mode.coverage.subdivision", 1);
+
+    AddParameter(ParameterType_Bool, "alltouched", "Burn all touched pixels");
+    SetParameterDescription("alltouched",
+                            "In binary and attribute modes, burn all the pixels touched by a geometry, instead of the pixels whose center is inside");
+
     AddRAMParameter();
 
     SetDocExampleParameterValue("in", "qb_RoadExtract_classification.shp");
@@ -348,6 +366,14 @@ private:
       m_OGRDataSourceRendering->SetBurnAttributeMode(true);
       m_OGRDataSourceRendering->SetBurnAttribute(GetParameterString("mode.attribute.field"));
     }
+    else if (GetParameterString("mode") == "coverage")
+    {
+      m_OGRDataSourceRendering->SetBurnAttributeMode(false);
+      m_OGRDataSourceRendering->CoverageFractionModeOn();
+      m_OGRDataSourceRendering->SetForegroundValue(GetParameterFloat("mode.coverage.foreground"));
+      m_OGRDataSourceRendering->SetCoverageSubdivision(GetParameterInt("mode.coverage.subdivision"));
+    }
+    m_OGRDataSourceRendering->SetAllTouchedMode(GetParameterInt("alltouched"));
 
     if (validInputProjRef)
     {
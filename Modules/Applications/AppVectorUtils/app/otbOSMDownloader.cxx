@@ -97,6 +97,13 @@ private:
                             "footway...). It defines the type of feature to select inside a category.");
     MandatoryOff("value");
 
+    AddParameter(ParameterType_Directory, "cachedir", "Cache directory");
+    SetParameterDescription("cachedir",
+                            "Directory where the answers of the OSM server are "
+                            "kept. An extent already requested is read from this directory instead "
+                            "of being downloaded again.");
+    MandatoryOff("cachedir");
+
     // Elevation
     ElevationParametersHandler::AddElevationParameters(this, "elev");
 
@@ -164,6 +171,11 @@ private:
     m_VdOSMGenerator->SetEast(east);
     m_VdOSMGenerator->SetWest(west);
 
+    if (IsParameterEnabled("cachedir") && HasValue("cachedir"))
+    {
+      m_VdOSMGenerator->SetCacheDirectory(GetParameterString("cachedir"));
+    }
+
     try
     {
       m_VdOSMGenerator->Update();
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComplexToIntensityMultilookImageFilter_h
+#define otbComplexToIntensityMultilookImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+namespace otb
+{
+
+/** \class ComplexToIntensityMultilookImageFilter
+ * \brief Computes the intensity of a complex image, averaged over looks
+ *
+ * Each band of the output is the intensity of the same band of the
+ * complex input, averaged over AzimuthLooks lines and RangeLooks samples.
+ * With one look in both directions, the output is the one of
+ * ComplexToIntensityImageFilter applied to each band.
+ *
+ * The filter reads the input buffer directly as interleaved real and
+ * imaginary parts, which is the layout of the GDAL CInt16 and CFloat32
+ * pixels: the squared parts of a whole line are summed in a single loop,
+ * without going through a std::complex per pixel, and the looks are
+ * accumulated in the same pass. The intermediate full resolution
+ * intensity image is thus never allocated.
+ *
+ * Output pixels only average complete looks: the output size is the input
+ * size divided by the number of looks. The output spacing is multiplied by
+ * the number of looks and the origin is moved to the center of the first
+ * look, as in SarCalibrationDeburstMultilookImageFilter.
+ *
+ * TInputImage is expected to be an otb::VectorImage of std::complex
+ * values, and TOutputImage an otb::VectorImage of real values.
+ *
+ * \sa ComplexToIntensityImageFilter
+ * \ingroup IntensityImageFilters  Multithreaded
+ *
+ * \ingroup OTBCommon
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT ComplexToIntensityMultilookImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ComplexToIntensityMultilookImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(ComplexToIntensityMultilookImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                                 InputImageType;
+  typedef typename InputImageType::RegionType         InputImageRegionType;
+  typedef typename InputImageType::InternalPixelType  InputInternalPixelType;
+  typedef typename InputInternalPixelType::value_type InputValueType;
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+
+  /** Number of lines averaged in azimuth */
+  itkSetClampMacro(AzimuthLooks, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+  itkGetConstMacro(AzimuthLooks, unsigned int);
+
+  /** Number of samples averaged in range */
+  itkSetClampMacro(RangeLooks, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+  itkGetConstMacro(RangeLooks, unsigned int);
+
+protected:
+  ComplexToIntensityMultilookImageFilter();
+  ~ComplexToIntensityMultilookImageFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void GenerateInputRequestedRegion() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ComplexToIntensityMultilookImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  unsigned int m_AzimuthLooks;
+  unsigned int m_RangeLooks;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbComplexToIntensityMultilookImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,187 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComplexToIntensityMultilookImageFilter_hxx
+#define otbComplexToIntensityMultilookImageFilter_hxx
+
+#include "otbComplexToIntensityMultilookImageFilter.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+ComplexToIntensityMultilookImageFilter<TInputImage, TOutputImage>::ComplexToIntensityMultilookImageFilter() : m_AzimuthLooks(1), m_RangeLooks(1)
+{
+}
+
+template <class TInputImage, class TOutputImage>
+void ComplexToIntensityMultilookImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  // Call superclass implementation
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType* inputPtr  = this->GetInput();
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  const InputImageRegionType&              inputLargestRegion = inputPtr->GetLargestPossibleRegion();
+  typename InputImageType::PointType       origin             = inputPtr->GetOrigin();
+  typename InputImageType::SpacingType     spacing            = inputPtr->GetSignedSpacing();
+  typename OutputImageRegionType::SizeType outputSize;
+
+  // Only complete looks are kept
+  const unsigned int looks[2] = {m_RangeLooks, m_AzimuthLooks};
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    outputSize[dim] = inputLargestRegion.GetSize()[dim] / looks[dim];
+    origin[dim] += 0.5 * (looks[dim] - 1) * spacing[dim];
+    spacing[dim] *= looks[dim];
+  }
+
+  if (outputSize[0] == 0 || outputSize[1] == 0)
+  {
+    itkExceptionMacro(<< "Input image (" << inputLargestRegion.GetSize()[0] << " x " << inputLargestRegion.GetSize()[1]
+                      << ") is smaller than the number of looks (" << m_RangeLooks << " x " << m_AzimuthLooks << ")");
+  }
+
+  OutputImageRegionType outputLargestRegion;
+  outputLargestRegion.SetIndex(inputLargestRegion.GetIndex());
+  outputLargestRegion.SetSize(outputSize);
+
+  outputPtr->SetLargestPossibleRegion(outputLargestRegion);
+  outputPtr->SetOrigin(origin);
+  outputPtr->SetSignedSpacing(spacing);
+  outputPtr->SetNumberOfComponentsPerPixel(inputPtr->GetNumberOfComponentsPerPixel());
+}
+
+template <class TInputImage, class TOutputImage>
+void ComplexToIntensityMultilookImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  const OutputImageRegionType&                     outputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  const typename OutputImageRegionType::IndexType& outputIndex           = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+
+  const unsigned int                       looks[2] = {m_RangeLooks, m_AzimuthLooks};
+  typename InputImageRegionType::IndexType inputIndex;
+  typename InputImageRegionType::SizeType  inputSize;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    inputIndex[dim] = outputIndex[dim] + (outputRequestedRegion.GetIndex()[dim] - outputIndex[dim]) * looks[dim];
+    inputSize[dim]  = outputRequestedRegion.GetSize()[dim] * looks[dim];
+  }
+
+  InputImageRegionType inputRequestedRegion(inputIndex, inputSize);
+  inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion());
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void ComplexToIntensityMultilookImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                itk::ThreadIdType            threadId)
+{
+  const InputImageType*                            inputPtr       = this->GetInput();
+  OutputImageType*                                 outputPtr      = this->GetOutput();
+  const InputImageRegionType&                      inputBuffered  = inputPtr->GetBufferedRegion();
+  const OutputImageRegionType&                     outputBuffered = outputPtr->GetBufferedRegion();
+  const typename OutputImageRegionType::IndexType& outputIndex    = outputPtr->GetLargestPossibleRegion().GetIndex();
+
+  const unsigned int nbBands   = inputPtr->GetNumberOfComponentsPerPixel();
+  const unsigned int width     = outputRegionForThread.GetSize()[0];
+  const unsigned int nbSamples = width * m_RangeLooks;
+  const double       norm      = 1. / (m_AzimuthLooks * m_RangeLooks);
+
+  // Interleaved (real, imaginary) values of a complex pixel, as in the
+  // GDAL complex buffers
+  const InputValueType* inputBuffer = reinterpret_cast<const InputValueType*>(inputPtr->GetBufferPointer());
+
+  std::vector<double> intensities(nbSamples * nbBands);
+  std::vector<double> sums(width * nbBands);
+
+  const long firstColumn = outputIndex[0] + (outputRegionForThread.GetIndex()[0] - outputIndex[0]) * m_RangeLooks;
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize()[1]);
+
+  for (unsigned int row = 0; row < outputRegionForThread.GetSize()[1]; ++row)
+  {
+    const long y         = outputRegionForThread.GetIndex()[1] + row;
+    const long firstLine = outputIndex[1] + (y - outputIndex[1]) * m_AzimuthLooks;
+
+    std::fill(sums.begin(), sums.end(), 0.);
+
+    for (unsigned int k = 0; k < m_AzimuthLooks; ++k)
+    {
+      const long            offset = (firstLine + k - inputBuffered.GetIndex()[1]) * inputBuffered.GetSize()[0] + firstColumn - inputBuffered.GetIndex()[0];
+      const InputValueType* values = inputBuffer + 2 * offset * nbBands;
+
+      // Intensity of each band of each sample of the line
+      for (unsigned int i = 0; i < nbSamples * nbBands; ++i)
+      {
+        const double re = values[2 * i];
+        const double im = values[2 * i + 1];
+        intensities[i]  = re * re + im * im;
+      }
+
+      // Accumulation of the range looks
+      const double* intensity = intensities.data();
+      for (unsigned int i = 0; i < width; ++i)
+      {
+        double* sum = &sums[i * nbBands];
+        for (unsigned int r = 0; r < m_RangeLooks; ++r)
+        {
+          for (unsigned int b = 0; b < nbBands; ++b, ++intensity)
+          {
+            sum[b] += *intensity;
+          }
+        }
+      }
+    }
+
+    const long outputOffset =
+        (y - outputBuffered.GetIndex()[1]) * outputBuffered.GetSize()[0] + outputRegionForThread.GetIndex()[0] - outputBuffered.GetIndex()[0];
+    OutputInternalPixelType* out = outputPtr->GetBufferPointer() + outputOffset * nbBands;
+    for (unsigned int i = 0; i < width * nbBands; ++i)
+    {
+      out[i] = static_cast<OutputInternalPixelType>(sums[i] * norm);
+    }
+
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void ComplexToIntensityMultilookImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "AzimuthLooks: " << m_AzimuthLooks << std::endl;
+  os << indent << "RangeLooks: " << m_RangeLooks << std::endl;
+}
+
+} // end namespace otb
+
+#endif
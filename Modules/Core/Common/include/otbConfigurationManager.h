@@ -84,6 +84,17 @@ public:
    */
   static RAMValueType GetMaxRAMHint();
 
+  /**
+   * MaxOpenDatasets is the maximum number of images opened for
+   * reading by GDAL at the same time. Beyond it, the least recently
+   * read images are closed, and opened again when needed.
+   *
+   * If environment variable OTB_MAX_OPEN_DATASETS is defined and
+   * could be converted to int, returns its content (0 means no
+   * limit). Else, returns default value, which is 512.
+   */
+  static unsigned int GetMaxOpenDatasets();
+
   /**
    * Logger level controls the level of logging that OTB will output.
    *
@@ -104,6 +115,55 @@ public:
    */
   static itk::LoggerBase::PriorityLevelType GetLoggerLevel();
 
+  /**
+   * TraceFile is the path of the Chrome trace written by
+   * PipelineTracer at the end of each application execution.
+   *
+   * If environment variable OTB_TRACE_FILE is defined,
+   * returns it contents as a string
+   * Else, returns an empty string (tracing disabled)
+   */
+  static std::string GetTraceFile();
+
+  /**
+   * NUMAPolicy controls how image buffers and ITK threads are placed
+   * on NUMA nodes (see NUMAPolicy class).
+   *
+   * If environment variable OTB_NUMA_POLICY is defined,
+   * returns it contents as a string (none, firsttouch or pin)
+   * Else, returns an empty string (no placement)
+   */
+  static std::string GetNUMAPolicy();
+
+  /**
+   * BufferPoolSize is the maximum size of the released image buffers
+   * kept for reuse by ImageBufferPool, expressed in MegaBytes.
+   *
+   * If environment variable OTB_BUFFER_POOL_SIZE is defined and could
+   * be converted to int, returns its content. Else, returns default
+   * value, which is 0 (buffers are not recycled).
+   */
+  static RAMValueType GetBufferPoolSize();
+
+  /**
+   * UseHugePages tells if ImageBufferPool aligns large buffers on huge
+   * pages.
+   *
+   * Returns true if environment variable OTB_HUGE_PAGES is set to ON,
+   * TRUE, YES or 1 (case insensitive), false otherwise.
+   */
+  static bool GetUseHugePages();
+
+  /**
+   * MPISplitScheduling controls how the MPI writers assign the streaming
+   * divisions to the processes.
+   *
+   * If environment variable OTB_MPI_SPLIT_SCHEDULING is defined,
+   * returns it contents as a string (static or dynamic)
+   * Else, returns an empty string (static assignment)
+   */
+  static std::string GetMPISplitScheduling();
+
   /**
    * If OpenMP is enabled, the number of threads for openMP is set to the
    * same number as in ITK (see GetGlobalDefaultNumberOfThreads()). This number
@@ -112,6 +172,42 @@ public:
    */
   static int InitOpenMPThreads();
 
+  /**
+   * Number of threads a parallel runtime (ITK, OpenMP, Shark) started
+   * from the calling thread may use.
+   *
+   * Outside of any ThreadBudgetScope, this is the ITK global default
+   * number of threads. Inside a scope, this is the share of the budget
+   * granted to the calling thread, so that nested parallel sections do
+   * not multiply the number of threads.
+   */
+  static int GetAvailableThreads();
+
+  /** \class ThreadBudgetScope
+   * \brief Share the thread budget of a parallel section between its workers
+   *
+   * Each worker of a parallel section (ITK ThreadedGenerateData, OpenMP
+   * thread...) creates a scope with the number of workers of the
+   * section and the budget of the thread that started it, which defaults
+   * to the budget of the calling thread. Until the scope is destroyed,
+   * GetAvailableThreads() called from this worker returns budget /
+   * nbWorkers, and at least 1.
+   *
+   * \ingroup OTBCommon
+   */
+  class OTBCommon_EXPORT ThreadBudgetScope
+  {
+  public:
+    explicit ThreadBudgetScope(int nbWorkers, int budget = GetAvailableThreads());
+    ~ThreadBudgetScope();
+
+  private:
+    ThreadBudgetScope(const ThreadBudgetScope&) = delete;
+    void operator=(const ThreadBudgetScope&) = delete;
+
+    int m_PreviousBudget;
+  };
+
 private:
   ConfigurationManager()                            = delete;
   ~ConfigurationManager()                           = delete;
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageBufferPool_h
+#define otbImageBufferPool_h
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <unordered_map>
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+/** \class ImageBufferPool
+ *  \brief Recycle the pixel buffers of images between streamed splits.
+ *
+ * Before each streamed split, ITK gives every image of the pipeline a new
+ * pixel container, and the buffer of the previous split is freed just
+ * before a buffer of the same size is allocated again. For large splits,
+ * each of these allocations maps new pages which are faulted in again.
+ *
+ * When the pool is enabled, the buffers of otb::Image and
+ * otb::VectorImage are taken from it (see PooledImportImageContainer).
+ * Released buffers are kept, up to the maximum size of the pool, and
+ * given back to the next request of exactly the same size, whether it
+ * comes from the same filter at the next split or from another filter.
+ * The least recently released buffers are freed first when the pool is
+ * full.
+ *
+ * The pool is disabled by default. Its maximum size is read from the
+ * OTB_BUFFER_POOL_SIZE environment variable (see
+ * ConfigurationManager::GetBufferPoolSize()). With OTB_HUGE_PAGES set,
+ * large buffers are aligned on huge pages and marked for transparent
+ * huge pages (Linux only).
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT ImageBufferPool
+{
+public:
+  /** Return the process wide pool */
+  static ImageBufferPool& GetInstance();
+
+  /** Tell if buffers are taken from the pool */
+  bool IsEnabled() const;
+
+  /** Set the maximum size of the released buffers kept, in bytes. 0
+   * disables the pool */
+  void SetMaximumSize(std::size_t bytes);
+
+  /** Get the maximum size of the released buffers kept, in bytes */
+  std::size_t GetMaximumSize() const;
+
+  /** Enable the alignment of large buffers on huge pages */
+  void SetUseHugePages(bool use);
+
+  /** Tell if large buffers are aligned on huge pages */
+  bool GetUseHugePages() const;
+
+  /** Return a buffer of the given size, recycled if possible. Returns
+   * nullptr if the allocation fails */
+  void* Acquire(std::size_t bytes);
+
+  /** Give back a buffer returned by Acquire(). Returns false, and does
+   * nothing, if the buffer does not come from the pool */
+  bool Release(void* buffer);
+
+  /** Size of the released buffers kept, in bytes */
+  std::size_t GetCachedSize() const;
+
+  /** Free the released buffers kept */
+  void Clear();
+
+private:
+  ImageBufferPool();
+  ~ImageBufferPool() = default;
+  ImageBufferPool(const ImageBufferPool&) = delete;
+  void operator=(const ImageBufferPool&) = delete;
+
+  void* Allocate(std::size_t bytes) const;
+  void Free(void* buffer) const;
+
+  /** Size of all the buffers of the pool, in use or not */
+  std::unordered_map<void*, std::size_t> m_Buffers;
+
+  /** Released buffers, by size */
+  std::multimap<std::size_t, void*> m_Released;
+
+  /** Released buffers, by release order, and their release number */
+  std::map<unsigned long, void*>           m_ReleaseOrder;
+  std::unordered_map<void*, unsigned long> m_ReleaseIds;
+
+  unsigned long m_NextReleaseId;
+  std::size_t   m_CachedSize;
+  std::size_t   m_MaximumSize;
+  bool          m_UseHugePages;
+
+  mutable std::mutex m_Mutex;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbImageRegionBlockAlignedSplitter_h
+#define otbImageRegionBlockAlignedSplitter_h
+
+#include "itkRegion.h"
+#include "itkImageRegionSplitter.h"
+#include "itkIndex.h"
+#include "itkSize.h"
+#include "itkFastMutexLock.h"
+
+namespace otb
+{
+
+/** \class ImageRegionBlockAlignedSplitter
+ * \brief Divide a region into pieces made of whole blocks of the input file.
+ *
+ * This splitter uses the BlockSize parameter (typically the tile hint
+ * found in the metadata dictionary of the input image) to derive splits
+ * whose borders fall on block borders: each split is made of an integer
+ * number of blocks (except at the region borders, where splits are
+ * cropped). Blocks are never shared between splits, so that each block
+ * of a compressed file is decoded only once.
+ *
+ * Splits are laid out on a regular grid of blocks. The number of
+ * blocks per split is chosen so that splits are as square as allowed by
+ * the block shape, and small enough to get at least the requested number
+ * of splits. If a single block is larger than the requested split size,
+ * splits are one block wide and the actual number of splits may be lower
+ * than requested.
+ *
+ * Unlike ImageRegionAdaptativeSplitter, blocks are never subdivided.
+ *
+ * If the BlockSize is empty, or if VImageDimension is not 2, the
+ * splitter falls back to the behaviour of
+ * otb::ImageRegionSquareTileSplitter.
+ *
+ * \sa ImageRegionAdaptativeSplitter
+ * \sa BlockAlignedStreamingManager
+ *
+ * \ingroup OTBCommon
+ */
+template <unsigned int VImageDimension>
+class ITK_EXPORT ImageRegionBlockAlignedSplitter : public itk::ImageRegionSplitter<VImageDimension>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageRegionBlockAlignedSplitter           Self;
+  typedef itk::ImageRegionSplitter<VImageDimension> Superclass;
+  typedef itk::SmartPointer<Self>                   Pointer;
+  typedef itk::SmartPointer<const Self>             ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageRegionBlockAlignedSplitter, itk::Object);
+
+  /** Dimension of the image available at compile time. */
+  itkStaticConstMacro(ImageDimension, unsigned int, VImageDimension);
+
+  /** Dimension of the image available at run time. */
+  static unsigned int GetImageDimension()
+  {
+    return VImageDimension;
+  }
+
+  /** Index typedef support. An index is used to access pixel values. */
+  typedef itk::Index<VImageDimension>        IndexType;
+  typedef typename IndexType::IndexValueType IndexValueType;
+
+  /** Size typedef support. A size is used to define region bounds. */
+  typedef itk::Size<VImageDimension>       SizeType;
+  typedef typename SizeType::SizeValueType SizeValueType;
+
+  /** Region typedef support.   */
+  typedef itk::ImageRegion<VImageDimension> RegionType;
+
+  typedef std::vector<RegionType> StreamVectorType;
+
+  /** Set the size of the blocks of the input file */
+  itkSetMacro(BlockSize, SizeType);
+
+  /** Get the size of the blocks of the input file */
+  itkGetConstReferenceMacro(BlockSize, SizeType);
+
+  /**
+   * Calling this method will set the image region and the requested
+   * number of splits, and compute the split map if necessary.
+   */
+  unsigned int GetNumberOfSplits(const RegionType& region, unsigned int requestedNumber) override;
+
+  /** Calling this method will set the image region and compute the
+   * split map if necessary. */
+  RegionType GetSplit(unsigned int i, unsigned int numberOfPieces, const RegionType& region) override;
+
+  /** Get the number of blocks along each dimension in one split, as
+   * computed by the last call to GetNumberOfSplits() */
+  itkGetConstReferenceMacro(BlocksPerSplit, SizeType);
+
+  /** Make the Modified() method update the IsUpToDate flag */
+  void Modified() const override
+  {
+    // Call superclass implementation
+    Superclass::Modified();
+
+    // Invalidate up-to-date
+    m_IsUpToDate = false;
+  }
+
+protected:
+  ImageRegionBlockAlignedSplitter() : m_ImageRegion(), m_RequestedNumberOfSplits(0), m_StreamVector(), m_IsUpToDate(false)
+  {
+    m_BlockSize.Fill(0);
+    m_BlocksPerSplit.Fill(0);
+  }
+
+  ~ImageRegionBlockAlignedSplitter() override
+  {
+  }
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ImageRegionBlockAlignedSplitter(const ImageRegionBlockAlignedSplitter&) = delete;
+  void operator=(const ImageRegionBlockAlignedSplitter&) = delete;
+
+  /** Compute the split map and store it in m_StreamVector */
+  void EstimateSplitMap();
+
+  // This reflects the input image tiling
+  SizeType m_BlockSize;
+
+  // Number of blocks in one split
+  SizeType m_BlocksPerSplit;
+
+  // This contains the ImageRegion that is currently being split
+  RegionType m_ImageRegion;
+
+  // This contains the requested number of splits
+  unsigned int m_RequestedNumberOfSplits;
+
+  // This is a vector of all regions which will be split
+  StreamVectorType m_StreamVector;
+
+  // Is the splitter up-to-date ?
+  mutable bool m_IsUpToDate;
+
+  // Lock to ensure thread-safety
+  itk::SimpleFastMutexLock m_Lock;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbImageRegionBlockAlignedSplitter.hxx"
+#endif
+
+#endif
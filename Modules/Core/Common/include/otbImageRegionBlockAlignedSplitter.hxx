@@ -0,0 +1,162 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbImageRegionBlockAlignedSplitter_hxx
+#define otbImageRegionBlockAlignedSplitter_hxx
+
+#include "otbImageRegionBlockAlignedSplitter.h"
+#include "otbMath.h"
+#include "otbMacro.h"
+
+// Default when no block size available
+#include "otbImageRegionSquareTileSplitter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <unsigned int VImageDimension>
+unsigned int ImageRegionBlockAlignedSplitter<VImageDimension>::GetNumberOfSplits(const RegionType& region, unsigned int requestedNumber)
+{
+  m_Lock.Lock();
+  if (!m_IsUpToDate || region != m_ImageRegion || requestedNumber != m_RequestedNumberOfSplits)
+  {
+    m_ImageRegion             = region;
+    m_RequestedNumberOfSplits = requestedNumber;
+    this->EstimateSplitMap();
+  }
+  m_Lock.Unlock();
+
+  return m_StreamVector.size();
+}
+
+template <unsigned int            VImageDimension>
+itk::ImageRegion<VImageDimension> ImageRegionBlockAlignedSplitter<VImageDimension>::GetSplit(unsigned int i, unsigned int itkNotUsed(numberOfPieces),
+                                                                                             const RegionType& region)
+{
+  m_Lock.Lock();
+  if (!m_IsUpToDate || region != m_ImageRegion)
+  {
+    m_ImageRegion = region;
+    this->EstimateSplitMap();
+  }
+  m_Lock.Unlock();
+
+  return m_StreamVector.at(i);
+}
+
+template <unsigned int VImageDimension>
+void                   ImageRegionBlockAlignedSplitter<VImageDimension>::EstimateSplitMap()
+{
+  m_StreamVector.clear();
+  m_IsUpToDate = true;
+
+  // Handle trivial case
+  if (m_RequestedNumberOfSplits <= 1)
+  {
+    m_StreamVector.push_back(m_ImageRegion);
+    m_BlocksPerSplit.Fill(0);
+    return;
+  }
+
+  // Handle the empty block size case and the case where VImageDimension != 2
+  if (m_BlockSize[0] == 0 || m_BlockSize[1] == 0 || VImageDimension != 2)
+  {
+    // In this case we fallback to the classical tile splitter
+    typename otb::ImageRegionSquareTileSplitter<VImageDimension>::Pointer splitter = otb::ImageRegionSquareTileSplitter<VImageDimension>::New();
+
+    unsigned int nbSplits = splitter->GetNumberOfSplits(m_ImageRegion, m_RequestedNumberOfSplits);
+
+    for (unsigned int i = 0; i < nbSplits; ++i)
+    {
+      m_StreamVector.push_back(splitter->GetSplit(i, m_RequestedNumberOfSplits, m_ImageRegion));
+    }
+    m_BlocksPerSplit.Fill(0);
+    return;
+  }
+
+  // Blocks covered by the region
+  IndexType firstBlock;
+  SizeType  blocksPerDim;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    firstBlock[dim]   = m_ImageRegion.GetIndex()[dim] / static_cast<IndexValueType>(m_BlockSize[dim]);
+    blocksPerDim[dim] = (m_ImageRegion.GetIndex()[dim] + m_ImageRegion.GetSize()[dim] + m_BlockSize[dim] - 1) / m_BlockSize[dim] - firstBlock[dim];
+  }
+
+  // Number of pixels allowed in one split
+  const double targetPixels = static_cast<double>(m_ImageRegion.GetNumberOfPixels()) / m_RequestedNumberOfSplits;
+
+  // Aim at square splits, then use the remaining budget along the other
+  // dimension (this allows full lines of blocks for stripped files)
+  const double side = std::sqrt(targetPixels);
+
+  m_BlocksPerSplit[0] = std::max<SizeValueType>(1, std::min<SizeValueType>(blocksPerDim[0], std::floor(side / m_BlockSize[0])));
+  m_BlocksPerSplit[1] = std::max<SizeValueType>(
+      1, std::min<SizeValueType>(blocksPerDim[1], std::floor(targetPixels / (m_BlocksPerSplit[0] * m_BlockSize[0] * m_BlockSize[1]))));
+  m_BlocksPerSplit[0] = std::max<SizeValueType>(
+      m_BlocksPerSplit[0], std::min<SizeValueType>(blocksPerDim[0], std::floor(targetPixels / (m_BlocksPerSplit[1] * m_BlockSize[1] * m_BlockSize[0]))));
+
+  SizeType splitsPerDim;
+  splitsPerDim[0] = (blocksPerDim[0] + m_BlocksPerSplit[0] - 1) / m_BlocksPerSplit[0];
+  splitsPerDim[1] = (blocksPerDim[1] + m_BlocksPerSplit[1] - 1) / m_BlocksPerSplit[1];
+
+  SizeType splitSize;
+  splitSize[0] = m_BlocksPerSplit[0] * m_BlockSize[0];
+  splitSize[1] = m_BlocksPerSplit[1] * m_BlockSize[1];
+
+  // Fill the split map, line of splits by line of splits
+  for (unsigned int splity = 0; splity < splitsPerDim[1]; ++splity)
+  {
+    for (unsigned int splitx = 0; splitx < splitsPerDim[0]; ++splitx)
+    {
+      IndexType splitIndex;
+      splitIndex[0] = firstBlock[0] * m_BlockSize[0] + splitx * splitSize[0];
+      splitIndex[1] = firstBlock[1] * m_BlockSize[1] + splity * splitSize[1];
+
+      RegionType newSplit(splitIndex, splitSize);
+
+      // Splits on the borders are cropped to the region
+      if (newSplit.Crop(m_ImageRegion))
+      {
+        m_StreamVector.push_back(newSplit);
+      }
+    }
+  }
+}
+
+template <unsigned int VImageDimension>
+void ImageRegionBlockAlignedSplitter<VImageDimension>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "IsUpToDate: " << (m_IsUpToDate ? "true" : "false") << std::endl;
+  os << indent << "ImageRegion: " << m_ImageRegion << std::endl;
+  os << indent << "Block size: " << m_BlockSize << std::endl;
+  os << indent << "Blocks per split: " << m_BlocksPerSplit << std::endl;
+  os << indent << "Requested number of splits: " << m_RequestedNumberOfSplits << std::endl;
+  os << indent << "Actual number of splits: " << m_StreamVector.size() << std::endl;
+}
+
+} // end namespace otb
+
+#endif
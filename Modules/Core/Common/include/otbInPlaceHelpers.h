@@ -0,0 +1,66 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbInPlaceHelpers_h
+#define otbInPlaceHelpers_h
+
+#include "itkDataObject.h"
+
+namespace otb
+{
+
+/**
+ * \brief Tell if a filter may overwrite the buffer of its input image
+ *
+ * This is the case when the image is an intermediate result of the
+ * pipeline only read by this filter:
+ * - it is produced by a filter, and not set by the user,
+ * - it is referenced only by its source and by the filter reading it,
+ *   so that no other filter, nor the user, holds it,
+ * - it owns its buffer and shares it with no other image (e.g. through
+ *   Graft()).
+ *
+ * The filter is expected to release the data of the image after
+ * overwriting it (see itk::InPlaceImageFilter::ReleaseInputs()), so
+ * that its source computes it again when it is requested again.
+ *
+ * \ingroup OTBCommon
+ */
+template <class TImage>
+bool CanOverwriteInput(const TImage* input)
+{
+  if (input == nullptr || input->GetSource().IsNull())
+  {
+    return false;
+  }
+
+  // One reference from its source, one from the filter reading it
+  if (input->GetReferenceCount() > 2)
+  {
+    return false;
+  }
+
+  const auto* container = input->GetPixelContainer();
+  return container != nullptr && container->GetReferenceCount() == 1 && container->GetContainerManageMemory();
+}
+
+} // namespace otb
+
+#endif
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMappedFile_h
+#define otbMappedFile_h
+
+#include <cstddef>
+#include <string>
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+
+/** \class MappedFile
+ * \brief Read-only memory mapping of a whole file
+ *
+ * Raw image formats (BSQ, LUM...) use it to copy the requested regions
+ * straight from the page cache into the output buffer, instead of a
+ * seek and a read into a temporary line per image line. Open() returns
+ * false when the file can not be mapped (unsupported platform, empty
+ * file, address space exhausted...), the caller then falls back to
+ * stream reads.
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT MappedFile
+{
+public:
+  MappedFile();
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+  /** Map the file, unmapping the previous one */
+  bool Open(const std::string& fileName);
+
+  void Close();
+
+  bool IsOpen() const
+  {
+    return m_Data != nullptr;
+  }
+
+  const char* GetData() const
+  {
+    return m_Data;
+  }
+
+  std::size_t GetSize() const
+  {
+    return m_Size;
+  }
+
+  /** Hint that the given bytes are about to be read sequentially. The
+   * kernel starts reading them ahead. */
+  void WillNeed(std::size_t offset, std::size_t length) const;
+
+  /** Copy count components of componentSize bytes from a contiguous
+   * source to a destination whose components are step bytes apart,
+   * swapping their bytes if requested. This is how one band of a line
+   * is interleaved in a pixel buffer. */
+  static void CopyComponents(const char* source, std::size_t count, std::size_t componentSize, char* destination, std::size_t step, bool swapBytes);
+
+private:
+  const char* m_Data;
+  std::size_t m_Size;
+};
+
+} // namespace otb
+
+#endif
@@ -0,0 +1,81 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbNUMAPolicy_h
+#define otbNUMAPolicy_h
+
+#include <cstddef>
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+
+/** \class NUMAPolicy
+ * \brief Place image buffers and ITK threads on NUMA nodes
+ *
+ * ITK splits the requested region of a filter along its slowest
+ * dimension and gives the n-th piece to the n-th thread. On machines
+ * with several NUMA nodes, NUMAPolicy assigns the threads of such a split
+ * to the nodes in order, thread t of n running on node t * nodes / n.
+ *
+ * With the FirstTouch policy, the pages of newly allocated image buffers
+ * are touched by threads following the same split, so that each piece of
+ * the buffer lives on the node of the thread that will process it. The
+ * Pin policy also binds the threads of the filters which call
+ * PinCurrentThread() to their node, so that the operating system can not
+ * move them to a remote one.
+ *
+ * The policy is read from the OTB_NUMA_POLICY environment variable (see
+ * ConfigurationManager::GetNUMAPolicy()). Nothing is done on machines
+ * with a single node or on platforms other than Linux.
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT NUMAPolicy
+{
+public:
+  typedef enum { None, FirstTouch, Pin } ModeType;
+
+  /** Policy in use, decoded once from OTB_NUMA_POLICY */
+  static ModeType GetMode();
+
+  /** Number of NUMA nodes of the machine, 1 if unknown */
+  static unsigned int GetNumberOfNodes();
+
+  /** Bind the calling thread to the node of piece threadId of
+   * nbThreads. Only done with the Pin policy. */
+  static void PinCurrentThread(unsigned int threadId, unsigned int nbThreads);
+
+  /** Touch the pages of a new buffer of nbRows rows of bytesPerRow bytes
+   * from ITK threads, each thread handling the rows a filter split would
+   * give it. The content of the buffer is left undefined. */
+  static void FirstTouchBuffer(void* buffer, std::size_t bytesPerRow, std::size_t nbRows);
+
+private:
+  NUMAPolicy()                  = delete;
+  ~NUMAPolicy()                 = delete;
+  NUMAPolicy(const NUMAPolicy&) = delete;
+  void operator=(const NUMAPolicy&) = delete;
+};
+
+} // namespace otb
+
+#endif
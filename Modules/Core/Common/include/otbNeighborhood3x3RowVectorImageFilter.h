@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbNeighborhood3x3RowVectorImageFilter_h
+#define otbNeighborhood3x3RowVectorImageFilter_h
+
+#include "otbUnaryFunctorNeighborhoodVectorImageFilter.h"
+
+namespace otb
+{
+/** \class Neighborhood3x3RowVectorImageFilter
+ * \brief Base class for 3x3 operators processed on buffered lines of a vector image.
+ *
+ * Instead of walking a neighborhood iterator per pixel, each thread keeps
+ * the three input lines around the current output line in contiguous
+ * double buffers holding all the bands, and subclasses compute a whole
+ * output line at once in ProcessLine(). Borders are replicated exactly
+ * as the itk::ZeroFluxNeumannBoundaryCondition of the superclass, which
+ * is still used if the radius is changed from 1.
+ *
+ * \ingroup OTBCommon
+ */
+template <class TInputImage, class TOutputImage, class TFunction>
+class ITK_EXPORT Neighborhood3x3RowVectorImageFilter : public UnaryFunctorNeighborhoodVectorImageFilter<TInputImage, TOutputImage, TFunction>
+{
+public:
+  /** Standard class typedefs. */
+  typedef Neighborhood3x3RowVectorImageFilter Self;
+  typedef UnaryFunctorNeighborhoodVectorImageFilter<TInputImage, TOutputImage, TFunction> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(Neighborhood3x3RowVectorImageFilter, UnaryFunctorNeighborhoodVectorImageFilter);
+
+  typedef typename Superclass::InputImageType        InputImageType;
+  typedef typename Superclass::InputImageRegionType  InputImageRegionType;
+  typedef typename Superclass::OutputImageType       OutputImageType;
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+protected:
+  Neighborhood3x3RowVectorImageFilter()
+  {
+    typename Superclass::RadiusType radius = {{1, 1}};
+    this->SetRadius(radius);
+  }
+  ~Neighborhood3x3RowVectorImageFilter() override
+  {
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** Compute one output line of length values (pixels times nbComp
+   * interleaved bands) from the lines above, at and below it. Each input
+   * line is padded by one replicated pixel on both sides, so that
+   * offsets -nbComp and length are valid. work points to two scratch
+   * lines with the same padding, the second one starting at
+   * work + length + 2 * nbComp. */
+  virtual void ProcessLine(const double* above, const double* center, const double* below, double* output, double* work, unsigned int length,
+                           unsigned int nbComp) const = 0;
+
+private:
+  Neighborhood3x3RowVectorImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbNeighborhood3x3RowVectorImageFilter.hxx"
+#endif
+
+#endif
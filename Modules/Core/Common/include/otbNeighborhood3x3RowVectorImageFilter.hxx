@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbNeighborhood3x3RowVectorImageFilter_hxx
+#define otbNeighborhood3x3RowVectorImageFilter_hxx
+
+#include "otbNeighborhood3x3RowVectorImageFilter.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage, class TFunction>
+void Neighborhood3x3RowVectorImageFilter<TInputImage, TOutputImage, TFunction>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                     itk::ThreadIdType threadId)
+{
+  if (this->GetRadius()[0] != 1 || this->GetRadius()[1] != 1)
+  {
+    Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+    return;
+  }
+
+  typedef typename InputImageType::InternalPixelType  InputValueType;
+  typedef typename OutputImageType::InternalPixelType OutputValueType;
+  typedef typename InputImageType::IndexType          IndexType;
+  typedef typename IndexType::IndexValueType          IndexValueType;
+
+  const InputImageType* input  = this->GetInput();
+  OutputImageType*      output = this->GetOutput();
+
+  const unsigned int          nbComp   = input->GetNumberOfComponentsPerPixel();
+  const InputImageRegionType& buffered = input->GetBufferedRegion();
+  const IndexValueType        firstX   = buffered.GetIndex()[0];
+  const IndexValueType        lastX    = firstX + static_cast<IndexValueType>(buffered.GetSize()[0]) - 1;
+  const IndexValueType        firstY   = buffered.GetIndex()[1];
+  const IndexValueType        lastY    = firstY + static_cast<IndexValueType>(buffered.GetSize()[1]) - 1;
+
+  const IndexValueType startX = outputRegionForThread.GetIndex()[0];
+  const IndexValueType startY = outputRegionForThread.GetIndex()[1];
+  const unsigned int   width  = outputRegionForThread.GetSize()[0];
+  const unsigned int   height = outputRegionForThread.GetSize()[1];
+  const unsigned int   length = width * nbComp;
+  const unsigned int   padded = length + 2 * nbComp;
+
+  std::vector<double> lines(3 * padded);
+  std::vector<double> work(2 * padded);
+  std::vector<double> result(length);
+
+  // Copy a clamped input line, with one replicated pixel on each side
+  auto load = [&](IndexValueType y, double* dst) {
+    IndexType index;
+    index[1] = std::min(std::max(y, firstY), lastY);
+
+    index[0]                  = std::max(startX - 1, firstX);
+    const InputValueType* src = input->GetBufferPointer() + input->ComputeOffset(index) * nbComp;
+    std::copy(src, src + nbComp, dst);
+
+    index[0] = startX;
+    src      = input->GetBufferPointer() + input->ComputeOffset(index) * nbComp;
+    std::copy(src, src + length, dst + nbComp);
+
+    index[0] = std::min(startX + static_cast<IndexValueType>(width), lastX);
+    src      = input->GetBufferPointer() + input->ComputeOffset(index) * nbComp;
+    std::copy(src, src + nbComp, dst + nbComp + length);
+  };
+
+  double* above  = &lines[0];
+  double* center = &lines[padded];
+  double* below  = &lines[2 * padded];
+  load(startY - 1, above);
+  load(startY, center);
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    load(startY + y + 1, below);
+
+    ProcessLine(above + nbComp, center + nbComp, below + nbComp, &result[0], &work[0] + nbComp, length, nbComp);
+
+    IndexType index;
+    index[0]             = startX;
+    index[1]             = startY + y;
+    OutputValueType* dst = output->GetBufferPointer() + output->ComputeOffset(index) * nbComp;
+    for (unsigned int i = 0; i < length; ++i)
+    {
+      dst[i] = static_cast<OutputValueType>(result[i]);
+    }
+
+    // Rotate the lines
+    std::swap(above, center);
+    std::swap(center, below);
+
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      progress.CompletedPixel();
+    }
+  }
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPipelineTracer_h
+#define otbPipelineTracer_h
+
+#include "itkProcessObject.h"
+
+#include <atomic>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "OTBCommonExport.h"
+
+namespace otb
+{
+/** \class PipelineTracer
+ *  \brief Record the time spent by each process object and dump it as a Chrome trace.
+ *
+ * Tracing is opt-in: it is enabled when a trace file is set, either with
+ * SetTraceFile() or with the OTB_TRACE_FILE environment variable (see
+ * ConfigurationManager::GetTraceFile()).
+ *
+ * Watched process objects record one event per update, that is per
+ * streamed split, with the number of pixels produced, the number of
+ * threads and the CPU time used, from which the thread utilisation
+ * is derived. Other components (e.g. image IOs) can add their own
+ * events with AddEvent().
+ *
+ * The trace can be loaded in chrome://tracing or https://ui.perfetto.dev.
+ *
+ * \ingroup OTBCommon
+ */
+class OTBCommon_EXPORT PipelineTracer
+{
+public:
+  typedef std::chrono::steady_clock     ClockType;
+  typedef ClockType::time_point         TimePointType;
+  typedef std::map<std::string, double> CountersType;
+
+  /** Return the process wide tracer */
+  static PipelineTracer& GetInstance();
+
+  /** Tell if events are recorded */
+  bool IsEnabled() const
+  {
+    return m_Enabled;
+  }
+
+  /** Set the file written by WriteTrace(). An empty name disables tracing */
+  void SetTraceFile(const std::string& filename);
+
+  /** Get the file written by WriteTrace() */
+  std::string GetTraceFile() const;
+
+  /** Record an event of the calling thread */
+  void AddEvent(const std::string& name, const std::string& category, TimePointType begin, TimePointType end, const CountersType& counters = CountersType(),
+                const std::string& detail = "");
+
+  /** Record each update of the process object. Does nothing if tracing is disabled */
+  void Watch(itk::ProcessObject* process);
+
+  /** Watch the process object and all the process objects upstream of it */
+  void WatchPipeline(itk::ProcessObject* process);
+
+  /** Number of recorded events */
+  std::size_t GetNumberOfEvents() const;
+
+  /** Remove all recorded events */
+  void Clear();
+
+  /** Write the recorded events in Chrome trace format. Returns false if the file can not be written */
+  bool WriteTrace(const std::string& filename) const;
+
+  /** Write the recorded events to the trace file */
+  bool WriteTrace() const;
+
+  /** Key of the process object meta data marking watched processes */
+  static const std::string WatchedKey;
+
+private:
+  PipelineTracer();
+  ~PipelineTracer() = default;
+  PipelineTracer(const PipelineTracer&) = delete;
+  void operator=(const PipelineTracer&) = delete;
+
+  struct EventType
+  {
+    std::string  name;
+    std::string  category;
+    std::string  detail;
+    double       begin;
+    double       duration;
+    unsigned int thread;
+    CountersType counters;
+  };
+
+  std::vector<EventType> m_Events;
+
+  std::map<std::thread::id, unsigned int> m_ThreadIds;
+
+  std::string m_TraceFile;
+
+  std::atomic<bool> m_Enabled;
+
+  const TimePointType m_Origin;
+
+  mutable std::mutex m_Mutex;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSummedAreaTable_h
+#define otbSummedAreaTable_h
+
+#include <cstddef>
+#include <vector>
+
+namespace otb
+{
+/** \class SummedAreaTable
+ * \brief Summed-area tables of the first powers of a 2D scalar image.
+ *
+ * Compute() accumulates the powers 1 to VOrder of (pixel - shift) over a
+ * region, where the shift is the pixel at the centre of that region.
+ * The region may exceed the buffered region of the image: missing pixels
+ * are replaced by the nearest buffered one, which matches the
+ * itk::ZeroFluxNeumannBoundaryCondition used by neighborhood filters.
+ *
+ * Accumulation is done in double precision with Kahan compensation along
+ * both axes, so that the sums of any box of the region can then be
+ * retrieved in constant time with GetSums(). Subtracting the central pixel
+ * keeps the magnitudes low and limits cancellation in high order sums;
+ * callers should still keep the region to a tile of moderate size.
+ *
+ * \ingroup OTBCommon
+ */
+template <class TInputImage, unsigned int VOrder>
+class SummedAreaTable
+{
+public:
+  typedef TInputImage                           ImageType;
+  typedef typename ImageType::PixelType         PixelType;
+  typedef typename ImageType::InternalPixelType InternalPixelType;
+  typedef typename ImageType::RegionType        RegionType;
+  typedef typename ImageType::IndexType         IndexType;
+  typedef typename ImageType::SizeType          SizeType;
+  typedef typename IndexType::IndexValueType    IndexValue;
+
+  static_assert(ImageType::ImageDimension == 2, "SummedAreaTable only supports 2D images");
+  static_assert(VOrder > 0, "SummedAreaTable needs at least one power");
+
+  SummedAreaTable() : m_Width(0), m_Height(0), m_Shift(0.)
+  {
+  }
+
+  /** Build the tables over region from the buffered pixels of image.
+   * For multi-component images, only the given band is accumulated. */
+  void Compute(const ImageType* image, const RegionType& region, unsigned int band = 0);
+
+  /** Sums of the powers of (pixel - shift) over the box of the given
+   * radius centred on index. The box must lie inside the region given
+   * to Compute(). */
+  void GetSums(const IndexType& index, const SizeType& radius, double* sums) const
+  {
+    const std::size_t x0 = index[0] - radius[0] - m_Origin[0];
+    const std::size_t y0 = index[1] - radius[1] - m_Origin[1];
+    const std::size_t x1 = x0 + 2 * radius[0] + 1;
+    const std::size_t y1 = y0 + 2 * radius[1] + 1;
+
+    const std::size_t stride = (m_Width + 1) * VOrder;
+    const double*     a      = &m_Table[y0 * stride + x0 * VOrder];
+    const double*     b      = &m_Table[y0 * stride + x1 * VOrder];
+    const double*     c      = &m_Table[y1 * stride + x0 * VOrder];
+    const double*     d      = &m_Table[y1 * stride + x1 * VOrder];
+    for (unsigned int k = 0; k < VOrder; ++k)
+    {
+      sums[k] = (d[k] - b[k]) - (c[k] - a[k]);
+    }
+  }
+
+  /** Value subtracted from each pixel before accumulating its powers */
+  double GetShift() const
+  {
+    return m_Shift;
+  }
+
+private:
+  std::vector<double> m_Table;
+  std::vector<double> m_Compensation;
+  IndexType           m_Origin;
+  std::size_t         m_Width;
+  std::size_t         m_Height;
+  double              m_Shift;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSummedAreaTable.hxx"
+#endif
+
+#endif
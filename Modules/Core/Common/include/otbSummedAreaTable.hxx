@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSummedAreaTable_hxx
+#define otbSummedAreaTable_hxx
+
+#include "otbSummedAreaTable.h"
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TInputImage, unsigned int VOrder>
+void SummedAreaTable<TInputImage, VOrder>::Compute(const ImageType* image, const RegionType& region, unsigned int band)
+{
+  const RegionType& buffered = image->GetBufferedRegion();
+  const IndexType   bufIndex = buffered.GetIndex();
+  const IndexValue  bufWidth = buffered.GetSize()[0];
+  const IndexValue  bufLines = buffered.GetSize()[1];
+  const IndexValue  nbBands  = image->GetNumberOfComponentsPerPixel();
+
+  m_Origin = region.GetIndex();
+  m_Width  = region.GetSize()[0];
+  m_Height = region.GetSize()[1];
+
+  // Column offsets into the buffer, clamped to the buffered region
+  std::vector<IndexValue> columns(m_Width);
+  for (std::size_t x = 0; x < m_Width; ++x)
+  {
+    columns[x] = std::min(std::max<IndexValue>(m_Origin[0] + static_cast<IndexValue>(x) - bufIndex[0], 0), bufWidth - 1) * nbBands;
+  }
+  const InternalPixelType* buffer = image->GetBufferPointer() + band;
+  auto                     line   = [&](std::size_t y) {
+    return buffer + std::min(std::max<IndexValue>(m_Origin[1] + static_cast<IndexValue>(y) - bufIndex[1], 0), bufLines - 1) * bufWidth * nbBands;
+  };
+
+  m_Shift = static_cast<double>(line(m_Height / 2)[columns[m_Width / 2]]);
+
+  const std::size_t stride = (m_Width + 1) * VOrder;
+  m_Table.assign(stride * (m_Height + 1), 0.);
+  m_Compensation.assign(stride, 0.);
+
+  double rowSum[VOrder];
+  double rowComp[VOrder];
+  double power[VOrder];
+
+  for (std::size_t y = 0; y < m_Height; ++y)
+  {
+    const InternalPixelType* pixels   = line(y);
+    const double*            previous = &m_Table[y * stride];
+    double*                  current  = &m_Table[(y + 1) * stride];
+
+    std::fill(rowSum, rowSum + VOrder, 0.);
+    std::fill(rowComp, rowComp + VOrder, 0.);
+
+    for (std::size_t x = 0; x < m_Width; ++x)
+    {
+      const double value = static_cast<double>(pixels[columns[x]]) - m_Shift;
+      power[0]           = value;
+      for (unsigned int k = 1; k < VOrder; ++k)
+      {
+        power[k] = power[k - 1] * value;
+      }
+
+      const std::size_t pos = (x + 1) * VOrder;
+      for (unsigned int k = 0; k < VOrder; ++k)
+      {
+        // Running sum along the line
+        double v   = power[k] - rowComp[k];
+        double t   = rowSum[k] + v;
+        rowComp[k] = (t - rowSum[k]) - v;
+        rowSum[k]  = t;
+
+        // Running sum along the column
+        double& comp     = m_Compensation[pos + k];
+        v                = (rowSum[k] - rowComp[k]) - comp;
+        t                = previous[pos + k] + v;
+        comp             = (t - previous[pos + k]) - v;
+        current[pos + k] = t;
+      }
+    }
+  }
+}
+
+} // end namespace otb
+
+#endif
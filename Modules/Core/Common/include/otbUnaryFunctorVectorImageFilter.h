@@ -32,6 +32,12 @@ namespace otb
  * and the type of the output image.  It is also parameterized by the
  * operation to be applied.  A Functor style is used.
  *
+ * When the input and output image types are the same, the filter
+ * overwrites the buffer of its input instead of allocating a new one
+ * if the pipeline allows it (see CanOverwriteInput()). The input is
+ * then released, so that it is computed again if requested again.
+ * Use InPlaceOff() to always allocate a new output buffer.
+ *
  * \ingroup IntensityImageFilters   Multithreaded
  *
  * \ingroup OTBCommon
@@ -114,11 +120,20 @@ protected:
    */
   void GenerateOutputInformation(void) override;
 
+  /** Graft the input onto the output when it can be overwritten */
+  void AllocateOutputs() override;
+
+  /** Release the input if it has been overwritten */
+  void ReleaseInputs() override;
+
 private:
   UnaryFunctorVectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
   FunctorType m_Functor;
+
+  /** True when the output buffer is the buffer of the input */
+  bool m_OverwritesInput;
 }; // end of class
 
 } // namespace otb
@@ -22,8 +22,10 @@
 #define otbUnaryFunctorVectorImageFilter_hxx
 
 #include "otbUnaryFunctorVectorImageFilter.h"
+#include "otbInPlaceHelpers.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
+#include <type_traits>
 
 namespace otb
 {
@@ -32,10 +34,10 @@ namespace otb
  * Constructor
  */
 template <class TInputImage, class TOutputImage, class TFunction>
-UnaryFunctorVectorImageFilter<TInputImage, TOutputImage, TFunction>::UnaryFunctorVectorImageFilter()
+UnaryFunctorVectorImageFilter<TInputImage, TOutputImage, TFunction>::UnaryFunctorVectorImageFilter() : m_OverwritesInput(false)
 {
   this->SetNumberOfRequiredInputs(1);
-  this->InPlaceOff();
+  this->InPlaceOn();
 }
 
 /**
@@ -49,6 +51,33 @@ void UnaryFunctorVectorImageFilter<TInputImage, TOutputImage, TFunction>::Genera
   this->GetOutput()->SetNumberOfComponentsPerPixel(this->GetInput()->GetNumberOfComponentsPerPixel());
 }
 
+template <class TInputImage, class TOutputImage, class TFunction>
+void UnaryFunctorVectorImageFilter<TInputImage, TOutputImage, TFunction>::AllocateOutputs()
+{
+  m_OverwritesInput = false;
+  if (this->GetInPlace() && std::is_same<TInputImage, TOutputImage>::value && CanOverwriteInput(this->GetInput()))
+  {
+    // Grafts the input when its buffered region is the requested region
+    Superclass::AllocateOutputs();
+    m_OverwritesInput = static_cast<const void*>(this->GetOutput()->GetBufferPointer()) == static_cast<const void*>(this->GetInput()->GetBufferPointer());
+  }
+  else
+  {
+    itk::ImageToImageFilter<TInputImage, TOutputImage>::AllocateOutputs();
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TFunction>
+void UnaryFunctorVectorImageFilter<TInputImage, TOutputImage, TFunction>::ReleaseInputs()
+{
+  itk::ImageToImageFilter<TInputImage, TOutputImage>::ReleaseInputs();
+  if (m_OverwritesInput)
+  {
+    const_cast<InputImageType*>(this->GetInput())->ReleaseData();
+    m_OverwritesInput = false;
+  }
+}
+
 /**
  * ThreadedGenerateData Performs the neighborhood-wise operation
  */
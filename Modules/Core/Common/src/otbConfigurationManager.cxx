@@ -32,6 +32,7 @@
 
 #include <cstdlib>
 #include <algorithm>
+#include <stdexcept>
 #include <string>
 
 namespace otb
@@ -65,6 +66,24 @@ ConfigurationManager::RAMValueType ConfigurationManager::GetMaxRAMHint()
   }
 }
 
+unsigned int ConfigurationManager::GetMaxOpenDatasets()
+{
+  std::string svalue;
+  if (itksys::SystemTools::GetEnv("OTB_MAX_OPEN_DATASETS", svalue))
+  {
+    try
+    {
+      return std::stoul(svalue);
+    }
+    catch (const std::exception&)
+    {
+      otbLogMacro(Warning, << "Unknown value for OTB_MAX_OPEN_DATASETS (set to: " << svalue << "). Using default value 512.");
+    }
+  }
+  // Default value, below the usual limit of 1024 open files per process
+  return 512;
+}
+
 itk::LoggerBase::PriorityLevelType ConfigurationManager::GetLoggerLevel()
 {
   std::string svalue;
@@ -105,6 +124,56 @@ itk::LoggerBase::PriorityLevelType ConfigurationManager::GetLoggerLevel()
   return level;
 }
 
+std::string ConfigurationManager::GetTraceFile()
+{
+  std::string svalue;
+  itksys::SystemTools::GetEnv("OTB_TRACE_FILE", svalue);
+  return svalue;
+}
+
+std::string ConfigurationManager::GetNUMAPolicy()
+{
+  std::string svalue;
+  itksys::SystemTools::GetEnv("OTB_NUMA_POLICY", svalue);
+  return svalue;
+}
+
+ConfigurationManager::RAMValueType ConfigurationManager::GetBufferPoolSize()
+{
+  std::string svalue;
+  if (itksys::SystemTools::GetEnv("OTB_BUFFER_POOL_SIZE", svalue))
+  {
+    try
+    {
+      return std::stoul(svalue);
+    }
+    catch (const std::exception&)
+    {
+      otbLogMacro(Warning, << "Unknown value for OTB_BUFFER_POOL_SIZE (set to: " << svalue << "). Buffers are not recycled.");
+    }
+  }
+  // Default value
+  return 0;
+}
+
+bool ConfigurationManager::GetUseHugePages()
+{
+  std::string svalue;
+  if (itksys::SystemTools::GetEnv("OTB_HUGE_PAGES", svalue))
+  {
+    svalue = itksys::SystemTools::UpperCase(svalue);
+    return svalue == "ON" || svalue == "TRUE" || svalue == "YES" || svalue == "1";
+  }
+  return false;
+}
+
+std::string ConfigurationManager::GetMPISplitScheduling()
+{
+  std::string svalue;
+  itksys::SystemTools::GetEnv("OTB_MPI_SPLIT_SCHEDULING", svalue);
+  return svalue;
+}
+
 int ConfigurationManager::InitOpenMPThreads()
 {
   int ret = 1;
@@ -114,4 +183,29 @@ int ConfigurationManager::InitOpenMPThreads()
 #endif
   return ret;
 }
+
+namespace
+{
+// Budget of the calling thread, 0 outside of any ThreadBudgetScope
+thread_local int threadBudget = 0;
+}
+
+int ConfigurationManager::GetAvailableThreads()
+{
+  if (threadBudget > 0)
+  {
+    return threadBudget;
+  }
+  return std::max(1, static_cast<int>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads()));
+}
+
+ConfigurationManager::ThreadBudgetScope::ThreadBudgetScope(int nbWorkers, int budget) : m_PreviousBudget(threadBudget)
+{
+  threadBudget = std::max(1, budget / std::max(1, nbWorkers));
+}
+
+ConfigurationManager::ThreadBudgetScope::~ThreadBudgetScope()
+{
+  threadBudget = m_PreviousBudget;
+}
 }
@@ -0,0 +1,222 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageBufferPool.h"
+#include "otbConfigurationManager.h"
+
+#ifdef _WIN32
+#include <malloc.h>
+#else
+#include <stdlib.h>
+#endif
+
+#ifdef __linux__
+#include <sys/mman.h>
+#endif
+
+namespace otb
+{
+
+namespace
+{
+// Alignment of the buffers, suitable for SIMD instructions
+const std::size_t BufferAlignment = 64;
+
+// Size of the transparent huge pages of x86-64 and aarch64
+const std::size_t HugePageSize = 2 * 1024 * 1024;
+}
+
+ImageBufferPool& ImageBufferPool::GetInstance()
+{
+  // Never destroyed: images may release their buffers at exit, after
+  // static objects are destroyed
+  static ImageBufferPool* s_instance = new ImageBufferPool;
+  return *s_instance;
+}
+
+ImageBufferPool::ImageBufferPool()
+  : m_NextReleaseId(0),
+    m_CachedSize(0),
+    m_MaximumSize(static_cast<std::size_t>(ConfigurationManager::GetBufferPoolSize()) * 1024 * 1024),
+    m_UseHugePages(ConfigurationManager::GetUseHugePages())
+{
+}
+
+bool ImageBufferPool::IsEnabled() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumSize > 0;
+}
+
+void ImageBufferPool::SetMaximumSize(std::size_t bytes)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    m_MaximumSize = bytes;
+  }
+  if (bytes == 0)
+  {
+    Clear();
+  }
+}
+
+std::size_t ImageBufferPool::GetMaximumSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumSize;
+}
+
+void ImageBufferPool::SetUseHugePages(bool use)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_UseHugePages = use;
+}
+
+bool ImageBufferPool::GetUseHugePages() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_UseHugePages;
+}
+
+void* ImageBufferPool::Acquire(std::size_t bytes)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  // Recycle a released buffer of the same size
+  auto released = m_Released.find(bytes);
+  if (released != m_Released.end())
+  {
+    void* buffer = released->second;
+    m_Released.erase(released);
+    m_ReleaseOrder.erase(m_ReleaseIds[buffer]);
+    m_ReleaseIds.erase(buffer);
+    m_CachedSize -= bytes;
+    return buffer;
+  }
+
+  void* buffer = Allocate(bytes);
+  if (buffer != nullptr)
+  {
+    m_Buffers[buffer] = bytes;
+  }
+  return buffer;
+}
+
+bool ImageBufferPool::Release(void* buffer)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  auto it = m_Buffers.find(buffer);
+  if (it == m_Buffers.end() || m_ReleaseIds.count(buffer) != 0)
+  {
+    return false;
+  }
+  const std::size_t bytes = it->second;
+
+  if (bytes > m_MaximumSize)
+  {
+    m_Buffers.erase(it);
+    Free(buffer);
+    return true;
+  }
+
+  // Free the least recently released buffers to make room
+  while (m_CachedSize + bytes > m_MaximumSize)
+  {
+    void*             oldest     = m_ReleaseOrder.begin()->second;
+    const std::size_t oldestSize = m_Buffers[oldest];
+    auto              range      = m_Released.equal_range(oldestSize);
+    for (auto r = range.first; r != range.second; ++r)
+    {
+      if (r->second == oldest)
+      {
+        m_Released.erase(r);
+        break;
+      }
+    }
+    m_ReleaseOrder.erase(m_ReleaseOrder.begin());
+    m_ReleaseIds.erase(oldest);
+    m_Buffers.erase(oldest);
+    m_CachedSize -= oldestSize;
+    Free(oldest);
+  }
+
+  m_Released.emplace(bytes, buffer);
+  m_ReleaseOrder[m_NextReleaseId] = buffer;
+  m_ReleaseIds[buffer]            = m_NextReleaseId++;
+  m_CachedSize += bytes;
+  return true;
+}
+
+std::size_t ImageBufferPool::GetCachedSize() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_CachedSize;
+}
+
+void ImageBufferPool::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (const auto& released : m_Released)
+  {
+    m_Buffers.erase(released.second);
+    Free(released.second);
+  }
+  m_Released.clear();
+  m_ReleaseOrder.clear();
+  m_ReleaseIds.clear();
+  m_CachedSize = 0;
+}
+
+void* ImageBufferPool::Allocate(std::size_t bytes) const
+{
+  const bool        hugePages = m_UseHugePages && bytes >= HugePageSize;
+  const std::size_t alignment = hugePages ? HugePageSize : BufferAlignment;
+
+  void* buffer = nullptr;
+#ifdef _WIN32
+  buffer = _aligned_malloc(bytes, alignment);
+#else
+  if (posix_memalign(&buffer, alignment, bytes) != 0)
+  {
+    return nullptr;
+  }
+#endif
+
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  if (hugePages)
+  {
+    // Only a hint: ignored if transparent huge pages are disabled
+    madvise(buffer, bytes - bytes % HugePageSize, MADV_HUGEPAGE);
+  }
+#endif
+  return buffer;
+}
+
+void ImageBufferPool::Free(void* buffer) const
+{
+#ifdef _WIN32
+  _aligned_free(buffer);
+#else
+  free(buffer);
+#endif
+}
+
+} // end namespace otb
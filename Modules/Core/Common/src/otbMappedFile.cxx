@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMappedFile.h"
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstring>
+
+namespace otb
+{
+
+namespace
+{
+// With the size known at compile time, the copy and the reversal of the
+// bytes compile to plain loads, byte swaps and stores, which the
+// compiler vectorizes when the destination is contiguous
+template <std::size_t N>
+void CopyComponents(const char* source, std::size_t count, char* destination, std::size_t step, bool swapBytes)
+{
+  for (std::size_t i = 0; i < count; ++i, source += N, destination += step)
+  {
+    char component[N];
+    std::memcpy(component, source, N);
+    if (swapBytes)
+    {
+      std::reverse(component, component + N);
+    }
+    std::memcpy(destination, component, N);
+  }
+}
+}
+
+MappedFile::MappedFile() : m_Data(nullptr), m_Size(0)
+{
+}
+
+MappedFile::~MappedFile()
+{
+  Close();
+}
+
+bool MappedFile::Open(const std::string& fileName)
+{
+  Close();
+#ifndef _WIN32
+  const int fd = open(fileName.c_str(), O_RDONLY);
+  if (fd < 0)
+  {
+    return false;
+  }
+  struct stat status;
+  if (fstat(fd, &status) == 0 && status.st_size > 0)
+  {
+    void* data = mmap(nullptr, status.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    if (data != MAP_FAILED)
+    {
+      m_Data = static_cast<const char*>(data);
+      m_Size = status.st_size;
+    }
+  }
+  // The mapping stays valid once the descriptor is closed
+  close(fd);
+#else
+  (void)fileName;
+#endif
+  return IsOpen();
+}
+
+void MappedFile::Close()
+{
+#ifndef _WIN32
+  if (m_Data != nullptr)
+  {
+    munmap(const_cast<char*>(m_Data), m_Size);
+  }
+#endif
+  m_Data = nullptr;
+  m_Size = 0;
+}
+
+void MappedFile::WillNeed(std::size_t offset, std::size_t length) const
+{
+#ifndef _WIN32
+  if (m_Data == nullptr || offset >= m_Size)
+  {
+    return;
+  }
+  // madvise() wants a page aligned address
+  const std::size_t pageSize = sysconf(_SC_PAGESIZE);
+  const std::size_t begin    = offset - offset % pageSize;
+  const std::size_t end      = std::min(offset + length, m_Size);
+  madvise(const_cast<char*>(m_Data) + begin, end - begin, MADV_WILLNEED);
+#else
+  (void)offset;
+  (void)length;
+#endif
+}
+
+void MappedFile::CopyComponents(const char* source, std::size_t count, std::size_t componentSize, char* destination, std::size_t step, bool swapBytes)
+{
+  if (componentSize == step && (componentSize == 1 || !swapBytes))
+  {
+    std::memcpy(destination, source, count * componentSize);
+    return;
+  }
+  switch (componentSize)
+  {
+  case 1:
+    otb::CopyComponents<1>(source, count, destination, step, false);
+    break;
+  case 2:
+    otb::CopyComponents<2>(source, count, destination, step, swapBytes);
+    break;
+  case 4:
+    otb::CopyComponents<4>(source, count, destination, step, swapBytes);
+    break;
+  case 8:
+    otb::CopyComponents<8>(source, count, destination, step, swapBytes);
+    break;
+  default:
+    for (std::size_t i = 0; i < count; ++i, source += componentSize, destination += step)
+    {
+      std::memcpy(destination, source, componentSize);
+      if (swapBytes)
+      {
+        std::reverse(destination, destination + componentSize);
+      }
+    }
+  }
+}
+
+} // namespace otb
@@ -0,0 +1,236 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbNUMAPolicy.h"
+#include "otbConfigurationManager.h"
+#include "otbMacro.h"
+
+#include "itkMultiThreader.h"
+#include "itksys/SystemTools.hxx"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+namespace
+{
+
+typedef std::vector<std::vector<int>> NodeCPUsType;
+
+// CPUs of each NUMA node, as listed by the kernel ("0-23,48-71")
+NodeCPUsType ReadNodeCPUs()
+{
+  NodeCPUsType nodes;
+#ifdef __linux__
+  for (unsigned int node = 0;; ++node)
+  {
+    std::ifstream file("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+    if (!file)
+    {
+      break;
+    }
+    std::vector<int> cpus;
+    std::string      range;
+    while (std::getline(file, range, ','))
+    {
+      if (range.find_first_of("0123456789") == std::string::npos)
+      {
+        continue;
+      }
+      const auto dash  = range.find('-');
+      const int  first = std::stoi(range.substr(0, dash));
+      const int  last  = dash == std::string::npos ? first : std::stoi(range.substr(dash + 1));
+      for (int cpu = first; cpu <= last; ++cpu)
+      {
+        cpus.push_back(cpu);
+      }
+    }
+    nodes.push_back(cpus);
+  }
+#endif
+  return nodes;
+}
+
+const NodeCPUsType& GetNodeCPUs()
+{
+  static const NodeCPUsType nodes = ReadNodeCPUs();
+  return nodes;
+}
+
+unsigned int GetNodeOfPiece(unsigned int threadId, unsigned int nbThreads)
+{
+  const std::size_t nbNodes = GetNodeCPUs().size();
+  return static_cast<unsigned int>(std::min<std::size_t>(threadId * nbNodes / std::max(1u, nbThreads), nbNodes - 1));
+}
+
+#ifdef __linux__
+// Bind the calling thread to the CPUs of a node, and optionally return
+// its previous affinity
+bool BindCurrentThread(unsigned int node, cpu_set_t* previous = nullptr)
+{
+  if (previous != nullptr && pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), previous) != 0)
+  {
+    return false;
+  }
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (int cpu : GetNodeCPUs()[node])
+  {
+    CPU_SET(cpu, &set);
+  }
+  return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+}
+#endif
+
+struct FirstTouchStruct
+{
+  char*       Buffer;
+  std::size_t BytesPerRow;
+  std::size_t NbRows;
+  std::size_t RowsPerPiece;
+  std::size_t PageSize;
+};
+
+ITK_THREAD_RETURN_TYPE FirstTouchCallback(void* arg)
+{
+  itk::MultiThreader::ThreadInfoStruct* info = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+  FirstTouchStruct*                     str  = static_cast<FirstTouchStruct*>(info->UserData);
+
+  const std::size_t firstRow = info->ThreadID * str->RowsPerPiece;
+  if (firstRow >= str->NbRows)
+  {
+    return ITK_THREAD_RETURN_VALUE;
+  }
+  const std::size_t begin = firstRow * str->BytesPerRow;
+  const std::size_t end   = std::min(firstRow + str->RowsPerPiece, str->NbRows) * str->BytesPerRow;
+
+#ifdef __linux__
+  // The touching thread must run on the node of its piece, even when the
+  // threads are not pinned afterwards. With the Pin policy it stays there.
+  const bool pin = NUMAPolicy::GetMode() == NUMAPolicy::Pin;
+  cpu_set_t  previous;
+  const bool restore = BindCurrentThread(GetNodeOfPiece(info->ThreadID, info->NumberOfThreads), pin ? nullptr : &previous) && !pin;
+#endif
+
+  // One write per page is enough for the kernel to allocate it locally
+  volatile char* buffer = str->Buffer;
+  for (std::size_t offset = begin; offset < end; offset += str->PageSize)
+  {
+    buffer[offset] = 0;
+  }
+
+#ifdef __linux__
+  if (restore)
+  {
+    pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &previous);
+  }
+#endif
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+} // end anonymous namespace
+
+NUMAPolicy::ModeType NUMAPolicy::GetMode()
+{
+  static const ModeType mode = [] {
+    const std::string policy = itksys::SystemTools::LowerCase(ConfigurationManager::GetNUMAPolicy());
+    if (policy.empty() || policy == "none")
+    {
+      return None;
+    }
+    else if (policy == "firsttouch")
+    {
+      return FirstTouch;
+    }
+    else if (policy == "pin")
+    {
+      return Pin;
+    }
+    otbLogMacro(Warning, << "Unknown value for OTB_NUMA_POLICY (set to: " << policy << "). Possible values are none, firsttouch and pin. "
+                         << "Policy set to none.");
+    return None;
+  }();
+  return mode;
+}
+
+unsigned int NUMAPolicy::GetNumberOfNodes()
+{
+  return static_cast<unsigned int>(std::max<std::size_t>(1, GetNodeCPUs().size()));
+}
+
+void NUMAPolicy::PinCurrentThread(unsigned int threadId, unsigned int nbThreads)
+{
+#ifdef __linux__
+  if (GetMode() == Pin && GetNumberOfNodes() > 1)
+  {
+    BindCurrentThread(GetNodeOfPiece(threadId, nbThreads));
+  }
+#else
+  (void)threadId;
+  (void)nbThreads;
+#endif
+}
+
+void NUMAPolicy::FirstTouchBuffer(void* buffer, std::size_t bytesPerRow, std::size_t nbRows)
+{
+#ifdef __linux__
+  if (GetMode() == None || GetNumberOfNodes() < 2 || buffer == nullptr || nbRows == 0)
+  {
+    return;
+  }
+
+  const unsigned int nbThreads = std::max(1, static_cast<int>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads()));
+
+  FirstTouchStruct str;
+  str.Buffer      = static_cast<char*>(buffer);
+  str.BytesPerRow = bytesPerRow;
+  str.NbRows      = nbRows;
+  str.PageSize    = static_cast<std::size_t>(sysconf(_SC_PAGESIZE));
+  // Same pieces as itk::ImageRegionSplitterSlowDimension
+  str.RowsPerPiece = (nbRows + nbThreads - 1) / nbThreads;
+
+  // Small buffers are not worth spawning threads
+  if (bytesPerRow * nbRows < nbThreads * str.PageSize)
+  {
+    return;
+  }
+
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(nbThreads);
+  threader->SetSingleMethod(FirstTouchCallback, &str);
+  threader->SingleMethodExecute();
+#else
+  (void)buffer;
+  (void)bytesPerRow;
+  (void)nbRows;
+#endif
+}
+
+} // namespace otb
@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbPipelineTracer.h"
+#include "otbConfigurationManager.h"
+
+#include "itkCommand.h"
+#include "itkImageBase.h"
+#include "itkMetaDataObject.h"
+
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <stack>
+
+namespace otb
+{
+
+namespace
+{
+/** Record one event for each update of the observed process object */
+class TraceCommand : public itk::Command
+{
+public:
+  typedef TraceCommand            Self;
+  typedef itk::Command            Superclass;
+  typedef itk::SmartPointer<Self> Pointer;
+
+  itkNewMacro(Self);
+
+  void Execute(const itk::Object* caller, const itk::EventObject& event) override
+  {
+    this->Execute(const_cast<itk::Object*>(caller), event);
+  }
+
+  void Execute(itk::Object* caller, const itk::EventObject& event) override
+  {
+    itk::ProcessObject* process = dynamic_cast<itk::ProcessObject*>(caller);
+    if (process == nullptr)
+    {
+      return;
+    }
+
+    if (itk::StartEvent().CheckEvent(&event))
+    {
+      m_Begin    = PipelineTracer::ClockType::now();
+      m_CPUBegin = std::clock();
+    }
+    else if (itk::EndEvent().CheckEvent(&event))
+    {
+      const PipelineTracer::TimePointType end  = PipelineTracer::ClockType::now();
+      const double                        cpu  = 1000. * static_cast<double>(std::clock() - m_CPUBegin) / CLOCKS_PER_SEC;
+      const double                        wall = std::chrono::duration<double, std::milli>(end - m_Begin).count();
+
+      PipelineTracer::CountersType counters;
+      double                       pixels = 0.;
+      for (auto& output : process->GetOutputs())
+      {
+        itk::ImageBase<2>* image = dynamic_cast<itk::ImageBase<2>*>(output.GetPointer());
+        if (image)
+        {
+          pixels += image->GetRequestedRegion().GetNumberOfPixels();
+        }
+      }
+      counters["pixels"]  = pixels;
+      counters["threads"] = process->GetNumberOfThreads();
+      counters["cpu_ms"]  = cpu;
+      // Share of the available threads kept busy during the update
+      counters["thread_utilisation"] = (wall > 0. && process->GetNumberOfThreads() > 0) ? cpu / (wall * process->GetNumberOfThreads()) : 0.;
+
+      PipelineTracer::GetInstance().AddEvent(process->GetNameOfClass(), "filter", m_Begin, end, counters, process->GetObjectName());
+    }
+  }
+
+protected:
+  TraceCommand() : m_Begin(PipelineTracer::ClockType::now()), m_CPUBegin(0)
+  {
+  }
+
+private:
+  PipelineTracer::TimePointType m_Begin;
+
+  std::clock_t m_CPUBegin;
+};
+
+/** Escape a string for JSON output */
+std::string JSONEscape(const std::string& str)
+{
+  std::ostringstream oss;
+  for (char c : str)
+  {
+    switch (c)
+    {
+    case '"':
+      oss << "\\\"";
+      break;
+    case '\\':
+      oss << "\\\\";
+      break;
+    case '\n':
+      oss << "\\n";
+      break;
+    case '\t':
+      oss << "\\t";
+      break;
+    default:
+      if (static_cast<unsigned char>(c) < 0x20)
+      {
+        oss << "\\u" << std::hex << std::setw(4) << std::setfill('0') << static_cast<int>(c) << std::dec;
+      }
+      else
+      {
+        oss << c;
+      }
+    }
+  }
+  return oss.str();
+}
+}
+
+const std::string PipelineTracer::WatchedKey = "PipelineTracerWatched";
+
+PipelineTracer& PipelineTracer::GetInstance()
+{
+  static PipelineTracer s_instance;
+  return s_instance;
+}
+
+PipelineTracer::PipelineTracer() : m_TraceFile(ConfigurationManager::GetTraceFile()), m_Enabled(!m_TraceFile.empty()), m_Origin(ClockType::now())
+{
+}
+
+void PipelineTracer::SetTraceFile(const std::string& filename)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_TraceFile = filename;
+  m_Enabled   = !filename.empty();
+}
+
+std::string PipelineTracer::GetTraceFile() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_TraceFile;
+}
+
+void PipelineTracer::AddEvent(const std::string& name, const std::string& category, TimePointType begin, TimePointType end, const CountersType& counters,
+                              const std::string& detail)
+{
+  if (!m_Enabled)
+  {
+    return;
+  }
+
+  EventType event;
+  event.name     = name;
+  event.category = category;
+  event.detail   = detail;
+  event.begin    = std::chrono::duration<double, std::micro>(begin - m_Origin).count();
+  event.duration = std::chrono::duration<double, std::micro>(end - begin).count();
+  event.counters = counters;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  auto thread  = m_ThreadIds.emplace(std::this_thread::get_id(), static_cast<unsigned int>(m_ThreadIds.size())).first;
+  event.thread = thread->second;
+  m_Events.push_back(std::move(event));
+}
+
+void PipelineTracer::Watch(itk::ProcessObject* process)
+{
+  if (!m_Enabled || process == nullptr)
+  {
+    return;
+  }
+
+  // The mark is stored in the process object itself, so that it goes away with it
+  bool watched = false;
+  itk::ExposeMetaData<bool>(process->GetMetaDataDictionary(), WatchedKey, watched);
+  if (watched)
+  {
+    return;
+  }
+  itk::EncapsulateMetaData<bool>(process->GetMetaDataDictionary(), WatchedKey, true);
+
+  TraceCommand::Pointer command = TraceCommand::New();
+  process->AddObserver(itk::StartEvent(), command);
+  process->AddObserver(itk::EndEvent(), command);
+}
+
+void PipelineTracer::WatchPipeline(itk::ProcessObject* process)
+{
+  std::set<itk::ProcessObject*>   visited;
+  std::stack<itk::ProcessObject*> processStack;
+  processStack.push(process);
+  while (!processStack.empty())
+  {
+    itk::ProcessObject* current = processStack.top();
+    processStack.pop();
+    if (current == nullptr || !visited.insert(current).second)
+    {
+      continue;
+    }
+    this->Watch(current);
+    for (auto& input : current->GetInputs())
+    {
+      if (input.GetPointer())
+      {
+        processStack.push(input->GetSource().GetPointer());
+      }
+    }
+  }
+}
+
+std::size_t PipelineTracer::GetNumberOfEvents() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Events.size();
+}
+
+void PipelineTracer::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Events.clear();
+}
+
+bool PipelineTracer::WriteTrace() const
+{
+  return this->WriteTrace(this->GetTraceFile());
+}
+
+bool PipelineTracer::WriteTrace(const std::string& filename) const
+{
+  if (filename.empty())
+  {
+    return false;
+  }
+  std::ofstream ofs(filename.c_str());
+  if (!ofs)
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  ofs << std::fixed << std::setprecision(3);
+  ofs << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+  for (std::size_t i = 0; i < m_Events.size(); ++i)
+  {
+    const EventType& event = m_Events[i];
+    ofs << (i == 0 ? "\n" : ",\n");
+    ofs << "{\"name\":\"" << JSONEscape(event.name) << "\",\"cat\":\"" << JSONEscape(event.category) << "\",\"ph\":\"X\",\"ts\":" << event.begin
+        << ",\"dur\":" << event.duration << ",\"pid\":1,\"tid\":" << event.thread << ",\"args\":{";
+    bool first = true;
+    if (!event.detail.empty())
+    {
+      ofs << "\"detail\":\"" << JSONEscape(event.detail) << "\"";
+      first = false;
+    }
+    for (const auto& counter : event.counters)
+    {
+      ofs << (first ? "" : ",") << "\"" << JSONEscape(counter.first) << "\":" << counter.second;
+      first = false;
+    }
+    ofs << "}}";
+  }
+  ofs << "\n]}\n";
+  return static_cast<bool>(ofs);
+}
+
+} // end namespace otb
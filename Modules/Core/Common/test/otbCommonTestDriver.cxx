@@ -24,6 +24,7 @@ void RegisterTests()
 {
   REGISTER_TEST(otbImageRegionTileMapSplitter);
   REGISTER_TEST(otbImageRegionAdaptativeSplitter);
+  REGISTER_TEST(otbImageRegionBlockAlignedSplitter);
   REGISTER_TEST(otbRGBAPixelConverter);
   REGISTER_TEST(otbRectangle);
   REGISTER_TEST(otbSystemTest);
@@ -36,4 +37,6 @@ void RegisterTests()
   REGISTER_TEST(otbStandardFilterWatcherNew);
   REGISTER_TEST(otbStandardOneLineFilterWatcherTest);
   REGISTER_TEST(otbStandardWriterWatcher);
+  REGISTER_TEST(otbPipelineTracerTest);
+  REGISTER_TEST(otbImageBufferPoolTest);
 }
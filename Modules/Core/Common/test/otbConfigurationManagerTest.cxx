@@ -68,6 +68,30 @@ int otbConfigurationManagerTest(int argc, char* argv[])
     std::cerr << "GetGeoidFile(): Value differs from expected value (" << refGeoidFile << ")" << std::endl;
   }
 
+  // Nested scopes share the budget of the enclosing one
+  const int budget = otb::ConfigurationManager::GetAvailableThreads();
+  {
+    otb::ConfigurationManager::ThreadBudgetScope outer(2, 8);
+    {
+      otb::ConfigurationManager::ThreadBudgetScope inner(8);
+      if (otb::ConfigurationManager::GetAvailableThreads() != 1)
+      {
+        failed = true;
+        std::cerr << "GetAvailableThreads(): expected 1 thread in the inner scope, got " << otb::ConfigurationManager::GetAvailableThreads() << std::endl;
+      }
+    }
+    if (otb::ConfigurationManager::GetAvailableThreads() != 4)
+    {
+      failed = true;
+      std::cerr << "GetAvailableThreads(): expected 4 threads in the outer scope, got " << otb::ConfigurationManager::GetAvailableThreads() << std::endl;
+    }
+  }
+  if (otb::ConfigurationManager::GetAvailableThreads() != budget)
+  {
+    failed = true;
+    std::cerr << "GetAvailableThreads(): budget not restored (" << budget << ")" << std::endl;
+  }
+
   if (failed)
     return EXIT_FAILURE;
 
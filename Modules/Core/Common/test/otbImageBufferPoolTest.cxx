@@ -0,0 +1,93 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+
+#include "otbImageBufferPool.h"
+#include "otbImage.h"
+
+int otbImageBufferPoolTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<float, 2> ImageType;
+
+  otb::ImageBufferPool& pool = otb::ImageBufferPool::GetInstance();
+  pool.SetMaximumSize(16 * 1024 * 1024);
+
+  // A released buffer is given back to a request of the same size
+  void* buffer = pool.Acquire(1024);
+  if (buffer == nullptr || !pool.Release(buffer) || pool.GetCachedSize() != 1024)
+  {
+    std::cerr << "Buffer not kept by the pool" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (pool.Acquire(1024) != buffer || pool.GetCachedSize() != 0)
+  {
+    std::cerr << "Released buffer not recycled" << std::endl;
+    return EXIT_FAILURE;
+  }
+  pool.Release(buffer);
+
+  // Foreign and already released buffers are left alone
+  int foreign = 0;
+  if (pool.Release(&foreign) || pool.Release(buffer))
+  {
+    std::cerr << "Release of a buffer not in use succeeded" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The least recently released buffers are freed when the pool is full
+  void* first  = pool.Acquire(10 * 1024 * 1024);
+  void* second = pool.Acquire(10 * 1024 * 1024);
+  pool.Release(first);
+  pool.Release(second);
+  if (pool.GetCachedSize() > pool.GetMaximumSize())
+  {
+    std::cerr << "Pool holds " << pool.GetCachedSize() << " bytes, more than its maximum size" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Successive splits of a streamed image reuse the same buffer
+  ImageType::RegionType region;
+  region.SetSize(0, 256);
+  region.SetSize(1, 64);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  const float* split = image->GetBufferPointer();
+  image->Initialize();
+  image->SetRegions(region);
+  image->Allocate();
+  if (image->GetBufferPointer() != split)
+  {
+    std::cerr << "Image buffer not recycled between splits" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  image = nullptr;
+  pool.Clear();
+  if (pool.GetCachedSize() != 0)
+  {
+    std::cerr << "Pool not empty after Clear()" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  pool.SetMaximumSize(0);
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageRegionBlockAlignedSplitter.h"
+#include <fstream>
+
+const int                                              Dimension = 2;
+typedef otb::ImageRegionBlockAlignedSplitter<Dimension> SplitterType;
+typedef SplitterType::RegionType                       RegionType;
+typedef RegionType::SizeType                           SizeType;
+typedef RegionType::IndexType                          IndexType;
+
+
+int otbImageRegionBlockAlignedSplitter(int itkNotUsed(argc), char* argv[])
+{
+  SizeType     regionSize, blockSize;
+  IndexType    regionIndex;
+  RegionType   region;
+  unsigned int requestedNbSplits;
+
+  regionIndex[0]       = atoi(argv[1]);
+  regionIndex[1]       = atoi(argv[2]);
+  regionSize[0]        = atoi(argv[3]);
+  regionSize[1]        = atoi(argv[4]);
+  blockSize[0]         = atoi(argv[5]);
+  blockSize[1]         = atoi(argv[6]);
+  requestedNbSplits    = atoi(argv[7]);
+  std::string outfname = argv[8];
+
+  std::ofstream outfile(outfname);
+
+  region.SetSize(regionSize);
+  region.SetIndex(regionIndex);
+
+  SplitterType::Pointer splitter = SplitterType::New();
+  splitter->SetBlockSize(blockSize);
+
+  unsigned int            nbSplits = splitter->GetNumberOfSplits(region, requestedNbSplits);
+  std::vector<RegionType> splits;
+
+  outfile << splitter << std::endl;
+  outfile << "Split map: " << std::endl;
+
+  for (unsigned int i = 0; i < nbSplits; ++i)
+  {
+    RegionType tmpRegion = splitter->GetSplit(i, requestedNbSplits, region);
+    splits.push_back(tmpRegion);
+    outfile << "Split " << i << ": " << tmpRegion;
+  }
+
+  outfile.close();
+
+  // Each split must start and end on a block border, unless it touches
+  // the border of the region
+  for (unsigned int k = 0; k < nbSplits; ++k)
+  {
+    for (unsigned int dim = 0; dim < Dimension; ++dim)
+    {
+      long start = splits[k].GetIndex(dim);
+      long end   = start + splits[k].GetSize(dim);
+
+      if (start != regionIndex[dim] && start % blockSize[dim] != 0)
+      {
+        std::cout << "Split " << k << " does not start on a block border" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (end != static_cast<long>(regionIndex[dim] + regionSize[dim]) && end % blockSize[dim] != 0)
+      {
+        std::cout << "Split " << k << " does not end on a block border" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // The split map must cover the region exactly once
+  IndexType tmpIndex;
+  for (unsigned int i = regionIndex[0]; i < (regionIndex[0] + regionSize[0]); ++i)
+  {
+    for (unsigned int j = regionIndex[1]; j < (regionIndex[1] + regionSize[1]); ++j)
+    {
+      tmpIndex[0]        = i;
+      tmpIndex[1]        = j;
+      unsigned int count = 0;
+      for (unsigned int k = 0; k < nbSplits; ++k)
+      {
+        if (splits[k].IsInside(tmpIndex))
+        {
+          count++;
+        }
+      }
+      if (count == 0)
+      {
+        std::cout << "Index [" << i << "," << j << "] is missing in split map" << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (count > 1)
+      {
+        std::cout << "Index [" << i << "," << j << "] occurs more than once in the split map" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
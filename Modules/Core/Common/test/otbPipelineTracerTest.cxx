@@ -0,0 +1,86 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+
+#include "otbImageFileReader.h"
+#include "otbImage.h"
+#include "otbPipelineTracer.h"
+#include "itkGradientMagnitudeImageFilter.h"
+
+#include <fstream>
+#include <sstream>
+
+int otbPipelineTracerTest(int itkNotUsed(argc), char* argv[])
+{
+  typedef otb::Image<unsigned char, 2>                            ImageType;
+  typedef otb::ImageFileReader<ImageType>                         ReaderType;
+  typedef itk::GradientMagnitudeImageFilter<ImageType, ImageType> FilterType;
+
+  otb::PipelineTracer& tracer = otb::PipelineTracer::GetInstance();
+  tracer.SetTraceFile(argv[2]);
+  tracer.Clear();
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  FilterType::Pointer gradient = FilterType::New();
+  gradient->SetInput(reader->GetOutput());
+
+  // Watching twice must not record events twice
+  tracer.WatchPipeline(gradient);
+  tracer.WatchPipeline(gradient);
+  gradient->Update();
+
+  // One event for the reader, one for the gradient, plus the image IO reads
+  if (tracer.GetNumberOfEvents() < 2)
+  {
+    std::cerr << "Expected at least 2 events, got " << tracer.GetNumberOfEvents() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  if (!tracer.WriteTrace())
+  {
+    std::cerr << "Unable to write " << argv[2] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::ifstream      ifs(argv[2]);
+  std::ostringstream content;
+  content << ifs.rdbuf();
+  const std::string trace = content.str();
+  if (trace.find("\"traceEvents\"") == std::string::npos || trace.find("\"name\":\"GradientMagnitudeImageFilter\"") == std::string::npos ||
+      trace.find("\"pixels\":") == std::string::npos)
+  {
+    std::cerr << "Unexpected trace content:" << std::endl << trace << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Disabled tracer records nothing
+  tracer.SetTraceFile("");
+  tracer.Clear();
+  gradient->Modified();
+  gradient->Update();
+  if (tracer.GetNumberOfEvents() != 0)
+  {
+    std::cerr << "Events recorded while tracing is disabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
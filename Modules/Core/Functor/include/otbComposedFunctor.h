@@ -0,0 +1,159 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComposedFunctor_h
+#define otbComposedFunctor_h
+
+#include "otbFunctorImageFilter.h"
+#include <array>
+#include <utility>
+
+namespace otb
+{
+
+namespace Functor
+{
+
+namespace composed_functor_details
+{
+// Number of components of the result of F, from the number of
+// components of its inputs: 1 if F does not provide OutputSize()
+template <class F, size_t N, class = void>
+struct OutputSizeOf
+{
+  static size_t Get(const F&, const std::array<size_t, N>&)
+  {
+    return 1;
+  }
+};
+
+template <class F, size_t N>
+struct OutputSizeOf<F, N, typename functor_filter_details::MakeVoid<decltype(std::declval<const F&>().OutputSize(std::declval<std::array<size_t, N>>()))>::type>
+{
+  static size_t Get(const F& f, const std::array<size_t, N>& inputsNbBands)
+  {
+    return f.OutputSize(inputsNbBands);
+  }
+};
+} // end namespace composed_functor_details
+
+/**
+ * \class ComposedFunctor
+ * \brief Functor applying TOuter to the result of TInner.
+ *
+ * The operator() of ComposedFunctor takes the arguments of the
+ * operator() of TInner, so that a FunctorImageFilter built from a
+ * ComposedFunctor has the inputs of TInner and the output of TOuter.
+ * Both functors are applied pixel by pixel in a single pass, and the
+ * intermediate image is never allocated.
+ *
+ * The operator() of TInner must return its result, and the operator()
+ * of TOuter must take it as its single argument and return its own
+ * result. OutputSize() is provided from those of TInner and TOuter.
+ *
+ * Use Compose() to build it.
+ *
+ * \sa Compose
+ *
+ * \ingroup OTBFunctor
+ */
+template <class TInner, class TOuter, class TInnerOperator = typename RetrieveOperator<TInner>::Type>
+class ComposedFunctor;
+
+template <class TInner, class TOuter, class C, class R, class... T>
+class ComposedFunctor<TInner, TOuter, R (C::*)(T...) const>
+{
+public:
+  ComposedFunctor(const TInner& inner = TInner(), const TOuter& outer = TOuter()) : m_Inner(inner), m_Outer(outer)
+  {
+  }
+
+  auto operator()(T... in) const
+  {
+    return m_Outer(m_Inner(in...));
+  }
+
+  size_t OutputSize(const std::array<size_t, sizeof...(T)>& inputsNbBands) const
+  {
+    const std::array<size_t, 1> innerNbBands = {{composed_functor_details::OutputSizeOf<TInner, sizeof...(T)>::Get(m_Inner, inputsNbBands)}};
+    return composed_functor_details::OutputSizeOf<TOuter, 1>::Get(m_Outer, innerNbBands);
+  }
+
+  const TInner& GetInner() const
+  {
+    return m_Inner;
+  }
+
+  TInner& GetInner()
+  {
+    return m_Inner;
+  }
+
+  const TOuter& GetOuter() const
+  {
+    return m_Outer;
+  }
+
+  TOuter& GetOuter()
+  {
+    return m_Outer;
+  }
+
+private:
+  TInner m_Inner;
+  TOuter m_Outer;
+};
+
+/**
+ * \brief Compose functors, applied from first to last
+ *
+ * Compose(f, g, h) returns a functor computing h(g(f(x...))), to build
+ * a single FunctorImageFilter instead of a chain of filters, one per
+ * functor, each writing a whole intermediate image:
+ *
+ * \code
+ * auto filter = NewFunctorFilter(Functor::Compose(calibration, clamp, rescale));
+ * \endcode
+ *
+ * All functors but the first must take a single argument, and each
+ * must accept the result of the previous one. The operator() of each
+ * functor must be const and return its result.
+ *
+ * \sa ComposedFunctor
+ *
+ * \ingroup OTBFunctor
+ */
+template <class TFirst>
+TFirst Compose(const TFirst& first)
+{
+  return first;
+}
+
+template <class TFirst, class TSecond, class... TOthers>
+auto Compose(const TFirst& first, const TSecond& second, const TOthers&... others)
+{
+  return Compose(ComposedFunctor<TFirst, TSecond>(first, second), others...);
+}
+
+} // end namespace Functor
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFixedPixelFunctorAdaptor_h
+#define otbFixedPixelFunctorAdaptor_h
+
+#include "itkFixedArray.h"
+#include "itkVariableLengthVector.h"
+#include "itkMacro.h"
+#include "otbSpan.h"
+
+namespace otb
+{
+namespace Functor
+{
+
+/** \class FixedPixelFunctorAdaptor
+ * \brief Adapts a functor on FixedArray pixels to VectorImage inputs and
+ * outputs of FunctorImageFilter.
+ *
+ * TFunctor is called as
+ * itk::FixedArray<TOutput, VOutputSize> f(const itk::FixedArray<TInput, VInputSize>&).
+ * The adaptor provides the ProcessLine() method of FunctorImageFilter,
+ * so that f is called on the components of each pixel in place in the
+ * buffers of the VectorImage: no VariableLengthVector is built, and the
+ * per pixel loops of f are unrolled by the compiler.
+ *
+ * The input image must have VInputSize components per pixel. The output
+ * image has VOutputSize components per pixel. Select VInputSize at
+ * runtime with DispatchNumberOfComponents().
+ *
+ * \code
+ * auto filter = NewFunctorFilter(FixedPixelFunctorAdaptor<MyFunctor, float, 4, float, 1>());
+ * \endcode
+ *
+ * \sa FunctorImageFilter
+ * \sa DispatchNumberOfComponents
+ *
+ * \ingroup OTBFunctor
+ */
+template <class TFunctor, class TInput, unsigned int VInputSize, class TOutput, unsigned int VOutputSize>
+class FixedPixelFunctorAdaptor
+{
+public:
+  typedef itk::FixedArray<TInput, VInputSize>   InputPixelType;
+  typedef itk::FixedArray<TOutput, VOutputSize> OutputPixelType;
+
+  // Pixels are read and written in place in the buffers
+  static_assert(sizeof(InputPixelType) == VInputSize * sizeof(TInput), "FixedArray does not have the layout of an array");
+  static_assert(sizeof(OutputPixelType) == VOutputSize * sizeof(TOutput), "FixedArray does not have the layout of an array");
+
+  FixedPixelFunctorAdaptor(const TFunctor& functor = TFunctor()) : m_Functor(functor)
+  {
+  }
+
+  /** Pixel by pixel interface, from which FunctorImageFilter deduces the
+   * VectorImage types of its input and output */
+  void operator()(itk::VariableLengthVector<TOutput>& out, const itk::VariableLengthVector<TInput>& in) const
+  {
+    if (in.GetSize() != VInputSize)
+    {
+      itkGenericExceptionMacro(<< "Pixel has " << in.GetSize() << " components instead of " << VInputSize);
+    }
+    Compute(out.GetDataPointer(), in.GetDataPointer());
+  }
+
+  /** Line by line interface used by FunctorImageFilter */
+  void ProcessLine(otb::Span<TOutput> out, otb::Span<const TInput> in) const
+  {
+    const size_t nbPixels = out.size() / VOutputSize;
+    if (in.size() != nbPixels * VInputSize)
+    {
+      itkGenericExceptionMacro(<< "Input image has " << in.size() / nbPixels << " components per pixel instead of " << VInputSize);
+    }
+    for (size_t i = 0; i < nbPixels; ++i)
+    {
+      Compute(out.data() + i * VOutputSize, in.data() + i * VInputSize);
+    }
+  }
+
+  constexpr size_t OutputSize(...) const
+  {
+    return VOutputSize;
+  }
+
+  const TFunctor& GetFunctor() const
+  {
+    return m_Functor;
+  }
+
+  TFunctor& GetFunctor()
+  {
+    return m_Functor;
+  }
+
+private:
+  void Compute(TOutput* out, const TInput* in) const
+  {
+    *reinterpret_cast<OutputPixelType*>(out) = m_Functor(*reinterpret_cast<const InputPixelType*>(in));
+  }
+
+  TFunctor m_Functor;
+};
+
+} // End namespace Functor
+} // End namespace otb
+
+#endif
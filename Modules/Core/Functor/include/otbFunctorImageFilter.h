@@ -29,8 +29,10 @@
 #include "itkFixedArray.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include <type_traits>
+#include <utility>
 #include "itkConstNeighborhoodIterator.h"
 #include "otbImage.h"
+#include "otbSpan.h"
 
 namespace otb
 {
@@ -266,6 +268,92 @@ struct FunctorFilterSuperclassHelper<void (C::*)(R&, T...), TNameMap>
   using InputHasNeighborhood = typename functor_filter_details::FunctorFilterSuperclassHelperImpl<R, TNameMap, T...>::InputHasNeighborhood;
 };
 
+namespace functor_filter_details
+{
+template <typename... T>
+struct MakeVoid
+{
+  using type = void;
+};
+
+// True if all B are true
+template <bool... B>
+struct AllTrue : std::is_same<std::integer_sequence<bool, true, B...>, std::integer_sequence<bool, B..., true>>::type
+{
+};
+
+template <class T>
+struct IsScalarImage : std::false_type
+{
+};
+
+template <class T>
+struct IsScalarImage<otb::Image<T>> : std::is_scalar<T>::type
+{
+};
+
+// Images whose lines can be handed to ProcessLine as spans of scalars
+template <class T>
+struct IsLineImage : IsScalarImage<T>
+{
+};
+
+template <class T>
+struct IsLineImage<otb::VectorImage<T>> : std::is_scalar<T>::type
+{
+};
+
+template <class F, class TOutputImage, class TInputsTuple, class = void>
+struct HasProcessLineImpl : std::false_type
+{
+};
+
+template <class F, class TOutputImage, class... TInputImages>
+struct HasProcessLineImpl<F, TOutputImage, std::tuple<TInputImages...>,
+                          typename MakeVoid<decltype(std::declval<F&>().ProcessLine(std::declval<otb::Span<typename TOutputImage::InternalPixelType>>(),
+                                                                                    std::declval<otb::Span<const typename TInputImages::InternalPixelType>>()...))>::type>
+  : AllTrue<IsLineImage<TOutputImage>::value, IsLineImage<TInputImages>::value...>
+{
+};
+
+template <class TOutputImage, class TInputsTuple, class TInputHasNeighborhood>
+struct CanRunInPlaceImpl : std::false_type
+{
+};
+
+template <class TOutputImage>
+struct CanRunInPlaceImpl<TOutputImage, std::tuple<TOutputImage>, std::tuple<std::false_type>> : std::true_type
+{
+};
+} // End namespace functor_filter_details
+
+/**
+ * \struct CanRunInPlace
+ * \brief Struct testing if a functor filter may overwrite its input
+ *
+ * ::value maps to true if the filter has a single input, read pixel by
+ * pixel (not through a neighborhood), of the type of its output.
+ */
+template <class TOutputImage, class TInputsTuple, class TInputHasNeighborhood>
+struct CanRunInPlace : functor_filter_details::CanRunInPlaceImpl<TOutputImage, TInputsTuple, TInputHasNeighborhood>::type
+{
+};
+
+/**
+ * \struct HasProcessLine
+ * \brief Struct testing if a functor can process whole lines of pixels
+ *
+ * ::value maps to true if all input and output images are otb::Image
+ * or otb::VectorImage of scalars and F provides a
+ * ProcessLine(otb::Span<Out> out, otb::Span<const In>... in) method
+ * matching their internal pixel types. Each span holds the line with
+ * the components of each pixel interleaved, so that its size is the
+ * number of pixels times the number of components of the image.
+ */
+template <class F, class TOutputImage, class TInputsTuple>
+struct HasProcessLine : functor_filter_details::HasProcessLineImpl<F, TOutputImage, TInputsTuple>::type
+{
+};
 
 /**
  * \brief This helper method builds a fully functional FunctorImageFilter from a functor instance
@@ -310,6 +398,29 @@ auto NewFunctorFilter(Functor f, itk::Size<2> radius = {{0, 0}});
  *
  * All image types will be deduced from the TFunction operator().
  *
+ * If all images are otb::Image or otb::VectorImage of scalars and
+ * TFunction also provides a
+ * ProcessLine(otb::Span<Out> out, otb::Span<const In>... in) method
+ * (see HasProcessLine), the filter calls it once per line of the
+ * output region, with spans pointing directly to the image buffers,
+ * instead of calling operator() once per pixel. This allows the
+ * compiler to vectorise the processing of the line. Both methods are
+ * expected to compute the same values.
+ *
+ * If the filter has a single input of the type of its output, read
+ * pixel by pixel (see CanRunInPlace), it overwrites the buffer of its
+ * input instead of allocating a new one when the pipeline allows it
+ * (see CanOverwriteInput()). The input is then released, so that it is
+ * computed again if requested again. ProcessLine() is then called with
+ * the same buffer as input and output. Use InPlaceOff() to always
+ * allocate a new output buffer.
+ *
+ * With SkipNoDataRegionsOn(), the regions where all the inputs only
+ * hold no-data pixels, as flagged by their sources (see
+ * IsBufferedRegionNoData()), are filled with OutputNoDataValue without
+ * calling the functor, and the output region is flagged as no-data in
+ * turn, so that the downstream filters and the writer skip it too.
+ *
  * \sa VariadicInputsImageFilter
  * \sa NewFunctorFilter
  *
@@ -394,9 +505,30 @@ public:
     return m_Functor;
   }
 
+  /** Allow the filter to overwrite its input (on by default). This has
+   * no effect if the filter can not run in place (see CanRunInPlace). */
+  itkSetMacro(InPlace, bool);
+  itkGetConstMacro(InPlace, bool);
+  itkBooleanMacro(InPlace);
+
+  /** Fill the regions where all the inputs are no-data with
+   * OutputNoDataValue instead of calling the functor (off by default).
+   * Only enable it if the functor computes no-data from no-data inputs.
+   * The bands of the output then get OutputNoDataValue as NoData
+   * metadata. */
+  itkSetMacro(SkipNoDataRegions, bool);
+  itkGetConstMacro(SkipNoDataRegions, bool);
+  itkBooleanMacro(SkipNoDataRegions);
+
+  /** Set/Get the value of the output pixels in skipped regions (0 by
+   * default) */
+  itkSetMacro(OutputNoDataValue, double);
+  itkGetConstMacro(OutputNoDataValue, double);
+
 protected:
   /// Constructor of functor filter, will copy the functor
-  FunctorImageFilter(const FunctorType& f, itk::Size<2> radius) : m_Functor(f), m_Radius(radius){};
+  FunctorImageFilter(const FunctorType& f, itk::Size<2> radius)
+    : m_Functor(f), m_Radius(radius), m_InPlace(true), m_OverwritesInput(false), m_SkipNoDataRegions(false), m_OutputNoDataValue(0.), m_InputsAreNoData(false){};
   FunctorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
   ~FunctorImageFilter()       = default;
@@ -405,9 +537,24 @@ private:
   /// Actual creation of the filter is handled by this free function
   friend auto NewFunctorFilter<TFunction, TNameMap>(TFunction f, itk::Size<2> radius);
 
+  /** Check whether all the inputs are flagged as no-data */
+  void BeforeThreadedGenerateData() override;
+
+  /** Flag the output as no-data if the inputs are */
+  void AfterThreadedGenerateData() override;
+
   /** Overload of ThreadedGenerateData  */
   void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Fill the region with OutputNoDataValue */
+  void FillNoData(const OutputImageRegionType& outputRegionForThread);
+
+  /** Call operator() for each pixel */
+  void ThreadedGenerateDataImpl(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId, std::false_type);
+
+  /** Call ProcessLine() for each line */
+  void ThreadedGenerateDataImpl(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId, std::true_type);
+
   /**
    * Pad the input requested region by radius
    */
@@ -418,12 +565,37 @@ private:
    */
   void GenerateOutputInformation() override;
 
+  /** Graft the input onto the output when it can be overwritten */
+  void AllocateOutputs() override;
+
+  /** Allocate the output */
+  void AllocateOutputsImpl(std::false_type);
+
+  /** Graft the input onto the output, or allocate the output */
+  void AllocateOutputsImpl(std::true_type);
+
+  /** Release the input if it has been overwritten */
+  void ReleaseInputs() override;
+
 
   // The functor member
   FunctorType m_Functor;
 
   // Radius if needed
   itk::Size<2> m_Radius;
+
+  // Allow the filter to overwrite its input
+  bool m_InPlace;
+
+  // True when the output buffer is the buffer of the input
+  bool m_OverwritesInput;
+
+  // Fill the no-data regions, and the value to fill them with
+  bool   m_SkipNoDataRegions;
+  double m_OutputNoDataValue;
+
+  // True when all the inputs of the current update are no-data
+  bool m_InputsAreNoData;
 };
 
 // Actual implementation of NewFunctorFilter free function
@@ -22,11 +22,15 @@
 #define otbFunctorImageFilter_hxx
 
 #include "otbFunctorImageFilter.h"
+#include "otbNUMAPolicy.h"
+#include "otbInPlaceHelpers.h"
+#include "otbNoDataRegion.h"
 #include "itkProgressReporter.h"
 #include "itkConstNeighborhoodIterator.h"
 #include "itkImageRegionConstIterator.h"
 #include "itkImageScanlineIterator.h"
 #include <array>
+#include <initializer_list>
 
 namespace otb
 {
@@ -283,6 +287,58 @@ struct NumberOfOutputComponents<F, otb::VectorImage<T>, N>
   }
 };
 
+// Span over n pixels of the buffer of img, starting at index
+template <class T>
+auto MakeLineSpan(T* img, const itk::Index<2>& index, size_t n)
+{
+  using ValueType           = std::conditional_t<std::is_const<T>::value, const typename T::InternalPixelType, typename T::InternalPixelType>;
+  const size_t nbComponents = img->GetNumberOfComponentsPerPixel();
+  return otb::Span<ValueType>(img->GetBufferPointer() + img->ComputeOffset(index) * nbComponents, n * nbComponents);
+}
+
+// Will be easier to write in c++17 with std::apply and fold expressions
+template <class Oper, class Out, class Tuple, size_t... Is>
+void CallProcessLineImpl(Oper& oper, otb::Span<Out> out, const Tuple& t, const itk::Index<2>& index, size_t n, std::index_sequence<Is...>)
+{
+  oper.ProcessLine(out, MakeLineSpan(std::get<Is>(t), index, n)...);
+}
+
+// Will be easier to write in c++17 with std::apply and fold expressions
+template <class Oper, class Out, typename... Args>
+void CallProcessLine(Oper& oper, otb::Span<Out> out, const std::tuple<Args...>& t, const itk::Index<2>& index, size_t n)
+{
+  CallProcessLineImpl(oper, out, t, index, n, std::make_index_sequence<sizeof...(Args)>{});
+}
+
+// Tell if the buffered regions of all the inputs are flagged as no-data
+template <class Tuple, size_t... Is>
+bool AllInputsAreNoDataImpl(const Tuple& t, std::index_sequence<Is...>)
+{
+  bool allNoData = true;
+  (void)std::initializer_list<int>{(allNoData = allNoData && IsBufferedRegionNoData(std::get<Is>(t)), 0)...};
+  return allNoData;
+}
+
+template <typename... Args>
+bool AllInputsAreNoData(const std::tuple<Args...>& t)
+{
+  return AllInputsAreNoDataImpl(t, std::make_index_sequence<sizeof...(Args)>{});
+}
+
+// Build a pixel with all its components set to value
+template <class T>
+void FillPixel(T& pixel, unsigned int, double value)
+{
+  pixel = static_cast<T>(value);
+}
+
+template <class T>
+void FillPixel(itk::VariableLengthVector<T>& pixel, unsigned int nbComponents, double value)
+{
+  pixel.SetSize(nbComponents);
+  pixel.Fill(static_cast<T>(value));
+}
+
 } // end namespace functor_filter_details
 
 template <class TFunction, class TNameMap>
@@ -312,6 +368,76 @@ void FunctorImageFilter<TFunction, TNameMap>::GenerateOutputInformation()
 
   // Call the helper to set the number of components for the output image
   functor_filter_details::NumberOfOutputComponents<TFunction, OutputImageType, inputNbComps.size()>::Set(m_Functor, this->GetOutput(), inputNbComps);
+
+  // Skipped regions are filled with the no-data value of the output
+  if (m_SkipNoDataRegions)
+  {
+    auto          outputPtr = this->GetOutput();
+    ImageMetadata imd       = outputPtr->GetImageMetadata();
+    imd.Bands.resize(outputPtr->GetNumberOfComponentsPerPixel());
+    for (auto& band : imd.Bands)
+    {
+      band.Add(MDNum::NoData, m_OutputNoDataValue);
+    }
+    outputPtr->SetImageMetadata(imd);
+  }
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::AllocateOutputs()
+{
+  m_OverwritesInput = false;
+  AllocateOutputsImpl(typename CanRunInPlace<OutputImageType, InputTypesTupleType, InputHasNeighborhood>::type{});
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::AllocateOutputsImpl(std::false_type)
+{
+  Superclass::AllocateOutputs();
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::AllocateOutputsImpl(std::true_type)
+{
+  auto input  = const_cast<OutputImageType*>(this->template GetInput<0>());
+  auto output = this->GetOutput();
+
+  if (m_InPlace && CanOverwriteInput(input) && input->GetBufferedRegion() == output->GetRequestedRegion() &&
+      input->GetNumberOfComponentsPerPixel() == output->GetNumberOfComponentsPerPixel())
+  {
+    output->Graft(input);
+    m_OverwritesInput = true;
+  }
+  else
+  {
+    Superclass::AllocateOutputs();
+  }
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::ReleaseInputs()
+{
+  Superclass::ReleaseInputs();
+  if (m_OverwritesInput)
+  {
+    // The source of the input has to compute it again
+    this->GetInput(0)->ReleaseData();
+    m_OverwritesInput = false;
+  }
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::BeforeThreadedGenerateData()
+{
+  Superclass::BeforeThreadedGenerateData();
+  m_InputsAreNoData = m_SkipNoDataRegions && functor_filter_details::AllInputsAreNoData(this->GetInputs());
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::AfterThreadedGenerateData()
+{
+  Superclass::AfterThreadedGenerateData();
+  SetBufferedRegionIsNoData(this->GetOutput(), m_InputsAreNoData);
 }
 
 /**
@@ -319,6 +445,37 @@ void FunctorImageFilter<TFunction, TNameMap>::GenerateOutputInformation()
  */
 template <class TFunction, class TNameMap>
 void FunctorImageFilter<TFunction, TNameMap>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  if (m_InputsAreNoData)
+  {
+    FillNoData(outputRegionForThread);
+    return;
+  }
+  NUMAPolicy::PinCurrentThread(threadId, this->GetNumberOfThreads());
+  ThreadedGenerateDataImpl(outputRegionForThread, threadId, typename HasProcessLine<TFunction, OutputImageType, InputTypesTupleType>::type{});
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::FillNoData(const OutputImageRegionType& outputRegionForThread)
+{
+  auto                                outputPtr = this->GetOutput();
+  typename OutputImageType::PixelType value;
+  functor_filter_details::FillPixel(value, outputPtr->GetNumberOfComponentsPerPixel(), m_OutputNoDataValue);
+
+  itk::ImageScanlineIterator<OutputImageType> outIt(outputPtr, outputRegionForThread);
+  while (!outIt.IsAtEnd())
+  {
+    for (; !outIt.IsAtEndOfLine(); ++outIt)
+    {
+      outIt.Set(value);
+    }
+    outIt.NextLine();
+  }
+}
+
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::ThreadedGenerateDataImpl(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId,
+                                                                       std::false_type)
 {
   const auto& regionSize = outputRegionForThread.GetSize();
 
@@ -354,6 +511,35 @@ void FunctorImageFilter<TFunction, TNameMap>::ThreadedGenerateData(const OutputI
   }
 }
 
+template <class TFunction, class TNameMap>
+void FunctorImageFilter<TFunction, TNameMap>::ThreadedGenerateDataImpl(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId,
+                                                                       std::true_type)
+{
+  const auto& regionSize = outputRegionForThread.GetSize();
+
+  if (regionSize[0] == 0)
+  {
+    return;
+  }
+  const auto            numberOfLinesToProcess = outputRegionForThread.GetNumberOfPixels() / regionSize[0];
+  itk::ProgressReporter p(this, threadId, numberOfLinesToProcess);
+
+  // Lines are contiguous in the buffers of (vector) images, as the
+  // buffered region of each input contains the output region
+  auto       outputPtr = this->GetOutput();
+  const auto inputs    = this->GetInputs();
+  auto       index     = outputRegionForThread.GetIndex();
+  const auto firstLine = index[1];
+
+  for (typename OutputImageRegionType::SizeValueType line = 0; line < regionSize[1]; ++line)
+  {
+    index[1] = firstLine + line;
+    auto out = functor_filter_details::MakeLineSpan(outputPtr, index, regionSize[0]);
+    functor_filter_details::CallProcessLine(m_Functor, out, inputs, index, regionSize[0]);
+    p.CompletedPixel(); // may throw
+  }
+}
+
 } // end namespace otb
 
 #endif
@@ -25,6 +25,12 @@
 #include "otbVariadicAddFunctor.h"
 #include "otbVariadicConcatenateFunctor.h"
 #include "otbVariadicNamedInputsImageFilter.h"
+#include "otbFixedPixelFunctorAdaptor.h"
+#include "otbFixedPixelIterator.h"
+#include "otbComposedFunctor.h"
+#include "otbNoDataRegion.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include <tuple>
 
 #include <numeric>
@@ -332,6 +338,71 @@ struct VectorModulus
   }
 };
 
+// 2 Images -> 1 Image, with a line by line implementation
+struct WeightedSum
+{
+  double operator()(double a, double b) const
+  {
+    return 0.25 * a + 0.75 * b;
+  }
+
+  void ProcessLine(otb::Span<double> out, otb::Span<const double> a, otb::Span<const double> b) const
+  {
+    for (size_t i = 0; i < out.size(); ++i)
+    {
+      out[i] = 0.25 * a[i] + 0.75 * b[i];
+    }
+  }
+};
+
+static_assert(HasProcessLine<WeightedSum, Image<double>, std::tuple<Image<double>, Image<double>>>::value, "");
+static_assert(!HasProcessLine<WeightedSum, Image<double>, std::tuple<Image<double>, Image<float>>>::value, "");
+static_assert(!HasProcessLine<Mean<double, double>, Image<double>, std::tuple<Image<double>>>::value, "");
+
+// VectorImage -> VectorImage with bands in reverse order, with a line by line implementation
+struct ReverseBands
+{
+  void operator()(itk::VariableLengthVector<double>& out, const itk::VariableLengthVector<double>& in) const
+  {
+    for (unsigned int b = 0; b < in.GetSize(); ++b)
+    {
+      out[b] = in[in.GetSize() - 1 - b];
+    }
+  }
+
+  void ProcessLine(otb::Span<double> out, otb::Span<const double> in) const
+  {
+    // Interleaved components: out.size() is the number of pixels times 2
+    for (size_t i = 0; i < out.size(); i += 2)
+    {
+      out[i]     = in[i + 1];
+      out[i + 1] = in[i];
+    }
+  }
+
+  constexpr size_t OutputSize(...) const
+  {
+    return 2;
+  }
+};
+
+static_assert(HasProcessLine<ReverseBands, VectorImage<double>, std::tuple<VectorImage<double>>>::value, "");
+
+// Sum and difference of the two bands of a pixel, with a compile-time number of bands
+struct SumDifference
+{
+  itk::FixedArray<double, 2> operator()(const itk::FixedArray<double, 2>& in) const
+  {
+    itk::FixedArray<double, 2> out;
+    out[0] = in[0] + in[1];
+    out[1] = in[0] - in[1];
+    return out;
+  }
+};
+
+using SumDifferenceAdaptor = Functor::FixedPixelFunctorAdaptor<SumDifference, double, 2, double, 2>;
+static_assert(HasProcessLine<SumDifferenceAdaptor, VectorImage<double>, std::tuple<VectorImage<double>>>::value, "");
+
 int otbFunctorImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
 {
   // test functions in functor_filter_details namespace
@@ -473,5 +544,178 @@ int otbFunctorImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
   argFilter->SetInputs(cimage);
   argFilter->Update();
 
+  // Test FunctorImageFilter with a functor processing whole lines
+  auto ramp1 = ImageType::New();
+  auto ramp2 = ImageType::New();
+  ramp1->SetRegions(size);
+  ramp1->Allocate();
+  ramp2->SetRegions(size);
+  ramp2->Allocate();
+  itk::ImageRegionIteratorWithIndex<ImageType> it1(ramp1, ramp1->GetLargestPossibleRegion());
+  itk::ImageRegionIteratorWithIndex<ImageType> it2(ramp2, ramp2->GetLargestPossibleRegion());
+  for (it1.GoToBegin(), it2.GoToBegin(); !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    it1.Set(it1.GetIndex()[0]);
+    it2.Set(it2.GetIndex()[0] * it2.GetIndex()[1]);
+  }
+
+  auto weightedSum = NewFunctorFilter(WeightedSum{});
+  weightedSum->SetInputs(ramp1, ramp2);
+  // Process a region which is not the whole buffer of the inputs
+  RegionType subRegion({{10, 20}}, {{50, 30}});
+  weightedSum->GetOutput()->SetRequestedRegion(subRegion);
+  weightedSum->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> itOut(weightedSum->GetOutput(), subRegion);
+  for (itOut.GoToBegin(); !itOut.IsAtEnd(); ++itOut)
+  {
+    const double expected = WeightedSum{}(ramp1->GetPixel(itOut.GetIndex()), ramp2->GetPixel(itOut.GetIndex()));
+    if (itOut.Get() != expected)
+    {
+      std::cerr << "Line by line processing failed at " << itOut.GetIndex() << ": expected " << expected << ", got " << itOut.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test line by line processing of vector images
+  auto rampVector = VectorImageType::New();
+  rampVector->SetRegions(size);
+  rampVector->SetNumberOfComponentsPerPixel(2);
+  rampVector->Allocate();
+  itk::ImageRegionIteratorWithIndex<VectorImageType> itv(rampVector, rampVector->GetLargestPossibleRegion());
+  for (itv.GoToBegin(); !itv.IsAtEnd(); ++itv)
+  {
+    VectorImageType::PixelType pixel(2);
+    pixel[0] = itv.GetIndex()[0];
+    pixel[1] = itv.GetIndex()[1];
+    itv.Set(pixel);
+  }
+
+  auto reverseBands = NewFunctorFilter(ReverseBands{});
+  reverseBands->SetInputs(rampVector);
+  reverseBands->GetOutput()->SetRequestedRegion(subRegion);
+  reverseBands->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<VectorImageType> itvOut(reverseBands->GetOutput(), subRegion);
+  for (itvOut.GoToBegin(); !itvOut.IsAtEnd(); ++itvOut)
+  {
+    if (itvOut.Get()[0] != itvOut.GetIndex()[1] || itvOut.Get()[1] != itvOut.GetIndex()[0])
+    {
+      std::cerr << "Line by line processing of vector images failed at " << itvOut.GetIndex() << ": got " << itvOut.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test composition of functors in a single filter
+  auto composed = NewFunctorFilter(Functor::Compose([](double x) { return x + 1; }, [](double x) { return 2 * x; }, [](double x) { return x - 3; }));
+  composed->SetInputs(ramp1);
+  composed->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> itComposed(composed->GetOutput(), composed->GetOutput()->GetLargestPossibleRegion());
+  for (itComposed.GoToBegin(); !itComposed.IsAtEnd(); ++itComposed)
+  {
+    const double expected = 2 * (ramp1->GetPixel(itComposed.GetIndex()) + 1) - 3;
+    if (itComposed.Get() != expected)
+    {
+      std::cerr << "Composed functors failed at " << itComposed.GetIndex() << ": expected " << expected << ", got " << itComposed.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  auto modulusThenFirstBand = Functor::Compose(VectorModulus<double>{}, [](const itk::VariableLengthVector<double>& in) { return in[0]; });
+  if (modulusThenFirstBand.OutputSize({{2}}) != 1)
+  {
+    std::cerr << "Wrong OutputSize() of composed functors" << std::endl;
+    return EXIT_FAILURE;
+  }
+  auto composedVector = NewFunctorFilter(modulusThenFirstBand);
+  composedVector->SetInputs(cvimage);
+  composedVector->Update();
+
+  // Test in place processing: the output of reverseOnce is only read
+  // by reverseTwice, which overwrites it
+  auto reverseOnce  = NewFunctorFilter(ReverseBands{});
+  auto reverseTwice = NewFunctorFilter(ReverseBands{});
+  reverseOnce->SetInputs(rampVector);
+  reverseTwice->SetInputs(reverseOnce->GetOutput());
+  reverseTwice->Update();
+
+  if (rampVector->GetBufferPointer() == nullptr || reverseOnce->GetOutput()->GetBufferPointer() != nullptr)
+  {
+    std::cerr << "In place processing did not release the overwritten input only" << std::endl;
+    return EXIT_FAILURE;
+  }
+  itk::ImageRegionConstIteratorWithIndex<VectorImageType> itInPlace(reverseTwice->GetOutput(), reverseTwice->GetOutput()->GetLargestPossibleRegion());
+  for (itInPlace.GoToBegin(); !itInPlace.IsAtEnd(); ++itInPlace)
+  {
+    if (itInPlace.Get()[0] != itInPlace.GetIndex()[0] || itInPlace.Get()[1] != itInPlace.GetIndex()[1])
+    {
+      std::cerr << "In place processing failed at " << itInPlace.GetIndex() << ": got " << itInPlace.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  reverseTwice->InPlaceOff();
+  reverseTwice->Update();
+  if (reverseOnce->GetOutput()->GetBufferPointer() == nullptr || reverseOnce->GetOutput()->GetBufferPointer() == reverseTwice->GetOutput()->GetBufferPointer())
+  {
+    std::cerr << "Input overwritten with in place processing disabled" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Test functor on FixedArray pixels of vector images, with runtime
+  // dispatch on the number of bands
+  auto sumDifference = DispatchNumberOfComponents<2, 2>(rampVector->GetNumberOfComponentsPerPixel(),
+                                                        [](auto) { return NewFunctorFilter(SumDifferenceAdaptor()); },
+                                                        []() -> decltype(NewFunctorFilter(SumDifferenceAdaptor())) { return nullptr; });
+  if (sumDifference.IsNull())
+  {
+    std::cerr << "Dispatch on the number of components failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  sumDifference->SetInputs(rampVector);
+  sumDifference->GetOutput()->SetRequestedRegion(subRegion);
+  sumDifference->Update();
+
+  FixedPixelConstIterator<VectorImageType, 2> itfOut(sumDifference->GetOutput(), subRegion);
+  itk::ImageRegionConstIteratorWithIndex<VectorImageType> itfIn(rampVector, subRegion);
+  for (itfOut.GoToBegin(), itfIn.GoToBegin(); !itfOut.IsAtEnd(); ++itfOut, ++itfIn)
+  {
+    const itk::FixedArray<double, 2>& pixel = itfOut.Get();
+    if (pixel[0] != itfIn.GetIndex()[0] + itfIn.GetIndex()[1] || pixel[1] != itfIn.GetIndex()[0] - itfIn.GetIndex()[1])
+    {
+      std::cerr << "Processing of FixedArray pixels failed at " << itfIn.GetIndex() << ": got " << pixel << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Test skipping of no-data regions
+  auto noDataImage = ImageType::New();
+  noDataImage->SetRegions(size);
+  noDataImage->Allocate();
+  noDataImage->FillBuffer(0);
+  SetBufferedRegionIsNoData(noDataImage.GetPointer(), true);
+
+  auto plusOne = NewFunctorFilter([](double x) { return x + 1; });
+  plusOne->SetInputs(noDataImage);
+  plusOne->SkipNoDataRegionsOn();
+  plusOne->SetOutputNoDataValue(-1);
+  plusOne->Update();
+  if (!IsBufferedRegionNoData(plusOne->GetOutput()) || plusOne->GetOutput()->GetPixel({{10, 10}}) != -1 ||
+      plusOne->GetOutput()->GetImageMetadata().Bands[0][MDNum::NoData] != -1)
+  {
+    std::cerr << "No-data region has not been skipped" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  SetBufferedRegionIsNoData(noDataImage.GetPointer(), false);
+  noDataImage->Modified();
+  plusOne->Update();
+  if (IsBufferedRegionNoData(plusOne->GetOutput()) || plusOne->GetOutput()->GetPixel({{10, 10}}) != 1)
+  {
+    std::cerr << "Valid region has been skipped" << std::endl;
+    return EXIT_FAILURE;
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFixedPixelIterator_h
+#define otbFixedPixelIterator_h
+
+#include "itkImageRegionIterator.h"
+#include "itkFixedArray.h"
+#include "otbSpan.h"
+#include <type_traits>
+#include <utility>
+
+namespace otb
+{
+
+/** \class FixedPixelConstIterator
+ * \brief Iterator over a region of a VectorImage returning its pixels as
+ * FixedArray of VNumberOfComponents components.
+ *
+ * Get() returns a reference to the components of the pixel in the buffer
+ * of the image, instead of a VariableLengthVector: the number of
+ * components is known at compile time, and no pixel is built. This suits
+ * the 3 to 8 bands images, whose per pixel loops are then unrolled.
+ *
+ * The number of components of the image is checked at construction. Use
+ * DispatchNumberOfComponents() to select VNumberOfComponents from the
+ * number of components of the image at runtime.
+ *
+ * \sa DispatchNumberOfComponents
+ *
+ * \ingroup OTBImageBase
+ */
+template <class TImage, unsigned int VNumberOfComponents>
+class ITK_EXPORT FixedPixelConstIterator : public itk::ImageRegionConstIterator<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef FixedPixelConstIterator               Self;
+  typedef itk::ImageRegionConstIterator<TImage> Superclass;
+
+  typedef typename Superclass::ImageType         ImageType;
+  typedef typename Superclass::RegionType        RegionType;
+  typedef typename Superclass::InternalPixelType InternalPixelType;
+
+  typedef itk::FixedArray<InternalPixelType, VNumberOfComponents> FixedPixelType;
+  typedef otb::Span<const InternalPixelType>                       SpanType;
+
+  itkStaticConstMacro(NumberOfComponents, unsigned int, VNumberOfComponents);
+
+  FixedPixelConstIterator(const ImageType* image, const RegionType& region) : Superclass(image, region)
+  {
+    if (image->GetNumberOfComponentsPerPixel() != VNumberOfComponents)
+    {
+      itkGenericExceptionMacro(<< "Image has " << image->GetNumberOfComponentsPerPixel() << " components per pixel instead of " << VNumberOfComponents);
+    }
+  }
+
+  /** Components of the current pixel */
+  const FixedPixelType& Get() const
+  {
+    return *reinterpret_cast<const FixedPixelType*>(this->GetComponents());
+  }
+
+  /** Components of the current pixel, as a span */
+  SpanType GetSpan() const
+  {
+    return SpanType(this->GetComponents(), VNumberOfComponents);
+  }
+
+protected:
+  const InternalPixelType* GetComponents() const
+  {
+    // Pixels are stored component by component in the buffer
+    return this->m_Buffer + this->m_Offset * VNumberOfComponents;
+  }
+};
+
+/** \class FixedPixelIterator
+ * \brief Iterator over a region of a VectorImage giving access to its
+ * pixels as FixedArray of VNumberOfComponents components.
+ *
+ * \sa FixedPixelConstIterator
+ *
+ * \ingroup OTBImageBase
+ */
+template <class TImage, unsigned int VNumberOfComponents>
+class ITK_EXPORT FixedPixelIterator : public FixedPixelConstIterator<TImage, VNumberOfComponents>
+{
+public:
+  /** Standard class typedefs. */
+  typedef FixedPixelIterator                                   Self;
+  typedef FixedPixelConstIterator<TImage, VNumberOfComponents> Superclass;
+
+  typedef typename Superclass::ImageType         ImageType;
+  typedef typename Superclass::RegionType        RegionType;
+  typedef typename Superclass::InternalPixelType InternalPixelType;
+  typedef typename Superclass::FixedPixelType    FixedPixelType;
+
+  FixedPixelIterator(ImageType* image, const RegionType& region) : Superclass(image, region)
+  {
+  }
+
+  /** Components of the current pixel */
+  FixedPixelType& Value() const
+  {
+    return *reinterpret_cast<FixedPixelType*>(const_cast<InternalPixelType*>(this->GetComponents()));
+  }
+
+  /** Set the components of the current pixel */
+  void Set(const FixedPixelType& value) const
+  {
+    this->Value() = value;
+  }
+};
+
+namespace fixed_pixel_details
+{
+template <unsigned int N, unsigned int TMax>
+struct Dispatcher
+{
+  template <class F, class G>
+  static decltype(auto) Dispatch(unsigned int n, F&& f, G&& fallback)
+  {
+    if (n == N)
+    {
+      return f(std::integral_constant<unsigned int, N>{});
+    }
+    return Dispatcher<N + 1, TMax>::Dispatch(n, std::forward<F>(f), std::forward<G>(fallback));
+  }
+};
+
+template <unsigned int TMax>
+struct Dispatcher<TMax, TMax>
+{
+  template <class F, class G>
+  static decltype(auto) Dispatch(unsigned int n, F&& f, G&& fallback)
+  {
+    if (n == TMax)
+    {
+      return f(std::integral_constant<unsigned int, TMax>{});
+    }
+    return fallback();
+  }
+};
+} // End namespace fixed_pixel_details
+
+/**
+ * \brief Dispatch on a number of components known at runtime
+ *
+ * Calls f(std::integral_constant<unsigned int, n>{}) if n is in [TMin,
+ * TMax], and fallback() otherwise, so that code using a compile-time
+ * number of components (e.g. FixedPixelConstIterator) can be
+ * instantiated for the usual band counts, with a generic fallback
+ * (e.g. with VariableLengthVector) for the others. f and fallback must
+ * return the same type.
+ *
+ * \code
+ * DispatchNumberOfComponents<3, 8>(image->GetNumberOfComponentsPerPixel(),
+ *     [&](auto n) { Process<decltype(n)::value>(image); },
+ *     [&]() { ProcessGeneric(image); });
+ * \endcode
+ *
+ * \ingroup OTBImageBase
+ */
+template <unsigned int TMin, unsigned int TMax, class F, class G>
+decltype(auto) DispatchNumberOfComponents(unsigned int n, F&& f, G&& fallback)
+{
+  static_assert(TMin > 0 && TMin <= TMax, "Invalid range of number of components");
+  return fixed_pixel_details::Dispatcher<TMin, TMax>::Dispatch(n, std::forward<F>(f), std::forward<G>(fallback));
+}
+
+} // End namespace otb
+
+#endif
@@ -239,6 +239,11 @@ public:
 
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
+  /** Allocate the pixel buffer. The pages of a new uninitialized buffer
+   * are first touched following the NUMA policy (see NUMAPolicy). When
+   * the ImageBufferPool is enabled, the buffer is taken from it. */
+  void Allocate(bool initializePixels = false) override;
+
   /// Copy metadata from a DataObject
   void CopyInformation(const itk::DataObject*) override;
 
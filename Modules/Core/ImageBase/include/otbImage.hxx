@@ -23,6 +23,8 @@
 
 
 #include "otbImage.h"
+#include "otbNUMAPolicy.h"
+#include "otbPooledImportImageContainer.h"
 #include "otbImageMetadataInterfaceFactory.h"
 #include "itkMetaDataObject.h"
 
@@ -102,6 +104,32 @@ const typename Image<TPixel, VImageDimension>::ImageKeywordlistType Image<TPixel
   return kwl;
 }
 
+template <class TPixel, unsigned int VImageDimension>
+void Image<TPixel, VImageDimension>::Allocate(bool initializePixels)
+{
+  // Image::Initialize() gives a new container before each streamed split
+  typedef PooledImportImageContainer<typename PixelContainer::ElementIdentifier, typename PixelContainer::Element> PooledContainerType;
+  if (ImageBufferPool::GetInstance().IsEnabled() && dynamic_cast<PooledContainerType*>(this->GetPixelContainer()) == nullptr)
+  {
+    this->SetPixelContainer(PooledContainerType::New());
+  }
+
+  const void* previousBuffer = this->GetBufferPointer();
+  Superclass::Allocate(initializePixels);
+
+  // Initialized buffers have already been touched by this thread, and
+  // reused buffers by previous processing
+  if (!initializePixels && this->GetBufferPointer() != previousBuffer)
+  {
+    const std::size_t nbRows = this->GetBufferedRegion().GetSize()[VImageDimension - 1];
+    if (nbRows > 0)
+    {
+      const std::size_t nbBytes = this->GetPixelContainer()->Size() * sizeof(typename PixelContainer::Element);
+      NUMAPolicy::FirstTouchBuffer(this->GetBufferPointer(), nbBytes / nbRows, nbRows);
+    }
+  }
+}
+
 template <class TPixel, unsigned int VImageDimension>
 void Image<TPixel, VImageDimension>::CopyInformation(const itk::DataObject* data)
 {
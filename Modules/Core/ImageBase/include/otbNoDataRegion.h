@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbNoDataRegion_h
+#define otbNoDataRegion_h
+
+#include "itkImageRegion.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkMetaDataObject.h"
+#include "otbImageMetadata.h"
+#include "otbMetaDataKey.h"
+#include "otbNoDataHelper.h"
+
+#include <cmath>
+#include <type_traits>
+#include <vector>
+
+namespace otb
+{
+
+/** \struct NoDataRegionTag
+ * \brief Records that the buffered region of an image holds only
+ * no-data pixels.
+ *
+ * The tag is stored in the MetaDataDictionary of the image, which is
+ * copied downstream by the filters. It therefore names the image and the
+ * buffer it has been set for: a copy found in the dictionary of another
+ * image, or a tag left from a previous update, is ignored.
+ *
+ * \sa SetBufferedRegionIsNoData
+ * \sa IsBufferedRegionNoData
+ *
+ * \ingroup OTBImageBase
+ */
+template <unsigned int VDimension>
+struct NoDataRegionTag
+{
+  const void*                  Image  = nullptr;
+  const void*                  Buffer = nullptr;
+  itk::ImageRegion<VDimension> Region;
+};
+
+/** Flag the buffered region of the image as holding only no-data
+ * pixels, or clear the flag. Sources supporting no-data regions call it
+ * after each update of their output */
+template <class TImage>
+void SetBufferedRegionIsNoData(TImage* image, bool isNoData)
+{
+  NoDataRegionTag<TImage::ImageDimension> tag;
+  if (isNoData)
+  {
+    tag.Image  = image;
+    tag.Buffer = image->GetBufferPointer();
+    tag.Region = image->GetBufferedRegion();
+  }
+  itk::EncapsulateMetaData<NoDataRegionTag<TImage::ImageDimension>>(image->GetMetaDataDictionary(), MetaDataKey::NoDataBufferedRegion, tag);
+}
+
+/** Tell if the buffered region of the image has been flagged as holding
+ * only no-data pixels by its source */
+template <class TImage>
+bool IsBufferedRegionNoData(const TImage* image)
+{
+  typedef NoDataRegionTag<TImage::ImageDimension> TagType;
+  TagType tag;
+  if (image == nullptr || !itk::ExposeMetaData<TagType>(image->GetMetaDataDictionary(), MetaDataKey::NoDataBufferedRegion, tag))
+  {
+    return false;
+  }
+  return tag.Image == image && tag.Buffer != nullptr && tag.Buffer == image->GetBufferPointer() && tag.Region == image->GetBufferedRegion();
+}
+
+namespace nodata_region_details
+{
+// Pixels of complex or composite types are never scanned
+template <class TImage>
+bool BufferHoldsOnlyNoData(const TImage*, std::false_type)
+{
+  return false;
+}
+
+template <class TImage>
+bool BufferHoldsOnlyNoData(const TImage* image, std::true_type)
+{
+  const ImageMetadata& imd = image->GetImageMetadata();
+  if (imd.Bands.size() < image->GetNumberOfComponentsPerPixel() || !imd.HasBandMetadata(MDNum::NoData) ||
+      image->GetBufferedRegion().GetNumberOfPixels() == 0)
+  {
+    return false;
+  }
+
+  std::vector<bool>   flags(imd.Bands.size(), true);
+  std::vector<double> values;
+  bool                nanIsNoData = false;
+  for (const auto& band : imd.Bands)
+  {
+    values.push_back(band[MDNum::NoData]);
+    nanIsNoData = nanIsNoData || std::isnan(values.back());
+  }
+
+  // Stops at the first valid pixel, so that only no-data regions are
+  // scanned entirely
+  itk::ImageRegionConstIterator<TImage> it(image, image->GetBufferedRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    if (!IsNoData(it.Get(), flags, values, nanIsNoData))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+} // End namespace nodata_region_details
+
+/** Scan the buffered region of the image, and return true if all its
+ * pixels are no-data according to the NoData band metadata of the image
+ * (see IsNoData()). Returns false if some bands have no NoData value, or
+ * if the components of the pixels are not scalars */
+template <class TImage>
+bool BufferHoldsOnlyNoData(const TImage* image)
+{
+  return nodata_region_details::BufferHoldsOnlyNoData(image, typename std::is_arithmetic<typename TImage::InternalPixelType>::type{});
+}
+
+} // End namespace otb
+
+#endif
@@ -0,0 +1,131 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPooledImportImageContainer_h
+#define otbPooledImportImageContainer_h
+
+#include "itkImportImageContainer.h"
+#include "otbImageBufferPool.h"
+
+#include <algorithm>
+#include <complex>
+#include <type_traits>
+
+namespace otb
+{
+
+namespace pooled_container_details
+{
+// Elements which can live in raw memory from the pool
+template <class T>
+struct IsPoolable : std::is_arithmetic<T>
+{
+};
+
+template <class T>
+struct IsPoolable<std::complex<T>> : std::is_arithmetic<T>
+{
+};
+} // End namespace pooled_container_details
+
+/** \class PooledImportImageContainer
+ * \brief Pixel container whose buffer is taken from the ImageBufferPool.
+ *
+ * The buffers of scalar and complex elements are acquired from the
+ * ImageBufferPool and given back to it when the container releases them,
+ * so that the buffer of the next streamed split, or of another filter,
+ * can reuse them. Other element types, and buffers imported with
+ * SetImportPointer(), are handled as by itk::ImportImageContainer.
+ *
+ * otb::Image and otb::VectorImage use this container when the pool is
+ * enabled.
+ *
+ * \sa ImageBufferPool
+ *
+ * \ingroup OTBImageBase
+ */
+template <typename TElementIdentifier, typename TElement>
+class ITK_EXPORT PooledImportImageContainer : public itk::ImportImageContainer<TElementIdentifier, TElement>
+{
+public:
+  /** Standard class typedefs. */
+  typedef PooledImportImageContainer Self;
+  typedef itk::ImportImageContainer<TElementIdentifier, TElement> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef typename Superclass::ElementIdentifier ElementIdentifier;
+  typedef typename Superclass::Element           Element;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Standard part of every itk Object. */
+  itkTypeMacro(PooledImportImageContainer, ImportImageContainer);
+
+protected:
+  PooledImportImageContainer()
+  {
+  }
+
+  ~PooledImportImageContainer() override
+  {
+    // The destructor of the superclass would delete[] a pool buffer
+    this->DeallocateManagedMemory();
+  }
+
+  TElement* AllocateElements(ElementIdentifier size, bool UseDefaultConstructor = false) const override
+  {
+    if (!pooled_container_details::IsPoolable<TElement>::value || size == 0)
+    {
+      return Superclass::AllocateElements(size, UseDefaultConstructor);
+    }
+
+    TElement* data = static_cast<TElement*>(ImageBufferPool::GetInstance().Acquire(size * sizeof(TElement)));
+    if (data == nullptr)
+    {
+      itkGenericExceptionMacro(<< "Failed to allocate memory for image.");
+    }
+    if (UseDefaultConstructor)
+    {
+      std::fill_n(data, size, TElement());
+    }
+    return data;
+  }
+
+  void DeallocateManagedMemory() override
+  {
+    if (this->GetContainerManageMemory() && this->GetImportPointer() != nullptr && ImageBufferPool::GetInstance().Release(this->GetImportPointer()))
+    {
+      // The buffer is back in the pool: the superclass only resets the
+      // container
+      this->SetContainerManageMemory(false);
+    }
+    Superclass::DeallocateManagedMemory();
+  }
+
+private:
+  PooledImportImageContainer(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // End namespace otb
+
+#endif
@@ -0,0 +1,100 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbVectorImage.h"
+#include "otbComplexToIntensityMultilookImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <complex>
+
+int otbComplexToIntensityMultilookImageFilter(int, char* [])
+{
+  typedef otb::VectorImage<std::complex<short>, 2> InputImageType;
+  typedef otb::VectorImage<float, 2>               OutputImageType;
+  typedef otb::ComplexToIntensityMultilookImageFilter<InputImageType, OutputImageType> FilterType;
+
+  const unsigned int nbBands      = 2;
+  const unsigned int rangeLooks   = 2;
+  const unsigned int azimuthLooks = 3;
+
+  // The last column and the last line do not make complete looks
+  InputImageType::SizeType size;
+  size[0] = 9;
+  size[1] = 7;
+  InputImageType::IndexType index;
+  index.Fill(0);
+
+  InputImageType::Pointer inputImage = InputImageType::New();
+  inputImage->SetRegions(InputImageType::RegionType(index, size));
+  inputImage->SetNumberOfComponentsPerPixel(nbBands);
+  inputImage->Allocate();
+
+  InputImageType::PixelType value(nbBands);
+  for (itk::ImageRegionIteratorWithIndex<InputImageType> it(inputImage, inputImage->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    for (unsigned int b = 0; b < nbBands; ++b)
+    {
+      value[b] = std::complex<short>(it.GetIndex()[0] - 3 * b, 2 * it.GetIndex()[1] + b);
+    }
+    it.Set(value);
+  }
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(inputImage);
+  filter->SetRangeLooks(rangeLooks);
+  filter->SetAzimuthLooks(azimuthLooks);
+  filter->Update();
+
+  OutputImageType* outputImage = filter->GetOutput();
+  if (outputImage->GetLargestPossibleRegion().GetSize()[0] != size[0] / rangeLooks ||
+      outputImage->GetLargestPossibleRegion().GetSize()[1] != size[1] / azimuthLooks || outputImage->GetNumberOfComponentsPerPixel() != nbBands)
+  {
+    std::cerr << "Wrong output size: " << outputImage->GetLargestPossibleRegion().GetSize() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const float epsilon = 1e-4;
+  for (itk::ImageRegionIteratorWithIndex<OutputImageType> ot(outputImage, outputImage->GetLargestPossibleRegion()); !ot.IsAtEnd(); ++ot)
+  {
+    for (unsigned int b = 0; b < nbBands; ++b)
+    {
+      double sum = 0.;
+      for (unsigned int l = 0; l < azimuthLooks; ++l)
+      {
+        for (unsigned int r = 0; r < rangeLooks; ++r)
+        {
+          InputImageType::IndexType inputIndex;
+          inputIndex[0] = ot.GetIndex()[0] * rangeLooks + r;
+          inputIndex[1] = ot.GetIndex()[1] * azimuthLooks + l;
+          sum += std::norm(std::complex<double>(inputImage->GetPixel(inputIndex)[b].real(), inputImage->GetPixel(inputIndex)[b].imag()));
+        }
+      }
+      const float expected = sum / (rangeLooks * azimuthLooks);
+      if (std::fabs(ot.Get()[b] - expected) > epsilon)
+      {
+        std::cerr << "Wrong intensity at " << ot.GetIndex() << " band " << b << ": " << ot.Get()[b] << " instead of " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
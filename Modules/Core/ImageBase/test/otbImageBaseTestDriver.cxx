@@ -37,6 +37,7 @@ void RegisterTests()
   REGISTER_TEST(otbImageOfVectorsToMonoChannelExtractROI);
   REGISTER_TEST(otbExtractROI_RGB);
   REGISTER_TEST(otbComplexToIntensityFilterTest);
+  REGISTER_TEST(otbComplexToIntensityMultilookImageFilter);
   REGISTER_TEST(otbMultiToMonoChannelExtractROI);
   REGISTER_TEST(otbImageTest);
   REGISTER_TEST(otbImageFunctionAdaptor);
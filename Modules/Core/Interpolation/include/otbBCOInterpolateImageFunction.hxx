@@ -25,6 +25,8 @@
 
 #include "itkNumericTraits.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -191,19 +193,22 @@ BCOInterpolateImageFunction<otb::VectorImage<TPixel, VImageDimension>, TCoordRep
 {
   typedef typename itk::NumericTraits<InputPixelType>::ScalarRealType ScalarRealType;
 
+  const InputImageType* image           = this->GetInputImage();
+  const unsigned int    componentNumber = image->GetNumberOfComponentsPerPixel();
+  const TPixel*         buffer          = image->GetBufferPointer();
+  const IndexType&      bufferStart     = image->GetBufferedRegion().GetIndex();
 
-  unsigned int dim;
-  unsigned int componentNumber = this->GetInputImage()->GetNumberOfComponentsPerPixel();
-
-  IndexType baseIndex;
-  IndexType neighIndex;
-
+  const itk::OffsetValueType lineStride = static_cast<itk::OffsetValueType>(image->GetBufferedRegion().GetSize(0)) * componentNumber;
 
 #if BOOST_VERSION >= 105800
   // faster path for <= 8 components
-  boost::container::small_vector<ScalarRealType, 8> lineRes(componentNumber);
+  boost::container::small_vector<ScalarRealType, 8>       lineRes(componentNumber);
+  boost::container::small_vector<itk::OffsetValueType, 7> offsetsX(this->m_WinSize);
+  boost::container::small_vector<itk::OffsetValueType, 7> offsetsY(this->m_WinSize);
 #else
-  std::vector<ScalarRealType> lineRes(componentNumber);
+  std::vector<ScalarRealType>       lineRes(componentNumber);
+  std::vector<itk::OffsetValueType> offsetsX(this->m_WinSize);
+  std::vector<itk::OffsetValueType> offsetsY(this->m_WinSize);
 #endif
 
   OutputType output(componentNumber);
@@ -213,45 +218,41 @@ BCOInterpolateImageFunction<otb::VectorImage<TPixel, VImageDimension>, TCoordRep
   const auto& BCOCoefY = this->EvaluateCoef(index[1]);
 
   // Compute base index = closet index
-  for (dim = 0; dim < ImageDimension; dim++)
+  IndexType baseIndex;
+  for (unsigned int dim = 0; dim < ImageDimension; dim++)
   {
     baseIndex[dim] = itk::Math::Floor<IndexValueType>(index[dim] + 0.5);
   }
 
+  // Buffer offsets of the window columns and rows, clamped to the
+  // buffered region once for the whole window
+  for (unsigned int i = 0; i < this->m_WinSize; ++i)
+  {
+    const IndexValueType x = std::min(std::max<IndexValueType>(baseIndex[0] + i - this->m_Radius, this->m_StartIndex[0]), this->m_EndIndex[0]);
+    const IndexValueType y = std::min(std::max<IndexValueType>(baseIndex[1] + i - this->m_Radius, this->m_StartIndex[1]), this->m_EndIndex[1]);
+    offsetsX[i]            = (x - bufferStart[0]) * componentNumber;
+    offsetsY[i]            = (y - bufferStart[1]) * lineStride;
+  }
+
+  // Accumulate directly from the pixel buffer: the component loops are
+  // contiguous, which lets the compiler vectorise them across bands
+  ScalarRealType* lineResPtr = lineRes.data();
   for (unsigned int i = 0; i < this->m_WinSize; ++i)
   {
     std::fill(lineRes.begin(), lineRes.end(), itk::NumericTraits<ScalarRealType>::Zero);
     for (unsigned int j = 0; j < this->m_WinSize; ++j)
     {
-      // get neighbor index
-      neighIndex[0] = baseIndex[0] + i - this->m_Radius;
-      neighIndex[1] = baseIndex[1] + j - this->m_Radius;
-      if (neighIndex[0] > this->m_EndIndex[0])
-      {
-        neighIndex[0] = this->m_EndIndex[0];
-      }
-      if (neighIndex[0] < this->m_StartIndex[0])
-      {
-        neighIndex[0] = this->m_StartIndex[0];
-      }
-      if (neighIndex[1] > this->m_EndIndex[1])
-      {
-        neighIndex[1] = this->m_EndIndex[1];
-      }
-      if (neighIndex[1] < this->m_StartIndex[1])
-      {
-        neighIndex[1] = this->m_StartIndex[1];
-      }
-
-      const InputPixelType& pixel = this->GetInputImage()->GetPixel(neighIndex);
+      const TPixel* pixel = buffer + offsetsX[i] + offsetsY[j];
+      const double  coefY = BCOCoefY[j];
       for (unsigned int k = 0; k < componentNumber; ++k)
       {
-        lineRes[k] += pixel.GetElement(k) * BCOCoefY[j];
+        lineResPtr[k] += pixel[k] * coefY;
       }
     }
+    const double coefX = BCOCoefX[i];
     for (unsigned int k = 0; k < componentNumber; ++k)
     {
-      output[k] += lineRes[k] * BCOCoefX[i];
+      output[k] += lineResPtr[k] * coefX;
     }
   }
 
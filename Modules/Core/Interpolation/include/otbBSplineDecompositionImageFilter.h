@@ -23,9 +23,6 @@
 
 #include <vector>
 
-#include "itkImageLinearIteratorWithIndex.h"
-#include "vnl/vnl_matrix.h"
-
 #include "itkImageToImageFilter.h"
 
 namespace otb
@@ -34,6 +31,26 @@ namespace otb
  *  \brief This class is an evolution of the itk::BSplineDecompositionImageFilter to handle
  * huge images with this interpolator. For more documentation, please refer to the original
  * class.
+ *
+ * The coefficients are computed by causal and anti-causal recursive
+ * filters along each dimension, whose impulse responses decay as the
+ * powers of the poles of the spline. A coefficient therefore depends on
+ * the input pixels within a bounded distance only, up to the tolerance,
+ * and the filter supports streaming: the input requested region is the
+ * output requested region padded by GetMargin() pixels, the sum of the
+ * horizons of the poles for the tolerance. The mirror boundary
+ * conditions are applied at the borders of the input image, and the
+ * coefficients of a tile are those of the whole image up to the
+ * tolerance. When the tolerance is not positive, the whole input image
+ * is requested.
+ *
+ * The padding can be disabled with PadInputRequestedRegionOff(), to
+ * decompose the buffered region of the input with mirror boundary
+ * conditions at its borders, as BSplineInterpolateImageFunction does.
+ *
+ * The lines of each dimension are processed in parallel, by blocks of
+ * adjacent lines so that the recursions run over interleaved samples.
+ *
  * \sa itk::BSplineDecompositionImageFilter
  * \ingroup ImageFilters
  *
@@ -60,19 +77,33 @@ public:
   typedef typename Superclass::InputImagePointer      InputImagePointer;
   typedef typename Superclass::InputImageConstPointer InputImageConstPointer;
   typedef typename Superclass::OutputImagePointer     OutputImagePointer;
+  typedef typename Superclass::InputImageRegionType   InputImageRegionType;
+  typedef typename Superclass::OutputImageRegionType  OutputImageRegionType;
 
   /** Dimension underlying input image. */
   itkStaticConstMacro(ImageDimension, unsigned int, TInputImage::ImageDimension);
   itkStaticConstMacro(OutputImageDimension, unsigned int, TOutputImage::ImageDimension);
 
-  /** Iterator typedef support */
-  typedef itk::ImageLinearIteratorWithIndex<TOutputImage> OutputLinearIterator;
-
   /** Get/Sets the Spline Order, supports 0th - 5th order splines. The default
    *  is a 3rd order spline. */
   void SetSplineOrder(unsigned int SplineOrder);
   itkGetMacro(SplineOrder, int);
 
+  /** Set/Get the tolerance used to truncate the initialization of the
+   * recursions and to bound the margin. The default is 1e-10. */
+  itkSetMacro(Tolerance, double);
+  itkGetConstMacro(Tolerance, double);
+
+  /** Set/Get whether the input requested region is padded by the margin
+   * (the default) */
+  itkSetMacro(PadInputRequestedRegion, bool);
+  itkGetConstMacro(PadInputRequestedRegion, bool);
+  itkBooleanMacro(PadInputRequestedRegion);
+
+  /** Number of pixels beyond which the input pixels weigh less than the
+   * tolerance on a coefficient, for a positive tolerance */
+  unsigned int GetMargin() const;
+
 protected:
   BSplineDecompositionImageFilter();
   ~BSplineDecompositionImageFilter() override
@@ -80,16 +111,17 @@ protected:
   }
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
+  /** Pad the requested region by the margin */
+  void GenerateInputRequestedRegion() override;
+
   void GenerateData() override;
 
   /** These are needed by the smoothing spline routine. */
-  std::vector<double>            m_Scratch;           // temp storage for processing of Coefficients
-  typename TInputImage::SizeType m_DataLength;        // Image size
-  unsigned int                   m_SplineOrder;       // User specified spline order (3rd or cubic is the default)
-  double                         m_SplinePoles[3];    // Poles calculated for a given spline order
-  int                            m_NumberOfPoles;     // number of poles
-  double                         m_Tolerance;         // Tolerance used for determining initial causal coefficient
-  unsigned int                   m_IteratorDirection; // Direction for iterator incrementing
+  unsigned int m_SplineOrder;             // User specified spline order (3rd or cubic is the default)
+  double       m_SplinePoles[3];          // Poles calculated for a given spline order
+  int          m_NumberOfPoles;           // number of poles
+  double       m_Tolerance;               // Tolerance used for determining initial causal coefficient
+  bool         m_PadInputRequestedRegion; // Whether the input requested region is padded by the margin
 
 private:
   BSplineDecompositionImageFilter(const Self&) = delete;
@@ -98,27 +130,42 @@ private:
   /** Determines the poles given the Spline Order. */
   virtual void SetPoles();
 
-  /** Converts a vector of data to a vector of Spline coefficients. */
-  virtual bool DataToCoefficients1D();
-
-  /** Converts an N-dimension image of data to an equivalent sized image
-   *    of spline coefficients. */
-  void DataToCoefficientsND();
+  /** Converts nbLines interleaved lines of data to Spline coefficients,
+   * sample k of line c being data[k * nbLines + c]. */
+  void DataToCoefficients1D(double* data, unsigned long length, unsigned int nbLines) const;
 
   /** Determines the first coefficient for the causal filtering of the data. */
-  virtual void SetInitialCausalCoefficient(double z);
+  void SetInitialCausalCoefficient(double z, double* data, unsigned long length, unsigned int nbLines) const;
 
   /** Determines the first coefficient for the anti-causal filtering of the data. */
-  virtual void SetInitialAntiCausalCoefficient(double z);
+  void SetInitialAntiCausalCoefficient(double z, double* data, unsigned long length, unsigned int nbLines) const;
+
+  /** Filters the lines along the direction of the pass. The dimensions
+   * below the direction are already filtered and restricted to the output
+   * region, the others still span the work region. */
+  void RunPass(unsigned int direction);
+
+  /** One pass along a direction, shared by the threads */
+  struct PassStruct
+  {
+    Self*                 Filter;
+    unsigned int          direction;
+    OutputImageRegionType region;
+  };
+
+  static ITK_THREAD_RETURN_TYPE PassThreaderCallback(void* arg);
 
-  /** Used to initialize the Coefficients image before calculation. */
-  void CopyImageToImage();
+  /** Filters the block of lines number block of the pass */
+  void ProcessBlock(const PassStruct& pass, unsigned long block, itk::ThreadIdType threadId);
 
-  /** Copies a vector of data from the Coefficients image to the m_Scratch vector. */
-  void CopyCoefficientsToScratch(OutputLinearIterator&);
+  /** Number of lines along the first dimension filtered together */
+  static const unsigned int BlockSize = 16;
 
-  /** Copies a vector of data from m_Scratch to the Coefficients image. */
-  void CopyScratchToCoefficients(OutputLinearIterator&);
+  /** Input pixels of the work region, then coefficients, in row-major
+   * order */
+  InputImageRegionType             m_WorkRegion;
+  std::vector<double>              m_Coefficients;
+  std::vector<std::vector<double>> m_ThreadBuffers;
 };
 
 } // namespace itk
@@ -21,10 +21,11 @@
 #ifndef otbBSplineDecompositionImageFilter_hxx
 #define otbBSplineDecompositionImageFilter_hxx
 #include "otbBSplineDecompositionImageFilter.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
-#include "itkImageRegionIterator.h"
-#include "itkProgressReporter.h"
-#include "itkVector.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <algorithm>
+#include <cmath>
 
 namespace otb
 {
@@ -35,10 +36,10 @@ namespace otb
 template <class TInputImage, class TOutputImage>
 BSplineDecompositionImageFilter<TInputImage, TOutputImage>::BSplineDecompositionImageFilter()
 {
-  m_SplineOrder       = 0;
-  int SplineOrder     = 3;
-  m_Tolerance         = 1e-10; // Need some guidance on this one...what is reasonable?
-  m_IteratorDirection = 0;
+  m_SplineOrder             = 0;
+  int SplineOrder           = 3;
+  m_Tolerance               = 1e-10; // Need some guidance on this one...what is reasonable?
+  m_PadInputRequestedRegion = true;
   this->SetSplineOrder(SplineOrder);
 }
 
@@ -50,10 +51,12 @@ void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::PrintSelf(std::
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Spline Order: " << m_SplineOrder << std::endl;
+  os << indent << "Tolerance: " << m_Tolerance << std::endl;
+  os << indent << "PadInputRequestedRegion: " << m_PadInputRequestedRegion << std::endl;
 }
 
 template <class TInputImage, class TOutputImage>
-bool BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficients1D()
+void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficients1D(double* data, unsigned long length, unsigned int nbLines) const
 {
 
   // See Unser, 1993, Part II, Equation 2.5,
@@ -61,9 +64,9 @@ bool BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficie
 
   double c0 = 1.0;
 
-  if (m_DataLength[m_IteratorDirection] == 1) // Required by mirror boundaries
+  if (length == 1) // Required by mirror boundaries
   {
-    return false;
+    return;
   }
 
   // Compute overall gain
@@ -74,31 +77,42 @@ bool BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficie
   }
 
   // apply the gain
-  for (unsigned int n = 0; n < m_DataLength[m_IteratorDirection]; ++n)
+  for (unsigned long i = 0; i < length * nbLines; ++i)
   {
-    m_Scratch[n] *= c0;
+    data[i] *= c0;
   }
 
   // loop over all poles
   for (int k = 0; k < m_NumberOfPoles; ++k)
   {
+    const double z = m_SplinePoles[k];
+
     // causal initialization
-    this->SetInitialCausalCoefficient(m_SplinePoles[k]);
+    this->SetInitialCausalCoefficient(z, data, length, nbLines);
     // causal recursion
-    for (unsigned int n = 1; n < m_DataLength[m_IteratorDirection]; ++n)
+    for (unsigned long n = 1; n < length; ++n)
     {
-      m_Scratch[n] += m_SplinePoles[k] * m_Scratch[n - 1];
+      double*       current  = data + n * nbLines;
+      const double* previous = current - nbLines;
+      for (unsigned int c = 0; c < nbLines; ++c)
+      {
+        current[c] += z * previous[c];
+      }
     }
 
     // anticausal initialization
-    this->SetInitialAntiCausalCoefficient(m_SplinePoles[k]);
+    this->SetInitialAntiCausalCoefficient(z, data, length, nbLines);
     // anticausal recursion
-    for (int n = m_DataLength[m_IteratorDirection] - 2; 0 <= n; n--)
+    for (long n = static_cast<long>(length) - 2; 0 <= n; n--)
     {
-      m_Scratch[n] = m_SplinePoles[k] * (m_Scratch[n + 1] - m_Scratch[n]);
+      double*       current = data + n * nbLines;
+      const double* next    = current + nbLines;
+      for (unsigned int c = 0; c < nbLines; ++c)
+      {
+        current[c] = z * (next[c] - current[c]);
+      }
     }
   }
-  return true;
 }
 
 template <class TInputImage, class TOutputImage>
@@ -156,153 +170,215 @@ void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetPoles()
 }
 
 template <class TInputImage, class TOutputImage>
-void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialCausalCoefficient(double z)
+unsigned int BSplineDecompositionImageFilter<TInputImage, TOutputImage>::GetMargin() const
+{
+  // Same horizon as the accelerated initialization of the causal recursion
+  unsigned int margin = 0;
+  for (int k = 0; k < m_NumberOfPoles; ++k)
+  {
+    margin += static_cast<unsigned int>(std::ceil(std::log(m_Tolerance) / std::log(std::fabs(m_SplinePoles[k]))));
+  }
+  return margin;
+}
+
+template <class TInputImage, class TOutputImage>
+void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialCausalCoefficient(double z, double* data, unsigned long length,
+                                                                                              unsigned int nbLines) const
 {
   /* beginning InitialCausalCoefficient */
   /* See Unser, 1999, Box 2 for explanation */
 
-  double        sum, zn, z2n, iz;
   unsigned long horizon;
 
   /* this initialization corresponds to mirror boundaries */
-  horizon = m_DataLength[m_IteratorDirection];
-  zn      = z;
+  horizon = length;
   if (m_Tolerance > 0.0)
   {
-    horizon = (long)std::ceil(log(m_Tolerance) / std::log(fabs(z)));
+    horizon = (long)std::ceil(std::log(m_Tolerance) / std::log(std::fabs(z)));
   }
-  if (horizon < m_DataLength[m_IteratorDirection])
+  if (horizon < length)
   {
     /* accelerated loop */
-    sum = m_Scratch[0]; // verify this
-    for (unsigned int n = 1; n < horizon; ++n)
+    double zn = z;
+    for (unsigned long n = 1; n < horizon; ++n)
     {
-      sum += zn * m_Scratch[n];
+      const double* sample = data + n * nbLines;
+      for (unsigned int c = 0; c < nbLines; ++c)
+      {
+        data[c] += zn * sample[c];
+      }
       zn *= z;
     }
-    m_Scratch[0] = sum;
   }
   else
   {
     /* full loop */
-    iz  = 1.0 / z;
-    z2n = std::pow(z, (double)(m_DataLength[m_IteratorDirection] - 1L));
-    sum = m_Scratch[0] + z2n * m_Scratch[m_DataLength[m_IteratorDirection] - 1L];
-    z2n *= z2n * iz;
-    for (unsigned int n = 1; n <= (m_DataLength[m_IteratorDirection] - 2); ++n)
+    const double iz    = 1.0 / z;
+    const double zLast = std::pow(z, (double)(length - 1L));
+    for (unsigned int c = 0; c < nbLines; ++c)
     {
-      sum += (zn + z2n) * m_Scratch[n];
-      zn *= z;
-      z2n *= iz;
+      double zn  = z;
+      double z2n = zLast;
+      double sum = data[c] + z2n * data[(length - 1L) * nbLines + c];
+      z2n *= z2n * iz;
+      for (unsigned long n = 1; n <= (length - 2); ++n)
+      {
+        sum += (zn + z2n) * data[n * nbLines + c];
+        zn *= z;
+        z2n *= iz;
+      }
+      data[c] = sum / (1.0 - zn * zn);
     }
-    m_Scratch[0] = sum / (1.0 - zn * zn);
   }
 }
 
 template <class TInputImage, class TOutputImage>
-void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialAntiCausalCoefficient(double z)
+void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::SetInitialAntiCausalCoefficient(double z, double* data, unsigned long length,
+                                                                                                  unsigned int nbLines) const
 {
   // this initialization corresponds to mirror boundaries
   /* See Unser, 1999, Box 2 for explanation */
   //  Also see erratum at http://bigwww.epfl.ch/publications/unser9902.html
-  m_Scratch[m_DataLength[m_IteratorDirection] - 1] =
-      (z / (z * z - 1.0)) * (z * m_Scratch[m_DataLength[m_IteratorDirection] - 2] + m_Scratch[m_DataLength[m_IteratorDirection] - 1]);
+  double*       last     = data + (length - 1) * nbLines;
+  const double* previous = last - nbLines;
+  for (unsigned int c = 0; c < nbLines; ++c)
+  {
+    last[c] = (z / (z * z - 1.0)) * (z * previous[c] + last[c]);
+  }
 }
 
 template <class TInputImage, class TOutputImage>
-void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::DataToCoefficientsND()
+void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
 {
-  OutputImagePointer output = this->GetOutput();
-
-  itk::Size<ImageDimension> size = output->GetBufferedRegion().GetSize();
-
-  unsigned int count = output->GetBufferedRegion().GetNumberOfPixels() / size[0] * ImageDimension;
+  Superclass::GenerateInputRequestedRegion();
 
-  itk::ProgressReporter progress(this, 0, count, 10);
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (!input || !m_PadInputRequestedRegion)
+  {
+    return;
+  }
 
-  // Initialize coeffient array
-  this->CopyImageToImage(); // Coefficients are initialized to the input data
+  if (m_Tolerance <= 0.0)
+  {
+    input->SetRequestedRegion(input->GetLargestPossibleRegion());
+    return;
+  }
 
-  for (unsigned int n = 0; n < ImageDimension; ++n)
+  InputImageRegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(this->GetMargin());
+  if (!inputRequestedRegion.Crop(input->GetLargestPossibleRegion()))
   {
-    m_IteratorDirection = n;
-    // Loop through each dimension
-
-    // Initialize iterators
-    OutputLinearIterator CIterator(output, output->GetBufferedRegion());
-    CIterator.SetDirection(m_IteratorDirection);
-    // For each data vector
-    while (!CIterator.IsAtEnd())
-    {
-      // Copy coefficients to scratch
-      this->CopyCoefficientsToScratch(CIterator);
-
-      // Perform 1D BSpline calculations
-      this->DataToCoefficients1D();
-
-      // Copy scratch back to coefficients.
-      // Brings us back to the end of the line we were working on.
-      CIterator.GoToBeginOfLine();
-      this->CopyScratchToCoefficients(CIterator); // m_Scratch = m_Image;
-      CIterator.NextLine();
-      progress.CompletedPixel();
-    }
+    itkExceptionMacro(<< "The requested region is outside the input image");
   }
+  input->SetRequestedRegion(inputRequestedRegion);
 }
 
-/**
- * Copy the input image into the output image
- */
 template <class TInputImage, class TOutputImage>
-void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::CopyImageToImage()
+void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::RunPass(unsigned int direction)
 {
-
-  typedef itk::ImageRegionConstIteratorWithIndex<TInputImage> InputIterator;
-  typedef itk::ImageRegionIterator<TOutputImage>              OutputIterator;
-  typedef typename TOutputImage::PixelType                    OutputPixelType;
-
-  InputIterator  inIt(this->GetInput(), this->GetInput()->GetBufferedRegion());
-  OutputIterator outIt(this->GetOutput(), this->GetOutput()->GetBufferedRegion());
-
-  inIt.GoToBegin();
-  outIt.GoToBegin();
-
-  while (!outIt.IsAtEnd())
+  PassStruct str;
+  str.Filter    = this;
+  str.direction = direction;
+  str.region    = m_WorkRegion;
+  for (unsigned int d = 0; d < direction; ++d)
   {
-    outIt.Set(static_cast<OutputPixelType>(inIt.Get()));
-    ++inIt;
-    ++outIt;
+    str.region.SetIndex(d, this->GetOutput()->GetRequestedRegion().GetIndex(d));
+    str.region.SetSize(d, this->GetOutput()->GetRequestedRegion().GetSize(d));
   }
+
+  this->GetMultiThreader()->SetNumberOfThreads(this->GetNumberOfThreads());
+  this->GetMultiThreader()->SetSingleMethod(this->PassThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
 }
 
-/**
- * Copy the scratch to one line of the output image
- */
 template <class TInputImage, class TOutputImage>
-void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::CopyScratchToCoefficients(OutputLinearIterator& Iter)
+ITK_THREAD_RETURN_TYPE BSplineDecompositionImageFilter<TInputImage, TOutputImage>::PassThreaderCallback(void* arg)
 {
-  typedef typename TOutputImage::PixelType OutputPixelType;
-  unsigned long                            j = 0;
-  while (!Iter.IsAtEndOfLine())
+  itk::ThreadIdType threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+  PassStruct*       str         = (PassStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+
+  // The blocks cover the first dimension by groups of BlockSize lines,
+  // except when filtering along it, and each of the other dimensions
+  const unsigned int blockSize = BlockSize;
+  unsigned long      nbBlocks  = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    if (d == 0 && str->direction != 0)
+    {
+      nbBlocks *= (str->region.GetSize(0) + blockSize - 1) / blockSize;
+    }
+    else if (d != str->direction)
+    {
+      nbBlocks *= str->region.GetSize(d);
+    }
+  }
+
+  // Each thread takes a contiguous range of blocks
+  const unsigned long firstBlock = nbBlocks * threadId / threadCount;
+  const unsigned long lastBlock  = nbBlocks * (threadId + 1) / threadCount;
+  for (unsigned long block = firstBlock; block < lastBlock; ++block)
   {
-    Iter.Set(static_cast<OutputPixelType>(m_Scratch[j]));
-    ++Iter;
-    ++j;
+    str->Filter->ProcessBlock(*str, block, threadId);
   }
+
+  return ITK_THREAD_RETURN_VALUE;
 }
 
-/**
- * Copy one line of the output image to the scratch
- */
 template <class TInputImage, class TOutputImage>
-void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::CopyCoefficientsToScratch(OutputLinearIterator& Iter)
+void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::ProcessBlock(const PassStruct& pass, unsigned long block, itk::ThreadIdType threadId)
 {
-  unsigned long j = 0;
-  while (!Iter.IsAtEndOfLine())
+  const unsigned int  blockSize = BlockSize;
+  const unsigned int  direction = pass.direction;
+  const unsigned long length    = pass.region.GetSize(direction);
+
+  // Offset of the first sample of the block in the work region
+  unsigned long strides[ImageDimension];
+  unsigned long offset   = 0;
+  unsigned long stride   = 1;
+  unsigned int  nbLines  = 1;
+  unsigned long position = block;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    strides[d] = stride;
+    long index = pass.region.GetIndex(d);
+    if (d == 0 && direction != 0)
+    {
+      const unsigned long nbGroups = (pass.region.GetSize(0) + blockSize - 1) / blockSize;
+      const unsigned long first    = (position % nbGroups) * blockSize;
+      nbLines = std::min(static_cast<unsigned long>(blockSize), pass.region.GetSize(0) - first);
+      index += first;
+      position /= nbGroups;
+    }
+    else if (d != direction)
+    {
+      index += position % pass.region.GetSize(d);
+      position /= pass.region.GetSize(d);
+    }
+    offset += (index - m_WorkRegion.GetIndex(d)) * stride;
+    stride *= m_WorkRegion.GetSize(d);
+  }
+
+  double* first = &m_Coefficients[offset];
+  if (direction == 0)
+  {
+    // The samples of a line along the first dimension are contiguous
+    this->DataToCoefficients1D(first, length, 1);
+    return;
+  }
+
+  // Interleave the lines of the block, which are adjacent in memory
+  double* buffer = m_ThreadBuffers[threadId].data();
+  for (unsigned long k = 0; k < length; ++k)
   {
-    m_Scratch[j] = static_cast<double>(Iter.Get());
-    ++Iter;
-    ++j;
+    std::copy(first + k * strides[direction], first + k * strides[direction] + nbLines, buffer + k * nbLines);
+  }
+
+  this->DataToCoefficients1D(buffer, length, nbLines);
+
+  for (unsigned long k = 0; k < length; ++k)
+  {
+    std::copy(buffer + k * nbLines, buffer + (k + 1) * nbLines, first + k * strides[direction]);
   }
 }
 
@@ -312,31 +388,58 @@ void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::CopyCoefficient
 template <class TInputImage, class TOutputImage>
 void BSplineDecompositionImageFilter<TInputImage, TOutputImage>::GenerateData()
 {
+  InputImageConstPointer inputPtr  = this->GetInput();
+  OutputImagePointer     outputPtr = this->GetOutput();
+
+  // Allocate memory for output image
+  outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
+  outputPtr->Allocate();
 
-  // Allocate scratch memory
-  InputImageConstPointer inputPtr = this->GetInput();
-  m_DataLength                    = inputPtr->GetBufferedRegion().GetSize();
+  // The coefficients are computed on the input requested region, which
+  // holds the output region and its margin
+  m_WorkRegion = inputPtr->GetRequestedRegion();
+  m_Coefficients.resize(m_WorkRegion.GetNumberOfPixels());
 
   unsigned long maxLength = 0;
   for (unsigned int n = 0; n < ImageDimension; ++n)
   {
-    if (m_DataLength[n] > maxLength)
-    {
-      maxLength = m_DataLength[n];
-    }
+    maxLength = std::max(maxLength, static_cast<unsigned long>(m_WorkRegion.GetSize(n)));
   }
-  m_Scratch.resize(maxLength);
+  m_ThreadBuffers.assign(this->GetNumberOfThreads(), std::vector<double>(maxLength * BlockSize));
 
-  // Allocate memory for output image
-  OutputImagePointer outputPtr = this->GetOutput();
-  outputPtr->SetBufferedRegion(outputPtr->GetRequestedRegion());
-  outputPtr->Allocate();
+  // Coefficients are initialized to the input data
+  itk::ImageRegionConstIterator<TInputImage> inIt(inputPtr, m_WorkRegion);
+  std::vector<double>::iterator              coeffIt = m_Coefficients.begin();
+  for (inIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++coeffIt)
+  {
+    *coeffIt = static_cast<double>(inIt.Get());
+  }
 
-  // Calculate actual output
-  this->DataToCoefficientsND();
+  // Loop through each dimension
+  for (unsigned int n = 0; n < ImageDimension; ++n)
+  {
+    this->RunPass(n);
+    this->UpdateProgress(static_cast<float>(n + 1) / ImageDimension);
+  }
+
+  typedef typename TOutputImage::PixelType OutputPixelType;
+
+  itk::ImageRegionIteratorWithIndex<TOutputImage> outIt(outputPtr, outputPtr->GetRequestedRegion());
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    unsigned long offset = 0;
+    unsigned long stride = 1;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      offset += (outIt.GetIndex()[d] - m_WorkRegion.GetIndex(d)) * stride;
+      stride *= m_WorkRegion.GetSize(d);
+    }
+    outIt.Set(static_cast<OutputPixelType>(m_Coefficients[offset]));
+  }
 
   // Clean up
-  m_Scratch.clear();
+  m_Coefficients.clear();
+  m_ThreadBuffers.clear();
 }
 
 } // namespace otb
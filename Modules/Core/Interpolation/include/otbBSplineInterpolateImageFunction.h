@@ -24,6 +24,7 @@
 #include <vector>
 
 #include "itkInterpolateImageFunction.h"
+#include "itkImageLinearIteratorWithIndex.h"
 #include "vnl/vnl_matrix.h"
 
 #include "otbBSplineDecompositionImageFilter.h"
@@ -126,6 +127,14 @@ public:
    region of the input image. */
   virtual void UpdateCoefficientsFilter(void);
 
+  /** Margin for streaming: the support of the spline plus the margin of
+   * the coefficient filter, beyond which the buffered region borders weigh
+   * less than its tolerance on the interpolated values. */
+  unsigned int GetRadius() const
+  {
+    return m_SplineOrder / 2 + 1 + m_CoefficientFilter->GetMargin();
+  }
+
 protected:
   BSplineInterpolateImageFunction();
   ~BSplineInterpolateImageFunction() override = default;
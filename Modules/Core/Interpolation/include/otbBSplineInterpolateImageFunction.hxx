@@ -42,6 +42,9 @@ BSplineInterpolateImageFunction<TImageType, TCoordRep, TCoefficientType>::BSplin
   m_Coefficients(CoefficientImageType::New()),  // TODO: Should we store coefficients in a variable or retrieve from filter?
   m_CoefficientFilter(CoefficientFilter::New())
 {
+  // The coefficients are computed on the buffered region of the input,
+  // which must not be enlarged while it is interpolated
+  m_CoefficientFilter->PadInputRequestedRegionOff();
   this->SetSplineOrder(3);
 }
 
@@ -24,6 +24,11 @@
 #include "itkInterpolateImageFunction.h"
 #include "itkConstNeighborhoodIterator.h"
 #include "itkConstantBoundaryCondition.h"
+#include "itkZeroFluxNeumannBoundaryCondition.h"
+#include "otbVectorImage.h"
+
+#include <type_traits>
+#include <vector>
 
 namespace otb
 {
@@ -36,6 +41,9 @@ namespace otb
  *
  * The Initialize() method need to be call to create the filter.
  *
+ * For 2D otb::VectorImage inputs, the kernel is applied separably on the
+ * pixel buffer, all bands at once.
+ *
  * \ingroup ImageFunctions ImageInterpolators
  *
  * \ingroup OTBInterpolation
@@ -130,6 +138,22 @@ protected:
 private:
   GenericInterpolateImageFunction(const Self&) = delete;
   void operator=(const Self&) = delete;
+
+  /** 1D kernel weights, per dimension */
+  typedef std::vector<std::vector<double>> WeightsType;
+
+  /** 2D VectorImage inputs are evaluated separably on the pixel buffer */
+  typedef std::integral_constant<bool, ImageDimension == 2 &&
+                                           std::is_same<InputImageType, otb::VectorImage<typename InputImageType::InternalPixelType, 2>>::value>
+      UseSeparableEvaluationType;
+
+  /** Apply the weights using a neighborhood iterator */
+  OutputType EvaluateWithWeights(const IndexType& baseIndex, const WeightsType& weights, std::false_type) const;
+
+  /** Apply the weights separably, reading the VectorImage buffer. Windows
+   * crossing the buffer border are clamped under the zero flux Neumann
+   * condition, and delegated to the neighborhood iterator otherwise. */
+  OutputType EvaluateWithWeights(const IndexType& baseIndex, const WeightsType& weights, std::true_type) const;
   /** Store the window radius. */
   // unsigned int m_Radius;
   // Constant to store twice the radius
@@ -23,6 +23,8 @@
 #include "otbGenericInterpolateImageFunction.h"
 #include "vnl/vnl_math.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -208,15 +210,9 @@ GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoo
     distance[dim] = index[dim] - double(baseIndex[dim]);
   }
 
-  // Position the neighborhood at the index of interest
-  SizeType radius;
-  radius.Fill(this->GetRadius());
-  IteratorType nit = IteratorType(radius, this->GetInputImage(), this->GetInputImage()->GetBufferedRegion());
-  nit.SetLocation(baseIndex);
-
   const unsigned int twiceRadius = static_cast<const unsigned int>(2 * this->GetRadius());
   /*  double xWeight[ImageDimension][ twiceRadius]; */
-  std::vector<std::vector<double>> xWeight;
+  WeightsType xWeight;
   xWeight.resize(ImageDimension);
   for (unsigned int cpt = 0; cpt < xWeight.size(); ++cpt)
   {
@@ -274,6 +270,20 @@ GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoo
     }
   }
 
+  return this->EvaluateWithWeights(baseIndex, xWeight, UseSeparableEvaluationType());
+}
+
+template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
+typename GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::OutputType
+GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::EvaluateWithWeights(const IndexType&   baseIndex,
+                                                                                                            const WeightsType& xWeight, std::false_type) const
+{
+  // Position the neighborhood at the index of interest
+  SizeType radius;
+  radius.Fill(this->GetRadius());
+  IteratorType nit = IteratorType(radius, this->GetInputImage(), this->GetInputImage()->GetBufferedRegion());
+  nit.SetLocation(baseIndex);
+
   // Iterate over the neighborhood, taking the correct set
   // of weights in each dimension
   RealType xPixelValue;
@@ -303,6 +313,81 @@ GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoo
   return static_cast<OutputType>(xPixelValue);
 }
 
+template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
+typename GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::OutputType
+GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::EvaluateWithWeights(const IndexType&   baseIndex,
+                                                                                                            const WeightsType& xWeight, std::true_type) const
+{
+  typedef typename InputImageType::InternalPixelType       InternalPixelType;
+  typedef typename itk::NumericTraits<RealType>::ValueType ScalarRealType;
+
+  const InputImageType*    image           = this->GetInputImage();
+  const unsigned int       componentNumber = image->GetNumberOfComponentsPerPixel();
+  const InternalPixelType* buffer          = image->GetBufferPointer();
+  const IndexType&         bufferStart     = image->GetBufferedRegion().GetIndex();
+  const IndexType&         startIndex      = this->m_StartIndex;
+  const IndexType&         endIndex        = this->m_EndIndex;
+
+  const itk::OffsetValueType lineStride = static_cast<itk::OffsetValueType>(image->GetBufferedRegion().GetSize(0)) * componentNumber;
+
+  // The window spans offsets [1 - radius, radius]. Clamping the indices
+  // to the buffered region is what the zero flux Neumann condition
+  // does, other conditions are left to the neighborhood iterator.
+  const long radius = static_cast<long>(this->GetRadius());
+  if (!std::is_same<TBoundaryCondition, itk::ZeroFluxNeumannBoundaryCondition<InputImageType>>::value)
+  {
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      if (baseIndex[dim] + 1 - radius < startIndex[dim] || baseIndex[dim] + radius > endIndex[dim])
+      {
+        return this->EvaluateWithWeights(baseIndex, xWeight, std::false_type());
+      }
+    }
+  }
+
+  // Buffer offsets of the window columns and rows
+  std::vector<itk::OffsetValueType> offsetsX(m_WindowSize);
+  std::vector<itk::OffsetValueType> offsetsY(m_WindowSize);
+  for (unsigned int i = 0; i < m_WindowSize; ++i)
+  {
+    const long x = std::min(std::max<long>(baseIndex[0] + i + 1 - radius, startIndex[0]), endIndex[0]);
+    const long y = std::min(std::max<long>(baseIndex[1] + i + 1 - radius, startIndex[1]), endIndex[1]);
+    offsetsX[i]  = (x - bufferStart[0]) * componentNumber;
+    offsetsY[i]  = (y - bufferStart[1]) * lineStride;
+  }
+
+  // Filter each row of the window along x, then combine the rows along y.
+  // The component loops are contiguous, so that they vectorise across bands.
+  std::vector<ScalarRealType> lineValue(componentNumber);
+  std::vector<ScalarRealType> value(componentNumber, 0.);
+  for (unsigned int j = 0; j < m_WindowSize; ++j)
+  {
+    std::fill(lineValue.begin(), lineValue.end(), 0.);
+    const InternalPixelType* row = buffer + offsetsY[j];
+    for (unsigned int i = 0; i < m_WindowSize; ++i)
+    {
+      const InternalPixelType* pixel   = row + offsetsX[i];
+      const double             weightX = xWeight[0][i];
+      for (unsigned int k = 0; k < componentNumber; ++k)
+      {
+        lineValue[k] += pixel[k] * weightX;
+      }
+    }
+    const double weightY = xWeight[1][j];
+    for (unsigned int k = 0; k < componentNumber; ++k)
+    {
+      value[k] += lineValue[k] * weightY;
+    }
+  }
+
+  OutputType output(componentNumber);
+  for (unsigned int k = 0; k < componentNumber; ++k)
+  {
+    output[k] = static_cast<typename OutputType::ValueType>(value[k]);
+  }
+  return output;
+}
+
 template <class TInputImage, class TFunction, class TBoundaryCondition, class TCoordRep>
 void GenericInterpolateImageFunction<TInputImage, TFunction, TBoundaryCondition, TCoordRep>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
@@ -35,6 +35,7 @@
 #include "otbBCOInterpolateImageFunction.h"
 
 #include "otbProlateInterpolateImageFunction.h"
+#include "otbBSplineInterpolateImageFunction.h"
 
 namespace otb
 {
@@ -77,6 +78,7 @@ public:
   typedef WindowedSincInterpolateImageBlackmanFunction<ImageType> BlackmanInterpolationType;
   typedef ProlateInterpolateImageFunction<ImageType>              ProlateInterpolationType;
   typedef BCOInterpolateImageFunction<ImageType>                  BCOInterpolationType;
+  typedef BSplineInterpolateImageFunction<ImageType, double>      OTBBSplineInterpolationType;
 
   static unsigned int CalculateNeededRadiusForInterpolator(const InterpolationType* interpolator);
 };
@@ -46,7 +46,10 @@ unsigned int StreamingTraits<TImage>::CalculateNeededRadiusForInterpolator(const
   else if (className == "BSplineInterpolateImageFunction")
   {
     otbMsgDevMacro(<< "BSpline Interpolator");
-    neededRadius = 2;
+    // The coefficients of the OTB interpolator need a margin to be
+    // independent of the streaming
+    const OTBBSplineInterpolationType* bspline = dynamic_cast<const OTBBSplineInterpolationType*>(interpolator);
+    neededRadius                               = bspline ? bspline->GetRadius() : 2;
   }
   else if (className == "ProlateInterpolateImageFunction")
   {
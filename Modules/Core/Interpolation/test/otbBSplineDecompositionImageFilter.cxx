@@ -24,6 +24,12 @@
 #include "otbImage.h"
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
 
 int otbBSplineDecompositionImageFilter(int itkNotUsed(argc), char* argv[])
 {
@@ -51,3 +57,54 @@ int otbBSplineDecompositionImageFilter(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbBSplineDecompositionImageFilterStreaming(int itkNotUsed(argc), char* argv[])
+{
+  typedef otb::Image<double, 2>                                      ImageType;
+  typedef otb::BSplineDecompositionImageFilter<ImageType, ImageType> BSplineDecompositionImageFilterType;
+  typedef otb::ImageFileReader<ImageType>                            ReaderType;
+  typedef itk::StreamingImageFilter<ImageType, ImageType>            StreamingFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->Update();
+
+  // The streamed coefficients must be those of the whole image, up to
+  // the tolerance
+  for (unsigned int order = 0; order <= 5; ++order)
+  {
+    BSplineDecompositionImageFilterType::Pointer fullFilter = BSplineDecompositionImageFilterType::New();
+    fullFilter->SetSplineOrder(order);
+    fullFilter->SetInput(reader->GetOutput());
+    fullFilter->Update();
+
+    BSplineDecompositionImageFilterType::Pointer streamedFilter = BSplineDecompositionImageFilterType::New();
+    streamedFilter->SetSplineOrder(order);
+    streamedFilter->SetInput(reader->GetOutput());
+
+    StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+    streamer->SetInput(streamedFilter->GetOutput());
+    streamer->SetNumberOfStreamDivisions(7);
+    streamer->Update();
+
+    double maxValue = 0.;
+    double maxError = 0.;
+
+    itk::ImageRegionConstIterator<ImageType> fullIt(fullFilter->GetOutput(), fullFilter->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> streamedIt(streamer->GetOutput(), fullFilter->GetOutput()->GetLargestPossibleRegion());
+    for (fullIt.GoToBegin(), streamedIt.GoToBegin(); !fullIt.IsAtEnd(); ++fullIt, ++streamedIt)
+    {
+      maxValue = std::max(maxValue, std::abs(fullIt.Get()));
+      maxError = std::max(maxError, std::abs(fullIt.Get() - streamedIt.Get()));
+    }
+
+    std::cout << "Order " << order << ", margin " << streamedFilter->GetMargin() << ": maximum error " << maxError << std::endl;
+    if (maxError > 1e-8 * std::max(maxValue, 1.))
+    {
+      std::cerr << "Streamed coefficients of order " << order << " differ from the whole image ones by " << maxError << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
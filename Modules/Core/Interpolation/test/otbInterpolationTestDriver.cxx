@@ -23,8 +23,10 @@
 void RegisterTests()
 {
   REGISTER_TEST(otbWindowedSincInterpolateImageLanczosFunction);
+  REGISTER_TEST(otbWindowedSincInterpolateImageLanczosFunctionOverVectorImage);
   REGISTER_TEST(otbWindowedSincInterpolateImageBlackmanFunction);
   REGISTER_TEST(otbBSplineDecompositionImageFilter);
+  REGISTER_TEST(otbBSplineDecompositionImageFilterStreaming);
   REGISTER_TEST(otbWindowedSincInterpolateImageGaussianFunction);
   REGISTER_TEST(otbWindowedSincInterpolateImageCosineFunction);
   REGISTER_TEST(otbWindowedSincInterpolateImageHammingFunction);
@@ -22,9 +22,13 @@
 
 #include "otbWindowedSincInterpolateImageLanczosFunction.h"
 #include "itkConstantBoundaryCondition.h"
+#include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "otbImage.h"
+#include "otbVectorImage.h"
 #include "otbImageFileReader.h"
 
+#include <cmath>
+
 int otbWindowedSincInterpolateImageLanczosFunction(int argc, char* argv[])
 {
   const char* infname  = argv[1];
@@ -74,3 +78,121 @@ int otbWindowedSincInterpolateImageLanczosFunction(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+namespace
+{
+/** Compare the interpolation of a VectorImage with the interpolation of
+ * each of its bands */
+template <class TVectorInterpolator, class TInterpolator>
+bool CheckLanczosOverVectorImage(typename TVectorInterpolator::InputImageType* vectorImage,
+                                 const std::vector<typename TInterpolator::InputImageType::Pointer>& bands, bool checkBorders)
+{
+  typedef typename TInterpolator::ContinuousIndexType ContinuousIndexType;
+
+  const unsigned int radius = 3;
+
+  typename TVectorInterpolator::Pointer vectorInterp = TVectorInterpolator::New();
+  vectorInterp->SetInputImage(vectorImage);
+  vectorInterp->SetRadius(radius);
+  vectorInterp->Initialize();
+
+  std::vector<typename TInterpolator::Pointer> bandInterps(bands.size());
+  for (unsigned int b = 0; b < bands.size(); ++b)
+  {
+    bandInterps[b] = TInterpolator::New();
+    bandInterps[b]->SetInputImage(bands[b]);
+    bandInterps[b]->SetRadius(radius);
+    bandInterps[b]->Initialize();
+  }
+
+  // Inner positions, then positions whose window crosses the borders
+  const double       positions[][2]   = {{10.5, 4.5}, {20.33, 10.9}, {30, 7}, {17.75, 0.25}, {2., -3.}, {2.4, -2.6}, {42.3, 25.1}};
+  const unsigned int nbInnerPositions = 4;
+  const unsigned int nbPositions      = checkBorders ? 7 : nbInnerPositions;
+
+  for (unsigned int p = 0; p < nbPositions; ++p)
+  {
+    const double* position = positions[p];
+
+    ContinuousIndexType index;
+    index[0] = position[0];
+    index[1] = position[1];
+
+    const typename TVectorInterpolator::OutputType vectorValue = vectorInterp->EvaluateAtContinuousIndex(index);
+    for (unsigned int b = 0; b < bands.size(); ++b)
+    {
+      const double bandValue = bandInterps[b]->EvaluateAtContinuousIndex(index);
+      if (std::abs(vectorValue[b] - bandValue) > 1e-9)
+      {
+        std::cerr << "At " << index << ", band " << b << ": VectorImage interpolation gives " << vectorValue[b] << " instead of " << bandValue << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+} // namespace
+
+int otbWindowedSincInterpolateImageLanczosFunctionOverVectorImage(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<double, 2>       ImageType;
+  typedef otb::VectorImage<double, 2> VectorImageType;
+
+  const unsigned int nbBands = 3;
+
+  // Synthetic image, whose bands are also stored as scalar images
+  ImageType::RegionType region;
+  region.SetIndex(0, 2);
+  region.SetIndex(1, -3);
+  region.SetSize(0, 41);
+  region.SetSize(1, 29);
+
+  VectorImageType::Pointer vectorImage = VectorImageType::New();
+  vectorImage->SetRegions(region);
+  vectorImage->SetNumberOfComponentsPerPixel(nbBands);
+  vectorImage->Allocate();
+
+  std::vector<ImageType::Pointer> bands(nbBands);
+  for (unsigned int b = 0; b < nbBands; ++b)
+  {
+    bands[b] = ImageType::New();
+    bands[b]->SetRegions(region);
+    bands[b]->Allocate();
+  }
+
+  for (ImageType::IndexValueType y = region.GetIndex(1); y < region.GetIndex(1) + static_cast<ImageType::IndexValueType>(region.GetSize(1)); ++y)
+  {
+    for (ImageType::IndexValueType x = region.GetIndex(0); x < region.GetIndex(0) + static_cast<ImageType::IndexValueType>(region.GetSize(0)); ++x)
+    {
+      ImageType::IndexType index;
+      index[0] = x;
+      index[1] = y;
+      VectorImageType::PixelType pixel(nbBands);
+      for (unsigned int b = 0; b < nbBands; ++b)
+      {
+        pixel[b] = std::sin(0.3 * x * (b + 1)) + std::cos(0.17 * y) * b + 0.01 * x * y;
+        bands[b]->SetPixel(index, pixel[b]);
+      }
+      vectorImage->SetPixel(index, pixel);
+    }
+  }
+
+  // Default (constant) boundary condition
+  typedef otb::WindowedSincInterpolateImageLanczosFunction<ImageType>       InterpolatorType;
+  typedef otb::WindowedSincInterpolateImageLanczosFunction<VectorImageType> VectorInterpolatorType;
+
+  // Zero flux Neumann boundary condition
+  typedef otb::WindowedSincInterpolateImageLanczosFunction<ImageType, itk::ZeroFluxNeumannBoundaryCondition<ImageType>> NeumannInterpolatorType;
+  typedef otb::WindowedSincInterpolateImageLanczosFunction<VectorImageType, itk::ZeroFluxNeumannBoundaryCondition<VectorImageType>>
+      NeumannVectorInterpolatorType;
+
+  // Only inner windows are compared for the constant boundary condition,
+  // whose default constant has no components for VectorImage pixels
+  if (!CheckLanczosOverVectorImage<VectorInterpolatorType, InterpolatorType>(vectorImage, bands, false) ||
+      !CheckLanczosOverVectorImage<NeumannVectorInterpolatorType, NeumannInterpolatorType>(vectorImage, bands, true))
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,303 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingAttributesFromLabelImageFilter_h
+#define otbStreamingAttributesFromLabelImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "otbVectorImage.h"
+#include "itkMatrix.h"
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentAttributesFromLabelImageFilter
+ * \brief Computes shape and band statistics attributes for each label of a label image
+ *
+ * This filter accumulates, tile after tile, the moments needed by the
+ * attributes of ShapeAttributesLabelMapFilter and
+ * BandsStatisticsAttributesLabelMapFilter directly from the label image,
+ * without building the run-length lines of an itk::LabelMap. Only a
+ * fixed-size accumulator per label is kept in memory.
+ *
+ * The perimeter is estimated by counting, for each pixel, the neighbours
+ * belonging to another label (intercepts along the axes, and along the
+ * diagonals in 2D). The label image requested region is therefore padded
+ * by one pixel. Attributes that need the whole object at once (Feret
+ * diameter, Flusser moments, polygon) are not computed.
+ *
+ * When a feature image is set, the STATS::BandN attributes are computed
+ * for each of its bands.
+ *
+ * Once the image has been streamed, Synthetize() fills a table giving,
+ * for each label, the attribute values in the order of GetAttributeNames().
+ * The names follow the SHAPE:: and STATS:: conventions of the label map
+ * attribute filters, so that the table can feed the same models.
+ *
+ * \sa StreamingAttributesFromLabelImageFilter
+ * \sa ShapeAttributesLabelMapFilter
+ * \sa BandsStatisticsAttributesLabelMapFilter
+ *
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBLabelMap
+ */
+template <class TLabelImage, class TFeatureImage = otb::VectorImage<float, TLabelImage::ImageDimension>>
+class ITK_EXPORT PersistentAttributesFromLabelImageFilter : public PersistentImageFilter<TLabelImage, TLabelImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentAttributesFromLabelImageFilter        Self;
+  typedef PersistentImageFilter<TLabelImage, TLabelImage> Superclass;
+  typedef itk::SmartPointer<Self>                         Pointer;
+  typedef itk::SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentAttributesFromLabelImageFilter, PersistentImageFilter);
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TLabelImage::ImageDimension);
+
+  /** Image related typedefs. */
+  typedef TLabelImage                         LabelImageType;
+  typedef typename LabelImageType::PixelType  LabelPixelType;
+  typedef typename LabelImageType::RegionType RegionType;
+  typedef typename LabelImageType::IndexType  IndexType;
+  typedef TFeatureImage                       FeatureImageType;
+
+  /** Attribute table typedefs */
+  typedef std::vector<std::string>                                AttributeNamesType;
+  typedef std::unordered_map<LabelPixelType, std::vector<double>> AttributesTableType;
+  typedef itk::Matrix<double, ImageDimension, ImageDimension>     MatrixType;
+  typedef itk::FixedArray<itk::SizeValueType, ImageDimension>     InterceptsType;
+
+  /** Moments of one label, merged over threads and streams */
+  struct AttributesAccumulator
+  {
+    AttributesAccumulator(const IndexType& idx, unsigned int nbBands);
+
+    void Merge(const AttributesAccumulator& other);
+
+    itk::SizeValueType                  m_Count;
+    itk::SizeValueType                  m_SizeOnBorder;
+    itk::Vector<double, ImageDimension> m_Sum;
+    MatrixType                          m_SqSum;
+    IndexType                           m_Min;
+    IndexType                           m_Max;
+    InterceptsType                      m_Intercepts;
+    itk::SizeValueType                  m_DiagonalIntercepts;
+    std::vector<double>                 m_BandSum;
+    std::vector<double>                 m_BandSum2;
+    std::vector<double>                 m_BandSum3;
+    std::vector<double>                 m_BandSum4;
+    std::vector<double>                 m_BandMin;
+    std::vector<double>                 m_BandMax;
+  };
+
+  typedef std::unordered_map<LabelPixelType, AttributesAccumulator> AccumulatorMapType;
+
+  /** Set/Get the label ignored by the accumulation */
+  itkSetMacro(BackgroundValue, LabelPixelType);
+  itkGetConstMacro(BackgroundValue, LabelPixelType);
+
+  /** Set the optional feature image used for the band statistics */
+  void SetFeatureImage(const FeatureImageType* image);
+
+  /** Get the feature image */
+  const FeatureImageType* GetFeatureImage() const;
+
+  /** Names of the attributes, in the order of the table values */
+  const AttributeNamesType& GetAttributeNames() const
+  {
+    return m_AttributeNames;
+  }
+
+  /** Attribute values of each label */
+  const AttributesTableType& GetAttributesTable() const
+  {
+    return m_AttributesTable;
+  }
+
+  void AllocateOutputs() override;
+
+  void GenerateOutputInformation() override;
+
+  void GenerateInputRequestedRegion() override;
+
+  void Reset(void) override;
+
+  void Synthetize(void) override;
+
+protected:
+  PersistentAttributesFromLabelImageFilter();
+  ~PersistentAttributesFromLabelImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  PersistentAttributesFromLabelImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Number of bands of the feature image, 0 if none */
+  unsigned int GetNumberOfBands() const;
+
+  LabelPixelType m_BackgroundValue;
+
+  std::vector<AccumulatorMapType> m_AccumulatorMaps;
+
+  AttributeNamesType  m_AttributeNames;
+  AttributesTableType m_AttributesTable;
+}; // end of class PersistentAttributesFromLabelImageFilter
+
+/*===========================================================================*/
+
+/** \class StreamingAttributesFromLabelImageFilter
+ * \brief Computes shape and band statistics attributes for each label of a label image
+ *
+ * This class streams the whole label image through the
+ * PersistentAttributesFromLabelImageFilter.
+ *
+ * This filter can be used as:
+ * \code
+ * typedef otb::StreamingAttributesFromLabelImageFilter<LabelImageType, VectorImageType> AttributesFilterType;
+ * AttributesFilterType::Pointer attributes = AttributesFilterType::New();
+ * attributes->SetInput(labelReader->GetOutput());
+ * attributes->SetFeatureImage(reader->GetOutput());
+ * attributes->Update();
+ * const AttributesFilterType::AttributeNamesType& names = attributes->GetAttributeNames();
+ * for (const auto& row : attributes->GetAttributesTable())
+ * {
+ *   // row.first is the label, row.second[i] the value of names[i]
+ * }
+ * \endcode
+ *
+ * \sa PersistentAttributesFromLabelImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ *
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBLabelMap
+ */
+template <class TLabelImage, class TFeatureImage = otb::VectorImage<float, TLabelImage::ImageDimension>>
+class ITK_EXPORT StreamingAttributesFromLabelImageFilter
+  : public PersistentFilterStreamingDecorator<PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingAttributesFromLabelImageFilter                                                                   Self;
+  typedef PersistentFilterStreamingDecorator<PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>> Superclass;
+  typedef itk::SmartPointer<Self>                                                                                  Pointer;
+  typedef itk::SmartPointer<const Self>                                                                            ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingAttributesFromLabelImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef TLabelImage   LabelImageType;
+  typedef TFeatureImage FeatureImageType;
+
+  typedef typename Superclass::FilterType::LabelPixelType      LabelPixelType;
+  typedef typename Superclass::FilterType::AttributeNamesType  AttributeNamesType;
+  typedef typename Superclass::FilterType::AttributesTableType AttributesTableType;
+
+  /** Set the label image */
+  using Superclass::SetInput;
+  void SetInput(const LabelImageType* input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+
+  /** Get the label image */
+  const LabelImageType* GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  /** Set the feature image */
+  void SetFeatureImage(const FeatureImageType* input)
+  {
+    this->GetFilter()->SetFeatureImage(input);
+  }
+
+  /** Get the feature image */
+  const FeatureImageType* GetFeatureImage() const
+  {
+    return this->GetFilter()->GetFeatureImage();
+  }
+
+  /** Set the label ignored by the accumulation */
+  void SetBackgroundValue(LabelPixelType value)
+  {
+    this->GetFilter()->SetBackgroundValue(value);
+  }
+
+  /** Get the label ignored by the accumulation */
+  LabelPixelType GetBackgroundValue() const
+  {
+    return this->GetFilter()->GetBackgroundValue();
+  }
+
+  /** Names of the attributes, in the order of the table values */
+  const AttributeNamesType& GetAttributeNames() const
+  {
+    return this->GetFilter()->GetAttributeNames();
+  }
+
+  /** Attribute values of each label */
+  const AttributesTableType& GetAttributesTable() const
+  {
+    return this->GetFilter()->GetAttributesTable();
+  }
+
+protected:
+  /** Constructor */
+  StreamingAttributesFromLabelImageFilter()
+  {
+  }
+  /** Destructor */
+  ~StreamingAttributesFromLabelImageFilter() override
+  {
+  }
+
+private:
+  StreamingAttributesFromLabelImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingAttributesFromLabelImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,501 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingAttributesFromLabelImageFilter_hxx
+#define otbStreamingAttributesFromLabelImageFilter_hxx
+
+#include "otbStreamingAttributesFromLabelImageFilter.h"
+#include "itkConstNeighborhoodIterator.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkProgressReporter.h"
+#include "itkGeometryUtilities.h"
+#include "itkMath.h"
+#include "vnl/algo/vnl_symmetric_eigensystem.h"
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+namespace otb
+{
+
+template <class TLabelImage, class TFeatureImage>
+PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::AttributesAccumulator::AttributesAccumulator(const IndexType& idx,
+                                                                                                                   unsigned int     nbBands)
+  : m_Count(0),
+    m_SizeOnBorder(0),
+    m_Min(idx),
+    m_Max(idx),
+    m_DiagonalIntercepts(0),
+    m_BandSum(nbBands, 0.),
+    m_BandSum2(nbBands, 0.),
+    m_BandSum3(nbBands, 0.),
+    m_BandSum4(nbBands, 0.),
+    m_BandMin(nbBands, itk::NumericTraits<double>::max()),
+    m_BandMax(nbBands, itk::NumericTraits<double>::NonpositiveMin())
+{
+  m_Sum.Fill(0.);
+  m_SqSum.Fill(0.);
+  m_Intercepts.Fill(0);
+}
+
+template <class TLabelImage, class TFeatureImage>
+void PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::AttributesAccumulator::Merge(const AttributesAccumulator& other)
+{
+  m_Count += other.m_Count;
+  m_SizeOnBorder += other.m_SizeOnBorder;
+  m_Sum += other.m_Sum;
+  m_SqSum += other.m_SqSum;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    m_Min[dim] = std::min(m_Min[dim], other.m_Min[dim]);
+    m_Max[dim] = std::max(m_Max[dim], other.m_Max[dim]);
+    m_Intercepts[dim] += other.m_Intercepts[dim];
+  }
+  m_DiagonalIntercepts += other.m_DiagonalIntercepts;
+  for (unsigned int band = 0; band < m_BandSum.size(); ++band)
+  {
+    m_BandSum[band] += other.m_BandSum[band];
+    m_BandSum2[band] += other.m_BandSum2[band];
+    m_BandSum3[band] += other.m_BandSum3[band];
+    m_BandSum4[band] += other.m_BandSum4[band];
+    m_BandMin[band] = std::min(m_BandMin[band], other.m_BandMin[band]);
+    m_BandMax[band] = std::max(m_BandMax[band], other.m_BandMax[band]);
+  }
+}
+
+template <class TLabelImage, class TFeatureImage>
+PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::PersistentAttributesFromLabelImageFilter()
+  : m_BackgroundValue(itk::NumericTraits<LabelPixelType>::ZeroValue())
+{
+  this->Reset();
+}
+
+template <class TLabelImage, class TFeatureImage>
+void PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::SetFeatureImage(const FeatureImageType* image)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->itk::ProcessObject::SetNthInput(1, const_cast<FeatureImageType*>(image));
+}
+
+template <class TLabelImage, class TFeatureImage>
+const typename PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::FeatureImageType*
+PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::GetFeatureImage() const
+{
+  if (this->GetNumberOfInputs() < 2)
+  {
+    return nullptr;
+  }
+  return static_cast<const FeatureImageType*>(this->itk::ProcessObject::GetInput(1));
+}
+
+template <class TLabelImage, class TFeatureImage>
+unsigned int PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::GetNumberOfBands() const
+{
+  const FeatureImageType* featureImage = this->GetFeatureImage();
+  return featureImage ? featureImage->GetNumberOfComponentsPerPixel() : 0;
+}
+
+template <class TLabelImage, class TFeatureImage>
+void PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::AllocateOutputs()
+{
+  // Nothing to allocate: the output image is not intended to be used
+}
+
+template <class TLabelImage, class TFeatureImage>
+void PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+
+    const FeatureImageType* featureImage = this->GetFeatureImage();
+    if (featureImage && featureImage->GetLargestPossibleRegion() != this->GetInput()->GetLargestPossibleRegion())
+    {
+      itkExceptionMacro(<< "Label image and feature image have different largest regions: " << this->GetInput()->GetLargestPossibleRegion() << " and "
+                        << featureImage->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TLabelImage, class TFeatureImage>
+void PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::GenerateInputRequestedRegion()
+{
+  const RegionType& outputRegion = this->GetOutput()->GetRequestedRegion();
+
+  // The perimeter needs the neighbours of the processed pixels
+  LabelImageType* labelImage = const_cast<LabelImageType*>(this->GetInput());
+  if (labelImage)
+  {
+    RegionType inputRegion = outputRegion;
+    inputRegion.PadByRadius(1);
+    inputRegion.Crop(labelImage->GetLargestPossibleRegion());
+    labelImage->SetRequestedRegion(inputRegion);
+  }
+
+  FeatureImageType* featureImage = const_cast<FeatureImageType*>(this->GetFeatureImage());
+  if (featureImage)
+  {
+    featureImage->SetRequestedRegion(outputRegion);
+  }
+}
+
+template <class TLabelImage, class TFeatureImage>
+void PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::Reset()
+{
+  m_AccumulatorMaps.clear();
+  m_AccumulatorMaps.resize(this->GetNumberOfThreads());
+  m_AttributeNames.clear();
+  m_AttributesTable.clear();
+}
+
+template <class TLabelImage, class TFeatureImage>
+void PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::ThreadedGenerateData(const RegionType& outputRegionForThread,
+                                                                                                itk::ThreadIdType threadId)
+{
+  const LabelImageType*   labelImage   = this->GetInput();
+  const FeatureImageType* featureImage = this->GetFeatureImage();
+  const unsigned int      nbBands      = this->GetNumberOfBands();
+  const RegionType&       largest      = labelImage->GetLargestPossibleRegion();
+  const IndexType         borderMin    = largest.GetIndex();
+  const IndexType         borderMax    = largest.GetUpperIndex();
+
+  typedef itk::ConstNeighborhoodIterator<LabelImageType> NeighborhoodIteratorType;
+  typename NeighborhoodIteratorType::RadiusType          radius;
+  radius.Fill(1);
+  NeighborhoodIteratorType it(radius, labelImage, outputRegionForThread);
+
+  // Neighbours along each axis, then the diagonals which are only used in 2D
+  std::vector<std::vector<unsigned int>> axisNeighbors(ImageDimension);
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    typename NeighborhoodIteratorType::OffsetType offset;
+    offset.Fill(0);
+    offset[dim] = -1;
+    axisNeighbors[dim].push_back(it.GetNeighborhoodIndex(offset));
+    offset[dim] = 1;
+    axisNeighbors[dim].push_back(it.GetNeighborhoodIndex(offset));
+  }
+  std::vector<unsigned int> diagonalNeighbors;
+  if (ImageDimension == 2)
+  {
+    for (int dx = -1; dx <= 1; dx += 2)
+    {
+      for (int dy = -1; dy <= 1; dy += 2)
+      {
+        typename NeighborhoodIteratorType::OffsetType offset;
+        offset[0] = dx;
+        offset[1] = dy;
+        diagonalNeighbors.push_back(it.GetNeighborhoodIndex(offset));
+      }
+    }
+  }
+
+  itk::ImageRegionConstIterator<FeatureImageType> featureIt;
+  if (featureImage)
+  {
+    featureIt = itk::ImageRegionConstIterator<FeatureImageType>(featureImage, outputRegionForThread);
+    featureIt.GoToBegin();
+  }
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+  AccumulatorMapType&   accumulators = m_AccumulatorMaps[threadId];
+
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const LabelPixelType label = it.GetCenterPixel();
+    if (label != m_BackgroundValue)
+    {
+      const IndexType idx   = it.GetIndex();
+      auto            accIt = accumulators.find(label);
+      if (accIt == accumulators.end())
+      {
+        accIt = accumulators.emplace(label, AttributesAccumulator(idx, nbBands)).first;
+      }
+      AttributesAccumulator& acc = accIt->second;
+
+      ++acc.m_Count;
+
+      typename LabelImageType::PointType point;
+      labelImage->TransformIndexToPhysicalPoint(idx, point);
+      bool onBorder = false;
+      for (unsigned int i = 0; i < ImageDimension; ++i)
+      {
+        acc.m_Sum[i] += point[i];
+        for (unsigned int j = 0; j < ImageDimension; ++j)
+        {
+          acc.m_SqSum[i][j] += point[i] * point[j];
+        }
+        acc.m_Min[i] = std::min(acc.m_Min[i], idx[i]);
+        acc.m_Max[i] = std::max(acc.m_Max[i], idx[i]);
+        onBorder     = onBorder || idx[i] == borderMin[i] || idx[i] == borderMax[i];
+      }
+      if (onBorder)
+      {
+        ++acc.m_SizeOnBorder;
+      }
+
+      // Intercepts: neighbours out of the image belong to another object
+      bool inBounds;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        for (unsigned int n : axisNeighbors[dim])
+        {
+          const LabelPixelType neighbor = it.GetPixel(n, inBounds);
+          if (!inBounds || neighbor != label)
+          {
+            ++acc.m_Intercepts[dim];
+          }
+        }
+      }
+      for (unsigned int n : diagonalNeighbors)
+      {
+        const LabelPixelType neighbor = it.GetPixel(n, inBounds);
+        if (!inBounds || neighbor != label)
+        {
+          ++acc.m_DiagonalIntercepts;
+        }
+      }
+
+      if (featureImage)
+      {
+        const typename FeatureImageType::PixelType& value = featureIt.Get();
+        for (unsigned int band = 0; band < nbBands; ++band)
+        {
+          const double v  = value[band];
+          const double v2 = v * v;
+          acc.m_BandSum[band] += v;
+          acc.m_BandSum2[band] += v2;
+          acc.m_BandSum3[band] += v2 * v;
+          acc.m_BandSum4[band] += v2 * v2;
+          acc.m_BandMin[band] = std::min(acc.m_BandMin[band], v);
+          acc.m_BandMax[band] = std::max(acc.m_BandMax[band], v);
+        }
+      }
+    }
+
+    if (featureImage)
+    {
+      ++featureIt;
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <class TLabelImage, class TFeatureImage>
+void PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::Synthetize()
+{
+  // Merge the thread accumulators
+  AccumulatorMapType merged;
+  for (auto& threadAccumulators : m_AccumulatorMaps)
+  {
+    for (auto& acc : threadAccumulators)
+    {
+      auto mergedIt = merged.find(acc.first);
+      if (mergedIt == merged.end())
+      {
+        merged.emplace(acc.first, std::move(acc.second));
+      }
+      else
+      {
+        mergedIt->second.Merge(acc.second);
+      }
+    }
+    threadAccumulators.clear();
+  }
+
+  const unsigned int nbBands = this->GetNumberOfBands();
+
+  // Attribute names, following the label map attribute filters
+  m_AttributeNames.clear();
+  m_AttributeNames.push_back("SHAPE::Size");
+  m_AttributeNames.push_back("SHAPE::PhysicalSize");
+  m_AttributeNames.push_back("SHAPE::SizeOnBorder");
+  m_AttributeNames.push_back("SHAPE::Perimeter");
+  m_AttributeNames.push_back("SHAPE::Roundness");
+  m_AttributeNames.push_back("SHAPE::Elongation");
+  m_AttributeNames.push_back("SHAPE::EquivalentRadius");
+  m_AttributeNames.push_back("SHAPE::EquivalentPerimeter");
+  m_AttributeNames.push_back("SHAPE::RegionElongation");
+  m_AttributeNames.push_back("SHAPE::RegionRatio");
+  std::ostringstream oss;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    for (const char* name : {"RegionIndex", "RegionSize", "PhysicalCentroid", "PrincipalMoments"})
+    {
+      oss.str("");
+      oss << "SHAPE::" << name << dim;
+      m_AttributeNames.push_back(oss.str());
+    }
+  }
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    for (const char* name : {"Mean", "Variance", "Skewness", "Kurtosis", "Minimum", "Maximum", "Sum", "Sigma"})
+    {
+      oss.str("");
+      oss << "STATS::Band" << band + 1 << "::" << name; // [1..N] convention in feature naming
+      m_AttributeNames.push_back(oss.str());
+    }
+  }
+
+  typename LabelImageType::SpacingType spacing      = this->GetInput()->GetSignedSpacing();
+  double                               sizePerPixel = 1.;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    spacing[dim] = std::abs(spacing[dim]);
+    sizePerPixel *= spacing[dim];
+  }
+
+  m_AttributesTable.clear();
+  m_AttributesTable.reserve(merged.size());
+  for (const auto& entry : merged)
+  {
+    const AttributesAccumulator& acc  = entry.second;
+    const double                 size = acc.m_Count;
+
+    typename LabelImageType::PointType centroid;
+    MatrixType                         centralMoments;
+    IndexType                          regionIndex = acc.m_Min;
+    typename LabelImageType::SizeType  regionSize;
+    double                             minSize = itk::NumericTraits<double>::max();
+    double                             maxSize = itk::NumericTraits<double>::NonpositiveMin();
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      centroid[i]   = acc.m_Sum[i] / size;
+      regionSize[i] = acc.m_Max[i] - acc.m_Min[i] + 1;
+      minSize       = std::min(regionSize[i] * spacing[i], minSize);
+      maxSize       = std::max(regionSize[i] * spacing[i], maxSize);
+    }
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      for (unsigned int j = 0; j < ImageDimension; ++j)
+      {
+        centralMoments[i][j] = acc.m_SqSum[i][j] / size - centroid[i] * centroid[j];
+      }
+    }
+
+    vnl_symmetric_eigensystem<double>   eigen(centralMoments.GetVnlMatrix());
+    itk::Vector<double, ImageDimension> principalMoments;
+    for (unsigned int i = 0; i < ImageDimension; ++i)
+    {
+      principalMoments[i] = eigen.D(i, i);
+    }
+    double elongation = 0;
+    if (principalMoments[ImageDimension - 2] != 0)
+    {
+      elongation = std::sqrt(principalMoments[ImageDimension - 1] / principalMoments[ImageDimension - 2]);
+    }
+
+    // Perimeter from the intercept counts, as in ShapeAttributesLabelMapFilter
+    double perimeter = 0.;
+    if (ImageDimension == 2)
+    {
+      perimeter += spacing[1] * acc.m_Intercepts[0] / 2.0;
+      perimeter += spacing[0] * acc.m_Intercepts[1] / 2.0;
+      perimeter += spacing[0] * spacing[1] / spacing.GetNorm() * acc.m_DiagonalIntercepts / 2.0;
+      perimeter *= itk::Math::pi / 4.0;
+    }
+    else
+    {
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        perimeter += sizePerPixel / spacing[dim] * acc.m_Intercepts[dim] / 2.0;
+      }
+      perimeter *= itk::GeometryUtilities::HyperSphereVolume(ImageDimension, 1.0) / itk::GeometryUtilities::HyperSphereVolume(ImageDimension - 1, 1.0);
+    }
+
+    const double physicalSize        = size * sizePerPixel;
+    const double equivalentRadius    = itk::GeometryUtilities::HyperSphereRadiusFromVolume(ImageDimension, physicalSize);
+    const double equivalentPerimeter = itk::GeometryUtilities::HyperSpherePerimeter(ImageDimension, equivalentRadius);
+    RegionType   region(regionIndex, regionSize);
+
+    std::vector<double> values;
+    values.reserve(m_AttributeNames.size());
+    values.push_back(size);
+    values.push_back(physicalSize);
+    values.push_back(acc.m_SizeOnBorder);
+    values.push_back(perimeter);
+    values.push_back(equivalentPerimeter / perimeter);
+    values.push_back(elongation);
+    values.push_back(equivalentRadius);
+    values.push_back(equivalentPerimeter);
+    values.push_back(maxSize / minSize);
+    values.push_back(size / static_cast<double>(region.GetNumberOfPixels()));
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      values.push_back(regionIndex[dim]);
+      values.push_back(regionSize[dim]);
+      values.push_back(centroid[dim]);
+      values.push_back(principalMoments[dim]);
+    }
+
+    // Band statistics, as in StatisticsAttributesLabelMapFilter
+    for (unsigned int band = 0; band < nbBands; ++band)
+    {
+      const double sum      = acc.m_BandSum[band];
+      const double sum2     = acc.m_BandSum2[band];
+      const double sum3     = acc.m_BandSum3[band];
+      const double sum4     = acc.m_BandSum4[band];
+      const double mean     = sum / size;
+      const double variance = (sum2 - (sum * sum / size)) / (size - 1);
+      const double sigma    = std::sqrt(variance);
+      const double mean2    = mean * mean;
+      double       skewness = 0;
+      double       kurtosis = 0;
+
+      const double epsilon = 1E-10;
+      if (std::abs(variance) > epsilon)
+      {
+        skewness = ((sum3 - 3.0 * mean * sum2) / size + 2.0 * mean * mean2) / (variance * sigma);
+        kurtosis = ((sum4 - 4.0 * mean * sum3 + 6.0 * mean2 * sum2) / size - 3.0 * mean2 * mean2) / (variance * variance) - 3.0;
+      }
+
+      values.push_back(mean);
+      values.push_back(variance);
+      values.push_back(skewness);
+      values.push_back(kurtosis);
+      values.push_back(acc.m_BandMin[band]);
+      values.push_back(acc.m_BandMax[band]);
+      values.push_back(sum);
+      values.push_back(sigma);
+    }
+
+    m_AttributesTable.emplace(entry.first, std::move(values));
+  }
+}
+
+template <class TLabelImage, class TFeatureImage>
+void PersistentAttributesFromLabelImageFilter<TLabelImage, TFeatureImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "BackgroundValue: " << static_cast<typename itk::NumericTraits<LabelPixelType>::PrintType>(m_BackgroundValue) << std::endl;
+  os << indent << "Number of labels: " << m_AttributesTable.size() << std::endl;
+}
+
+} // end namespace otb
+
+#endif
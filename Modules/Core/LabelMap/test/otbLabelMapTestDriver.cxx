@@ -31,4 +31,5 @@ void RegisterTests()
   REGISTER_TEST(otbMinMaxAttributesLabelMapFilter);
   REGISTER_TEST(otbNormalizeAttributesLabelMapFilter);
   REGISTER_TEST(otbBandsStatisticsAttributesLabelMapFilter);
+  REGISTER_TEST(otbStreamingAttributesFromLabelImageFilter);
 }
@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbAttributesMapLabelObject.h"
+#include "itkLabelImageToLabelMapFilter.h"
+#include "otbShapeAttributesLabelMapFilter.h"
+#include "otbBandsStatisticsAttributesLabelMapFilter.h"
+#include "otbStreamingAttributesFromLabelImageFilter.h"
+
+#include <algorithm>
+
+// Compare the streamed attributes with the ones computed on a label map
+int otbStreamingAttributesFromLabelImageFilter(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " featureImage labelImage nbStreamDivisions" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  typedef otb::VectorImage<double, 2>                                                   VectorImageType;
+  typedef otb::Image<unsigned int, 2>                                                   LabelImageType;
+  typedef otb::AttributesMapLabelObject<unsigned int, 2, double>                        LabelObjectType;
+  typedef itk::LabelMap<LabelObjectType>                                                LabelMapType;
+  typedef otb::ImageFileReader<VectorImageType>                                         ReaderType;
+  typedef otb::ImageFileReader<LabelImageType>                                          LabelReaderType;
+  typedef itk::LabelImageToLabelMapFilter<LabelImageType, LabelMapType>                 LabelMapFilterType;
+  typedef otb::ShapeAttributesLabelMapFilter<LabelMapType>                              ShapeFilterType;
+  typedef otb::BandsStatisticsAttributesLabelMapFilter<LabelMapType, VectorImageType>   BandsStatisticsFilterType;
+  typedef otb::StreamingAttributesFromLabelImageFilter<LabelImageType, VectorImageType> AttributesFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  LabelReaderType::Pointer labelReader = LabelReaderType::New();
+  labelReader->SetFileName(argv[2]);
+
+  AttributesFilterType::Pointer attributes = AttributesFilterType::New();
+  attributes->SetInput(labelReader->GetOutput());
+  attributes->SetFeatureImage(reader->GetOutput());
+  attributes->SetBackgroundValue(0);
+  attributes->GetStreamer()->SetNumberOfDivisionsStrippedStreaming(atoi(argv[3]));
+  attributes->Update();
+
+  LabelMapFilterType::Pointer labelMapFilter = LabelMapFilterType::New();
+  labelMapFilter->SetInput(labelReader->GetOutput());
+  labelMapFilter->SetBackgroundValue(0);
+
+  ShapeFilterType::Pointer shape = ShapeFilterType::New();
+  shape->SetInput(labelMapFilter->GetOutput());
+  shape->SetReducedAttributeSet(false);
+  shape->SetComputePerimeter(true);
+
+  BandsStatisticsFilterType::Pointer stats = BandsStatisticsFilterType::New();
+  stats->SetInput(shape->GetOutput());
+  stats->SetFeatureImage(reader->GetOutput());
+  stats->SetReducedAttributeSet(false);
+  stats->Update();
+
+  LabelMapType::Pointer                            labelMap = stats->GetOutput();
+  const AttributesFilterType::AttributeNamesType&  names    = attributes->GetAttributeNames();
+  const AttributesFilterType::AttributesTableType& table    = attributes->GetAttributesTable();
+
+  if (table.size() != labelMap->GetNumberOfLabelObjects())
+  {
+    std::cerr << "Found " << table.size() << " labels, expected " << labelMap->GetNumberOfLabelObjects() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (LabelMapType::Iterator it(labelMap); !it.IsAtEnd(); ++it)
+  {
+    auto row = table.find(it.GetLabel());
+    if (row == table.end())
+    {
+      std::cerr << "Label " << it.GetLabel() << " is missing" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    const LabelObjectType*   labelObject = it.GetLabelObject();
+    std::vector<std::string> available   = labelObject->GetAvailableAttributes();
+    for (unsigned int i = 0; i < names.size(); ++i)
+    {
+      if (std::find(available.begin(), available.end(), names[i]) == available.end())
+      {
+        continue;
+      }
+      const double expected = labelObject->GetAttribute(names[i].c_str());
+      const double value    = row->second[i];
+      if (std::abs(value - expected) > 1e-6 * std::max(1., std::abs(expected)))
+      {
+        std::cerr << "Label " << it.GetLabel() << ": " << names[i] << " is " << value << ", expected " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
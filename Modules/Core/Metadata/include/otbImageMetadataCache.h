@@ -0,0 +1,118 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageMetadataCache_h
+#define otbImageMetadataCache_h
+
+#include <list>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "OTBMetadataExport.h"
+#include "otbImageMetadata.h"
+
+namespace otb
+{
+
+/** \class ImageMetadataCache
+ *
+ * \brief Process wide cache of the ImageMetadata parsed from products
+ *
+ * Parsing the metadata of a product (e.g. the annotation files of a
+ * Sentinel-1 product, or the DIMAP file of a Pleiades product) is done
+ * each time a reader generates its output information, and applications
+ * often instantiate several readers on the same file. The readers store
+ * the ImageMetadata they parse here, and look for it before parsing.
+ *
+ * An entry is identified by a key (the file name given to the reader,
+ * with its extended filename) and by the files it was parsed from. It is
+ * only returned if none of these files has been modified since it was
+ * stored (same modification time and size). The least recently used entries are dropped when the cache is
+ * full.
+ *
+ * \ingroup OTBMetadata
+ */
+class OTBMetadata_EXPORT ImageMetadataCache
+{
+public:
+  /** Return the process wide cache */
+  static ImageMetadataCache& GetInstance();
+
+  /** Copy the metadata stored for key into imd. Returns false if there
+   * is none, or if one of the files has been modified since */
+  bool Get(const std::string& key, const std::vector<std::string>& files, ImageMetadata& imd);
+
+  /** Store the metadata parsed from files for key. Does nothing if one
+   * of the files does not exist (e.g. a GDAL virtual path), as its
+   * modifications could not be detected */
+  void Set(const std::string& key, const std::vector<std::string>& files, const ImageMetadata& imd);
+
+  /** Set the maximum number of entries (16 by default). 0 disables the
+   * cache */
+  void SetMaximumNumberOfEntries(std::size_t n);
+
+  std::size_t GetMaximumNumberOfEntries() const;
+
+  std::size_t GetNumberOfEntries() const;
+
+  /** Drop all the entries */
+  void Clear();
+
+private:
+  ImageMetadataCache();
+  ~ImageMetadataCache() = default;
+  ImageMetadataCache(const ImageMetadataCache&) = delete;
+  ImageMetadataCache& operator=(const ImageMetadataCache&) = delete;
+
+  /** Modification time and size of a file */
+  struct FileStamp
+  {
+    std::string   Name;
+    long int      ModifiedTime;
+    unsigned long Length;
+
+    bool operator==(const FileStamp& other) const
+    {
+      return Name == other.Name && ModifiedTime == other.ModifiedTime && Length == other.Length;
+    }
+  };
+
+  /** Stamps of the files, false if one does not exist */
+  static bool GetStamps(const std::vector<std::string>& files, std::vector<FileStamp>& stamps);
+
+  struct Entry
+  {
+    std::string            Key;
+    std::vector<FileStamp> Files;
+    ImageMetadata          Metadata;
+  };
+
+  /** Entries, most recently used first */
+  std::list<Entry> m_Entries;
+
+  std::size_t m_MaximumNumberOfEntries;
+
+  mutable std::mutex m_Mutex;
+};
+
+} // end namespace otb
+
+#endif
@@ -79,6 +79,7 @@ extern OTBMetadata_EXPORT char const* TileHintY;
 
 extern OTBMetadata_EXPORT char const* NoDataValueAvailable;
 extern OTBMetadata_EXPORT char const* NoDataValue;
+extern OTBMetadata_EXPORT char const* NoDataBufferedRegion;
 
 extern OTBMetadata_EXPORT char const* DataType;
 
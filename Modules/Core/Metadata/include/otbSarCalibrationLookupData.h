@@ -68,6 +68,17 @@ public:
     return 1.0;
   }
 
+  /** Fill values with the lookup values of nbValues consecutive pixels of line y,
+   * starting at column x. Subclasses can override it to share the per-line
+   * part of the interpolation. */
+  virtual void GetLineValues(const IndexValueType x, const IndexValueType y, unsigned int nbValues, double* values) const
+  {
+    for (unsigned int i = 0; i < nbValues; ++i)
+    {
+      values[i] = this->GetValue(x + i, y);
+    }
+  }
+
   void SetType(short t)
   {
     m_Type = t;
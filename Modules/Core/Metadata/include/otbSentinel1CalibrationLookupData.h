@@ -76,6 +76,8 @@ public:
 
   double GetValue(const IndexValueType x, const IndexValueType y) const override;
 
+  void GetLineValues(const IndexValueType x, const IndexValueType y, unsigned int nbValues, double* values) const override;
+
   int GetVectorIndex(int y) const;
 
   int GetPixelIndex(int x, const Sentinel1CalibrationStruct& calVec) const;
@@ -94,6 +94,9 @@ public:
   /** Compute noise contribution for a given pixel */
   double GetValue(const IndexValueType x, const IndexValueType y) const override;
 
+  /** Compute noise contribution for nbValues consecutive pixels of a line */
+  void GetLineValues(const IndexValueType x, const IndexValueType y, unsigned int nbValues, double* values) const override;
+
 protected:
   Sentinel1ThermalNoiseLookupData() : m_FirstLineTime(0.), m_LastLineTime(0.) {m_FirstLineTime = 1.;};
   ~Sentinel1ThermalNoiseLookupData() = default;
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageMetadataCache.h"
+#include "itksys/SystemTools.hxx"
+
+namespace otb
+{
+
+ImageMetadataCache& ImageMetadataCache::GetInstance()
+{
+  static ImageMetadataCache instance;
+  return instance;
+}
+
+ImageMetadataCache::ImageMetadataCache() : m_MaximumNumberOfEntries(16)
+{
+}
+
+bool ImageMetadataCache::Get(const std::string& key, const std::vector<std::string>& files, ImageMetadata& imd)
+{
+  std::vector<FileStamp> stamps;
+  if (!GetStamps(files, stamps))
+  {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  for (auto it = m_Entries.begin(); it != m_Entries.end(); ++it)
+  {
+    if (it->Key != key)
+    {
+      continue;
+    }
+    if (it->Files != stamps)
+    {
+      // Parsed from other files, or from an older version
+      m_Entries.erase(it);
+      return false;
+    }
+    m_Entries.splice(m_Entries.begin(), m_Entries, it);
+    imd = it->Metadata;
+    return true;
+  }
+  return false;
+}
+
+void ImageMetadataCache::Set(const std::string& key, const std::vector<std::string>& files, const ImageMetadata& imd)
+{
+  Entry entry;
+  if (!GetStamps(files, entry.Files))
+  {
+    return;
+  }
+  entry.Key      = key;
+  entry.Metadata = imd;
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_MaximumNumberOfEntries == 0)
+  {
+    return;
+  }
+  m_Entries.remove_if([&key](const Entry& e) { return e.Key == key; });
+  m_Entries.push_front(std::move(entry));
+  if (m_Entries.size() > m_MaximumNumberOfEntries)
+  {
+    m_Entries.resize(m_MaximumNumberOfEntries);
+  }
+}
+
+void ImageMetadataCache::SetMaximumNumberOfEntries(std::size_t n)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_MaximumNumberOfEntries = n;
+  if (m_Entries.size() > n)
+  {
+    m_Entries.resize(n);
+  }
+}
+
+std::size_t ImageMetadataCache::GetMaximumNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_MaximumNumberOfEntries;
+}
+
+std::size_t ImageMetadataCache::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+void ImageMetadataCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+}
+
+bool ImageMetadataCache::GetStamps(const std::vector<std::string>& files, std::vector<FileStamp>& stamps)
+{
+  stamps.clear();
+  for (const auto& file : files)
+  {
+    if (!itksys::SystemTools::FileExists(file, true))
+    {
+      return false;
+    }
+    stamps.push_back({file, itksys::SystemTools::ModifiedTime(file), itksys::SystemTools::FileLength(file)});
+  }
+  return true;
+}
+
+} // end namespace otb
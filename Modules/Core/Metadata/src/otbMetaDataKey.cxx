@@ -65,6 +65,7 @@ char const* TileHintY = "TileHintY";
 
 char const* NoDataValueAvailable = "NoDataValueAvailable";
 char const* NoDataValue          = "NoDataValue";
+char const* NoDataBufferedRegion = "NoDataBufferedRegion";
 
 char const* DataType = "DataType";
 
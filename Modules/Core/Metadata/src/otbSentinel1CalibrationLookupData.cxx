@@ -53,6 +53,37 @@ double Sentinel1CalibrationLookupData::GetValue(const IndexValueType x, const In
   return lutVal;
 }
 
+void Sentinel1CalibrationLookupData::GetLineValues(const IndexValueType x, const IndexValueType y, unsigned int nbValues, double* values) const
+{
+  if (nbValues == 0)
+  {
+    return;
+  }
+
+  // The calibration vectors and the azimuth weight only depend on the line
+  const int calVecIdx = GetVectorIndex(y);
+  assert(calVecIdx >= 0 && calVecIdx < count - 1);
+  const Sentinel1CalibrationStruct& vec0   = calibrationVectorList[calVecIdx];
+  const Sentinel1CalibrationStruct& vec1   = calibrationVectorList[calVecIdx + 1];
+  const double                      azTime = firstLineTime + y * lineTimeInterval;
+  const double                      muY    = (azTime - vec0.timeMJD) / vec1.deltaMJD;
+
+  // Columns are increasing: the pixel index is walked instead of searched
+  const int size     = vec0.pixels.size();
+  int       pixelIdx = GetPixelIndex(x, vec0);
+  for (unsigned int i = 0; i < nbValues; ++i)
+  {
+    const IndexValueType currentX = x + i;
+    while (pixelIdx < size - 2 && currentX >= vec0.pixels[pixelIdx + 1])
+    {
+      ++pixelIdx;
+    }
+    const double muX = (currentX - vec0.pixels[pixelIdx]) / vec0.deltaPixels[pixelIdx + 1];
+    values[i] =
+        (1 - muY) * ((1 - muX) * vec0.vect[pixelIdx] + muX * vec0.vect[pixelIdx + 1]) + muY * ((1 - muX) * vec1.vect[pixelIdx] + muX * vec1.vect[pixelIdx + 1]);
+  }
+}
+
 int Sentinel1CalibrationLookupData::GetVectorIndex(int y) const
 {
   for (int i = 1; i < count; i++)
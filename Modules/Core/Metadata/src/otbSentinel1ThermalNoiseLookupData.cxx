@@ -47,6 +47,78 @@ double Sentinel1ThermalNoiseLookupData::GetValue(const IndexValueType x, const I
   return GetRangeNoise(x,y) * GetAzimuthNoise(x,y);
 }
 
+void Sentinel1ThermalNoiseLookupData::GetLineValues(const IndexValueType x, const IndexValueType y, unsigned int nbValues, double* values) const
+{
+  if (nbValues == 0)
+  {
+    return;
+  }
+
+  std::vector<double> rangeNoise(nbValues, 1.);
+  if (m_RangeCount)
+  {
+    const auto vecIdx = GetRangeVectorIndex(y);
+    assert(vecIdx >= 0 && vecIdx < m_RangeCount - 1);
+
+    const auto& vec0 = m_RangeNoiseVectorList[vecIdx];
+    const auto& vec1 = m_RangeNoiseVectorList[vecIdx + 1];
+
+    const auto azTime = m_FirstLineTime + y * m_LineTimeInterval;
+    const auto muY = (azTime - vec0.timeMJD) / vec1.deltaMJD;
+
+    // Columns are increasing: the pixel index is walked instead of searched
+    const int size = vec0.pixels.size();
+    int pixelIdx = GetPixelIndex(x, vec0.pixels);
+    for (unsigned int i = 0; i < nbValues; ++i)
+    {
+      const IndexValueType currentX = x + i;
+      while (pixelIdx < size - 2 && currentX >= vec0.pixels[pixelIdx + 1])
+      {
+        ++pixelIdx;
+      }
+      const double muX = (currentX - vec0.pixels[pixelIdx]) / vec0.deltaPixels[pixelIdx + 1];
+      rangeNoise[i] =
+          (1 - muY) * ((1 - muX) * vec0.vect[pixelIdx] + muX * vec0.vect[pixelIdx + 1]) + muY * ((1 - muX) * vec1.vect[pixelIdx] + muX * vec1.vect[pixelIdx + 1]);
+    }
+  }
+
+  if (m_AzimuthCount)
+  {
+    // The azimuth noise of a block only depends on the line: evaluate it once
+    // for each block crossing the line, in the order used by GetAzimuthVectorIndex
+    std::vector<int> blocks;
+    std::vector<double> blockNoise;
+    for (int j = 0; j < m_AzimuthCount; j++)
+    {
+      const auto & vec = m_AzimuthNoiseVectorList[j];
+      if (y >= vec.firstAzimuthLine && y <= vec.lastAzimuthLine)
+      {
+        const auto pixelIdx = GetPixelIndex(y, vec.lines);
+        blocks.push_back(j);
+        blockNoise.push_back(vec.vect[pixelIdx] + (vec.vect[pixelIdx + 1] - vec.vect[pixelIdx]) *
+          (static_cast<double>(y - vec.lines[pixelIdx]) / static_cast<double>(vec.lines[pixelIdx+1] - vec.lines[pixelIdx])));
+      }
+    }
+
+    for (unsigned int i = 0; i < nbValues; ++i)
+    {
+      const IndexValueType currentX = x + i;
+      std::size_t k = 0;
+      while (k < blocks.size() && (currentX < m_AzimuthNoiseVectorList[blocks[k]].firstRangeSample
+                                   || currentX > m_AzimuthNoiseVectorList[blocks[k]].lastRangeSample))
+      {
+        ++k;
+      }
+      const double azimuthNoise = k < blocks.size() ? blockNoise[k] : GetAzimuthNoise(currentX, y);
+      values[i] = rangeNoise[i] * azimuthNoise;
+    }
+  }
+  else
+  {
+    std::copy(rangeNoise.begin(), rangeNoise.end(), values);
+  }
+}
+
 double Sentinel1ThermalNoiseLookupData::GetRangeNoise(const IndexValueType x, const IndexValueType y) const
 {
   if (m_RangeCount)
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbImageMetadataCache.h"
+#include "otbMacro.h"
+#include <fstream>
+
+int otbImageMetadataCacheTest(int itkNotUsed(argc), char* argv[])
+{
+  const std::string file(argv[1]);
+  {
+    std::ofstream ofs(file);
+    ofs << "product";
+  }
+
+  otb::ImageMetadataCache& cache = otb::ImageMetadataCache::GetInstance();
+  cache.Clear();
+  cache.SetMaximumNumberOfEntries(2);
+
+  otb::ImageMetadata imd;
+  imd.Add(otb::MDStr::SensorID, "SENSOR");
+  const std::vector<std::string> files(1, file);
+  cache.Set(file, files, imd);
+
+  otb::ImageMetadata cached;
+  otbControlConditionTestMacro(!cache.Get(file, files, cached), " metadata not found in the cache");
+  otbControlConditionTestMacro(!cached.Has(otb::MDStr::SensorID) || cached[otb::MDStr::SensorID] != "SENSOR", " wrong metadata returned by the cache");
+  otbControlConditionTestMacro(cache.Get(file + "?&skipcarto=true", files, cached), " metadata found for another key");
+
+  // Files which do not exist are not cached
+  const std::vector<std::string> missing(1, file + ".missing");
+  cache.Set("missing", missing, imd);
+  otbControlConditionTestMacro(cache.GetNumberOfEntries() != 1, " metadata of a missing file cached");
+
+  // The least recently used entry is dropped
+  cache.Set("second", files, imd);
+  cache.Get(file, files, cached);
+  cache.Set("third", files, imd);
+  otbControlConditionTestMacro(cache.GetNumberOfEntries() != 2, " cache larger than its maximum size");
+  otbControlConditionTestMacro(!cache.Get(file, files, cached), " most recently used entry dropped");
+  otbControlConditionTestMacro(cache.Get("second", files, cached), " least recently used entry kept");
+
+  // Modified files invalidate the entry
+  {
+    std::ofstream ofs(file, std::ios::app);
+    ofs << " modified";
+  }
+  otbControlConditionTestMacro(cache.Get(file, files, cached), " metadata of a modified file returned");
+
+  cache.Clear();
+  otbControlConditionTestMacro(cache.GetNumberOfEntries() != 0, " cache not empty after Clear()");
+  return EXIT_SUCCESS;
+}
@@ -36,4 +36,5 @@ void RegisterTests()
   REGISTER_TEST(otbGeomMetadataSupplierTest);
   REGISTER_TEST(otbXMLMetadataSupplierTest);
   REGISTER_TEST(otbSentinel1ThermalNoiseLutTest);
+  REGISTER_TEST(otbImageMetadataCacheTest);
 }
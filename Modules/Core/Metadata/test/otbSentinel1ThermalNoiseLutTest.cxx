@@ -83,5 +83,21 @@ int otbSentinel1ThermalNoiseLutTest(int argc, char* argv[])
     return EXIT_FAILURE;
   }
 
+  // Line evaluation must match the pixel-wise evaluation
+  const unsigned int  width = reader->GetOutput()->GetLargestPossibleRegion().GetSize()[0];
+  std::vector<double> lutLine(width), thermalNoiseLine(width);
+  lut->GetLineValues(0, idx2, width, lutLine.data());
+  thermalNoiseLut->GetLineValues(0, idx2, width, thermalNoiseLine.data());
+
+  for (unsigned int x = 0; x < width; ++x)
+  {
+    if (std::abs(lutLine[x] - lut->GetValue(x, idx2)) > tol || std::abs(thermalNoiseLine[x] - thermalNoiseLut->GetValue(x, idx2)) > tol)
+    {
+      std::cerr << "Line evaluation at [" << x << ", " << idx2 << "]: " << lutLine[x] << ", " << thermalNoiseLine[x]
+                << " does not match the pixel evaluation: " << lut->GetValue(x, idx2) << ", " << thermalNoiseLut->GetValue(x, idx2) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbBlockAlignedStreamingManager_h
+#define otbBlockAlignedStreamingManager_h
+
+#include "otbStreamingManager.h"
+
+namespace otb
+{
+
+/** \class BlockAlignedStreamingManager
+ *  \brief This class computes the divisions needed to stream an image
+ *  by whole blocks of the input file, according to a user-defined
+ *  available RAM.
+ *
+ * This streaming manager uses the TileHint from the
+ * MetaDataDictionary to find out the block size of the input file
+ * if available. Each division is made of an integer number of blocks,
+ * aligned on the block grid of the file, so that no block is read
+ * (and decoded) twice. This is mostly useful for compressed tiled
+ * inputs.
+ *
+ * You can use SetAvailableRAMInMB to set the available RAM. An
+ * estimation of the pipeline memory print will be done, and the
+ * number of divisions will then be computed to fit the available RAM.
+ *
+ * If no tile hint is available, the divisions are square tiles.
+ *
+ * The block grid can also be set with SetBlockSize(), for instance to
+ * align the divisions on the chunks of the output file.
+ *
+ * \sa ImageRegionBlockAlignedSplitter
+ * \sa RAMDrivenAdaptativeStreamingManager
+ * \sa ImageFileWriter
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TImage>
+class ITK_EXPORT BlockAlignedStreamingManager : public StreamingManager<TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef BlockAlignedStreamingManager    Self;
+  typedef StreamingManager<TImage>        Superclass;
+  typedef itk::SmartPointer<Self>         Pointer;
+  typedef itk::SmartPointer<const Self>   ConstPointer;
+
+  typedef TImage                          ImageType;
+  typedef typename Superclass::RegionType RegionType;
+  typedef typename RegionType::SizeType   SizeType;
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Type macro */
+  itkTypeMacro(BlockAlignedStreamingManager, itk::LightObject);
+
+  /** Dimension of input image. */
+  itkStaticConstMacro(ImageDimension, unsigned int, ImageType::ImageDimension);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+
+  /** The number of Megabytes available (if 0, the configuration option is
+    used)*/
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkSetMacro(Bias, double);
+
+  /** The multiplier to apply to the memory print estimation */
+  itkGetConstMacro(Bias, double);
+
+  /** The block grid to align the divisions on. If empty (the default),
+   * the tile hint of the input is used */
+  itkSetMacro(BlockSize, SizeType);
+
+  /** The block grid to align the divisions on */
+  itkGetConstReferenceMacro(BlockSize, SizeType);
+
+  /** Actually computes the stream divisions, according to the specified streaming mode,
+   * eventually using the input parameter to estimate memory consumption */
+  void PrepareStreaming(itk::DataObject* input, const RegionType& region) override;
+
+protected:
+  BlockAlignedStreamingManager();
+  ~BlockAlignedStreamingManager() override;
+
+  /** The number of MegaBytes of RAM available */
+  unsigned int m_AvailableRAMInMB;
+
+  /** The multiplier to apply to the memory print estimation */
+  double m_Bias;
+
+  /** The block grid forced by the user */
+  SizeType m_BlockSize;
+
+private:
+  BlockAlignedStreamingManager(const BlockAlignedStreamingManager&);
+  void operator=(const BlockAlignedStreamingManager&);
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbBlockAlignedStreamingManager.hxx"
+#endif
+
+#endif
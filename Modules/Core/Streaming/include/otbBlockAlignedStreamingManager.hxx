@@ -0,0 +1,80 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbBlockAlignedStreamingManager_hxx
+#define otbBlockAlignedStreamingManager_hxx
+
+#include "otbBlockAlignedStreamingManager.h"
+#include "otbMacro.h"
+#include "otbImageRegionBlockAlignedSplitter.h"
+#include "itkMetaDataObject.h"
+#include "otbMetaDataKey.h"
+
+namespace otb
+{
+
+template <class TImage>
+BlockAlignedStreamingManager<TImage>::BlockAlignedStreamingManager() : m_AvailableRAMInMB(0), m_Bias(1.0)
+{
+  m_BlockSize.Fill(0);
+}
+
+template <class TImage>
+BlockAlignedStreamingManager<TImage>::~BlockAlignedStreamingManager()
+{
+}
+
+template <class TImage>
+void BlockAlignedStreamingManager<TImage>::PrepareStreaming(itk::DataObject* input, const RegionType& region)
+{
+  unsigned long nbDivisions = this->EstimateOptimalNumberOfDivisions(input, region, m_AvailableRAMInMB, m_Bias);
+
+  typename otb::ImageRegionBlockAlignedSplitter<itkGetStaticConstMacro(ImageDimension)>::SizeType blockSize;
+  blockSize.Fill(0);
+
+  unsigned int tileHintX(0), tileHintY(0);
+
+  itk::ExposeMetaData<unsigned int>(input->GetMetaDataDictionary(), MetaDataKey::TileHintX, tileHintX);
+
+  itk::ExposeMetaData<unsigned int>(input->GetMetaDataDictionary(), MetaDataKey::TileHintY, tileHintY);
+
+  blockSize[0] = tileHintX;
+  blockSize[1] = tileHintY;
+
+  if (m_BlockSize[0] != 0 && m_BlockSize[1] != 0)
+  {
+    blockSize = m_BlockSize;
+  }
+
+  typename otb::ImageRegionBlockAlignedSplitter<itkGetStaticConstMacro(ImageDimension)>::Pointer splitter =
+      otb::ImageRegionBlockAlignedSplitter<itkGetStaticConstMacro(ImageDimension)>::New();
+
+  splitter->SetBlockSize(blockSize);
+
+  this->m_Splitter = splitter;
+
+  this->m_ComputedNumberOfSplits = this->m_Splitter->GetNumberOfSplits(region, nbDivisions);
+
+  this->m_Region = region;
+}
+
+} // End namespace otb
+
+#endif
@@ -38,6 +38,10 @@ namespace otb
  *  temporary data. One can access the persistent filter via the GetFilter() method, and
  * StreamingVirtualWriter via the GetStreamer() method.
  *
+ * When OTB runs on several processes (see ProcessGroup) and the persistent
+ * filter supports it, each process streams a part of the splits and
+ * Synthetize() reduces the temporary data of all the processes.
+ *
  * \sa StreamingStatisticsImageFilter
  * \sa StreamingStatisticsVectorImageFilter
  *
@@ -22,9 +22,29 @@
 #define otbPersistentFilterStreamingDecorator_hxx
 
 #include "otbPersistentFilterStreamingDecorator.h"
+#include "otbPersistentImageFilter.h"
 
 namespace otb
 {
+namespace internal
+{
+/** Group of processes sharing the streaming of a persistent filter, null
+ *  when the filter cannot reduce its persistent data */
+template <class TInputImage, class TOutputImage>
+ProcessGroup* DistributeStreaming(PersistentImageFilter<TInputImage, TOutputImage>* filter)
+{
+  ProcessGroup* group = filter->SupportsDistributedStreaming() ? ProcessGroup::GetDefault() : nullptr;
+  filter->SetProcessGroup(group);
+  return group;
+}
+
+/** Filters which are not PersistentImageFilter stream the whole image */
+inline ProcessGroup* DistributeStreaming(itk::ProcessObject*)
+{
+  return nullptr;
+}
+} // End namespace internal
+
 /**
  * Constructor
  */
@@ -48,6 +68,10 @@ void PersistentFilterStreamingDecorator<TFilter>::GenerateData(void)
     }
   */
 
+  // Share the streaming among the processes of the default group if the
+  // filter can reduce its persistent data
+  this->GetStreamer()->SetProcessGroup(internal::DistributeStreaming(this->GetFilter()));
+
   this->GetStreamer()->SetInput(this->GetFilter()->GetOutput());
   this->GetStreamer()->Update();
 
@@ -22,6 +22,7 @@
 #define otbPersistentImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include "otbProcessGroup.h"
 
 namespace otb
 {
@@ -68,6 +69,20 @@ public:
    */
   virtual void Synthetize(void) = 0;
 
+  /**
+   * Whether Synthetize() reduces the persistent data over the processes of
+   * the ProcessGroup, so that they can stream different splits of the image.
+   */
+  virtual bool SupportsDistributedStreaming() const
+  {
+    return false;
+  }
+
+  /** Group of the processes sharing the streaming, null when the whole
+   *  image is streamed by this process */
+  itkSetObjectMacro(ProcessGroup, ProcessGroup);
+  itkGetObjectMacro(ProcessGroup, ProcessGroup);
+
 protected:
   /** Constructor */
   PersistentImageFilter()
@@ -86,6 +101,8 @@ protected:
 private:
   PersistentImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
+
+  ProcessGroup::Pointer m_ProcessGroup;
 };
 } // End namespace otb
 
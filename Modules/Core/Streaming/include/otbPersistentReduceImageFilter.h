@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPersistentReduceImageFilter_h
+#define otbPersistentReduceImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "itkProgressReporter.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentReduceImageFilter
+ *  \brief Base class of the persistent filters reducing their input to
+ *  a single accumulator over multiple updates.
+ *
+ *  Each thread accumulates the pixels of its region into its own copy of
+ *  the accumulator. Copies are padded so that accumulators of different
+ *  threads never share a cache line. Synthetize() merges the thread
+ *  accumulators pairwise (tree reduction), which keeps the merge order
+ *  deterministic and limits the round-off errors of long sums.
+ *
+ *  TAccumulator must be copy constructible and provide:
+ *  \code
+ *  void Accumulate(const PixelType& value, const IndexType& index);
+ *  void Merge(const TAccumulator& other);
+ *  \endcode
+ *  Merge() must keep the current accumulator first in case of ties, so
+ *  that results do not depend on the number of threads.
+ *
+ *  The initial value of the thread accumulators is set with
+ *  SetInitialAccumulator(), before calling Reset(). Subclasses may
+ *  override AccumulateRegion() for a faster loop than the default
+ *  pixel by pixel one.
+ *
+ *  This filter can be used as is to plug a custom reduction in a
+ *  streamed pipeline, through PersistentFilterStreamingDecorator.
+ *
+ * \sa PersistentImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ *
+ * \ingroup OTBStreaming
+ */
+template <class TInputImage, class TAccumulator>
+class ITK_EXPORT PersistentReduceImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef PersistentReduceImageFilter Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentReduceImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                      ImageType;
+  typedef typename TInputImage::Pointer    InputImagePointer;
+  typedef typename TInputImage::RegionType RegionType;
+  typedef typename TInputImage::IndexType  IndexType;
+  typedef typename TInputImage::PixelType  PixelType;
+
+  typedef TAccumulator AccumulatorType;
+
+  /** Set the value the thread accumulators start from */
+  void SetInitialAccumulator(const AccumulatorType& accumulator)
+  {
+    m_InitialAccumulator = accumulator;
+    this->Modified();
+  }
+  itkGetConstReferenceMacro(InitialAccumulator, AccumulatorType);
+
+  /** Get the reduced accumulator, as computed by the last call to
+   * Synthetize() */
+  itkGetConstReferenceMacro(Result, AccumulatorType);
+
+  /** Pass the input through unmodified. Do this by Grafting in the
+   *  AllocateOutputs method.
+   */
+  void AllocateOutputs() override;
+  void GenerateOutputInformation() override;
+  void Synthetize(void) override;
+  void Reset(void) override;
+
+protected:
+  PersistentReduceImageFilter();
+  ~PersistentReduceImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Multi-thread version GenerateData. */
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** Accumulate the pixels of region. The default implementation calls
+   * accumulator.Accumulate() for each pixel */
+  virtual void AccumulateRegion(const RegionType& region, AccumulatorType& accumulator, itk::ProgressReporter& progress);
+
+private:
+  PersistentReduceImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Size of the padding between thread accumulators */
+  static const unsigned int CacheLineSize = 64;
+
+  /** Thread accumulator, padded to avoid false sharing */
+  struct PaddedAccumulator
+  {
+    explicit PaddedAccumulator(const AccumulatorType& accumulator) : Accumulator(accumulator)
+    {
+    }
+    AccumulatorType Accumulator;
+    char            Padding[CacheLineSize];
+  };
+
+  AccumulatorType                m_InitialAccumulator;
+  AccumulatorType                m_Result;
+  std::vector<PaddedAccumulator> m_ThreadAccumulators;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbPersistentReduceImageFilter.hxx"
+#endif
+
+#endif
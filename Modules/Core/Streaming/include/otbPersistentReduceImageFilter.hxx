@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPersistentReduceImageFilter_hxx
+#define otbPersistentReduceImageFilter_hxx
+
+#include "otbPersistentReduceImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+namespace otb
+{
+
+template <class TInputImage, class TAccumulator>
+PersistentReduceImageFilter<TInputImage, TAccumulator>::PersistentReduceImageFilter() : m_InitialAccumulator(), m_Result(), m_ThreadAccumulators()
+{
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReduceImageFilter<TInputImage, TAccumulator>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReduceImageFilter<TInputImage, TAccumulator>::AllocateOutputs()
+{
+  // This is commented to prevent the streaming of the whole image for the first stream strip
+  // It shall not cause any problem because the output image of this filter is not intended to be used.
+  // InputImagePointer image = const_cast< TInputImage * >( this->GetInput() );
+  // this->GraftOutput( image );
+  // Nothing that needs to be allocated for the remaining outputs
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReduceImageFilter<TInputImage, TAccumulator>::Reset()
+{
+  m_ThreadAccumulators.clear();
+  m_ThreadAccumulators.reserve(this->GetNumberOfThreads());
+  for (unsigned int i = 0; i < this->GetNumberOfThreads(); ++i)
+  {
+    m_ThreadAccumulators.emplace_back(m_InitialAccumulator);
+  }
+  m_Result = m_InitialAccumulator;
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReduceImageFilter<TInputImage, TAccumulator>::Synthetize()
+{
+  const std::size_t nbAccumulators = m_ThreadAccumulators.size();
+
+  if (nbAccumulators == 0)
+  {
+    m_Result = m_InitialAccumulator;
+    return;
+  }
+
+  // Merge neighbours, then neighbours of neighbours... The thread
+  // accumulators are left merged, so the result is copied at the end
+  for (std::size_t stride = 1; stride < nbAccumulators; stride *= 2)
+  {
+    for (std::size_t i = 0; i + stride < nbAccumulators; i += 2 * stride)
+    {
+      m_ThreadAccumulators[i].Accumulator.Merge(m_ThreadAccumulators[i + stride].Accumulator);
+    }
+  }
+  m_Result = m_ThreadAccumulators[0].Accumulator;
+
+  // Persistent data are kept in the first accumulator only, so that a
+  // later Synthetize() doesn't count the other ones twice
+  for (std::size_t i = 1; i < nbAccumulators; ++i)
+  {
+    m_ThreadAccumulators[i].Accumulator = m_InitialAccumulator;
+  }
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReduceImageFilter<TInputImage, TAccumulator>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  this->AccumulateRegion(outputRegionForThread, m_ThreadAccumulators[threadId].Accumulator, progress);
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReduceImageFilter<TInputImage, TAccumulator>::AccumulateRegion(const RegionType& region, AccumulatorType& accumulator,
+                                                                              itk::ProgressReporter& progress)
+{
+  itk::ImageRegionConstIteratorWithIndex<TInputImage> it(this->GetInput(), region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    accumulator.Accumulate(it.Get(), it.GetIndex());
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TAccumulator>
+void PersistentReduceImageFilter<TInputImage, TAccumulator>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of thread accumulators: " << m_ThreadAccumulators.size() << std::endl;
+}
+
+} // end namespace otb
+
+#endif
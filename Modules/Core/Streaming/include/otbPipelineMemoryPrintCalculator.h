@@ -28,6 +28,9 @@
 #include "itk_kwiml.h"
 #endif
 #include <set>
+#include <string>
+#include <utility>
+#include <vector>
 #include <iosfwd>
 
 #include "OTBStreamingExport.h"
@@ -56,6 +59,12 @@ namespace otb
  *  memory usage. The optimal number of stream divisions can be
  *  retrieved using the GetOptimalNumberOfStreamDivisions().
  *
+ *  Filters allocating intermediate buffers on top of their outputs
+ *  can declare them with SetIntermediatePrintPerPixel(), as a number
+ *  of bytes per pixel of their first output requested region. Input
+ *  padding needs no declaration: it is part of the requested regions
+ *  computed by the dry run.
+ *
  *  Please note that for now this calculator suffers from the
  *  following limitations:
  *  - DataObject taken into account for memory usage estimation are
@@ -91,6 +100,9 @@ public:
 #endif
   typedef std::set<const ProcessObjectType*> ProcessObjectPointerSetType;
 
+  /** Memory print of each visited process object (outputs and declared intermediate buffers) */
+  typedef std::vector<std::pair<std::string, MemoryPrintType>> ProcessObjectPrintVectorType;
+
   /** Run-time type information (and related methods). */
   itkTypeMacro(PipelineMemoryPrintCalculator, itk::Object);
 
@@ -106,6 +118,12 @@ public:
   itkSetMacro(BiasCorrectionFactor, double);
   itkGetMacro(BiasCorrectionFactor, double);
 
+  /** Set/Get the number of copies of the data to write which are held
+   * in memory on top of the pipeline itself (for instance by a writer
+   * queuing blocks for a background thread, default is 0) */
+  itkSetMacro(NumberOfQueuedOutputBuffers, unsigned int);
+  itkGetMacro(NumberOfQueuedOutputBuffers, unsigned int);
+
   /** Get the optimal number of stream division */
   static unsigned long EstimateOptimalNumberOfStreamDivisions(MemoryPrintType memoryPrint, MemoryPrintType availableMemory);
 
@@ -122,6 +140,23 @@ public:
   /** Evaluate the print (in bytes) of a single data object */
   MemoryPrintType EvaluateDataObjectPrint(DataObjectType* data);
 
+  /** Get the print of each process object visited by the last Compute() call */
+  const ProcessObjectPrintVectorType& GetProcessObjectPrints() const
+  {
+    return m_ProcessObjectPrints;
+  }
+
+  /** Declare the intermediate buffers allocated by a process object, in
+   * bytes per pixel of its first output requested region. The value is
+   * stored in the meta-data dictionary of the process object. */
+  static void SetIntermediatePrintPerPixel(ProcessObjectType* process, double bytesPerPixel);
+
+  /** Get the intermediate print declared for a process object (0 if none) */
+  static double GetIntermediatePrintPerPixel(const ProcessObjectType* process);
+
+  /** Meta-data key of the declared intermediate print */
+  static const std::string IntermediatePrintPerPixelKey;
+
 protected:
   /** Constructor */
   PipelineMemoryPrintCalculator();
@@ -148,8 +183,14 @@ private:
   /** Bias correction factor */
   double m_BiasCorrectionFactor;
 
+  /** Number of queued copies of the data to write */
+  unsigned int m_NumberOfQueuedOutputBuffers;
+
   /** Visited ProcessObject set */
   ProcessObjectPointerSetType m_VisitedProcessObjects;
+
+  /** Print of each visited process object */
+  ProcessObjectPrintVectorType m_ProcessObjectPrints;
 };
 } // end of namespace otb
 
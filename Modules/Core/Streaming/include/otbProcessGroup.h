@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbProcessGroup_h
+#define otbProcessGroup_h
+
+#include "itkLightObject.h"
+#include "itkObjectFactory.h"
+#include "OTBStreamingExport.h"
+
+#include <algorithm>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class ProcessGroup
+ *  \brief Group of processes sharing the streaming of an image
+ *
+ * Persistent filters supporting it (see
+ * PersistentImageFilter::SupportsDistributedStreaming()) can have their
+ * splits streamed by different processes: each process then accumulates a
+ * part of the image, and Synthetize() combines the accumulators of all of
+ * them with the reductions of this class.
+ *
+ * This class does not depend on MPI. The MPIConfig module installs an
+ * implementation as the default group when OTB runs on several MPI
+ * processes. All the reductions are collective: every process of the group
+ * must call them, in the same order.
+ *
+ * \ingroup OTBStreaming
+ */
+class OTBStreaming_EXPORT ProcessGroup : public itk::LightObject
+{
+public:
+  /** Standard class typedefs. */
+  typedef ProcessGroup                  Self;
+  typedef itk::LightObject              Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ProcessGroup, itk::LightObject);
+
+  /** Group of all the processes OTB runs on. Null when OTB runs on a
+   *  single process */
+  static Self* GetDefault();
+
+  /** Set the default group (null to disable distributed streaming) */
+  static void SetDefault(Self* group);
+
+  /** Rank of the calling process in the group */
+  virtual unsigned int GetRank() const = 0;
+
+  /** Number of processes in the group */
+  virtual unsigned int GetSize() const = 0;
+
+  /** Element-wise sum, minimum and maximum of the buffers of all the
+   *  processes. The result replaces the buffer on every process. */
+  virtual void AllReduceSum(double* buffer, std::size_t size) = 0;
+  virtual void AllReduceMin(double* buffer, std::size_t size) = 0;
+  virtual void AllReduceMax(double* buffer, std::size_t size) = 0;
+
+  /** Buffers of all the processes, ordered by rank */
+  virtual std::vector<std::string> AllGather(const std::string& buffer) = 0;
+
+  /** Same reductions on a range of values convertible to double */
+  template <class TIterator>
+  void AllReduceSum(TIterator first, TIterator last)
+  {
+    this->Reduce(first, last, &Self::AllReduceSum);
+  }
+  template <class TIterator>
+  void AllReduceMin(TIterator first, TIterator last)
+  {
+    this->Reduce(first, last, &Self::AllReduceMin);
+  }
+  template <class TIterator>
+  void AllReduceMax(TIterator first, TIterator last)
+  {
+    this->Reduce(first, last, &Self::AllReduceMax);
+  }
+
+protected:
+  ProcessGroup() = default;
+  ~ProcessGroup() override = default;
+
+private:
+  ProcessGroup(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  template <class TIterator>
+  void Reduce(TIterator first, TIterator last, void (Self::*reduction)(double*, std::size_t))
+  {
+    std::vector<double> buffer(first, last);
+    (this->*reduction)(buffer.data(), buffer.size());
+    std::copy(buffer.begin(), buffer.end(), first);
+  }
+};
+
+} // End namespace otb
+
+#endif
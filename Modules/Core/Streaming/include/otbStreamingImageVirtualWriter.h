@@ -24,6 +24,7 @@
 #include "itkMacro.h"
 #include "itkImageToImageFilter.h"
 #include "otbStreamingManager.h"
+#include "otbProcessGroup.h"
 #include "itkFastMutexLock.h"
 
 namespace otb
@@ -138,6 +139,11 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /** Set/Get the group of processes sharing the streaming. When set, each
+   *  process only streams the divisions assigned to its rank */
+  itkSetObjectMacro(ProcessGroup, ProcessGroup);
+  itkGetObjectMacro(ProcessGroup, ProcessGroup);
+
   /** Override Update() from ProcessObject
    *  This filter does not produce an output */
   void Update() override;
@@ -189,6 +195,8 @@ private:
 
   StreamingManagerPointerType m_StreamingManager;
 
+  ProcessGroup::Pointer m_ProcessGroup;
+
   bool          m_IsObserving;
   unsigned long m_ObserverID;
 
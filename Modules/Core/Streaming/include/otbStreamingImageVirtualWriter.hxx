@@ -207,6 +207,10 @@ void StreamingImageVirtualWriter<TInputImage>::GenerateData(void)
   otbLogMacro(Info, << "Estimation will be performed in " << m_NumberOfDivisions << " blocks of " << firstSplitSize[0] << "x" << firstSplitSize[1]
                     << " pixels");
 
+  // Divisions are assigned in turn to the processes of the group
+  const unsigned int rank    = m_ProcessGroup ? m_ProcessGroup->GetRank() : 0;
+  const unsigned int nbProcs = m_ProcessGroup ? m_ProcessGroup->GetSize() : 1;
+
 
   /**
    * Loop over the number of pieces, execute the upstream pipeline on each
@@ -216,6 +220,10 @@ void StreamingImageVirtualWriter<TInputImage>::GenerateData(void)
   for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
        m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
   {
+    if (m_CurrentDivision % nbProcs != rank)
+    {
+      continue;
+    }
     streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
     // inputPtr->ReleaseData();
     // inputPtr->SetRequestedRegion(streamRegion);
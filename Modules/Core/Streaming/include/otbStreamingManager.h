@@ -64,6 +64,7 @@ public:
   typedef typename ImageType::RegionType        RegionType;
   typedef typename RegionType::IndexType        IndexType;
   typedef typename RegionType::SizeType         SizeType;
+  typedef typename SizeType::SizeValueType      SizeValueType;
   typedef typename ImageType::InternalPixelType PixelType;
 
   typedef otb::PipelineMemoryPrintCalculator::MemoryPrintType MemoryPrintType;
@@ -94,12 +95,21 @@ public:
   itkSetMacro(DefaultRAM, MemoryPrintType);
   itkGetMacro(DefaultRAM, MemoryPrintType);
 
+  /** Set/Get the number of output blocks held in memory while waiting to
+   *  be written. They are accounted for when estimating the number of
+   *  divisions from the available RAM */
+  itkSetMacro(NumberOfQueuedOutputBuffers, unsigned int);
+  itkGetMacro(NumberOfQueuedOutputBuffers, unsigned int);
+
 protected:
   StreamingManager();
   ~StreamingManager() override;
 
   virtual unsigned int EstimateOptimalNumberOfDivisions(itk::DataObject* input, const RegionType& region, MemoryPrintType availableRAMInMB, double bias = 1.0);
 
+  /** Estimate the print per pixel (in bytes, without bias) of a square block holding 1/numberOfDivisions of the region */
+  double EstimateBlockPrintPerPixel(ImageType* input, const RegionType& region, unsigned int numberOfDivisions);
+
   /** The number of splits generated by the splitter */
   unsigned int m_ComputedNumberOfSplits;
 
@@ -121,6 +131,9 @@ private:
 
   /** Default available RAM in MB */
   MemoryPrintType m_DefaultRAM;
+
+  /** Number of output blocks waiting to be written */
+  unsigned int m_NumberOfQueuedOutputBuffers;
 };
 
 } // End namespace otb
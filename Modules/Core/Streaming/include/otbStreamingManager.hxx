@@ -23,13 +23,17 @@
 
 #include "otbStreamingManager.h"
 #include "otbConfigurationManager.h"
+#include "otbImageBufferPool.h"
 #include "itkExtractImageFilter.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace otb
 {
 
 template <class TImage>
-StreamingManager<TImage>::StreamingManager() : m_ComputedNumberOfSplits(0), m_DefaultRAM(0)
+StreamingManager<TImage>::StreamingManager() : m_ComputedNumberOfSplits(0), m_DefaultRAM(0), m_NumberOfQueuedOutputBuffers(0)
 {
 }
 
@@ -61,6 +65,14 @@ typename StreamingManager<TImage>::MemoryPrintType StreamingManager<TImage>::Get
       availableRAMInBytes = 1024 * 1024 * ConfigurationManager::GetMaxRAMHint();
     }
   }
+
+  // Released buffers kept by the pool are not part of the pipeline
+  // memory print: leave them room, but no more than half of the RAM
+  const ImageBufferPool& pool = ImageBufferPool::GetInstance();
+  if (pool.IsEnabled())
+  {
+    availableRAMInBytes -= std::min<MemoryPrintType>(pool.GetMaximumSize(), availableRAMInBytes / 2);
+  }
   return availableRAMInBytes;
 }
 
@@ -72,6 +84,7 @@ unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::Dat
 
   otb::PipelineMemoryPrintCalculator::Pointer memoryPrintCalculator;
   memoryPrintCalculator = otb::PipelineMemoryPrintCalculator::New();
+  memoryPrintCalculator->SetNumberOfQueuedOutputBuffers(m_NumberOfQueuedOutputBuffers);
 
   // Trick to avoid having the resampler compute the whole
   // displacement field
@@ -79,6 +92,8 @@ unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::Dat
   ImageType* inputImage        = dynamic_cast<ImageType*>(input);
 
   MemoryPrintType pipelineMemoryPrint;
+  // Print per pixel of the small region, without bias
+  double probePrintPerPixel = 0;
   if (inputImage)
   {
 
@@ -131,6 +146,8 @@ unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::Dat
       // remove the contribution of the ExtractImageFilter
       MemoryPrintType extractContrib = memoryPrintCalculator->EvaluateDataObjectPrint(extractFilter->GetOutput());
 
+      probePrintPerPixel = (pipelineMemoryPrint / (regionTrickFactor * bias) - extractContrib) / smallRegion.GetNumberOfPixels();
+
       pipelineMemoryPrint -= extractContrib;
     }
   }
@@ -147,6 +164,43 @@ unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::Dat
 
   unsigned int optimalNumberOfDivisions = otb::PipelineMemoryPrintCalculator::EstimateOptimalNumberOfStreamDivisions(pipelineMemoryPrint, availableRAMInBytes);
 
+  // The small region estimate misjudges the halos of filters requesting
+  // padded inputs, which weigh less on larger blocks. Measure the print per
+  // pixel of a block of the planned size and rescale the estimate.
+  const unsigned int    maxNumberOfRefinements = 3;
+  const MemoryPrintType probeMemoryPrint       = pipelineMemoryPrint;
+  for (unsigned int refinement = 0; probePrintPerPixel > 0 && optimalNumberOfDivisions > 1 && refinement < maxNumberOfRefinements; ++refinement)
+  {
+    const double blockPrintPerPixel = this->EstimateBlockPrintPerPixel(inputImage, region, optimalNumberOfDivisions);
+    if (blockPrintPerPixel <= 0)
+    {
+      break;
+    }
+    MemoryPrintType refinedMemoryPrint       = static_cast<MemoryPrintType>(probeMemoryPrint * (blockPrintPerPixel / probePrintPerPixel));
+    unsigned int    refinedNumberOfDivisions = std::max<unsigned long>(
+        1, otb::PipelineMemoryPrintCalculator::EstimateOptimalNumberOfStreamDivisions(refinedMemoryPrint, availableRAMInBytes));
+    otbLogMacro(Debug, << "Estimated memory from blocks of 1/" << optimalNumberOfDivisions << " of the region: "
+                       << refinedMemoryPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte << " MB, refined partitioning: " << refinedNumberOfDivisions
+                       << " blocks");
+    if (refinedNumberOfDivisions == optimalNumberOfDivisions)
+    {
+      break;
+    }
+    // Fewer divisions would not be checked anymore: only accept more
+    if (refinedNumberOfDivisions < optimalNumberOfDivisions && refinement == maxNumberOfRefinements - 1)
+    {
+      break;
+    }
+    optimalNumberOfDivisions = refinedNumberOfDivisions;
+    pipelineMemoryPrint      = refinedMemoryPrint;
+  }
+
+  for (const auto& processPrint : memoryPrintCalculator->GetProcessObjectPrints())
+  {
+    otbLogMacro(Debug, << "Memory print on the small region of " << processPrint.first << ": "
+                       << processPrint.second * otb::PipelineMemoryPrintCalculator::ByteToMegabyte << " MB");
+  }
+
   otbLogMacro(Info, << "Estimated memory for full processing: " << pipelineMemoryPrint * otb::PipelineMemoryPrintCalculator::ByteToMegabyte
                     << "MB (avail.: " << availableRAMInBytes * otb::PipelineMemoryPrintCalculator::ByteToMegabyte
                     << " MB), optimal image partitioning: " << optimalNumberOfDivisions << " blocks");
@@ -154,6 +208,35 @@ unsigned int StreamingManager<TImage>::EstimateOptimalNumberOfDivisions(itk::Dat
   return optimalNumberOfDivisions;
 }
 
+template <class TImage>
+double StreamingManager<TImage>::EstimateBlockPrintPerPixel(ImageType* input, const RegionType& region, unsigned int numberOfDivisions)
+{
+  // Square block with 1/numberOfDivisions of the pixels, at the center of the region
+  const double blockSide = std::sqrt(static_cast<double>(region.GetNumberOfPixels()) / numberOfDivisions);
+  SizeType     blockSize;
+  IndexType    blockIndex;
+  for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+  {
+    blockSize[dim]  = std::max<SizeValueType>(1, std::min<SizeValueType>(region.GetSize()[dim], std::ceil(blockSide)));
+    blockIndex[dim] = region.GetIndex()[dim] + (region.GetSize()[dim] - blockSize[dim]) / 2;
+  }
+  RegionType blockRegion(blockIndex, blockSize);
+
+  typedef itk::ExtractImageFilter<ImageType, ImageType> ExtractFilterType;
+  typename ExtractFilterType::Pointer extractFilter = ExtractFilterType::New();
+  extractFilter->SetInput(input);
+  extractFilter->SetExtractionRegion(blockRegion);
+
+  otb::PipelineMemoryPrintCalculator::Pointer memoryPrintCalculator = otb::PipelineMemoryPrintCalculator::New();
+  memoryPrintCalculator->SetNumberOfQueuedOutputBuffers(m_NumberOfQueuedOutputBuffers);
+  memoryPrintCalculator->SetDataToWrite(extractFilter->GetOutput());
+  memoryPrintCalculator->Compute();
+
+  // remove the contribution of the ExtractImageFilter
+  const double extractContrib = memoryPrintCalculator->EvaluateDataObjectPrint(extractFilter->GetOutput());
+  return (memoryPrintCalculator->GetMemoryPrint() - extractContrib) / blockRegion.GetNumberOfPixels();
+}
+
 template <class TImage>
 unsigned int StreamingManager<TImage>::GetNumberOfSplits()
 {
@@ -30,13 +30,15 @@
 #include "otbVectorImage.h"
 #include "itkFixedArray.h"
 #include "otbImageList.h"
+#include "itkMetaDataObject.h"
 
 namespace otb
 {
 const double PipelineMemoryPrintCalculator::ByteToMegabyte = 1. / std::pow(2.0, 20);
 const double PipelineMemoryPrintCalculator::MegabyteToByte = std::pow(2.0, 20);
+const std::string PipelineMemoryPrintCalculator::IntermediatePrintPerPixelKey = "IntermediatePrintPerPixel";
 
-PipelineMemoryPrintCalculator::PipelineMemoryPrintCalculator() : m_MemoryPrint(0), m_DataToWrite(nullptr), m_BiasCorrectionFactor(1.), m_VisitedProcessObjects()
+PipelineMemoryPrintCalculator::PipelineMemoryPrintCalculator() : m_MemoryPrint(0), m_DataToWrite(nullptr), m_BiasCorrectionFactor(1.), m_NumberOfQueuedOutputBuffers(0), m_VisitedProcessObjects()
 {
 }
 
@@ -44,6 +46,20 @@ PipelineMemoryPrintCalculator::~PipelineMemoryPrintCalculator()
 {
 }
 
+// [static]
+void PipelineMemoryPrintCalculator::SetIntermediatePrintPerPixel(ProcessObjectType* process, double bytesPerPixel)
+{
+  itk::EncapsulateMetaData<double>(process->GetMetaDataDictionary(), IntermediatePrintPerPixelKey, bytesPerPixel);
+}
+
+// [static]
+double PipelineMemoryPrintCalculator::GetIntermediatePrintPerPixel(const ProcessObjectType* process)
+{
+  double bytesPerPixel = 0.;
+  itk::ExposeMetaData<double>(process->GetMetaDataDictionary(), IntermediatePrintPerPixelKey, bytesPerPixel);
+  return bytesPerPixel;
+}
+
 // [static]
 unsigned long PipelineMemoryPrintCalculator::EstimateOptimalNumberOfStreamDivisions(MemoryPrintType memoryPrint, MemoryPrintType availableMemory)
 {
@@ -61,12 +77,14 @@ void PipelineMemoryPrintCalculator::PrintSelf(std::ostream& os, itk::Indent inde
   os << indent << "Data to write:                      " << m_DataToWrite << std::endl;
   os << indent << "Memory print of whole pipeline:     " << m_MemoryPrint * ByteToMegabyte << " Mb" << std::endl;
   os << indent << "Bias correction factor applied:     " << m_BiasCorrectionFactor << std::endl;
+  os << indent << "Number of queued output buffers:    " << m_NumberOfQueuedOutputBuffers << std::endl;
 }
 
 void PipelineMemoryPrintCalculator::Compute(bool propagate)
 {
   // Clear the visited process objects set
   m_VisitedProcessObjects.clear();
+  m_ProcessObjectPrints.clear();
 
   // Dry run of pipeline synchronisation
   if (propagate)
@@ -91,6 +109,12 @@ void PipelineMemoryPrintCalculator::Compute(bool propagate)
     m_MemoryPrint = EvaluateDataObjectPrint(m_DataToWrite);
   }
 
+  // Account for the copies of the output waiting to be written
+  if (m_NumberOfQueuedOutputBuffers > 0)
+  {
+    m_MemoryPrint += m_NumberOfQueuedOutputBuffers * EvaluateDataObjectPrint(m_DataToWrite);
+  }
+
   // Apply bias correction factor
   m_MemoryPrint *= m_BiasCorrectionFactor;
 }
@@ -142,12 +166,27 @@ PipelineMemoryPrintCalculator::MemoryPrintType PipelineMemoryPrintCalculator::Ev
   ProcessObjectType::DataObjectPointerArray outputs = process->GetOutputs();
 
   // Now, evaluate the current object print
+  MemoryPrintType processPrint = 0;
   for (unsigned int i = 0; i < process->GetNumberOfOutputs(); ++i)
   {
     MemoryPrintType localPrint = this->EvaluateDataObjectPrint(outputs[i]);
-    print += localPrint;
+    processPrint += localPrint;
+  }
+
+  // Add the intermediate buffers declared by the process object
+  const double bytesPerPixel = GetIntermediatePrintPerPixel(process);
+  if (bytesPerPixel > 0 && process->GetNumberOfOutputs() > 0)
+  {
+    itk::ImageBase<2>* output = dynamic_cast<itk::ImageBase<2>*>(outputs[0].GetPointer());
+    if (output)
+    {
+      processPrint += static_cast<MemoryPrintType>(bytesPerPixel * output->GetRequestedRegion().GetNumberOfPixels());
+    }
   }
 
+  m_ProcessObjectPrints.push_back(std::make_pair(std::string(process->GetNameOfClass()), processPrint));
+  print += processPrint;
+
   // Finally, return the total print
   return print;
 }
@@ -57,3 +57,46 @@ int otbPipelineMemoryPrintCalculatorTest(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbPipelineMemoryPrintCalculatorIntermediatePrint(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::VectorImage<double, 2> VectorImageType;
+  typedef otb::Image<double, 2>       ImageType;
+  typedef otb::VectorImageToIntensityImageFilter<VectorImageType, ImageType> IntensityImageFilterType;
+
+  VectorImageType::RegionType region;
+  region.SetIndex(0, 0);
+  region.SetIndex(1, 0);
+  region.SetSize(0, 100);
+  region.SetSize(1, 50);
+  VectorImageType::Pointer image = VectorImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(4);
+
+  IntensityImageFilterType::Pointer intensity = IntensityImageFilterType::New();
+  intensity->SetInput(image);
+
+  otb::PipelineMemoryPrintCalculator::Pointer calculator = otb::PipelineMemoryPrintCalculator::New();
+  calculator->SetDataToWrite(intensity->GetOutput());
+  calculator->Compute();
+  otb::PipelineMemoryPrintCalculator::MemoryPrintType print = calculator->GetMemoryPrint();
+
+  // Declare 3 bytes per output pixel of intermediate buffers
+  otb::PipelineMemoryPrintCalculator::SetIntermediatePrintPerPixel(intensity, 3.);
+  calculator->Compute();
+  otb::PipelineMemoryPrintCalculator::MemoryPrintType printWithIntermediate = calculator->GetMemoryPrint();
+
+  if (printWithIntermediate - print != 3 * region.GetNumberOfPixels())
+  {
+    std::cerr << "Intermediate print not accounted for: " << print << " bytes without, " << printWithIntermediate << " bytes with" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const auto& prints = calculator->GetProcessObjectPrints();
+  if (prints.size() != 1 || prints[0].first != intensity->GetNameOfClass() || prints[0].second != (sizeof(double) + 3) * region.GetNumberOfPixels())
+  {
+    std::cerr << "Unexpected print per process object" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
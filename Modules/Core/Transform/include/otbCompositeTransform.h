@@ -114,6 +114,9 @@ public:
   /**  Method to transform a point. */
   SecondTransformOutputPointType TransformPoint(const FirstTransformInputPointType&) const override;
 
+  /**  Method to transform n points, each transform processing all the points at once. */
+  void TransformPoints(const FirstTransformInputPointType* in, SecondTransformOutputPointType* out, std::size_t n) const override;
+
   /**  Method to transform a vector. */
   //  virtual OutputVectorType TransformVector(const InputVectorType &) const;
 
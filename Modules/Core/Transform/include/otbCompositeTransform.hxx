@@ -26,6 +26,8 @@
 #include "otbGenericMapProjection.h"
 #include "itkIdentityTransform.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -55,6 +57,15 @@ CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensi
   return outputPoint;
 }
 
+template <class TFirstTransform, class TSecondTransform, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(
+    const FirstTransformInputPointType* in, SecondTransformOutputPointType* out, std::size_t n) const
+{
+  std::vector<FirstTransformOutputPointType> geoPoints(n);
+  otb::TransformPoints(m_FirstTransform.GetPointer(), in, geoPoints.data(), n);
+  otb::TransformPoints(m_SecondTransform.GetPointer(), geoPoints.data(), out, n);
+}
+
 /*template<class TFirstTransform, class TSecondTransform, class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
   typename CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>::OutputVectorType
   CompositeTransform<TFirstTransform, TSecondTransform, TScalarType, NInputDimensions, NOutputDimensions>
@@ -159,6 +159,9 @@ public:
 
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  /** Method to transform n points at once */
+  void TransformPoints(const InputPointType* in, OutputPointType* out, std::size_t n) const override;
+
   virtual void InstantiateTransform();
 
   // Get inverse methods
@@ -31,6 +31,8 @@
 #include "ogr_spatialref.h"
 #include "otbSensorTransformFactory.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -238,6 +240,29 @@ GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformP
   return outputPoint;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(const InputPointType* in, OutputPointType* out,
+                                                                                           std::size_t n) const
+{
+  // Apply input origin/spacing
+  std::vector<InputPointType> inputPoints(in, in + n);
+  for (auto& inputPoint : inputPoints)
+  {
+    inputPoint[0] = inputPoint[0] * m_InputSpacing[0] + m_InputOrigin[0];
+    inputPoint[1] = inputPoint[1] * m_InputSpacing[1] + m_InputOrigin[1];
+  }
+
+  // Transform points
+  this->GetTransform()->TransformPoints(inputPoints.data(), out, n);
+
+  // Apply output origin/spacing
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    out[i][0] = (out[i][0] - m_OutputOrigin[0]) / m_OutputSpacing[0];
+    out[i][1] = (out[i][1] - m_OutputOrigin[1]) / m_OutputSpacing[1];
+  }
+}
+
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 bool GenericRSTransform<TScalarType, NInputDimensions, NOutputDimensions>::GetInverse(Self* inverseTransform) const
 {
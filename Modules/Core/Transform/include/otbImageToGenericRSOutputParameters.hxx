@@ -115,12 +115,15 @@ void ImageToGenericRSOutputParameters<TImage>::EstimateOutputImageExtent()
   vindex.push_back(index3);
   vindex.push_back(index4);
 
+  // The corners are transformed in a single batch, so that sensor
+  // models solve them together
+  std::vector<PointType> vphysical(vindex.size());
   for (unsigned int i = 0; i < vindex.size(); ++i)
   {
-    PointType physicalPoint;
-    m_Input->TransformContinuousIndexToPhysicalPoint(vindex[i], physicalPoint);
-    voutput.push_back(invTransform->TransformPoint(physicalPoint));
+    m_Input->TransformContinuousIndexToPhysicalPoint(vindex[i], vphysical[i]);
   }
+  voutput.resize(vphysical.size());
+  invTransform->TransformPoints(vphysical.data(), voutput.data(), vphysical.size());
 
   // Compute the boundaries
   double minX = voutput[0][0];
@@ -189,9 +192,12 @@ void ImageToGenericRSOutputParameters<TImage>::EstimateOutputSpacing()
   oY[1] -= sizeCartoY;
 
   // Transform back into the input image
-  PointType io  = m_Transform->TransformPoint(o);
-  PointType ioX = m_Transform->TransformPoint(oX);
-  PointType ioY = m_Transform->TransformPoint(oY);
+  const PointType corners[3] = {o, oX, oY};
+  PointType       inputCorners[3];
+  m_Transform->TransformPoints(corners, inputCorners, 3);
+  const PointType& io  = inputCorners[0];
+  const PointType& ioX = inputCorners[1];
+  const PointType& ioY = inputCorners[2];
 
   // Transform to indices
   IndexType ioIndex, ioXIndex, ioYIndex;
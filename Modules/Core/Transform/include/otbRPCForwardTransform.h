@@ -32,6 +32,15 @@ namespace otb
  *  class computes a forward transformation of a point in the sensor
  *  geometry (i, j) to a geographic point in (lat, long)
  *
+ *  The RPC model maps ground points to the sensor geometry, so this
+ *  direction has to be solved iteratively. When the model is set, a
+ *  second order polynomial giving the ground position from the sensor
+ *  position and the height is fitted on the model, over its height
+ *  range. Points are seeded with this polynomial and refined by Newton
+ *  iterations, using the Jacobian of the fitted polynomial, on whole
+ *  batches of points at once. Points that do not converge are solved
+ *  by GDAL.
+ *
  * \ingroup OTBTransform
  */
 template <class TScalarType, unsigned int NInputDimensions = 3, unsigned int NOutputDimensions = 2>
@@ -59,9 +68,19 @@ public:
   itkStaticConstMacro(InputSpaceDimension, unsigned int, NInputDimensions);
   itkStaticConstMacro(OutputSpaceDimension, unsigned int, NOutputDimensions);
 
+  /*
+   * Provide the ImageMetadata in order to set the model.
+   * Return false if model not valid.
+   */
+  bool SetMetadata(const ImageMetadata& imd) override;
+
   /**  Method to transform a point. */
   OutputPointType TransformPoint(const InputPointType& point) const override;
 
+  /** Method to transform n points, refining the seeds of all the
+   * points together. */
+  void TransformPoints(const InputPointType* in, OutputPointType* out, std::size_t n) const override;
+
   RPCForwardTransform();
   ~RPCForwardTransform() = default;
 
@@ -71,6 +90,23 @@ protected:
 private:
   RPCForwardTransform(const Self&) = delete;
   void operator=(const Self&) = delete;
+
+  /** Number of terms of the seed polynomials */
+  static constexpr unsigned int NumberOfSeedCoefficients = 10;
+
+  /** Fit the seed polynomials on the model */
+  bool FitSeed();
+
+  /** Evaluate the seed polynomials at normalized sensor coordinates
+   * (column, row, height). The Jacobian is the derivative of the
+   * normalized (longitude, latitude) with respect to the normalized
+   * (column, row), stored row by row. */
+  void EvaluateSeed(double column, double row, double height, double& lon, double& lat, double (&jacobian)[4]) const;
+
+  /** Seed polynomials, giving the normalized longitude and latitude */
+  double m_SeedLonCoefficients[NumberOfSeedCoefficients];
+  double m_SeedLatCoefficients[NumberOfSeedCoefficients];
+  bool   m_SeedValid;
 };
 
 }
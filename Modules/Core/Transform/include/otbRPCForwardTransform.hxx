@@ -22,17 +22,136 @@
 #define otbRPCForwardTransform_hxx
 
 #include "otbRPCForwardTransform.h"
+#include "otbDEMHandler.h"
+
+#include "vnl/vnl_matrix.h"
+#include "vnl/vnl_vector.h"
+#include "vnl/algo/vnl_svd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace otb
 {
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
-RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::RPCForwardTransform() : Superclass(TransformDirection::FORWARD)
+RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::RPCForwardTransform()
+  : Superclass(TransformDirection::FORWARD), m_SeedValid(false)
 {}
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+bool RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::SetMetadata(const ImageMetadata& imd)
+{
+  m_SeedValid = false;
+  if (!Superclass::SetMetadata(imd))
+    return false;
+
+  // The output height is only known when the input height is given
+  if (NOutputDimensions == 2 || NInputDimensions > 2)
+    m_SeedValid = this->FitSeed();
+  return true;
+}
+
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+bool RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::FitSeed()
+{
+  const Projection::RPCParam& rpc = *this->m_RPCParam;
+  if (rpc.LonScale == 0. || rpc.LatScale == 0. || rpc.SampleScale == 0. || rpc.LineScale == 0.)
+    return false;
+
+  // Sample the model over its validity domain, with absolute heights
+  const unsigned int nbPlanimetricSamples = 11;
+  const unsigned int nbHeightSamples      = 5;
+  const unsigned int nbSamples            = nbPlanimetricSamples * nbPlanimetricSamples * nbHeightSamples;
+
+  std::vector<double> lon(nbSamples), lat(nbSamples), height(nbSamples);
+  std::vector<double> x(nbSamples), y(nbSamples), z(nbSamples);
+  unsigned int        k = 0;
+  for (unsigned int h = 0; h < nbHeightSamples; ++h)
+  {
+    for (unsigned int j = 0; j < nbPlanimetricSamples; ++j)
+    {
+      for (unsigned int i = 0; i < nbPlanimetricSamples; ++i, ++k)
+      {
+        lon[k]    = -1. + 2. * i / (nbPlanimetricSamples - 1);
+        lat[k]    = -1. + 2. * j / (nbPlanimetricSamples - 1);
+        height[k] = -1. + 2. * h / (nbHeightSamples - 1);
+        x[k]      = lon[k] * rpc.LonScale + rpc.LonOffset;
+        y[k]      = lat[k] * rpc.LatScale + rpc.LatOffset;
+        z[k]      = height[k] * rpc.HeightScale + rpc.HeightOffset;
+      }
+    }
+  }
+
+  GDALRPCTransformer sampler(rpc, false);
+  if (!sampler.InverseTransform(x.data(), y.data(), z.data(), static_cast<int>(nbSamples)))
+    return false;
+
+  // Least squares fit of the normalized ground position on the
+  // normalized sensor position and height
+  vnl_matrix<double> design(nbSamples, NumberOfSeedCoefficients);
+  vnl_vector<double> lonValues(nbSamples), latValues(nbSamples);
+  for (k = 0; k < nbSamples; ++k)
+  {
+    const double c = (x[k] - rpc.SampleOffset) / rpc.SampleScale;
+    const double r = (y[k] - rpc.LineOffset) / rpc.LineScale;
+    const double h = height[k];
+    if (!std::isfinite(c) || !std::isfinite(r))
+      return false;
+
+    const double terms[NumberOfSeedCoefficients] = {1., c, r, h, c * r, c * h, r * h, c * c, r * r, h * h};
+    for (unsigned int t = 0; t < NumberOfSeedCoefficients; ++t)
+      design(k, t) = terms[t];
+    lonValues[k] = lon[k];
+    latValues[k] = lat[k];
+  }
+
+  vnl_svd<double> svd(design);
+  if (svd.rank() < NumberOfSeedCoefficients)
+    return false;
+
+  const vnl_vector<double> lonCoefficients = svd.solve(lonValues);
+  const vnl_vector<double> latCoefficients = svd.solve(latValues);
+  for (unsigned int t = 0; t < NumberOfSeedCoefficients; ++t)
+  {
+    m_SeedLonCoefficients[t] = lonCoefficients[t];
+    m_SeedLatCoefficients[t] = latCoefficients[t];
+  }
+  return true;
+}
+
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::EvaluateSeed(double c, double r, double h, double& lon, double& lat,
+                                                                                         double (&jacobian)[4]) const
+{
+  const double terms[NumberOfSeedCoefficients]    = {1., c, r, h, c * r, c * h, r * h, c * c, r * r, h * h};
+  const double dTermsDc[NumberOfSeedCoefficients] = {0., 1., 0., 0., r, h, 0., 2. * c, 0., 0.};
+  const double dTermsDr[NumberOfSeedCoefficients] = {0., 0., 1., 0., c, 0., h, 0., 2. * r, 0.};
+
+  lon = lat = 0.;
+  jacobian[0] = jacobian[1] = jacobian[2] = jacobian[3] = 0.;
+  for (unsigned int t = 0; t < NumberOfSeedCoefficients; ++t)
+  {
+    lon += m_SeedLonCoefficients[t] * terms[t];
+    lat += m_SeedLatCoefficients[t] * terms[t];
+    jacobian[0] += m_SeedLonCoefficients[t] * dTermsDc[t];
+    jacobian[1] += m_SeedLonCoefficients[t] * dTermsDr[t];
+    jacobian[2] += m_SeedLatCoefficients[t] * dTermsDc[t];
+    jacobian[3] += m_SeedLatCoefficients[t] * dTermsDr[t];
+  }
+}
+
 template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
 typename RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::OutputPointType
 RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoint(const InputPointType& point) const
 {
+  if (m_SeedValid)
+  {
+    OutputPointType pOut;
+    this->TransformPoints(&point, &pOut, 1);
+    return pOut;
+  }
+
   GDALRPCTransformer::PointType zePoint;
   zePoint[0] = static_cast<double>(point[0]);
   zePoint[1] = static_cast<double>(point[1]);
@@ -51,6 +170,109 @@ RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::Transform
   return pOut;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void RPCForwardTransform<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(const InputPointType* in, OutputPointType* out,
+                                                                                            std::size_t n) const
+{
+  if (!m_SeedValid)
+  {
+    Superclass::TransformPoints(in, out, n);
+    return;
+  }
+  if (n == 0)
+    return;
+
+  // Same convergence criteria as the GDAL RPC transformer
+  const double       pixelErrorThreshold = 1e-6;
+  const unsigned int maxIterations       = 40;
+
+  const Projection::RPCParam& rpc = *this->m_RPCParam;
+
+  // Without input height, the DEM is used by the GDAL transformer, and
+  // the seed uses the default height
+  const double defaultHeight = DEMHandler::GetInstance().GetDefaultHeightAboveEllipsoid();
+
+  std::vector<double>      lon(n), lat(n), inputHeight(n);
+  std::vector<double>      jacobians(4 * n);
+  std::vector<std::size_t> active(n), failed;
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    inputHeight[i]      = NInputDimensions > 2 ? static_cast<double>(in[i][2]) : 0.;
+    const double height = NInputDimensions > 2 ? inputHeight[i] : defaultHeight;
+
+    const double c = (static_cast<double>(in[i][0]) - rpc.SampleOffset) / rpc.SampleScale;
+    const double r = (static_cast<double>(in[i][1]) - rpc.LineOffset) / rpc.LineScale;
+    const double h = rpc.HeightScale != 0. ? (height - rpc.HeightOffset) / rpc.HeightScale : 0.;
+
+    double jacobian[4];
+    this->EvaluateSeed(c, r, h, lon[i], lat[i], jacobian);
+    std::copy(jacobian, jacobian + 4, jacobians.begin() + 4 * i);
+    active[i] = i;
+  }
+
+  // Refine all the points which have not converged yet together
+  std::vector<double> x, y, z;
+  for (unsigned int iteration = 0; iteration < maxIterations && !active.empty(); ++iteration)
+  {
+    const std::size_t nbActive = active.size();
+    x.resize(nbActive);
+    y.resize(nbActive);
+    z.resize(nbActive);
+    for (std::size_t k = 0; k < nbActive; ++k)
+    {
+      x[k] = lon[active[k]] * rpc.LonScale + rpc.LonOffset;
+      y[k] = lat[active[k]] * rpc.LatScale + rpc.LatOffset;
+      z[k] = inputHeight[active[k]];
+    }
+
+    if (!this->m_Transformer->InverseTransform(x.data(), y.data(), z.data(), static_cast<int>(nbActive)))
+      break;
+
+    std::size_t nbRemaining = 0;
+    for (std::size_t k = 0; k < nbActive; ++k)
+    {
+      const std::size_t i  = active[k];
+      const double      dc = static_cast<double>(in[i][0]) - x[k];
+      const double      dr = static_cast<double>(in[i][1]) - y[k];
+      if (std::abs(dc) <= pixelErrorThreshold && std::abs(dr) <= pixelErrorThreshold)
+        continue;
+      if (!std::isfinite(dc) || !std::isfinite(dr))
+      {
+        failed.push_back(i);
+        continue;
+      }
+
+      const double* jacobian = &jacobians[4 * i];
+      lon[i] += jacobian[0] * dc / rpc.SampleScale + jacobian[1] * dr / rpc.LineScale;
+      lat[i] += jacobian[2] * dc / rpc.SampleScale + jacobian[3] * dr / rpc.LineScale;
+      active[nbRemaining++] = i;
+    }
+    active.resize(nbRemaining);
+  }
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    out[i][0] = static_cast<TScalarType>(lon[i] * rpc.LonScale + rpc.LonOffset);
+    out[i][1] = static_cast<TScalarType>(lat[i] * rpc.LatScale + rpc.LatOffset);
+    if (NOutputDimensions > 2)
+      out[i][2] = static_cast<TScalarType>(inputHeight[i]);
+  }
+
+  // Points which did not converge are solved by GDAL
+  active.insert(active.end(), failed.begin(), failed.end());
+  if (!active.empty())
+  {
+    std::vector<InputPointType>  remainingIn(active.size());
+    std::vector<OutputPointType> remainingOut(active.size());
+    for (std::size_t k = 0; k < active.size(); ++k)
+      remainingIn[k] = in[active[k]];
+    Superclass::TransformPoints(remainingIn.data(), remainingOut.data(), active.size());
+    for (std::size_t k = 0; k < active.size(); ++k)
+      out[active[k]] = remainingOut[k];
+  }
+}
+
 /**
  * PrintSelf method
  */
@@ -72,6 +72,11 @@ public:
   /** Check model validity */
   bool IsValidSensorModel() const override;
 
+  /** Method to transform n points with a single call to the GDAL RPC
+   * transformer, in the direction of the transform. Throws if a point
+   * can not be transformed. */
+  void TransformPoints(const InputPointType* in, OutputPointType* out, std::size_t n) const override;
+
 protected:
   RPCTransformBase(TransformDirection dir) : Superclass(dir) {};
   ~RPCTransformBase() = default;
@@ -23,6 +23,9 @@
 
 #include "otbRPCTransformBase.h"
 
+#include <stdexcept>
+#include <vector>
+
 namespace otb
 {
 
@@ -54,6 +57,43 @@ bool RPCTransformBase<TScalarType, NInputDimensions, NOutputDimensions>::IsValid
   return m_Transformer != nullptr;
 }
 
+template <class TScalarType, unsigned int NInputDimensions, unsigned int NOutputDimensions>
+void RPCTransformBase<TScalarType, NInputDimensions, NOutputDimensions>::TransformPoints(const InputPointType* in, OutputPointType* out,
+                                                                                         std::size_t n) const
+{
+  if (n == 0)
+    return;
+
+  std::vector<double> x(n), y(n), z(n, 0.);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    x[i] = static_cast<double>(in[i][0]);
+    y[i] = static_cast<double>(in[i][1]);
+    if (NInputDimensions > 2)
+      z[i] = static_cast<double>(in[i][2]);
+  }
+
+  bool success;
+  if (this->m_direction == TransformDirection::FORWARD)
+  {
+    success = this->m_Transformer->ForwardTransform(x.data(), y.data(), z.data(), static_cast<int>(n));
+  }
+  else
+  {
+    success = this->m_Transformer->InverseTransform(x.data(), y.data(), z.data(), static_cast<int>(n));
+  }
+  if (!success)
+    throw std::runtime_error("GDALRPCTransform was not able to process all the points.");
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    out[i][0] = static_cast<TScalarType>(x[i]);
+    out[i][1] = static_cast<TScalarType>(y[i]);
+    if (NOutputDimensions > 2)
+      out[i][2] = static_cast<TScalarType>(z[i]);
+  }
+}
+
 /**
  * PrintSelf method
  */
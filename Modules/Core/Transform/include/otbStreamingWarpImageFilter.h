@@ -37,6 +37,15 @@ namespace otb
  *
  * This security margin is used to stream the input image, making this filter an entirely streamable one.
  *
+ * The input requested region is the bounding box of the input positions of the
+ * requested output pixels: since the displacement field is interpolated
+ * bilinearly, it is computed from the field nodes covered by the output region
+ * and from the crossings of the region border with the field grid lines.
+ *
+ * Output pixels are processed line by line: the position of each pixel in the
+ * displacement field and in the input image is stepped along the line instead
+ * of being transformed from physical coordinates.
+ *
  * If the maximum displacement is wrong, this filter is likely to request data outside of the input image buffered region. In this case, pixels
  * outside the region will be set to Zero according to itk::NumericTraits.
  *
@@ -79,6 +88,9 @@ public:
   typedef typename DisplacementFieldType::Pointer    DisplacementFieldPointerType;
   typedef typename DisplacementFieldType::RegionType DisplacementFieldRegionType;
 
+  typedef itk::ContinuousIndex<double, DisplacementFieldType::ImageDimension> FieldContinuousIndexType;
+  typedef itk::ContinuousIndex<double, InputImageType::ImageDimension>        InputContinuousIndexType;
+
   /** Accessors */
   itkSetMacro(MaximumDisplacement, DisplacementValueType);
   itkGetConstReferenceMacro(MaximumDisplacement, DisplacementValueType);
@@ -117,6 +129,11 @@ private:
   StreamingWarpImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Bilinear interpolation of the displacement field at a continuous index
+   * of the field, clamped to its buffered region as itk::WarpImageFilter does */
+  void EvaluateDisplacementAtContinuousIndex(const DisplacementFieldType* fieldPtr, const FieldContinuousIndexType& index,
+                                             DisplacementValueType& displacement) const;
+
   // Because of itk positive spacing we need this member to be compliant with otb
   // signed spacing
   SpacingType m_OutputSignedSpacing;
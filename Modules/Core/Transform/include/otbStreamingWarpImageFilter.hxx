@@ -23,10 +23,13 @@
 #define otbStreamingWarpImageFilter_hxx
 
 #include "otbStreamingWarpImageFilter.h"
-#include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkMetaDataObject.h"
 #include "otbMetaDataKey.h"
+#include <algorithm>
+#include <vector>
 
 namespace otb
 {
@@ -126,7 +129,7 @@ void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::Ge
   // Avoid extrapolation
   displacementRequestedRegion.PadByRadius(1);
 
-  // crop the input requested region at the input's largest possible region
+    // crop the input requested region at the input's largest possible region
   if (displacementRequestedRegion.Crop(displacementPtr->GetLargestPossibleRegion()))
   {
     displacementPtr->SetRequestedRegion(displacementRequestedRegion);
@@ -156,65 +159,119 @@ void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::Ge
   displacementPtr->PropagateRequestedRegion();
   displacementPtr->UpdateOutputData();
 
-  // Walk the loaded displacement field to derive maximum and minimum
-  itk::ImageRegionIteratorWithIndex<DisplacementFieldType> defIt(displacementPtr, displacementRequestedRegion);
-  defIt.GoToBegin();
-
-  typename InputImageType::PointType currentPoint;
-  typename InputImageType::PointType inputStartPoint, inputEndPoint;
-
-  // Initialise start and end points
-  displacementPtr->TransformIndexToPhysicalPoint(defIt.GetIndex(), currentPoint);
+  // 3) Bound the input positions of the requested output pixels. The
+  // displacement is bilinear within each field cell, and so is the
+  // mapping from output to input positions: its extrema over the output
+  // region are reached at the field nodes inside the region, at the
+  // crossings of the region border with the field grid lines, or at the
+  // region corners. Output pixels falling outside of the field are
+  // padded and do not need any input.
+  typename DisplacementFieldType::IndexType largestFieldStart = displacementPtr->GetLargestPossibleRegion().GetIndex();
+  typename DisplacementFieldType::SizeType  largestFieldSize  = displacementPtr->GetLargestPossibleRegion().GetSize();
+
+  FieldContinuousIndexType fieldStart, fieldEnd;
+  displacementPtr->TransformPhysicalPointToContinuousIndex(outPointStart, fieldStart);
+  displacementPtr->TransformPhysicalPointToContinuousIndex(outPointEnd, fieldEnd);
+
+  std::vector<double> candidates[DisplacementFieldType::ImageDimension];
+  bool                emptyOutput = false;
   for (unsigned int dim = 0; dim < DisplacementFieldType::ImageDimension; ++dim)
   {
-    currentPoint[dim] += defIt.Get()[dim];
+    double lower = std::max(std::min(fieldStart[dim], fieldEnd[dim]), static_cast<double>(largestFieldStart[dim]));
+    double upper = std::min(std::max(fieldStart[dim], fieldEnd[dim]), static_cast<double>(largestFieldStart[dim] + largestFieldSize[dim] - 1));
+    if (lower > upper || outputRequestedRegion.GetSize(dim) == 0)
+    {
+      emptyOutput = true;
+      break;
+    }
+    candidates[dim].push_back(lower);
+    for (double node = std::floor(lower) + 1; node < upper; node += 1.)
+    {
+      candidates[dim].push_back(node);
+    }
+    if (upper > lower)
+    {
+      candidates[dim].push_back(upper);
+    }
   }
-  inputStartPoint = currentPoint;
-  inputEndPoint   = currentPoint;
 
-  ++defIt;
+  typename InputImageType::IndexType inputFinalIndex;
+  typename InputImageType::SizeType  inputFinalSize;
+  inputFinalIndex.Fill(0);
+  inputFinalSize.Fill(0);
 
-  // 3) Now Walk the field and compute the physical bounding box
-  while (!defIt.IsAtEnd())
+  typename InputImageType::RegionType inputRequestedRegion;
+  bool                                emptyInput = emptyOutput;
+
+  if (!emptyOutput)
   {
-    displacementPtr->TransformIndexToPhysicalPoint(defIt.GetIndex(), currentPoint);
-    for (unsigned int dim = 0; dim < DisplacementFieldType::ImageDimension; ++dim)
+    InputContinuousIndexType inputStartIndex, inputEndIndex;
+    bool                     first = true;
+
+    unsigned int position[DisplacementFieldType::ImageDimension] = {};
+    bool         done = false;
+    while (!done)
     {
-      currentPoint[dim] += defIt.Get()[dim];
-      if (inputStartPoint[dim] > currentPoint[dim])
-        inputStartPoint[dim] = currentPoint[dim];
-      if (inputEndPoint[dim] < currentPoint[dim])
-        inputEndPoint[dim] = currentPoint[dim];
-    }
-    ++defIt;
-  }
+      FieldContinuousIndexType fieldIndex;
+      for (unsigned int dim = 0; dim < DisplacementFieldType::ImageDimension; ++dim)
+      {
+        fieldIndex[dim] = candidates[dim][position[dim]];
+      }
 
-  // Convert physical bounding box to requested region
-  typename InputImageType::IndexType inputStartIndex, inputEndIndex;
-  inputPtr->TransformPhysicalPointToIndex(inputStartPoint, inputStartIndex);
-  inputPtr->TransformPhysicalPointToIndex(inputEndPoint, inputEndIndex);
+      DisplacementValueType displacement;
+      this->EvaluateDisplacementAtContinuousIndex(displacementPtr, fieldIndex, displacement);
 
-  typename InputImageType::SizeType  inputFinalSize;
-  typename InputImageType::IndexType inputFinalIndex;
+      typename InputImageType::PointType currentPoint;
+      displacementPtr->TransformContinuousIndexToPhysicalPoint(fieldIndex, currentPoint);
+      for (unsigned int dim = 0; dim < DisplacementFieldType::ImageDimension; ++dim)
+      {
+        currentPoint[dim] += displacement[dim];
+      }
 
-  for (unsigned int dim = 0; dim < DisplacementFieldType::ImageDimension; ++dim)
-  {
-    inputFinalIndex[dim] = std::min(inputStartIndex[dim], inputEndIndex[dim]);
-    inputFinalSize[dim]  = std::max(inputStartIndex[dim], inputEndIndex[dim]) - inputFinalIndex[dim] + 1;
-  }
+      InputContinuousIndexType currentIndex;
+      inputPtr->TransformPhysicalPointToContinuousIndex(currentPoint, currentIndex);
+      for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+      {
+        if (first || currentIndex[dim] < inputStartIndex[dim])
+          inputStartIndex[dim] = currentIndex[dim];
+        if (first || currentIndex[dim] > inputEndIndex[dim])
+          inputEndIndex[dim] = currentIndex[dim];
+      }
+      first = false;
 
-  typename InputImageType::RegionType inputRequestedRegion;
-  inputRequestedRegion.SetIndex(inputFinalIndex);
-  inputRequestedRegion.SetSize(inputFinalSize);
+      done = true;
+      for (unsigned int dim = 0; dim < DisplacementFieldType::ImageDimension; ++dim)
+      {
+        if (++position[dim] < candidates[dim].size())
+        {
+          done = false;
+          break;
+        }
+        position[dim] = 0;
+      }
+    }
+
+    // Convert the continuous bounding box to the nearest pixels
+    for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+    {
+      inputFinalIndex[dim] = itk::Math::RoundHalfIntegerUp<typename InputImageType::IndexValueType>(inputStartIndex[dim]);
+      inputFinalSize[dim]  = itk::Math::RoundHalfIntegerUp<typename InputImageType::IndexValueType>(inputEndIndex[dim]) - inputFinalIndex[dim] + 1;
+    }
+
+    inputRequestedRegion.SetIndex(inputFinalIndex);
+    inputRequestedRegion.SetSize(inputFinalSize);
 
-  // Compute the padding due to the interpolator
-  unsigned int interpolatorRadius = StreamingTraits<typename Superclass::InputImageType>::CalculateNeededRadiusForInterpolator(this->GetInterpolator());
+    // Compute the padding due to the interpolator
+    unsigned int interpolatorRadius = StreamingTraits<typename Superclass::InputImageType>::CalculateNeededRadiusForInterpolator(this->GetInterpolator());
 
-  // pad the input requested region by the operator radius
-  inputRequestedRegion.PadByRadius(interpolatorRadius);
+    // pad the input requested region by the operator radius
+    inputRequestedRegion.PadByRadius(interpolatorRadius);
 
-  // crop the input requested region at the input's largest possible region
-  if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+    // crop the input requested region at the input's largest possible region
+    emptyInput = !inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion());
+  }
+
+  if (!emptyInput)
   {
     inputPtr->SetRequestedRegion(inputRequestedRegion);
   }
@@ -284,16 +341,95 @@ void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::Ge
   itk::EncapsulateMetaData<std::vector<double>>(dict, MetaDataKey::NoDataValue, noDataValue);
 }
 
+template <class TInputImage, class TOutputImage, class TDisplacementField>
+void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::EvaluateDisplacementAtContinuousIndex(const DisplacementFieldType*     fieldPtr,
+                                                                                                                    const FieldContinuousIndexType& index,
+                                                                                                                    DisplacementValueType& displacement) const
+{
+  const unsigned int FieldDimension = DisplacementFieldType::ImageDimension;
+
+  typename DisplacementFieldType::IndexType startIndex = fieldPtr->GetBufferedRegion().GetIndex();
+  typename DisplacementFieldType::IndexType endIndex   = startIndex + fieldPtr->GetBufferedRegion().GetSize();
+
+  typename DisplacementFieldType::IndexType baseIndex;
+  double                                    distance[FieldDimension];
+
+  for (unsigned int dim = 0; dim < FieldDimension; ++dim)
+  {
+    endIndex[dim] -= 1;
+    baseIndex[dim] = itk::Math::Floor<typename DisplacementFieldType::IndexValueType>(index[dim]);
+
+    if (baseIndex[dim] >= startIndex[dim])
+    {
+      if (baseIndex[dim] < endIndex[dim])
+      {
+        distance[dim] = index[dim] - static_cast<double>(baseIndex[dim]);
+      }
+      else
+      {
+        baseIndex[dim] = endIndex[dim];
+        distance[dim]  = 0.0;
+      }
+    }
+    else
+    {
+      baseIndex[dim] = startIndex[dim];
+      distance[dim]  = 0.0;
+    }
+  }
+
+  // Same neighbour walk as itk::WarpImageFilter, so that both evaluations match
+  displacement.Fill(0);
+
+  const unsigned int numberOfNeighbors = 1u << FieldDimension;
+  double             totalOverlap      = 0.0;
+  for (unsigned int counter = 0; counter < numberOfNeighbors; ++counter)
+  {
+    double                                    overlap      = 1.0;
+    unsigned int                              upper        = counter;
+    typename DisplacementFieldType::IndexType neighborIndex;
+
+    for (unsigned int dim = 0; dim < FieldDimension; ++dim)
+    {
+      if (upper & 1)
+      {
+        neighborIndex[dim] = baseIndex[dim] + 1;
+        overlap *= distance[dim];
+      }
+      else
+      {
+        neighborIndex[dim] = baseIndex[dim];
+        overlap *= 1.0 - distance[dim];
+      }
+      upper >>= 1;
+    }
+
+    if (overlap)
+    {
+      const DisplacementValueType& neighbor = fieldPtr->GetPixel(neighborIndex);
+      for (unsigned int k = 0; k < FieldDimension; ++k)
+      {
+        displacement[k] += overlap * neighbor[k];
+      }
+      totalOverlap += overlap;
+    }
+
+    if (totalOverlap == 1.0)
+    {
+      break;
+    }
+  }
+}
+
 template <class TInputImage, class TOutputImage, class TDisplacementField>
 void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
                                                                                                    itk::ThreadIdType threadId)
 {
-  // the superclass itk::WarpImageFilter is doing the actual warping
-  Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+  typedef typename Superclass::InterpolatorType::ContinuousIndexType InterpolatorContinuousIndexType;
 
-  // second pass on the thread region to mask pixels outside the displacement grid
   const PixelType        paddingValue = this->GetEdgePaddingValue();
   OutputImagePointerType outputPtr    = this->GetOutput();
+  const InputImageType*  inputPtr     = this->GetInput();
 
   // ITK 4.13 fix const correctness of GetDisplacementField.
   // Related commit in ITK: https://github.com/InsightSoftwareConsortium/ITK/commit/0070848b91baf69f04893bc3ce85bcf110c3c63a
@@ -301,31 +437,95 @@ void StreamingWarpImageFilter<TInputImage, TOutputImage, TDisplacementField>::Th
   // DisplacementFieldPointerType fieldPtr = this->GetDisplacementField();
   const DisplacementFieldType* fieldPtr = this->GetDisplacementField();
 
+  typename Superclass::InterpolatorType* interpolator = this->GetInterpolator();
 
   DisplacementFieldRegionType defRegion = fieldPtr->GetLargestPossibleRegion();
 
-  itk::ImageRegionIteratorWithIndex<OutputImageType> outputIt(outputPtr, outputRegionForThread);
-  IndexType                                          currentIndex;
-  PointType                                          currentPoint;
-  itk::ContinuousIndex<double, DisplacementFieldType::ImageDimension> contiIndex;
+  // The output, field and input grids are related by affine maps: along
+  // an output line, the field and input continuous indices of the pixels
+  // are stepped by a constant increment, and only the displacement needs
+  // to be interpolated for each pixel.
+  const typename InputImageType::DirectionType& physicalToInput = inputPtr->GetPhysicalPointToIndexMatrix();
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  itk::ImageScanlineIterator<OutputImageType> outputIt(outputPtr, outputRegionForThread);
 
   while (!outputIt.IsAtEnd())
   {
-    // get the output image index
-    currentIndex = outputIt.GetIndex();
-    outputPtr->TransformIndexToPhysicalPoint(currentIndex, currentPoint);
-    fieldPtr->TransformPhysicalPointToContinuousIndex(currentPoint, contiIndex);
+    IndexType lineIndex = outputIt.GetIndex();
+    IndexType nextIndex = lineIndex;
+    nextIndex[0] += 1;
+
+    PointType linePoint, nextPoint;
+    outputPtr->TransformIndexToPhysicalPoint(lineIndex, linePoint);
+    outputPtr->TransformIndexToPhysicalPoint(nextIndex, nextPoint);
+
+    FieldContinuousIndexType fieldIndex, fieldStep;
+    fieldPtr->TransformPhysicalPointToContinuousIndex(linePoint, fieldIndex);
+    fieldPtr->TransformPhysicalPointToContinuousIndex(nextPoint, fieldStep);
+
+    InputContinuousIndexType inputIndex, inputStep;
+    inputPtr->TransformPhysicalPointToContinuousIndex(linePoint, inputIndex);
+    inputPtr->TransformPhysicalPointToContinuousIndex(nextPoint, inputStep);
 
     for (unsigned int dim = 0; dim < DisplacementFieldType::ImageDimension; ++dim)
     {
-      if (contiIndex[dim] < static_cast<double>(defRegion.GetIndex(dim)) ||
-          contiIndex[dim] > static_cast<double>(defRegion.GetIndex(dim) + defRegion.GetSize(dim) - 1))
+      fieldStep[dim] -= fieldIndex[dim];
+    }
+    for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+    {
+      inputStep[dim] -= inputIndex[dim];
+    }
+
+    FieldContinuousIndexType        currentFieldIndex;
+    InterpolatorContinuousIndexType currentInputIndex;
+    DisplacementValueType           displacement;
+
+    for (double pos = 0.; !outputIt.IsAtEndOfLine(); ++outputIt, pos += 1.)
+    {
+      // mask pixels outside the displacement grid
+      bool insideField = true;
+      for (unsigned int dim = 0; dim < DisplacementFieldType::ImageDimension; ++dim)
+      {
+        currentFieldIndex[dim] = fieldIndex[dim] + pos * fieldStep[dim];
+        if (currentFieldIndex[dim] < static_cast<double>(defRegion.GetIndex(dim)) ||
+            currentFieldIndex[dim] > static_cast<double>(defRegion.GetIndex(dim) + defRegion.GetSize(dim) - 1))
+        {
+          insideField = false;
+          break;
+        }
+      }
+
+      if (!insideField)
+      {
+        outputIt.Set(paddingValue);
+        progress.CompletedPixel();
+        continue;
+      }
+
+      this->EvaluateDisplacementAtContinuousIndex(fieldPtr, currentFieldIndex, displacement);
+
+      for (unsigned int i = 0; i < InputImageType::ImageDimension; ++i)
+      {
+        currentInputIndex[i] = inputIndex[i] + pos * inputStep[i];
+        for (unsigned int j = 0; j < InputImageType::ImageDimension; ++j)
+        {
+          currentInputIndex[i] += physicalToInput[i][j] * displacement[j];
+        }
+      }
+
+      if (interpolator->IsInsideBuffer(currentInputIndex))
+      {
+        outputIt.Set(static_cast<PixelType>(interpolator->EvaluateAtContinuousIndex(currentInputIndex)));
+      }
+      else
       {
         outputIt.Set(paddingValue);
-        break;
       }
+      progress.CompletedPixel();
     }
-    ++outputIt;
+    outputIt.NextLine();
   }
 }
 
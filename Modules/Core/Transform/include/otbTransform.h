@@ -23,6 +23,7 @@
 
 #include "itkTransform.h"
 #include "vnl/vnl_vector_fixed.h"
+#include <cstddef>
 
 
 namespace otb
@@ -106,6 +107,18 @@ public:
     return OutputPointType();
   }
 
+  /** Method to transform n points, out[i] being the transform of in[i].
+   * The default implementation calls TransformPoint() on each point.
+   * Subclasses which can process several points at once (e.g. through
+   * the array interfaces of GDAL) should override it. */
+  virtual void TransformPoints(const InputPointType* in, OutputPointType* out, std::size_t n) const
+  {
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      out[i] = this->TransformPoint(in[i]);
+    }
+  }
+
   using Superclass::TransformVector;
   /**  Method to transform a vector. */
   OutputVectorType TransformVector(const InputVectorType&) const override
@@ -255,6 +268,25 @@ private:
   Transform(const Self&) = delete;
   void operator=(const Self&) = delete;
 };
+
+/** Transform n points with any itk::Transform. The batched
+ * TransformPoints() method is used if transform is an otb::Transform,
+ * else TransformPoint() is called on each point. */
+template <class TTransform>
+void TransformPoints(const TTransform* transform, const typename TTransform::InputPointType* in, typename TTransform::OutputPointType* out, std::size_t n)
+{
+  typedef Transform<typename TTransform::ScalarType, TTransform::InputSpaceDimension, TTransform::OutputSpaceDimension> BatchTransformType;
+
+  if (const BatchTransformType* batchTransform = dynamic_cast<const BatchTransformType*>(transform))
+  {
+    batchTransform->TransformPoints(in, out, n);
+    return;
+  }
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    out[i] = transform->TransformPoint(in[i]);
+  }
+}
 } // end namespace otb
 
 #endif
@@ -175,7 +175,34 @@ int otbRPCTransformTest(int itkNotUsed(argc), char* argv[])
        success = false;
      }
   }
-  
+
+  // Testing the batched transforms on all the GCPs at once
+  const std::size_t nbPoints = pointsContainer.size();
+  PointsContainerType forwardPoints(nbPoints), inversePoints(nbPoints), img2wgsPoints(nbPoints), wgs2imgPoints(nbPoints);
+  ForwardTransform->TransformPoints(pointsContainer.data(), forwardPoints.data(), nbPoints);
+  InverseTransform->TransformPoints(geo3dPointsContainer.data(), inversePoints.data(), nbPoints);
+  GenericRSTransform_img2wgs->TransformPoints(pointsContainer.data(), img2wgsPoints.data(), nbPoints);
+  GenericRSTransform_wgs2img->TransformPoints(geo3dPointsContainer.data(), wgs2imgPoints.data(), nbPoints);
+  for (std::size_t i = 0; i < nbPoints; ++i)
+  {
+    if (geoDistance->Evaluate(forwardPoints[i], geo3dPointsContainer[i]) > geoTol ||
+        geoDistance->Evaluate(img2wgsPoints[i], geo3dPointsContainer[i]) > geoTol)
+    {
+      std::cerr << "Geo distance between batched TransformPoints and GCP too high :\n"
+                << "GCP: " << geo3dPointsContainer[i] << " / computed: " << forwardPoints[i] << " (RPC) " << img2wgsPoints[i]
+                << " (GenericRSTransform)" << std::endl;
+      success = false;
+    }
+    if (imgDistance->Evaluate(inversePoints[i], pointsContainer[i]) > imgTol ||
+        imgDistance->Evaluate(wgs2imgPoints[i], pointsContainer[i]) > imgTol)
+    {
+      std::cerr << "Distance between batched TransformPoints and GCP too high :\n"
+                << "GCP: " << pointsContainer[i] << " / computed: " << inversePoints[i] << " (RPC) " << wgs2imgPoints[i]
+                << " (GenericRSTransform)" << std::endl;
+      success = false;
+    }
+  }
+
   if (success)
     return EXIT_SUCCESS;
   else
@@ -122,6 +122,26 @@ public:
     return false;
   }
 
+  /** Determine if the VectorDataIO can read only the features
+      intersecting the spatial filter. Default is false: the whole file
+      is read. */
+  virtual bool CanSpatialFilterRead() const
+  {
+    return false;
+  }
+
+  /** Set the spatial filter: only the features whose geometry intersects
+   * the rectangle [lower, upper] (in the coordinates of the file) are read,
+   * if CanSpatialFilterRead() */
+  void SetSpatialFilter(const PointType& lower, const PointType& upper);
+
+  /** Read all the features */
+  void ClearSpatialFilter();
+
+  itkGetMacro(UseSpatialFilter, bool);
+  itkGetConstReferenceMacro(SpatialFilterLower, PointType);
+  itkGetConstReferenceMacro(SpatialFilterUpper, PointType);
+
   /*   /\** Read the spacing and dimensions of the VectorData. */
   /*    * Assumes SetFileName has been called with a valid file name. *\/ */
   /*   virtual void ReadVectorDataInformation() = 0; */
@@ -166,6 +186,11 @@ protected:
   /** Filename to read */
   std::string m_FileName;
 
+  /** Spatial filter of the reading */
+  bool      m_UseSpatialFilter;
+  PointType m_SpatialFilterLower;
+  PointType m_SpatialFilterUpper;
+
   /** Return the object to an initialized state, ready to be used */
   virtual void Reset(const bool freeDynamic = true);
 
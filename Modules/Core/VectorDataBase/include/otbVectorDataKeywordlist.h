@@ -22,6 +22,7 @@
 #define otbVectorDataKeywordlist_h
 
 #include <iosfwd>
+#include <memory>
 #include <vector>
 #include <string>
 
@@ -68,8 +69,13 @@ public:
     return "VectorDataKeywordlist";
   }
 
+  /** Add a field, with a copy of its definition */
   void AddField(OGRFieldDefn* fieldDefn, OGRField* field);
 
+  /** Add a field sharing its definition (e.g. with the other features of a
+   * layer): the definition must not be modified afterwards */
+  void AddField(const std::shared_ptr<OGRFieldDefn>& fieldDefn, OGRField* field);
+
   /**
     * \param key The name of the field.
     * \param value The value of the field.
@@ -154,7 +160,8 @@ public:
   /** Destructor */
   ~VectorDataKeywordlist();
 
-  /** Constructor by copy (deep copy)*/
+  /** Constructor by copy (deep copy of the values, the field definitions
+   * are shared)*/
   VectorDataKeywordlist(const Self& other);
 
   /** Deep copy operator*/
@@ -166,7 +173,10 @@ protected:
 private:
   std::string PrintField(FieldType field) const;
   FieldType CopyOgrField(FieldType field);
+  void PushField(const std::shared_ptr<OGRFieldDefn>& fieldDefn, const OGRField& field);
   FieldListType m_FieldList;
+  /** Owners of the definitions of m_FieldList */
+  std::vector<std::shared_ptr<OGRFieldDefn>> m_FieldDefns;
 };
 OTBVectorDataBase_EXPORT extern std::ostream& operator<<(std::ostream& os, const VectorDataKeywordlist& kwl);
 }
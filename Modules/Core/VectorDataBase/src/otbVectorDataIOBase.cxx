@@ -24,11 +24,30 @@
 
 namespace otb
 {
-VectorDataIOBase::VectorDataIOBase() : m_ByteOrder(OrderNotApplicable)
+VectorDataIOBase::VectorDataIOBase() : m_ByteOrder(OrderNotApplicable), m_UseSpatialFilter(false)
 {
+  m_SpatialFilterLower.Fill(0.);
+  m_SpatialFilterUpper.Fill(0.);
   this->Reset(false);
 }
 
+void VectorDataIOBase::SetSpatialFilter(const PointType& lower, const PointType& upper)
+{
+  m_UseSpatialFilter   = true;
+  m_SpatialFilterLower = lower;
+  m_SpatialFilterUpper = upper;
+  this->Modified();
+}
+
+void VectorDataIOBase::ClearSpatialFilter()
+{
+  if (m_UseSpatialFilter)
+  {
+    m_UseSpatialFilter = false;
+    this->Modified();
+  }
+}
+
 void VectorDataIOBase::Reset(const bool)
 {
   m_Initialized = false;
@@ -61,6 +80,10 @@ void VectorDataIOBase::PrintSelf(std::ostream& os, itk::Indent indent) const
 
   os << indent << "FileName: " << m_FileName << std::endl;
   os << indent << "ByteOrder: " << this->GetByteOrderAsString(m_ByteOrder) << std::endl;
+  if (m_UseSpatialFilter)
+  {
+    os << indent << "SpatialFilter: " << m_SpatialFilterLower << " " << m_SpatialFilterUpper << std::endl;
+  }
 }
 
 } // namespace otb
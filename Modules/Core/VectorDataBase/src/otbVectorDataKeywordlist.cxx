@@ -47,36 +47,39 @@ VectorDataKeywordlist::~VectorDataKeywordlist()
     {
       VSIFree(m_FieldList[i].second.String);
     }
-    delete (m_FieldList[i].first);
   }
 }
 
+void VectorDataKeywordlist::PushField(const std::shared_ptr<OGRFieldDefn>& fieldDefn, const OGRField& field)
+{
+  m_FieldDefns.push_back(fieldDefn);
+  m_FieldList.push_back(FieldType(fieldDefn.get(), field));
+}
+
 void VectorDataKeywordlist::AddField(OGRFieldDefn* fieldDefn, OGRField* field)
+{
+  std::shared_ptr<OGRFieldDefn> defn(new OGRFieldDefn(fieldDefn));
+  this->AddField(defn, field);
+}
+
+void VectorDataKeywordlist::AddField(const std::shared_ptr<OGRFieldDefn>& fieldDefn, OGRField* field)
 {
   FieldType newField;
-  newField.first  = fieldDefn;
+  newField.first  = fieldDefn.get();
   newField.second = *field;
-  // TODO: evaluate performance impact of fieldDefn copy
-  // the object itself could be handled at the VectorData level
-  // keeping only pointer here. (but it does not seem
-  // necessary so far...)
-  m_FieldList.push_back(CopyOgrField(newField));
+  PushField(fieldDefn, CopyOgrField(newField).second);
 }
 
 void VectorDataKeywordlist::AddField(const std::string& key, const std::string& value)
 {
-  FieldType newField;
-
-  OGRFieldDefn* fieldDefn = new OGRFieldDefn(key.c_str(), OFTString);
+  std::shared_ptr<OGRFieldDefn> fieldDefn(new OGRFieldDefn(key.c_str(), OFTString));
 
   OGRField field;
   char*    cstr = (char*)VSIMalloc((value.length() + 1) * sizeof(char));
   strcpy(cstr, value.c_str());
   field.String = cstr;
 
-  newField.first  = fieldDefn;
-  newField.second = field;
-  m_FieldList.push_back(newField);
+  PushField(fieldDefn, field);
 }
 
 std::string VectorDataKeywordlist::GetFieldAsString(const std::string& key) const
@@ -225,15 +228,11 @@ void VectorDataKeywordlist::SetFieldAsDouble(const std::string& key, double valu
   }
   else
   {
-    FieldType newField;
-
-    OGRFieldDefn* fieldDefn = new OGRFieldDefn(key.c_str(), OFTReal);
+    std::shared_ptr<OGRFieldDefn> fieldDefn(new OGRFieldDefn(key.c_str(), OFTReal));
 
     OGRField field;
-    field.Real      = value;
-    newField.first  = fieldDefn;
-    newField.second = field;
-    m_FieldList.push_back(newField);
+    field.Real = value;
+    PushField(fieldDefn, field);
   }
 }
 
@@ -266,14 +265,10 @@ void VectorDataKeywordlist::SetFieldAsInt(const std::string& key, int value)
   }
   else
   {
-    FieldType newField;
-
-    OGRFieldDefn* fieldDefn = new OGRFieldDefn(key.c_str(), OFTInteger);
-    OGRField      field;
-    field.Integer   = value;
-    newField.first  = fieldDefn;
-    newField.second = field;
-    m_FieldList.push_back(newField);
+    std::shared_ptr<OGRFieldDefn> fieldDefn(new OGRFieldDefn(key.c_str(), OFTInteger));
+    OGRField                      field;
+    field.Integer = value;
+    PushField(fieldDefn, field);
   }
 }
 
@@ -346,7 +341,7 @@ void VectorDataKeywordlist::operator=(const Self& p)
 {
   for (unsigned int i = 0; i < p.m_FieldList.size(); ++i)
   {
-    m_FieldList.push_back(CopyOgrField(p.m_FieldList[i]));
+    PushField(p.m_FieldDefns[i], CopyOgrField(p.m_FieldList[i]).second);
   }
 }
 
@@ -453,7 +448,7 @@ std::string VectorDataKeywordlist::PrintField(FieldType field) const
 VectorDataKeywordlist::FieldType VectorDataKeywordlist::CopyOgrField(FieldType field)
 {
   FieldType outField;
-  outField.first = new OGRFieldDefn(field.first);
+  outField.first = field.first;
   switch (field.first->GetType())
   {
   case OFTInteger:
@@ -473,11 +468,7 @@ VectorDataKeywordlist::FieldType VectorDataKeywordlist::CopyOgrField(FieldType f
   }
   case OFTString:
   {
-    if (field.second.String != nullptr)
-    {
-      CPLFree(outField.second.String);
-      outField.second.String = CPLStrdup(field.second.String);
-    }
+    outField.second.String = (field.second.String != nullptr) ? CPLStrdup(field.second.String) : nullptr;
     break;
   }
   case OFTDate:
@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbCloudMaskImageFilter_h
+#define otbCloudMaskImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <vector>
+
+namespace otb
+{
+/** \class CloudMaskImageFilter
+ *  \brief Compute a dilated cloud mask in a single pass
+ *
+ * The pixels are detected as in CloudDetectionFilter: the estimator of
+ * CloudEstimatorFunctor, the spectral angle with the reference pixel
+ * reversed and normalized between 0 and 1, weighted by a Gaussian
+ * coefficient of the pixel norm, must be above MinThreshold and below or
+ * equal to MaxThreshold. Both factors of the estimator are below 1, so
+ * the pixels whose angle or norm alone bound it below MinThreshold are
+ * rejected from the dot product and the norm only, before computing the
+ * arc cosine and the exponential.
+ *
+ * The detected pixels are then dilated by a square structuring element
+ * of radius DilationRadius, as a separable dilation: each detected row is
+ * dilated along the columns with a prefix sum, and each output pixel
+ * counts the dilated rows of the window within a rolling buffer of rows.
+ * The input requested region is padded by the radius, so the mask does
+ * not depend on the streaming.
+ *
+ * The mask pixels are set to ForegroundValue (1 by default) and the
+ * others to BackgroundValue (0 by default). Swapping them gives the mask
+ * of the clear pixels, as expected by the classification or mosaicking
+ * filters that ignore the pixels of null mask.
+ *
+ * TInputImage is expected to be an otb::VectorImage type and
+ * TOutputImage an otb::Image type, of dimension 2.
+ *
+ * \sa CloudDetectionFilter
+ * \sa CloudEstimatorFunctor
+ *
+ * \ingroup OTBCloudDetection
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT CloudMaskImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef CloudMaskImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(CloudMaskImageFilter, ImageToImageFilter);
+
+  /** Some convenient typedefs. */
+  typedef TInputImage                                InputImageType;
+  typedef typename InputImageType::PixelType         InputPixelType;
+  typedef typename InputImageType::RegionType        InputImageRegionType;
+  typedef typename InputImageType::InternalPixelType InputInternalPixelType;
+  typedef TOutputImage                               OutputImageType;
+  typedef typename OutputImageType::RegionType       OutputImageRegionType;
+  typedef typename OutputImageType::PixelType        OutputPixelType;
+
+  /** Set/Get the reference pixel of the clouds */
+  void SetReferencePixel(const InputPixelType& ref)
+  {
+    m_ReferencePixel = ref;
+    this->Modified();
+  }
+  const InputPixelType& GetReferencePixel() const
+  {
+    return m_ReferencePixel;
+  }
+
+  /** Set/Get the variance of the Gaussian coefficient, relative to the
+   * norm of the reference pixel */
+  itkSetMacro(Variance, double);
+  itkGetConstMacro(Variance, double);
+
+  /** Set/Get the thresholds of the cloud estimator */
+  itkSetMacro(MinThreshold, double);
+  itkGetConstMacro(MinThreshold, double);
+  itkSetMacro(MaxThreshold, double);
+  itkGetConstMacro(MaxThreshold, double);
+
+  /** Set/Get the radius of the square structuring element of the dilation */
+  itkSetMacro(DilationRadius, unsigned int);
+  itkGetConstMacro(DilationRadius, unsigned int);
+
+  /** Set/Get the values of the mask and of the other pixels */
+  itkSetMacro(ForegroundValue, OutputPixelType);
+  itkGetConstMacro(ForegroundValue, OutputPixelType);
+  itkSetMacro(BackgroundValue, OutputPixelType);
+  itkGetConstMacro(BackgroundValue, OutputPixelType);
+
+protected:
+  CloudMaskImageFilter();
+  ~CloudMaskImageFilter() override
+  {
+  }
+
+  /** Pad the requested region by the dilation radius */
+  void GenerateInputRequestedRegion() override;
+
+  /** Check the reference pixel and compute the bounds of the prefilter */
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  CloudMaskImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Detect the pixels of an input row, from the first column on width
+   * pixels */
+  void DetectRow(long row, long firstColumn, unsigned int width, unsigned char* detection) const;
+
+  InputPixelType  m_ReferencePixel;
+  double          m_Variance;
+  double          m_MinThreshold;
+  double          m_MaxThreshold;
+  unsigned int    m_DilationRadius;
+  OutputPixelType m_ForegroundValue;
+  OutputPixelType m_BackgroundValue;
+
+  /** Reference pixel, its norm, the denominator of the Gaussian
+   * coefficient and the bounds of the prefilter */
+  std::vector<double> m_Reference;
+  double              m_ReferenceNorm;
+  double              m_Denominator;
+  double              m_NormBound;
+  double              m_CosineBound;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbCloudMaskImageFilter.hxx"
+#endif
+
+#endif
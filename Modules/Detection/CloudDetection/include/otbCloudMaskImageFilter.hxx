@@ -0,0 +1,253 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbCloudMaskImageFilter_hxx
+#define otbCloudMaskImageFilter_hxx
+
+#include "otbCloudMaskImageFilter.h"
+#include "itkProgressReporter.h"
+#include "otbMath.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+CloudMaskImageFilter<TInputImage, TOutputImage>::CloudMaskImageFilter()
+  : m_Variance(1.0),
+    m_MinThreshold(0.0),
+    m_MaxThreshold(1.0),
+    m_DilationRadius(0),
+    m_ForegroundValue(1),
+    m_BackgroundValue(0),
+    m_ReferenceNorm(0.),
+    m_Denominator(1.),
+    m_NormBound(0.),
+    m_CosineBound(0.)
+{
+  m_ReferencePixel.SetSize(4);
+  m_ReferencePixel.Fill(1);
+}
+
+template <class TInputImage, class TOutputImage>
+void CloudMaskImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (!input)
+  {
+    return;
+  }
+
+  InputImageRegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(m_DilationRadius);
+  if (!inputRequestedRegion.Crop(input->GetLargestPossibleRegion()))
+  {
+    itkExceptionMacro(<< "The requested region is outside the input image");
+  }
+  input->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void CloudMaskImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  if (m_ReferencePixel.Size() != this->GetInput()->GetNumberOfComponentsPerPixel())
+  {
+    itkExceptionMacro("The number of bands of the reference pixel is different from the number of bands of the input image. ");
+  }
+
+  m_Reference.resize(m_ReferencePixel.Size());
+  double squaredNorm = 0.;
+  for (unsigned int i = 0; i < m_ReferencePixel.Size(); ++i)
+  {
+    m_Reference[i] = m_ReferencePixel[i];
+    squaredNorm += m_Reference[i] * m_Reference[i];
+  }
+  m_ReferenceNorm = std::sqrt(squaredNorm);
+  m_Denominator   = 2 * m_Variance * m_Variance * m_ReferenceNorm * m_ReferenceNorm;
+
+  // The estimator is the product of the Gaussian coefficient and of the
+  // reversed angle, both in [0, 1]: it is above MinThreshold only if both
+  // are. The bounds are slightly relaxed so that the rounding errors
+  // never reject a detected pixel.
+  if (m_MinThreshold <= 0.)
+  {
+    m_NormBound   = std::numeric_limits<double>::infinity();
+    m_CosineBound = -std::numeric_limits<double>::infinity();
+  }
+  else if (m_MinThreshold >= 1.)
+  {
+    m_NormBound   = -1.;
+    m_CosineBound = -std::numeric_limits<double>::infinity();
+  }
+  else
+  {
+    m_NormBound   = -m_Denominator * std::log(m_MinThreshold) * (1. + 1e-6);
+    m_CosineBound = std::cos(CONST_PI * (1. - m_MinThreshold)) - 1e-9;
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void CloudMaskImageFilter<TInputImage, TOutputImage>::DetectRow(long row, long firstColumn, unsigned int width, unsigned char* detection) const
+{
+  const InputImageType*       input        = this->GetInput();
+  const InputImageRegionType& buffered     = input->GetBufferedRegion();
+  const unsigned int          nbComponents = input->GetNumberOfComponentsPerPixel();
+  const double*               reference    = m_Reference.data();
+
+  const InputInternalPixelType* pixel =
+      input->GetBufferPointer() + ((row - buffered.GetIndex()[1]) * buffered.GetSize()[0] + (firstColumn - buffered.GetIndex()[0])) * nbComponents;
+
+  for (unsigned int i = 0; i < width; ++i, pixel += nbComponents)
+  {
+    double dot         = 0.;
+    double squaredNorm = 0.;
+    for (unsigned int k = 0; k < nbComponents; ++k)
+    {
+      const double value = pixel[k];
+      dot += value * reference[k];
+      squaredNorm += value * value;
+    }
+
+    // Prefilter on the norm
+    const double norm     = std::sqrt(squaredNorm);
+    const double distance = (norm - m_ReferenceNorm) * (norm - m_ReferenceNorm);
+    if (distance > m_NormBound)
+    {
+      detection[i] = 0;
+      continue;
+    }
+
+    // Prefilter on the cosine, the angle being 0 as in SpectralAngleFunctor
+    // for null pixels
+    const double normProd = norm * m_ReferenceNorm;
+    double       angle    = 0.;
+    if (normProd >= 1.e-12 && dot / normProd <= 1)
+    {
+      const double cosine = dot / normProd;
+      if (cosine < m_CosineBound)
+      {
+        detection[i] = 0;
+        continue;
+      }
+      angle = std::acos(std::max(cosine, -1.));
+    }
+
+    const double estimator = std::exp(-distance / m_Denominator) * ((CONST_PI - angle) / CONST_PI);
+    detection[i]           = (estimator > m_MinThreshold) && (estimator <= m_MaxThreshold);
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void CloudMaskImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  const InputImageType*       input   = this->GetInput();
+  OutputImageType*            output  = this->GetOutput();
+  const InputImageRegionType& largest = input->GetLargestPossibleRegion();
+
+  const unsigned int width  = outputRegionForThread.GetSize()[0];
+  const unsigned int height = outputRegionForThread.GetSize()[1];
+  const long         startX = outputRegionForThread.GetIndex()[0];
+  const long         startY = outputRegionForThread.GetIndex()[1];
+  const long         radius = m_DilationRadius;
+
+  // Input pixels within the radius of the region
+  const long firstX = std::max(startX - radius, static_cast<long>(largest.GetIndex()[0]));
+  const long lastX  = std::min(startX + static_cast<long>(width) - 1 + radius, static_cast<long>(largest.GetIndex()[0] + largest.GetSize()[0]) - 1);
+  const long firstY = std::max(startY - radius, static_cast<long>(largest.GetIndex()[1]));
+  const long lastY  = std::min(startY + static_cast<long>(height) - 1 + radius, static_cast<long>(largest.GetIndex()[1] + largest.GetSize()[1]) - 1);
+
+  const unsigned int spanWidth = lastX - firstX + 1;
+
+  // Detections of an input row and their prefix sums, and rolling buffer
+  // of the rows dilated along the columns with the count of each column
+  const unsigned int         nbRows = 2 * radius + 1;
+  std::vector<unsigned char> detection(spanWidth);
+  std::vector<unsigned int>  prefix(spanWidth + 1, 0);
+  std::vector<unsigned char> dilatedRows(nbRows * width);
+  std::vector<unsigned int>  counts(width, 0);
+
+  const OutputImageRegionType& buffered = output->GetBufferedRegion();
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  long nextRow = firstY;
+  for (long y = startY; y < startY + static_cast<long>(height); ++y)
+  {
+    // Remove the row leaving the window, whose slot is reused
+    const long leaving = y - radius - 1;
+    if (leaving >= firstY)
+    {
+      const unsigned char* dilated = &dilatedRows[((leaving - firstY) % nbRows) * width];
+      for (unsigned int i = 0; i < width; ++i)
+      {
+        counts[i] -= dilated[i];
+      }
+    }
+
+    // Detect and dilate the rows entering the window
+    for (; nextRow <= std::min(y + radius, lastY); ++nextRow)
+    {
+      this->DetectRow(nextRow, firstX, spanWidth, detection.data());
+      for (unsigned int j = 0; j < spanWidth; ++j)
+      {
+        prefix[j + 1] = prefix[j] + detection[j];
+      }
+
+      unsigned char* dilated = &dilatedRows[((nextRow - firstY) % nbRows) * width];
+      for (unsigned int i = 0; i < width; ++i)
+      {
+        const long x    = startX + i;
+        const long low  = std::max(x - radius, firstX) - firstX;
+        const long high = std::min(x + radius, lastX) - firstX;
+        dilated[i]      = prefix[high + 1] > prefix[low];
+        counts[i] += dilated[i];
+      }
+    }
+
+    OutputPixelType* out = output->GetBufferPointer() + (y - buffered.GetIndex()[1]) * buffered.GetSize()[0] + (startX - buffered.GetIndex()[0]);
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      out[i] = counts[i] > 0 ? m_ForegroundValue : m_BackgroundValue;
+      progress.CompletedPixel();
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void CloudMaskImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ReferencePixel: " << m_ReferencePixel << std::endl;
+  os << indent << "Variance: " << m_Variance << std::endl;
+  os << indent << "MinThreshold: " << m_MinThreshold << std::endl;
+  os << indent << "MaxThreshold: " << m_MaxThreshold << std::endl;
+  os << indent << "DilationRadius: " << m_DilationRadius << std::endl;
+  os << indent << "ForegroundValue: " << static_cast<typename itk::NumericTraits<OutputPixelType>::PrintType>(m_ForegroundValue) << std::endl;
+  os << indent << "BackgroundValue: " << static_cast<typename itk::NumericTraits<OutputPixelType>::PrintType>(m_BackgroundValue) << std::endl;
+}
+
+} // end namespace otb
+
+#endif
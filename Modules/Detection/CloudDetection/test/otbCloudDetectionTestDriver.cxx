@@ -25,4 +25,5 @@ void RegisterTests()
   REGISTER_TEST(otbCloudEstimatorDefaultFilter);
   REGISTER_TEST(otbCloudDetectionFilter);
   REGISTER_TEST(otbCloudEstimatorFilter);
+  REGISTER_TEST(otbCloudMaskImageFilter);
 }
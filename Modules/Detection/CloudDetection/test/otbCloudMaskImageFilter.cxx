@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+
+#include "otbVectorImage.h"
+#include "otbImage.h"
+#include "otbCloudDetectionFilter.h"
+#include "otbCloudMaskImageFilter.h"
+#include "otbImageFileReader.h"
+#include "itkStreamingImageFilter.h"
+
+#include <algorithm>
+#include <iostream>
+
+int otbCloudMaskImageFilter(int itkNotUsed(argc), char* argv[])
+{
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+  typedef otb::VectorImage<PixelType, Dimension>                             VectorImageType;
+  typedef otb::Image<PixelType, Dimension>                                   ImageType;
+  typedef otb::Image<unsigned char, Dimension>                               MaskImageType;
+  typedef VectorImageType::PixelType                                         VectorPixelType;
+  typedef otb::Functor::CloudDetectionFunctor<VectorPixelType, PixelType>    FunctorType;
+  typedef otb::CloudDetectionFilter<VectorImageType, ImageType, FunctorType> CloudDetectionFilterType;
+  typedef otb::CloudMaskImageFilter<VectorImageType, MaskImageType>          CloudMaskFilterType;
+  typedef itk::StreamingImageFilter<MaskImageType, MaskImageType>            StreamingFilterType;
+  typedef otb::ImageFileReader<VectorImageType>                              ReaderType;
+
+  // Parameters
+  const char*     inputFileName(argv[1]);
+  VectorPixelType referencePixel;
+  referencePixel.SetSize(4);
+  referencePixel.Fill(0.);
+
+  referencePixel[0] = (atof(argv[2]));
+  referencePixel[1] = (atof(argv[3]));
+  referencePixel[2] = (atof(argv[4]));
+  referencePixel[3] = (atof(argv[5]));
+
+  const double variance     = (atof(argv[6]));
+  const double minThreshold = (atof(argv[7]));
+  const double maxThreshold = (atof(argv[8]));
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFileName);
+
+  // Detection of the pixels by the functor filter
+  CloudDetectionFilterType::Pointer cloudDetection = CloudDetectionFilterType::New();
+  cloudDetection->SetInput(reader->GetOutput());
+  cloudDetection->SetReferencePixel(referencePixel);
+  cloudDetection->SetMinThreshold(minThreshold);
+  cloudDetection->SetMaxThreshold(maxThreshold);
+  cloudDetection->SetVariance(variance);
+  cloudDetection->Update();
+
+  const ImageType*            reference = cloudDetection->GetOutput();
+  const ImageType::RegionType region    = reference->GetLargestPossibleRegion();
+  const ImageType::IndexType  origin    = region.GetIndex();
+  const long                  sizeX     = region.GetSize()[0];
+  const long                  sizeY     = region.GetSize()[1];
+
+  for (unsigned int radius = 0; radius <= 3; radius += 3)
+  {
+    CloudMaskFilterType::Pointer cloudMask = CloudMaskFilterType::New();
+    cloudMask->SetInput(reader->GetOutput());
+    cloudMask->SetReferencePixel(referencePixel);
+    cloudMask->SetMinThreshold(minThreshold);
+    cloudMask->SetMaxThreshold(maxThreshold);
+    cloudMask->SetVariance(variance);
+    cloudMask->SetDilationRadius(radius);
+    cloudMask->SetForegroundValue(255);
+
+    StreamingFilterType::Pointer streamer = StreamingFilterType::New();
+    streamer->SetInput(cloudMask->GetOutput());
+    streamer->SetNumberOfStreamDivisions(5);
+    streamer->Update();
+
+    // Brute force dilation of the detected pixels
+    unsigned int nbErrors = 0;
+    unsigned int nbClouds = 0;
+    for (long y = 0; y < sizeY; ++y)
+    {
+      for (long x = 0; x < sizeX; ++x)
+      {
+        bool cloud = false;
+        for (long v = std::max(y - static_cast<long>(radius), 0L); v <= std::min(y + static_cast<long>(radius), sizeY - 1) && !cloud; ++v)
+        {
+          for (long u = std::max(x - static_cast<long>(radius), 0L); u <= std::min(x + static_cast<long>(radius), sizeX - 1) && !cloud; ++u)
+          {
+            ImageType::IndexType index = {{origin[0] + u, origin[1] + v}};
+            cloud                      = reference->GetPixel(index) != 0;
+          }
+        }
+
+        ImageType::IndexType index = {{origin[0] + x, origin[1] + y}};
+        nbClouds += cloud;
+        if (streamer->GetOutput()->GetPixel(index) != (cloud ? 255 : 0))
+        {
+          ++nbErrors;
+        }
+      }
+    }
+
+    std::cout << "Radius " << radius << ": " << nbClouds << " cloud pixels, " << nbErrors << " errors" << std::endl;
+    if (nbErrors > 0)
+    {
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
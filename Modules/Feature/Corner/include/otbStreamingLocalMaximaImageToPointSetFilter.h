@@ -0,0 +1,238 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingLocalMaximaImageToPointSetFilter_h
+#define otbStreamingLocalMaximaImageToPointSetFilter_h
+
+#include "otbPersistentReduceImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "itkPointSet.h"
+
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class LocalMaximaAccumulator
+ * \brief Holds the local maxima found in a set of regions, with their value.
+ *
+ * \sa PersistentLocalMaximaImageToPointSetFilter
+ *
+ * \ingroup OTBCorner
+ */
+template <class TPixel, class TIndex>
+class LocalMaximaAccumulator
+{
+public:
+  typedef std::pair<TIndex, TPixel> MaximumType;
+  typedef std::vector<MaximumType>  MaximaContainerType;
+
+  void Accumulate(const TPixel& value, const TIndex& index)
+  {
+    m_Maxima.emplace_back(index, value);
+  }
+
+  void Merge(const LocalMaximaAccumulator& other)
+  {
+    m_Maxima.insert(m_Maxima.end(), other.m_Maxima.begin(), other.m_Maxima.end());
+  }
+
+  const MaximaContainerType& GetMaxima() const
+  {
+    return m_Maxima;
+  }
+
+private:
+  MaximaContainerType m_Maxima;
+};
+
+/** \class PersistentLocalMaximaImageToPointSetFilter
+ * \brief Extract the local maxima of an image, such as a corner response, as a point set
+ *
+ * A pixel is a local maximum if its value is above the threshold and
+ * greater than the values of the pixels in the square window of the
+ * given radius around it. On plateaus, only the first pixel in raster
+ * order is kept.
+ *
+ * Each thread runs the non-maximum suppression on its own region, the
+ * input requested region being padded by the radius so that maxima are
+ * found identically regardless of the streaming and threading layout,
+ * and keeps its maxima in its own list. Synthetize() merges the lists,
+ * sorts the maxima in raster order, keeps the MaximumNumberOfPoints
+ * strongest ones when it is not 0, and fills the output point set with
+ * their physical positions, the point data being the image values.
+ *
+ * \sa PersistentReduceImageFilter
+ * \sa StreamingLocalMaximaImageToPointSetFilter
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBCorner
+ */
+template <class TInputImage, class TOutputPointSet = itk::PointSet<typename TInputImage::PixelType, 2>>
+class ITK_EXPORT PersistentLocalMaximaImageToPointSetFilter
+    : public PersistentReduceImageFilter<TInputImage, LocalMaximaAccumulator<typename TInputImage::PixelType, typename TInputImage::IndexType>>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentLocalMaximaImageToPointSetFilter Self;
+  typedef PersistentReduceImageFilter<TInputImage, LocalMaximaAccumulator<typename TInputImage::PixelType, typename TInputImage::IndexType>> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentLocalMaximaImageToPointSetFilter, PersistentReduceImageFilter);
+
+  typedef TInputImage                            ImageType;
+  typedef typename TInputImage::RegionType       RegionType;
+  typedef typename TInputImage::IndexType        IndexType;
+  typedef typename TInputImage::PixelType        PixelType;
+  typedef typename Superclass::AccumulatorType   AccumulatorType;
+  typedef TOutputPointSet                        OutputPointSetType;
+  typedef typename OutputPointSetType::Pointer   OutputPointSetPointerType;
+  typedef typename OutputPointSetType::PixelType OutputPointSetPixelType;
+
+  /** Radius of the non-maximum suppression window */
+  itkSetMacro(Radius, unsigned int);
+  itkGetConstMacro(Radius, unsigned int);
+
+  /** Values lower or equal to the threshold are never maxima */
+  itkSetMacro(Threshold, PixelType);
+  itkGetConstMacro(Threshold, PixelType);
+
+  /** Number of strongest maxima kept, all of them when 0 */
+  itkSetMacro(MaximumNumberOfPoints, unsigned long);
+  itkGetConstMacro(MaximumNumberOfPoints, unsigned long);
+
+  /** Point set of the maxima, filled by Synthetize() */
+  OutputPointSetType* GetPointSet()
+  {
+    return m_PointSet;
+  }
+
+  void Synthetize(void) override;
+
+protected:
+  PersistentLocalMaximaImageToPointSetFilter();
+  ~PersistentLocalMaximaImageToPointSetFilter() override
+  {
+  }
+
+  /** Pad the requested region by the radius */
+  void GenerateInputRequestedRegion() override;
+
+  /** Non-maximum suppression over a thread region */
+  void AccumulateRegion(const RegionType& region, AccumulatorType& accumulator, itk::ProgressReporter& progress) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  PersistentLocalMaximaImageToPointSetFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  unsigned int              m_Radius;
+  PixelType                 m_Threshold;
+  unsigned long             m_MaximumNumberOfPoints;
+  OutputPointSetPointerType m_PointSet;
+};
+
+/** \class StreamingLocalMaximaImageToPointSetFilter
+ * \brief This class streams the whole input image through the PersistentLocalMaximaImageToPointSetFilter.
+ *
+ * It can be used to extract corners from the output of
+ * StructureTensorHarrisImageFilter, the response being computed tile by
+ * tile, only with the margin needed by both filters:
+ * \code
+ * typedef otb::StreamingLocalMaximaImageToPointSetFilter<ImageType, PointSetType> MaximaType;
+ * MaximaType::Pointer maxima = MaximaType::New();
+ * maxima->SetInput(harris->GetOutput());
+ * maxima->GetFilter()->SetRadius(3);
+ * maxima->GetFilter()->SetMaximumNumberOfPoints(1000);
+ * maxima->Update();
+ * PointSetType* points = maxima->GetPointSet();
+ * \endcode
+ *
+ * \sa PersistentLocalMaximaImageToPointSetFilter
+ * \sa PersistentFilterStreamingDecorator
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBCorner
+ */
+template <class TInputImage, class TOutputPointSet = itk::PointSet<typename TInputImage::PixelType, 2>>
+class ITK_EXPORT StreamingLocalMaximaImageToPointSetFilter
+    : public PersistentFilterStreamingDecorator<PersistentLocalMaximaImageToPointSetFilter<TInputImage, TOutputPointSet>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingLocalMaximaImageToPointSetFilter Self;
+  typedef PersistentFilterStreamingDecorator<PersistentLocalMaximaImageToPointSetFilter<TInputImage, TOutputPointSet>> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingLocalMaximaImageToPointSetFilter, PersistentFilterStreamingDecorator);
+
+  typedef TInputImage     InputImageType;
+  typedef TOutputPointSet OutputPointSetType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType* input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+  const InputImageType* GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  /** Point set of the maxima */
+  OutputPointSetType* GetPointSet()
+  {
+    return this->GetFilter()->GetPointSet();
+  }
+
+protected:
+  StreamingLocalMaximaImageToPointSetFilter()
+  {
+  }
+  ~StreamingLocalMaximaImageToPointSetFilter() override
+  {
+  }
+
+private:
+  StreamingLocalMaximaImageToPointSetFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingLocalMaximaImageToPointSetFilter.hxx"
+#endif
+
+#endif
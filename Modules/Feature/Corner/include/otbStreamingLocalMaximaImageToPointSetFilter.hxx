@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingLocalMaximaImageToPointSetFilter_hxx
+#define otbStreamingLocalMaximaImageToPointSetFilter_hxx
+
+#include "otbStreamingLocalMaximaImageToPointSetFilter.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputPointSet>
+PersistentLocalMaximaImageToPointSetFilter<TInputImage, TOutputPointSet>::PersistentLocalMaximaImageToPointSetFilter()
+  : m_Radius(1), m_Threshold(0), m_MaximumNumberOfPoints(0)
+{
+  m_PointSet = OutputPointSetType::New();
+}
+
+template <class TInputImage, class TOutputPointSet>
+void PersistentLocalMaximaImageToPointSetFilter<TInputImage, TOutputPointSet>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  ImageType* input = const_cast<ImageType*>(this->GetInput());
+  if (!input)
+  {
+    return;
+  }
+
+  RegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(m_Radius);
+  if (!inputRequestedRegion.Crop(input->GetLargestPossibleRegion()))
+  {
+    itkExceptionMacro(<< "The requested region is outside the input image");
+  }
+  input->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputPointSet>
+void PersistentLocalMaximaImageToPointSetFilter<TInputImage, TOutputPointSet>::AccumulateRegion(const RegionType& region, AccumulatorType& accumulator,
+                                                                                                 itk::ProgressReporter& progress)
+{
+  const ImageType*  input    = this->GetInput();
+  const RegionType& buffered = input->GetBufferedRegion();
+  const RegionType& largest  = input->GetLargestPossibleRegion();
+  const auto        buffer   = input->GetBufferPointer();
+  const long        stride   = buffered.GetSize()[0];
+  const long        firstX   = buffered.GetIndex()[0];
+  const long        firstY   = buffered.GetIndex()[1];
+  const long        radius   = m_Radius;
+
+  // The window is clamped to the image, whose pixels are all buffered
+  // around the region thanks to the padding of the requested region
+  const long minX = largest.GetIndex()[0];
+  const long minY = largest.GetIndex()[1];
+  const long maxX = minX + static_cast<long>(largest.GetSize()[0]) - 1;
+  const long maxY = minY + static_cast<long>(largest.GetSize()[1]) - 1;
+
+  const long startX = region.GetIndex()[0];
+  const long startY = region.GetIndex()[1];
+  const long endX   = startX + static_cast<long>(region.GetSize()[0]);
+  const long endY   = startY + static_cast<long>(region.GetSize()[1]);
+
+  IndexType index;
+  for (long y = startY; y < endY; ++y)
+  {
+    const long windowStartY = std::max(y - radius, minY);
+    const long windowEndY   = std::min(y + radius, maxY);
+    const auto row          = buffer + (y - firstY) * stride - firstX;
+
+    for (long x = startX; x < endX; ++x)
+    {
+      progress.CompletedPixel();
+
+      const PixelType value = row[x];
+      if (!(value > m_Threshold))
+      {
+        continue;
+      }
+
+      // Strictly greater than the pixels before it in raster order, and
+      // greater or equal to the following ones, so that a single pixel
+      // of a plateau is kept
+      const long windowStartX = std::max(x - radius, minX);
+      const long windowEndX   = std::min(x + radius, maxX);
+      bool       isMaximum    = true;
+      for (long wy = windowStartY; wy <= windowEndY && isMaximum; ++wy)
+      {
+        const auto windowRow = buffer + (wy - firstY) * stride - firstX;
+        for (long wx = windowStartX; wx <= windowEndX; ++wx)
+        {
+          const bool before = wy < y || (wy == y && wx < x);
+          if ((before && !(value > windowRow[wx])) || (!before && value < windowRow[wx]))
+          {
+            isMaximum = false;
+            break;
+          }
+        }
+      }
+
+      if (isMaximum)
+      {
+        index[0] = x;
+        index[1] = y;
+        accumulator.Accumulate(value, index);
+      }
+    }
+  }
+}
+
+template <class TInputImage, class TOutputPointSet>
+void PersistentLocalMaximaImageToPointSetFilter<TInputImage, TOutputPointSet>::Synthetize()
+{
+  Superclass::Synthetize();
+
+  typedef typename AccumulatorType::MaximumType MaximumType;
+
+  // The merge order of the thread lists depends on the splitting, so the
+  // maxima are sorted to give the same point set for any layout
+  std::vector<MaximumType> maxima = this->GetResult().GetMaxima();
+  auto rasterOrder                = [](const MaximumType& a, const MaximumType& b) {
+    return a.first[1] < b.first[1] || (a.first[1] == b.first[1] && a.first[0] < b.first[0]);
+  };
+  std::sort(maxima.begin(), maxima.end(), rasterOrder);
+
+  if (m_MaximumNumberOfPoints > 0 && maxima.size() > m_MaximumNumberOfPoints)
+  {
+    std::stable_sort(maxima.begin(), maxima.end(), [](const MaximumType& a, const MaximumType& b) { return a.second > b.second; });
+    maxima.resize(m_MaximumNumberOfPoints);
+    std::sort(maxima.begin(), maxima.end(), rasterOrder);
+  }
+
+  m_PointSet = OutputPointSetType::New();
+  const ImageType*                       input = this->GetInput();
+  typename OutputPointSetType::PointType point;
+  for (unsigned long i = 0; i < maxima.size(); ++i)
+  {
+    input->TransformIndexToPhysicalPoint(maxima[i].first, point);
+    m_PointSet->SetPoint(i, point);
+    m_PointSet->SetPointData(i, static_cast<OutputPointSetPixelType>(maxima[i].second));
+  }
+}
+
+template <class TInputImage, class TOutputPointSet>
+void PersistentLocalMaximaImageToPointSetFilter<TInputImage, TOutputPointSet>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "Threshold: " << m_Threshold << std::endl;
+  os << indent << "MaximumNumberOfPoints: " << m_MaximumNumberOfPoints << std::endl;
+  os << indent << "Number of points: " << m_PointSet->GetNumberOfPoints() << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStructureTensorHarrisImageFilter_h
+#define otbStructureTensorHarrisImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <vector>
+
+namespace otb
+{
+
+/** \class StructureTensorHarrisImageFilter
+ * \brief Compute the Harris corner response from the structure tensor in a single pass
+ *
+ * The derivatives \f$ L_x \f$ and \f$ L_y \f$ of the image are computed
+ * with the derivative of a Gaussian kernel of standard deviation
+ * \f$ \sigma_D \f$ (derivation scale), and their products are smoothed
+ * with a Gaussian kernel of standard deviation \f$ \sigma_I \f$
+ * (integration scale), giving the structure tensor:
+ *
+ * \f[
+ * \mu(\mathbf{x},\sigma_I,\sigma_D) = \sigma_D^2 g(\sigma_I)\star
+ * \left[\begin{array}{cc} L_x^2(\mathbf{x},\sigma_D) &
+ * L_xL_y(\mathbf{x},\sigma_D)\\ L_xL_y(\mathbf{x},\sigma_D)&
+ * L_y^2(\mathbf{x},\sigma_D) \end{array}\right] \f]
+ *
+ * The output is \f$ det(\mu) - \alpha trace^2(\mu) \f$.
+ *
+ * Unlike HarrisImageFilter, which applies the same measure to the
+ * smoothed Hessian through a pipeline of recursive Gaussian filters, all
+ * the steps are fused: the kernels are sampled Gaussians truncated at
+ * \f$ 3\sigma \f$ and applied as separable filters, the horizontally
+ * filtered input rows and products being kept in two rolling buffers of
+ * rows. No intermediate image is allocated, and the filter streams with
+ * an input margin of the sum of both kernel radii. The borders follow a
+ * zero flux Neumann boundary condition at each step.
+ *
+ * \sa HarrisImageFilter
+ * \sa StreamingLocalMaximaImageToPointSetFilter
+ *
+ * \ingroup OTBCorner
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT StructureTensorHarrisImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef StructureTensorHarrisImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(StructureTensorHarrisImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                                 InputImageType;
+  typedef typename InputImageType::RegionType         InputImageRegionType;
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+
+  itkSetMacro(SigmaD, double);
+  itkGetConstReferenceMacro(SigmaD, double);
+
+  itkSetMacro(SigmaI, double);
+  itkGetConstReferenceMacro(SigmaI, double);
+
+  itkSetMacro(Alpha, double);
+  itkGetConstReferenceMacro(Alpha, double);
+
+protected:
+  StructureTensorHarrisImageFilter();
+  ~StructureTensorHarrisImageFilter() override
+  {
+  }
+
+  /** Pad the requested region by the radii of both kernels */
+  void GenerateInputRequestedRegion() override;
+
+  /** Sample the kernels */
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  StructureTensorHarrisImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Radius of the kernel of a Gaussian of standard deviation sigma */
+  static int KernelRadius(double sigma);
+
+  double m_SigmaD;
+  double m_SigmaI;
+  double m_Alpha;
+
+  /** Gaussian and derivative kernels of the derivation scale, and
+   * Gaussian kernel of the integration scale */
+  std::vector<double> m_GaussianD;
+  std::vector<double> m_DerivativeD;
+  std::vector<double> m_GaussianI;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStructureTensorHarrisImageFilter.hxx"
+#endif
+
+#endif
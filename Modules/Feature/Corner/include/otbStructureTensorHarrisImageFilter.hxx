@@ -0,0 +1,289 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStructureTensorHarrisImageFilter_hxx
+#define otbStructureTensorHarrisImageFilter_hxx
+
+#include "otbStructureTensorHarrisImageFilter.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+StructureTensorHarrisImageFilter<TInputImage, TOutputImage>::StructureTensorHarrisImageFilter() : m_SigmaD(1.0), m_SigmaI(1.0), m_Alpha(0.04)
+{
+}
+
+template <class TInputImage, class TOutputImage>
+int StructureTensorHarrisImageFilter<TInputImage, TOutputImage>::KernelRadius(double sigma)
+{
+  return std::max(1, static_cast<int>(std::ceil(3 * sigma)));
+}
+
+template <class TInputImage, class TOutputImage>
+void StructureTensorHarrisImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (!input)
+  {
+    return;
+  }
+
+  InputImageRegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(KernelRadius(m_SigmaD) + KernelRadius(m_SigmaI));
+  if (!inputRequestedRegion.Crop(input->GetLargestPossibleRegion()))
+  {
+    itkExceptionMacro(<< "The requested region is outside the input image");
+  }
+  input->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void StructureTensorHarrisImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  if (m_SigmaD <= 0. || m_SigmaI <= 0.)
+  {
+    itkExceptionMacro(<< "SigmaD and SigmaI must be positive");
+  }
+
+  // Normalized Gaussian kernels, and derivative kernel normalized so that
+  // the derivative of a ramp is exact
+  const int radiusD = KernelRadius(m_SigmaD);
+  const int radiusI = KernelRadius(m_SigmaI);
+
+  m_GaussianD.resize(2 * radiusD + 1);
+  m_DerivativeD.resize(2 * radiusD + 1);
+  m_GaussianI.resize(2 * radiusI + 1);
+
+  double sumD = 0., momentD = 0., sumI = 0.;
+  for (int k = -radiusD; k <= radiusD; ++k)
+  {
+    m_GaussianD[k + radiusD] = std::exp(-k * k / (2 * m_SigmaD * m_SigmaD));
+    sumD += m_GaussianD[k + radiusD];
+    momentD += k * k * m_GaussianD[k + radiusD];
+  }
+  for (int k = -radiusD; k <= radiusD; ++k)
+  {
+    m_DerivativeD[k + radiusD] = k * m_GaussianD[k + radiusD] / momentD;
+    m_GaussianD[k + radiusD] /= sumD;
+  }
+  for (int k = -radiusI; k <= radiusI; ++k)
+  {
+    m_GaussianI[k + radiusI] = std::exp(-k * k / (2 * m_SigmaI * m_SigmaI));
+    sumI += m_GaussianI[k + radiusI];
+  }
+  for (int k = -radiusI; k <= radiusI; ++k)
+  {
+    m_GaussianI[k + radiusI] /= sumI;
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void StructureTensorHarrisImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                       itk::ThreadIdType            threadId)
+{
+  const InputImageType*       input    = this->GetInput();
+  OutputImageType*            output   = this->GetOutput();
+  const InputImageRegionType& largest  = input->GetLargestPossibleRegion();
+  const InputImageRegionType& buffered = input->GetBufferedRegion();
+
+  const int radiusD = (m_GaussianD.size() - 1) / 2;
+  const int radiusI = (m_GaussianI.size() - 1) / 2;
+
+  const long firstX = largest.GetIndex()[0];
+  const long lastX  = firstX + static_cast<long>(largest.GetSize()[0]) - 1;
+  const long firstY = largest.GetIndex()[1];
+  const long lastY  = firstY + static_cast<long>(largest.GetSize()[1]) - 1;
+  auto       clampX = [firstX, lastX](long x) { return std::min(std::max(x, firstX), lastX); };
+  auto       clampY = [firstY, lastY](long y) { return std::min(std::max(y, firstY), lastY); };
+
+  const long x0    = outputRegionForThread.GetIndex()[0];
+  const long y0    = outputRegionForThread.GetIndex()[1];
+  const long width = outputRegionForThread.GetSize()[0];
+
+  // Columns of the products needed by the integration kernel
+  const long productX0     = clampX(x0 - radiusI);
+  const long productWidth  = clampX(x0 + width - 1 + radiusI) - productX0 + 1;
+  const long lineWidth     = productWidth + 2 * radiusD;
+  const long extendedWidth = width + 2 * radiusI;
+
+  // Rolling buffer of the horizontally smoothed and derived input rows,
+  // indexed by input row
+  const long          nbInputSlots = 2 * radiusD + 1;
+  std::vector<double> smoothedRows(nbInputSlots * productWidth), derivedRows(nbInputSlots * productWidth);
+  std::vector<long>   inputSlotRows(nbInputSlots, firstY - 1);
+
+  // Rolling buffer of the horizontally smoothed products, indexed by row
+  const long          nbProductSlots = 2 * radiusI + 1;
+  std::vector<double> smoothedXX(nbProductSlots * width), smoothedXY(nbProductSlots * width), smoothedYY(nbProductSlots * width);
+
+  std::vector<double> line(lineWidth), lx(productWidth), ly(productWidth);
+  std::vector<double> extendedXX(extendedWidth), extendedXY(extendedWidth), extendedYY(extendedWidth);
+  std::vector<double> mxx(width), mxy(width), myy(width);
+  std::vector<long>   extendedColumns(extendedWidth);
+  for (long j = 0; j < extendedWidth; ++j)
+  {
+    extendedColumns[j] = clampX(x0 - radiusI + j) - productX0;
+  }
+
+  const auto* buffer = input->GetBufferPointer();
+
+  // Horizontal filtering of an input row, once per row
+  auto filterInputRow = [&](long row) {
+    const long slot = (row - firstY) % nbInputSlots;
+    if (inputSlotRows[slot] == row)
+    {
+      return slot;
+    }
+    inputSlotRows[slot] = row;
+
+    const auto* rowData = buffer + (row - buffered.GetIndex()[1]) * buffered.GetSize()[0];
+    for (long j = 0; j < lineWidth; ++j)
+    {
+      line[j] = static_cast<double>(rowData[clampX(productX0 - radiusD + j) - buffered.GetIndex()[0]]);
+    }
+
+    double* smoothed = &smoothedRows[slot * productWidth];
+    double* derived  = &derivedRows[slot * productWidth];
+    std::fill(smoothed, smoothed + productWidth, 0.);
+    std::fill(derived, derived + productWidth, 0.);
+    for (int k = 0; k <= 2 * radiusD; ++k)
+    {
+      const double  g    = m_GaussianD[k];
+      const double  d    = m_DerivativeD[k];
+      const double* taps = &line[k];
+      for (long c = 0; c < productWidth; ++c)
+      {
+        smoothed[c] += g * taps[c];
+        derived[c] += d * taps[c];
+      }
+    }
+    return slot;
+  };
+
+  // Derivatives and products of a row, horizontally smoothed
+  auto computeProductRow = [&](long row) {
+    std::fill(lx.begin(), lx.end(), 0.);
+    std::fill(ly.begin(), ly.end(), 0.);
+    for (int k = 0; k <= 2 * radiusD; ++k)
+    {
+      const long    slot     = filterInputRow(clampY(row - radiusD + k));
+      const double* smoothed = &smoothedRows[slot * productWidth];
+      const double* derived  = &derivedRows[slot * productWidth];
+      const double  g        = m_GaussianD[k];
+      const double  d        = m_DerivativeD[k];
+      for (long c = 0; c < productWidth; ++c)
+      {
+        lx[c] += g * derived[c];
+        ly[c] += d * smoothed[c];
+      }
+    }
+
+    for (long j = 0; j < extendedWidth; ++j)
+    {
+      const long c  = extendedColumns[j];
+      extendedXX[j] = lx[c] * lx[c];
+      extendedXY[j] = lx[c] * ly[c];
+      extendedYY[j] = ly[c] * ly[c];
+    }
+
+    const long slot = (row - firstY) % nbProductSlots;
+    double*    sxx  = &smoothedXX[slot * width];
+    double*    sxy  = &smoothedXY[slot * width];
+    double*    syy  = &smoothedYY[slot * width];
+    std::fill(sxx, sxx + width, 0.);
+    std::fill(sxy, sxy + width, 0.);
+    std::fill(syy, syy + width, 0.);
+    for (int k = 0; k <= 2 * radiusI; ++k)
+    {
+      const double g = m_GaussianI[k];
+      for (long i = 0; i < width; ++i)
+      {
+        sxx[i] += g * extendedXX[i + k];
+        sxy[i] += g * extendedXY[i + k];
+        syy[i] += g * extendedYY[i + k];
+      }
+    }
+  };
+
+  const double scale = std::pow(m_SigmaD, 4.0);
+
+  const OutputImageRegionType& outputBuffered = output->GetBufferedRegion();
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize()[1]);
+
+  long nextProductRow = clampY(y0 - radiusI);
+  for (unsigned int row = 0; row < outputRegionForThread.GetSize()[1]; ++row)
+  {
+    const long y = y0 + row;
+    for (; nextProductRow <= clampY(y + radiusI); ++nextProductRow)
+    {
+      computeProductRow(nextProductRow);
+    }
+
+    // Vertical smoothing of the products
+    std::fill(mxx.begin(), mxx.end(), 0.);
+    std::fill(mxy.begin(), mxy.end(), 0.);
+    std::fill(myy.begin(), myy.end(), 0.);
+    for (int k = 0; k <= 2 * radiusI; ++k)
+    {
+      const long    slot = (clampY(y - radiusI + k) - firstY) % nbProductSlots;
+      const double* sxx  = &smoothedXX[slot * width];
+      const double* sxy  = &smoothedXY[slot * width];
+      const double* syy  = &smoothedYY[slot * width];
+      const double  g    = m_GaussianI[k];
+      for (long i = 0; i < width; ++i)
+      {
+        mxx[i] += g * sxx[i];
+        mxy[i] += g * sxy[i];
+        myy[i] += g * syy[i];
+      }
+    }
+
+    OutputInternalPixelType* out =
+        output->GetBufferPointer() + (y - outputBuffered.GetIndex()[1]) * outputBuffered.GetSize()[0] + x0 - outputBuffered.GetIndex()[0];
+    for (long i = 0; i < width; ++i)
+    {
+      const double trace = mxx[i] + myy[i];
+      out[i]             = static_cast<OutputInternalPixelType>(scale * (mxx[i] * myy[i] - mxy[i] * mxy[i] - m_Alpha * trace * trace));
+    }
+
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void StructureTensorHarrisImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Sigma_D : " << this->m_SigmaD << std::endl;
+  os << indent << "Sigma_I : " << this->m_SigmaI << std::endl;
+  os << indent << "Alpha   : " << this->m_Alpha << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -31,6 +31,7 @@ otb_module(OTBCorner
     OTBPointSet
     OTBImageManipulation
     OTBCommon
+    OTBStreaming
 
   TEST_DEPENDS
     OTBVectorDataIO
@@ -25,4 +25,6 @@ void RegisterTests()
   REGISTER_TEST(otbVectorDataToRightAngleVectorDataFilter);
   REGISTER_TEST(otbHarrisImage);
   REGISTER_TEST(otbHarrisToPointSet);
+  REGISTER_TEST(otbStructureTensorHarrisImageFilterStreaming);
+  REGISTER_TEST(otbStreamingLocalMaximaImageToPointSetFilter);
 }
@@ -0,0 +1,175 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbStructureTensorHarrisImageFilter.h"
+#include "otbStreamingLocalMaximaImageToPointSetFilter.h"
+#include "itkStreamingImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+
+namespace
+{
+typedef otb::Image<float, 2> ImageType;
+
+// Bright square on a dark background
+ImageType::Pointer MakeSquareImage()
+{
+  ImageType::RegionType region;
+  region.SetSize(0, 64);
+  region.SetSize(1, 64);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  image->FillBuffer(10);
+
+  ImageType::IndexType index;
+  for (index[1] = 20; index[1] < 40; ++index[1])
+  {
+    for (index[0] = 20; index[0] < 40; ++index[0])
+    {
+      image->SetPixel(index, 200);
+    }
+  }
+  return image;
+}
+}
+
+int otbStructureTensorHarrisImageFilterStreaming(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::StructureTensorHarrisImageFilter<ImageType, ImageType> HarrisType;
+  typedef itk::StreamingImageFilter<ImageType, ImageType>             StreamingType;
+
+  ImageType::Pointer image = MakeSquareImage();
+
+  HarrisType::Pointer harris = HarrisType::New();
+  harris->SetInput(image);
+  harris->SetSigmaD(1.);
+  harris->SetSigmaI(1.5);
+  harris->SetAlpha(0.04);
+  harris->Update();
+
+  // The response must not depend on the tiling
+  HarrisType::Pointer streamedHarris = HarrisType::New();
+  streamedHarris->SetInput(image);
+  streamedHarris->SetSigmaD(1.);
+  streamedHarris->SetSigmaI(1.5);
+  streamedHarris->SetAlpha(0.04);
+
+  StreamingType::Pointer streaming = StreamingType::New();
+  streaming->SetInput(streamedHarris->GetOutput());
+  streaming->SetNumberOfStreamDivisions(7);
+  streaming->Update();
+
+  itk::ImageRegionConstIterator<ImageType> it(harris->GetOutput(), image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> streamedIt(streaming->GetOutput(), image->GetLargestPossibleRegion());
+  float                                    maxResponse = 0;
+  for (it.GoToBegin(), streamedIt.GoToBegin(); !it.IsAtEnd(); ++it, ++streamedIt)
+  {
+    if (std::abs(it.Get() - streamedIt.Get()) > 1e-3 * (1 + std::abs(it.Get())))
+    {
+      std::cerr << "Streamed response " << streamedIt.Get() << " differs from " << it.Get() << " at " << it.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+    maxResponse = std::max(maxResponse, it.Get());
+  }
+
+  // Flat areas have no response, edges a negative one
+  ImageType::IndexType flat   = {{5, 5}};
+  ImageType::IndexType edge   = {{30, 20}};
+  ImageType::IndexType corner = {{20, 20}};
+  if (std::abs(harris->GetOutput()->GetPixel(flat)) > 1e-3 * maxResponse || harris->GetOutput()->GetPixel(edge) >= 0 ||
+      harris->GetOutput()->GetPixel(corner) <= 0)
+  {
+    std::cerr << "Unexpected responses: flat " << harris->GetOutput()->GetPixel(flat) << ", edge " << harris->GetOutput()->GetPixel(edge) << ", corner "
+              << harris->GetOutput()->GetPixel(corner) << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int otbStreamingLocalMaximaImageToPointSetFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::StructureTensorHarrisImageFilter<ImageType, ImageType>             HarrisType;
+  typedef itk::PointSet<float, 2>                                                 PointSetType;
+  typedef otb::StreamingLocalMaximaImageToPointSetFilter<ImageType, PointSetType> MaximaType;
+
+  ImageType::Pointer image = MakeSquareImage();
+
+  HarrisType::Pointer harris = HarrisType::New();
+  harris->SetInput(image);
+  harris->SetSigmaD(1.);
+  harris->SetSigmaI(1.5);
+  harris->Update();
+
+  float                                    maxResponse = 0;
+  itk::ImageRegionConstIterator<ImageType> it(harris->GetOutput(), image->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    maxResponse = std::max(maxResponse, it.Get());
+  }
+
+  // The four corners of the square, whatever the number of strips
+  for (unsigned int divisions = 1; divisions <= 9; divisions += 4)
+  {
+    MaximaType::Pointer maxima = MaximaType::New();
+    maxima->SetInput(harris->GetOutput());
+    maxima->GetFilter()->SetRadius(3);
+    maxima->GetFilter()->SetThreshold(0.1 * maxResponse);
+    maxima->GetStreamer()->SetNumberOfDivisionsStrippedStreaming(divisions);
+    maxima->Update();
+
+    PointSetType* points = maxima->GetPointSet();
+    if (points->GetNumberOfPoints() != 4)
+    {
+      std::cerr << points->GetNumberOfPoints() << " maxima found with " << divisions << " strips instead of 4" << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    for (unsigned long i = 0; i < points->GetNumberOfPoints(); ++i)
+    {
+      PointSetType::PointType point;
+      points->GetPoint(i, &point);
+      const double dx = std::min(std::abs(point[0] - 19.5), std::abs(point[0] - 39.5));
+      const double dy = std::min(std::abs(point[1] - 19.5), std::abs(point[1] - 39.5));
+      if (dx > 2 || dy > 2)
+      {
+        std::cerr << "Maximum " << point << " is not at a corner of the square" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+
+    // Only the strongest maxima are kept
+    maxima->GetFilter()->SetMaximumNumberOfPoints(2);
+    maxima->Update();
+    if (maxima->GetPointSet()->GetNumberOfPoints() != 2)
+    {
+      std::cerr << maxima->GetPointSet()->GetNumberOfPoints() << " maxima kept instead of 2" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
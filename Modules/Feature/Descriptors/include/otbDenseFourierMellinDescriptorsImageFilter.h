@@ -0,0 +1,137 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDenseFourierMellinDescriptorsImageFilter_h
+#define otbDenseFourierMellinDescriptorsImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <complex>
+#include <vector>
+
+namespace otb
+{
+
+/**
+ * \class DenseFourierMellinDescriptorsImageFilter
+ * \brief Compute the Fourier-Mellin descriptors of every pixel of a grid
+ *
+ * This filter computes, for every Stride-th pixel in both directions, the
+ * same Fourier-Mellin descriptors \f$ D_{p, q} \f$ as
+ * FourierMellinDescriptorsImageFunction, and writes them as a pixel of
+ * the output vector image, so that the descriptors can be used as the
+ * features of a classifier. The output pixel holds the
+ * (Pmax + 1) x (Qmax + 1) descriptors, q varying first.
+ *
+ * Each moment \f$ M_{p, q} \f$ is a weighted sum of the neighborhood
+ * values, whose complex weights only depend on the position of the
+ * neighbor. They are computed once per update, instead of calling
+ * std::pow twice for every neighbor, moment and pixel, and the
+ * neighborhood values are read once per tile.
+ *
+ * The output is expected to be an otb::VectorImage. The output grid keeps
+ * the origin of the input, and its spacing is multiplied by the stride.
+ *
+ * \sa FourierMellinDescriptorsImageFunction
+ *
+ * \ingroup OTBDescriptors
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT DenseFourierMellinDescriptorsImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef DenseFourierMellinDescriptorsImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DenseFourierMellinDescriptorsImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                                 InputImageType;
+  typedef typename InputImageType::RegionType         InputImageRegionType;
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+
+  typedef double                               ScalarRealType;
+  typedef typename std::complex<ScalarRealType> ScalarComplexType;
+
+  /** Get/Set the radius of the neighborhood over which the
+   *  descriptors are computed
+   */
+  itkSetMacro(NeighborhoodRadius, unsigned int);
+  itkGetConstReferenceMacro(NeighborhoodRadius, unsigned int);
+
+  itkSetMacro(Pmax, unsigned int);
+  itkGetConstReferenceMacro(Pmax, unsigned int);
+
+  itkSetMacro(Qmax, unsigned int);
+  itkGetConstReferenceMacro(Qmax, unsigned int);
+
+  /** Get/Set the step between two descriptors, in pixels */
+  itkSetClampMacro(Stride, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+  itkGetConstMacro(Stride, unsigned int);
+
+protected:
+  DenseFourierMellinDescriptorsImageFilter();
+  ~DenseFourierMellinDescriptorsImageFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void GenerateInputRequestedRegion() override;
+
+  /** Compute the weights of the neighbors */
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  DenseFourierMellinDescriptorsImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Input index of the descriptor of an output index */
+  typename InputImageType::IndexType OutputToInputIndex(const typename OutputImageType::IndexType& index) const;
+
+  unsigned int m_Pmax;
+  unsigned int m_Qmax;
+  unsigned int m_NeighborhoodRadius;
+  double       m_Sigma;
+  unsigned int m_Stride;
+
+  /** Weights of each neighbor (x varying first) for each moment */
+  std::vector<ScalarComplexType> m_Weights;
+};
+
+} // namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbDenseFourierMellinDescriptorsImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,237 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDenseFourierMellinDescriptorsImageFilter_hxx
+#define otbDenseFourierMellinDescriptorsImageFilter_hxx
+
+#include "otbDenseFourierMellinDescriptorsImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+#include "otbMath.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+DenseFourierMellinDescriptorsImageFilter<TInputImage, TOutputImage>::DenseFourierMellinDescriptorsImageFilter()
+  : m_Pmax(3), m_Qmax(3), m_NeighborhoodRadius(1), m_Sigma(0.5), m_Stride(1)
+{
+}
+
+template <class TInputImage, class TOutputImage>
+typename TInputImage::IndexType
+DenseFourierMellinDescriptorsImageFilter<TInputImage, TOutputImage>::OutputToInputIndex(const typename OutputImageType::IndexType& index) const
+{
+  const typename InputImageType::IndexType&  inputIndex  = this->GetInput()->GetLargestPossibleRegion().GetIndex();
+  const typename OutputImageType::IndexType& outputIndex = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+
+  typename InputImageType::IndexType result;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    result[dim] = inputIndex[dim] + (index[dim] - outputIndex[dim]) * m_Stride;
+  }
+  return result;
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseFourierMellinDescriptorsImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType* inputPtr  = this->GetInput();
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  const InputImageRegionType&              inputLargestRegion = inputPtr->GetLargestPossibleRegion();
+  typename OutputImageRegionType::SizeType outputSize;
+  typename InputImageType::SpacingType     spacing = inputPtr->GetSignedSpacing();
+
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    outputSize[dim] = (inputLargestRegion.GetSize()[dim] + m_Stride - 1) / m_Stride;
+    spacing[dim] *= m_Stride;
+  }
+
+  OutputImageRegionType outputLargestRegion;
+  outputLargestRegion.SetIndex(inputLargestRegion.GetIndex());
+  outputLargestRegion.SetSize(outputSize);
+
+  outputPtr->SetLargestPossibleRegion(outputLargestRegion);
+  outputPtr->SetSignedSpacing(spacing);
+  outputPtr->SetNumberOfComponentsPerPixel((m_Pmax + 1) * (m_Qmax + 1));
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseFourierMellinDescriptorsImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  const OutputImageRegionType&        outputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  typename OutputImageType::IndexType lastIndex             = outputRequestedRegion.GetIndex();
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    lastIndex[dim] += outputRequestedRegion.GetSize()[dim] - 1;
+  }
+
+  const typename InputImageType::IndexType first = OutputToInputIndex(outputRequestedRegion.GetIndex());
+  const typename InputImageType::IndexType last  = OutputToInputIndex(lastIndex);
+
+  typename InputImageRegionType::SizeType size;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    size[dim] = last[dim] - first[dim] + 1;
+  }
+
+  InputImageRegionType inputRequestedRegion(first, size);
+  inputRequestedRegion.PadByRadius(m_NeighborhoodRadius);
+  if (!inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    itkExceptionMacro(<< "The requested region is outside the input image");
+  }
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseFourierMellinDescriptorsImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  // Same weights as in FourierMellinDescriptorsImageFunction, the center
+  // being excluded by the std::pow limitation
+  const int          radius    = m_NeighborhoodRadius;
+  const unsigned int nbMoments = (m_Pmax + 1) * (m_Qmax + 1);
+
+  m_Weights.assign((2 * radius + 1) * (2 * radius + 1) * nbMoments, ScalarComplexType(0., 0.));
+
+  unsigned int k = 0;
+  for (int j = -radius; j <= radius; ++j)
+  {
+    for (int i = -radius; i <= radius; ++i, ++k)
+    {
+      const ScalarRealType x = static_cast<ScalarRealType>(i) / (2 * m_NeighborhoodRadius + 1);
+      const ScalarRealType y = static_cast<ScalarRealType>(j) / (2 * m_NeighborhoodRadius + 1);
+
+      if (x != 0 || y != 0)
+      {
+        ScalarComplexType xplusiy(x, y), x2plusy2(x * x + y * y, 0.0);
+        for (unsigned int p = 0; p <= m_Pmax; p++)
+        {
+          for (unsigned int q = 0; q <= m_Qmax; q++)
+          {
+            ScalarComplexType power(double(p - 2.0 + m_Sigma) / 2.0, -double(q) / 2.0);
+
+            m_Weights[k * nbMoments + p * (m_Qmax + 1) + q] = std::pow(xplusiy, -static_cast<double>(p)) * std::pow(x2plusy2, power);
+          }
+        }
+      }
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseFourierMellinDescriptorsImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                itk::ThreadIdType            threadId)
+{
+  const InputImageType*       inputPtr = this->GetInput();
+  const InputImageRegionType& buffered = inputPtr->GetBufferedRegion();
+
+  const int          radius      = m_NeighborhoodRadius;
+  const unsigned int diameter    = 2 * radius + 1;
+  const unsigned int nbNeighbors = diameter * diameter;
+  const unsigned int nbMoments   = (m_Pmax + 1) * (m_Qmax + 1);
+
+  // Values of the tile covering the descriptors of the region, with a
+  // zero flux Neumann boundary condition
+  const typename InputImageType::IndexType first = OutputToInputIndex(outputRegionForThread.GetIndex());
+  const long tileWidth  = (outputRegionForThread.GetSize()[0] - 1) * m_Stride + 2 * radius + 1;
+  const long tileHeight = (outputRegionForThread.GetSize()[1] - 1) * m_Stride + 2 * radius + 1;
+
+  std::vector<ScalarRealType> values(tileWidth * tileHeight);
+
+  typename InputImageType::IndexType index;
+  for (long y = 0; y < tileHeight; ++y)
+  {
+    index[1] = std::min(std::max(first[1] - radius + y, buffered.GetIndex()[1]), buffered.GetIndex()[1] + static_cast<long>(buffered.GetSize()[1]) - 1);
+    for (long x = 0; x < tileWidth; ++x)
+    {
+      index[0] = std::min(std::max(first[0] - radius + x, buffered.GetIndex()[0]), buffered.GetIndex()[0] + static_cast<long>(buffered.GetSize()[0]) - 1);
+      values[y * tileWidth + x] = static_cast<ScalarRealType>(inputPtr->GetPixel(index));
+    }
+  }
+
+  // Offsets of the neighbors in the tile
+  std::vector<long> tileOffsets(nbNeighbors);
+  for (unsigned int k = 0; k < nbNeighbors; ++k)
+  {
+    tileOffsets[k] = (static_cast<long>(k / diameter) - radius) * tileWidth + static_cast<long>(k % diameter) - radius;
+  }
+
+  std::vector<ScalarComplexType> coefs(nbMoments);
+
+  typename OutputImageType::PixelType outputPixel(nbMoments);
+
+  itk::ImageRegionIterator<OutputImageType> outIt(this->GetOutput(), outputRegionForThread);
+  itk::ProgressReporter                     progress(this, threadId, outputRegionForThread.GetSize()[1]);
+
+  for (unsigned int row = 0; row < outputRegionForThread.GetSize()[1]; ++row)
+  {
+    for (unsigned int col = 0; col < outputRegionForThread.GetSize()[0]; ++col, ++outIt)
+    {
+      const long center = (radius + row * m_Stride) * tileWidth + radius + col * m_Stride;
+
+      std::fill(coefs.begin(), coefs.end(), ScalarComplexType(0., 0.));
+      for (unsigned int k = 0; k < nbNeighbors; ++k)
+      {
+        const ScalarRealType     value   = values[center + tileOffsets[k]];
+        const ScalarComplexType* weights = &m_Weights[k * nbMoments];
+        for (unsigned int m = 0; m < nbMoments; ++m)
+        {
+          coefs[m] += weights[m] * value;
+        }
+      }
+
+      // Normalisation, M_{0, 0} being normalized last
+      for (int m = nbMoments - 1; m >= 0; m--)
+      {
+        coefs[m] /= 2 * CONST_PI * coefs[0];
+        outputPixel[m] = static_cast<OutputInternalPixelType>(std::sqrt(coefs[m].real() * coefs[m].real() + coefs[m].imag() * coefs[m].imag()));
+      }
+      outIt.Set(outputPixel);
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseFourierMellinDescriptorsImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Pmax: " << m_Pmax << std::endl;
+  os << indent << "Qmax: " << m_Qmax << std::endl;
+  os << indent << "NeighborhoodRadius: " << m_NeighborhoodRadius << std::endl;
+  os << indent << "Stride: " << m_Stride << std::endl;
+}
+
+} // namespace otb
+
+#endif
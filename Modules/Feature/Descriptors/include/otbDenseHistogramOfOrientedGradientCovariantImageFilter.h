@@ -0,0 +1,151 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDenseHistogramOfOrientedGradientCovariantImageFilter_h
+#define otbDenseHistogramOfOrientedGradientCovariantImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <vector>
+
+namespace otb
+{
+
+/**
+ * \class DenseHistogramOfOrientedGradientCovariantImageFilter
+ * \brief Compute the centered HOG features of every pixel of a grid
+ *
+ * This filter computes, for every Stride-th pixel in both directions, the
+ * same centered histogram of gradient as
+ * HistogramOfOrientedGradientCovariantImageFunction, and writes it as a
+ * pixel of the output vector image, so that the descriptors can be used
+ * as the features of a classifier. The output pixel holds the center,
+ * upper-left, upper-right, lower-right and lower-left histograms, each of
+ * NumberOfOrientationBins bins, in this order.
+ *
+ * Evaluating the image function at every pixel computes the orientation
+ * and magnitude of each gradient of the neighborhood again for every
+ * pixel, along with the gaussian weights and the angular positions of
+ * the neighbors. Here the orientation and magnitude of the gradients are
+ * computed once per tile, and the weights and the spatial bins of the
+ * neighbors, for each of the possible principal orientations, once per
+ * update. The descriptors are not computed from integral histograms,
+ * since both the gaussian weighting and the orientation of the spatial
+ * bins depend on the position of the neighbors with respect to each
+ * descriptor center.
+ *
+ * The input is expected to be a gradient covariant image, such as the
+ * output of the itk::GradientImageFilter, and the output an
+ * otb::VectorImage. The output grid keeps the origin of the input, and
+ * its spacing is multiplied by the stride.
+ *
+ * \sa HistogramOfOrientedGradientCovariantImageFunction
+ *
+ * \ingroup OTBDescriptors
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT DenseHistogramOfOrientedGradientCovariantImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef DenseHistogramOfOrientedGradientCovariantImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DenseHistogramOfOrientedGradientCovariantImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                                 InputImageType;
+  typedef typename InputImageType::PixelType          InputPixelType;
+  typedef typename InputImageType::RegionType         InputImageRegionType;
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+
+  /** Get/Set the radius of the neighborhood over which the
+   *  histograms are computed
+   */
+  itkSetMacro(NeighborhoodRadius, unsigned int);
+  itkGetConstReferenceMacro(NeighborhoodRadius, unsigned int);
+
+  /** Get/Set the number of bins of the orientation histograms
+   */
+  itkSetMacro(NumberOfOrientationBins, unsigned int);
+  itkGetConstReferenceMacro(NumberOfOrientationBins, unsigned int);
+
+  /** Get/Set the step between two descriptors, in pixels */
+  itkSetClampMacro(Stride, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+  itkGetConstMacro(Stride, unsigned int);
+
+protected:
+  DenseHistogramOfOrientedGradientCovariantImageFilter();
+  ~DenseHistogramOfOrientedGradientCovariantImageFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void GenerateInputRequestedRegion() override;
+
+  /** Compute the neighbors weights and spatial bins */
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  DenseHistogramOfOrientedGradientCovariantImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Input index of the descriptor of an output index */
+  typename InputImageType::IndexType OutputToInputIndex(const typename OutputImageType::IndexType& index) const;
+
+  // Radius over which the principal orientation will be computed
+  unsigned int m_NeighborhoodRadius;
+
+  // Number of bins in the orientation
+  unsigned int m_NumberOfOrientationBins;
+
+  // Step between two descriptors
+  unsigned int m_Stride;
+
+  /** Neighbors of the disc, with their gaussian weight, and whether they
+   * lie in the center bin */
+  std::vector<int>    m_OffsetsX;
+  std::vector<int>    m_OffsetsY;
+  std::vector<double> m_Weights;
+  std::vector<bool>   m_InCenterBin;
+
+  /** Spatial bin of each neighbor for each principal orientation bin */
+  std::vector<unsigned int> m_SpatialBins;
+};
+
+} // namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbDenseHistogramOfOrientedGradientCovariantImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,324 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDenseHistogramOfOrientedGradientCovariantImageFilter_hxx
+#define otbDenseHistogramOfOrientedGradientCovariantImageFilter_hxx
+
+#include "otbDenseHistogramOfOrientedGradientCovariantImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+#include "otbMath.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+DenseHistogramOfOrientedGradientCovariantImageFilter<TInputImage, TOutputImage>::DenseHistogramOfOrientedGradientCovariantImageFilter()
+  : m_NeighborhoodRadius(8), m_NumberOfOrientationBins(18), m_Stride(1)
+{
+}
+
+template <class TInputImage, class TOutputImage>
+typename TInputImage::IndexType
+DenseHistogramOfOrientedGradientCovariantImageFilter<TInputImage, TOutputImage>::OutputToInputIndex(const typename OutputImageType::IndexType& index) const
+{
+  const typename InputImageType::IndexType&  inputIndex  = this->GetInput()->GetLargestPossibleRegion().GetIndex();
+  const typename OutputImageType::IndexType& outputIndex = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+
+  typename InputImageType::IndexType result;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    result[dim] = inputIndex[dim] + (index[dim] - outputIndex[dim]) * m_Stride;
+  }
+  return result;
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseHistogramOfOrientedGradientCovariantImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType* inputPtr  = this->GetInput();
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  const InputImageRegionType&              inputLargestRegion = inputPtr->GetLargestPossibleRegion();
+  typename OutputImageRegionType::SizeType outputSize;
+  typename InputImageType::SpacingType     spacing = inputPtr->GetSignedSpacing();
+
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    outputSize[dim] = (inputLargestRegion.GetSize()[dim] + m_Stride - 1) / m_Stride;
+    spacing[dim] *= m_Stride;
+  }
+
+  OutputImageRegionType outputLargestRegion;
+  outputLargestRegion.SetIndex(inputLargestRegion.GetIndex());
+  outputLargestRegion.SetSize(outputSize);
+
+  outputPtr->SetLargestPossibleRegion(outputLargestRegion);
+  outputPtr->SetSignedSpacing(spacing);
+  outputPtr->SetNumberOfComponentsPerPixel(5 * m_NumberOfOrientationBins);
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseHistogramOfOrientedGradientCovariantImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  const OutputImageRegionType&        outputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  typename OutputImageType::IndexType lastIndex             = outputRequestedRegion.GetIndex();
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    lastIndex[dim] += outputRequestedRegion.GetSize()[dim] - 1;
+  }
+
+  const typename InputImageType::IndexType first = OutputToInputIndex(outputRequestedRegion.GetIndex());
+  const typename InputImageType::IndexType last  = OutputToInputIndex(lastIndex);
+
+  typename InputImageRegionType::SizeType size;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    size[dim] = last[dim] - first[dim] + 1;
+  }
+
+  InputImageRegionType inputRequestedRegion(first, size);
+  inputRequestedRegion.PadByRadius(m_NeighborhoodRadius);
+  if (!inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    itkExceptionMacro(<< "The requested region is outside the input image");
+  }
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseHistogramOfOrientedGradientCovariantImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  // Same neighbors, weights and spatial bins as in
+  // HistogramOfOrientedGradientCovariantImageFunction
+  const double centerBinRadius        = static_cast<double>(m_NeighborhoodRadius) / 2;
+  const double squaredRadius          = m_NeighborhoodRadius * m_NeighborhoodRadius;
+  const double squaredCenterBinRadius = centerBinRadius * centerBinRadius;
+  const double squaredSigma           = 0.25 * squaredRadius;
+  const double orientationBinWidth    = otb::CONST_2PI / m_NumberOfOrientationBins;
+
+  m_OffsetsX.clear();
+  m_OffsetsY.clear();
+  m_Weights.clear();
+  m_InCenterBin.clear();
+  std::vector<double> angularPositions;
+
+  for (int i = -(int)m_NeighborhoodRadius; i < (int)m_NeighborhoodRadius; ++i)
+  {
+    for (int j = -(int)m_NeighborhoodRadius; j < (int)m_NeighborhoodRadius; ++j)
+    {
+      const double currentSquaredRadius = i * i + j * j;
+      if (currentSquaredRadius < squaredRadius)
+      {
+        m_OffsetsX.push_back(i);
+        m_OffsetsY.push_back(j);
+        m_Weights.push_back((1 / std::sqrt(otb::CONST_2PI * squaredSigma)) * std::exp(-currentSquaredRadius / (2 * squaredSigma)));
+        m_InCenterBin.push_back(currentSquaredRadius < squaredCenterBinRadius);
+        angularPositions.push_back(std::atan2((double)j, (double)i));
+      }
+    }
+  }
+
+  // Spatial bins: 0 center, 1 upper-left, 2 upper-right, 3 lower-right, 4 lower-left
+  const unsigned int nbNeighbors = m_Weights.size();
+  m_SpatialBins.resize(m_NumberOfOrientationBins * nbNeighbors);
+  for (unsigned int p = 0; p < m_NumberOfOrientationBins; ++p)
+  {
+    const double principalOrientation = p * orientationBinWidth - otb::CONST_PI;
+    for (unsigned int k = 0; k < nbNeighbors; ++k)
+    {
+      double angularPosition = angularPositions[k] - principalOrientation;
+      if (angularPosition > otb::CONST_PI)
+      {
+        angularPosition -= otb::CONST_2PI;
+      }
+      else if (angularPosition < -otb::CONST_PI)
+      {
+        angularPosition += otb::CONST_2PI;
+      }
+
+      unsigned int spatialBin;
+      if (m_InCenterBin[k])
+      {
+        spatialBin = 0;
+      }
+      else if (angularPosition > 0)
+      {
+        spatialBin = angularPosition < otb::CONST_PI_2 ? 2 : 1;
+      }
+      else
+      {
+        spatialBin = angularPosition > -otb::CONST_PI_2 ? 3 : 4;
+      }
+      m_SpatialBins[p * nbNeighbors + k] = spatialBin;
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseHistogramOfOrientedGradientCovariantImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                            itk::ThreadIdType            threadId)
+{
+  const InputImageType*       inputPtr = this->GetInput();
+  const InputImageRegionType& buffered = inputPtr->GetBufferedRegion();
+
+  const int          radius              = m_NeighborhoodRadius;
+  const unsigned int nbBins              = m_NumberOfOrientationBins;
+  const unsigned int nbNeighbors         = m_Weights.size();
+  const double       orientationBinWidth = otb::CONST_2PI / nbBins;
+
+  // Orientation, magnitude and orientation bin of the gradients of the
+  // tile covering the descriptors of the region, with a zero flux
+  // Neumann boundary condition
+  const typename InputImageType::IndexType first = OutputToInputIndex(outputRegionForThread.GetIndex());
+  const long tileWidth  = (outputRegionForThread.GetSize()[0] - 1) * m_Stride + 2 * radius + 1;
+  const long tileHeight = (outputRegionForThread.GetSize()[1] - 1) * m_Stride + 2 * radius + 1;
+
+  std::vector<double>       angles(tileWidth * tileHeight);
+  std::vector<double>       magnitudes(tileWidth * tileHeight);
+  std::vector<unsigned int> bins(tileWidth * tileHeight);
+
+  typename InputImageType::IndexType index;
+  for (long y = 0; y < tileHeight; ++y)
+  {
+    index[1] = std::min(std::max(first[1] - radius + y, buffered.GetIndex()[1]), buffered.GetIndex()[1] + static_cast<long>(buffered.GetSize()[1]) - 1);
+    for (long x = 0; x < tileWidth; ++x)
+    {
+      index[0] = std::min(std::max(first[0] - radius + x, buffered.GetIndex()[0]), buffered.GetIndex()[0] + static_cast<long>(buffered.GetSize()[0]) - 1);
+
+      const InputPixelType gradient = inputPtr->GetPixel(index);
+      const long           t        = y * tileWidth + x;
+
+      angles[t]     = std::atan2(gradient[1], gradient[0]);
+      magnitudes[t] = std::sqrt(gradient[0] * gradient[0] + gradient[1] * gradient[1]);
+
+      unsigned int binIndex = std::floor((otb::CONST_PI + angles[t]) / orientationBinWidth);
+      if (binIndex == nbBins)
+        binIndex = nbBins - 1;
+      bins[t] = binIndex;
+    }
+  }
+
+  // Offsets of the neighbors in the tile
+  std::vector<long> tileOffsets(nbNeighbors);
+  for (unsigned int k = 0; k < nbNeighbors; ++k)
+  {
+    tileOffsets[k] = m_OffsetsY[k] * tileWidth + m_OffsetsX[k];
+  }
+
+  std::vector<double> globalOrientationHistogram(nbBins);
+  std::vector<double> histograms(5 * nbBins);
+
+  typename OutputImageType::PixelType outputPixel(5 * nbBins);
+
+  itk::ImageRegionIterator<OutputImageType> outIt(this->GetOutput(), outputRegionForThread);
+  itk::ProgressReporter                     progress(this, threadId, outputRegionForThread.GetSize()[1]);
+
+  for (unsigned int row = 0; row < outputRegionForThread.GetSize()[1]; ++row)
+  {
+    for (unsigned int col = 0; col < outputRegionForThread.GetSize()[0]; ++col, ++outIt)
+    {
+      const long center = (radius + row * m_Stride) * tileWidth + radius + col * m_Stride;
+
+      // Global orientation histogram and principal orientation
+      std::fill(globalOrientationHistogram.begin(), globalOrientationHistogram.end(), 0.);
+      for (unsigned int k = 0; k < nbNeighbors; ++k)
+      {
+        const long t = center + tileOffsets[k];
+        globalOrientationHistogram[bins[t]] += magnitudes[t] * m_Weights[k];
+      }
+
+      double       maxOrientationHistogramValue = globalOrientationHistogram[0];
+      unsigned int maxOrientationHistogramBin   = 0;
+      for (unsigned int i = 1; i < nbBins; ++i)
+      {
+        if (maxOrientationHistogramValue < globalOrientationHistogram[i])
+        {
+          maxOrientationHistogramValue = globalOrientationHistogram[i];
+          maxOrientationHistogramBin   = i;
+        }
+      }
+      const double        principalOrientation = maxOrientationHistogramBin * orientationBinWidth - otb::CONST_PI;
+      const unsigned int* spatialBins          = &m_SpatialBins[maxOrientationHistogramBin * nbNeighbors];
+
+      // Spatial histograms of the compensated orientations
+      std::fill(histograms.begin(), histograms.end(), 0.);
+      for (unsigned int k = 0; k < nbNeighbors; ++k)
+      {
+        const long t     = center + tileOffsets[k];
+        double     angle = angles[t] - principalOrientation;
+        if (angle > otb::CONST_PI)
+        {
+          angle -= otb::CONST_2PI;
+        }
+        else if (angle < -otb::CONST_PI)
+        {
+          angle += otb::CONST_2PI;
+        }
+
+        unsigned int binIndex = std::floor((otb::CONST_PI + angle) / orientationBinWidth);
+        if (binIndex == nbBins)
+          binIndex = nbBins - 1;
+
+        histograms[spatialBins[k] * nbBins + binIndex] += magnitudes[t] * m_Weights[k];
+      }
+
+      // L2 normalization of each histogram
+      for (unsigned int h = 0; h < 5; ++h)
+      {
+        double squaredCumul = 1e-10;
+        for (unsigned int b = 0; b < nbBins; ++b)
+        {
+          squaredCumul += histograms[h * nbBins + b] * histograms[h * nbBins + b];
+        }
+        const double scale = 1 / std::sqrt(squaredCumul);
+        for (unsigned int b = 0; b < nbBins; ++b)
+        {
+          outputPixel[h * nbBins + b] = static_cast<OutputInternalPixelType>(histograms[h * nbBins + b] * scale);
+        }
+      }
+      outIt.Set(outputPixel);
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void DenseHistogramOfOrientedGradientCovariantImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NeighborhoodRadius: " << m_NeighborhoodRadius << std::endl;
+  os << indent << "NumberOfOrientationBins: " << m_NumberOfOrientationBins << std::endl;
+  os << indent << "Stride: " << m_Stride << std::endl;
+}
+
+} // namespace otb
+
+#endif
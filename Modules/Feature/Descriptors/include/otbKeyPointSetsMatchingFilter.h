@@ -24,6 +24,8 @@
 #include "otbObjectListSource.h"
 #include "otbLandmark.h"
 #include "itkEuclideanDistanceMetric.h"
+#include <random>
+#include <vector>
 
 namespace otb
 {
@@ -41,6 +43,11 @@ namespace otb
  *   Matches are stored in a landmark object containing both matched points and point data. The landmark data will hold the distance value
  *   between the data.
  *
+ *   Points of pointset 1 are matched in parallel. By default, neighbors are searched exhaustively. If UseKdForest is on, they are
+ *   searched approximately in a forest of NumberOfKdTrees randomized kd-trees built on the point data, evaluating the distance to at most
+ *   MaxChecks points of the other pointset (best bin first). The trees split point data along Euclidean coordinates, while the distance
+ *   ratio is still computed with TDistance.
+ *
  *   \sa Landmark
  *   \sa PointSet
  *   \sa EuclideanDistanceMetric
@@ -85,6 +92,13 @@ public:
   itkGetMacro(UseBackMatching, bool);
   itkSetMacro(DistanceThreshold, double);
   itkGetMacro(DistanceThreshold, double);
+  itkBooleanMacro(UseKdForest);
+  itkSetMacro(UseKdForest, bool);
+  itkGetMacro(UseKdForest, bool);
+  itkSetMacro(NumberOfKdTrees, unsigned int);
+  itkGetMacro(NumberOfKdTrees, unsigned int);
+  itkSetMacro(MaxChecks, unsigned int);
+  itkGetMacro(MaxChecks, unsigned int);
 
   /// Set the first pointset
   void SetInput1(const PointSetType* pointset);
@@ -118,12 +132,85 @@ private:
   KeyPointSetsMatchingFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Node of a kd-tree. Leaves have a negative Dimension, and hold the points [First, Second) of the tree indices */
+  struct KdNode
+  {
+    int          Dimension;
+    double       Split;
+    unsigned int First;
+    unsigned int Second;
+  };
+
+  /** Randomized kd-tree on point data */
+  struct KdTree
+  {
+    std::vector<KdNode>       Nodes;
+    std::vector<unsigned int> Indices;
+  };
+
+  /** Points and point data of a pointset, with its kd-trees when UseKdForest is on */
+  struct KdForest
+  {
+    std::vector<PointType>     Points;
+    std::vector<PointDataType> Data;
+    std::vector<KdTree>        Trees;
+  };
+
+  /** Per-thread storage for approximate searches */
+  struct SearchWorkspace
+  {
+    std::vector<unsigned int> Visited;
+    unsigned int              Stamp;
+  };
+
+  /** Result of the matching of a point of pointset 1 */
+  struct MatchResult
+  {
+    bool                     Found;
+    NeighborSearchResultType Neighbor;
+  };
+
+  /** Internal structure used for passing the pointsets to the threading library */
+  struct MatchingThreadStruct
+  {
+    Pointer                  Filter;
+    const KdForest*          Forest1;
+    const KdForest*          Forest2;
+    std::vector<MatchResult> Results;
+    unsigned int             NumberOfThreads;
+  };
+
+  /** Copy the points and point data of a pointset, and build its kd-trees if needed */
+  void BuildKdForest(const PointSetType* pointset, bool buildTrees, KdForest& forest) const;
+
+  /** Recursively build the kd-tree node for the tree indices [first, last) */
+  unsigned int BuildKdNode(const KdForest& forest, KdTree& tree, unsigned int first, unsigned int last, std::mt19937& generator) const;
+
+  /** Search the two nearest neighbors of data1 in forest (exhaustively if it has no tree).
+   * \return a pair of (position, distance ratio). */
+  NeighborSearchResultType SearchNeighbors(const PointDataType& data1, const KdForest& forest, SearchWorkspace& workspace) const;
+
+  /** Match the points [first, last) of forest 1 */
+  void MatchRange(MatchingThreadStruct& str, unsigned int first, unsigned int last) const;
+
+  /** Static function used as a "callback" by the MultiThreader to match a block of points */
+  static ITK_THREAD_RETURN_TYPE MatchingThreaderCallback(void* arg);
+
   // Find back matches from 2 to 1 to validate them
   bool m_UseBackMatching;
 
   // Distance threshold to decide matching
   double m_DistanceThreshold;
 
+  // Search neighbors in randomized kd-trees
+  bool m_UseKdForest;
+
+  // Number of randomized kd-trees
+  unsigned int m_NumberOfKdTrees;
+
+  // Maximum number of distance evaluations per approximate search
+  unsigned int m_MaxChecks;
+
   // Distance calculator
   DistancePointerType m_DistanceCalculator;
 };
@@ -23,6 +23,11 @@
 
 #include "otbKeyPointSetsMatchingFilter.h"
 
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+
 namespace otb
 {
 
@@ -32,6 +37,9 @@ KeyPointSetsMatchingFilter<TPointSet, TDistance>::KeyPointSetsMatchingFilter()
   this->SetNumberOfRequiredInputs(2);
   m_UseBackMatching   = false;
   m_DistanceThreshold = 0.6;
+  m_UseKdForest       = false;
+  m_NumberOfKdTrees   = 4;
+  m_MaxChecks         = 256;
   // Object used to measure distance
   m_DistanceCalculator = DistanceType::New();
 }
@@ -63,8 +71,6 @@ void KeyPointSetsMatchingFilter<TPointSet, TDistance>::SetInput2(const PointSetT
 template <class TPointSet, class TDistance>
 void KeyPointSetsMatchingFilter<TPointSet, TDistance>::GenerateData()
 {
-  //   std::cout<<"GenerateData()"<<std::endl;
-
   // Get the input pointers
   const PointSetType* ps1 = this->GetInput1();
   const PointSetType* ps2 = this->GetInput2();
@@ -78,67 +84,260 @@ void KeyPointSetsMatchingFilter<TPointSet, TDistance>::GenerateData()
   // Get the output pointer
   LandmarkListPointerType landmarks = this->GetOutput();
 
-  // Define iterators on points and point data.
-  PointsIteratorType    pIt  = ps1->GetPoints()->Begin();
-  PointDataIteratorType pdIt = ps1->GetPointData()->Begin();
+  // Pointset 1 is only searched for back matching
+  KdForest forest1, forest2;
+  BuildKdForest(ps1, m_UseBackMatching, forest1);
+  BuildKdForest(ps2, true, forest2);
+
+  // Match blocks of points of pointset 1 in parallel
+  MatchingThreadStruct str;
+  str.Filter          = this;
+  str.Forest1         = &forest1;
+  str.Forest2         = &forest2;
+  str.NumberOfThreads = std::max(1u, std::min(static_cast<unsigned int>(this->GetNumberOfThreads()), static_cast<unsigned int>(forest1.Data.size())));
+  str.Results.resize(forest1.Data.size());
+
+  this->GetMultiThreader()->SetNumberOfThreads(str.NumberOfThreads);
+  this->GetMultiThreader()->SetSingleMethod(this->MatchingThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  // Add the landmarks, in pointset 1 order
+  for (unsigned int i = 0; i < str.Results.size(); ++i)
+  {
+    const MatchResult& result = str.Results[i];
+    if (result.Found)
+    {
+      LandmarkPointerType landmark = LandmarkType::New();
+      landmark->SetPoint1(forest1.Points[i]);
+      landmark->SetPointData1(forest1.Data[i]);
+      landmark->SetPoint2(forest2.Points[result.Neighbor.first]);
+      landmark->SetPointData2(forest2.Data[result.Neighbor.first]);
+      landmark->SetLandmarkData(result.Neighbor.second);
+
+      // Add the new landmark to the landmark list
+      landmarks->PushBack(landmark);
+    }
+  }
+}
 
-  // iterate on pointset 1
-  while (pdIt != ps1->GetPointData()->End() && pIt != ps1->GetPoints()->End())
+template <class TPointSet, class TDistance>
+ITK_THREAD_RETURN_TYPE KeyPointSetsMatchingFilter<TPointSet, TDistance>::MatchingThreaderCallback(void* arg)
+{
+  itk::ThreadIdType     threadId = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  MatchingThreadStruct* str      = (MatchingThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+
+  if (threadId < str->NumberOfThreads)
   {
-    // Get point and point data at current location
-    bool          matchFound   = false;
-    unsigned int  currentIndex = pIt.Index();
-    PointDataType data         = pdIt.Value();
-    PointType     point        = pIt.Value();
+    const unsigned int numberOfPoints = str->Results.size();
+    str->Filter->MatchRange(*str, threadId * numberOfPoints / str->NumberOfThreads, (threadId + 1) * numberOfPoints / str->NumberOfThreads);
+  }
 
-    // These variables will hold the matched point and point data
-    PointDataType dataMatch;
-    PointType     pointMatch;
+  return ITK_THREAD_RETURN_VALUE;
+}
 
-    // call to the matching routine
-    NeighborSearchResultType searchResult1 = NearestNeighbor(data, ps2);
+template <class TPointSet, class TDistance>
+void KeyPointSetsMatchingFilter<TPointSet, TDistance>::MatchRange(MatchingThreadStruct& str, unsigned int first, unsigned int last) const
+{
+  SearchWorkspace workspace;
+  workspace.Visited.assign(std::max(str.Forest1->Data.size(), str.Forest2->Data.size()), 0);
+  workspace.Stamp = 0;
+
+  for (unsigned int i = first; i < last; ++i)
+  {
+    MatchResult& result = str.Results[i];
 
     // Check if the neighbor distance is lower than the threshold
-    if (searchResult1.second < m_DistanceThreshold)
+    result.Neighbor = SearchNeighbors(str.Forest1->Data[i], *str.Forest2, workspace);
+    result.Found    = result.Neighbor.second < m_DistanceThreshold;
+
+    // Test if back search finds the same match
+    if (result.Found && m_UseBackMatching)
     {
-      // Get the matched point and point data
-      dataMatch  = ps2->GetPointData()->GetElement(searchResult1.first);
-      pointMatch = ps2->GetPoints()->GetElement(searchResult1.first);
+      result.Found = SearchNeighbors(str.Forest2->Data[result.Neighbor.first], *str.Forest1, workspace).first == i;
+    }
+  }
+}
 
-      // If the back matching option is on
-      if (m_UseBackMatching)
-      {
-        // Perform the back search
-        NeighborSearchResultType searchResult2 = NearestNeighbor(dataMatch, ps1);
+template <class TPointSet, class TDistance>
+void KeyPointSetsMatchingFilter<TPointSet, TDistance>::BuildKdForest(const PointSetType* pointset, bool buildTrees, KdForest& forest) const
+{
+  PointsIteratorType    pIt  = pointset->GetPoints()->Begin();
+  PointDataIteratorType pdIt = pointset->GetPointData()->Begin();
+  while (pdIt != pointset->GetPointData()->End() && pIt != pointset->GetPoints()->End())
+  {
+    forest.Points.push_back(pIt.Value());
+    forest.Data.push_back(pdIt.Value());
+    ++pdIt;
+    ++pIt;
+  }
 
-        // Test if back search finds the same match
-        if (currentIndex == searchResult2.first)
-        {
-          matchFound = true;
-        }
+  if (!m_UseKdForest || !buildTrees)
+  {
+    return;
+  }
+
+  // Fixed seed, so that matches are reproducible
+  std::mt19937 generator(0);
+
+  forest.Trees.resize(m_NumberOfKdTrees);
+  for (KdTree& tree : forest.Trees)
+  {
+    tree.Indices.resize(forest.Data.size());
+    std::iota(tree.Indices.begin(), tree.Indices.end(), 0);
+    std::shuffle(tree.Indices.begin(), tree.Indices.end(), generator);
+    BuildKdNode(forest, tree, 0, tree.Indices.size(), generator);
+  }
+}
+
+template <class TPointSet, class TDistance>
+unsigned int KeyPointSetsMatchingFilter<TPointSet, TDistance>::BuildKdNode(const KdForest& forest, KdTree& tree, unsigned int first, unsigned int last,
+                                                                           std::mt19937& generator) const
+{
+  const unsigned int leafSize   = 8;
+  const unsigned int sampleSize = 100;
+  const unsigned int topSize    = 5;
+
+  const unsigned int nodeIndex = tree.Nodes.size();
+  tree.Nodes.push_back({-1, 0., first, last});
+  if (last - first <= leafSize)
+  {
+    return nodeIndex;
+  }
+
+  // Estimate the mean and variance of each dimension on a sample of the
+  // (shuffled) points
+  const unsigned int  dimension = forest.Data[tree.Indices[first]].Size();
+  const unsigned int  samples   = std::min(last - first, sampleSize);
+  std::vector<double> mean(dimension, 0.), variance(dimension, 0.);
+  for (unsigned int k = first; k < first + samples; ++k)
+  {
+    const PointDataType& data = forest.Data[tree.Indices[k]];
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      mean[d] += data[d];
+      variance[d] += data[d] * data[d];
+    }
+  }
+  for (unsigned int d = 0; d < dimension; ++d)
+  {
+    mean[d] /= samples;
+    variance[d] = variance[d] / samples - mean[d] * mean[d];
+  }
+
+  // Split at the mean of one of the dimensions with the highest variance,
+  // drawn at random so that the trees differ
+  std::vector<unsigned int> dimensions(dimension);
+  std::iota(dimensions.begin(), dimensions.end(), 0);
+  const unsigned int candidates = std::min(dimension, topSize);
+  std::partial_sort(dimensions.begin(), dimensions.begin() + candidates, dimensions.end(),
+                    [&variance](unsigned int a, unsigned int b) { return variance[a] > variance[b]; });
+  const unsigned int splitDimension = dimensions[generator() % candidates];
+  const double       split          = mean[splitDimension];
+
+  const unsigned int middle =
+      std::partition(tree.Indices.begin() + first, tree.Indices.begin() + last, [&](unsigned int i) { return forest.Data[i][splitDimension] < split; }) -
+      tree.Indices.begin();
+  if (middle == first || middle == last)
+  {
+    return nodeIndex;
+  }
+
+  const unsigned int left  = BuildKdNode(forest, tree, first, middle, generator);
+  const unsigned int right = BuildKdNode(forest, tree, middle, last, generator);
+
+  tree.Nodes[nodeIndex].Dimension = splitDimension;
+  tree.Nodes[nodeIndex].Split     = split;
+  tree.Nodes[nodeIndex].First     = left;
+  tree.Nodes[nodeIndex].Second    = right;
+
+  return nodeIndex;
+}
+
+template <class TPointSet, class TDistance>
+typename KeyPointSetsMatchingFilter<TPointSet, TDistance>::NeighborSearchResultType
+KeyPointSetsMatchingFilter<TPointSet, TDistance>::SearchNeighbors(const PointDataType& data1, const KdForest& forest, SearchWorkspace& workspace) const
+{
+  unsigned int nearestIndex          = 0;
+  double       nearestDistance       = itk::NumericTraits<double>::max();
+  double       secondNearestDistance = itk::NumericTraits<double>::max();
+
+  auto evaluate = [&](unsigned int position) {
+    const double distanceValue = m_DistanceCalculator->Evaluate(data1, forest.Data[position]);
+
+    // Check if this point is the nearest neighbor
+    if (distanceValue < nearestDistance)
+    {
+      secondNearestDistance = nearestDistance;
+      nearestDistance       = distanceValue;
+      nearestIndex          = position;
+    }
+    // Else check if it is the second nearest neighbor
+    else if (distanceValue < secondNearestDistance)
+    {
+      secondNearestDistance = distanceValue;
+    }
+  };
+
+  if (forest.Trees.empty())
+  {
+    for (unsigned int position = 0; position < forest.Data.size(); ++position)
+    {
+      evaluate(position);
+    }
+  }
+  else
+  {
+    // Points reached through several trees are only evaluated once
+    if (++workspace.Stamp == 0)
+    {
+      std::fill(workspace.Visited.begin(), workspace.Visited.end(), 0);
+      workspace.Stamp = 1;
+    }
+
+    // Best bin first: branches not taken are queued by their (squared)
+    // distance lower bound to data1
+    typedef std::pair<double, std::pair<unsigned int, unsigned int>> BranchType;
+    std::priority_queue<BranchType, std::vector<BranchType>, std::greater<BranchType>> branches;
+    unsigned int checks = 0;
+
+    auto descend = [&](unsigned int treeIndex, unsigned int node, double lowerBound) {
+      const KdTree& tree = forest.Trees[treeIndex];
+      while (tree.Nodes[node].Dimension >= 0)
+      {
+        const KdNode& kdNode = tree.Nodes[node];
+        const double  diff   = data1[kdNode.Dimension] - kdNode.Split;
+        branches.push(BranchType(lowerBound + diff * diff, std::make_pair(treeIndex, diff < 0 ? kdNode.Second : kdNode.First)));
+        node = diff < 0 ? kdNode.First : kdNode.Second;
       }
-      else // else back matching
+      for (unsigned int k = tree.Nodes[node].First; k < tree.Nodes[node].Second; ++k)
       {
-        matchFound = true;
+        const unsigned int position = tree.Indices[k];
+        if (workspace.Visited[position] != workspace.Stamp)
+        {
+          workspace.Visited[position] = workspace.Stamp;
+          evaluate(position);
+          ++checks;
+        }
       }
-    }
+    };
 
-    // If we found a match, add the proper landmark
-    if (matchFound)
+    for (unsigned int treeIndex = 0; treeIndex < forest.Trees.size(); ++treeIndex)
     {
-      LandmarkPointerType landmark = LandmarkType::New();
-      landmark->SetPoint1(point);
-      landmark->SetPointData1(data);
-      landmark->SetPoint2(pointMatch);
-      landmark->SetPointData2(dataMatch);
-      landmark->SetLandmarkData(searchResult1.second);
-
-      // Add the new landmark to the landmark list
-      landmarks->PushBack(landmark);
+      descend(treeIndex, 0, 0.);
+    }
+    while (!branches.empty() && checks < m_MaxChecks)
+    {
+      const BranchType branch = branches.top();
+      branches.pop();
+      descend(branch.second.first, branch.second.second, branch.first);
     }
-    ++pdIt;
-    ++pIt;
   }
+
+  // Fill results
+  NeighborSearchResultType result;
+  result.first  = nearestIndex;
+  result.second = secondNearestDistance == 0 ? 1 : nearestDistance / secondNearestDistance;
+  return result;
 }
 
 template <class TPointSet, class TDistance>
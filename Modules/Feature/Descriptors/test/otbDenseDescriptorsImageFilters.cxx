@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "itkGradientImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "otbHistogramOfOrientedGradientCovariantImageFunction.h"
+#include "otbDenseHistogramOfOrientedGradientCovariantImageFilter.h"
+#include "otbFourierMellinDescriptorsImageFunction.h"
+#include "otbDenseFourierMellinDescriptorsImageFilter.h"
+
+typedef otb::Image<double, 2>           ImageType;
+typedef otb::VectorImage<double, 2>     VectorImageType;
+typedef otb::ImageFileReader<ImageType> ReaderType;
+
+// Compare the dense filters to their image function at every descriptor
+int otbDenseHistogramOfOrientedGradientCovariantImageFilter(int itkNotUsed(argc), char* argv[])
+{
+  typedef itk::GradientImageFilter<ImageType>                                                             GradientFilterType;
+  typedef GradientFilterType::OutputImageType                                                             CovariantImageType;
+  typedef otb::HistogramOfOrientedGradientCovariantImageFunction<CovariantImageType>                      FunctionType;
+  typedef otb::DenseHistogramOfOrientedGradientCovariantImageFilter<CovariantImageType, VectorImageType> FilterType;
+
+  const unsigned int radius = atoi(argv[2]);
+  const unsigned int stride = atoi(argv[3]);
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  GradientFilterType::Pointer gradient = GradientFilterType::New();
+  gradient->SetInput(reader->GetOutput());
+  gradient->SetUseImageSpacing(false);
+  gradient->SetUseImageDirection(false);
+  gradient->Update();
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(gradient->GetOutput());
+  filter->SetNeighborhoodRadius(radius);
+  filter->SetStride(stride);
+  filter->Update();
+
+  FunctionType::Pointer function = FunctionType::New();
+  function->SetInputImage(gradient->GetOutput());
+  function->SetNeighborhoodRadius(radius);
+
+  const unsigned int nbBins = function->GetNumberOfOrientationBins();
+
+  for (itk::ImageRegionConstIteratorWithIndex<VectorImageType> it(filter->GetOutput(), filter->GetOutput()->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    CovariantImageType::IndexType index;
+    index[0] = it.GetIndex()[0] * stride;
+    index[1] = it.GetIndex()[1] * stride;
+
+    const FunctionType::OutputType hog = function->EvaluateAtIndex(index);
+    for (unsigned int h = 0; h < 5; ++h)
+    {
+      for (unsigned int b = 0; b < nbBins; ++b)
+      {
+        if (std::abs(it.Get()[h * nbBins + b] - hog[h][b]) > 1e-9)
+        {
+          std::cerr << "Wrong histogram " << h << " bin " << b << " at " << index << ": " << it.Get()[h * nbBins + b] << " instead of " << hog[h][b]
+                    << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+
+int otbDenseFourierMellinDescriptorsImageFilter(int itkNotUsed(argc), char* argv[])
+{
+  typedef otb::FourierMellinDescriptorsImageFunction<ImageType>                      FunctionType;
+  typedef otb::DenseFourierMellinDescriptorsImageFilter<ImageType, VectorImageType> FilterType;
+
+  const unsigned int p      = atoi(argv[2]);
+  const unsigned int q      = atoi(argv[3]);
+  const unsigned int radius = atoi(argv[4]);
+  const unsigned int stride = atoi(argv[5]);
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->Update();
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(reader->GetOutput());
+  filter->SetPmax(p);
+  filter->SetQmax(q);
+  filter->SetNeighborhoodRadius(radius);
+  filter->SetStride(stride);
+  filter->Update();
+
+  FunctionType::Pointer function = FunctionType::New();
+  function->SetInputImage(reader->GetOutput());
+  function->SetPmax(p);
+  function->SetQmax(q);
+  function->SetNeighborhoodRadius(radius);
+
+  for (itk::ImageRegionConstIteratorWithIndex<VectorImageType> it(filter->GetOutput(), filter->GetOutput()->GetLargestPossibleRegion()); !it.IsAtEnd();
+       ++it)
+  {
+    ImageType::IndexType index;
+    index[0] = it.GetIndex()[0] * stride;
+    index[1] = it.GetIndex()[1] * stride;
+
+    const FunctionType::OutputType descriptors = function->EvaluateAtIndex(index);
+    for (unsigned int i = 0; i <= p; ++i)
+    {
+      for (unsigned int j = 0; j <= q; ++j)
+      {
+        const double value = it.Get()[i * (q + 1) + j];
+        if (std::abs(value - descriptors[i][j]) > 1e-9 * std::max(1., std::abs(descriptors[i][j])))
+        {
+          std::cerr << "Wrong descriptor (" << i << ", " << j << ") at " << index << ": " << value << " instead of " << descriptors[i][j] << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
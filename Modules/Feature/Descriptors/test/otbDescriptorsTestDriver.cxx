@@ -28,6 +28,8 @@ void RegisterTests()
   REGISTER_TEST(otbFourierMellinDescriptors);
   REGISTER_TEST(otbFourierMellinDescriptorsScaleInvariant);
   REGISTER_TEST(otbFourierMellinDescriptorsRotationInvariant);
+  REGISTER_TEST(otbDenseHistogramOfOrientedGradientCovariantImageFilter);
+  REGISTER_TEST(otbDenseFourierMellinDescriptorsImageFilter);
  #ifdef OTB_USE_SIFTFAST
   REGISTER_TEST(otbKeyPointsAlgorithmsTest);
  #endif
@@ -30,6 +30,7 @@
 #include "otbImageToSURFKeyPointSetFilter.h"
 #include "itkPointSet.h"
 
+#include <random>
 #include <tuple>
 
 using ImageType          = otb::Image<double>;
@@ -158,6 +159,60 @@ bool testMatchingFilter()
   return success;
 }
 
+bool testKdForestMatching()
+{
+  // Secondary descriptors are slightly perturbed copies of the reference ones
+  const unsigned int nbPoints  = 2000;
+  const unsigned int dimension = 16;
+
+  auto ps1 = PointSetType::New();
+  auto ps2 = PointSetType::New();
+
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> uniform(0., 1.);
+  std::normal_distribution<double>       noise(0., 0.01);
+
+  for (unsigned int i = 0; i < nbPoints; ++i)
+  {
+    PointSetType::PointType point;
+    point.Fill(i);
+    VectorType d1(dimension), d2(dimension);
+    for (unsigned int d = 0; d < dimension; ++d)
+    {
+      d1[d] = uniform(generator);
+      d2[d] = d1[d] + noise(generator);
+    }
+    ps1->SetPoint(i, point);
+    ps1->SetPointData(i, d1);
+    ps2->SetPoint(i, point);
+    ps2->SetPointData(i, d2);
+  }
+
+  auto matchPoints = [&](bool useKdForest) {
+    auto filter = MatchingFilterType::New();
+    filter->SetDistanceThreshold(0.6);
+    filter->SetUseBackMatching(true);
+    filter->SetUseKdForest(useKdForest);
+    filter->SetInput1(ps1);
+    filter->SetInput2(ps2);
+    filter->Update();
+
+    unsigned int nbGoodMatches = 0;
+    for (auto it = filter->GetOutput()->Begin(); it != filter->GetOutput()->End(); ++it)
+    {
+      nbGoodMatches += it.Get()->GetPoint1() == it.Get()->GetPoint2();
+    }
+    return nbGoodMatches;
+  };
+
+  const unsigned int exhaustiveMatches = matchPoints(false);
+  const unsigned int kdForestMatches   = matchPoints(true);
+
+  bool test = kdForestMatches >= 0.9 * exhaustiveMatches && exhaustiveMatches > 0.9 * nbPoints;
+  std::cout << "Kd-forest finds " << kdForestMatches << " of the " << exhaustiveMatches << " exhaustive good matches:\t" << printResult(test) << std::endl;
+  return test;
+}
+
 
 /** Generate a pair of images, one being slightly warped wrt the
  * other */
@@ -332,6 +387,7 @@ int otbKeyPointsAlgorithmsTest(int argc, char* argv[])
   std::cout << "Checking matching filter:" << std::endl;
   std::cout << "=========================" << std::endl;
   bool status = testMatchingFilter();
+  status      = testKdForestMatching() && status;
 
   std::tie(reference, secondary, transform) = generateImagePair(infname, rotation, scaling);
 
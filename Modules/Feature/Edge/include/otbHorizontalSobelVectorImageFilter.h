@@ -21,7 +21,7 @@
 #ifndef otbHorizontalSobelVectorImageFilter_h
 #define otbHorizontalSobelVectorImageFilter_h
 
-#include "otbUnaryFunctorNeighborhoodVectorImageFilter.h"
+#include "otbNeighborhood3x3RowVectorImageFilter.h"
 
 namespace otb
 {
@@ -66,13 +66,13 @@ public:
  */
 template <class TInputImage, class TOutputImage>
 class ITK_EXPORT HorizontalSobelVectorImageFilter
-    : public UnaryFunctorNeighborhoodVectorImageFilter<
+    : public Neighborhood3x3RowVectorImageFilter<
           TInputImage, TOutputImage, Functor::HorizontalSobelOperator<typename itk::ConstNeighborhoodIterator<TInputImage>, typename TOutputImage::PixelType>>
 {
 public:
   /** Standard class typedefs */
   typedef HorizontalSobelVectorImageFilter Self;
-  typedef UnaryFunctorNeighborhoodVectorImageFilter<
+  typedef Neighborhood3x3RowVectorImageFilter<
       TInputImage, TOutputImage, Functor::HorizontalSobelOperator<typename itk::ConstNeighborhoodIterator<TInputImage>, typename TOutputImage::PixelType>>
                                         Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
@@ -87,13 +87,26 @@ public:
 protected:
   HorizontalSobelVectorImageFilter()
   {
-    typename Superclass::RadiusType radius = {{1, 1}};
-    this->SetRadius(radius);
   }
   ~HorizontalSobelVectorImageFilter() override
   {
   }
 
+  void ProcessLine(const double* above, const double* center, const double* below, double* output, double* work, unsigned int length,
+                   unsigned int nbComp) const override
+  {
+    // Vertical smoothing of the three lines, then horizontal difference
+    double* smooth = work;
+    for (int i = -static_cast<int>(nbComp); i < static_cast<int>(length + nbComp); ++i)
+    {
+      smooth[i] = above[i] + 2. * center[i] + below[i];
+    }
+    for (unsigned int i = 0; i < length; ++i)
+    {
+      output[i] = (smooth - nbComp)[i] - (smooth + nbComp)[i];
+    }
+  }
+
 private:
   HorizontalSobelVectorImageFilter(const Self&); // Not implemented
   void operator=(const Self&);                   // Not implemented
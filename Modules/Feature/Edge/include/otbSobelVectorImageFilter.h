@@ -21,7 +21,7 @@
 #ifndef otbSobelVectorImageFilter_h
 #define otbSobelVectorImageFilter_h
 
-#include "otbUnaryFunctorNeighborhoodVectorImageFilter.h"
+#include "otbNeighborhood3x3RowVectorImageFilter.h"
 
 #include <vnl/vnl_math.h>
 
@@ -72,13 +72,13 @@ public:
  */
 template <class TInputImage, class TOutputImage>
 class ITK_EXPORT SobelVectorImageFilter
-    : public UnaryFunctorNeighborhoodVectorImageFilter<
+    : public Neighborhood3x3RowVectorImageFilter<
           TInputImage, TOutputImage, Functor::SobelOperator<typename itk::ConstNeighborhoodIterator<TInputImage>, typename TOutputImage::PixelType>>
 {
 public:
   /** Standard class typedefs */
   typedef SobelVectorImageFilter Self;
-  typedef UnaryFunctorNeighborhoodVectorImageFilter<
+  typedef Neighborhood3x3RowVectorImageFilter<
       TInputImage, TOutputImage, Functor::SobelOperator<typename itk::ConstNeighborhoodIterator<TInputImage>, typename TOutputImage::PixelType>>
                                         Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
@@ -93,13 +93,31 @@ public:
 protected:
   SobelVectorImageFilter()
   {
-    typename Superclass::RadiusType radius = {{1, 1}};
-    this->SetRadius(radius);
   }
   ~SobelVectorImageFilter() override
   {
   }
 
+  void ProcessLine(const double* above, const double* center, const double* below, double* output, double* work, unsigned int length,
+                   unsigned int nbComp) const override
+  {
+    // Vertical smoothing and difference of the three lines, then the
+    // horizontal difference and smoothing of each
+    double* smooth = work;
+    double* diff   = work + length + 2 * nbComp;
+    for (int i = -static_cast<int>(nbComp); i < static_cast<int>(length + nbComp); ++i)
+    {
+      smooth[i] = above[i] + 2. * center[i] + below[i];
+      diff[i]   = above[i] - below[i];
+    }
+    for (unsigned int i = 0; i < length; ++i)
+    {
+      const double hori = (smooth - nbComp)[i] - (smooth + nbComp)[i];
+      const double vert = (diff - nbComp)[i] + 2. * diff[i] + (diff + nbComp)[i];
+      output[i]         = std::sqrt(hori * hori + vert * vert);
+    }
+  }
+
 private:
   SobelVectorImageFilter(const Self&); // Not implemented
   void operator=(const Self&);         // Not implemented
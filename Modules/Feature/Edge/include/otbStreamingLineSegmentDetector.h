@@ -34,6 +34,7 @@
 
 #include "otbPersistentFilterStreamingDecorator.h"
 #include "otbPersistentImageToVectorDataFilter.h"
+#include "itkMultiThreader.h"
 
 namespace otb
 {
@@ -43,6 +44,15 @@ namespace otb
  *  This filter is a generic PersistentImageFilter, which encapsulate
  *  the Line Segment detector filter.
  *
+ *  By default the segments of each tile are simply concatenated. With
+ *  MergeTileSegments on, each tile is further split in strips that are
+ *  processed in parallel, and the segments ending close to a strip or
+ *  tile border are kept until Synthetize(). There, segments from both
+ *  sides of a border are joined when they are collinear: their
+ *  directions differ by less than MergeAngle (radians) and they lie
+ *  within MergeDistance (pixels) of each other. Candidates are looked
+ *  up through a grid index over the border end points.
+ *
  * \sa PersistentImageToVectorDataFilter
  *
  *
@@ -67,12 +77,31 @@ public:
   typedef typename Superclass::OutputVectorDataPointerType OutputVectorDataPointerType;
 
   typedef typename Superclass::ExtractImageFilterType ExtractImageFilterType;
+  typedef typename InputImageType::RegionType         RegionType;
+
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
   /** Runtime information support. */
   itkTypeMacro(PersistentStreamingLineSegmentDetector, PersistentImageToVectorDataFilter);
 
+  /** Join the segments cut by tile borders (off by default) */
+  itkSetMacro(MergeTileSegments, bool);
+  itkGetMacro(MergeTileSegments, bool);
+  itkBooleanMacro(MergeTileSegments);
+
+  /** Maximum distance in pixels between two segments to join */
+  itkSetMacro(MergeDistance, double);
+  itkGetMacro(MergeDistance, double);
+
+  /** Maximum angle in radians between two segments to join */
+  itkSetMacro(MergeAngle, double);
+  itkGetMacro(MergeAngle, double);
+
+  void Reset(void) override;
+
+  void Synthetize(void) override;
+
 protected:
   PersistentStreamingLineSegmentDetector();
 
@@ -80,11 +109,41 @@ protected:
 
   void GenerateInputRequestedRegion() override;
 
+  void GenerateData() override;
+
 private:
   PersistentStreamingLineSegmentDetector(const Self&) = delete;
   void operator=(const Self&) = delete;
 
   OutputVectorDataPointerType ProcessTile() override;
+
+  /** Segment in continuous index coordinates of the input image. The
+   * flags tell whether each end point is close to an inner border of
+   * the region where it was detected. */
+  struct Segment
+  {
+    double x[2];
+    double y[2];
+    bool   border[2];
+    bool   alive;
+  };
+
+  /** Add the line features of vd detected over region */
+  void AddSegments(OutputVectorDataType* vd, const RegionType& region);
+
+  /** Join a with b into a if they are collinear and close enough */
+  bool MergeSegment(Segment& a, const Segment& b) const;
+
+  /** Join the segments across borders, then fill the output vector data */
+  void MergeSegments();
+
+  static ITK_THREAD_RETURN_TYPE DetectorThreaderCallback(void* arg);
+
+  std::vector<Segment> m_Segments;
+
+  bool   m_MergeTileSegments;
+  double m_MergeDistance;
+  double m_MergeAngle;
 };
 
 template <class TImageType>
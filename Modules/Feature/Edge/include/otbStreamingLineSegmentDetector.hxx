@@ -25,13 +25,17 @@
 #include "otbStreamingLineSegmentDetector.h"
 
 #include "otbVectorDataTransformFilter.h"
+#include "otbMath.h"
 #include "itkAffineTransform.h"
+#include "itkMultiThreader.h"
+#include <map>
 
 namespace otb
 {
 
 template <class TInputImage>
 PersistentStreamingLineSegmentDetector<TInputImage>::PersistentStreamingLineSegmentDetector()
+  : m_MergeTileSegments(false), m_MergeDistance(2.), m_MergeAngle(CONST_PI / 8.)
 {
 }
 
@@ -80,6 +84,319 @@ typename PersistentStreamingLineSegmentDetector<TInputImage>::OutputVectorDataPo
   return lsd->GetOutput();
 }
 
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::Reset()
+{
+  Superclass::Reset();
+  m_Segments.clear();
+}
+
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::Synthetize()
+{
+  Superclass::Synthetize();
+
+  if (m_MergeTileSegments)
+  {
+    this->MergeSegments();
+  }
+}
+
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::GenerateData()
+{
+  if (!m_MergeTileSegments)
+  {
+    Superclass::GenerateData();
+    return;
+  }
+
+  // Split the tile in strips of at least 64 lines, one per thread
+  const RegionType   region    = this->GetInput()->GetBufferedRegion();
+  const unsigned int maxStrips = std::max<unsigned int>(1, region.GetSize()[1] / 64);
+  const unsigned int nbStrips  = std::min<unsigned int>(this->GetNumberOfThreads(), maxStrips);
+
+  std::vector<RegionType>                strips(nbStrips);
+  std::vector<typename LSDType::Pointer> detectors(nbStrips);
+  for (unsigned int i = 0; i < nbStrips; ++i)
+  {
+    const unsigned long first = region.GetSize()[1] * i / nbStrips;
+    const unsigned long last  = region.GetSize()[1] * (i + 1) / nbStrips;
+
+    strips[i] = region;
+    strips[i].SetIndex(1, region.GetIndex()[1] + first);
+    strips[i].SetSize(1, last - first);
+
+    // Extract sequentially so that the threads never touch the upstream pipeline
+    typename ExtractImageFilterType::Pointer extract = ExtractImageFilterType::New();
+    extract->SetInput(this->GetInput());
+    extract->SetExtractionRegion(strips[i]);
+    extract->Update();
+
+    InputImagePointerType strip = extract->GetOutput();
+    strip->DisconnectPipeline();
+    strip->SetMetaDataDictionary(this->GetInput()->GetMetaDataDictionary());
+
+    detectors[i] = LSDType::New();
+    detectors[i]->SetInput(strip);
+    detectors[i]->UpdateOutputInformation();
+  }
+
+  this->GetMultiThreader()->SetNumberOfThreads(nbStrips);
+  this->GetMultiThreader()->SetSingleMethod(this->DetectorThreaderCallback, &detectors);
+  this->GetMultiThreader()->SingleMethodExecute();
+
+  for (unsigned int i = 0; i < nbStrips; ++i)
+  {
+    this->AddSegments(detectors[i]->GetOutput(), strips[i]);
+  }
+  this->GetOutputVectorData()->SetMetaDataDictionary(detectors[0]->GetOutput()->GetMetaDataDictionary());
+}
+
+template <class TInputImage>
+ITK_THREAD_RETURN_TYPE PersistentStreamingLineSegmentDetector<TInputImage>::DetectorThreaderCallback(void* arg)
+{
+  itk::MultiThreader::ThreadInfoStruct*   info      = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+  std::vector<typename LSDType::Pointer>* detectors = static_cast<std::vector<typename LSDType::Pointer>*>(info->UserData);
+
+  (*detectors)[info->ThreadID]->Update();
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::AddSegments(OutputVectorDataType* vd, const RegionType& region)
+{
+  typedef typename OutputVectorDataType::DataTreeType DataTreeType;
+  typedef typename OutputVectorDataType::LineType     LineType;
+  typedef typename LineType::VertexType               VertexType;
+  typedef itk::PreOrderTreeIterator<DataTreeType>     TreeIteratorType;
+
+  const typename InputImageType::PointType   origin  = this->GetInput()->GetOrigin();
+  const typename InputImageType::SpacingType spacing = this->GetInput()->GetSignedSpacing();
+  const RegionType                           largest = this->GetInput()->GetLargestPossibleRegion();
+
+  // Inner borders of the region, in continuous index coordinates
+  double lower[2], upper[2];
+  bool   innerLower[2], innerUpper[2];
+  for (unsigned int d = 0; d < 2; ++d)
+  {
+    lower[d]      = region.GetIndex()[d] - 0.5;
+    upper[d]      = region.GetIndex()[d] + region.GetSize()[d] - 0.5;
+    innerLower[d] = region.GetIndex()[d] > largest.GetIndex()[d];
+    innerUpper[d] = region.GetIndex()[d] + region.GetSize()[d] < largest.GetIndex()[d] + largest.GetSize()[d];
+  }
+
+  TreeIteratorType it(vd->GetDataTree());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    if (!it.Get()->IsLineFeature())
+    {
+      continue;
+    }
+    const typename LineType::VertexListType* vertices = it.Get()->GetLine()->GetVertexList();
+
+    Segment segment;
+    segment.alive = true;
+    for (unsigned int e = 0; e < 2; ++e)
+    {
+      const VertexType& vertex = vertices->ElementAt(e == 0 ? 0 : vertices->Size() - 1);
+      segment.x[e]             = (vertex[0] - origin[0]) / spacing[0];
+      segment.y[e]             = (vertex[1] - origin[1]) / spacing[1];
+
+      const double p[2] = {segment.x[e], segment.y[e]};
+      segment.border[e] = false;
+      for (unsigned int d = 0; d < 2; ++d)
+      {
+        segment.border[e] = segment.border[e] || (innerLower[d] && std::abs(p[d] - lower[d]) < m_MergeDistance) ||
+                            (innerUpper[d] && std::abs(p[d] - upper[d]) < m_MergeDistance);
+      }
+    }
+    m_Segments.push_back(segment);
+  }
+}
+
+template <class TInputImage>
+bool PersistentStreamingLineSegmentDetector<TInputImage>::MergeSegment(Segment& a, const Segment& b) const
+{
+  const double lengthA = std::sqrt((a.x[1] - a.x[0]) * (a.x[1] - a.x[0]) + (a.y[1] - a.y[0]) * (a.y[1] - a.y[0]));
+  const double lengthB = std::sqrt((b.x[1] - b.x[0]) * (b.x[1] - b.x[0]) + (b.y[1] - b.y[0]) * (b.y[1] - b.y[0]));
+  if (lengthA == 0. || lengthB == 0.)
+  {
+    return false;
+  }
+
+  // Directions, regardless of orientation
+  const double ux = (a.x[1] - a.x[0]) / lengthA;
+  const double uy = (a.y[1] - a.y[0]) / lengthA;
+  const double vx = (b.x[1] - b.x[0]) / lengthB;
+  const double vy = (b.y[1] - b.y[0]) / lengthB;
+  if (std::abs(ux * vx + uy * vy) < std::cos(m_MergeAngle))
+  {
+    return false;
+  }
+
+  // End points of the shorter segment must lie close to the line of the longer one
+  const Segment& ref   = lengthA >= lengthB ? a : b;
+  const Segment& other = lengthA >= lengthB ? b : a;
+  const double   rx    = lengthA >= lengthB ? ux : vx;
+  const double   ry    = lengthA >= lengthB ? uy : vy;
+  for (unsigned int e = 0; e < 2; ++e)
+  {
+    if (std::abs(rx * (other.y[e] - ref.y[0]) - ry * (other.x[e] - ref.x[0])) >= m_MergeDistance)
+    {
+      return false;
+    }
+  }
+
+  // Keep the extreme end points along the reference direction
+  const Segment*     owners[4] = {&a, &a, &b, &b};
+  const unsigned int ends[4]   = {0, 1, 0, 1};
+  unsigned int       first = 0, last = 0;
+  double             minPos = 0., maxPos = 0.;
+  for (unsigned int k = 0; k < 4; ++k)
+  {
+    const double pos = rx * (owners[k]->x[ends[k]] - ref.x[0]) + ry * (owners[k]->y[ends[k]] - ref.y[0]);
+    if (k == 0 || pos < minPos)
+    {
+      minPos = pos;
+      first  = k;
+    }
+    if (k == 0 || pos > maxPos)
+    {
+      maxPos = pos;
+      last   = k;
+    }
+  }
+
+  Segment merged;
+  merged.alive     = true;
+  merged.x[0]      = owners[first]->x[ends[first]];
+  merged.y[0]      = owners[first]->y[ends[first]];
+  merged.border[0] = owners[first]->border[ends[first]];
+  merged.x[1]      = owners[last]->x[ends[last]];
+  merged.y[1]      = owners[last]->y[ends[last]];
+  merged.border[1] = owners[last]->border[ends[last]];
+  a                = merged;
+
+  return true;
+}
+
+template <class TInputImage>
+void PersistentStreamingLineSegmentDetector<TInputImage>::MergeSegments()
+{
+  typedef std::pair<long, long>                       CellType;
+  typedef std::multimap<CellType, unsigned int>       GridType;
+  typedef typename OutputVectorDataType::DataNodeType DataNodeType;
+  typedef typename OutputVectorDataType::DataTreeType DataTreeType;
+  typedef typename OutputVectorDataType::LineType     LineType;
+  typedef typename LineType::VertexType               VertexType;
+  typedef itk::PreOrderTreeIterator<DataTreeType>     TreeIteratorType;
+
+  const double cellSize = std::max(m_MergeDistance, 1.);
+  auto         cellOf   = [cellSize](double x, double y) { return CellType(std::floor(x / cellSize), std::floor(y / cellSize)); };
+
+  bool merged = true;
+  while (merged)
+  {
+    merged = false;
+
+    // Index the border end points of the remaining segments
+    GridType grid;
+    for (unsigned int i = 0; i < m_Segments.size(); ++i)
+    {
+      for (unsigned int e = 0; e < 2; ++e)
+      {
+        if (m_Segments[i].alive && m_Segments[i].border[e])
+        {
+          grid.insert(std::make_pair(cellOf(m_Segments[i].x[e], m_Segments[i].y[e]), i));
+        }
+      }
+    }
+
+    for (unsigned int i = 0; i < m_Segments.size(); ++i)
+    {
+      for (unsigned int e = 0; e < 2 && m_Segments[i].alive; ++e)
+      {
+        if (!m_Segments[i].border[e])
+        {
+          continue;
+        }
+        const double   x    = m_Segments[i].x[e];
+        const double   y    = m_Segments[i].y[e];
+        const CellType cell = cellOf(x, y);
+        bool           done = false;
+        for (long cy = cell.second - 1; cy <= cell.second + 1 && !done; ++cy)
+        {
+          for (long cx = cell.first - 1; cx <= cell.first + 1 && !done; ++cx)
+          {
+            auto range = grid.equal_range(CellType(cx, cy));
+            for (auto it = range.first; it != range.second && !done; ++it)
+            {
+              Segment& candidate = m_Segments[it->second];
+              if (it->second == i || !candidate.alive)
+              {
+                continue;
+              }
+              // Only border end points close to each other
+              bool close = false;
+              for (unsigned int f = 0; f < 2; ++f)
+              {
+                close = close || (candidate.border[f] && std::abs(candidate.x[f] - x) < m_MergeDistance && std::abs(candidate.y[f] - y) < m_MergeDistance);
+              }
+              if (close && this->MergeSegment(m_Segments[i], candidate))
+              {
+                candidate.alive = false;
+                merged          = true;
+                done            = true;
+              }
+            }
+          }
+        }
+        if (done)
+        {
+          // The end points changed, look again at the next pass
+          break;
+        }
+      }
+    }
+  }
+
+  // Fill the folder created by Reset()
+  OutputVectorDataType*          output = this->GetOutputVectorData();
+  typename DataNodeType::Pointer folder;
+  TreeIteratorType               treeIt(output->GetDataTree());
+  for (treeIt.GoToBegin(); !treeIt.IsAtEnd() && folder.IsNull(); ++treeIt)
+  {
+    if (treeIt.Get()->IsFolder())
+    {
+      folder = treeIt.Get();
+    }
+  }
+
+  const typename InputImageType::PointType   origin  = this->GetInput()->GetOrigin();
+  const typename InputImageType::SpacingType spacing = this->GetInput()->GetSignedSpacing();
+  for (const Segment& segment : m_Segments)
+  {
+    if (!segment.alive)
+    {
+      continue;
+    }
+    typename DataNodeType::Pointer geometry = DataNodeType::New();
+    geometry->SetNodeId("FEATURE_LINE");
+    geometry->SetNodeType(otb::FEATURE_LINE);
+    geometry->SetLine(LineType::New());
+    output->GetDataTree()->Add(geometry, folder);
+    for (unsigned int e = 0; e < 2; ++e)
+    {
+      VertexType vertex;
+      vertex[0] = origin[0] + segment.x[e] * spacing[0];
+      vertex[1] = origin[1] + segment.y[e] * spacing[1];
+      geometry->GetLine()->AddVertex(vertex);
+    }
+  }
+  m_Segments.clear();
+}
 
 } // end namespace otb
 #endif
@@ -21,7 +21,7 @@
 #ifndef otbVerticalSobelVectorImageFilter_h
 #define otbVerticalSobelVectorImageFilter_h
 
-#include "otbUnaryFunctorNeighborhoodVectorImageFilter.h"
+#include "otbNeighborhood3x3RowVectorImageFilter.h"
 
 namespace otb
 {
@@ -66,13 +66,13 @@ public:
  */
 template <class TInputImage, class TOutputImage>
 class ITK_EXPORT VerticalSobelVectorImageFilter
-    : public UnaryFunctorNeighborhoodVectorImageFilter<
+    : public Neighborhood3x3RowVectorImageFilter<
           TInputImage, TOutputImage, Functor::VerticalSobelOperator<typename itk::ConstNeighborhoodIterator<TInputImage>, typename TOutputImage::PixelType>>
 {
 public:
   /** Standard class typedefs */
   typedef VerticalSobelVectorImageFilter Self;
-  typedef UnaryFunctorNeighborhoodVectorImageFilter<
+  typedef Neighborhood3x3RowVectorImageFilter<
       TInputImage, TOutputImage, Functor::VerticalSobelOperator<typename itk::ConstNeighborhoodIterator<TInputImage>, typename TOutputImage::PixelType>>
                                         Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
@@ -87,13 +87,26 @@ public:
 protected:
   VerticalSobelVectorImageFilter()
   {
-    typename Superclass::RadiusType radius = {{1, 1}};
-    this->SetRadius(radius);
   }
   ~VerticalSobelVectorImageFilter() override
   {
   }
 
+  void ProcessLine(const double* above, const double* center, const double* below, double* output, double* work, unsigned int length,
+                   unsigned int nbComp) const override
+  {
+    // Vertical difference of the three lines, then horizontal smoothing
+    double* diff = work;
+    for (int i = -static_cast<int>(nbComp); i < static_cast<int>(length + nbComp); ++i)
+    {
+      diff[i] = above[i] - below[i];
+    }
+    for (unsigned int i = 0; i < length; ++i)
+    {
+      output[i] = (diff - nbComp)[i] + 2. * diff[i] + (diff + nbComp)[i];
+    }
+  }
+
 private:
   VerticalSobelVectorImageFilter(const Self&); // Not implemented
   void operator=(const Self&);                 // Not implemented
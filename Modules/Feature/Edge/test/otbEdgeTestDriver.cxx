@@ -30,11 +30,13 @@ void RegisterTests()
   REGISTER_TEST(otbEdgeDensityImageFilter);
   REGISTER_TEST(otbLineCorrelationDetector);
   REGISTER_TEST(otbSobelVectorImageFilterTest);
+  REGISTER_TEST(otbSobelVectorImageFilterLineBuffers);
   REGISTER_TEST(otbPixelSuppressionByDirection);
   REGISTER_TEST(otbLineRatioDetector);
   REGISTER_TEST(otbTouziEdgeDetectorDirection);
   REGISTER_TEST(otbVerticalSobelVectorImageFilterTest);
   REGISTER_TEST(otbStreamingLineSegmentDetector);
+  REGISTER_TEST(otbStreamingLineSegmentDetectorMerge);
   REGISTER_TEST(otbTouziEdgeDetector);
   REGISTER_TEST(otbLineRatioDetectorLinear);
   REGISTER_TEST(otbLineSegmentDetector);
@@ -26,6 +26,7 @@
 #include "otbCommandProgressUpdate.h"
 
 #include "otbSobelVectorImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 int otbSobelVectorImageFilterTest(int argc, char* argv[])
 {
@@ -62,3 +63,58 @@ int otbSobelVectorImageFilterTest(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbSobelVectorImageFilterLineBuffers(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::VectorImage<float, 2>                                                                   ImageType;
+  typedef otb::SobelVectorImageFilter<ImageType, ImageType>                                            FilterType;
+  typedef otb::Functor::SobelOperator<itk::ConstNeighborhoodIterator<ImageType>, ImageType::PixelType> FunctorType;
+  typedef otb::UnaryFunctorNeighborhoodVectorImageFilter<ImageType, ImageType, FunctorType>            ReferenceFilterType;
+
+  ImageType::RegionType region;
+  region.SetSize(0, 53);
+  region.SetSize(1, 31);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(3);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+  ImageType::PixelType                         pixel(3);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    for (unsigned int b = 0; b < 3; ++b)
+    {
+      pixel[b] = (it.GetIndex()[0] * (b + 3) * 7919 + it.GetIndex()[1] * 104729) % 251;
+    }
+    it.Set(pixel);
+  }
+
+  // The line buffers must reproduce the generic neighborhood computation
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetNumberOfThreads(4);
+  filter->Update();
+
+  ReferenceFilterType::Pointer    reference = ReferenceFilterType::New();
+  ReferenceFilterType::RadiusType radius    = {{1, 1}};
+  reference->SetInput(image);
+  reference->SetRadius(radius);
+  reference->Update();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> outIt(filter->GetOutput(), region);
+  itk::ImageRegionIteratorWithIndex<ImageType> refIt(reference->GetOutput(), region);
+  for (outIt.GoToBegin(), refIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt, ++refIt)
+  {
+    for (unsigned int b = 0; b < 3; ++b)
+    {
+      if (std::abs(outIt.Get()[b] - refIt.Get()[b]) > 1e-3)
+      {
+        std::cerr << "Wrong Sobel value at " << outIt.GetIndex() << ": " << outIt.Get() << " instead of " << refIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
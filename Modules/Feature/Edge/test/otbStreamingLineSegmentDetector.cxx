@@ -23,6 +23,7 @@
 #include "otbStreamingLineSegmentDetector.h"
 #include "otbImageFileReader.h"
 #include "otbVectorDataFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 
 int otbStreamingLineSegmentDetector(int itkNotUsed(argc), char* argv[])
@@ -55,3 +56,72 @@ int otbStreamingLineSegmentDetector(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+namespace
+{
+template <class TVectorData>
+double LongestSegment(TVectorData* vd)
+{
+  typedef itk::PreOrderTreeIterator<typename TVectorData::DataTreeType> TreeIteratorType;
+
+  double           longest = 0.;
+  TreeIteratorType it(vd->GetDataTree());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get()->IsLineFeature())
+    {
+      longest = std::max(longest, it.Get()->GetLine()->GetLength());
+    }
+  }
+  return longest;
+}
+}
+
+int otbStreamingLineSegmentDetectorMerge(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<float, 2>                                     ImageType;
+  typedef otb::LineSegmentDetector<ImageType, double>              LSDType;
+  typedef otb::StreamingLineSegmentDetector<ImageType>::FilterType StreamingLineSegmentDetectorType;
+
+  // A slanted step edge crossing every strip
+  ImageType::RegionType region;
+  region.SetSize(0, 256);
+  region.SetSize(1, 256);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    it.Set(it.GetIndex()[1] > 2 * it.GetIndex()[0] - 100 ? 200. : 20.);
+  }
+
+  LSDType::Pointer lsd = LSDType::New();
+  lsd->SetInput(image);
+  lsd->Update();
+  const double global = LongestSegment(lsd->GetOutput());
+
+  // Streamed strips alone, then strips split between threads
+  const unsigned int lines[2]   = {40, 256};
+  const unsigned int threads[2] = {1, 4};
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    StreamingLineSegmentDetectorType::Pointer streamed = StreamingLineSegmentDetectorType::New();
+    streamed->GetFilter()->SetInput(image);
+    streamed->GetFilter()->MergeTileSegmentsOn();
+    streamed->GetFilter()->SetNumberOfThreads(threads[i]);
+    streamed->GetStreamer()->SetNumberOfLinesStrippedStreaming(lines[i]);
+    streamed->Update();
+
+    const double merged = LongestSegment(streamed->GetFilter()->GetOutputVectorData());
+    std::cout << "Longest segment: " << merged << " (global run: " << global << ")" << std::endl;
+    if (merged < 0.9 * global)
+    {
+      std::cerr << "Segments were not merged across the borders" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -54,10 +54,6 @@ public:
 
   inline OutputType operator()(TNeighIter& it) const
   {
-    OutputType moments;
-    moments.SetSize(4);
-    moments.Fill(itk::NumericTraits<ScalarRealType>::Zero);
-
     ScalarRealType sum1, sum2, sum3, sum4;
     sum1 = itk::NumericTraits<ScalarRealType>::Zero;
     sum2 = itk::NumericTraits<ScalarRealType>::Zero;
@@ -78,22 +74,37 @@ public:
       sum4 += value2 * value2;
     }
 
+    return FromSums(sum1, sum2, sum3, sum4, size);
+  }
+
+  /** Moments from the sums of the powers of (value - shift) over size
+   * values, computed in the precision of the sums. */
+  template <class TSum>
+  static OutputType FromSums(TSum sum1, TSum sum2, TSum sum3, TSum sum4, unsigned int size, TSum shift = TSum(0))
+  {
+    OutputType moments;
+    moments.SetSize(4);
+    moments.Fill(itk::NumericTraits<ScalarRealType>::Zero);
+
     // final computations
     // Mean
-    moments[0] = sum1 / size;
+    const TSum mean = sum1 / size;
     // Variance
-    moments[1] = (sum2 - (sum1 * moments[0])) / (size - 1);
+    const TSum variance = (sum2 - (sum1 * mean)) / (size - 1);
+
+    TSum sigma = std::sqrt(variance);
+    TSum mean2 = mean * mean;
 
-    ScalarRealType sigma = std::sqrt(moments[1]);
-    ScalarRealType mean2 = moments[0] * moments[0];
+    moments[0] = mean + shift;
+    moments[1] = variance;
 
     const double epsilon = 1E-10;
-    if (std::abs(moments[1]) > epsilon)
+    if (std::abs(variance) > epsilon)
     {
       // Skewness
-      moments[2] = ((sum3 - 3.0 * moments[0] * sum2) / size + 2.0 * moments[0] * mean2) / (moments[1] * sigma);
+      moments[2] = ((sum3 - 3.0 * mean * sum2) / size + 2.0 * mean * mean2) / (variance * sigma);
       // Kurtosis
-      moments[3] = ((sum4 - 4.0 * moments[0] * sum3 + 6.0 * mean2 * sum2) / size - 3.0 * mean2 * mean2) / (moments[1] * moments[1]) - 3.0;
+      moments[3] = ((sum4 - 4.0 * mean * sum3 + 6.0 * mean2 * sum2) / size - 3.0 * mean2 * mean2) / (variance * variance) - 3.0;
     }
 
     return moments;
@@ -24,6 +24,7 @@
 #include "itkImageToImageFilter.h"
 #include "otbRadiometricMomentsFunctor.h"
 #include "itkConstNeighborhoodIterator.h"
+#include "itkProgressReporter.h"
 
 namespace otb
 {
@@ -34,6 +35,11 @@ namespace otb
  *
  * Calculate the radiometric moments over a specified neighborhood
  *
+ * When both radii reach IntegralImageMinimumRadius (2 by default), the
+ * moments are computed from summed-area tables built in double precision
+ * on square tiles of the output region, so that the cost per pixel does
+ * not depend on the radius. Smaller neighborhoods are processed directly.
+ *
  * This class is templated over the input image and the output image.
  *
  * \ingroup ImageFilters
@@ -84,6 +90,10 @@ public:
     m_Radius.Fill(radius);
   }
 
+  /** Set/Get the smallest radius processed with summed-area tables */
+  itkSetMacro(IntegralImageMinimumRadius, unsigned int);
+  itkGetMacro(IntegralImageMinimumRadius, unsigned int);
+
   typedef itk::ConstNeighborhoodIterator<TInputImage>   NeighborhoodIteratorType;
   typedef typename NeighborhoodIteratorType::RadiusType RadiusType;
   typedef unsigned char                                 RadiusSizeType;
@@ -97,12 +107,16 @@ protected:
   void GenerateInputRequestedRegion(void) override;
   void GenerateOutputInformation(void) override;
 
+  /** Summed-area table version of ThreadedGenerateData() */
+  void IntegralImageGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ProgressReporter& progress);
+
 private:
   RadiometricMomentsImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
   InputImageSizeType m_Radius;
   FunctorType        m_Functor;
+  unsigned int       m_IntegralImageMinimumRadius;
 };
 
 } // namespace otb
@@ -23,10 +23,12 @@
 
 #include "otbRadiometricMomentsImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkProgressReporter.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
 #include "itkNeighborhoodAlgorithm.h"
+#include "otbSummedAreaTable.h"
 
 namespace otb
 {
@@ -38,6 +40,7 @@ RadiometricMomentsImageFilter<TInputImage, TOutputImage>::RadiometricMomentsImag
 {
   this->SetNumberOfRequiredInputs(1);
   m_Radius.Fill(1);
+  m_IntegralImageMinimumRadius = 2;
 }
 
 template <class TInputImage, class TOutputImage>
@@ -103,6 +106,15 @@ template <class TInputImage, class TOutputImage>
 void RadiometricMomentsImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
                                                                                     itk::ThreadIdType threadId)
 {
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  if (std::min(m_Radius[0], m_Radius[1]) >= m_IntegralImageMinimumRadius)
+  {
+    IntegralImageGenerateData(outputRegionForThread, progress);
+    return;
+  }
+
   itk::ZeroFluxNeumannBoundaryCondition<TInputImage> nbc;
 
   // We use dynamic_cast since inputs are stored as DataObjects.  The
@@ -127,9 +139,6 @@ void RadiometricMomentsImageFilter<TInputImage, TOutputImage>::ThreadedGenerateD
 
   typename itk::NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<TInputImage>::FaceListType::iterator fit;
 
-  // support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
-
   // Process each of the boundary faces.  These are N-d regions which border
   // the edge of the buffer.
   for (fit = faceList.begin(); fit != faceList.end(); ++fit)
@@ -151,6 +160,49 @@ void RadiometricMomentsImageFilter<TInputImage, TOutputImage>::ThreadedGenerateD
   }
 }
 
+template <class TInputImage, class TOutputImage>
+void RadiometricMomentsImageFilter<TInputImage, TOutputImage>::IntegralImageGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                         itk::ProgressReporter&       progress)
+{
+  InputImagePointer  inputPtr  = this->GetInput();
+  OutputImagePointer outputPtr = this->GetOutput();
+
+  // Tiles bound the magnitude of the sums, at the cost of recomputing
+  // the overlap of their padded regions
+  const itk::SizeValueType tileSize = std::max<itk::SizeValueType>(64, 2 * std::max(m_Radius[0], m_Radius[1]) + 1);
+  const unsigned int       size     = (2 * m_Radius[0] + 1) * (2 * m_Radius[1] + 1);
+
+  SummedAreaTable<InputImageType, 4> table;
+  double                             sums[4];
+
+  const typename OutputImageRegionType::IndexType start  = outputRegionForThread.GetIndex();
+  const typename OutputImageRegionType::SizeType  extent = outputRegionForThread.GetSize();
+
+  for (itk::SizeValueType ty = 0; ty < extent[1]; ty += tileSize)
+  {
+    for (itk::SizeValueType tx = 0; tx < extent[0]; tx += tileSize)
+    {
+      OutputImageRegionType tile;
+      tile.SetIndex(0, start[0] + tx);
+      tile.SetIndex(1, start[1] + ty);
+      tile.SetSize(0, std::min(tileSize, extent[0] - tx));
+      tile.SetSize(1, std::min(tileSize, extent[1] - ty));
+
+      InputImageRegionType padded = tile;
+      padded.PadByRadius(m_Radius);
+      table.Compute(inputPtr, padded);
+
+      itk::ImageRegionIteratorWithIndex<TOutputImage> outputIt(outputPtr, tile);
+      for (outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt)
+      {
+        table.GetSums(outputIt.GetIndex(), m_Radius, sums);
+        outputIt.Set(FunctorType::FromSums(sums[0], sums[1], sums[2], sums[3], size, table.GetShift()));
+        progress.CompletedPixel();
+      }
+    }
+  }
+}
+
 } // end namespace otb
 
 #endif
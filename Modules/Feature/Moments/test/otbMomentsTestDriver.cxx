@@ -37,4 +37,5 @@ void RegisterTests()
   REGISTER_TEST(otbFlusserPath);
   REGISTER_TEST(otbComplexMomentPath);
   REGISTER_TEST(otbRadiometricMomentsImageFilter);
+  REGISTER_TEST(otbRadiometricMomentsImageFilterIntegralImage);
 }
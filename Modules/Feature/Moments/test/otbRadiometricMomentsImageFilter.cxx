@@ -24,6 +24,8 @@
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
 #include "otbRadiometricMomentsImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <vector>
 
 
 int otbRadiometricMomentsImageFilter(int itkNotUsed(argc), char* argv[])
@@ -48,6 +50,8 @@ int otbRadiometricMomentsImageFilter(int itkNotUsed(argc), char* argv[])
   filter->SetInput(reader->GetOutput());
   filter->SetRadius(atoi(argv[3]));
   filter->SetNumberOfThreads(1);
+  // The baseline was produced by the direct neighborhood computation
+  filter->SetIntegralImageMinimumRadius(atoi(argv[3]) + 1);
 
   writer->SetFileName(argv[2]);
   writer->SetInput(filter->GetOutput());
@@ -55,3 +59,83 @@ int otbRadiometricMomentsImageFilter(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbRadiometricMomentsImageFilterIntegralImage(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<float, 2>                                           ImageType;
+  typedef otb::VectorImage<float, 2>                                     VectorImageType;
+  typedef otb::RadiometricMomentsImageFilter<ImageType, VectorImageType> FilterType;
+
+  // Skewed values on a large offset, to stress the cancellation in the sums
+  ImageType::RegionType region;
+  region.SetSize(0, 97);
+  region.SetSize(1, 83);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const unsigned int h = (it.GetIndex()[0] * 7919 + it.GetIndex()[1] * 104729) % 1013;
+    it.Set(1000. + (h * h) / 10000.);
+  }
+
+  FilterType::RadiusType radius;
+  radius[0] = 5;
+  radius[1] = 3;
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetRadius(radius);
+  filter->SetNumberOfThreads(3);
+  filter->Update();
+
+  const long   width  = region.GetSize(0);
+  const long   height = region.GetSize(1);
+  const double n      = (2 * radius[0] + 1) * (2 * radius[1] + 1);
+
+  itk::ImageRegionIteratorWithIndex<VectorImageType> outIt(filter->GetOutput(), region);
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    // Two-pass reference in double, with replicated borders
+    const ImageType::IndexType center = outIt.GetIndex();
+    std::vector<double>        values;
+    for (long y = center[1] - static_cast<long>(radius[1]); y <= center[1] + static_cast<long>(radius[1]); ++y)
+    {
+      for (long x = center[0] - static_cast<long>(radius[0]); x <= center[0] + static_cast<long>(radius[0]); ++x)
+      {
+        ImageType::IndexType idx;
+        idx[0] = std::min(std::max(x, 0L), width - 1);
+        idx[1] = std::min(std::max(y, 0L), height - 1);
+        values.push_back(image->GetPixel(idx));
+      }
+    }
+    double mean = 0.;
+    for (double v : values)
+      mean += v;
+    mean /= n;
+    double m2 = 0., m3 = 0., m4 = 0.;
+    for (double v : values)
+    {
+      const double d = v - mean;
+      m2 += d * d;
+      m3 += d * d * d;
+      m4 += d * d * d * d;
+    }
+    const double variance = m2 / (n - 1);
+    const double skewness = m3 / n / (variance * std::sqrt(variance));
+    const double kurtosis = m4 / n / (variance * variance) - 3.;
+
+    const VectorImageType::PixelType moments = outIt.Get();
+    if (std::abs(moments[0] - mean) > 1e-3 || std::abs(moments[1] - variance) > 1e-4 * variance || std::abs(moments[2] - skewness) > 1e-4 ||
+        std::abs(moments[3] - kurtosis) > 1e-4)
+    {
+      std::cerr << "Wrong moments at " << center << ": " << moments << " instead of [" << mean << ", " << variance << ", " << skewness << ", " << kurtosis
+                << "]" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
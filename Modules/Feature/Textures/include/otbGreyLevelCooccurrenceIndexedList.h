@@ -127,6 +127,10 @@ public:
   // m_InputImageMaximum. If so add to m_Vector via AddPairToVector method */
   void AddPixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2);
 
+  /** Remove a pixel pair previously added with AddPixelPair. This allows one
+    * to slide a window over the image without rebuilding the list. */
+  void RemovePixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2);
+
   /* Get the frequency value from Vector with index =[j,i] */
   RelativeFrequencyType GetFrequency(IndexValueType i, IndexValueType j);
 
@@ -144,6 +148,11 @@ protected:
     * co-occurrence pair is added again with index values swapped */
   void AddPairToVector(IndexType index);
 
+  /** Decrement the frequency of the pair with given index. A pair whose
+    * frequency drops to zero is swapped with the last element of the vector
+    * and removed. */
+  void RemovePairFromVector(IndexType index);
+
   void SetBinMin(const unsigned int dimension, const InstanceIdentifier nbin, PixelValueType min);
 
   void SetBinMax(const unsigned int dimension, const InstanceIdentifier nbin, PixelValueType max);
@@ -217,6 +217,38 @@ void GreyLevelCooccurrenceIndexedList<TPixel>::AddPixelPair(const PixelValueType
   }
 }
 
+template <class TPixel>
+void GreyLevelCooccurrenceIndexedList<TPixel>::RemovePixelPair(const PixelValueType& pixelvalue1, const PixelValueType& pixelvalue2)
+{
+  // Same filtering as AddPixelPair, so that out-of-bounds pairs which were
+  // never added are not removed
+  if (pixelvalue1 < m_InputImageMinimum || pixelvalue1 > m_InputImageMaximum)
+  {
+    return;
+  }
+
+  if (pixelvalue2 < m_InputImageMinimum || pixelvalue2 > m_InputImageMaximum)
+  {
+    return;
+  }
+
+  IndexType     index;
+  PixelPairType ppair(PixelPairSize);
+  ppair[0] = pixelvalue1;
+  ppair[1] = pixelvalue2;
+
+  this->GetIndex(ppair, index);
+  this->RemovePairFromVector(index);
+  if (m_Symmetry)
+  {
+    IndexValueType temp;
+    temp     = index[0];
+    index[0] = index[1];
+    index[1] = temp;
+    this->RemovePairFromVector(index);
+  }
+}
+
 template <class TPixel>
 typename GreyLevelCooccurrenceIndexedList<TPixel>::RelativeFrequencyType GreyLevelCooccurrenceIndexedList<TPixel>::GetFrequency(IndexValueType i,
                                                                                                                                 IndexValueType j)
@@ -274,6 +306,29 @@ void GreyLevelCooccurrenceIndexedList<TPixel>::AddPairToVector(IndexType index)
   m_TotalFrequency = m_TotalFrequency + 1;
 }
 
+template <class TPixel>
+void GreyLevelCooccurrenceIndexedList<TPixel>::RemovePairFromVector(IndexType index)
+{
+  InstanceIdentifier instanceId = index[1] * m_Size[0] + index[0];
+  int                vindex     = m_LookupArray[instanceId];
+  if (vindex < 0)
+  {
+    return;
+  }
+
+  if (--m_Vector[vindex].second == 0)
+  {
+    // Move the last pair in the freed slot to keep the vector compact
+    const CooccurrencePairType& last   = m_Vector.back();
+    InstanceIdentifier          lastId = last.first[1] * m_Size[0] + last.first[0];
+    m_LookupArray[lastId]              = vindex;
+    m_Vector[vindex]                   = last;
+    m_Vector.pop_back();
+    m_LookupArray[instanceId] = -1;
+  }
+  m_TotalFrequency = m_TotalFrequency - 1;
+}
+
 template <class TPixel>
 void GreyLevelCooccurrenceIndexedList<TPixel>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
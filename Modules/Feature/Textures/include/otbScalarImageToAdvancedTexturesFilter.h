@@ -180,6 +180,15 @@ public:
   /** Get the sub-sampling offset */
   itkGetMacro(SubsampleOffset, OffsetType);
 
+  /** Set/Get the incremental update of the co-occurrence list. When on,
+   * the list is updated along each row by removing the pairs of the
+   * leaving columns and adding those of the entering columns, instead of
+   * being rebuilt over the whole window. Off by default, since the
+   * summation order of the textures then differs slightly. */
+  itkSetMacro(Incremental, bool);
+  itkGetMacro(Incremental, bool);
+  itkBooleanMacro(Incremental);
+
   /** Get the mean output image */
   OutputImageType* GetMeanOutput();
 
@@ -254,6 +263,12 @@ private:
 
   /** Sub-sampling offset */
   OffsetType m_SubsampleOffset;
+
+  /** Incremental update of the co-occurrence list */
+  bool m_Incremental;
+
+  /** Add (or remove) to the list the pixel pairs whose first pixel lies in region */
+  void UpdateCooccurrenceList(CooccurrenceIndexedListType* list, const InputRegionType& region, bool remove) const;
 };
 } // End namespace otb
 
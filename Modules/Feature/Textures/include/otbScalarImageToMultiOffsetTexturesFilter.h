@@ -0,0 +1,257 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbScalarImageToMultiOffsetTexturesFilter_h
+#define otbScalarImageToMultiOffsetTexturesFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkVectorContainer.h"
+#include <vector>
+
+namespace otb
+{
+/** \class ScalarImageToMultiOffsetTexturesFilter
+ *  \brief Computes the simple, advanced and higher order textures for
+ *  several offsets in a single pass over the input image.
+ *
+ *  Each thread quantises its part of the input image once, using the same
+ *  bins as otb::GreyLevelCooccurrenceIndexedList, and the quantised values
+ *  are shared by all the offsets and all the texture sets. For each output
+ *  pixel and each offset, a dense co-occurrence matrix is updated when the
+ *  window slides along a row, and the grey level run-length matrix is built
+ *  from the same quantised window.
+ *
+ *  The output is a vector image. For each offset, its bands are the 8
+ *  features of otb::ScalarImageToTexturesFilter, then the 10 features of
+ *  otb::ScalarImageToAdvancedTexturesFilter, then the 10 features of
+ *  otb::ScalarImageToHigherOrderTexturesFilter, restricted to the enabled
+ *  sets. When AverageOffsets is on, each feature is averaged over the
+ *  offsets instead, which gives rotation invariant textures if the offsets
+ *  cover all the directions.
+ *
+ *  The run-length grey levels use the co-occurrence bins, that is
+ *  [min, max + 1) split in NumberOfBinsPerAxis bins.
+ *
+ * \sa otb::ScalarImageToTexturesFilter
+ * \sa otb::ScalarImageToAdvancedTexturesFilter
+ * \sa otb::ScalarImageToHigherOrderTexturesFilter
+ *
+ * \ingroup Streamed
+ * \ingroup Threaded
+ *
+ * \ingroup OTBTextures
+ */
+template <class TInputImage, class TOutputImage>
+class ScalarImageToMultiOffsetTexturesFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs */
+  typedef ScalarImageToMultiOffsetTexturesFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Creation through the object factory */
+  itkNewMacro(Self);
+
+  /** RTTI */
+  itkTypeMacro(ScalarImageToMultiOffsetTexturesFilter, ImageToImageFilter);
+
+  /** Template class typedefs */
+  typedef TInputImage                          InputImageType;
+  typedef typename InputImageType::PixelType   InputPixelType;
+  typedef typename InputImageType::RegionType  InputRegionType;
+  typedef typename InputImageType::IndexType   IndexType;
+  typedef typename InputImageType::OffsetType  OffsetType;
+  typedef typename InputRegionType::SizeType   SizeType;
+  typedef TOutputImage                         OutputImageType;
+  typedef typename OutputImageType::Pointer    OutputImagePointerType;
+  typedef typename OutputImageType::PixelType  OutputPixelType;
+  typedef typename OutputImageType::RegionType OutputRegionType;
+
+  typedef itk::VectorContainer<unsigned char, OffsetType> OffsetVector;
+  typedef typename OffsetVector::Pointer                   OffsetVectorPointer;
+  typedef typename OffsetVector::ConstPointer              OffsetVectorConstPointer;
+
+  /** Number of features of each texture set */
+  static constexpr unsigned int NumberOfSimpleTextures      = 8;
+  static constexpr unsigned int NumberOfAdvancedTextures    = 10;
+  static constexpr unsigned int NumberOfHigherOrderTextures = 10;
+
+  /** Set the radius of the window on which textures will be computed */
+  itkSetMacro(Radius, SizeType);
+  /** Get the radius of the window on which textures will be computed */
+  itkGetMacro(Radius, SizeType);
+
+  /** Get/Set the offsets over which the textures will be computed.
+      Calling either of these methods clears the previous offsets. */
+  itkSetConstObjectMacro(Offsets, OffsetVector);
+  itkGetConstObjectMacro(Offsets, OffsetVector);
+
+  void SetOffset(const OffsetType offset);
+
+  /** Set the number of bin per axis */
+  itkSetMacro(NumberOfBinsPerAxis, unsigned int);
+
+  /** Get the number of bin per axis */
+  itkGetMacro(NumberOfBinsPerAxis, unsigned int);
+
+  /** Set the input image minimum */
+  itkSetMacro(InputImageMinimum, InputPixelType);
+
+  /** Get the input image minimum */
+  itkGetMacro(InputImageMinimum, InputPixelType);
+
+  /** Set the input image maximum */
+  itkSetMacro(InputImageMaximum, InputPixelType);
+
+  /** Get the input image maximum */
+  itkGetMacro(InputImageMaximum, InputPixelType);
+
+  /** Set the sub-sampling factor */
+  itkSetMacro(SubsampleFactor, SizeType);
+
+  /** Get the sub-sampling factor */
+  itkGetMacro(SubsampleFactor, SizeType);
+
+  /** Set the sub-sampling offset */
+  itkSetMacro(SubsampleOffset, OffsetType);
+
+  /** Get the sub-sampling offset */
+  itkGetMacro(SubsampleOffset, OffsetType);
+
+  /** Set/Get the computation of the simple textures (on by default) */
+  itkSetMacro(ComputeSimpleTextures, bool);
+  itkGetMacro(ComputeSimpleTextures, bool);
+  itkBooleanMacro(ComputeSimpleTextures);
+
+  /** Set/Get the computation of the advanced textures (on by default) */
+  itkSetMacro(ComputeAdvancedTextures, bool);
+  itkGetMacro(ComputeAdvancedTextures, bool);
+  itkBooleanMacro(ComputeAdvancedTextures);
+
+  /** Set/Get the computation of the higher order textures (on by default) */
+  itkSetMacro(ComputeHigherOrderTextures, bool);
+  itkGetMacro(ComputeHigherOrderTextures, bool);
+  itkBooleanMacro(ComputeHigherOrderTextures);
+
+  /** Set/Get the averaging of the features over the offsets (off by default) */
+  itkSetMacro(AverageOffsets, bool);
+  itkGetMacro(AverageOffsets, bool);
+  itkBooleanMacro(AverageOffsets);
+
+  /** Number of features computed for each offset */
+  unsigned int GetNumberOfFeaturesPerOffset() const;
+
+  /** Number of bands of the output image */
+  unsigned int GetNumberOfFeatures() const;
+
+protected:
+  /** Constructor */
+  ScalarImageToMultiOffsetTexturesFilter();
+  /** Destructor */
+  ~ScalarImageToMultiOffsetTexturesFilter() override;
+  /** Generate the output information */
+  void GenerateOutputInformation() override;
+  /** Generate the input requested region */
+  void GenerateInputRequestedRegion() override;
+  /** Before Parallel textures extraction */
+  void BeforeThreadedGenerateData() override;
+  /** Parallel textures extraction */
+  void ThreadedGenerateData(const OutputRegionType& outputRegion, itk::ThreadIdType threadId) override;
+
+private:
+  ScalarImageToMultiOffsetTexturesFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Quantised grey levels of a region of the input, -1 outside [min, max] */
+  struct QuantizedRegion
+  {
+    InputRegionType  region;
+    std::vector<int> bins;
+
+    int Get(const IndexType& index) const;
+  };
+
+  typedef std::vector<long> MatrixType;
+
+  /** Bin of a grey level, -1 if it is outside [min, max] */
+  int Quantize(const InputPixelType& value) const;
+
+  /** Add (or remove) the co-occurrence pairs whose first pixel lies in region */
+  void UpdateCooccurrenceMatrix(const QuantizedRegion& quantized, const InputRegionType& region, const OffsetType& offset, long sign, MatrixType& matrix,
+                                long& totalFrequency) const;
+
+  /** Build the run-length matrix of the window along offset */
+  void ComputeRunLengthMatrix(const QuantizedRegion& quantized, const InputRegionType& window, unsigned int offsetIndex, MatrixType& matrix,
+                              long& totalRuns) const;
+
+  void ComputeSimpleTextures(const MatrixType& matrix, double totalFrequency, double* features) const;
+  void ComputeAdvancedTextures(const MatrixType& matrix, double totalFrequency, double* features) const;
+  void ComputeHigherOrderTextures(const MatrixType& matrix, double totalRuns, double* features) const;
+
+  /** Radius of the window on which to compute textures */
+  SizeType m_Radius;
+
+  /** Offsets for co-occurence and run-length */
+  OffsetVectorConstPointer m_Offsets;
+
+  /** Number of bins per axis */
+  unsigned int m_NumberOfBinsPerAxis;
+
+  /** Input image minimum */
+  InputPixelType m_InputImageMinimum;
+
+  /** Input image maximum */
+  InputPixelType m_InputImageMaximum;
+
+  /** Sub-sampling factor */
+  SizeType m_SubsampleFactor;
+
+  /** Sub-sampling offset */
+  OffsetType m_SubsampleOffset;
+
+  /** Texture sets to compute */
+  bool m_ComputeSimpleTextures;
+  bool m_ComputeAdvancedTextures;
+  bool m_ComputeHigherOrderTextures;
+
+  /** Average the features over the offsets */
+  bool m_AverageOffsets;
+
+  /** Lower bounds of the grey level bins */
+  std::vector<InputPixelType> m_BinMinimums;
+
+  /** Lower bounds of the run length bins, in physical unit */
+  std::vector<double> m_RunLengthBinMinimums;
+
+  /** Longest possible run, in physical unit */
+  double m_MaximumRunLength;
+
+  /** Physical displacement of each offset */
+  std::vector<std::vector<double>> m_PhysicalOffsets;
+};
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbScalarImageToMultiOffsetTexturesFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,778 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbScalarImageToMultiOffsetTexturesFilter_hxx
+#define otbScalarImageToMultiOffsetTexturesFilter_hxx
+
+#include "otbScalarImageToMultiOffsetTexturesFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "itkNeighborhood.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+template <class TInputImage, class TOutputImage>
+ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::ScalarImageToMultiOffsetTexturesFilter()
+  : m_Radius(),
+    m_NumberOfBinsPerAxis(8),
+    m_InputImageMinimum(0),
+    m_InputImageMaximum(255),
+    m_SubsampleFactor(),
+    m_SubsampleOffset(),
+    m_ComputeSimpleTextures(true),
+    m_ComputeAdvancedTextures(true),
+    m_ComputeHigherOrderTextures(true),
+    m_AverageOffsets(false),
+    m_MaximumRunLength(0.)
+{
+  m_Radius.Fill(2);
+
+  // Default offsets: the "previous" neighbors 1 pixel away, as in
+  // ScalarImageToHigherOrderTexturesFilter
+  typedef itk::Neighborhood<InputPixelType, InputImageType::ImageDimension> NeighborhoodType;
+  NeighborhoodType hood;
+  hood.SetRadius(1);
+
+  unsigned int        centerIndex = hood.GetCenterNeighborhoodIndex();
+  OffsetVectorPointer offsets     = OffsetVector::New();
+  for (unsigned int d = 0; d < centerIndex; d++)
+  {
+    offsets->push_back(hood.GetOffset(d));
+  }
+  this->SetOffsets(offsets);
+
+  this->m_SubsampleFactor.Fill(1);
+  this->m_SubsampleOffset.Fill(0);
+}
+
+template <class TInputImage, class TOutputImage>
+ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::~ScalarImageToMultiOffsetTexturesFilter()
+{
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::SetOffset(const OffsetType offset)
+{
+  OffsetVectorPointer offsetVector = OffsetVector::New();
+  offsetVector->push_back(offset);
+  this->SetOffsets(offsetVector);
+}
+
+template <class TInputImage, class TOutputImage>
+unsigned int ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::GetNumberOfFeaturesPerOffset() const
+{
+  return (m_ComputeSimpleTextures ? NumberOfSimpleTextures : 0) + (m_ComputeAdvancedTextures ? NumberOfAdvancedTextures : 0) +
+         (m_ComputeHigherOrderTextures ? NumberOfHigherOrderTextures : 0);
+}
+
+template <class TInputImage, class TOutputImage>
+unsigned int ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::GetNumberOfFeatures() const
+{
+  const unsigned int nbOffsets = m_Offsets ? m_Offsets->Size() : 0;
+  return this->GetNumberOfFeaturesPerOffset() * (m_AverageOffsets ? std::min(nbOffsets, 1u) : nbOffsets);
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  if (this->GetNumberOfFeatures() == 0)
+  {
+    itkExceptionMacro(<< "At least one offset and one texture set are required.");
+  }
+
+  // Compute output size, origin & spacing
+  const InputImageType* inputPtr    = this->GetInput();
+  InputRegionType       inputRegion = inputPtr->GetLargestPossibleRegion();
+  OutputRegionType      outputRegion;
+  outputRegion.SetIndex(0, 0);
+  outputRegion.SetIndex(1, 0);
+  outputRegion.SetSize(0, 1 + (inputRegion.GetSize(0) - 1 - m_SubsampleOffset[0]) / m_SubsampleFactor[0]);
+  outputRegion.SetSize(1, 1 + (inputRegion.GetSize(1) - 1 - m_SubsampleOffset[1]) / m_SubsampleFactor[1]);
+
+  typename OutputImageType::SpacingType outSpacing = inputPtr->GetSignedSpacing();
+  outSpacing[0] *= m_SubsampleFactor[0];
+  outSpacing[1] *= m_SubsampleFactor[1];
+
+  typename OutputImageType::PointType outOrigin;
+  inputPtr->TransformIndexToPhysicalPoint(inputRegion.GetIndex() + m_SubsampleOffset, outOrigin);
+
+  OutputImagePointerType outputPtr = this->GetOutput();
+  outputPtr->CopyInformation(inputPtr);
+  outputPtr->SetLargestPossibleRegion(outputRegion);
+  outputPtr->SetOrigin(outOrigin);
+  outputPtr->SetSignedSpacing(outSpacing);
+  outputPtr->SetNumberOfComponentsPerPixel(this->GetNumberOfFeatures());
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // First, call superclass implementation
+  Superclass::GenerateInputRequestedRegion();
+
+  // Retrieve the input and output pointers
+  InputImageType*        inputPtr  = const_cast<InputImageType*>(this->GetInput());
+  OutputImagePointerType outputPtr = this->GetOutput();
+
+  if (!inputPtr || !outputPtr)
+  {
+    return;
+  }
+
+  OutputRegionType                     outputRequestedRegion = outputPtr->GetRequestedRegion();
+  typename OutputRegionType::IndexType outputIndex           = outputRequestedRegion.GetIndex();
+  typename OutputRegionType::SizeType  outputSize            = outputRequestedRegion.GetSize();
+  typename InputRegionType::IndexType  inputIndex;
+  typename InputRegionType::SizeType   inputSize;
+  InputRegionType                      inputLargest = inputPtr->GetLargestPossibleRegion();
+
+  // Convert index and size to full grid
+  outputIndex[0] = outputIndex[0] * m_SubsampleFactor[0] + m_SubsampleOffset[0] + inputLargest.GetIndex(0);
+  outputIndex[1] = outputIndex[1] * m_SubsampleFactor[1] + m_SubsampleOffset[1] + inputLargest.GetIndex(1);
+  outputSize[0]  = 1 + (outputSize[0] - 1) * m_SubsampleFactor[0];
+  outputSize[1]  = 1 + (outputSize[1] - 1) * m_SubsampleFactor[1];
+
+  // First, apply all the offsets
+  for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+  {
+    itk::OffsetValueType lower = 0;
+    itk::OffsetValueType upper = 0;
+    for (unsigned int k = 0; k < m_Offsets->Size(); ++k)
+    {
+      lower = std::min(lower, m_Offsets->GetElement(k)[dim]);
+      upper = std::max(upper, m_Offsets->GetElement(k)[dim]);
+    }
+    inputIndex[dim] = outputIndex[dim] + lower;
+    inputSize[dim]  = outputSize[dim] + upper - lower;
+  }
+
+  // Build the input requested region
+  InputRegionType inputRequestedRegion;
+  inputRequestedRegion.SetIndex(inputIndex);
+  inputRequestedRegion.SetSize(inputSize);
+
+  // Apply the radius
+  inputRequestedRegion.PadByRadius(m_Radius);
+
+  // Try to apply the requested region to the input image
+  if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+  }
+  else
+  {
+    // Build an exception
+    itk::InvalidRequestedRegionError e(__FILE__, __LINE__);
+    e.SetLocation(ITK_LOCATION);
+    e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+    e.SetDataObject(inputPtr);
+    throw e;
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  const InputImageType* inputPtr = this->GetInput();
+
+  // Grey level bins, computed as in GreyLevelCooccurrenceIndexedList::Initialize()
+  const InputPixelType upperBound = m_InputImageMaximum + 1;
+  const float          interval   = static_cast<float>(upperBound - m_InputImageMinimum) / static_cast<InputPixelType>(m_NumberOfBinsPerAxis);
+  m_BinMinimums.resize(m_NumberOfBinsPerAxis);
+  for (unsigned int j = 0; j < m_NumberOfBinsPerAxis; ++j)
+  {
+    m_BinMinimums[j] = static_cast<InputPixelType>(m_InputImageMinimum + (static_cast<float>(j) * interval));
+  }
+
+  // Compute the max possible run length (in physical unit)
+  const IndexType                    originIndex = inputPtr->GetLargestPossibleRegion().GetIndex();
+  typename InputImageType::PointType topLeftPoint;
+  typename InputImageType::PointType bottomRightPoint;
+  inputPtr->TransformIndexToPhysicalPoint(originIndex - m_Radius, topLeftPoint);
+  inputPtr->TransformIndexToPhysicalPoint(originIndex + m_Radius, bottomRightPoint);
+  m_MaximumRunLength = topLeftPoint.EuclideanDistanceTo(bottomRightPoint);
+
+  // Run length bins over [0, max run length], as in itk::Statistics::Histogram::Initialize()
+  const float runLengthInterval = static_cast<float>(m_MaximumRunLength) / static_cast<double>(m_NumberOfBinsPerAxis);
+  m_RunLengthBinMinimums.resize(m_NumberOfBinsPerAxis);
+  for (unsigned int j = 0; j < m_NumberOfBinsPerAxis; ++j)
+  {
+    m_RunLengthBinMinimums[j] = static_cast<double>(static_cast<float>(j) * runLengthInterval);
+  }
+
+  // Physical displacement of one step along each offset
+  typename InputImageType::PointType originPoint;
+  inputPtr->TransformIndexToPhysicalPoint(originIndex, originPoint);
+  m_PhysicalOffsets.assign(m_Offsets->Size(), std::vector<double>(InputImageType::ImageDimension));
+  for (unsigned int k = 0; k < m_Offsets->Size(); ++k)
+  {
+    typename InputImageType::PointType offsetPoint;
+    inputPtr->TransformIndexToPhysicalPoint(originIndex + m_Offsets->GetElement(k), offsetPoint);
+    for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+    {
+      m_PhysicalOffsets[k][dim] = offsetPoint[dim] - originPoint[dim];
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputRegionType& outputRegionForThread,
+                                                                                             itk::ThreadIdType threadId)
+{
+  const InputImageType*  inputPtr  = this->GetInput();
+  OutputImagePointerType outputPtr = this->GetOutput();
+
+  const unsigned int nbBins              = m_NumberOfBinsPerAxis;
+  const unsigned int nbOffsets           = m_Offsets->Size();
+  const unsigned int nbFeaturesPerOffset = this->GetNumberOfFeaturesPerOffset();
+  const unsigned int nbFeatures          = this->GetNumberOfFeatures();
+  const bool         computeCooccurrence = m_ComputeSimpleTextures || m_ComputeAdvancedTextures;
+
+  InputRegionType inputLargest = inputPtr->GetLargestPossibleRegion();
+
+  // Quantise once the part of the input read by this thread: the union of
+  // its windows, extended by the offsets for the co-occurrence pairs
+  QuantizedRegion quantized;
+  for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+  {
+    itk::OffsetValueType lower = 0;
+    itk::OffsetValueType upper = 0;
+    for (unsigned int k = 0; k < nbOffsets; ++k)
+    {
+      lower = std::min(lower, m_Offsets->GetElement(k)[dim]);
+      upper = std::max(upper, m_Offsets->GetElement(k)[dim]);
+    }
+    const itk::IndexValueType start = outputRegionForThread.GetIndex(dim) * m_SubsampleFactor[dim] + m_SubsampleOffset[dim] + inputLargest.GetIndex(dim);
+    const itk::SizeValueType  size  = 1 + (outputRegionForThread.GetSize(dim) - 1) * m_SubsampleFactor[dim];
+    quantized.region.SetIndex(dim, start - static_cast<itk::IndexValueType>(m_Radius[dim]) + lower);
+    quantized.region.SetSize(dim, size + 2 * m_Radius[dim] + upper - lower);
+  }
+  quantized.region.Crop(inputPtr->GetBufferedRegion());
+  quantized.bins.resize(quantized.region.GetNumberOfPixels());
+
+  itk::ImageRegionConstIterator<InputImageType> inIt(inputPtr, quantized.region);
+  std::vector<int>::iterator                    binIt = quantized.bins.begin();
+  for (inIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++binIt)
+  {
+    *binIt = this->Quantize(inIt.Get());
+  }
+
+  // Co-occurrence matrices of the previous window, updated along the rows
+  std::vector<MatrixType> cooccurrences(nbOffsets, MatrixType(nbBins * nbBins, 0));
+  std::vector<long>       totalFrequencies(nbOffsets, 0);
+  MatrixType              runLengths(nbBins * nbBins, 0);
+  InputRegionType         previousRegion;
+  bool                    hasPrevious = false;
+
+  std::vector<double> features(nbFeaturesPerOffset);
+  std::vector<double> accumulated(nbFeatures);
+  OutputPixelType     outPixel(nbFeatures);
+
+  // Set-up progress reporting
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  itk::ImageRegionIteratorWithIndex<OutputImageType> outIt(outputPtr, outputRegionForThread);
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    // Window on which the textures are estimated
+    typename InputRegionType::IndexType inputIndex;
+    typename InputRegionType::SizeType  inputSize;
+    for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+    {
+      inputIndex[dim] = outIt.GetIndex()[dim] * m_SubsampleFactor[dim] + m_SubsampleOffset[dim] + inputLargest.GetIndex(dim) - m_Radius[dim];
+      inputSize[dim]  = 2 * m_Radius[dim] + 1;
+    }
+    InputRegionType inputRegion(inputIndex, inputSize);
+    inputRegion.Crop(inputPtr->GetRequestedRegion());
+
+    if (computeCooccurrence)
+    {
+      bool slide = hasPrevious;
+      for (unsigned int dim = 1; dim < InputImageType::ImageDimension; ++dim)
+      {
+        slide = slide && inputRegion.GetIndex(dim) == previousRegion.GetIndex(dim) && inputRegion.GetSize(dim) == previousRegion.GetSize(dim);
+      }
+      const itk::IndexValueType previousEnd = previousRegion.GetIndex(0) + static_cast<itk::IndexValueType>(previousRegion.GetSize(0));
+      const itk::IndexValueType currentEnd  = inputRegion.GetIndex(0) + static_cast<itk::IndexValueType>(inputRegion.GetSize(0));
+      slide = slide && inputRegion.GetIndex(0) >= previousRegion.GetIndex(0) && currentEnd >= previousEnd;
+
+      for (unsigned int k = 0; k < nbOffsets; ++k)
+      {
+        const OffsetType offset = m_Offsets->GetElement(k);
+        if (slide)
+        {
+          // The window slid along the row: remove the leaving columns and add the entering ones
+          InputRegionType leavingRegion = previousRegion;
+          leavingRegion.SetSize(0, std::min(previousEnd, inputRegion.GetIndex(0)) - previousRegion.GetIndex(0));
+          this->UpdateCooccurrenceMatrix(quantized, leavingRegion, offset, -1, cooccurrences[k], totalFrequencies[k]);
+
+          InputRegionType enteringRegion = inputRegion;
+          enteringRegion.SetIndex(0, std::max(previousEnd, inputRegion.GetIndex(0)));
+          enteringRegion.SetSize(0, currentEnd - enteringRegion.GetIndex(0));
+          this->UpdateCooccurrenceMatrix(quantized, enteringRegion, offset, 1, cooccurrences[k], totalFrequencies[k]);
+        }
+        else
+        {
+          std::fill(cooccurrences[k].begin(), cooccurrences[k].end(), 0);
+          totalFrequencies[k] = 0;
+          this->UpdateCooccurrenceMatrix(quantized, inputRegion, offset, 1, cooccurrences[k], totalFrequencies[k]);
+        }
+      }
+      previousRegion = inputRegion;
+      hasPrevious    = true;
+    }
+
+    std::fill(accumulated.begin(), accumulated.end(), 0.);
+    for (unsigned int k = 0; k < nbOffsets; ++k)
+    {
+      unsigned int pos = 0;
+      if (m_ComputeSimpleTextures)
+      {
+        this->ComputeSimpleTextures(cooccurrences[k], static_cast<double>(totalFrequencies[k]), &features[pos]);
+        pos += NumberOfSimpleTextures;
+      }
+      if (m_ComputeAdvancedTextures)
+      {
+        this->ComputeAdvancedTextures(cooccurrences[k], static_cast<double>(totalFrequencies[k]), &features[pos]);
+        pos += NumberOfAdvancedTextures;
+      }
+      if (m_ComputeHigherOrderTextures)
+      {
+        long totalRuns = 0;
+        this->ComputeRunLengthMatrix(quantized, inputRegion, k, runLengths, totalRuns);
+        this->ComputeHigherOrderTextures(runLengths, static_cast<double>(totalRuns), &features[pos]);
+      }
+
+      const unsigned int band = m_AverageOffsets ? 0 : k * nbFeaturesPerOffset;
+      for (unsigned int i = 0; i < nbFeaturesPerOffset; ++i)
+      {
+        accumulated[band + i] += features[i];
+      }
+    }
+
+    for (unsigned int i = 0; i < nbFeatures; ++i)
+    {
+      outPixel[i] = m_AverageOffsets ? accumulated[i] / nbOffsets : accumulated[i];
+    }
+    outIt.Set(outPixel);
+
+    // Update progress
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+int ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::QuantizedRegion::Get(const IndexType& index) const
+{
+  if (!region.IsInside(index))
+  {
+    return -1;
+  }
+  std::size_t pos    = 0;
+  std::size_t stride = 1;
+  for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+  {
+    pos += (index[dim] - region.GetIndex(dim)) * stride;
+    stride *= region.GetSize(dim);
+  }
+  return bins[pos];
+}
+
+template <class TInputImage, class TOutputImage>
+int ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::Quantize(const InputPixelType& value) const
+{
+  if (value < m_InputImageMinimum || value > m_InputImageMaximum)
+  {
+    return -1;
+  }
+  return std::upper_bound(m_BinMinimums.begin(), m_BinMinimums.end(), value) - m_BinMinimums.begin() - 1;
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::UpdateCooccurrenceMatrix(const QuantizedRegion& quantized, const InputRegionType& region,
+                                                                                                 const OffsetType& offset, long sign, MatrixType& matrix,
+                                                                                                 long& totalFrequency) const
+{
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  const unsigned int nbBins = m_NumberOfBinsPerAxis;
+
+  itk::ImageRegionConstIteratorWithIndex<InputImageType> it(this->GetInput(), region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const int centerBin   = quantized.Get(it.GetIndex());
+    const int neighborBin = quantized.Get(it.GetIndex() + offset);
+    if (centerBin < 0 || neighborBin < 0)
+    {
+      continue; // don't put a pair in the matrix if one of its pixels is out of bounds
+    }
+    // The matrix is symmetric
+    matrix[centerBin * nbBins + neighborBin] += sign;
+    matrix[neighborBin * nbBins + centerBin] += sign;
+    totalFrequency += 2 * sign;
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::ComputeRunLengthMatrix(const QuantizedRegion& quantized, const InputRegionType& window,
+                                                                                               unsigned int offsetIndex, MatrixType& matrix,
+                                                                                               long& totalRuns) const
+{
+  const unsigned int         nbBins         = m_NumberOfBinsPerAxis;
+  const OffsetType           offset         = m_Offsets->GetElement(offsetIndex);
+  const std::vector<double>& physicalOffset = m_PhysicalOffsets[offsetIndex];
+
+  std::fill(matrix.begin(), matrix.end(), 0);
+  totalRuns = 0;
+
+  itk::ImageRegionConstIteratorWithIndex<InputImageType> it(this->GetInput(), window);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const IndexType index = it.GetIndex();
+    const int       bin   = quantized.Get(index);
+    if (bin < 0)
+    {
+      continue;
+    }
+
+    // Each run is counted once, from its first pixel along the offset
+    const IndexType previous = index - offset;
+    if (window.IsInside(previous) && quantized.Get(previous) == bin)
+    {
+      continue;
+    }
+
+    unsigned int steps = 0;
+    for (IndexType next = index + offset; window.IsInside(next) && quantized.Get(next) == bin; next += offset)
+    {
+      ++steps;
+    }
+
+    double squaredLength = 0.;
+    for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+    {
+      squaredLength += (steps * physicalOffset[dim]) * (steps * physicalOffset[dim]);
+    }
+    const double length = std::sqrt(squaredLength);
+    if (length > m_MaximumRunLength)
+    {
+      continue;
+    }
+
+    const long lengthBin = std::upper_bound(m_RunLengthBinMinimums.begin(), m_RunLengthBinMinimums.end(), length) - m_RunLengthBinMinimums.begin() - 1;
+    ++matrix[bin * nbBins + lengthBin];
+    ++totalRuns;
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::ComputeSimpleTextures(const MatrixType& matrix, double totalFrequency,
+                                                                                              double* features) const
+{
+  const unsigned int nbBins    = m_NumberOfBinsPerAxis;
+  const double       log2      = std::log(2.0);
+  const double       tolerance = 0.0001;
+
+  double pixelMean = 0.;
+  double marginalMean;
+  double marginalDevSquared = 0.;
+  double pixelVariance      = 0.;
+
+  // Normalize the co-occurrence matrix and compute mean, marginalSum
+  std::vector<double> marginalSums(nbBins, 0);
+  for (unsigned int a = 0; a < nbBins; ++a)
+  {
+    for (unsigned int b = 0; b < nbBins; ++b)
+    {
+      if (matrix[a * nbBins + b] != 0)
+      {
+        const double frequency = matrix[a * nbBins + b] / totalFrequency;
+        pixelMean += a * frequency;
+        marginalSums[a] += frequency;
+      }
+    }
+  }
+
+  // Mean and deviation of the marginal sums, a la Knuth (see ScalarImageToTexturesFilter)
+  std::vector<double>::const_iterator msIt = marginalSums.begin();
+  marginalMean                             = *msIt;
+  ++msIt;
+  for (int k = 2; msIt != marginalSums.end(); ++k, ++msIt)
+  {
+    double M_k_minus_1 = marginalMean;
+    double S_k_minus_1 = marginalDevSquared;
+    double x_k         = *msIt;
+    double M_k         = M_k_minus_1 + (x_k - M_k_minus_1) / k;
+    double S_k         = S_k_minus_1 + (x_k - M_k_minus_1) * (x_k - M_k);
+    marginalMean       = M_k;
+    marginalDevSquared = S_k;
+  }
+  marginalDevSquared = marginalDevSquared / nbBins;
+
+  for (unsigned int a = 0; a < nbBins; ++a)
+  {
+    for (unsigned int b = 0; b < nbBins; ++b)
+    {
+      if (matrix[a * nbBins + b] != 0)
+      {
+        const double frequency = matrix[a * nbBins + b] / totalFrequency;
+        pixelVariance += (a - pixelMean) * (a - pixelMean) * frequency;
+      }
+    }
+  }
+
+  double pixelVarianceSquared = pixelVariance * pixelVariance;
+  // Avoid NaN correlation on uniform windows
+  if (pixelVarianceSquared < tolerance)
+  {
+    pixelVarianceSquared = 1.;
+  }
+
+  double energy                  = 0.;
+  double entropy                 = 0.;
+  double correlation             = 0.;
+  double inverseDifferenceMoment = 0.;
+  double inertia                 = 0.;
+  double clusterShade            = 0.;
+  double clusterProminence       = 0.;
+  double haralickCorrelation     = 0.;
+
+  for (unsigned int a = 0; a < nbBins; ++a)
+  {
+    for (unsigned int b = 0; b < nbBins; ++b)
+    {
+      if (matrix[a * nbBins + b] == 0)
+      {
+        continue;
+      }
+      const double frequency = matrix[a * nbBins + b] / totalFrequency;
+      const double i         = a;
+      const double j         = b;
+      energy += frequency * frequency;
+      entropy -= (frequency > tolerance) ? frequency * std::log(frequency) / log2 : 0;
+      correlation += ((i - pixelMean) * (j - pixelMean) * frequency) / pixelVarianceSquared;
+      inverseDifferenceMoment += frequency / (1.0 + (i - j) * (i - j));
+      inertia += (i - j) * (i - j) * frequency;
+      clusterShade += std::pow((i - pixelMean) + (j - pixelMean), 3) * frequency;
+      clusterProminence += std::pow((i - pixelMean) + (j - pixelMean), 4) * frequency;
+      haralickCorrelation += i * j * frequency;
+    }
+  }
+
+  haralickCorrelation = (std::abs(marginalDevSquared) > 1E-8) ? (haralickCorrelation - marginalMean * marginalMean) / marginalDevSquared : 0;
+
+  features[0] = energy;
+  features[1] = entropy;
+  features[2] = correlation;
+  features[3] = inverseDifferenceMoment;
+  features[4] = inertia;
+  features[5] = clusterShade;
+  features[6] = clusterProminence;
+  features[7] = haralickCorrelation;
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::ComputeAdvancedTextures(const MatrixType& matrix, double totalFrequency,
+                                                                                                double* features) const
+{
+  const unsigned int      histSize      = m_NumberOfBinsPerAxis;
+  const long unsigned int twiceHistSize = 2 * m_NumberOfBinsPerAxis;
+  const double            log2          = std::log(2.0);
+
+  double mean               = 0.;
+  double variance           = 0.;
+  double dissimilarity      = 0.;
+  double sumAverage         = 0.;
+  double sumEntropy         = 0.;
+  double sumVariance        = 0.;
+  double differenceEntropy  = 0.;
+  double differenceVariance = 0.;
+  double entropy            = 0.;
+  double hxy1               = 0.;
+
+  std::vector<double> hx(histSize, 0.);
+  std::vector<double> hy(histSize, 0.);
+  std::vector<double> pdxy(twiceHistSize, 0.);
+
+  // Compute Mean, Entropy (f12), hx, hy, pdxy. The first index of a cell is
+  // j and the second one i, as in ScalarImageToAdvancedTexturesFilter.
+  for (unsigned int j = 0; j < histSize; ++j)
+  {
+    for (unsigned int i = 0; i < histSize; ++i)
+    {
+      if (matrix[j * histSize + i] == 0)
+      {
+        continue;
+      }
+      const double frequency = matrix[j * histSize + i] / totalFrequency;
+      mean += static_cast<double>(j) * frequency;
+      entropy -= (frequency > 0.0001) ? frequency * std::log(frequency) / log2 : 0.;
+      hx[j] += frequency;
+      hy[i] += frequency;
+
+      if (i + j > histSize - 1)
+      {
+        pdxy[i + j] += frequency;
+      }
+      if (i <= j)
+      {
+        pdxy[j - i] += frequency;
+      }
+    }
+  }
+
+  // Second pass to find variance and pipj, needed to calculate f11
+  for (unsigned int j = 0; j < histSize; ++j)
+  {
+    for (unsigned int i = 0; i < histSize; ++i)
+    {
+      if (matrix[j * histSize + i] == 0)
+      {
+        continue;
+      }
+      const double frequency = matrix[j * histSize + i] / totalFrequency;
+      variance += ((j - mean) * (j - mean)) * frequency;
+      const double pipj = hx[j] * hy[i];
+      hxy1 -= (pipj > 0.0001) ? frequency * std::log(pipj) : 0.;
+    }
+  }
+
+  double PSSquareCumul = 0;
+  for (long unsigned int k = histSize; k < twiceHistSize; k++)
+  {
+    sumAverage += k * pdxy[k];
+    sumEntropy -= (pdxy[k] > 0.0001) ? pdxy[k] * std::log(pdxy[k]) / log2 : 0;
+    PSSquareCumul += k * k * pdxy[k];
+  }
+  sumVariance = PSSquareCumul - sumAverage * sumAverage;
+
+  double PDSquareCumul = 0;
+  double PDCumul       = 0;
+  double hxCumul       = 0;
+  double hyCumul       = 0;
+  for (long unsigned int i = 0; i < histSize; ++i)
+  {
+    double pdTmp = pdxy[i];
+    PDCumul += i * pdTmp;
+    differenceEntropy -= (pdTmp > 0.0001) ? pdTmp * std::log(pdTmp) / log2 : 0;
+    PDSquareCumul += i * i * pdTmp;
+
+    double marginalfreq = hx[i];
+    hxCumul += (marginalfreq > 0.0001) ? std::log(marginalfreq) * marginalfreq : 0;
+
+    marginalfreq = hy[i];
+    hyCumul += (marginalfreq > 0.0001) ? std::log(marginalfreq) * marginalfreq : 0;
+  }
+  differenceVariance = PDSquareCumul - PDCumul * PDCumul;
+
+  double hxy2 = 0;
+  for (unsigned int i = 0; i < histSize; ++i)
+  {
+    for (unsigned int j = 0; j < histSize; ++j)
+    {
+      double pipj = hx[j] * hy[i];
+      hxy2 -= (pipj > 0.0001) ? pipj * std::log(pipj) : 0.;
+      if (matrix[i * histSize + j] != 0)
+      {
+        double frequency = matrix[i * histSize + j] / totalFrequency;
+        dissimilarity += (static_cast<double>(j) - static_cast<double>(i)) * (frequency * frequency);
+      }
+    }
+  }
+
+  // Information measures of correlation 1 & 2
+  double ic1 = (std::abs(std::max(hxCumul, hyCumul)) > 0.0001) ? (entropy - hxy1) / (std::max(hxCumul, hyCumul)) : 0;
+  double ic2 = 1 - std::exp(-2. * std::abs(hxy2 - entropy));
+  ic2        = (ic2 >= 0) ? std::sqrt(ic2) : 0;
+
+  features[0] = mean;
+  features[1] = variance;
+  features[2] = dissimilarity;
+  features[3] = sumAverage;
+  features[4] = sumVariance;
+  features[5] = sumEntropy;
+  features[6] = differenceEntropy;
+  features[7] = differenceVariance;
+  features[8] = ic1;
+  features[9] = ic2;
+}
+
+template <class TInputImage, class TOutputImage>
+void ScalarImageToMultiOffsetTexturesFilter<TInputImage, TOutputImage>::ComputeHigherOrderTextures(const MatrixType& matrix, double totalRuns,
+                                                                                                   double* features) const
+{
+  const unsigned int nbBins = m_NumberOfBinsPerAxis;
+
+  std::fill(features, features + NumberOfHigherOrderTextures, 0.);
+  if (totalRuns == 0)
+  {
+    return;
+  }
+
+  // Same definitions as itk::Statistics::HistogramToRunLengthFeaturesFilter
+  std::vector<double> greyLevelNonuniformityVector(nbBins, 0.);
+  std::vector<double> runLengthNonuniformityVector(nbBins, 0.);
+  for (unsigned int g = 0; g < nbBins; ++g)
+  {
+    for (unsigned int r = 0; r < nbBins; ++r)
+    {
+      const double frequency = matrix[g * nbBins + r];
+      if (frequency == 0)
+      {
+        continue;
+      }
+      const double i2 = static_cast<double>((g + 1) * (g + 1));
+      const double j2 = static_cast<double>((r + 1) * (r + 1));
+
+      features[0] += frequency / j2;
+      features[1] += frequency * j2;
+      greyLevelNonuniformityVector[g] += frequency;
+      runLengthNonuniformityVector[r] += frequency;
+      features[4] += frequency / i2;
+      features[5] += frequency * i2;
+      features[6] += frequency / (i2 * j2);
+      features[7] += frequency * i2 / j2;
+      features[8] += frequency * j2 / i2;
+      features[9] += frequency * i2 * j2;
+    }
+  }
+  for (unsigned int k = 0; k < nbBins; ++k)
+  {
+    features[2] += greyLevelNonuniformityVector[k] * greyLevelNonuniformityVector[k];
+    features[3] += runLengthNonuniformityVector[k] * runLengthNonuniformityVector[k];
+  }
+
+  // Normalize all measures by the total number of runs
+  for (unsigned int k = 0; k < NumberOfHigherOrderTextures; ++k)
+  {
+    features[k] /= totalRuns;
+  }
+}
+
+} // End namespace otb
+
+#endif
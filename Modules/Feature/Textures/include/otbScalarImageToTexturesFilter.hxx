@@ -28,6 +28,7 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "itkNumericTraits.h"
+#include <algorithm>
 #include <vector>
 #include <cmath>
 
@@ -42,7 +43,8 @@ ScalarImageToTexturesFilter<TInputImage, TOutputImage>::ScalarImageToTexturesFil
     m_InputImageMinimum(0),
     m_InputImageMaximum(255),
     m_SubsampleFactor(),
-    m_SubsampleOffset()
+    m_SubsampleOffset(),
+    m_Incremental(false)
 {
   // There are 8 outputs corresponding to the 8 textures indices
   this->SetNumberOfRequiredOutputs(8);
@@ -299,6 +301,10 @@ void ScalarImageToTexturesFilter<TInputImage, TOutputImage>::ThreadedGenerateDat
   // Set-up progress reporting
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
+  // Co-occurrence list and window of the previous output pixel, used by the incremental update
+  CooccurrenceIndexedListPointerType GLCIList;
+  InputRegionType                    previousRegion;
+
   // Iterate on outputs to compute textures
   while (!energyIt.IsAtEnd() && !entropyIt.IsAtEnd() && !correlationIt.IsAtEnd() && !invDiffMomentIt.IsAtEnd() && !inertiaIt.IsAtEnd() &&
          !clusterShadeIt.IsAtEnd() && !clusterProminenceIt.IsAtEnd() && !haralickCorIt.IsAtEnd())
@@ -325,24 +331,43 @@ void ScalarImageToTexturesFilter<TInputImage, TOutputImage>::ThreadedGenerateDat
     inputRegion.SetSize(inputSize);
     inputRegion.Crop(inputPtr->GetRequestedRegion());
 
-    CooccurrenceIndexedListPointerType GLCIList = CooccurrenceIndexedListType::New();
-    GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
-
-    typedef itk::ConstNeighborhoodIterator<InputImageType> NeighborhoodIteratorType;
-    NeighborhoodIteratorType                               neighborIt;
-    neighborIt = NeighborhoodIteratorType(m_NeighborhoodRadius, inputPtr, inputRegion);
-    for (neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt)
+    const itk::IndexValueType previousEnd = previousRegion.GetIndex(0) + static_cast<itk::IndexValueType>(previousRegion.GetSize(0));
+    const itk::IndexValueType currentEnd  = inputRegion.GetIndex(0) + static_cast<itk::IndexValueType>(inputRegion.GetSize(0));
+    if (m_Incremental && GLCIList && inputRegion.GetIndex(1) == previousRegion.GetIndex(1) && inputRegion.GetSize(1) == previousRegion.GetSize(1) &&
+        inputRegion.GetIndex(0) >= previousRegion.GetIndex(0) && currentEnd >= previousEnd)
+    {
+      // The window slid along the row: remove the leaving columns and add the entering ones
+      InputRegionType leavingRegion = previousRegion;
+      leavingRegion.SetSize(0, std::min(previousEnd, inputRegion.GetIndex(0)) - previousRegion.GetIndex(0));
+      this->UpdateCooccurrenceList(GLCIList, leavingRegion, true);
+
+      InputRegionType enteringRegion = inputRegion;
+      enteringRegion.SetIndex(0, std::max(previousEnd, inputRegion.GetIndex(0)));
+      enteringRegion.SetSize(0, currentEnd - enteringRegion.GetIndex(0));
+      this->UpdateCooccurrenceList(GLCIList, enteringRegion, false);
+    }
+    else
     {
-      const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
-      bool                 pixelInBounds;
-      const InputPixelType pixelIntensity = neighborIt.GetPixel(m_Offset, pixelInBounds);
-      if (!pixelInBounds)
+      GLCIList = CooccurrenceIndexedListType::New();
+      GLCIList->Initialize(m_NumberOfBinsPerAxis, m_InputImageMinimum, m_InputImageMaximum);
+
+      typedef itk::ConstNeighborhoodIterator<InputImageType> NeighborhoodIteratorType;
+      NeighborhoodIteratorType                               neighborIt;
+      neighborIt = NeighborhoodIteratorType(m_NeighborhoodRadius, inputPtr, inputRegion);
+      for (neighborIt.GoToBegin(); !neighborIt.IsAtEnd(); ++neighborIt)
       {
-        continue; // don't put a pixel in the co-occurrence list if the value is
-                  // out of bounds
+        const InputPixelType centerPixelIntensity = neighborIt.GetCenterPixel();
+        bool                 pixelInBounds;
+        const InputPixelType pixelIntensity = neighborIt.GetPixel(m_Offset, pixelInBounds);
+        if (!pixelInBounds)
+        {
+          continue; // don't put a pixel in the co-occurrence list if the value is
+                    // out of bounds
+        }
+        GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
       }
-      GLCIList->AddPixelPair(centerPixelIntensity, pixelIntensity);
     }
+    previousRegion = inputRegion;
 
     double pixelMean = 0.;
     double marginalMean;
@@ -466,6 +491,37 @@ void ScalarImageToTexturesFilter<TInputImage, TOutputImage>::ThreadedGenerateDat
   }
 }
 
+template <class TInputImage, class TOutputImage>
+void ScalarImageToTexturesFilter<TInputImage, TOutputImage>::UpdateCooccurrenceList(CooccurrenceIndexedListType* list, const InputRegionType& region, bool remove) const
+{
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  const InputImageType*  inputPtr       = this->GetInput();
+  const InputRegionType& bufferedRegion = inputPtr->GetBufferedRegion();
+
+  itk::ImageRegionConstIteratorWithIndex<InputImageType> it(inputPtr, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    // Same pairs as the neighborhood iterator: the offset pixel must be buffered
+    const typename InputImageType::IndexType offsetIndex = it.GetIndex() + m_Offset;
+    if (!bufferedRegion.IsInside(offsetIndex))
+    {
+      continue;
+    }
+    if (remove)
+    {
+      list->RemovePixelPair(it.Get(), inputPtr->GetPixel(offsetIndex));
+    }
+    else
+    {
+      list->AddPixelPair(it.Get(), inputPtr->GetPixel(offsetIndex));
+    }
+  }
+}
+
 } // End namespace otb
 
 #endif
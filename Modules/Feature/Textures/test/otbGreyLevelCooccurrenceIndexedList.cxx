@@ -240,6 +240,32 @@ int otbGreyLevelCooccurrenceIndexedList(int, char* [])
     std::cerr << "Co-occurrence list total frequencies are correct" << std::endl;
   }
 
+  // Check that removed pairs leave the list as if they were never added
+  CooccurrenceIndexedListType::Pointer cooccurrenceObj3 = CooccurrenceIndexedListType::New();
+  cooccurrenceObj3->Initialize(8, 0, 3);
+  cooccurrenceObj3->AddPixelPair(1, 2);
+  cooccurrenceObj3->AddPixelPair(2, 2);
+  cooccurrenceObj3->AddPixelPair(1, 1);
+  cooccurrenceObj3->AddPixelPair(2, 1);
+  cooccurrenceObj3->RemovePixelPair(1, 2);
+  cooccurrenceObj3->RemovePixelPair(2, 2);
+  cooccurrenceObj3->RemovePixelPair(1, 5);
+
+  // With 8 bins over [0, 4), grey levels 1 and 2 fall in bins 2 and 4
+  CooccurrenceIndexedListType::VectorType remaining = cooccurrenceObj3->GetVector();
+  bool                                    removed   = cooccurrenceObj3->GetTotalFrequency() == 4 && remaining.size() == 3;
+  for (const auto& pair : remaining)
+  {
+    const FrequencyType expected = (pair.first[0] == 2 && pair.first[1] == 2) ? 2 : 1;
+    removed                      = removed && pair.first[0] + pair.first[1] != 8 && pair.second == expected;
+  }
+  if (!removed)
+  {
+    std::cerr << "Unexpected co-occurrence list after removing pairs: total frequency " << cooccurrenceObj3->GetTotalFrequency() << ", "
+              << remaining.size() << " pairs" << std::endl;
+    passed = false;
+  }
+
   if (!passed)
   {
     std::cerr << "Test failed" << std::endl;
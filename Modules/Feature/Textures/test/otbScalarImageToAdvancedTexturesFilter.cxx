@@ -28,9 +28,9 @@
 
 int otbScalarImageToAdvancedTexturesFilter(int argc, char* argv[])
 {
-  if (argc != 7)
+  if (argc != 7 && argc != 8)
   {
-    std::cerr << "Usage: " << argv[0] << " infname outprefix nbBins radius offsetx offsety" << std::endl;
+    std::cerr << "Usage: " << argv[0] << " infname outprefix nbBins radius offsetx offsety [incremental]" << std::endl;
     return EXIT_FAILURE;
   }
   const char*        infname   = argv[1];
@@ -70,6 +70,10 @@ int otbScalarImageToAdvancedTexturesFilter(int argc, char* argv[])
   otb::StandardFilterWatcher watcher(filter, "Textures filter");
 
   filter->SetNumberOfBinsPerAxis(nbBins);
+  if (argc == 8)
+  {
+    filter->SetIncremental(atoi(argv[7]) != 0);
+  }
   filter->SetInputImageMinimum(0);
   filter->SetInputImageMaximum(255);
 
@@ -0,0 +1,192 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbScalarImageToMultiOffsetTexturesFilter.h"
+#include "otbScalarImageToTexturesFilter.h"
+#include "otbScalarImageToAdvancedTexturesFilter.h"
+#include "otbScalarImageToHigherOrderTexturesFilter.h"
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+const unsigned int Dimension = 2;
+typedef float      PixelType;
+typedef otb::Image<PixelType, Dimension>                                        ImageType;
+typedef otb::VectorImage<PixelType, Dimension>                                  VectorImageType;
+typedef otb::ScalarImageToMultiOffsetTexturesFilter<ImageType, VectorImageType> MultiOffsetFilterType;
+typedef otb::ScalarImageToTexturesFilter<ImageType, ImageType>                  SimpleFilterType;
+typedef otb::ScalarImageToAdvancedTexturesFilter<ImageType, ImageType>          AdvancedFilterType;
+typedef otb::ScalarImageToHigherOrderTexturesFilter<ImageType, ImageType>       HigherOrderFilterType;
+typedef otb::ImageFileReader<ImageType>                                         ReaderType;
+typedef MultiOffsetFilterType::OffsetType                                       OffsetType;
+typedef MultiOffsetFilterType::OffsetVector                                     OffsetVector;
+
+bool IsClose(double value, double reference)
+{
+  return std::abs(value - reference) <= 1e-4 * std::max(1., std::abs(reference));
+}
+
+// Compare the band of the multi-offset filter with a single texture output
+bool CheckBand(const VectorImageType* multi, unsigned int band, const ImageType* reference, const char* name)
+{
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(reference, reference->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const double value = multi->GetPixel(it.GetIndex())[band];
+    if (!IsClose(value, it.Get()))
+    {
+      std::cerr << name << " differs at " << it.GetIndex() << ": got " << value << ", expected " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int otbScalarImageToMultiOffsetTexturesFilter(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " infname nbBins radius" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const char*        infname = argv[1];
+  const unsigned int nbBins  = atoi(argv[2]);
+  const unsigned int radius  = atoi(argv[3]);
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(infname);
+  reader->Update();
+
+  MultiOffsetFilterType::SizeType sradius;
+  sradius.Fill(radius);
+
+  OffsetVector::Pointer offsets = OffsetVector::New();
+  OffsetType            offset;
+  offset[0] = 1;
+  offset[1] = 0;
+  offsets->push_back(offset);
+  offset[0] = 1;
+  offset[1] = 1;
+  offsets->push_back(offset);
+
+  MultiOffsetFilterType::Pointer multiFilter = MultiOffsetFilterType::New();
+  multiFilter->SetInput(reader->GetOutput());
+  multiFilter->SetRadius(sradius);
+  multiFilter->SetOffsets(offsets);
+  multiFilter->SetNumberOfBinsPerAxis(nbBins);
+  multiFilter->SetInputImageMinimum(0);
+  multiFilter->SetInputImageMaximum(255);
+  multiFilter->Update();
+
+  const unsigned int nbFeatures = multiFilter->GetNumberOfFeaturesPerOffset();
+  if (multiFilter->GetOutput()->GetNumberOfComponentsPerPixel() != 2 * nbFeatures)
+  {
+    std::cerr << "Unexpected number of bands: " << multiFilter->GetOutput()->GetNumberOfComponentsPerPixel() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  for (unsigned int k = 0; k < offsets->Size(); ++k)
+  {
+    const unsigned int band = k * nbFeatures;
+
+    SimpleFilterType::Pointer simpleFilter = SimpleFilterType::New();
+    simpleFilter->SetInput(reader->GetOutput());
+    simpleFilter->SetRadius(sradius);
+    simpleFilter->SetOffset(offsets->GetElement(k));
+    simpleFilter->SetNumberOfBinsPerAxis(nbBins);
+    simpleFilter->SetInputImageMinimum(0);
+    simpleFilter->SetInputImageMaximum(255);
+    simpleFilter->Update();
+    for (unsigned int i = 0; i < MultiOffsetFilterType::NumberOfSimpleTextures; ++i)
+    {
+      passed = passed && CheckBand(multiFilter->GetOutput(), band + i, simpleFilter->GetOutput(i), "Simple texture");
+    }
+
+    AdvancedFilterType::Pointer advancedFilter = AdvancedFilterType::New();
+    advancedFilter->SetInput(reader->GetOutput());
+    advancedFilter->SetRadius(sradius);
+    advancedFilter->SetOffset(offsets->GetElement(k));
+    advancedFilter->SetNumberOfBinsPerAxis(nbBins);
+    advancedFilter->SetInputImageMinimum(0);
+    advancedFilter->SetInputImageMaximum(255);
+    advancedFilter->Update();
+    for (unsigned int i = 0; i < MultiOffsetFilterType::NumberOfAdvancedTextures; ++i)
+    {
+      passed = passed && CheckBand(multiFilter->GetOutput(), band + MultiOffsetFilterType::NumberOfSimpleTextures + i, advancedFilter->GetOutput(i),
+                                   "Advanced texture");
+    }
+
+    // The run-length grey levels use [0, 256) like the co-occurrence bins
+    HigherOrderFilterType::Pointer higherOrderFilter = HigherOrderFilterType::New();
+    higherOrderFilter->SetInput(reader->GetOutput());
+    higherOrderFilter->SetRadius(sradius);
+    higherOrderFilter->SetOffset(offsets->GetElement(k));
+    higherOrderFilter->SetNumberOfBinsPerAxis(nbBins);
+    higherOrderFilter->SetInputImageMinimum(0);
+    higherOrderFilter->SetInputImageMaximum(256);
+    higherOrderFilter->Update();
+    for (unsigned int i = 0; i < MultiOffsetFilterType::NumberOfHigherOrderTextures; ++i)
+    {
+      passed = passed && CheckBand(multiFilter->GetOutput(),
+                                   band + MultiOffsetFilterType::NumberOfSimpleTextures + MultiOffsetFilterType::NumberOfAdvancedTextures + i,
+                                   higherOrderFilter->GetOutput(i), "Higher order texture");
+    }
+  }
+
+  // Averaged outputs are the mean of the per-offset bands
+  MultiOffsetFilterType::Pointer averageFilter = MultiOffsetFilterType::New();
+  averageFilter->SetInput(reader->GetOutput());
+  averageFilter->SetRadius(sradius);
+  averageFilter->SetOffsets(offsets);
+  averageFilter->SetNumberOfBinsPerAxis(nbBins);
+  averageFilter->SetInputImageMinimum(0);
+  averageFilter->SetInputImageMaximum(255);
+  averageFilter->AverageOffsetsOn();
+  averageFilter->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<VectorImageType> it(averageFilter->GetOutput(), averageFilter->GetOutput()->GetLargestPossibleRegion());
+  for (it.GoToBegin(); passed && !it.IsAtEnd(); ++it)
+  {
+    const VectorImageType::PixelType perOffset = multiFilter->GetOutput()->GetPixel(it.GetIndex());
+    for (unsigned int i = 0; i < nbFeatures; ++i)
+    {
+      const double expected = (static_cast<double>(perOffset[i]) + perOffset[nbFeatures + i]) / 2;
+      if (!IsClose(it.Get()[i], expected))
+      {
+        std::cerr << "Averaged feature " << i << " differs at " << it.GetIndex() << ": got " << it.Get()[i] << ", expected " << expected << std::endl;
+        passed = false;
+      }
+    }
+  }
+
+  if (!passed)
+  {
+    std::cerr << "Test failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
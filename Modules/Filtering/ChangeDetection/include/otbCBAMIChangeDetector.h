@@ -49,6 +49,11 @@ namespace otb
  * The filter expect all images to have the same dimension
  * (e.g. all 2D, or all 3D, or all ND)
  *
+ * For 2D images of scalar pixels, the moments of the window, which are
+ * those of the products of up to four pixel values, are derived from
+ * running sums updated from the previous window instead of being
+ * computed over the whole window for each pixel (see SlidingWindowSums).
+ *
  * \ingroup IntensityImageFilters Multithreaded
  *
  * \ingroup OTBChangeDetection
@@ -76,6 +81,8 @@ public:
   /** Macro defining the type*/
   itkTypeMacro(CBAMIChangeDetector, SuperClass);
 
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
 protected:
   CBAMIChangeDetector()
   {
@@ -84,6 +91,9 @@ protected:
   {
   }
 
+  /** Sliding window computation of the CBAMI */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 private:
   CBAMIChangeDetector(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -91,4 +101,8 @@ private:
 
 } // end namespace otb
 
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbCBAMIChangeDetector.hxx"
+#endif
+
 #endif
@@ -0,0 +1,103 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbCBAMIChangeDetector_hxx
+#define otbCBAMIChangeDetector_hxx
+
+#include "otbCBAMIChangeDetector.h"
+#include "otbSlidingWindowSums.h"
+#include "itkProgressReporter.h"
+
+#include <cmath>
+
+namespace otb
+{
+
+template <class TInputImage1, class TInputImage2, class TOutputImage>
+void CBAMIChangeDetector<TInputImage1, TInputImage2, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                          itk::ThreadIdType            threadId)
+{
+  typedef SlidingWindowSums<6> SumsType;
+
+  const NeumannPixelReader<TInputImage1> input1(dynamic_cast<const TInputImage1*>(this->itk::ProcessObject::GetInput(0)));
+  const NeumannPixelReader<TInputImage2> input2(dynamic_cast<const TInputImage2*>(this->itk::ProcessObject::GetInput(1)));
+  TOutputImage*                          output = this->GetOutput();
+
+  const long         startX = outputRegionForThread.GetIndex()[0];
+  const long         startY = outputRegionForThread.GetIndex()[1];
+  const unsigned int width  = outputRegionForThread.GetSize()[0];
+  const unsigned int height = outputRegionForThread.GetSize()[1];
+
+  // Functor::CBAMI works on the raw values of the window (its
+  // normalization step is applied to copies), and only needs the moments
+  // of the products of two and four of them, without the fourth powers
+  auto features = [&](long x, long y, double* values) {
+    const double a = input1(x, y);
+    const double b = input2(x, y);
+    values[0]      = a * a;
+    values[1]      = a * b;
+    values[2]      = b * b;
+    values[3]      = a * a * a * b;
+    values[4]      = a * a * b * b;
+    values[5]      = a * b * b * b;
+  };
+
+  SumsType     sums(std::vector<typename SumsType::RadiusType>(1, this->m_Radius), startX, width);
+  const double windowSize = sums.GetWindowSize(0);
+  const double epsilon    = 0.01;
+
+  const typename TOutputImage::RegionType& buffered = output->GetBufferedRegion();
+  itk::ProgressReporter                    progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  for (unsigned int row = 0; row < height; ++row)
+  {
+    const long y = startY + row;
+    sums.SetRow(y, features);
+
+    auto out = output->GetBufferPointer() + (y - buffered.GetIndex()[1]) * buffered.GetSize()[0] + (startX - buffered.GetIndex()[0]);
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      const double* values = sums.GetSums(0, i);
+      const double  Eaa    = values[0] / windowSize;
+      const double  Eab    = values[1] / windowSize;
+      const double  Ebb    = values[2] / windowSize;
+      const double  Eaaab  = values[3] / windowSize;
+      const double  Eaabb  = values[4] / windowSize;
+      const double  Eabbb  = values[5] / windowSize;
+
+      // Sum of the squared second order cross cumulants, and of the
+      // squared fourth order cumulants Qxijkl of Functor::CBAMI, which
+      // only depend on the number of b among their variables
+      const double termeR = 2 * Eab * Eab;
+      const double q1     = Eaaab - 3 * Eaa * Eab;
+      const double q2     = Eaabb - Eaa * Ebb - 2 * Eab * Eab;
+      const double q3     = Eabbb - 3 * Eab * Ebb;
+      const double termeQ = 4 * q1 * q1 + 6 * q2 * q2 + 4 * q3 * q3;
+
+      const double phiMI = 1.0 / 4.0 * termeR + 1.0 / 48.0 * termeQ;
+      out[i]             = static_cast<typename TOutputImage::PixelType>(-std::log(phiMI + epsilon));
+      progress.CompletedPixel();
+    }
+  }
+}
+
+} // end namespace otb
+
+#endif
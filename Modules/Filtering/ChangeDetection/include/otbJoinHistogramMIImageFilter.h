@@ -49,6 +49,11 @@ namespace otb
  * The filter expect all images to have the same dimension
  * (e.g. all 2D, or all 3D, or all ND)
  *
+ * For 2D images of scalar pixels, the frequency of the joint histogram
+ * bin of each pixel is looked up once, and the sums of f log(f) over the
+ * windows are updated from the previous window (see SlidingWindowSums)
+ * instead of looking up the whole window for each pixel.
+ *
  * \ingroup IntensityImageFilters Multithreaded
  *
  * \ingroup OTBChangeDetection
@@ -78,6 +83,9 @@ public:
   /** Macro defining the type*/
   itkTypeMacro(JoinHistogramMIImageFilter, SuperClass);
 
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+  typedef typename Superclass::HistogramType         HistogramType;
+
 protected:
   JoinHistogramMIImageFilter()
   {
@@ -86,6 +94,9 @@ protected:
   {
   }
 
+  /** Sliding window computation of the joint entropy */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 private:
   JoinHistogramMIImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -93,4 +104,8 @@ private:
 
 } // end namespace otb
 
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbJoinHistogramMIImageFilter.hxx"
+#endif
+
 #endif
@@ -0,0 +1,87 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbJoinHistogramMIImageFilter_hxx
+#define otbJoinHistogramMIImageFilter_hxx
+
+#include "otbJoinHistogramMIImageFilter.h"
+#include "otbSlidingWindowSums.h"
+#include "itkProgressReporter.h"
+
+#include <cmath>
+
+namespace otb
+{
+
+template <class TInputImage1, class TInputImage2, class TOutputImage>
+void JoinHistogramMIImageFilter<TInputImage1, TInputImage2, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                 itk::ThreadIdType            threadId)
+{
+  typedef SlidingWindowSums<1> SumsType;
+
+  const NeumannPixelReader<TInputImage1> input1(dynamic_cast<const TInputImage1*>(this->itk::ProcessObject::GetInput(0)));
+  const NeumannPixelReader<TInputImage2> input2(dynamic_cast<const TInputImage2*>(this->itk::ProcessObject::GetInput(1)));
+  TOutputImage*                          output    = this->GetOutput();
+  const HistogramType*                   histogram = this->m_Histogram;
+
+  const long         startX = outputRegionForThread.GetIndex()[0];
+  const long         startY = outputRegionForThread.GetIndex()[1];
+  const unsigned int width  = outputRegionForThread.GetSize()[0];
+  const unsigned int height = outputRegionForThread.GetSize()[1];
+
+  // Functor::JoinHistogramMI sums f log(f) over the window, f being the
+  // frequency of the joint histogram bin of each pixel
+  typename HistogramType::MeasurementVectorType sample(2);
+  typename HistogramType::IndexType             index;
+  auto features = [&](long x, long y, double* values) {
+    sample[0] = input1(x, y);
+    sample[1] = input2(x, y);
+    histogram->GetIndex(sample, index);
+    const double frequency = histogram->GetFrequency(index);
+    values[0]              = frequency > 0 ? frequency * std::log(frequency) : 0.;
+  };
+
+  typename SumsType::RadiusType radius;
+  radius.Fill(this->m_Radius);
+  SumsType sums(std::vector<typename SumsType::RadiusType>(1, radius), startX, width);
+
+  const double totalFrequency = histogram->GetTotalFrequency();
+  const double logTotal       = std::log(totalFrequency);
+
+  const typename TOutputImage::RegionType& buffered = output->GetBufferedRegion();
+  itk::ProgressReporter                    progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  for (unsigned int row = 0; row < height; ++row)
+  {
+    const long y = startY + row;
+    sums.SetRow(y, features);
+
+    auto out = output->GetBufferPointer() + (y - buffered.GetIndex()[1]) * buffered.GetSize()[0] + (startX - buffered.GetIndex()[0]);
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      out[i] = static_cast<typename TOutputImage::PixelType>(-sums.GetSums(0, i)[0] / totalFrequency + logTotal);
+      progress.CompletedPixel();
+    }
+  }
+}
+
+} // end namespace otb
+
+#endif
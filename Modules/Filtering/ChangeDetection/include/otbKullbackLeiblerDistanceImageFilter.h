@@ -23,6 +23,7 @@
 #define otbKullbackLeiblerDistanceImageFilter_h
 
 #include "itkVariableLengthVector.h"
+#include "itkVector.h"
 #include "otbBinaryFunctorNeighborhoodImageFilter.h"
 
 namespace otb
@@ -40,6 +41,10 @@ class CumulantsForEdgeworth
 public:
   CumulantsForEdgeworth(const TInput& input);
   CumulantsForEdgeworth(const itk::Image<typename TInput::ImageType::PixelType, 1>* input);
+  /** Cumulants from the number of values and the sums of their powers 1
+   * to 4, the values being shifted by -offset. The offset only changes
+   * the mean, and keeps the sums small */
+  CumulantsForEdgeworth(const itk::Vector<double, 5>& sums, double offset);
   virtual ~CumulantsForEdgeworth()
   {
   }
@@ -74,6 +79,8 @@ protected:
   void MakeSumAndMoments(const TInput& input);
   /** Moment estimation from raw data */
   void MakeSumAndMoments(const itk::Image<typename TInput::ImageType::PixelType, 1>* input);
+  /** Moment estimation from power sums */
+  void MakeSumAndMoments(const itk::Vector<double, 5>& sums, double offset);
   /** transformation moment -> cumulants (for Edgeworth) */
   void MakeCumulants();
 
@@ -139,6 +146,12 @@ public:
  * The filter expect all images to have the same dimension
  * (e.g. all 2D, or all 3D, or all ND)
  *
+ * For 2D images of scalar pixels, the moments of each window are derived
+ * from the sums of the powers of its pixel values, which are updated from
+ * the previous window instead of being computed over the whole window
+ * for each pixel (see SlidingWindowSums). The values are shifted by the
+ * first pixel of each thread region so that the sums stay small.
+ *
  * See article of  Lin Saito et Levine
  * "Edgeworth Approximation of the Kullback-Leibler Distance Towards Problems in Image Analysis"
  * and
@@ -170,6 +183,8 @@ public:
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
 protected:
   KullbackLeiblerDistanceImageFilter()
   {
@@ -178,6 +193,9 @@ protected:
   {
   }
 
+  /** Sliding window computation of the distance */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 private:
   KullbackLeiblerDistanceImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -26,8 +26,10 @@
 #include <vector>
 
 #include "itkImageRegionConstIterator.h"
+#include "itkProgressReporter.h"
 
 #include "otbMacro.h"
+#include "otbSlidingWindowSums.h"
 
 namespace otb
 {
@@ -50,6 +52,13 @@ CumulantsForEdgeworth<TInput>::CumulantsForEdgeworth(const itk::Image<typename T
   MakeCumulants();
 }
 
+template <class TInput>
+CumulantsForEdgeworth<TInput>::CumulantsForEdgeworth(const itk::Vector<double, 5>& sums, double offset)
+{
+  MakeSumAndMoments(sums, offset);
+  MakeCumulants();
+}
+
 /* ========================== Divergence de KL ======================= */
 
 template <class TInput>
@@ -239,6 +248,41 @@ void CumulantsForEdgeworth<TInput>::MakeSumAndMoments(const itk::Image<typename
   // return 0;
 }
 
+/* ================== Moment estimation from power sums ============== */
+
+template <class TInput>
+void CumulantsForEdgeworth<TInput>::MakeSumAndMoments(const itk::Vector<double, 5>& sums, double offset)
+{
+  fSum0 = sums[0];
+  fSum1 = sums[1];
+  fSum2 = sums[2];
+  fSum3 = sums[3];
+  fSum4 = sums[4];
+
+  // Raw moments of the shifted values
+  double m1 = fSum1 / fSum0;
+  double m2 = fSum2 / fSum0;
+  double m3 = fSum3 / fSum0;
+  double m4 = fSum4 / fSum0;
+
+  fMu1 = m1 + offset;
+  fMu2 = m2 - m1 * m1;
+
+  if (fMu2 <= 0.0)
+  {
+    fMu3           = 0.0;
+    fMu4           = 4.0;
+    fDataAvailable = false;
+    return;
+  }
+
+  double m1_2 = m1 * m1;
+  fMu3        = (m3 - 3.0 * m1 * m2 + 2.0 * m1_2 * m1) / (fMu2 * sqrt(fMu2));
+  fMu4        = (m4 - 4.0 * m1 * m3 + 6.0 * m1_2 * m2 - 3.0 * m1_2 * m1_2) / (fMu2 * fMu2);
+
+  fDataAvailable = true;
+}
+
 /* ================= moments -> cumulants transformation ============= */
 
 template <class TInput>
@@ -254,6 +298,85 @@ void CumulantsForEdgeworth<TInput>::MakeCumulants()
   // return 0;
 }
 
+/* *******************************************************************
+ *  KullbackLeiblerDistanceImageFilter
+ *********************************************************************
+ */
+template <class TInputImage1, class TInputImage2, class TOutputImage>
+void KullbackLeiblerDistanceImageFilter<TInputImage1, TInputImage2, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                         itk::ThreadIdType            threadId)
+{
+  typedef CumulantsForEdgeworth<itk::ConstNeighborhoodIterator<TInputImage1>> CumulantsType1;
+  typedef CumulantsForEdgeworth<itk::ConstNeighborhoodIterator<TInputImage2>> CumulantsType2;
+  typedef SlidingWindowSums<8>                                                SumsType;
+
+  const NeumannPixelReader<TInputImage1> input1(dynamic_cast<const TInputImage1*>(this->itk::ProcessObject::GetInput(0)));
+  const NeumannPixelReader<TInputImage2> input2(dynamic_cast<const TInputImage2*>(this->itk::ProcessObject::GetInput(1)));
+  TOutputImage*                          output = this->GetOutput();
+
+  const long         startX = outputRegionForThread.GetIndex()[0];
+  const long         startY = outputRegionForThread.GetIndex()[1];
+  const unsigned int width  = outputRegionForThread.GetSize()[0];
+  const unsigned int height = outputRegionForThread.GetSize()[1];
+
+  const double offset1 = input1(startX, startY);
+  const double offset2 = input2(startX, startY);
+
+  // Powers 1 to 4 of the shifted values of both images
+  auto features = [&](long x, long y, double* values) {
+    const double a   = input1(x, y) - offset1;
+    const double b   = input2(x, y) - offset2;
+    const double a_2 = a * a;
+    const double b_2 = b * b;
+    values[0]        = a;
+    values[1]        = a_2;
+    values[2]        = a_2 * a;
+    values[3]        = a_2 * a_2;
+    values[4]        = b;
+    values[5]        = b_2;
+    values[6]        = b_2 * b;
+    values[7]        = b_2 * b_2;
+  };
+
+  SumsType     sums(std::vector<typename SumsType::RadiusType>(1, this->m_Radius), startX, width);
+  const double windowSize = sums.GetWindowSize(0);
+
+  const typename TOutputImage::RegionType& buffered = output->GetBufferedRegion();
+  itk::ProgressReporter                    progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  itk::Vector<double, 5> sums1, sums2;
+  sums1[0] = windowSize;
+  sums2[0] = windowSize;
+  for (unsigned int row = 0; row < height; ++row)
+  {
+    const long y = startY + row;
+    sums.SetRow(y, features);
+
+    auto out = output->GetBufferPointer() + (y - buffered.GetIndex()[1]) * buffered.GetSize()[0] + (startX - buffered.GetIndex()[0]);
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      const double* values = sums.GetSums(0, i);
+      for (unsigned int k = 0; k < 4; ++k)
+      {
+        sums1[k + 1] = values[k];
+        sums2[k + 1] = values[k + 4];
+      }
+
+      out[i] = static_cast<typename TOutputImage::PixelType>(0.);
+      CumulantsType1 cum1(sums1, offset1);
+      if (cum1.IsDataAvailable())
+      {
+        CumulantsType2 cum2(sums2, offset2);
+        if (cum2.IsDataAvailable())
+        {
+          out[i] = static_cast<typename TOutputImage::PixelType>(cum1.Divergence(cum2) + cum2.Divergence(cum1));
+        }
+      }
+      progress.CompletedPixel();
+    }
+  }
+}
+
 } // end of namespace otb
 
 #endif
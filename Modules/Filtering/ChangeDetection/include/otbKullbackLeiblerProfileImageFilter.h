@@ -27,6 +27,7 @@
 #include "itkArray.h"
 #include "itkArray2D.h"
 #include "itkVariableLengthVector.h"
+#include "itkVector.h"
 
 #include "otbBinaryFunctorNeighborhoodVectorImageFilter.h"
 
@@ -47,7 +48,13 @@ public:
   typedef std::vector<CumulantType> CumulantSet;
   typedef CumulantSet::iterator     Iterator;
 
+  /** Number of values and sums of their powers 1 to 4 */
+  typedef itk::Vector<double, 5> SumType;
+
   CumulantsForEdgeworthProfile(const TInput& input, std::vector<itk::Array2D<int>>& mask);
+  /** Cumulants from the number of values and the sums of their powers 1
+   * to 4 over the nested windows, from the smallest to the largest */
+  CumulantsForEdgeworthProfile(const std::vector<SumType>& sums);
   virtual ~CumulantsForEdgeworthProfile()
   {
   }
@@ -78,6 +85,8 @@ protected:
   int InitSumAndMoments(const TInput& input, itk::Array2D<int>& mask);
   //
   int ReInitSumAndMoments(const TInput& input, itk::Array2D<int>& mask, int level);
+  // momentum estimation from the power sums of the nested windows
+  int MakeSumAndMoments(const std::vector<SumType>& sums);
   // transformation moment -> cumulants (for Edgeworth)
   int MakeCumulants();
 
@@ -159,6 +168,11 @@ protected:
  *
  *  TOutput is expected to be a itk::VariableLengthVector< TPixel > and comes from an otbVectorImage< TPixel, 2 >
  *
+ * For 2D images of scalar pixels, the power sums of all the nested
+ * windows are computed in a single traversal from running sums, updated
+ * from the previous window instead of being computed over the whole
+ * window for each pixel (see SlidingWindowSums).
+ *
  * \ingroup IntensityImageFilters Multithreaded
  *
  * \ingroup OTBChangeDetection
@@ -184,6 +198,8 @@ public:
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
 
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
 protected:
   KullbackLeiblerProfileImageFilter()
   {
@@ -192,6 +208,9 @@ protected:
   {
   }
 
+  /** Sliding window computation of the profiles */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 private:
   KullbackLeiblerProfileImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -26,6 +26,8 @@
 
 #include "otbKullbackLeiblerProfileImageFilter.h"
 #include "otbMath.h"
+#include "otbSlidingWindowSums.h"
+#include "itkProgressReporter.h"
 
 namespace otb
 {
@@ -41,6 +43,13 @@ CumulantsForEdgeworthProfile<TInput>::CumulantsForEdgeworthProfile(const TInput&
   MakeCumulants();
 }
 
+template <class TInput>
+CumulantsForEdgeworthProfile<TInput>::CumulantsForEdgeworthProfile(const std::vector<SumType>& sums)
+{
+  m_debug = MakeSumAndMoments(sums);
+  MakeCumulants();
+}
+
 /* ===================== Kullback-Leibler Profile ==================== */
 
 template <class TInput>
@@ -290,6 +299,85 @@ int CumulantsForEdgeworthProfile<TInput>::ReInitSumAndMoments(const TInput& inpu
   return 0;
 }
 
+/* ======== Moments estimation from the nested windows sums ======= */
+
+template <class TInput>
+int CumulantsForEdgeworthProfile<TInput>::MakeSumAndMoments(const std::vector<SumType>& sums)
+{
+  fMu.resize(sums.size());
+
+  // Smallest window, as InitSumAndMoments()
+  fMu[0].Fill(0.0);
+  fSum0 = sums[0][0];
+  fSum1 = sums[0][1];
+  fSum2 = sums[0][2];
+  fSum3 = sums[0][3];
+  fSum4 = sums[0][4];
+  if (fSum0 == 0.0)
+  {
+    fDataAvailable = false;
+    return 1;
+  }
+
+  double mu1 = fSum1 / fSum0;
+  double mu2 = fSum2 / fSum0 - mu1 * mu1;
+
+  if (mu2 == 0.0)
+  {
+    fDataAvailable = false;
+    return 1;
+  }
+
+  double sigma = sqrt(mu2);
+  double mu1_2 = mu1 * mu1;
+  double mean2 = fSum2 / fSum0;
+  double mean3 = fSum3 / fSum0;
+  double mean4 = fSum4 / fSum0;
+  double mu3   = (mean3 - 3.0 * mu1 * mean2 + 2.0 * mu1_2 * mu1) / (mu2 * sigma);
+  double mu4   = (mean4 - 4.0 * mu1 * mean3 + 6.0 * mu1_2 * mean2 - 3.0 * mu1_2 * mu1_2) / (mu2 * mu2);
+
+  if (vnl_math_isnan(mu3) || vnl_math_isnan(mu4))
+  {
+    fDataAvailable = false;
+    return 1;
+  }
+
+  fMu[0][0] = mu1;
+  fMu[0][1] = mu2;
+  fMu[0][2] = mu3;
+  fMu[0][3] = mu4;
+
+  fDataAvailable = true;
+
+  // Larger windows, with the same formulas as ReInitSumAndMoments()
+  for (unsigned int level = 1; level < sums.size(); ++level)
+  {
+    fSum0 = sums[level][0];
+    fSum1 = sums[level][1];
+    fSum2 = sums[level][2];
+    fSum3 = sums[level][3];
+    fSum4 = sums[level][4];
+
+    double mu   = fSum1 / fSum0;
+    double mu_2 = mu * mu;
+    double mu_3 = mu_2 * mu;
+    double mu_4 = mu_2 * mu_2;
+
+    fMu[level][0] = mu;
+    fMu[level][1] = fSum2 / fSum0 - mu_2;
+
+    double sigma_l   = sqrt(fSum2);
+    double sigma_l_2 = fSum2;
+    double sigma_l_3 = sigma_l * sigma_l_2;
+    double sigma_l_4 = sigma_l_2 * sigma_l_2;
+
+    fMu[level][2] = (fSum3 - 3.0 * mu * fSum2 + 3.0 * mu_2 * fSum1 - fSum0 * mu_3) / (sigma_l_3 * fSum0);
+    fMu[level][3] = (fSum4 - 4.0 * mu * fSum3 + 6.0 * mu_2 * fSum2 - 4.0 * mu_3 * fSum1 + fSum0 * mu_4) / (sigma_l_4 * fSum0);
+  }
+
+  return 0;
+}
+
 /* =========== transformation moment -> cumulants ==================== */
 
 template <class TInput>
@@ -413,6 +501,116 @@ TOutput KullbackLeiblerProfile<TInput1, TInput2, TOutput>::operator()(const TInp
 
 } // Functor
 
+/* *******************************************************************
+*
+*  KullbackLeiblerProfileImageFilter
+*
+* ********************************************************************
+*/
+
+template <class TInputImage1, class TInputImage2, class TOutputImage>
+void KullbackLeiblerProfileImageFilter<TInputImage1, TInputImage2, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                        itk::ThreadIdType            threadId)
+{
+  typedef CumulantsForEdgeworthProfile<itk::ConstNeighborhoodIterator<TInputImage1>> CumulantsType1;
+  typedef CumulantsForEdgeworthProfile<itk::ConstNeighborhoodIterator<TInputImage2>> CumulantsType2;
+  typedef SlidingWindowSums<8>                                                       SumsType;
+  typedef typename TOutputImage::InternalPixelType                                   OutputValueType;
+
+  const NeumannPixelReader<TInputImage1> input1(dynamic_cast<const TInputImage1*>(this->itk::ProcessObject::GetInput(0)));
+  const NeumannPixelReader<TInputImage2> input2(dynamic_cast<const TInputImage2*>(this->itk::ProcessObject::GetInput(1)));
+  TOutputImage*                          output = this->GetOutput();
+
+  const long         startX = outputRegionForThread.GetIndex()[0];
+  const long         startY = outputRegionForThread.GetIndex()[1];
+  const unsigned int width  = outputRegionForThread.GetSize()[0];
+  const unsigned int height = outputRegionForThread.GetSize()[1];
+
+  // One level per radius of the profile, all computed in the same traversal
+  const unsigned int                         radiusMin = this->GetFunctor().GetRadiusMin();
+  const unsigned int                         radiusMax = this->GetFunctor().GetRadiusMax();
+  std::vector<typename SumsType::RadiusType> radii(radiusMax - radiusMin + 1);
+  for (unsigned int level = 0; level < radii.size(); ++level)
+  {
+    radii[level].Fill(radiusMin + level);
+  }
+  const unsigned int nbLevels     = radii.size();
+  const unsigned int nbComponents = output->GetNumberOfComponentsPerPixel();
+
+  // Powers 1 to 4 of the values of both images. They are not shifted, as
+  // the moments of the larger windows are not shift invariant
+  auto features = [&](long x, long y, double* values) {
+    const double a   = input1(x, y);
+    const double b   = input2(x, y);
+    const double a_2 = a * a;
+    const double b_2 = b * b;
+    values[0]        = a;
+    values[1]        = a_2;
+    values[2]        = a_2 * a;
+    values[3]        = a_2 * a_2;
+    values[4]        = b;
+    values[5]        = b_2;
+    values[6]        = b_2 * b;
+    values[7]        = b_2 * b_2;
+  };
+
+  SumsType sums(radii, startX, width);
+
+  std::vector<typename CumulantsType1::SumType> sums1(nbLevels), sums2(nbLevels);
+  for (unsigned int level = 0; level < nbLevels; ++level)
+  {
+    sums1[level][0] = sums.GetWindowSize(level);
+    sums2[level][0] = sums.GetWindowSize(level);
+  }
+
+  const typename TOutputImage::RegionType& buffered = output->GetBufferedRegion();
+  itk::ProgressReporter                    progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  for (unsigned int row = 0; row < height; ++row)
+  {
+    const long y = startY + row;
+    sums.SetRow(y, features);
+
+    OutputValueType* out =
+        output->GetBufferPointer() + ((y - buffered.GetIndex()[1]) * buffered.GetSize()[0] + (startX - buffered.GetIndex()[0])) * nbComponents;
+    for (unsigned int i = 0; i < width; ++i, out += nbComponents)
+    {
+      for (unsigned int level = 0; level < nbLevels; ++level)
+      {
+        const double* values = sums.GetSums(level, i);
+        for (unsigned int k = 0; k < 4; ++k)
+        {
+          sums1[level][k + 1] = values[k];
+          sums2[level][k + 1] = values[k + 4];
+        }
+      }
+
+      CumulantsType1 cum1(sums1);
+      if (cum1.m_debug)
+      {
+        std::fill(out, out + nbComponents, static_cast<OutputValueType>(1e3));
+        progress.CompletedPixel();
+        continue;
+      }
+
+      CumulantsType2 cum2(sums2);
+      if (cum2.m_debug)
+      {
+        std::fill(out, out + nbComponents, static_cast<OutputValueType>(1e3));
+        progress.CompletedPixel();
+        continue;
+      }
+
+      const itk::VariableLengthVector<double> profile = cum1.KL_profile(cum2) + cum2.KL_profile(cum1);
+      for (unsigned int level = 0; level < nbComponents; ++level)
+      {
+        out[level] = static_cast<OutputValueType>(profile[level]);
+      }
+      progress.CompletedPixel();
+    }
+  }
+}
+
 } // namespace otb
 
 #endif
@@ -49,6 +49,11 @@ namespace otb
  * The filter expect all images to have the same dimension
  * (e.g. all 2D, or all 3D, or all ND)
  *
+ * For 2D images of scalar pixels, the joint histogram of the window is
+ * updated from the previous window along each row, by removing the
+ * leaving column and adding the entering one, and the entropies are
+ * updated with the changed bins only.
+ *
  * \ingroup IntensityImageFilters Multithreaded
  *
  * \ingroup OTBChangeDetection
@@ -76,6 +81,8 @@ public:
   /** Macro defining the type*/
   itkTypeMacro(LHMIChangeDetector, SuperClass);
 
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
 protected:
   LHMIChangeDetector()
   {
@@ -84,6 +91,9 @@ protected:
   {
   }
 
+  /** Sliding window computation of the LHMI */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 private:
   LHMIChangeDetector(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -91,4 +101,8 @@ private:
 
 } // end namespace otb
 
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbLHMIChangeDetector.hxx"
+#endif
+
 #endif
@@ -0,0 +1,134 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLHMIChangeDetector_hxx
+#define otbLHMIChangeDetector_hxx
+
+#include "otbLHMIChangeDetector.h"
+#include "otbSlidingWindowSums.h"
+#include "itkProgressReporter.h"
+
+#include <cmath>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage1, class TInputImage2, class TOutputImage>
+void LHMIChangeDetector<TInputImage1, TInputImage2, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                         itk::ThreadIdType            threadId)
+{
+  const NeumannPixelReader<TInputImage1> input1(dynamic_cast<const TInputImage1*>(this->itk::ProcessObject::GetInput(0)));
+  const NeumannPixelReader<TInputImage2> input2(dynamic_cast<const TInputImage2*>(this->itk::ProcessObject::GetInput(1)));
+  TOutputImage*                          output = this->GetOutput();
+
+  const long         startX  = outputRegionForThread.GetIndex()[0];
+  const long         startY  = outputRegionForThread.GetIndex()[1];
+  const unsigned int width   = outputRegionForThread.GetSize()[0];
+  const unsigned int height  = outputRegionForThread.GetSize()[1];
+  const long         radiusX = this->m_Radius[0];
+  const long         radiusY = this->m_Radius[1];
+
+  // Functor::LHMI fills a 256 x 256 histogram using the pixel values as
+  // bin indices, the samples whose linear bin index falls outside the
+  // histogram being ignored. The same dense histogram is kept here, with
+  // its marginals and the sums of f log(f) over their bins
+  const long          nbBins     = 256;
+  const unsigned long windowSize = (2 * radiusX + 1) * (2 * radiusY + 1);
+
+  std::vector<long>   joint(nbBins * nbBins, 0);
+  std::vector<long>   marginal1(nbBins, 0);
+  std::vector<long>   marginal2(nbBins, 0);
+  std::vector<double> fLogF(windowSize + 1, 0.);
+  for (unsigned long f = 1; f <= windowSize; ++f)
+  {
+    fLogF[f] = f * std::log(static_cast<double>(f));
+  }
+
+  double sumJoint = 0., sum1 = 0., sum2 = 0.;
+  long   total    = 0;
+
+  auto change = [&](long& frequency, double& sum, long delta) {
+    sum -= fLogF[frequency];
+    frequency += delta;
+    sum += fLogF[frequency];
+  };
+  auto update = [&](long x, long y, long delta) {
+    const long bin = static_cast<long>(input1(x, y)) + nbBins * static_cast<long>(input2(x, y));
+    if (bin < 0 || bin >= nbBins * nbBins)
+    {
+      return;
+    }
+    change(joint[bin], sumJoint, delta);
+    change(marginal1[bin % nbBins], sum1, delta);
+    change(marginal2[bin / nbBins], sum2, delta);
+    total += delta;
+  };
+  auto updateColumn = [&](long x, long y, long delta) {
+    for (long dy = -radiusY; dy <= radiusY; ++dy)
+    {
+      update(x, y + dy, delta);
+    }
+  };
+
+  const typename TOutputImage::RegionType& buffered = output->GetBufferedRegion();
+  itk::ProgressReporter                    progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  for (unsigned int row = 0; row < height; ++row)
+  {
+    const long y   = startY + row;
+    auto       out = output->GetBufferPointer() + (y - buffered.GetIndex()[1]) * buffered.GetSize()[0] + (startX - buffered.GetIndex()[0]);
+
+    for (long dx = -radiusX; dx <= radiusX; ++dx)
+    {
+      updateColumn(startX + dx, y, 1);
+    }
+
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      const long x = startX + i;
+      if (i > 0)
+      {
+        updateColumn(x - 1 - radiusX, y, -1);
+        updateColumn(x + radiusX, y, 1);
+      }
+
+      const double logTotal     = std::log(static_cast<double>(total));
+      const double entropyX     = -sum1 / total + logTotal;
+      const double entropyY     = -sum2 / total + logTotal;
+      const double jointEntropy = -sumJoint / total + logTotal;
+
+      out[i] = static_cast<typename TOutputImage::PixelType>(jointEntropy / (entropyX + entropyY));
+      progress.CompletedPixel();
+    }
+
+    // Empty the histogram for the next row, the sums being reset to avoid
+    // accumulating rounding errors
+    for (long dx = -radiusX; dx <= radiusX; ++dx)
+    {
+      updateColumn(startX + width - 1 + dx, y, -1);
+    }
+    sumJoint = sum1 = sum2 = 0.;
+  }
+}
+
+} // end namespace otb
+
+#endif
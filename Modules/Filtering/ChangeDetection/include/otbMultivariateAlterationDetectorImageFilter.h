@@ -24,6 +24,8 @@
 
 #include "otbStreamingStatisticsVectorImageFilter.h"
 #include "otbConcatenateVectorImageFilter.h"
+#include "otbPersistentPixelSampleImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
 
 #include "vnl/vnl_vector.h"
 #include "vnl/vnl_matrix.h"
@@ -73,6 +75,26 @@ namespace otb
  * code, and the reference images for testing have been generated from
  * the Matlab code using Octave.
  *
+ * By default, the joint statistics of both images are computed on all
+ * the pixels. If NumberOfSamples is set, they are computed on a random
+ * sample of pixels gathered in a single streamed pass. The statistics can
+ * also be set with SetStatistics() (for instance those of a previous run,
+ * retrieved with GetMeanValues() and GetCovarianceMatrix()), in which case
+ * the input images are only read to produce the change maps.
+ *
+ * If NumberOfIterations is set, the iteratively reweighted MAD (IR-MAD)
+ * is computed, as described in:
+ *
+ * A. A. Nielsen, "The regularized iteratively reweighted MAD method for
+ * change detection in multi- and hyperspectral data," IEEE Trans. Image
+ * Process., vol. 16, no. 2, pp. 463-478, (2007)
+ *
+ * At each iteration, the statistics are weighted by the probability of no
+ * change of each pixel, given by the chi-square distribution of the sum of
+ * its squared standardized MAD variates. The iterations run on the pixel
+ * sample, which requires NumberOfSamples to be set, and stop when the
+ * canonical correlations change by less than ConvergenceThreshold.
+ *
  * \ingroup Streamed, Multithreaded
  *
  * \ingroup OTBChangeDetection
@@ -109,6 +131,8 @@ public:
   typedef typename CovarianceEstimatorType::Pointer            CovarianceEstimatorPointer;
   typedef otb::ConcatenateVectorImageFilter<InputImageType, InputImageType, InputImageType> ConcatenateImageFilterType;
   typedef typename ConcatenateImageFilterType::Pointer ConcatenateImageFilterPointer;
+  typedef PersistentPixelSampleImageFilter<InputImageType>          PixelSampleFilterType;
+  typedef PersistentFilterStreamingDecorator<PixelSampleFilterType> PixelSampleEstimatorType;
 
   typedef typename CovarianceEstimatorType::MatrixObjectType MatrixObjectType;
   typedef typename MatrixObjectType::ComponentType           MatrixType;
@@ -139,6 +163,30 @@ public:
   /** Get the correlation coefficient associated with each mad.*/
   itkGetMacro(Rho, VnlVectorType);
 
+  /** Get the mean of the bands of both images (image 1 first) */
+  itkGetConstReferenceMacro(MeanValues, VectorType);
+
+  /** Get the covariance matrix of the bands of both images (image 1 first) */
+  itkGetConstReferenceMacro(CovarianceMatrix, MatrixType);
+
+  /** Set the joint statistics instead of estimating them from the images */
+  void SetStatistics(const VectorType& meanValues, const MatrixType& covarianceMatrix);
+
+  /** Set/Get the number of pixels sampled to compute the statistics (0,
+   * the default, uses all the pixels) */
+  itkSetMacro(NumberOfSamples, unsigned int);
+  itkGetMacro(NumberOfSamples, unsigned int);
+
+  /** Set/Get the maximum number of IR-MAD iterations (0, the default,
+   * computes the MAD) */
+  itkSetMacro(NumberOfIterations, unsigned int);
+  itkGetMacro(NumberOfIterations, unsigned int);
+
+  /** Set/Get the largest change of the canonical correlations at which the
+   * IR-MAD iterations stop */
+  itkSetMacro(ConvergenceThreshold, double);
+  itkGetMacro(ConvergenceThreshold, double);
+
   /** Get the covariance estimator (for progress reporting purposes) */
   itkGetObjectMacro(CovarianceEstimator, CovarianceEstimatorType);
 
@@ -162,6 +210,18 @@ protected:
 
   void GenerateOutputInformation() override;
 
+  /** Estimate m_MeanValues and m_CovarianceMatrix on a pixel sample,
+   * with the IR-MAD reweighting if requested */
+  virtual void EstimateStatisticsFromSamples();
+
+  /** Compute the canonical transforms and correlations from the joint
+   * statistics */
+  virtual void ComputeCanonicalCorrelation();
+
+  /** Fold the means, the transforms and the output ordering of the change
+   * maps into m_Projection and m_Offset */
+  virtual void ComputeProjection();
+
 private:
   MultivariateAlterationDetectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -175,6 +235,15 @@ private:
   VnlVectorType m_Mean1;
   VnlVectorType m_Mean2;
   VnlVectorType m_Rho;
+
+  /** Change maps, as [x1 x2] * m_Projection + m_Offset */
+  VnlMatrixType m_Projection;
+  VnlVectorType m_Offset;
+
+  bool         m_UseInputStatistics;
+  unsigned int m_NumberOfSamples;
+  unsigned int m_NumberOfIterations;
+  double       m_ConvergenceThreshold;
 };
 
 } // end namespace otb
@@ -23,20 +23,37 @@
 
 #include "otbMultivariateAlterationDetectorImageFilter.h"
 #include "otbMath.h"
+#include "otbMacro.h"
 
 #include "vnl/algo/vnl_matrix_inverse.h"
 #include "vnl/algo/vnl_generalized_eigensystem.h"
 
-#include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkChiSquareDistribution.h"
 #include "itkProgressReporter.h"
 
+#include <algorithm>
+
 namespace otb
 {
 template <class TInputImage, class TOutputImage>
 MultivariateAlterationDetectorImageFilter<TInputImage, TOutputImage>::MultivariateAlterationDetectorImageFilter()
 {
   this->SetNumberOfRequiredInputs(2);
-  m_CovarianceEstimator = CovarianceEstimatorType::New();
+  m_CovarianceEstimator  = CovarianceEstimatorType::New();
+  m_UseInputStatistics   = false;
+  m_NumberOfSamples      = 0;
+  m_NumberOfIterations   = 0;
+  m_ConvergenceThreshold = 1e-3;
+}
+
+template <class TInputImage, class TOutputImage>
+void MultivariateAlterationDetectorImageFilter<TInputImage, TOutputImage>::SetStatistics(const VectorType& meanValues, const MatrixType& covarianceMatrix)
+{
+  m_MeanValues         = meanValues;
+  m_CovarianceMatrix   = covarianceMatrix;
+  m_UseInputStatistics = true;
+  this->Modified();
 }
 
 template <class TInputImage, class TOutputImage>
@@ -99,17 +116,45 @@ void MultivariateAlterationDetectorImageFilter<TInputImage, TOutputImage>::Gener
     itkExceptionMacro(<< "Input images does not have the same size!");
   }
 
-  // First concatenate both images
-  ConcatenateImageFilterPointer concatenateFilter = ConcatenateImageFilterType::New();
-  concatenateFilter->SetInput1(input1Ptr);
-  concatenateFilter->SetInput2(input2Ptr);
+  if (m_UseInputStatistics)
+  {
+    if (m_MeanValues.GetSize() != nbComp1 + nbComp2 || m_CovarianceMatrix.Rows() != nbComp1 + nbComp2 || m_CovarianceMatrix.Cols() != nbComp1 + nbComp2)
+    {
+      itkExceptionMacro(<< "Statistics of size " << m_MeanValues.GetSize() << " do not match the " << nbComp1 + nbComp2 << " bands of the input images");
+    }
+  }
+  else if (m_NumberOfSamples > 0)
+  {
+    EstimateStatisticsFromSamples();
+  }
+  else
+  {
+    if (m_NumberOfIterations > 0)
+    {
+      itkExceptionMacro(<< "IR-MAD iterations run on a pixel sample: NumberOfSamples must be set");
+    }
+
+    // First concatenate both images
+    ConcatenateImageFilterPointer concatenateFilter = ConcatenateImageFilterType::New();
+    concatenateFilter->SetInput1(input1Ptr);
+    concatenateFilter->SetInput2(input2Ptr);
 
-  // The compute covariance matrix
-  // TODO: implement switch off of this computation
-  m_CovarianceEstimator->SetInput(concatenateFilter->GetOutput());
-  m_CovarianceEstimator->Update();
-  m_CovarianceMatrix = m_CovarianceEstimator->GetCovariance();
-  m_MeanValues       = m_CovarianceEstimator->GetMean();
+    // The compute covariance matrix
+    m_CovarianceEstimator->SetInput(concatenateFilter->GetOutput());
+    m_CovarianceEstimator->Update();
+    m_CovarianceMatrix = m_CovarianceEstimator->GetCovariance();
+    m_MeanValues       = m_CovarianceEstimator->GetMean();
+  }
+
+  ComputeCanonicalCorrelation();
+  ComputeProjection();
+}
+
+template <class TInputImage, class TOutputImage>
+void MultivariateAlterationDetectorImageFilter<TInputImage, TOutputImage>::ComputeCanonicalCorrelation()
+{
+  const unsigned int nbComp1 = this->GetInput1()->GetNumberOfComponentsPerPixel();
+  const unsigned int nbComp2 = this->GetInput2()->GetNumberOfComponentsPerPixel();
 
   // Extract sub-matrices of the covariance matrix
   VnlMatrixType s11 = m_CovarianceMatrix.GetVnlMatrix().extract(nbComp1, nbComp1);
@@ -261,95 +306,207 @@ void MultivariateAlterationDetectorImageFilter<TInputImage, TOutputImage>::Gener
 }
 
 template <class TInputImage, class TOutputImage>
-void MultivariateAlterationDetectorImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
-                                                                                                itk::ThreadIdType threadId)
+void MultivariateAlterationDetectorImageFilter<TInputImage, TOutputImage>::ComputeProjection()
 {
-  // Retrieve input images pointers
-  const TInputImage* input1Ptr = this->GetInput1();
-  const TInputImage* input2Ptr = this->GetInput2();
-  TOutputImage*      outputPtr = this->GetOutput();
+  const unsigned int nbComp1   = m_V1.rows();
+  const unsigned int nbComp2   = m_V2.rows();
+  const unsigned int outNbComp = std::max(nbComp1, nbComp2);
+
+  // mad = (x1 - m1) * V1 - (x2 - m2) * V2, the columns of V1 or V2 beyond
+  // the number of bands of the image being zero. With different numbers of
+  // bands, the change maps are reversed and those without correlated
+  // counterpart are scaled by sqrt(2).
+  m_Projection.set_size(nbComp1 + nbComp2, outNbComp);
+  m_Projection.fill(0);
+  for (unsigned int i = 0; i < outNbComp; ++i)
+  {
+    unsigned int madIndex = i;
+    RealType     scale    = 1.;
+    if (nbComp1 != nbComp2)
+    {
+      madIndex = outNbComp - i - 1;
+      if (i < outNbComp - std::min(nbComp1, nbComp2))
+      {
+        scale = std::sqrt(2.);
+      }
+    }
 
+    if (madIndex < nbComp1)
+    {
+      for (unsigned int b = 0; b < nbComp1; ++b)
+      {
+        m_Projection(b, i) = scale * m_V1(b, madIndex);
+      }
+    }
+    if (madIndex < nbComp2)
+    {
+      for (unsigned int b = 0; b < nbComp2; ++b)
+      {
+        m_Projection(nbComp1 + b, i) = -scale * m_V2(b, madIndex);
+      }
+    }
+  }
 
-  typedef itk::ImageRegionConstIterator<InputImageType> ConstIteratorType;
-  typedef itk::ImageRegionIterator<OutputImageType>     IteratorType;
+  VnlVectorType mean(nbComp1 + nbComp2);
+  mean.update(m_Mean1, 0);
+  mean.update(m_Mean2, nbComp1);
+  m_Offset = -(mean * m_Projection);
+}
 
-  IteratorType      outIt(outputPtr, outputRegionForThread);
-  ConstIteratorType inIt1(input1Ptr, outputRegionForThread);
-  ConstIteratorType inIt2(input2Ptr, outputRegionForThread);
+template <class TInputImage, class TOutputImage>
+void MultivariateAlterationDetectorImageFilter<TInputImage, TOutputImage>::EstimateStatisticsFromSamples()
+{
+  const unsigned int nbComp1   = this->GetInput1()->GetNumberOfComponentsPerPixel();
+  const unsigned int nbComp2   = this->GetInput2()->GetNumberOfComponentsPerPixel();
+  const unsigned int nbBands   = nbComp1 + nbComp2;
+  const unsigned int outNbComp = std::max(nbComp1, nbComp2);
 
-  inIt1.GoToBegin();
-  inIt2.GoToBegin();
-  outIt.GoToBegin();
+  // Gather the sample of the concatenated images
+  ConcatenateImageFilterPointer concatenateFilter = ConcatenateImageFilterType::New();
+  concatenateFilter->SetInput1(this->GetInput1());
+  concatenateFilter->SetInput2(this->GetInput2());
 
-  // Get the number of components for each image
-  unsigned int nbComp1   = input1Ptr->GetNumberOfComponentsPerPixel();
-  unsigned int nbComp2   = input2Ptr->GetNumberOfComponentsPerPixel();
-  unsigned int outNbComp = outputPtr->GetNumberOfComponentsPerPixel();
+  typename PixelSampleEstimatorType::Pointer sampler = PixelSampleEstimatorType::New();
+  sampler->SetInput(concatenateFilter->GetOutput());
+  sampler->GetFilter()->SetInitialAccumulator(typename PixelSampleFilterType::AccumulatorType(m_NumberOfSamples));
+  sampler->Update();
 
+  const auto         samples   = sampler->GetFilter()->GetResult().GetSamples();
+  const unsigned int nbSamples = samples.size();
+  if (nbSamples < 2)
+  {
+    itkExceptionMacro(<< "At least 2 pixels are needed to compute the statistics, " << nbSamples << " could be sampled");
+  }
 
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+  VnlMatrixType X(nbSamples, nbBands);
+  for (unsigned int k = 0; k < nbSamples; ++k)
+  {
+    for (unsigned int b = 0; b < nbBands; ++b)
+    {
+      X(k, b) = static_cast<RealType>(samples[k][b]);
+    }
+  }
+
+  // Probability of no change of each sample
+  VnlVectorType weights(nbSamples, 1.);
+  VnlVectorType previousRho;
 
-  while (!inIt1.IsAtEnd() && !inIt2.IsAtEnd() && !outIt.IsAtEnd())
+  for (unsigned int iteration = 0;; ++iteration)
   {
-    VnlVectorType x1(nbComp1, 0);
-    VnlVectorType x1bis(outNbComp, 0);
-    VnlVectorType x2(nbComp2, 0);
-    VnlVectorType x2bis(outNbComp, 0);
-    VnlVectorType mad(outNbComp, 0);
+    // Weighted statistics, unbiased when all the weights are 1
+    const RealType sumOfWeights = weights.sum();
+    VnlVectorType  mean         = (weights * X) / sumOfWeights;
 
-    for (unsigned int i = 0; i < nbComp1; ++i)
+    VnlMatrixType centered = X;
+    for (unsigned int k = 0; k < nbSamples; ++k)
     {
-      x1[i] = inIt1.Get()[i];
+      centered.set_row(k, centered.get_row(k) - mean);
     }
-
-    for (unsigned int i = 0; i < nbComp2; ++i)
+    VnlMatrixType weighted = centered;
+    for (unsigned int k = 0; k < nbSamples; ++k)
     {
-      x2[i] = inIt2.Get()[i];
+      weighted.scale_row(k, weights[k]);
     }
+    VnlMatrixType covariance = centered.transpose() * weighted;
+    covariance /= sumOfWeights * (nbSamples - 1) / nbSamples;
 
-    VnlVectorType first  = (x1 - m_Mean1) * m_V1;
-    VnlVectorType second = (x2 - m_Mean2) * m_V2;
-
-    for (unsigned int i = 0; i < nbComp1; ++i)
+    m_MeanValues.SetSize(nbBands);
+    for (unsigned int b = 0; b < nbBands; ++b)
     {
-      x1bis[i] = first[i];
+      m_MeanValues[b] = mean[b];
     }
+    m_CovarianceMatrix = covariance;
 
-    for (unsigned int i = 0; i < nbComp2; ++i)
+    if (iteration == m_NumberOfIterations)
     {
-      x2bis[i] = second[i];
+      break;
     }
 
-    mad = x1bis - x2bis;
+    ComputeCanonicalCorrelation();
+    if (iteration > 0 && (m_Rho - previousRho).inf_norm() < m_ConvergenceThreshold)
+    {
+      otbMsgDevMacro(<< "IR-MAD converged after " << iteration << " iterations");
+      break;
+    }
+    previousRho = m_Rho;
+    ComputeProjection();
 
-    typename OutputImageType::PixelType outPixel(outNbComp);
+    // Standardized change maps
+    VnlMatrixType mad = X * m_Projection;
+    VnlVectorType variance(outNbComp);
+    for (unsigned int i = 0; i < outNbComp; ++i)
+    {
+      const VnlVectorType column = m_Projection.get_column(i);
+      variance[i]                = dot_product(column, covariance * column);
+    }
 
-    if (nbComp1 == nbComp2)
+    for (unsigned int k = 0; k < nbSamples; ++k)
     {
+      RealType chiSquare = 0;
       for (unsigned int i = 0; i < outNbComp; ++i)
       {
-        outPixel[i] = mad[i];
+        const RealType value = mad(k, i) + m_Offset[i];
+        chiSquare += value * value / variance[i];
       }
+      weights[k] = 1. - itk::Statistics::ChiSquareDistribution::CDF(chiSquare, outNbComp);
     }
-    else
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void MultivariateAlterationDetectorImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                itk::ThreadIdType threadId)
+{
+  // Retrieve input images pointers
+  const TInputImage* input1Ptr = this->GetInput1();
+  const TInputImage* input2Ptr = this->GetInput2();
+  TOutputImage*      outputPtr = this->GetOutput();
+
+  typedef itk::ImageScanlineConstIterator<InputImageType> ConstIteratorType;
+  typedef itk::ImageScanlineIterator<OutputImageType>     IteratorType;
+
+  IteratorType      outIt(outputPtr, outputRegionForThread);
+  ConstIteratorType inIt1(input1Ptr, outputRegionForThread);
+  ConstIteratorType inIt2(input2Ptr, outputRegionForThread);
+
+  // Get the number of components for each image
+  const unsigned int nbComp1   = input1Ptr->GetNumberOfComponentsPerPixel();
+  const unsigned int nbComp2   = input2Ptr->GetNumberOfComponentsPerPixel();
+  const unsigned int outNbComp = outputPtr->GetNumberOfComponentsPerPixel();
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  // Each line is projected with a single matrix product
+  VnlMatrixType                       line(outputRegionForThread.GetSize(0), nbComp1 + nbComp2);
+  typename OutputImageType::PixelType outPixel(outNbComp);
+
+  for (inIt1.GoToBegin(), inIt2.GoToBegin(), outIt.GoToBegin(); !inIt1.IsAtEnd(); inIt1.NextLine(), inIt2.NextLine(), outIt.NextLine())
+  {
+    for (unsigned int x = 0; !inIt1.IsAtEndOfLine(); ++inIt1, ++inIt2, ++x)
     {
-      for (unsigned int i = 0; i < outNbComp; ++i)
+      const InputImagePixelType& pixel1 = inIt1.Get();
+      const InputImagePixelType& pixel2 = inIt2.Get();
+      for (unsigned int i = 0; i < nbComp1; ++i)
       {
-        outPixel[i] = mad[outNbComp - i - 1];
-
-        if (i < outNbComp - std::min(nbComp1, nbComp2))
-        {
-          outPixel[i] *= std::sqrt(2.);
-        }
+        line(x, i) = pixel1[i];
+      }
+      for (unsigned int i = 0; i < nbComp2; ++i)
+      {
+        line(x, nbComp1 + i) = pixel2[i];
       }
     }
 
-    outIt.Set(outPixel);
+    const VnlMatrixType mad = line * m_Projection;
 
-    ++inIt1;
-    ++inIt2;
-    ++outIt;
-    progress.CompletedPixel();
+    for (unsigned int x = 0; !outIt.IsAtEndOfLine(); ++outIt, ++x)
+    {
+      for (unsigned int i = 0; i < outNbComp; ++i)
+      {
+        outPixel[i] = static_cast<typename OutputImageType::InternalPixelType>(mad(x, i) + m_Offset[i]);
+      }
+      outIt.Set(outPixel);
+      progress.CompletedPixel();
+    }
   }
 }
 }
@@ -0,0 +1,251 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSlidingWindowSums_h
+#define otbSlidingWindowSums_h
+
+#include "itkSize.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+/** \class SlidingWindowSums
+ * \brief Sums of per-pixel features over the sliding windows of a row of pixels
+ *
+ * This helper of the neighborhood change detectors computes, for each
+ * pixel of a row, the sums of VNumberOfFeatures values over the windows
+ * of one or several radii centred on it, for instance the sums of the
+ * powers of the pixel values from which local moments are derived.
+ *
+ * The features of each input row are computed once, by a callable
+ * features(x, y, values) writing the VNumberOfFeatures values of the
+ * pixel (x, y), and kept in a rolling buffer. The features callable is
+ * given the unclamped window coordinates, and is expected to clamp them
+ * to the buffered region for a zero flux Neumann boundary condition.
+ * When the rows are processed in sequence, the sums of each column over
+ * the window rows are updated by adding the entering row and removing the
+ * leaving one, and the window sums are updated along the row by adding
+ * the entering column and removing the leaving one. The cost per pixel
+ * therefore does not depend on the window size.
+ *
+ * Like any running sum, the sums of floating point features may drift
+ * slightly from a direct summation along the rows of a region. They are
+ * exact for integer features, such as the powers of integer pixel values,
+ * as long as they stay below 2^53.
+ *
+ * \ingroup OTBChangeDetection
+ */
+template <unsigned int VNumberOfFeatures>
+class SlidingWindowSums
+{
+public:
+  typedef itk::Size<2> RadiusType;
+
+  /** Windows of the given radii, for the pixels startX to startX + width - 1 of a row */
+  SlidingWindowSums(const std::vector<RadiusType>& radii, long startX, unsigned int width)
+    : m_Radii(radii), m_StartX(startX), m_Width(width), m_MaxRadiusX(0), m_MaxRadiusY(0), m_FirstRow(0), m_CurrentRow(0), m_Initialized(false)
+  {
+    for (const RadiusType& radius : m_Radii)
+    {
+      m_MaxRadiusX = std::max(m_MaxRadiusX, static_cast<long>(radius[0]));
+      m_MaxRadiusY = std::max(m_MaxRadiusY, static_cast<long>(radius[1]));
+    }
+    m_NumberOfColumns = m_Width + 2 * m_MaxRadiusX;
+    m_NumberOfSlots   = 2 * m_MaxRadiusY + 2;
+
+    m_RowFeatures.resize(m_NumberOfSlots * m_NumberOfColumns * VNumberOfFeatures);
+    m_ColumnSums.assign(m_Radii.size(), std::vector<double>(m_NumberOfColumns * VNumberOfFeatures));
+    m_WindowSums.assign(m_Radii.size(), std::vector<double>(m_Width * VNumberOfFeatures));
+  }
+
+  /** Number of pixels in the windows of the given level */
+  unsigned long GetWindowSize(unsigned int level) const
+  {
+    return (2 * m_Radii[level][0] + 1) * (2 * m_Radii[level][1] + 1);
+  }
+
+  /** Compute the window sums of the given row. The column sums are
+   * updated when it follows the row of the previous call, and computed
+   * again otherwise */
+  template <class TFeatureFunction>
+  void SetRow(long y, TFeatureFunction& features)
+  {
+    if (!m_Initialized || y != m_CurrentRow + 1)
+    {
+      m_FirstRow = y - m_MaxRadiusY;
+      for (long row = y - m_MaxRadiusY; row <= y + m_MaxRadiusY; ++row)
+      {
+        ComputeRow(row, features);
+      }
+      for (unsigned int level = 0; level < m_Radii.size(); ++level)
+      {
+        const long           radiusY = m_Radii[level][1];
+        std::vector<double>& sums    = m_ColumnSums[level];
+        std::fill(sums.begin(), sums.end(), 0.);
+        for (long row = y - radiusY; row <= y + radiusY; ++row)
+        {
+          const double* values = GetRowFeatures(row);
+          for (unsigned int i = 0; i < sums.size(); ++i)
+          {
+            sums[i] += values[i];
+          }
+        }
+      }
+      m_Initialized = true;
+    }
+    else
+    {
+      // The slot of the new row held the row leaving the largest window
+      // at the previous step, which is not needed anymore
+      ComputeRow(y + m_MaxRadiusY, features);
+      for (unsigned int level = 0; level < m_Radii.size(); ++level)
+      {
+        const long           radiusY  = m_Radii[level][1];
+        const double*        entering = GetRowFeatures(y + radiusY);
+        const double*        leaving  = GetRowFeatures(y - 1 - radiusY);
+        std::vector<double>& sums     = m_ColumnSums[level];
+        for (unsigned int i = 0; i < sums.size(); ++i)
+        {
+          sums[i] += entering[i] - leaving[i];
+        }
+      }
+    }
+    m_CurrentRow = y;
+
+    for (unsigned int level = 0; level < m_Radii.size(); ++level)
+    {
+      const long    radiusX = m_Radii[level][0];
+      const double* columns = &m_ColumnSums[level][0];
+      double*       out     = &m_WindowSums[level][0];
+
+      double sums[VNumberOfFeatures];
+      std::fill(sums, sums + VNumberOfFeatures, 0.);
+      for (long j = m_MaxRadiusX - radiusX; j <= m_MaxRadiusX + radiusX; ++j)
+      {
+        for (unsigned int k = 0; k < VNumberOfFeatures; ++k)
+        {
+          sums[k] += columns[j * VNumberOfFeatures + k];
+        }
+      }
+      std::copy(sums, sums + VNumberOfFeatures, out);
+
+      for (unsigned int i = 1; i < m_Width; ++i)
+      {
+        const double* entering = columns + (m_MaxRadiusX + radiusX + i) * VNumberOfFeatures;
+        const double* leaving  = columns + (m_MaxRadiusX - radiusX + i - 1) * VNumberOfFeatures;
+        for (unsigned int k = 0; k < VNumberOfFeatures; ++k)
+        {
+          sums[k] += entering[k] - leaving[k];
+        }
+        std::copy(sums, sums + VNumberOfFeatures, out + i * VNumberOfFeatures);
+      }
+    }
+  }
+
+  /** Sums of the features over the window of the given level centred on
+   * the i-th pixel of the current row */
+  const double* GetSums(unsigned int level, unsigned int i) const
+  {
+    return &m_WindowSums[level][i * VNumberOfFeatures];
+  }
+
+private:
+  double* GetRowFeatures(long row)
+  {
+    return &m_RowFeatures[((row - m_FirstRow) % m_NumberOfSlots) * m_NumberOfColumns * VNumberOfFeatures];
+  }
+
+  template <class TFeatureFunction>
+  void ComputeRow(long row, TFeatureFunction& features)
+  {
+    double* values = GetRowFeatures(row);
+    for (long j = 0; j < m_NumberOfColumns; ++j)
+    {
+      features(m_StartX - m_MaxRadiusX + j, row, values + j * VNumberOfFeatures);
+    }
+  }
+
+  std::vector<RadiusType> m_Radii;
+  long                    m_StartX;
+  unsigned int            m_Width;
+  long                    m_MaxRadiusX;
+  long                    m_MaxRadiusY;
+  long                    m_NumberOfColumns;
+  long                    m_NumberOfSlots;
+
+  /** Rolling buffer of the features of the rows of the largest window,
+   * plus the row leaving it */
+  std::vector<double> m_RowFeatures;
+  long                m_FirstRow;
+
+  /** Sums of the features of each column over the window rows, and over
+   * the windows, for each radius */
+  std::vector<std::vector<double>> m_ColumnSums;
+  std::vector<std::vector<double>> m_WindowSums;
+
+  long m_CurrentRow;
+  bool m_Initialized;
+};
+
+/** \class NeumannPixelReader
+ * \brief Read the pixels of a scalar image as double, with a zero flux Neumann boundary condition
+ *
+ * The coordinates are clamped to the buffered region of the image, as
+ * itk::ZeroFluxNeumannBoundaryCondition does for the neighborhood
+ * iterators.
+ *
+ * \ingroup OTBChangeDetection
+ */
+template <class TImage>
+class NeumannPixelReader
+{
+public:
+  explicit NeumannPixelReader(const TImage* image)
+    : m_Buffer(image->GetBufferPointer()),
+      m_Stride(image->GetBufferedRegion().GetSize()[0]),
+      m_FirstX(image->GetBufferedRegion().GetIndex()[0]),
+      m_FirstY(image->GetBufferedRegion().GetIndex()[1]),
+      m_LastX(m_FirstX + static_cast<long>(image->GetBufferedRegion().GetSize()[0]) - 1),
+      m_LastY(m_FirstY + static_cast<long>(image->GetBufferedRegion().GetSize()[1]) - 1)
+  {
+  }
+
+  double operator()(long x, long y) const
+  {
+    x = std::min(std::max(x, m_FirstX), m_LastX);
+    y = std::min(std::max(y, m_FirstY), m_LastY);
+    return static_cast<double>(m_Buffer[(y - m_FirstY) * m_Stride + (x - m_FirstX)]);
+  }
+
+private:
+  const typename TImage::InternalPixelType* m_Buffer;
+  long                                      m_Stride;
+  long                                      m_FirstX;
+  long                                      m_FirstY;
+  long                                      m_LastX;
+  long                                      m_LastY;
+};
+
+} // end namespace otb
+
+#endif
@@ -32,4 +32,5 @@ void RegisterTests()
   REGISTER_TEST(otbKullbackLeiblerDistanceImageFilter);
   REGISTER_TEST(otbMeanRatioChangeDetectionTest);
   REGISTER_TEST(otbLHMIChangeDetectionTest);
+  REGISTER_TEST(otbSlidingWindowChangeDetectors);
 }
@@ -30,7 +30,7 @@ typedef otb::ImageFileWriter<OutputImageType> WriterType;
 typedef otb::MultivariateAlterationDetectorImageFilter<ImageType, OutputImageType> MADFilterType;
 
 
-int otbMultivariateAlterationDetectorImageFilter(int itkNotUsed(argc), char* argv[])
+int otbMultivariateAlterationDetectorImageFilter(int argc, char* argv[])
 {
   char* infname1 = argv[1];
   char* infname2 = argv[2];
@@ -45,6 +45,14 @@ int otbMultivariateAlterationDetectorImageFilter(int itkNotUsed(argc), char* arg
   MADFilterType::Pointer madFilter = MADFilterType::New();
   madFilter->SetInput1(reader1->GetOutput());
   madFilter->SetInput2(reader2->GetOutput());
+  if (argc > 4)
+  {
+    madFilter->SetNumberOfSamples(atoi(argv[4]));
+  }
+  if (argc > 5)
+  {
+    madFilter->SetNumberOfIterations(atoi(argv[5]));
+  }
 
   WriterType::Pointer writer = WriterType::New();
   writer->SetInput(madFilter->GetOutput());
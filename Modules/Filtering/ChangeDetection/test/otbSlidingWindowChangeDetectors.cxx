@@ -0,0 +1,125 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbCBAMIChangeDetector.h"
+#include "otbLHMIChangeDetector.h"
+#include "otbJoinHistogramMIImageFilter.h"
+#include "otbKullbackLeiblerDistanceImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+#include <cmath>
+#include <iostream>
+
+typedef otb::Image<double, 2> ImageType;
+
+namespace
+{
+
+ImageType::Pointer CreateImage(unsigned int seed)
+{
+  ImageType::Pointer    image = ImageType::New();
+  ImageType::RegionType region;
+  region.SetSize(0, 37);
+  region.SetSize(1, 29);
+  image->SetRegions(region);
+  image->Allocate();
+
+  for (unsigned int y = 0; y < region.GetSize(1); ++y)
+  {
+    for (unsigned int x = 0; x < region.GetSize(0); ++x)
+    {
+      ImageType::IndexType index = {{x, y}};
+      image->SetPixel(index, (x * x * seed + 7 * y * y + 13 * x * y + seed) % 201);
+    }
+  }
+  return image;
+}
+
+// Compare the sliding window implementation of a filter with the
+// neighborhood iterator implementation of its base class
+template <class TFilter, class TReference, class TRadius>
+bool Compare(const char* name, ImageType* image1, ImageType* image2, TRadius radius, double tolerance)
+{
+  typename TFilter::Pointer filter = TFilter::New();
+  filter->SetInput1(image1);
+  filter->SetInput2(image2);
+  filter->SetRadius(radius);
+  filter->Update();
+
+  typename TReference::Pointer reference = TReference::New();
+  reference->SetInput1(image1);
+  reference->SetInput2(image2);
+  reference->SetRadius(radius);
+  reference->Update();
+
+  itk::ImageRegionConstIterator<ImageType> it(filter->GetOutput(), filter->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType> refIt(reference->GetOutput(), reference->GetOutput()->GetLargestPossibleRegion());
+  for (; !it.IsAtEnd(); ++it, ++refIt)
+  {
+    if (std::abs(it.Get() - refIt.Get()) > tolerance * std::max(1., std::abs(refIt.Get())))
+    {
+      std::cerr << name << ": " << it.Get() << " instead of " << refIt.Get() << " at " << it.GetIndex() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+} // end anonymous namespace
+
+int otbSlidingWindowChangeDetectors(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef itk::ConstNeighborhoodIterator<ImageType> NeighborhoodIteratorType;
+
+  typedef otb::CBAMIChangeDetector<ImageType, ImageType, ImageType> CBAMIType;
+  typedef otb::BinaryFunctorNeighborhoodImageFilter<ImageType, ImageType, ImageType,
+                                                    otb::Functor::CBAMI<NeighborhoodIteratorType, NeighborhoodIteratorType, double>>
+      CBAMIReferenceType;
+
+  typedef otb::LHMIChangeDetector<ImageType, ImageType, ImageType> LHMIType;
+  typedef otb::BinaryFunctorNeighborhoodImageFilter<ImageType, ImageType, ImageType,
+                                                    otb::Functor::LHMI<NeighborhoodIteratorType, NeighborhoodIteratorType, double>>
+      LHMIReferenceType;
+
+  typedef otb::JoinHistogramMIImageFilter<ImageType, ImageType, ImageType> JHMIType;
+  typedef otb::BinaryFunctorNeighborhoodJoinHistogramImageFilter<ImageType, ImageType, ImageType,
+                                                                 otb::Functor::JoinHistogramMI<NeighborhoodIteratorType, NeighborhoodIteratorType, double>>
+      JHMIReferenceType;
+
+  typedef otb::KullbackLeiblerDistanceImageFilter<ImageType, ImageType, ImageType> KLType;
+  typedef otb::BinaryFunctorNeighborhoodImageFilter<ImageType, ImageType, ImageType,
+                                                    otb::Functor::KullbackLeiblerDistance<NeighborhoodIteratorType, NeighborhoodIteratorType, double>>
+      KLReferenceType;
+
+  ImageType::Pointer image1 = CreateImage(3);
+  ImageType::Pointer image2 = CreateImage(5);
+
+  bool ok = true;
+  for (unsigned int radius = 1; radius <= 3; ++radius)
+  {
+    ok = Compare<CBAMIType, CBAMIReferenceType>("CBAMI", image1, image2, radius, 1e-9) && ok;
+    ok = Compare<LHMIType, LHMIReferenceType>("LHMI", image1, image2, radius, 1e-9) && ok;
+    ok = Compare<JHMIType, JHMIReferenceType>("JHMI", image1, image2, static_cast<unsigned char>(radius), 1e-9) && ok;
+    ok = Compare<KLType, KLReferenceType>("KullbackLeiblerDistance", image1, image2, radius, 1e-6) && ok;
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
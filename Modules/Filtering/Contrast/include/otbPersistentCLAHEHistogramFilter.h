@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPersistentCLAHEHistogramFilter_h
+#define otbPersistentCLAHEHistogramFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentCLAHEHistogramFilter
+ *  \brief Compute the local histograms and gain look-up tables of the CLAHE algorithm.
+ *
+ *  This filter accumulates the histograms of the thumbnails of the image
+ *  over the streamed regions, with the binning, the nodata handling and the
+ *  contrast limitation of ComputeHistoFilter. Synthetize() equalizes them with
+ *  ComputeGainLutFilter and stores the look-up tables of all the thumbnails in
+ *  one array, the one of the thumbnail (x, y) starting at
+ *  (y * number of thumbnails along x + x) * NbBin.
+ *
+ * \sa ComputeHistoFilter
+ * \sa ComputeGainLutFilter
+ * \sa StreamingCLAHEImageFilter
+ *
+ * \ingroup OTBContrast
+ */
+template <class TInputImage>
+class ITK_EXPORT PersistentCLAHEHistogramFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** typedef for standard classes. */
+  typedef PersistentCLAHEHistogramFilter Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef TInputImage                                InputImageType;
+  typedef typename InputImageType::InternalPixelType InputPixelType;
+  typedef typename InputImageType::RegionType        RegionType;
+  typedef typename InputImageType::SizeType          SizeType;
+  typedef typename InputImageType::IndexType         IndexType;
+  typedef std::vector<double>                        LutArrayType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(PersistentCLAHEHistogramFilter, PersistentImageFilter);
+
+  /** Get/Set macro to get/set the number of bin. Default value is 256 */
+  itkSetMacro(NbBin, unsigned int);
+  itkGetMacro(NbBin, unsigned int);
+
+  /** Get/Set macro to get/set the minimum value */
+  itkSetMacro(Min, InputPixelType);
+  itkGetMacro(Min, InputPixelType);
+
+  /** Get/Set macro to get/set the maximum value */
+  itkSetMacro(Max, InputPixelType);
+  itkGetMacro(Max, InputPixelType);
+
+  /** Get/Set macro to get/set the nodata value */
+  itkSetMacro(NoData, InputPixelType);
+  itkGetMacro(NoData, InputPixelType);
+
+  /** Get/Set macro to get/set the nodata flag value */
+  itkBooleanMacro(NoDataFlag);
+  itkGetMacro(NoDataFlag, bool);
+  itkSetMacro(NoDataFlag, bool);
+
+  /** Get/Set macro to get/set the thumbnail's size */
+  itkSetMacro(ThumbSize, SizeType);
+  itkGetMacro(ThumbSize, SizeType);
+
+  /** Get/Set macro to get/set the threshold parameter */
+  itkSetMacro(Threshold, float);
+  itkGetMacro(Threshold, float);
+
+  /** Number of thumbnails along each dimension */
+  itkGetConstReferenceMacro(NumberOfThumbs, SizeType);
+
+  /** Look-up tables of the thumbnails, filled by Synthetize() */
+  const LutArrayType& GetLut() const
+  {
+    return m_Lut;
+  }
+
+  void Reset(void) override;
+
+  void Synthetize(void) override;
+
+protected:
+  PersistentCLAHEHistogramFilter();
+  ~PersistentCLAHEHistogramFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  void GenerateOutputInformation() override;
+
+  /** The output is not used, nothing is allocated */
+  void AllocateOutputs() override
+  {
+  }
+
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void AfterThreadedGenerateData() override;
+
+private:
+  PersistentCLAHEHistogramFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  InputPixelType m_Min;
+  InputPixelType m_Max;
+  InputPixelType m_NoData;
+  SizeType       m_ThumbSize;
+  bool           m_NoDataFlag;
+  float          m_Threshold;
+  unsigned int   m_NbBin;
+  double         m_Step;
+  SizeType       m_NumberOfThumbs;
+
+  /** Histograms of all the thumbnails */
+  std::vector<unsigned int> m_Histograms;
+  /** Histograms of the thumbnails of the requested region, per thread */
+  std::vector<std::vector<unsigned int>> m_ThreadHistograms;
+  /** First thumbnail and number of thumbnails of the requested region */
+  IndexType    m_RegionFirstThumb;
+  SizeType     m_RegionNumberOfThumbs;
+  LutArrayType m_Lut;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbPersistentCLAHEHistogramFilter.hxx"
+#endif
+
+#endif
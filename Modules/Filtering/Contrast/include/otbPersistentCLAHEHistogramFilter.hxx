@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPersistentCLAHEHistogramFilter_hxx
+#define otbPersistentCLAHEHistogramFilter_hxx
+
+#include "otbPersistentCLAHEHistogramFilter.h"
+#include "otbComputeGainLutFilter.h"
+#include "otbVectorImage.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+template <class TInputImage>
+PersistentCLAHEHistogramFilter<TInputImage>::PersistentCLAHEHistogramFilter()
+{
+  m_Min        = std::numeric_limits<InputPixelType>::quiet_NaN();
+  m_Max        = std::numeric_limits<InputPixelType>::quiet_NaN();
+  m_NoData     = std::numeric_limits<InputPixelType>::quiet_NaN();
+  m_NoDataFlag = false;
+  m_NbBin      = 256;
+  m_Threshold  = -1;
+  m_Step       = -1;
+  m_ThumbSize.Fill(0);
+  m_NumberOfThumbs.Fill(0);
+  m_RegionFirstThumb.Fill(0);
+  m_RegionNumberOfThumbs.Fill(0);
+}
+
+template <class TInputImage>
+void PersistentCLAHEHistogramFilter<TInputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentCLAHEHistogramFilter<TInputImage>::Reset()
+{
+  if (m_ThumbSize[0] == 0 || m_ThumbSize[1] == 0)
+  {
+    itkExceptionMacro(<< "Thumbnail size " << m_ThumbSize << " is not valid");
+  }
+  if (!(m_Max > m_Min) || m_NbBin < 2)
+  {
+    itkExceptionMacro(<< "Invalid histogram bounds [" << m_Min << ", " << m_Max << "] for " << m_NbBin << " bins");
+  }
+
+  SizeType size = this->GetInput()->GetLargestPossibleRegion().GetSize();
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    m_NumberOfThumbs[dim] = (size[dim] + m_ThumbSize[dim] - 1) / m_ThumbSize[dim];
+  }
+  m_Histograms.assign(m_NumberOfThumbs[0] * m_NumberOfThumbs[1] * m_NbBin, 0);
+  m_Lut.clear();
+
+  m_Step = static_cast<double>(m_Max - m_Min) / static_cast<double>(m_NbBin - 1);
+}
+
+template <class TInputImage>
+void PersistentCLAHEHistogramFilter<TInputImage>::BeforeThreadedGenerateData()
+{
+  const RegionType region       = this->GetOutput()->GetRequestedRegion();
+  const IndexType  largestIndex = this->GetInput()->GetLargestPossibleRegion().GetIndex();
+
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    const unsigned long first = (region.GetIndex()[dim] - largestIndex[dim]) / m_ThumbSize[dim];
+    const unsigned long last  = (region.GetIndex()[dim] + region.GetSize()[dim] - 1 - largestIndex[dim]) / m_ThumbSize[dim];
+    m_RegionFirstThumb[dim]     = first;
+    m_RegionNumberOfThumbs[dim] = last - first + 1;
+  }
+
+  m_ThreadHistograms.assign(this->GetNumberOfThreads(), std::vector<unsigned int>(m_RegionNumberOfThumbs[0] * m_RegionNumberOfThumbs[1] * m_NbBin, 0));
+}
+
+template <class TInputImage>
+void PersistentCLAHEHistogramFilter<TInputImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  const InputImageType* input        = this->GetInput();
+  const IndexType       largestIndex = input->GetLargestPossibleRegion().GetIndex();
+  unsigned int*         histograms   = m_ThreadHistograms[threadId].data();
+
+  itk::ImageScanlineConstIterator<InputImageType> it(input, outputRegionForThread);
+  for (it.GoToBegin(); !it.IsAtEnd(); it.NextLine())
+  {
+    // Histogram of the thumbnail of the first pixel of the line, and number
+    // of pixels of the line left in this thumbnail
+    const IndexType     index = it.GetIndex();
+    const unsigned long x     = index[0] - largestIndex[0];
+    const unsigned long y     = index[1] - largestIndex[1];
+    unsigned int*       histo =
+        histograms + ((y / m_ThumbSize[1] - m_RegionFirstThumb[1]) * m_RegionNumberOfThumbs[0] + x / m_ThumbSize[0] - m_RegionFirstThumb[0]) * m_NbBin;
+    unsigned long left = m_ThumbSize[0] - x % m_ThumbSize[0];
+
+    for (; !it.IsAtEndOfLine(); ++it)
+    {
+      const InputPixelType currentPixel = it.Get();
+      if (!(currentPixel == m_NoData && m_NoDataFlag) && currentPixel <= m_Max && currentPixel >= m_Min)
+      {
+        ++histo[static_cast<unsigned int>(std::round((currentPixel - m_Min) / m_Step))];
+      }
+      if (--left == 0)
+      {
+        histo += m_NbBin;
+        left = m_ThumbSize[0];
+      }
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentCLAHEHistogramFilter<TInputImage>::AfterThreadedGenerateData()
+{
+  for (unsigned long y = 0; y < m_RegionNumberOfThumbs[1]; ++y)
+  {
+    for (unsigned long x = 0; x < m_RegionNumberOfThumbs[0]; ++x)
+    {
+      unsigned int*       histo  = &m_Histograms[((m_RegionFirstThumb[1] + y) * m_NumberOfThumbs[0] + m_RegionFirstThumb[0] + x) * m_NbBin];
+      const unsigned long offset = (y * m_RegionNumberOfThumbs[0] + x) * m_NbBin;
+      for (const auto& threadHistograms : m_ThreadHistograms)
+      {
+        for (unsigned int i = 0; i < m_NbBin; ++i)
+        {
+          histo[i] += threadHistograms[offset + i];
+        }
+      }
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentCLAHEHistogramFilter<TInputImage>::Synthetize()
+{
+  typedef otb::VectorImage<unsigned int, 2>                 HistogramType;
+  typedef otb::VectorImage<double, 2>                       LutType;
+  typedef otb::ComputeGainLutFilter<HistogramType, LutType> GainLutFilterType;
+
+  m_ThreadHistograms.clear();
+
+  typename HistogramType::RegionType region;
+  region.SetSize(m_NumberOfThumbs);
+  typename HistogramType::Pointer histoImage = HistogramType::New();
+  histoImage->SetNumberOfComponentsPerPixel(m_NbBin);
+  histoImage->SetRegions(region);
+  histoImage->Allocate();
+
+  // Contrast limitation as in ComputeHistoFilter: the bins are clipped and
+  // the clipped population is spread over the histogram
+  typename HistogramType::PixelType       histo(m_NbBin);
+  itk::ImageRegionIterator<HistogramType> hit(histoImage, region);
+  const unsigned int*                     thumbHisto = m_Histograms.data();
+  for (hit.GoToBegin(); !hit.IsAtEnd(); ++hit, thumbHisto += m_NbBin)
+  {
+    unsigned int total(0);
+    for (unsigned int i = 0; i < m_NbBin; i++)
+    {
+      histo[i] = thumbHisto[i];
+      total += thumbHisto[i];
+    }
+    if (m_Threshold > 0)
+    {
+      unsigned int rest(0);
+      unsigned int height(static_cast<unsigned int>(m_Threshold * (total / m_NbBin)));
+      for (unsigned int i = 0; i < m_NbBin; i++)
+      {
+        if (histo[i] > height)
+        {
+          rest += histo[i] - height;
+          histo[i] = height;
+        }
+      }
+      height = rest / m_NbBin;
+      rest   = rest % m_NbBin;
+      for (unsigned int i = 0; i < m_NbBin; i++)
+      {
+        histo[i] += height;
+        if (i > (m_NbBin - rest) / 2 && i <= (m_NbBin - rest) / 2 + rest)
+        {
+          ++histo[i];
+        }
+      }
+    }
+    hit.Set(histo);
+  }
+
+  typename GainLutFilterType::Pointer gainLutFilter = GainLutFilterType::New();
+  gainLutFilter->SetInput(histoImage);
+  gainLutFilter->SetMin(m_Min);
+  gainLutFilter->SetMax(m_Max);
+  gainLutFilter->SetNbPixel(m_ThumbSize[0] * m_ThumbSize[1]);
+  gainLutFilter->SetNumberOfThreads(this->GetNumberOfThreads());
+  gainLutFilter->Update();
+
+  m_Lut.resize(m_Histograms.size());
+  double*                                lut = m_Lut.data();
+  itk::ImageRegionConstIterator<LutType> lit(gainLutFilter->GetOutput(), region);
+  for (lit.GoToBegin(); !lit.IsAtEnd(); ++lit, lut += m_NbBin)
+  {
+    const typename LutType::PixelType& thumbLut = lit.Get();
+    for (unsigned int i = 0; i < m_NbBin; i++)
+    {
+      lut[i] = thumbLut[i];
+    }
+  }
+  m_Histograms.clear();
+}
+
+template <class TInputImage>
+void PersistentCLAHEHistogramFilter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Minimum : " << m_Min << std::endl;
+  os << indent << "Maximum : " << m_Max << std::endl;
+  os << indent << "Bin Number : " << m_NbBin << std::endl;
+  os << indent << "Thumbnail size : " << m_ThumbSize << std::endl;
+  os << indent << "Threshold value : " << m_Threshold << std::endl;
+  os << indent << "Is no data activated : " << m_NoDataFlag << std::endl;
+  os << indent << "No Data : " << m_NoData << std::endl;
+}
+
+} // End namespace otb
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingCLAHEImageFilter_h
+#define otbStreamingCLAHEImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbPersistentCLAHEHistogramFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+
+namespace otb
+{
+
+/** \class StreamingCLAHEImageFilter
+ *  \brief Implement the CLAHE algorithm in two streamed passes
+ *
+ *  This filter gives the result of CLHistogramEqualizationFilter without
+ *  intermediate histogram and look-up table images. When the output
+ *  information is generated, the input is streamed once through a
+ *  PersistentCLAHEHistogramFilter that computes the look-up tables of all
+ *  the thumbnails. The output can then be streamed: each region applies
+ *  the gains interpolated between the look-up tables of the four nearest
+ *  thumbnails, with the weights of ApplyGainFilter computed once per row
+ *  and per column.
+ *
+ * \sa CLHistogramEqualizationFilter
+ * \sa PersistentCLAHEHistogramFilter
+ *
+ * \ingroup OTBContrast
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT StreamingCLAHEImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** typedef for standard classes. */
+  typedef StreamingCLAHEImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef TInputImage                                                       InputImageType;
+  typedef TOutputImage                                                      OutputImageType;
+  typedef typename InputImageType::InternalPixelType                        InputPixelType;
+  typedef typename InputImageType::SizeType                                 SizeType;
+  typedef typename OutputImageType::InternalPixelType                       OutputPixelType;
+  typedef typename OutputImageType::RegionType                              OutputImageRegionType;
+  typedef PersistentCLAHEHistogramFilter<InputImageType>                    PersistentHistogramFilterType;
+  typedef PersistentFilterStreamingDecorator<PersistentHistogramFilterType> HistogramFilterType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(StreamingCLAHEImageFilter, ImageToImageFilter);
+
+  itkSetMacro(NbBin, unsigned int);
+  itkGetMacro(NbBin, unsigned int);
+
+  itkSetMacro(Min, InputPixelType);
+  itkGetMacro(Min, InputPixelType);
+
+  itkSetMacro(Max, InputPixelType);
+  itkGetMacro(Max, InputPixelType);
+
+  itkSetMacro(NoData, InputPixelType);
+  itkGetMacro(NoData, InputPixelType);
+
+  itkBooleanMacro(NoDataFlag);
+  itkGetMacro(NoDataFlag, bool);
+  itkSetMacro(NoDataFlag, bool);
+
+  itkSetMacro(ThumbSize, SizeType);
+  itkGetMacro(ThumbSize, SizeType);
+
+  itkSetMacro(Threshold, float);
+  itkGetMacro(Threshold, float);
+
+  /** The streamed histogram pass, to follow its progress */
+  HistogramFilterType* GetHistogramFilter()
+  {
+    return m_HistogramFilter;
+  }
+
+protected:
+  StreamingCLAHEImageFilter();
+  ~StreamingCLAHEImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Compute the look-up tables */
+  void GenerateOutputInformation() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  StreamingCLAHEImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Interpolation along one dimension: the two nearest thumbnails and
+   * their weights, a thumbnail outside the image having no weight */
+  struct NeighborsType
+  {
+    long   first;
+    double weights[2];
+    bool   valid[2];
+  };
+
+  void ComputeNeighbors(unsigned long size, unsigned long thumbSize, unsigned long nbThumbs, std::vector<NeighborsType>& neighbors) const;
+
+  InputPixelType m_Min;
+  InputPixelType m_Max;
+  InputPixelType m_NoData;
+  SizeType       m_ThumbSize;
+  bool           m_NoDataFlag;
+  float          m_Threshold;
+  unsigned int   m_NbBin;
+  double         m_Step;
+
+  typename HistogramFilterType::Pointer m_HistogramFilter;
+  std::vector<NeighborsType>            m_ColumnNeighbors;
+  std::vector<NeighborsType>            m_RowNeighbors;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingCLAHEImageFilter.hxx"
+#endif
+
+#endif
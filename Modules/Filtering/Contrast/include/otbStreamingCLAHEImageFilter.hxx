@@ -0,0 +1,161 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingCLAHEImageFilter_hxx
+#define otbStreamingCLAHEImageFilter_hxx
+
+#include "otbStreamingCLAHEImageFilter.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkImageScanlineIterator.h"
+
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+StreamingCLAHEImageFilter<TInputImage, TOutputImage>::StreamingCLAHEImageFilter() : m_HistogramFilter(HistogramFilterType::New())
+{
+  m_Min        = std::numeric_limits<InputPixelType>::quiet_NaN();
+  m_Max        = std::numeric_limits<InputPixelType>::quiet_NaN();
+  m_NoData     = std::numeric_limits<InputPixelType>::quiet_NaN();
+  m_NoDataFlag = false;
+  m_NbBin      = 256;
+  m_Threshold  = -1;
+  m_Step       = -1;
+  m_ThumbSize.Fill(0);
+}
+
+template <class TInputImage, class TOutputImage>
+void StreamingCLAHEImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  PersistentHistogramFilterType* histoFilter = m_HistogramFilter->GetFilter();
+  histoFilter->SetInput(this->GetInput());
+  histoFilter->SetMin(m_Min);
+  histoFilter->SetMax(m_Max);
+  histoFilter->SetNbBin(m_NbBin);
+  histoFilter->SetThumbSize(m_ThumbSize);
+  histoFilter->SetThreshold(m_Threshold);
+  histoFilter->SetNoData(m_NoData);
+  histoFilter->SetNoDataFlag(m_NoDataFlag);
+  histoFilter->SetNumberOfThreads(this->GetNumberOfThreads());
+  m_HistogramFilter->Update();
+
+  m_Step = static_cast<double>(m_Max - m_Min) / static_cast<double>(m_NbBin - 1);
+
+  const SizeType size = this->GetInput()->GetLargestPossibleRegion().GetSize();
+  ComputeNeighbors(size[0], m_ThumbSize[0], histoFilter->GetNumberOfThumbs()[0], m_ColumnNeighbors);
+  ComputeNeighbors(size[1], m_ThumbSize[1], histoFilter->GetNumberOfThumbs()[1], m_RowNeighbors);
+}
+
+template <class TInputImage, class TOutputImage>
+void StreamingCLAHEImageFilter<TInputImage, TOutputImage>::ComputeNeighbors(unsigned long size, unsigned long thumbSize, unsigned long nbThumbs,
+                                                                            std::vector<NeighborsType>& neighbors) const
+{
+  // The thumbnail centers are at (thumb + 0.5) * thumbSize - 0.5 pixels
+  neighbors.resize(size);
+  for (unsigned long i = 0; i < size; ++i)
+  {
+    const double position = (i + 0.5) / thumbSize - 0.5;
+    neighbors[i].first    = static_cast<long>(std::floor(position));
+    for (unsigned int k = 0; k < 2; ++k)
+    {
+      const long thumb        = neighbors[i].first + k;
+      neighbors[i].valid[k]   = thumb >= 0 && thumb < static_cast<long>(nbThumbs);
+      neighbors[i].weights[k] = 1 - std::abs(position - thumb);
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void StreamingCLAHEImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                itk::ThreadIdType itkNotUsed(threadId))
+{
+  const InputImageType*                    input        = this->GetInput();
+  OutputImageType*                         output       = this->GetOutput();
+  const typename InputImageType::IndexType largestIndex = input->GetLargestPossibleRegion().GetIndex();
+  const double*                            lut          = m_HistogramFilter->GetFilter()->GetLut().data();
+  const long                               nbThumbsX    = m_HistogramFilter->GetFilter()->GetNumberOfThumbs()[0];
+
+  itk::ImageScanlineConstIterator<InputImageType> it(input, outputRegionForThread);
+  itk::ImageScanlineIterator<OutputImageType>     oit(output, outputRegionForThread);
+
+  for (it.GoToBegin(), oit.GoToBegin(); !it.IsAtEnd(); it.NextLine(), oit.NextLine())
+  {
+    const NeighborsType& row = m_RowNeighbors[it.GetIndex()[1] - largestIndex[1]];
+    const NeighborsType* col = &m_ColumnNeighbors[it.GetIndex()[0] - largestIndex[0]];
+
+    for (; !it.IsAtEndOfLine(); ++it, ++oit, ++col)
+    {
+      const InputPixelType currentPixel = it.Get();
+      double               newValue     = static_cast<double>(currentPixel);
+      if (!(currentPixel == m_NoData && m_NoDataFlag) && currentPixel <= m_Max && currentPixel >= m_Min)
+      {
+        const unsigned int pixelLutValue = static_cast<unsigned int>(std::round((currentPixel - m_Min) / m_Step));
+
+        // Same accumulation order and precision as ApplyGainFilter
+        float gain(0.f), w(0.f), wtm(0.f);
+        for (unsigned int j = 0; j < 2; ++j)
+        {
+          if (!row.valid[j])
+            continue;
+          for (unsigned int i = 0; i < 2; ++i)
+          {
+            if (!col->valid[i])
+              continue;
+            const double value = lut[((row.first + j) * nbThumbsX + col->first + i) * m_NbBin + pixelLutValue];
+            if (value == -1)
+              continue;
+            wtm = col->weights[i] * row.weights[j];
+            gain += value * wtm;
+            w += wtm;
+          }
+        }
+        if (w == 0)
+        {
+          w    = 1;
+          gain = 1;
+        }
+        newValue *= gain / w;
+      }
+      oit.Set(static_cast<OutputPixelType>(newValue));
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void StreamingCLAHEImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Minimum : " << m_Min << std::endl;
+  os << indent << "Maximum : " << m_Max << std::endl;
+  os << indent << "Bin Number : " << m_NbBin << std::endl;
+  os << indent << "Thumbnail size : " << m_ThumbSize << std::endl;
+  os << indent << "Threshold value : " << m_Threshold << std::endl;
+  os << indent << "Is no data activated : " << m_NoDataFlag << std::endl;
+  os << indent << "No Data : " << m_NoData << std::endl;
+}
+
+} // End namespace otb
+
+#endif
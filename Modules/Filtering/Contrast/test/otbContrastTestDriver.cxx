@@ -26,5 +26,6 @@ void RegisterTests()
   REGISTER_TEST(otbComputeGainLutFilter);
   REGISTER_TEST(otbApplyGainFilter);
   REGISTER_TEST(otbCLHistogramEqualizationFilter);
+  REGISTER_TEST(otbStreamingCLAHEImageFilter);
   REGISTER_TEST(otbHelperCLAHE);
 }
@@ -26,6 +26,8 @@
 #include "itkNumericTraits.h"
 #include "itkArray.h"
 #include "itkZeroFluxNeumannBoundaryCondition.h"
+#include <memory>
+#include <string>
 
 namespace otb
 {
@@ -39,26 +41,35 @@ namespace otb
  * product in the Fourrier domain. This result in tremendous speed gain when using large kernel
  * with exactly the same result as the classical convolution filter.
  *
- * \note This filter could be threaded but requires additional design due to limited thread-safety
- * of the FFTW library.
+ * Each thread convolves its own block. The FFTW plans and the transform of the kernel are
+ * cached by block size, so that they are shared by the threads and reused across the streaming
+ * divisions, the bands of a VectorImage processed through PerBandVectorImageFilter, or a bank of
+ * kernels of the same size (only the kernel transform is recomputed when the filter changes).
+ * Plans can be made persistent across runs with SetWisdomFileName().
+ *
+ * The precision of the transforms is given by TFFTPrecision (double by default, float requires
+ * ITK to be built with ITK_USE_FFTWF).
+ *
+ * When AutomaticDomainSelection is on, blocks for which the kernel is small compared to the cost
+ * of the transforms are convolved in the spatial domain instead, with the same boundary condition.
  *
  * \note For the moment only constant zero boundary conditions are used in this filter. This could produce
  *  very different results from the classical convolution filter with zero flux neumann boundary condition,
  * especially with large kernels.
  *
- * \note ITK must be set to use FFTW (double implementation) for this filter to work properly. If not, exception
- *  will be raised at filter creation.
+ * \note ITK must be set to use FFTW (double or float implementation, matching TFFTPrecision) for this
+ *  filter to work properly. If not, exception will be raised at filter creation.
  *  Install fftw and set the cmake variable ITK_USE_FFTWD to ON.
  *
  * \sa ConvolutionImageFilter
  *
- * \ingroup ShouldBeThreaded
+ * \ingroup Threaded
  * \ingroup Streamed
  * \ingroup IntensityImageFilters
  *
  * \ingroup OTBConvolution
  */
-template <class TInputImage, class TOutputImage, class TBoundaryCondition = itk::ZeroFluxNeumannBoundaryCondition<TInputImage>>
+template <class TInputImage, class TOutputImage, class TBoundaryCondition = itk::ZeroFluxNeumannBoundaryCondition<TInputImage>, class TFFTPrecision = double>
 class ITK_EXPORT OverlapSaveConvolutionImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
 {
 public:
@@ -91,6 +102,7 @@ public:
   typedef typename InputImageType::SizeType                     InputSizeType;
   typedef typename itk::Array<InputRealType>                    ArrayType;
   typedef TBoundaryCondition                                    BoundaryConditionType;
+  typedef TFFTPrecision                                         FFTPrecisionType;
 
   /** Set the radius of the neighborhood used to compute the mean. */
   virtual void SetRadius(const InputSizeType rad)
@@ -134,6 +146,17 @@ public:
   itkGetMacro(NormalizeFilter, bool);
   itkBooleanMacro(NormalizeFilter);
 
+  /** Set/Get the FFTW wisdom file. When set, the wisdom is read from this file
+   * before planning, and written back when new plans have been created. */
+  itkSetStringMacro(WisdomFileName);
+  itkGetStringMacro(WisdomFileName);
+
+  /** Set/Get the automatic choice between spatial and FFT convolution for
+   * each block, based on the kernel size (off by default) */
+  itkSetMacro(AutomaticDomainSelection, bool);
+  itkGetMacro(AutomaticDomainSelection, bool);
+  itkBooleanMacro(AutomaticDomainSelection);
+
   /** Since this filter implements a neighborhood operation, it requests a largest input
    * region than the output region.
    */
@@ -149,16 +172,15 @@ protected:
   /** Constructor */
   OverlapSaveConvolutionImageFilter();
   /** destructor */
-  ~OverlapSaveConvolutionImageFilter() override
-  {
-  }
+  ~OverlapSaveConvolutionImageFilter() override;
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
-  /* TODO For the moment this class provide only a GenerateData(),
-   * due to limited thread-safety of FFTW plan creation.
-   */
-  void GenerateData() override;
-  // void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId);
+  void BeforeThreadedGenerateData() override;
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+  void AfterThreadedGenerateData() override;
+
+  /** Whether the block is cheaper to convolve in the spatial domain */
+  bool UseSpatialDomain(const OutputImageRegionType& region) const;
 
 private:
   OverlapSaveConvolutionImageFilter(const Self&) = delete;
@@ -172,6 +194,19 @@ private:
 
   /** Flag for filter normalization */
   bool m_NormalizeFilter;
+
+  /** Normalization factor of the current filter */
+  double m_Norm;
+
+  /** FFTW wisdom file */
+  std::string m_WisdomFileName;
+
+  /** Flag for the automatic domain selection */
+  bool m_AutomaticDomainSelection;
+
+  /** FFTW plans and kernel transforms, by block size */
+  struct FFTPlanCache;
+  std::unique_ptr<FFTPlanCache> m_PlanCache;
 };
 } // end namespace otb
 
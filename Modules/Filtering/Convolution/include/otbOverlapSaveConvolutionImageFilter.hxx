@@ -25,25 +25,212 @@
 
 #include "otbOverlapSaveConvolutionImageFilter.h"
 
-#include "itkConstNeighborhoodIterator.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkImageRegionIteratorWithIndex.h"
-#include "itkNeighborhoodAlgorithm.h"
-#include "itkOffset.h"
 #include "itkProgressReporter.h"
 
-// debug
-#include "itkImageRegionIterator.h"
 #include "otbMath.h"
 
-#ifdef ITK_USE_FFTWD
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <map>
+#include <mutex>
+#include <utility>
+
+#if defined ITK_USE_FFTWD || defined ITK_USE_FFTWF
 #include "itkFFTWCommon.h"
+#define OTB_OVERLAP_SAVE_USE_FFTW
 #endif
 
 namespace otb
 {
 
-template <class TInputImage, class TOutputImage, class TBoundaryCondition>
-OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition>::OverlapSaveConvolutionImageFilter()
+#ifdef OTB_OVERLAP_SAVE_USE_FFTW
+namespace internal
+{
+/** FFTW functions which are not wrapped by itk::fftw::Proxy */
+template <class TPrecision>
+struct OverlapSaveFFTWFunctions;
+
+#ifdef ITK_USE_FFTWD
+template <>
+struct OverlapSaveFFTWFunctions<double>
+{
+  typedef itk::fftw::Proxy<double> ProxyType;
+
+  static void ExecuteForward(ProxyType::PlanType plan, ProxyType::PixelType* in, ProxyType::ComplexType* out)
+  {
+    fftw_execute_dft_r2c(plan, in, out);
+  }
+  static void ExecuteBackward(ProxyType::PlanType plan, ProxyType::ComplexType* in, ProxyType::PixelType* out)
+  {
+    fftw_execute_dft_c2r(plan, in, out);
+  }
+  static void* Malloc(std::size_t size)
+  {
+    return fftw_malloc(size);
+  }
+  static void Free(void* ptr)
+  {
+    fftw_free(ptr);
+  }
+  static bool ImportWisdom(const char* filename)
+  {
+    return fftw_import_wisdom_from_filename(filename) != 0;
+  }
+  static bool ExportWisdom(const char* filename)
+  {
+    return fftw_export_wisdom_to_filename(filename) != 0;
+  }
+};
+#endif
+
+#ifdef ITK_USE_FFTWF
+template <>
+struct OverlapSaveFFTWFunctions<float>
+{
+  typedef itk::fftw::Proxy<float> ProxyType;
+
+  static void ExecuteForward(ProxyType::PlanType plan, ProxyType::PixelType* in, ProxyType::ComplexType* out)
+  {
+    fftwf_execute_dft_r2c(plan, in, out);
+  }
+  static void ExecuteBackward(ProxyType::PlanType plan, ProxyType::ComplexType* in, ProxyType::PixelType* out)
+  {
+    fftwf_execute_dft_c2r(plan, in, out);
+  }
+  static void* Malloc(std::size_t size)
+  {
+    return fftwf_malloc(size);
+  }
+  static void Free(void* ptr)
+  {
+    fftwf_free(ptr);
+  }
+  static bool ImportWisdom(const char* filename)
+  {
+    return fftwf_import_wisdom_from_filename(filename) != 0;
+  }
+  static bool ExportWisdom(const char* filename)
+  {
+    return fftwf_export_wisdom_to_filename(filename) != 0;
+  }
+};
+#endif
+} // end namespace internal
+#endif
+
+template <class TInputImage, class TOutputImage, class TBoundaryCondition, class TFFTPrecision>
+struct OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition, TFFTPrecision>::FFTPlanCache
+{
+#ifdef OTB_OVERLAP_SAVE_USE_FFTW
+  typedef internal::OverlapSaveFFTWFunctions<TFFTPrecision> FunctionsType;
+  typedef typename FunctionsType::ProxyType                 ProxyType;
+  typedef typename ProxyType::PixelType                     PixelType;
+  typedef typename ProxyType::ComplexType                   ComplexType;
+  typedef typename ProxyType::PlanType                      PlanType;
+
+  /** Plans and kernel transform for one block size */
+  struct Block
+  {
+    PlanType     forwardPlan;
+    PlanType     backwardPlan;
+    ComplexType* filterFFT;
+  };
+
+  typedef std::pair<itk::SizeValueType, itk::SizeValueType> KeyType;
+
+  FFTPlanCache() : newPlans(false)
+  {
+    radius.Fill(0);
+  }
+
+  ~FFTPlanCache()
+  {
+    for (auto& block : blocks)
+    {
+      ProxyType::DestroyPlan(block.second.forwardPlan);
+      ProxyType::DestroyPlan(block.second.backwardPlan);
+      FunctionsType::Free(block.second.filterFFT);
+    }
+  }
+
+  /** Drop the kernel transforms if the kernel changed, keeping the plans */
+  void SetFilter(const ArrayType& newFilter, const InputSizeType& newRadius)
+  {
+    if (newRadius == radius && newFilter.Size() == filter.Size() && newFilter == filter)
+    {
+      return;
+    }
+    for (auto& block : blocks)
+    {
+      FunctionsType::Free(block.second.filterFFT);
+      block.second.filterFFT = nullptr;
+    }
+    filter = newFilter;
+    radius = newRadius;
+  }
+
+  /** Get the plans and the kernel transform for a block, creating them if needed */
+  const Block& GetBlock(const InputSizeType& pieceSize)
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+
+    const unsigned int pieceNbOfPixel = pieceSize[0] * pieceSize[1];
+    const unsigned int sizeFFT        = (pieceSize[0] / 2 + 1) * pieceSize[1];
+
+    const KeyType key(pieceSize[0], pieceSize[1]);
+    auto          it = blocks.find(key);
+    if (it != blocks.end() && it->second.filterFFT)
+    {
+      return it->second;
+    }
+
+    PixelType*   piece    = static_cast<PixelType*>(FunctionsType::Malloc(pieceNbOfPixel * sizeof(PixelType)));
+    ComplexType* pieceFFT = static_cast<ComplexType*>(FunctionsType::Malloc(sizeFFT * sizeof(ComplexType)));
+
+    if (it == blocks.end())
+    {
+      // Planning overwrites the buffers, so it is done before filling them
+      Block block;
+      block.forwardPlan  = ProxyType::Plan_dft_r2c_2d(pieceSize[1], pieceSize[0], piece, pieceFFT, FFTW_MEASURE);
+      block.backwardPlan = ProxyType::Plan_dft_c2r_2d(pieceSize[1], pieceSize[0], pieceFFT, piece, FFTW_MEASURE);
+      block.filterFFT    = nullptr;
+      it                 = blocks.insert(std::make_pair(key, block)).first;
+      newPlans           = true;
+    }
+
+    // Resampled filter FFT
+    memset(piece, 0, pieceNbOfPixel * sizeof(PixelType));
+    unsigned int k = 0;
+    for (unsigned int j = 0; j < 2 * radius[1] + 1; ++j)
+    {
+      for (unsigned int i = 0; i < 2 * radius[0] + 1; ++i)
+      {
+        piece[i + j * pieceSize[0]] = static_cast<PixelType>(filter.GetElement(k));
+        ++k;
+      }
+    }
+    it->second.filterFFT = static_cast<ComplexType*>(FunctionsType::Malloc(sizeFFT * sizeof(ComplexType)));
+    FunctionsType::ExecuteForward(it->second.forwardPlan, piece, it->second.filterFFT);
+
+    FunctionsType::Free(piece);
+    FunctionsType::Free(pieceFFT);
+    return it->second;
+  }
+
+  std::map<KeyType, Block> blocks;
+  ArrayType                filter;
+  InputSizeType            radius;
+  bool                     newPlans;
+  std::mutex               mutex;
+#endif
+};
+
+template <class TInputImage, class TOutputImage, class TBoundaryCondition, class TFFTPrecision>
+OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition, TFFTPrecision>::OverlapSaveConvolutionImageFilter()
+  : m_Norm(1.), m_AutomaticDomainSelection(false), m_PlanCache(new FFTPlanCache)
 {
   m_Radius.Fill(1);
   m_Filter.SetSize(3 * 3);
@@ -51,10 +238,15 @@ OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition>
   m_NormalizeFilter = false;
 }
 
-template <class TInputImage, class TOutputImage, class TBoundaryCondition>
-void OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition>::GenerateInputRequestedRegion()
+template <class TInputImage, class TOutputImage, class TBoundaryCondition, class TFFTPrecision>
+OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition, TFFTPrecision>::~OverlapSaveConvolutionImageFilter()
 {
-#if defined ITK_USE_FFTWD
+}
+
+template <class TInputImage, class TOutputImage, class TBoundaryCondition, class TFFTPrecision>
+void OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition, TFFTPrecision>::GenerateInputRequestedRegion()
+{
+#ifdef OTB_OVERLAP_SAVE_USE_FFTW
   // call the superclass' implementation of this method
   Superclass::GenerateInputRequestedRegion();
 
@@ -97,34 +289,114 @@ void OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondi
     throw e;
   }
 #else
-  itkGenericExceptionMacro(<< "The OverlapSaveConvolutionImageFilter can not operate without the FFTW library (double implementation). Please build ITK with "
-                              "USE_FFTD set to ON, and rebuild OTB.");
+  itkGenericExceptionMacro(<< "The OverlapSaveConvolutionImageFilter can not operate without the FFTW library. Please build ITK with "
+                              "USE_FFTD (or USE_FFTWF for single precision) set to ON, and rebuild OTB.");
+#endif
+}
+
+template <class TInputImage, class TOutputImage, class TBoundaryCondition, class TFFTPrecision>
+void OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition, TFFTPrecision>::BeforeThreadedGenerateData()
+{
+  // Computing the filter normalization
+  m_Norm = 1.0;
+  if (m_NormalizeFilter)
+  {
+    InputRealType norm = itk::NumericTraits<InputRealType>::Zero;
+    for (unsigned int i = 0; i < m_Filter.Size(); ++i)
+    {
+      norm += static_cast<InputRealType>(m_Filter(i));
+    }
+    m_Norm = (norm == 0.0) ? 1.0 : 1 / static_cast<double>(norm);
+  }
+
+#ifdef OTB_OVERLAP_SAVE_USE_FFTW
+  m_PlanCache->SetFilter(m_Filter, m_Radius);
+  if (!m_WisdomFileName.empty())
+  {
+    // A missing wisdom file is not an error: it is created after planning
+    FFTPlanCache::FunctionsType::ImportWisdom(m_WisdomFileName.c_str());
+  }
+#endif
+}
+
+template <class TInputImage, class TOutputImage, class TBoundaryCondition, class TFFTPrecision>
+void OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition, TFFTPrecision>::AfterThreadedGenerateData()
+{
+#ifdef OTB_OVERLAP_SAVE_USE_FFTW
+  if (!m_WisdomFileName.empty() && m_PlanCache->newPlans)
+  {
+    if (!FFTPlanCache::FunctionsType::ExportWisdom(m_WisdomFileName.c_str()))
+    {
+      itkWarningMacro(<< "Unable to write the FFTW wisdom to " << m_WisdomFileName);
+    }
+    m_PlanCache->newPlans = false;
+  }
 #endif
 }
 
-template <class TInputImage, class TOutputImage, class TBoundaryCondition>
-void OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition>
-    /* TODO commented out since multi-threading is not supported for the moment
-     * ::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) */
-    ::GenerateData()
+template <class TInputImage, class TOutputImage, class TBoundaryCondition, class TFFTPrecision>
+bool OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition, TFFTPrecision>::UseSpatialDomain(const OutputImageRegionType& region) const
+{
+  if (!m_AutomaticDomainSelection)
+  {
+    return false;
+  }
+  // Two real transforms of the padded block (the kernel one is cached)
+  // against one multiply-add per kernel coefficient and output pixel
+  const double pieceNbOfPixel = static_cast<double>(region.GetSize(0) + 2 * m_Radius[0]) * (region.GetSize(1) + 2 * m_Radius[1]);
+  const double fftCost        = 5. * pieceNbOfPixel * std::log2(pieceNbOfPixel) / region.GetNumberOfPixels();
+  const double spatialCost    = 2. * m_Filter.Size();
+  return spatialCost <= fftCost;
+}
+
+template <class TInputImage, class TOutputImage, class TBoundaryCondition, class TFFTPrecision>
+void OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondition, TFFTPrecision>::ThreadedGenerateData(
+    const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
-#if defined ITK_USE_FFTWD
+#ifdef OTB_OVERLAP_SAVE_USE_FFTW
   // Input/Output pointers
-  typename OutputImageType::Pointer     output = this->GetOutput();
-  typename InputImageType::ConstPointer input  = this->GetInput();
+  OutputImageType*      output = this->GetOutput();
+  const InputImageType* input  = this->GetInput();
 
-  /* TODO: This is a patch to switch from GenerateData() to ThreadedGenerateData(). Remove these two lines
-  once multi-threading problem is solved */
-  this->AllocateOutputs();
-  OutputImageRegionType outputRegionForThread = output->GetRequestedRegion();
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
   // Size of the filter
   typename InputImageType::SizeType sizeOfFilter;
   sizeOfFilter[0] = 2 * m_Radius[0] + 1;
   sizeOfFilter[1] = 2 * m_Radius[1] + 1;
 
-  // Filter normalization
-  InputRealType norm;
+  itk::ImageRegionIteratorWithIndex<OutputImageType> outputIt(output, outputRegionForThread);
+
+  if (this->UseSpatialDomain(outputRegionForThread))
+  {
+    // Same zero boundary and kernel orientation as the FFT product
+    const InputImageRegionType largest = input->GetLargestPossibleRegion();
+    for (outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt)
+    {
+      double       sum = 0.;
+      unsigned int k   = 0;
+      for (unsigned int j = 0; j < sizeOfFilter[1]; ++j)
+      {
+        for (unsigned int i = 0; i < sizeOfFilter[0]; ++i, ++k)
+        {
+          typename InputImageType::IndexType index = outputIt.GetIndex();
+          index[0] += static_cast<itk::IndexValueType>(m_Radius[0]) - i;
+          index[1] += static_cast<itk::IndexValueType>(m_Radius[1]) - j;
+          if (largest.IsInside(index))
+          {
+            sum += static_cast<double>(m_Filter.GetElement(k)) * static_cast<double>(input->GetPixel(index));
+          }
+        }
+      }
+      outputIt.Set(static_cast<OutputPixelType>(sum * m_Norm));
+      progress.CompletedPixel();
+    }
+    return;
+  }
+
+  typedef typename FFTPlanCache::FunctionsType FunctionsType;
+  typedef typename FFTPlanCache::PixelType     FFTPixelType;
+  typedef typename FFTPlanCache::ComplexType   FFTComplexType;
 
   // Compute the input region for the given thread
   OutputImageRegionType inputRegionForThread = outputRegionForThread;
@@ -145,153 +417,80 @@ void OverlapSaveConvolutionImageFilter<TInputImage, TOutputImage, TBoundaryCondi
   typename InputImageType::IndexType inputIndex = inputRegionForThread.GetIndex();
   typename InputImageType::SizeType  inputSize  = inputRegionForThread.GetSize();
 
-  // Iterator of input image
-  itk::ConstNeighborhoodIterator<InputImageType, BoundaryConditionType> inputIt(m_Radius, input, inputRegionForThread);
-  inputIt.GoToBegin();
-
-  // Iterator of output image
-  itk::ImageRegionIteratorWithIndex<OutputImageType> outputIt;
-  outputIt = itk::ImageRegionIteratorWithIndex<OutputImageType>(output, outputRegionForThread);
-
-  // variables for loops
-  unsigned int i, j, k, l;
-
-  // ITK proxy to the fftw library
-  typedef typename itk::fftw::Proxy<double> FFTWProxyType;
+  // Plans and resampled filter FFT, shared by the blocks of the same size
+  const typename FFTPlanCache::Block& block = m_PlanCache->GetBlock(pieceSize);
 
   // memory allocation
-  InputPixelType* resampledFilterPiece;
-  resampledFilterPiece = static_cast<FFTWProxyType::PixelType*>(fftw_malloc(pieceNbOfPixel * sizeof(InputPixelType)));
-
-  FFTWProxyType::ComplexType* filterPieceFFT;
-  filterPieceFFT = static_cast<FFTWProxyType::ComplexType*>(fftw_malloc(sizeFFT * sizeof(FFTWProxyType::ComplexType)));
-
-  InputPixelType* inputPiece;
-  inputPiece = static_cast<FFTWProxyType::PixelType*>(fftw_malloc(pieceNbOfPixel * sizeof(InputPixelType)));
-
-  FFTWProxyType::ComplexType* inputPieceFFT;
-  inputPieceFFT = static_cast<FFTWProxyType::ComplexType*>(fftw_malloc(sizeFFT * sizeof(FFTWProxyType::ComplexType)));
-
-  // Image piece FFT
-  FFTWProxyType::PlanType inputPlan = FFTWProxyType::Plan_dft_r2c_2d(pieceSize[1], pieceSize[0], inputPiece, inputPieceFFT, FFTW_MEASURE);
+  FFTPixelType*   inputPiece      = static_cast<FFTPixelType*>(FunctionsType::Malloc(pieceNbOfPixel * sizeof(FFTPixelType)));
+  FFTComplexType* inputPieceFFT   = static_cast<FFTComplexType*>(FunctionsType::Malloc(sizeFFT * sizeof(FFTComplexType)));
+  FFTPixelType*   inverseFFTpiece = static_cast<FFTPixelType*>(FunctionsType::Malloc(pieceNbOfPixel * sizeof(FFTPixelType)));
 
   // left zero padding
   unsigned int leftskip = static_cast<unsigned int>(std::max((typename InputImageType::IndexValueType)0, inputIndex[0] - pieceIndex[0]));
   unsigned int topskip  = pieceSize[0] * static_cast<unsigned int>(std::max((typename InputImageType::IndexValueType)0, inputIndex[1] - pieceIndex[1]));
 
   // zero filling
-  memset(inputPiece, 0, pieceNbOfPixel * sizeof(InputPixelType));
+  memset(inputPiece, 0, pieceNbOfPixel * sizeof(FFTPixelType));
 
   // Filling the buffer with image values
-  for (l = 0; l < inputSize[1]; ++l)
+  itk::ImageRegionConstIterator<InputImageType> inputIt(input, inputRegionForThread);
+  inputIt.GoToBegin();
+  for (unsigned int l = 0; l < inputSize[1]; ++l)
   {
-    for (k = 0; k < inputSize[0]; ++k)
+    for (unsigned int k = 0; k < inputSize[0]; ++k)
     {
-      inputPiece[topskip + pieceSize[0] * l + k + leftskip] = inputIt.GetCenterPixel();
+      inputPiece[topskip + pieceSize[0] * l + k + leftskip] = static_cast<FFTPixelType>(inputIt.Get());
       ++inputIt;
     }
   }
 
-  FFTWProxyType::Execute(inputPlan);
-
-  // Resampled filter FFT
-  FFTWProxyType::PlanType filterPlan = FFTWProxyType::Plan_dft_r2c_2d(pieceSize[1], pieceSize[0], resampledFilterPiece, filterPieceFFT, FFTW_MEASURE);
-
-  // zero filling
-  memset(resampledFilterPiece, 0, pieceNbOfPixel * sizeof(InputPixelType));
-
-  k = 0;
-  // Filling the buffer with filter values
-  for (j = 0; j < sizeOfFilter[1]; ++j)
-  {
-    for (i = 0; i < sizeOfFilter[0]; ++i)
-    {
-      resampledFilterPiece[i + j * pieceSize[0]] = m_Filter.GetElement(k); // Copy values
-      ++k;
-    }
-  }
-
-  FFTWProxyType::Execute(filterPlan);
-
-  // memory allocation for inverse FFT
-  FFTWProxyType::ComplexType* multipliedFFTarray;
-  multipliedFFTarray = static_cast<FFTWProxyType::ComplexType*>(fftw_malloc(sizeFFT * sizeof(FFTWProxyType::ComplexType)));
-
-  FFTWProxyType::PixelType* inverseFFTpiece;
-  inverseFFTpiece = static_cast<FFTWProxyType::PixelType*>(fftw_malloc(pieceNbOfPixel * sizeof(FFTWProxyType::PixelType)));
-
-  // Inverse FFT of the product of FFT (actually do filtering here)
-  FFTWProxyType::PlanType outputPlan = FFTWProxyType::Plan_dft_c2r_2d(pieceSize[1], pieceSize[0], multipliedFFTarray, inverseFFTpiece, FFTW_MEASURE);
+  // Image piece FFT
+  FunctionsType::ExecuteForward(block.forwardPlan, inputPiece, inputPieceFFT);
 
-  // Filling the buffer with complex product values
-  for (k = 0; k < sizeFFT; ++k)
+  // Product of FFT (actually do filtering here)
+  for (unsigned int k = 0; k < sizeFFT; ++k)
   {
     // complex mutiplication
-    multipliedFFTarray[k][0] = inputPieceFFT[k][0] * filterPieceFFT[k][0] - inputPieceFFT[k][1] * filterPieceFFT[k][1];
-    multipliedFFTarray[k][1] = inputPieceFFT[k][0] * filterPieceFFT[k][1] + inputPieceFFT[k][1] * filterPieceFFT[k][0];
+    const FFTPixelType re = inputPieceFFT[k][0] * block.filterFFT[k][0] - inputPieceFFT[k][1] * block.filterFFT[k][1];
+    const FFTPixelType im = inputPieceFFT[k][0] * block.filterFFT[k][1] + inputPieceFFT[k][1] * block.filterFFT[k][0];
+    inputPieceFFT[k][0]   = re;
+    inputPieceFFT[k][1]   = im;
   }
 
-  FFTWProxyType::Execute(outputPlan);
-
-  // Computing the filter normalization
-
-  if (m_NormalizeFilter)
-  {
-    norm = itk::NumericTraits<InputRealType>::Zero;
-    for (i = 0; i < sizeOfFilter[0] * sizeOfFilter[1]; ++i)
-    {
-      norm += static_cast<InputRealType>(m_Filter(i));
-    }
-    if (norm == 0.0)
-    {
-      norm = 1.0;
-    }
-    else
-    {
-      norm = 1 / norm;
-    }
-  }
-  else
-  {
-    norm = 1.0;
-  }
+  // Inverse FFT of the product
+  FunctionsType::ExecuteBackward(block.backwardPlan, inputPieceFFT, inverseFFTpiece);
 
   // Fill the output image
-  outputIt.GoToBegin();
-  while (!outputIt.IsAtEnd())
+  for (outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt)
   {
     typename InputImageType::IndexType index = outputIt.GetIndex();
     unsigned int linearIndex = (index[1] + sizeOfFilter[1] - 1 - outputRegionForThread.GetIndex()[1]) * pieceSize[0] - 1 + index[0] + sizeOfFilter[0] -
                                outputRegionForThread.GetIndex()[0];
-    outputIt.Set(static_cast<OutputPixelType>((inverseFFTpiece[linearIndex] / pieceNbOfPixel) * static_cast<double>(norm)));
-    ++outputIt;
+    outputIt.Set(static_cast<OutputPixelType>((inverseFFTpiece[linearIndex] / pieceNbOfPixel) * m_Norm));
+    progress.CompletedPixel();
   }
 
-  // destroy the FFT plans
-  FFTWProxyType::DestroyPlan(inputPlan);
-  FFTWProxyType::DestroyPlan(filterPlan);
-  FFTWProxyType::DestroyPlan(outputPlan);
-
   // frees memory
-  fftw_free(resampledFilterPiece);
-  fftw_free(inputPiece);
-  fftw_free(filterPieceFFT);
-  fftw_free(inputPieceFFT);
-  fftw_free(multipliedFFTarray);
-  fftw_free(inverseFFTpiece);
+  FunctionsType::Free(inputPiece);
+  FunctionsType::Free(inputPieceFFT);
+  FunctionsType::Free(inverseFFTpiece);
 #else
-  itkGenericExceptionMacro(<< "The OverlapSaveConvolutionImageFilter can not operate without the FFTW library (double implementation). Please build ITK with "
-                              "USE_FFTD set to ON, and rebuild OTB.");
+  (void)outputRegionForThread;
+  (void)threadId;
+  itkGenericExceptionMacro(<< "The OverlapSaveConvolutionImageFilter can not operate without the FFTW library. Please build ITK with "
+                              "USE_FFTD (or USE_FFTWF for single precision) set to ON, and rebuild OTB.");
 #endif
 }
 
 /** Standard "PrintSelf" method */
-template <class TInputImage, class TOutput, class TBoundaryCondition>
-void OverlapSaveConvolutionImageFilter<TInputImage, TOutput, TBoundaryCondition>::PrintSelf(std::ostream& os, itk::Indent indent) const
+template <class TInputImage, class TOutput, class TBoundaryCondition, class TFFTPrecision>
+void OverlapSaveConvolutionImageFilter<TInputImage, TOutput, TBoundaryCondition, TFFTPrecision>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Radius: " << m_Radius << std::endl;
   os << indent << "Normalize filter: " << m_NormalizeFilter << std::endl;
+  os << indent << "Wisdom file name: " << m_WisdomFileName << std::endl;
+  os << indent << "Automatic domain selection: " << m_AutomaticDomainSelection << std::endl;
 }
 } // end namespace otb
 
@@ -24,7 +24,7 @@
 #include "otbImageFileWriter.h"
 #include "otbOverlapSaveConvolutionImageFilter.h"
 
-int otbOverlapSaveConvolutionImageFilter(int itkNotUsed(argc), char* argv[])
+int otbOverlapSaveConvolutionImageFilter(int argc, char* argv[])
 {
   const char* inputFileName  = argv[1];
   const char* outputFileName = argv[2];
@@ -57,6 +57,18 @@ int otbOverlapSaveConvolutionImageFilter(int itkNotUsed(argc), char* argv[])
   convFilter->SetFilter(filterCoeffs);
   convFilter->NormalizeFilterOn();
 
+  // Optional automatic domain selection and wisdom file, streamed so that
+  // the cached plans are reused across the divisions
+  if (argc > 3)
+  {
+    convFilter->SetAutomaticDomainSelection(atoi(argv[3]) != 0);
+    writer->SetNumberOfDivisionsStrippedStreaming(4);
+  }
+  if (argc > 4)
+  {
+    convFilter->SetWisdomFileName(argv[4]);
+  }
+
   convFilter->SetInput(reader->GetOutput());
   writer->SetInput(convFilter->GetOutput());
 
@@ -0,0 +1,149 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDEMDerivativesImageFilter_h
+#define otbDEMDerivativesImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <vector>
+
+namespace otb
+{
+/** \class DEMDerivativesImageFilter
+ *  \brief Compute the slope, the aspect and the hill shading of a DEM in a single pass
+ *
+ * The gradient is estimated with the 3x3 Sobel (Horn) kernel, applied as
+ * a separable kernel: the horizontal derivative and smoothing of each
+ * input row are computed once and kept in a rolling buffer of three
+ * rows, from which the gradient of the output row is combined. The
+ * borders follow a zero flux Neumann boundary condition.
+ *
+ * Three outputs are produced:
+ * - GetSlopeOutput(): slope in degrees, from 0 (flat) to 90;
+ * - GetAspectOutput(): azimuth of the steepest descent in degrees,
+ *   clockwise from the north, in [0, 360[, and 0 on flat areas;
+ * - GetHillShadeOutput(): lambertian of the surface lit from the given
+ *   azimuth and elevation, rescaled between 0 and 1 as in HillShadingFilter.
+ *
+ * The image is assumed to be north up: the first row is the northern
+ * one. The horizontal resolutions are the absolute value of the image
+ * spacing, unless they are set with SetXRes() and SetYRes() (for
+ * instance to give meters for a DEM in geographic coordinates). The
+ * heights are multiplied by ZScale.
+ *
+ * \sa DEMCaracteristicsExtractor
+ * \sa HillShadingFilter
+ *
+ * \ingroup OTBDEM
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT DEMDerivativesImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs */
+  typedef DEMDerivativesImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DEMDerivativesImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                                 InputImageType;
+  typedef TOutputImage                                OutputImageType;
+  typedef typename InputImageType::RegionType         InputImageRegionType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+
+  /** Get the slope output image */
+  OutputImageType* GetSlopeOutput()
+  {
+    return static_cast<OutputImageType*>(this->itk::ProcessObject::GetOutput(0));
+  }
+
+  /** Get the aspect output image */
+  OutputImageType* GetAspectOutput()
+  {
+    return static_cast<OutputImageType*>(this->itk::ProcessObject::GetOutput(1));
+  }
+
+  /** Get the hill shading output image */
+  OutputImageType* GetHillShadeOutput()
+  {
+    return static_cast<OutputImageType*>(this->itk::ProcessObject::GetOutput(2));
+  }
+
+  /** Set/Get the azimuth of the light, in degrees clockwise from the north */
+  itkSetMacro(AzimuthLight, double);
+  itkGetConstMacro(AzimuthLight, double);
+
+  /** Set/Get the elevation of the light, in degrees */
+  itkSetMacro(ElevationLight, double);
+  itkGetConstMacro(ElevationLight, double);
+
+  /** Set/Get the horizontal resolutions, the image spacing is used when 0 */
+  itkSetMacro(XRes, double);
+  itkGetConstMacro(XRes, double);
+  itkSetMacro(YRes, double);
+  itkGetConstMacro(YRes, double);
+
+  /** Set/Get the scale factor of the heights */
+  itkSetMacro(ZScale, double);
+  itkGetConstMacro(ZScale, double);
+
+protected:
+  DEMDerivativesImageFilter();
+  ~DEMDerivativesImageFilter() override
+  {
+  }
+
+  /** Pad the requested region by one pixel */
+  void GenerateInputRequestedRegion() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  DEMDerivativesImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Horizontal derivative and smoothing of an input row, clamped to the
+   * buffered region */
+  void FilterRow(long row, long firstColumn, unsigned int width, std::vector<double>& values, double* derivative, double* smoothed) const;
+
+  double m_AzimuthLight;
+  double m_ElevationLight;
+  double m_XRes;
+  double m_YRes;
+  double m_ZScale;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbDEMDerivativesImageFilter.hxx"
+#endif
+
+#endif
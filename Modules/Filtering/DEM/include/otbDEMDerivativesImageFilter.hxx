@@ -0,0 +1,198 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDEMDerivativesImageFilter_hxx
+#define otbDEMDerivativesImageFilter_hxx
+
+#include "otbDEMDerivativesImageFilter.h"
+#include "itkProgressReporter.h"
+#include "otbMath.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+DEMDerivativesImageFilter<TInputImage, TOutputImage>::DEMDerivativesImageFilter()
+  : m_AzimuthLight(30.), m_ElevationLight(45.), m_XRes(0.), m_YRes(0.), m_ZScale(1.)
+{
+  this->SetNumberOfRequiredInputs(1);
+  this->SetNumberOfRequiredOutputs(3);
+
+  this->SetNthOutput(0, OutputImageType::New());
+  this->SetNthOutput(1, OutputImageType::New());
+  this->SetNthOutput(2, OutputImageType::New());
+}
+
+template <class TInputImage, class TOutputImage>
+void DEMDerivativesImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (!input)
+  {
+    return;
+  }
+
+  InputImageRegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(1);
+  if (!inputRequestedRegion.Crop(input->GetLargestPossibleRegion()))
+  {
+    itkExceptionMacro(<< "The requested region is outside the input image");
+  }
+  input->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void DEMDerivativesImageFilter<TInputImage, TOutputImage>::FilterRow(long row, long firstColumn, unsigned int width, std::vector<double>& values,
+                                                                      double* derivative, double* smoothed) const
+{
+  const InputImageType*       input    = this->GetInput();
+  const InputImageRegionType& buffered = input->GetBufferedRegion();
+  const auto                  buffer   = input->GetBufferPointer();
+  const long                  firstX   = buffered.GetIndex()[0];
+  const long                  firstY   = buffered.GetIndex()[1];
+  const long                  lastX    = firstX + static_cast<long>(buffered.GetSize()[0]) - 1;
+  const long                  lastY    = firstY + static_cast<long>(buffered.GetSize()[1]) - 1;
+
+  // Row with one pixel of margin on each side
+  const long y       = std::min(std::max(row, firstY), lastY);
+  const auto rowData = buffer + (y - firstY) * buffered.GetSize()[0];
+  for (unsigned int i = 0; i < width + 2; ++i)
+  {
+    const long x = std::min(std::max(firstColumn - 1 + static_cast<long>(i), firstX), lastX);
+    values[i]    = m_ZScale * static_cast<double>(rowData[x - firstX]);
+  }
+
+  for (unsigned int i = 0; i < width; ++i)
+  {
+    derivative[i] = values[i + 2] - values[i];
+    smoothed[i]   = values[i] + 2 * values[i + 1] + values[i + 2];
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void DEMDerivativesImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                 itk::ThreadIdType            threadId)
+{
+  const InputImageType* input  = this->GetInput();
+  const unsigned int    width  = outputRegionForThread.GetSize()[0];
+  const unsigned int    height = outputRegionForThread.GetSize()[1];
+  const long            startX = outputRegionForThread.GetIndex()[0];
+  const long            startY = outputRegionForThread.GetIndex()[1];
+
+  const double xRes = m_XRes > 0. ? m_XRes : std::abs(input->GetSignedSpacing()[0]);
+  const double yRes = m_YRes > 0. ? m_YRes : std::abs(input->GetSignedSpacing()[1]);
+
+  // Light direction (east, north, up)
+  const double azimuth   = m_AzimuthLight * CONST_PI_180;
+  const double elevation = m_ElevationLight * CONST_PI_180;
+  const double lightX    = std::cos(elevation) * std::sin(azimuth);
+  const double lightY    = std::cos(elevation) * std::cos(azimuth);
+  const double lightZ    = std::sin(elevation);
+  const double rad2deg   = CONST_180_PI;
+
+  // Rolling buffers of the filtered rows above, at and below the current row
+  std::vector<double> values(width + 2);
+  std::vector<double> derivatives(3 * width), smoothed(3 * width);
+  std::vector<double> gradEast(width), gradNorth(width);
+  double*             derivativeRows[3] = {&derivatives[0], &derivatives[width], &derivatives[2 * width]};
+  double*             smoothedRows[3]   = {&smoothed[0], &smoothed[width], &smoothed[2 * width]};
+
+  FilterRow(startY - 1, startX, width, values, derivativeRows[0], smoothedRows[0]);
+  FilterRow(startY, startX, width, values, derivativeRows[1], smoothedRows[1]);
+
+  OutputImageType* outputs[3] = {this->GetSlopeOutput(), this->GetAspectOutput(), this->GetHillShadeOutput()};
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  for (unsigned int row = 0; row < height; ++row)
+  {
+    const long y = startY + row;
+    FilterRow(y + 1, startX, width, values, derivativeRows[2], smoothedRows[2]);
+
+    // Gradient along the east and north directions (the rows go southward)
+    const double* above = smoothedRows[0];
+    const double* below = smoothedRows[2];
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      gradEast[i]  = (derivativeRows[0][i] + 2 * derivativeRows[1][i] + derivativeRows[2][i]) / (8 * xRes);
+      gradNorth[i] = (above[i] - below[i]) / (8 * yRes);
+    }
+
+    OutputInternalPixelType* rows[3];
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      const OutputImageRegionType& buffered = outputs[k]->GetBufferedRegion();
+      rows[k] = outputs[k]->GetBufferPointer() + (y - buffered.GetIndex()[1]) * buffered.GetSize()[0] + (startX - buffered.GetIndex()[0]);
+    }
+
+    // Each product is computed by its own loop over the row
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      const double norm = std::sqrt(gradEast[i] * gradEast[i] + gradNorth[i] * gradNorth[i]);
+      rows[0][i]        = static_cast<OutputInternalPixelType>(std::atan(norm) * rad2deg);
+    }
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      double aspect = 0.;
+      if (gradEast[i] != 0. || gradNorth[i] != 0.)
+      {
+        aspect = std::atan2(-gradEast[i], -gradNorth[i]) * rad2deg;
+        if (aspect < 0.)
+        {
+          aspect += 360.;
+        }
+      }
+      rows[1][i] = static_cast<OutputInternalPixelType>(aspect);
+    }
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      const double lambertian =
+          (lightZ - lightX * gradEast[i] - lightY * gradNorth[i]) / std::sqrt(gradEast[i] * gradEast[i] + gradNorth[i] * gradNorth[i] + 1);
+      rows[2][i] = static_cast<OutputInternalPixelType>((lambertian + 1) / 2);
+    }
+
+    std::rotate(derivativeRows, derivativeRows + 1, derivativeRows + 3);
+    std::rotate(smoothedRows, smoothedRows + 1, smoothedRows + 3);
+    for (unsigned int i = 0; i < width; ++i)
+    {
+      progress.CompletedPixel();
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void DEMDerivativesImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "AzimuthLight: " << m_AzimuthLight << std::endl;
+  os << indent << "ElevationLight: " << m_ElevationLight << std::endl;
+  os << indent << "XRes: " << m_XRes << std::endl;
+  os << indent << "YRes: " << m_YRes << std::endl;
+  os << indent << "ZScale: " << m_ZScale << std::endl;
+}
+
+} // end namespace otb
+
+#endif
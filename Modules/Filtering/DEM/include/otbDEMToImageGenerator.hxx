@@ -25,6 +25,8 @@
 #include "otbMacro.h"
 #include "itkProgressReporter.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -93,69 +95,72 @@ void DEMToImageGenerator<TDEMImage>::ThreadedGenerateData(const OutputImageRegio
 {
   DEMImagePointerType DEMImage = this->GetOutput();
 
-  // Create an iterator that will walk the output region
-  ImageIteratorType outIt = ImageIteratorType(DEMImage, outputRegionForThread);
-
   // support progress methods/callbacks
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
-  // Walk the output image, evaluating the height at each pixel
-  IndexType currentindex;
-  PointType phyPoint;
-  double    height;
-  PointType geoPoint;
+  // The heights are computed row by row: the points of a row are
+  // transformed and looked up in the DEM in a single call
+  const unsigned int     width = outputRegionForThread.GetSize()[0];
+  std::vector<PointType> phyPoints(width);
+  std::vector<PointType> geoPoints(width);
+  std::vector<double>    lon(width), lat(width), heights(width);
 
-  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  IndexType currentindex = outputRegionForThread.GetIndex();
+  for (unsigned int row = 0; row < outputRegionForThread.GetSize()[1]; ++row)
   {
-    currentindex = outIt.GetIndex();
-    DEMImage->TransformIndexToPhysicalPoint(currentindex, phyPoint);
+    currentindex[0] = outputRegionForThread.GetIndex()[0];
+    currentindex[1] = outputRegionForThread.GetIndex()[1] + row;
 
+    IndexType pixelIndex = currentindex;
+    for (unsigned int col = 0; col < width; ++col)
+    {
+      pixelIndex[0] = currentindex[0] + col;
+      DEMImage->TransformIndexToPhysicalPoint(pixelIndex, phyPoints[col]);
+    }
 
+    const PointType* points = phyPoints.data();
     if (m_Transform.IsNotNull())
     {
-      geoPoint = m_Transform->TransformPoint(phyPoint);
-      if (m_AboveEllipsoid)
-      {
-        height = DEMHandler::GetInstance().GetHeightAboveEllipsoid(geoPoint); // Altitude
-                                                                  // calculation
-      }
-      else
-      {
-        height = DEMHandler::GetInstance().GetHeightAboveMSL(geoPoint); // Altitude
-                                                            // calculation
-      }
+      m_Transform->TransformPoints(phyPoints.data(), geoPoints.data(), width);
+      points = geoPoints.data();
+    }
+
+    for (unsigned int col = 0; col < width; ++col)
+    {
+      lon[col] = points[col][0];
+      lat[col] = points[col][1];
+    }
+
+    // Altitude calculation
+    if (m_AboveEllipsoid)
+    {
+      DEMHandler::GetInstance().GetHeightAboveEllipsoid(lon.data(), lat.data(), heights.data(), width);
     }
     else
     {
-      if (m_AboveEllipsoid)
+      DEMHandler::GetInstance().GetHeightAboveMSL(lon.data(), lat.data(), heights.data(), width);
+    }
+
+    SizeType rowSize;
+    rowSize[0] = width;
+    rowSize[1] = 1;
+    ImageIteratorType outIt(DEMImage, OutputImageRegionType(currentindex, rowSize));
+    for (unsigned int col = 0; col < width; ++col, ++outIt)
+    {
+      // DEM sets a default value (-32768) at point where it doesn't have altitude information.
+      // OSSIM has chosen to change this default value in OSSIM_DBL_NAN (-4.5036e15).
+      if (!vnl_math_isnan(heights[col]))
       {
-        height = DEMHandler::GetInstance().GetHeightAboveEllipsoid(phyPoint); // Altitude
-                                                                  // calculation
+        // Fill the image
+        outIt.Set(static_cast<PixelType>(heights[col]));
       }
       else
       {
-        height = DEMHandler::GetInstance().GetHeightAboveMSL(phyPoint); // Altitude
-                                                            // calculation
+        // Back to the MNT default value
+        outIt.Set(m_DefaultUnknownValue);
       }
+      progress.CompletedPixel();
     }
-    /*    otbMsgDevMacro(<< "Index : (" << currentindex[0]<< "," << currentindex[1] << ") -> PhyPoint : ("
-                       << phyPoint[0] << "," << phyPoint[1] << ") -> GeoPoint: ("
-                       << geoPoint[0] << "," << geoPoint[1] << ") -> height" << height);
-    */
-    //       otbMsgDevMacro(<< "height" << height);
-    // DEM sets a default value (-32768) at point where it doesn't have altitude information.
-    // OSSIM has chosen to change this default value in OSSIM_DBL_NAN (-4.5036e15).
-    if (!vnl_math_isnan(height))
-    {
-      // Fill the image
-      DEMImage->SetPixel(currentindex, static_cast<PixelType>(height));
-    }
-    else
-    {
-      // Back to the MNT default value
-      DEMImage->SetPixel(currentindex, m_DefaultUnknownValue);
-    }
-    progress.CompletedPixel();
   }
 }
 
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbDEMDerivativesImageFilter.h"
+#include "otbImage.h"
+#include "otbMath.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <cmath>
+
+// The derivatives of a plane are known everywhere but on the borders
+int otbDEMDerivativesImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<double, 2> ImageType;
+  typedef otb::DEMDerivativesImageFilter<ImageType, ImageType> FilterType;
+
+  // z = a * column + b * row, with a north up spacing of 2 meters
+  const double a = 1.5;
+  const double b = -0.5;
+
+  ImageType::SizeType size;
+  size[0] = 57;
+  size[1] = 43;
+  ImageType::IndexType index;
+  index.Fill(0);
+  ImageType::SpacingType spacing;
+  spacing[0] = 2.;
+  spacing[1] = -2.;
+
+  ImageType::Pointer dem = ImageType::New();
+  dem->SetRegions(ImageType::RegionType(index, size));
+  dem->SetSignedSpacing(spacing);
+  dem->Allocate();
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(dem, dem->GetLargestPossibleRegion()); !it.IsAtEnd(); ++it)
+  {
+    it.Set(a * it.GetIndex()[0] + b * it.GetIndex()[1]);
+  }
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(dem);
+  filter->SetAzimuthLight(315.);
+  filter->SetElevationLight(45.);
+  filter->Update();
+
+  const double gradEast  = a / 2.;
+  const double gradNorth = -b / 2.;
+  const double norm      = std::sqrt(gradEast * gradEast + gradNorth * gradNorth);
+  const double slope     = std::atan(norm) * CONST_180_PI;
+  double       aspect    = std::atan2(-gradEast, -gradNorth) * CONST_180_PI;
+  if (aspect < 0.)
+    aspect += 360.;
+  const double az         = 315. * CONST_PI_180;
+  const double el         = 45. * CONST_PI_180;
+  const double lambertian = (std::sin(el) - std::cos(el) * std::sin(az) * gradEast - std::cos(el) * std::cos(az) * gradNorth) / std::sqrt(norm * norm + 1);
+  const double hillShade  = (lambertian + 1) / 2;
+
+  ImageType::RegionType inner = dem->GetLargestPossibleRegion();
+  inner.ShrinkByRadius(1);
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(filter->GetSlopeOutput(), inner); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType idx = it.GetIndex();
+    if (std::abs(it.Get() - slope) > 1e-9 || std::abs(filter->GetAspectOutput()->GetPixel(idx) - aspect) > 1e-9 ||
+        std::abs(filter->GetHillShadeOutput()->GetPixel(idx) - hillShade) > 1e-9)
+    {
+      std::cout << "Wrong derivatives at " << idx << ": slope " << it.Get() << " (" << slope << "), aspect " << filter->GetAspectOutput()->GetPixel(idx)
+                << " (" << aspect << "), hill shade " << filter->GetHillShadeOutput()->GetPixel(idx) << " (" << hillShade << ")" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
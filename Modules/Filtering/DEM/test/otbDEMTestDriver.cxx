@@ -25,4 +25,5 @@ void RegisterTests()
   REGISTER_TEST(otbDEMToImageGeneratorFromImageTest);
   REGISTER_TEST(otbDEMToImageGeneratorTest);
   REGISTER_TEST(otbDEMCaracteristicsExtractor);
+  REGISTER_TEST(otbDEMDerivativesImageFilter);
 }
@@ -24,6 +24,8 @@
 #include "itkImageToImageFilter.h"
 #include "otbPCAImageFilter.h"
 #include "otbFastICAInternalOptimizerVectorImageFilter.h"
+#include "otbPersistentPixelSampleImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
 #include <functional>
 
 namespace otb
@@ -37,6 +39,11 @@ namespace otb
  * The contrast function and its derivative can be supplied to the filter as
  * lambda functions.
  *
+ * By default, each iteration streams the whole image once per component.
+ * When a number of samples is set, a uniform random sample of the
+ * principal components is gathered in a single streamed pass, and the
+ * iterations are computed in memory on this sample.
+ *
  * [1] Fast and robust fixed-point algorithms for independent component analysis
  *
  * \sa PCAImageFilter
@@ -88,6 +95,9 @@ public:
   typedef StreamingStatisticsVectorImageFilter<InputImageType> MeanEstimatorFilterType;
   typedef typename MeanEstimatorFilterType::Pointer            MeanEstimatorFilterPointerType;
 
+  typedef PersistentPixelSampleImageFilter<typename PCAFilterType::OutputImageType> PixelSampleFilterType;
+  typedef PersistentFilterStreamingDecorator<PixelSampleFilterType>               PixelSampleEstimatorType;
+
   typedef std::function<double(double)> NonLinearityType;
 
   /**
@@ -158,6 +168,11 @@ public:
   itkGetMacro(Mu, double);
   itkSetMacro(Mu, double);
 
+  /** Set/Get the number of sampled pixels the iterations are computed on.
+   * 0 (default) uses the whole image. */
+  itkGetMacro(NumberOfSamples, unsigned int);
+  itkSetMacro(NumberOfSamples, unsigned int);
+
 protected:
   FastICAImageFilter();
   ~FastICAImageFilter() override
@@ -188,6 +203,12 @@ protected:
   /** this is the specific part of FastICA */
   virtual void GenerateTransformationMatrix();
 
+  /** FastICA iterations on a sample of the principal components */
+  virtual void GenerateTransformationMatrixFromSamples();
+
+  /** W = (W.W^T)^(-1/2).W */
+  static void SymmetricDecorrelation(InternalMatrixType& W);
+
   unsigned int m_NumberOfPrincipalComponentsRequired;
 
   /** Transformation matrix refers to the ICA step (not PCA) */
@@ -201,6 +222,7 @@ protected:
   NonLinearityType m_NonLinearity;           // see g() function in the biblio. Def is tanh
   NonLinearityType m_NonLinearityDerivative; // derivative of g().
   double           m_Mu;                     // def is 1. in [0, 1]
+  unsigned int     m_NumberOfSamples;        // def is 0 (whole image)
 
   PCAFilterPointerType       m_PCAFilter;
   TransformFilterPointerType m_TransformFilter;
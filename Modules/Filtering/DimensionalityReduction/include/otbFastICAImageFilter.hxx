@@ -52,6 +52,8 @@ FastICAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::FastI
 
   m_Mu = 1.;
 
+  m_NumberOfSamples = 0;
+
   m_PCAFilter = PCAFilterType::New();
   m_PCAFilter->SetUseNormalization(true);
   m_PCAFilter->SetUseVarianceForNormalization(false);
@@ -209,6 +211,12 @@ void FastICAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::
 template <class TInputImage, class TOutputImage, Transform::TransformDirection TDirectionOfTransformation>
 void FastICAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::GenerateTransformationMatrix()
 {
+  if (m_NumberOfSamples > 0)
+  {
+    GenerateTransformationMatrixFromSamples();
+    return;
+  }
+
   itk::ProgressReporter reporter(this, 0, GetNumberOfIterations(), GetNumberOfIterations());
 
   double       convergence = itk::NumericTraits<double>::max();
@@ -264,14 +272,7 @@ void FastICAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::
     }
 
     // Decorrelation of the W vectors
-    InternalMatrixType         W_tmp = W * W.transpose();
-    vnl_svd<MatrixElementType> solver(W_tmp);
-    InternalMatrixType         valP = solver.W();
-    for (unsigned int i = 0; i < valP.rows(); ++i)
-      valP(i, i) = 1. / std::sqrt(static_cast<double>(valP(i, i))); // Watch for 0 or neg
-    InternalMatrixType transf = solver.U();
-    W_tmp                     = transf * valP * transf.transpose();
-    W                         = W_tmp * W;
+    SymmetricDecorrelation(W);
 
     // Convergence evaluation
     convergence = 0.;
@@ -287,6 +288,107 @@ void FastICAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::
   otbMsgDebugMacro(<< "Final convergence " << convergence << " after " << iteration << " iterations");
 }
 
+template <class TInputImage, class TOutputImage, Transform::TransformDirection TDirectionOfTransformation>
+void FastICAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::GenerateTransformationMatrixFromSamples()
+{
+  const unsigned int size = this->GetNumberOfPrincipalComponentsRequired();
+
+  // Z = [ z_1 ... z_N ], sampled principal components
+  typename PixelSampleEstimatorType::Pointer sampler = PixelSampleEstimatorType::New();
+  sampler->SetInput(m_PCAFilter->GetOutput());
+  sampler->GetFilter()->SetInitialAccumulator(typename PixelSampleFilterType::AccumulatorType(m_NumberOfSamples));
+  sampler->Update();
+
+  const auto         samples   = sampler->GetFilter()->GetResult().GetSamples();
+  const unsigned int nbSamples = samples.size();
+  if (nbSamples == 0)
+  {
+    throw itk::ExceptionObject(__FILE__, __LINE__, "No pixel could be sampled from the input image", ITK_LOCATION);
+  }
+
+  InternalMatrixType Z(size, nbSamples);
+  for (unsigned int k = 0; k < nbSamples; ++k)
+  {
+    for (unsigned int bd = 0; bd < size; bd++)
+      Z(bd, k) = static_cast<MatrixElementType>(samples[k][bd]);
+  }
+
+  itk::ProgressReporter reporter(this, 0, GetNumberOfIterations(), GetNumberOfIterations());
+
+  double       convergence = itk::NumericTraits<double>::max();
+  unsigned int iteration   = 0;
+
+  // transformation matrix
+  InternalMatrixType W(size, size, vnl_matrix_identity);
+
+  while (iteration++ < GetNumberOfIterations() && convergence > GetConvergenceThreshold())
+  {
+    InternalMatrixType W_old(W);
+
+    // X = W^T.Z, as the transformer applies z^T.W
+    const InternalMatrixType X = W.transpose() * Z;
+
+    for (unsigned int band = 0; band < size; band++)
+    {
+      otbMsgDebugMacro(<< "Iteration " << iteration << ", bande " << band << ", convergence " << convergence);
+
+      // beta = E[x.g(x)], den = E[g'(x)] - beta, mean = E[g(x).z]
+      double                   beta = 0.;
+      double                   den  = 0.;
+      vnl_vector<double>       mean(size, 0.);
+      const MatrixElementType* x    = X[band];
+      for (unsigned int k = 0; k < nbSamples; ++k)
+      {
+        const double g_x = m_NonLinearity(x[k]);
+        beta += x[k] * g_x;
+        den += m_NonLinearityDerivative(x[k]);
+        for (unsigned int bd = 0; bd < size; bd++)
+          mean[bd] += g_x * Z(bd, k);
+      }
+      beta /= nbSamples;
+      den = den / nbSamples - beta;
+      mean /= nbSamples;
+
+      double norm = 0.;
+      for (unsigned int bd = 0; bd < size; bd++)
+      {
+        W(bd, band) -= m_Mu * (mean[bd] - beta * W(bd, band)) / den;
+        norm += std::pow(W(bd, band), 2.);
+      }
+      for (unsigned int bd = 0; bd < size; bd++)
+        W(bd, band) /= std::sqrt(norm);
+    }
+
+    // Decorrelation of the W vectors
+    SymmetricDecorrelation(W);
+
+    // Convergence evaluation
+    convergence = 0.;
+    for (unsigned int i = 0; i < W.rows(); ++i)
+      for (unsigned int j = 0; j < W.cols(); ++j)
+        convergence += std::abs(W(i, j) - W_old(i, j));
+
+    reporter.CompletedPixel();
+  } // end of while loop
+
+  this->m_TransformationMatrix = W;
+
+  otbMsgDebugMacro(<< "Final convergence " << convergence << " after " << iteration << " iterations on " << nbSamples << " samples");
+}
+
+template <class TInputImage, class TOutputImage, Transform::TransformDirection TDirectionOfTransformation>
+void FastICAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::SymmetricDecorrelation(InternalMatrixType& W)
+{
+  InternalMatrixType         W_tmp = W * W.transpose();
+  vnl_svd<MatrixElementType> solver(W_tmp);
+  InternalMatrixType         valP = solver.W();
+  for (unsigned int i = 0; i < valP.rows(); ++i)
+    valP(i, i) = 1. / std::sqrt(static_cast<double>(valP(i, i))); // Watch for 0 or neg
+  InternalMatrixType transf = solver.U();
+  W_tmp                     = transf * valP * transf.transpose();
+  W                         = W_tmp * W;
+}
+
 } // end of namespace otb
 
 #endif
@@ -184,8 +184,25 @@ void MNFImageFilter<TInputImage, TOutputImage, TNoiseImageFilter, TDirectionOfTr
     throw itk::ExceptionObject(__FILE__, __LINE__, "Empty transformation matrix", ITK_LOCATION);
   }
 
-  m_Transformer->SetInput(m_Normalizer->GetOutput());
-  m_Transformer->SetMatrix(m_TransformationMatrix.GetVnlMatrix());
+  // The normalisation is folded into the transformation:
+  // T.((x - mean) / stddev) = (T.diag(1/stddev)).x - (T.diag(1/stddev)).mean
+  const auto mean   = m_Normalizer->GetFunctor().GetMean();
+  const auto stdDev = m_Normalizer->GetFunctor().GetStdDev();
+
+  InternalMatrixType                       transf = m_TransformationMatrix.GetVnlMatrix();
+  typename TransformFilterType::VectorType offset(transf.rows(), 0.);
+  for (unsigned int r = 0; r < transf.rows(); ++r)
+  {
+    for (unsigned int c = 0; c < transf.cols(); ++c)
+    {
+      transf(r, c) /= stdDev[c];
+      offset[r] -= transf(r, c) * mean[c];
+    }
+  }
+
+  m_Transformer->SetInput(inputImgPtr);
+  m_Transformer->SetMatrix(transf);
+  m_Transformer->SetOffset(offset);
 }
 
 template <class TInputImage, class TOutputImage, class TNoiseImageFilter, Transform::TransformDirection TDirectionOfTransformation>
@@ -313,7 +330,7 @@ void MNFImageFilter<TInputImage, TOutputImage, TNoiseImageFilter, TDirectionOfTr
   InternalMatrixType         U    = solver.U();
   InternalMatrixType         valP = solver.W();
 
-  InternalMatrixType transf = Rn_inv * U;
+  InternalMatrixType                       transf = Rn_inv * U;
 
   transf.inplace_transpose();
 
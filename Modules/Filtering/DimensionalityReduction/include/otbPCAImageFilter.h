@@ -217,6 +217,9 @@ protected:
   bool         m_IsTransformationMatrixForward;
   bool         m_Whitening;
 
+  /** Whether the normalisation is applied by the transformer */
+  bool m_FoldNormalization;
+
   VectorType m_MeanValues;
   VectorType m_StdDevValues;
   MatrixType m_CovarianceMatrix;
@@ -46,6 +46,7 @@ PCAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::PCAImageF
   m_GivenCovarianceMatrix         = false;
   m_GivenTransformationMatrix     = false;
   m_IsTransformationMatrixForward = true;
+  m_FoldNormalization             = false;
 
   m_CovarianceEstimator = CovarianceEstimatorFilterType::New();
   m_Transformer         = TransformFilterType::New();
@@ -115,6 +116,8 @@ void PCAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::Forw
 {
   typename InputImageType::Pointer inputImgPtr = const_cast<InputImageType*>(this->GetInput());
 
+  m_FoldNormalization = false;
+
   if (!m_GivenTransformationMatrix)
   {
     if (!m_GivenCovarianceMatrix)
@@ -177,7 +180,10 @@ void PCAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::Forw
           m_CovarianceMatrix = m_CovarianceEstimator->GetCovariance();
         }
 
-        m_Transformer->SetInput(m_Normalizer->GetOutput());
+        // The normalisation is folded into the transformation, see
+        // ForwardGenerateData()
+        m_Transformer->SetInput(inputImgPtr);
+        m_FoldNormalization = true;
       }
       else
       {
@@ -294,7 +300,31 @@ void PCAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::Gene
 template <class TInputImage, class TOutputImage, Transform::TransformDirection TDirectionOfTransformation>
 void PCAImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::ForwardGenerateData()
 {
-  m_Transformer->SetMatrix(m_TransformationMatrix.GetVnlMatrix());
+  if (m_FoldNormalization)
+  {
+    // T.((x - mean) / stddev) = (T.diag(1/stddev)).x - (T.diag(1/stddev)).mean
+    m_Normalizer->GetOutput()->UpdateOutputInformation();
+    const auto mean   = m_Normalizer->GetFunctor().GetMean();
+    const auto stdDev = m_Normalizer->GetFunctor().GetStdDev();
+
+    InternalMatrixType                       transf = m_TransformationMatrix.GetVnlMatrix();
+    typename TransformFilterType::VectorType offset(transf.rows(), 0.);
+    for (unsigned int r = 0; r < transf.rows(); ++r)
+    {
+      for (unsigned int c = 0; c < transf.cols(); ++c)
+      {
+        transf(r, c) /= stdDev[c];
+        offset[r] -= transf(r, c) * mean[c];
+      }
+    }
+    m_Transformer->SetMatrix(transf);
+    m_Transformer->SetOffset(offset);
+  }
+  else
+  {
+    m_Transformer->SetMatrix(m_TransformationMatrix.GetVnlMatrix());
+    m_Transformer->SetOffset(typename TransformFilterType::VectorType());
+  }
   m_Transformer->GraftOutput(this->GetOutput());
   m_Transformer->Update();
   this->GraftOutput(m_Transformer->GetOutput());
@@ -26,7 +26,7 @@
 #include "otbFastICAImageFilter.h"
 
 
-int otbFastICAImageFilterTest(int, char* argv[])
+int otbFastICAImageFilterTest(int argc, char* argv[])
 {
 
   std::string inputImageName     = argv[1];
@@ -54,6 +54,10 @@ int otbFastICAImageFilterTest(int, char* argv[])
   filter->SetNumberOfPrincipalComponentsRequired(nbComponents);
   filter->SetNumberOfIterations(nbIterations);
   filter->SetMu(mu);
+  if (argc > 4)
+  {
+    filter->SetNumberOfSamples(atoi(argv[4]));
+  }
 
   typedef otb::CommandProgressUpdate<FilterType> CommandType;
   CommandType::Pointer                           observer = CommandType::New();
@@ -0,0 +1,136 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbAdaptiveTransformToDisplacementFieldSource_h
+#define otbAdaptiveTransformToDisplacementFieldSource_h
+
+#include "itkTransformToDisplacementFieldSource.h"
+#include "itkProgressReporter.h"
+
+#include <unordered_map>
+
+namespace otb
+{
+
+/** \class AdaptiveTransformToDisplacementFieldSource
+ *  \brief Generate a displacement field from a transform, evaluating the
+ *         transform only where the field is not locally bilinear.
+ *
+ * This source produces exactly the same regular grid as
+ * itk::TransformToDisplacementFieldSource. When AdaptiveRefinement is
+ * off (the default), the superclass implementation is used. When it is
+ * on, the largest possible region of the field is tiled with coarse
+ * cells of CoarseCellSize nodes. The transform is evaluated at the
+ * corners of each cell and at its centre and edge midpoints: if the
+ * bilinear interpolation of the corners predicts these control points
+ * within Tolerance (in the units of the transformed space), the nodes of
+ * the cell are interpolated. Otherwise the cell is split in four and the
+ * test is repeated, down to single-node cells which are evaluated
+ * exactly.
+ *
+ * Cells are anchored on the largest possible region, so that the result
+ * does not depend on the streaming or threading layout.
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class TOutputImage, class TTransformPrecisionType = double>
+class ITK_EXPORT AdaptiveTransformToDisplacementFieldSource : public itk::TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>
+{
+public:
+  /** Standard class typedefs. */
+  typedef AdaptiveTransformToDisplacementFieldSource Self;
+  typedef itk::TransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(AdaptiveTransformToDisplacementFieldSource, itk::TransformToDisplacementFieldSource);
+
+  typedef typename Superclass::OutputImageType       OutputImageType;
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+  typedef typename Superclass::PixelType             PixelType;
+  typedef typename Superclass::PixelValueType        PixelValueType;
+  typedef typename Superclass::IndexType             IndexType;
+  typedef typename Superclass::PointType             PointType;
+  typedef typename Superclass::RegionType            RegionType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TOutputImage::ImageDimension);
+
+  /** Enable the adaptive evaluation of the transform */
+  itkSetMacro(AdaptiveRefinement, bool);
+  itkGetConstMacro(AdaptiveRefinement, bool);
+  itkBooleanMacro(AdaptiveRefinement);
+
+  /** Size (in nodes) of the coarse cells the refinement starts from */
+  itkSetClampMacro(CoarseCellSize, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+  itkGetConstMacro(CoarseCellSize, unsigned int);
+
+  /** Maximum allowed interpolation error, in transformed space units */
+  itkSetMacro(Tolerance, double);
+  itkGetConstMacro(Tolerance, double);
+
+protected:
+  AdaptiveTransformToDisplacementFieldSource();
+  ~AdaptiveTransformToDisplacementFieldSource() override
+  {
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  AdaptiveTransformToDisplacementFieldSource(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Exact displacements already computed by the current thread, keyed
+   *  by node offset in the largest possible region */
+  typedef std::unordered_map<itk::OffsetValueType, PixelType> NodeCacheType;
+
+  /** Exact displacement at a node */
+  const PixelType& Evaluate(const IndexType& index, NodeCacheType& cache) const;
+
+  /** Recursively fill the part of the thread region covered by the
+   *  [first, last] cell (bounds included) */
+  void RefineCell(const IndexType& first, const IndexType& last, const OutputImageRegionType& outputRegionForThread, NodeCacheType& cache,
+                  itk::ProgressReporter& progress) const;
+
+  /** True if the bilinear interpolation of the corners of the cell
+   *  predicts the field within tolerance at the control points */
+  bool IsCellLinear(const IndexType& first, const IndexType& last, NodeCacheType& cache) const;
+
+  /** Bilinear interpolation of the corners of a cell at index */
+  PixelType Interpolate(const IndexType& first, const IndexType& last, const IndexType& index, NodeCacheType& cache) const;
+
+  bool         m_AdaptiveRefinement;
+  unsigned int m_CoarseCellSize;
+  double       m_Tolerance;
+};
+
+} // namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbAdaptiveTransformToDisplacementFieldSource.hxx"
+#endif
+
+#endif
@@ -0,0 +1,317 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbAdaptiveTransformToDisplacementFieldSource_hxx
+#define otbAdaptiveTransformToDisplacementFieldSource_hxx
+
+#include "otbAdaptiveTransformToDisplacementFieldSource.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TOutputImage, class TTransformPrecisionType>
+AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::AdaptiveTransformToDisplacementFieldSource()
+  : m_AdaptiveRefinement(false), m_CoarseCellSize(16), m_Tolerance(0.1)
+{
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                            itk::ThreadIdType            threadId)
+{
+  if (!m_AdaptiveRefinement)
+  {
+    Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+    return;
+  }
+
+  const RegionType& largest = this->GetOutput()->GetLargestPossibleRegion();
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+  NodeCacheType         cache;
+
+  const itk::IndexValueType step = m_CoarseCellSize;
+
+  // Range of coarse cells touching the thread region, per dimension
+  itk::IndexValueType firstCell[ImageDimension];
+  itk::IndexValueType lastCell[ImageDimension];
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const itk::IndexValueType start   = largest.GetIndex(d);
+    const itk::IndexValueType extent  = static_cast<itk::IndexValueType>(largest.GetSize(d)) - 1;
+    const itk::IndexValueType maxCell = std::max<itk::IndexValueType>(0, (extent + step - 1) / step - 1);
+
+    const itk::IndexValueType regionStart = outputRegionForThread.GetIndex(d) - start;
+    const itk::IndexValueType regionEnd   = regionStart + static_cast<itk::IndexValueType>(outputRegionForThread.GetSize(d)) - 1;
+
+    firstCell[d] = std::min(regionStart / step, maxCell);
+    lastCell[d]  = std::min(regionEnd / step, maxCell);
+  }
+
+  // Walk the coarse cells
+  itk::IndexValueType cell[ImageDimension];
+  std::copy(firstCell, firstCell + ImageDimension, cell);
+  bool done = false;
+  while (!done)
+  {
+    IndexType first, last;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const itk::IndexValueType end = largest.GetIndex(d) + static_cast<itk::IndexValueType>(largest.GetSize(d)) - 1;
+      first[d]                      = largest.GetIndex(d) + cell[d] * step;
+      last[d]                       = std::min(first[d] + step, end);
+    }
+
+    RefineCell(first, last, outputRegionForThread, cache, progress);
+
+    done = true;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      if (cell[d] < lastCell[d])
+      {
+        ++cell[d];
+        done = false;
+        break;
+      }
+      cell[d] = firstCell[d];
+    }
+  }
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+const typename AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::PixelType&
+AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::Evaluate(const IndexType& index, NodeCacheType& cache) const
+{
+  const OutputImageType* outputPtr = this->GetOutput();
+  const RegionType&      largest   = outputPtr->GetLargestPossibleRegion();
+
+  itk::OffsetValueType key    = 0;
+  itk::OffsetValueType stride = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    key += (index[d] - largest.GetIndex(d)) * stride;
+    stride *= static_cast<itk::OffsetValueType>(largest.GetSize(d));
+  }
+
+  auto it = cache.find(key);
+  if (it != cache.end())
+  {
+    return it->second;
+  }
+
+  PointType outputPoint;
+  outputPtr->TransformIndexToPhysicalPoint(index, outputPoint);
+  const PointType transformedPoint = this->GetTransform()->TransformPoint(outputPoint);
+
+  PixelType displacement;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    displacement[d] = static_cast<PixelValueType>(transformedPoint[d] - outputPoint[d]);
+  }
+  return cache.emplace(key, displacement).first->second;
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+typename AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::PixelType
+AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::Interpolate(const IndexType& first, const IndexType& last,
+                                                                                              const IndexType& index, NodeCacheType& cache) const
+{
+  double weights[ImageDimension];
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    weights[d] = last[d] > first[d] ? static_cast<double>(index[d] - first[d]) / static_cast<double>(last[d] - first[d]) : 0.;
+  }
+
+  double value[ImageDimension] = {};
+  for (unsigned int corner = 0; corner < (1u << ImageDimension); ++corner)
+  {
+    IndexType cornerIndex;
+    double    weight = 1.;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const bool upper = (corner >> d) & 1u;
+      cornerIndex[d]   = upper ? last[d] : first[d];
+      weight *= upper ? weights[d] : 1. - weights[d];
+    }
+    if (weight == 0.)
+    {
+      continue;
+    }
+    const PixelType& cornerValue = Evaluate(cornerIndex, cache);
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      value[d] += weight * cornerValue[d];
+    }
+  }
+
+  PixelType displacement;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    displacement[d] = static_cast<PixelValueType>(value[d]);
+  }
+  return displacement;
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+bool AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::IsCellLinear(const IndexType& first, const IndexType& last,
+                                                                                                    NodeCacheType& cache) const
+{
+  const double tolerance2 = m_Tolerance * m_Tolerance;
+
+  // Control points are the nodes of the {first, mid, last}^N lattice
+  // which are not corners of the cell
+  unsigned int nbPoints = 1;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    nbPoints *= 3;
+  }
+
+  for (unsigned int point = 0; point < nbPoints; ++point)
+  {
+    IndexType    index;
+    bool         isCorner = true;
+    unsigned int code     = point;
+    for (unsigned int d = 0; d < ImageDimension; ++d, code /= 3)
+    {
+      switch (code % 3)
+      {
+      case 0:
+        index[d] = first[d];
+        break;
+      case 1:
+        index[d] = first[d] + (last[d] - first[d]) / 2;
+        isCorner = isCorner && (index[d] == first[d] || index[d] == last[d]);
+        break;
+      default:
+        index[d] = last[d];
+      }
+    }
+    if (isCorner)
+    {
+      continue;
+    }
+
+    const PixelType& exact        = Evaluate(index, cache);
+    const PixelType  interpolated = Interpolate(first, last, index, cache);
+
+    double error2 = 0.;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const double diff = static_cast<double>(exact[d]) - static_cast<double>(interpolated[d]);
+      error2 += diff * diff;
+    }
+    if (error2 > tolerance2)
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::RefineCell(const IndexType& first, const IndexType& last,
+                                                                                                  const OutputImageRegionType& outputRegionForThread,
+                                                                                                  NodeCacheType& cache, itk::ProgressReporter& progress) const
+{
+  OutputImageType*  outputPtr = const_cast<OutputImageType*>(this->GetOutput());
+  const RegionType& largest   = outputPtr->GetLargestPossibleRegion();
+
+  // A cell owns its nodes up to, but excluding, its upper bound, unless
+  // that bound is the border of the field. Each node thus belongs to a
+  // single leaf cell.
+  IndexType ownedStart;
+  typename RegionType::SizeType ownedSize;
+  bool      isLeaf = true;
+  for (unsigned int d = 0; d < ImageDimension; ++d)
+  {
+    const itk::IndexValueType end      = largest.GetIndex(d) + static_cast<itk::IndexValueType>(largest.GetSize(d)) - 1;
+    const itk::IndexValueType ownedEnd = last[d] == end ? last[d] : last[d] - 1;
+
+    const itk::IndexValueType regionStart = outputRegionForThread.GetIndex(d);
+    const itk::IndexValueType regionEnd   = regionStart + static_cast<itk::IndexValueType>(outputRegionForThread.GetSize(d)) - 1;
+
+    const itk::IndexValueType lower = std::max(first[d], regionStart);
+    const itk::IndexValueType upper = std::min(ownedEnd, regionEnd);
+    if (upper < lower)
+    {
+      return;
+    }
+    ownedStart[d] = lower;
+    ownedSize[d]  = static_cast<typename RegionType::SizeValueType>(upper - lower + 1);
+
+    isLeaf = isLeaf && (last[d] - first[d] <= 1);
+  }
+
+  const bool interpolate = !isLeaf && IsCellLinear(first, last, cache);
+
+  if (isLeaf || interpolate)
+  {
+    itk::ImageRegionIteratorWithIndex<OutputImageType> outIt(outputPtr, RegionType(ownedStart, ownedSize));
+    for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+    {
+      outIt.Set(interpolate ? Interpolate(first, last, outIt.GetIndex(), cache) : Evaluate(outIt.GetIndex(), cache));
+      progress.CompletedPixel();
+    }
+    return;
+  }
+
+  // Split the cell in two along each dimension wider than one node
+  for (unsigned int child = 0; child < (1u << ImageDimension); ++child)
+  {
+    IndexType childFirst, childLast;
+    bool      valid = true;
+    for (unsigned int d = 0; d < ImageDimension; ++d)
+    {
+      const bool upper = (child >> d) & 1u;
+      if (last[d] - first[d] <= 1)
+      {
+        valid         = valid && !upper;
+        childFirst[d] = first[d];
+        childLast[d]  = last[d];
+      }
+      else
+      {
+        const itk::IndexValueType mid = first[d] + (last[d] - first[d]) / 2;
+        childFirst[d]                 = upper ? mid : first[d];
+        childLast[d]                  = upper ? last[d] : mid;
+      }
+    }
+    if (valid)
+    {
+      RefineCell(childFirst, childLast, outputRegionForThread, cache, progress);
+    }
+  }
+}
+
+template <class TOutputImage, class TTransformPrecisionType>
+void AdaptiveTransformToDisplacementFieldSource<TOutputImage, TTransformPrecisionType>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "AdaptiveRefinement: " << m_AdaptiveRefinement << std::endl;
+  os << indent << "CoarseCellSize: " << m_CoarseCellSize << std::endl;
+  os << indent << "Tolerance: " << m_Tolerance << std::endl;
+}
+
+} // namespace otb
+
+#endif
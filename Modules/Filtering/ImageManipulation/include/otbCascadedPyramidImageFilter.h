@@ -0,0 +1,172 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbCascadedPyramidImageFilter_h
+#define otbCascadedPyramidImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkMultiThreader.h"
+
+#include <deque>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class CascadedPyramidImageFilter
+ * \brief Compute all the levels of a multi-resolution pyramid from a single
+ * streamed read of the input.
+ *
+ * Output i is level i + 1 of the pyramid. Each level is the previous one
+ * smoothed with a gaussian kernel of variance VarianceFactor * ShrinkFactor
+ * (in pixels of the previous level), then subsampled by ShrinkFactor.
+ *
+ * The outputs are meant to be streamed together by strips, from top to
+ * bottom, with a MultiImageFileWriter. Between two strips, the filter only
+ * keeps the rows of each level that the next strips still need, so that
+ * the input is read once and no level is computed twice. Other requests
+ * remain correct but may recompute rows.
+ *
+ * \sa MultiImageFileWriter
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class TImage>
+class ITK_EXPORT CascadedPyramidImageFilter : public itk::ImageToImageFilter<TImage, TImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef CascadedPyramidImageFilter              Self;
+  typedef itk::ImageToImageFilter<TImage, TImage> Superclass;
+  typedef itk::SmartPointer<Self>                 Pointer;
+  typedef itk::SmartPointer<const Self>           ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(CascadedPyramidImageFilter, itk::ImageToImageFilter);
+
+  typedef TImage                                ImageType;
+  typedef typename ImageType::RegionType        RegionType;
+  typedef typename ImageType::IndexType         IndexType;
+  typedef typename ImageType::SizeType          SizeType;
+  typedef typename ImageType::InternalPixelType InternalPixelType;
+
+  /** Set the number of levels, which is the number of outputs */
+  void SetNumberOfLevels(unsigned int nbLevels);
+  itkGetConstMacro(NumberOfLevels, unsigned int);
+
+  /** Subsampling factor between two consecutive levels */
+  itkSetMacro(ShrinkFactor, unsigned int);
+  itkGetConstMacro(ShrinkFactor, unsigned int);
+
+  /** Variance of the smoothing, relative to the ShrinkFactor */
+  itkSetMacro(VarianceFactor, double);
+  itkGetConstMacro(VarianceFactor, double);
+
+protected:
+  CascadedPyramidImageFilter();
+  ~CascadedPyramidImageFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  /** Outputs have different sizes, their requested regions are independent */
+  void GenerateOutputRequestedRegion(itk::DataObject* output) override;
+
+  /** Outputs are computed by full rows */
+  void EnlargeOutputRequestedRegion(itk::DataObject* output) override;
+
+  void GenerateInputRequestedRegion() override;
+
+  void GenerateData() override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  CascadedPyramidImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Rows [first, second) of a level */
+  typedef std::pair<long, long> RowRangeType;
+
+  /** Rows of a level computed so far and not yet released */
+  struct RowCacheType
+  {
+    long                            FirstRow;
+    std::deque<std::vector<double>> Rows;
+    long EndRow() const
+    {
+      return FirstRow + static_cast<long>(Rows.size());
+    }
+  };
+
+  struct ThreadStruct
+  {
+    Self*        Filter;
+    unsigned int Level;
+    long         FirstRow;
+    long         NbRows;
+  };
+
+  /** Rows to compute at each level for the current requested regions.
+   *  Index 0 holds the rows to read from the input. */
+  void ComputeRowsToProcess(std::vector<RowRangeType>& rows) const;
+
+  /** Rows to compute, among the wanted ones, that are not in the cache */
+  RowRangeType MissingRows(unsigned int level, const RowRangeType& wanted) const;
+
+  /** Rows of level - 1 needed to compute the given rows of level */
+  RowRangeType Footprint(unsigned int level, const RowRangeType& rows) const;
+
+  /** Rows of level requested on the corresponding output */
+  RowRangeType RequestedRows(unsigned int level) const;
+
+  /** Compute one row of level from the cached rows of level - 1 */
+  void ComputeRow(unsigned int level, long row, std::vector<double>& vertical, std::vector<double>& out) const;
+
+  static ITK_THREAD_RETURN_TYPE ComputeRowsThreaderCallback(void* arg);
+
+  unsigned int m_NumberOfLevels;
+  unsigned int m_ShrinkFactor;
+  double       m_VarianceFactor;
+
+  /** Gaussian kernel, of size 2 * radius + 1 */
+  std::vector<double> m_Kernel;
+  long                m_Radius;
+
+  /** Size of each level, level 0 being the input */
+  std::vector<long> m_Width;
+  std::vector<long> m_Height;
+  long              m_NbComponents;
+
+  std::vector<RowCacheType> m_Cache;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbCascadedPyramidImageFilter.hxx"
+#endif
+
+#endif
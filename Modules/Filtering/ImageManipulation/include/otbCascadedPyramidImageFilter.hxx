@@ -0,0 +1,440 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbCascadedPyramidImageFilter_hxx
+#define otbCascadedPyramidImageFilter_hxx
+
+#include "otbCascadedPyramidImageFilter.h"
+#include "otbMacro.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <class TImage>
+CascadedPyramidImageFilter<TImage>::CascadedPyramidImageFilter()
+  : m_NumberOfLevels(0), m_ShrinkFactor(2), m_VarianceFactor(0.6), m_Radius(0), m_NbComponents(0)
+{
+  this->SetNumberOfLevels(1);
+}
+
+template <class TImage>
+void CascadedPyramidImageFilter<TImage>::SetNumberOfLevels(unsigned int nbLevels)
+{
+  if (nbLevels == 0)
+  {
+    itkExceptionMacro(<< "The pyramid needs at least one level");
+  }
+  if (nbLevels == m_NumberOfLevels)
+  {
+    return;
+  }
+
+  this->SetNumberOfRequiredOutputs(nbLevels);
+  for (unsigned int level = m_NumberOfLevels; level < nbLevels; ++level)
+  {
+    this->SetNthOutput(level, ImageType::New());
+  }
+  for (unsigned int level = nbLevels; level < m_NumberOfLevels; ++level)
+  {
+    this->RemoveOutput(level);
+  }
+  m_NumberOfLevels = nbLevels;
+  this->Modified();
+}
+
+template <class TImage>
+void CascadedPyramidImageFilter<TImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  if (m_ShrinkFactor == 0)
+  {
+    itkExceptionMacro(<< "The shrink factor must be positive");
+  }
+
+  const ImageType* input  = this->GetInput();
+  const RegionType largest = input->GetLargestPossibleRegion();
+  const long       offset  = (m_ShrinkFactor - 1) / 2;
+
+  m_NbComponents = input->GetNumberOfComponentsPerPixel();
+  m_Width.assign(1, largest.GetSize()[0]);
+  m_Height.assign(1, largest.GetSize()[1]);
+
+  typename ImageType::SpacingType spacing = input->GetSignedSpacing();
+  typename ImageType::PointType   origin;
+  input->TransformIndexToPhysicalPoint(largest.GetIndex(), origin);
+
+  for (unsigned int level = 1; level <= m_NumberOfLevels; ++level)
+  {
+    // Pixel i of a level is centered on pixel i * factor + offset of the
+    // previous one
+    m_Width.push_back(std::max(1L, m_Width.back() / static_cast<long>(m_ShrinkFactor)));
+    m_Height.push_back(std::max(1L, m_Height.back() / static_cast<long>(m_ShrinkFactor)));
+    for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+      origin[dim] += offset * spacing[dim];
+      spacing[dim] *= m_ShrinkFactor;
+    }
+
+    IndexType index;
+    index.Fill(0);
+    SizeType size;
+    size[0] = m_Width.back();
+    size[1] = m_Height.back();
+
+    ImageType* output = this->GetOutput(level - 1);
+    output->SetLargestPossibleRegion(RegionType(index, size));
+    output->SetSignedSpacing(spacing);
+    output->SetOrigin(origin);
+  }
+
+  // The same kernel is applied at each level, in pixels of the previous level
+  const double sigma = std::sqrt(m_VarianceFactor * m_ShrinkFactor);
+  m_Radius           = sigma > 0. ? static_cast<long>(std::ceil(3. * sigma)) : 0;
+  m_Kernel.assign(2 * m_Radius + 1, 1.);
+  if (m_Radius > 0)
+  {
+    double sum = 0.;
+    for (long k = -m_Radius; k <= m_Radius; ++k)
+    {
+      m_Kernel[k + m_Radius] = std::exp(-0.5 * k * k / (sigma * sigma));
+      sum += m_Kernel[k + m_Radius];
+    }
+    for (auto& weight : m_Kernel)
+    {
+      weight /= sum;
+    }
+  }
+
+  // A new streaming starts
+  m_Cache.assign(m_NumberOfLevels + 1, RowCacheType());
+  for (auto& cache : m_Cache)
+  {
+    cache.FirstRow = 0;
+  }
+}
+
+template <class TImage>
+void CascadedPyramidImageFilter<TImage>::GenerateOutputRequestedRegion(itk::DataObject* itkNotUsed(output))
+{
+}
+
+template <class TImage>
+void CascadedPyramidImageFilter<TImage>::EnlargeOutputRequestedRegion(itk::DataObject* output)
+{
+  ImageType* image = dynamic_cast<ImageType*>(output);
+  if (image == nullptr)
+  {
+    return;
+  }
+
+  RegionType       region  = image->GetRequestedRegion();
+  const RegionType largest = image->GetLargestPossibleRegion();
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+  region.SetIndex(0, largest.GetIndex(0));
+  region.SetSize(0, largest.GetSize(0));
+  image->SetRequestedRegion(region);
+}
+
+template <class TImage>
+typename CascadedPyramidImageFilter<TImage>::RowRangeType CascadedPyramidImageFilter<TImage>::RequestedRows(unsigned int level) const
+{
+  const RegionType region = this->GetOutput(level - 1)->GetRequestedRegion();
+  if (region.GetNumberOfPixels() == 0)
+  {
+    return RowRangeType(0, 0);
+  }
+  const long first = std::max(0L, static_cast<long>(region.GetIndex(1)));
+  return RowRangeType(first, std::min(m_Height[level], static_cast<long>(region.GetIndex(1) + region.GetSize(1))));
+}
+
+template <class TImage>
+typename CascadedPyramidImageFilter<TImage>::RowRangeType CascadedPyramidImageFilter<TImage>::MissingRows(unsigned int        level,
+                                                                                                        const RowRangeType& wanted) const
+{
+  if (wanted.first >= wanted.second)
+  {
+    return RowRangeType(0, 0);
+  }
+
+  // Rows are appended to the cache, which is dropped when the wanted rows
+  // do not follow it
+  const RowCacheType& cache = m_Cache[level];
+  if (wanted.first >= cache.FirstRow && wanted.first <= cache.EndRow())
+  {
+    const long first = std::max(wanted.first, cache.EndRow());
+    return first < wanted.second ? RowRangeType(first, wanted.second) : RowRangeType(0, 0);
+  }
+  return wanted;
+}
+
+template <class TImage>
+typename CascadedPyramidImageFilter<TImage>::RowRangeType CascadedPyramidImageFilter<TImage>::Footprint(unsigned int level, const RowRangeType& rows) const
+{
+  if (rows.first >= rows.second)
+  {
+    return RowRangeType(0, 0);
+  }
+  const long offset = (m_ShrinkFactor - 1) / 2;
+  return RowRangeType(std::max(0L, rows.first * m_ShrinkFactor + offset - m_Radius),
+                      std::min(m_Height[level - 1], (rows.second - 1) * m_ShrinkFactor + offset + m_Radius + 1));
+}
+
+template <class TImage>
+void CascadedPyramidImageFilter<TImage>::ComputeRowsToProcess(std::vector<RowRangeType>& rows) const
+{
+  rows.assign(m_NumberOfLevels + 1, RowRangeType(0, 0));
+
+  // From the coarsest level down: the rows wanted at a level are the ones
+  // requested on its output, and the ones the next level has to compute
+  RowRangeType needed(0, 0);
+  for (unsigned int level = m_NumberOfLevels; level > 0; --level)
+  {
+    RowRangeType wanted = RequestedRows(level);
+    if (needed.first < needed.second)
+    {
+      wanted = wanted.first < wanted.second ? RowRangeType(std::min(wanted.first, needed.first), std::max(wanted.second, needed.second)) : needed;
+    }
+    rows[level] = MissingRows(level, wanted);
+    needed      = Footprint(level, rows[level]);
+  }
+  rows[0] = MissingRows(0, needed);
+}
+
+template <class TImage>
+void CascadedPyramidImageFilter<TImage>::GenerateInputRequestedRegion()
+{
+  ImageType* input = const_cast<ImageType*>(this->GetInput());
+  if (input == nullptr)
+  {
+    return;
+  }
+
+  std::vector<RowRangeType> rows;
+  this->ComputeRowsToProcess(rows);
+
+  // The input needs a non empty requested region, even when all the needed
+  // rows are already cached
+  RowRangeType inputRows = rows[0];
+  if (inputRows.first >= inputRows.second)
+  {
+    inputRows.first  = std::max(0L, std::min(m_Cache[0].EndRow(), m_Height[0]) - 1);
+    inputRows.second = inputRows.first + 1;
+  }
+
+  RegionType region = input->GetLargestPossibleRegion();
+  region.SetIndex(1, region.GetIndex(1) + inputRows.first);
+  region.SetSize(1, inputRows.second - inputRows.first);
+  input->SetRequestedRegion(region);
+}
+
+template <class TImage>
+void CascadedPyramidImageFilter<TImage>::GenerateData()
+{
+  std::vector<RowRangeType> rows;
+  this->ComputeRowsToProcess(rows);
+
+  // Append the new input rows to the cache of level 0
+  const ImageType* input = this->GetInput();
+  if (rows[0].first < rows[0].second)
+  {
+    const RegionType buffered = input->GetBufferedRegion();
+    const long       offsetY  = input->GetLargestPossibleRegion().GetIndex(1);
+    if (rows[0].first + offsetY < buffered.GetIndex(1) || rows[0].second + offsetY > static_cast<long>(buffered.GetIndex(1) + buffered.GetSize(1)))
+    {
+      itkExceptionMacro(<< "Input rows [" << rows[0].first << ", " << rows[0].second << ") have not been requested");
+    }
+
+    RowCacheType& cache = m_Cache[0];
+    if (rows[0].first != cache.EndRow())
+    {
+      cache.Rows.clear();
+      cache.FirstRow = rows[0].first;
+    }
+
+    IndexType index = input->GetLargestPossibleRegion().GetIndex();
+    for (long row = rows[0].first; row < rows[0].second; ++row)
+    {
+      index[1]                       = offsetY + row;
+      const InternalPixelType* first = input->GetBufferPointer() + input->ComputeOffset(index) * m_NbComponents;
+      cache.Rows.emplace_back(first, first + m_Width[0] * m_NbComponents);
+    }
+  }
+
+  // Compute each level from the previous one
+  for (unsigned int level = 1; level <= m_NumberOfLevels; ++level)
+  {
+    if (rows[level].first >= rows[level].second)
+    {
+      continue;
+    }
+
+    RowCacheType& cache = m_Cache[level];
+    if (rows[level].first != cache.EndRow())
+    {
+      cache.Rows.clear();
+      cache.FirstRow = rows[level].first;
+    }
+    const long nbRows = rows[level].second - rows[level].first;
+    cache.Rows.resize(cache.Rows.size() + nbRows, std::vector<double>(m_Width[level] * m_NbComponents));
+
+    ThreadStruct str;
+    str.Filter   = this;
+    str.Level    = level;
+    str.FirstRow = rows[level].first;
+    str.NbRows   = nbRows;
+
+    this->GetMultiThreader()->SetNumberOfThreads(std::min(static_cast<long>(this->GetNumberOfThreads()), nbRows));
+    this->GetMultiThreader()->SetSingleMethod(this->ComputeRowsThreaderCallback, &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+  }
+
+  // Fill the outputs from the caches
+  for (unsigned int level = 1; level <= m_NumberOfLevels; ++level)
+  {
+    ImageType* output = this->GetOutput(level - 1);
+    output->SetBufferedRegion(output->GetRequestedRegion());
+    output->Allocate();
+
+    const RowRangeType  requested = RequestedRows(level);
+    const RowCacheType& cache     = m_Cache[level];
+    const RegionType    region    = output->GetBufferedRegion();
+    for (long row = requested.first; row < requested.second; ++row)
+    {
+      IndexType index;
+      index[0]                 = region.GetIndex(0);
+      index[1]                 = row;
+      const double*      first = cache.Rows[row - cache.FirstRow].data() + region.GetIndex(0) * m_NbComponents;
+      InternalPixelType* out   = output->GetBufferPointer() + output->ComputeOffset(index) * m_NbComponents;
+      for (long k = 0; k < static_cast<long>(region.GetSize(0)) * m_NbComponents; ++k)
+      {
+        out[k] = static_cast<InternalPixelType>(first[k]);
+      }
+    }
+  }
+
+  // Release the rows that the next strips will not need any more. The
+  // current strip is kept, as its output may be requested again when the
+  // strips of a small level are repeated.
+  for (unsigned int level = 0; level <= m_NumberOfLevels; ++level)
+  {
+    RowCacheType& cache   = m_Cache[level];
+    long          release = cache.EndRow();
+    if (level > 0)
+    {
+      const RowRangeType requested = RequestedRows(level);
+      if (requested.first < requested.second)
+      {
+        release = std::min(release, requested.first);
+      }
+    }
+    if (level < m_NumberOfLevels)
+    {
+      const long next = m_Cache[level + 1].EndRow();
+      release         = std::min(release, Footprint(level + 1, RowRangeType(next, next + 1)).first);
+    }
+    while (cache.FirstRow < release && !cache.Rows.empty())
+    {
+      cache.Rows.pop_front();
+      ++cache.FirstRow;
+    }
+  }
+}
+
+template <class TImage>
+ITK_THREAD_RETURN_TYPE CascadedPyramidImageFilter<TImage>::ComputeRowsThreaderCallback(void* arg)
+{
+  itk::ThreadIdType threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+  ThreadStruct*     str         = (ThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+
+  const long first = str->FirstRow + str->NbRows * threadId / threadCount;
+  const long last  = str->FirstRow + str->NbRows * (threadId + 1) / threadCount;
+
+  RowCacheType&       cache = str->Filter->m_Cache[str->Level];
+  std::vector<double> vertical;
+  for (long row = first; row < last; ++row)
+  {
+    str->Filter->ComputeRow(str->Level, row, vertical, cache.Rows[row - cache.FirstRow]);
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TImage>
+void CascadedPyramidImageFilter<TImage>::ComputeRow(unsigned int level, long row, std::vector<double>& vertical, std::vector<double>& out) const
+{
+  const RowCacheType& source    = m_Cache[level - 1];
+  const long          srcWidth  = m_Width[level - 1];
+  const long          srcHeight = m_Height[level - 1];
+  const long          offset    = (m_ShrinkFactor - 1) / 2;
+  const long          nbValues  = srcWidth * m_NbComponents;
+
+  // Vertical pass on the source rows around the center, the borders being
+  // replicated
+  vertical.assign(nbValues, 0.);
+  const long center = row * m_ShrinkFactor + offset;
+  for (long k = -m_Radius; k <= m_Radius; ++k)
+  {
+    const long                 srcRow = std::min(std::max(center + k, 0L), srcHeight - 1);
+    const std::vector<double>& line   = source.Rows[srcRow - source.FirstRow];
+    const double               weight = m_Kernel[k + m_Radius];
+    for (long i = 0; i < nbValues; ++i)
+    {
+      vertical[i] += weight * line[i];
+    }
+  }
+
+  // Horizontal pass at the subsampled columns only
+  for (long col = 0; col < m_Width[level]; ++col)
+  {
+    double*    pixel     = out.data() + col * m_NbComponents;
+    const long srcCenter = col * m_ShrinkFactor + offset;
+    std::fill(pixel, pixel + m_NbComponents, 0.);
+    for (long k = -m_Radius; k <= m_Radius; ++k)
+    {
+      const double* srcPixel = vertical.data() + std::min(std::max(srcCenter + k, 0L), srcWidth - 1) * m_NbComponents;
+      const double  weight   = m_Kernel[k + m_Radius];
+      for (long band = 0; band < m_NbComponents; ++band)
+      {
+        pixel[band] += weight * srcPixel[band];
+      }
+    }
+  }
+}
+
+template <class TImage>
+void CascadedPyramidImageFilter<TImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of levels: " << m_NumberOfLevels << std::endl;
+  os << indent << "Shrink factor: " << m_ShrinkFactor << std::endl;
+  os << indent << "Variance factor: " << m_VarianceFactor << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -133,13 +133,15 @@ void ClampVectorImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(con
   // support progress methods/callbacks
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
+  // Scratch pixel of the thread, reused for the whole region
+  const unsigned int   l_size = inputPtr->GetNumberOfComponentsPerPixel();
+  OutputImagePixelType outPix;
+  outPix.SetSize(l_size);
+
   // walk the regions, threshold each pixel
   while (!outIt.IsAtEnd() && !inIt.IsAtEnd())
   {
-    const InputImagePixelType inPix  = inIt.Get();
-    unsigned int              l_size = inPix.Size();
-    OutputImagePixelType      outPix;
-    outPix.SetSize(l_size);
+    const InputImagePixelType& inPix = inIt.Get();
     for (unsigned int i = 0; i < l_size; i++)
     {
       // Cast the value of the pixel to double in order to compare
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComposeTransformDisplacementFieldFilter_h
+#define otbComposeTransformDisplacementFieldFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkTransform.h"
+
+namespace otb
+{
+
+/** \class ComposeTransformDisplacementFieldFilter
+ *  \brief Compose a transform with a displacement field.
+ *
+ * Each node p of the input field holds a displacement d(p). The output
+ * field, which shares the geometry of the input one, holds
+ * T(p + d(p)) - p, where T is the transform set by the user.
+ *
+ * This allows to share the first stage of a two-stage mapping between
+ * several fields: for instance, the ground coordinates of a reference
+ * geometry are computed once as a displacement field, and composed with
+ * the ground-to-image transform of each input to superimpose.
+ *
+ * The transform is evaluated on whole lines of the field through
+ * otb::TransformPoints(), so that transforms supporting batches are
+ * called once per line.
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class TDisplacementField, class TTransformPrecisionType = double>
+class ITK_EXPORT ComposeTransformDisplacementFieldFilter : public itk::ImageToImageFilter<TDisplacementField, TDisplacementField>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ComposeTransformDisplacementFieldFilter Self;
+  typedef itk::ImageToImageFilter<TDisplacementField, TDisplacementField> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ComposeTransformDisplacementFieldFilter, itk::ImageToImageFilter);
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TDisplacementField::ImageDimension);
+
+  typedef TDisplacementField                         DisplacementFieldType;
+  typedef typename DisplacementFieldType::PixelType  PixelType;
+  typedef typename DisplacementFieldType::RegionType RegionType;
+  typedef typename DisplacementFieldType::IndexType  IndexType;
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+  typedef itk::Transform<TTransformPrecisionType, ImageDimension, ImageDimension> TransformType;
+  typedef typename TransformType::ConstPointer    TransformPointerType;
+  typedef typename TransformType::InputPointType  TransformInputPointType;
+  typedef typename TransformType::OutputPointType TransformOutputPointType;
+
+  /** Set/Get the transform composed with the input field */
+  itkSetConstObjectMacro(Transform, TransformType);
+  itkGetConstObjectMacro(Transform, TransformType);
+
+protected:
+  ComposeTransformDisplacementFieldFilter();
+  ~ComposeTransformDisplacementFieldFilter() override
+  {
+  }
+
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ComposeTransformDisplacementFieldFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  TransformPointerType m_Transform;
+};
+
+} // namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbComposeTransformDisplacementFieldFilter.hxx"
+#endif
+
+#endif
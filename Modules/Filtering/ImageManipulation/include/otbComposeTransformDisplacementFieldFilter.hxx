@@ -0,0 +1,109 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComposeTransformDisplacementFieldFilter_hxx
+#define otbComposeTransformDisplacementFieldFilter_hxx
+
+#include "otbComposeTransformDisplacementFieldFilter.h"
+#include "otbTransform.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+template <class TDisplacementField, class TTransformPrecisionType>
+ComposeTransformDisplacementFieldFilter<TDisplacementField, TTransformPrecisionType>::ComposeTransformDisplacementFieldFilter()
+{
+}
+
+template <class TDisplacementField, class TTransformPrecisionType>
+void ComposeTransformDisplacementFieldFilter<TDisplacementField, TTransformPrecisionType>::BeforeThreadedGenerateData()
+{
+  if (m_Transform.IsNull())
+  {
+    itkExceptionMacro(<< "Transform not set");
+  }
+}
+
+template <class TDisplacementField, class TTransformPrecisionType>
+void ComposeTransformDisplacementFieldFilter<TDisplacementField, TTransformPrecisionType>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                                itk::ThreadIdType            threadId)
+{
+  const DisplacementFieldType* inputPtr  = this->GetInput();
+  DisplacementFieldType*       outputPtr = this->GetOutput();
+
+  const std::size_t lineLength = outputRegionForThread.GetSize(0);
+
+  // Progress is reported line by line
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels() / std::max<std::size_t>(lineLength, 1));
+
+  itk::ImageScanlineConstIterator<DisplacementFieldType> inIt(inputPtr, outputRegionForThread);
+  itk::ImageScanlineIterator<DisplacementFieldType>      outIt(outputPtr, outputRegionForThread);
+
+  std::vector<typename DisplacementFieldType::PointType> nodePoints(lineLength);
+  std::vector<TransformInputPointType>                   inputPoints(lineLength);
+  std::vector<TransformOutputPointType>                  outputPoints(lineLength);
+
+  while (!inIt.IsAtEnd())
+  {
+    IndexType index = inIt.GetIndex();
+    for (std::size_t i = 0; !inIt.IsAtEndOfLine(); ++inIt, ++i, ++index[0])
+    {
+      outputPtr->TransformIndexToPhysicalPoint(index, nodePoints[i]);
+      const PixelType& displacement = inIt.Get();
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        inputPoints[i][dim] = nodePoints[i][dim] + displacement[dim];
+      }
+    }
+
+    otb::TransformPoints(m_Transform.GetPointer(), inputPoints.data(), outputPoints.data(), lineLength);
+
+    for (std::size_t i = 0; !outIt.IsAtEndOfLine(); ++outIt, ++i)
+    {
+      PixelType value;
+      for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+      {
+        value[dim] = outputPoints[i][dim] - nodePoints[i][dim];
+      }
+      outIt.Set(value);
+    }
+
+    inIt.NextLine();
+    outIt.NextLine();
+    progress.CompletedPixel();
+  }
+}
+
+template <class TDisplacementField, class TTransformPrecisionType>
+void ComposeTransformDisplacementFieldFilter<TDisplacementField, TTransformPrecisionType>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Transform: " << m_Transform.GetPointer() << std::endl;
+}
+
+} // namespace otb
+
+#endif
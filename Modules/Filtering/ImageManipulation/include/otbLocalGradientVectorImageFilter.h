@@ -21,7 +21,7 @@
 #ifndef otbLocalGradientVectorImageFilter_h
 #define otbLocalGradientVectorImageFilter_h
 
-#include "otbUnaryFunctorNeighborhoodVectorImageFilter.h"
+#include "otbNeighborhood3x3RowVectorImageFilter.h"
 
 #include <itkNumericTraits.h>
 
@@ -70,13 +70,13 @@ public:
  */
 template <class TInputImage, class TOutputImage>
 class ITK_EXPORT LocalGradientVectorImageFilter
-    : public UnaryFunctorNeighborhoodVectorImageFilter<
+    : public Neighborhood3x3RowVectorImageFilter<
           TInputImage, TOutputImage, Functor::LocalGradientOperator<typename itk::ConstNeighborhoodIterator<TInputImage>, typename TOutputImage::PixelType>>
 {
 public:
   /** Standard class typedefs */
   typedef LocalGradientVectorImageFilter Self;
-  typedef UnaryFunctorNeighborhoodVectorImageFilter<
+  typedef Neighborhood3x3RowVectorImageFilter<
       TInputImage, TOutputImage, Functor::LocalGradientOperator<typename itk::ConstNeighborhoodIterator<TInputImage>, typename TOutputImage::PixelType>>
                                         Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
@@ -91,13 +91,20 @@ public:
 protected:
   LocalGradientVectorImageFilter()
   {
-    typename Superclass::RadiusType radius = {{1, 1}};
-    this->SetRadius(radius);
   }
   ~LocalGradientVectorImageFilter() override
   {
   }
 
+  void ProcessLine(const double* itkNotUsed(above), const double* center, const double* below, double* output, double* itkNotUsed(work),
+                   unsigned int length, unsigned int nbComp) const override
+  {
+    for (unsigned int i = 0; i < length; ++i)
+    {
+      output[i] = center[i] - (center + nbComp)[i] / 2. - below[i] / 2.;
+    }
+  }
+
 private:
   LocalGradientVectorImageFilter(const Self&); // Not implemented
   void operator=(const Self&);                 // Not implemented
@@ -42,6 +42,13 @@ namespace otb
  * For example, if the image has 2 bands, the matrix is \f$ \begin{pmatrix} \alpha & \beta \\ \gama & \delta \end{pmatrix} \f$
  * The pixel \f$ [a, b] \f$ will give the output pixel \f$ [\alpha.a + \beta.b, \gamma.a + \delta.b  ]. \f$
  *
+ * An optional offset can be added to the result, so that an affine
+ * transform (for instance a normalisation followed by a projection) is
+ * applied in a single pass.
+ *
+ * Pixels are processed line by line: each line of the region is gathered
+ * in a matrix and multiplied at once by the transition matrix.
+ *
  *
  * \ingroup OTBImageManipulation
  */
@@ -101,6 +108,18 @@ public:
     return m_Matrix;
   }
 
+  /** Offset added to the result of the multiplication. Empty (default)
+   * means no offset. */
+  void SetOffset(const VectorType& offset)
+  {
+    m_Offset = offset;
+    this->Modified();
+  }
+  const VectorType& GetOffset() const
+  {
+    return m_Offset;
+  }
+
   itkGetConstMacro(MatrixByVector, bool);
   itkSetMacro(MatrixByVector, bool);
   itkBooleanMacro(MatrixByVector);
@@ -117,6 +136,9 @@ protected:
    */
   void GenerateOutputInformation() override;
 
+  /** Prepare the matrix applied to the lines of pixels */
+  void BeforeThreadedGenerateData() override;
+
   /** MatrixImageFilter can be implemented for a multithreaded filter treatment.
    * Thus, this implementation give the ThreadedGenerateData() method.
    * that is called for each process thread. Image datas are automatically allocated
@@ -134,6 +156,13 @@ private:
   /** Matrix declaration */
   MatrixType m_Matrix;
 
+  /** Optional offset */
+  VectorType m_Offset;
+
+  /** Matrix applied to the pixels stored as rows: m_Matrix, or its
+   * transpose if m_MatrixByVector is true */
+  MatrixType m_RowMatrix;
+
   /** If set to true, the applied operation is \f$ M . p \f$ where p is the pixel represented as a column vector.
       Otherwise the applied operation is  \f$ p . M \f$ where p is the pixel represented as a row vector.
   */
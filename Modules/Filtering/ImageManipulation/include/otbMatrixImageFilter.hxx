@@ -22,7 +22,7 @@
 #define otbMatrixImageFilter_hxx
 
 #include "otbMatrixImageFilter.h"
-#include "itkImageRegionIterator.h"
+#include "itkImageScanlineIterator.h"
 #include "itkProgressReporter.h"
 
 namespace otb
@@ -71,6 +71,17 @@ void MatrixImageFilter<TInputImage, TOutputImage, TMatrix>::GenerateOutputInform
   }
 }
 
+template <class TInputImage, class TOutputImage, class TMatrix>
+void MatrixImageFilter<TInputImage, TOutputImage, TMatrix>::BeforeThreadedGenerateData()
+{
+  m_RowMatrix = m_MatrixByVector ? m_Matrix.transpose() : m_Matrix;
+
+  if (!m_Offset.empty() && m_Offset.size() != m_RowMatrix.cols())
+  {
+    itkExceptionMacro("Invalid offset size. It must be the same as the output image number of channels.");
+  }
+}
+
 template <class TInputImage, class TOutputImage, class TMatrix>
 void MatrixImageFilter<TInputImage, TOutputImage, TMatrix>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
@@ -78,48 +89,53 @@ void MatrixImageFilter<TInputImage, TOutputImage, TMatrix>::ThreadedGenerateData
   typename OutputImageType::Pointer     outputPtr = this->GetOutput();
   typename InputImageType::ConstPointer inputPtr  = this->GetInput();
 
-  typename itk::ImageRegionConstIterator<InputImageType> inIt(inputPtr, outputRegionForThread);
-  itk::ImageRegionIterator<OutputImageType>              outIt(outputPtr, outputRegionForThread);
-
+  itk::ImageScanlineConstIterator<InputImageType> inIt(inputPtr, outputRegionForThread);
+  itk::ImageScanlineIterator<OutputImageType>     outIt(outputPtr, outputRegionForThread);
 
   // support progress methods/callbacks
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
-  inIt.GoToBegin();
-  outIt.GoToBegin();
+  const unsigned int inSize     = m_RowMatrix.rows();
+  const unsigned int outSize    = m_RowMatrix.cols();
+  const unsigned int lineLength = outputRegionForThread.GetSize(0);
 
-  const unsigned int inSize  = m_MatrixByVector ? m_Matrix.cols() : m_Matrix.rows();
-  const unsigned int outSize = m_MatrixByVector ? m_Matrix.rows() : m_Matrix.cols();
+  // One pixel per row
+  vnl_matrix<InputRealType> inLine(lineLength, inSize);
+  vnl_matrix<InputRealType> outLine(lineLength, outSize);
 
-  VectorType inVect(inSize, InputRealType(0.));
-  VectorType outVect(outSize, InputRealType(0.));
+  OutputPixelType outPix;
+  outPix.SetSize(outSize);
 
-  while (!outIt.IsAtEnd())
+  while (!inIt.IsAtEnd())
   {
-    const InputPixelType& inPix = inIt.Get();
-    OutputPixelType       outPix;
-    outPix.SetSize(outSize);
-
-    for (unsigned int i = 0; i < inSize; ++i)
+    for (unsigned int x = 0; !inIt.IsAtEndOfLine(); ++inIt, ++x)
     {
-      inVect[i] = static_cast<InputRealType>(inPix[i]);
+      const InputPixelType& inPix = inIt.Get();
+      InputRealType*        row   = inLine[x];
+      for (unsigned int i = 0; i < inSize; ++i)
+      {
+        row[i] = static_cast<InputRealType>(inPix[i]);
+      }
     }
 
-    outVect = m_MatrixByVector ? m_Matrix * inVect : inVect * m_Matrix;
+    outLine = inLine * m_RowMatrix;
 
-    for (unsigned int i = 0; i < outSize; ++i)
+    for (unsigned int x = 0; !outIt.IsAtEndOfLine(); ++outIt, ++x)
     {
-      outPix[i] = static_cast<OutputInternalPixelType>(outVect[i]);
+      const InputRealType* row = outLine[x];
+      for (unsigned int i = 0; i < outSize; ++i)
+      {
+        outPix[i] = static_cast<OutputInternalPixelType>(m_Offset.empty() ? row[i] : row[i] + m_Offset[i]);
+      }
+      outIt.Set(outPix);
+      progress.CompletedPixel();
     }
-    outIt.Set(outPix);
 
-    ++inIt;
-    ++outIt;
-    progress.CompletedPixel();
+    inIt.NextLine();
+    outIt.NextLine();
   }
 }
 
-
 /**
  * Standard "PrintSelf" method
  */
@@ -129,6 +145,7 @@ void MatrixImageFilter<TInputImage, TOutputImage, TMatrix>::PrintSelf(std::ostre
   Superclass::PrintSelf(os, indent);
   os << indent << "Matrix: " << m_Matrix << std::endl;
   os << indent << "MatrixByVector: " << m_MatrixByVector << std::endl;
+  os << indent << "Offset: " << m_Offset << std::endl;
 }
 
 } // end namespace otb
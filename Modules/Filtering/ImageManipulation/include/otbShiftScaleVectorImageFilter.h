@@ -117,6 +117,15 @@ public:
     TOutput result;
     result.SetSize(x.GetSize());
 
+    (*this)(result, x);
+
+    return result;
+  }
+
+  // main computation method, in a result already sized as x (does not
+  // allocate)
+  inline void operator()(TOutput& result, const TInput& x) const
+  {
     // consistency checking
     if (result.GetSize() != m_Scale.GetSize() || result.GetSize() != m_Shift.GetSize())
     {
@@ -136,7 +145,6 @@ public:
         result[i] = static_cast<typename TOutput::ValueType>(x[i] - m_Shift[i]);
       }
     }
-    return result;
   }
 
 private:
@@ -180,6 +188,7 @@ public:
   typedef typename OutputPixelType::ValueType                    OutputValueType;
   typedef typename itk::NumericTraits<InputValueType>::RealType  InputRealType;
   typedef typename itk::NumericTraits<OutputValueType>::RealType OutputRealType;
+  typedef typename Superclass::OutputImageRegionType             OutputImageRegionType;
 
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
@@ -210,6 +219,9 @@ protected:
   /** Generate input requested region */
   void GenerateInputRequestedRegion(void) override;
 
+  /** Apply the functor in an output pixel reused for the whole region */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 private:
   ShiftScaleVectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
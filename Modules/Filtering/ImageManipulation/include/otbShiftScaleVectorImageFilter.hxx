@@ -23,6 +23,8 @@
 #define otbShiftScaleVectorImageFilter_hxx
 
 #include "otbShiftScaleVectorImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
 
 namespace otb
 {
@@ -60,5 +62,34 @@ void ShiftScaleVectorImageFilter<TInputImage, TOutputImage>::BeforeThreadedGener
   this->GetFunctor().SetShiftValues(m_Shift);
 }
 
+template <class TInputImage, class TOutputImage>
+void ShiftScaleVectorImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                  itk::ThreadIdType             threadId)
+{
+  const TInputImage* inputPtr  = this->GetInput();
+  TOutputImage*      outputPtr = this->GetOutput();
+
+  typename TInputImage::RegionType inputRegionForThread;
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+
+  itk::ImageRegionConstIterator<TInputImage> inputIt(inputPtr, inputRegionForThread);
+  itk::ImageRegionIterator<TOutputImage>     outputIt(outputPtr, outputRegionForThread);
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  // Scratch pixel of the thread: the functor writes into it instead of
+  // returning a new pixel
+  OutputPixelType outputPixel(outputPtr->GetNumberOfComponentsPerPixel());
+
+  const FunctorType& functor = this->GetFunctor();
+
+  for (inputIt.GoToBegin(), outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    functor(outputPixel, inputIt.Get());
+    outputIt.Set(outputPixel);
+    progress.CompletedPixel();
+  }
+}
+
 } // end namespace otb
 #endif
@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSpectralAngleClassificationImageFilter_h
+#define otbSpectralAngleClassificationImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbSpectralAngleFunctor.h"
+
+#include <limits>
+
+namespace otb
+{
+/** \class SpectralAngleClassificationImageFilter
+ *  \brief Label each pixel with the reference pixel of lowest spectral angle
+ *
+ * The pixels are labeled from 1 to L, L being the number of reference
+ * pixels, with the index of the reference of lowest spectral angle, the
+ * first one in case of a tie. The pixels whose lowest angle is not below
+ * the threshold are set to the background value.
+ *
+ * This gives the labels of the minimum of the angles computed by the
+ * SpectralAngleMapperImageFilter without computing them all: the dot
+ * products of blocks of BlockSize pixels with all the references are
+ * computed as a matrix product, the lowest angle is the highest cosine,
+ * and the arc cosine is only computed for it.
+ *
+ * TInputImage is expected to be an otb::VectorImage type, and
+ * TOutputImage an otb::Image type.
+ *
+ * \sa SpectralAngleMapperImageFilter
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT SpectralAngleClassificationImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef SpectralAngleClassificationImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(SpectralAngleClassificationImageFilter, ImageToImageFilter);
+
+  /** Template parameters typedefs */
+  typedef TInputImage                          InputImageType;
+  typedef typename InputImageType::PixelType   InputPixelType;
+  typedef TOutputImage                         OutputImageType;
+  typedef typename OutputImageType::RegionType OutputImageRegionType;
+  typedef typename OutputImageType::PixelType  OutputPixelType;
+  typedef std::vector<InputPixelType>          ReferencePixelsType;
+
+  /** Set/Get the reference pixels */
+  void SetReferencePixels(const ReferencePixelsType& references)
+  {
+    m_ReferencePixels = references;
+    this->Modified();
+  }
+  const ReferencePixelsType& GetReferencePixels() const
+  {
+    return m_ReferencePixels;
+  }
+
+  /** Set/Get the angle (in radians) below which the pixels are classified */
+  itkSetMacro(Threshold, double);
+  itkGetConstMacro(Threshold, double);
+
+  /** Set/Get the label of the unclassified pixels */
+  itkSetMacro(BackgroundValue, OutputPixelType);
+  itkGetConstMacro(BackgroundValue, OutputPixelType);
+
+  /** Number of pixels of a row processed at once */
+  itkSetMacro(BlockSize, unsigned int);
+  itkGetConstMacro(BlockSize, unsigned int);
+
+protected:
+  SpectralAngleClassificationImageFilter();
+  ~SpectralAngleClassificationImageFilter() override
+  {
+  }
+
+  /** Pack the reference pixels */
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  SpectralAngleClassificationImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  ReferencePixelsType                                             m_ReferencePixels;
+  double                                                          m_Threshold;
+  OutputPixelType                                                 m_BackgroundValue;
+  unsigned int                                                    m_BlockSize;
+  Functor::SpectralAngleDetails::ReferenceSpectra<InputPixelType> m_References;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSpectralAngleClassificationImageFilter.hxx"
+#endif
+
+#endif
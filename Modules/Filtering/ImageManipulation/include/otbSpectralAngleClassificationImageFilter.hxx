@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSpectralAngleClassificationImageFilter_hxx
+#define otbSpectralAngleClassificationImageFilter_hxx
+
+#include "otbSpectralAngleClassificationImageFilter.h"
+#include "itkProgressReporter.h"
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+SpectralAngleClassificationImageFilter<TInputImage, TOutputImage>::SpectralAngleClassificationImageFilter()
+  : m_Threshold(std::numeric_limits<double>::max()), m_BackgroundValue(0), m_BlockSize(16)
+{
+}
+
+template <class TInputImage, class TOutputImage>
+void SpectralAngleClassificationImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  if (m_ReferencePixels.empty())
+  {
+    itkExceptionMacro(<< "Reference pixels are not set!");
+  }
+  if (m_BlockSize == 0)
+  {
+    itkExceptionMacro(<< "The block size must be positive");
+  }
+  m_References.SetReferences(m_ReferencePixels, this->GetInput()->GetNumberOfComponentsPerPixel());
+}
+
+template <class TInputImage, class TOutputImage>
+void SpectralAngleClassificationImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                             itk::ThreadIdType            threadId)
+{
+  const InputImageType* input        = this->GetInput();
+  OutputImageType*      output       = this->GetOutput();
+  const unsigned int    nbComponents = input->GetNumberOfComponentsPerPixel();
+  const std::size_t     nbReferences = m_References.GetNumberOfReferences();
+
+  const long         startX = outputRegionForThread.GetIndex()[0];
+  const long         startY = outputRegionForThread.GetIndex()[1];
+  const unsigned int width  = outputRegionForThread.GetSize()[0];
+  const unsigned int height = outputRegionForThread.GetSize()[1];
+
+  const typename InputImageType::RegionType& inputBuffered  = input->GetBufferedRegion();
+  const OutputImageRegionType&               outputBuffered = output->GetBufferedRegion();
+
+  std::vector<double>   cosines(m_BlockSize * nbReferences);
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  for (unsigned int row = 0; row < height; ++row)
+  {
+    const long y  = startY + row;
+    const auto in = input->GetBufferPointer() +
+                    ((y - inputBuffered.GetIndex()[1]) * inputBuffered.GetSize()[0] + (startX - inputBuffered.GetIndex()[0])) * nbComponents;
+    auto out = output->GetBufferPointer() + (y - outputBuffered.GetIndex()[1]) * outputBuffered.GetSize()[0] + (startX - outputBuffered.GetIndex()[0]);
+
+    for (unsigned int first = 0; first < width; first += m_BlockSize)
+    {
+      const unsigned int nbPixels = std::min(m_BlockSize, width - first);
+      m_References.ComputeCosines(in + first * nbComponents, nbPixels, nbComponents, cosines.data());
+
+      for (unsigned int i = 0; i < nbPixels; ++i)
+      {
+        const double* pixelCosines = &cosines[i * nbReferences];
+        const auto    best         = std::max_element(pixelCosines, pixelCosines + nbReferences);
+        out[first + i] =
+            std::acos(*best) < m_Threshold ? static_cast<OutputPixelType>(std::distance(pixelCosines, best) + 1) : m_BackgroundValue;
+        progress.CompletedPixel();
+      }
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void SpectralAngleClassificationImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of reference pixels: " << m_ReferencePixels.size() << std::endl;
+  os << indent << "Threshold: " << m_Threshold << std::endl;
+  os << indent << "BackgroundValue: " << static_cast<double>(m_BackgroundValue) << std::endl;
+  os << indent << "BlockSize: " << m_BlockSize << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -82,19 +82,25 @@ void SpectralAngleDistanceImageFilter<TInputImage, TOutputImage>::ThreadedGenera
   inputIt.GoToBegin();
   outputIt.GoToBegin();
 
+  // The squared norm of the reference does not depend on the pixel
+  const unsigned int nbComponents = inputPtr->GetNumberOfComponentsPerPixel();
+  double             normProd2    = 0.0;
+  for (unsigned int i = 0; i < nbComponents; ++i)
+  {
+    normProd2 += m_ReferencePixel[i] * m_ReferencePixel[i];
+  }
+
   while (!inputIt.IsAtEnd() && !outputIt.IsAtEnd())
   {
     double         dist       = 0.0;
     double         scalarProd = 0.0;
     double         normProd   = 0.0;
     double         normProd1  = 0.0;
-    double         normProd2  = 0.0;
     InputPixelType pixel      = inputIt.Get();
-    for (unsigned int i = 0; i < pixel.Size(); ++i)
+    for (unsigned int i = 0; i < nbComponents; ++i)
     {
       scalarProd += pixel[i] * m_ReferencePixel[i];
       normProd1 += pixel[i] * pixel[i];
-      normProd2 += m_ReferencePixel[i] * m_ReferencePixel[i];
     }
     normProd = normProd1 * normProd2;
 
@@ -25,6 +25,7 @@
 #include <algorithm>
 #include <vector>
 #include <numeric>
+#include <cmath>
 
 namespace otb
 {
@@ -55,6 +56,95 @@ TOutput ComputeSpectralAngle(TInput const & input, typename TInput ::ValueType c
   }
 }
 
+/** \class ReferenceSpectra
+ * \brief Reference pixels packed to compute their cosines with blocks of pixels.
+ *
+ * The values of the references are stored band by band, so that the dot
+ * products of a block of pixels with all the references are computed as
+ * a matrix product, whose inner loop runs over the references. Each band
+ * of the references is thus read once per block of pixels.
+ *
+ * The cosines follow the conventions of ComputeSpectralAngle: they are 1
+ * (a zero angle) when the product of the norms is below 1e-12 or when
+ * their ratio is above 1, and they are clamped to -1.
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class TReference>
+class ReferenceSpectra
+{
+public:
+  ReferenceSpectra() : m_NumberOfReferences(0), m_NumberOfBands(0)
+  {
+  }
+
+  /** Pack the first nbBands values of each reference */
+  void SetReferences(std::vector<TReference> const & references, unsigned int nbBands)
+  {
+    m_NumberOfReferences = references.size();
+    m_NumberOfBands      = nbBands;
+    m_Values.assign(m_NumberOfBands * m_NumberOfReferences, 0.);
+    m_Norms.resize(m_NumberOfReferences);
+    for (std::size_t j = 0; j < m_NumberOfReferences; ++j)
+    {
+      const unsigned int size = std::min(nbBands, references[j].Size());
+      for (unsigned int k = 0; k < size; ++k)
+      {
+        m_Values[k * m_NumberOfReferences + j] = references[j][k];
+      }
+      m_Norms[j] = references[j].GetNorm();
+    }
+  }
+
+  std::size_t GetNumberOfReferences() const
+  {
+    return m_NumberOfReferences;
+  }
+
+  /** Cosines between nbPixels consecutive pixels of nbComponents values and
+   * the references, written pixel by pixel in cosines */
+  template <class TValue>
+  void ComputeCosines(TValue const * pixels, unsigned int nbPixels, unsigned int nbComponents, double* cosines) const
+  {
+    const std::size_t  nbReferences = m_NumberOfReferences;
+    const unsigned int nbBands      = std::min(m_NumberOfBands, nbComponents);
+
+    std::fill(cosines, cosines + nbPixels * nbReferences, 0.);
+    for (unsigned int k = 0; k < nbBands; ++k)
+    {
+      const double* band = &m_Values[k * nbReferences];
+      for (unsigned int p = 0; p < nbPixels; ++p)
+      {
+        const double value = pixels[p * nbComponents + k];
+        double*      dot   = cosines + p * nbReferences;
+        for (std::size_t j = 0; j < nbReferences; ++j)
+        {
+          dot[j] += value * band[j];
+        }
+      }
+    }
+
+    for (unsigned int p = 0; p < nbPixels; ++p)
+    {
+      TValue const * pixel = pixels + p * nbComponents;
+      const double   norm  = std::sqrt(std::inner_product(pixel, pixel + nbComponents, pixel, 0.));
+      double*        cos   = cosines + p * nbReferences;
+      for (std::size_t j = 0; j < nbReferences; ++j)
+      {
+        const double normProd = norm * m_Norms[j];
+        const double ratio    = cos[j] / normProd;
+        cos[j]                = (normProd < 1.e-12 || ratio > 1) ? 1. : std::max(ratio, -1.);
+      }
+    }
+  }
+
+private:
+  std::size_t         m_NumberOfReferences;
+  unsigned int        m_NumberOfBands;
+  std::vector<double> m_Values;
+  std::vector<double> m_Norms;
+};
+
 } // end namespace SpectralAngleDetails
 
 /** \class SpectralAngleFunctor
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSpectralAngleMapperImageFilter_h
+#define otbSpectralAngleMapperImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbSpectralAngleFunctor.h"
+
+namespace otb
+{
+/** \class SpectralAngleMapperImageFilter
+ *  \brief Compute the spectral angles between each pixel and a set of reference pixels
+ *
+ * The output has one band per reference pixel, holding the same angles
+ * as the SpectralAngleMapperFunctor. Instead of an inner product per
+ * pixel and reference, the dot products of blocks of BlockSize pixels of
+ * a row with all the references are computed as a matrix product (see
+ * SpectralAngleDetails::ReferenceSpectra), which keeps a large number of
+ * references efficient.
+ *
+ * TInputImage and TOutputImage are expected to be otb::VectorImage types.
+ *
+ * \sa SpectralAngleMapperFunctor
+ * \sa SpectralAngleClassificationImageFilter
+ *
+ * \ingroup OTBImageManipulation
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT SpectralAngleMapperImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef SpectralAngleMapperImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(SpectralAngleMapperImageFilter, ImageToImageFilter);
+
+  /** Template parameters typedefs */
+  typedef TInputImage                                 InputImageType;
+  typedef typename InputImageType::PixelType          InputPixelType;
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+  typedef std::vector<InputPixelType>                 ReferencePixelsType;
+
+  /** Set/Get the reference pixels */
+  void SetReferencePixels(const ReferencePixelsType& references)
+  {
+    m_ReferencePixels = references;
+    this->Modified();
+  }
+  const ReferencePixelsType& GetReferencePixels() const
+  {
+    return m_ReferencePixels;
+  }
+
+  /** Number of pixels of a row processed at once */
+  itkSetMacro(BlockSize, unsigned int);
+  itkGetConstMacro(BlockSize, unsigned int);
+
+protected:
+  SpectralAngleMapperImageFilter();
+  ~SpectralAngleMapperImageFilter() override
+  {
+  }
+
+  /** One output band per reference pixel */
+  void GenerateOutputInformation() override;
+
+  /** Pack the reference pixels */
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  SpectralAngleMapperImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  ReferencePixelsType                                             m_ReferencePixels;
+  unsigned int                                                    m_BlockSize;
+  Functor::SpectralAngleDetails::ReferenceSpectra<InputPixelType> m_References;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSpectralAngleMapperImageFilter.hxx"
+#endif
+
+#endif
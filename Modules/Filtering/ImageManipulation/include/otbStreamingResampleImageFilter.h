@@ -23,7 +23,7 @@
 
 #include "itkImageToImageFilter.h"
 #include "otbStreamingWarpImageFilter.h"
-#include "itkTransformToDisplacementFieldSource.h"
+#include "otbAdaptiveTransformToDisplacementFieldSource.h"
 #include "itkLinearInterpolateImageFunction.h"
 #include "otbImage.h"
 #include "itkVector.h"
@@ -47,6 +47,11 @@ namespace otb
  * the  interpolator (SetInterpolator()) and the origin (SetOrigin())
  * can be set using the method between brackets.
  *
+ * When AdaptiveDisplacementField is on, the transform is only evaluated
+ * where the displacement grid is not locally bilinear within
+ * DisplacementFieldTolerance input pixels, the remaining nodes being
+ * interpolated (see otb::AdaptiveTransformToDisplacementFieldSource).
+ *
  *
  *
  * \ingroup Projection
@@ -83,7 +88,7 @@ public:
   typedef StreamingWarpImageFilter<InputImageType, OutputImageType, DisplacementFieldType> WarpImageFilterType;
 
   /** Internal filters typedefs*/
-  typedef itk::TransformToDisplacementFieldSource<DisplacementFieldType, double> DisplacementFieldGeneratorType;
+  typedef AdaptiveTransformToDisplacementFieldSource<DisplacementFieldType, double> DisplacementFieldGeneratorType;
   typedef typename DisplacementFieldGeneratorType::TransformType TransformType;
   typedef typename DisplacementFieldGeneratorType::SizeType      SizeType;
   typedef typename DisplacementFieldGeneratorType::SpacingType   SpacingType;
@@ -116,6 +121,39 @@ public:
     return m_SignedOutputSpacing;
   };
 
+  /** Evaluate the transform adaptively on the displacement field */
+  itkSetMacro(AdaptiveDisplacementField, bool);
+  itkGetConstMacro(AdaptiveDisplacementField, bool);
+  itkBooleanMacro(AdaptiveDisplacementField);
+
+  /** Size, in displacement field nodes, of the cells the adaptive refinement starts from */
+  itkSetMacro(DisplacementFieldCoarseCellSize, unsigned int);
+  itkGetConstMacro(DisplacementFieldCoarseCellSize, unsigned int);
+
+  /** Maximum interpolation error of the adaptive refinement, in input pixels */
+  itkSetMacro(DisplacementFieldTolerance, double);
+  itkGetConstMacro(DisplacementFieldTolerance, double);
+
+  /** Use a precomputed displacement field instead of evaluating the
+   *  transform. The field must have been generated for the same output
+   *  grid and displacement field spacing. */
+  void SetDisplacementField(const DisplacementFieldType* field)
+  {
+    m_PrecomputedDisplacementField = field;
+    this->Modified();
+  }
+
+  /** Get the displacement field used to warp the input: the precomputed
+   *  one if any, the internally generated one otherwise */
+  const DisplacementFieldType* GetDisplacementField() const
+  {
+    if (m_PrecomputedDisplacementField.IsNotNull())
+    {
+      return m_PrecomputedDisplacementField;
+    }
+    return m_DisplacementFilter->GetOutput();
+  }
+
   /** The resampled image parameters */
   // Output Origin
   void SetOutputOrigin(const OriginType& origin)
@@ -182,7 +220,12 @@ private:
   // spacing
   SpacingType m_SignedOutputSpacing;
 
+  bool         m_AdaptiveDisplacementField;
+  unsigned int m_DisplacementFieldCoarseCellSize;
+  double       m_DisplacementFieldTolerance;
+
   typename DisplacementFieldGeneratorType::Pointer m_DisplacementFilter;
+  typename DisplacementFieldType::ConstPointer     m_PrecomputedDisplacementField;
   typename WarpImageFilterType::Pointer            m_WarpFilter;
 };
 
@@ -25,11 +25,14 @@
 #include "itkProgressAccumulator.h"
 #include "otbImage.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
 template <class TInputImage, class TOutputImage, class TInterpolatorPrecisionType>
 StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecisionType>::StreamingResampleImageFilter()
+  : m_AdaptiveDisplacementField(false), m_DisplacementFieldCoarseCellSize(16), m_DisplacementFieldTolerance(0.1)
 {
   // internal filters instantiation
   m_DisplacementFilter  = DisplacementFieldGeneratorType::New();
@@ -88,6 +91,22 @@ void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecis
   m_DisplacementFilter->SetOutputSize(displacementFieldLargestSize);
   m_DisplacementFilter->SetOutputIndex(this->GetOutputStartIndex());
 
+  // The refinement tolerance is expressed in input pixels, the
+  // displacement field in input physical units
+  m_DisplacementFilter->SetAdaptiveRefinement(m_AdaptiveDisplacementField);
+  m_DisplacementFilter->SetCoarseCellSize(m_DisplacementFieldCoarseCellSize);
+  if (m_AdaptiveDisplacementField && this->GetInput())
+  {
+    const typename InputImageType::SpacingType& inputSpacing = this->GetInput()->GetSpacing();
+    double                                      minSpacing   = inputSpacing[0];
+    for (unsigned int dim = 1; dim < InputImageType::ImageDimension; ++dim)
+    {
+      minSpacing = std::min(minSpacing, inputSpacing[dim]);
+    }
+    m_DisplacementFilter->SetTolerance(m_DisplacementFieldTolerance * minSpacing);
+  }
+
+  m_WarpFilter->SetDisplacementField(this->GetDisplacementField());
   m_WarpFilter->SetInput(this->GetInput());
   m_WarpFilter->GraftOutput(this->GetOutput());
   m_WarpFilter->UpdateOutputInformation();
@@ -149,6 +168,9 @@ void StreamingResampleImageFilter<TInputImage, TOutputImage, TInterpolatorPrecis
   os << indent << "OutputSpacing: " << this->GetOutputSpacing() << std::endl;
   os << indent << "OutputStartIndex: " << this->GetOutputStartIndex() << std::endl;
   os << indent << "OutputSize: " << this->GetOutputSize() << std::endl;
+  os << indent << "AdaptiveDisplacementField: " << m_AdaptiveDisplacementField << std::endl;
+  os << indent << "DisplacementFieldCoarseCellSize: " << m_DisplacementFieldCoarseCellSize << std::endl;
+  os << indent << "DisplacementFieldTolerance: " << m_DisplacementFieldTolerance << std::endl;
 }
 }
 #endif
@@ -155,6 +155,15 @@ public:
     TOutput result;
     result.SetSize(x.GetSize());
 
+    (*this)(result, x);
+
+    return result;
+  }
+
+  // main computation method, in a result already sized as x (does not
+  // allocate)
+  inline void operator()(TOutput& result, const TInput& x) const
+  {
     // consistency checking
     if (result.GetSize() != m_OutputMinimum.GetSize() || result.GetSize() != m_OutputMaximum.GetSize() || result.GetSize() != m_InputMinimum.GetSize() ||
         result.GetSize() != m_InputMaximum.GetSize())
@@ -162,6 +171,9 @@ public:
       itkGenericExceptionMacro(<< "Pixel size different from scale or shift size !");
     }
 
+    const bool   useGamma     = m_Gamma != 1.;
+    const double inverseGamma = 1. / m_Gamma;
+
     // transformation
     for (unsigned int i = 0; i < x.GetSize(); ++i)
     {
@@ -180,12 +192,14 @@ public:
       else
       {
         RealType scaledComponent = static_cast<RealType>(x[i] - m_InputMinimum[i]) / static_cast<RealType>(m_InputMaximum[i] - m_InputMinimum[i]);
-        scaledComponent          = std::pow(scaledComponent, 1. / m_Gamma);
+        if (useGamma)
+        {
+          scaledComponent = std::pow(scaledComponent, inverseGamma);
+        }
         scaledComponent *= static_cast<RealType>(m_OutputMaximum[i] - m_OutputMinimum[i]);
         result[i] = static_cast<typename TOutput::ValueType>(scaledComponent + m_OutputMinimum[i]);
       }
     }
-    return result;
   }
 
 private:
@@ -238,6 +252,8 @@ public:
   typedef typename OutputPixelType::ValueType                    OutputValueType;
   typedef typename itk::NumericTraits<InputValueType>::RealType  InputRealType;
   typedef typename itk::NumericTraits<OutputValueType>::RealType OutputRealType;
+  typedef typename Superclass::FunctorType                       FunctorType;
+  typedef typename Superclass::OutputImageRegionType             OutputImageRegionType;
 
   /** Method for creation through the object factory. */
   itkNewMacro(Self);
@@ -271,6 +287,9 @@ public:
   /** Generate input requested region */
   void GenerateInputRequestedRegion(void) override;
 
+  /** Apply the functor in an output pixel reused for the whole region */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
   /** Print internal ivars */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -29,6 +29,8 @@
 #include "otbObjectList.h"
 #include "otbMacro.h"
 #include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
 
 namespace otb
 {
@@ -150,6 +152,35 @@ void VectorRescaleIntensityImageFilter<TInputImage, TOutputImage>::BeforeThreade
   this->GetFunctor().SetGamma(m_Gamma);
 }
 
+template <class TInputImage, class TOutputImage>
+void VectorRescaleIntensityImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                        itk::ThreadIdType             threadId)
+{
+  const TInputImage* inputPtr  = this->GetInput();
+  TOutputImage*      outputPtr = this->GetOutput();
+
+  typename TInputImage::RegionType inputRegionForThread;
+  this->CallCopyOutputRegionToInputRegion(inputRegionForThread, outputRegionForThread);
+
+  itk::ImageRegionConstIterator<TInputImage> inputIt(inputPtr, inputRegionForThread);
+  itk::ImageRegionIterator<TOutputImage>     outputIt(outputPtr, outputRegionForThread);
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  // Scratch pixel of the thread: the functor writes into it instead of
+  // returning a new pixel
+  OutputPixelType outputPixel(outputPtr->GetNumberOfComponentsPerPixel());
+
+  const FunctorType& functor = this->GetFunctor();
+
+  for (inputIt.GoToBegin(), outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++inputIt, ++outputIt)
+  {
+    functor(outputPixel, inputIt.Get());
+    outputIt.Set(outputPixel);
+    progress.CompletedPixel();
+  }
+}
+
 /**
  * Printself method
  */
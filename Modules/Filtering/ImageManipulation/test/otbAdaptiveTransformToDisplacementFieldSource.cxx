@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbAdaptiveTransformToDisplacementFieldSource.h"
+#include "otbTransform.h"
+#include "otbImage.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkVector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+
+/** Smooth warp with a localized bump, so that only part of the field
+ *  needs refinement */
+class BumpTransform : public otb::Transform<double, 2, 2>
+{
+public:
+  typedef BumpTransform                 Self;
+  typedef otb::Transform<double, 2, 2>  Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(BumpTransform, otb::Transform);
+
+  OutputPointType TransformPoint(const InputPointType& point) const override
+  {
+    const double dx   = point[0] - 150.;
+    const double dy   = point[1] - 100.;
+    const double bump = 8. * std::exp(-(dx * dx + dy * dy) / 400.);
+
+    OutputPointType result;
+    result[0] = 1.5 * point[0] + 0.2 * point[1] + 10. + bump;
+    result[1] = -0.3 * point[0] + 0.8 * point[1] - 5. + bump;
+    return result;
+  }
+
+protected:
+  BumpTransform() : Superclass(0)
+  {
+  }
+};
+
+} // namespace
+
+int otbAdaptiveTransformToDisplacementFieldSource(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef itk::Vector<double, 2>                                                 DisplacementType;
+  typedef otb::Image<DisplacementType, 2>                                        DisplacementFieldType;
+  typedef otb::AdaptiveTransformToDisplacementFieldSource<DisplacementFieldType> SourceType;
+
+  const double tolerance = 0.01;
+
+  BumpTransform::Pointer transform = BumpTransform::New();
+
+  DisplacementFieldType::SizeType size;
+  size[0] = 301;
+  size[1] = 203;
+  DisplacementFieldType::IndexType index;
+  index[0] = 3;
+  index[1] = -2;
+
+  SourceType::Pointer exact    = SourceType::New();
+  SourceType::Pointer adaptive = SourceType::New();
+  for (SourceType* source : {exact.GetPointer(), adaptive.GetPointer()})
+  {
+    source->SetTransform(transform);
+    source->SetOutputSize(size);
+    source->SetOutputIndex(index);
+  }
+  adaptive->AdaptiveRefinementOn();
+  adaptive->SetCoarseCellSize(32);
+  adaptive->SetTolerance(tolerance);
+
+  exact->Update();
+  adaptive->Update();
+
+  itk::ImageRegionConstIterator<DisplacementFieldType> exactIt(exact->GetOutput(), exact->GetOutput()->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<DisplacementFieldType> adaptiveIt(adaptive->GetOutput(), adaptive->GetOutput()->GetLargestPossibleRegion());
+
+  double maxError = 0.;
+  for (exactIt.GoToBegin(), adaptiveIt.GoToBegin(); !exactIt.IsAtEnd(); ++exactIt, ++adaptiveIt)
+  {
+    maxError = std::max(maxError, (exactIt.Get() - adaptiveIt.Get()).GetNorm());
+  }
+
+  std::cout << "Maximum displacement error: " << maxError << std::endl;
+
+  // The tolerance is only enforced on the control points of each cell
+  if (maxError > 10. * tolerance)
+  {
+    std::cerr << "Adaptive displacement field is too far from the exact one (" << maxError << ")" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The result must not depend on the threading layout
+  SourceType::Pointer singleThread = SourceType::New();
+  singleThread->SetTransform(transform);
+  singleThread->SetOutputSize(size);
+  singleThread->SetOutputIndex(index);
+  singleThread->AdaptiveRefinementOn();
+  singleThread->SetCoarseCellSize(32);
+  singleThread->SetTolerance(tolerance);
+  singleThread->SetNumberOfThreads(1);
+  singleThread->Update();
+
+  itk::ImageRegionConstIterator<DisplacementFieldType> singleIt(singleThread->GetOutput(), singleThread->GetOutput()->GetLargestPossibleRegion());
+  for (singleIt.GoToBegin(), adaptiveIt.GoToBegin(); !singleIt.IsAtEnd(); ++singleIt, ++adaptiveIt)
+  {
+    if (singleIt.Get() != adaptiveIt.Get())
+    {
+      std::cerr << "Adaptive displacement field depends on the number of threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImageFileReader.h"
+#include "otbMultiImageFileWriter.h"
+#include "otbVectorImage.h"
+#include "otbCascadedPyramidImageFilter.h"
+
+#include <sstream>
+
+// Write the levels once in a single piece and once by strips: the
+// cached rows must give the same levels as a full computation
+int otbCascadedPyramidImageFilter(int itkNotUsed(argc), char* argv[])
+{
+  const char*        inputFilename = argv[1];
+  const std::string  prefix        = argv[2];
+  const unsigned int nbLevels      = atoi(argv[3]);
+  const unsigned int nbStrips      = atoi(argv[4]);
+
+  typedef otb::VectorImage<float, 2>                 ImageType;
+  typedef otb::ImageFileReader<ImageType>            ReaderType;
+  typedef otb::CascadedPyramidImageFilter<ImageType> PyramidType;
+
+  for (unsigned int nbDivisions : {1u, nbStrips})
+  {
+    ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName(inputFilename);
+
+    PyramidType::Pointer pyramid = PyramidType::New();
+    pyramid->SetInput(reader->GetOutput());
+    pyramid->SetNumberOfLevels(nbLevels);
+    pyramid->SetShrinkFactor(2);
+    pyramid->SetVarianceFactor(0.6);
+
+    otb::MultiImageFileWriter::Pointer writer = otb::MultiImageFileWriter::New();
+    writer->SetNumberOfDivisionsStrippedStreaming(nbDivisions);
+    for (unsigned int level = 0; level < nbLevels; ++level)
+    {
+      std::ostringstream oss;
+      oss << prefix << (nbDivisions == 1 ? "_whole_" : "_strips_") << level + 1 << ".tif";
+      writer->AddInputImage(pyramid->GetOutput(level), oss.str());
+    }
+    writer->Update();
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,139 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbComposeTransformDisplacementFieldFilter.h"
+#include "otbTransform.h"
+#include "otbImage.h"
+#include "itkAffineTransform.h"
+#include "itkTransformToDisplacementFieldSource.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkVector.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace
+{
+
+/** Non linear transform standing for a ground to image mapping */
+class WaveTransform : public otb::Transform<double, 2, 2>
+{
+public:
+  typedef WaveTransform                 Self;
+  typedef otb::Transform<double, 2, 2>  Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(WaveTransform, otb::Transform);
+
+  OutputPointType TransformPoint(const InputPointType& point) const override
+  {
+    OutputPointType result;
+    result[0] = 0.5 * point[0] + 3. * std::sin(point[1] / 20.) - 4.;
+    result[1] = 0.7 * point[1] + 2. * std::cos(point[0] / 15.) + 12.;
+    return result;
+  }
+
+protected:
+  WaveTransform() : Superclass(0)
+  {
+  }
+};
+
+} // namespace
+
+int otbComposeTransformDisplacementFieldFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef itk::Vector<double, 2>                                              DisplacementType;
+  typedef otb::Image<DisplacementType, 2>                                     DisplacementFieldType;
+  typedef itk::TransformToDisplacementFieldSource<DisplacementFieldType>      SourceType;
+  typedef otb::ComposeTransformDisplacementFieldFilter<DisplacementFieldType> ComposeFilterType;
+  typedef itk::AffineTransform<double, 2>                                     AffineTransformType;
+
+  // First stage: reference image to ground
+  AffineTransformType::Pointer firstTransform = AffineTransformType::New();
+  AffineTransformType::MatrixType matrix;
+  matrix(0, 0) = 2.;
+  matrix(0, 1) = 0.3;
+  matrix(1, 0) = -0.2;
+  matrix(1, 1) = 1.5;
+  firstTransform->SetMatrix(matrix);
+  AffineTransformType::OutputVectorType translation;
+  translation[0] = 100.;
+  translation[1] = -50.;
+  firstTransform->SetTranslation(translation);
+
+  // Second stage: ground to moving image
+  WaveTransform::Pointer secondTransform = WaveTransform::New();
+
+  DisplacementFieldType::SizeType size;
+  size[0] = 57;
+  size[1] = 43;
+  DisplacementFieldType::IndexType index;
+  index[0] = -5;
+  index[1] = 7;
+  DisplacementFieldType::SpacingType spacing;
+  spacing[0] = 2.5;
+  spacing[1] = 4.;
+  DisplacementFieldType::PointType origin;
+  origin[0] = 10.;
+  origin[1] = -20.;
+
+  SourceType::Pointer source = SourceType::New();
+  source->SetTransform(firstTransform);
+  source->SetOutputSize(size);
+  source->SetOutputIndex(index);
+  source->SetOutputSpacing(spacing);
+  source->SetOutputOrigin(origin);
+
+  ComposeFilterType::Pointer compose = ComposeFilterType::New();
+  compose->SetInput(source->GetOutput());
+  compose->SetTransform(secondTransform);
+  compose->Update();
+
+  const DisplacementFieldType* output = compose->GetOutput();
+
+  itk::ImageRegionConstIteratorWithIndex<DisplacementFieldType> it(output, output->GetLargestPossibleRegion());
+
+  double maxError = 0.;
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    DisplacementFieldType::PointType point;
+    output->TransformIndexToPhysicalPoint(it.GetIndex(), point);
+
+    WaveTransform::OutputPointType expected = secondTransform->TransformPoint(firstTransform->TransformPoint(point));
+    for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+      maxError = std::max(maxError, std::abs(point[dim] + it.Get()[dim] - expected[dim]));
+    }
+  }
+
+  std::cout << "Maximum composition error: " << maxError << std::endl;
+
+  if (maxError > 1e-9)
+  {
+    std::cerr << "Composed displacement field does not match the composed transforms (" << maxError << ")" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
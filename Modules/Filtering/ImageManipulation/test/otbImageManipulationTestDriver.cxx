@@ -29,12 +29,15 @@ void RegisterTests()
   REGISTER_TEST(otbFunctionWithNeighborhoodToImageFilter);
   REGISTER_TEST(otbSqrtSpectralAngleImageFilter);
   REGISTER_TEST(otbStreamingShrinkImageFilter);
+  REGISTER_TEST(otbCascadedPyramidImageFilter);
   REGISTER_TEST(otbUnaryImageFunctorWithVectorImageFilter);
   REGISTER_TEST(otbPrintableImageFilterWithMask);
   REGISTER_TEST(otbStreamingResampleImageFilter);
   REGISTER_TEST(otbVectorImageToAmplitudeImageFilter);
   REGISTER_TEST(otbUnaryFunctorNeighborhoodWithOffsetImageFilter);
   REGISTER_TEST(otbStreamingResampleImageFilterCompareWithITK);
+  REGISTER_TEST(otbAdaptiveTransformToDisplacementFieldSource);
+  REGISTER_TEST(otbComposeTransformDisplacementFieldFilter);
   REGISTER_TEST(otbRegionProjectionResampler);
   REGISTER_TEST(otbUnaryFunctorWithIndexImageFilter);
   REGISTER_TEST(otbMeanFunctorImageTest);
@@ -62,6 +65,7 @@ void RegisterTests()
   REGISTER_TEST(otbConcatenateVectorImageFilter);
   REGISTER_TEST(otbBinaryImageToDensityImageFilter);
   REGISTER_TEST(otbSpectralAngleDistanceImageFilter);
+  REGISTER_TEST(otbSpectralAngleMapperImageFilter);
   REGISTER_TEST(otbEuclideanDistanceMetricWithMissingValue);
   REGISTER_TEST(otbNRIBandImagesToOneNComplexBandsImage);
   REGISTER_TEST(otbOneRIBandImageToOneComplexBandImage);
@@ -0,0 +1,126 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbFunctorImageFilter.h"
+#include "otbSpectralAngleMapperImageFilter.h"
+#include "otbSpectralAngleClassificationImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+int otbSpectralAngleMapperImageFilter(int itkNotUsed(argc), char* argv[])
+{
+  typedef float                          PixelType;
+  typedef otb::VectorImage<PixelType, 2> ImageType;
+  typedef ImageType::PixelType           VectorPixelType;
+  typedef otb::Image<int, 2>             LabelImageType;
+  typedef otb::ImageFileReader<ImageType> ReaderType;
+  typedef otb::Functor::SpectralAngleMapperFunctor<VectorPixelType, VectorPixelType, VectorPixelType> FunctorType;
+  typedef otb::FunctorImageFilter<FunctorType>                                   FunctorFilterType;
+  typedef otb::SpectralAngleMapperImageFilter<ImageType, ImageType>              MapperFilterType;
+  typedef otb::SpectralAngleClassificationImageFilter<ImageType, LabelImageType> ClassificationFilterType;
+
+  const double threshold = 0.1;
+  const int    bv        = -1;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->Update();
+  ImageType::Pointer image = reader->GetOutput();
+
+  // A few pixels of the image as references
+  std::vector<VectorPixelType> references;
+  const ImageType::SizeType    size = image->GetLargestPossibleRegion().GetSize();
+  for (unsigned int i = 0; i < 5; ++i)
+  {
+    ImageType::IndexType index;
+    index[0] = (i * 37) % size[0];
+    index[1] = (i * 53) % size[1];
+    references.push_back(image->GetPixel(index));
+  }
+
+  FunctorFilterType::Pointer functorFilter = FunctorFilterType::New();
+  functorFilter->GetModifiableFunctor().SetReferencePixels(references);
+  functorFilter->SetInput(image);
+  functorFilter->Update();
+
+  MapperFilterType::Pointer mapperFilter = MapperFilterType::New();
+  mapperFilter->SetReferencePixels(references);
+  mapperFilter->SetBlockSize(7);
+  mapperFilter->SetInput(image);
+  mapperFilter->Update();
+
+  ClassificationFilterType::Pointer classificationFilter = ClassificationFilterType::New();
+  classificationFilter->SetReferencePixels(references);
+  classificationFilter->SetThreshold(threshold);
+  classificationFilter->SetBackgroundValue(bv);
+  classificationFilter->SetInput(image);
+  classificationFilter->Update();
+
+  if (mapperFilter->GetOutput()->GetNumberOfComponentsPerPixel() != references.size())
+  {
+    std::cerr << "Wrong number of bands: " << mapperFilter->GetOutput()->GetNumberOfComponentsPerPixel() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  itk::ImageRegionConstIterator<ImageType>      refIt(functorFilter->GetOutput(), image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<ImageType>      mapperIt(mapperFilter->GetOutput(), image->GetLargestPossibleRegion());
+  itk::ImageRegionConstIterator<LabelImageType> labelIt(classificationFilter->GetOutput(), image->GetLargestPossibleRegion());
+
+  unsigned int nbErrors = 0;
+  for (refIt.GoToBegin(), mapperIt.GoToBegin(), labelIt.GoToBegin(); !refIt.IsAtEnd(); ++refIt, ++mapperIt, ++labelIt)
+  {
+    const VectorPixelType angles = refIt.Get();
+    const VectorPixelType mapped = mapperIt.Get();
+    for (unsigned int j = 0; j < angles.Size(); ++j)
+    {
+      if (std::abs(angles[j] - mapped[j]) > 1e-4)
+      {
+        std::cerr << "Angle " << j << " at " << refIt.GetIndex() << ": " << mapped[j] << " instead of " << angles[j] << std::endl;
+        ++nbErrors;
+      }
+    }
+
+    // The lowest angle is compared with a tolerance, as two nearly equal
+    // angles may be ordered differently
+    const auto   minElem = std::min_element(&angles[0], &angles[angles.Size()]);
+    const int    label   = labelIt.Get();
+    const double angle   = label == bv ? threshold : angles[label - 1];
+    if ((label == bv && *minElem < threshold - 1e-4) || (label != bv && (angle > *minElem + 1e-4 || angle >= threshold + 1e-4)))
+    {
+      std::cerr << "Label at " << refIt.GetIndex() << ": " << label << " instead of " << std::distance(&angles[0], minElem) + 1 << std::endl;
+      ++nbErrors;
+    }
+  }
+
+  if (nbErrors > 0)
+  {
+    std::cerr << nbErrors << " errors" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -24,6 +24,7 @@
 #include "itkImageToImageFilter.h"
 #include "itkImage.h"
 #include "itkNumericTraits.h"
+#include "itkProgressReporter.h"
 
 namespace otb
 {
@@ -40,6 +41,10 @@ namespace otb
  *
  * (http://www.isprs.org/proceedings/XXXV/congress/comm2/papers/110.pdf)
  *
+ * When both radii reach IntegralImageMinimumRadius (2 by default), the
+ * local mean and variance are read from summed-area tables; the kernel
+ * itself still visits the whole neighborhood.
+ *
  * \ingroup OTBImageNoise
  */
 
@@ -91,6 +96,10 @@ public:
   /** Get the damping factor. */
   itkGetConstReferenceMacro(Deramp, double);
 
+  /** Set/Get the smallest radius processed with summed-area tables */
+  itkSetMacro(IntegralImageMinimumRadius, unsigned int);
+  itkGetMacro(IntegralImageMinimumRadius, unsigned int);
+
   /** To be allowed to use the pipeline method FrostImageFilter needs
     * an input processing area larger than the output one.
     * \sa ImageToImageFilter::GenerateInputRequestedRegion() */
@@ -113,6 +122,9 @@ protected:
    *     ImageToImageFilter::GenerateData() */
   void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Summed-area table version of ThreadedGenerateData() */
+  void IntegralImageGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ProgressReporter& progress);
+
 private:
   FrostImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -121,6 +133,8 @@ private:
   SizeType m_Radius;
   /** Decrease factor declaration */
   double m_Deramp;
+  /** Smallest radius processed with summed-area tables */
+  unsigned int m_IntegralImageMinimumRadius;
 };
 } // end namespace otb
 
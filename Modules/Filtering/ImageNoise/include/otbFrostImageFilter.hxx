@@ -30,6 +30,8 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
+#include "otbSpeckleLocalStatistics.h"
+#include <vector>
 
 namespace otb
 {
@@ -41,7 +43,8 @@ template <class TInputImage, class TOutputImage>
 FrostImageFilter<TInputImage, TOutputImage>::FrostImageFilter()
 {
   m_Radius.Fill(1);
-  m_Deramp = 2;
+  m_Deramp                     = 2;
+  m_IntegralImageMinimumRadius = 2;
 }
 
 template <class TInputImage, class TOutputImage>
@@ -95,6 +98,15 @@ void FrostImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
 template <class TInputImage, class TOutputImage>
 void FrostImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  if (std::min(m_Radius[0], m_Radius[1]) >= m_IntegralImageMinimumRadius)
+  {
+    IntegralImageGenerateData(outputRegionForThread, progress);
+    return;
+  }
+
   unsigned int                                                        i;
   itk::ZeroFluxNeumannBoundaryCondition<InputImageType>               nbc;
   itk::ConstNeighborhoodIterator<InputImageType>                      bit;
@@ -112,9 +124,6 @@ void FrostImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const Out
   itk::NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType> bC;
   faceList = bC(input, outputRegionForThread, m_Radius);
 
-  // support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
-
   InputRealType sum;
   InputRealType sum2;
 
@@ -203,6 +212,93 @@ void FrostImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const Out
   }
 }
 
+template <class TInputImage, class TOutputImage>
+void FrostImageFilter<TInputImage, TOutputImage>::IntegralImageGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                            itk::ProgressReporter&       progress)
+{
+  typename OutputImageType::Pointer     output = this->GetOutput();
+  typename InputImageType::ConstPointer input  = this->GetInput();
+
+  const InputImageRegionType&              buffered = input->GetBufferedRegion();
+  const typename InputImageType::IndexType first    = buffered.GetIndex();
+  const typename InputImageType::IndexType last     = buffered.GetUpperIndex();
+  const InputPixelType*                    buffer   = input->GetBufferPointer();
+  const itk::SizeValueType                 stride   = buffered.GetSize()[0];
+
+  const int rad_x = m_Radius[0];
+  const int rad_y = m_Radius[1];
+
+  // Distances to the center, in the same order as the direct kernel
+  std::vector<double> distances;
+  for (int x = -rad_x; x <= rad_x; ++x)
+  {
+    for (int y = -rad_y; y <= rad_y; ++y)
+    {
+      distances.push_back(std::sqrt(static_cast<double>(x * x + y * y)));
+    }
+  }
+
+  // Rows and columns of the kernel, replicated at the buffer borders
+  std::vector<const InputPixelType*> rows(2 * rad_y + 1);
+  std::vector<itk::OffsetValueType>  columns;
+
+  SpeckleLocalStatistics<InputImageType>::ProcessRegion(
+      input, outputRegionForThread, m_Radius,
+      [&](const typename InputImageType::IndexType& index, unsigned int length, const double* means, const double* variances) {
+        for (int y = -rad_y; y <= rad_y; ++y)
+        {
+          const itk::IndexValueType row = std::min(std::max(index[1] + y, first[1]), last[1]);
+          rows[y + rad_y]               = buffer + (row - first[1]) * stride;
+        }
+        columns.resize(length + 2 * rad_x);
+        for (unsigned int c = 0; c < columns.size(); ++c)
+        {
+          columns[c] = std::min(std::max(index[0] - rad_x + static_cast<itk::IndexValueType>(c), first[0]), last[0]) - first[0];
+        }
+
+        OutputPixelType* out = output->GetBufferPointer() + output->ComputeOffset(index);
+        for (unsigned int c = 0; c < length; ++c)
+        {
+          const double Mean     = means[c];
+          const double Variance = variances[c];
+          double       dPixel;
+
+          const double epsilon = 0.0000000001;
+          if (std::abs(Mean) < epsilon)
+          {
+            dPixel = itk::NumericTraits<OutputPixelType>::Zero;
+          }
+          else if (std::abs(Variance) < epsilon)
+          {
+            dPixel = Mean;
+          }
+          else
+          {
+            const double Alpha = m_Deramp * Variance / (Mean * Mean);
+
+            double        NormFilter  = 0.0;
+            double        FrostFilter = 0.0;
+            const double* dist        = distances.data();
+            for (int x = 0; x <= 2 * rad_x; ++x)
+            {
+              const itk::OffsetValueType column = columns[c + x];
+              for (int y = 0; y <= 2 * rad_y; ++y, ++dist)
+              {
+                const double CoefFilter = std::exp(-Alpha * *dist);
+                NormFilter += CoefFilter;
+                FrostFilter += CoefFilter * static_cast<double>(rows[y][column]);
+              }
+            }
+
+            dPixel = FrostFilter / NormFilter;
+          }
+
+          out[c] = static_cast<OutputPixelType>(dPixel);
+          progress.CompletedPixel();
+        }
+      });
+}
+
 /**
  * Standard "PrintSelf" method
  */
@@ -211,6 +307,7 @@ void FrostImageFilter<TInputImage, TOutput>::PrintSelf(std::ostream& os, itk::In
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "IntegralImageMinimumRadius: " << m_IntegralImageMinimumRadius << std::endl;
 }
 
 } // end namespace otb
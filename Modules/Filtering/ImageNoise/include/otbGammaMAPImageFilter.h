@@ -24,6 +24,7 @@
 #include "itkImageToImageFilter.h"
 #include "itkImage.h"
 #include "itkNumericTraits.h"
+#include "itkProgressReporter.h"
 
 namespace otb
 {
@@ -36,6 +37,10 @@ namespace otb
  *
  * (http://www.isprs.org/proceedings/XXXV/congress/comm2/papers/110.pdf)
  *
+ * When both radii reach IntegralImageMinimumRadius (2 by default), the
+ * local mean and variance are read from summed-area tables, so that the
+ * cost per pixel does not depend on the radius.
+ *
  * \ingroup OTBImageNoise
  */
 
@@ -80,6 +85,10 @@ public:
   /** Getthe number of look used for computation */
   itkGetConstReferenceMacro(NbLooks, double);
 
+  /** Set/Get the smallest radius processed with summed-area tables */
+  itkSetMacro(IntegralImageMinimumRadius, unsigned int);
+  itkGetMacro(IntegralImageMinimumRadius, unsigned int);
+
   /** GammaMAPImageFilter needs a larger input requested region than
    * the output requested region.  As such, GammaMAPImageFilter needs
    * to provide an implementation for GenerateInputRequestedRegion()
@@ -100,14 +109,22 @@ protected:
 
   void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Summed-area table version of ThreadedGenerateData() */
+  void IntegralImageGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ProgressReporter& progress);
+
 private:
   GammaMAPImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Estimated reflectivity of pixel I from the local mean and variance */
+  double EstimateReflectivity(double I, double E_I, double Var_I, double Cu2) const;
+
   /** Radius of the filter */
   SizeType m_Radius;
   /** Number of look of the filter */
   double m_NbLooks;
+  /** Smallest radius processed with summed-area tables */
+  unsigned int m_IntegralImageMinimumRadius;
 };
 } // end namespace otb
 
@@ -30,6 +30,7 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
+#include "otbSpeckleLocalStatistics.h"
 
 namespace otb
 {
@@ -42,6 +43,7 @@ KuanImageFilter<TInputImage, TOutputImage>::KuanImageFilter()
 {
   m_Radius.Fill(1);
   SetNbLooks(1.0);
+  m_IntegralImageMinimumRadius = 2;
 }
 
 template <class TInputImage, class TOutputImage>
@@ -95,6 +97,15 @@ void KuanImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
 template <class TInputImage, class TOutputImage>
 void KuanImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  if (std::min(m_Radius[0], m_Radius[1]) >= m_IntegralImageMinimumRadius)
+  {
+    IntegralImageGenerateData(outputRegionForThread, progress);
+    return;
+  }
+
   unsigned int                                          i;
   itk::ZeroFluxNeumannBoundaryCondition<InputImageType> nbc;
 
@@ -111,14 +122,11 @@ void KuanImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const Outp
   itk::NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType> bC;
   faceList = bC(input, outputRegionForThread, m_Radius);
 
-  // support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
-
   //  InputRealType pixel;
   InputRealType sum;
   InputRealType sum2;
 
-  double Ci2, Cu2, w, E_I, I, Var_I, dPixel;
+  double Cu2, E_I, I, Var_I, dPixel;
 
   // Compute the ratio using the number of looks
   Cu2 = 1.0 / m_NbLooks;
@@ -158,26 +166,7 @@ void KuanImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const Outp
 
       I = static_cast<double>(bit.GetCenterPixel());
 
-      Ci2 = Var_I / (E_I * E_I);
-
-      const double epsilon = 0.0000000001;
-      if (std::abs(E_I) < epsilon)
-      {
-        dPixel = itk::NumericTraits<OutputPixelType>::Zero;
-      }
-      else if (std::abs(Var_I) < epsilon)
-      {
-        dPixel = E_I;
-      }
-      else if (Ci2 < Cu2)
-      {
-        dPixel = E_I;
-      }
-      else
-      {
-        w      = (1 - Cu2 / Ci2) / (1 + Cu2);
-        dPixel = I * w + E_I * (1 - w);
-      }
+      dPixel = EstimateReflectivity(I, E_I, Var_I, Cu2);
 
       // set the weighted value
       it.Set(static_cast<OutputPixelType>(dPixel));
@@ -190,6 +179,52 @@ void KuanImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const Outp
   }
 }
 
+template <class TInputImage, class TOutputImage>
+void KuanImageFilter<TInputImage, TOutputImage>::IntegralImageGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                           itk::ProgressReporter&       progress)
+{
+  typename OutputImageType::Pointer     output = this->GetOutput();
+  typename InputImageType::ConstPointer input  = this->GetInput();
+
+  // Compute the ratio using the number of looks
+  const double Cu2 = 1.0 / m_NbLooks;
+
+  SpeckleLocalStatistics<InputImageType>::ProcessRegion(
+      input, outputRegionForThread, m_Radius,
+      [&](const typename InputImageType::IndexType& index, unsigned int length, const double* means, const double* variances) {
+        const InputPixelType* in  = input->GetBufferPointer() + input->ComputeOffset(index);
+        OutputPixelType*      out = output->GetBufferPointer() + output->ComputeOffset(index);
+        for (unsigned int x = 0; x < length; ++x)
+        {
+          out[x] = static_cast<OutputPixelType>(EstimateReflectivity(static_cast<double>(in[x]), means[x], variances[x], Cu2));
+          progress.CompletedPixel();
+        }
+      });
+}
+
+template <class TInputImage, class TOutputImage>
+double KuanImageFilter<TInputImage, TOutputImage>::EstimateReflectivity(double I, double E_I, double Var_I, double Cu2) const
+{
+  const double Ci2 = Var_I / (E_I * E_I);
+
+  const double epsilon = 0.0000000001;
+  if (std::abs(E_I) < epsilon)
+  {
+    return itk::NumericTraits<OutputPixelType>::Zero;
+  }
+  else if (std::abs(Var_I) < epsilon)
+  {
+    return E_I;
+  }
+  else if (Ci2 < Cu2)
+  {
+    return E_I;
+  }
+
+  const double w = (1 - Cu2 / Ci2) / (1 + Cu2);
+  return I * w + E_I * (1 - w);
+}
+
 /**
  * Standard "PrintSelf" method
  */
@@ -198,6 +233,7 @@ void KuanImageFilter<TInputImage, TOutput>::PrintSelf(std::ostream& os, itk::Ind
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "IntegralImageMinimumRadius: " << m_IntegralImageMinimumRadius << std::endl;
 }
 
 } // end namespace otb
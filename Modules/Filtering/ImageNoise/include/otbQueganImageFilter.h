@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbQueganImageFilter_h
+#define otbQueganImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkProgressReporter.h"
+
+namespace otb
+{
+
+/** \class QueganImageFilter
+ * \brief Multitemporal anti-speckle image filter
+ *
+ * This class implements the multitemporal filter of Quegan for a stack
+ * of N co-registered SAR intensity images, each band of the input being
+ * one date. The filtered image of date k is computed as follows:
+ *
+ * J_k = E[I_k]/N * sum_i I_i/E[I_i]
+ *
+ * where E[I_i] is the local mean of date i over the neighborhood of the
+ * given radius. Dates with a null local mean are left out of the
+ * average.
+ *
+ * All the dates are read once, and the local means are computed in
+ * constant time per pixel from summed-area tables.
+ *
+ * (S. Quegan and J. J. Yu, Filtering of multichannel SAR images,
+ * IEEE Transactions on Geoscience and Remote Sensing, 39(11), 2001)
+ *
+ * \sa SpeckleLocalStatistics
+ *
+ * \ingroup OTBImageNoise
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT QueganImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  typedef TInputImage  InputImageType;
+  typedef TOutputImage OutputImageType;
+
+  /** standard class typedefs */
+  typedef QueganImageFilter Self;
+  typedef itk::ImageToImageFilter<InputImageType, OutputImageType> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Object factory management */
+  itkNewMacro(Self);
+
+  /** typemacro */
+  itkTypeMacro(QueganImageFilter, ImageToImageFilter);
+
+  typedef typename InputImageType::InternalPixelType  InputPixelType;
+  typedef typename OutputImageType::InternalPixelType OutputPixelType;
+  typedef typename InputImageType::RegionType         InputImageRegionType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename InputImageType::IndexType          IndexType;
+  typedef typename InputImageType::SizeType           SizeType;
+
+  /** Set the radius of the neighborhood used to compute the local means */
+  itkSetMacro(Radius, SizeType);
+
+  /** Get the radius of the neighborhood used to compute the local means */
+  itkGetConstReferenceMacro(Radius, SizeType);
+
+  /** The output has one band per input date */
+  void GenerateOutputInformation() override;
+
+  /** QueganImageFilter needs a larger input requested region than the
+   * output requested region.
+   *
+   * \sa ImageToImageFilter::GenerateInputRequestedRegion() */
+  void GenerateInputRequestedRegion() override;
+
+protected:
+  QueganImageFilter();
+  ~QueganImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  QueganImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Radius of the filter */
+  SizeType m_Radius;
+};
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbQueganImageFilter.hxx"
+#endif
+
+#endif
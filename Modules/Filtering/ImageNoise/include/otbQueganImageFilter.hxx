@@ -0,0 +1,178 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbQueganImageFilter_hxx
+#define otbQueganImageFilter_hxx
+
+#include "otbQueganImageFilter.h"
+#include "otbSpeckleLocalStatistics.h"
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+QueganImageFilter<TInputImage, TOutputImage>::QueganImageFilter()
+{
+  m_Radius.Fill(1);
+}
+
+template <class TInputImage, class TOutputImage>
+void QueganImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  this->GetOutput()->SetNumberOfComponentsPerPixel(this->GetInput()->GetNumberOfComponentsPerPixel());
+}
+
+template <class TInputImage, class TOutputImage>
+void QueganImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  // call the superclass' implementation of this method
+  Superclass::GenerateInputRequestedRegion();
+
+  // get pointers to the input and output
+  typename Superclass::InputImagePointer  inputPtr  = const_cast<TInputImage*>(this->GetInput());
+  typename Superclass::OutputImagePointer outputPtr = this->GetOutput();
+
+  if (!inputPtr || !outputPtr)
+  {
+    return;
+  }
+
+  // pad the input requested region by the operator radius
+  InputImageRegionType inputRequestedRegion = inputPtr->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(m_Radius);
+
+  // crop the input requested region at the input's largest possible region
+  if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+    return;
+  }
+  else
+  {
+    // store what we tried to request (prior to trying to crop)
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+    // build an exception
+    itk::InvalidRequestedRegionError e(__FILE__, __LINE__);
+    std::ostringstream               msg;
+    msg << static_cast<const char*>(this->GetNameOfClass()) << "::GenerateInputRequestedRegion()";
+    e.SetLocation(msg.str());
+    e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+    e.SetDataObject(inputPtr);
+    throw e;
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void QueganImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  typename OutputImageType::Pointer     output = this->GetOutput();
+  typename InputImageType::ConstPointer input  = this->GetInput();
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  const unsigned int nbDates = input->GetNumberOfComponentsPerPixel();
+  const double       epsilon = 0.0000000001;
+
+  // The local means of all the dates are kept for one tile at a time
+  const itk::SizeValueType tileSize = 64;
+  std::vector<double>      means(nbDates * tileSize * tileSize);
+
+  const IndexType start  = outputRegionForThread.GetIndex();
+  const SizeType  extent = outputRegionForThread.GetSize();
+
+  for (itk::SizeValueType ty = 0; ty < extent[1]; ty += tileSize)
+  {
+    for (itk::SizeValueType tx = 0; tx < extent[0]; tx += tileSize)
+    {
+      OutputImageRegionType tile;
+      tile.SetIndex(0, start[0] + tx);
+      tile.SetIndex(1, start[1] + ty);
+      tile.SetSize(0, std::min(tileSize, extent[0] - tx));
+      tile.SetSize(1, std::min(tileSize, extent[1] - ty));
+
+      const IndexType          origin = tile.GetIndex();
+      const itk::SizeValueType width  = tile.GetSize()[0];
+
+      for (unsigned int date = 0; date < nbDates; ++date)
+      {
+        double* dateMeans = &means[date * tileSize * tileSize];
+        auto    store     = [&](const IndexType& index, unsigned int length, const double* lineMeans, const double*) {
+          std::copy(lineMeans, lineMeans + length, dateMeans + (index[1] - origin[1]) * width);
+        };
+        SpeckleLocalStatistics<InputImageType>::ProcessRegion(input, tile, m_Radius, store, date);
+      }
+
+      IndexType index = origin;
+      for (itk::SizeValueType y = 0; y < tile.GetSize()[1]; ++y, ++index[1])
+      {
+        const InputPixelType* in  = input->GetBufferPointer() + input->ComputeOffset(index) * nbDates;
+        OutputPixelType*      out = output->GetBufferPointer() + output->ComputeOffset(index) * nbDates;
+
+        for (itk::SizeValueType x = 0; x < width; ++x, in += nbDates, out += nbDates)
+        {
+          const std::size_t pos = y * width + x;
+
+          // Temporal average of the ratios to the local means
+          double       ratio   = 0.;
+          unsigned int nbValid = 0;
+          for (unsigned int date = 0; date < nbDates; ++date)
+          {
+            const double mean = means[date * tileSize * tileSize + pos];
+            if (std::abs(mean) >= epsilon)
+            {
+              ratio += static_cast<double>(in[date]) / mean;
+              ++nbValid;
+            }
+          }
+          if (nbValid > 0)
+          {
+            ratio /= nbValid;
+          }
+
+          for (unsigned int date = 0; date < nbDates; ++date)
+          {
+            out[date] = static_cast<OutputPixelType>(means[date * tileSize * tileSize + pos] * ratio);
+          }
+          progress.CompletedPixel();
+        }
+      }
+    }
+  }
+}
+
+/**
+ * Standard "PrintSelf" method
+ */
+template <class TInputImage, class TOutputImage>
+void QueganImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Radius: " << m_Radius << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,67 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSpeckleLocalStatistics_h
+#define otbSpeckleLocalStatistics_h
+
+#include "otbSummedAreaTable.h"
+
+namespace otb
+{
+
+/** \class SpeckleLocalStatistics
+ * \brief Local mean and variance of the neighborhoods of a region, in constant time per pixel.
+ *
+ * ProcessRegion() splits a region into square tiles, builds summed-area
+ * tables of each tile padded by the radius, and hands the local mean and
+ * unbiased variance of each line of the tile to a function:
+ *
+ * function(index, length, means, variances)
+ *
+ * where index is the first pixel of the line and means and variances hold
+ * length values. For multi-component images, the statistics are those of
+ * the given band. Borders are replicated as with the
+ * itk::ZeroFluxNeumannBoundaryCondition. This is the statistics step shared
+ * by the Lee, Frost, Kuan and GammaMAP filters.
+ *
+ * \sa SummedAreaTable
+ *
+ * \ingroup OTBImageNoise
+ */
+template <class TInputImage>
+class SpeckleLocalStatistics
+{
+public:
+  typedef TInputImage                    ImageType;
+  typedef typename ImageType::RegionType RegionType;
+  typedef typename ImageType::IndexType  IndexType;
+  typedef typename ImageType::SizeType   SizeType;
+
+  template <class TFunction>
+  static void ProcessRegion(const ImageType* image, const RegionType& region, const SizeType& radius, TFunction function, unsigned int band = 0);
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSpeckleLocalStatistics.hxx"
+#endif
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSpeckleLocalStatistics_hxx
+#define otbSpeckleLocalStatistics_hxx
+
+#include "otbSpeckleLocalStatistics.h"
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage>
+template <class TFunction>
+void SpeckleLocalStatistics<TInputImage>::ProcessRegion(const ImageType* image, const RegionType& region, const SizeType& radius, TFunction function,
+                                                        unsigned int band)
+{
+  // Tiles bound the magnitude of the sums, at the cost of recomputing
+  // the overlap of their padded regions
+  const itk::SizeValueType tileSize = std::max<itk::SizeValueType>(64, 2 * std::max(radius[0], radius[1]) + 1);
+  const double             num      = static_cast<double>((2 * radius[0] + 1) * (2 * radius[1] + 1));
+
+  SummedAreaTable<ImageType, 2> table;
+  double                        sums[2];
+  std::vector<double>           means(tileSize);
+  std::vector<double>           variances(tileSize);
+
+  const IndexType start  = region.GetIndex();
+  const SizeType  extent = region.GetSize();
+
+  for (itk::SizeValueType ty = 0; ty < extent[1]; ty += tileSize)
+  {
+    for (itk::SizeValueType tx = 0; tx < extent[0]; tx += tileSize)
+    {
+      RegionType tile;
+      tile.SetIndex(0, start[0] + tx);
+      tile.SetIndex(1, start[1] + ty);
+      tile.SetSize(0, std::min(tileSize, extent[0] - tx));
+      tile.SetSize(1, std::min(tileSize, extent[1] - ty));
+
+      RegionType padded = tile;
+      padded.PadByRadius(radius);
+      table.Compute(image, padded, band);
+
+      const double             shift  = table.GetShift();
+      const itk::SizeValueType length = tile.GetSize()[0];
+
+      IndexType index = tile.GetIndex();
+      for (itk::SizeValueType y = 0; y < tile.GetSize()[1]; ++y, ++index[1])
+      {
+        IndexType current = index;
+        for (itk::SizeValueType x = 0; x < length; ++x, ++current[0])
+        {
+          table.GetSums(current, radius, sums);
+          means[x]     = shift + sums[0] / num;
+          variances[x] = std::max(0., (sums[1] - sums[0] * sums[0] / num) / (num - 1.));
+        }
+        function(index, static_cast<unsigned int>(length), means.data(), variances.data());
+      }
+    }
+  }
+}
+
+} // end namespace otb
+
+#endif
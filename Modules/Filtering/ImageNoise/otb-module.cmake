@@ -22,6 +22,7 @@ set(DOCUMENTATION "This module is related to noise estimation and reduction.")
 
 otb_module(OTBImageNoise
   DEPENDS
+    OTBCommon
     OTBImageManipulation
     OTBITK
 
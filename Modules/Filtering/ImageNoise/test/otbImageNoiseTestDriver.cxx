@@ -26,4 +26,6 @@ void RegisterTests()
   REGISTER_TEST(otbLeeFilter);
   REGISTER_TEST(otbGammaMAPFilter);
   REGISTER_TEST(otbKuanFilter);
+  REGISTER_TEST(otbSpeckleFiltersIntegralImage);
+  REGISTER_TEST(otbQueganImageFilter);
 }
@@ -0,0 +1,123 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbVectorImage.h"
+#include "otbQueganImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+int otbQueganImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::VectorImage<double, 2>                  ImageType;
+  typedef otb::QueganImageFilter<ImageType, ImageType> FilterType;
+  typedef itk::ImageRegionIteratorWithIndex<ImageType> IteratorType;
+
+  const unsigned int nbDates = 5;
+
+  ImageType::RegionType region;
+  region.SetSize(0, 97);
+  region.SetSize(1, 71);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(nbDates);
+  image->Allocate();
+
+  // Speckle-like dates, the last one being null on a stripe
+  ImageType::PixelType pixel(nbDates);
+  IteratorType         it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    for (unsigned int date = 0; date < nbDates; ++date)
+    {
+      pixel[date] = 1. + (index[0] * 7919 + index[1] * 104729 + date * 1299709) % 97;
+    }
+    if (index[0] < 10)
+    {
+      pixel[nbDates - 1] = 0.;
+    }
+    it.Set(pixel);
+  }
+
+  ImageType::SizeType radius;
+  radius[0] = 3;
+  radius[1] = 2;
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetRadius(radius);
+  filter->SetNumberOfThreads(3);
+  filter->Update();
+
+  ImageType* output = filter->GetOutput();
+  if (output->GetNumberOfComponentsPerPixel() != nbDates)
+  {
+    std::cerr << "Wrong number of output dates: " << output->GetNumberOfComponentsPerPixel() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Compare with the brute force formula, replicating the borders
+  const ImageType::IndexType last = region.GetUpperIndex();
+  IteratorType               outIt(output, region);
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    const ImageType::IndexType index = outIt.GetIndex();
+
+    std::vector<double> means(nbDates, 0.);
+    for (int dy = -static_cast<int>(radius[1]); dy <= static_cast<int>(radius[1]); ++dy)
+    {
+      for (int dx = -static_cast<int>(radius[0]); dx <= static_cast<int>(radius[0]); ++dx)
+      {
+        ImageType::IndexType neighbor;
+        neighbor[0]                       = std::min(std::max<itk::IndexValueType>(index[0] + dx, 0), last[0]);
+        neighbor[1]                       = std::min(std::max<itk::IndexValueType>(index[1] + dy, 0), last[1]);
+        const ImageType::PixelType& value = image->GetPixel(neighbor);
+        for (unsigned int date = 0; date < nbDates; ++date)
+        {
+          means[date] += value[date] / ((2 * radius[0] + 1) * (2 * radius[1] + 1));
+        }
+      }
+    }
+
+    const ImageType::PixelType center  = image->GetPixel(index);
+    double                     ratio   = 0.;
+    unsigned int               nbValid = 0;
+    for (unsigned int date = 0; date < nbDates; ++date)
+    {
+      if (means[date] > 0.)
+      {
+        ratio += center[date] / means[date];
+        ++nbValid;
+      }
+    }
+    ratio /= nbValid;
+
+    for (unsigned int date = 0; date < nbDates; ++date)
+    {
+      const double expected = means[date] * ratio;
+      if (std::abs(outIt.Get()[date] - expected) > 1e-9 * std::abs(expected) + 1e-12)
+      {
+        std::cerr << "Wrong value at " << index << " for date " << date << ": " << outIt.Get()[date] << " instead of " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
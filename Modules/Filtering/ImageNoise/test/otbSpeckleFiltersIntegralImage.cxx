@@ -0,0 +1,113 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbLeeImageFilter.h"
+#include "otbKuanImageFilter.h"
+#include "otbGammaMAPImageFilter.h"
+#include "otbFrostImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+namespace
+{
+typedef otb::Image<double, 2> ImageType;
+
+// Run a speckle filter once with each path and compare the outputs
+template <class TFilter>
+bool CompareIntegralImage(const char* name, ImageType* image, typename TFilter::Pointer direct, typename TFilter::Pointer integral)
+{
+  ImageType::SizeType radius;
+  radius[0] = 6;
+  radius[1] = 3;
+
+  direct->SetInput(image);
+  direct->SetRadius(radius);
+  direct->SetIntegralImageMinimumRadius(7);
+  direct->Update();
+
+  integral->SetInput(image);
+  integral->SetRadius(radius);
+  integral->SetNumberOfThreads(3);
+  integral->Update();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> directIt(direct->GetOutput(), image->GetLargestPossibleRegion());
+  itk::ImageRegionIteratorWithIndex<ImageType> integralIt(integral->GetOutput(), image->GetLargestPossibleRegion());
+  for (directIt.GoToBegin(), integralIt.GoToBegin(); !directIt.IsAtEnd(); ++directIt, ++integralIt)
+  {
+    if (std::abs(directIt.Get() - integralIt.Get()) > 1e-9 * std::abs(directIt.Get()))
+    {
+      std::cerr << name << ": wrong value at " << directIt.GetIndex() << ": " << integralIt.Get() << " instead of " << directIt.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int otbSpeckleFiltersIntegralImage(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::LeeImageFilter<ImageType, ImageType>      LeeFilterType;
+  typedef otb::KuanImageFilter<ImageType, ImageType>     KuanFilterType;
+  typedef otb::GammaMAPImageFilter<ImageType, ImageType> GammaMAPFilterType;
+  typedef otb::FrostImageFilter<ImageType, ImageType>    FrostFilterType;
+
+  ImageType::RegionType region;
+  region.SetSize(0, 141);
+  region.SetSize(1, 77);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  // Speckle-like texture with a flat area to exercise every branch
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType index = it.GetIndex();
+    it.Set(index[0] < 20 ? 100. : 10. + (index[0] * 7919 + index[1] * 104729) % 251);
+  }
+
+  bool passed = true;
+
+  LeeFilterType::Pointer leeDirect   = LeeFilterType::New();
+  LeeFilterType::Pointer leeIntegral = LeeFilterType::New();
+  leeDirect->SetNbLooks(4.);
+  leeIntegral->SetNbLooks(4.);
+  passed = CompareIntegralImage<LeeFilterType>("Lee", image, leeDirect, leeIntegral) && passed;
+
+  KuanFilterType::Pointer kuanDirect   = KuanFilterType::New();
+  KuanFilterType::Pointer kuanIntegral = KuanFilterType::New();
+  kuanDirect->SetNbLooks(4.);
+  kuanIntegral->SetNbLooks(4.);
+  passed = CompareIntegralImage<KuanFilterType>("Kuan", image, kuanDirect, kuanIntegral) && passed;
+
+  GammaMAPFilterType::Pointer gammaDirect   = GammaMAPFilterType::New();
+  GammaMAPFilterType::Pointer gammaIntegral = GammaMAPFilterType::New();
+  gammaDirect->SetNbLooks(4.);
+  gammaIntegral->SetNbLooks(4.);
+  passed = CompareIntegralImage<GammaMAPFilterType>("GammaMAP", image, gammaDirect, gammaIntegral) && passed;
+
+  FrostFilterType::Pointer frostDirect   = FrostFilterType::New();
+  FrostFilterType::Pointer frostIntegral = FrostFilterType::New();
+  frostDirect->SetDeramp(0.1);
+  frostIntegral->SetDeramp(0.1);
+  passed = CompareIntegralImage<FrostFilterType>("Frost", image, frostDirect, frostIntegral) && passed;
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
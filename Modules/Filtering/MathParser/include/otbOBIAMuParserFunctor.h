@@ -26,6 +26,7 @@
 #include "otbParser.h"
 #include "otbMacro.h"
 #include <string>
+#include <vector>
 
 
 namespace otb
@@ -97,6 +98,61 @@ public:
     return static_cast<bool>(value);
   }
 
+  /** Evaluate the expression on nbObjects label objects at once, with the
+   * bulk mode of the parser: accepted[i] tells if objects[i] is accepted.
+   * The attributes are gathered in one array per attribute. */
+  void EvaluateBulk(const TLabelObject* const* objects, unsigned int nbObjects, std::vector<bool>& accepted)
+  {
+    accepted.assign(nbObjects, false);
+    if (nbObjects == 0)
+    {
+      return;
+    }
+
+    if (objects[0]->GetNumberOfAttributes() != m_AAttributes.size())
+    {
+      this->SetAttributes(*objects[0]);
+    }
+
+    const unsigned int nbOfAttributes = m_AAttributes.size();
+    m_BulkAttributes.resize(nbOfAttributes * nbObjects);
+    m_BulkResults.resize(nbObjects);
+    for (unsigned int i = 0; i < nbOfAttributes; ++i)
+    {
+      const char* name   = m_AttributesName[i].c_str();
+      double*     column = &m_BulkAttributes[i * nbObjects];
+      for (unsigned int j = 0; j < nbObjects; ++j)
+      {
+        column[j] = objects[j]->GetAttribute(name);
+      }
+      std::string attributeName = m_AttributesName[i];
+      ParseAttributeName(attributeName);
+      m_Parser->DefineVar(attributeName, column);
+    }
+
+    try
+    {
+      m_Parser->EvalBulk(m_BulkResults.data(), nbObjects);
+    }
+    catch (itk::ExceptionObject& err)
+    {
+      itkExceptionMacro(<< err);
+    }
+
+    for (unsigned int j = 0; j < nbObjects; ++j)
+    {
+      accepted[j] = static_cast<bool>(m_BulkResults[j]);
+    }
+
+    // Back to the variables of the evaluation of single objects
+    for (unsigned int i = 0; i < nbOfAttributes; ++i)
+    {
+      std::string attributeName = m_AttributesName[i];
+      ParseAttributeName(attributeName);
+      m_Parser->DefineVar(attributeName, &(m_AAttributes[i]));
+    }
+  }
+
   void SetExpression(const std::string expression)
   {
     m_Expression = expression;
@@ -209,6 +265,8 @@ private:
   std::vector<double>      m_AAttributes;
   std::vector<std::string> m_AttributesName;
   double                   m_ParserResult;
+  std::vector<double>      m_BulkAttributes;
+  std::vector<double>      m_BulkResults;
 };
 } // end of Functor namespace
 
@@ -69,6 +69,11 @@ public:
   /** Trigger the parsing */
   ValueType Eval();
 
+  /** Trigger the parsing in bulk mode: each variable points to an array of
+   * bulkSize values, and results[i] is the value of the expression with the
+   * i-th value of each variable */
+  void EvalBulk(ValueType* results, int bulkSize);
+
   /** Define a variable */
   void DefineVar(const std::string& sName, ValueType* fVar);
 
@@ -96,6 +96,19 @@ public:
     return result;
   }
 
+  /** Trigger the parsing in bulk mode */
+  void EvalBulk(ValueType* results, int bulkSize)
+  {
+    try
+    {
+      m_MuParser.Eval(results, bulkSize);
+    }
+    catch (ExceptionType& e)
+    {
+      ExceptionHandler(e);
+    }
+  }
+
 
   /** Define a variable */
   void DefineVar(const std::string& sName, ValueType* fVar)
@@ -253,6 +266,11 @@ Parser::ValueType Parser::Eval()
   return m_InternalParser->Eval();
 }
 
+void Parser::EvalBulk(Parser::ValueType* results, int bulkSize)
+{
+  m_InternalParser->EvalBulk(results, bulkSize);
+}
+
 void Parser::DefineVar(const std::string& sName, Parser::ValueType* fVar)
 {
   m_InternalParser->DefineVar(sName, fVar);
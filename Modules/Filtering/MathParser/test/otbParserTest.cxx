@@ -90,6 +90,29 @@ void otbParserTest_UserDefinedVars(void)
   otbParserTest_ThrowIfNotEqual(parser->Eval(), (var1 + var2 - var3) * var4 / var5, "UserDefinedVars");
 }
 
+void otbParserTest_BulkVars(void)
+{
+  const int bulkSize = 100;
+  double    var1[bulkSize];
+  double    var2[bulkSize];
+  double    results[bulkSize];
+  for (int i = 0; i < bulkSize; ++i)
+  {
+    var1[i] = i;
+    var2[i] = 0.5 * (bulkSize - i);
+  }
+
+  ParserType::Pointer parser = ParserType::New();
+  parser->DefineVar("var1", var1);
+  parser->DefineVar("var2", var2);
+  parser->SetExpr("var1 * 2 + var2 > 60");
+  parser->EvalBulk(results, bulkSize);
+  for (int i = 0; i < bulkSize; ++i)
+  {
+    otbParserTest_ThrowIfNotEqual(results[i], (var1[i] * 2 + var2[i] > 60) ? 1.0 : 0.0, "BulkVars");
+  }
+}
+
 void otbParserTest_Mixed(void)
 {
   ParserType::Pointer parser = ParserType::New();
@@ -114,6 +137,7 @@ int otbParserTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
   otbParserTest_UserDefinedCst();
   otbParserTest_UserDefinedFun();
   otbParserTest_UserDefinedVars();
+  otbParserTest_BulkVars();
   otbParserTest_Mixed();
   otbParserTest_LogicalOperator();
   return EXIT_SUCCESS;
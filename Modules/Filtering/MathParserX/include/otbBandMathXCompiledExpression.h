@@ -0,0 +1,184 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbBandMathXCompiledExpression_h
+#define otbBandMathXCompiledExpression_h
+
+#include "itkMacro.h"
+
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace otb
+{
+
+/** \class BandMathXCompiledExpression
+ * \brief Scalar expression compiled once and evaluated over spans of pixels.
+ *
+ * This class compiles the arithmetic subset of the BandMathX syntax into
+ * a flat program of typed operations, evaluated on whole spans of values
+ * (typically an image line) with simple loops that the compiler can
+ * vectorize. It is used by BandMathXImageFilter to avoid the per pixel
+ * overhead of muParserX.
+ *
+ * Supported syntax: numbers, scalar variables, the constants pi, e,
+ * log2e, log10e, ln2, ln10 and euler, the operators + - * / ^, unary -
+ * and +, comparisons (< <= > >= == !=), && and ||, the ternary operator
+ * ?:, the functions abs, sqrt, exp, log, ln, log10, log2, sin, cos, tan,
+ * asin, acos, atan, sinh, cosh, tanh and the OTB function ndvi.
+ * Comparisons and logical operators give 1 or 0. All computations are
+ * done in double precision.
+ *
+ * Variables are either spans, whose values change from pixel to pixel,
+ * or constants. Compile() returns false for anything else (vectors,
+ * matrices, other functions...), in which case the expression must be
+ * evaluated by muParserX.
+ *
+ * A compiled expression is read only: several threads can evaluate it
+ * concurrently, each with its own workspace.
+ *
+ * \sa BandMathXImageFilter
+ *
+ * \ingroup OTBMathParserX
+ */
+class ITK_EXPORT BandMathXCompiledExpression
+{
+public:
+  /** Index of each span variable in the spans given to Evaluate() */
+  typedef std::map<std::string, unsigned int> SpanVariableMapType;
+
+  /** Value of each constant variable */
+  typedef std::map<std::string, double> ConstantMapType;
+
+  /** Scratch buffers of one evaluating thread */
+  typedef std::vector<std::vector<double>> WorkspaceType;
+
+  BandMathXCompiledExpression();
+
+  /** Compile expression. Returns false if the expression uses a feature
+   * that is not supported, the expression being then left empty.
+   * Syntax errors are not reported: the expression is expected to have
+   * been checked by muParserX beforehand. Compiled programs are cached
+   * process wide, so compiling the same expression with the same variables
+   * again (e.g. for each thread or each run of a pipeline) skips parsing. */
+  bool Compile(const std::string& expression, const SpanVariableMapType& spanVariables, const ConstantMapType& constants);
+
+  /** Remove all the programs from the compilation cache */
+  static void ClearCache();
+
+  /** Number of programs in the compilation cache */
+  static std::size_t GetCacheSize();
+
+  /** Is there a compiled expression ? */
+  bool IsCompiled() const
+  {
+    return !m_Program.empty();
+  }
+
+  /** Evaluate the expression on n pixels. spans[i] points to the n values
+   * of the span variable of index i. */
+  void Evaluate(const double* const* spans, std::size_t n, double* output, WorkspaceType& workspace) const;
+
+private:
+  enum OpCodeType
+  {
+    OpConstant,
+    OpSpan,
+    OpNeg,
+    OpAdd,
+    OpSub,
+    OpMul,
+    OpDiv,
+    OpPow,
+    OpLt,
+    OpLe,
+    OpGt,
+    OpGe,
+    OpEq,
+    OpNe,
+    OpAnd,
+    OpOr,
+    OpSelect,
+    OpNdvi,
+    OpAbs,
+    OpSqrt,
+    OpExp,
+    OpLog,
+    OpLog10,
+    OpLog2,
+    OpSin,
+    OpCos,
+    OpTan,
+    OpAsin,
+    OpAcos,
+    OpAtan,
+    OpSinh,
+    OpCosh,
+    OpTanh
+  };
+
+  /** One operation of the program. Its result is stored in the register
+   * of the same index as the instruction */
+  struct Instruction
+  {
+    OpCodeType   op;
+    unsigned int arg[3];
+    double       value;
+  };
+
+  class Parser;
+
+  /** Entry of the compilation cache */
+  struct CachedProgram
+  {
+    bool                     supported;
+    std::vector<Instruction> program;
+    unsigned int             result;
+  };
+
+  typedef std::unordered_map<std::string, CachedProgram> ProgramCacheType;
+
+  static ProgramCacheType& GetCache();
+  static std::mutex&       GetCacheMutex();
+
+  /** Build the cache key of a compilation */
+  static std::string CacheKey(const std::string& expression, const SpanVariableMapType& spanVariables, const ConstantMapType& constants);
+
+  /** Append an instruction, folding it if all its arguments are constant.
+   * Returns the register holding the result */
+  unsigned int Emit(OpCodeType op, unsigned int a = 0, unsigned int b = 0, unsigned int c = 0, double value = 0.);
+
+  /** Apply a computing op on n values (n is 1 for constant folding) */
+  static void Kernel(OpCodeType op, const double* a, const double* b, const double* c, double* out, std::size_t n);
+
+  /** Remove the instructions the result doesn't depend on */
+  void RemoveDeadCode();
+
+  std::vector<Instruction> m_Program;
+  unsigned int             m_Result;
+};
+
+} // end namespace otb
+
+#endif
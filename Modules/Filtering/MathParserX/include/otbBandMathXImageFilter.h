@@ -29,6 +29,7 @@
 
 #include "otbStreamingStatisticsVectorImageFilter.h"
 #include "otbParserX.h"
+#include "otbBandMathXCompiledExpression.h"
 
 #include <vector>
 #include <string>
@@ -53,6 +54,12 @@ namespace otb
  * If the jth input image is multidimensional, then the variable imj represents a vector whose components are related to its bands.
  * In order to access the kth band, the variable observes the following pattern : imjbk.
  *
+ * When CompiledEvaluation is on, scalar expressions which only use band
+ * variables, indices, spacings, scalar constants and the functions listed in
+ * BandMathXCompiledExpression are evaluated one line of pixels at a time
+ * instead of one pixel at a time through muParserX. Other expressions keep
+ * the muParserX evaluation.
+ *
  * \sa Parser
  *
  * \ingroup Streamed
@@ -131,6 +138,11 @@ public:
   /** Return the variable and constant names */
   std::vector<std::string> GetVarNames() const;
 
+  /** Enable the line by line evaluation of scalar expressions (off by default) */
+  itkSetMacro(CompiledEvaluation, bool);
+  itkGetConstMacro(CompiledEvaluation, bool);
+  itkBooleanMacro(CompiledEvaluation);
+
   bool GlobalStatsDetected() const
   {
     return !m_StatsVarDetected.empty();
@@ -166,6 +178,8 @@ private:
   void PrepareParsers();
   void PrepareParsersGlobStats();
   void OutputsDimensions();
+  void PrepareCompiledExpressions();
+  void CompiledThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId);
 
   std::vector<std::string>                      m_Expression;
   std::vector<std::vector<ParserType::Pointer>> m_VParser;
@@ -190,6 +204,11 @@ private:
   itk::Array<long> m_ThreadOverflow;
 
   bool m_ManyExpressions;
+
+  bool                                     m_CompiledEvaluation;
+  bool                                     m_UseCompiledExpressions;
+  std::vector<BandMathXCompiledExpression> m_CompiledExpressions;
+  std::vector<unsigned int>                m_CompiledSpanVariables; // index in m_VVarName of each span of the compiled expressions
 };
 
 } // end namespace otb
@@ -32,6 +32,7 @@
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
+#include "otbNUMAPolicy.h"
 
 #include <iostream>
 #include <fstream>
@@ -68,6 +69,9 @@ BandMathXImageFilter<TImage>::BandMathXImageFilter()
   m_SizeNeighbourhood = 10;
 
   m_ManyExpressions = true;
+
+  m_CompiledEvaluation     = false;
+  m_UseCompiledExpressions = false;
 }
 
 /** Destructor */
@@ -101,6 +105,7 @@ void BandMathXImageFilter<TImage>::PrintSelf(std::ostream& os, itk::Indent inden
   os << indent << "Computed values follow:" << std::endl;
   os << indent << "UnderflowCount: " << m_UnderflowCount << std::endl;
   os << indent << "OverflowCount: " << m_OverflowCount << std::endl;
+  os << indent << "CompiledEvaluation: " << m_CompiledEvaluation << std::endl;
   os << indent << "itk::NumericTraits<typename PixelValueType>::NonpositiveMin()  :  " << itk::NumericTraits<PixelValueType>::NonpositiveMin() << std::endl;
   os << indent << "itk::NumericTraits<typename PixelValueType>::max()  :             " << itk::NumericTraits<PixelValueType>::max() << std::endl;
 }
@@ -856,6 +861,68 @@ void BandMathXImageFilter<TImage>::OutputsDimensions()
   }
 }
 
+template <typename TImage>
+void BandMathXImageFilter<TImage>::PrepareCompiledExpressions()
+{
+  m_UseCompiledExpressions = false;
+  m_CompiledExpressions.clear();
+  m_CompiledSpanVariables.clear();
+
+  if (!m_CompiledEvaluation || m_AImage.empty())
+    return;
+
+  // Only scalar outputs are compiled
+  for (unsigned int i = 0; i < m_outputsDimensions.size(); ++i)
+    if (m_outputsDimensions[i] != 1)
+      return;
+
+  BandMathXCompiledExpression::SpanVariableMapType spans;
+  BandMathXCompiledExpression::ConstantMapType     constants;
+  for (unsigned int j = 0; j < m_AImage[0].size(); ++j)
+  {
+    const adhocStruct& var = m_AImage[0][j];
+    switch (var.type)
+    {
+    case 0: // idxX
+    case 1: // idxY
+    case 5: // pixel
+      spans[var.name] = m_CompiledSpanVariables.size();
+      m_CompiledSpanVariables.push_back(j);
+      break;
+
+    case 2: // imiPhyX
+    case 3: // imiPhyY
+    case 7: // user defined variables
+    case 8: // global stats
+      // Values have been set by PrepareParsers and PrepareParsersGlobStats
+      if (var.value.GetType() == 'f')
+        constants[var.name] = var.value.GetFloat();
+      else if (var.value.GetType() == 'i')
+        constants[var.name] = var.value.GetInteger();
+      else
+        return;
+      break;
+
+    default: // vectors and neighborhoods
+      return;
+    }
+  }
+
+  m_CompiledExpressions.resize(m_Expression.size());
+  for (unsigned int i = 0; i < m_Expression.size(); ++i)
+  {
+    if (!m_CompiledExpressions[i].Compile(m_Expression[i], spans, constants))
+    {
+      otbLogMacro(Debug, << "Expression " << m_Expression[i] << " is evaluated by muParserX");
+      m_CompiledExpressions.clear();
+      m_CompiledSpanVariables.clear();
+      return;
+    }
+  }
+
+  m_UseCompiledExpressions = true;
+}
+
 template <typename TImage>
 void BandMathXImageFilter<TImage>::CheckImageDimensions(void)
 {
@@ -888,6 +955,7 @@ void BandMathXImageFilter<TImage>::GenerateOutputInformation(void)
   if (GlobalStatsDetected())
     PrepareParsersGlobStats();
   OutputsDimensions();
+  PrepareCompiledExpressions();
 
 
   typedef itk::ImageBase<TImage::ImageDimension> ImageBaseType;
@@ -1006,6 +1074,13 @@ void BandMathXImageFilter<TImage>::AfterThreadedGenerateData()
 template <typename TImage>
 void BandMathXImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
+  NUMAPolicy::PinCurrentThread(threadId, this->GetNumberOfThreads());
+
+  if (m_UseCompiledExpressions)
+  {
+    this->CompiledThreadedGenerateData(outputRegionForThread, threadId);
+    return;
+  }
 
   ValueType    value;
   unsigned int nbInputImages = this->GetNumberOfInputs();
@@ -1229,6 +1304,116 @@ void BandMathXImageFilter<TImage>::ThreadedGenerateData(const ImageRegionType& o
   }
 }
 
+template <typename TImage>
+void BandMathXImageFilter<TImage>::CompiledThreadedGenerateData(const ImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  unsigned int nbInputImages = this->GetNumberOfInputs();
+  unsigned int nbSpans       = m_CompiledSpanVariables.size();
+  unsigned int lineLength    = outputRegionForThread.GetSize(0);
+
+  typedef itk::ImageScanlineConstIterator<TImage> ImageScanlineConstIteratorType;
+  typedef itk::ImageScanlineIterator<TImage>      ImageScanlineIteratorType;
+  std::vector<ImageScanlineConstIteratorType>     Vit(nbInputImages);
+  for (unsigned int j = 0; j < nbInputImages; ++j)
+  {
+    Vit[j] = ImageScanlineConstIteratorType(this->GetNthInput(j), outputRegionForThread);
+    Vit[j].GoToBegin();
+  }
+
+  std::vector<ImageScanlineIteratorType> VoutIt(m_Expression.size());
+  for (unsigned int j = 0; j < VoutIt.size(); ++j)
+  {
+    VoutIt[j] = ImageScanlineIteratorType(this->GetOutput(j), outputRegionForThread);
+    VoutIt[j].GoToBegin();
+  }
+
+  // Support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  // Values of the variables along the current line
+  std::vector<std::vector<double>> spanValues(nbSpans, std::vector<double>(lineLength));
+  std::vector<const double*>       spanPointers(nbSpans);
+  for (unsigned int s = 0; s < nbSpans; ++s)
+    spanPointers[s] = spanValues[s].data();
+
+  std::vector<double>                        results(lineLength);
+  BandMathXCompiledExpression::WorkspaceType workspace;
+
+  PixelType outputPixel;
+  outputPixel.SetSize(1);
+
+  const double minValue = double(itk::NumericTraits<PixelValueType>::NonpositiveMin());
+  const double maxValue = double(itk::NumericTraits<PixelValueType>::max());
+
+  while (!Vit[0].IsAtEnd())
+  {
+    const IndexType lineIndex = Vit[0].GetIndex();
+
+    //----------------- Gather the line -----------------//
+    for (unsigned int x = 0; !Vit[0].IsAtEndOfLine(); ++x)
+    {
+      for (unsigned int s = 0; s < nbSpans; ++s)
+      {
+        const adhocStruct& var = m_VVarName[m_CompiledSpanVariables[s]];
+        switch (var.type)
+        {
+        case 0: // idxX
+          spanValues[s][x] = static_cast<double>(lineIndex[0] + x);
+          break;
+
+        case 1: // idxY
+          spanValues[s][x] = static_cast<double>(lineIndex[1]);
+          break;
+
+        default: // pixel
+          // var.info[0] : Input image #ID
+          // var.info[1] : Band #ID
+          spanValues[s][x] = static_cast<double>(Vit[var.info[0]].Get()[var.info[1]]);
+          break;
+        }
+      }
+
+      for (unsigned int j = 0; j < nbInputImages; ++j)
+      {
+        ++Vit[j];
+      }
+    }
+
+    //----------------- Evaluations -----------------//
+    for (unsigned int IDExpression = 0; IDExpression < m_Expression.size(); ++IDExpression)
+    {
+      m_CompiledExpressions[IDExpression].Evaluate(spanPointers.data(), lineLength, results.data(), workspace);
+
+      for (unsigned int x = 0; x < lineLength; ++x)
+      {
+        double value = results[x];
+        if (value < minValue)
+        {
+          value = minValue;
+          m_ThreadUnderflow[threadId]++;
+        }
+        else if (value > maxValue)
+        {
+          value = maxValue;
+          m_ThreadOverflow[threadId]++;
+        }
+        outputPixel[0] = static_cast<PixelValueType>(value);
+        VoutIt[IDExpression].Set(outputPixel);
+        ++VoutIt[IDExpression];
+      }
+      VoutIt[IDExpression].NextLine();
+    }
+
+    for (unsigned int x = 0; x < lineLength; ++x)
+      progress.CompletedPixel();
+
+    for (unsigned int j = 0; j < nbInputImages; ++j)
+    {
+      Vit[j].NextLine();
+    }
+  }
+}
+
 } // end namespace otb
 
 #endif
@@ -0,0 +1,719 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbBandMathXCompiledExpression.h"
+#include "otbMath.h"
+
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <cstdlib>
+#include <sstream>
+
+namespace otb
+{
+
+namespace
+{
+template <class F>
+inline void Map1(const double* a, double* out, std::size_t n, F f)
+{
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    out[i] = f(a[i]);
+  }
+}
+
+template <class F>
+inline void Map2(const double* a, const double* b, double* out, std::size_t n, F f)
+{
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    out[i] = f(a[i], b[i]);
+  }
+}
+} // end anonymous namespace
+
+/** Recursive descent parser emitting the program of the expression.
+ * Each parsing method returns the register of its result, or throws
+ * UnsupportedException. */
+class BandMathXCompiledExpression::Parser
+{
+public:
+  struct UnsupportedException
+  {
+  };
+
+  Parser(BandMathXCompiledExpression& owner, const std::string& expression, const SpanVariableMapType& spanVariables, const ConstantMapType& constants)
+    : m_Owner(owner), m_Expression(expression), m_Position(0), m_SpanVariables(spanVariables), m_Constants(constants)
+  {
+  }
+
+  unsigned int Parse()
+  {
+    unsigned int result = ParseTernary();
+    SkipSpaces();
+    if (m_Position != m_Expression.size())
+    {
+      throw UnsupportedException();
+    }
+    return result;
+  }
+
+private:
+  void SkipSpaces()
+  {
+    while (m_Position < m_Expression.size() && std::isspace(static_cast<unsigned char>(m_Expression[m_Position])))
+    {
+      ++m_Position;
+    }
+  }
+
+  /** Consume token if it comes next */
+  bool Accept(const char* token)
+  {
+    SkipSpaces();
+    const std::size_t length = std::char_traits<char>::length(token);
+    if (m_Expression.compare(m_Position, length, token) == 0)
+    {
+      m_Position += length;
+      return true;
+    }
+    return false;
+  }
+
+  /** Check the next token without consuming it */
+  bool Peek(const char* token)
+  {
+    SkipSpaces();
+    return m_Expression.compare(m_Position, std::char_traits<char>::length(token), token) == 0;
+  }
+
+  void Expect(const char* token)
+  {
+    if (!Accept(token))
+    {
+      throw UnsupportedException();
+    }
+  }
+
+  unsigned int ParseTernary()
+  {
+    unsigned int condition = ParseOr();
+    if (Accept("?"))
+    {
+      unsigned int ifTrue = ParseTernary();
+      Expect(":");
+      unsigned int ifFalse = ParseTernary();
+      return m_Owner.Emit(OpSelect, condition, ifTrue, ifFalse);
+    }
+    return condition;
+  }
+
+  unsigned int ParseOr()
+  {
+    unsigned int left = ParseAnd();
+    while (Accept("||"))
+    {
+      left = m_Owner.Emit(OpOr, left, ParseAnd());
+    }
+    return left;
+  }
+
+  unsigned int ParseAnd()
+  {
+    unsigned int left = ParseEquality();
+    while (Accept("&&"))
+    {
+      left = m_Owner.Emit(OpAnd, left, ParseEquality());
+    }
+    return left;
+  }
+
+  unsigned int ParseEquality()
+  {
+    unsigned int left = ParseRelational();
+    while (true)
+    {
+      if (Accept("=="))
+      {
+        left = m_Owner.Emit(OpEq, left, ParseRelational());
+      }
+      else if (Accept("!="))
+      {
+        left = m_Owner.Emit(OpNe, left, ParseRelational());
+      }
+      else
+      {
+        return left;
+      }
+    }
+  }
+
+  unsigned int ParseRelational()
+  {
+    unsigned int left = ParseAdditive();
+    while (true)
+    {
+      if (Accept("<="))
+      {
+        left = m_Owner.Emit(OpLe, left, ParseAdditive());
+      }
+      else if (Accept(">="))
+      {
+        left = m_Owner.Emit(OpGe, left, ParseAdditive());
+      }
+      else if (Accept("<"))
+      {
+        left = m_Owner.Emit(OpLt, left, ParseAdditive());
+      }
+      else if (Accept(">"))
+      {
+        left = m_Owner.Emit(OpGt, left, ParseAdditive());
+      }
+      else
+      {
+        return left;
+      }
+    }
+  }
+
+  unsigned int ParseAdditive()
+  {
+    unsigned int left = ParseMultiplicative();
+    while (true)
+    {
+      if (Accept("+"))
+      {
+        left = m_Owner.Emit(OpAdd, left, ParseMultiplicative());
+      }
+      else if (Accept("-"))
+      {
+        left = m_Owner.Emit(OpSub, left, ParseMultiplicative());
+      }
+      else
+      {
+        return left;
+      }
+    }
+  }
+
+  unsigned int ParseMultiplicative()
+  {
+    unsigned int left = ParseUnary();
+    while (true)
+    {
+      // Keep the BandMathX element-wise operators (mult, div, dv...) for
+      // muParserX
+      if (Peek("**") || Peek("//"))
+      {
+        throw UnsupportedException();
+      }
+      if (Accept("*"))
+      {
+        left = m_Owner.Emit(OpMul, left, ParseUnary());
+      }
+      else if (Accept("/"))
+      {
+        left = m_Owner.Emit(OpDiv, left, ParseUnary());
+      }
+      else
+      {
+        return left;
+      }
+    }
+  }
+
+  unsigned int ParseUnary()
+  {
+    // The relative priority of the sign and the power operators differs
+    // between parsers, so a signed power is left to muParserX
+    if (Accept("-"))
+    {
+      unsigned int operand = ParsePrimary();
+      if (Peek("^"))
+      {
+        throw UnsupportedException();
+      }
+      return m_Owner.Emit(OpNeg, operand);
+    }
+    if (Accept("+"))
+    {
+      unsigned int operand = ParsePrimary();
+      if (Peek("^"))
+      {
+        throw UnsupportedException();
+      }
+      return operand;
+    }
+    return ParsePower();
+  }
+
+  unsigned int ParsePower()
+  {
+    unsigned int base = ParsePrimary();
+    if (Accept("^"))
+    {
+      unsigned int exponent = ParsePrimary();
+      // Chained powers are not supported, for the same reason
+      if (Peek("^"))
+      {
+        throw UnsupportedException();
+      }
+      return m_Owner.Emit(OpPow, base, exponent);
+    }
+    return base;
+  }
+
+  unsigned int ParsePrimary()
+  {
+    SkipSpaces();
+    if (m_Position >= m_Expression.size())
+    {
+      throw UnsupportedException();
+    }
+
+    const char current = m_Expression[m_Position];
+
+    if (Accept("("))
+    {
+      unsigned int result = ParseTernary();
+      Expect(")");
+      return result;
+    }
+
+    if (std::isdigit(static_cast<unsigned char>(current)) || current == '.')
+    {
+      return ParseNumber();
+    }
+
+    if (std::isalpha(static_cast<unsigned char>(current)) || current == '_')
+    {
+      std::size_t start = m_Position;
+      while (m_Position < m_Expression.size() &&
+             (std::isalnum(static_cast<unsigned char>(m_Expression[m_Position])) || m_Expression[m_Position] == '_'))
+      {
+        ++m_Position;
+      }
+      const std::string name = m_Expression.substr(start, m_Position - start);
+
+      if (Accept("("))
+      {
+        return ParseFunction(name);
+      }
+      return ParseIdentifier(name);
+    }
+
+    throw UnsupportedException();
+  }
+
+  unsigned int ParseNumber()
+  {
+    const char* begin = m_Expression.c_str() + m_Position;
+    char*       end   = nullptr;
+    double      value = std::strtod(begin, &end);
+    if (end == begin)
+    {
+      throw UnsupportedException();
+    }
+    m_Position += end - begin;
+    return m_Owner.Emit(OpConstant, 0, 0, 0, value);
+  }
+
+  unsigned int ParseIdentifier(const std::string& name)
+  {
+    SpanVariableMapType::const_iterator span = m_SpanVariables.find(name);
+    if (span != m_SpanVariables.end())
+    {
+      return m_Owner.Emit(OpSpan, span->second);
+    }
+
+    ConstantMapType::const_iterator constant = m_Constants.find(name);
+    if (constant != m_Constants.end())
+    {
+      return m_Owner.Emit(OpConstant, 0, 0, 0, constant->second);
+    }
+
+    static const std::map<std::string, double> builtinConstants = {{"pi", CONST_PI},       {"e", CONST_E},       {"log2e", CONST_LOG2E},
+                                                                   {"log10e", CONST_LOG10E}, {"ln2", CONST_LN2},   {"ln10", CONST_LN10},
+                                                                   {"euler", CONST_EULER}};
+    std::map<std::string, double>::const_iterator builtin = builtinConstants.find(name);
+    if (builtin != builtinConstants.end())
+    {
+      return m_Owner.Emit(OpConstant, 0, 0, 0, builtin->second);
+    }
+
+    throw UnsupportedException();
+  }
+
+  unsigned int ParseFunction(const std::string& name)
+  {
+    static const std::map<std::string, OpCodeType> unaryFunctions = {
+        {"abs", OpAbs},   {"sqrt", OpSqrt}, {"exp", OpExp},   {"log", OpLog},   {"ln", OpLog},     {"log10", OpLog10}, {"log2", OpLog2}, {"sin", OpSin},
+        {"cos", OpCos},   {"tan", OpTan},   {"asin", OpAsin}, {"acos", OpAcos}, {"atan", OpAtan}, {"sinh", OpSinh},   {"cosh", OpCosh}, {"tanh", OpTanh}};
+
+    if (name == "ndvi")
+    {
+      unsigned int red = ParseTernary();
+      Expect(",");
+      unsigned int nir = ParseTernary();
+      Expect(")");
+      return m_Owner.Emit(OpNdvi, red, nir);
+    }
+
+    std::map<std::string, OpCodeType>::const_iterator function = unaryFunctions.find(name);
+    if (function == unaryFunctions.end())
+    {
+      throw UnsupportedException();
+    }
+    unsigned int argument = ParseTernary();
+    Expect(")");
+    return m_Owner.Emit(function->second, argument);
+  }
+
+  BandMathXCompiledExpression& m_Owner;
+  const std::string&           m_Expression;
+  std::size_t                  m_Position;
+  const SpanVariableMapType&   m_SpanVariables;
+  const ConstantMapType&       m_Constants;
+};
+
+BandMathXCompiledExpression::BandMathXCompiledExpression() : m_Program(), m_Result(0)
+{
+}
+
+BandMathXCompiledExpression::ProgramCacheType& BandMathXCompiledExpression::GetCache()
+{
+  static ProgramCacheType cache;
+  return cache;
+}
+
+std::mutex& BandMathXCompiledExpression::GetCacheMutex()
+{
+  static std::mutex mutex;
+  return mutex;
+}
+
+void BandMathXCompiledExpression::ClearCache()
+{
+  std::lock_guard<std::mutex> lock(GetCacheMutex());
+  GetCache().clear();
+}
+
+std::size_t BandMathXCompiledExpression::GetCacheSize()
+{
+  std::lock_guard<std::mutex> lock(GetCacheMutex());
+  return GetCache().size();
+}
+
+std::string BandMathXCompiledExpression::CacheKey(const std::string& expression, const SpanVariableMapType& spanVariables, const ConstantMapType& constants)
+{
+  // Constants are folded into the program, so their exact values are
+  // part of the key (hexfloat keeps all the bits)
+  std::ostringstream oss;
+  oss << expression << '\n';
+  for (const auto& span : spanVariables)
+  {
+    oss << span.first << '=' << span.second << ';';
+  }
+  oss << '\n' << std::hexfloat;
+  for (const auto& constant : constants)
+  {
+    oss << constant.first << '=' << constant.second << ';';
+  }
+  return oss.str();
+}
+
+bool BandMathXCompiledExpression::Compile(const std::string& expression, const SpanVariableMapType& spanVariables, const ConstantMapType& constants)
+{
+  m_Program.clear();
+  m_Result = 0;
+
+  const std::string key = CacheKey(expression, spanVariables, constants);
+  {
+    std::lock_guard<std::mutex>      lock(GetCacheMutex());
+    ProgramCacheType::const_iterator cached = GetCache().find(key);
+    if (cached != GetCache().end())
+    {
+      m_Program = cached->second.program;
+      m_Result  = cached->second.result;
+      return cached->second.supported;
+    }
+  }
+
+  bool supported = true;
+  try
+  {
+    Parser parser(*this, expression, spanVariables, constants);
+    m_Result = parser.Parse();
+    this->RemoveDeadCode();
+  }
+  catch (Parser::UnsupportedException&)
+  {
+    m_Program.clear();
+    m_Result  = 0;
+    supported = false;
+  }
+
+  CachedProgram entry;
+  entry.supported = supported;
+  entry.program   = m_Program;
+  entry.result    = m_Result;
+
+  std::lock_guard<std::mutex> lock(GetCacheMutex());
+  GetCache()[key] = entry;
+  return supported;
+}
+
+unsigned int BandMathXCompiledExpression::Emit(OpCodeType op, unsigned int a, unsigned int b, unsigned int c, double value)
+{
+  Instruction instruction;
+  instruction.op     = op;
+  instruction.arg[0] = a;
+  instruction.arg[1] = b;
+  instruction.arg[2] = c;
+  instruction.value  = value;
+
+  // Number of register arguments of op
+  unsigned int nbArgs = 1;
+  if (op == OpConstant || op == OpSpan)
+  {
+    nbArgs = 0;
+  }
+  else if (op == OpSelect)
+  {
+    nbArgs = 3;
+  }
+  else if (op >= OpAdd && op <= OpNdvi)
+  {
+    nbArgs = 2;
+  }
+
+  // Constant folding
+  bool constantArgs = (op != OpSpan);
+  for (unsigned int i = 0; i < nbArgs; ++i)
+  {
+    constantArgs = constantArgs && (m_Program[instruction.arg[i]].op == OpConstant);
+  }
+  if (nbArgs > 0 && constantArgs)
+  {
+    double args[3] = {0., 0., 0.};
+    for (unsigned int i = 0; i < nbArgs; ++i)
+    {
+      args[i] = m_Program[instruction.arg[i]].value;
+    }
+    Kernel(op, &args[0], &args[1], &args[2], &instruction.value, 1);
+    instruction.op = OpConstant;
+  }
+
+  m_Program.push_back(instruction);
+  return m_Program.size() - 1;
+}
+
+void BandMathXCompiledExpression::RemoveDeadCode()
+{
+  // Arguments always come before their instruction, so a backward pass
+  // finds every instruction the result depends on
+  std::vector<bool> used(m_Program.size(), false);
+  used[m_Result] = true;
+  for (std::size_t i = m_Program.size(); i-- > 0;)
+  {
+    if (!used[i])
+    {
+      continue;
+    }
+    const Instruction& instruction = m_Program[i];
+    const unsigned int nbArgs      = instruction.op == OpConstant || instruction.op == OpSpan
+                                    ? 0
+                                    : (instruction.op == OpSelect ? 3 : ((instruction.op >= OpAdd && instruction.op <= OpNdvi) ? 2 : 1));
+    for (unsigned int j = 0; j < nbArgs; ++j)
+    {
+      used[instruction.arg[j]] = true;
+    }
+  }
+
+  std::vector<unsigned int> newIndex(m_Program.size(), 0);
+  std::vector<Instruction>  program;
+  for (std::size_t i = 0; i < m_Program.size(); ++i)
+  {
+    if (used[i])
+    {
+      Instruction instruction = m_Program[i];
+      if (instruction.op != OpConstant && instruction.op != OpSpan)
+      {
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+          instruction.arg[j] = newIndex[instruction.arg[j]];
+        }
+      }
+      newIndex[i] = program.size();
+      program.push_back(instruction);
+    }
+  }
+  m_Result = newIndex[m_Result];
+  m_Program.swap(program);
+}
+
+void BandMathXCompiledExpression::Kernel(OpCodeType op, const double* a, const double* b, const double* c, double* out, std::size_t n)
+{
+  switch (op)
+  {
+  case OpNeg:
+    Map1(a, out, n, [](double x) { return -x; });
+    break;
+  case OpAdd:
+    Map2(a, b, out, n, [](double x, double y) { return x + y; });
+    break;
+  case OpSub:
+    Map2(a, b, out, n, [](double x, double y) { return x - y; });
+    break;
+  case OpMul:
+    Map2(a, b, out, n, [](double x, double y) { return x * y; });
+    break;
+  case OpDiv:
+    Map2(a, b, out, n, [](double x, double y) { return x / y; });
+    break;
+  case OpPow:
+    Map2(a, b, out, n, [](double x, double y) { return std::pow(x, y); });
+    break;
+  case OpLt:
+    Map2(a, b, out, n, [](double x, double y) { return x < y ? 1. : 0.; });
+    break;
+  case OpLe:
+    Map2(a, b, out, n, [](double x, double y) { return x <= y ? 1. : 0.; });
+    break;
+  case OpGt:
+    Map2(a, b, out, n, [](double x, double y) { return x > y ? 1. : 0.; });
+    break;
+  case OpGe:
+    Map2(a, b, out, n, [](double x, double y) { return x >= y ? 1. : 0.; });
+    break;
+  case OpEq:
+    Map2(a, b, out, n, [](double x, double y) { return x == y ? 1. : 0.; });
+    break;
+  case OpNe:
+    Map2(a, b, out, n, [](double x, double y) { return x != y ? 1. : 0.; });
+    break;
+  case OpAnd:
+    Map2(a, b, out, n, [](double x, double y) { return (x != 0. && y != 0.) ? 1. : 0.; });
+    break;
+  case OpOr:
+    Map2(a, b, out, n, [](double x, double y) { return (x != 0. || y != 0.) ? 1. : 0.; });
+    break;
+  case OpSelect:
+    for (std::size_t i = 0; i < n; ++i)
+    {
+      out[i] = a[i] != 0. ? b[i] : c[i];
+    }
+    break;
+  case OpNdvi:
+    // Same definition as the ndvi muParserX plugin
+    Map2(a, b, out, n, [](double r, double nir) { return std::abs(r + nir) < 1E-6 ? 0. : (nir - r) / (nir + r); });
+    break;
+  case OpAbs:
+    Map1(a, out, n, [](double x) { return std::abs(x); });
+    break;
+  case OpSqrt:
+    Map1(a, out, n, [](double x) { return std::sqrt(x); });
+    break;
+  case OpExp:
+    Map1(a, out, n, [](double x) { return std::exp(x); });
+    break;
+  case OpLog:
+    Map1(a, out, n, [](double x) { return std::log(x); });
+    break;
+  case OpLog10:
+    Map1(a, out, n, [](double x) { return std::log10(x); });
+    break;
+  case OpLog2:
+    Map1(a, out, n, [](double x) { return std::log2(x); });
+    break;
+  case OpSin:
+    Map1(a, out, n, [](double x) { return std::sin(x); });
+    break;
+  case OpCos:
+    Map1(a, out, n, [](double x) { return std::cos(x); });
+    break;
+  case OpTan:
+    Map1(a, out, n, [](double x) { return std::tan(x); });
+    break;
+  case OpAsin:
+    Map1(a, out, n, [](double x) { return std::asin(x); });
+    break;
+  case OpAcos:
+    Map1(a, out, n, [](double x) { return std::acos(x); });
+    break;
+  case OpAtan:
+    Map1(a, out, n, [](double x) { return std::atan(x); });
+    break;
+  case OpSinh:
+    Map1(a, out, n, [](double x) { return std::sinh(x); });
+    break;
+  case OpCosh:
+    Map1(a, out, n, [](double x) { return std::cosh(x); });
+    break;
+  case OpTanh:
+    Map1(a, out, n, [](double x) { return std::tanh(x); });
+    break;
+  case OpConstant:
+  case OpSpan:
+    break;
+  }
+}
+
+void BandMathXCompiledExpression::Evaluate(const double* const* spans, std::size_t n, double* output, WorkspaceType& workspace) const
+{
+  if (m_Program.empty())
+  {
+    return;
+  }
+
+  std::vector<const double*> registers(m_Program.size(), nullptr);
+  workspace.resize(m_Program.size());
+
+  for (std::size_t i = 0; i < m_Program.size(); ++i)
+  {
+    const Instruction& instruction = m_Program[i];
+
+    if (instruction.op == OpSpan)
+    {
+      // Span variables are read in place
+      registers[i] = spans[instruction.arg[0]];
+      continue;
+    }
+
+    std::vector<double>& buffer = workspace[i];
+    buffer.resize(n);
+
+    if (instruction.op == OpConstant)
+    {
+      std::fill(buffer.begin(), buffer.end(), instruction.value);
+    }
+    else
+    {
+      Kernel(instruction.op, registers[instruction.arg[0]], registers[instruction.arg[1]], registers[instruction.arg[2]], buffer.data(), n);
+    }
+    registers[i] = buffer.data();
+  }
+
+  std::copy(registers[m_Result], registers[m_Result] + n, output);
+}
+
+} // end namespace otb
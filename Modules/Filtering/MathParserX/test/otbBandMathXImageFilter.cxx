@@ -22,6 +22,7 @@
 #include "itkMacro.h"
 #include <iostream>
 #include <complex> //only for the isnan() test line 148
+#include <algorithm>
 
 #include "otbMath.h"
 #include "otbVectorImage.h"
@@ -684,3 +685,82 @@ int otbBandMathXImageFilterBandsFailures(int itkNotUsed(argc), char* itkNotUsed(
   }
   return EXIT_SUCCESS;
 }
+
+int otbBandMathXImageFilterCompiled(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::VectorImage<double, 2> ImageType;
+  typedef ImageType::PixelType                 PixelType;
+  typedef otb::BandMathXImageFilter<ImageType> FilterType;
+
+  const unsigned int N = 100, D1 = 3;
+
+  ImageType::SizeType size;
+  size.Fill(N);
+  ImageType::IndexType index;
+  index.Fill(0);
+  ImageType::RegionType region;
+  region.SetSize(size);
+  region.SetIndex(index);
+
+  ImageType::Pointer image = createTestImage<ImageType>(region, D1);
+
+  typedef itk::ImageRegionIteratorWithIndex<ImageType> IteratorType;
+  IteratorType                                         it(image, region);
+  PixelType                                            val;
+  val.SetSize(D1);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    ImageType::IndexType i = it.GetIndex();
+    val[0]                 = i[0] - 50.;
+    val[1]                 = i[0] * i[1] * 0.1;
+    val[2]                 = i[1] / (i[0] + 1.);
+    it.Set(val);
+  }
+
+  std::vector<std::string> exps = {"ndvi(im1b1, im1b2)", "im1b1 > 0 ? im1b1 / (im1b2 + 1) : -im1b3",
+                                   "sqrt(abs(im1b2)) + idxX * 0.5 - idxY", "log(1 + im1b3 ^ 2) * myConst + pi",
+                                   "(im1b1 >= 10 && im1b3 < 0.5) || im1b2 == 0 ? exp(-im1b3) : tanh(im1b1)"};
+
+  FilterType::Pointer reference = FilterType::New();
+  FilterType::Pointer compiled  = FilterType::New();
+  reference->SetNthInput(0, image);
+  compiled->SetNthInput(0, image);
+  reference->SetConstant("myConst", 1.5);
+  compiled->SetConstant("myConst", 1.5);
+  for (const std::string& exp : exps)
+  {
+    reference->SetExpression(exp);
+    compiled->SetExpression(exp);
+  }
+  compiled->CompiledEvaluationOn();
+
+  reference->UpdateOutputInformation();
+  compiled->UpdateOutputInformation();
+  for (unsigned int j = 0; j < exps.size(); ++j)
+  {
+    reference->GetOutput(j)->SetRequestedRegion(region);
+    compiled->GetOutput(j)->SetRequestedRegion(region);
+  }
+  reference->Update();
+  compiled->Update();
+
+  double error = 0.;
+  for (unsigned int j = 0; j < exps.size(); ++j)
+  {
+    IteratorType itRef(reference->GetOutput(j), region);
+    IteratorType itCompiled(compiled->GetOutput(j), region);
+    for (itRef.GoToBegin(), itCompiled.GoToBegin(); !itRef.IsAtEnd(); ++itRef, ++itCompiled)
+    {
+      error = std::max(error, std::fabs(itRef.Get()[0] - itCompiled.Get()[0]));
+      if (std::fabs(itRef.Get()[0] - itCompiled.Get()[0]) > 1e-9)
+      {
+        std::cerr << "Error in expression " << exps[j] << " at " << itRef.GetIndex() << " : muParserX gives " << itRef.Get()[0]
+                  << " whereas compiled evaluation gives " << itCompiled.Get()[0] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  std::cout << "Maximum difference : " << error << std::endl;
+
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,8 @@
 #include "itkNumericTraits.h"
 #include <vnl/vnl_matrix.h>
 #include "vnl/algo/vnl_solve_qp.h"
+#include <utility>
+#include <vector>
 
 namespace otb
 {
@@ -52,6 +54,13 @@ namespace otb
  * Output:
  * N x 1 Vector of scales to apply to images
  *
+ * Each connected component of the overlaps graph is solved separately.
+ * Components larger than the maximum dense component size are solved with
+ * a sparse objective matrix: the equality constrained problem is solved
+ * with a Jacobi preconditioned conjugate gradient, which only involves the
+ * overlapping pairs of images, and the non-negativity constraint is
+ * checked on the solution afterwards.
+ *
  *  For more details, see Cresson, Remi, and Nathalie Saint-Geours.
  *  "Natural color satellite image mosaicking using quadratic programming in decorrelated color space."
  *  IEEE Journal of Selected Topics in Applied Earth Observations and Remote Sensing 8.8 (2015): 4151-4162.
@@ -85,6 +94,9 @@ public:
   typedef vnl_vector<double>        DoubleVectorType;
   typedef std::vector<unsigned int> ListIndexType;
 
+  /** Sparse matrix rows: (column, value) pairs */
+  typedef std::vector<std::vector<std::pair<unsigned int, double>>> SparseMatrixType;
+
   /** Enum for objective function type */
   enum ObjectiveFunctionType
   {
@@ -155,6 +167,17 @@ public:
     return m_WeightOfStandardDeviationTerm;
   }
 
+  /** Maximum number of images of a connected component solved with dense
+   * matrices (default 200) */
+  void SetMaximumDenseComponentSize(unsigned int size)
+  {
+    m_MaximumDenseComponentSize = size;
+  }
+  unsigned int GetMaximumDenseComponentSize()
+  {
+    return m_MaximumDenseComponentSize;
+  }
+
   /** Solving routine */
   void Solve();
 
@@ -184,8 +207,11 @@ private:
   // Check inputs
   void CheckInputs(void) const;
 
-  // Deep First Search
-  void DFS(std::vector<bool>& marked, unsigned int s) const;
+  // Connected components of the overlaps graph
+  void ComputeConnectedComponents(std::vector<ListIndexType>& components) const;
+
+  // Weight of the standard deviation term in the objective function
+  ValueType GetStandardDeviationWeight() const;
 
   // Compute the objective matrix
   const DoubleMatrixType GetQuadraticObjectiveMatrix(const DoubleMatrixType& areas, const DoubleMatrixType& means, const DoubleMatrixType& stds,
@@ -194,6 +220,12 @@ private:
   // Extract a sub matrix from indices list
   const DoubleMatrixType ExtractMatrix(const RealMatrixType& mat, const ListIndexType& idx);
 
+  // Solve a connected component with dense matrices (vnl)
+  bool SolveDense(const ListIndexType& list, DoubleVectorType& x);
+
+  // Solve a connected component with a sparse objective matrix
+  bool SolveSparse(const ListIndexType& list, DoubleVectorType& x);
+
   // Input
   RealMatrixType m_MeanInOverlaps;
   RealMatrixType m_StandardDeviationInOverlaps;
@@ -201,7 +233,8 @@ private:
   RealMatrixType m_MeanOfProductsInOverlaps;
 
   // Params
-  ValueType m_WeightOfStandardDeviationTerm; // could be manually tuned for different results
+  ValueType    m_WeightOfStandardDeviationTerm; // could be manually tuned for different results
+  unsigned int m_MaximumDenseComponentSize;     // larger components use the sparse solver
 
   // Output correction models
   RealVectorType m_OutputCorrectionModel;
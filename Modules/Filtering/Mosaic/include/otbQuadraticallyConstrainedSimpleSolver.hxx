@@ -24,6 +24,8 @@
 
 #include "otbQuadraticallyConstrainedSimpleSolver.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -31,6 +33,7 @@ template <class ValueType>
 QuadraticallyConstrainedSimpleSolver<ValueType>::QuadraticallyConstrainedSimpleSolver()
 {
   m_WeightOfStandardDeviationTerm = 1.0;
+  m_MaximumDenseComponentSize     = 200;
   oft                             = Cost_Function_rmse;
 }
 
@@ -40,25 +43,42 @@ QuadraticallyConstrainedSimpleSolver<ValueType>::~QuadraticallyConstrainedSimple
 }
 
 /*
- * Used to check layout topology consistency (Deep First Search)
+ * Used to check layout topology consistency (Breadth First Search)
  *
  * "m_AreaInOverlaps[i][j]>0" is equivalent to "images i and j are
  * overlapping with a non empty intersection (i.e. non null data)"
  */
 template <class ValueType>
-void QuadraticallyConstrainedSimpleSolver<ValueType>::DFS(std::vector<bool>& marked, unsigned int s) const
+void QuadraticallyConstrainedSimpleSolver<ValueType>::ComputeConnectedComponents(std::vector<ListIndexType>& components) const
 {
+  const unsigned int nbOfVertices = m_AreaInOverlaps.rows();
+  std::vector<bool>  marked(nbOfVertices, false);
 
-  // mark the s vertex
-  marked[s] = true;
-
-  // Get neighborhood
-  for (unsigned int i = 0; i < m_AreaInOverlaps.rows(); i++)
+  components.clear();
+  for (unsigned int start = 0; start < nbOfVertices; start++)
   {
-    if (s != i && m_AreaInOverlaps[s][i] > 0 && !marked[i])
+    if (marked[start])
     {
-      DFS(marked, i);
+      continue;
     }
+
+    // Visit the connected component of the first unmarked vertex
+    ListIndexType list(1, start);
+    marked[start] = true;
+    for (unsigned int next = 0; next < list.size(); next++)
+    {
+      const unsigned int s = list[next];
+      for (unsigned int i = 0; i < nbOfVertices; i++)
+      {
+        if (s != i && m_AreaInOverlaps[s][i] > 0 && !marked[i])
+        {
+          marked[i] = true;
+          list.push_back(i);
+        }
+      }
+    }
+    std::sort(list.begin(), list.end());
+    components.push_back(list);
   }
 }
 
@@ -108,6 +128,24 @@ void QuadraticallyConstrainedSimpleSolver<ValueType>::CheckInputs() const
   }
 }
 
+/*
+ * Weight of the STD terms of the objective function (not used by the RMSE
+ * based cost function)
+ */
+template <class ValueType>
+ValueType QuadraticallyConstrainedSimpleSolver<ValueType>::GetStandardDeviationWeight() const
+{
+  if (oft == Cost_Function_musig)
+  {
+    return 1.0;
+  }
+  if (oft == Cost_Function_weighted_musig)
+  {
+    return m_WeightOfStandardDeviationTerm;
+  }
+  return 0.0;
+}
+
 /*
  * Compute the objective function
  *
@@ -128,20 +166,7 @@ QuadraticallyConstrainedSimpleSolver<ValueType>::GetQuadraticObjectiveMatrix(con
                                                                              const DoubleMatrixType& stds, const DoubleMatrixType& mops)
 {
   // Set STD matrix weight
-  ValueType w;
-
-  if (oft == Cost_Function_mu)
-  {
-    w = 0.0;
-  }
-  if (oft == Cost_Function_musig)
-  {
-    w = 1.0;
-  }
-  if (oft == Cost_Function_weighted_musig)
-  {
-    w = (ValueType)m_WeightOfStandardDeviationTerm;
-  }
+  const ValueType w = GetStandardDeviationWeight();
 
   const unsigned int n = areas.cols();
 
@@ -207,57 +232,193 @@ QuadraticallyConstrainedSimpleSolver<ValueType>::ExtractMatrix(const RealMatrixT
 }
 
 /*
- * QP Solving using vnl
+ * Solve one connected component with dense matrices, using vnl
  */
 template <class ValueType>
-void QuadraticallyConstrainedSimpleSolver<ValueType>::Solve()
+bool QuadraticallyConstrainedSimpleSolver<ValueType>::SolveDense(const ListIndexType& list, DoubleVectorType& x)
 {
-  // Check matrices dimensions
-  CheckInputs();
+  const unsigned int n = list.size();
 
-  // Display a warning if overlap matrix is null
-  if (m_AreaInOverlaps.max_value() == 0)
+  // Extract matrices
+  DoubleMatrixType sub_areas = ExtractMatrix(m_AreaInOverlaps, list);
+  DoubleMatrixType sub_means = ExtractMatrix(m_MeanInOverlaps, list);
+  DoubleMatrixType sub_stdev = ExtractMatrix(m_StandardDeviationInOverlaps, list);
+  DoubleMatrixType sub_mOfPr = ExtractMatrix(m_MeanOfProductsInOverlaps, list);
+
+  // Objective function
+  DoubleMatrixType Q = GetQuadraticObjectiveMatrix(sub_areas, sub_means, sub_stdev, sub_mOfPr);
+  DoubleVectorType g(n, 0);
+
+  // Constraint (Energy conservation)
+  DoubleMatrixType A(1, n);
+  DoubleVectorType b(1, 0);
+  for (unsigned int i = 0; i < n; i++)
   {
-    itkExceptionMacro("No overlap in images!");
+    double energy = sub_areas[i][i] * sub_means[i][i];
+    b[0] += energy;
+    A[0][i] = energy;
   }
 
-  // Identify the connected components
-  unsigned int               nbOfComponents = m_AreaInOverlaps.rows();
-  unsigned int               nextVertex     = 0;
-  std::vector<ListIndexType> connectedComponentsIndices;
-  std::vector<bool>          markedVertices(nbOfComponents, false);
-  bool                       allMarked = false;
-  while (!allMarked)
+  // Change tol. to 0.01 is a quick hack to avoid numerical instability...
+  return vnl_solve_qp_with_non_neg_constraints(Q, g, A, b, x, 0.01);
+}
+
+/*
+ * Solve one connected component with a sparse objective matrix Q.
+ *
+ * Q is symmetric positive definite and has one non-zero term per pair of
+ * overlapping images. The minimum of x'Qx subject to A'x = b is
+ * x = b Q^-1 A / (A' Q^-1 A), Q^-1 A being computed with a Jacobi
+ * preconditioned conjugate gradient. Returns false if the conjugate
+ * gradient does not converge, or if the solution has negative terms (the
+ * non-negativity constraint would then be active).
+ */
+template <class ValueType>
+bool QuadraticallyConstrainedSimpleSolver<ValueType>::SolveSparse(const ListIndexType& list, DoubleVectorType& x)
+{
+  const unsigned int n            = list.size();
+  const unsigned int nbOfVertices = m_AreaInOverlaps.rows();
+  const double       w            = GetStandardDeviationWeight();
+
+  // Position of the images in the component
+  std::vector<int> position(nbOfVertices, -1);
+  for (unsigned int i = 0; i < n; i++)
   {
-    // Depth First Search starting from nextVertex
-    std::vector<bool> marked(nbOfComponents, false);
-    DFS(marked, nextVertex);
+    position[list[i]] = i;
+  }
 
-    // Id the connected component
-    ListIndexType list;
-    for (unsigned int i = 0; i < nbOfComponents; i++)
+  // Objective matrix (the diagonal term comes first in each row) and
+  // constraint (energy conservation)
+  SparseMatrixType Q(n);
+  DoubleVectorType A(n, 0);
+  double           b = 0;
+  for (unsigned int i = 0; i < n; i++)
+  {
+    const unsigned int im   = list[i];
+    double             diag = 0;
+    Q[i].push_back(std::make_pair(i, 0.0));
+    for (unsigned int k = 0; k < nbOfVertices; k++)
     {
-      if (marked[i])
+      const double area = m_AreaInOverlaps[im][k];
+      if (k == im || area <= 0 || position[k] < 0)
+      {
+        continue;
+      }
+      const double mean_ik = m_MeanInOverlaps[im][k];
+      double       offDiag;
+      if (oft == Cost_Function_rmse)
+      {
+        const double std_ik = m_StandardDeviationInOverlaps[im][k];
+        diag += area * (mean_ik * mean_ik + std_ik * std_ik);
+        offDiag = -area * m_MeanOfProductsInOverlaps[im][k];
+      }
+      else
       {
-        // Tag the connected component index
-        list.push_back(i);
-        markedVertices[i] = true;
+        const double mean_ki = m_MeanInOverlaps[k][im];
+        double       std_terms_ii = 0, std_terms_ik = 0;
+        if (w != 0)
+        {
+          std_terms_ii = w * m_StandardDeviationInOverlaps[im][k] * m_StandardDeviationInOverlaps[im][k];
+          std_terms_ik = w * m_StandardDeviationInOverlaps[im][k] * m_StandardDeviationInOverlaps[k][im];
+        }
+        diag += area * (mean_ik * mean_ik + std_terms_ii);
+        offDiag = -area * (mean_ik * mean_ki + std_terms_ik);
       }
-      else if (!markedVertices[i])
+      Q[i].push_back(std::make_pair(static_cast<unsigned int>(position[k]), offDiag));
+    }
+    Q[i][0].second = diag;
+
+    A[i] = m_AreaInOverlaps[im][im] * m_MeanInOverlaps[im][im];
+    b += A[i];
+  }
+
+  // Jacobi preconditioner
+  DoubleVectorType invDiag(n, 1);
+  for (unsigned int i = 0; i < n; i++)
+  {
+    if (Q[i][0].second > 0)
+    {
+      invDiag[i] = 1.0 / Q[i][0].second;
+    }
+  }
+
+  // Conjugate gradient: Q y = A
+  DoubleVectorType y(n, 0), r(A), z(n), p(n), q(n);
+  for (unsigned int i = 0; i < n; i++)
+  {
+    z[i] = invDiag[i] * r[i];
+  }
+  p                             = z;
+  double             rz         = dot_product(r, z);
+  const double       tolerance  = 1e-20 * dot_product(A, A);
+  const unsigned int iterations = std::max(1000u, 10 * n);
+  bool               converged  = false;
+  for (unsigned int iteration = 0; iteration < iterations && !converged; iteration++)
+  {
+    for (unsigned int i = 0; i < n; i++)
+    {
+      q[i] = 0;
+      for (const auto& term : Q[i])
       {
-        // if the i-th vertex is not marked, DFS will start from it next
-        nextVertex = i;
-        break;
+        q[i] += term.second * p[term.first];
       }
     }
-    connectedComponentsIndices.push_back(list);
+    const double pq = dot_product(p, q);
+    if (!(pq > 0))
+    {
+      return false;
+    }
+    const double alpha = rz / pq;
+    y += alpha * p;
+    r -= alpha * q;
+    if (dot_product(r, r) <= tolerance)
+    {
+      converged = true;
+      break;
+    }
+    for (unsigned int i = 0; i < n; i++)
+    {
+      z[i] = invDiag[i] * r[i];
+    }
+    const double rzNext = dot_product(r, z);
+    p *= rzNext / rz;
+    p += z;
+    rz = rzNext;
+  }
+  if (!converged)
+  {
+    return false;
+  }
 
-    // Check if vertices are all marked
-    allMarked = true;
-    for (unsigned int i = 0; i < nbOfComponents; i++)
-      if (!markedVertices[i])
-        allMarked = false;
+  // Scale the solution to satisfy the constraint
+  const double Ay = dot_product(A, y);
+  if (!(Ay > 0))
+  {
+    return false;
   }
+  x = y * (b / Ay);
+  return x.min_value() >= 0;
+}
+
+/*
+ * QP Solving using vnl
+ */
+template <class ValueType>
+void QuadraticallyConstrainedSimpleSolver<ValueType>::Solve()
+{
+  // Check matrices dimensions
+  CheckInputs();
+
+  // Display a warning if overlap matrix is null
+  if (m_AreaInOverlaps.max_value() == 0)
+  {
+    itkExceptionMacro("No overlap in images!");
+  }
+
+  // Identify the connected components
+  const unsigned int         nbOfComponents = m_AreaInOverlaps.rows();
+  std::vector<ListIndexType> connectedComponentsIndices;
+  ComputeConnectedComponents(connectedComponentsIndices);
 
   // Prepare output model
   m_OutputCorrectionModel.set_size(nbOfComponents);
@@ -270,34 +431,28 @@ void QuadraticallyConstrainedSimpleSolver<ValueType>::Solve()
   for (unsigned int component = 0; component < connectedComponentsIndices.size(); component++)
   {
     // Indices list
-    ListIndexType      list = connectedComponentsIndices[component];
-    const unsigned int n    = list.size();
-
-    // Extract matrices
-    DoubleMatrixType sub_areas = ExtractMatrix(m_AreaInOverlaps, list);
-    DoubleMatrixType sub_means = ExtractMatrix(m_MeanInOverlaps, list);
-    DoubleMatrixType sub_stdev = ExtractMatrix(m_StandardDeviationInOverlaps, list);
-    DoubleMatrixType sub_mOfPr = ExtractMatrix(m_MeanOfProductsInOverlaps, list);
-
-    // Objective function
-    DoubleMatrixType Q = GetQuadraticObjectiveMatrix(sub_areas, sub_means, sub_stdev, sub_mOfPr);
-    DoubleVectorType g(n, 0);
-
-    // Constraint (Energy conservation)
-    DoubleMatrixType A(1, n);
-    DoubleVectorType b(1, 0);
-    for (unsigned int i = 0; i < n; i++)
-    {
-      double energy = sub_areas[i][i] * sub_means[i][i];
-      b[0] += energy;
-      A[0][i] = energy;
-    }
+    const ListIndexType& list = connectedComponentsIndices[component];
+    const unsigned int   n    = list.size();
 
     // Solution
     DoubleVectorType x(n, 1);
 
-    // Change tol. to 0.01 is a quick hack to avoid numerical instability...
-    bool solv = vnl_solve_qp_with_non_neg_constraints(Q, g, A, b, x, 0.01);
+    bool solv;
+    if (n > m_MaximumDenseComponentSize)
+    {
+      solv = SolveSparse(list, x);
+      if (!solv)
+      {
+        itkWarningMacro("Sparse solver failed for component #" << component << ", using vnl_solve_qp_with_non_neg_constraints");
+        x.fill(1);
+        solv = SolveDense(list, x);
+      }
+    }
+    else
+    {
+      solv = SolveDense(list, x);
+    }
+
     if (solv)
     {
       for (unsigned int i = 0; i < n; i++)
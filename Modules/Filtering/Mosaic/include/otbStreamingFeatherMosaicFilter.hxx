@@ -51,9 +51,6 @@ void StreamingFeatherMosaicFilter<TInputImage, TOutputImage, TDistanceImage, TIn
   // Get output pointer
   OutputImageType* mosaicImage = this->GetOutput();
 
-  // Get number of used inputs
-  const unsigned int nbOfUsedInputImages = Superclass::GetNumberOfUsedInputImages();
-
   // Get number of bands
   const unsigned int nBands = Superclass::GetNumberOfBands();
 
@@ -65,6 +62,10 @@ void StreamingFeatherMosaicFilter<TInputImage, TOutputImage, TDistanceImage, TIn
   typename std::vector<InterpolatorPointerType> interp;
   Superclass::PrepareImageAccessors(currentImage, interp);
 
+  // Used input images intersecting the thread region
+  typename Superclass::IndicesListType threadImages;
+  Superclass::GetUsedInputImagesInRegion(outputRegionForThread, threadImages);
+
   // Prepare input pointers, interpolators, and valid regions (distances images)
   typename std::vector<DistanceImageType*>               currentDistanceImage;
   typename std::vector<DistanceImageInterpolatorPointer> distanceInterpolator;
@@ -96,8 +97,9 @@ void StreamingFeatherMosaicFilter<TInputImage, TOutputImage, TDistanceImage, TIn
     tempOutputPixel.Fill(0.0);
 
     // Loop on used input images
-    for (i = 0; i < nbOfUsedInputImages; i++)
+    for (unsigned int position : threadImages)
     {
+      i = position;
 
       // Check if the point is inside the transformed thread region
       // (i.e. the region in the current input image which match the thread
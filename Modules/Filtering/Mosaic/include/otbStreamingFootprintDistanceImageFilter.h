@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __StreamingFootprintDistanceImageFilter_H
+#define __StreamingFootprintDistanceImageFilter_H
+
+#include "itkImageToImageFilter.h"
+
+namespace otb
+{
+/** \class StreamingFootprintDistanceImageFilter
+ * \brief Computes, tile by tile, the distance to the edges of the valid
+ * data footprint of an image.
+ *
+ * This filter produces the distance images used by the feathering mosaic
+ * filters (StreamingFeatherMosaicFilter, StreamingLargeFeatherMosaicFilter)
+ * without computing them beforehand on the whole image.
+ *
+ * An input pixel is valid when at least one of its bands differs from the
+ * no-data pixel. The output grid has the origin of the input image, and a
+ * spacing multiplied by the sampling ratio. Each output pixel contains the
+ * physical distance between its center and the nearest invalid pixel, the
+ * outside of the image being invalid, and invalid pixels are set to 0.
+ *
+ * Distances are computed with a two-pass 3x3 chamfer transform on the
+ * requested region padded by the margin, so they are only known up to this
+ * margin: larger distances are set to the margin. With the
+ * StreamingFeatherMosaicFilter, a margin equal to the feathering transition
+ * distance plus the distance offset gives the same weights as complete
+ * distance images.
+ *
+ * Support streaming
+ *
+ * \ingroup OTBMosaic
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT StreamingFootprintDistanceImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedef */
+  typedef StreamingFootprintDistanceImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(StreamingFootprintDistanceImageFilter, ImageToImageFilter);
+
+  /** Input image typedefs */
+  typedef TInputImage                                InputImageType;
+  typedef typename InputImageType::RegionType        InputImageRegionType;
+  typedef typename InputImageType::PixelType         InputImagePixelType;
+  typedef typename InputImageType::IndexType         InputImageIndexType;
+  typedef typename InputImageType::InternalPixelType InputImageInternalPixelType;
+
+  /** Output image typedefs */
+  typedef TOutputImage                         OutputImageType;
+  typedef typename OutputImageType::RegionType OutputImageRegionType;
+  typedef typename OutputImageType::IndexType  OutputImageIndexType;
+  typedef typename OutputImageType::SizeType   OutputImageSizeType;
+  typedef typename OutputImageType::PixelType  OutputImagePixelType;
+
+  /** Set/Get the input no data value */
+  itkSetMacro(NoDataInputPixel, InputImagePixelType);
+  itkGetMacro(NoDataInputPixel, InputImagePixelType);
+
+  /** Set/Get the ratio between the output spacing and the input spacing */
+  itkSetMacro(SamplingRatio, double);
+  itkGetMacro(SamplingRatio, double);
+
+  /** Set/Get the distance up to which distances are computed (physical units) */
+  itkSetMacro(Margin, double);
+  itkGetMacro(Margin, double);
+
+protected:
+  StreamingFootprintDistanceImageFilter();
+  ~StreamingFootprintDistanceImageFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void GenerateInputRequestedRegion() override;
+
+  void GenerateData() override;
+
+  /** Region of the output grid whose distances are needed to compute the
+   * given output region */
+  virtual OutputImageRegionType PadOutputRegion(const OutputImageRegionType& outputRegion) const;
+
+  /** Index of the input pixel sampled by the given output index */
+  virtual InputImageIndexType OutputIndexToInputIndex(const OutputImageIndexType& outputIndex) const;
+
+private:
+  StreamingFootprintDistanceImageFilter(const Self&); // purposely not implemented
+  void operator=(const Self&);                        // purposely not implemented
+
+  InputImagePixelType m_NoDataInputPixel; // No data (input)
+  double              m_SamplingRatio;    // Output spacing / input spacing
+  double              m_Margin;           // Maximum computed distance
+
+}; // end of class
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingFootprintDistanceImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,290 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+#ifndef __StreamingFootprintDistanceImageFilter_hxx
+#define __StreamingFootprintDistanceImageFilter_hxx
+
+#include "otbStreamingFootprintDistanceImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+StreamingFootprintDistanceImageFilter<TInputImage, TOutputImage>::StreamingFootprintDistanceImageFilter()
+{
+  m_SamplingRatio = 1.0;
+  m_Margin        = 0.0;
+}
+
+/**
+ * Output grid: origin of the input image, spacing multiplied by the
+ * sampling ratio
+ */
+template <class TInputImage, class TOutputImage>
+void StreamingFootprintDistanceImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  if (m_SamplingRatio <= 0)
+  {
+    itkExceptionMacro(<< "Sampling ratio must be positive (got " << m_SamplingRatio << ")");
+  }
+  if (m_Margin <= 0)
+  {
+    itkExceptionMacro(<< "Margin must be positive (got " << m_Margin << ")");
+  }
+
+  const InputImageType* inputPtr  = this->GetInput();
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  const InputImageRegionType& inputRegion = inputPtr->GetLargestPossibleRegion();
+
+  typename OutputImageType::PointType origin;
+  inputPtr->TransformIndexToPhysicalPoint(inputRegion.GetIndex(), origin);
+
+  typename OutputImageType::SpacingType spacing = inputPtr->GetSignedSpacing();
+  OutputImageSizeType                   size;
+  for (unsigned int dim = 0; dim < OutputImageType::ImageDimension; ++dim)
+  {
+    spacing[dim] *= m_SamplingRatio;
+    size[dim] = inputRegion.GetSize(dim) / m_SamplingRatio + 1;
+  }
+
+  OutputImageIndexType start;
+  start.Fill(0);
+  outputPtr->SetOrigin(origin);
+  outputPtr->SetSignedSpacing(spacing);
+  outputPtr->SetLargestPossibleRegion(OutputImageRegionType(start, size));
+}
+
+template <class TInputImage, class TOutputImage>
+typename StreamingFootprintDistanceImageFilter<TInputImage, TOutputImage>::OutputImageRegionType
+StreamingFootprintDistanceImageFilter<TInputImage, TOutputImage>::PadOutputRegion(const OutputImageRegionType& outputRegion) const
+{
+  // One more pixel, so that the outside of the image is seen at its border
+  const typename OutputImageType::SpacingType spacing = this->GetOutput()->GetSignedSpacing();
+  OutputImageSizeType                         radius;
+  for (unsigned int dim = 0; dim < OutputImageType::ImageDimension; ++dim)
+  {
+    radius[dim] = std::ceil(m_Margin / std::abs(spacing[dim])) + 1;
+  }
+
+  OutputImageRegionType window = outputRegion;
+  window.PadByRadius(radius);
+  return window;
+}
+
+template <class TInputImage, class TOutputImage>
+typename StreamingFootprintDistanceImageFilter<TInputImage, TOutputImage>::InputImageIndexType
+StreamingFootprintDistanceImageFilter<TInputImage, TOutputImage>::OutputIndexToInputIndex(const OutputImageIndexType& outputIndex) const
+{
+  const InputImageIndexType& start = this->GetInput()->GetLargestPossibleRegion().GetIndex();
+  InputImageIndexType        inputIndex;
+  for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+  {
+    inputIndex[dim] = start[dim] + std::lround(outputIndex[dim] * m_SamplingRatio);
+  }
+  return inputIndex;
+}
+
+/**
+ * The input requested region covers the output requested region padded by
+ * the margin
+ */
+template <class TInputImage, class TOutputImage>
+void StreamingFootprintDistanceImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  const OutputImageRegionType outputRegion = this->GetOutput()->GetRequestedRegion();
+  InputImageRegionType        inputRegion;
+
+  // The mosaic filters request null regions for the images they do not use
+  if (outputRegion.GetNumberOfPixels() == 0)
+  {
+    inputRegion.GetModifiableSize().Fill(0);
+    inputRegion.GetModifiableIndex().Fill(0);
+    inputPtr->SetRequestedRegion(inputRegion);
+    return;
+  }
+
+  const OutputImageRegionType window = PadOutputRegion(outputRegion);
+  const InputImageIndexType   start  = OutputIndexToInputIndex(window.GetIndex());
+  const InputImageIndexType   end    = OutputIndexToInputIndex(window.GetUpperIndex());
+  inputRegion.SetIndex(start);
+  for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+  {
+    inputRegion.SetSize(dim, end[dim] - start[dim] + 1);
+  }
+
+  if (!inputRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    itk::InvalidRequestedRegionError e(__FILE__, __LINE__);
+    e.SetLocation(ITK_LOCATION);
+    e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+    e.SetDataObject(inputPtr);
+    throw e;
+  }
+  inputPtr->SetRequestedRegion(inputRegion);
+}
+
+/**
+ * Processing
+ */
+template <class TInputImage, class TOutputImage>
+void StreamingFootprintDistanceImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const InputImageType* inputPtr  = this->GetInput();
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  const OutputImageRegionType outputRegion = outputPtr->GetRequestedRegion();
+  if (outputRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // Support progress methods/callbacks
+  itk::ProgressReporter progress(this, 0, outputRegion.GetNumberOfPixels());
+
+  // No data pixel (default: zeros)
+  const unsigned int  nbOfBands = inputPtr->GetNumberOfComponentsPerPixel();
+  InputImagePixelType noData    = m_NoDataInputPixel;
+  if (noData.GetSize() != nbOfBands)
+  {
+    noData.SetSize(nbOfBands);
+    noData.Fill(itk::NumericTraits<InputImageInternalPixelType>::Zero);
+  }
+
+  // Distances over the padded region: 0 for the invalid pixels, margin for
+  // the valid ones
+  const OutputImageRegionType window = PadOutputRegion(outputRegion);
+  const unsigned int          sizeX  = window.GetSize(0);
+  const unsigned int          sizeY  = window.GetSize(1);
+  std::vector<double>         distance(static_cast<std::size_t>(sizeX) * sizeY);
+
+  const InputImageRegionType& bufferedRegion = inputPtr->GetBufferedRegion();
+  OutputImageIndexType        outputIndex;
+  for (unsigned int y = 0; y < sizeY; ++y)
+  {
+    outputIndex[1] = window.GetIndex(1) + y;
+    for (unsigned int x = 0; x < sizeX; ++x)
+    {
+      outputIndex[0]                  = window.GetIndex(0) + x;
+      const InputImageIndexType index = OutputIndexToInputIndex(outputIndex);
+
+      bool isValid = false;
+      if (bufferedRegion.IsInside(index))
+      {
+        const InputImagePixelType pixel = inputPtr->GetPixel(index);
+        for (unsigned int band = 0; band < nbOfBands && !isValid; ++band)
+        {
+          isValid = (pixel[band] != noData[band]);
+        }
+      }
+      distance[y * sizeX + x] = isValid ? m_Margin : 0.0;
+    }
+  }
+
+  // Chamfer mask weights
+  const typename OutputImageType::SpacingType spacing = outputPtr->GetSignedSpacing();
+  const double                                dx      = std::abs(spacing[0]);
+  const double                                dy      = std::abs(spacing[1]);
+  const double                                dxy     = std::sqrt(dx * dx + dy * dy);
+
+  // Forward pass
+  for (unsigned int y = 0; y < sizeY; ++y)
+  {
+    for (unsigned int x = 0; x < sizeX; ++x)
+    {
+      double& d = distance[y * sizeX + x];
+      if (x > 0)
+      {
+        d = std::min(d, distance[y * sizeX + x - 1] + dx);
+      }
+      if (y > 0)
+      {
+        const std::size_t above = (y - 1) * sizeX + x;
+        d                       = std::min(d, distance[above] + dy);
+        if (x > 0)
+        {
+          d = std::min(d, distance[above - 1] + dxy);
+        }
+        if (x + 1 < sizeX)
+        {
+          d = std::min(d, distance[above + 1] + dxy);
+        }
+      }
+    }
+  }
+
+  // Backward pass
+  for (unsigned int y = sizeY; y-- > 0;)
+  {
+    for (unsigned int x = sizeX; x-- > 0;)
+    {
+      double& d = distance[y * sizeX + x];
+      if (x + 1 < sizeX)
+      {
+        d = std::min(d, distance[y * sizeX + x + 1] + dx);
+      }
+      if (y + 1 < sizeY)
+      {
+        const std::size_t below = (y + 1) * sizeX + x;
+        d                       = std::min(d, distance[below] + dy);
+        if (x > 0)
+        {
+          d = std::min(d, distance[below - 1] + dxy);
+        }
+        if (x + 1 < sizeX)
+        {
+          d = std::min(d, distance[below + 1] + dxy);
+        }
+      }
+    }
+  }
+
+  // Copy the requested region
+  itk::ImageRegionIterator<OutputImageType> outputIt(outputPtr, outputRegion);
+  for (outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt)
+  {
+    const OutputImageIndexType& index = outputIt.GetIndex();
+    const std::size_t           x     = index[0] - window.GetIndex(0);
+    const std::size_t           y     = index[1] - window.GetIndex(1);
+    outputIt.Set(static_cast<OutputImagePixelType>(distance[y * sizeX + x]));
+    progress.CompletedPixel();
+  }
+}
+
+} // end namespace otb
+
+#endif
@@ -25,6 +25,7 @@
 #include "itkImageToImageFilter.h"
 #include "itkNearestNeighborInterpolateImageFunction.h"
 #include "otbStreamingTraits.h"
+#include "otbEnvelopeSTRTree.h"
 
 // No data
 #include "otbNoDataHelper.h"
@@ -45,6 +46,10 @@ namespace otb
  * the  interpolator (SetInterpolator()) and the origin (SetOrigin())
  * can be set using the method between brackets.
  *
+ * The footprints of the input images are indexed in an R-tree, so that
+ * only the images intersecting the output requested region, and then
+ * the region of each thread, are visited.
+ *
  *
  * \ingroup OTBMosaic
  *
@@ -203,6 +208,16 @@ protected:
     return usedInputIndices.size();
   }
 
+  /** Get the positions, in the used input images, of the images whose
+   * footprint intersects the given output region */
+  virtual void GetUsedInputImagesInRegion(const OutputImageRegionType& outputRegion, IndicesListType& positions);
+
+  /** Convert an output region to its physical envelope */
+  virtual void OutputRegionToEnvelope(const OutputImageRegionType& outputRegion, OGREnvelope& envelope);
+
+  /** Index the footprints of the input images */
+  virtual void BuildFootprintIndex();
+
   /** Compute output mosaic parameters (size, spacing, origin, ...) */
   virtual void ComputeOutputParameters();
 
@@ -221,6 +236,9 @@ protected:
   /** Compute the requested region of a given input image */
   virtual void ComputeRequestedRegionOfInputImage(unsigned int inputImageIndex);
 
+  /** Set a null requested region to a given input image */
+  virtual void ClearRequestedRegionOfInputImage(unsigned int inputImageIndex);
+
   /** Shift-Scale a value */
   virtual void ShiftScaleValue(InternalValueType& value, const unsigned int& imageIndex, unsigned int& band)
   {
@@ -258,6 +276,7 @@ private:
   IndicesListType   usedInputIndices;   // requested input image indices
   InternalValueType minOutputPixelValue;
   InternalValueType maxOutputPixelValue;
+  EnvelopeSTRTree   footprintIndex; // R-tree of the input images footprints
 
 }; // end of class
 
@@ -24,6 +24,8 @@
 
 #include "otbStreamingMosaicFilterBase.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -155,10 +157,104 @@ void StreamingMosaicFilterBase<TInputImage, TOutputImage, TInternalValueType>::G
 {
   usedInputIndices.clear();
 
-  // For each image, get the requested region
+  if (footprintIndex.GetNumberOfItems() != this->GetNumberOfInputs())
+  {
+    BuildFootprintIndex();
+  }
+
+  // Only the images whose footprint intersects the requested region are
+  // checked, the other ones get a null requested region
+  OGREnvelope envelope;
+  OutputRegionToEnvelope(this->GetOutput()->GetRequestedRegion(), envelope);
+  const EnvelopeSTRTree::ItemListType candidates = footprintIndex.Query(envelope);
+
+  EnvelopeSTRTree::ItemListType::const_iterator candidate = candidates.begin();
+  for (unsigned int i = 0; i < this->GetNumberOfInputs(); ++i)
+  {
+    if (candidate != candidates.end() && *candidate == i)
+    {
+      ComputeRequestedRegionOfInputImage(i);
+      ++candidate;
+    }
+    else
+    {
+      ClearRequestedRegionOfInputImage(i);
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TInternalValueType>
+void StreamingMosaicFilterBase<TInputImage, TOutputImage, TInternalValueType>::ClearRequestedRegionOfInputImage(unsigned int inputImageIndex)
+{
+  InputImageType*      inputTile = static_cast<InputImageType*>(Superclass::ProcessObject::GetInput(inputImageIndex));
+  InputImageRegionType inRegion;
+  inRegion.GetModifiableSize().Fill(0);
+  inRegion.GetModifiableIndex().Fill(0);
+  inputTile->SetRequestedRegion(inRegion);
+}
+
+/**
+ * Physical envelope of an output region, pixels included
+ */
+template <class TInputImage, class TOutputImage, class TInternalValueType>
+void StreamingMosaicFilterBase<TInputImage, TOutputImage, TInternalValueType>::OutputRegionToEnvelope(const OutputImageRegionType& outputRegion,
+                                                                                                      OGREnvelope&                 envelope)
+{
+  OutputImagePointType pointStart, pointEnd;
+  this->GetOutput()->TransformIndexToPhysicalPoint(outputRegion.GetIndex(), pointStart);
+  this->GetOutput()->TransformIndexToPhysicalPoint(outputRegion.GetUpperIndex(), pointEnd);
+
+  const OutputImageSpacingType spacing = this->GetOutput()->GetSignedSpacing();
+  envelope.MinX                        = vnl_math_min(pointStart[0], pointEnd[0]) - 0.5 * vcl_abs(spacing[0]);
+  envelope.MaxX                        = vnl_math_max(pointStart[0], pointEnd[0]) + 0.5 * vcl_abs(spacing[0]);
+  envelope.MinY                        = vnl_math_min(pointStart[1], pointEnd[1]) - 0.5 * vcl_abs(spacing[1]);
+  envelope.MaxY                        = vnl_math_max(pointStart[1], pointEnd[1]) + 0.5 * vcl_abs(spacing[1]);
+}
+
+/**
+ * Index the input images footprints. Footprints are padded like the
+ * requested regions (one pixel and the interpolator radius, plus one pixel
+ * for the extent of the border pixels), so that the R-tree never misses an
+ * image that OutputRegionToInputRegion() would keep.
+ */
+template <class TInputImage, class TOutputImage, class TInternalValueType>
+void StreamingMosaicFilterBase<TInputImage, TOutputImage, TInternalValueType>::BuildFootprintIndex()
+{
+  footprintIndex.Clear();
   for (unsigned int i = 0; i < this->GetNumberOfInputs(); ++i)
   {
-    ComputeRequestedRegionOfInputImage(i);
+    InputImageType* currentImage = static_cast<InputImageType*>(Superclass::ProcessObject::GetInput(i));
+
+    InputImagePointType extentInf, extentSup;
+    ImageToExtent(currentImage, extentInf, extentSup);
+
+    const double marginX = (interpolatorRadius + 2) * vcl_abs(currentImage->GetSignedSpacing()[0]);
+    const double marginY = (interpolatorRadius + 2) * vcl_abs(currentImage->GetSignedSpacing()[1]);
+    OGREnvelope  footprint;
+    footprint.MinX = extentInf[0] - marginX;
+    footprint.MaxX = extentSup[0] + marginX;
+    footprint.MinY = extentInf[1] - marginY;
+    footprint.MaxY = extentSup[1] + marginY;
+    footprintIndex.Insert(footprint, i);
+  }
+  footprintIndex.Build();
+}
+
+template <class TInputImage, class TOutputImage, class TInternalValueType>
+void StreamingMosaicFilterBase<TInputImage, TOutputImage, TInternalValueType>::GetUsedInputImagesInRegion(const OutputImageRegionType& outputRegion,
+                                                                                                          IndicesListType&             positions)
+{
+  OGREnvelope envelope;
+  OutputRegionToEnvelope(outputRegion, envelope);
+  const EnvelopeSTRTree::ItemListType candidates = footprintIndex.Query(envelope);
+
+  positions.clear();
+  for (unsigned int i = 0; i < usedInputIndices.size(); ++i)
+  {
+    if (std::binary_search(candidates.begin(), candidates.end(), static_cast<EnvelopeSTRTree::ItemType>(usedInputIndices[i])))
+    {
+      positions.push_back(i);
+    }
   }
 }
 
@@ -369,6 +465,9 @@ void StreamingMosaicFilterBase<TInputImage, TOutputImage, TInternalValueType>::G
   {
     CheckShiftScaleMatrices();
   }
+
+  // Index the input images footprints
+  BuildFootprintIndex();
 }
 
 /*
@@ -44,9 +44,6 @@ void StreamingSimpleMosaicFilter<TInputImage, TOutputImage, TInternalValueType>:
   // Get output pointer
   OutputImageType* mosaicImage = this->GetOutput();
 
-  // Get number of used inputs
-  const unsigned int nbOfUsedInputImages = Superclass::GetNumberOfUsedInputImages();
-
   // Get number of bands
   const unsigned int nBands = Superclass::GetNumberOfBands();
 
@@ -62,6 +59,10 @@ void StreamingSimpleMosaicFilter<TInputImage, TOutputImage, TInternalValueType>:
   typename std::vector<InterpolatorPointerType> interp;
   Superclass::PrepareImageAccessors(currentImage, interp);
 
+  // Used input images intersecting the thread region
+  typename Superclass::IndicesListType threadImages;
+  Superclass::GetUsedInputImagesInRegion(outputRegionForThread, threadImages);
+
   // Container for geo coordinates
   OutputImagePointType geoPoint;
 
@@ -74,7 +75,7 @@ void StreamingSimpleMosaicFilter<TInputImage, TOutputImage, TInternalValueType>:
     mosaicImage->TransformIndexToPhysicalPoint(outputIt.GetIndex(), geoPoint);
 
     // Loop on used input images
-    for (unsigned int i = 0; i < nbOfUsedInputImages; i++)
+    for (unsigned int i : threadImages)
     {
       // Get the input image pointer
       unsigned int imgIndex = Superclass::GetUsedInputImageIndice(i);
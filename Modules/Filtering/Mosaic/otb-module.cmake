@@ -28,6 +28,7 @@ otb_module(OTBMosaic
     OTBCommon
     OTBConversion
     OTBFunctor
+    OTBOGRProcessing
 
   TEST_DEPENDS
 
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbHermitianEigenSolver3x3_h
+#define otbHermitianEigenSolver3x3_h
+
+#include <algorithm>
+#include <complex>
+#include <cmath>
+#include <limits>
+
+namespace otb
+{
+
+/** \class HermitianEigenSolver3x3
+ * \brief Eigen decomposition of a 3x3 Hermitian matrix.
+ *
+ * The matrix is diagonalised with the cyclic Jacobi method, using complex
+ * rotations on stack arrays only, so that it can be called for each pixel
+ * without any allocation. A few sweeps are enough to reach the machine
+ * precision for such matrices.
+ *
+ * The matrix is given by its upper triangle in the order
+ * (0,0) (0,1) (0,2) (1,1) (1,2) (2,2), which is the layout of the
+ * reciprocal coherency and covariance matrix images.
+ *
+ * \ingroup OTBPolarimetry
+ */
+template <class TValue>
+class HermitianEigenSolver3x3
+{
+public:
+  typedef TValue               ValueType;
+  typedef std::complex<TValue> ComplexType;
+
+  /** Compute the eigen values in decreasing order, and the unit eigen
+   * vector eigenVectors[k] of each eigen value eigenValues[k]. */
+  static void Compute(const ComplexType upper[6], ValueType eigenValues[3], ComplexType eigenVectors[3][3])
+  {
+    ComplexType a[3][3];
+    a[0][0] = ComplexType(upper[0].real(), 0.);
+    a[0][1] = upper[1];
+    a[0][2] = upper[2];
+    a[1][0] = std::conj(upper[1]);
+    a[1][1] = ComplexType(upper[3].real(), 0.);
+    a[1][2] = upper[4];
+    a[2][0] = std::conj(upper[2]);
+    a[2][1] = std::conj(upper[4]);
+    a[2][2] = ComplexType(upper[5].real(), 0.);
+
+    // Product of the rotations, whose columns are the eigen vectors
+    ComplexType v[3][3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        v[i][j] = ComplexType(i == j ? 1. : 0., 0.);
+      }
+    }
+
+    ValueType norm = 0.;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        norm += std::norm(a[i][j]);
+      }
+    }
+    const ValueType epsilon   = std::numeric_limits<ValueType>::epsilon();
+    const ValueType threshold = epsilon * epsilon * norm;
+
+    static const unsigned int pairs[3][2] = {{0, 1}, {0, 2}, {1, 2}};
+
+    for (unsigned int sweep = 0; sweep < MaximumNumberOfSweeps; ++sweep)
+    {
+      if (std::norm(a[0][1]) + std::norm(a[0][2]) + std::norm(a[1][2]) <= threshold)
+      {
+        break;
+      }
+
+      for (unsigned int n = 0; n < 3; ++n)
+      {
+        const unsigned int p = pairs[n][0];
+        const unsigned int q = pairs[n][1];
+
+        const ValueType r = std::abs(a[p][q]);
+        if (r == 0.)
+        {
+          continue;
+        }
+
+        // Phase the (p, q) element to a real value, then apply the real
+        // rotation that cancels it
+        const ComplexType phase = std::conj(a[p][q] / r);
+        const ValueType   theta = (a[q][q].real() - a[p][p].real()) / (2. * r);
+        const ValueType   t     = (theta >= 0. ? 1. : -1.) / (std::abs(theta) + std::sqrt(theta * theta + 1.));
+        const ValueType   c     = 1. / std::sqrt(t * t + 1.);
+        const ValueType   s     = t * c;
+        const ComplexType vqp   = -s * phase;
+        const ComplexType vqq   = c * phase;
+
+        // a = a * rotation and v = v * rotation
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+          const ComplexType akp = a[k][p];
+          const ComplexType akq = a[k][q];
+          a[k][p]               = c * akp + vqp * akq;
+          a[k][q]               = s * akp + vqq * akq;
+
+          const ComplexType vkp = v[k][p];
+          const ComplexType vkq = v[k][q];
+          v[k][p]               = c * vkp + vqp * vkq;
+          v[k][q]               = s * vkp + vqq * vkq;
+        }
+
+        // a = rotation^H * a
+        for (unsigned int k = 0; k < 3; ++k)
+        {
+          const ComplexType apk = a[p][k];
+          const ComplexType aqk = a[q][k];
+          a[p][k]               = c * apk + std::conj(vqp) * aqk;
+          a[q][k]               = s * apk + std::conj(vqq) * aqk;
+        }
+
+        a[p][q] = ComplexType(0., 0.);
+        a[q][p] = ComplexType(0., 0.);
+        a[p][p] = ComplexType(a[p][p].real(), 0.);
+        a[q][q] = ComplexType(a[q][q].real(), 0.);
+      }
+    }
+
+    // Sort the eigen values in decreasing order
+    unsigned int order[3] = {0, 1, 2};
+    std::sort(order, order + 3, [&a](unsigned int i, unsigned int j) { return a[i][i].real() > a[j][j].real(); });
+
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      eigenValues[k] = a[order[k]][order[k]].real();
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        eigenVectors[k][i] = v[i][order[k]];
+      }
+    }
+  }
+
+private:
+  static constexpr unsigned int MaximumNumberOfSweeps = 20;
+};
+
+} // end namespace otb
+
+#endif
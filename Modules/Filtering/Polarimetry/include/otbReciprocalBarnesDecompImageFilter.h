@@ -23,8 +23,7 @@
 #define otbReciprocalBarnesDecompImageFilter_h
 
 #include "otbMath.h"
-#include "vnl/algo/vnl_complex_eigensystem.h"
-#include <algorithm>
+#include <complex>
 
 #include "otbFunctorImageFilter.h"
 
@@ -47,19 +46,11 @@ class ReciprocalBarnesDecompFunctor
 {
 public:
   typedef typename std::complex<double> ComplexType;
-  typedef vnl_matrix<ComplexType>       VNLMatrixType;
-  typedef vnl_vector<ComplexType>       VNLVectorType;
-  typedef vnl_vector<double>            VNLDoubleVectorType;
-  typedef std::vector<double>           VectorType;
   typedef typename TOutput::ValueType   OutputValueType;
 
   inline void operator()(TOutput& result, const TInput& Covariance) const
   {
-
-    VNLMatrixType qi(3, 1);
-
-
-    VNLMatrixType cov(3, 3);
+    ComplexType cov[3][3];
     cov[0][0] = ComplexType(Covariance[0]);
     cov[0][1] = ComplexType(Covariance[1]);
     cov[0][2] = ComplexType(Covariance[2]);
@@ -70,35 +61,22 @@ public:
     cov[2][1] = std::conj(ComplexType(Covariance[4]));
     cov[2][2] = ComplexType(Covariance[5]);
 
+    ComplexType qi[3];
+
+    qi[0] = ComplexType(1., 0.);
+    qi[1] = ComplexType(0., 0.);
+    qi[2] = ComplexType(0., 0.);
+    Project(result, 0, cov, qi);
 
-    qi[0][0]           = ComplexType(1., 0.);
-    qi[1][0]           = ComplexType(0., 0.);
-    qi[2][0]           = ComplexType(0., 0.);
-    ComplexType   norm = (qi.conjugate_transpose() * cov * qi)[0][0];
-    VNLMatrixType ki   = cov * qi / std::sqrt(norm);
-    result[0]          = static_cast<OutputValueType>(ki[0][0]);
-    result[1]          = static_cast<OutputValueType>(ki[1][0]);
-    result[2]          = static_cast<OutputValueType>(ki[2][0]);
-
-
-    qi[0][0]  = ComplexType(0., 0.);
-    qi[1][0]  = ComplexType(1. / std::sqrt(2.), 0.);
-    qi[2][0]  = ComplexType(0., 1. / std::sqrt(2.));
-    norm      = (qi.conjugate_transpose() * cov * qi)[0][0];
-    ki        = cov * qi / std::sqrt(norm);
-    result[3] = static_cast<OutputValueType>(ki[0][0]);
-    result[4] = static_cast<OutputValueType>(ki[1][0]);
-    result[5] = static_cast<OutputValueType>(ki[2][0]);
-
-
-    qi[0][0]  = ComplexType(0., 0.);
-    qi[1][0]  = ComplexType(0., 1. / std::sqrt(2.));
-    qi[2][0]  = ComplexType(1. / std::sqrt(2.), 0.);
-    norm      = (qi.conjugate_transpose() * cov * qi)[0][0];
-    ki        = cov * qi / std::sqrt(norm);
-    result[6] = static_cast<OutputValueType>(ki[0][0]);
-    result[7] = static_cast<OutputValueType>(ki[1][0]);
-    result[8] = static_cast<OutputValueType>(ki[2][0]);
+    qi[0] = ComplexType(0., 0.);
+    qi[1] = ComplexType(1. / std::sqrt(2.), 0.);
+    qi[2] = ComplexType(0., 1. / std::sqrt(2.));
+    Project(result, 3, cov, qi);
+
+    qi[0] = ComplexType(0., 0.);
+    qi[1] = ComplexType(0., 1. / std::sqrt(2.));
+    qi[2] = ComplexType(1. / std::sqrt(2.), 0.);
+    Project(result, 6, cov, qi);
   }
 
   constexpr size_t OutputSize(...) const
@@ -108,6 +86,32 @@ public:
   }
 
 private:
+  /** Write cov * qi / sqrt(qi^H * cov * qi) at the given offset of result */
+  inline void Project(TOutput& result, unsigned int offset, const ComplexType cov[3][3], const ComplexType qi[3]) const
+  {
+    ComplexType norm(0., 0.);
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      ComplexType row(0., 0.);
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        row += std::conj(qi[i]) * cov[i][j];
+      }
+      norm += row * qi[j];
+    }
+
+    const ComplexType scale = std::sqrt(norm);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      ComplexType ki(0., 0.);
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        ki += cov[i][j] * qi[j];
+      }
+      result[offset + i] = static_cast<OutputValueType>(ki / scale);
+    }
+  }
+
   static constexpr double m_Epsilon = 1e-6;
 };
 } // namespace Functor
@@ -23,6 +23,7 @@
 #define otbReciprocalHAlphaImageFilter_h
 
 #include "otbMath.h"
+#include "otbHermitianEigenSolver3x3.h"
 #include "vnl/algo/vnl_complex_eigensystem.h"
 #include <algorithm>
 #include <vector>
@@ -59,41 +60,56 @@ namespace Functor
  * - \f$ if p[i] > 1, p[i]=1 \f$
  * - \f$ if \alpha_{i} > 90, \alpha_{i}=90 \f$
  *
+ * The matrix is diagonalised with HermitianEigenSolver3x3, which does not
+ * allocate. Evaluate() takes the upper triangle of the matrix directly,
+ * for callers that build it themselves.
+ *
  * \ingroup OTBPolarimetry
  */
 template <class TInput, class TOutput>
 class ReciprocalHAlphaFunctor
 {
 public:
-  typedef typename std::complex<double> ComplexType;
-  typedef vnl_matrix<ComplexType>       VNLMatrixType;
-  typedef vnl_vector<ComplexType>       VNLVectorType;
-  typedef vnl_vector<double>            VNLDoubleVectorType;
-  typedef std::vector<double>           VectorType;
-  typedef typename TOutput::ValueType   OutputValueType;
+  typedef typename std::complex<double>   ComplexType;
+  typedef vnl_matrix<ComplexType>         VNLMatrixType;
+  typedef vnl_vector<ComplexType>         VNLVectorType;
+  typedef vnl_vector<double>              VNLDoubleVectorType;
+  typedef std::vector<double>             VectorType;
+  typedef typename TOutput::ValueType     OutputValueType;
+  typedef HermitianEigenSolver3x3<double> EigenSolverType;
 
 
   inline void operator()(TOutput& result, const TInput& Coherency) const
   {
-    const double T0 = static_cast<double>(Coherency[0].real());
-    const double T1 = static_cast<double>(Coherency[3].real());
-    const double T2 = static_cast<double>(Coherency[5].real());
-
-    VNLMatrixType vnlMat(3, 3, 0.);
-    vnlMat[0][0] = ComplexType(T0, 0.);
-    vnlMat[0][1] = ComplexType(Coherency[1]);
-    vnlMat[0][2] = ComplexType(Coherency[2]);
-    vnlMat[1][0] = std::conj(ComplexType(Coherency[1]));
-    vnlMat[1][1] = ComplexType(T1, 0.);
-    vnlMat[1][2] = ComplexType(Coherency[4]);
-    vnlMat[2][0] = std::conj(ComplexType(Coherency[2]));
-    vnlMat[2][1] = std::conj(ComplexType(Coherency[4]));
-    vnlMat[2][2] = ComplexType(T2, 0.);
+    ComplexType coherency[6];
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      coherency[i] = ComplexType(Coherency[i]);
+    }
+    Evaluate(result, coherency);
+  }
 
-    // Only compute the left symmetry to respect the previous Hermitian Analisys code
-    vnl_complex_eigensystem syst(vnlMat, false, true);
-    const VNLMatrixType     eigenVectors(syst.L);
-    const VNLVectorType     eigenValues(syst.W);
+  /** Compute the parameters from the upper triangle of a coherency
+   * matrix, in the order of the reciprocal coherency image */
+  inline void Evaluate(TOutput& result, const ComplexType coherency[6]) const
+  {
+    // Eigen values in decreasing order, and modulus of the first
+    // component of the corresponding eigen vectors
+    double sortedRealEigenValues[3];
+    double sortedFirstComponents[3];
+    if (m_UseVnlEigenSystem)
+    {
+      VnlEigenAnalysis(coherency, sortedRealEigenValues, sortedFirstComponents);
+    }
+    else
+    {
+      ComplexType eigenVectors[3][3];
+      EigenSolverType::Compute(coherency, sortedRealEigenValues, eigenVectors);
+      for (unsigned int k = 0; k < 3; ++k)
+      {
+        sortedFirstComponents[k] = std::min(std::abs(eigenVectors[k][0]), 1.);
+      }
+    }
 
     // Entropy estimation
     double totalEigenValues(0.0);
@@ -103,27 +119,6 @@ public:
     double alpha;
     double anisotropy;
 
-    // Sort eigen values in decreasing order
-    VectorType sortedRealEigenValues(3, eigenValues[0].real());
-    sortedRealEigenValues[1] = eigenValues[1].real();
-    sortedRealEigenValues[2] = eigenValues[2].real();
-    std::sort(sortedRealEigenValues.begin(), sortedRealEigenValues.end());
-    std::reverse(sortedRealEigenValues.begin(), sortedRealEigenValues.end());
-
-    // Extract the first component of each the eigen vector sorted by eigen value decrease order
-    VNLVectorType sortedGreaterEigenVector(3, eigenVectors[0][0]);
-    for (unsigned int i = 0; i < 3; ++i)
-    {
-      if (std::abs(eigenValues[1].real() - sortedRealEigenValues[i]) < m_Epsilon)
-      {
-        sortedGreaterEigenVector[i] = eigenVectors[1][0];
-      }
-      else if (std::abs(eigenValues[2].real() - sortedRealEigenValues[i]) < m_Epsilon)
-      {
-        sortedGreaterEigenVector[i] = eigenVectors[2][0];
-      }
-    }
-
     totalEigenValues = 0.0;
     for (unsigned int k = 0; k < 3; ++k)
     {
@@ -147,17 +142,11 @@ public:
       entropy += plog[k];
 
     // alpha estimation
-    double val0, val1, val2;
     double a0, a1, a2;
 
-    val0 = std::abs(sortedGreaterEigenVector[0]);
-    a0   = acos(std::abs(val0)) * CONST_180_PI;
-
-    val1 = std::abs(sortedGreaterEigenVector[1]);
-    a1   = acos(std::abs(val1)) * CONST_180_PI;
-
-    val2 = std::abs(sortedGreaterEigenVector[2]);
-    a2   = acos(std::abs(val2)) * CONST_180_PI;
+    a0 = acos(sortedFirstComponents[0]) * CONST_180_PI;
+    a1 = acos(sortedFirstComponents[1]) * CONST_180_PI;
+    a2 = acos(sortedFirstComponents[2]) * CONST_180_PI;
 
     alpha = p[0] * a0 + p[1] * a1 + p[2] * a2;
 
@@ -169,6 +158,18 @@ public:
     result[2] = static_cast<OutputValueType>(anisotropy);
   }
 
+  /** Diagonalise with the general vnl complex eigen system instead of
+   * HermitianEigenSolver3x3. This is slower and allocates for each
+   * pixel, and is kept as a reference. */
+  void SetUseVnlEigenSystem(bool use)
+  {
+    m_UseVnlEigenSystem = use;
+  }
+  bool GetUseVnlEigenSystem() const
+  {
+    return m_UseVnlEigenSystem;
+  }
+
   constexpr size_t OutputSize(...) const
   {
     // Size of the result (entropy, alpha, anisotropy)
@@ -176,7 +177,59 @@ public:
   }
 
 private:
+  void VnlEigenAnalysis(const ComplexType coherency[6], double sortedEigenValues[3], double sortedFirstComponents[3]) const
+  {
+    const double T0 = coherency[0].real();
+    const double T1 = coherency[3].real();
+    const double T2 = coherency[5].real();
+
+    VNLMatrixType vnlMat(3, 3, 0.);
+    vnlMat[0][0] = ComplexType(T0, 0.);
+    vnlMat[0][1] = coherency[1];
+    vnlMat[0][2] = coherency[2];
+    vnlMat[1][0] = std::conj(coherency[1]);
+    vnlMat[1][1] = ComplexType(T1, 0.);
+    vnlMat[1][2] = coherency[4];
+    vnlMat[2][0] = std::conj(coherency[2]);
+    vnlMat[2][1] = std::conj(coherency[4]);
+    vnlMat[2][2] = ComplexType(T2, 0.);
+
+    // Only compute the left symmetry to respect the previous Hermitian Analisys code
+    vnl_complex_eigensystem syst(vnlMat, false, true);
+    const VNLMatrixType     eigenVectors(syst.L);
+    const VNLVectorType     eigenValues(syst.W);
+
+    // Sort eigen values in decreasing order
+    VectorType sortedRealEigenValues(3, eigenValues[0].real());
+    sortedRealEigenValues[1] = eigenValues[1].real();
+    sortedRealEigenValues[2] = eigenValues[2].real();
+    std::sort(sortedRealEigenValues.begin(), sortedRealEigenValues.end());
+    std::reverse(sortedRealEigenValues.begin(), sortedRealEigenValues.end());
+
+    // Extract the first component of each the eigen vector sorted by eigen value decrease order
+    VNLVectorType sortedGreaterEigenVector(3, eigenVectors[0][0]);
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (std::abs(eigenValues[1].real() - sortedRealEigenValues[i]) < m_Epsilon)
+      {
+        sortedGreaterEigenVector[i] = eigenVectors[1][0];
+      }
+      else if (std::abs(eigenValues[2].real() - sortedRealEigenValues[i]) < m_Epsilon)
+      {
+        sortedGreaterEigenVector[i] = eigenVectors[2][0];
+      }
+    }
+
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      sortedEigenValues[k]     = sortedRealEigenValues[k];
+      sortedFirstComponents[k] = std::abs(sortedGreaterEigenVector[k]);
+    }
+  }
+
   static constexpr double m_Epsilon = 1e-6;
+
+  bool m_UseVnlEigenSystem = false;
 };
 } // namespace Functor
 
@@ -0,0 +1,142 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSinclairToReciprocalBoxcarMatrixImageFilter_h
+#define otbSinclairToReciprocalBoxcarMatrixImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbPolarimetryTags.h"
+#include "otbSinclairToReciprocalCoherencyMatrixImageFilter.h"
+
+namespace otb
+{
+
+/** \class SinclairToReciprocalBoxcarMatrixImageFilter
+ * \brief Compute a reciprocal polarimetric matrix averaged over a boxcar window.
+ *
+ * The matrix given by the functor (coherency, covariance or circular
+ * covariance) is computed from the HH, HV or VH, and VV Sinclair images,
+ * then averaged over a (2*radius+1) window with running sums along the
+ * columns and the rows. This gives the same result as the Sinclair
+ * conversion followed by a mean filter on each band, without writing or
+ * reading the unaveraged matrix image.
+ *
+ * The image borders are handled like itk::MeanImageFilter, by replicating
+ * the edge pixels.
+ *
+ * Set inputs with:
+ * \code
+ * filter->SetInput(polarimetry_tags::hh{}, hhImage);
+ * filter->SetInput(polarimetry_tags::hv_or_vh{}, hvImage);
+ * filter->SetInput(polarimetry_tags::vv{}, vvImage);
+ * \endcode
+ *
+ * \sa SinclairToReciprocalCoherencyMatrixFunctor
+ * \sa SinclairToReciprocalCovarianceMatrixFunctor
+ * \sa SinclairToReciprocalCircularCovarianceMatrixFunctor
+ *
+ * \ingroup OTBPolarimetry
+ */
+template <class TInputImage, class TOutputImage,
+          class TFunction = Functor::SinclairToReciprocalCoherencyMatrixFunctor<typename TInputImage::PixelType, typename TInputImage::PixelType,
+                                                                                typename TInputImage::PixelType, typename TOutputImage::PixelType>>
+class ITK_EXPORT SinclairToReciprocalBoxcarMatrixImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef SinclairToReciprocalBoxcarMatrixImageFilter        Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>                            Pointer;
+  typedef itk::SmartPointer<const Self>                      ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(SinclairToReciprocalBoxcarMatrixImageFilter, ImageToImageFilter);
+
+  /** Some typedefs. */
+  typedef TFunction                                   FunctorType;
+  typedef TInputImage                                 InputImageType;
+  typedef typename InputImageType::RegionType         InputImageRegionType;
+  typedef typename InputImageType::SizeType           SizeType;
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::PixelType         OutputPixelType;
+  typedef typename OutputImageType::InternalPixelType OutputValueType;
+
+  /** Set the Sinclair images */
+  void SetInput(polarimetry_tags::hh, const InputImageType* image)
+  {
+    this->SetNthInput(0, const_cast<InputImageType*>(image));
+  }
+  void SetInput(polarimetry_tags::hv_or_vh, const InputImageType* image)
+  {
+    this->SetNthInput(1, const_cast<InputImageType*>(image));
+  }
+  void SetInput(polarimetry_tags::vv, const InputImageType* image)
+  {
+    this->SetNthInput(2, const_cast<InputImageType*>(image));
+  }
+
+  /** Set/Get the radius of the averaging window */
+  itkSetMacro(Radius, SizeType);
+  itkGetConstReferenceMacro(Radius, SizeType);
+
+  /** Get the functor object */
+  FunctorType& GetFunctor()
+  {
+    return m_Functor;
+  }
+  const FunctorType& GetFunctor() const
+  {
+    return m_Functor;
+  }
+
+protected:
+  SinclairToReciprocalBoxcarMatrixImageFilter();
+  ~SinclairToReciprocalBoxcarMatrixImageFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  /** Pad the requested regions of the inputs by the radius */
+  void GenerateInputRequestedRegion() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  SinclairToReciprocalBoxcarMatrixImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  SizeType    m_Radius;
+  FunctorType m_Functor;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSinclairToReciprocalBoxcarMatrixImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSinclairToReciprocalBoxcarMatrixImageFilter_hxx
+#define otbSinclairToReciprocalBoxcarMatrixImageFilter_hxx
+
+#include "otbSinclairToReciprocalBoxcarMatrixImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage, class TFunction>
+SinclairToReciprocalBoxcarMatrixImageFilter<TInputImage, TOutputImage, TFunction>::SinclairToReciprocalBoxcarMatrixImageFilter()
+{
+  this->SetNumberOfRequiredInputs(3);
+  m_Radius.Fill(1);
+}
+
+template <class TInputImage, class TOutputImage, class TFunction>
+void SinclairToReciprocalBoxcarMatrixImageFilter<TInputImage, TOutputImage, TFunction>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  this->GetOutput()->SetNumberOfComponentsPerPixel(m_Functor.OutputSize());
+}
+
+template <class TInputImage, class TOutputImage, class TFunction>
+void SinclairToReciprocalBoxcarMatrixImageFilter<TInputImage, TOutputImage, TFunction>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  for (unsigned int i = 0; i < 3; ++i)
+  {
+    InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput(i));
+    if (!inputPtr)
+    {
+      continue;
+    }
+
+    InputImageRegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+    inputRequestedRegion.PadByRadius(m_Radius);
+    inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion());
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TFunction>
+void SinclairToReciprocalBoxcarMatrixImageFilter<TInputImage, TOutputImage, TFunction>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                             itk::ThreadIdType            threadId)
+{
+  const InputImageType* hhPtr     = this->GetInput(0);
+  const InputImageType* hvPtr     = this->GetInput(1);
+  const InputImageType* vvPtr     = this->GetInput(2);
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  const InputImageRegionType& largestRegion = hhPtr->GetLargestPossibleRegion();
+  const long                  firstX        = largestRegion.GetIndex(0);
+  const long                  lastX         = firstX + static_cast<long>(largestRegion.GetSize(0)) - 1;
+  const long                  firstY        = largestRegion.GetIndex(1);
+  const long                  lastY         = firstY + static_cast<long>(largestRegion.GetSize(1)) - 1;
+
+  const unsigned int nbElements  = outputPtr->GetNumberOfComponentsPerPixel();
+  const long         radiusX     = m_Radius[0];
+  const long         radiusY     = m_Radius[1];
+  const long         startX      = outputRegionForThread.GetIndex(0);
+  const long         startY      = outputRegionForThread.GetIndex(1);
+  const long         width       = outputRegionForThread.GetSize(0);
+  const long         height      = outputRegionForThread.GetSize(1);
+  const long         paddedWidth = width + 2 * radiusX;
+  const long         windowRows  = 2 * radiusY + 1;
+  const double       windowSize  = static_cast<double>(windowRows * (2 * radiusX + 1));
+
+  // Matrices of the rows inside the window, in a ring buffer, and their sums along the columns
+  std::vector<OutputValueType> rows(windowRows * paddedWidth * nbElements);
+  std::vector<OutputValueType> columnSums(paddedWidth * nbElements, OutputValueType());
+
+  OutputPixelType matrix(nbElements);
+
+  // Compute the matrices of an image row over the padded width, replicating the edge pixels
+  auto computeRow = [&](long y, OutputValueType* row) {
+    const long firstInside = std::max(startX - radiusX, firstX);
+    const long lastInside  = std::min(startX + width - 1 + radiusX, lastX);
+
+    InputImageRegionType rowRegion;
+    rowRegion.SetIndex(0, firstInside);
+    rowRegion.SetIndex(1, std::min(std::max(y, firstY), lastY));
+    rowRegion.SetSize(0, lastInside - firstInside + 1);
+    rowRegion.SetSize(1, 1);
+
+    itk::ImageRegionConstIterator<InputImageType> hhIt(hhPtr, rowRegion);
+    itk::ImageRegionConstIterator<InputImageType> hvIt(hvPtr, rowRegion);
+    itk::ImageRegionConstIterator<InputImageType> vvIt(vvPtr, rowRegion);
+
+    OutputValueType* current = row + (firstInside - startX + radiusX) * nbElements;
+    for (; !hhIt.IsAtEnd(); ++hhIt, ++hvIt, ++vvIt, current += nbElements)
+    {
+      m_Functor(matrix, hhIt.Get(), hvIt.Get(), vvIt.Get());
+      for (unsigned int k = 0; k < nbElements; ++k)
+      {
+        current[k] = matrix[k];
+      }
+    }
+
+    const OutputValueType* first = row + (firstInside - startX + radiusX) * nbElements;
+    for (OutputValueType* it = row; it != first; it += nbElements)
+    {
+      std::copy(first, first + nbElements, it);
+    }
+    const OutputValueType* last = row + (lastInside - startX + radiusX) * nbElements;
+    for (OutputValueType* it = row + (lastInside - startX + radiusX + 1) * nbElements; it != row + paddedWidth * nbElements; it += nbElements)
+    {
+      std::copy(last, last + nbElements, it);
+    }
+  };
+
+  // Row startY - radiusY + t is stored in slot t % windowRows
+  for (long t = 0; t < windowRows; ++t)
+  {
+    OutputValueType* row = &rows[t * paddedWidth * nbElements];
+    computeRow(startY - radiusY + t, row);
+    for (long i = 0; i < paddedWidth * nbElements; ++i)
+    {
+      columnSums[i] += row[i];
+    }
+  }
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  itk::ImageScanlineIterator<OutputImageType> outIt(outputPtr, outputRegionForThread);
+  OutputPixelType                             outputPixel(nbElements);
+  std::vector<OutputValueType>                sums(nbElements);
+
+  for (long j = 0; j < height; ++j, outIt.NextLine())
+  {
+    if (j > 0)
+    {
+      // Slide the window down by one row
+      OutputValueType* row = &rows[((j - 1) % windowRows) * paddedWidth * nbElements];
+      for (long i = 0; i < paddedWidth * nbElements; ++i)
+      {
+        columnSums[i] -= row[i];
+      }
+      computeRow(startY + j + radiusY, row);
+      for (long i = 0; i < paddedWidth * nbElements; ++i)
+      {
+        columnSums[i] += row[i];
+      }
+    }
+
+    std::fill(sums.begin(), sums.end(), OutputValueType());
+    for (long i = 0; i < 2 * radiusX + 1; ++i)
+    {
+      for (unsigned int k = 0; k < nbElements; ++k)
+      {
+        sums[k] += columnSums[i * nbElements + k];
+      }
+    }
+
+    for (long i = 0; i < width; ++i, ++outIt)
+    {
+      if (i > 0)
+      {
+        for (unsigned int k = 0; k < nbElements; ++k)
+        {
+          sums[k] += columnSums[(i + 2 * radiusX) * nbElements + k] - columnSums[(i - 1) * nbElements + k];
+        }
+      }
+      for (unsigned int k = 0; k < nbElements; ++k)
+      {
+        outputPixel[k] = sums[k] / windowSize;
+      }
+      outIt.Set(outputPixel);
+      progress.CompletedPixel();
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TFunction>
+void SinclairToReciprocalBoxcarMatrixImageFilter<TInputImage, TOutputImage, TFunction>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Radius: " << m_Radius << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -24,7 +24,6 @@
 #include "itkMacro.h"
 #include <complex>
 #include "otbMath.h"
-#include "vnl/vnl_matrix.h"
 
 #include "otbFunctorImageFilter.h"
 #include "otbPolarimetryTags.h"
@@ -72,28 +71,33 @@ class SinclairToReciprocalCoherencyMatrixFunctor
 public:
   /** Some typedefs. */
   typedef typename std::complex<double> ComplexType;
-  typedef vnl_matrix<ComplexType>       VNLMatrixType;
   typedef typename TOutput::ValueType   OutputValueType;
 
   inline void operator()(TOutput& result, const TInput1& Shh, const TInput2& Shv, const TInput3& Svv) const
   {
-    const ComplexType S_hh = static_cast<ComplexType>(Shh);
-    const ComplexType S_hv = static_cast<ComplexType>(Shv);
-    const ComplexType S_vv = static_cast<ComplexType>(Svv);
+    ComplexType coherency[6];
+    Evaluate(coherency, static_cast<ComplexType>(Shh), static_cast<ComplexType>(Shv), static_cast<ComplexType>(Svv));
 
-    VNLMatrixType f3p(3, 1, 0.);
-    f3p[0][0] = (S_hh + S_vv) / ComplexType(std::sqrt(2.0), 0.0);
-    f3p[1][0] = (S_hh - S_vv) / ComplexType(std::sqrt(2.0), 0.0);
-    f3p[2][0] = ComplexType(std::sqrt(2.0), 0.0) * S_hv;
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      result[i] = static_cast<OutputValueType>(coherency[i]);
+    }
+  }
 
-    VNLMatrixType res = f3p * f3p.conjugate_transpose();
+  /** Upper triangle of the reciprocal coherency matrix, in the order of
+   * the output image */
+  static inline void Evaluate(ComplexType coherency[6], const ComplexType& S_hh, const ComplexType& S_hv, const ComplexType& S_vv)
+  {
+    const ComplexType f0 = (S_hh + S_vv) / ComplexType(std::sqrt(2.0), 0.0);
+    const ComplexType f1 = (S_hh - S_vv) / ComplexType(std::sqrt(2.0), 0.0);
+    const ComplexType f2 = ComplexType(std::sqrt(2.0), 0.0) * S_hv;
 
-    result[0] = static_cast<OutputValueType>(res[0][0]);
-    result[1] = static_cast<OutputValueType>(res[0][1]);
-    result[2] = static_cast<OutputValueType>(res[0][2]);
-    result[3] = static_cast<OutputValueType>(res[1][1]);
-    result[4] = static_cast<OutputValueType>(res[1][2]);
-    result[5] = static_cast<OutputValueType>(res[2][2]);
+    coherency[0] = f0 * std::conj(f0);
+    coherency[1] = f0 * std::conj(f1);
+    coherency[2] = f0 * std::conj(f2);
+    coherency[3] = f1 * std::conj(f1);
+    coherency[4] = f1 * std::conj(f2);
+    coherency[5] = f2 * std::conj(f2);
   }
 
   constexpr size_t OutputSize(...) const
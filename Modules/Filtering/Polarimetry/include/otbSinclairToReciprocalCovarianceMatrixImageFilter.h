@@ -23,7 +23,6 @@
 
 #include <complex>
 #include "otbMath.h"
-#include "vnl/vnl_matrix.h"
 
 #include "otbFunctorImageFilter.h"
 #include "otbPolarimetryTags.h"
@@ -71,7 +70,6 @@ class SinclairToReciprocalCovarianceMatrixFunctor
 public:
   /** Some typedefs. */
   typedef typename std::complex<double> ComplexType;
-  typedef vnl_matrix<ComplexType>       VNLMatrixType;
   typedef typename TOutput::ValueType   OutputValueType;
   inline void operator()(TOutput& result, const TInput1& Shh, const TInput2& Shv, const TInput3& Svv) const
   {
@@ -79,19 +77,16 @@ public:
     const ComplexType S_hv = static_cast<ComplexType>(Shv);
     const ComplexType S_vv = static_cast<ComplexType>(Svv);
 
-    VNLMatrixType f3l(3, 1, 0.);
-    f3l[0][0] = S_hh;
-    f3l[1][0] = ComplexType(std::sqrt(2.0), 0.0) * S_hv;
-    f3l[2][0] = S_vv;
+    const ComplexType f0 = S_hh;
+    const ComplexType f1 = ComplexType(std::sqrt(2.0), 0.0) * S_hv;
+    const ComplexType f2 = S_vv;
 
-    VNLMatrixType res = f3l * f3l.conjugate_transpose();
-
-    result[0] = static_cast<OutputValueType>(res[0][0]);
-    result[1] = static_cast<OutputValueType>(res[0][1]);
-    result[2] = static_cast<OutputValueType>(res[0][2]);
-    result[3] = static_cast<OutputValueType>(res[1][1]);
-    result[4] = static_cast<OutputValueType>(res[1][2]);
-    result[5] = static_cast<OutputValueType>(res[2][2]);
+    result[0] = static_cast<OutputValueType>(f0 * std::conj(f0));
+    result[1] = static_cast<OutputValueType>(f0 * std::conj(f1));
+    result[2] = static_cast<OutputValueType>(f0 * std::conj(f2));
+    result[3] = static_cast<OutputValueType>(f1 * std::conj(f1));
+    result[4] = static_cast<OutputValueType>(f1 * std::conj(f2));
+    result[5] = static_cast<OutputValueType>(f2 * std::conj(f2));
   }
 
   constexpr size_t OutputSize(...) const
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSinclairToReciprocalHAlphaImageFilter_h
+#define otbSinclairToReciprocalHAlphaImageFilter_h
+
+#include "otbSinclairToReciprocalCoherencyMatrixImageFilter.h"
+#include "otbReciprocalHAlphaImageFilter.h"
+#include "itkConstNeighborhoodIterator.h"
+#include "itkVariableLengthVector.h"
+
+namespace otb
+{
+
+namespace Functor
+{
+
+/** \class SinclairToReciprocalHAlphaFunctor
+ * \brief Evaluate the H-Alpha parameters from the Sinclair matrix images.
+ *
+ * The reciprocal coherency matrices of the neighborhood are averaged and
+ * given to ReciprocalHAlphaFunctor. This gives the same result as
+ * SinclairToReciprocalCoherencyMatrixImageFilter followed by a mean filter
+ * and ReciprocalHAlphaImageFilter, without the intermediate 6-band complex
+ * image.
+ *
+ * Output value are those of ReciprocalHAlphaFunctor:
+ * - channel #0 : entropy
+ * - channel #1 : alpha
+ * - channel #2 : anisotropy
+ *
+ * Use otb::SinclairToReciprocalHAlphaImageFilter to apply
+ *
+ * \sa ReciprocalHAlphaFunctor
+ *
+ * \ingroup OTBPolarimetry
+ */
+template <class TInputImage, class TOutput>
+class SinclairToReciprocalHAlphaFunctor
+{
+public:
+  typedef typename std::complex<double>                        ComplexType;
+  typedef itk::ConstNeighborhoodIterator<TInputImage>          NeighborhoodType;
+  typedef typename TInputImage::PixelType                      InputPixelType;
+  typedef itk::VariableLengthVector<ComplexType>               CoherencyPixelType;
+  typedef ReciprocalHAlphaFunctor<CoherencyPixelType, TOutput> HAlphaFunctorType;
+  typedef SinclairToReciprocalCoherencyMatrixFunctor<InputPixelType, InputPixelType, InputPixelType, CoherencyPixelType> CoherencyFunctorType;
+
+  inline void operator()(TOutput& result, const NeighborhoodType& Shh, const NeighborhoodType& Shv, const NeighborhoodType& Svv) const
+  {
+    ComplexType mean[6];
+    ComplexType coherency[6];
+    std::fill(mean, mean + 6, ComplexType(0., 0.));
+
+    const unsigned int neighborhoodSize = Shh.Size();
+    for (unsigned int n = 0; n < neighborhoodSize; ++n)
+    {
+      CoherencyFunctorType::Evaluate(coherency, static_cast<ComplexType>(Shh.GetPixel(n)), static_cast<ComplexType>(Shv.GetPixel(n)),
+                                     static_cast<ComplexType>(Svv.GetPixel(n)));
+      for (unsigned int i = 0; i < 6; ++i)
+      {
+        mean[i] += coherency[i];
+      }
+    }
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      mean[i] /= static_cast<double>(neighborhoodSize);
+    }
+
+    m_HAlphaFunctor.Evaluate(result, mean);
+  }
+
+  constexpr size_t OutputSize(...) const
+  {
+    // Size of the result (entropy, alpha, anisotropy)
+    return 3;
+  }
+
+  /** Access to the H-Alpha functor applied to the averaged matrix */
+  HAlphaFunctorType& GetHAlphaFunctor()
+  {
+    return m_HAlphaFunctor;
+  }
+
+private:
+  HAlphaFunctorType m_HAlphaFunctor;
+};
+} // namespace Functor
+
+/**
+ * \typedef SinclairToReciprocalHAlphaImageFilter
+ * \brief Applies otb::Functor::SinclairToReciprocalHAlphaFunctor
+ * \sa otb::Functor::SinclairToReciprocalHAlphaFunctor
+ *
+ * The filter must be built with the averaging radius:
+ * \code
+ * auto filter = NewFunctorFilter<FunctorType, std::tuple<polarimetry_tags::hh, polarimetry_tags::hv_or_vh, polarimetry_tags::vv>>(FunctorType{}, radius);
+ *
+ * filter->SetInput<polarimetry_tags::hh>(inputPtr);
+ * filter->SetInput<polarimetry_tags::hv_or_vh>(inputPtr);
+ * filter->SetInput<polarimetry_tags::vv>(inputPtr);
+ * \endcode
+ *
+ * \ingroup OTBPolarimetry
+ */
+template <typename TInputImage, typename TOutputImage>
+using SinclairToReciprocalHAlphaImageFilter =
+    FunctorImageFilter<Functor::SinclairToReciprocalHAlphaFunctor<TInputImage, typename TOutputImage::PixelType>,
+                       std::tuple<polarimetry_tags::hh, polarimetry_tags::hv_or_vh, polarimetry_tags::vv>>;
+
+} // namespace otb
+
+#endif
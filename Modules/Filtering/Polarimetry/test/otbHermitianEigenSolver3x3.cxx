@@ -0,0 +1,129 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+
+#include "otbHermitianEigenSolver3x3.h"
+#include <random>
+#include <iostream>
+
+int otbHermitianEigenSolver3x3(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::HermitianEigenSolver3x3<double> SolverType;
+  typedef SolverType::ComplexType              ComplexType;
+
+  std::mt19937                           generator(42);
+  std::uniform_real_distribution<double> distribution(-10., 10.);
+
+  const unsigned int nbMatrices = 1000;
+  for (unsigned int n = 0; n < nbMatrices; ++n)
+  {
+    // Random Hermitian matrices, the last ones being degenerate (diagonal then rank one)
+    ComplexType upper[6];
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      upper[i] = ComplexType(distribution(generator), distribution(generator));
+    }
+    if (n == nbMatrices - 2)
+    {
+      upper[1] = upper[2] = upper[4] = ComplexType(0., 0.);
+      upper[3]                       = upper[0];
+    }
+    if (n == nbMatrices - 1)
+    {
+      const ComplexType k[3] = {upper[0], upper[1], upper[2]};
+      upper[0]               = k[0] * std::conj(k[0]);
+      upper[1]               = k[0] * std::conj(k[1]);
+      upper[2]               = k[0] * std::conj(k[2]);
+      upper[3]               = k[1] * std::conj(k[1]);
+      upper[4]               = k[1] * std::conj(k[2]);
+      upper[5]               = k[2] * std::conj(k[2]);
+    }
+
+    ComplexType a[3][3];
+    a[0][0] = ComplexType(upper[0].real(), 0.);
+    a[0][1] = upper[1];
+    a[0][2] = upper[2];
+    a[1][0] = std::conj(upper[1]);
+    a[1][1] = ComplexType(upper[3].real(), 0.);
+    a[1][2] = upper[4];
+    a[2][0] = std::conj(upper[2]);
+    a[2][1] = std::conj(upper[4]);
+    a[2][2] = ComplexType(upper[5].real(), 0.);
+
+    double norm = 0.;
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      for (unsigned int j = 0; j < 3; ++j)
+      {
+        norm += std::norm(a[i][j]);
+      }
+    }
+    const double tolerance = 1e-10 * std::sqrt(norm);
+
+    double      eigenValues[3];
+    ComplexType eigenVectors[3][3];
+    SolverType::Compute(upper, eigenValues, eigenVectors);
+
+    if (eigenValues[0] < eigenValues[1] || eigenValues[1] < eigenValues[2])
+    {
+      std::cout << "Matrix " << n << ": eigen values are not sorted: " << eigenValues[0] << " " << eigenValues[1] << " " << eigenValues[2] << std::endl;
+      return EXIT_FAILURE;
+    }
+
+    for (unsigned int k = 0; k < 3; ++k)
+    {
+      // Residual of A v = lambda v
+      double residual = 0.;
+      for (unsigned int i = 0; i < 3; ++i)
+      {
+        ComplexType av(0., 0.);
+        for (unsigned int j = 0; j < 3; ++j)
+        {
+          av += a[i][j] * eigenVectors[k][j];
+        }
+        residual += std::norm(av - eigenValues[k] * eigenVectors[k][i]);
+      }
+
+      // Orthonormality of the eigen vectors
+      for (unsigned int l = 0; l < 3; ++l)
+      {
+        ComplexType dot(0., 0.);
+        for (unsigned int i = 0; i < 3; ++i)
+        {
+          dot += std::conj(eigenVectors[k][i]) * eigenVectors[l][i];
+        }
+        if (std::abs(dot - ComplexType(k == l ? 1. : 0., 0.)) > 1e-10)
+        {
+          std::cout << "Matrix " << n << ": eigen vectors " << k << " and " << l << " are not orthonormal (dot product " << dot << ")" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+
+      if (std::sqrt(residual) > tolerance)
+      {
+        std::cout << "Matrix " << n << ": residual " << std::sqrt(residual) << " for eigen value " << eigenValues[k] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
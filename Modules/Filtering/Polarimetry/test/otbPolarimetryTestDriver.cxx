@@ -46,4 +46,7 @@ void RegisterTests()
   REGISTER_TEST(otbReciprocalBarnesDecompImageFilter);
   REGISTER_TEST(otbReciprocalHuynenDecompImageFilter);
   REGISTER_TEST(otbReciprocalPauliDecompImageFilter);
+  REGISTER_TEST(otbHermitianEigenSolver3x3);
+  REGISTER_TEST(otbSinclairToReciprocalHAlphaImageFilter);
+  REGISTER_TEST(otbSinclairToReciprocalBoxcarMatrixImageFilter);
 }
@@ -70,6 +70,8 @@ int otbReciprocalHAlphaImageFilter(int itkNotUsed(argc), char* argv[])
   PerBandMeanFilterType::Pointer   perBand       = PerBandMeanFilterType::New();
   HAlphaFilterType::Pointer        haafilter     = HAlphaFilterType::New();
 
+  // The baseline was produced with the vnl eigen solver
+  haafilter->GetModifiableFunctor().SetUseVnlEigenSystem(true);
 
   MeanFilterType::InputSizeType radius;
   radius.Fill(size);
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkMeanImageFilter.h"
+#include "otbPerBandVectorImageFilter.h"
+
+#include "otbSinclairToReciprocalCovarianceMatrixImageFilter.h"
+#include "otbSinclairToReciprocalBoxcarMatrixImageFilter.h"
+#include <random>
+
+int otbSinclairToReciprocalBoxcarMatrixImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef std::complex<double> ComplexPixelType;
+  const unsigned int           Dimension = 2;
+
+  typedef otb::Image<ComplexPixelType, Dimension>       ComplexImageType;
+  typedef otb::VectorImage<ComplexPixelType, Dimension> ComplexVectorImageType;
+
+  using SinclairToCovFilterType = otb::SinclairToReciprocalCovarianceMatrixImageFilter<ComplexImageType, ComplexVectorImageType>;
+  typedef itk::MeanImageFilter<ComplexImageType, ComplexImageType> MeanFilterType;
+  typedef otb::PerBandVectorImageFilter<ComplexVectorImageType, ComplexVectorImageType, MeanFilterType> PerBandMeanFilterType;
+  typedef otb::SinclairToReciprocalBoxcarMatrixImageFilter<ComplexImageType, ComplexVectorImageType, SinclairToCovFilterType::FunctorType> BoxcarFilterType;
+
+  ComplexImageType::RegionType region;
+  region.SetSize(0, 31);
+  region.SetSize(1, 19);
+
+  std::mt19937                           generator(3);
+  std::uniform_real_distribution<double> distribution(-100., 100.);
+
+  ComplexImageType::Pointer images[3];
+  for (unsigned int k = 0; k < 3; ++k)
+  {
+    images[k] = ComplexImageType::New();
+    images[k]->SetRegions(region);
+    images[k]->Allocate();
+    for (itk::ImageRegionIterator<ComplexImageType> it(images[k], region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(ComplexPixelType(distribution(generator), distribution(generator)));
+    }
+  }
+
+  // The window is larger than the image along y to exercise the border replication
+  MeanFilterType::InputSizeType radius;
+  radius[0] = 3;
+  radius[1] = 10;
+
+  // Reference chain: covariance image then mean filter
+  SinclairToCovFilterType::Pointer sinclairToCov = SinclairToCovFilterType::New();
+  PerBandMeanFilterType::Pointer   perBand       = PerBandMeanFilterType::New();
+  sinclairToCov->SetInput<otb::polarimetry_tags::hh>(images[0]);
+  sinclairToCov->SetInput<otb::polarimetry_tags::hv_or_vh>(images[1]);
+  sinclairToCov->SetInput<otb::polarimetry_tags::vv>(images[2]);
+  perBand->GetFilter()->SetRadius(radius);
+  perBand->SetInput(sinclairToCov->GetOutput());
+  perBand->Update();
+
+  BoxcarFilterType::Pointer boxcar = BoxcarFilterType::New();
+  boxcar->SetInput(otb::polarimetry_tags::hh{}, images[0]);
+  boxcar->SetInput(otb::polarimetry_tags::hv_or_vh{}, images[1]);
+  boxcar->SetInput(otb::polarimetry_tags::vv{}, images[2]);
+  boxcar->SetRadius(radius);
+  boxcar->Update();
+
+  if (boxcar->GetOutput()->GetNumberOfComponentsPerPixel() != 6)
+  {
+    std::cout << "Wrong number of components: " << boxcar->GetOutput()->GetNumberOfComponentsPerPixel() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  itk::ImageRegionConstIterator<ComplexVectorImageType> refIt(perBand->GetOutput(), region);
+  itk::ImageRegionConstIterator<ComplexVectorImageType> boxcarIt(boxcar->GetOutput(), region);
+  for (; !refIt.IsAtEnd(); ++refIt, ++boxcarIt)
+  {
+    for (unsigned int i = 0; i < 6; ++i)
+    {
+      if (std::abs(refIt.Get()[i] - boxcarIt.Get()[i]) > 1e-6)
+      {
+        std::cout << "At " << refIt.GetIndex() << ", the boxcar filter gives " << boxcarIt.Get() << " instead of " << refIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
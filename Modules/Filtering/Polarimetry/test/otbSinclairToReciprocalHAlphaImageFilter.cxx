@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkMeanImageFilter.h"
+#include "otbPerBandVectorImageFilter.h"
+
+#include "otbSinclairToReciprocalCoherencyMatrixImageFilter.h"
+#include "otbReciprocalHAlphaImageFilter.h"
+#include "otbSinclairToReciprocalHAlphaImageFilter.h"
+#include <random>
+
+int otbSinclairToReciprocalHAlphaImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef std::complex<double> ComplexPixelType;
+  const unsigned int           Dimension = 2;
+
+  typedef otb::Image<ComplexPixelType, Dimension>       ComplexImageType;
+  typedef otb::VectorImage<ComplexPixelType, Dimension> ComplexVectorImageType;
+  typedef otb::VectorImage<double, Dimension>           RealVectorImageType;
+
+  using SinclairToCohFilterType = otb::SinclairToReciprocalCoherencyMatrixImageFilter<ComplexImageType, ComplexVectorImageType>;
+  typedef itk::MeanImageFilter<ComplexImageType, ComplexImageType> MeanFilterType;
+  typedef otb::PerBandVectorImageFilter<ComplexVectorImageType, ComplexVectorImageType, MeanFilterType> PerBandMeanFilterType;
+  typedef otb::ReciprocalHAlphaImageFilter<ComplexVectorImageType, RealVectorImageType>                 HAlphaFilterType;
+
+  typedef otb::Functor::SinclairToReciprocalHAlphaFunctor<ComplexImageType, RealVectorImageType::PixelType> FusedFunctorType;
+
+  ComplexImageType::RegionType region;
+  region.SetSize(0, 23);
+  region.SetSize(1, 17);
+
+  std::mt19937                           generator(7);
+  std::uniform_real_distribution<double> distribution(-100., 100.);
+
+  ComplexImageType::Pointer images[3];
+  for (unsigned int k = 0; k < 3; ++k)
+  {
+    images[k] = ComplexImageType::New();
+    images[k]->SetRegions(region);
+    images[k]->Allocate();
+    for (itk::ImageRegionIterator<ComplexImageType> it(images[k], region); !it.IsAtEnd(); ++it)
+    {
+      it.Set(ComplexPixelType(distribution(generator), distribution(generator)));
+    }
+  }
+
+  MeanFilterType::InputSizeType radius;
+  radius.Fill(2);
+
+  // Reference chain: coherency image, mean filter, H-Alpha
+  SinclairToCohFilterType::Pointer sinclairToCoh = SinclairToCohFilterType::New();
+  PerBandMeanFilterType::Pointer   perBand       = PerBandMeanFilterType::New();
+  HAlphaFilterType::Pointer        haafilter     = HAlphaFilterType::New();
+
+  sinclairToCoh->SetInput<otb::polarimetry_tags::hh>(images[0]);
+  sinclairToCoh->SetInput<otb::polarimetry_tags::hv_or_vh>(images[1]);
+  sinclairToCoh->SetInput<otb::polarimetry_tags::vv>(images[2]);
+  perBand->GetFilter()->SetRadius(radius);
+  perBand->SetInput(sinclairToCoh->GetOutput());
+  haafilter->SetInput<0>(perBand->GetOutput());
+  haafilter->Update();
+
+  auto fused = otb::NewFunctorFilter<FusedFunctorType, std::tuple<otb::polarimetry_tags::hh, otb::polarimetry_tags::hv_or_vh, otb::polarimetry_tags::vv>>(
+      FusedFunctorType{}, radius);
+  fused->SetInput<otb::polarimetry_tags::hh>(images[0]);
+  fused->SetInput<otb::polarimetry_tags::hv_or_vh>(images[1]);
+  fused->SetInput<otb::polarimetry_tags::vv>(images[2]);
+  fused->Update();
+
+  itk::ImageRegionConstIterator<RealVectorImageType> refIt(haafilter->GetOutput(), region);
+  itk::ImageRegionConstIterator<RealVectorImageType> fusedIt(fused->GetOutput(), region);
+  for (; !refIt.IsAtEnd(); ++refIt, ++fusedIt)
+  {
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      if (std::abs(refIt.Get()[i] - fusedIt.Get()[i]) > 1e-9)
+      {
+        std::cout << "At " << refIt.GetIndex() << ", the fused filter gives " << fusedIt.Get() << " instead of " << refIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -76,14 +76,15 @@ public:
 
   /** Internal filters typedefs*/
   typedef StreamingResampleImageFilter<InputImageType, OutputImageType> ResamplerType;
-  typedef typename ResamplerType::Pointer          ResamplerPointerType;
-  typedef typename ResamplerType::TransformType    TransformType;
-  typedef typename ResamplerType::SizeType         SizeType;
-  typedef typename ResamplerType::SpacingType      SpacingType;
-  typedef typename ResamplerType::OriginType       OriginType;
-  typedef typename ResamplerType::IndexType        IndexType;
-  typedef typename ResamplerType::RegionType       RegionType;
-  typedef typename ResamplerType::InterpolatorType InterpolatorType;
+  typedef typename ResamplerType::Pointer               ResamplerPointerType;
+  typedef typename ResamplerType::TransformType         TransformType;
+  typedef typename ResamplerType::SizeType              SizeType;
+  typedef typename ResamplerType::SpacingType           SpacingType;
+  typedef typename ResamplerType::OriginType            OriginType;
+  typedef typename ResamplerType::IndexType             IndexType;
+  typedef typename ResamplerType::RegionType            RegionType;
+  typedef typename ResamplerType::InterpolatorType      InterpolatorType;
+  typedef typename ResamplerType::DisplacementFieldType DisplacementFieldType;
 
   /** Estimate the rpc model */
   typedef PhysicalToRPCSensorModelImageFilter<InputImageType> InputRpcModelEstimatorType;
@@ -106,6 +107,31 @@ public:
 
   otbGetObjectMemberConstReferenceMacro(Resampler, DisplacementFieldSpacing, SpacingType);
 
+  /** Adaptive refinement of the displacement field: the sensor model is
+   *  only evaluated where the grid is not locally bilinear within
+   *  DisplacementFieldTolerance input pixels */
+  otbSetObjectMemberMacro(Resampler, AdaptiveDisplacementField, bool);
+  otbGetObjectMemberConstMacro(Resampler, AdaptiveDisplacementField, bool);
+  otbSetObjectMemberMacro(Resampler, DisplacementFieldCoarseCellSize, unsigned int);
+  otbGetObjectMemberConstMacro(Resampler, DisplacementFieldCoarseCellSize, unsigned int);
+  otbSetObjectMemberMacro(Resampler, DisplacementFieldTolerance, double);
+  otbGetObjectMemberConstMacro(Resampler, DisplacementFieldTolerance, double);
+
+  /** Use a precomputed displacement field (e.g. read back from a
+   *  previous run) instead of evaluating the sensor model */
+  void SetDisplacementField(const DisplacementFieldType* field)
+  {
+    m_Resampler->SetDisplacementField(field);
+    this->Modified();
+  }
+
+  /** Displacement field used to warp the input. Valid once the output
+   *  information has been generated. */
+  const DisplacementFieldType* GetDisplacementField() const
+  {
+    return m_Resampler->GetDisplacementField();
+  }
+
   /** The resampled image parameters */
   /** Output Origin */
   void SetOutputOrigin(const OriginType& origin)
@@ -162,6 +162,10 @@ private:
  * \note This filter does not support \em in-place transformation as the spatial
  * references of the new layer are expected to change.
  *
+ * \note The geometries of each layer are reprojected by chunks of features,
+ * on \c GetNumberOfThreads() threads, each using its own transform. Features
+ * are written in the order of the input layer.
+ *
  * \ingroup OTBProjection
  */
 class OTBProjection_EXPORT GeometriesProjectionFilter : public GeometriesToGeometriesFilter
@@ -303,6 +307,12 @@ private:
   typedef TransformationFunctorType::InternalTransformPointerType InternalTransformPointerType;
 
   InternalTransformPointerType m_Transform;
+
+  /** Builds a new transform configured as \c m_Transform, for the layer
+   * described by \c inputProjectionRef.
+   * Used to give each reprojection thread its own transform.
+   */
+  InternalTransformPointerType NewLayerTransform(std::string const& inputProjectionRef) const;
   //@}
 
   /**\name Image Reference (origin, spacing) */
@@ -26,6 +26,7 @@
 #include "itkMetaDataObject.h"
 #include "otbMetaDataKey.h"
 #include "otbStopwatch.h"
+#include <vector>
 
 namespace otb
 {
@@ -173,19 +174,24 @@ VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::ProcessLine(Inp
   typedef typename InputLineType::VertexListType::ConstPointer VertexListConstPointerType;
   typedef typename InputLineType::VertexListConstIteratorType  VertexListConstIteratorType;
   VertexListConstPointerType                                   vertexList = line->GetVertexList();
-  VertexListConstIteratorType                                  it         = vertexList->Begin();
   typename OutputLineType::Pointer                             newLine    = OutputLineType::New();
-  while (it != vertexList->End())
+
+  // Transform all the vertices at once
+  std::vector<typename InternalTransformType::InputPointType> inPoints;
+  inPoints.reserve(vertexList->Size());
+  for (VertexListConstIteratorType it = vertexList->Begin(); it != vertexList->End(); ++it)
+  {
+    inPoints.push_back(it.Value());
+  }
+  std::vector<typename InternalTransformType::OutputPointType> outPoints(inPoints.size());
+  m_Transform->TransformPoints(inPoints.data(), outPoints.data(), inPoints.size());
+
+  for (const auto& point : outPoints)
   {
-    itk::Point<double, 2>           point;
     itk::ContinuousIndex<double, 2> index;
-    typename InputLineType::VertexType pointCoord = it.Value();
-    point                                         = m_Transform->TransformPoint(pointCoord);
-    index[0]                                      = point[0];
-    index[1]                                      = point[1];
-    //       otbMsgDevMacro(<< "Converting: " << it.Value() << " -> " << pointCoord << " -> " << point << " -> " << index);
+    index[0] = point[0];
+    index[1] = point[1];
     newLine->AddVertex(index);
-    ++it;
   }
 
   return newLine;
@@ -201,18 +207,24 @@ VectorDataProjectionFilter<TInputVectorData, TOutputVectorData>::ProcessPolygon(
   typedef typename InputPolygonType::VertexListType::ConstPointer VertexListConstPointerType;
   typedef typename InputPolygonType::VertexListConstIteratorType  VertexListConstIteratorType;
   VertexListConstPointerType                                      vertexList = polygon->GetVertexList();
-  VertexListConstIteratorType                                     it         = vertexList->Begin();
   typename OutputPolygonType::Pointer                             newPolygon = OutputPolygonType::New();
-  while (it != vertexList->End())
+
+  // Transform all the vertices at once
+  std::vector<typename InternalTransformType::InputPointType> inPoints;
+  inPoints.reserve(vertexList->Size());
+  for (VertexListConstIteratorType it = vertexList->Begin(); it != vertexList->End(); ++it)
+  {
+    inPoints.push_back(it.Value());
+  }
+  std::vector<typename InternalTransformType::OutputPointType> outPoints(inPoints.size());
+  m_Transform->TransformPoints(inPoints.data(), outPoints.data(), inPoints.size());
+
+  for (const auto& point : outPoints)
   {
-    itk::Point<double, 2>           point;
     itk::ContinuousIndex<double, 2> index;
-    typename InputPolygonType::VertexType pointCoord = it.Value();
-    point                                            = m_Transform->TransformPoint(pointCoord);
-    index[0]                                         = point[0];
-    index[1]                                         = point[1];
+    index[0] = point[0];
+    index[1] = point[1];
     newPolygon->AddVertex(index);
-    ++it;
   }
   return newPolygon;
 }
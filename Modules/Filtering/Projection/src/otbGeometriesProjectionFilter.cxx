@@ -32,6 +32,9 @@
 #include "itkMetaDataObject.h"
 #include "otbOGRGeometryWrapper.h"
 #include "otbOGRGeometriesVisitor.h"
+#include "itkMultiThreader.h"
+#include <algorithm>
+#include <vector>
 
 
 /*===========================================================================*/
@@ -60,12 +63,28 @@ void otb::internal::ReprojectTransformationFunctor::do_transform(OGRPoint& g) co
 
 void otb::internal::ReprojectTransformationFunctor::do_transform(OGRLineString& g) const
 {
-  OGRPoint point;
-  for (int i = 0, N = g.getNumPoints(); i != N; ++i)
+  typedef InternalTransformType::InputPointType  InputPointType;
+  typedef InternalTransformType::OutputPointType OutputPointType;
+  const int N = g.getNumPoints();
+  if (N <= 0)
+    return;
+
+  // All the vertices are sent at once to the transform: this way, the
+  // per-call overhead of the underlying projection (OGR coordinate
+  // transformation, sensor model) is paid once per line-string instead of
+  // once per vertex.
+  std::vector<InputPointType>  inPoints(N);
+  std::vector<OutputPointType> outPoints(N);
+  for (int i = 0; i != N; ++i)
+  {
+    inPoints[i][0] = g.getX(i);
+    inPoints[i][1] = g.getY(i);
+  }
+  m_Transform->TransformPoints(inPoints.data(), outPoints.data(), N);
+  for (int i = 0; i != N; ++i)
   {
-    g.getPoint(i, &point);
-    do_transform(point); // no need to go through the redispatch cycle
-    g.setPoint(i, &point);
+    // Z, if any, is left untouched
+    g.setPoint(i, outPoints[i][0], outPoints[i][1]);
   }
 }
 
@@ -217,21 +236,147 @@ OGRSpatialReference* otb::GeometriesProjectionFilter::DoDefineNewLayerSpatialRef
   }
 }
 
+otb::GeometriesProjectionFilter::InternalTransformPointerType
+otb::GeometriesProjectionFilter::NewLayerTransform(std::string const& inputProjectionRef) const
+{
+  InternalTransformPointerType transform = InternalTransformType::New();
+  transform->SetInputProjectionRef(inputProjectionRef);
+  transform->SetOutputProjectionRef(m_OutputProjectionRef);
+  transform->SetInputImageMetadata(m_InputImageMetadata);
+  transform->SetOutputImageMetadata(m_OutputImageMetadata);
+
+  transform->SetInputSpacing(m_InputImageReference.GetSpacing());
+  transform->SetInputOrigin(m_InputImageReference.GetOrigin());
+  transform->SetOutputSpacing(m_OutputImageReference.GetSpacing());
+  transform->SetOutputOrigin(m_OutputImageReference.GetOrigin());
+
+  transform->InstantiateTransform();
+  return transform;
+}
+
+namespace
+{
+/** Data shared with the reprojection threads.
+ * Each thread reprojects a contiguous part of \c Features into the matching
+ * slots of \c Geometries, with its own functor (and thus its own transform).
+ */
+struct ReprojectionThreadStruct
+{
+  std::vector<otb::ogr::Feature> const*                       Features;
+  std::vector<otb::ogr::UniqueGeometryPtr>*                   Geometries;
+  std::vector<otb::internal::ReprojectTransformationFunctor>* Functors;
+  std::vector<std::string>*                                   Errors;
+};
+
+ITK_THREAD_RETURN_TYPE ReprojectionThreaderCallback(void* arg)
+{
+  itk::MultiThreader::ThreadInfoStruct* info = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+  ReprojectionThreadStruct*             str  = static_cast<ReprojectionThreadStruct*>(info->UserData);
+
+  const std::size_t threadId    = info->ThreadID;
+  const std::size_t threadCount = info->NumberOfThreads;
+  const std::size_t total       = str->Features->size();
+  const std::size_t start       = (total * threadId) / threadCount;
+  const std::size_t stop        = (total * (threadId + 1)) / threadCount;
+
+  otb::internal::ReprojectTransformationFunctor const& functor = (*str->Functors)[threadId];
+  try
+  {
+    for (std::size_t i = start; i != stop; ++i)
+    {
+      (*str->Geometries)[i] = functor((*str->Features)[i].GetGeometry());
+    }
+  }
+  catch (std::exception const& e)
+  {
+    (*str->Errors)[threadId] = e.what();
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+} // anonymous namespace
+
 /*virtual*/
 void otb::GeometriesProjectionFilter::DoProcessLayer(ogr::Layer const& source, ogr::Layer& destination) const
 {
+  if (source == destination)
+  {
+    itkExceptionMacro(<< "Geometries projection filter cannot work in-place as the resulting layers will have a new spatial reference."
+                         " Please supply too different geometries sets to work on.");
+  }
+
   // Finish the initialization phase as somethings depends on the current layer
   // to process.
-  m_Transform->SetInputProjectionRef(source.GetProjectionRef());
+  const std::string inputProjectionRef = source.GetProjectionRef();
+  m_Transform->SetInputProjectionRef(inputProjectionRef);
   m_Transform->InstantiateTransform();
 
-  if (source == destination)
+  const itk::ThreadIdType nbThreads = std::max<itk::ThreadIdType>(1, this->GetNumberOfThreads());
+  if (nbThreads == 1)
   {
-    itkExceptionMacro(<< "Geometries projection filter cannot work in-place as the resulting layers will have a new spatial reference."
-                         " Please supply too different geometries sets to work on.");
+    m_TransformationFunctor(source, destination); // if TransformedElementType == layer
+    return;
   }
 
-  m_TransformationFunctor(source, destination); // if TransformedElementType == layer
+  // The coordinate transformations and sensor models held by GenericRSTransform
+  // are not meant to be shared between threads: each thread gets its own
+  // transform, instantiated here, sequentially, for the current layer.
+  std::vector<TransformationFunctorType> functors(nbThreads);
+  functors[0].SetOnePointTransformation(m_Transform);
+  for (itk::ThreadIdType t = 1; t < nbThreads; ++t)
+  {
+    functors[t].SetOnePointTransformation(NewLayerTransform(inputProjectionRef));
+  }
+
+  std::vector<ogr::Feature>           features;
+  std::vector<ogr::UniqueGeometryPtr> geometries;
+  std::vector<std::string>            errors(nbThreads);
+
+  ReprojectionThreadStruct str;
+  str.Features   = &features;
+  str.Geometries = &geometries;
+  str.Functors   = &functors;
+  str.Errors     = &errors;
+
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(nbThreads);
+  threader->SetSingleMethod(ReprojectionThreaderCallback, &str);
+
+  // The layer is processed by chunks of features: the features are read and
+  // written sequentially, in their original order, while only the
+  // reprojection of the geometries of the current chunk is multithreaded.
+  const std::size_t chunkSize = 1024 * nbThreads;
+  features.reserve(chunkSize);
+
+  OGRFeatureDefn& defn = destination.GetLayerDefn();
+  for (ogr::Layer::const_iterator b = source.begin(), e = source.end(); b != e;)
+  {
+    features.clear();
+    for (; b != e && features.size() != chunkSize; ++b)
+    {
+      features.push_back(*b);
+    }
+    geometries.clear();
+    geometries.resize(features.size());
+
+    threader->SingleMethodExecute();
+
+    for (itk::ThreadIdType t = 0; t < nbThreads; ++t)
+    {
+      if (!errors[t].empty())
+      {
+        itkExceptionMacro(<< "Cannot reproject the geometries of layer " << source.GetName() << ": " << errors[t]);
+      }
+    }
+
+    for (std::size_t i = 0, N = features.size(); i != N; ++i)
+    {
+      ogr::Feature dest(defn);
+      dest.SetGeometryDirectly(std::move(geometries[i]));
+      m_TransformationFunctor.fieldsTransform(features[i], dest);
+      destination.CreateFeature(dest);
+    }
+  }
 }
 
 /*virtual*/
@@ -22,6 +22,7 @@
 #define otbFastNLMeansImageFilter_h
 
 #include "itkImageToImageFilter.h"
+#include <vector>
 
 namespace otb
 {
@@ -41,6 +42,12 @@ namespace otb
  * Parameter-Free Fast Pixelwise Non-Local Means Denoising.
  * Image Processing On Line, 2014, vol. 4, p. 300-326.
  *
+ * Computations are done in single precision. Shifts are processed by
+ * blocks of consecutive column shifts: squared differences of a block are
+ * interleaved so that the inner loops run over the shifts of the block,
+ * and patch sums are obtained from row-wise prefix sums of one row at a
+ * time. Working buffers are kept per thread and reused across calls.
+ *
  * \ingroup OTBSmoothing
  */
 
@@ -104,7 +111,9 @@ protected:
   /** Destructor */
   ~NLMeansFilter() override = default;
 
-  void ThreadedGenerateData(const OutRegionType& outputRegionForThread, itk::ThreadIdType itkNotUsed(threadId)) override;
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
   void GenerateInputRequestedRegion() override;
 
@@ -124,27 +133,28 @@ private:
   NLMeansFilter(const Self&) = delete;            // purposely not implemented
   NLMeansFilter& operator=(const Self&) = delete; // purposely not implemented
 
-  /** For a given shift in rows and cols, this function computes
-   * the squared difference between the image and its shifted version.
-   * Results are added to form an integral image.
+  /** Working buffers of a thread */
+  struct ThreadBuffers
+  {
+    std::vector<float> input;     // mirror padded input, with m_ShiftsPerBlock-1 extra values per row
+    std::vector<float> rowPrefix; // row-wise prefix sums of squared differences, interleaved by shift
+    std::vector<float> patchRows; // ring of horizontal patch sums of the last patch rows
+    std::vector<float> outTemp;   // weighted sum of pixel values
+    std::vector<float> weights;   // sum of weights
+  };
+
+  /** For a given row shift and a block of m_ShiftsPerBlock column shifts
+   * starting at firstDCol, this function computes the distance between
+   * each patch and its shifted versions, and accumulates the weighted
+   * shifted pixels in outTemp and the weights in weights.
    */
-  void ComputeIntegralImage(const std::vector<double>& dataInput,    /**< input data stored in a vector */
-                            std::vector<double>&       imIntegral,   /**< output parameter. Contains the integral image of squared difference */
-                            const OutIndexType         shift,        /**< Shift (dcol, drow) to apply to compute the difference */
-                            const InSizeType           sizeIntegral, /**< Integral image size */
-                            const InSizeType           sizeInput     /**< input data image size */
+  void AccumulateShiftBlock(ThreadBuffers&     buffers,   /**< thread buffers, input already filled */
+                            const int          drow,      /**< row shift */
+                            const int          firstDCol, /**< first column shift of the block */
+                            const OutSizeType& outSize,   /**< output region size */
+                            const unsigned int stride     /**< row stride of the input buffer */
                             ) const;
 
-  /** This function computes the squared euclidean distance
-   * between a patch and its shifted version.
-   * Computation relies on the integral image obtained before.
-   */
-  OutPixelType ComputeDistance(const unsigned int         row,        /**< Upper left corner row coordinate of patch*/
-                               const unsigned int         col,        /**< Upper left corner col coordinate of patch*/
-                               const std::vector<double>& imIntegral, /**< Integral image of squared difference*/
-                               const unsigned int         nbCols      /**< Integral image number of columns */
-                               ) const;
-
   // Define class attributes
   InSizeType m_HalfSearchSize{0,0};
   InSizeType m_HalfPatchSize{0,0};
@@ -152,8 +162,11 @@ private:
   float      m_CutoffDistance;
   float      m_NormalizeDistance; // cutoff**2 * windowSize**2
 
-  static const int m_ROW = 1;
-  static const int m_COL = 0;
+  std::vector<ThreadBuffers> m_ThreadBuffers;
+
+  static const int          m_ROW            = 1;
+  static const int          m_COL            = 0;
+  static const unsigned int m_ShiftsPerBlock = 8;
 };
 } // end namespace otb
 
@@ -25,6 +25,8 @@
 #include "itkImageRegionIterator.h"
 #include "itkImageRegionConstIterator.h"
 #include "itkNumericTraits.h"
+#include <algorithm>
+#include <cmath>
 #include <vector>
 #include <tuple>
 
@@ -118,11 +120,19 @@ namespace otb
     inputPtr->SetRequestedRegion(inRequestedRegion);
   }
 
+  template<class TInputImage, class TOutputImage>
+  void
+  NLMeansFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+  {
+    // Keep the buffers of previous calls, they are only resized when needed
+    m_ThreadBuffers.resize(this->GetNumberOfThreads());
+  }
+
   template<class TInputImage, class TOutputImage>
   void 
   NLMeansFilter<TInputImage, TOutputImage>::ThreadedGenerateData
   (const OutRegionType& outputRegionForThread, 
-   itk::ThreadIdType itkNotUsed(threadId))
+   itk::ThreadIdType threadId)
   {
     InImageConstPointerType inputPtr = this->GetInput();
     auto regionAndMirror = OutputRegionToInputRegion(outputRegionForThread);
@@ -134,12 +144,13 @@ namespace otb
     int mirrorLastCol = std::get<4>(regionAndMirror);
     bool needMirror = std::get<5>(regionAndMirror);
 
-    // initialize and allocate vector to store temporary output values 
+    ThreadBuffers& buffers = m_ThreadBuffers[threadId];
+
+    // initialize temporary output values and weights
     // It makes it easier to store them in vectors to access various non-contiguous locations
     auto const& outSize = outputRegionForThread.GetSize();
-    std::vector<double> outTemp(outSize[m_ROW]*outSize[m_COL]);
-    // initialize and allocate buffer to store all weights
-    std::vector<double> weights(outSize[m_ROW]*outSize[m_COL]);
+    buffers.outTemp.assign(outSize[m_ROW]*outSize[m_COL], 0.f);
+    buffers.weights.assign(outSize[m_ROW]*outSize[m_COL], 0.f);
 
     typedef itk::ImageRegionConstIterator<InImageType> InIteratorType;
     InIteratorType inIt(inputPtr, inputRegionForThread);
@@ -148,16 +159,19 @@ namespace otb
     auto mirrorCol = inputSize[m_COL] + mirrorFirstCol + mirrorLastCol;
     auto mirrorRow = inputSize[m_ROW] + mirrorFirstRow + mirrorLastRow;
     InSizeType const& mirrorSize = {{mirrorCol, mirrorRow}};
+    // Extra values at the end of rows are only read by the unused shifts of the last block
+    const unsigned int stride = mirrorSize[m_COL] + m_ShiftsPerBlock - 1;
 
-    std::vector<double> dataInput(mirrorSize[m_ROW]*mirrorSize[m_COL]);
+    std::vector<float>& dataInput = buffers.input;
+    dataInput.assign(mirrorSize[m_ROW]*stride, 0.f);
     inIt.GoToBegin();
     for (unsigned int row=static_cast<unsigned int>(mirrorFirstRow); 
 	 row<static_cast<unsigned int>(mirrorFirstRow)+inputSize[m_ROW]; row++)
       for (unsigned int col=static_cast<unsigned int>(mirrorFirstCol); 
 	   col<static_cast<unsigned int>(mirrorFirstCol)+inputSize[m_COL]; col++)
 	{
-	  auto index = row * mirrorSize[m_COL] + col;
-	  dataInput[index] = static_cast<double>(inIt.Get());
+	  auto index = row * stride + col;
+	  dataInput[index] = static_cast<float>(inIt.Get());
 	  ++inIt;
 	}
 
@@ -166,27 +180,27 @@ namespace otb
 	// Perform mirror on upper lines
 	for (int row=0; row<mirrorFirstRow; row++)
 	  {
-	    int lineToCopy = (2*mirrorFirstRow - row)*mirrorSize[m_COL];
+	    int lineToCopy = (2*mirrorFirstRow - row)*stride;
 	    std::copy(dataInput.begin() + lineToCopy,
 		      dataInput.begin() + lineToCopy + mirrorSize[m_COL],
-		      dataInput.begin() + row*mirrorSize[m_COL] );
+		      dataInput.begin() + row*stride );
 	  }
 	// Perform mirror on lower lines
 	int lastRowRead = mirrorFirstRow+inputSize[m_ROW];
 	for (int row=0; row<mirrorLastRow; row++)
 	  {
-	    int lineToCopy = (lastRowRead - row -2)*mirrorSize[m_COL];
+	    int lineToCopy = (lastRowRead - row -2)*stride;
 	    std::copy(dataInput.begin() + lineToCopy,
 		      dataInput.begin() + lineToCopy + mirrorSize[m_COL],
-		      dataInput.begin() + (lastRowRead + row)*mirrorSize[m_COL]);
+		      dataInput.begin() + (lastRowRead + row)*stride);
 	  }
 	// Perform mirror on left-hand columns
 	if (mirrorFirstCol > 0) {
 	  for (unsigned int row=0; row<mirrorSize[m_ROW]; row++)
 	    {
-	      std::reverse_copy(dataInput.begin() + row*mirrorSize[m_COL] + mirrorFirstCol+1,
-				dataInput.begin() + row*mirrorSize[m_COL] +2*mirrorFirstCol+1,
-				dataInput.begin() + row*mirrorSize[m_COL]);
+	      std::reverse_copy(dataInput.begin() + row*stride + mirrorFirstCol+1,
+				dataInput.begin() + row*stride +2*mirrorFirstCol+1,
+				dataInput.begin() + row*stride);
 	    }
 		
 	}
@@ -194,44 +208,27 @@ namespace otb
 	if (mirrorLastCol > 0){
 	  for (unsigned int row=0; row<mirrorSize[m_ROW]; row++)
 	    {
-	      std::reverse_copy(dataInput.begin() + (row+1)*mirrorSize[m_COL] - 2*mirrorLastCol-1,
-				dataInput.begin() + (row+1)*mirrorSize[m_COL] - mirrorLastCol-1,
-				dataInput.begin() + (row+1)*mirrorSize[m_COL] - mirrorLastCol);
+	      auto rowEnd = row*stride + mirrorSize[m_COL];
+	      std::reverse_copy(dataInput.begin() + rowEnd - 2*mirrorLastCol-1,
+				dataInput.begin() + rowEnd - mirrorLastCol-1,
+				dataInput.begin() + rowEnd - mirrorLastCol);
 	    }
 	}
       }
 
-    // For loops on all shifts possible
-    int fullMarginRow = static_cast<int>(m_HalfSearchSize[m_ROW]+m_HalfPatchSize[m_ROW]);
-    int fullMarginCol = static_cast<int>(m_HalfSearchSize[m_COL]+m_HalfPatchSize[m_COL]);
+    // Allocate the buffers used for a block of shifts
+    auto const nbRingRows = std::max<itk::SizeValueType>(2*m_HalfPatchSize[m_ROW], 1);
+    auto const nbPrefixCols = outSize[m_COL] + 2*m_HalfPatchSize[m_COL] + 1;
+    buffers.rowPrefix.assign(nbPrefixCols*m_ShiftsPerBlock, 0.f);
+    buffers.patchRows.assign(nbRingRows*outSize[m_COL]*m_ShiftsPerBlock, 0.f);
+
+    // For loops on all shifts possible, column shifts are processed by blocks
     int searchSizeRow = static_cast<int>(m_HalfSearchSize[m_ROW]);
     int searchSizeCol = static_cast<int>(m_HalfSearchSize[m_COL]);
-    // Allocate integral image
-    const InSizeType sizeTwo = {{2,2}};
-    auto const& inSize = outSize + sizeTwo * m_HalfPatchSize;
-    
-    std::vector<double> imIntegral(inSize[m_ROW]*inSize[m_COL]);
     for (int drow=-searchSizeRow; drow < searchSizeRow+1; drow++)
-      for (int dcol=-searchSizeCol; dcol < searchSizeCol+1; dcol++)
+      for (int dcol=-searchSizeCol; dcol < searchSizeCol+1; dcol += m_ShiftsPerBlock)
 	{
-	  // Compute integral image for current shift (drow, dcol)
-	  OutIndexType shift = {{dcol, drow}};
-	  ComputeIntegralImage(dataInput, imIntegral, shift, inSize, mirrorSize);
-
-	  for(unsigned int row=0; row<outSize[m_ROW]; row++)
-	    for (unsigned int col=0; col<outSize[m_COL]; col++)
-	      {
-		// Compute distance from integral image for patch centered at 
-		// (row, col) + (m_HalfPatchSize, m_HalfPatchSize)
-		OutPixelType distance = ComputeDistance(row, col, imIntegral, inSize[m_COL]);
-		if (distance < 5.0)
-		  {
-		    double weight = exp(static_cast<double>(-distance));
-		    outTemp[row*outSize[m_COL] + col] += weight*dataInput[(row+drow+fullMarginRow)*mirrorSize[m_COL] 
-									  + col+dcol+fullMarginCol];
-		    weights[row*outSize[m_COL] + col] += weight;
-		  }
-	      }
+	  AccumulateShiftBlock(buffers, drow, dcol, outSize, stride);
 	}
 
     // Normalize all results by dividing output by weights (store in output)
@@ -241,85 +238,98 @@ namespace otb
     outIt.GoToBegin();
     for(unsigned int index=0; index<outSize[m_ROW]*outSize[m_COL]; index++)
       {
-	outIt.Set(static_cast<OutPixelType>(outTemp[index]/weights[index]));
+	outIt.Set(static_cast<OutPixelType>(buffers.outTemp[index]/buffers.weights[index]));
 	++outIt;
       }
   }
 
   template<class TInputImage, class TOutputImage>
   void 
-  NLMeansFilter<TInputImage, TOutputImage>::ComputeIntegralImage
-  (const std::vector<double> & dataInput, 
-   std::vector<double> &imIntegral, 
-   const OutIndexType shift, const InSizeType sizeIntegral, const InSizeType sizeInput) const
+  NLMeansFilter<TInputImage, TOutputImage>::AccumulateShiftBlock
+  (ThreadBuffers& buffers, const int drow, const int firstDCol,
+   const OutSizeType& outSize, const unsigned int stride) const
   {
+    constexpr unsigned int nbShifts = m_ShiftsPerBlock;
+
     // dataInput has a margin of m_HalfSearchSize+m_HalfPatchSize to allow
-    // computation of all shifts (computation of all integral images)
-    // integral images just have the m_HalfPatchSize margin necessary
-    // to compute patches differences for a given shift
-    // hence, the first point used in computation for the non-shifted image
-    // is located at m_HalfSearchSize
-    auto const& offsetRef = m_HalfSearchSize;
-    OutSizeType const& offsetShift = {{offsetRef[0] + shift[0], offsetRef[1] + shift[1]}};
-
-    // Initialize integral image (compute position (0,0))
-    auto indexInput = offsetRef[m_ROW]*sizeInput[m_COL] + offsetRef[m_COL];
-    auto indexShift = offsetShift[m_ROW]*sizeInput[m_COL] + offsetShift[m_COL];
-    double diff = dataInput[indexInput] - dataInput[indexShift];
-    imIntegral[0] = (diff * diff) - m_Var;
-    // Compute first line of integral image
-    for (unsigned int col=1; col<sizeIntegral[m_COL]; col++)
-      {
-	auto indexInputCol = indexInput + col;
-	auto indexShiftCol = indexShift + col;
-	diff = dataInput[indexInputCol] - dataInput[indexShiftCol];
-	double distance = diff * diff - m_Var;
-	imIntegral[col] = distance + imIntegral[col-1];
-	assert(imIntegral[col] < itk::NumericTraits<double>::max());
-      }
-    // Compute first column of integral image
-    for (unsigned int row=1; row<sizeIntegral[m_ROW]; row++)
+    // computation of all shifts. Patch sums only need the m_HalfPatchSize
+    // margin, hence the first point used in computation for the non-shifted
+    // image is located at m_HalfSearchSize
+    const float* dataInput = buffers.input.data();
+    float* rowPrefix = buffers.rowPrefix.data();
+    float* patchRows = buffers.patchRows.data();
+    float* outTemp = buffers.outTemp.data();
+    float* weights = buffers.weights.data();
+
+    const unsigned int halfPatchRow = m_HalfPatchSize[m_ROW];
+    const unsigned int halfPatchCol = m_HalfPatchSize[m_COL];
+    // As with the four corners of an integral image, the patch of output
+    // pixel (row, col) covers the 2*m_HalfPatchSize rows and columns
+    // following (row, col) in the squared differences
+    const unsigned int nbPatchRows = 2*halfPatchRow;
+    const unsigned int nbPatchCols = 2*halfPatchCol;
+    const unsigned int nbRingRows = std::max(nbPatchRows, 1u);
+    const unsigned int nbCols = outSize[m_COL];
+    const unsigned int nbDiffCols = nbCols + 2*halfPatchCol;
+    const long searchSizeRow = static_cast<long>(m_HalfSearchSize[m_ROW]);
+    const long searchSizeCol = static_cast<long>(m_HalfSearchSize[m_COL]);
+    const long fullMarginRow = searchSizeRow + halfPatchRow;
+    const long fullMarginCol = searchSizeCol + halfPatchCol;
+    const float patchVar = m_Var * nbPatchRows * nbPatchCols;
+    const float invNormalize = 1.f / m_NormalizeDistance;
+
+    // Shifts beyond the search window only complete the last block
+    float valid[nbShifts];
+    for (unsigned int k=0; k<nbShifts; k++)
+      valid[k] = (firstDCol + static_cast<long>(k) <= searchSizeCol) ? 1.f : 0.f;
+
+    float patchSum[nbShifts];
+    for (long row=0; row<static_cast<long>(outSize[m_ROW]+2*halfPatchRow); row++)
       {
-	auto indexInputRow = indexInput + row*sizeInput[m_COL];
-	auto indexShiftRow = indexShift + row*sizeInput[m_COL];
-	diff = dataInput[indexInputRow] - dataInput[indexShiftRow];
-	double distance = diff * diff - m_Var;
-	imIntegral[row*sizeIntegral[m_COL]] = distance + imIntegral[(row-1)*sizeIntegral[m_COL]];
-	assert(imIntegral[row*sizeIntegral[m_COL]] < itk::NumericTraits<double>::max());
-      }
-    // All initializations have been done previously
-    // Remaining coefficients can be computed
-    for (unsigned int row=1; row<sizeIntegral[m_ROW]; row++)
-      for (unsigned int col=1; col<sizeIntegral[m_COL]; col++)
-	{
-	  indexInput = (offsetRef[m_ROW]+row)*sizeInput[m_COL] + offsetRef[m_COL]+col;
-	  indexShift = (offsetShift[m_ROW]+row)*sizeInput[m_COL] + offsetShift[m_COL]+col;
-	  diff = dataInput[indexInput] - dataInput[indexShift];
-	  double distance = diff*diff - m_Var;
-	  imIntegral[row*sizeIntegral[m_COL] + col] = distance + imIntegral[row*sizeIntegral[m_COL] + col-1] 
-	    + imIntegral[(row-1)*sizeIntegral[m_COL] + col] - imIntegral[(row-1)*sizeIntegral[m_COL] + col-1];
-	  assert(imIntegral[row*sizeIntegral[m_COL] + col] < itk::NumericTraits<double>::max());
-	}
-    
-  }
+	const float* inputRef = dataInput + (searchSizeRow + row)*stride + searchSizeCol;
+	const float* inputShift = dataInput + (searchSizeRow + drow + row)*stride + searchSizeCol + firstDCol;
 
-  template <class TInputImage, class TOutputImage>
-  typename NLMeansFilter<TInputImage, TOutputImage>::OutPixelType 
-  NLMeansFilter<TInputImage, TOutputImage>::ComputeDistance
-  (const unsigned int row, const unsigned int col, 
-   const std::vector<double>& imIntegral, const unsigned int nbCols) const
-  {
-    // (row, col) is the central position of the local window in the output image
-    // however, integral image is shifted by (m_HalfPatchSize, m_HalfPatchSize) compared to output image
-    // Thus, (row, col) corresponds, in integral image, to the upper left corner of the local window
-    double distance_patch = 
-      imIntegral[(row+2*m_HalfPatchSize[m_ROW])*nbCols + col+2*m_HalfPatchSize[m_COL]] 
-      - imIntegral[row*nbCols + col+2*m_HalfPatchSize[m_COL]]
-      - imIntegral[(row+2*m_HalfPatchSize[m_ROW])*nbCols + col]
-      + imIntegral[row*nbCols + col];
-
-    distance_patch = std::max(distance_patch, 0.0) / (m_NormalizeDistance);
-    return static_cast<OutPixelType>(distance_patch);
+	// Row-wise prefix sums of squared differences, interleaved by shift
+	for (unsigned int col=0; col<nbDiffCols; col++)
+	  for (unsigned int k=0; k<nbShifts; k++)
+	    {
+	      float diff = inputRef[col] - inputShift[col+k];
+	      rowPrefix[(col+1)*nbShifts + k] = rowPrefix[col*nbShifts + k] + diff*diff;
+	    }
+
+	// Horizontal patch sums of this row, stored in the ring of patch rows
+	float* patchRow = patchRows + (row % nbRingRows)*nbCols*nbShifts;
+	for (unsigned int col=0; col<nbCols; col++)
+	  for (unsigned int k=0; k<nbShifts; k++)
+	    patchRow[col*nbShifts + k] = rowPrefix[(col+1+nbPatchCols)*nbShifts + k] - rowPrefix[(col+1)*nbShifts + k];
+
+	if (row < static_cast<long>(nbPatchRows))
+	  continue;
+
+	// The ring now holds all rows of the patches of output row outRow
+	const long outRow = row - nbPatchRows;
+	const float* value = dataInput + (outRow + drow + fullMarginRow)*stride + fullMarginCol + firstDCol;
+	for (unsigned int col=0; col<nbCols; col++)
+	  {
+	    for (unsigned int k=0; k<nbShifts; k++)
+	      patchSum[k] = 0.f;
+	    for (unsigned int patchRowIndex=0; patchRowIndex<nbPatchRows; patchRowIndex++)
+	      for (unsigned int k=0; k<nbShifts; k++)
+		patchSum[k] += patchRows[(patchRowIndex*nbCols + col)*nbShifts + k];
+
+	    float sumWeights = 0.f;
+	    float sumValues = 0.f;
+	    for (unsigned int k=0; k<nbShifts; k++)
+	      {
+		float distance = std::max(patchSum[k] - patchVar, 0.f) * invNormalize;
+		float weight = distance < 5.f ? valid[k] * std::exp(-distance) : 0.f;
+		sumWeights += weight;
+		sumValues += weight * value[col+k];
+	      }
+	    outTemp[outRow*nbCols + col] += sumValues;
+	    weights[outRow*nbCols + col] += sumWeights;
+	  }
+      }
   }
 
   template<class TInputImage, class TOutputImage>
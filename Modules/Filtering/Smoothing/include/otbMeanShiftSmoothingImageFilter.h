@@ -27,6 +27,7 @@
 #include "itkImageRegionConstIterator.h"
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include <algorithm>
+#include <vector>
 
 
 namespace otb
@@ -137,6 +138,37 @@ public:
   }
 };
 
+/** Evaluates the kernel on n squared norms at once. Overloaded for the kernels
+ * above with branch-free loops that the compiler can vectorize; other kernels
+ * go through their operator().
+ *
+ * \ingroup OTBSmoothing
+ */
+template <class TKernel>
+inline void EvaluateKernel(const TKernel& kernel, const double* norm2, double* weights, unsigned int n)
+{
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    weights[i] = kernel(norm2[i]);
+  }
+}
+
+inline void EvaluateKernel(const KernelUniform&, const double* norm2, double* weights, unsigned int n)
+{
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    weights[i] = (norm2[i] <= 1) ? 1.0 : 0.0;
+  }
+}
+
+inline void EvaluateKernel(const KernelGaussian&, const double* norm2, double* weights, unsigned int n)
+{
+  for (unsigned int i = 0; i < n; ++i)
+  {
+    weights[i] = std::exp(-0.5 * norm2[i]);
+  }
+}
+
 /** \class FastImageRegionConstIterator
  *
  * Iterator for reading pixels over an image region, specialized for faster
@@ -436,6 +468,8 @@ private:
  * MaxIterationNumber defines maximum iteration number for each pixel convergence (set using Get/Set accessor). Set to 4 by default.
  * ModeSearch is a boolean value, to choose between optimized and non optimized algorithm. If set to true (by default), assign mode value to each pixel on a
  * path covered in convergence steps.
+ * ModeSearchTolerance sets how close (in range) a path has to be to a pixel to share its mode, and BasinOfAttraction
+ * additionally assigns each new mode to the pixels lying within this tolerance of it, in the joint domain.
  *
  * For more information on mean shift techniques, one might consider reading the following article:
  *
@@ -540,6 +574,25 @@ public:
   itkSetMacro(ModeSearch, bool);
   itkGetConstReferenceMacro(ModeSearch, bool);
 
+  /** Squared range distance, normalized by the range bandwidth, under which a
+   * trajectory point is considered to belong to the mode of the pixel it
+   * crosses. Only used with mode search. Lower values give results closer to
+   * the exact mean shift, at the expense of fewer early terminations.
+   * Default is 0.5.
+   */
+  itkSetMacro(ModeSearchTolerance, RealType);
+  itkGetConstReferenceMacro(ModeSearchTolerance, RealType);
+
+  /** Toggle basin of attraction, which is disabled by default. Only used with
+   * mode search. When a pixel converges to a new mode, the unprocessed pixels
+   * whose joint spatial-range distance to this mode (normalized by the
+   * bandwidths, squared) is lower than ModeSearchTolerance are assigned to it
+   * without iterating.
+   */
+  itkSetMacro(BasinOfAttraction, bool);
+  itkGetConstReferenceMacro(BasinOfAttraction, bool);
+  itkBooleanMacro(BasinOfAttraction);
+
 #if 0
   /** Toggle bucket optimization, which is disabled by default.
    */
@@ -644,6 +697,10 @@ private:
   /** Input data in the joint spatial-range domain, scaled by the bandwidths */
   typename RealVectorImageType::Pointer m_JointImage;
 
+  /** Same data as m_JointImage, stored as one plane per joint component so
+   * that the neighbours along a line are contiguous for each component */
+  std::vector<RealType> m_JointPlanes;
+
   /** Image to store the status at each pixel:
    * 0 : no mode has been found yet
    * 1 : a mode has been assigned to this pixel
@@ -655,6 +712,12 @@ private:
   /** Boolean to enable mode search  */
   bool m_ModeSearch;
 
+  /** Distance under which trajectory points are merged with a mode */
+  RealType m_ModeSearchTolerance;
+
+  /** Boolean to enable basin of attraction assignment */
+  bool m_BasinOfAttraction;
+
 #if 0
   /** Boolean to enable bucket optimization */
   bool m_BucketOptimization;
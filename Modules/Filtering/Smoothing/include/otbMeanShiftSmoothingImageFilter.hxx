@@ -24,6 +24,8 @@
 
 #include "otbMeanShiftSmoothingImageFilter.h"
 #include "itkImageRegionIterator.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkImageRegionIteratorWithIndex.h"
 #include "otbUnaryFunctorWithIndexWithOutputSizeImageFilter.h"
 #include "otbMacro.h"
 
@@ -48,6 +50,8 @@ MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIterati
     // , m_ModeTable(0)
     ,
     m_ModeSearch(false),
+    m_ModeSearchTolerance(0.5),
+    m_BasinOfAttraction(false),
     m_ThreadIdNumberOfBits(0)
 #if 0
       , m_BucketOptimization(false)
@@ -261,6 +265,19 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
   jointImageFunctor->Update();
   m_JointImage = jointImageFunctor->GetOutput();
 
+  // Structure-of-arrays copy of the joint image, used by CalculateMeanShiftVector()
+  const unsigned int jointDimension = ImageDimension + m_NumberOfComponentsPerPixel;
+  const std::size_t  nbPixels       = m_JointImage->GetBufferedRegion().GetNumberOfPixels();
+  const RealType*    jointBuffer    = m_JointImage->GetBufferPointer();
+  m_JointPlanes.resize(jointDimension * nbPixels);
+  for (std::size_t i = 0; i < nbPixels; ++i)
+  {
+    for (unsigned int comp = 0; comp < jointDimension; ++comp)
+    {
+      m_JointPlanes[comp * nbPixels + i] = jointBuffer[i * jointDimension + comp];
+    }
+  }
+
 #if 0
   if (m_BucketOptimization)
     {
@@ -376,72 +393,71 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
   neighborhoodRegion.SetIndex(regionIndex);
   neighborhoodRegion.SetSize(regionSize);
 
-  RealType   weightSum = 0;
-  RealVector shifts(jointDimension);
+  if (neighborhoodRegion.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  RealType weightSum = 0;
+
+  // Neighbours are processed line by line, in blocks of contiguous pixels.
+  // For each component, the block is read from its plane so that distances and
+  // kernel weights are computed on several neighbours at once. Accumulations
+  // keep the pixel order, so that results do not depend on the block size.
+  const unsigned int BlockSize = 64;
+  RealType           norm2[BlockSize];
+  RealType           weights[BlockSize];
+
+  const std::size_t nbPixels = jointImage->GetBufferedRegion().GetNumberOfPixels();
 
-  // An iterator on the neighborhood of the current pixel (in joint
-  // spatial-range domain)
-  otb::Meanshift::FastImageRegionConstIterator<RealVectorImageType> it(jointImage, neighborhoodRegion);
-  // itk::ImageRegionConstIterator<RealVectorImageType> it(jointImage, neighborhoodRegion);
+  itk::ImageScanlineConstIterator<RealVectorImageType> it(jointImage, neighborhoodRegion);
 
   it.GoToBegin();
   while (!it.IsAtEnd())
   {
-    const RealType* jointNeighbor = it.GetPixelPointer();
+    const std::size_t  lineOffset = jointImage->ComputeOffset(it.GetIndex());
+    const unsigned int lineLength = neighborhoodRegion.GetSize()[0];
 
-    // Compute the squared norm of the difference
-    // This is the L2 norm, TODO: replace by the templated norm
-    RealType norm2 = 0;
-    for (unsigned int comp = 0; comp < jointDimension; comp++)
+    for (unsigned int start = 0; start < lineLength; start += BlockSize)
     {
-      shifts[comp] = jointNeighbor[comp] - jointPixel[comp];
-      double d     = shifts[comp] / bandwidth[comp];
-      norm2 += d * d;
-    }
+      const unsigned int n = std::min(BlockSize, lineLength - start);
 
-    // Compute pixel weight from kernel
-    const RealType weight = m_Kernel(norm2);
-    /*
-     // The following code is an alternative way to compute norm2 and weight
-     // It separates the norms of spatial and range elements
-     RealType spatialNorm2;
-     RealType rangeNorm2;
-     spatialNorm2 = 0;
-     for (unsigned int comp = 0; comp < ImageDimension; comp++)
-     {
-     RealType d;
-     d = jointNeighbor[comp] - jointPixel[comp];
-     spatialNorm2 += d*d;
-     }
-
-     if(spatialNorm2 >= 1.0)
-     {
-     weight = 0;
-     }
-     else
-     {
-     rangeNorm2 = 0;
-     for (unsigned int comp = 0; comp < m_NumberOfComponentsPerPixel; comp++)
-     {
-     RealType d;
-     d = jointNeighbor[ImageDimension + comp] - jointPixel[ImageDimension + comp];
-     rangeNorm2 += d*d;
-     }
-
-     weight = (rangeNorm2 <= 1.0)? 1.0 : 0.0;
-     }
-     */
-
-    // Update sum of weights
-    weightSum += weight;
-
-    // Update mean shift vector
-    for (unsigned int comp = 0; comp < jointDimension; comp++)
-    {
-      meanShiftVector[comp] += weight * shifts[comp];
+      // Squared norms of the differences, normalized by the bandwidth
+      std::fill(norm2, norm2 + n, 0.);
+      for (unsigned int comp = 0; comp < jointDimension; comp++)
+      {
+        const RealType* plane = &m_JointPlanes[comp * nbPixels + lineOffset + start];
+        const RealType  value = jointPixel[comp];
+        const RealType  bw    = bandwidth[comp];
+        for (unsigned int i = 0; i < n; ++i)
+        {
+          const RealType d = (plane[i] - value) / bw;
+          norm2[i] += d * d;
+        }
+      }
+
+      // Compute pixel weights from kernel
+      Meanshift::EvaluateKernel(m_Kernel, norm2, weights, n);
+
+      // Update sum of weights and mean shift vector
+      for (unsigned int i = 0; i < n; ++i)
+      {
+        weightSum += weights[i];
+      }
+      for (unsigned int comp = 0; comp < jointDimension; comp++)
+      {
+        const RealType* plane = &m_JointPlanes[comp * nbPixels + lineOffset + start];
+        const RealType  value = jointPixel[comp];
+        RealType        sum   = meanShiftVector[comp];
+        for (unsigned int i = 0; i < n; ++i)
+        {
+          sum += weights[i] * (plane[i] - value);
+        }
+        meanShiftVector[comp] = sum;
+      }
     }
 
-    ++it;
+    it.NextLine();
   }
 
   if (weightSum > 0)
@@ -655,7 +671,7 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
             diff += d * d;
           }
 
-          if (diff < 0.5) // Spectral value is close enough
+          if (diff < m_ModeSearchTolerance) // Spectral value is close enough
           {
             // If no mode has been associated to the candidate pixel then
             // associate it to the upcoming mode
@@ -756,6 +772,52 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
         m_ModeTable->SetPixel(pointList[i], 1);
         labelOutput->SetPixel(pointList[i], label);
       }
+
+      // Assign the new mode to the unprocessed pixels of its basin of attraction
+      if (m_BasinOfAttraction && hasConverged)
+      {
+        const RealType tolerance = std::sqrt(m_ModeSearchTolerance);
+        InputIndexType basinIndex;
+        InputSizeType  basinSize;
+        for (unsigned int comp = 0; comp < ImageDimension; comp++)
+        {
+          const long int center = std::floor(jointPixel[comp] - m_GlobalShift[comp] + 0.5);
+          const long int radius = std::ceil(tolerance * bandwidth[comp]);
+          basinIndex[comp]      = center - radius;
+          basinSize[comp]       = 2 * radius + 1;
+        }
+        RegionType basinRegion(basinIndex, basinSize);
+        if (basinRegion.Crop(outputRegionForThread))
+        {
+          itk::ImageRegionIteratorWithIndex<ModeTableImageType> basinIt(m_ModeTable, basinRegion);
+          for (basinIt.GoToBegin(); !basinIt.IsAtEnd(); ++basinIt)
+          {
+            if (basinIt.Get() != 0)
+            {
+              continue;
+            }
+            const InputIndexType basinPixelIndex = basinIt.GetIndex();
+            RealVector const&    basinPixel      = m_JointImage->GetPixel(basinPixelIndex);
+            RealType             dist            = 0;
+            for (unsigned int comp = 0; comp < jointDimension; comp++)
+            {
+              const RealType d = (basinPixel[comp] - jointPixel[comp]) / bandwidth[comp];
+              dist += d * d;
+            }
+            if (dist < m_ModeSearchTolerance)
+            {
+              for (unsigned int comp = 0; comp < ImageDimension; comp++)
+              {
+                spatialPixel[comp] = jointPixel[comp] - basinPixelIndex[comp] - m_GlobalShift[comp];
+              }
+              rangeOutput->SetPixel(basinPixelIndex, rangePixel);
+              spatialOutput->SetPixel(basinPixelIndex, spatialPixel);
+              labelOutput->SetPixel(basinPixelIndex, label);
+              basinIt.Set(1);
+            }
+          }
+        }
+      }
     }
     else // if ModeSearch is not set LabelOutput can't be generated
     {
@@ -774,6 +836,9 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
   typedef itk::ImageRegionIterator<OutputLabelImageType> OutputLabelIteratorType;
   OutputLabelIteratorType                                labelIt(labelOutput, labelOutput->GetRequestedRegion());
 
+  // Release the structure-of-arrays copy of the joint image
+  std::vector<RealType>().swap(m_JointPlanes);
+
   // Reassign mode labels
   // Note: Labels are only computed when mode search optimization is enabled
   if (m_ModeSearch)
@@ -819,6 +884,9 @@ void MeanShiftSmoothingImageFilter<TInputImage, TOutputImage, TKernel, TOutputIt
   Superclass::PrintSelf(os, indent);
   os << indent << "Spatial bandwidth: " << m_SpatialBandwidth << std::endl;
   os << indent << "Range bandwidth: " << m_RangeBandwidth << std::endl;
+  os << indent << "Mode search: " << m_ModeSearch << std::endl;
+  os << indent << "Mode search tolerance: " << m_ModeSearchTolerance << std::endl;
+  os << indent << "Basin of attraction: " << m_BasinOfAttraction << std::endl;
 }
 
 } // end namespace otb
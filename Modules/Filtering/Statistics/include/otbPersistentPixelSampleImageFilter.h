@@ -0,0 +1,190 @@
+/*
+ * Copyright (C) 1999-2011 Insight Software Consortium
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbPersistentPixelSampleImageFilter_h
+#define otbPersistentPixelSampleImageFilter_h
+
+#include "otbPersistentReduceImageFilter.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+
+/** \class PixelSampleAccumulator
+ * \brief Holds a uniform random sample of a fixed number of pixels.
+ *
+ * Each pixel gets a pseudo-random key computed from its index and a seed,
+ * and the accumulator keeps the pixels with the smallest keys. The sample
+ * only depends on the seed and on the set of accumulated pixels: neither
+ * the streaming nor the number of threads changes it.
+ *
+ * \sa PersistentPixelSampleImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPixel, class TIndex>
+class PixelSampleAccumulator
+{
+public:
+  typedef unsigned long long KeyType;
+
+  PixelSampleAccumulator(unsigned int sampleSize = 0, KeyType seed = 0) : m_SampleSize(sampleSize), m_Seed(seed)
+  {
+  }
+
+  void Accumulate(const TPixel& value, const TIndex& index)
+  {
+    // Indices are packed on 32 bits per dimension, which is exact for 2D
+    // images: the mixing function is a bijection, so keys never collide
+    KeyType packed = 0;
+    for (unsigned int dim = 0; dim < TIndex::Dimension; ++dim)
+    {
+      packed = (packed << 32) ^ static_cast<KeyType>(static_cast<unsigned int>(index[dim]));
+    }
+    Insert(Mix(packed ^ m_Seed), value);
+  }
+
+  void Merge(const PixelSampleAccumulator& other)
+  {
+    for (const auto& entry : other.m_Entries)
+    {
+      Insert(entry.first, entry.second);
+    }
+  }
+
+  /** Sampled pixels, in increasing key order */
+  std::vector<TPixel> GetSamples() const
+  {
+    std::vector<Entry> entries = m_Entries;
+    std::sort_heap(entries.begin(), entries.end(), CompareKeys);
+
+    std::vector<TPixel> samples;
+    samples.reserve(entries.size());
+    for (const auto& entry : entries)
+    {
+      samples.push_back(entry.second);
+    }
+    return samples;
+  }
+
+  unsigned int GetSampleSize() const
+  {
+    return m_SampleSize;
+  }
+
+private:
+  typedef std::pair<KeyType, TPixel> Entry;
+
+  static bool CompareKeys(const Entry& a, const Entry& b)
+  {
+    return a.first < b.first;
+  }
+
+  /** splitmix64 finalizer */
+  static KeyType Mix(KeyType x)
+  {
+    x = (x ^ (x >> 30)) * 0xbf58476d1ce4e5b9ULL;
+    x = (x ^ (x >> 27)) * 0x94d049bb133111ebULL;
+    return x ^ (x >> 31);
+  }
+
+  /** m_Entries is a max-heap on the keys, so that the largest kept key is
+   * the first one to be replaced */
+  void Insert(KeyType key, const TPixel& value)
+  {
+    if (m_Entries.size() < m_SampleSize)
+    {
+      m_Entries.emplace_back(key, value);
+      std::push_heap(m_Entries.begin(), m_Entries.end(), CompareKeys);
+    }
+    else if (m_SampleSize > 0 && key < m_Entries.front().first)
+    {
+      std::pop_heap(m_Entries.begin(), m_Entries.end(), CompareKeys);
+      m_Entries.back() = Entry(key, value);
+      std::push_heap(m_Entries.begin(), m_Entries.end(), CompareKeys);
+    }
+  }
+
+  unsigned int       m_SampleSize;
+  KeyType            m_Seed;
+  std::vector<Entry> m_Entries;
+};
+
+/** \class PersistentPixelSampleImageFilter
+ * \brief Gathers a uniform random sample of the pixels of an image over
+ * multiple updates.
+ *
+ * Unlike the other persistent filters, the input is grafted to the output,
+ * so that this filter can be placed upstream another persistent filter and
+ * gather its sample during the same streamed pass. In that case, Reset()
+ * and Synthetize() have to be called around the update of the downstream
+ * filter.
+ *
+ * The sample size and the seed are set through SetInitialAccumulator().
+ *
+ * \sa PixelSampleAccumulator
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TInputImage>
+class ITK_EXPORT PersistentPixelSampleImageFilter
+    : public PersistentReduceImageFilter<TInputImage, PixelSampleAccumulator<typename TInputImage::PixelType, typename TInputImage::IndexType>>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentPixelSampleImageFilter Self;
+  typedef PersistentReduceImageFilter<TInputImage, PixelSampleAccumulator<typename TInputImage::PixelType, typename TInputImage::IndexType>> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentPixelSampleImageFilter, PersistentReduceImageFilter);
+
+  typedef typename Superclass::ImageType       ImageType;
+  typedef typename Superclass::AccumulatorType AccumulatorType;
+
+  /** Pass the input through */
+  void AllocateOutputs() override
+  {
+    this->GraftOutput(const_cast<ImageType*>(this->GetInput()));
+  }
+
+protected:
+  PersistentPixelSampleImageFilter()
+  {
+  }
+  ~PersistentPixelSampleImageFilter() override
+  {
+  }
+
+private:
+  PersistentPixelSampleImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#endif
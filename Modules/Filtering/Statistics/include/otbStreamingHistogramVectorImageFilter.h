@@ -175,6 +175,12 @@ public:
   void Synthetize(void) override;
   void Reset(void) override;
 
+  /** The histograms are reduced over the processes sharing the streaming */
+  bool SupportsDistributedStreaming() const override
+  {
+    return true;
+  }
+
 protected:
   PersistentHistogramVectorImageFilter();
   ~PersistentHistogramVectorImageFilter() override
@@ -211,6 +211,32 @@ void PersistentHistogramVectorImageFilter<TInputImage>::Synthetize()
       }
     }
   }
+
+  // Reduce the histograms of the processes which streamed the other splits
+  if (ProcessGroup* group = this->GetProcessGroup())
+  {
+    std::vector<double> frequencies;
+    for (unsigned int j = 0; j < numberOfComponent; ++j)
+    {
+      HistogramType* outHisto = outputHisto->GetNthElement(j);
+      for (typename HistogramType::Iterator it = outHisto->Begin(); it != outHisto->End(); ++it)
+      {
+        frequencies.push_back(it.GetFrequency());
+      }
+    }
+
+    group->AllReduceSum(frequencies.data(), frequencies.size());
+
+    std::vector<double>::const_iterator frequency = frequencies.begin();
+    for (unsigned int j = 0; j < numberOfComponent; ++j)
+    {
+      HistogramType* outHisto = outputHisto->GetNthElement(j);
+      for (typename HistogramType::Iterator it = outHisto->Begin(); it != outHisto->End(); ++it, ++frequency)
+      {
+        it.SetFrequency(*frequency);
+      }
+    }
+  }
 }
 
 template <class TInputImage>
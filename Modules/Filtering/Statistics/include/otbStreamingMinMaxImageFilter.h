@@ -22,8 +22,7 @@
 #ifndef otbStreamingMinMaxImageFilter_h
 #define otbStreamingMinMaxImageFilter_h
 
-#include <vector>
-#include "otbPersistentImageFilter.h"
+#include "otbPersistentReduceImageFilter.h"
 #include "itkNumericTraits.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "otbPersistentFilterStreamingDecorator.h"
@@ -31,6 +30,76 @@
 namespace otb
 {
 
+/** \class MinMaxAccumulator
+ * \brief Holds the minimum and maximum of a set of pixels, and their
+ * first position.
+ *
+ * \sa PersistentMinMaxImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPixel, class TIndex>
+class MinMaxAccumulator
+{
+public:
+  MinMaxAccumulator() : m_Minimum(itk::NumericTraits<TPixel>::max()), m_Maximum(itk::NumericTraits<TPixel>::NonpositiveMin())
+  {
+    m_MinimumIndex.Fill(0);
+    m_MaximumIndex.Fill(0);
+  }
+
+  void Accumulate(const TPixel& value, const TIndex& index)
+  {
+    if (value < m_Minimum)
+    {
+      m_Minimum      = value;
+      m_MinimumIndex = index;
+    }
+    if (value > m_Maximum)
+    {
+      m_Maximum      = value;
+      m_MaximumIndex = index;
+    }
+  }
+
+  void Merge(const MinMaxAccumulator& other)
+  {
+    if (other.m_Minimum < m_Minimum)
+    {
+      m_Minimum      = other.m_Minimum;
+      m_MinimumIndex = other.m_MinimumIndex;
+    }
+    if (other.m_Maximum > m_Maximum)
+    {
+      m_Maximum      = other.m_Maximum;
+      m_MaximumIndex = other.m_MaximumIndex;
+    }
+  }
+
+  const TPixel& GetMinimum() const
+  {
+    return m_Minimum;
+  }
+  const TPixel& GetMaximum() const
+  {
+    return m_Maximum;
+  }
+  const TIndex& GetMinimumIndex() const
+  {
+    return m_MinimumIndex;
+  }
+  const TIndex& GetMaximumIndex() const
+  {
+    return m_MaximumIndex;
+  }
+
+private:
+  TPixel m_Minimum;
+  TPixel m_Maximum;
+  TIndex m_MinimumIndex;
+  TIndex m_MaximumIndex;
+};
+
 /** \class PersistentMinMaxImageFilter
  * \brief Compute min. max of an image using the output requested region.
  *
@@ -41,7 +110,7 @@ namespace otb
  *
  * To get the min/max once the regions have been processed via the pipeline, use the Synthetize() method.
  *
- * \sa PersistentImageFilter
+ * \sa PersistentReduceImageFilter
  * \ingroup Streamed
  * \ingroup Multithreaded
  * \ingroup MathematicalStatisticsImageFilters
@@ -49,12 +118,13 @@ namespace otb
  * \ingroup OTBStatistics
  */
 template <class TInputImage>
-class ITK_EXPORT PersistentMinMaxImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+class ITK_EXPORT PersistentMinMaxImageFilter
+    : public PersistentReduceImageFilter<TInputImage, MinMaxAccumulator<typename TInputImage::PixelType, typename TInputImage::IndexType>>
 {
 public:
   /** Standard Self typedef */
   typedef PersistentMinMaxImageFilter Self;
-  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef PersistentReduceImageFilter<TInputImage, MinMaxAccumulator<typename TInputImage::PixelType, typename TInputImage::IndexType>> Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
@@ -62,7 +132,7 @@ public:
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(PersistentMinMaxImageFilter, PersistentImageFilter);
+  itkTypeMacro(PersistentMinMaxImageFilter, PersistentReduceImageFilter);
 
   /** Image related typedefs. */
   typedef TInputImage                   ImageType;
@@ -124,13 +194,7 @@ public:
   DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx) override;
   using Superclass::MakeOutput;
 
-  /** Pass the input through unmodified. Do this by Grafting in the
-   *  AllocateOutputs method.
-   */
-  void AllocateOutputs() override;
-  void GenerateOutputInformation() override;
   void Synthetize(void) override;
-  void Reset(void) override;
 
 protected:
   PersistentMinMaxImageFilter();
@@ -139,17 +203,9 @@ protected:
   }
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
-  /** Multi-thread version GenerateData. */
-  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
-
 private:
   PersistentMinMaxImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
-
-  std::vector<PixelType> m_ThreadMin;
-  std::vector<PixelType> m_ThreadMax;
-  std::vector<IndexType> m_ThreadMinIndex;
-  std::vector<IndexType> m_ThreadMaxIndex;
 }; // end of class PersistentMinMaxImageFilter
 
 
@@ -23,9 +23,6 @@
 #define otbStreamingMinMaxImageFilter_hxx
 #include "otbStreamingMinMaxImageFilter.h"
 
-#include <algorithm>
-#include "itkImageRegionIterator.h"
-#include "itkProgressReporter.h"
 #include "otbMacro.h"
 
 namespace otb
@@ -122,107 +119,17 @@ const typename PersistentMinMaxImageFilter<TInputImage>::IndexObjectType* Persis
   return static_cast<const IndexObjectType*>(this->itk::ProcessObject::GetOutput(4));
 }
 
-template <class TInputImage>
-void PersistentMinMaxImageFilter<TInputImage>::GenerateOutputInformation()
-{
-  Superclass::GenerateOutputInformation();
-  if (this->GetInput())
-  {
-    this->GetOutput()->CopyInformation(this->GetInput());
-    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
-
-    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
-    {
-      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
-    }
-  }
-}
-template <class TInputImage>
-void PersistentMinMaxImageFilter<TInputImage>::AllocateOutputs()
-{
-  // This is commented to prevent the streaming of the whole image for the first stream strip
-  // It shall not cause any problem because the output image of this filter is not intended to be used.
-  // InputImagePointer image = const_cast< TInputImage * >( this->GetInput() );
-  // this->GraftOutput( image );
-  // Nothing that needs to be allocated for the remaining outputs
-}
-
 template <class TInputImage>
 void PersistentMinMaxImageFilter<TInputImage>::Synthetize()
 {
-  int i;
-  int numberOfThreads = this->GetNumberOfThreads();
-
-  PixelType minimum = itk::NumericTraits<PixelType>::max();
-  PixelType maximum = itk::NumericTraits<PixelType>::NonpositiveMin();
-  IndexType minimumIdx;
-  IndexType maximumIdx;
-
-  for (i = 0; i < numberOfThreads; ++i)
-  {
-    if (m_ThreadMin[i] < minimum)
-    {
-      minimum    = m_ThreadMin[i];
-      minimumIdx = m_ThreadMinIndex[i];
-    }
-    if (m_ThreadMax[i] > maximum)
-    {
-      maximum    = m_ThreadMax[i];
-      maximumIdx = m_ThreadMaxIndex[i];
-    }
-  }
+  Superclass::Synthetize();
 
   // Set the outputs
-  this->GetMinimumOutput()->Set(minimum);
-  this->GetMaximumOutput()->Set(maximum);
-  this->GetMinimumIndexOutput()->Set(minimumIdx);
-  this->GetMaximumIndexOutput()->Set(maximumIdx);
-}
-
-template <class TInputImage>
-void PersistentMinMaxImageFilter<TInputImage>::Reset()
-{
-  int numberOfThreads = this->GetNumberOfThreads();
-
-  m_ThreadMin.resize(numberOfThreads);
-  m_ThreadMax.resize(numberOfThreads);
-  std::fill(m_ThreadMin.begin(), m_ThreadMin.end(), itk::NumericTraits<PixelType>::max());
-  std::fill(m_ThreadMax.begin(), m_ThreadMax.end(), itk::NumericTraits<PixelType>::NonpositiveMin());
-
-  IndexType zeroIdx;
-  zeroIdx.Fill(0);
-  m_ThreadMinIndex.resize(numberOfThreads);
-  m_ThreadMaxIndex.resize(numberOfThreads);
-  std::fill(m_ThreadMinIndex.begin(), m_ThreadMinIndex.end(), zeroIdx);
-  std::fill(m_ThreadMaxIndex.begin(), m_ThreadMaxIndex.end(), zeroIdx);
-}
-
-template <class TInputImage>
-void PersistentMinMaxImageFilter<TInputImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
-{
-  // support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
-
-  InputImagePointer                          inputPtr = const_cast<TInputImage*>(this->GetInput(0));
-  itk::ImageRegionConstIterator<TInputImage> it(inputPtr, outputRegionForThread);
-  it.GoToBegin();
-  // do the work
-  while (!it.IsAtEnd())
-  {
-    PixelType value = it.Get();
-    if (value < m_ThreadMin[threadId])
-    {
-      m_ThreadMin[threadId]      = value;
-      m_ThreadMinIndex[threadId] = it.GetIndex();
-    }
-    if (value > m_ThreadMax[threadId])
-    {
-      m_ThreadMax[threadId]      = value;
-      m_ThreadMaxIndex[threadId] = it.GetIndex();
-    }
-    ++it;
-    progress.CompletedPixel();
-  }
+  const typename Superclass::AccumulatorType& result = this->GetResult();
+  this->GetMinimumOutput()->Set(result.GetMinimum());
+  this->GetMaximumOutput()->Set(result.GetMaximum());
+  this->GetMinimumIndexOutput()->Set(result.GetMinimumIndex());
+  this->GetMaximumIndexOutput()->Set(result.GetMaximumIndex());
 }
 
 template <class TImage>
@@ -22,7 +22,7 @@
 #ifndef otbStreamingMinMaxVectorImageFilter_h
 #define otbStreamingMinMaxVectorImageFilter_h
 
-#include "otbPersistentImageFilter.h"
+#include "otbPersistentReduceImageFilter.h"
 #include "otbPersistentFilterStreamingDecorator.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "itkImageRegionSplitter.h"
@@ -32,6 +32,85 @@
 namespace otb
 {
 
+/** \class VectorMinMaxAccumulator
+ * \brief Holds the band-wise minimum and maximum of a set of vector
+ * pixels, optionally ignoring a no-data value.
+ *
+ * \sa PersistentMinMaxVectorImageFilter
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TPixel>
+class VectorMinMaxAccumulator
+{
+public:
+  typedef typename TPixel::ValueType InternalPixelType;
+
+  VectorMinMaxAccumulator() : m_NoDataFlag(false), m_NoDataValue()
+  {
+  }
+
+  VectorMinMaxAccumulator(unsigned int numberOfComponents, bool noDataFlag, InternalPixelType noDataValue)
+    : m_NoDataFlag(noDataFlag), m_NoDataValue(noDataValue)
+  {
+    m_Minimum.SetSize(numberOfComponents);
+    m_Minimum.Fill(itk::NumericTraits<InternalPixelType>::max());
+    m_Maximum.SetSize(numberOfComponents);
+    m_Maximum.Fill(itk::NumericTraits<InternalPixelType>::NonpositiveMin());
+  }
+
+  template <class TIndex>
+  void Accumulate(const TPixel& vectorValue, const TIndex&)
+  {
+    for (unsigned int j = 0; j < vectorValue.GetSize(); ++j)
+    {
+      const InternalPixelType value = vectorValue[j];
+
+      if ((!m_NoDataFlag) || value != m_NoDataValue)
+      {
+        if (value < m_Minimum[j])
+        {
+          m_Minimum[j] = value;
+        }
+        if (value > m_Maximum[j])
+        {
+          m_Maximum[j] = value;
+        }
+      }
+    }
+  }
+
+  void Merge(const VectorMinMaxAccumulator& other)
+  {
+    for (unsigned int j = 0; j < m_Minimum.GetSize(); ++j)
+    {
+      if (other.m_Minimum[j] < m_Minimum[j])
+      {
+        m_Minimum[j] = other.m_Minimum[j];
+      }
+      if (other.m_Maximum[j] > m_Maximum[j])
+      {
+        m_Maximum[j] = other.m_Maximum[j];
+      }
+    }
+  }
+
+  const TPixel& GetMinimum() const
+  {
+    return m_Minimum;
+  }
+  const TPixel& GetMaximum() const
+  {
+    return m_Maximum;
+  }
+
+private:
+  TPixel            m_Minimum;
+  TPixel            m_Maximum;
+  bool              m_NoDataFlag;
+  InternalPixelType m_NoDataValue;
+};
+
 /** \class PersistentMinMaxVectorImageFilter
  * \brief Compute min. max of a large image using streaming
  *
@@ -42,7 +121,7 @@ namespace otb
  *
  * To get the statistics once the regions have been processed via the pipeline, use the Synthetize() method.
  *
- * \sa PersistentImageFilter
+ * \sa PersistentReduceImageFilter
  * \ingroup Streamed
  * \ingroup Multithreaded
  * \ingroup MathematicalStatisticsImageFilters
@@ -51,12 +130,12 @@ namespace otb
  * \ingroup OTBStatistics
  */
 template <class TInputImage>
-class ITK_EXPORT PersistentMinMaxVectorImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+class ITK_EXPORT PersistentMinMaxVectorImageFilter : public PersistentReduceImageFilter<TInputImage, VectorMinMaxAccumulator<typename TInputImage::PixelType>>
 {
 public:
   /** Standard Self typedef */
   typedef PersistentMinMaxVectorImageFilter Self;
-  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef PersistentReduceImageFilter<TInputImage, VectorMinMaxAccumulator<typename TInputImage::PixelType>> Superclass;
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
@@ -64,7 +143,9 @@ public:
   itkNewMacro(Self);
 
   /** Runtime information support. */
-  itkTypeMacro(PersistentMinMaxVectorImageFilter, PersistentImageFilter);
+  itkTypeMacro(PersistentMinMaxVectorImageFilter, PersistentReduceImageFilter);
+
+  typedef typename Superclass::AccumulatorType AccumulatorType;
 
   /** Image related typedefs. */
   typedef TInputImage                             ImageType;
@@ -146,11 +227,6 @@ public:
   DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx) override;
   using Superclass::MakeOutput;
 
-  /** Pass the input through unmodified. Do this by Grafting in the
-   *  AllocateOutputs method.
-   */
-  void AllocateOutputs() override;
-  void GenerateOutputInformation() override;
   void Synthetize(void) override;
   void Reset(void) override;
 
@@ -160,15 +236,14 @@ protected:
   {
   }
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
-  /** Multi-thread version GenerateData. */
-  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** Accumulate the pixels of region, without computing their index */
+  void AccumulateRegion(const RegionType& region, AccumulatorType& accumulator, itk::ProgressReporter& progress) override;
 
 private:
   PersistentMinMaxVectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  ArrayPixelType    m_ThreadMin;
-  ArrayPixelType    m_ThreadMax;
   bool              m_NoDataFlag;
   InternalPixelType m_NoDataValue;
 
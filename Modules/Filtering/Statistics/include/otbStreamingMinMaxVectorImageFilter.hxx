@@ -23,8 +23,7 @@
 #define otbStreamingMinMaxVectorImageFilter_hxx
 #include "otbStreamingMinMaxVectorImageFilter.h"
 
-#include "itkImageRegionIterator.h"
-#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionConstIterator.h"
 #include "itkNumericTraits.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
@@ -90,132 +89,44 @@ const typename PersistentMinMaxVectorImageFilter<TInputImage>::PixelObjectType*
   return static_cast<const PixelObjectType*>(this->itk::ProcessObject::GetOutput(2));
 }
 
-template <class TInputImage>
-void PersistentMinMaxVectorImageFilter<TInputImage>::GenerateOutputInformation()
-{
-  Superclass::GenerateOutputInformation();
-  if (this->GetInput())
-  {
-    this->GetOutput()->CopyInformation(this->GetInput());
-    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
-
-    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
-    {
-      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
-    }
-  }
-}
-
-template <class TInputImage>
-void PersistentMinMaxVectorImageFilter<TInputImage>::AllocateOutputs()
-{
-  // This is commented to prevent the streaming of the whole image for the first stream strip
-  // It shall not cause any problem because the output image of this filter is not intended to be used.
-  // InputImagePointer image = const_cast< TInputImage * >( this->GetInput() );
-  // this->GraftOutput( image );
-  // Nothing that needs to be allocated for the remaining outputs
-}
-
 template <class TInputImage>
 void PersistentMinMaxVectorImageFilter<TInputImage>::Reset()
 {
   TInputImage* inputPtr = const_cast<TInputImage*>(this->GetInput());
   inputPtr->UpdateOutputInformation();
 
-  unsigned int numberOfThreads   = this->GetNumberOfThreads();
-  unsigned int numberOfComponent = inputPtr->GetNumberOfComponentsPerPixel();
+  AccumulatorType initialAccumulator(inputPtr->GetNumberOfComponentsPerPixel(), m_NoDataFlag, m_NoDataValue);
+  this->SetInitialAccumulator(initialAccumulator);
 
   // Variable Initialization
-  PixelType tempPixel;
-  tempPixel.SetSize(numberOfComponent);
-  tempPixel.Fill(itk::NumericTraits<InternalPixelType>::NonpositiveMin());
-  this->GetMaximumOutput()->Set(tempPixel);
-
-  tempPixel.Fill(itk::NumericTraits<InternalPixelType>::max());
-  this->GetMinimumOutput()->Set(tempPixel);
-
-  PixelType tempTemporiesPixel;
-  tempTemporiesPixel.SetSize(numberOfComponent);
-  tempTemporiesPixel.Fill(itk::NumericTraits<InternalPixelType>::max());
-  m_ThreadMin = ArrayPixelType(numberOfThreads, tempTemporiesPixel);
+  this->GetMaximumOutput()->Set(initialAccumulator.GetMaximum());
+  this->GetMinimumOutput()->Set(initialAccumulator.GetMinimum());
 
-  tempTemporiesPixel.Fill(itk::NumericTraits<InternalPixelType>::NonpositiveMin());
-  m_ThreadMax = ArrayPixelType(numberOfThreads, tempTemporiesPixel);
+  Superclass::Reset();
 }
 
 template <class TInputImage>
 void PersistentMinMaxVectorImageFilter<TInputImage>::Synthetize()
 {
-  int i;
-
-  int          numberOfThreads   = this->GetNumberOfThreads();
-  unsigned int numberOfComponent = this->GetInput()->GetNumberOfComponentsPerPixel();
-
-  PixelType minimumVector;
-  minimumVector.SetSize(numberOfComponent);
-  minimumVector.Fill(itk::NumericTraits<InternalPixelType>::max());
-
-  PixelType maximumVector;
-  maximumVector.SetSize(numberOfComponent);
-  maximumVector.Fill(itk::NumericTraits<InternalPixelType>::NonpositiveMin());
-
-  // Find the min/max over all threads and accumulate count, sum and
-  // sum of squares
-  for (i = 0; i < numberOfThreads; ++i)
-  {
-    for (unsigned int j = 0; j < numberOfComponent; ++j)
-    {
-      if (m_ThreadMin[i][j] < minimumVector[j])
-      {
-        minimumVector[j] = m_ThreadMin[i][j];
-      }
-      if (m_ThreadMax[i][j] > maximumVector[j])
-      {
-        maximumVector[j] = m_ThreadMax[i][j];
-      }
-    }
-  } // end for( i = 0; i < numberOfThreads; ++i)
+  Superclass::Synthetize();
 
   // Set the outputs
-  this->GetMinimumOutput()->Set(minimumVector);
-  this->GetMaximumOutput()->Set(maximumVector);
+  this->GetMinimumOutput()->Set(this->GetResult().GetMinimum());
+  this->GetMaximumOutput()->Set(this->GetResult().GetMaximum());
 }
 
 template <class TInputImage>
-void PersistentMinMaxVectorImageFilter<TInputImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+void PersistentMinMaxVectorImageFilter<TInputImage>::AccumulateRegion(const RegionType& region, AccumulatorType& accumulator, itk::ProgressReporter& progress)
 {
-  /**
-   * Grab the input
-   */
-  InputImagePointer inputPtr = const_cast<TInputImage*>(this->GetInput());
-  // support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
-
-  itk::ImageRegionConstIteratorWithIndex<TInputImage> it(inputPtr, outputRegionForThread);
-  it.GoToBegin();
-
-  // do the work
-  while (!it.IsAtEnd())
+  itk::ImageRegionConstIterator<TInputImage> it(this->GetInput(), region);
+
+  // The index is not needed by the accumulator
+  IndexType unusedIndex;
+  unusedIndex.Fill(0);
+
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
   {
-    // IndexType index = it.GetIndex();
-    PixelType vectorValue = it.Get();
-    for (unsigned int j = 0; j < vectorValue.GetSize(); ++j)
-    {
-      InternalPixelType value = vectorValue[j];
-
-      if ((!m_NoDataFlag) || value != m_NoDataValue)
-      {
-        if (value < m_ThreadMin[threadId][j])
-        {
-          m_ThreadMin[threadId][j] = value;
-        }
-        if (value > m_ThreadMax[threadId][j])
-        {
-          m_ThreadMax[threadId][j] = value;
-        }
-      }
-    }
-    ++it;
+    accumulator.Accumulate(it.Get(), unusedIndex);
     progress.CompletedPixel();
   }
 }
@@ -27,7 +27,9 @@
 #include "itkArray.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "otbPersistentFilterStreamingDecorator.h"
+#include <algorithm>
 #include <unordered_map>
+#include <vector>
 
 namespace otb
 {
@@ -88,14 +90,22 @@ public:
         m_BandCount[band] = 0;
         m_Sum[band]       = itk::NumericTraits<RealValueType>::ZeroValue();
         m_Min[band]       = itk::NumericTraits<RealValueType>::max();
-        m_Max[band]       = itk::NumericTraits<RealValueType>::min();
+        m_Max[band]       = itk::NumericTraits<RealValueType>::NonpositiveMin();
         m_SqSum[band]     = itk::NumericTraits<RealValueType>::ZeroValue();
       }
     }
   }
 
-  // Function update (pixel)
-  void Update(const TRealVectorPixelType& pixel)
+  // Constructor (initialize the accumulator with the given statistics)
+  StatisticsAccumulator(RealValueType noDataValue, bool useNoDataValue, PixelCountType count, const PixelCountVectorType& bandCount,
+                        const TRealVectorPixelType& sum, const TRealVectorPixelType& sqSum, const TRealVectorPixelType& min, const TRealVectorPixelType& max)
+    : m_BandCount(bandCount), m_Sum(sum), m_SqSum(sqSum), m_Min(min), m_Max(max), m_NoDataValue(noDataValue), m_Count(count), m_UseNoDataValue(useNoDataValue)
+  {
+  }
+
+  // Function update (pixel of any vector type, without conversion)
+  template <class TPixel>
+  void Update(const TPixel& pixel)
   {
     m_Count++;
     const unsigned int nBands = pixel.GetSize();
@@ -155,6 +165,158 @@ protected:
   bool                 m_UseNoDataValue;
 };
 
+/** \class DenseStatisticsAccumulator
+ * \brief Holds the statistics of the labels 0 to N-1 of a label image
+ *
+ * Computes the same statistics as StatisticsAccumulator, for a range of
+ * labels starting at 0. Each statistic is stored in a single array, the
+ * bands of a label being contiguous, so that updating a label does not
+ * need any lookup nor allocation.
+ *
+ * \sa StatisticsAccumulator
+ *
+ * \ingroup OTBStatistics
+ */
+template <class TRealVectorPixelType>
+class DenseStatisticsAccumulator
+{
+public:
+  typedef typename TRealVectorPixelType::ValueType       RealValueType;
+  typedef StatisticsAccumulator<TRealVectorPixelType>    AccumulatorType;
+  typedef typename AccumulatorType::PixelCountType       PixelCountType;
+  typedef typename AccumulatorType::PixelCountVectorType PixelCountVectorType;
+
+  DenseStatisticsAccumulator(unsigned int nbBands = 0, RealValueType noDataValue = RealValueType(), bool useNoDataValue = false)
+    : m_NumberOfBands(nbBands), m_NoDataValue(noDataValue), m_UseNoDataValue(useNoDataValue), m_NumberOfPresentLabels(0)
+  {
+  }
+
+  /** Number of labels of the range */
+  std::size_t GetNumberOfLabels() const
+  {
+    return m_Count.size();
+  }
+
+  /** Number of labels of the range met at least once */
+  std::size_t GetNumberOfPresentLabels() const
+  {
+    return m_NumberOfPresentLabels;
+  }
+
+  unsigned int GetNumberOfBands() const
+  {
+    return m_NumberOfBands;
+  }
+
+  /** Extend the range of labels (it is never shrunk) */
+  void Resize(std::size_t nbLabels)
+  {
+    if (nbLabels <= m_Count.size())
+    {
+      return;
+    }
+    const std::size_t size = nbLabels * m_NumberOfBands;
+    m_Count.resize(nbLabels, 0);
+    m_BandCount.resize(size, 0);
+    m_Sum.resize(size, itk::NumericTraits<RealValueType>::ZeroValue());
+    m_SqSum.resize(size, itk::NumericTraits<RealValueType>::ZeroValue());
+    m_Min.resize(size, itk::NumericTraits<RealValueType>::max());
+    m_Max.resize(size, itk::NumericTraits<RealValueType>::NonpositiveMin());
+  }
+
+  /** Update a label of the range with a pixel */
+  template <class TPixel>
+  void Update(std::size_t label, const TPixel& pixel)
+  {
+    if (m_Count[label]++ == 0)
+    {
+      ++m_NumberOfPresentLabels;
+    }
+
+    const std::size_t offset    = label * m_NumberOfBands;
+    PixelCountType*   bandCount = &m_BandCount[offset];
+    RealValueType*    sum       = &m_Sum[offset];
+    RealValueType*    sqSum     = &m_SqSum[offset];
+    RealValueType*    min       = &m_Min[offset];
+    RealValueType*    max       = &m_Max[offset];
+    for (unsigned int band = 0; band < m_NumberOfBands; ++band)
+    {
+      const RealValueType value = pixel[band];
+      if (m_UseNoDataValue && value == m_NoDataValue)
+      {
+        continue;
+      }
+      ++bandCount[band];
+      sum[band] += value;
+      sqSum[band] += value * value;
+      min[band] = std::min(min[band], value);
+      max[band] = std::max(max[band], value);
+    }
+  }
+
+  /** Merge the statistics of another range */
+  void Update(const DenseStatisticsAccumulator& other)
+  {
+    Resize(other.GetNumberOfLabels());
+    for (std::size_t label = 0; label < other.m_Count.size(); ++label)
+    {
+      if (other.m_Count[label] == 0)
+      {
+        continue;
+      }
+      if (m_Count[label] == 0)
+      {
+        ++m_NumberOfPresentLabels;
+      }
+      m_Count[label] += other.m_Count[label];
+    }
+    for (std::size_t i = 0; i < other.m_Sum.size(); ++i)
+    {
+      m_BandCount[i] += other.m_BandCount[i];
+      m_Sum[i] += other.m_Sum[i];
+      m_SqSum[i] += other.m_SqSum[i];
+      m_Min[i] = std::min(m_Min[i], other.m_Min[i]);
+      m_Max[i] = std::max(m_Max[i], other.m_Max[i]);
+    }
+  }
+
+  /** Number of pixels of a label */
+  PixelCountType GetCount(std::size_t label) const
+  {
+    return m_Count[label];
+  }
+
+  /** Statistics of a label */
+  AccumulatorType GetAccumulator(std::size_t label) const
+  {
+    const std::size_t    offset = label * m_NumberOfBands;
+    PixelCountVectorType bandCount(m_NumberOfBands);
+    TRealVectorPixelType sum(m_NumberOfBands), sqSum(m_NumberOfBands), min(m_NumberOfBands), max(m_NumberOfBands);
+    for (unsigned int band = 0; band < m_NumberOfBands; ++band)
+    {
+      bandCount[band] = m_BandCount[offset + band];
+      sum[band]       = m_Sum[offset + band];
+      sqSum[band]     = m_SqSum[offset + band];
+      min[band]       = m_Min[offset + band];
+      max[band]       = m_Max[offset + band];
+    }
+    return AccumulatorType(m_NoDataValue, m_UseNoDataValue, m_Count[label], bandCount, sum, sqSum, min, max);
+  }
+
+private:
+  unsigned int  m_NumberOfBands;
+  RealValueType m_NoDataValue;
+  bool          m_UseNoDataValue;
+  std::size_t   m_NumberOfPresentLabels;
+
+  std::vector<PixelCountType> m_Count;
+  std::vector<PixelCountType> m_BandCount;
+  std::vector<RealValueType>  m_Sum;
+  std::vector<RealValueType>  m_SqSum;
+  std::vector<RealValueType>  m_Min;
+  std::vector<RealValueType>  m_Max;
+};
+
 /** \class PersistentStreamingStatisticsMapFromLabelImageFilter
  * \brief Computes mean radiometric value for each label of a label image, based on a support VectorImage
  *
@@ -165,6 +327,10 @@ protected:
  *
  * To get the statistics once the regions have been processed via the pipeline, use the Synthetize() method.
  *
+ * Non-negative integer labels are accumulated in a DenseStatisticsAccumulator
+ * per thread, which grows as long as it covers at most four times as many
+ * labels as met so far (at least 1024), as with the consecutive labels of
+ * a rasterization. The other labels are accumulated in a hash map.
  *
  * \sa StreamingStatisticsMapFromLabelImageFilter
  * \ingroup Streamed
@@ -203,6 +369,8 @@ public:
   typedef StatisticsAccumulator<RealVectorPixelType>              AccumulatorType;
   typedef std::unordered_map<LabelPixelType, AccumulatorType>     AccumulatorMapType;
   typedef std::vector<AccumulatorMapType>                         AccumulatorMapCollectionType;
+  typedef DenseStatisticsAccumulator<RealVectorPixelType>         DenseAccumulatorType;
+  typedef std::vector<DenseAccumulatorType>                       DenseAccumulatorCollectionType;
   typedef std::unordered_map<LabelPixelType, RealVectorPixelType> PixelValueMapType;
   typedef std::unordered_map<LabelPixelType, double>              LabelPopulationMapType;
 
@@ -276,6 +444,10 @@ protected:
 
   void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Whether a label goes to the dense accumulator, which is extended if
+   * needed */
+  bool AccumulateAsDenseLabel(LabelPixelType label, DenseAccumulatorType& dense, std::size_t nbHashedLabels) const;
+
 private:
   PersistentStreamingStatisticsMapFromLabelImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
@@ -283,7 +455,8 @@ private:
   VectorPixelValueType m_NoDataValue;
   bool                 m_UseNoDataValue;
 
-  AccumulatorMapCollectionType m_AccumulatorMaps;
+  AccumulatorMapCollectionType   m_AccumulatorMaps;
+  DenseAccumulatorCollectionType m_DenseAccumulators;
 
   PixelValueMapType m_MeanRadiometricValue;
   PixelValueMapType m_StDevRadiometricValue;
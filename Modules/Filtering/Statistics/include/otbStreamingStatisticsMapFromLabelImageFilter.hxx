@@ -27,7 +27,9 @@
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
+#include <algorithm>
 #include <cmath>
+#include <limits>
 #include <utility>
 
 namespace otb
@@ -136,7 +138,6 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
 {
   // Update temporary accumulator
   AccumulatorMapType outputAcc;
-  auto               endAcc = outputAcc.end();
 
   for (auto const& threadAccMap : m_AccumulatorMaps)
   {
@@ -144,7 +145,7 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
     {
       auto label = it.first;
       auto itAcc = outputAcc.find(label);
-      if (itAcc == endAcc)
+      if (itAcc == outputAcc.end())
       {
         outputAcc.emplace(label, it.second);
       }
@@ -155,6 +156,42 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
     }
   }
 
+  // Merge the dense labels of the threads, then with the hashed ones
+  DenseAccumulatorType denseAcc;
+  for (auto const& threadDenseAcc : m_DenseAccumulators)
+  {
+    if (threadDenseAcc.GetNumberOfLabels() == 0)
+    {
+      continue;
+    }
+    if (denseAcc.GetNumberOfLabels() == 0)
+    {
+      denseAcc = threadDenseAcc;
+    }
+    else
+    {
+      denseAcc.Update(threadDenseAcc);
+    }
+  }
+
+  for (std::size_t index = 0; index < denseAcc.GetNumberOfLabels(); ++index)
+  {
+    if (denseAcc.GetCount(index) == 0)
+    {
+      continue;
+    }
+    const LabelPixelType label = static_cast<LabelPixelType>(index);
+    auto                 itAcc = outputAcc.find(label);
+    if (itAcc == outputAcc.end())
+    {
+      outputAcc.emplace(label, denseAcc.GetAccumulator(index));
+    }
+    else
+    {
+      itAcc->second.Update(denseAcc.GetAccumulator(index));
+    }
+  }
+
   // Publish output maps
   for (auto& it : outputAcc)
   {
@@ -202,6 +239,7 @@ template <class TInputVectorImage, class TLabelImage>
 void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::Reset()
 {
   m_AccumulatorMaps.clear();
+  m_DenseAccumulators.clear();
 
   m_MeanRadiometricValue.clear();
   m_StDevRadiometricValue.clear();
@@ -209,6 +247,7 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
   m_MaxRadiometricValue.clear();
   m_LabelPopulation.clear();
   m_AccumulatorMaps.resize(this->GetNumberOfThreads());
+  m_DenseAccumulators.resize(this->GetNumberOfThreads());
 }
 
 template <class TInputVectorImage, class TLabelImage>
@@ -253,8 +292,14 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
   itk::ImageRegionConstIterator<TLabelImage>       labelIt(labelInputPtr, outputRegionForThread);
   itk::ProgressReporter                            progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
-  auto& acc    = m_AccumulatorMaps[threadId];
-  auto  endAcc = acc.end();
+  auto& acc      = m_AccumulatorMaps[threadId];
+  auto& denseAcc = m_DenseAccumulators[threadId];
+
+  const unsigned int nbBands = inputPtr->GetNumberOfComponentsPerPixel();
+  if (denseAcc.GetNumberOfBands() != nbBands)
+  {
+    denseAcc = DenseAccumulatorType(nbBands, this->GetNoDataValue(), this->GetUseNoDataValue());
+  }
 
   // do the work
   for (inIt.GoToBegin(), labelIt.GoToBegin(); !inIt.IsAtEnd() && !labelIt.IsAtEnd(); ++inIt, ++labelIt)
@@ -263,8 +308,15 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
     auto        label = labelIt.Get();
 
     // Update the accumulator
+    if (AccumulateAsDenseLabel(label, denseAcc, acc.size()))
+    {
+      denseAcc.Update(static_cast<std::size_t>(label), value);
+      progress.CompletedPixel();
+      continue;
+    }
+
     auto itAcc = acc.find(label);
-    if (itAcc == endAcc)
+    if (itAcc == acc.end())
     {
       acc.emplace(label, AccumulatorType(this->GetNoDataValue(), this->GetUseNoDataValue(), value));
     }
@@ -277,6 +329,34 @@ void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLa
   }
 }
 
+template <class TInputVectorImage, class TLabelImage>
+bool PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::AccumulateAsDenseLabel(LabelPixelType        label,
+                                                                                                                  DenseAccumulatorType& dense,
+                                                                                                                  std::size_t nbHashedLabels) const
+{
+  if (!std::numeric_limits<LabelPixelType>::is_integer || itk::NumericTraits<LabelPixelType>::IsNegative(label))
+  {
+    return false;
+  }
+
+  const std::size_t index = static_cast<std::size_t>(label);
+  if (index < dense.GetNumberOfLabels())
+  {
+    return true;
+  }
+
+  // The range stays at most 4 times larger than the number of labels met,
+  // so that sparse labels (e.g. random identifiers) go to the hash map
+  const std::size_t maxNbLabels = std::max<std::size_t>(1024, 4 * (dense.GetNumberOfPresentLabels() + nbHashedLabels + 1));
+  if (index >= maxNbLabels)
+  {
+    return false;
+  }
+
+  dense.Resize(std::min(maxNbLabels, std::max(index + 1, 2 * dense.GetNumberOfLabels())));
+  return true;
+}
+
 template <class TInputVectorImage, class TLabelImage>
 void PersistentStreamingStatisticsMapFromLabelImageFilter<TInputVectorImage, TLabelImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
@@ -28,6 +28,7 @@
 #include "itkArray.h"
 #include "itkSimpleDataObjectDecorator.h"
 #include "itkImageRegionConstIteratorWithOnlyIndex.h"
+#include <unordered_map>
 
 namespace otb
 {
@@ -159,119 +160,140 @@ protected:
   {
   }
 
+  /** Identifier of the overlap ij (i * number of images + j) */
+  typedef unsigned long long SampleIdType;
+
   /** Class for storing thread results:
    * -sum of values
    * -sum of squared values
    * -min value
    * -max value
    * -count
+   *
+   * Only the overlaps which are actually met are stored: each one gets a
+   * slot, where its values for all bands are kept.
    */
   class ThreadResultsContainer
   {
   public:
     /** Default constructor */
-    ThreadResultsContainer()
+    ThreadResultsContainer() : m_nbOfBands(0)
     {
     }
 
     /* Constructor with size */
-    ThreadResultsContainer(unsigned int nbOfBands, unsigned int nbOfSamples)
+    ThreadResultsContainer(unsigned int nbOfBands)
     {
-      Clear(nbOfBands, nbOfSamples);
+      Clear(nbOfBands);
     }
 
-    /* Copy constructor */
-    ThreadResultsContainer(const ThreadResultsContainer& other)
+    /* Clear routine: set the number of bands and remove all samples */
+    void Clear(unsigned int nbOfBands)
     {
-      m_count = RealVectorType(other.m_count);
-      m_sum   = RealMatrixType(other.m_sum);
-      m_cosum = RealMatrixType(other.m_cosum);
-      m_sqSum = RealMatrixType(other.m_sqSum);
-      m_min   = RealMatrixType(other.m_min);
-      m_max   = RealMatrixType(other.m_max);
+      m_nbOfBands = nbOfBands;
+      m_slots.clear();
+      m_count.clear();
+      m_sum.clear();
+      m_cosum.clear();
+      m_sqSum.clear();
+      m_min.clear();
+      m_max.clear();
     }
 
-    /* Clear routine: Resize at the specified dimension and clear values */
-    void Clear(unsigned int nbOfBands, unsigned int nbOfSamples)
+    /* Slot of a sample, created if needed */
+    unsigned int GetSlot(SampleIdType sampleId)
     {
+      auto it = m_slots.find(sampleId);
+      if (it != m_slots.end())
+      {
+        return it->second;
+      }
+
       const InternalValueType zeroValue = itk::NumericTraits<InternalValueType>::Zero;
       const InternalValueType supValue  = itk::NumericTraits<InternalValueType>::max();
       const InternalValueType infValue  = itk::NumericTraits<InternalValueType>::NonpositiveMin();
 
-      m_count = RealVectorType(nbOfSamples, 0);
-      m_sum   = RealMatrixType(nbOfBands, nbOfSamples, zeroValue);
-      m_cosum = RealMatrixType(nbOfBands, nbOfSamples, zeroValue);
-      m_sqSum = RealMatrixType(nbOfBands, nbOfSamples, zeroValue);
-      m_min   = RealMatrixType(nbOfBands, nbOfSamples, supValue);
-      m_max   = RealMatrixType(nbOfBands, nbOfSamples, infValue);
+      const unsigned int slot = m_count.size();
+      m_slots[sampleId]       = slot;
+      m_count.push_back(0);
+      m_sum.resize(m_sum.size() + m_nbOfBands, zeroValue);
+      m_cosum.resize(m_cosum.size() + m_nbOfBands, zeroValue);
+      m_sqSum.resize(m_sqSum.size() + m_nbOfBands, zeroValue);
+      m_min.resize(m_min.size() + m_nbOfBands, supValue);
+      m_max.resize(m_max.size() + m_nbOfBands, infValue);
+      return slot;
     }
 
     /* 1-Pixel update */
-    void Update(const InputImagePixelType& pixel, unsigned int sampleId)
+    void Update(const InputImagePixelType& pixel, unsigned int slot)
     {
       unsigned int nbOfBands = pixel.Size();
 
-      m_count[sampleId]++;
+      m_count[slot]++;
+      const unsigned int offset = slot * m_nbOfBands;
       for (unsigned int band = 0; band < nbOfBands; band++)
       {
         // Cast
         InternalValueType pixelValue = static_cast<InternalValueType>(pixel[band]);
 
         // Update Min & max
-        if (pixelValue < m_min[band][sampleId])
-          m_min[band][sampleId] = pixelValue;
-        if (pixelValue > m_max[band][sampleId])
-          m_max[band][sampleId] = pixelValue;
+        if (pixelValue < m_min[offset + band])
+          m_min[offset + band] = pixelValue;
+        if (pixelValue > m_max[offset + band])
+          m_max[offset + band] = pixelValue;
 
         // Update Sums
-        m_sum[band][sampleId] += pixelValue;
-        m_sqSum[band][sampleId] += pixelValue * pixelValue;
+        m_sum[offset + band] += pixelValue;
+        m_sqSum[offset + band] += pixelValue * pixelValue;
       }
     }
 
     /* 2-Pixels update */
-    void Update(const InputImagePixelType& pixel_i, const InputImagePixelType& pixel_j, unsigned int sampleId)
+    void Update(const InputImagePixelType& pixel_i, const InputImagePixelType& pixel_j, unsigned int slot)
     {
-      Update(pixel_i, sampleId);
-      unsigned int nbOfBands = pixel_i.Size();
+      Update(pixel_i, slot);
+      unsigned int       nbOfBands = pixel_i.Size();
+      const unsigned int offset    = slot * m_nbOfBands;
       for (unsigned int band = 0; band < nbOfBands; band++)
       {
         // Cast
         InternalValueType pixelValue_i = static_cast<InternalValueType>(pixel_i[band]);
         InternalValueType pixelValue_j = static_cast<InternalValueType>(pixel_j[band]);
 
-        m_cosum[band][sampleId] += pixelValue_i * pixelValue_j;
+        m_cosum[offset + band] += pixelValue_i * pixelValue_j;
       }
     }
 
     /* Self update */
     void Update(const ThreadResultsContainer& other)
     {
-      unsigned int nbOfBands   = other.m_sum.rows();
-      unsigned int nbOfSamples = other.m_sum.cols();
-
-      for (unsigned int sampleId = 0; sampleId < nbOfSamples; sampleId++)
+      for (const auto& sample : other.m_slots)
       {
-        m_count[sampleId] += other.m_count[sampleId];
-        for (unsigned int band = 0; band < nbOfBands; band++)
+        const unsigned int slot        = GetSlot(sample.first);
+        const unsigned int offset      = slot * m_nbOfBands;
+        const unsigned int otherOffset = sample.second * m_nbOfBands;
+        m_count[slot] += other.m_count[sample.second];
+        for (unsigned int band = 0; band < m_nbOfBands; band++)
         {
-          m_sum[band][sampleId] += other.m_sum[band][sampleId];
-          m_cosum[band][sampleId] += other.m_cosum[band][sampleId];
-          m_sqSum[band][sampleId] += other.m_sqSum[band][sampleId];
-          if (other.m_min[band][sampleId] < m_min[band][sampleId])
-            m_min[band][sampleId] = other.m_min[band][sampleId];
-          if (other.m_max[band][sampleId] > m_max[band][sampleId])
-            m_max[band][sampleId] = other.m_max[band][sampleId];
+          m_sum[offset + band] += other.m_sum[otherOffset + band];
+          m_cosum[offset + band] += other.m_cosum[otherOffset + band];
+          m_sqSum[offset + band] += other.m_sqSum[otherOffset + band];
+          if (other.m_min[otherOffset + band] < m_min[offset + band])
+            m_min[offset + band] = other.m_min[otherOffset + band];
+          if (other.m_max[otherOffset + band] > m_max[offset + band])
+            m_max[offset + band] = other.m_max[otherOffset + band];
         }
       }
     }
 
-    RealMatrixType m_sum;
-    RealMatrixType m_sqSum;
-    RealMatrixType m_cosum;
-    RealMatrixType m_min;
-    RealMatrixType m_max;
-    RealVectorType m_count;
+    unsigned int                                   m_nbOfBands;
+    std::unordered_map<SampleIdType, unsigned int> m_slots;
+    std::vector<InternalValueType>                 m_sum;
+    std::vector<InternalValueType>                 m_sqSum;
+    std::vector<InternalValueType>                 m_cosum;
+    std::vector<InternalValueType>                 m_min;
+    std::vector<InternalValueType>                 m_max;
+    std::vector<InternalValueType>                 m_count;
   };
 
   // Internal threads count
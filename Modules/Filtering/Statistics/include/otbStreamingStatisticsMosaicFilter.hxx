@@ -176,8 +176,7 @@ void PersistentStatisticsMosaicFilter<TInputImage, TOutputImage, TInternalValueT
   for (unsigned int threadId = 0; threadId < numberOfThreads; threadId++)
   {
     // Create a clean empty container for each thread
-    ThreadResultsContainer threadResult(nBands, nbImages * nbImages);
-    m_InternalThreadResults.push_back(threadResult);
+    m_InternalThreadResults.push_back(ThreadResultsContainer(nBands));
   }
 }
 
@@ -204,7 +203,7 @@ void PersistentStatisticsMosaicFilter<TInputImage, TOutputImage, TInternalValueT
   const unsigned int nbImages = this->GetNumberOfInputImages();
 
   // Merge threads result
-  ThreadResultsContainer finalResults = ThreadResultsContainer(nBands, nbImages * nbImages);
+  ThreadResultsContainer finalResults(nBands);
   for (const auto& res : m_InternalThreadResults)
   {
     finalResults.Update(res);
@@ -220,55 +219,54 @@ void PersistentStatisticsMosaicFilter<TInputImage, TOutputImage, TInternalValueT
 
   for (unsigned int band = 0; band < nBands; band++)
   {
-    RealMatrixType mean(nbImages, nbImages, 0);
-    RealMatrixType prodmean(nbImages, nbImages, 0);
-    RealMatrixType stdev(nbImages, nbImages, 0);
-    RealMatrixType min(nbImages, nbImages, itk::NumericTraits<InputImageInternalPixelType>::max());
-    RealMatrixType max(nbImages, nbImages, itk::NumericTraits<InputImageInternalPixelType>::NonpositiveMin());
+    m_Means.push_back(RealMatrixType(nbImages, nbImages, 0));
+    m_ProdMeans.push_back(RealMatrixType(nbImages, nbImages, 0));
+    m_Stds.push_back(RealMatrixType(nbImages, nbImages, 0));
+    m_Mins.push_back(RealMatrixType(nbImages, nbImages, itk::NumericTraits<InputImageInternalPixelType>::max()));
+    m_Maxs.push_back(RealMatrixType(nbImages, nbImages, itk::NumericTraits<InputImageInternalPixelType>::NonpositiveMin()));
+  }
 
-    for (unsigned int i = 0; i < nbImages; i++)
-    {
-      for (unsigned int j = 0; j < nbImages; j++)
-      {
+  // Only the overlaps that have been met are updated
+  for (const auto& sample : finalResults.m_slots)
+  {
+    const unsigned int i      = sample.first / nbImages;
+    const unsigned int j      = sample.first % nbImages;
+    const unsigned int offset = sample.second * nBands;
 
-        const InternalValueType count  = finalResults.m_count[i * nbImages + j];
-        const InternalValueType sum    = finalResults.m_sum[band][i * nbImages + j];
-        const InternalValueType cosum  = finalResults.m_cosum[band][i * nbImages + j];
-        const InternalValueType sqSum  = finalResults.m_sqSum[band][i * nbImages + j];
-        const InternalValueType minVal = finalResults.m_min[band][i * nbImages + j];
-        const InternalValueType maxVal = finalResults.m_max[band][i * nbImages + j];
+    const InternalValueType count = finalResults.m_count[sample.second];
 
-        // Update area
-        m_Area[i][j] = count;
+    // Update area
+    m_Area[i][j] = count;
 
-        // Update Min and Max
-        if (minVal < min[i][j])
-          min[i][j] = minVal;
-        if (maxVal > max[i][j])
-          max[i][j] = maxVal;
+    for (unsigned int band = 0; band < nBands; band++)
+    {
+      const InternalValueType sum    = finalResults.m_sum[offset + band];
+      const InternalValueType cosum  = finalResults.m_cosum[offset + band];
+      const InternalValueType sqSum  = finalResults.m_sqSum[offset + band];
+      const InternalValueType minVal = finalResults.m_min[offset + band];
+      const InternalValueType maxVal = finalResults.m_max[offset + band];
+
+      // Update Min and Max
+      if (minVal < m_Mins[band][i][j])
+        m_Mins[band][i][j] = minVal;
+      if (maxVal > m_Maxs[band][i][j])
+        m_Maxs[band][i][j] = maxVal;
+
+      // Update Mean, Std and Mean of products
+      if (count > 0)
+      {
+        m_Means[band][i][j]     = sum / (static_cast<InternalValueType>(count));
+        m_ProdMeans[band][i][j] = cosum / (static_cast<InternalValueType>(count));
 
-        // Update Mean, Std and Mean of products
-        if (count > 0)
+        // Unbiased estimate
+        InternalValueType variance = (sqSum - (sum * sum / static_cast<InternalValueType>(count))) / (static_cast<InternalValueType>(count) - 1);
+        if (variance > 0)
         {
-          mean[i][j]     = sum / (static_cast<InternalValueType>(count));
-          prodmean[i][j] = cosum / (static_cast<InternalValueType>(count));
-
-          // Unbiased estimate
-          InternalValueType variance = (sqSum - (sum * sum / static_cast<InternalValueType>(count))) / (static_cast<InternalValueType>(count) - 1);
-          if (variance > 0)
-          {
-            stdev[i][j] = vcl_sqrt(variance);
-          }
+          m_Stds[band][i][j] = vcl_sqrt(variance);
         }
       }
     }
-    m_Means.push_back(mean);
-    m_Stds.push_back(stdev);
-    m_ProdMeans.push_back(prodmean);
-    m_Mins.push_back(min);
-    m_Maxs.push_back(max);
-
-  } // next band
+  }
 
   this->GetMeansOutput()->Set(m_Means);
   this->GetStdsOutput()->Set(m_Stds);
@@ -295,9 +293,6 @@ void PersistentStatisticsMosaicFilter<TInputImage, TOutputImage, TInternalValueT
   // Get number of input images
   const unsigned int nbOfInputImages = this->GetNumberOfInputImages();
 
-  // Get number of used inputs
-  const unsigned int nbOfUsedInputImages = Superclass::GetNumberOfUsedInputImages();
-
   // Iterate through the thread region
   IteratorType outputIt(this->GetOutput(), outputRegionForThread);
 
@@ -306,8 +301,22 @@ void PersistentStatisticsMosaicFilter<TInputImage, TOutputImage, TInternalValueT
   typename std::vector<InterpolatorPointerType> interp;
   Superclass::PrepareImageAccessors(currentImage, interp);
 
+  // Used input images intersecting the thread region
+  typename Superclass::IndicesListType threadImages;
+  Superclass::GetUsedInputImagesInRegion(outputRegionForThread, threadImages);
+
   // temporary variables
-  OutputImagePointType geoPoint;
+  OutputImagePointType    geoPoint;
+  ThreadResultsContainer& threadResult = m_InternalThreadResults.at(threadId);
+
+  // Overlap descriptor for the current pixel (yes/no + value)
+  std::vector<unsigned int>        overlapImagesIndices;
+  std::vector<InputImagePixelType> overlapPixelValue;
+
+  // Slots of the overlaps ij of the previous pixel: neighboring pixels
+  // mostly share the same overlapping images
+  std::vector<unsigned int> previousImagesIndices;
+  std::vector<unsigned int> overlapSlots;
 
   for (outputIt.GoToBegin(); !outputIt.IsAtEnd(); ++outputIt)
   {
@@ -315,15 +324,14 @@ void PersistentStatisticsMosaicFilter<TInputImage, TOutputImage, TInternalValueT
     // Update progress
     progress.CompletedPixel();
 
-    // Overlap descriptor for the current pixel (yes/no + value)
-    std::vector<unsigned int>        overlapImagesIndices;
-    std::vector<InputImagePixelType> overlapPixelValue;
+    overlapImagesIndices.clear();
+    overlapPixelValue.clear();
 
     // Current pixel --> Geographical point
     this->GetOutput()->TransformIndexToPhysicalPoint(outputIt.GetIndex(), geoPoint);
 
     // Loop on used input images
-    for (unsigned int i = 0; i < nbOfUsedInputImages; i++)
+    for (unsigned int i : threadImages)
     {
 
       // Check if the point is inside the transformed thread region
@@ -350,27 +358,36 @@ void PersistentStatisticsMosaicFilter<TInputImage, TOutputImage, TInternalValueT
     // Nb of overlaps at the current pixel
     unsigned int nbOfOverlappingPixels = overlapImagesIndices.size();
 
+    // Slots of the overlaps ij
+    if (overlapImagesIndices != previousImagesIndices)
+    {
+      overlapSlots.resize(nbOfOverlappingPixels * nbOfOverlappingPixels);
+      for (unsigned int i = 0; i < nbOfOverlappingPixels; i++)
+      {
+        for (unsigned int j = 0; j < nbOfOverlappingPixels; j++)
+        {
+          const SampleIdType sampleId = static_cast<SampleIdType>(overlapImagesIndices[i]) * nbOfInputImages + overlapImagesIndices[j];
+          overlapSlots[i * nbOfOverlappingPixels + j] = threadResult.GetSlot(sampleId);
+        }
+      }
+      previousImagesIndices = overlapImagesIndices;
+    }
+
     // Loop on overlapping pixels
     for (unsigned int i = 0; i < nbOfOverlappingPixels; i++)
     {
-      // Index of the image whose comes the current overlapping pixel
-      unsigned int imageIndex = overlapImagesIndices.at(i);
-
       // We need to sum this pixel to all overlaps ij
-      InputImagePixelType pixel = overlapPixelValue.at(i);
+      const InputImagePixelType& pixel = overlapPixelValue[i];
 
       for (unsigned int j = 0; j < nbOfOverlappingPixels; j++)
       {
         //				if (i!=j)
         {
-          // Index of the other image which share this overlapping pixel
-          unsigned int otherImageIndex = overlapImagesIndices.at(j);
-
           // Pixel value of the other image which share this overlapping pixel
-          InputImagePixelType otherPixel = overlapPixelValue.at(j);
+          const InputImagePixelType& otherPixel = overlapPixelValue[j];
 
-          // Update
-          m_InternalThreadResults.at(threadId).Update(pixel, otherPixel, imageIndex * nbOfInputImages + otherImageIndex);
+          // Update the overlap of this image and the other image
+          threadResult.Update(pixel, otherPixel, overlapSlots[i * nbOfOverlappingPixels + j]);
         }
       }
     } // loop on overlapping pixels
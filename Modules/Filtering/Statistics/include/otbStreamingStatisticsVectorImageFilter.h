@@ -191,6 +191,12 @@ public:
 
   void Synthetize(void) override;
 
+  /** The accumulators are reduced over the processes sharing the streaming */
+  bool SupportsDistributedStreaming() const override
+  {
+    return true;
+  }
+
   itkSetMacro(EnableMinMax, bool);
   itkGetMacro(EnableMinMax, bool);
 
@@ -231,10 +237,19 @@ protected:
   /** Multi-thread version GenerateData. */
   void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Add the outer products of a panel of nbPixels pixels (stored pixel
+   * after pixel) to the upper triangle of the second order accumulator.
+   * The lower triangle is filled in Synthetize(). */
+  static void AccumulateSecondOrderPanel(const PrecisionType* panel, unsigned int nbPixels, unsigned int nbComponents, MatrixType& accumulator);
+
 private:
   PersistentStreamingStatisticsVectorImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Number of pixels gathered before updating the second order
+   * accumulator */
+  static const unsigned int SecondOrderPanelSize = 64;
+
   bool m_EnableMinMax;
   bool m_EnableFirstOrderStats;
   bool m_EnableSecondOrderStats;
@@ -26,6 +26,7 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkProgressReporter.h"
 #include "otbMacro.h"
+#include "otbNUMAPolicy.h"
 
 namespace otb
 {
@@ -401,6 +402,31 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Sy
     ignoredUserPixelCount += m_IgnoredUserPixelCount[threadId];
   }
 
+  // Reduce the accumulators of the processes which streamed the other splits
+  if (ProcessGroup* group = this->GetProcessGroup())
+  {
+    if (m_EnableMinMax)
+    {
+      group->AllReduceMin(minimum.GetDataPointer(), minimum.GetDataPointer() + numberOfComponent);
+      group->AllReduceMax(maximum.GetDataPointer(), maximum.GetDataPointer() + numberOfComponent);
+    }
+    if (m_EnableFirstOrderStats)
+    {
+      group->AllReduceSum(streamFirstOrderAccumulator.GetDataPointer(), streamFirstOrderAccumulator.GetDataPointer() + numberOfComponent);
+      group->AllReduceSum(&streamFirstOrderComponentAccumulator, &streamFirstOrderComponentAccumulator + 1);
+    }
+    if (m_EnableSecondOrderStats)
+    {
+      PrecisionType* secondOrder = streamSecondOrderAccumulator.GetVnlMatrix().data_block();
+      group->AllReduceSum(secondOrder, secondOrder + numberOfComponent * numberOfComponent);
+      group->AllReduceSum(&streamSecondOrderComponentAccumulator, &streamSecondOrderComponentAccumulator + 1);
+    }
+    unsigned int ignoredPixelCounts[2] = {ignoredInfinitePixelCount, ignoredUserPixelCount};
+    group->AllReduceSum(ignoredPixelCounts, ignoredPixelCounts + 2);
+    ignoredInfinitePixelCount = ignoredPixelCounts[0];
+    ignoredUserPixelCount     = ignoredPixelCounts[1];
+  }
+
   // There cannot be more ignored pixels than read pixels.
   assert(nbPixels >= ignoredInfinitePixelCount + ignoredUserPixelCount);
   if (nbPixels < ignoredInfinitePixelCount + ignoredUserPixelCount)
@@ -410,6 +436,18 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Sy
 
   unsigned int nbRelevantPixel = nbPixels - (ignoredInfinitePixelCount + ignoredUserPixelCount);
 
+  // Only the upper triangle of the second order accumulators is computed
+  if (m_EnableSecondOrderStats)
+  {
+    for (unsigned int r = 1; r < numberOfComponent; ++r)
+    {
+      for (unsigned int c = 0; c < r; ++c)
+      {
+        streamSecondOrderAccumulator(r, c) = streamSecondOrderAccumulator(c, r);
+      }
+    }
+  }
+
   CountType nbRelevantPixels(numberOfComponent);
   nbRelevantPixels.Fill(nbRelevantPixel);
 
@@ -475,6 +513,8 @@ template <class TInputImage, class TPrecision>
 void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::ThreadedGenerateData(const RegionType& outputRegionForThread,
                                                                                                    itk::ThreadIdType threadId)
 {
+  NUMAPolicy::PinCurrentThread(threadId, this->GetNumberOfThreads());
+
   // Support progress methods/callbacks
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
@@ -483,6 +523,16 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Th
   PixelType&        threadMin = m_ThreadMin[threadId];
   PixelType&        threadMax = m_ThreadMax[threadId];
 
+  // Relevant pixels are gathered in a panel before being added to the
+  // second order accumulator, which is much faster than one outer
+  // product per pixel
+  const unsigned int         nbComponents = inputPtr->GetNumberOfComponentsPerPixel();
+  std::vector<PrecisionType> panel;
+  unsigned int               panelPixels = 0;
+  if (m_EnableSecondOrderStats)
+  {
+    panel.resize(SecondOrderPanelSize * nbComponents);
+  }
 
   itk::ImageRegionConstIteratorWithIndex<TInputImage> it(inputPtr, outputRegionForThread);
 
@@ -540,21 +590,51 @@ void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::Th
 
         if (m_EnableSecondOrderStats)
         {
-          MatrixType& threadSecondOrder          = m_ThreadSecondOrderAccumulators[threadId];
-          RealType&   threadSecondOrderComponent = m_ThreadSecondOrderComponentAccumulators[threadId];
+          RealType& threadSecondOrderComponent = m_ThreadSecondOrderComponentAccumulators[threadId];
 
-          for (unsigned int r = 0; r < threadSecondOrder.Rows(); ++r)
+          PrecisionType* panelPixel = &panel[panelPixels * nbComponents];
+          for (unsigned int j = 0; j < nbComponents; ++j)
           {
-            for (unsigned int c = 0; c < threadSecondOrder.Cols(); ++c)
-            {
-              threadSecondOrder(r, c) += static_cast<PrecisionType>(vectorValue[r]) * static_cast<PrecisionType>(vectorValue[c]);
-            }
+            panelPixel[j] = static_cast<PrecisionType>(vectorValue[j]);
+          }
+          if (++panelPixels == SecondOrderPanelSize)
+          {
+            AccumulateSecondOrderPanel(panel.data(), panelPixels, nbComponents, m_ThreadSecondOrderAccumulators[threadId]);
+            panelPixels = 0;
           }
           threadSecondOrderComponent += vectorValue.GetSquaredNorm();
         }
       }
     }
   }
+
+  if (panelPixels > 0)
+  {
+    AccumulateSecondOrderPanel(panel.data(), panelPixels, nbComponents, m_ThreadSecondOrderAccumulators[threadId]);
+  }
+}
+
+template <class TInputImage, class TPrecision>
+void PersistentStreamingStatisticsVectorImageFilter<TInputImage, TPrecision>::AccumulateSecondOrderPanel(const PrecisionType* panel, unsigned int nbPixels,
+                                                                                                         unsigned int nbComponents, MatrixType& accumulator)
+{
+  vnl_matrix<PrecisionType>& matrix = accumulator.GetVnlMatrix();
+
+  // Rank-k update of the upper triangle: each row of the accumulator is
+  // updated with contiguous multiply-adds, that the compiler vectorizes
+  for (unsigned int r = 0; r < nbComponents; ++r)
+  {
+    PrecisionType* row = matrix[r];
+    for (unsigned int k = 0; k < nbPixels; ++k)
+    {
+      const PrecisionType* pixel = panel + k * nbComponents;
+      const PrecisionType  value = pixel[r];
+      for (unsigned int c = r; c < nbComponents; ++c)
+      {
+        row[c] += value * pixel[c];
+      }
+    }
+  }
 }
 
 template <class TImage, class TPrecision>
@@ -24,6 +24,7 @@
 #include "itkImageToImageFilter.h"
 #include "itkImage.h"
 #include "itkNumericTraits.h"
+#include "itkProgressReporter.h"
 
 namespace otb
 {
@@ -33,6 +34,11 @@ namespace otb
  * Computes an image where a given pixel is the value over the standard 8, 26, etc. connected
  * neighborhood. This calculation uses a ZeroFluxNeumannBoundaryCondition.
  *
+ * When both radii reach IntegralImageMinimumRadius (2 by default), the
+ * sums are read from summed-area tables built in double precision on
+ * square tiles of the output region, so that the cost per pixel does not
+ * depend on the radius. Smaller neighborhoods are processed directly.
+ *
  *
  * \sa Image
  * \sa Neighborhood
@@ -83,6 +89,10 @@ public:
   /** Get the radius of the neighborhood used to compute the mean */
   itkGetConstReferenceMacro(Radius, InputSizeType);
 
+  /** Set/Get the smallest radius processed with summed-area tables */
+  itkSetMacro(IntegralImageMinimumRadius, unsigned int);
+  itkGetMacro(IntegralImageMinimumRadius, unsigned int);
+
   /** VarianceImageFilter needs a larger input requested region than
    * the output requested region.  As such, VarianceImageFilter needs
    * to provide an implementation for GenerateInputRequestedRegion()
@@ -116,11 +126,15 @@ protected:
    *     ImageToImageFilter::GenerateData() */
   void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
+  /** Summed-area table version of ThreadedGenerateData() */
+  void IntegralImageGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ProgressReporter& progress);
+
 private:
   VarianceImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
   InputSizeType m_Radius;
+  unsigned int  m_IntegralImageMinimumRadius;
 };
 
 } // end namespace otb
@@ -29,6 +29,8 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkOffset.h"
 #include "itkProgressReporter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include "otbSummedAreaTable.h"
 
 namespace otb
 {
@@ -37,6 +39,7 @@ template <class TInputImage, class TOutputImage>
 VarianceImageFilter<TInputImage, TOutputImage>::VarianceImageFilter()
 {
   m_Radius.Fill(1);
+  m_IntegralImageMinimumRadius = 2;
 }
 
 template <class TInputImage, class TOutputImage>
@@ -88,6 +91,15 @@ void VarianceImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegio
 template <class TInputImage, class TOutputImage>
 void VarianceImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  if (std::min(m_Radius[0], m_Radius[1]) >= m_IntegralImageMinimumRadius)
+  {
+    IntegralImageGenerateData(outputRegionForThread, progress);
+    return;
+  }
+
   unsigned int                                          i;
   itk::ZeroFluxNeumannBoundaryCondition<InputImageType> nbc;
 
@@ -105,9 +117,6 @@ void VarianceImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const
 
   typename itk::NeighborhoodAlgorithm::ImageBoundaryFacesCalculator<InputImageType>::FaceListType::iterator fit;
 
-  // support progress methods/callbacks
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
-
   InputRealType sum;
   InputRealType sumOfSquares;
 
@@ -143,6 +152,49 @@ void VarianceImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const
   }
 }
 
+template <class TInputImage, class TOutputImage>
+void VarianceImageFilter<TInputImage, TOutputImage>::IntegralImageGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                               itk::ProgressReporter&       progress)
+{
+  typename OutputImageType::Pointer     output = this->GetOutput();
+  typename InputImageType::ConstPointer input  = this->GetInput();
+
+  // Tiles bound the magnitude of the sums, at the cost of recomputing
+  // the overlap of their padded regions
+  const itk::SizeValueType tileSize = std::max<itk::SizeValueType>(64, 2 * std::max(m_Radius[0], m_Radius[1]) + 1);
+  const double             num      = static_cast<double>((2 * m_Radius[0] + 1) * (2 * m_Radius[1] + 1));
+
+  SummedAreaTable<InputImageType, 2> table;
+  double                             sums[2];
+
+  const typename OutputImageRegionType::IndexType start  = outputRegionForThread.GetIndex();
+  const typename OutputImageRegionType::SizeType  extent = outputRegionForThread.GetSize();
+
+  for (itk::SizeValueType ty = 0; ty < extent[1]; ty += tileSize)
+  {
+    for (itk::SizeValueType tx = 0; tx < extent[0]; tx += tileSize)
+    {
+      OutputImageRegionType tile;
+      tile.SetIndex(0, start[0] + tx);
+      tile.SetIndex(1, start[1] + ty);
+      tile.SetSize(0, std::min(tileSize, extent[0] - tx));
+      tile.SetSize(1, std::min(tileSize, extent[1] - ty));
+
+      InputImageRegionType padded = tile;
+      padded.PadByRadius(m_Radius);
+      table.Compute(input, padded);
+
+      itk::ImageRegionIteratorWithIndex<OutputImageType> it(output, tile);
+      for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+      {
+        table.GetSums(it.GetIndex(), m_Radius, sums);
+        it.Set(static_cast<OutputPixelType>((sums[1] - (sums[0] * sums[0] / num)) / (num - 1.0)));
+        progress.CompletedPixel();
+      }
+    }
+  }
+}
+
 /**
  * Standard "PrintSelf" method
  */
@@ -151,6 +203,7 @@ void VarianceImageFilter<TInputImage, TOutput>::PrintSelf(std::ostream& os, itk:
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "IntegralImageMinimumRadius: " << m_IntegralImageMinimumRadius << std::endl;
 }
 
 } // end namespace otb
@@ -33,6 +33,7 @@ void RegisterTests()
   REGISTER_TEST(otbShiftScaleSampleListFilter);
   REGISTER_TEST(otbVectorImageToIntensityImageFilter);
   REGISTER_TEST(otbVarianceImageFilter);
+  REGISTER_TEST(otbVarianceImageFilterIntegralImage);
   REGISTER_TEST(otbConcatenateSampleListFilter);
   REGISTER_TEST(otbLocalHistogramImageFunctionTest);
   REGISTER_TEST(otbProjectiveProjectionTestHighSNR);
@@ -22,6 +22,7 @@
 #include "otbImage.h"
 #include "otbImageFileReader.h"
 #include "otbImageFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
 
 int otbVarianceImageFilter(int itkNotUsed(argc), char* argv[])
 {
@@ -47,3 +48,52 @@ int otbVarianceImageFilter(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbVarianceImageFilterIntegralImage(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<double, 2>                          ImageType;
+  typedef otb::VarianceImageFilter<ImageType, ImageType> FilterType;
+
+  ImageType::RegionType region;
+  region.SetSize(0, 151);
+  region.SetSize(1, 67);
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    it.Set(500. + (it.GetIndex()[0] * 7919 + it.GetIndex()[1] * 104729) % 257);
+  }
+
+  ImageType::SizeType radius;
+  radius[0] = 9;
+  radius[1] = 4;
+
+  // The summed-area tables must reproduce the direct computation
+  FilterType::Pointer direct = FilterType::New();
+  direct->SetInput(image);
+  direct->SetRadius(radius);
+  direct->SetIntegralImageMinimumRadius(10);
+  direct->Update();
+
+  FilterType::Pointer integral = FilterType::New();
+  integral->SetInput(image);
+  integral->SetRadius(radius);
+  integral->SetNumberOfThreads(3);
+  integral->Update();
+
+  itk::ImageRegionIteratorWithIndex<ImageType> directIt(direct->GetOutput(), region);
+  itk::ImageRegionIteratorWithIndex<ImageType> integralIt(integral->GetOutput(), region);
+  for (directIt.GoToBegin(), integralIt.GoToBegin(); !directIt.IsAtEnd(); ++directIt, ++integralIt)
+  {
+    if (std::abs(directIt.Get() - integralIt.Get()) > 1e-9 * directIt.Get())
+    {
+      std::cerr << "Wrong variance at " << directIt.GetIndex() << ": " << integralIt.Get() << " instead of " << directIt.Get() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
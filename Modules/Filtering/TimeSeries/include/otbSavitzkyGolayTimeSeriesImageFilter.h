@@ -0,0 +1,176 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSavitzkyGolayTimeSeriesImageFilter_h
+#define otbSavitzkyGolayTimeSeriesImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <map>
+#include <vector>
+
+namespace otb
+{
+
+/** \class SavitzkyGolayTimeSeriesImageFilter
+ * \brief Smooths and gap-fills the time series of an image stack with
+ * local polynomial least squares fits.
+ *
+ * Each band of the input image is a date of the series. The value of date
+ * i is replaced by the value at date i of the polynomial of degree Degree
+ * fitted by weighted least squares on the 2 * Radius + 1 dates centred on
+ * i. Near the ends of the series, the window is shifted to stay inside
+ * the series. A Radius of 0 fits a single polynomial on the whole series,
+ * as TimeSeriesLeastSquareFittingFunctor does.
+ *
+ * The optional weights image has one band per date. Weights are
+ * confidences, 0 excluding a date from the fits (e.g. a cloudy date,
+ * whose value is then interpolated from the others). The weight of a date
+ * is \f$ 1/\sigma_i^2 \f$ for the error \f$ \sigma_i \f$ used by
+ * SavitzkyGolayInterpolationFunctor. When a window holds fewer valid dates
+ * than the polynomial has coefficients, the degree is decreased, and a
+ * window without any valid date keeps the input value.
+ *
+ * The fitted value at a date is a linear combination of the values of its
+ * window, whose coefficients only depend on the dates and on the weights.
+ * They are computed once per weight pattern (once for the whole image
+ * without weights image, once per cloud mask pattern with binary weights)
+ * and cached, up to MaximumNumberOfPatterns patterns per thread. Each line
+ * is processed in a date-major layout, so that the coefficients are
+ * applied to all the pixels sharing a pattern with contiguous loops.
+ *
+ * Unlike the time series functors, the number of dates is only known at
+ * runtime, from the dates set with SetDates().
+ *
+ * \sa SavitzkyGolayInterpolationFunctor
+ * \sa TimeSeriesLeastSquareFittingFunctor
+ *
+ * \ingroup OTBTimeSeries
+ */
+template <class TInputImage, class TOutputImage = TInputImage, class TWeightImage = TInputImage>
+class ITK_EXPORT SavitzkyGolayTimeSeriesImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef SavitzkyGolayTimeSeriesImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(SavitzkyGolayTimeSeriesImageFilter, ImageToImageFilter);
+
+  /** Some convenient typedefs. */
+  typedef TInputImage                                 InputImageType;
+  typedef typename InputImageType::PixelType          InputImagePixelType;
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::PixelType         OutputImagePixelType;
+  typedef typename OutputImageType::InternalPixelType OutputInternalPixelType;
+  typedef TWeightImage                                WeightImageType;
+  typedef typename WeightImageType::PixelType         WeightImagePixelType;
+
+  typedef std::vector<double> DatesType;
+
+  /** Smoothing coefficients for one weight pattern: the fitted value of
+   * date i is the dot product of the WindowLength coefficients starting at
+   * Coefficients[i * WindowLength] with the values of the dates starting
+   * at WindowStart[i] */
+  struct SmoothingCoefficients
+  {
+    std::vector<unsigned int> WindowStart;
+    std::vector<double>       Coefficients;
+  };
+
+  /** Set/Get the dates of the bands (e.g. days of year) */
+  void SetDates(const DatesType& dates)
+  {
+    m_Dates = dates;
+    this->Modified();
+  }
+  itkGetConstReferenceMacro(Dates, DatesType);
+
+  /** Set/Get the half size of the fitting window (0 fits the whole series) */
+  itkSetMacro(Radius, unsigned int);
+  itkGetMacro(Radius, unsigned int);
+
+  /** Set/Get the degree of the fitted polynomials */
+  itkSetMacro(Degree, unsigned int);
+  itkGetMacro(Degree, unsigned int);
+
+  /** Set/Get the maximum number of weight patterns cached by each thread */
+  itkSetMacro(MaximumNumberOfPatterns, unsigned int);
+  itkGetMacro(MaximumNumberOfPatterns, unsigned int);
+
+  /** Set/Get the optional image of the weights of the dates */
+  void SetWeightsImage(const WeightImageType* weights);
+  const WeightImageType* GetWeightsImage() const;
+
+  /** Compute the smoothing coefficients of a weight pattern */
+  SmoothingCoefficients ComputeCoefficients(const std::vector<double>& weights) const;
+
+protected:
+  SavitzkyGolayTimeSeriesImageFilter();
+  ~SavitzkyGolayTimeSeriesImageFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Number of dates of the fitting windows */
+  unsigned int GetWindowLength() const;
+
+  /** Apply coefficients to nbPixels series stored date by date */
+  void ApplyCoefficients(const SmoothingCoefficients& coefficients, const double* input, double* output, unsigned int nbPixels) const;
+
+private:
+  SavitzkyGolayTimeSeriesImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  typedef std::map<std::vector<double>, SmoothingCoefficients> PatternCacheType;
+
+  DatesType    m_Dates;
+  unsigned int m_Radius;
+  unsigned int m_Degree;
+  unsigned int m_MaximumNumberOfPatterns;
+
+  /** Coefficients with all the weights equal to 1 */
+  SmoothingCoefficients m_UniformCoefficients;
+
+  /** Coefficients of the weight patterns met by each thread */
+  std::vector<PatternCacheType> m_PatternCaches;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSavitzkyGolayTimeSeriesImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,365 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSavitzkyGolayTimeSeriesImageFilter_hxx
+#define otbSavitzkyGolayTimeSeriesImageFilter_hxx
+
+#include "otbSavitzkyGolayTimeSeriesImageFilter.h"
+
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+#include "vnl/algo/vnl_svd.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::SavitzkyGolayTimeSeriesImageFilter()
+{
+  m_Radius                  = 2;
+  m_Degree                  = 2;
+  m_MaximumNumberOfPatterns = 256;
+}
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+void SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::SetWeightsImage(const WeightImageType* weights)
+{
+  // Process object is not const-correct so the const casting is required.
+  this->SetNthInput(1, const_cast<WeightImageType*>(weights));
+}
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+const typename SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::WeightImageType*
+SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::GetWeightsImage() const
+{
+  if (this->GetNumberOfInputs() < 2)
+  {
+    return nullptr;
+  }
+  return static_cast<const WeightImageType*>(this->itk::ProcessObject::GetInput(1));
+}
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+unsigned int SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::GetWindowLength() const
+{
+  const unsigned int nbDates = m_Dates.size();
+  if (m_Radius == 0 || 2 * m_Radius + 1 > nbDates)
+  {
+    return nbDates;
+  }
+  return 2 * m_Radius + 1;
+}
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+void SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType*  inputPtr   = this->GetInput();
+  const WeightImageType* weightsPtr = this->GetWeightsImage();
+  OutputImageType*       outputPtr  = this->GetOutput();
+
+  const unsigned int nbDates = inputPtr->GetNumberOfComponentsPerPixel();
+  if (nbDates == 0 || m_Dates.size() != nbDates)
+  {
+    itkExceptionMacro(<< m_Dates.size() << " dates are set for an input image of " << nbDates << " bands");
+  }
+  if (weightsPtr)
+  {
+    if (weightsPtr->GetNumberOfComponentsPerPixel() != nbDates)
+    {
+      itkExceptionMacro(<< "The weights image has " << weightsPtr->GetNumberOfComponentsPerPixel() << " bands instead of " << nbDates);
+    }
+    if (weightsPtr->GetLargestPossibleRegion() != inputPtr->GetLargestPossibleRegion())
+    {
+      itkExceptionMacro(<< "The weights image and the input image do not have the same size");
+    }
+  }
+  if (m_Degree >= GetWindowLength())
+  {
+    itkExceptionMacro(<< "A polynomial of degree " << m_Degree << " can not be fitted on " << GetWindowLength() << " dates");
+  }
+
+  outputPtr->SetNumberOfComponentsPerPixel(nbDates);
+}
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+typename SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::SmoothingCoefficients
+SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::ComputeCoefficients(const std::vector<double>& weights) const
+{
+  const unsigned int nbDates      = m_Dates.size();
+  const unsigned int windowLength = GetWindowLength();
+
+  SmoothingCoefficients result;
+  result.WindowStart.resize(nbDates);
+  result.Coefficients.assign(static_cast<std::size_t>(nbDates) * windowLength, 0.);
+
+  std::vector<double> basis;
+  for (unsigned int i = 0; i < nbDates; ++i)
+  {
+    const unsigned int start = i < m_Radius ? 0 : std::min(i - m_Radius, nbDates - windowLength);
+    double*            row   = &result.Coefficients[static_cast<std::size_t>(i) * windowLength];
+    result.WindowStart[i]    = start;
+
+    unsigned int nbValid = 0;
+    double       span    = 0.;
+    for (unsigned int l = 0; l < windowLength; ++l)
+    {
+      if (weights[start + l] > 0)
+      {
+        ++nbValid;
+        span = std::max(span, std::abs(m_Dates[start + l] - m_Dates[i]));
+      }
+    }
+    if (nbValid == 0)
+    {
+      row[i - start] = 1.;
+      continue;
+    }
+    if (span == 0.)
+    {
+      span = 1.;
+    }
+
+    // The polynomial is expressed in (t - t_i) / span, so that its value at
+    // t_i is its first coefficient: with the normal equations N c = A^T W y,
+    // the fitted value is (N^-1 e_0)^T A^T W y
+    const unsigned int nbCoefs = std::min(m_Degree + 1, nbValid);
+    basis.assign(static_cast<std::size_t>(windowLength) * nbCoefs, 0.);
+    vnl_matrix<double> normal(nbCoefs, nbCoefs, 0.);
+    for (unsigned int l = 0; l < windowLength; ++l)
+    {
+      const double w = weights[start + l];
+      if (w <= 0)
+      {
+        continue;
+      }
+      double* phi = &basis[static_cast<std::size_t>(l) * nbCoefs];
+      phi[0]      = 1.;
+      for (unsigned int j = 1; j < nbCoefs; ++j)
+      {
+        phi[j] = phi[j - 1] * (m_Dates[start + l] - m_Dates[i]) / span;
+      }
+      for (unsigned int r = 0; r < nbCoefs; ++r)
+      {
+        for (unsigned int c = 0; c < nbCoefs; ++c)
+        {
+          normal(r, c) += w * phi[r] * phi[c];
+        }
+      }
+    }
+
+    vnl_vector<double> e0(nbCoefs, 0.);
+    e0[0]                      = 1.;
+    const vnl_vector<double> a = vnl_svd<double>(normal).solve(e0);
+
+    for (unsigned int l = 0; l < windowLength; ++l)
+    {
+      const double w = weights[start + l];
+      if (w <= 0)
+      {
+        continue;
+      }
+      const double* phi   = &basis[static_cast<std::size_t>(l) * nbCoefs];
+      double        value = 0.;
+      for (unsigned int j = 0; j < nbCoefs; ++j)
+      {
+        value += a[j] * phi[j];
+      }
+      row[l] = w * value;
+    }
+  }
+  return result;
+}
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+void SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::ApplyCoefficients(const SmoothingCoefficients& coefficients,
+                                                                                                    const double* input, double* output,
+                                                                                                    unsigned int nbPixels) const
+{
+  const unsigned int nbDates      = m_Dates.size();
+  const unsigned int windowLength = GetWindowLength();
+
+  for (unsigned int i = 0; i < nbDates; ++i)
+  {
+    double* out = output + static_cast<std::size_t>(i) * nbPixels;
+    std::fill(out, out + nbPixels, 0.);
+
+    const double* row = &coefficients.Coefficients[static_cast<std::size_t>(i) * windowLength];
+    for (unsigned int l = 0; l < windowLength; ++l)
+    {
+      const double coefficient = row[l];
+      if (coefficient == 0.)
+      {
+        continue;
+      }
+      const double* in = input + static_cast<std::size_t>(coefficients.WindowStart[i] + l) * nbPixels;
+      for (unsigned int p = 0; p < nbPixels; ++p)
+      {
+        out[p] += coefficient * in[p];
+      }
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+void SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::BeforeThreadedGenerateData()
+{
+  m_UniformCoefficients = ComputeCoefficients(std::vector<double>(m_Dates.size(), 1.));
+  m_PatternCaches.assign(this->GetNumberOfThreads(), PatternCacheType());
+}
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+void SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                       itk::ThreadIdType threadId)
+{
+  const InputImageType*  inputPtr   = this->GetInput();
+  const WeightImageType* weightsPtr = this->GetWeightsImage();
+  OutputImageType*       outputPtr  = this->GetOutput();
+
+  typedef itk::ImageScanlineConstIterator<InputImageType>  InputIteratorType;
+  typedef itk::ImageScanlineConstIterator<WeightImageType> WeightIteratorType;
+  typedef itk::ImageScanlineIterator<OutputImageType>      OutputIteratorType;
+
+  InputIteratorType  inIt(inputPtr, outputRegionForThread);
+  OutputIteratorType outIt(outputPtr, outputRegionForThread);
+  WeightIteratorType weightIt;
+  if (weightsPtr)
+  {
+    weightIt = WeightIteratorType(weightsPtr, outputRegionForThread);
+    weightIt.GoToBegin();
+  }
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  const unsigned int nbDates = m_Dates.size();
+  const unsigned int width   = outputRegionForThread.GetSize(0);
+
+  // Series of a line, date by date
+  std::vector<double> input(static_cast<std::size_t>(nbDates) * width);
+  std::vector<double> output(input.size());
+  std::vector<double> groupInput;
+  std::vector<double> groupOutput;
+
+  // Pixels of the line sharing a weight pattern
+  std::map<std::vector<double>, std::vector<unsigned int>> groups;
+  std::vector<double>                                      pattern(nbDates);
+  PatternCacheType&                                        cache = m_PatternCaches[threadId];
+
+  OutputImagePixelType outPixel;
+  outPixel.SetSize(nbDates);
+
+  for (inIt.GoToBegin(), outIt.GoToBegin(); !inIt.IsAtEnd(); inIt.NextLine(), outIt.NextLine())
+  {
+    groups.clear();
+    for (unsigned int x = 0; !inIt.IsAtEndOfLine(); ++inIt, ++x)
+    {
+      const InputImagePixelType& pixel = inIt.Get();
+      for (unsigned int d = 0; d < nbDates; ++d)
+      {
+        input[static_cast<std::size_t>(d) * width + x] = pixel[d];
+      }
+      if (weightsPtr)
+      {
+        const WeightImagePixelType& weights = weightIt.Get();
+        for (unsigned int d = 0; d < nbDates; ++d)
+        {
+          pattern[d] = weights[d];
+        }
+        groups[pattern].push_back(x);
+        ++weightIt;
+      }
+    }
+
+    if (!weightsPtr)
+    {
+      ApplyCoefficients(m_UniformCoefficients, input.data(), output.data(), width);
+    }
+    else
+    {
+      weightIt.NextLine();
+      for (const auto& group : groups)
+      {
+        auto cached = cache.find(group.first);
+        if (cached == cache.end())
+        {
+          if (cache.size() >= m_MaximumNumberOfPatterns)
+          {
+            cache.clear();
+          }
+          cached = cache.emplace(group.first, ComputeCoefficients(group.first)).first;
+        }
+
+        const std::vector<unsigned int>& columns = group.second;
+        const unsigned int               nbPixels = columns.size();
+        if (nbPixels == width)
+        {
+          ApplyCoefficients(cached->second, input.data(), output.data(), width);
+          continue;
+        }
+
+        groupInput.resize(static_cast<std::size_t>(nbDates) * nbPixels);
+        groupOutput.resize(groupInput.size());
+        for (unsigned int d = 0; d < nbDates; ++d)
+        {
+          for (unsigned int k = 0; k < nbPixels; ++k)
+          {
+            groupInput[static_cast<std::size_t>(d) * nbPixels + k] = input[static_cast<std::size_t>(d) * width + columns[k]];
+          }
+        }
+        ApplyCoefficients(cached->second, groupInput.data(), groupOutput.data(), nbPixels);
+        for (unsigned int d = 0; d < nbDates; ++d)
+        {
+          for (unsigned int k = 0; k < nbPixels; ++k)
+          {
+            output[static_cast<std::size_t>(d) * width + columns[k]] = groupOutput[static_cast<std::size_t>(d) * nbPixels + k];
+          }
+        }
+      }
+    }
+
+    for (unsigned int x = 0; !outIt.IsAtEndOfLine(); ++outIt, ++x)
+    {
+      for (unsigned int d = 0; d < nbDates; ++d)
+      {
+        outPixel[d] = static_cast<OutputInternalPixelType>(output[static_cast<std::size_t>(d) * width + x]);
+      }
+      outIt.Set(outPixel);
+      progress.CompletedPixel();
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TWeightImage>
+void SavitzkyGolayTimeSeriesImageFilter<TInputImage, TOutputImage, TWeightImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of dates: " << m_Dates.size() << std::endl;
+  os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "Degree: " << m_Degree << std::endl;
+  os << indent << "MaximumNumberOfPatterns: " << m_MaximumNumberOfPatterns << std::endl;
+}
+
+} // end namespace otb
+
+#endif
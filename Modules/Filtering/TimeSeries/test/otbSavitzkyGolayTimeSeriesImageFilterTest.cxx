@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbSavitzkyGolayTimeSeriesImageFilter.h"
+#include "otbSavitzkyGolayInterpolationFunctor.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionIterator.h"
+
+typedef otb::VectorImage<double, 2>                         ImageType;
+typedef otb::SavitzkyGolayTimeSeriesImageFilter<ImageType> FilterType;
+
+namespace
+{
+ImageType::Pointer CreateImage(unsigned int nbDates)
+{
+  ImageType::Pointer  image = ImageType::New();
+  ImageType::SizeType size;
+  size[0] = 7;
+  size[1] = 5;
+  image->SetRegions(size);
+  image->SetNumberOfComponentsPerPixel(nbDates);
+  image->Allocate();
+  return image;
+}
+}
+
+int otbSavitzkyGolayTimeSeriesImageFilterTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  const unsigned int nbDates = 40;
+  const unsigned int Radius  = 2;
+
+  // Unweighted smoothing: same values as the functor inside the series
+  typedef itk::FixedArray<double, nbDates>                                                          SeriesType;
+  typedef otb::Functor::SavitzkyGolayInterpolationFunctor<Radius, SeriesType, SeriesType, SeriesType> FunctorType;
+
+  SeriesType            inSeries, weightSeries, doySeries;
+  FilterType::DatesType dates(nbDates);
+  for (unsigned int i = 0; i < nbDates; ++i)
+  {
+    inSeries[i]     = 10 * std::cos(i / 5.0);
+    doySeries[i]    = 3 * i + (i % 2);
+    weightSeries[i] = 1;
+    dates[i]        = doySeries[i];
+  }
+  inSeries[nbDates / 4] = 0.0;
+
+  FunctorType f;
+  f.SetWeights(weightSeries);
+  f.SetDates(doySeries);
+  const SeriesType expected = f(inSeries);
+
+  ImageType::Pointer   series = CreateImage(nbDates);
+  ImageType::PixelType pixel(nbDates);
+  for (unsigned int i = 0; i < nbDates; ++i)
+    pixel[i] = inSeries[i];
+  series->FillBuffer(pixel);
+
+  FilterType::Pointer smoothing = FilterType::New();
+  smoothing->SetInput(series);
+  smoothing->SetDates(dates);
+  smoothing->SetRadius(Radius);
+  smoothing->Update();
+
+  ImageType::IndexType center;
+  center[0]                           = 3;
+  center[1]                           = 2;
+  const ImageType::PixelType smoothed = smoothing->GetOutput()->GetPixel(center);
+  for (unsigned int i = Radius; i < nbDates - Radius; ++i)
+  {
+    if (std::abs(smoothed[i] - expected[i]) > 1e-3)
+    {
+      std::cout << "Date " << i << ": " << smoothed[i] << " != " << expected[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Gap filling: masked dates of a quadratic series are recovered, even
+  // near the ends of the series
+  ImageType::Pointer quadratic = CreateImage(nbDates);
+  ImageType::Pointer weights   = CreateImage(nbDates);
+
+  itk::ImageRegionIterator<ImageType> seriesIt(quadratic, quadratic->GetLargestPossibleRegion());
+  itk::ImageRegionIterator<ImageType> weightsIt(weights, weights->GetLargestPossibleRegion());
+  ImageType::PixelType                weight(nbDates);
+  for (seriesIt.GoToBegin(), weightsIt.GoToBegin(); !seriesIt.IsAtEnd(); ++seriesIt, ++weightsIt)
+  {
+    const ImageType::IndexType index = seriesIt.GetIndex();
+    for (unsigned int i = 0; i < nbDates; ++i)
+    {
+      pixel[i]  = index[0] + 0.5 * index[1] * dates[i] - 0.01 * dates[i] * dates[i];
+      weight[i] = 1;
+      // A few cloudy dates, depending on the pixel
+      if ((i + index[0] + 2 * index[1]) % 7 == 0)
+      {
+        pixel[i]  = -1000;
+        weight[i] = 0;
+      }
+    }
+    seriesIt.Set(pixel);
+    weightsIt.Set(weight);
+  }
+
+  FilterType::Pointer gapFilling = FilterType::New();
+  gapFilling->SetInput(quadratic);
+  gapFilling->SetWeightsImage(weights);
+  gapFilling->SetDates(dates);
+  gapFilling->SetRadius(3);
+  gapFilling->SetMaximumNumberOfPatterns(3);
+  gapFilling->Update();
+
+  itk::ImageRegionIterator<ImageType> outIt(gapFilling->GetOutput(), gapFilling->GetOutput()->GetLargestPossibleRegion());
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    const ImageType::IndexType index = outIt.GetIndex();
+    for (unsigned int i = 0; i < nbDates; ++i)
+    {
+      const double value = index[0] + 0.5 * index[1] * dates[i] - 0.01 * dates[i] * dates[i];
+      if (std::abs(outIt.Get()[i] - value) > 1e-6)
+      {
+        std::cout << "Pixel " << index << ", date " << i << ": " << outIt.Get()[i] << " != " << value << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -25,6 +25,7 @@ void RegisterTests()
   REGISTER_TEST(otbEnvelopeSavitzkyGolayInterpolationFunctorTest);
   REGISTER_TEST(otbPolynomialTimeSeriesTest);
   REGISTER_TEST(otbSavitzkyGolayInterpolationFunctorTest);
+  REGISTER_TEST(otbSavitzkyGolayTimeSeriesImageFilterTest);
   REGISTER_TEST(otbTimeSeriesLeastSquareFittingFunctorTest);
   REGISTER_TEST(otbTimeSeriesLeastSquareFittingFunctorWeightsTest);
 }
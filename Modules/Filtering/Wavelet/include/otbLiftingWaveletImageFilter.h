@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLiftingWaveletImageFilter_h
+#define otbLiftingWaveletImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbWaveletOperatorBase.h"
+#include <vector>
+
+namespace otb
+{
+
+namespace Wavelet
+{
+enum LiftingScheme
+{
+  LIFTING_HAAR    = 0,
+  LIFTING_CDF_5_3 = 1,
+  LIFTING_CDF_9_7 = 2
+};
+}
+
+/** \class LiftingWaveletImageFilter
+ * \brief Multi-level wavelet transform by lifting, computed in place on the synopsis image.
+ *
+ * The forward transform copies the input into the output and decomposes
+ * it in place: at each level the rows, then the columns, of the current
+ * low band are split into their low and high halves by the lifting steps
+ * of the selected scheme. The inverse transform undoes the levels from the
+ * coarsest one. No band list is built in between.
+ *
+ * The supported schemes are the orthonormal Haar wavelet and the
+ * Cohen-Daubechies-Feauveau 5/3 and 9/7 biorthogonal wavelets, with a
+ * symmetric extension at the band borders. For image sizes divisible by
+ * 2^NumberOfDecompositions, the output has the layout of
+ * WaveletsBandsListToWaveletsSynopsisImageFilter. Otherwise, the low half
+ * of a line of odd length holds the extra sample.
+ *
+ * Lines are processed by blocks of consecutive rows or columns, gathered
+ * in a per-thread buffer so that the column passes read the image row by
+ * row. The blocks of a pass are shared between the threads.
+ *
+ * The output pixel type must be a real type. This filter is not streamed.
+ *
+ * \ingroup OTBWavelet
+ * \sa WaveletImageFilter
+ * \sa WaveletInverseImageFilter
+ */
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation = Wavelet::FORWARD>
+class ITK_EXPORT LiftingWaveletImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef LiftingWaveletImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(LiftingWaveletImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                                             InputImageType;
+  typedef TOutputImage                                            OutputImageType;
+  typedef typename OutputImageType::PixelType                     OutputPixelType;
+  typedef typename OutputImageType::RegionType                    RegionType;
+  typedef typename itk::NumericTraits<OutputPixelType>::FloatType PrecisionType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, InputImageType::ImageDimension);
+  itkStaticConstMacro(DirectionOfTransformation, Wavelet::WaveletDirection, TDirectionOfTransformation);
+  static_assert(ImageDimension == 2, "Only 2D images are supported");
+
+  itkGetMacro(NumberOfDecompositions, unsigned int);
+  itkSetMacro(NumberOfDecompositions, unsigned int);
+
+  itkGetMacro(Scheme, Wavelet::LiftingScheme);
+  itkSetMacro(Scheme, Wavelet::LiftingScheme);
+
+  /** Number of rows or columns processed together */
+  itkGetMacro(BlockSize, unsigned int);
+  itkSetMacro(BlockSize, unsigned int);
+
+protected:
+  LiftingWaveletImageFilter();
+  ~LiftingWaveletImageFilter() override
+  {
+  }
+
+  void GenerateInputRequestedRegion() override;
+
+  void EnlargeOutputRequestedRegion(itk::DataObject* output) override;
+
+  void GenerateData() override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  LiftingWaveletImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** A lifting step adds to each sample of one half of a line the
+   * weighted sum of its two neighbours in the other half */
+  struct LiftingStepType
+  {
+    bool          predict;
+    PrecisionType previous;
+    PrecisionType next;
+  };
+
+  /** One pass of one level, shared by the threads */
+  struct PassStruct
+  {
+    Self*        Filter;
+    bool         alongRows;
+    unsigned int width;
+    unsigned int height;
+  };
+
+  static ITK_THREAD_RETURN_TYPE PassThreaderCallback(void* arg);
+
+  /** Transform the lines [firstLine, firstLine + nbLines) of the
+   * width x height top-left corner of the output */
+  void ProcessBlock(bool alongRows, unsigned int width, unsigned int height, unsigned int firstLine, unsigned int nbLines, itk::ThreadIdType threadId);
+
+  /** Apply the lifting steps to nbLines interleaved lines of length
+   * length, whose low and high halves are stored one after the other */
+  void Lift(PrecisionType* buffer, unsigned int length, unsigned int nbLines) const;
+
+  void RunPass(bool alongRows, unsigned int width, unsigned int height);
+
+  unsigned int           m_NumberOfDecompositions;
+  Wavelet::LiftingScheme m_Scheme;
+  unsigned int           m_BlockSize;
+
+  std::vector<LiftingStepType>            m_Steps;
+  PrecisionType                           m_LowScale;
+  PrecisionType                           m_HighScale;
+  std::vector<std::vector<PrecisionType>> m_ThreadBuffers;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbLiftingWaveletImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,327 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLiftingWaveletImageFilter_hxx
+#define otbLiftingWaveletImageFilter_hxx
+
+#include "otbLiftingWaveletImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation>
+LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::LiftingWaveletImageFilter()
+  : m_NumberOfDecompositions(2), m_Scheme(Wavelet::LIFTING_HAAR), m_BlockSize(16), m_LowScale(1), m_HighScale(1)
+{
+}
+
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation>
+void LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (input)
+  {
+    input->SetRequestedRegionToLargestPossibleRegion();
+  }
+}
+
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation>
+void LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::EnlargeOutputRequestedRegion(itk::DataObject* output)
+{
+  Superclass::EnlargeOutputRequestedRegion(output);
+  output->SetRequestedRegionToLargestPossibleRegion();
+}
+
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation>
+void LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::GenerateData()
+{
+  const InputImageType* input  = this->GetInput();
+  OutputImageType*      output = this->GetOutput();
+
+  if (m_BlockSize == 0)
+  {
+    itkExceptionMacro(<< "BlockSize must be positive");
+  }
+
+  // The lifting steps and the scaling of the forward transform. The
+  // constants of the 9/7 wavelet are the ones of JPEG 2000, and the
+  // scaling gives a gain of sqrt(2) to the low pass filters, as the
+  // filters of WaveletGenerator.
+  m_Steps.clear();
+  switch (m_Scheme)
+  {
+  case Wavelet::LIFTING_HAAR:
+    m_Steps.push_back({true, -1., 0.});
+    m_Steps.push_back({false, 0., 0.5});
+    m_LowScale  = std::sqrt(2.);
+    m_HighScale = 1. / std::sqrt(2.);
+    break;
+  case Wavelet::LIFTING_CDF_5_3:
+    m_Steps.push_back({true, -0.5, -0.5});
+    m_Steps.push_back({false, 0.25, 0.25});
+    m_LowScale  = std::sqrt(2.);
+    m_HighScale = 1. / std::sqrt(2.);
+    break;
+  case Wavelet::LIFTING_CDF_9_7:
+    m_Steps.push_back({true, -1.586134342059924, -1.586134342059924});
+    m_Steps.push_back({false, -0.052980118572961, -0.052980118572961});
+    m_Steps.push_back({true, 0.882911075530934, 0.882911075530934});
+    m_Steps.push_back({false, 0.443506852043971, 0.443506852043971});
+    m_LowScale  = std::sqrt(2.) / 1.230174104914001;
+    m_HighScale = 1. / m_LowScale;
+    break;
+  default:
+    itkExceptionMacro(<< "Unknown lifting scheme " << m_Scheme);
+  }
+
+  // Sizes of the low band before each level
+  const RegionType          region = output->GetLargestPossibleRegion();
+  std::vector<unsigned int> widths(1, region.GetSize()[0]);
+  std::vector<unsigned int> heights(1, region.GetSize()[1]);
+  for (unsigned int level = 0; level < m_NumberOfDecompositions; ++level)
+  {
+    if (widths.back() < 2 || heights.back() < 2)
+    {
+      itkExceptionMacro(<< "Image of size " << region.GetSize() << " is too small for " << m_NumberOfDecompositions << " decompositions");
+    }
+    widths.push_back((widths.back() + 1) / 2);
+    heights.push_back((heights.back() + 1) / 2);
+  }
+
+  this->AllocateOutputs();
+
+  itk::ImageRegionConstIterator<InputImageType> inIt(input, region);
+  itk::ImageRegionIterator<OutputImageType>     outIt(output, region);
+  for (inIt.GoToBegin(), outIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++outIt)
+  {
+    outIt.Set(static_cast<OutputPixelType>(inIt.Get()));
+  }
+
+  m_ThreadBuffers.assign(this->GetNumberOfThreads(), std::vector<PrecisionType>(std::max(widths[0], heights[0]) * m_BlockSize));
+
+  for (unsigned int i = 0; i < m_NumberOfDecompositions; ++i)
+  {
+    if (TDirectionOfTransformation == Wavelet::FORWARD)
+    {
+      RunPass(true, widths[i], heights[i]);
+      RunPass(false, widths[i], heights[i]);
+    }
+    else
+    {
+      const unsigned int level = m_NumberOfDecompositions - 1 - i;
+      RunPass(false, widths[level], heights[level]);
+      RunPass(true, widths[level], heights[level]);
+    }
+    this->UpdateProgress(static_cast<float>(i + 1) / m_NumberOfDecompositions);
+  }
+
+  m_ThreadBuffers.clear();
+}
+
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation>
+void LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::RunPass(bool alongRows, unsigned int width, unsigned int height)
+{
+  PassStruct str;
+  str.Filter    = this;
+  str.alongRows = alongRows;
+  str.width     = width;
+  str.height    = height;
+
+  this->GetMultiThreader()->SetNumberOfThreads(this->GetNumberOfThreads());
+  this->GetMultiThreader()->SetSingleMethod(this->PassThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation>
+ITK_THREAD_RETURN_TYPE LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::PassThreaderCallback(void* arg)
+{
+  itk::ThreadIdType threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+  PassStruct*       str         = (PassStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+
+  // Each thread takes a contiguous range of blocks
+  const unsigned int blockSize  = str->Filter->m_BlockSize;
+  const unsigned int nbLines    = str->alongRows ? str->height : str->width;
+  const unsigned int nbBlocks   = (nbLines + blockSize - 1) / blockSize;
+  const unsigned int firstBlock = static_cast<unsigned int>(static_cast<unsigned long>(nbBlocks) * threadId / threadCount);
+  const unsigned int lastBlock  = static_cast<unsigned int>(static_cast<unsigned long>(nbBlocks) * (threadId + 1) / threadCount);
+
+  for (unsigned int block = firstBlock; block < lastBlock; ++block)
+  {
+    const unsigned int firstLine = block * blockSize;
+    str->Filter->ProcessBlock(str->alongRows, str->width, str->height, firstLine, std::min(blockSize, nbLines - firstLine), threadId);
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation>
+void LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::ProcessBlock(bool alongRows, unsigned int width, unsigned int height,
+                                                                                                    unsigned int firstLine, unsigned int nbLines,
+                                                                                                    itk::ThreadIdType threadId)
+{
+  OutputImageType* output    = this->GetOutput();
+  const long       rowStride = output->GetBufferedRegion().GetSize()[0];
+
+  // Sample k of line c is at first + c * lineStride + k * sampleStride
+  const unsigned int length       = alongRows ? width : height;
+  const long         lineStride   = alongRows ? rowStride : 1;
+  const long         sampleStride = alongRows ? 1 : rowStride;
+  OutputPixelType*   first        = output->GetBufferPointer() + firstLine * lineStride;
+
+  // In the buffer, sample k of line c is at k * nbLines + c, the samples
+  // being in the low half then high half order
+  PrecisionType*     buffer = m_ThreadBuffers[threadId].data();
+  const unsigned int nbLow  = (length + 1) / 2;
+
+  for (unsigned int k = 0; k < length; ++k)
+  {
+    const OutputPixelType* in  = first + k * sampleStride;
+    PrecisionType*         out = buffer;
+    if (TDirectionOfTransformation == Wavelet::FORWARD)
+    {
+      out += (k % 2 == 0 ? k / 2 : nbLow + k / 2) * nbLines;
+    }
+    else
+    {
+      out += k * nbLines;
+    }
+    for (unsigned int c = 0; c < nbLines; ++c)
+    {
+      out[c] = in[c * lineStride];
+    }
+  }
+
+  Lift(buffer, length, nbLines);
+
+  for (unsigned int k = 0; k < length; ++k)
+  {
+    OutputPixelType*     out = first + k * sampleStride;
+    const PrecisionType* in  = buffer;
+    if (TDirectionOfTransformation == Wavelet::FORWARD)
+    {
+      in += k * nbLines;
+    }
+    else
+    {
+      in += (k % 2 == 0 ? k / 2 : nbLow + k / 2) * nbLines;
+    }
+    for (unsigned int c = 0; c < nbLines; ++c)
+    {
+      out[c * lineStride] = static_cast<OutputPixelType>(in[c]);
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation>
+void LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::Lift(PrecisionType* buffer, unsigned int length,
+                                                                                            unsigned int nbLines) const
+{
+  const unsigned int nbLow  = (length + 1) / 2;
+  const unsigned int nbHigh = length / 2;
+  if (nbHigh == 0)
+  {
+    return;
+  }
+  PrecisionType* low  = buffer;
+  PrecisionType* high = buffer + nbLow * nbLines;
+
+  const bool          forward   = TDirectionOfTransformation == Wavelet::FORWARD;
+  const PrecisionType lowScale  = forward ? m_LowScale : 1 / m_LowScale;
+  const PrecisionType highScale = forward ? m_HighScale : 1 / m_HighScale;
+
+  if (!forward)
+  {
+    for (unsigned int i = 0; i < nbLow * nbLines; ++i)
+    {
+      low[i] *= lowScale;
+    }
+    for (unsigned int i = 0; i < nbHigh * nbLines; ++i)
+    {
+      high[i] *= highScale;
+    }
+  }
+
+  // Symmetric extension: the neighbours outside the line are mirrored
+  // on its first and last samples
+  for (unsigned int s = 0; s < m_Steps.size(); ++s)
+  {
+    const LiftingStepType& step     = m_Steps[forward ? s : m_Steps.size() - 1 - s];
+    const PrecisionType    previous = forward ? step.previous : -step.previous;
+    const PrecisionType    next     = forward ? step.next : -step.next;
+    if (step.predict)
+    {
+      for (unsigned int j = 0; j < nbHigh; ++j)
+      {
+        PrecisionType*       target = high + j * nbLines;
+        const PrecisionType* left   = low + j * nbLines;
+        const PrecisionType* right  = low + std::min(j + 1, nbLow - 1) * nbLines;
+        for (unsigned int c = 0; c < nbLines; ++c)
+        {
+          target[c] += previous * left[c] + next * right[c];
+        }
+      }
+    }
+    else
+    {
+      for (unsigned int i = 0; i < nbLow; ++i)
+      {
+        PrecisionType*       target = low + i * nbLines;
+        const PrecisionType* left   = high + (i > 0 ? i - 1 : 0) * nbLines;
+        const PrecisionType* right  = high + std::min(i, nbHigh - 1) * nbLines;
+        for (unsigned int c = 0; c < nbLines; ++c)
+        {
+          target[c] += previous * left[c] + next * right[c];
+        }
+      }
+    }
+  }
+
+  if (forward)
+  {
+    for (unsigned int i = 0; i < nbLow * nbLines; ++i)
+    {
+      low[i] *= lowScale;
+    }
+    for (unsigned int i = 0; i < nbHigh * nbLines; ++i)
+    {
+      high[i] *= highScale;
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, Wavelet::WaveletDirection TDirectionOfTransformation>
+void LiftingWaveletImageFilter<TInputImage, TOutputImage, TDirectionOfTransformation>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfDecompositions: " << m_NumberOfDecompositions << std::endl;
+  os << indent << "Scheme: " << m_Scheme << std::endl;
+  os << indent << "BlockSize: " << m_BlockSize << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,122 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbImage.h"
+#include "otbLiftingWaveletImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <algorithm>
+#include <cmath>
+
+/*
+This test runs the forward then the inverse lifting transform on a
+synthetic image with odd band sizes, checks that the input is
+recovered, and checks that a constant image only gives low band
+coefficients.
+*/
+
+int otbLiftingWaveletImageFilter(int, char* [])
+{
+  typedef otb::Image<double, 2> ImageType;
+  typedef otb::LiftingWaveletImageFilter<ImageType, ImageType, otb::Wavelet::FORWARD> FwdFilterType;
+  typedef otb::LiftingWaveletImageFilter<ImageType, ImageType, otb::Wavelet::INVERSE> InvFilterType;
+
+  const unsigned int nbDecompositions = 3;
+
+  ImageType::SizeType size;
+  size[0] = 37;
+  size[1] = 24;
+  ImageType::RegionType region;
+  region.SetSize(size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  ImageType::Pointer constant = ImageType::New();
+  constant->SetRegions(region);
+  constant->Allocate();
+  constant->FillBuffer(3.);
+
+  for (itk::ImageRegionIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const ImageType::IndexType idx = it.GetIndex();
+    it.Set(std::sin(0.3 * idx[0]) * 50. + std::cos(0.7 * idx[1] + idx[0]) * 20. + (idx[0] * idx[1]) % 7);
+  }
+
+  const otb::Wavelet::LiftingScheme schemes[] = {otb::Wavelet::LIFTING_HAAR, otb::Wavelet::LIFTING_CDF_5_3, otb::Wavelet::LIFTING_CDF_9_7};
+
+  bool passed = true;
+  for (unsigned int s = 0; s < 3; ++s)
+  {
+    FwdFilterType::Pointer fwdFilter = FwdFilterType::New();
+    fwdFilter->SetInput(image);
+    fwdFilter->SetScheme(schemes[s]);
+    fwdFilter->SetNumberOfDecompositions(nbDecompositions);
+    fwdFilter->SetBlockSize(4);
+    fwdFilter->SetNumberOfThreads(3);
+
+    InvFilterType::Pointer invFilter = InvFilterType::New();
+    invFilter->SetInput(fwdFilter->GetOutput());
+    invFilter->SetScheme(schemes[s]);
+    invFilter->SetNumberOfDecompositions(nbDecompositions);
+    invFilter->Update();
+
+    double maxError = 0.;
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(image, region); !it.IsAtEnd(); ++it)
+    {
+      maxError = std::max(maxError, std::abs(it.Get() - invFilter->GetOutput()->GetPixel(it.GetIndex())));
+    }
+    if (maxError > 1e-9)
+    {
+      std::cerr << "Scheme " << schemes[s] << ": reconstruction error " << maxError << std::endl;
+      passed = false;
+    }
+
+    // The low pass filters have a gain of sqrt(2) in each direction, and
+    // the coarsest low band is 5 x 3 pixels
+    FwdFilterType::Pointer constantFilter = FwdFilterType::New();
+    constantFilter->SetInput(constant);
+    constantFilter->SetScheme(schemes[s]);
+    constantFilter->SetNumberOfDecompositions(nbDecompositions);
+    constantFilter->Update();
+
+    double maxLowError = 0., maxHigh = 0.;
+    for (itk::ImageRegionConstIteratorWithIndex<ImageType> it(constantFilter->GetOutput(), region); !it.IsAtEnd(); ++it)
+    {
+      if (it.GetIndex()[0] < 5 && it.GetIndex()[1] < 3)
+      {
+        maxLowError = std::max(maxLowError, std::abs(it.Get() - 3. * 8.));
+      }
+      else
+      {
+        maxHigh = std::max(maxHigh, std::abs(it.Get()));
+      }
+    }
+    if (maxLowError > 1e-9 || maxHigh > 1e-9)
+    {
+      std::cerr << "Scheme " << schemes[s] << ": constant image gives low band error " << maxLowError << " and high band coefficients up to " << maxHigh
+                << std::endl;
+      passed = false;
+    }
+  }
+
+  return passed ? EXIT_SUCCESS : EXIT_FAILURE;
+}
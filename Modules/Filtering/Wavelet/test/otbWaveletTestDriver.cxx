@@ -28,4 +28,5 @@ void RegisterTests()
   REGISTER_TEST(otbSubsampleImageFilter);
   REGISTER_TEST(otbWaveletFilterBank);
   REGISTER_TEST(otbWaveletImageToImageFilter);
+  REGISTER_TEST(otbLiftingWaveletImageFilter);
 }
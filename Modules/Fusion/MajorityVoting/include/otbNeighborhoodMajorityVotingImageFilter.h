@@ -29,6 +29,9 @@
 #include "itkMorphologyImageFilter.h"
 #include "itkBinaryBallStructuringElement.h"
 
+#include <algorithm>
+#include <vector>
+
 namespace otb
 {
 
@@ -57,6 +60,14 @@ namespace otb
  *     the image neighbors where the kernel has elements > 0.
  *   - Replace the original label value with the more representative label value
  *
+ * For inputs with at most 65536 distinct labels, the label histogram slides along each row instead:
+ * moving to the next pixel only removes the pixels leaving the structuring element and adds the
+ * entering ones, and the labels are chained by frequency so that the majority label and its
+ * uniqueness are updated in constant time. The output is the same as with Evaluate().
+ * Integer labels spanning a bounded range are stored from the smallest one, the other labels
+ * (sparse or not integer) are remapped to their rank among the sorted labels of the input.
+ * Pixels outside the image are considered as not classified.
+ *
  * \sa MorphologyImageFilter, GrayscaleFunctionDilateImageFilter, BinaryDilateImageFilter
  * \ingroup ImageEnhancement  MathematicalMorphologyImageFilters
  *
@@ -92,6 +103,11 @@ public:
   /** Kernel typedef. */
   typedef typename Superclass::KernelType KernelType;
 
+  /** Region and offset typedefs. */
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+  typedef typename TInputImage::IndexType            IndexType;
+  typedef typename TInputImage::OffsetType           OffsetType;
+
 
   /** Default boundary condition type */
   typedef typename Superclass::DefaultBoundaryConditionType DefaultBoundaryConditionType;
@@ -156,6 +172,12 @@ protected:
 
   void GenerateOutputInformation() override;
 
+  /** Choose between the sliding histogram and Evaluate(), according to the label range */
+  void BeforeThreadedGenerateData() override;
+
+  /** Slide the label histogram along the rows of the region, or call Evaluate() on each pixel */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 
   // Type to store the useful information from the label histogram
   struct HistoSummary
@@ -197,6 +219,91 @@ private:
   // this threshold with the same label
   unsigned int m_IsolatedThreshold;
 
+  // Frequencies of the labels of a neighborhood. Labels with the same
+  // frequency are chained in a doubly linked list starting at Heads[frequency].
+  struct LabelHistogram
+  {
+    std::vector<unsigned int> Counts;
+    std::vector<int>          Previous;
+    std::vector<int>          Next;
+    std::vector<int>          Heads;
+    unsigned int              MaxCount;
+
+    void Link(int label)
+    {
+      const unsigned int count = Counts[label];
+      Previous[label]          = -1;
+      Next[label]              = Heads[count];
+      if (Heads[count] >= 0)
+      {
+        Previous[Heads[count]] = label;
+      }
+      Heads[count] = label;
+    }
+
+    void Unlink(int label)
+    {
+      if (Previous[label] >= 0)
+      {
+        Next[Previous[label]] = Next[label];
+      }
+      else
+      {
+        Heads[Counts[label]] = Next[label];
+      }
+      if (Next[label] >= 0)
+      {
+        Previous[Next[label]] = Previous[label];
+      }
+    }
+
+    void Add(int label)
+    {
+      if (Counts[label] > 0)
+      {
+        Unlink(label);
+      }
+      ++Counts[label];
+      Link(label);
+      MaxCount = std::max(MaxCount, Counts[label]);
+    }
+
+    void Remove(int label)
+    {
+      Unlink(label);
+      --Counts[label];
+      if (Counts[label] > 0)
+      {
+        Link(label);
+      }
+      if (MaxCount > 0 && Heads[MaxCount] < 0)
+      {
+        --MaxCount;
+      }
+    }
+  };
+
+  // Add or remove the labels at the given offsets of the center
+  void UpdateLabelHistogram(LabelHistogram& histogram, const IndexType& center, const std::vector<OffsetType>& offsets, bool add) const;
+
+  // Bin of a classified label in the histogram, and its inverse
+  int GetLabelBin(const PixelType& label) const;
+  PixelType GetBinLabel(int bin) const;
+
+  // Use the sliding histogram for the current input
+  bool m_UseLabelHistogram;
+  // Smallest label of the input, labels are stored from this one
+  PixelType    m_MinLabel;
+  unsigned int m_NumberOfLabels;
+  // Sorted labels of the input when they are remapped to their rank, empty otherwise
+  std::vector<PixelType> m_Labels;
+
+  // Offsets of the structuring element, and those entering (relative to the
+  // new center) and leaving (relative to the old center) when moving along a row
+  std::vector<OffsetType> m_KernelOffsets;
+  std::vector<OffsetType> m_EnteringOffsets;
+  std::vector<OffsetType> m_LeavingOffsets;
+
 }; // end of class
 
 } // end namespace otb
@@ -29,6 +29,12 @@
 #include "itkDefaultConvertPixelTraits.h"
 #include "itkMetaDataObject.h"
 #include "otbMetaDataKey.h"
+#include "itkImageLinearIteratorWithIndex.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkProgressReporter.h"
+
+#include <limits>
+#include <set>
 
 namespace otb
 {
@@ -43,6 +49,9 @@ NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::Neigh
   this->SetKeepOriginalLabelBool(true);                                              // m_KeepOriginalLabelBool = true
   this->SetOnlyIsolatedPixels(false);                                                // process all pixels
   this->SetIsolatedThreshold(1);
+  m_UseLabelHistogram = false;
+  m_MinLabel          = itk::NumericTraits<PixelType>::Zero;
+  m_NumberOfLabels    = 0;
 }
 
 
@@ -129,6 +138,224 @@ NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::Compu
   return result;
 }
 
+template <class TInputImage, class TOutputImage, class TKernel>
+void NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::BeforeThreadedGenerateData()
+{
+  Superclass::BeforeThreadedGenerateData();
+
+  m_UseLabelHistogram = false;
+  m_Labels.clear();
+
+  // Range of the classified labels
+  const TInputImage*                          input = this->GetInput();
+  itk::ImageRegionConstIterator<TInputImage> it(input, input->GetBufferedRegion());
+  bool                                        found    = false;
+  PixelType                                   minLabel = itk::NumericTraits<PixelType>::Zero;
+  PixelType                                   maxLabel = itk::NumericTraits<PixelType>::Zero;
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const PixelType label = it.Get();
+    if (label != m_LabelForNoDataPixels)
+    {
+      minLabel = (!found || label < minLabel) ? label : minLabel;
+      maxLabel = (!found || label > maxLabel) ? label : maxLabel;
+      found    = true;
+    }
+  }
+
+  if (!found)
+  {
+    return;
+  }
+
+  // Bound the memory used by the histogram of each thread
+  const unsigned int maxNumberOfLabels = 65536;
+  if (std::numeric_limits<PixelType>::is_integer && static_cast<double>(maxLabel) - static_cast<double>(minLabel) + 1.0 <= maxNumberOfLabels)
+  {
+    m_MinLabel       = minLabel;
+    m_NumberOfLabels = static_cast<unsigned int>(static_cast<double>(maxLabel) - static_cast<double>(minLabel) + 1.0);
+  }
+  else
+  {
+    // Remap the distinct labels to their rank
+    std::set<PixelType> labels;
+    for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+    {
+      const PixelType label = it.Get();
+      if (label != m_LabelForNoDataPixels && labels.insert(label).second && labels.size() > maxNumberOfLabels)
+      {
+        return;
+      }
+    }
+    m_Labels.assign(labels.begin(), labels.end());
+    m_MinLabel       = minLabel;
+    m_NumberOfLabels = m_Labels.size();
+  }
+  m_UseLabelHistogram = true;
+
+  // Offsets of the structuring element, and the ones that change when moving along a row
+  const KernelType& kernel = this->GetKernel();
+  m_KernelOffsets.clear();
+  m_EnteringOffsets.clear();
+  m_LeavingOffsets.clear();
+  for (unsigned int i = 0; i < kernel.Size(); ++i)
+  {
+    if (kernel[i] > itk::NumericTraits<KernelPixelType>::Zero)
+    {
+      m_KernelOffsets.push_back(kernel.GetOffset(i));
+    }
+  }
+
+  const typename KernelType::SizeType radius = kernel.GetRadius();
+  auto isActive                              = [&](const OffsetType& offset) {
+    for (unsigned int d = 0; d < InputImageDimension; ++d)
+    {
+      if (offset[d] < -static_cast<typename OffsetType::OffsetValueType>(radius[d]) ||
+          offset[d] > static_cast<typename OffsetType::OffsetValueType>(radius[d]))
+      {
+        return false;
+      }
+    }
+    return kernel[kernel.GetNeighborhoodIndex(offset)] > itk::NumericTraits<KernelPixelType>::Zero;
+  };
+
+  OffsetType step;
+  step.Fill(0);
+  step[0] = 1;
+  for (const OffsetType& offset : m_KernelOffsets)
+  {
+    if (!isActive(offset + step))
+    {
+      m_EnteringOffsets.push_back(offset);
+    }
+    if (!isActive(offset - step))
+    {
+      m_LeavingOffsets.push_back(offset);
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+void NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                    itk::ThreadIdType            threadId)
+{
+  if (!m_UseLabelHistogram)
+  {
+    Superclass::ThreadedGenerateData(outputRegionForThread, threadId);
+    return;
+  }
+
+  const TInputImage* input  = this->GetInput();
+  TOutputImage*      output = this->GetOutput();
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  LabelHistogram histogram;
+  histogram.Counts.assign(m_NumberOfLabels, 0);
+  histogram.Previous.assign(m_NumberOfLabels, -1);
+  histogram.Next.assign(m_NumberOfLabels, -1);
+  histogram.Heads.assign(m_KernelOffsets.size() + 1, -1);
+  histogram.MaxCount = 0;
+
+  itk::ImageLinearIteratorWithIndex<TOutputImage> outputIt(output, outputRegionForThread);
+  outputIt.SetDirection(0);
+  outputIt.GoToBegin();
+  while (!outputIt.IsAtEnd())
+  {
+    IndexType center = outputIt.GetIndex();
+    this->UpdateLabelHistogram(histogram, center, m_KernelOffsets, true);
+
+    while (!outputIt.IsAtEndOfLine())
+    {
+      if (outputIt.GetIndex() != center)
+      {
+        this->UpdateLabelHistogram(histogram, center, m_LeavingOffsets, false);
+        center = outputIt.GetIndex();
+        this->UpdateLabelHistogram(histogram, center, m_EnteringOffsets, true);
+      }
+
+      // Same decision as Evaluate()
+      const PixelType centerPixel = input->GetPixel(center);
+      PixelType       result      = centerPixel;
+      if (centerPixel != m_LabelForNoDataPixels && histogram.MaxCount > 0)
+      {
+        const unsigned int freqCenterLabel = histogram.Counts[this->GetLabelBin(centerPixel)];
+        if (!m_OnlyIsolatedPixels || freqCenterLabel <= m_IsolatedThreshold)
+        {
+          const int majorityLabel = histogram.Heads[histogram.MaxCount];
+          if (histogram.Next[majorityLabel] < 0)
+          {
+            result = this->GetBinLabel(majorityLabel);
+          }
+          else if (!m_KeepOriginalLabelBool)
+          {
+            result = m_LabelForUndecidedPixels;
+          }
+        }
+      }
+      outputIt.Set(static_cast<typename TOutputImage::PixelType>(result));
+
+      ++outputIt;
+      progress.CompletedPixel();
+    }
+
+    // Empty the histogram for the next row
+    this->UpdateLabelHistogram(histogram, center, m_KernelOffsets, false);
+    outputIt.NextLine();
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+void NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::UpdateLabelHistogram(LabelHistogram& histogram, const IndexType& center,
+                                                                                                    const std::vector<OffsetType>& offsets, bool add) const
+{
+  const TInputImage*                     input          = this->GetInput();
+  const typename TInputImage::RegionType bufferedRegion = input->GetBufferedRegion();
+  for (const OffsetType& offset : offsets)
+  {
+    const IndexType index = center + offset;
+    if (!bufferedRegion.IsInside(index))
+    {
+      continue;
+    }
+    const PixelType label = input->GetPixel(index);
+    if (label == m_LabelForNoDataPixels)
+    {
+      continue;
+    }
+    const int bin = this->GetLabelBin(label);
+    if (add)
+    {
+      histogram.Add(bin);
+    }
+    else
+    {
+      histogram.Remove(bin);
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+int NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::GetLabelBin(const PixelType& label) const
+{
+  if (m_Labels.empty())
+  {
+    return static_cast<int>(static_cast<long>(label) - static_cast<long>(m_MinLabel));
+  }
+  return static_cast<int>(std::lower_bound(m_Labels.begin(), m_Labels.end(), label) - m_Labels.begin());
+}
+
+template <class TInputImage, class TOutputImage, class TKernel>
+typename NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::PixelType
+NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::GetBinLabel(int bin) const
+{
+  if (m_Labels.empty())
+  {
+    return static_cast<PixelType>(static_cast<long>(m_MinLabel) + bin);
+  }
+  return m_Labels[bin];
+}
+
 template <class TInputImage, class TOutputImage, class TKernel>
 void NeighborhoodMajorityVotingImageFilter<TInputImage, TOutputImage, TKernel>::GenerateOutputInformation()
 {
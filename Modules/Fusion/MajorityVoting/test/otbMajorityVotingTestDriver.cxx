@@ -24,4 +24,5 @@ void RegisterTests()
 {
   REGISTER_TEST(otbNeighborhoodMajorityVotingImageFilterTest);
   REGISTER_TEST(otbNeighborhoodMajorityVotingImageFilterIsolatedTest);
+  REGISTER_TEST(otbNeighborhoodMajorityVotingImageFilterSparseLabelsTest);
 }
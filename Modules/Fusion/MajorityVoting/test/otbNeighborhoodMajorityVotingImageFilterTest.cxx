@@ -27,6 +27,7 @@
 #include "otbImageFileWriter.h"
 
 #include "otbNeighborhoodMajorityVotingImageFilter.h"
+#include "itkImageRegionIterator.h"
 
 
 int otbNeighborhoodMajorityVotingImageFilterTest(int argc, char* argv[])
@@ -206,3 +207,68 @@ int otbNeighborhoodMajorityVotingImageFilterIsolatedTest(int itkNotUsed(argc), c
   }
   return EXIT_SUCCESS;
 }
+
+int otbNeighborhoodMajorityVotingImageFilterSparseLabelsTest(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef unsigned int                  PixelType;
+  typedef otb::Image<PixelType, 2>      ImageType;
+  typedef otb::NeighborhoodMajorityVotingImageFilter<ImageType> NeighborhoodMajorityVotingFilterType;
+  typedef NeighborhoodMajorityVotingFilterType::KernelType StructuringType;
+
+  // Labels 1 to 4 stored from the smallest one, and the same labels spread
+  // over a range too large for that, which are remapped to their rank
+  const PixelType sparseLabels[5] = {0, 3, 100000, 250000, 5000000};
+
+  ImageType::RegionType region;
+  region.SetSize(0, 60);
+  region.SetSize(1, 40);
+
+  ImageType::Pointer denseImage  = ImageType::New();
+  ImageType::Pointer sparseImage = ImageType::New();
+  denseImage->SetRegions(region);
+  denseImage->Allocate();
+  sparseImage->SetRegions(region);
+  sparseImage->Allocate();
+
+  itk::ImageRegionIterator<ImageType> denseIt(denseImage, region);
+  itk::ImageRegionIterator<ImageType> sparseIt(sparseImage, region);
+  unsigned int                        seed = 12345;
+  for (denseIt.GoToBegin(), sparseIt.GoToBegin(); !denseIt.IsAtEnd(); ++denseIt, ++sparseIt)
+  {
+    seed                  = seed * 1103515245 + 12345;
+    const PixelType label = (seed >> 16) % 5;
+    denseIt.Set(label);
+    sparseIt.Set(sparseLabels[label]);
+  }
+
+  StructuringType             seBall;
+  StructuringType::RadiusType rad;
+  rad.Fill(2);
+  seBall.SetRadius(rad);
+  seBall.CreateStructuringElement();
+
+  ImageType::Pointer outputs[2];
+  ImageType::Pointer inputs[2] = {denseImage, sparseImage};
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    NeighborhoodMajorityVotingFilterType::Pointer filter = NeighborhoodMajorityVotingFilterType::New();
+    filter->SetInput(inputs[i]);
+    filter->SetKernel(seBall);
+    filter->SetLabelForNoDataPixels(0);
+    filter->SetKeepOriginalLabelBool(true);
+    filter->Update();
+    outputs[i] = filter->GetOutput();
+  }
+
+  itk::ImageRegionConstIterator<ImageType> denseOutIt(outputs[0], region);
+  itk::ImageRegionConstIterator<ImageType> sparseOutIt(outputs[1], region);
+  for (denseOutIt.GoToBegin(), sparseOutIt.GoToBegin(); !denseOutIt.IsAtEnd(); ++denseOutIt, ++sparseOutIt)
+  {
+    if (sparseLabels[denseOutIt.Get()] != sparseOutIt.Get())
+    {
+      std::cout << "Label " << sparseOutIt.Get() << " instead of " << sparseLabels[denseOutIt.Get()] << " at " << denseOutIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,218 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFusedPanSharpeningImageFilter_h
+#define otbFusedPanSharpeningImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkArray.h"
+
+#include <vector>
+
+namespace otb
+{
+/**
+ * \class FusedPanSharpeningImageFilter
+ * \brief Resample, smooth and fuse Pan and Xs images in a single pass
+ *
+ * This filter computes the same fusions as
+ * SimpleRcsPanSharpeningFusionImageFilter (RCS method):
+ *
+ * \f[ \frac{XS}{\mathrm{Filtered}(PAN)} PAN  \f]
+ *
+ * and LmvmPanSharpeningFusionImageFilter (LMVM method):
+ *
+ * \f[ (PAN - \mathrm{Filtered}(PAN)) \frac{\sigma(XS)}{\sigma(PAN)} + \mathrm{Filtered}(XS)  \f]
+ *
+ * but without any internal pipeline: each thread processes its region by
+ * square blocks of BlockSize pixels, and for each block reads the Pan and
+ * Xs pixels with the margin of the smoothing radius, filters them with a
+ * separable kernel and applies the fusion formula. The intermediate
+ * images of the other filters (smoothed Pan, resampled, smoothed and
+ * local standard deviation Xs) therefore never exist beyond a block.
+ *
+ * The smoothing kernel is the outer product of an horizontal and a
+ * vertical kernel of 2 * radius + 1 coefficients, normalized to a unit
+ * sum. A box kernel is used when they are not set. The local standard
+ * deviations of the LMVM method are computed on a box window of the same
+ * radius, as itk::NoiseImageFilter does.
+ *
+ * When the Xs image has the size of the Pan image, it is assumed to be
+ * already resampled on the Pan grid, as in the other pansharpening
+ * filters. Otherwise it is resampled on the fly with a bilinear
+ * interpolation, the Xs position of each Pan pixel being given by the
+ * origins and spacings of both images. This is suited to Pan and Xs
+ * images already registered in the same geometry (orthorectified or
+ * Pleiades-like bundles). The output has the geometry of the Pan image.
+ *
+ * The no-data values of the Pan and Xs images are handled as in
+ * SimpleRcsPanSharpeningFusionImageFilter by the RCS method.
+ *
+ * TXsImageType and TOutputImageType are expected to be otb::VectorImage
+ * types, and TPanImageType an otb::Image type, of dimension 2.
+ *
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ * \ingroup Fusion
+ *
+ * \sa SimpleRcsPanSharpeningFusionImageFilter
+ * \sa LmvmPanSharpeningFusionImageFilter
+ *
+ * \ingroup OTBPanSharpening
+ */
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision = float>
+class ITK_EXPORT FusedPanSharpeningImageFilter : public itk::ImageToImageFilter<TXsImageType, TOutputImageType>
+{
+public:
+  /** Standard class typedefs */
+  typedef FusedPanSharpeningImageFilter Self;
+  typedef itk::ImageToImageFilter<TXsImageType, TOutputImageType> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through object factory */
+  itkNewMacro(Self);
+
+  /** Run-time type information */
+  itkTypeMacro(FusedPanSharpeningImageFilter, itk::ImageToImageFilter);
+
+  typedef TInternalPrecision                           InternalValueType;
+  typedef typename itk::Array<TInternalPrecision>      ArrayType;
+  typedef typename TPanImageType::SizeType             RadiusType;
+  typedef typename TPanImageType::RegionType           PanImageRegionType;
+  typedef typename TPanImageType::IndexType            PanImageIndexType;
+  typedef typename TXsImageType::RegionType            XsImageRegionType;
+  typedef typename TOutputImageType::RegionType        OutputImageRegionType;
+  typedef typename TOutputImageType::InternalPixelType OutputInternalPixelType;
+
+  /** Fusion formula */
+  enum MethodType
+  {
+    RCS = 0,
+    LMVM
+  };
+
+  itkSetMacro(Method, MethodType);
+  itkGetConstMacro(Method, MethodType);
+
+  /** Set the smoothing filter radius */
+  itkGetMacro(Radius, RadiusType);
+  itkSetMacro(Radius, RadiusType);
+
+  /** Set the 1D kernels of the separable smoothing filter, of
+   * 2 * radius + 1 coefficients each. A box kernel is used when empty */
+  itkSetMacro(HorizontalFilter, ArrayType);
+  itkGetConstReferenceMacro(HorizontalFilter, ArrayType);
+  itkSetMacro(VerticalFilter, ArrayType);
+  itkGetConstReferenceMacro(VerticalFilter, ArrayType);
+
+  /** Side of the square blocks processed at once by each thread */
+  itkSetMacro(BlockSize, unsigned int);
+  itkGetConstMacro(BlockSize, unsigned int);
+
+  virtual void SetPanInput(const TPanImageType* image);
+  const TPanImageType* GetPanInput(void) const;
+
+  virtual void SetXsInput(const TXsImageType* path);
+  const TXsImageType* GetXsInput(void) const;
+
+protected:
+  /** Constructor */
+  FusedPanSharpeningImageFilter();
+
+  /** Destructor */
+  ~FusedPanSharpeningImageFilter() override{};
+
+  /** The output has the geometry of the Pan image and the bands of the Xs image */
+  void GenerateOutputInformation() override;
+
+  /** Pad the requested region by the smoothing radius, and map it to the
+   * Xs grid */
+  void GenerateInputRequestedRegion() override;
+
+  /** Check the kernels and read the no-data values */
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  FusedPanSharpeningImageFilter(Self&); // intentionally not implemented
+  void operator=(const Self&);          // intentionally not implemented
+
+  /** Xs region holding the pixels needed to interpolate a Pan region */
+  XsImageRegionType ComputeXsRegion(const PanImageRegionType& panRegion) const;
+
+  /** Read a block of Pan pixels starting at the given (possibly
+   * outside) index, with a zero flux Neumann boundary condition */
+  void LoadPan(const PanImageIndexType& start, unsigned int width, unsigned int height, InternalValueType* out) const;
+
+  /** Same for the Xs image resampled on the Pan grid, as interleaved
+   * bands */
+  void LoadXs(const PanImageIndexType& start, unsigned int width, unsigned int height, InternalValueType* out) const;
+
+  /** Filter the rows then the columns of a padded block of interleaved
+   * components, of (width + kernelX.size() - 1) x (height + kernelY.size() - 1)
+   * pixels, into a block of width x height pixels */
+  static void SeparableFilter(const InternalValueType* in, unsigned int width, unsigned int height, unsigned int nbComponents,
+                              const std::vector<InternalValueType>& kernelX, const std::vector<InternalValueType>& kernelY, InternalValueType* tmp,
+                              InternalValueType* out);
+
+  /** Fusion formula */
+  MethodType m_Method;
+
+  /** Radius used for the smoothing filter */
+  RadiusType m_Radius;
+
+  /** 1D kernels of the smoothing filter */
+  ArrayType m_HorizontalFilter;
+  ArrayType m_VerticalFilter;
+
+  unsigned int m_BlockSize;
+
+  /** Normalized smoothing and box kernels */
+  std::vector<InternalValueType> m_KernelX;
+  std::vector<InternalValueType> m_KernelY;
+  std::vector<InternalValueType> m_BoxKernelX;
+  std::vector<InternalValueType> m_BoxKernelY;
+  bool                           m_BoxFilter;
+
+  /** Continuous Xs index of a Pan index: offset + scale * index */
+  double m_XsIndexScale[2];
+  double m_XsIndexOffset[2];
+  bool   m_XsOnPanGrid;
+
+  /** No data flags and values */
+  bool                           m_UseNoData;
+  bool                           m_NoDataValuePanAvailable;
+  InternalValueType              m_NoDataValuePan;
+  std::vector<bool>              m_NoDataValuesXsAvailable;
+  std::vector<InternalValueType> m_NoDataValuesXs;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbFusedPanSharpeningImageFilter.hxx"
+#endif
+
+#endif
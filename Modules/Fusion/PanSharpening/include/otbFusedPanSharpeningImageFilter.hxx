@@ -0,0 +1,603 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFusedPanSharpeningImageFilter_hxx
+#define otbFusedPanSharpeningImageFilter_hxx
+
+#include "otbFusedPanSharpeningImageFilter.h"
+#include "itkMetaDataObject.h"
+#include "itkProgressReporter.h"
+#include "otbMetaDataKey.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::FusedPanSharpeningImageFilter()
+  : m_Method(RCS), m_BlockSize(64), m_BoxFilter(true), m_XsOnPanGrid(true), m_UseNoData(false), m_NoDataValuePanAvailable(false), m_NoDataValuePan(0)
+{
+  // Fix number of required inputs
+  this->SetNumberOfRequiredInputs(2);
+
+  // Set-up default parameters
+  m_Radius.Fill(3);
+  m_XsIndexScale[0] = m_XsIndexScale[1] = 1.;
+  m_XsIndexOffset[0] = m_XsIndexOffset[1] = 0.;
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::SetPanInput(const TPanImageType* image)
+{
+  // We have 2 inputs:  an image and a vector image
+
+  // Process object is not const-correct so the const_cast is required here
+  this->itk::ProcessObject::SetNthInput(1, const_cast<TPanImageType*>(image));
+  this->Modified();
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+const TPanImageType* FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::GetPanInput(void) const
+{
+  if (this->GetNumberOfInputs() < 2)
+  {
+    return nullptr;
+  }
+
+  return static_cast<const TPanImageType*>(this->itk::ProcessObject::GetInput(1));
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::SetXsInput(const TXsImageType* image)
+{
+  // Process object is not const-correct so the const_cast is required here
+  this->itk::ProcessObject::SetNthInput(0, const_cast<TXsImageType*>(image));
+  this->Modified();
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+const TXsImageType* FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::GetXsInput(void) const
+{
+  if (this->GetNumberOfInputs() < 1)
+  {
+    return nullptr;
+  }
+
+  return static_cast<const TXsImageType*>(this->itk::ProcessObject::GetInput(0));
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::GenerateOutputInformation()
+{
+  // Bands and metadata of the Xs image
+  Superclass::GenerateOutputInformation();
+
+  const TPanImageType* pan = this->GetPanInput();
+  const TXsImageType*  xs  = this->GetXsInput();
+  if (!pan || !xs)
+  {
+    return;
+  }
+
+  // Geometry of the Pan image
+  TOutputImageType* output = this->GetOutput();
+  output->SetLargestPossibleRegion(pan->GetLargestPossibleRegion());
+  output->SetOrigin(pan->GetOrigin());
+  output->SetSignedSpacing(pan->GetSignedSpacing());
+  output->SetNumberOfComponentsPerPixel(xs->GetNumberOfComponentsPerPixel());
+
+  // Position of the Pan pixels in the Xs grid
+  const PanImageRegionType& panLargest = pan->GetLargestPossibleRegion();
+  const XsImageRegionType&  xsLargest  = xs->GetLargestPossibleRegion();
+  if (panLargest.GetSize() == xsLargest.GetSize())
+  {
+    // Xs already resampled on the Pan grid
+    m_XsOnPanGrid = true;
+    for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+      m_XsIndexScale[dim]  = 1.;
+      m_XsIndexOffset[dim] = xsLargest.GetIndex()[dim] - panLargest.GetIndex()[dim];
+    }
+    return;
+  }
+
+  m_XsOnPanGrid = true;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    const double xsSpacing = xs->GetSignedSpacing()[dim];
+    m_XsIndexScale[dim]    = pan->GetSignedSpacing()[dim] / xsSpacing;
+    m_XsIndexOffset[dim]   = (pan->GetOrigin()[dim] - xs->GetOrigin()[dim]) / xsSpacing;
+
+    // Identical grids up to an integer shift do not need any interpolation
+    if (std::abs(m_XsIndexScale[dim] - 1.) > 1e-9 || std::abs(m_XsIndexOffset[dim] - std::round(m_XsIndexOffset[dim])) > 1e-6)
+    {
+      m_XsOnPanGrid = false;
+    }
+  }
+  if (m_XsOnPanGrid)
+  {
+    for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+      m_XsIndexScale[dim]  = 1.;
+      m_XsIndexOffset[dim] = std::round(m_XsIndexOffset[dim]);
+    }
+  }
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+typename FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::XsImageRegionType
+FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::ComputeXsRegion(const PanImageRegionType& panRegion) const
+{
+  const XsImageRegionType& xsLargest = this->GetXsInput()->GetLargestPossibleRegion();
+
+  typename XsImageRegionType::IndexType index;
+  typename XsImageRegionType::SizeType  size;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    const double first = m_XsIndexOffset[dim] + m_XsIndexScale[dim] * panRegion.GetIndex()[dim];
+    const double last  = m_XsIndexOffset[dim] + m_XsIndexScale[dim] * (panRegion.GetIndex()[dim] + static_cast<long>(panRegion.GetSize()[dim]) - 1);
+
+    long lo = static_cast<long>(std::floor(std::min(first, last)));
+    long hi = static_cast<long>(std::floor(std::max(first, last)));
+    if (!m_XsOnPanGrid)
+    {
+      // Second pixel of the bilinear interpolation
+      ++hi;
+    }
+
+    const long xsFirst = xsLargest.GetIndex()[dim];
+    const long xsLast  = xsFirst + static_cast<long>(xsLargest.GetSize()[dim]) - 1;
+    lo                 = std::min(std::max(lo, xsFirst), xsLast);
+    hi                 = std::min(std::max(hi, xsFirst), xsLast);
+
+    index[dim] = lo;
+    size[dim]  = hi - lo + 1;
+  }
+  return XsImageRegionType(index, size);
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::GenerateInputRequestedRegion()
+{
+  TPanImageType* pan = const_cast<TPanImageType*>(this->GetPanInput());
+  TXsImageType*  xs  = const_cast<TXsImageType*>(this->GetXsInput());
+  if (!pan || !xs)
+  {
+    return;
+  }
+
+  // Pan pixels of the smoothing windows
+  const OutputImageRegionType& outputRequested = this->GetOutput()->GetRequestedRegion();
+  PanImageRegionType           panRegion       = outputRequested;
+  panRegion.PadByRadius(m_Radius);
+  if (!panRegion.Crop(pan->GetLargestPossibleRegion()))
+  {
+    itkExceptionMacro(<< "The requested region is outside the Pan image");
+  }
+  pan->SetRequestedRegion(panRegion);
+
+  // Xs pixels of the smoothing windows (LMVM) or of the output pixels only (RCS)
+  PanImageRegionType xsPanRegion = outputRequested;
+  if (m_Method == LMVM)
+  {
+    xsPanRegion = panRegion;
+  }
+  xs->SetRequestedRegion(ComputeXsRegion(xsPanRegion));
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::BeforeThreadedGenerateData()
+{
+  if (m_BlockSize == 0)
+  {
+    itkExceptionMacro(<< "The block size must be positive");
+  }
+
+  // Normalized separable kernels
+  auto setupKernel = [this](const ArrayType& coefficients, unsigned int radius, std::vector<InternalValueType>& kernel,
+                            std::vector<InternalValueType>& boxKernel) {
+    const unsigned int size = 2 * radius + 1;
+    if (coefficients.Size() == 0)
+    {
+      kernel.assign(size, 1.);
+    }
+    else if (coefficients.Size() != size)
+    {
+      itkExceptionMacro(<< "The smoothing filters must have 2 * radius + 1 coefficients, got " << coefficients.Size() << " instead of " << size);
+    }
+    else
+    {
+      kernel.assign(coefficients.begin(), coefficients.end());
+    }
+
+    InternalValueType sum = 0.;
+    for (const auto& coefficient : kernel)
+    {
+      sum += coefficient;
+    }
+    if (sum != 0.)
+    {
+      for (auto& coefficient : kernel)
+      {
+        coefficient /= sum;
+      }
+    }
+    boxKernel.assign(size, static_cast<InternalValueType>(1. / size));
+    return std::all_of(kernel.begin(), kernel.end(), [&kernel](InternalValueType c) { return c == kernel[0]; });
+  };
+  const bool boxX = setupKernel(m_HorizontalFilter, m_Radius[0], m_KernelX, m_BoxKernelX);
+  const bool boxY = setupKernel(m_VerticalFilter, m_Radius[1], m_KernelY, m_BoxKernelY);
+  m_BoxFilter     = boxX && boxY;
+
+  // No-data flags of the Pan image
+  std::vector<bool>   tmpNoDataValuePanAvailable;
+  std::vector<double> tmpNoDataValuePan;
+  m_NoDataValuePanAvailable = false;
+  m_NoDataValuePan          = 0;
+
+  bool retPan =
+      itk::ExposeMetaData<std::vector<bool>>(this->GetPanInput()->GetMetaDataDictionary(), MetaDataKey::NoDataValueAvailable, tmpNoDataValuePanAvailable);
+  retPan &= itk::ExposeMetaData<std::vector<double>>(this->GetPanInput()->GetMetaDataDictionary(), MetaDataKey::NoDataValue, tmpNoDataValuePan);
+
+  if (retPan && tmpNoDataValuePanAvailable.size() > 0 && tmpNoDataValuePan.size() > 0)
+  {
+    m_NoDataValuePanAvailable = tmpNoDataValuePanAvailable[0];
+    m_NoDataValuePan          = static_cast<InternalValueType>(static_cast<typename TPanImageType::InternalPixelType>(tmpNoDataValuePan[0]));
+  }
+
+  // No-data flags of the Xs image
+  std::vector<double> tmpNoDataValuesXs;
+  m_NoDataValuesXsAvailable.clear();
+  m_NoDataValuesXs.clear();
+
+  bool retXs =
+      itk::ExposeMetaData<std::vector<bool>>(this->GetXsInput()->GetMetaDataDictionary(), MetaDataKey::NoDataValueAvailable, m_NoDataValuesXsAvailable);
+  retXs &= itk::ExposeMetaData<std::vector<double>>(this->GetXsInput()->GetMetaDataDictionary(), MetaDataKey::NoDataValue, tmpNoDataValuesXs);
+
+  m_UseNoData = m_NoDataValuePanAvailable;
+  if (retXs)
+  {
+    m_NoDataValuesXsAvailable.resize(std::min(m_NoDataValuesXsAvailable.size(), tmpNoDataValuesXs.size()));
+    for (unsigned int i = 0; i < m_NoDataValuesXsAvailable.size(); ++i)
+    {
+      m_NoDataValuesXs.push_back(static_cast<InternalValueType>(static_cast<typename TXsImageType::InternalPixelType>(tmpNoDataValuesXs[i])));
+      m_UseNoData |= m_NoDataValuesXsAvailable[i];
+    }
+  }
+  else
+  {
+    m_NoDataValuesXsAvailable.clear();
+  }
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::LoadPan(const PanImageIndexType& start,
+                                                                                                                unsigned int width, unsigned int height,
+                                                                                                                InternalValueType* out) const
+{
+  const TPanImageType* pan = this->GetPanInput();
+
+  // The buffered region holds the requested region, which is the padded
+  // output region cropped by the largest region: clamping to it gives
+  // the zero flux Neumann boundary condition
+  const PanImageRegionType& buffered = pan->GetBufferedRegion();
+  const auto                buffer   = pan->GetBufferPointer();
+  const long                firstX   = buffered.GetIndex()[0];
+  const long                firstY   = buffered.GetIndex()[1];
+  const long                lastX    = firstX + static_cast<long>(buffered.GetSize()[0]) - 1;
+  const long                lastY    = firstY + static_cast<long>(buffered.GetSize()[1]) - 1;
+
+  for (unsigned int r = 0; r < height; ++r)
+  {
+    const long y   = std::min(std::max(start[1] + static_cast<long>(r), firstY), lastY);
+    const auto row = buffer + (y - firstY) * buffered.GetSize()[0];
+    for (unsigned int c = 0; c < width; ++c)
+    {
+      const long x       = std::min(std::max(start[0] + static_cast<long>(c), firstX), lastX);
+      out[r * width + c] = static_cast<InternalValueType>(row[x - firstX]);
+    }
+  }
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::LoadXs(const PanImageIndexType& start,
+                                                                                                               unsigned int width, unsigned int height,
+                                                                                                               InternalValueType* out) const
+{
+  const TXsImageType*       xs          = this->GetXsInput();
+  const unsigned int        nbBands     = xs->GetNumberOfComponentsPerPixel();
+  const PanImageRegionType& panLargest  = this->GetPanInput()->GetLargestPossibleRegion();
+  const XsImageRegionType&  buffered    = xs->GetBufferedRegion();
+  const auto                buffer      = xs->GetBufferPointer();
+  const long                lineLength  = buffered.GetSize()[0];
+  const long                firstPan[2] = {panLargest.GetIndex()[0], panLargest.GetIndex()[1]};
+  const long lastPan[2] = {firstPan[0] + static_cast<long>(panLargest.GetSize()[0]) - 1, firstPan[1] + static_cast<long>(panLargest.GetSize()[1]) - 1};
+  const long firstXs[2] = {buffered.GetIndex()[0], buffered.GetIndex()[1]};
+  const long lastXs[2]  = {firstXs[0] + static_cast<long>(buffered.GetSize()[0]) - 1, firstXs[1] + static_cast<long>(buffered.GetSize()[1]) - 1};
+
+  // Xs position of a Pan index, the Pan index being clamped first so that
+  // the boundary condition applies to the resampled image
+  auto xsPosition = [&](unsigned int dim, long panIndex) {
+    return m_XsIndexOffset[dim] + m_XsIndexScale[dim] * std::min(std::max(panIndex, firstPan[dim]), lastPan[dim]);
+  };
+  auto clampXs = [&](unsigned int dim, long xsIndex) { return std::min(std::max(xsIndex, firstXs[dim]), lastXs[dim]) - firstXs[dim]; };
+
+  if (m_XsOnPanGrid)
+  {
+    for (unsigned int r = 0; r < height; ++r)
+    {
+      const long y   = clampXs(1, static_cast<long>(xsPosition(1, start[1] + r)));
+      const auto row = buffer + y * lineLength * nbBands;
+      for (unsigned int c = 0; c < width; ++c)
+      {
+        const auto pixel = row + clampXs(0, static_cast<long>(xsPosition(0, start[0] + c))) * nbBands;
+        for (unsigned int b = 0; b < nbBands; ++b)
+        {
+          out[(r * width + c) * nbBands + b] = static_cast<InternalValueType>(pixel[b]);
+        }
+      }
+    }
+    return;
+  }
+
+  // Bilinear interpolation, with the columns computed once for the block
+  std::vector<long>              columns0(width), columns1(width);
+  std::vector<InternalValueType> weights(width);
+  for (unsigned int c = 0; c < width; ++c)
+  {
+    const double position = xsPosition(0, start[0] + c);
+    const long   x        = static_cast<long>(std::floor(position));
+    columns0[c]           = clampXs(0, x) * nbBands;
+    columns1[c]           = clampXs(0, x + 1) * nbBands;
+    weights[c]            = static_cast<InternalValueType>(position - x);
+  }
+
+  for (unsigned int r = 0; r < height; ++r)
+  {
+    const double            position = xsPosition(1, start[1] + r);
+    const long              y        = static_cast<long>(std::floor(position));
+    const InternalValueType fy       = static_cast<InternalValueType>(position - y);
+    const auto              row0     = buffer + clampXs(1, y) * lineLength * nbBands;
+    const auto              row1     = buffer + clampXs(1, y + 1) * lineLength * nbBands;
+    for (unsigned int c = 0; c < width; ++c)
+    {
+      const InternalValueType fx = weights[c];
+      for (unsigned int b = 0; b < nbBands; ++b)
+      {
+        const InternalValueType top    = (1 - fx) * row0[columns0[c] + b] + fx * row0[columns1[c] + b];
+        const InternalValueType bottom = (1 - fx) * row1[columns0[c] + b] + fx * row1[columns1[c] + b];
+        out[(r * width + c) * nbBands + b] = (1 - fy) * top + fy * bottom;
+      }
+    }
+  }
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::SeparableFilter(
+    const InternalValueType* in, unsigned int width, unsigned int height, unsigned int nbComponents, const std::vector<InternalValueType>& kernelX,
+    const std::vector<InternalValueType>& kernelY, InternalValueType* tmp, InternalValueType* out)
+{
+  const unsigned int paddedWidth  = width + kernelX.size() - 1;
+  const unsigned int paddedHeight = height + kernelY.size() - 1;
+  const unsigned int lineLength   = width * nbComponents;
+
+  // Rows
+  for (unsigned int r = 0; r < paddedHeight; ++r)
+  {
+    const InternalValueType* inRow  = in + r * paddedWidth * nbComponents;
+    InternalValueType*       tmpRow = tmp + r * lineLength;
+    std::fill(tmpRow, tmpRow + lineLength, InternalValueType(0));
+    for (unsigned int d = 0; d < kernelX.size(); ++d)
+    {
+      const InternalValueType  weight  = kernelX[d];
+      const InternalValueType* shifted = inRow + d * nbComponents;
+      for (unsigned int i = 0; i < lineLength; ++i)
+      {
+        tmpRow[i] += weight * shifted[i];
+      }
+    }
+  }
+
+  // Columns
+  for (unsigned int r = 0; r < height; ++r)
+  {
+    InternalValueType* outRow = out + r * lineLength;
+    std::fill(outRow, outRow + lineLength, InternalValueType(0));
+    for (unsigned int d = 0; d < kernelY.size(); ++d)
+    {
+      const InternalValueType  weight = kernelY[d];
+      const InternalValueType* tmpRow = tmp + (r + d) * lineLength;
+      for (unsigned int i = 0; i < lineLength; ++i)
+      {
+        outRow[i] += weight * tmpRow[i];
+      }
+    }
+  }
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::ThreadedGenerateData(
+    const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  TOutputImageType*            output       = this->GetOutput();
+  const unsigned int           nbBands      = this->GetXsInput()->GetNumberOfComponentsPerPixel();
+  const OutputImageRegionType& outBuffered  = output->GetBufferedRegion();
+  OutputInternalPixelType*     outBuffer    = output->GetBufferPointer();
+  const bool                   lmvm         = (m_Method == LMVM);
+  const unsigned int           rx           = m_Radius[0];
+  const unsigned int           ry           = m_Radius[1];
+  const unsigned int           maxBlockSize = m_BlockSize * m_BlockSize;
+  const unsigned int           maxPadded    = (m_BlockSize + 2 * rx) * (m_BlockSize + 2 * ry);
+
+  // Unbiased local variance, as computed by itk::NoiseImageFilter
+  const double windowSize    = (2. * rx + 1.) * (2. * ry + 1.);
+  const double varianceScale = windowSize > 1. ? windowSize / (windowSize - 1.) : 0.;
+
+  // Block buffers, allocated once per thread
+  std::vector<InternalValueType> panBlock(maxPadded), smoothPan(maxBlockSize);
+  std::vector<InternalValueType> tmp((m_BlockSize + 2 * ry) * m_BlockSize * nbBands);
+  std::vector<InternalValueType> xsBlock((lmvm ? maxPadded : maxBlockSize) * nbBands);
+  std::vector<InternalValueType> squares, smoothXs, meanPan, meanPan2, meanXs, meanXs2;
+  if (lmvm)
+  {
+    squares.resize(maxPadded * nbBands);
+    smoothXs.resize(maxBlockSize * nbBands);
+    meanPan2.resize(maxBlockSize);
+    meanXs2.resize(maxBlockSize * nbBands);
+    if (!m_BoxFilter)
+    {
+      meanPan.resize(maxBlockSize);
+      meanXs.resize(maxBlockSize * nbBands);
+    }
+  }
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  const long startX = outputRegionForThread.GetIndex()[0];
+  const long startY = outputRegionForThread.GetIndex()[1];
+  const long endX   = startX + static_cast<long>(outputRegionForThread.GetSize()[0]);
+  const long endY   = startY + static_cast<long>(outputRegionForThread.GetSize()[1]);
+
+  for (long y0 = startY; y0 < endY; y0 += m_BlockSize)
+  {
+    const unsigned int height = std::min<long>(m_BlockSize, endY - y0);
+    for (long x0 = startX; x0 < endX; x0 += m_BlockSize)
+    {
+      const unsigned int width       = std::min<long>(m_BlockSize, endX - x0);
+      const unsigned int paddedWidth = width + 2 * rx;
+      const unsigned int paddedSize  = paddedWidth * (height + 2 * ry);
+
+      PanImageIndexType blockStart, paddedStart;
+      blockStart[0]  = x0;
+      blockStart[1]  = y0;
+      paddedStart[0] = x0 - rx;
+      paddedStart[1] = y0 - ry;
+
+      LoadPan(paddedStart, paddedWidth, height + 2 * ry, panBlock.data());
+      SeparableFilter(panBlock.data(), width, height, 1, m_KernelX, m_KernelY, tmp.data(), smoothPan.data());
+
+      const InternalValueType* meanPanPtr = smoothPan.data();
+      const InternalValueType* meanXsPtr  = smoothXs.data();
+      if (lmvm)
+      {
+        LoadXs(paddedStart, paddedWidth, height + 2 * ry, xsBlock.data());
+        SeparableFilter(xsBlock.data(), width, height, nbBands, m_KernelX, m_KernelY, tmp.data(), smoothXs.data());
+
+        // Box means of the values and of their squares give the local
+        // standard deviations. The means of the values are the smoothed
+        // values when the smoothing kernel is a box.
+        if (!m_BoxFilter)
+        {
+          SeparableFilter(panBlock.data(), width, height, 1, m_BoxKernelX, m_BoxKernelY, tmp.data(), meanPan.data());
+          SeparableFilter(xsBlock.data(), width, height, nbBands, m_BoxKernelX, m_BoxKernelY, tmp.data(), meanXs.data());
+          meanPanPtr = meanPan.data();
+          meanXsPtr  = meanXs.data();
+        }
+        for (unsigned int i = 0; i < paddedSize; ++i)
+        {
+          squares[i] = panBlock[i] * panBlock[i];
+        }
+        SeparableFilter(squares.data(), width, height, 1, m_BoxKernelX, m_BoxKernelY, tmp.data(), meanPan2.data());
+        for (unsigned int i = 0; i < paddedSize * nbBands; ++i)
+        {
+          squares[i] = xsBlock[i] * xsBlock[i];
+        }
+        SeparableFilter(squares.data(), width, height, nbBands, m_BoxKernelX, m_BoxKernelY, tmp.data(), meanXs2.data());
+      }
+      else
+      {
+        LoadXs(blockStart, width, height, xsBlock.data());
+      }
+
+      // Fusion
+      for (unsigned int r = 0; r < height; ++r)
+      {
+        OutputInternalPixelType* outRow =
+            outBuffer + ((y0 + r - outBuffered.GetIndex()[1]) * outBuffered.GetSize()[0] + (x0 - outBuffered.GetIndex()[0])) * nbBands;
+        const InternalValueType* panRow = panBlock.data() + (r + ry) * paddedWidth + rx;
+
+        for (unsigned int c = 0; c < width; ++c)
+        {
+          const unsigned int       i      = r * width + c;
+          const InternalValueType  p      = panRow[c];
+          const InternalValueType  sp     = smoothPan[i];
+          OutputInternalPixelType* outPix = outRow + c * nbBands;
+
+          if (lmvm)
+          {
+            const InternalValueType mp     = meanPanPtr[i];
+            const InternalValueType stdPan = std::sqrt(std::max(0., varianceScale * (meanPan2[i] - mp * mp)));
+            InternalValueType       scale  = 1.;
+            if (std::abs(stdPan) > 1e-10)
+            {
+              scale = 1.0 / stdPan;
+            }
+            for (unsigned int b = 0; b < nbBands; ++b)
+            {
+              const InternalValueType mxs   = meanXsPtr[i * nbBands + b];
+              const InternalValueType stdXs = std::sqrt(std::max(0., varianceScale * (meanXs2[i * nbBands + b] - mxs * mxs)));
+              outPix[b]                     = static_cast<OutputInternalPixelType>((p - sp) * stdXs * scale + smoothXs[i * nbBands + b]);
+            }
+          }
+          else
+          {
+            const InternalValueType* xsPix = xsBlock.data() + i * nbBands;
+            if (m_NoDataValuePanAvailable && p == m_NoDataValuePan)
+            {
+              for (unsigned int b = 0; b < nbBands; ++b)
+              {
+                outPix[b] = static_cast<OutputInternalPixelType>(b < m_NoDataValuesXs.size() ? m_NoDataValuesXs[b] : xsPix[b]);
+              }
+            }
+            else
+            {
+              InternalValueType scale = 1.;
+              if (std::abs(sp) > 1e-10)
+              {
+                scale = p / sp;
+              }
+              for (unsigned int b = 0; b < nbBands; ++b)
+              {
+                const bool noData = m_UseNoData && b < m_NoDataValuesXsAvailable.size() && m_NoDataValuesXsAvailable[b] && xsPix[b] == m_NoDataValuesXs[b];
+                outPix[b]         = static_cast<OutputInternalPixelType>(noData ? xsPix[b] : xsPix[b] * scale);
+              }
+            }
+          }
+          progress.CompletedPixel();
+        }
+      }
+    }
+  }
+}
+
+template <class TPanImageType, class TXsImageType, class TOutputImageType, class TInternalPrecision>
+void FusedPanSharpeningImageFilter<TPanImageType, TXsImageType, TOutputImageType, TInternalPrecision>::PrintSelf(std::ostream& os,
+                                                                                                                  itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Method: " << (m_Method == LMVM ? "LMVM" : "RCS") << std::endl;
+  os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "Block size: " << m_BlockSize << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -25,4 +25,5 @@ void RegisterTests()
   REGISTER_TEST(otbSimpleRcsPanSharpeningFusionImageFilter);
   REGISTER_TEST(otbBayesianFusionFilter);
   REGISTER_TEST(otbLmvmPanSharpeningFusionImageFilter);
+  REGISTER_TEST(otbFusedPanSharpeningImageFilter);
 }
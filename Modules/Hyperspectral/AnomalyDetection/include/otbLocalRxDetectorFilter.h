@@ -146,6 +146,93 @@ public:
 };
 
 } // end namespace functor
+
+/** \class LocalRxDetectorFilter
+ * \brief Computes the local Rx score of each pixel of a vector image.
+ *
+ * The score is the same as the one of LocalRxDetectionFunctor: statistics
+ * are computed on the pixels of the external window that are outside the
+ * internal window, pixels outside the image being replaced by the nearest
+ * image pixel.
+ *
+ * Instead of gathering the neighbourhood of each pixel, the filter keeps the
+ * first and second order sums of the window columns up to date while moving
+ * from one row to the next, and slides the window sums along each row by
+ * adding the entering column and removing the leaving one. The covariance
+ * matrix of each window is then factorised with a Cholesky decomposition,
+ * without being inverted. Columns are processed by strips, so that the
+ * column sums of a thread fit in MaximumColumnSumsSize bytes.
+ *
+ * \ingroup Streamed
+ * \ingroup Threaded
+ *
+ * \ingroup OTBAnomalyDetection
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT LocalRxDetectorFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef LocalRxDetectorFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(LocalRxDetectorFilter, ImageToImageFilter);
+
+  /** Image typedefs */
+  typedef TInputImage                                InputImageType;
+  typedef typename InputImageType::RegionType        InputRegionType;
+  typedef typename InputImageType::IndexType         IndexType;
+  typedef typename InputImageType::SizeType          SizeType;
+  typedef typename InputImageType::InternalPixelType InputInternalPixelType;
+  typedef TOutputImage                               OutputImageType;
+  typedef typename OutputImageType::RegionType       OutputRegionType;
+  typedef typename OutputImageType::PixelType        OutputPixelType;
+
+  /** Set/Get the radius of the window the statistics are computed on */
+  itkSetMacro(ExternalRadius, SizeType);
+  itkGetConstReferenceMacro(ExternalRadius, SizeType);
+
+  /** Set/Get the radius of the window excluded from the statistics */
+  itkSetMacro(InternalRadius, SizeType);
+  itkGetConstReferenceMacro(InternalRadius, SizeType);
+
+  /** Set/Get the maximum size of the column sums of a thread, in bytes */
+  itkSetMacro(MaximumColumnSumsSize, unsigned long);
+  itkGetMacro(MaximumColumnSumsSize, unsigned long);
+
+protected:
+  LocalRxDetectorFilter();
+  ~LocalRxDetectorFilter() override
+  {
+  }
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  void GenerateInputRequestedRegion() override;
+
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  LocalRxDetectorFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  SizeType      m_ExternalRadius;
+  SizeType      m_InternalRadius;
+  unsigned long m_MaximumColumnSumsSize;
+};
+
 } // end namespace otb
 
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbLocalRxDetectorFilter.hxx"
+#endif
+
 #endif
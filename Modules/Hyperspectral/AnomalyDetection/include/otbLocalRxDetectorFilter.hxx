@@ -0,0 +1,362 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLocalRxDetectorFilter_hxx
+#define otbLocalRxDetectorFilter_hxx
+
+#include "otbLocalRxDetectorFilter.h"
+#include "itkProgressReporter.h"
+#include "vnl/algo/vnl_svd.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+LocalRxDetectorFilter<TInputImage, TOutputImage>::LocalRxDetectorFilter() : m_MaximumColumnSumsSize(64 * 1024 * 1024)
+{
+  m_ExternalRadius.Fill(5);
+  m_InternalRadius.Fill(1);
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  InputRegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(m_ExternalRadius);
+
+  if (inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+    return;
+  }
+
+  // Store what we tried to request (prior to trying to crop)
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+  itk::InvalidRequestedRegionError e(__FILE__, __LINE__);
+  e.SetLocation(ITK_LOCATION);
+  e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+  e.SetDataObject(inputPtr);
+  throw e;
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  unsigned long nbExternalPixels = 1;
+  unsigned long nbInternalPixels = 1;
+  for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+  {
+    nbExternalPixels *= 2 * m_ExternalRadius[dim] + 1;
+    nbInternalPixels *= 2 * std::min(m_InternalRadius[dim], m_ExternalRadius[dim]) + 1;
+  }
+
+  if (nbExternalPixels - nbInternalPixels < 2)
+  {
+    itkExceptionMacro(<< "The external window must contain at least two pixels outside the internal window");
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputRegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  // Support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  if (outputRegionForThread.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  const InputImageType* inputPtr  = this->GetInput();
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  const unsigned int nbBands = inputPtr->GetNumberOfComponentsPerPixel();
+  const std::size_t  nbTerms = nbBands * (nbBands + 1) / 2;
+
+  const long extRadiusX = m_ExternalRadius[0];
+  const long extRadiusY = m_ExternalRadius[1];
+  const long intRadiusX = std::min(m_InternalRadius[0], m_ExternalRadius[0]);
+  const long intRadiusY = std::min(m_InternalRadius[1], m_ExternalRadius[1]);
+
+  const double nbPixels = (2 * extRadiusX + 1) * (2 * extRadiusY + 1) - (2 * intRadiusX + 1) * (2 * intRadiusY + 1);
+
+  // Pixels outside the buffered region are replaced by the nearest one
+  const InputRegionType&        bufferedRegion = inputPtr->GetBufferedRegion();
+  const long                    bufferX0       = bufferedRegion.GetIndex(0);
+  const long                    bufferY0       = bufferedRegion.GetIndex(1);
+  const long                    bufferX1       = bufferX0 + static_cast<long>(bufferedRegion.GetSize(0)) - 1;
+  const long                    bufferY1       = bufferY0 + static_cast<long>(bufferedRegion.GetSize(1)) - 1;
+  const InputInternalPixelType* buffer         = inputPtr->GetBufferPointer();
+
+  // Pixel values are shifted by a pixel of the region, which limits the
+  // cancellation when the covariance is derived from the sums
+  std::vector<double> shift(nbBands, 0.);
+  auto readPixel = [&](long x, long y, double* value) {
+    x = std::min(std::max(x, bufferX0), bufferX1);
+    y = std::min(std::max(y, bufferY0), bufferY1);
+    const InputInternalPixelType* pixel = buffer + ((y - bufferY0) * bufferedRegion.GetSize(0) + (x - bufferX0)) * nbBands;
+    for (unsigned int b = 0; b < nbBands; ++b)
+    {
+      value[b] = static_cast<double>(pixel[b]) - shift[b];
+    }
+  };
+
+  // Second order sums are stored as packed upper triangles
+  auto addPixel = [&](const double* value, double sign, double* sum1, double* sum2) {
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      sum1[i] += sign * value[i];
+      const double vi = sign * value[i];
+      for (unsigned int j = i; j < nbBands; ++j)
+      {
+        *sum2++ += vi * value[j];
+      }
+    }
+  };
+  auto addColumn = [&](const double* column1, const double* column2, double sign, double* sum1, double* sum2) {
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      sum1[i] += sign * column1[i];
+    }
+    for (std::size_t t = 0; t < nbTerms; ++t)
+    {
+      sum2[t] += sign * column2[t];
+    }
+  };
+
+  const long x0 = outputRegionForThread.GetIndex(0);
+  const long y0 = outputRegionForThread.GetIndex(1);
+  const long x1 = x0 + static_cast<long>(outputRegionForThread.GetSize(0)) - 1;
+  const long y1 = y0 + static_cast<long>(outputRegionForThread.GetSize(1)) - 1;
+
+  readPixel(x0, y0, shift.data());
+
+  // Strips of output columns whose external and internal column sums fit in
+  // the memory budget
+  const unsigned long columnSize = 2 * (nbBands + nbTerms) * sizeof(double);
+  const long          stripWidth = std::max(1L, static_cast<long>(m_MaximumColumnSumsSize / columnSize) - 2 * extRadiusX);
+
+  std::vector<double> value(nbBands), mean(nbBands), centred(nbBands);
+  std::vector<double> window1(nbBands), window2(nbTerms), inner1(nbBands), inner2(nbTerms);
+  std::vector<double> cholesky(nbBands * nbBands);
+  std::vector<double> extColumns1, extColumns2, intColumns1, intColumns2;
+
+  IndexType index;
+  for (long stripX0 = x0; stripX0 <= x1; stripX0 += stripWidth)
+  {
+    const long stripX1   = std::min(x1, stripX0 + stripWidth - 1);
+    const long columnX0  = stripX0 - extRadiusX;
+    const long nbColumns = stripX1 - stripX0 + 1 + 2 * extRadiusX;
+
+    // Internal column sums are only needed away from the strip edges
+    const long intColumn0 = extRadiusX - intRadiusX;
+    const long intColumn1 = nbColumns - 1 - intColumn0;
+
+    extColumns1.assign(nbColumns * nbBands, 0.);
+    extColumns2.assign(nbColumns * nbTerms, 0.);
+    intColumns1.assign(nbColumns * nbBands, 0.);
+    intColumns2.assign(nbColumns * nbTerms, 0.);
+
+    for (long y = y0; y <= y1; ++y)
+    {
+      // Column sums: full windows for the first row, then one row enters
+      // and one row leaves each column
+      for (long c = 0; c < nbColumns; ++c)
+      {
+        const long x      = columnX0 + c;
+        double*    ext1   = &extColumns1[c * nbBands];
+        double*    ext2   = &extColumns2[c * nbTerms];
+        double*    int1   = &intColumns1[c * nbBands];
+        double*    int2   = &intColumns2[c * nbTerms];
+        const bool hasInt = (c >= intColumn0 && c <= intColumn1);
+
+        if (y == y0)
+        {
+          for (long dy = -extRadiusY; dy <= extRadiusY; ++dy)
+          {
+            readPixel(x, y + dy, value.data());
+            addPixel(value.data(), 1., ext1, ext2);
+            if (hasInt && std::abs(dy) <= intRadiusY)
+            {
+              addPixel(value.data(), 1., int1, int2);
+            }
+          }
+          continue;
+        }
+
+        readPixel(x, y - 1 - extRadiusY, value.data());
+        addPixel(value.data(), -1., ext1, ext2);
+        readPixel(x, y + extRadiusY, value.data());
+        addPixel(value.data(), 1., ext1, ext2);
+        if (hasInt)
+        {
+          readPixel(x, y - 1 - intRadiusY, value.data());
+          addPixel(value.data(), -1., int1, int2);
+          readPixel(x, y + intRadiusY, value.data());
+          addPixel(value.data(), 1., int1, int2);
+        }
+      }
+
+      // Window sums of the first pixel of the strip, then one column enters
+      // and one column leaves the windows
+      std::fill(window1.begin(), window1.end(), 0.);
+      std::fill(window2.begin(), window2.end(), 0.);
+      std::fill(inner1.begin(), inner1.end(), 0.);
+      std::fill(inner2.begin(), inner2.end(), 0.);
+      for (long c = 0; c <= 2 * extRadiusX; ++c)
+      {
+        addColumn(&extColumns1[c * nbBands], &extColumns2[c * nbTerms], 1., window1.data(), window2.data());
+      }
+      for (long c = intColumn0; c <= intColumn0 + 2 * intRadiusX; ++c)
+      {
+        addColumn(&intColumns1[c * nbBands], &intColumns2[c * nbTerms], 1., inner1.data(), inner2.data());
+      }
+
+      index[1] = y;
+      for (long x = stripX0; x <= stripX1; ++x)
+      {
+        const long k = x - stripX0;
+        if (k > 0)
+        {
+          const long extIn  = k + 2 * extRadiusX;
+          const long extOut = k - 1;
+          const long intIn  = k + intColumn0 + 2 * intRadiusX;
+          const long intOut = k - 1 + intColumn0;
+          addColumn(&extColumns1[extIn * nbBands], &extColumns2[extIn * nbTerms], 1., window1.data(), window2.data());
+          addColumn(&extColumns1[extOut * nbBands], &extColumns2[extOut * nbTerms], -1., window1.data(), window2.data());
+          addColumn(&intColumns1[intIn * nbBands], &intColumns2[intIn * nbTerms], 1., inner1.data(), inner2.data());
+          addColumn(&intColumns1[intOut * nbBands], &intColumns2[intOut * nbTerms], -1., inner1.data(), inner2.data());
+        }
+
+        // Mean and (unbiased) covariance of the pixels between the windows,
+        // in the lower triangle of the Cholesky factor
+        for (unsigned int i = 0; i < nbBands; ++i)
+        {
+          mean[i] = (window1[i] - inner1[i]) / nbPixels;
+        }
+        std::size_t t = 0;
+        for (unsigned int i = 0; i < nbBands; ++i)
+        {
+          for (unsigned int j = i; j < nbBands; ++j, ++t)
+          {
+            cholesky[j * nbBands + i] = (window2[t] - inner2[t] - nbPixels * mean[i] * mean[j]) / (nbPixels - 1);
+          }
+        }
+
+        readPixel(x, y, value.data());
+        for (unsigned int i = 0; i < nbBands; ++i)
+        {
+          centred[i] = value[i] - mean[i];
+        }
+
+        // Cholesky factorisation, row by row
+        bool isDefinite = true;
+        for (unsigned int j = 0; j < nbBands && isDefinite; ++j)
+        {
+          double* rowJ = &cholesky[j * nbBands];
+          for (unsigned int i = 0; i <= j; ++i)
+          {
+            const double* rowI = &cholesky[i * nbBands];
+            double        sum  = rowJ[i];
+            for (unsigned int l = 0; l < i; ++l)
+            {
+              sum -= rowJ[l] * rowI[l];
+            }
+            if (i < j)
+            {
+              rowJ[i] = sum / rowI[i];
+            }
+            else if (sum > 0)
+            {
+              rowJ[j] = std::sqrt(sum);
+            }
+            else
+            {
+              isDefinite = false;
+            }
+          }
+        }
+
+        // Rx score: |L^-1 (x - mean)|^2
+        double score = 0.;
+        if (isDefinite)
+        {
+          for (unsigned int j = 0; j < nbBands; ++j)
+          {
+            const double* rowJ = &cholesky[j * nbBands];
+            double        sum  = centred[j];
+            for (unsigned int l = 0; l < j; ++l)
+            {
+              sum -= rowJ[l] * centred[l];
+            }
+            centred[j] = sum / rowJ[j];
+            score += centred[j] * centred[j];
+          }
+        }
+        else
+        {
+          // Singular covariance: pseudo-inverse
+          vnl_matrix<double> covariance(nbBands, nbBands);
+          t = 0;
+          for (unsigned int i = 0; i < nbBands; ++i)
+          {
+            for (unsigned int j = i; j < nbBands; ++j, ++t)
+            {
+              covariance(i, j) = (window2[t] - inner2[t] - nbPixels * mean[i] * mean[j]) / (nbPixels - 1);
+              covariance(j, i) = covariance(i, j);
+            }
+          }
+          const vnl_vector<double> centredVector(centred.data(), nbBands);
+          score = dot_product(centredVector, vnl_svd<double>(covariance).solve(centredVector));
+        }
+
+        index[0] = x;
+        outputPtr->SetPixel(index, static_cast<OutputPixelType>(score));
+        progress.CompletedPixel();
+      }
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void LocalRxDetectorFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "ExternalRadius: " << m_ExternalRadius << std::endl;
+  os << indent << "InternalRadius: " << m_InternalRadius << std::endl;
+  os << indent << "MaximumColumnSumsSize: " << m_MaximumColumnSumsSize << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -23,6 +23,10 @@
 #include "otbLocalRxDetectorFilter.h"
 #include "itkRescaleIntensityImageFilter.h"
 #include "otbFunctorImageFilter.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+
+#include <algorithm>
+#include <cmath>
 
 int LocalRXDetectorTest(int itkNotUsed(argc), char* argv[])
 {
@@ -72,3 +76,55 @@ int LocalRXDetectorTest(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int LocalRXDetectorFilterTest(int itkNotUsed(argc), char* argv[])
+{
+  typedef double PixelType;
+  typedef otb::VectorImage<PixelType, 2> VectorImageType;
+  typedef otb::Image<PixelType, 2>       ImageType;
+  typedef otb::Functor::LocalRxDetectionFunctor<PixelType> LocalRxDetectorFunctorType;
+  typedef otb::LocalRxDetectorFilter<VectorImageType, ImageType> LocalRxDetectorFilterType;
+
+  typedef otb::ImageFileReader<VectorImageType> ReaderType;
+
+  const char*        filename       = argv[1];
+  const unsigned int externalRadius = atoi(argv[2]);
+  const unsigned int internalRadius = atoi(argv[3]);
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(filename);
+
+  // Reference: statistics computed on each neighborhood
+  LocalRxDetectorFunctorType detectorFunctor;
+  detectorFunctor.SetInternalRadius(internalRadius, internalRadius);
+
+  auto rxFunctorDetector = otb::NewFunctorFilter(detectorFunctor, {{externalRadius, externalRadius}});
+  rxFunctorDetector->SetInputs(reader->GetOutput());
+  rxFunctorDetector->Update();
+
+  // Sliding window sums, with narrow strips to test their seams
+  LocalRxDetectorFilterType::SizeType external, internal;
+  external.Fill(externalRadius);
+  internal.Fill(internalRadius);
+
+  LocalRxDetectorFilterType::Pointer rxDetector = LocalRxDetectorFilterType::New();
+  rxDetector->SetInput(reader->GetOutput());
+  rxDetector->SetExternalRadius(external);
+  rxDetector->SetInternalRadius(internal);
+  rxDetector->SetMaximumColumnSumsSize(1);
+  rxDetector->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(rxFunctorDetector->GetOutput(), rxFunctorDetector->GetOutput()->GetLargestPossibleRegion());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const double expected = it.Get();
+    const double score    = rxDetector->GetOutput()->GetPixel(it.GetIndex());
+    if (std::abs(score - expected) > 1e-6 * std::max(1., std::abs(expected)))
+    {
+      std::cerr << "Rx score at " << it.GetIndex() << " is " << score << ", expected " << expected << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
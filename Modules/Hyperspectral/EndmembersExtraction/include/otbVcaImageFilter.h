@@ -32,6 +32,7 @@
 #include "otbPCAImageFilter.h"
 #include "otbVectorImageToAmplitudeImageFilter.h"
 #include "otbConcatenateScalarValueImageFilter.h"
+#include "otbPersistentPixelSampleImageFilter.h"
 
 #include "itkMersenneTwisterRandomVariateGenerator.h"
 #include "vnl/algo/vnl_svd.h"
@@ -52,6 +53,12 @@ namespace otb
  * Most notably it supports streaming and is fully multi-threaded,
  * so it can be run seamlessly on full hyperspectral scenes.
  *
+ * By default, each projection of the algorithm is a streamed pass over the
+ * whole image. When a number of samples is set, a uniform random sample of
+ * pixels is gathered during the pass computing the image statistics, and
+ * the projections are computed in memory on this sample: the image is then
+ * read only once, and endmembers are chosen among the sampled pixels.
+ *
  * References :
  * "Vertex Component Analysis: A Fast Algorithm to Unmix Hyperspectral Data",
  * Jos\'e M. P. Nascimento, and Jos\'e M. Bioucas Dias,
@@ -95,6 +102,8 @@ public:
   typedef otb::PCAImageFilter<VectorImageType, VectorImageType, otb::Transform::INVERSE> InversePCAImageFilterType;
   typedef otb::VectorImageToAmplitudeImageFilter<VectorImageType, ImageType>       VectorImageToAmplitudeImageFilterType;
   typedef otb::ConcatenateScalarValueImageFilter<VectorImageType, VectorImageType> ConcatenateScalarValueImageFilterType;
+  typedef otb::PersistentPixelSampleImageFilter<VectorImageType>                   PixelSampleImageFilterType;
+  typedef typename PixelSampleImageFilterType::AccumulatorType                     PixelSampleAccumulatorType;
 
   // creation of SmartPointer
   itkNewMacro(Self);
@@ -104,6 +113,11 @@ public:
   itkGetMacro(NumberOfEndmembers, unsigned int);
   itkSetMacro(NumberOfEndmembers, unsigned int);
 
+  /** Set/Get the number of sampled pixels the projections are computed on.
+   * 0 (default) uses the whole image. */
+  itkGetMacro(NumberOfSamples, unsigned int);
+  itkSetMacro(NumberOfSamples, unsigned int);
+
   void Update() override
   {
     this->GenerateData();
@@ -125,11 +139,21 @@ protected:
 
   void GenerateData() override;
 
+  /** Endmembers estimated on a sample of the input pixels */
+  virtual vnl_matrix<PrecisionType> EstimateEndmembersFromSamples();
+
+  /** f = ((I - A*pinv(A))*w) / (norm(I - A*pinv(A))*w)), w being random */
+  vnl_vector<PrecisionType> DrawOrthogonalDirection(const vnl_matrix<PrecisionType>& A) const;
+
+  /** Write the endmembers (columns of E) in the output image */
+  void FillOutput(const vnl_matrix<PrecisionType>& E);
+
 private:
   VCAImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
   unsigned int m_NumberOfEndmembers;
+  unsigned int m_NumberOfSamples;
 };
 
 } // end namesapce otb
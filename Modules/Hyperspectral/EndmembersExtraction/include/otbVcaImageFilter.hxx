@@ -24,12 +24,14 @@
 
 #include "otbVcaImageFilter.h"
 #include "otbStandardWriterWatcher.h"
+#include "vnl/vnl_trace.h"
+#include <algorithm>
 
 namespace otb
 {
 
 template <class TImage>
-VCAImageFilter<TImage>::VCAImageFilter() : m_NumberOfEndmembers(0)
+VCAImageFilter<TImage>::VCAImageFilter() : m_NumberOfEndmembers(0), m_NumberOfSamples(0)
 {
 }
 
@@ -73,6 +75,12 @@ void VCAImageFilter<TImage>::GenerateData()
 {
   typedef typename ForwardPCAImageFilterType::NormalizeFilterType NormalizeFilterType;
 
+  if (m_NumberOfSamples > 0)
+  {
+    FillOutput(EstimateEndmembersFromSamples());
+    return;
+  }
+
   VectorImageType*   input   = const_cast<VectorImageType*>(this->GetInput());
   const unsigned int nbBands = this->GetInput()->GetNumberOfComponentsPerPixel();
 
@@ -227,28 +235,12 @@ void VCAImageFilter<TImage>::GenerateData()
   vnl_matrix<PrecisionType> A(m_NumberOfEndmembers, m_NumberOfEndmembers);
   A.fill(0);
   A(m_NumberOfEndmembers - 1, 0) = 1;
-  typename RandomVariateGeneratorType::Pointer randomGen = RandomVariateGeneratorType::GetInstance();
 
   for (unsigned int i = 0; i < m_NumberOfEndmembers; ++i)
   {
     otbMsgDevMacro("----------------------------------------") otbMsgDevMacro("Iteration " << i)
 
-        // w = rand(q, 1)
-        otbMsgDevMacro("Random vector generation ") vnl_vector<PrecisionType>
-            w(m_NumberOfEndmembers);
-    for (unsigned int j = 0; j < w.size(); ++j)
-    {
-      w(j) = randomGen->GetVariateWithOpenRange();
-    }
-
-    // f = ((I - A*pinv(A))*w) / (norm(I - A*pinv(A))*w))
-    otbMsgDevMacro("f = ((I - A*pinv(A))*w) /(norm(I - A*pinv(A))*w))") vnl_matrix<PrecisionType> tmpMat(m_NumberOfEndmembers, m_NumberOfEndmembers);
-    tmpMat.set_identity();
-    otbMsgDevMacro("A" << std::endl << A) vnl_svd<PrecisionType> Asvd(A);
-    tmpMat -= A * Asvd.inverse();
-
-    vnl_vector<PrecisionType> tmpNumerator = tmpMat * w;
-    vnl_vector<PrecisionType> f            = tmpNumerator / tmpNumerator.two_norm();
+        vnl_vector<PrecisionType> f = DrawOrthogonalDirection(A);
 
     // v = f.'*Y
     otbMsgDevMacro("f = " << f);
@@ -321,18 +313,187 @@ void VCAImageFilter<TImage>::GenerateData()
     otbMsgDevMacro("E(:, i) = u") otbMsgDevMacro("u = " << u) E.set_column(i, u);
   }
 
+  FillOutput(E);
+}
+
+template <class TImage>
+vnl_matrix<typename VCAImageFilter<TImage>::PrecisionType> VCAImageFilter<TImage>::EstimateEndmembersFromSamples()
+{
+  VectorImageType*   input   = const_cast<VectorImageType*>(this->GetInput());
+  const unsigned int nbBands = this->GetInput()->GetNumberOfComponentsPerPixel();
+
+  // The sample is gathered during the streamed pass of the statistics: the
+  // sampler grafts its input, and is reset and synthetized around the pass
+  otbMsgDevMacro("Computing image stats and sampling " << m_NumberOfSamples << " pixels");
+  typename PixelSampleImageFilterType::Pointer sampler = PixelSampleImageFilterType::New();
+  sampler->SetInput(input);
+  sampler->SetInitialAccumulator(PixelSampleAccumulatorType(m_NumberOfSamples));
+
+  typename StreamingStatisticsVectorImageFilterType::Pointer statsInput = StreamingStatisticsVectorImageFilterType::New();
+  statsInput->SetInput(sampler->GetOutput());
+  statsInput->SetEnableMinMax(false);
+
+  sampler->Reset();
+  statsInput->Update();
+  sampler->Synthetize();
+
+  const std::vector<PixelType> samples   = sampler->GetResult().GetSamples();
+  const unsigned int           nbSamples = samples.size();
+  if (nbSamples == 0)
+  {
+    itkExceptionMacro(<< "No pixel could be sampled from the input image");
+  }
+
+  // M = [ x_1 ... x_N ]
+  vnl_matrix<PrecisionType> M(nbBands, nbSamples);
+  for (unsigned int k = 0; k < nbSamples; ++k)
+  {
+    M.set_column(k, samples[k].GetDataPointer());
+  }
+
+  const vnl_matrix<PrecisionType> R = statsInput->GetCorrelation().GetVnlMatrix();
+  const vnl_vector<PrecisionType> mean(statsInput->GetMean().GetDataPointer(), statsInput->GetMean().GetSize());
+
+  // SNR computation. The power of the projected centred data is derived
+  // from the statistics: mean(|Ud.'*(x - mean)|^2) = trace(Ud.'*(R - mean*mean.')*Ud)
+  double                    SNR, SNRth;
+  vnl_matrix<PrecisionType> Ud;
+  {
+    vnl_svd<PrecisionType> svd(R);
+    Ud = svd.U().get_n_columns(0, m_NumberOfEndmembers);
+
+    const vnl_matrix<PrecisionType> centredR = R - outer_product(mean, mean);
+
+    double P_R  = nbBands * statsInput->GetComponentCorrelation();
+    double P_Rp = vnl_trace(Ud.transpose() * centredR * Ud) + mean.squared_magnitude();
+    SNR         = std::abs(10 * std::log10((P_Rp - (m_NumberOfEndmembers / nbBands) * P_R) / (P_R - P_Rp)));
+  }
+
+  SNRth = 15.0 + 10.0 * std::log(static_cast<double>(m_NumberOfEndmembers)) + 8.0;
+
+  vnl_matrix<PrecisionType> Xd;
+  vnl_matrix<PrecisionType> Y;
+
+  if (SNR > SNRth)
+  {
+    otbMsgDevMacro("Using projective projection for dimensionnality reduction");
+
+    // Xd = Ud.'*M, and mean(Xd) = Ud.'*mean(M)
+    Xd                                     = Ud.transpose() * M;
+    const vnl_vector<PrecisionType> Xdmean = Ud.transpose() * mean;
+
+    // Projective projection
+    // Xd ./ repmat( sum( Xd .* repmat(u, [1 N]) ) , [d 1]);
+    Y = Xd;
+    for (unsigned int k = 0; k < nbSamples; ++k)
+    {
+      Y.set_column(k, Xd.get_column(k) / dot_product(Xd.get_column(k), Xdmean));
+    }
+  }
+  else
+  {
+    otbMsgDevMacro("Using PCA for dimensionnality reduction");
+
+    vnl_svd<PrecisionType> svd(statsInput->GetCovariance().GetVnlMatrix());
+    Ud = svd.U().get_n_columns(0, m_NumberOfEndmembers - 1);
+
+    // Xd = Ud.'*(M - mean)
+    vnl_matrix<PrecisionType> centredM = M;
+    for (unsigned int k = 0; k < nbSamples; ++k)
+    {
+      centredM.set_column(k, M.get_column(k) - mean);
+    }
+    Xd = Ud.transpose() * centredM;
+
+    // Y = [ Xd ; max(norm(Xd)) ]
+    PrecisionType maxNorm = 0;
+    for (unsigned int k = 0; k < nbSamples; ++k)
+    {
+      maxNorm = std::max(maxNorm, Xd.get_column(k).two_norm());
+    }
+    otbMsgDevMacro("maxNorm : " << maxNorm);
+
+    Y.set_size(m_NumberOfEndmembers, nbSamples);
+    Y.update(Xd, 0, 0);
+    Y.set_row(m_NumberOfEndmembers - 1, maxNorm);
+  }
+
+  // E : result, will contain the endmembers
+  vnl_matrix<PrecisionType> E(nbBands, m_NumberOfEndmembers);
+
+  // A = zeros(q, q)
+  // A(q, 1) = 1
+  vnl_matrix<PrecisionType> A(m_NumberOfEndmembers, m_NumberOfEndmembers);
+  A.fill(0);
+  A(m_NumberOfEndmembers - 1, 0) = 1;
+
+  for (unsigned int i = 0; i < m_NumberOfEndmembers; ++i)
+  {
+    const vnl_vector<PrecisionType> f = DrawOrthogonalDirection(A);
+
+    // v = f.'*Y, k = arg_max( abs(v) )
+    const vnl_vector<PrecisionType> v      = f * Y;
+    unsigned int                    maxIdx = 0;
+    for (unsigned int k = 1; k < nbSamples; ++k)
+    {
+      if (std::abs(v[k]) > std::abs(v[maxIdx]))
+      {
+        maxIdx = k;
+      }
+    }
+
+    // A(:, i) = Y(:, k)
+    A.set_column(i, Y.get_column(maxIdx));
+
+    // reproject new endmember in original space
+    vnl_vector<PrecisionType> u = Ud * Xd.get_column(maxIdx);
+    if (SNR <= SNRth)
+    {
+      u += mean;
+    }
+
+    // E(:, i) = u
+    E.set_column(i, u);
+  }
+
+  return E;
+}
+
+template <class TImage>
+vnl_vector<typename VCAImageFilter<TImage>::PrecisionType> VCAImageFilter<TImage>::DrawOrthogonalDirection(const vnl_matrix<PrecisionType>& A) const
+{
+  typename RandomVariateGeneratorType::Pointer randomGen = RandomVariateGeneratorType::GetInstance();
+
+  // w = rand(q, 1)
+  otbMsgDevMacro("Random vector generation ") vnl_vector<PrecisionType> w(m_NumberOfEndmembers);
+  for (unsigned int j = 0; j < w.size(); ++j)
+  {
+    w(j) = randomGen->GetVariateWithOpenRange();
+  }
+
+  // f = ((I - A*pinv(A))*w) / (norm(I - A*pinv(A))*w))
+  otbMsgDevMacro("f = ((I - A*pinv(A))*w) /(norm(I - A*pinv(A))*w))") vnl_matrix<PrecisionType> tmpMat(m_NumberOfEndmembers, m_NumberOfEndmembers);
+  tmpMat.set_identity();
+  otbMsgDevMacro("A" << std::endl << A) vnl_svd<PrecisionType> Asvd(A);
+  tmpMat -= A * Asvd.inverse();
+
+  vnl_vector<PrecisionType> tmpNumerator = tmpMat * w;
+  return tmpNumerator / tmpNumerator.two_norm();
+}
+
+template <class TImage>
+void VCAImageFilter<TImage>::FillOutput(const vnl_matrix<PrecisionType>& E)
+{
   typename VectorImageType::Pointer output = this->GetOutput();
   output->SetRegions(output->GetLargestPossibleRegion());
-  // output->SetNumberOfComponentsPerPixel(input->GetNumberOfComponentsPerPixel());
   output->Allocate();
 
   itk::ImageRegionIteratorWithIndex<VectorImageType> it(output, output->GetLargestPossibleRegion());
   unsigned int                                       i;
   for (it.GoToBegin(), i = 0; !it.IsAtEnd(); ++it, ++i)
   {
-    vnl_vector<PrecisionType>           e = E.get_column(i);
-    typename VectorImageType::PixelType pixel(input->GetNumberOfComponentsPerPixel());
-    for (unsigned int j = 0; j < e.size(); ++j)
+    typename VectorImageType::PixelType pixel(E.rows());
+    for (unsigned int j = 0; j < E.rows(); ++j)
     {
       pixel[j] = E(j, i);
     }
@@ -347,6 +508,8 @@ template <class TImage>
 void VCAImageFilter<TImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfEndmembers: " << m_NumberOfEndmembers << std::endl;
+  os << indent << "NumberOfSamples: " << m_NumberOfSamples << std::endl;
 }
 
 } // end namespace otb
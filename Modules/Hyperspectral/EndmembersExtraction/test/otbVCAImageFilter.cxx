@@ -36,7 +36,7 @@ typedef otb::ImageFileReader<VectorImageType> ReaderType;
 typedef otb::ImageFileWriter<VectorImageType> WriterType;
 
 
-int otbVCAImageFilterTestHighSNR(int itkNotUsed(argc), char* argv[])
+int otbVCAImageFilterTestHighSNR(int argc, char* argv[])
 {
   const char*        inputImage   = argv[1];
   const char*        outputImage  = argv[2];
@@ -47,6 +47,10 @@ int otbVCAImageFilterTestHighSNR(int itkNotUsed(argc), char* argv[])
 
   VCAFilterType::Pointer vca = VCAFilterType::New();
   vca->SetNumberOfEndmembers(nbEndmembers);
+  if (argc > 4)
+  {
+    vca->SetNumberOfSamples(atoi(argv[4]));
+  }
   vca->SetInput(readerImage->GetOutput());
 
   WriterType::Pointer writer = WriterType::New();
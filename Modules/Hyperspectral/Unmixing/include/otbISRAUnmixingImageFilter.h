@@ -24,7 +24,7 @@
 #include "itkNumericTraits.h"
 #include "otbFunctorImageFilter.h"
 #include "vnl/algo/vnl_svd.h"
-#include <memory>
+#include <vector>
 
 namespace otb
 {
@@ -71,7 +71,8 @@ public:
     return m_MaxIteration;
   }
 
-  OutputType operator()(const InputType& in) const;
+  /** The output pixel is written in place */
+  void operator()(OutputType& out, const InputType& in) const;
 
 private:
   static bool IsNonNegative(PrecisionType val)
@@ -79,13 +80,14 @@ private:
     return val >= 0;
   }
 
-  typedef vnl_svd<PrecisionType>     SVDType;
-  typedef std::shared_ptr<SVDType> SVDPointerType;
+  typedef vnl_svd<PrecisionType> SVDType;
 
-  MatrixType     m_U;
-  SVDPointerType m_Svd; // SVD of U
-  unsigned int   m_OutputSize;
-  unsigned int   m_MaxIteration;
+  MatrixType   m_U;
+  MatrixType   m_Inv; // pseudo-inverse of U
+  MatrixType   m_Ut;  // transpose of U
+  MatrixType   m_UtU; // U^T U
+  unsigned int m_OutputSize;
+  unsigned int m_MaxIteration;
 };
 }
 
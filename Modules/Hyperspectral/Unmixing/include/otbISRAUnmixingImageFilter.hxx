@@ -46,7 +46,12 @@ void ISRAUnmixingFunctor<TInput, TOutput, TPrecision>::SetEndmembersMatrix(const
 {
   m_U          = U;
   m_OutputSize = m_U.cols();
-  m_Svd.reset(new SVDType(m_U));
+
+  // Everything which does not depend on the pixel is computed once
+  SVDType svd(m_U);
+  m_Inv = svd.inverse();
+  m_Ut  = m_U.transpose();
+  m_UtU = m_Ut * m_U;
 }
 
 
@@ -56,60 +61,68 @@ const typename ISRAUnmixingFunctor<TInput, TOutput, TPrecision>::MatrixType& ISR
   return m_U;
 }
 
+/*
+ * ISRA multiplicative update: x_e <- x_e * (U^T p)_e / (U^T U x)_e
+ *
+ * U^T p does not change along the iterations, and (U^T U) is a small
+ * nbEndmembers x nbEndmembers matrix, so an iteration does not depend on
+ * the number of bands.
+ */
 template <class TInput, class TOutput, class TPrecision>
-typename ISRAUnmixingFunctor<TInput, TOutput, TPrecision>::OutputType ISRAUnmixingFunctor<TInput, TOutput, TPrecision>::operator()(const InputType& in) const
+void ISRAUnmixingFunctor<TInput, TOutput, TPrecision>::operator()(OutputType& out, const InputType& in) const
 {
   // TODO : support different types between input and output ?
-  VectorType inVector(in.Size());
-  for (unsigned int i = 0; i < in.GetSize(); ++i)
-  {
-    inVector[i] = in[i];
-  }
+  const unsigned int nbEndmembers = m_OutputSize;
+  const unsigned int nbBands      = in.Size();
 
-  // Initialize with Unconstrained Least Square solution
-  VectorType outVector = m_Svd->solve(inVector);
+  // Per-thread storage for the solution, U^T p and U^T U x
+  thread_local std::vector<PrecisionType> buffer;
+  buffer.resize(3 * nbEndmembers);
+  PrecisionType* outVector   = buffer.data();
+  PrecisionType* numerator   = outVector + nbEndmembers;
+  PrecisionType* denominator = numerator + nbEndmembers;
 
-  unsigned int nbEndmembers = m_OutputSize;
-  unsigned int nbBands      = in.Size();
+  // Initialize with Unconstrained Least Square solution
+  for (unsigned int e = 0; e < nbEndmembers; ++e)
+  {
+    const PrecisionType* inv = m_Inv[e];
+    const PrecisionType* ut  = m_Ut[e];
+    PrecisionType        x   = 0;
+    PrecisionType        num = 0;
+    for (unsigned int b = 0; b < nbBands; ++b)
+    {
+      x += inv[b] * in[b];
+      num += ut[b] * in[b];
+    }
+    outVector[e] = x;
+    numerator[e] = num;
+  }
 
   // Apply ISRA iterations
   for (unsigned int i = 0; i < m_MaxIteration; ++i)
   {
-
-    // Use a temporary storage since it is used
-    // inside the iterations
-    VectorType outVectorNew = outVector;
+    // Use outVector from previous iteration for all the endmembers
     for (unsigned int e = 0; e < nbEndmembers; ++e)
     {
-      PrecisionType numerator   = 0;
-      PrecisionType denominator = 0;
-
-      for (unsigned int b = 0; b < nbBands; ++b)
+      const PrecisionType* utu = m_UtU[e];
+      PrecisionType        dot = 0;
+      for (unsigned int s = 0; s < nbEndmembers; ++s)
       {
-        numerator += in[b] * m_U(b, e);
-
-        PrecisionType dot = 0;
-        for (unsigned int s = 0; s < nbEndmembers; ++s)
-        {
-          // Use outVector from previous iteration here
-          dot += m_U(b, s) * outVector[s];
-        }
-        denominator += dot * m_U(b, e);
+        dot += utu[s] * outVector[s];
       }
-
-      outVectorNew[e] *= (numerator / denominator);
+      denominator[e] = dot;
     }
 
-    // Prepare for next iteration
-    outVector = outVectorNew;
+    for (unsigned int e = 0; e < nbEndmembers; ++e)
+    {
+      outVector[e] *= (numerator[e] / denominator[e]);
+    }
   }
 
-  OutputType out(outVector.size());
-  for (unsigned int i = 0; i < out.GetSize(); ++i)
+  for (unsigned int e = 0; e < nbEndmembers; ++e)
   {
-    out[i] = outVector[i];
+    out[e] = outVector[e];
   }
-  return out;
 }
 
 } // end namespace functor
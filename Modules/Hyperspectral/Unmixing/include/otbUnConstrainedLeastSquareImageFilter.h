@@ -58,7 +58,8 @@ public:
 
   void SetMatrix(const MatrixType& m);
 
-  OutputType operator()(const InputType& in) const;
+  /** The output pixel is written in place, with no temporary vector */
+  void operator()(OutputType& out, const InputType& in) const;
 
 private:
   typedef vnl_svd<PrecisionType>     SVDType;
@@ -43,24 +43,20 @@ void UnConstrainedLeastSquareFunctor<TInput, TOutput, TPrecision>::SetMatrix(con
 }
 
 template <class TInput, class TOutput, class TPrecision>
-typename UnConstrainedLeastSquareFunctor<TInput, TOutput, TPrecision>::OutputType UnConstrainedLeastSquareFunctor<TInput, TOutput, TPrecision>::
-operator()(const InputType& in) const
+void UnConstrainedLeastSquareFunctor<TInput, TOutput, TPrecision>::operator()(OutputType& out, const InputType& in) const
 {
-  VectorType inVector(in.Size());
-  for (unsigned int i = 0; i < in.GetSize(); ++i)
+  // Rows of the pseudo-inverse are contiguous, like the pixel bands
+  const unsigned int nbBands = in.Size();
+  for (unsigned int e = 0; e < m_OutputSize; ++e)
   {
-    inVector[i] = in[i];
+    const PrecisionType* row = m_Inv[e];
+    PrecisionType        sum = 0;
+    for (unsigned int b = 0; b < nbBands; ++b)
+    {
+      sum += row[b] * in[b];
+    }
+    out[e] = sum;
   }
-
-  VectorType outVector = m_Inv * inVector;
-
-  OutputType out(outVector.size());
-  for (unsigned int i = 0; i < out.GetSize(); ++i)
-  {
-    out[i] = outVector[i];
-  }
-
-  return out;
 }
 
 
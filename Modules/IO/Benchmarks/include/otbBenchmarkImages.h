@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbBenchmarkImages_h
+#define otbBenchmarkImages_h
+
+#include "otbImage.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+
+namespace otb
+{
+namespace Benchmark
+{
+
+typedef otb::Image<float, 2>       FloatImageType;
+typedef otb::VectorImage<float, 2> FloatVectorImageType;
+
+/** Deterministic pattern used to fill the synthetic images. It is not
+ * constant so that compression and branch prediction do not flatter the
+ * timings. */
+inline float PatternValue(const itk::Index<2>& index, unsigned int band)
+{
+  return static_cast<float>((index[0] * 7 + index[1] * 13 + band * 31) % 251);
+}
+
+/** Create a square single band image of the given size */
+inline FloatImageType::Pointer CreateImage(unsigned int size)
+{
+  FloatImageType::RegionType region;
+  region.SetSize(0, size);
+  region.SetSize(1, size);
+
+  auto image = FloatImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<FloatImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    it.Set(PatternValue(it.GetIndex(), 0));
+  }
+  return image;
+}
+
+/** Create a square multi-band image of the given size */
+inline FloatVectorImageType::Pointer CreateVectorImage(unsigned int size, unsigned int nbBands)
+{
+  FloatVectorImageType::RegionType region;
+  region.SetSize(0, size);
+  region.SetSize(1, size);
+
+  auto image = FloatVectorImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(nbBands);
+  image->Allocate();
+
+  FloatVectorImageType::PixelType pixel(nbBands);
+  itk::ImageRegionIteratorWithIndex<FloatVectorImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    for (unsigned int band = 0; band < nbBands; ++band)
+    {
+      pixel[band] = PatternValue(it.GetIndex(), band);
+    }
+    it.Set(pixel);
+  }
+  return image;
+}
+
+} // end namespace Benchmark
+} // end namespace otb
+
+#endif
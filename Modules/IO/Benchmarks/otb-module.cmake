@@ -0,0 +1,45 @@
+#
+# Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+set(DOCUMENTATION "This module contains micro and macro benchmarks of the
+OTB hot paths (image IO, functor filters, band math, interpolation,
+statistics, machine learning prediction and applications). They are built
+on Google Benchmark and are not part of the default build.")
+
+otb_module(OTBBenchmarks
+  EXCLUDE_FROM_DEFAULT
+  DEPENDS
+    OTBApplicationEngine
+    OTBAppFiltering
+    OTBAppMathParserX
+    OTBCommon
+    OTBFunctor
+    OTBImageBase
+    OTBImageIO
+    OTBInterpolation
+    OTBIOGDAL
+    OTBITK
+    OTBMathParserX
+    OTBStatistics
+    OTBSupervised
+
+  DESCRIPTION
+    "${DOCUMENTATION}"
+)
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbBenchmarkImages.h"
+#include "otbWrapperApplicationRegistry.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+
+const unsigned int NumberOfBands = 4;
+
+// The applications are loaded from OTB_APPLICATION_PATH, which is set by
+// the OTBBenchmarks target
+otb::Wrapper::Application::Pointer CreateApplication(benchmark::State& state, const std::string& name)
+{
+  auto app = otb::Wrapper::ApplicationRegistry::CreateApplication(name);
+  if (app.IsNull())
+  {
+    state.SkipWithError(("Unable to load the " + name + " application, check OTB_APPLICATION_PATH").c_str());
+    return app;
+  }
+  app->GetLogger()->SetPriorityLevel(itk::LoggerBase::WARNING);
+  return app;
+}
+
+// Whole Smoothing application run on a synthetic image, written to disk
+void BM_SmoothingApplication(benchmark::State& state)
+{
+  const unsigned int size = static_cast<unsigned int>(state.range(0));
+  auto               app  = CreateApplication(state, "Smoothing");
+  if (app.IsNull())
+  {
+    return;
+  }
+
+  const std::string filename = "otbBenchmarkSmoothing.tif";
+  auto              image    = otb::Benchmark::CreateVectorImage(size, NumberOfBands);
+  app->SetParameterInputImage("in", image);
+  app->SetParameterString("type", "gaussian");
+  app->SetParameterString("out", filename);
+
+  for (auto _ : state)
+  {
+    app->ExecuteAndWriteOutput();
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+  std::remove(filename.c_str());
+}
+BENCHMARK(BM_SmoothingApplication)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Whole BandMathX application run on a synthetic image, written to disk
+void BM_BandMathXApplication(benchmark::State& state)
+{
+  const unsigned int size = static_cast<unsigned int>(state.range(0));
+  auto               app  = CreateApplication(state, "BandMathX");
+  if (app.IsNull())
+  {
+    return;
+  }
+
+  const std::string filename = "otbBenchmarkBandMathX.tif";
+  auto              image    = otb::Benchmark::CreateVectorImage(size, NumberOfBands);
+  app->AddImageToParameterInputImageList("il", image);
+  app->SetParameterString("exp", "im1b1 + im1b2 * im1b3 - im1b4");
+  app->SetParameterString("out", filename);
+
+  for (auto _ : state)
+  {
+    app->ExecuteAndWriteOutput();
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+  std::remove(filename.c_str());
+}
+BENCHMARK(BM_BandMathXApplication)->Arg(1024)->Arg(4096)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // end anonymous namespace
@@ -0,0 +1,78 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbBenchmarkImages.h"
+#include "otbFunctorImageFilter.h"
+#include "otbBandMathXImageFilter.h"
+
+#include <benchmark/benchmark.h>
+
+namespace
+{
+
+using otb::Benchmark::FloatVectorImageType;
+
+const unsigned int NumberOfBands = 4;
+
+// Per pixel functor reducing all the bands of a multi-band image
+void BM_FunctorImageFilter(benchmark::State& state)
+{
+  const unsigned int size  = static_cast<unsigned int>(state.range(0));
+  auto               image = otb::Benchmark::CreateVectorImage(size, NumberOfBands);
+
+  auto filter = otb::NewFunctorFilter([](const itk::VariableLengthVector<float>& in) {
+    float sum = 0.;
+    for (unsigned int band = 0; band < in.GetSize(); ++band)
+    {
+      sum += in[band];
+    }
+    return sum;
+  });
+  filter->SetInputs(image);
+
+  for (auto _ : state)
+  {
+    filter->Modified();
+    filter->Update();
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_FunctorImageFilter)->Arg(512)->Arg(2048)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+// Band math expression evaluated by muParserX
+void BM_BandMathXImageFilter(benchmark::State& state)
+{
+  const unsigned int size  = static_cast<unsigned int>(state.range(0));
+  auto               image = otb::Benchmark::CreateVectorImage(size, NumberOfBands);
+
+  auto filter = otb::BandMathXImageFilter<FloatVectorImageType>::New();
+  filter->SetNthInput(0, image);
+  filter->SetExpression("im1b1 + im1b2 * im1b3 - im1b4");
+
+  for (auto _ : state)
+  {
+    filter->Modified();
+    filter->Update();
+  }
+  state.SetItemsProcessed(state.iterations() * size * size);
+}
+BENCHMARK(BM_BandMathXImageFilter)->Arg(512)->Arg(2048)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // end anonymous namespace
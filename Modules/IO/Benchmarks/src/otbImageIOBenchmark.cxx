@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbBenchmarkImages.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <string>
+
+namespace
+{
+
+using otb::Benchmark::FloatVectorImageType;
+
+const unsigned int NumberOfBands = 4;
+
+std::string GetFileName(const std::string& prefix, unsigned int size)
+{
+  return prefix + std::to_string(size) + ".tif";
+}
+
+void WriteImage(FloatVectorImageType* image, const std::string& filename)
+{
+  auto writer = otb::ImageFileWriter<FloatVectorImageType>::New();
+  writer->SetInput(image);
+  writer->SetFileName(filename);
+  writer->Update();
+}
+
+// GeoTIFF writing through GDALImageIO, including streaming
+void BM_GDALImageIOWrite(benchmark::State& state)
+{
+  const unsigned int size     = static_cast<unsigned int>(state.range(0));
+  auto               image    = otb::Benchmark::CreateVectorImage(size, NumberOfBands);
+  const std::string  filename = GetFileName("otbBenchmarkWrite", size);
+
+  for (auto _ : state)
+  {
+    WriteImage(image, filename);
+  }
+  state.SetBytesProcessed(state.iterations() * size * size * NumberOfBands * sizeof(float));
+  std::remove(filename.c_str());
+}
+BENCHMARK(BM_GDALImageIOWrite)->Arg(512)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+// GeoTIFF reading through GDALImageIO, a new reader is used for each
+// iteration so that nothing is served from the pipeline
+void BM_GDALImageIORead(benchmark::State& state)
+{
+  const unsigned int size     = static_cast<unsigned int>(state.range(0));
+  const std::string  filename = GetFileName("otbBenchmarkRead", size);
+  WriteImage(otb::Benchmark::CreateVectorImage(size, NumberOfBands), filename);
+
+  for (auto _ : state)
+  {
+    auto reader = otb::ImageFileReader<FloatVectorImageType>::New();
+    reader->SetFileName(filename);
+    reader->Update();
+    benchmark::DoNotOptimize(reader->GetOutput()->GetBufferPointer());
+  }
+  state.SetBytesProcessed(state.iterations() * size * size * NumberOfBands * sizeof(float));
+  std::remove(filename.c_str());
+}
+BENCHMARK(BM_GDALImageIORead)->Arg(512)->Arg(2048)->Unit(benchmark::kMillisecond);
+
+} // end anonymous namespace
@@ -0,0 +1,65 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbBenchmarkImages.h"
+#include "otbBCOInterpolateImageFunction.h"
+
+#include <benchmark/benchmark.h>
+#include <vector>
+
+namespace
+{
+
+using otb::Benchmark::FloatImageType;
+
+// Bicubic interpolation at scattered sub-pixel positions, the benchmark
+// argument is the radius of the BCO kernel
+void BM_BCOInterpolateImageFunction(benchmark::State& state)
+{
+  const unsigned int size           = 1024;
+  const unsigned int numberOfPoints = 1 << 16;
+  auto               image          = otb::Benchmark::CreateImage(size);
+
+  typedef otb::BCOInterpolateImageFunction<FloatImageType> InterpolatorType;
+  auto interpolator = InterpolatorType::New();
+  interpolator->SetRadius(static_cast<unsigned int>(state.range(0)));
+  interpolator->SetInputImage(image);
+
+  std::vector<InterpolatorType::ContinuousIndexType> points(numberOfPoints);
+  for (unsigned int i = 0; i < numberOfPoints; ++i)
+  {
+    points[i][0] = (i * 37 % (size - 8)) + 4 + 0.25 * (i % 4);
+    points[i][1] = (i * 61 % (size - 8)) + 4 + 0.2 * (i % 5);
+  }
+
+  for (auto _ : state)
+  {
+    double sum = 0.;
+    for (const auto& point : points)
+    {
+      sum += interpolator->EvaluateAtContinuousIndex(point);
+    }
+    benchmark::DoNotOptimize(sum);
+  }
+  state.SetItemsProcessed(state.iterations() * numberOfPoints);
+}
+BENCHMARK(BM_BCOInterpolateImageFunction)->Arg(2)->Arg(3)->Unit(benchmark::kMillisecond);
+
+} // end anonymous namespace
@@ -0,0 +1,89 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbConfigure.h"
+
+#include <benchmark/benchmark.h>
+
+#ifdef OTB_USE_OPENCV
+#include "otbRandomForestsMachineLearningModel.h"
+
+namespace
+{
+
+typedef otb::RandomForestsMachineLearningModel<float, int> RandomForestType;
+
+const unsigned int NumberOfFeatures = 8;
+const unsigned int NumberOfClasses  = 3;
+
+RandomForestType::InputListSampleType::Pointer CreateSamples(unsigned int nbSamples)
+{
+  auto samples = RandomForestType::InputListSampleType::New();
+  samples->SetMeasurementVectorSize(NumberOfFeatures);
+
+  RandomForestType::InputSampleType sample(NumberOfFeatures);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    for (unsigned int feature = 0; feature < NumberOfFeatures; ++feature)
+    {
+      sample[feature] = static_cast<float>((i * (feature + 3) * 17) % 101);
+    }
+    samples->PushBack(sample);
+  }
+  return samples;
+}
+
+// Batch prediction of a trained random forest, the benchmark argument is
+// the number of predicted samples
+void BM_RandomForestsPredictBatch(benchmark::State& state)
+{
+  const unsigned int nbTrainingSamples = 2000;
+
+  auto trainingSamples = CreateSamples(nbTrainingSamples);
+  auto labels          = RandomForestType::TargetListSampleType::New();
+  for (unsigned int i = 0; i < nbTrainingSamples; ++i)
+  {
+    const auto&                        sample = trainingSamples->GetMeasurementVector(i);
+    RandomForestType::TargetSampleType label;
+    label[0] = (static_cast<int>(sample[0] + sample[1] > 100) + static_cast<int>(sample[2] > 50)) % NumberOfClasses;
+    labels->PushBack(label);
+  }
+
+  auto model = RandomForestType::New();
+  model->SetMaxNumberOfTrees(50);
+  model->SetMaxDepth(10);
+  model->SetInputListSample(trainingSamples);
+  model->SetTargetListSample(labels);
+  model->Train();
+
+  const unsigned int nbSamples = static_cast<unsigned int>(state.range(0));
+  auto               samples   = CreateSamples(nbSamples);
+
+  for (auto _ : state)
+  {
+    auto predictions = model->PredictBatch(samples);
+    benchmark::DoNotOptimize(predictions.GetPointer());
+  }
+  state.SetItemsProcessed(state.iterations() * nbSamples);
+}
+BENCHMARK(BM_RandomForestsPredictBatch)->Arg(10000)->Arg(100000)->Unit(benchmark::kMillisecond)->UseRealTime();
+
+} // end anonymous namespace
+#endif
@@ -138,6 +138,12 @@ public:
    in the disk */
   itkSetMacro(UseUrl, bool);
 
+  /** Directory where the answers of the OSM server are kept. When set, an
+   * extent already requested is read from this directory instead of
+   * being downloaded again */
+  itkSetStringMacro(CacheDirectory);
+  itkGetStringMacro(CacheDirectory);
+
   /** Add a key to search into the list */
   void AddKey(const std::string& key)
   {
@@ -203,6 +209,7 @@ private:
   /** the url in OSM API format */
   std::string m_Url;
   bool        m_UseUrl;
+  std::string m_CacheDirectory;
 
   /** List to store keys to search */
   std::vector<std::string> m_KeyList;
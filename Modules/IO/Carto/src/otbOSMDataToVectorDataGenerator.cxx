@@ -24,9 +24,12 @@
 #include "itksys/SystemTools.hxx"
 #include "itkDataObject.h"
 #include "itkMacro.h"
+#include "otbMacro.h"
 
 #include "otb_tinyxml.h"
 
+#include <functional>
+
 namespace otb
 {
 
@@ -69,23 +72,46 @@ void OSMDataToVectorDataGenerator::GenerateData()
     std::ostringstream urlStream;
     urlStream << m_Url;
 
-    // TODO : Replace by the new method RetrieveFileFromInMemory
-    m_FileName = "temposmresult.xml";
-
     // Add the extent to the url
     urlStream << "bbox=" << m_West << "," << m_South << "," << m_East << "," << m_North;
 
-    // First check if the request does not cross the server
-    // limitations :
-    if (m_Curl->IsCurlReturnHttpError(urlStream.str()))
+    // TODO : Replace by the new method RetrieveFileFromInMemory
+    if (m_CacheDirectory.empty())
     {
-      itkExceptionMacro(<< "The OSM Server returned an Error > =400,"
-                        << " it means that one of server limits are crossed : node/way/relation or area requested");
+      m_FileName = "temposmresult.xml";
+      m_Curl->SetSkipExistingFiles(false);
     }
+    else
+    {
+      // One file per requested url
+      std::ostringstream cacheName;
+      cacheName << "osm_" << std::hex << std::hash<std::string>()(urlStream.str()) << ".xml";
+      m_FileName = m_CacheDirectory + "/" + cacheName.str();
+      m_Curl->SetSkipExistingFiles(true);
+    }
+
+    if (!m_Curl->GetSkipExistingFiles() || !itksys::SystemTools::FileExists(m_FileName, true))
+    {
+      // First check if the request does not cross the server
+      // limitations :
+      if (m_Curl->IsCurlReturnHttpError(urlStream.str()))
+      {
+        itkExceptionMacro(<< "The OSM Server returned an Error > =400,"
+                          << " it means that one of server limits are crossed : node/way/relation or area requested");
+      }
 
-    // Use Curl to request the OSM Server
-    // TODO use the RetrieveUrlInMemory
-    m_Curl->RetrieveFile(urlStream.str(), m_FileName);
+      // Use Curl to request the OSM Server, with retries and resumed
+      // transfers
+      // TODO use the RetrieveUrlInMemory
+      if (m_Curl->RetrieveFileMulti(std::vector<std::string>(1, urlStream.str()), std::vector<std::string>(1, m_FileName), 1) != 0)
+      {
+        itkExceptionMacro(<< "Failed to download the OSM data from " << urlStream.str());
+      }
+    }
+    else
+    {
+      otbMsgDevMacro(<< "Reading the OSM data from the cache file " << m_FileName);
+    }
   }
   else
   {
@@ -103,8 +129,9 @@ void OSMDataToVectorDataGenerator::GenerateData()
   // Parse the XML File
   this->ParseXmlFile();
 
-  // Remove the osm temp file only if the url request is used
-  if (m_UseUrl)
+  // Remove the osm temp file only if the url request is used, and the
+  // answer is not cached
+  if (m_UseUrl && m_CacheDirectory.empty())
     if (std::remove(m_FileName.c_str()) != 0)
     {
       itkExceptionMacro(<< "Error while deleting the file" << m_FileName);
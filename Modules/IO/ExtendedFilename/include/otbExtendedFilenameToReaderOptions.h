@@ -43,6 +43,14 @@ namespace otb
  *             - a range of bands : '3:' means 3rd band until the last one
  *                 ':-2' means the first bands until the second to last
  *                 '2:4' means bands 2,3 and 4
+ * - &prefetch : switch to read the next streaming region in the background
+ *           while the current one is processed (GDAL only)
+ * - &resample : resampling method used with &resol (GDAL only), one of nearest,
+ *           bilinear, cubic, cubicspline, lanczos, average, mode or gauss
+ * - &readthreads : number of threads reading each region in parallel,
+ *           through several handles on the file (GDAL only)
+ * - &readahead : number of upcoming regions whose blocks are requested
+ *           with the current one, for remote files (GDAL only)
  *
  *  \sa ImageFileReader
  *
@@ -76,6 +84,10 @@ public:
     std::pair<bool, bool>         skipGeom;
     std::pair<bool, bool>         skipRpcTag;
     std::pair<bool, std::string>  bandRange;
+    std::pair<bool, bool>         prefetch;
+    std::pair<bool, std::string>  resamplingMethod;
+    std::pair<bool, unsigned int> readThreads;
+    std::pair<bool, unsigned int> readAhead;
     std::vector<std::string> optionList;
   };
 
@@ -99,6 +111,14 @@ public:
   bool         SkipRpcTagIsSet() const;
   bool         GetSkipRpcTag() const;
   std::string  GetBandRange() const;
+  bool         PrefetchIsSet() const;
+  bool         GetPrefetch() const;
+  bool         ResamplingMethodIsSet() const;
+  std::string  GetResamplingMethod() const;
+  bool         ReadThreadsIsSet() const;
+  unsigned int GetReadThreads() const;
+  bool         ReadAheadIsSet() const;
+  unsigned int GetReadAhead() const;
 
   /** Test if band range extended filename is set */
   bool BandRangeIsSet() const;
@@ -41,6 +41,15 @@ namespace otb
  * - &nodata=<VALUE>/<VALUE:VALUE...> : to set specific nodata values
  * - &multiwrite=<(bool)false> : to deactivate multi-writing
  * - &epsg=<VALUE> : to set the spatial reference system
+ * - &writethreads=<VALUE> : number of blocks that can be queued to be
+ *   written by a background thread (0 to write synchronously)
+ * - &cog=<(bool)false> : to write GeoTIFF as Cloud Optimized GeoTIFF
+ * - &resume=<(bool)false> : to keep a journal of the written blocks, and
+ *   only write the missing ones when the same image is written again
+ * - &incremental=<(bool)false> : to keep a journal of the inputs of each
+ *   written block, and only compute again the blocks whose inputs changed
+ * - &compress=<PRESET> : compression preset of GeoTIFF files (none, fast,
+ *   lzw, deflate or zstd), compressed by several threads
  *
  * See http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for
  * more information
@@ -83,6 +92,11 @@ public:
     std::pair<bool, std::string> box;
     std::pair<bool, std::string> bandRange;
     std::pair<bool, unsigned int> srsValue;
+    std::pair<bool, unsigned int> writeThreads;
+    std::pair<bool, bool>        cloudOptimized;
+    std::pair<bool, bool>        resume;
+    std::pair<bool, bool>        incremental;
+    std::pair<bool, std::string> compression;
     std::vector<std::string> optionList;
   };
 
@@ -120,6 +134,16 @@ public:
   std::string GetBandRange() const;
   bool        SrsValueIsSet() const;
   unsigned int GetSrsValue() const;
+  bool        WriteThreadsIsSet() const;
+  unsigned int GetWriteThreads() const;
+  bool        CloudOptimizedIsSet() const;
+  bool        GetCloudOptimized() const;
+  bool        ResumeIsSet() const;
+  bool        GetResume() const;
+  bool        IncrementalIsSet() const;
+  bool        GetIncremental() const;
+  bool        CompressionIsSet() const;
+  std::string GetCompression() const;
 
   bool        BoxIsSet() const;
   std::string GetBox() const;
@@ -51,6 +51,18 @@ ExtendedFilenameToReaderOptions::ExtendedFilenameToReaderOptions() : ExtendedFil
   m_Options.bandRange.first  = false;
   m_Options.bandRange.second = "";
 
+  m_Options.prefetch.first  = false;
+  m_Options.prefetch.second = false;
+
+  m_Options.resamplingMethod.first  = false;
+  m_Options.resamplingMethod.second = "";
+
+  m_Options.readThreads.first  = false;
+  m_Options.readThreads.second = 1;
+
+  m_Options.readAhead.first  = false;
+  m_Options.readAhead.second = 0;
+
   m_Options.optionList.push_back("geom");
   m_Options.optionList.push_back("sdataidx");
   m_Options.optionList.push_back("resol");
@@ -58,6 +70,10 @@ ExtendedFilenameToReaderOptions::ExtendedFilenameToReaderOptions() : ExtendedFil
   m_Options.optionList.push_back("skipgeom");
   m_Options.optionList.push_back("skiprpctag");
   m_Options.optionList.push_back("bands");
+  m_Options.optionList.push_back("prefetch");
+  m_Options.optionList.push_back("resample");
+  m_Options.optionList.push_back("readthreads");
+  m_Options.optionList.push_back("readahead");
 }
 
 void ExtendedFilenameToReaderOptions::SetExtendedFileName(const char* extFname)
@@ -122,6 +138,44 @@ void ExtendedFilenameToReaderOptions::SetExtendedFileName(const std::string& ext
     }
   }
 
+  if (!map["prefetch"].empty())
+  {
+    m_Options.prefetch.first = true;
+    if (map["prefetch"] == "On" || map["prefetch"] == "on" || map["prefetch"] == "ON" || map["prefetch"] == "true" || map["prefetch"] == "True" ||
+        map["prefetch"] == "1")
+    {
+      m_Options.prefetch.second = true;
+    }
+  }
+
+  if (!map["readthreads"].empty())
+  {
+    m_Options.readThreads.first  = true;
+    m_Options.readThreads.second = atoi(map["readthreads"].c_str());
+  }
+
+  if (!map["readahead"].empty())
+  {
+    m_Options.readAhead.first  = true;
+    m_Options.readAhead.second = atoi(map["readahead"].c_str());
+  }
+
+  if (!map["resample"].empty())
+  {
+    const std::string& method = map["resample"];
+    if (method == "nearest" || method == "bilinear" || method == "cubic" || method == "cubicspline" || method == "lanczos" || method == "average" ||
+        method == "mode" || method == "gauss")
+    {
+      m_Options.resamplingMethod.first  = true;
+      m_Options.resamplingMethod.second = method;
+    }
+    else
+    {
+      itkExceptionMacro("Unknown value " << method
+                                         << " for resampling method. Expect one of nearest, bilinear, cubic, cubicspline, lanczos, average, mode or gauss");
+    }
+  }
+
   if (!map["bands"].empty())
   {
     // Basic check on bandRange (using regex)
@@ -224,4 +278,44 @@ std::string ExtendedFilenameToReaderOptions::GetBandRange() const
   return m_Options.bandRange.second;
 }
 
+bool ExtendedFilenameToReaderOptions::PrefetchIsSet() const
+{
+  return m_Options.prefetch.first;
+}
+
+bool ExtendedFilenameToReaderOptions::GetPrefetch() const
+{
+  return m_Options.prefetch.second;
+}
+
+bool ExtendedFilenameToReaderOptions::ResamplingMethodIsSet() const
+{
+  return m_Options.resamplingMethod.first;
+}
+
+std::string ExtendedFilenameToReaderOptions::GetResamplingMethod() const
+{
+  return m_Options.resamplingMethod.second;
+}
+
+bool ExtendedFilenameToReaderOptions::ReadThreadsIsSet() const
+{
+  return m_Options.readThreads.first;
+}
+
+unsigned int ExtendedFilenameToReaderOptions::GetReadThreads() const
+{
+  return m_Options.readThreads.second;
+}
+
+bool ExtendedFilenameToReaderOptions::ReadAheadIsSet() const
+{
+  return m_Options.readAhead.first;
+}
+
+unsigned int ExtendedFilenameToReaderOptions::GetReadAhead() const
+{
+  return m_Options.readAhead.second;
+}
+
 } // end namespace otb
@@ -54,8 +54,23 @@ ExtendedFilenameToWriterOptions::ExtendedFilenameToWriterOptions() : ExtendedFil
 
   m_Options.srsValue.first = false;
 
+  m_Options.writeThreads.first  = false;
+  m_Options.writeThreads.second = 0;
+
+  m_Options.cloudOptimized.first  = false;
+  m_Options.cloudOptimized.second = false;
+
+  m_Options.resume.first  = false;
+  m_Options.resume.second = false;
+
+  m_Options.incremental.first  = false;
+  m_Options.incremental.second = false;
+
+  m_Options.compression.first  = false;
+  m_Options.compression.second = "";
+
   m_Options.optionList = {"writegeom", "writerpctags", "multiwrite", "streaming:type",
-    "streaming:sizemode", "streaming:sizevalue", "nodata", "box", "bands", "epsg"};
+    "streaming:sizemode", "streaming:sizevalue", "nodata", "box", "bands", "epsg", "writethreads", "cog", "resume", "incremental", "compress"};
 }
 
 void ExtendedFilenameToWriterOptions::SetExtendedFileName(const char* extFname)
@@ -153,14 +168,14 @@ void ExtendedFilenameToWriterOptions::SetExtendedFileName(const std::string& ext
   if (!map["streaming:type"].empty())
   {
     if (map["streaming:type"] == "auto" || map["streaming:type"] == "tiled" ||
-        map["streaming:type"] == "stripped" || map["streaming:type"] == "none")
+        map["streaming:type"] == "stripped" || map["streaming:type"] == "aligned" || map["streaming:type"] == "none")
     {
       m_Options.streamingType.first  = true;
       m_Options.streamingType.second = map["streaming:type"];
     }
     else
     {
-      itkWarningMacro("Unknown value " << map["streaming:type"] << " for streaming:type option. Available values are auto,tiled,stripped.");
+      itkWarningMacro("Unknown value " << map["streaming:type"] << " for streaming:type option. Available values are auto,tiled,stripped,aligned,none.");
     }
   }
 
@@ -246,6 +261,70 @@ void ExtendedFilenameToWriterOptions::SetExtendedFileName(const std::string& ext
     }
   }
 
+  if (!map["writethreads"].empty())
+  {
+    int depth;
+    try
+    {
+      depth = std::stoi(map["writethreads"]);
+    }
+    catch (const std::invalid_argument&)
+    {
+      itkWarningMacro("Invalid value (" << map["writethreads"] << ") for writethreads. Must be integer.");
+      depth = 0;
+    }
+    if (depth < 0)
+    {
+      itkWarningMacro("Invalid value (" << map["writethreads"] << ") for writethreads. Must be positive.");
+      depth = 0;
+    }
+    m_Options.writeThreads.first  = true;
+    m_Options.writeThreads.second = static_cast<unsigned int>(depth);
+  }
+
+  if (!map["cog"].empty())
+  {
+    m_Options.cloudOptimized.first = true;
+    if (map["cog"] == "On" || map["cog"] == "on" || map["cog"] == "ON" ||
+        map["cog"] == "true" || map["cog"] == "True" || map["cog"] == "1")
+    {
+      m_Options.cloudOptimized.second = true;
+    }
+  }
+
+  if (!map["resume"].empty())
+  {
+    m_Options.resume.first = true;
+    if (map["resume"] == "On" || map["resume"] == "on" || map["resume"] == "ON" ||
+        map["resume"] == "true" || map["resume"] == "True" || map["resume"] == "1")
+    {
+      m_Options.resume.second = true;
+    }
+  }
+
+  if (!map["incremental"].empty())
+  {
+    m_Options.incremental.first = true;
+    if (map["incremental"] == "On" || map["incremental"] == "on" || map["incremental"] == "ON" || map["incremental"] == "true" ||
+        map["incremental"] == "True" || map["incremental"] == "1")
+    {
+      m_Options.incremental.second = true;
+    }
+  }
+
+  if (!map["compress"].empty())
+  {
+    if (map["compress"] == "none" || map["compress"] == "fast" || map["compress"] == "lzw" || map["compress"] == "deflate" || map["compress"] == "zstd")
+    {
+      m_Options.compression.first  = true;
+      m_Options.compression.second = map["compress"];
+    }
+    else
+    {
+      itkWarningMacro("Unknown value " << map["compress"] << " for compress option. Available values are none,fast,lzw,deflate,zstd.");
+    }
+  }
+
   // Option Checking
   for (it = map.begin(); it != map.end(); it++)
   {
@@ -376,4 +455,54 @@ unsigned int ExtendedFilenameToWriterOptions::GetSrsValue() const
   return m_Options.srsValue.second;
 }
 
+bool ExtendedFilenameToWriterOptions::WriteThreadsIsSet() const
+{
+  return m_Options.writeThreads.first;
+}
+
+unsigned int ExtendedFilenameToWriterOptions::GetWriteThreads() const
+{
+  return m_Options.writeThreads.second;
+}
+
+bool ExtendedFilenameToWriterOptions::CloudOptimizedIsSet() const
+{
+  return m_Options.cloudOptimized.first;
+}
+
+bool ExtendedFilenameToWriterOptions::GetCloudOptimized() const
+{
+  return m_Options.cloudOptimized.second;
+}
+
+bool ExtendedFilenameToWriterOptions::ResumeIsSet() const
+{
+  return m_Options.resume.first;
+}
+
+bool ExtendedFilenameToWriterOptions::GetResume() const
+{
+  return m_Options.resume.second;
+}
+
+bool ExtendedFilenameToWriterOptions::IncrementalIsSet() const
+{
+  return m_Options.incremental.first;
+}
+
+bool ExtendedFilenameToWriterOptions::GetIncremental() const
+{
+  return m_Options.incremental.second;
+}
+
+bool ExtendedFilenameToWriterOptions::CompressionIsSet() const
+{
+  return m_Options.compression.first;
+}
+
+std::string ExtendedFilenameToWriterOptions::GetCompression() const
+{
+  return m_Options.compression.second;
+}
+
 } // end namespace otb
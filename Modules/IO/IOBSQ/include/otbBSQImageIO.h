@@ -24,8 +24,10 @@
 #include <string>
 #include <vector>
 #include <fstream>
+#include <memory>
 
 #include "otbImageIOBase.h"
+#include "otbMappedFile.h"
 
 namespace otb
 {
@@ -181,6 +183,9 @@ private:
   std::string                 m_TypeBsq;
   std::vector<std::string>    m_ChannelsFileName;
   std::fstream*               m_ChannelsFile;
+
+  /** Memory mapping of the channel files, empty if they can not be mapped */
+  std::vector<std::unique_ptr<MappedFile>> m_MappedChannels;
 };
 
 } // end namespace otb
@@ -153,6 +153,33 @@ void BSQImageIO::Read(void* buffer)
   // Update the step variable
   step = step * (unsigned long)(this->GetComponentSize());
 
+  // Fast path: interleave the lines of each channel straight from the
+  // mapped channel files, swapping the bytes on the fly
+  if (!m_MappedChannels.empty())
+  {
+    const bool        swapBytes    = m_ByteOrder != m_FileByteOrder;
+    const std::size_t columnOffset = this->GetComponentSize() * lFirstColumn;
+    const std::size_t regionBegin  = numberOfBytesPerLines * lFirstLine + columnOffset;
+    const std::size_t regionEnd    = numberOfBytesPerLines * (lFirstLine + lNbLines - 1) + columnOffset + numberOfBytesToBeRead;
+    for (unsigned int nbComponents = 0; nbComponents < this->GetNumberOfComponents(); ++nbComponents)
+    {
+      const MappedFile& channel = *m_MappedChannels[nbComponents];
+      if (regionEnd > channel.GetSize())
+      {
+        itkExceptionMacro(<< "BSQImageIO::Read() Can Read the specified Region"); // read failed
+      }
+      channel.WillNeed(regionBegin, regionEnd - regionBegin);
+      cpt = (unsigned long)(nbComponents) * (unsigned long)(this->GetComponentSize());
+      for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
+      {
+        MappedFile::CopyComponents(channel.GetData() + numberOfBytesPerLines * LineNo + columnOffset, lNbColumns, this->GetComponentSize(), &(p[cpt]), step,
+                                   swapBytes);
+        cpt += step * lNbColumns;
+      }
+    }
+    return;
+  }
+
   char* value = new char[numberOfBytesToBeRead];
   if (value == nullptr)
   {
@@ -234,6 +261,20 @@ void BSQImageIO::ReadImageInformation()
   // Read header information
   InternalReadHeaderInformation(m_FileName, m_HeaderFile, true);
 
+  // Map the channel files, Read() falls back to the streams if one of
+  // them can not be mapped
+  m_MappedChannels.clear();
+  for (const auto& channelFileName : m_ChannelsFileName)
+  {
+    std::unique_ptr<MappedFile> channel(new MappedFile);
+    if (!channel->Open(channelFileName))
+    {
+      m_MappedChannels.clear();
+      break;
+    }
+    m_MappedChannels.push_back(std::move(channel));
+  }
+
   otbMsgDebugMacro(<< "Driver to read: BSQ");
   otbMsgDebugMacro(<< "         Read  file         : " << m_FileName);
   otbMsgDebugMacro(<< "         Size               : " << m_Dimensions[0] << "," << m_Dimensions[1]);
@@ -635,6 +676,7 @@ void BSQImageIO::WriteImageInformation()
   }
 
   // Allocate  buffer of stream file
+  m_MappedChannels.clear();
   m_ChannelsFile = new std::fstream[this->GetNumberOfComponents()];
 
   // Try to open channels file
@@ -24,9 +24,17 @@
 #include "otbImage.h"
 #include "otbGDALDriverManagerWrapper.h"
 
+#include <cstddef>
+#include <memory>
+
 namespace otb
 {
 
+namespace DEMDetails
+{
+class TileCache;
+}
+
 
 
 /** \class DEMObserverInterface
@@ -93,6 +101,12 @@ class DEMSubjectInterface {
  * - SRTM available, but no geoid: srtm_value
  * - No SRTM and no geoid available: 0
  *
+ * Elevation values are read by tiles of the DEM and geoid datasets, which
+ * are kept in a cache shared by all threads. The least recently used tiles
+ * are evicted once the cache exceeds its size, which defaults to a quarter
+ * of ConfigurationManager::GetMaxRAMHint(). The cache is cleared whenever
+ * the DEM configuration changes.
+ *
  * \ingroup OTBIOGDAL
  */
 class DEMHandler : public DEMSubjectInterface
@@ -136,6 +150,14 @@ public:
   double GetHeightAboveEllipsoid(double lon, double lat) const;
 
   double GetHeightAboveEllipsoid(const PointType& geoPoint) const;
+
+  /** Return the height above the ellipsoid of n points
+   * \param lon input longitudes
+   * \param lat input latitudes
+   * \param height output heights above ellipsoid
+   * \param n number of points
+   */
+  void GetHeightAboveEllipsoid(const double* lon, const double* lat, double* height, std::size_t n) const;
  
   /** Return the height above the mean sea level :
    * - SRTM and geoid both available: srtm_value
@@ -150,6 +172,14 @@ public:
 
   double GetHeightAboveMSL(const PointType& geoPoint) const;
 
+  /** Return the height above the mean sea level of n points
+   * \param lon input longitudes
+   * \param lat input latitudes
+   * \param height output heights above mean sea level
+   * \param n number of points
+   */
+  void GetHeightAboveMSL(const double* lon, const double* lat, double* height, std::size_t n) const;
+
   /** Return the number of DEM opened */
   unsigned int GetDEMCount() const;
   
@@ -168,6 +198,12 @@ public:
 
   /** Clear the DEM list and close all DEM datasets */
   void ClearDEMs();
+
+  /** Set the maximum size of the DEM tile cache, in bytes */
+  void SetTileCacheSize(std::size_t size);
+
+  /** Get the maximum size of the DEM tile cache, in bytes */
+  std::size_t GetTileCacheSize() const;
   
   /** Add an element to the current list of observers. The obsever will be updated whenever the DEM configuration
   is modified*/
@@ -219,6 +255,9 @@ private:
 
   /** Observers on the DEM */
   std::list<DEMObserverInterface *> m_ObserverList;
+
+  /** Cache of the DEM and geoid tiles */
+  std::unique_ptr<DEMDetails::TileCache> m_TileCache;
 };
 
 }
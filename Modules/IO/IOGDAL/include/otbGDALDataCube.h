@@ -0,0 +1,188 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGDALDataCube_h
+#define otbGDALDataCube_h
+
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "OTBIOGDALExport.h"
+
+namespace otb
+{
+
+/** \class GDALDataCube
+ * \brief Read and write a chunked (time, band, y, x) array as one
+ * multi-band image
+ *
+ * The array is accessed through the GDAL multidimensional API, which
+ * supports among others the Zarr and netCDF-4 formats. Arrays of 2, 3
+ * or 4 dimensions are supported: the last two are the y and x
+ * dimensions, the first one of an array of 3 or 4 dimensions is the time
+ * dimension, and the second one of an array of 4 dimensions is the band
+ * dimension.
+ *
+ * The components of a pixel are its bands for each date, date after
+ * date: component t * NumberOfBands + b holds band b of date t, so that
+ * the time series of a pixel is contiguous in the pixel interleaved
+ * buffers of Read() and Write(). Each read or write of a region is a
+ * single strided access of the array, which lets GDAL decode or encode
+ * each chunk only once.
+ *
+ * Read() splits the region along the chunk rows between up to
+ * numberOfThreads tasks, each one reading through its own handle of the
+ * dataset, so that the chunks are decompressed in parallel.
+ *
+ * The spatial extent is derived from the indexing variables of the x
+ * and y dimensions, which hold the coordinates of the pixel centers.
+ *
+ * GDAL 3.1 or later is required.
+ *
+ * \sa ImageFileCubeReader
+ * \sa ImageFileCubeWriter
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT GDALDataCube
+{
+public:
+  /** Open an array of an existing file, the first array of 2 dimensions or
+   * more of the root group if the name is empty. Throw if the array
+   * cannot be opened */
+  GDALDataCube(const std::string& fileName, const std::string& arrayName = "");
+
+  /** Create a file with the given driver ("Zarr", "netCDF"...) holding a
+   * (time, band, y, x) array of the given GDALDataType, chunked by
+   * (1, 1, chunkHeight, chunkWidth). The band dimension is omitted when
+   * there is a single band. Extra array creation options can be given as
+   * "KEY=VALUE" strings */
+  GDALDataCube(const std::string& fileName, const std::string& driverName, const std::string& arrayName, unsigned int width, unsigned int height,
+               unsigned int numberOfTimes, unsigned int numberOfBands, int dataType, unsigned int chunkWidth, unsigned int chunkHeight,
+               const std::vector<std::string>& creationOptions = std::vector<std::string>());
+
+  ~GDALDataCube();
+
+  GDALDataCube(const GDALDataCube&) = delete;
+  GDALDataCube& operator=(const GDALDataCube&) = delete;
+
+  unsigned int GetWidth() const
+  {
+    return m_Width;
+  }
+
+  unsigned int GetHeight() const
+  {
+    return m_Height;
+  }
+
+  unsigned int GetNumberOfTimes() const
+  {
+    return m_NumberOfTimes;
+  }
+
+  unsigned int GetNumberOfBands() const
+  {
+    return m_NumberOfBands;
+  }
+
+  /** Number of components of a pixel: bands times dates */
+  unsigned int GetNumberOfComponents() const
+  {
+    return m_NumberOfTimes * m_NumberOfBands;
+  }
+
+  unsigned int GetChunkWidth() const
+  {
+    return m_ChunkWidth;
+  }
+
+  unsigned int GetChunkHeight() const
+  {
+    return m_ChunkHeight;
+  }
+
+  /** GDALDataType of the array */
+  int GetDataType() const
+  {
+    return m_DataType;
+  }
+
+  /** Coordinates of the center of the first pixel and signed pixel
+   * spacing. Returns false if the x or y dimension has no regularly
+   * spaced indexing variable */
+  bool GetGeoTransform(double origin[2], double spacing[2]) const;
+
+  /** Create the indexing variables of the x and y dimensions of a new
+   * cube from the center of the first pixel and the pixel spacing */
+  void SetGeoTransform(const double origin[2], const double spacing[2]);
+
+  /** Spatial reference of the array as WKT, empty if unknown */
+  std::string GetProjectionRef() const;
+
+  void SetProjectionRef(const std::string& wkt);
+
+  /** No-data value of the array, returns false if there is none */
+  bool GetNoDataValue(double& value) const;
+
+  void SetNoDataValue(double value);
+
+  /** Read a region of all the components into a pixel interleaved
+   * buffer of the given GDALDataType */
+  void Read(void* buffer, int dataType, int x, int y, int sizeX, int sizeY, unsigned int numberOfThreads = 1) const;
+
+  /** Write a region of all the components from a pixel interleaved
+   * buffer of the given GDALDataType */
+  void Write(const void* buffer, int dataType, int x, int y, int sizeX, int sizeY);
+
+private:
+  struct Handle;
+
+  std::unique_ptr<Handle> OpenHandle() const;
+
+  /** Take a handle of the pool, or open a new one */
+  std::unique_ptr<Handle> AcquireHandle() const;
+
+  void ReleaseHandle(std::unique_ptr<Handle> handle) const;
+
+  std::string m_FileName;
+  std::string m_ArrayName;
+
+  unsigned int m_Width;
+  unsigned int m_Height;
+  unsigned int m_NumberOfTimes;
+  unsigned int m_NumberOfBands;
+  unsigned int m_ChunkWidth;
+  unsigned int m_ChunkHeight;
+  int          m_DataType;
+
+  /** Handle used for the metadata and the writes */
+  std::unique_ptr<Handle> m_Handle;
+
+  /** Extra read handles, one per concurrent read task */
+  mutable std::vector<std::unique_ptr<Handle>> m_HandlePool;
+  mutable std::mutex                           m_HandlePoolMutex;
+};
+
+} // namespace otb
+
+#endif
@@ -25,6 +25,7 @@
 #include "itkLightObject.h"
 #include "itkProcessObject.h"
 #include "otbConfigure.h"
+#include <mutex>
 
 class GDALDataset;
 class GDALDriver;
@@ -49,7 +50,7 @@ namespace otb
  *
  * This class provides an unique instance of GDALDataSet which remain
  * available during all the program lifetime. This class automatically
- * allocate and destroy the available gdal drivers.
+ * registers the available gdal drivers on first use.
  *
  * \ingroup IOFilters
  *
@@ -76,6 +77,9 @@ public:
   // Open the file for reading and returns a smart dataset pointer
   GDALDatasetWrapper::Pointer Open(std::string filename) const;
 
+  // Open an existing file for update and returns a smart dataset pointer
+  GDALDatasetWrapper::Pointer OpenForUpdate(std::string filename) const;
+
   // Open the new  file for writing and returns a smart dataset pointer
   GDALDatasetWrapper::Pointer Create(std::string& driverShortName, std::string filename, int nXSize, int nYSize, int nBands, GDALDataType eType,
                                      char** papszOptions) const;
@@ -83,11 +87,18 @@ public:
 
   GDALDriver* GetDriverByName(std::string driverShortName) const;
 
+  // Register the GDAL drivers. Called on first use by the methods above, it
+  // only needs to be called before using the GDAL API directly
+  void RegisterDrivers() const;
+
 private:
   // private constructor so that this class is allocated only inside GetInstance
   GDALDriverManagerWrapper();
 
   ~GDALDriverManagerWrapper();
+
+  // Make sure the drivers are registered only once
+  mutable std::once_flag m_RegisterFlag;
 }; // end of GDALDriverManagerWrapper
 
 
@@ -25,6 +25,9 @@
 
 /* C++ Libraries */
 #include <string>
+#include <vector>
+#include <future>
+#include <memory>
 
 /* ITK Libraries */
 #include "otbImageIOBase.h"
@@ -33,11 +36,13 @@
 
 #include "OTBIOGDALExport.h"
 #include "otbSpatialReference.h"
+#include "otbGDALStreamedOverviews.h"
 
 namespace otb
 {
 class GDALDatasetWrapper;
 class GDALDataTypeWrapper;
+class GDALDatasetPool;
 
 /** \class GDALImageIO
  *
@@ -65,7 +70,26 @@ class GDALDataTypeWrapper;
  * physical space as GDAL physical space : a given point of
  * image has the same physical location in OTB and in GDAL.
  *
- * The streaming read is implemented.
+ * The streaming read is implemented. Optionally (see SetPrefetch()),
+ * the region expected to be requested next is read by a background
+ * task while the current one is being processed downstream. The next
+ * region is guessed from the scan order of the previous requests; if
+ * the guess is wrong, the prefetched data is dropped and the requested
+ * region is read synchronously.
+ *
+ * On remote files (/vsicurl/, /vsis3/...), the reads of the next regions
+ * can be announced to GDAL (see SetNumberOfReadAheadRegions()), so that
+ * the blocks of several regions are fetched by a single multi-range
+ * request instead of one request per block.
+ *
+ * Large regions can be read by several threads (see
+ * SetNumberOfReadThreads()). The region is split into strips of whole
+ * rows of GDAL blocks, each read through its own handle on the file, so
+ * that the decompression of the blocks runs in parallel.
+ *
+ * The number of datasets opened for reading at the same time is bounded
+ * (see ConfigurationManager::GetMaxOpenDatasets()). The least recently
+ * read datasets are closed, and opened again when they are accessed.
  *
  * \ingroup IOFilters
  *
@@ -112,6 +136,69 @@ public:
   itkSetMacro(WriteRPCTags, bool);
   itkGetMacro(WriteRPCTags, bool);
 
+  /** Set/Get whether the next streaming region is read in the background
+   *  while the current one is processed (read-ahead, disabled by default) */
+  itkSetMacro(Prefetch, bool);
+  itkGetMacro(Prefetch, bool);
+  itkBooleanMacro(Prefetch);
+
+  /** Set/Get the number of regions, following the scan order of the
+   *  previous requests, whose reads are announced to GDAL with the read of
+   *  the current one (GDALDataset::AdviseRead()). Drivers reading remote
+   *  files then fetch all their blocks at once. 0 (default) disables it */
+  itkSetMacro(NumberOfReadAheadRegions, unsigned int);
+  itkGetMacro(NumberOfReadAheadRegions, unsigned int);
+
+  /** Set/Get the number of threads reading each region (1 by default).
+   *  Each extra thread opens its own handle on the file. Decimated and
+   *  indexed reads always use a single thread. 0 is handled as 1 */
+  itkSetMacro(NumberOfReadThreads, unsigned int);
+  itkGetMacro(NumberOfReadThreads, unsigned int);
+
+  /** Tell if the region read last is empty in the file, according to
+   *  GDALGetDataCoverageStatus(): no block of the region has ever been
+   *  written in a sparse file (e.g. a GeoTIFF created with SPARSE_OK).
+   *  Such regions read as the no-data value of the bands */
+  itkGetConstMacro(IORegionIsEmpty, bool);
+
+  /** Tell that the next region written only holds no-data pixels. When
+   *  the file is a GeoTIFF created with SPARSE_OK=TRUE, the region is then
+   *  not written: its blocks are left empty, and read back as the no-data
+   *  value of the bands. Reset after each write */
+  itkSetMacro(IORegionIsNoData, bool);
+
+  /** Set/Get the resampling method used when reading at a coarser
+   *  resolution (see the ResolutionFactor metadata): nearest (default),
+   *  bilinear, cubic, cubicspline, lanczos, average, mode or gauss */
+  itkSetStringMacro(ResamplingMethod);
+  itkGetStringMacro(ResamplingMethod);
+
+  /** Set/Get whether GeoTIFF files are written as Cloud Optimized GeoTIFF
+   *  (tiled, with internal overviews computed while streaming) */
+  itkSetMacro(CloudOptimized, bool);
+  itkGetMacro(CloudOptimized, bool);
+
+  /** Set/Get whether a streamed write updates the existing file instead
+   *  of creating a new one, so that an interrupted write can be resumed.
+   *  The file is created anyway if its size, number of bands or pixel type
+   *  do not match the image to write */
+  itkSetMacro(UpdateExistingFile, bool);
+  itkGetMacro(UpdateExistingFile, bool);
+
+  /** Set/Get the compression preset of GeoTIFF files: none, fast (ZSTD
+   *  at its fastest level, or DEFLATE if GDAL has no ZSTD support), lzw,
+   *  deflate or zstd. Empty (default) keeps the COMPRESS creation option.
+   *  An explicit COMPRESS creation option has precedence */
+  itkSetStringMacro(CompressionPreset);
+  itkGetStringMacro(CompressionPreset);
+
+  /** Set/Get the number of threads compressing the blocks of the written
+   *  files, for drivers supporting the NUM_THREADS creation option. 0
+   *  (default) uses the number of threads of OTB. An explicit NUM_THREADS
+   *  creation option has precedence */
+  itkSetMacro(NumberOfCompressionThreads, unsigned int);
+  itkGetMacro(NumberOfCompressionThreads, unsigned int);
+
 
   /** Set/Get the options */
   void SetOptions(const GDALCreationOptionsType& opts)
@@ -271,6 +358,9 @@ private:
   GDALImageIO(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** The pool closes and opens again m_Dataset */
+  friend class GDALDatasetPool;
+
   /** Determine real file name to write the image */
   std::string GetGdalWriteImageFileName(const std::string& gdalDriverShortName, const std::string& filename) const;
 
@@ -284,6 +374,50 @@ private:
    */
   bool CreationOptionContains(std::string partialOption) const;
 
+  /** Return the creation options of the written file, completed with the
+   *  compression preset and the number of compression threads */
+  GDALCreationOptionsType GetWriteCreationOptions(const std::string& driverShortName) const;
+
+  /** Read the given region (expressed at the current resolution factor)
+   *  into the buffer provided, with synchronous GDAL calls */
+  void InternalRead(const itk::ImageIORegion& region, unsigned char* p);
+
+  /** Tell if no block of the given region has ever been written in the
+   *  file. Must not be called while a read-ahead is running */
+  bool IsRegionEmpty(const itk::ImageIORegion& region);
+
+  /** Tell if the blocks of written no-data regions can be left empty */
+  bool CanSkipNoDataRegions() const;
+
+  /** Guess the region that will be requested after the given one, by
+   *  following the scan order (tiles along lines, then next line of tiles)
+   *  observed during the previous calls. Returns false if no guess can be
+   *  made (for instance at the end of the image) */
+  bool PredictNextRegion(const itk::ImageIORegion& current, itk::ImageIORegion& next);
+
+  /** Guess the region following the given one in the scan order observed
+   *  so far, without updating it */
+  bool NextRegionInScanOrder(const itk::ImageIORegion& current, itk::ImageIORegion& next) const;
+
+  /** Announce to GDAL the read of the region and of the regions expected
+   *  after it, unless it has already been announced. The dataset must be
+   *  accessed by the caller */
+  void AdviseReadAhead(const itk::ImageIORegion& region);
+
+  /** Start reading the given region in the background */
+  void StartPrefetch(const itk::ImageIORegion& region);
+
+  /** Wait for the pending background read (if any), and return true if it
+   *  succeeded and holds the given region */
+  bool WaitForPrefetch(const itk::ImageIORegion& region);
+
+  /** Wait for the pending background read (if any) and discard it. Must be
+   *  called before any other access to the dataset */
+  void CancelPrefetch();
+
+  /** Copy the temporary tiled file to its final Cloud Optimized layout */
+  void FinalizeCloudOptimized();
+
   /** Dump the ImageMetadata content into GDAL metadata */
   void ExportMetadata();
 
@@ -293,6 +427,8 @@ private:
   /** GDAL parameters. */
   typedef itk::SmartPointer<GDALDatasetWrapper> GDALDatasetWrapperPointer;
   GDALDatasetWrapperPointer                     m_Dataset;
+  /** Name of the dataset opened for reading, to open it again */
+  std::string m_DatasetName;
   unsigned int                                  m_epsgCode;
 
   GDALDataTypeWrapper* m_PxType;
@@ -340,6 +476,57 @@ private:
 
 
   NoDataListType m_NoDataList;
+
+  /** True if read-ahead of the next streaming region is enabled */
+  bool m_Prefetch;
+
+  /** Pending background read, and the region it has been started for */
+  std::future<bool>  m_PrefetchRequest;
+  itk::ImageIORegion m_PrefetchRegion;
+
+  /** Buffer receiving the background read. It is reused from one region to
+   *  the next, so that at most one extra region is held in memory */
+  std::vector<unsigned char> m_PrefetchBuffer;
+
+  /** Scan order observed so far: last region read, first region of
+   *  the current line of tiles, and steps between consecutive regions */
+  itk::ImageIORegion m_LastReadRegion;
+  itk::ImageIORegion m_LineStartRegion;
+  long               m_PrefetchColumnStep;
+  long               m_PrefetchLineStep;
+
+  /** Number of regions announced ahead of the current one, and bounding
+   *  box of the regions announced last */
+  unsigned int       m_NumberOfReadAheadRegions;
+  itk::ImageIORegion m_AdvisedRegion;
+
+  /** Number of threads reading each region, and the handles on the file
+   *  used by the extra threads, opened on first use */
+  unsigned int                           m_NumberOfReadThreads;
+  std::vector<GDALDatasetWrapperPointer> m_ReadDatasets;
+
+  /** True if the region read last is empty in the file, and if the
+   *  region to write only holds no-data pixels */
+  bool m_IORegionIsEmpty;
+  bool m_IORegionIsNoData;
+
+  /** Resampling method of decimated reads */
+  std::string m_ResamplingMethod;
+
+  /** True if GeoTIFF files are written as Cloud Optimized GeoTIFF */
+  bool m_CloudOptimized;
+
+  /** True if streamed writes update the existing file */
+  bool m_UpdateExistingFile;
+
+  /** Compression preset, and number of compression threads */
+  std::string  m_CompressionPreset;
+  unsigned int m_NumberOfCompressionThreads;
+
+  /** Overviews computed while the temporary file is written, and the name
+   *  of this file */
+  std::unique_ptr<GDALStreamedOverviews> m_StreamedOverviews;
+  std::string                            m_CloudOptimizedTemporaryFileName;
 };
 
 } // end namespace otb
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGDALImageStack_h
+#define otbGDALImageStack_h
+
+#include <string>
+#include <vector>
+
+#include "otbGDALDatasetWrapper.h"
+#include "OTBIOGDALExport.h"
+
+class GDALDataset;
+
+namespace otb
+{
+
+/** \class GDALImageStack
+ * \brief Read several images of the same size as one multi-band image
+ *
+ * The bands of the images are stacked in the order of the file names.
+ * Read() fills a pixel interleaved buffer holding all the bands: each
+ * image is read by a single RasterIO call whose pixel and line spacing
+ * write its bands directly at their place in the buffer, so that no
+ * intermediate per-band image nor copy is needed. The images are read
+ * concurrently by up to numberOfThreads tasks.
+ *
+ * When the stack is opened as a VRT, an in-memory VRT dataset
+ * referencing the bands of all the images is built and read with a
+ * single RasterIO call, which lets GDAL schedule the reads of the
+ * sources itself.
+ *
+ * This is used by ImageFileStackReader to concatenate images and to
+ * stack time series.
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT GDALImageStack
+{
+public:
+  /** Open all the images, throw if one of them cannot be opened or
+   * does not have the size of the first one */
+  GDALImageStack(const std::vector<std::string>& fileNames, bool asVRT = false);
+
+  ~GDALImageStack();
+
+  GDALImageStack(const GDALImageStack&) = delete;
+  GDALImageStack& operator=(const GDALImageStack&) = delete;
+
+  unsigned int GetNumberOfImages() const
+  {
+    return m_Datasets.size();
+  }
+
+  /** Total number of bands of the stack */
+  unsigned int GetNumberOfBands() const
+  {
+    return m_FirstBand.back();
+  }
+
+  /** Band of the stack holding the first band of an image */
+  unsigned int GetFirstBand(unsigned int image) const
+  {
+    return m_FirstBand[image];
+  }
+
+  unsigned int GetWidth() const;
+  unsigned int GetHeight() const;
+
+  /** Read a region of all the bands into a pixel interleaved buffer of
+   * the given GDALDataType */
+  void Read(void* buffer, int dataType, int x, int y, int sizeX, int sizeY, unsigned int numberOfThreads = 1) const;
+
+private:
+  void BuildVRT();
+
+  std::vector<GDALDatasetWrapper::Pointer> m_Datasets;
+
+  /** Cumulated number of bands, with a leading zero */
+  std::vector<unsigned int> m_FirstBand;
+
+  GDALDataset* m_VRT;
+};
+
+} // namespace otb
+
+#endif
@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbGDALStreamedOverviews_h
+#define otbGDALStreamedOverviews_h
+
+#include <cstdint>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "OTBIOGDALExport.h"
+
+class GDALDataset;
+
+namespace otb
+{
+
+/** \class GDALStreamedOverviews
+ * \brief Compute the overviews of a dataset while it is written by regions
+ *
+ * The constructor creates the internal overview levels of the dataset,
+ * each one half the size of the previous one. Each full resolution
+ * region passed to AddRegion() is averaged into the first overview
+ * level, which is in turn averaged into the next one, and so on. The
+ * overview pixels whose footprint spans several regions are kept aside
+ * until all their source pixels have been received, so that regions can
+ * come in any order and with any size. Splits aligned on a power of two
+ * leave very few such pixels.
+ *
+ * Source pixels equal to the no-data value of their band are excluded
+ * from the average.
+ *
+ * This is used by GDALImageIO to write Cloud Optimized GeoTIFF without
+ * reading the full resolution image again.
+ *
+ * \sa GDALOverviewsBuilder
+ *
+ * \ingroup OTBIOGDAL
+ */
+class OTBIOGDAL_EXPORT GDALStreamedOverviews
+{
+public:
+  /** Create nbLevels overview levels in the dataset, which must support
+   * internal overviews (GTiff) */
+  GDALStreamedOverviews(GDALDataset* dataset, unsigned int nbLevels);
+
+  /** Add a full resolution region. The buffer holds the pixels of all
+   * bands interleaved, of the given GDALDataType. */
+  void AddRegion(const void* buffer, int dataType, int x, int y, int sizeX, int sizeY);
+
+  /** Number of overview pixels still waiting for some of their source
+   * pixels. It is zero once the whole image has been added. */
+  std::size_t GetNumberOfPendingPixels() const;
+
+  unsigned int GetNumberOfLevels() const
+  {
+    return m_NbLevels;
+  }
+
+  /** Number of levels needed for the smallest overview to fit in one
+   * block of blockSize pixels */
+  static unsigned int ComputeNumberOfLevels(unsigned int sizeX, unsigned int sizeY, unsigned int blockSize);
+
+private:
+  struct PendingPixel
+  {
+    std::vector<double>       Sum;
+    std::vector<unsigned int> Count;
+    unsigned int              Coverage;
+  };
+
+  typedef std::unordered_map<std::uint64_t, PendingPixel> PendingMapType;
+
+  /** Average a region of level into level + 1 */
+  void Decimate(unsigned int level, const double* data, int x, int y, int sizeX, int sizeY);
+
+  /** Write a region of an overview level and propagate it to the next one */
+  void Emit(unsigned int level, const double* data, int x, int y, int sizeX, int sizeY);
+
+  double Average(const std::vector<double>& sum, const std::vector<unsigned int>& count, unsigned int band) const;
+
+  GDALDataset* m_Dataset;
+  unsigned int m_NbBands;
+  unsigned int m_NbLevels;
+
+  /** Size of each level, level 0 being the full resolution */
+  std::vector<int> m_SizeX;
+  std::vector<int> m_SizeY;
+
+  /** Partial overview pixels of each level */
+  std::vector<PendingMapType> m_Pending;
+
+  std::vector<std::pair<bool, double>> m_NoData;
+};
+
+} // end namespace otb
+
+#endif
@@ -91,6 +91,12 @@ public:
    * file specified. */
   bool CanReadFile(const char*) const override;
 
+  /** The spatial filter is applied to the OGR layers */
+  bool CanSpatialFilterRead() const override
+  {
+    return true;
+  }
+
   /** Reads the data from disk into the memory buffer provided. */
   void Read(itk::DataObject* data) override;
 
@@ -34,7 +34,14 @@
 // TODO : RemoveOSSIM
 #include <otbOssimDEMHandler.h>
 
+#include "otbConfigurationManager.h"
+
+#include <algorithm>
+#include <atomic>
+#include <list>
+#include <map>
 #include <mutex>
+#include <unordered_map>
 
 #include "ogr_spatialref.h"
 
@@ -76,32 +83,311 @@ std::vector<std::string> GetFilesInDirectory(const std::string & directoryPath)
 
 std::mutex demMutex;
 
-boost::optional<double> GetDEMValue(double lon, double lat, GDALDataset& ds)
+/** \class TileCache
+ *
+ * \brief LRU cache of decoded DEM tiles, shared by all threads
+ *
+ * Tiles are decoded as double so that the interpolated heights are the same
+ * as when reading the datasets point by point. Each thread keeps hints on
+ * the last tiles it used, so that most lookups do not need the lock.
+ */
+class TileCache
 {
-  const std::lock_guard<std::mutex> lock(demMutex);
+public:
+  static const int TileSize = 256;
+
+  /** Number of tiles hinted per thread (e.g. DEM and geoid, on both sides of a tile border) */
+  static const int NumberOfHints = 4;
+
+  /** Geometry of a dataset, read once */
+  struct DatasetInfo
+  {
+    double geoTransform[6];
+    int    sizeX;
+    int    sizeY;
+    double noDataValue;
+    /** Spatial reference of the dataset if it is not WGS84, null otherwise */
+    std::unique_ptr<OGRSpatialReference> srs;
+  };
+
+  struct Tile
+  {
+    bool                valid;
+    int                 x0;
+    int                 y0;
+    int                 width;
+    std::vector<double> data;
+  };
+
+  explicit TileCache(std::size_t maxSize) : m_Size(0), m_MaxSize(maxSize), m_Generation(0)
+  {
+  }
+
+  void Clear()
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_Tiles.clear();
+    m_LRU.clear();
+    m_Infos.clear();
+    m_Size = 0;
+    ++m_Generation;
+  }
+
+  void SetMaxSize(std::size_t maxSize)
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    m_MaxSize = maxSize;
+    Evict();
+  }
+
+  std::size_t GetMaxSize() const
+  {
+    const std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_MaxSize;
+  }
+
+  std::shared_ptr<const DatasetInfo> GetDatasetInfo(GDALDataset& ds)
+  {
+    thread_local LastInfo hints[NumberOfHints];
+    thread_local int      nextHint   = 0;
+    const unsigned long   generation = m_Generation;
+    for (const auto& hint : hints)
+    {
+      if (hint.cache == this && hint.generation == generation && hint.ds == &ds)
+        return hint.info;
+    }
+
+    std::shared_ptr<const DatasetInfo> info;
+    {
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      auto it = m_Infos.find(&ds);
+      if (it != m_Infos.end())
+        info = it->second;
+    }
+
+    if (!info)
+    {
+      info = ReadDatasetInfo(ds);
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      if (m_Generation == generation)
+        m_Infos[&ds] = info;
+    }
+
+    LastInfo& hint  = hints[nextHint];
+    nextHint        = (nextHint + 1) % NumberOfHints;
+    hint.cache      = this;
+    hint.generation = generation;
+    hint.ds         = &ds;
+    hint.info       = info;
+    return info;
+  }
+
+  /** Read the value of pixel (x, y) of ds. Returns false if the pixel is
+   * outside the dataset or can not be read. */
+  bool GetPixel(GDALDataset& ds, const DatasetInfo& info, int x, int y, double& value)
+  {
+    if (x < 0 || y < 0 || x >= info.sizeX || y >= info.sizeY)
+      return false;
+
+    const Tile& tile = GetTile(ds, x / TileSize, y / TileSize);
+    if (!tile.valid)
+      return false;
+
+    value = tile.data[(y - tile.y0) * tile.width + (x - tile.x0)];
+    return true;
+  }
+
+private:
+  struct Key
+  {
+    GDALDataset* ds;
+    int          x;
+    int          y;
+
+    bool operator==(const Key& other) const
+    {
+      return ds == other.ds && x == other.x && y == other.y;
+    }
+  };
+
+  struct KeyHash
+  {
+    std::size_t operator()(const Key& key) const
+    {
+      return std::hash<const void*>()(key.ds) ^ (std::hash<int>()(key.x) * 31u) ^ (std::hash<int>()(key.y) * 1000003u);
+    }
+  };
+
+  typedef std::list<Key> LRUListType;
+
+  struct Entry
+  {
+    std::shared_ptr<const Tile> tile;
+    LRUListType::iterator       lru;
+  };
+
+  struct LastTile
+  {
+    const TileCache*            cache      = nullptr;
+    unsigned long               generation = 0;
+    Key                         key        = {nullptr, 0, 0};
+    std::shared_ptr<const Tile> tile;
+  };
+
+  struct LastInfo
+  {
+    const TileCache*                   cache      = nullptr;
+    unsigned long                      generation = 0;
+    const GDALDataset*                 ds         = nullptr;
+    std::shared_ptr<const DatasetInfo> info;
+  };
+
+  const Tile& GetTile(GDALDataset& ds, int tileX, int tileY)
+  {
+    thread_local LastTile hints[NumberOfHints];
+    thread_local int      nextHint   = 0;
+    const Key             key        = {&ds, tileX, tileY};
+    const unsigned long   generation = m_Generation;
+    for (const auto& hint : hints)
+    {
+      if (hint.cache == this && hint.generation == generation && hint.key == key)
+        return *hint.tile;
+    }
+
+    std::shared_ptr<const Tile> tile;
+    {
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      auto it = m_Tiles.find(key);
+      if (it != m_Tiles.end())
+      {
+        m_LRU.splice(m_LRU.begin(), m_LRU, it->second.lru);
+        tile = it->second.tile;
+      }
+    }
+
+    if (!tile)
+    {
+      tile = ReadTile(ds, tileX, tileY);
+      const std::lock_guard<std::mutex> lock(m_Mutex);
+      // Don't insert tiles of datasets which have been closed meanwhile
+      if (m_Generation == generation && m_Tiles.find(key) == m_Tiles.end())
+      {
+        m_LRU.push_front(key);
+        m_Tiles[key] = Entry{tile, m_LRU.begin()};
+        m_Size += TileBytes(*tile);
+        Evict();
+      }
+    }
+
+    LastTile& hint  = hints[nextHint];
+    nextHint        = (nextHint + 1) % NumberOfHints;
+    hint.cache      = this;
+    hint.generation = generation;
+    hint.key        = key;
+    hint.tile       = tile;
+    return *hint.tile;
+  }
+
+  static std::size_t TileBytes(const Tile& tile)
+  {
+    return sizeof(Tile) + tile.data.size() * sizeof(double);
+  }
+
+  /** Remove least recently used tiles, keeping at least the last one.
+   * m_Mutex must be locked. */
+  void Evict()
+  {
+    while (m_Size > m_MaxSize && m_LRU.size() > 1)
+    {
+      auto it = m_Tiles.find(m_LRU.back());
+      m_Size -= TileBytes(*it->second.tile);
+      m_Tiles.erase(it);
+      m_LRU.pop_back();
+    }
+  }
+
+  static std::shared_ptr<const DatasetInfo> ReadDatasetInfo(GDALDataset& ds)
+  {
+    const std::lock_guard<std::mutex> lock(demMutex);
+
+    auto info = std::make_shared<DatasetInfo>();
 
 #if GDAL_VERSION_NUM >= 3000000
-  auto srs = ds.GetSpatialRef();
+    auto srs = ds.GetSpatialRef();
 #else
-  auto projRef = ds.GetProjectionRef();
-  
-  std::unique_ptr<OGRSpatialReference> srsUniquePtr;
-  OGRSpatialReference* srs = nullptr;
-  // GetProjectionRef() returns an empty non null string if no projection is available
-  if (strlen(projRef) != 0 )
+    auto projRef = ds.GetProjectionRef();
+
+    std::unique_ptr<OGRSpatialReference> srsUniquePtr;
+    OGRSpatialReference* srs = nullptr;
+    // GetProjectionRef() returns an empty non null string if no projection is available
+    if (strlen(projRef) != 0 )
+    {
+      srsUniquePtr = std::make_unique<OGRSpatialReference>(ds.GetProjectionRef());
+      srs = srsUniquePtr.get();
+    }
+#endif
+
+    if (srs && !srs->IsSame(OGRSpatialReference::GetWGS84SRS()))
+    {
+      info->srs = std::make_unique<OGRSpatialReference>(*srs);
+    }
+
+    ds.GetGeoTransform(info->geoTransform);
+    info->sizeX       = ds.GetRasterXSize();
+    info->sizeY       = ds.GetRasterYSize();
+    info->noDataValue = ds.GetRasterBand(1)->GetNoDataValue();
+    return info;
+  }
+
+  static std::shared_ptr<const Tile> ReadTile(GDALDataset& ds, int tileX, int tileY)
   {
-    srsUniquePtr = std::make_unique<OGRSpatialReference>(ds.GetProjectionRef());
-    srs = srsUniquePtr.get();
+    const std::lock_guard<std::mutex> lock(demMutex);
+
+    auto tile    = std::make_shared<Tile>();
+    tile->x0     = tileX * TileSize;
+    tile->y0     = tileY * TileSize;
+    tile->width  = std::min(TileSize, ds.GetRasterXSize() - tile->x0);
+    int height   = std::min(TileSize, ds.GetRasterYSize() - tile->y0);
+    tile->data.resize(static_cast<std::size_t>(tile->width) * height);
+
+    auto err = ds.GetRasterBand(1)->RasterIO(GF_Read, tile->x0, tile->y0, tile->width, height, tile->data.data(), tile->width, height, GDT_Float64, 0, 0,
+                                             nullptr);
+    tile->valid = !err;
+    if (err)
+      tile->data.clear();
+    return tile;
   }
-#endif
 
-  auto wgs84Srs = OGRSpatialReference::GetWGS84SRS();
+  mutable std::mutex                           m_Mutex;
+  std::unordered_map<Key, Entry, KeyHash>      m_Tiles;
+  LRUListType                                  m_LRU;
+  std::map<GDALDataset*, std::shared_ptr<const DatasetInfo>> m_Infos;
+  std::size_t                                  m_Size;
+  std::size_t                                  m_MaxSize;
+  std::atomic<unsigned long>                   m_Generation;
+};
+
+boost::optional<double> GetDEMValue(double lon, double lat, GDALDataset& ds, TileCache& cache)
+{
+  auto info = cache.GetDatasetInfo(ds);
 
   // Convert input lon lat into the coordinates defined by the dataset if needed.
-  if (srs && !srs->IsSame(wgs84Srs))
+  if (info->srs)
   {
-    auto poCT = std::unique_ptr<OGRCoordinateTransformation>
-                    (OGRCreateCoordinateTransformation(wgs84Srs, srs));
+    // The transformations are built once per thread and dataset. The
+    // dataset info is kept alive so that its address is not reused.
+    using TransformationType = std::pair<std::shared_ptr<const TileCache::DatasetInfo>, std::unique_ptr<OGRCoordinateTransformation>>;
+    thread_local std::map<const TileCache::DatasetInfo*, TransformationType> transformations;
+
+    auto it = transformations.find(info.get());
+    if (it == transformations.end())
+    {
+      if (transformations.size() >= TileCache::NumberOfHints)
+        transformations.clear();
+      auto poCT = std::unique_ptr<OGRCoordinateTransformation>(OGRCreateCoordinateTransformation(OGRSpatialReference::GetWGS84SRS(), info->srs.get()));
+      it        = transformations.emplace(info.get(), TransformationType(info, std::move(poCT))).first;
+    }
+    auto& poCT = it->second.second;
 
     if (poCT && !poCT->Transform( 1, &lon, &lat ) )
     {
@@ -109,14 +395,12 @@ boost::optional<double> GetDEMValue(double lon, double lat, GDALDataset& ds)
     }
   }
 
-  double geoTransform[6];
-  
-  ds.GetGeoTransform(geoTransform);
+  const double* geoTransform = info->geoTransform;
 
   auto x = (lon - geoTransform[0]) / geoTransform[1] - 0.5;
   auto y = (lat - geoTransform[3]) / geoTransform[5] - 0.5;
 
-  if (x < 0 || y < 0 || x > ds.GetRasterXSize() || y > ds.GetRasterYSize())
+  if (x < 0 || y < 0 || x > info->sizeX || y > info->sizeY)
   {
     return boost::none;
   }
@@ -127,28 +411,27 @@ boost::optional<double> GetDEMValue(double lon, double lat, GDALDataset& ds)
   auto deltaX = x - x_int;
   auto deltaY = y - y_int;
 
-  if (x < 0 || y < 0 || x+1 > ds.GetRasterXSize() || y+1 > ds.GetRasterYSize())
+  if (x < 0 || y < 0 || x+1 > info->sizeX || y+1 > info->sizeY)
   {
     return boost::none;
   }
-  
+
   // Bilinear interpolation.
   double elevData[4];
-  
-  auto err = ds.GetRasterBand(1)->RasterIO( GF_Read, x_int, y_int, 2, 2,
-              elevData, 2, 2, GDT_Float64,
-              0, 0, nullptr);
 
-  if (err)
+  for (int i = 0; i < 4; i++)
   {
-    return boost::none;
+    if (!cache.GetPixel(ds, *info, x_int + i % 2, y_int + i / 2, elevData[i]))
+    {
+      return boost::none;
+    }
   }
 
-  // Test for no data. Don't return a value if one pixel 
+  // Test for no data. Don't return a value if one pixel
   // of the interpolation is no data.
   for (int i =0; i<4; i++)
   {
-    if (elevData[i] == ds.GetRasterBand(1)->GetNoDataValue())
+    if (elevData[i] == info->noDataValue)
     {
       return boost::none;
     }
@@ -172,9 +455,10 @@ DEMHandler & DEMHandler::GetInstance()
 
 DEMHandler::DEMHandler() : m_Dataset(nullptr),
                            m_GeoidDS(nullptr),
-                           m_DefaultHeightAboveEllipsoid(0.0)
+                           m_DefaultHeightAboveEllipsoid(0.0),
+                           m_TileCache(std::make_unique<DEMDetails::TileCache>(ConfigurationManager::GetMaxRAMHint() * 1024 * 1024 / 4))
 {
-  GDALAllRegister();
+  // GDAL drivers are registered by GDALDriverManagerWrapper on first use
 };
 
 DEMHandler::~DEMHandler()
@@ -208,11 +492,19 @@ void DEMHandler::OpenDEMFile(const std::string& path)
     CreateShiftedDataset();
   }
 
+  m_TileCache->Clear();
   Notify();
 }
 
 void DEMHandler::OpenDEMDirectory(const std::string& DEMDirectory)
 {
+  // Keep the datasets of a directory already opened, e.g. by a previous
+  // application run in the same process
+  if (std::find(m_DEMDirectories.begin(), m_DEMDirectories.end(), DEMDirectory) != m_DEMDirectories.end())
+  {
+    return;
+  }
+
   // TODO : RemoveOSSIM
   OssimDEMHandler::Instance()->OpenDEMDirectory(DEMDirectory);
 
@@ -257,6 +549,7 @@ void DEMHandler::OpenDEMDirectory(const std::string& DEMDirectory)
   {
     CreateShiftedDataset();
   }
+  m_TileCache->Clear();
   Notify();
 }
 
@@ -265,6 +558,7 @@ bool DEMHandler::OpenGeoidFile(const std::string& geoidFile)
   // TODO : RemoveOSSIM
   OssimDEMHandler::Instance()->OpenGeoidFile(geoidFile);
 
+  GDALDriverManagerWrapper::GetInstance().RegisterDrivers();
 
   int pbError;
   auto ds = GDALOpenVerticalShiftGrid(geoidFile.c_str(), &pbError);
@@ -285,6 +579,7 @@ bool DEMHandler::OpenGeoidFile(const std::string& geoidFile)
     CreateShiftedDataset();
   }
 
+  m_TileCache->Clear();
   Notify();
   return pbError;
 }
@@ -393,7 +688,7 @@ double DEMHandler::GetHeightAboveEllipsoid(double lon, double lat) const
 
   if (m_Dataset)
   {
-    DEMresult = DEMDetails::GetDEMValue(lon, lat, *m_Dataset);
+    DEMresult = DEMDetails::GetDEMValue(lon, lat, *m_Dataset, *m_TileCache);
     if (DEMresult)
     {
       result += *DEMresult;
@@ -403,7 +698,7 @@ double DEMHandler::GetHeightAboveEllipsoid(double lon, double lat) const
 
   if (m_GeoidDS)
   {
-    geoidResult = DEMDetails::GetDEMValue(lon, lat, *m_GeoidDS);
+    geoidResult = DEMDetails::GetDEMValue(lon, lat, *m_GeoidDS, *m_TileCache);
     if (geoidResult)
     {
       result += *geoidResult;
@@ -421,11 +716,19 @@ double DEMHandler::GetHeightAboveEllipsoid(const PointType& geoPoint) const
   return GetHeightAboveEllipsoid(geoPoint[0], geoPoint[1]);
 }
 
+void DEMHandler::GetHeightAboveEllipsoid(const double* lon, const double* lat, double* height, std::size_t n) const
+{
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    height[i] = GetHeightAboveEllipsoid(lon[i], lat[i]);
+  }
+}
+
 double DEMHandler::GetHeightAboveMSL(double lon, double lat) const
 {
   if (m_Dataset)
   { 
-    auto result = DEMDetails::GetDEMValue(lon, lat, *m_Dataset);
+    auto result = DEMDetails::GetDEMValue(lon, lat, *m_Dataset, *m_TileCache);
     
     if (result)
     {
@@ -441,6 +744,21 @@ double DEMHandler::GetHeightAboveMSL(const PointType& geoPoint) const
   return GetHeightAboveMSL(geoPoint[0], geoPoint[1]);
 }
 
+void DEMHandler::GetHeightAboveMSL(const double* lon, const double* lat, double* height, std::size_t n) const
+{
+  if (!m_Dataset)
+  {
+    std::fill(height, height + n, 0.);
+    return;
+  }
+
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    auto result = DEMDetails::GetDEMValue(lon[i], lat[i], *m_Dataset, *m_TileCache);
+    height[i]   = result ? *result : 0.;
+  }
+}
+
 unsigned int DEMHandler::GetDEMCount() const
 {
   return m_DatasetList.size();
@@ -448,6 +766,8 @@ unsigned int DEMHandler::GetDEMCount() const
 
 bool DEMHandler::IsValidDEMDirectory(const std::string& DEMDirectory) const
 {
+  GDALDriverManagerWrapper::GetInstance().RegisterDrivers();
+
   for (const auto & filename : DEMDetails::GetFilesInDirectory(DEMDirectory))
   {
     // test if a driver can identify this dataset
@@ -490,6 +810,7 @@ void DEMHandler::ClearDEMs()
 
   // This will call GDALClose on all datasets
   m_DatasetList.clear();
+  m_TileCache->Clear();
   Notify();
 }
 
@@ -501,6 +822,16 @@ void DEMHandler::SetDefaultHeightAboveEllipsoid(double height)
   Notify();
 }
 
+void DEMHandler::SetTileCacheSize(std::size_t size)
+{
+  m_TileCache->SetMaxSize(size);
+}
+
+std::size_t DEMHandler::GetTileCacheSize() const
+{
+  return m_TileCache->GetMaxSize();
+}
+
 double DEMHandler::GetDefaultHeightAboveEllipsoid() const
 {
   return m_DefaultHeightAboveEllipsoid;
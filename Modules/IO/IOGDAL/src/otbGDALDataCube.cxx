@@ -0,0 +1,488 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGDALDataCube.h"
+#include "otbGDALDriverManagerWrapper.h"
+
+#include "itkMacro.h"
+
+#include "gdal.h"
+#include "gdal_priv.h"
+#include "cpl_string.h"
+#include "ogr_spatialref.h"
+
+#include <algorithm>
+#include <future>
+#include <sstream>
+
+namespace otb
+{
+
+#if GDAL_VERSION_NUM >= 3010000
+
+struct GDALDataCube::Handle
+{
+  // Declared first, so that the dataset is closed after its array
+  GDALDatasetUniquePtr         Dataset;
+  std::shared_ptr<GDALGroup>   Group;
+  std::shared_ptr<GDALMDArray> Array;
+};
+
+namespace
+{
+// Start, count and buffer stride of each dimension of the array for a
+// region read into, or written from, a pixel interleaved buffer
+void ComputeAccess(std::size_t nbDims, unsigned int nbTimes, unsigned int nbBands, int x, int y, int sizeX, int sizeY, std::vector<GUInt64>& start,
+                   std::vector<size_t>& count, std::vector<GPtrDiff_t>& stride)
+{
+  const GPtrDiff_t nbComponents = nbTimes * nbBands;
+
+  start.assign(nbDims, 0);
+  count.assign(nbDims, 0);
+  stride.assign(nbDims, 0);
+
+  start[nbDims - 1]  = x;
+  count[nbDims - 1]  = sizeX;
+  stride[nbDims - 1] = nbComponents;
+  start[nbDims - 2]  = y;
+  count[nbDims - 2]  = sizeY;
+  stride[nbDims - 2] = nbComponents * sizeX;
+  if (nbDims >= 3)
+  {
+    count[0]  = nbTimes;
+    stride[0] = nbBands;
+  }
+  if (nbDims == 4)
+  {
+    count[1]  = nbBands;
+    stride[1] = 1;
+  }
+}
+} // namespace
+
+GDALDataCube::GDALDataCube(const std::string& fileName, const std::string& arrayName)
+  : m_FileName(fileName),
+    m_ArrayName(arrayName),
+    m_Width(0),
+    m_Height(0),
+    m_NumberOfTimes(1),
+    m_NumberOfBands(1),
+    m_ChunkWidth(0),
+    m_ChunkHeight(0),
+    m_DataType(GDT_Unknown)
+{
+  // Make sure that the drivers are registered
+  GDALDriverManagerWrapper::GetInstance();
+
+  m_Handle    = OpenHandle();
+  m_ArrayName = m_Handle->Array->GetName();
+
+  const auto& dims = m_Handle->Array->GetDimensions();
+  const auto  n    = dims.size();
+  if (n < 2 || n > 4)
+  {
+    itkGenericExceptionMacro(<< "Array " << m_ArrayName << " of " << fileName << " has " << n
+                             << " dimensions, expected (time, band, y, x), (time, y, x) or (y, x)");
+  }
+  m_Width  = dims[n - 1]->GetSize();
+  m_Height = dims[n - 2]->GetSize();
+  if (n >= 3)
+  {
+    m_NumberOfTimes = dims[0]->GetSize();
+  }
+  if (n == 4)
+  {
+    m_NumberOfBands = dims[1]->GetSize();
+  }
+
+  const std::vector<GUInt64> blockSize = m_Handle->Array->GetBlockSize();
+  m_ChunkWidth                         = blockSize[n - 1] != 0 ? blockSize[n - 1] : m_Width;
+  m_ChunkHeight                        = blockSize[n - 2] != 0 ? blockSize[n - 2] : m_Height;
+
+  const GDALExtendedDataType& dataType = m_Handle->Array->GetDataType();
+  if (dataType.GetClass() != GEDTC_NUMERIC)
+  {
+    itkGenericExceptionMacro(<< "Array " << m_ArrayName << " of " << fileName << " does not hold numeric values");
+  }
+  m_DataType = dataType.GetNumericDataType();
+}
+
+GDALDataCube::GDALDataCube(const std::string& fileName, const std::string& driverName, const std::string& arrayName, unsigned int width,
+                           unsigned int height, unsigned int numberOfTimes, unsigned int numberOfBands, int dataType, unsigned int chunkWidth,
+                           unsigned int chunkHeight, const std::vector<std::string>& creationOptions)
+  : m_FileName(fileName),
+    m_ArrayName(arrayName),
+    m_Width(width),
+    m_Height(height),
+    m_NumberOfTimes(numberOfTimes),
+    m_NumberOfBands(numberOfBands),
+    m_ChunkWidth(std::min(chunkWidth, width)),
+    m_ChunkHeight(std::min(chunkHeight, height)),
+    m_DataType(dataType)
+{
+  GDALDriver* driver = GDALDriverManagerWrapper::GetInstance().GetDriverByName(driverName);
+  if (driver == nullptr)
+  {
+    itkGenericExceptionMacro(<< "GDAL driver " << driverName << " not available");
+  }
+
+  std::unique_ptr<Handle> handle(new Handle);
+  handle->Dataset.reset(driver->CreateMultiDimensional(fileName.c_str(), nullptr, nullptr));
+  if (!handle->Dataset)
+  {
+    itkGenericExceptionMacro(<< "Unable to create " << fileName << " with the multidimensional API of the " << driverName
+                             << " driver: " << CPLGetLastErrorMsg());
+  }
+  handle->Group = handle->Dataset->GetRootGroup();
+
+  std::vector<std::shared_ptr<GDALDimension>> dims;
+  std::ostringstream                           blockSize;
+  dims.push_back(handle->Group->CreateDimension("time", GDAL_DIM_TYPE_TEMPORAL, "", numberOfTimes));
+  blockSize << "BLOCKSIZE=1,";
+  if (numberOfBands > 1)
+  {
+    dims.push_back(handle->Group->CreateDimension("band", "", "", numberOfBands));
+    blockSize << "1,";
+  }
+  dims.push_back(handle->Group->CreateDimension("y", GDAL_DIM_TYPE_HORIZONTAL_Y, "NORTH", height));
+  dims.push_back(handle->Group->CreateDimension("x", GDAL_DIM_TYPE_HORIZONTAL_X, "EAST", width));
+  blockSize << m_ChunkHeight << "," << m_ChunkWidth;
+
+  CPLStringList options;
+  bool          hasBlockSize = false;
+  for (const auto& option : creationOptions)
+  {
+    hasBlockSize = hasBlockSize || STARTS_WITH_CI(option.c_str(), "BLOCKSIZE=");
+    options.AddString(option.c_str());
+  }
+  if (!hasBlockSize)
+  {
+    options.AddString(blockSize.str().c_str());
+  }
+
+  handle->Array = handle->Group->CreateMDArray(arrayName, dims, GDALExtendedDataType::Create(static_cast<GDALDataType>(dataType)), options.List());
+  if (!handle->Array)
+  {
+    itkGenericExceptionMacro(<< "Unable to create array " << arrayName << " in " << fileName << ": " << CPLGetLastErrorMsg());
+  }
+
+  // The chunk size may be adjusted by the driver
+  const std::vector<GUInt64> actualBlockSize = handle->Array->GetBlockSize();
+  if (actualBlockSize.size() == dims.size() && actualBlockSize.back() != 0)
+  {
+    m_ChunkWidth  = actualBlockSize[dims.size() - 1];
+    m_ChunkHeight = actualBlockSize[dims.size() - 2];
+  }
+
+  m_Handle = std::move(handle);
+}
+
+GDALDataCube::~GDALDataCube()
+{
+}
+
+std::unique_ptr<GDALDataCube::Handle> GDALDataCube::OpenHandle() const
+{
+  std::unique_ptr<Handle> handle(new Handle);
+  handle->Dataset.reset(GDALDataset::Open(m_FileName.c_str(), GDAL_OF_MULTIDIM_RASTER | GDAL_OF_READONLY));
+  if (!handle->Dataset)
+  {
+    itkGenericExceptionMacro(<< "Unable to open " << m_FileName << " as a multidimensional dataset: " << CPLGetLastErrorMsg());
+  }
+  handle->Group = handle->Dataset->GetRootGroup();
+  if (!handle->Group)
+  {
+    itkGenericExceptionMacro(<< m_FileName << " has no root group");
+  }
+
+  if (m_ArrayName.empty())
+  {
+    // Take the first array that is not a coordinate variable
+    for (const auto& name : handle->Group->GetMDArrayNames())
+    {
+      auto array = handle->Group->OpenMDArray(name);
+      if (array && array->GetDimensionCount() >= 2)
+      {
+        handle->Array = array;
+        break;
+      }
+    }
+  }
+  else
+  {
+    handle->Array = handle->Group->OpenMDArray(m_ArrayName);
+  }
+
+  if (!handle->Array)
+  {
+    itkGenericExceptionMacro(<< "No array " << m_ArrayName << " found in " << m_FileName);
+  }
+  return handle;
+}
+
+std::unique_ptr<GDALDataCube::Handle> GDALDataCube::AcquireHandle() const
+{
+  {
+    std::lock_guard<std::mutex> lock(m_HandlePoolMutex);
+    if (!m_HandlePool.empty())
+    {
+      std::unique_ptr<Handle> handle = std::move(m_HandlePool.back());
+      m_HandlePool.pop_back();
+      return handle;
+    }
+  }
+  return OpenHandle();
+}
+
+void GDALDataCube::ReleaseHandle(std::unique_ptr<Handle> handle) const
+{
+  std::lock_guard<std::mutex> lock(m_HandlePoolMutex);
+  m_HandlePool.push_back(std::move(handle));
+}
+
+bool GDALDataCube::GetGeoTransform(double origin[2], double spacing[2]) const
+{
+  const auto& dims = m_Handle->Array->GetDimensions();
+  for (unsigned int axis = 0; axis < 2; ++axis)
+  {
+    auto coordinates = dims[dims.size() - 1 - axis]->GetIndexingVariable();
+    if (!coordinates || coordinates->GetDimensionCount() != 1 || !coordinates->IsRegularlySpaced(origin[axis], spacing[axis]))
+    {
+      return false;
+    }
+  }
+  return true;
+}
+
+void GDALDataCube::SetGeoTransform(const double origin[2], const double spacing[2])
+{
+  if (!m_Handle->Group)
+  {
+    itkGenericExceptionMacro(<< "The geotransform of " << m_FileName << " can only be set on creation");
+  }
+  const auto& dims = m_Handle->Array->GetDimensions();
+  for (unsigned int axis = 0; axis < 2; ++axis)
+  {
+    const auto& dim         = dims[dims.size() - 1 - axis];
+    auto        coordinates = m_Handle->Group->CreateMDArray(dim->GetName(), {dim}, GDALExtendedDataType::Create(GDT_Float64));
+    if (!coordinates)
+    {
+      itkGenericExceptionMacro(<< "Unable to create the coordinates of dimension " << dim->GetName() << " in " << m_FileName << ": " << CPLGetLastErrorMsg());
+    }
+
+    std::vector<double> values(dim->GetSize());
+    for (std::size_t i = 0; i < values.size(); ++i)
+    {
+      values[i] = origin[axis] + i * spacing[axis];
+    }
+    const GUInt64 start = 0;
+    const size_t  count = values.size();
+    if (!coordinates->Write(&start, &count, nullptr, nullptr, GDALExtendedDataType::Create(GDT_Float64), values.data()) ||
+        !dim->SetIndexingVariable(coordinates))
+    {
+      itkGenericExceptionMacro(<< "Unable to write the coordinates of dimension " << dim->GetName() << " in " << m_FileName << ": " << CPLGetLastErrorMsg());
+    }
+  }
+}
+
+std::string GDALDataCube::GetProjectionRef() const
+{
+  std::string                          projection;
+  std::shared_ptr<OGRSpatialReference> srs = m_Handle->Array->GetSpatialRef();
+  if (srs)
+  {
+    char* wkt = nullptr;
+    if (srs->exportToWkt(&wkt) == OGRERR_NONE && wkt != nullptr)
+    {
+      projection = wkt;
+    }
+    CPLFree(wkt);
+  }
+  return projection;
+}
+
+void GDALDataCube::SetProjectionRef(const std::string& wkt)
+{
+  if (wkt.empty())
+  {
+    return;
+  }
+  OGRSpatialReference srs;
+  if (srs.importFromWkt(wkt.c_str()) != OGRERR_NONE)
+  {
+    itkGenericExceptionMacro(<< "Invalid projection for " << m_FileName << ": " << wkt);
+  }
+  // First SRS axis along the x dimension, the second along the y one
+  const int nbDims = static_cast<int>(m_Handle->Array->GetDimensionCount());
+  srs.SetDataAxisToSRSAxisMapping({nbDims, nbDims - 1});
+  if (!m_Handle->Array->SetSpatialRef(&srs))
+  {
+    itkGenericExceptionMacro(<< "Unable to set the projection of " << m_FileName << ": " << CPLGetLastErrorMsg());
+  }
+}
+
+bool GDALDataCube::GetNoDataValue(double& value) const
+{
+  bool hasNoData = false;
+  value          = m_Handle->Array->GetNoDataValueAsDouble(&hasNoData);
+  return hasNoData;
+}
+
+void GDALDataCube::SetNoDataValue(double value)
+{
+  if (!m_Handle->Array->SetNoDataValue(value))
+  {
+    itkGenericExceptionMacro(<< "Unable to set the no-data value of " << m_FileName << ": " << CPLGetLastErrorMsg());
+  }
+}
+
+void GDALDataCube::Read(void* buffer, int dataType, int x, int y, int sizeX, int sizeY, unsigned int numberOfThreads) const
+{
+  const GDALDataType         type      = static_cast<GDALDataType>(dataType);
+  const GDALExtendedDataType bufferType = GDALExtendedDataType::Create(type);
+  const std::size_t          lineSize  = static_cast<std::size_t>(GDALGetDataTypeSizeBytes(type)) * GetNumberOfComponents() * sizeX;
+  const std::size_t          nbDims    = m_Handle->Array->GetDimensionCount();
+
+  // Read the rows [y0, y1) of the region
+  auto readRows = [&](const Handle& handle, int y0, int y1) {
+    std::vector<GUInt64>    start;
+    std::vector<size_t>     count;
+    std::vector<GPtrDiff_t> stride;
+    ComputeAccess(nbDims, m_NumberOfTimes, m_NumberOfBands, x, y0, sizeX, y1 - y0, start, count, stride);
+    if (!handle.Array->Read(start.data(), count.data(), nullptr, stride.data(), bufferType, static_cast<char*>(buffer) + (y0 - y) * lineSize))
+    {
+      itkGenericExceptionMacro(<< "Unable to read region [" << x << ", " << y0 << ", " << sizeX << ", " << y1 - y0 << "] of " << m_FileName << ": "
+                               << CPLGetLastErrorMsg());
+    }
+  };
+
+  // Split the region on the chunk rows, each task reading a strip of
+  // whole chunk rows through its own handle
+  std::vector<int> rows(1, y);
+  for (int row = (y / m_ChunkHeight + 1) * m_ChunkHeight; row < y + sizeY; row += m_ChunkHeight)
+  {
+    rows.push_back(row);
+  }
+  rows.push_back(y + sizeY);
+
+  const unsigned int nbChunkRows = rows.size() - 1;
+  const unsigned int nbTasks     = std::max(1u, std::min(numberOfThreads, nbChunkRows));
+  if (nbTasks == 1)
+  {
+    readRows(*m_Handle, y, y + sizeY);
+    return;
+  }
+
+  std::vector<std::future<void>> tasks;
+  for (unsigned int task = 0; task < nbTasks; ++task)
+  {
+    const int y0 = rows[task * nbChunkRows / nbTasks];
+    const int y1 = rows[(task + 1) * nbChunkRows / nbTasks];
+    tasks.push_back(std::async(std::launch::async, [&, y0, y1]() {
+      std::unique_ptr<Handle> handle = AcquireHandle();
+      readRows(*handle, y0, y1);
+      ReleaseHandle(std::move(handle));
+    }));
+  }
+  // Wait for all the tasks before reporting the first error
+  for (auto& task : tasks)
+  {
+    task.wait();
+  }
+  for (auto& task : tasks)
+  {
+    task.get();
+  }
+}
+
+void GDALDataCube::Write(const void* buffer, int dataType, int x, int y, int sizeX, int sizeY)
+{
+  std::vector<GUInt64>    start;
+  std::vector<size_t>     count;
+  std::vector<GPtrDiff_t> stride;
+  ComputeAccess(m_Handle->Array->GetDimensionCount(), m_NumberOfTimes, m_NumberOfBands, x, y, sizeX, sizeY, start, count, stride);
+  if (!m_Handle->Array->Write(start.data(), count.data(), nullptr, stride.data(), GDALExtendedDataType::Create(static_cast<GDALDataType>(dataType)), buffer))
+  {
+    itkGenericExceptionMacro(<< "Unable to write region [" << x << ", " << y << ", " << sizeX << ", " << sizeY << "] of " << m_FileName << ": "
+                             << CPLGetLastErrorMsg());
+  }
+}
+
+#else // GDAL_VERSION_NUM >= 3010000
+
+struct GDALDataCube::Handle
+{
+};
+
+GDALDataCube::GDALDataCube(const std::string& fileName, const std::string&)
+{
+  itkGenericExceptionMacro(<< "Reading the data cube " << fileName << " requires GDAL 3.1 or later");
+}
+
+GDALDataCube::GDALDataCube(const std::string& fileName, const std::string&, const std::string&, unsigned int, unsigned int, unsigned int,
+                           unsigned int, int, unsigned int, unsigned int, const std::vector<std::string>&)
+{
+  itkGenericExceptionMacro(<< "Writing the data cube " << fileName << " requires GDAL 3.1 or later");
+}
+
+GDALDataCube::~GDALDataCube()
+{
+}
+
+// The cube cannot be constructed, the methods below are never called
+
+bool GDALDataCube::GetGeoTransform(double[2], double[2]) const
+{
+  return false;
+}
+
+void GDALDataCube::SetGeoTransform(const double[2], const double[2])
+{
+}
+
+std::string GDALDataCube::GetProjectionRef() const
+{
+  return std::string();
+}
+
+void GDALDataCube::SetProjectionRef(const std::string&)
+{
+}
+
+bool GDALDataCube::GetNoDataValue(double&) const
+{
+  return false;
+}
+
+void GDALDataCube::SetNoDataValue(double)
+{
+}
+
+void GDALDataCube::Read(void*, int, int, int, int, int, unsigned int) const
+{
+}
+
+void GDALDataCube::Write(const void*, int, int, int, int, int)
+{
+}
+
+#endif // GDAL_VERSION_NUM >= 3010000
+
+} // namespace otb
@@ -20,6 +20,7 @@
 
 #include "otbGDALDriverManagerWrapper.h"
 #include <vector>
+#include <mutex>
 #include "otb_boost_string_header.h"
 #include "otbSystem.h"
 
@@ -30,21 +31,33 @@ namespace otb
 
 GDALDriverManagerWrapper::GDALDriverManagerWrapper()
 {
-  GDALAllRegister();
+  // Drivers are registered on first use, see RegisterDrivers()
+}
+
+void GDALDriverManagerWrapper::RegisterDrivers() const
+{
+  std::call_once(m_RegisterFlag, []() {
+    // Registering all drivers scans the plugin directories, skip it when
+    // it has already been done elsewhere in the process
+    if (GetGDALDriverManager()->GetDriverCount() == 0)
+    {
+      GDALAllRegister();
+    }
 
-  GDALDriver* driver = nullptr;
+    GDALDriver* driver = nullptr;
 
-  // Ignore incompatible Jpeg2000 drivers (Jasper)
-  driver = GetGDALDriverManager()->GetDriverByName("JPEG2000");
-  if (driver)
-    GetGDALDriverManager()->DeregisterDriver(driver);
+    // Ignore incompatible Jpeg2000 drivers (Jasper)
+    driver = GetGDALDriverManager()->GetDriverByName("JPEG2000");
+    if (driver)
+      GetGDALDriverManager()->DeregisterDriver(driver);
 
-  // #ifndef CHECK_HDF4OPEN_SYMBOL
-  //     // Get rid of the HDF4 driver when it is buggy
-  //     driver = GetGDALDriverManager()->GetDriverByName( "hdf4" );
-  //     if (driver)
-  //       GetGDALDriverManager()->DeregisterDriver( driver );
-  // #endif
+    // #ifndef CHECK_HDF4OPEN_SYMBOL
+    //     // Get rid of the HDF4 driver when it is buggy
+    //     driver = GetGDALDriverManager()->GetDriverByName( "hdf4" );
+    //     if (driver)
+    //       GetGDALDriverManager()->DeregisterDriver( driver );
+    // #endif
+  });
 }
 
 GDALDriverManagerWrapper::~GDALDriverManagerWrapper()
@@ -59,6 +72,8 @@ GDALDatasetWrapper::Pointer GDALDriverManagerWrapper::Open(std::string filename)
 {
   GDALDatasetWrapper::Pointer datasetWrapper;
 
+  RegisterDrivers();
+
   // test if a driver can identify the dataset
   GDALDriverH identifyDriverH = GDALIdentifyDriver(filename.c_str(), nullptr);
   if (identifyDriverH == nullptr)
@@ -87,6 +102,28 @@ GDALDatasetWrapper::Pointer GDALDriverManagerWrapper::Open(std::string filename)
   return datasetWrapper;
 }
 
+// Open an existing file for update and returns a smart dataset pointer
+GDALDatasetWrapper::Pointer GDALDriverManagerWrapper::OpenForUpdate(std::string filename) const
+{
+  GDALDatasetWrapper::Pointer datasetWrapper;
+
+  RegisterDrivers();
+
+  if (GDALIdentifyDriver(filename.c_str(), nullptr) == nullptr)
+  {
+    return datasetWrapper;
+  }
+
+  GDALDatasetH dataset = GDALOpen(filename.c_str(), GA_Update);
+
+  if (dataset != nullptr)
+  {
+    datasetWrapper            = GDALDatasetWrapper::New();
+    datasetWrapper->m_Dataset = static_cast<GDALDataset*>(dataset);
+  }
+  return datasetWrapper;
+}
+
 // Open the new  file for writing and returns a smart dataset pointer
 GDALDatasetWrapper::Pointer GDALDriverManagerWrapper::Create(std::string& driverShortName, std::string filename, int nXSize, int nYSize, int nBands,
                                                              GDALDataType eType, char** papszOptions) const
@@ -109,6 +146,7 @@ GDALDatasetWrapper::Pointer GDALDriverManagerWrapper::Create(std::string& driver
 
 GDALDriver* GDALDriverManagerWrapper::GetDriverByName(std::string driverShortName) const
 {
+  RegisterDrivers();
   return GetGDALDriverManager()->GetDriverByName(driverShortName.c_str());
 }
 
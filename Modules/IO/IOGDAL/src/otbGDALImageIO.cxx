@@ -22,11 +22,16 @@
 #include <iostream>
 #include <fstream>
 #include <vector>
+#include <algorithm>
+#include <list>
+#include <mutex>
+#include <unordered_map>
 
 #include "otbGDALImageIO.h"
 #include "otbMacro.h"
 #include "otbSystem.h"
 #include "otbStopwatch.h"
+#include "otbPipelineTracer.h"
 #include "itksys/SystemTools.hxx"
 #include "otbImage.h"
 #include "otb_tinyxml.h"
@@ -52,6 +57,8 @@
 #include "otbOGRHelpers.h"
 #include "otbGeometryMetadata.h"
 #include "otbConfigure.h"
+#include "otbConfigurationManager.h"
+#include "itkMultiThreader.h"
 
 #include "stdint.h" //needed for uintptr_t
 
@@ -60,6 +67,23 @@ inline unsigned int uint_ceildivpow2(unsigned int a, unsigned int b)
   return (a + (1 << b) - 1) >> b;
 }
 
+// Map a resampling method name to the GDAL algorithm used by decimated reads
+inline bool ResamplingAlgorithmFromName(const std::string& name, GDALRIOResampleAlg& alg)
+{
+  static const std::pair<const char*, GDALRIOResampleAlg> algorithms[] = {
+      {"nearest", GRIORA_NearestNeighbour}, {"bilinear", GRIORA_Bilinear}, {"cubic", GRIORA_Cubic}, {"cubicspline", GRIORA_CubicSpline},
+      {"lanczos", GRIORA_Lanczos},          {"average", GRIORA_Average},   {"mode", GRIORA_Mode},   {"gauss", GRIORA_Gauss}};
+  for (const auto& algorithm : algorithms)
+  {
+    if (name == algorithm.first)
+    {
+      alg = algorithm.second;
+      return true;
+    }
+  }
+  return false;
+}
+
 namespace otb
 {
 
@@ -84,6 +108,160 @@ public:
   GDALDataType pixType;
 }; // end of GDALDataTypeWrapper
 
+/**
+ * Bounded set of the datasets opened for reading. When there are more
+ * than GetMaxOpenDatasets() of them, the least recently accessed ones are
+ * closed. Each access to a dataset is enclosed in a ScopedAccess, which
+ * opens the dataset again if needed, and keeps it open until the end of
+ * the access.
+ */
+class GDALDatasetPool
+{
+public:
+  static GDALDatasetPool& GetInstance()
+  {
+    static GDALDatasetPool pool;
+    return pool;
+  }
+
+  class ScopedAccess
+  {
+  public:
+    explicit ScopedAccess(const GDALImageIO* io) : m_IO(const_cast<GDALImageIO*>(io))
+    {
+      GDALDatasetPool::GetInstance().Acquire(m_IO);
+    }
+    ~ScopedAccess()
+    {
+      GDALDatasetPool::GetInstance().Release(m_IO);
+    }
+
+  private:
+    GDALImageIO* m_IO;
+  };
+
+  /** Track the dataset just opened for reading by io (m_DatasetName) */
+  void Register(GDALImageIO* io)
+  {
+    if (m_MaxOpenDatasets == 0)
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto                        it = m_Entries.find(io);
+    if (it == m_Entries.end())
+    {
+      m_Open.push_front(io);
+      m_Entries[io] = Entry{0, m_Open.begin()};
+    }
+    else
+    {
+      m_Open.splice(m_Open.begin(), m_Open, it->second.position);
+    }
+    CloseUnused();
+  }
+
+  /** Stop tracking io, its dataset is left as is */
+  void Unregister(GDALImageIO* io)
+  {
+    if (m_MaxOpenDatasets == 0)
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto                        it = m_Entries.find(io);
+    if (it != m_Entries.end())
+    {
+      if (it->second.position != m_Open.end())
+      {
+        m_Open.erase(it->second.position);
+      }
+      m_Entries.erase(it);
+    }
+  }
+
+private:
+  struct Entry
+  {
+    unsigned int                      users;
+    std::list<GDALImageIO*>::iterator position; // m_Open.end() when closed
+  };
+
+  GDALDatasetPool() : m_MaxOpenDatasets(ConfigurationManager::GetMaxOpenDatasets())
+  {
+  }
+
+  void Acquire(GDALImageIO* io)
+  {
+    if (m_MaxOpenDatasets == 0)
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto                        it = m_Entries.find(io);
+    if (it == m_Entries.end())
+    {
+      return;
+    }
+    Entry& entry = it->second;
+    if (entry.position == m_Open.end())
+    {
+      otbLogMacro(Debug, << "Opening again " << io->m_DatasetName);
+      io->m_Dataset = GDALDriverManagerWrapper::GetInstance().Open(io->m_DatasetName);
+      if (io->m_Dataset.IsNull())
+      {
+        m_Entries.erase(it);
+        throw itk::ExceptionObject(__FILE__, __LINE__, "Unable to open again " + io->m_DatasetName, ITK_LOCATION);
+      }
+      m_Open.push_front(io);
+      entry.position = m_Open.begin();
+    }
+    else
+    {
+      m_Open.splice(m_Open.begin(), m_Open, entry.position);
+    }
+    ++entry.users;
+    CloseUnused();
+  }
+
+  void Release(GDALImageIO* io)
+  {
+    if (m_MaxOpenDatasets == 0)
+    {
+      return;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto                        it = m_Entries.find(io);
+    if (it != m_Entries.end() && it->second.users > 0)
+    {
+      --it->second.users;
+      CloseUnused();
+    }
+  }
+
+  /** Close the least recently used datasets beyond the limit, except the ones being accessed */
+  void CloseUnused()
+  {
+    auto candidate = m_Open.end();
+    while (m_Open.size() > m_MaxOpenDatasets && candidate != m_Open.begin())
+    {
+      --candidate;
+      Entry& entry = m_Entries[*candidate];
+      if (entry.users == 0)
+      {
+        (*candidate)->m_Dataset = GDALImageIO::GDALDatasetWrapperPointer();
+        entry.position          = m_Open.end();
+        candidate               = m_Open.erase(candidate);
+      }
+    }
+  }
+
+  const std::size_t                     m_MaxOpenDatasets;
+  std::mutex                            m_Mutex;
+  std::list<GDALImageIO*>               m_Open; // most recently accessed first
+  std::unordered_map<GDALImageIO*, Entry> m_Entries;
+};
+
 
 GDALImageIO::GDALImageIO()
 {
@@ -123,10 +301,29 @@ GDALImageIO::GDALImageIO()
   m_WriteRPCTags      = true;
 
   m_epsgCode          = 0;
+
+  m_Prefetch           = false;
+  m_PrefetchColumnStep = 0;
+  m_PrefetchLineStep   = 0;
+
+  m_NumberOfReadAheadRegions = 0;
+
+  m_CloudOptimized     = false;
+  m_UpdateExistingFile = false;
+
+  m_NumberOfCompressionThreads = 0;
+
+  m_NumberOfReadThreads = 1;
+  m_IORegionIsEmpty     = false;
+  m_IORegionIsNoData    = false;
+
+  m_ResamplingMethod = "nearest";
 }
 
 GDALImageIO::~GDALImageIO()
 {
+  CancelPrefetch();
+  GDALDatasetPool::GetInstance().Unregister(this);
   delete m_PxType;
 }
 
@@ -138,8 +335,17 @@ bool GDALImageIO::CanReadFile(const char* file)
   {
     return false;
   }
+  CancelPrefetch();
+  GDALDatasetPool::GetInstance().Unregister(this);
+  m_ReadDatasets.clear();
   m_Dataset = GDALDriverManagerWrapper::GetInstance().Open(file);
-  return m_Dataset.IsNotNull();
+  if (m_Dataset.IsNull())
+  {
+    return false;
+  }
+  m_DatasetName = file;
+  GDALDatasetPool::GetInstance().Register(this);
+  return true;
 }
 
 // Used to print information about this object
@@ -149,6 +355,13 @@ void GDALImageIO::PrintSelf(std::ostream& os, itk::Indent indent) const
   os << indent << "Compression Level : " << m_CompressionLevel << "\n";
   os << indent << "IsComplex (otb side) : " << m_IsComplex << "\n";
   os << indent << "Byte per pixel : " << m_BytePerPixel << "\n";
+  os << indent << "Prefetch : " << m_Prefetch << "\n";
+  os << indent << "Number of read-ahead regions : " << m_NumberOfReadAheadRegions << "\n";
+  os << indent << "Number of read threads : " << m_NumberOfReadThreads << "\n";
+  os << indent << "Resampling method : " << m_ResamplingMethod << "\n";
+  os << indent << "Update existing file : " << m_UpdateExistingFile << "\n";
+  os << indent << "Compression preset : " << m_CompressionPreset << "\n";
+  os << indent << "Number of compression threads : " << m_NumberOfCompressionThreads << "\n";
 }
 
 // Read a 3D image (or event more bands)... not implemented yet
@@ -169,13 +382,238 @@ void GDALImageIO::Read(void* buffer)
     return;
   }
 
+  const itk::ImageIORegion& region = this->GetIORegion();
+
+  if (!m_Prefetch)
+  {
+    // The scan order is also needed to announce the next reads
+    itk::ImageIORegion next;
+    if (m_NumberOfReadAheadRegions > 0)
+    {
+      this->PredictNextRegion(region, next);
+    }
+    this->InternalRead(region, p);
+    m_IORegionIsEmpty = this->IsRegionEmpty(region);
+    return;
+  }
+
+  if (this->WaitForPrefetch(region))
+  {
+    otbLogMacro(Debug, << "GDAL read of region " << region.GetIndex()[0] << "," << region.GetIndex()[1] << " served by read-ahead");
+    std::copy(m_PrefetchBuffer.begin(), m_PrefetchBuffer.end(), p);
+  }
+  else
+  {
+    this->InternalRead(region, p);
+  }
+  // Before the next read-ahead starts using the dataset
+  m_IORegionIsEmpty = this->IsRegionEmpty(region);
+
+  itk::ImageIORegion next;
+  if (this->PredictNextRegion(region, next))
+  {
+    this->StartPrefetch(next);
+  }
+}
+
+bool GDALImageIO::IsRegionEmpty(const itk::ImageIORegion& region)
+{
+#if GDAL_VERSION_NUM >= 2020000
+  if (m_IsIndexed || region.GetImageDimension() != 2 || region.GetNumberOfPixels() == 0)
+  {
+    return false;
+  }
+  GDALDatasetPool::ScopedAccess access(this);
+  GDALDataset*                  dataset = m_Dataset->GetDataSet();
+
+  // Same extent as InternalRead(), at the initial resolution
+  const int factor      = 1 << m_ResolutionFactor;
+  const int firstColumn = region.GetIndex()[0] * factor;
+  const int firstLine   = region.GetIndex()[1] * factor;
+  const int nbColumns   = std::min(static_cast<int>(region.GetSize()[0]) * factor, static_cast<int>(m_OriginalDimensions[0]) - firstColumn);
+  const int nbLines     = std::min(static_cast<int>(region.GetSize()[1]) * factor, static_cast<int>(m_OriginalDimensions[1]) - firstLine);
+
+  // Drivers which do not know the coverage report it as data
+  for (int band = 1; band <= dataset->GetRasterCount(); ++band)
+  {
+    if (dataset->GetRasterBand(band)->GetDataCoverageStatus(firstColumn, firstLine, nbColumns, nbLines, GDAL_DATA_COVERAGE_STATUS_DATA, nullptr) !=
+        GDAL_DATA_COVERAGE_STATUS_EMPTY)
+    {
+      return false;
+    }
+  }
+  return true;
+#else
+  (void)region;
+  return false;
+#endif
+}
+
+bool GDALImageIO::PredictNextRegion(const itk::ImageIORegion& current, itk::ImageIORegion& next)
+{
+  if (current.GetImageDimension() != 2 || current.GetNumberOfPixels() == 0)
+  {
+    return false;
+  }
+
+  const long x = current.GetIndex()[0];
+  const long y = current.GetIndex()[1];
+
+  // Update the observed scan order
+  if (m_LastReadRegion.GetNumberOfPixels() > 0 && y == m_LastReadRegion.GetIndex()[1] && x > m_LastReadRegion.GetIndex()[0])
+  {
+    // Next tile on the same line of tiles
+    m_PrefetchColumnStep = x - m_LastReadRegion.GetIndex()[0];
+  }
+  else
+  {
+    // New line of tiles (or first request)
+    if (m_LineStartRegion.GetNumberOfPixels() > 0 && y > m_LineStartRegion.GetIndex()[1])
+    {
+      m_PrefetchLineStep = y - m_LineStartRegion.GetIndex()[1];
+    }
+    m_LineStartRegion = current;
+  }
+  m_LastReadRegion = current;
+
+  return this->NextRegionInScanOrder(current, next);
+}
+
+bool GDALImageIO::NextRegionInScanOrder(const itk::ImageIORegion& current, itk::ImageIORegion& next) const
+{
+  const long x      = current.GetIndex()[0];
+  const long y      = current.GetIndex()[1];
+  const long width  = static_cast<long>(m_Dimensions[0]);
+  const long height = static_cast<long>(m_Dimensions[1]);
+
+  next = current;
+  if (m_PrefetchColumnStep > 0 && x + m_PrefetchColumnStep < width)
+  {
+    next.SetIndex(0, x + m_PrefetchColumnStep);
+  }
+  else
+  {
+    // Go to the first tile of the next line of tiles
+    const long lineStep = m_PrefetchLineStep > 0 ? m_PrefetchLineStep : static_cast<long>(current.GetSize()[1]);
+    if (y + lineStep >= height)
+    {
+      return false;
+    }
+    next = m_LineStartRegion;
+    next.SetIndex(1, y + lineStep);
+  }
+
+  // Requested regions are cropped to the image extent
+  next.SetSize(0, std::min<long>(next.GetSize()[0], width - next.GetIndex()[0]));
+  next.SetSize(1, std::min<long>(next.GetSize()[1], height - next.GetIndex()[1]));
+
+  return next != current;
+}
+
+void GDALImageIO::StartPrefetch(const itk::ImageIORegion& region)
+{
+  CancelPrefetch();
+
+  m_PrefetchRegion = region;
+  m_PrefetchBuffer.resize(static_cast<std::size_t>(this->GetComponentSize()) * this->GetNumberOfComponents() * region.GetNumberOfPixels());
+
+  m_PrefetchRequest = std::async(std::launch::async, [this]() {
+    try
+    {
+      this->InternalRead(m_PrefetchRegion, m_PrefetchBuffer.data());
+    }
+    catch (itk::ExceptionObject& err)
+    {
+      // The region may not even be requested: the error will be reported
+      // by the synchronous read if it is.
+      otbLogMacro(Debug, << "GDAL read-ahead failed: " << err.GetDescription());
+      return false;
+    }
+    return true;
+  });
+}
+
+bool GDALImageIO::WaitForPrefetch(const itk::ImageIORegion& region)
+{
+  if (!m_PrefetchRequest.valid())
+  {
+    return false;
+  }
+  const bool success = m_PrefetchRequest.get();
+  return success && m_PrefetchRegion == region;
+}
+
+void GDALImageIO::CancelPrefetch()
+{
+  if (m_PrefetchRequest.valid())
+  {
+    m_PrefetchRequest.wait();
+    m_PrefetchRequest = std::future<bool>();
+  }
+}
+
+void GDALImageIO::AdviseReadAhead(const itk::ImageIORegion& region)
+{
+  if (m_NumberOfReadAheadRegions == 0 || region.GetImageDimension() != 2 || region.GetNumberOfPixels() == 0)
+  {
+    return;
+  }
+
+  // A single request covers several regions, so that it is only issued
+  // once every m_NumberOfReadAheadRegions + 1 reads
+  if (m_AdvisedRegion.GetImageDimension() == 2 && m_AdvisedRegion.IsInside(region))
+  {
+    return;
+  }
+
+  long               firstColumn = region.GetIndex()[0];
+  long               firstLine   = region.GetIndex()[1];
+  long               lastColumn  = firstColumn + static_cast<long>(region.GetSize()[0]);
+  long               lastLine    = firstLine + static_cast<long>(region.GetSize()[1]);
+  itk::ImageIORegion current     = region;
+  itk::ImageIORegion next;
+  for (unsigned int i = 0; i < m_NumberOfReadAheadRegions && this->NextRegionInScanOrder(current, next); ++i)
+  {
+    firstColumn = std::min(firstColumn, static_cast<long>(next.GetIndex()[0]));
+    firstLine   = std::min(firstLine, static_cast<long>(next.GetIndex()[1]));
+    lastColumn  = std::max(lastColumn, static_cast<long>(next.GetIndex()[0] + next.GetSize()[0]));
+    lastLine    = std::max(lastLine, static_cast<long>(next.GetIndex()[1] + next.GetSize()[1]));
+    current     = next;
+  }
+
+  m_AdvisedRegion = itk::ImageIORegion(2);
+  m_AdvisedRegion.SetIndex(0, firstColumn);
+  m_AdvisedRegion.SetIndex(1, firstLine);
+  m_AdvisedRegion.SetSize(0, lastColumn - firstColumn);
+  m_AdvisedRegion.SetSize(1, lastLine - firstLine);
+
+  // Same extent as InternalRead(), at the initial resolution
+  const int factor    = 1 << m_ResolutionFactor;
+  const int xOff      = static_cast<int>(firstColumn) * factor;
+  const int yOff      = static_cast<int>(firstLine) * factor;
+  const int nbColumns = std::min(static_cast<int>(lastColumn - firstColumn) * factor, static_cast<int>(m_OriginalDimensions[0]) - xOff);
+  const int nbLines   = std::min(static_cast<int>(lastLine - firstLine) * factor, static_cast<int>(m_OriginalDimensions[1]) - yOff);
+
+  otbLogMacro(Debug, << "GDAL announces the read of [" << xOff << ", " << xOff + nbColumns - 1 << "]x[" << yOff << ", " << yOff + nbLines - 1 << "] from file "
+                     << m_FileName);
+  m_Dataset->GetDataSet()->AdviseRead(xOff, yOff, nbColumns, nbLines, static_cast<int>(lastColumn - firstColumn), static_cast<int>(lastLine - firstLine),
+                                      m_PxType->pixType, m_Dataset->GetDataSet()->GetRasterCount(), nullptr, nullptr);
+}
+
+void GDALImageIO::InternalRead(const itk::ImageIORegion& region, unsigned char* p)
+{
+  GDALDatasetPool::ScopedAccess access(this);
+  const PipelineTracer::TimePointType traceBegin = PipelineTracer::ClockType::now();
+
+  this->AdviseReadAhead(region);
+
   // Get the origin of the region to read
-  int lFirstLineRegion   = this->GetIORegion().GetIndex()[1];
-  int lFirstColumnRegion = this->GetIORegion().GetIndex()[0];
+  int lFirstLineRegion   = region.GetIndex()[1];
+  int lFirstColumnRegion = region.GetIndex()[0];
 
   // Get nb. of lines and columns of the region to read
-  int lNbLinesRegion   = this->GetIORegion().GetSize()[1];
-  int lNbColumnsRegion = this->GetIORegion().GetSize()[0];
+  int lNbLinesRegion   = region.GetSize()[1];
+  int lNbColumnsRegion = region.GetSize()[0];
 
   // Compute the origin of the image region to read at the initial resolution
   int lFirstLine   = lFirstLineRegion * (1 << m_ResolutionFactor);
@@ -255,25 +693,92 @@ void GDALImageIO::Read(void* buffer)
                        << lFirstLineRegion + lNbLinesRegion - 1 << "] x " << nbBands << " bands of type " << GDALGetDataTypeName(m_PxType->pixType)
                        << " from file " << m_FileName);
 
-    otb::Stopwatch chrono  = otb::Stopwatch::StartNew();
-    CPLErr         lCrGdal = m_Dataset->GetDataSet()->RasterIO(GF_Read, lFirstColumn, lFirstLine, lNbColumns, lNbLines, p, lNbColumnsRegion, lNbLinesRegion,
-                                                       m_PxType->pixType, nbBands,
-                                                       // We want to read all bands
-                                                       nullptr, pixelOffset, lineOffset, bandOffset);
+    // Decimated reads let GDAL pick the best overview and resample with
+    // the requested algorithm
+    GDALRasterIOExtraArg extraArg;
+    INIT_RASTERIO_EXTRA_ARG(extraArg);
+    if (m_ResolutionFactor > 0 && !ResamplingAlgorithmFromName(m_ResamplingMethod, extraArg.eResampleAlg))
+    {
+      itkExceptionMacro(<< "Unknown resampling method '" << m_ResamplingMethod << "' for file " << m_FileName);
+    }
+
+    // Split the region into strips of whole rows of blocks, so that no
+    // block is decoded by two threads
+    int blockWidth  = 0;
+    int blockHeight = 0;
+    dataset->GetRasterBand(1)->GetBlockSize(&blockWidth, &blockHeight);
+    blockHeight = std::max(blockHeight, 1);
+
+    const int firstBlockRow = lFirstLine / blockHeight;
+    const int nbBlockRows   = (lFirstLine + lNbLines - 1) / blockHeight - firstBlockRow + 1;
+    int       nbStrips      = 1;
+    if (m_ResolutionFactor == 0 && nbBlockRows > 1)
+    {
+      nbStrips = std::min(static_cast<int>(std::max(m_NumberOfReadThreads, 1u)), nbBlockRows);
+    }
+
+    // Read the lines [firstLine, firstLine + nbLines) of the region with
+    // the given handle. Returns the GDAL error message on failure
+    auto readStrip = [=, &extraArg](GDALDataset* handle, int firstLine, int nbLines) -> std::string {
+      GDALRasterIOExtraArg stripExtraArg = extraArg;
+      unsigned char*       stripBuffer   = p + static_cast<std::ptrdiff_t>(firstLine - lFirstLine) * lineOffset;
+      const int            nbLinesRegion = nbStrips > 1 ? nbLines : lNbLinesRegion;
+      CPLErr lCrGdal = handle->RasterIO(GF_Read, lFirstColumn, firstLine, lNbColumns, nbLines, stripBuffer, lNbColumnsRegion, nbLinesRegion, m_PxType->pixType,
+                                        nbBands,
+                                        // We want to read all bands
+                                        nullptr, pixelOffset, lineOffset, bandOffset, &stripExtraArg);
+      return lCrGdal == CE_Failure ? std::string(CPLGetLastErrorMsg()) + " " : std::string();
+    };
+
+    // The extra threads use their own handles: a GDAL dataset must not be
+    // accessed by several threads at the same time
+    while (static_cast<int>(m_ReadDatasets.size()) < nbStrips - 1)
+    {
+      GDALDatasetWrapperPointer handle = GDALDriverManagerWrapper::GetInstance().Open(m_DatasetName);
+      if (handle.IsNull())
+      {
+        itkExceptionMacro(<< "Unable to open another handle on '" << m_DatasetName << "' for parallel reads");
+      }
+      m_ReadDatasets.push_back(handle);
+    }
+
+    otb::Stopwatch                         chrono = otb::Stopwatch::StartNew();
+    std::vector<std::future<std::string>> stripRequests;
+    for (int strip = 1; strip < nbStrips; ++strip)
+    {
+      const int stripBegin = std::max(lFirstLine, (firstBlockRow + strip * nbBlockRows / nbStrips) * blockHeight);
+      const int stripEnd   = std::min(lFirstLine + lNbLines, (firstBlockRow + (strip + 1) * nbBlockRows / nbStrips) * blockHeight);
+      GDALDataset* handle  = m_ReadDatasets[strip - 1]->GetDataSet();
+      stripRequests.push_back(std::async(std::launch::async, readStrip, handle, stripBegin, stripEnd - stripBegin));
+    }
+    const int   firstStripEnd = nbStrips > 1 ? (firstBlockRow + nbBlockRows / nbStrips) * blockHeight : lFirstLine + lNbLines;
+    std::string errors        = readStrip(dataset, lFirstLine, firstStripEnd - lFirstLine);
+    for (auto& request : stripRequests)
+    {
+      errors += request.get();
+    }
     chrono.Stop();
     // Check if gdal call succeed
-    if (lCrGdal == CE_Failure)
+    if (!errors.empty())
     {
-      itkExceptionMacro(<< "Error while reading image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+      itkExceptionMacro(<< "Error while reading image (GDAL format) '" << m_FileName << "' : " << errors);
       return;
     }
 
     otbLogMacro(Debug, << "GDAL read took " << chrono.GetElapsedMilliseconds() << " ms")
   }
+
+  if (PipelineTracer::GetInstance().IsEnabled())
+  {
+    PipelineTracer::CountersType counters;
+    counters["bytes"] = static_cast<double>(this->GetComponentSize()) * this->GetNumberOfComponents() * region.GetNumberOfPixels();
+    PipelineTracer::GetInstance().AddEvent("GDALImageIO::Read", "io", traceBegin, PipelineTracer::ClockType::now(), counters, m_FileName);
+  }
 }
 
 bool GDALImageIO::GetSubDatasetInfo(std::vector<std::string>& names, std::vector<std::string>& desc)
 {
+  GDALDatasetPool::ScopedAccess access(this);
   // Note: we assume that the subdatasets are in order : SUBDATASET_ID_NAME, SUBDATASET_ID_DESC, SUBDATASET_ID+1_NAME, SUBDATASET_ID+1_DESC
   char** papszMetadata;
   papszMetadata = m_Dataset->GetDataSet()->GetMetadata("SUBDATASETS");
@@ -327,6 +832,7 @@ void GDALImageIO::ReadImageInformation()
 
 unsigned int GDALImageIO::GetOverviewsCount()
 {
+  GDALDatasetPool::ScopedAccess access(this);
   GDALDataset* dataset = m_Dataset->GetDataSet();
 
   // JPEG2000 case : use the number of overviews actually in the dataset
@@ -360,6 +866,7 @@ unsigned int GDALImageIO::GetOverviewsCount()
 
 std::vector<std::string> GDALImageIO::GetOverviewsInfo()
 {
+  GDALDatasetPool::ScopedAccess access(this);
   std::vector<std::string> desc;
 
   // This should never happen, according to implementation of GetOverviewCount()
@@ -419,6 +926,12 @@ void GDALImageIO::SetEpsgCode(const unsigned int epsgCode)
 
 void GDALImageIO::InternalReadImageInformation()
 {
+  CancelPrefetch();
+  GDALDatasetPool::ScopedAccess access(this);
+  m_LastReadRegion  = itk::ImageIORegion();
+  m_LineStartRegion = itk::ImageIORegion();
+  m_AdvisedRegion   = itk::ImageIORegion();
+
   itk::ExposeMetaData<unsigned int>(this->GetMetaDataDictionary(), MetaDataKey::ResolutionFactor, m_ResolutionFactor);
 
   itk::ExposeMetaData<unsigned int>(this->GetMetaDataDictionary(), MetaDataKey::SubDatasetIndex, m_DatasetNumber);
@@ -452,7 +965,9 @@ void GDALImageIO::InternalReadImageInformation()
     }
     if (m_DatasetNumber < names.size())
     {
-      m_Dataset = GDALDriverManagerWrapper::GetInstance().Open(names[m_DatasetNumber]);
+      m_ReadDatasets.clear();
+      m_Dataset     = GDALDriverManagerWrapper::GetInstance().Open(names[m_DatasetNumber]);
+      m_DatasetName = names[m_DatasetNumber];
     }
     else
     {
@@ -1184,6 +1699,8 @@ bool GDALImageIO::CanStreamWrite()
 
 void GDALImageIO::Write(const void* buffer)
 {
+  const PipelineTracer::TimePointType traceBegin = PipelineTracer::ClockType::now();
+
   // Check if we have to write the image information
   if (m_FlagWriteImageInformation == true)
   {
@@ -1224,8 +1741,18 @@ void GDALImageIO::Write(const void* buffer)
   // unsigned char *p = static_cast<unsigned char*>( const_cast<void *>(buffer));
   // printDataBuffer(p,  m_PxType->pixType, m_NbBands, 10*2); // Buffer incorrect
 
+  // The flag only applies to this region
+  const bool isNoData = m_IORegionIsNoData;
+  m_IORegionIsNoData  = false;
+
+  // Blocks never written are read back as no-data in sparse files
+  if (m_CanStreamWrite && isNoData && this->CanSkipNoDataRegions())
+  {
+    otbLogMacro(Debug, << "GDAL leaves [" << lFirstColumn << ", " << lFirstColumn + lNbColumns - 1 << "]x[" << lFirstLine << ", " << lFirstLine + lNbLines - 1
+                       << "] empty in file " << m_FileName << " (no-data region)");
+  }
   // If driver supports streaming
-  if (m_CanStreamWrite)
+  else if (m_CanStreamWrite)
   {
     otbLogMacro(Debug, << "GDAL writes [" << lFirstColumn << ", " << lFirstColumn + lNbColumns - 1 << "]x[" << lFirstLine << ", " << lFirstLine + lNbLines - 1
                        << "] x " << m_NbBands << " bands of type " << GDALGetDataTypeName(m_PxType->pixType) << " to file " << m_FileName);
@@ -1253,6 +1780,11 @@ void GDALImageIO::Write(const void* buffer)
 
     otbLogMacro(Debug, << "GDAL write took " << chrono.GetElapsedMilliseconds() << " ms")
 
+    if (m_StreamedOverviews)
+    {
+      m_StreamedOverviews->AddRegion(buffer, m_PxType->pixType, lFirstColumn, lFirstLine, lNbColumns, lNbLines);
+    }
+
         // Flush dataset cache
         m_Dataset->GetDataSet()
             ->FlushCache();
@@ -1270,7 +1802,7 @@ void GDALImageIO::Write(const void* buffer)
       itkExceptionMacro(<< "Unable to instantiate driver " << gdalDriverShortName << " to write " << m_FileName);
     }
 
-    GDALCreationOptionsType creationOptions = m_CreationOptions;
+    GDALCreationOptionsType creationOptions = GetWriteCreationOptions(gdalDriverShortName);
     GDALDataset*            hOutputDS =
         driver->CreateCopy(realFileName.c_str(), m_Dataset->GetDataSet(), FALSE, otb::ogr::StringListConverter(creationOptions).to_ogr(), nullptr, nullptr);
     if (!hOutputDS)
@@ -1284,14 +1816,75 @@ void GDALImageIO::Write(const void* buffer)
   }
 
 
+  if (PipelineTracer::GetInstance().IsEnabled())
+  {
+    PipelineTracer::CountersType counters;
+    counters["bytes"] = static_cast<double>(m_BytePerPixel) * m_NbBands * lNbLines * lNbColumns;
+    PipelineTracer::GetInstance().AddEvent("GDALImageIO::Write", "io", traceBegin, PipelineTracer::ClockType::now(), counters, m_FileName);
+  }
+
   if (lFirstLine + lNbLines == m_Dimensions[1] && lFirstColumn + lNbColumns == m_Dimensions[0])
   {
     // Last pixel written
+    if (!m_CloudOptimizedTemporaryFileName.empty())
+    {
+      FinalizeCloudOptimized();
+    }
     // Reinitialize to close the file
     m_Dataset = GDALDatasetWrapperPointer();
   }
 }
 
+void GDALImageIO::FinalizeCloudOptimized()
+{
+  if (m_StreamedOverviews->GetNumberOfPendingPixels() != 0)
+  {
+    itkWarningMacro(<< m_StreamedOverviews->GetNumberOfPendingPixels() << " overview pixels of " << m_FileName
+                    << " have not been computed, some regions have not been written");
+  }
+  m_StreamedOverviews.reset();
+
+  // Close the temporary file and reopen it, so that GDAL copies what has
+  // actually been written
+  const std::string temporaryFileName = m_CloudOptimizedTemporaryFileName;
+  m_CloudOptimizedTemporaryFileName.clear();
+  m_Dataset = GDALDatasetWrapperPointer();
+  m_Dataset = GDALDriverManagerWrapper::GetInstance().Open(temporaryFileName);
+  if (m_Dataset.IsNull())
+  {
+    itkExceptionMacro(<< "Unable to open the temporary file " << temporaryFileName << " : " << CPLGetLastErrorMsg());
+  }
+
+  // Copying the overviews first puts the image directories and the lowest
+  // resolutions at the beginning of the file, which is the COG layout
+  GDALCreationOptionsType creationOptions = GetWriteCreationOptions("GTiff");
+  creationOptions.push_back("TILED=YES");
+  creationOptions.push_back("COPY_SRC_OVERVIEWS=YES");
+  if (!CreationOptionContains("BLOCKXSIZE=") && !CreationOptionContains("BLOCKYSIZE="))
+  {
+    creationOptions.push_back("BLOCKXSIZE=512");
+    creationOptions.push_back("BLOCKYSIZE=512");
+  }
+
+  GDALDriver*       driver       = GDALDriverManagerWrapper::GetInstance().GetDriverByName("GTiff");
+  const std::string realFileName = GetGdalWriteImageFileName("GTiff", m_FileName);
+
+  otb::Stopwatch chrono    = otb::Stopwatch::StartNew();
+  GDALDataset*   hOutputDS = driver->CreateCopy(realFileName.c_str(), m_Dataset->GetDataSet(), FALSE, otb::ogr::StringListConverter(creationOptions).to_ogr(),
+                                              nullptr, nullptr);
+  chrono.Stop();
+  m_Dataset = GDALDatasetWrapperPointer();
+  driver->Delete(temporaryFileName.c_str());
+
+  if (!hOutputDS)
+  {
+    itkExceptionMacro(<< "Error while writing image (GDAL format) '" << m_FileName << "' : " << CPLGetLastErrorMsg());
+  }
+  GDALClose(hOutputDS);
+
+  otbLogMacro(Debug, << "Cloud Optimized GeoTIFF layout of " << m_FileName << " written in " << chrono.GetElapsedMilliseconds() << " ms")
+}
+
 /** TODO : Method WriteImageInformation not implemented */
 void GDALImageIO::WriteImageInformation()
 {
@@ -1299,6 +1892,9 @@ void GDALImageIO::WriteImageInformation()
 
 void GDALImageIO::InternalWriteImageInformation(const void* buffer)
 {
+  // Datasets opened for writing are never closed by the pool
+  GDALDatasetPool::GetInstance().Unregister(this);
+
   // char **     papszOptions = NULL;
   std::string driverShortName;
   m_NbBands = this->GetNumberOfComponents();
@@ -1434,12 +2030,69 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
     itkExceptionMacro(<< "GDAL Writing failed: the image file name '" << m_FileName << "' is not recognized by GDAL.");
   }
 
-  if (m_CanStreamWrite)
+  // Cloud Optimized GeoTIFF are streamed to a temporary tiled file, whose
+  // overviews are computed on the fly, then copied once to their final layout
+  m_StreamedOverviews.reset();
+  m_CloudOptimizedTemporaryFileName.clear();
+  bool         cloudOptimized          = m_CloudOptimized;
+  unsigned int cloudOptimizedBlockSize = 512;
+  if (cloudOptimized && (driverShortName != "GTiff" || !m_CanStreamWrite || this->GetPixelType() == COMPLEX))
+  {
+    itkWarningMacro(<< "Cloud Optimized GeoTIFF is only available for non complex GeoTIFF images, " << m_FileName << " is written as a regular file");
+    cloudOptimized = false;
+  }
+
+  if (cloudOptimized)
+  {
+    GDALCreationOptionsType creationOptions = {"TILED=YES", "BIGTIFF=IF_SAFER"};
+    for (const auto& option : m_CreationOptions)
+    {
+      if (option.find("BLOCKXSIZE=") == 0 || option.find("BLOCKYSIZE=") == 0)
+      {
+        creationOptions.push_back(option);
+        cloudOptimizedBlockSize = std::min(cloudOptimizedBlockSize, static_cast<unsigned int>(std::stoul(option.substr(option.find('=') + 1))));
+      }
+    }
+    if (creationOptions.size() == 2)
+    {
+      creationOptions.push_back("BLOCKXSIZE=512");
+      creationOptions.push_back("BLOCKYSIZE=512");
+    }
+
+    m_CloudOptimizedTemporaryFileName = GetGdalWriteImageFileName(driverShortName, m_FileName) + ".tmp.tif";
+    m_Dataset = GDALDriverManagerWrapper::GetInstance().Create(driverShortName, m_CloudOptimizedTemporaryFileName, m_Dimensions[0], m_Dimensions[1], m_NbBands,
+                                                               m_PxType->pixType, otb::ogr::StringListConverter(creationOptions).to_ogr());
+    if (m_Dataset.IsNull())
+    {
+      itkExceptionMacro(<< CPLGetLastErrorMsg());
+    }
+  }
+  else if (m_CanStreamWrite)
   {
-    GDALCreationOptionsType creationOptions = m_CreationOptions;
-    m_Dataset =
-        GDALDriverManagerWrapper::GetInstance().Create(driverShortName, GetGdalWriteImageFileName(driverShortName, m_FileName), m_Dimensions[0],
-                                                       m_Dimensions[1], m_NbBands, m_PxType->pixType, otb::ogr::StringListConverter(creationOptions).to_ogr());
+    // Resumed writes update the file left by the interrupted one, when it
+    // still matches the image to write
+    m_Dataset = nullptr;
+    if (m_UpdateExistingFile)
+    {
+      m_Dataset = GDALDriverManagerWrapper::GetInstance().OpenForUpdate(GetGdalWriteImageFileName(driverShortName, m_FileName));
+      if (m_Dataset.IsNotNull())
+      {
+        GDALDataset* existing = m_Dataset->GetDataSet();
+        if (existing->GetRasterXSize() != static_cast<int>(m_Dimensions[0]) || existing->GetRasterYSize() != static_cast<int>(m_Dimensions[1]) ||
+            existing->GetRasterCount() != m_NbBands || existing->GetRasterBand(1)->GetRasterDataType() != m_PxType->pixType)
+        {
+          itkWarningMacro(<< "The existing file " << m_FileName << " does not match the image to write, it is written again");
+          m_Dataset = nullptr;
+        }
+      }
+    }
+    if (m_Dataset.IsNull())
+    {
+      GDALCreationOptionsType creationOptions = GetWriteCreationOptions(driverShortName);
+      m_Dataset =
+          GDALDriverManagerWrapper::GetInstance().Create(driverShortName, GetGdalWriteImageFileName(driverShortName, m_FileName), m_Dimensions[0],
+                                                         m_Dimensions[1], m_NbBands, m_PxType->pixType, otb::ogr::StringListConverter(creationOptions).to_ogr());
+    }
   }
   else
   {
@@ -1656,6 +2309,13 @@ void GDALImageIO::InternalWriteImageInformation(const void* buffer)
   {
     dataset->SetMetadataItem("AREA_OR_POINT", m_Imd[MDStr::AreaOrPoint].c_str());
   }
+
+  // Created last, so that the overviews use the no-data values set above
+  if (!m_CloudOptimizedTemporaryFileName.empty())
+  {
+    m_StreamedOverviews.reset(
+        new GDALStreamedOverviews(dataset, GDALStreamedOverviews::ComputeNumberOfLevels(m_Dimensions[0], m_Dimensions[1], cloudOptimizedBlockSize)));
+  }
 }
 
 std::string GDALImageIO::FilenameToGdalDriverShortName(const std::string& name) const
@@ -1810,6 +2470,16 @@ bool GDALImageIO::GDALInfoReportCorner(const char* /*corner_name*/, double x, do
   return IsTrue;
 }
 
+bool GDALImageIO::CanSkipNoDataRegions() const
+{
+  // Streamed overviews are computed from every written region
+  if (m_StreamedOverviews || m_Dataset.IsNull() || strcmp(m_Dataset->GetDataSet()->GetDriver()->GetDescription(), "GTiff") != 0)
+  {
+    return false;
+  }
+  return CreationOptionContains("SPARSE_OK=TRUE") || CreationOptionContains("SPARSE_OK=YES") || CreationOptionContains("SPARSE_OK=ON");
+}
+
 bool GDALImageIO::CreationOptionContains(std::string partialOption) const
 {
   size_t i;
@@ -1824,6 +2494,67 @@ bool GDALImageIO::CreationOptionContains(std::string partialOption) const
 }
 
 
+GDALImageIO::GDALCreationOptionsType GDALImageIO::GetWriteCreationOptions(const std::string& driverShortName) const
+{
+  GDALCreationOptionsType creationOptions = m_CreationOptions;
+
+  GDALDriver* driver = GDALDriverManagerWrapper::GetInstance().GetDriverByName(driverShortName);
+  const char* supportedOptions = driver != nullptr ? driver->GetMetadataItem(GDAL_DMD_CREATIONOPTIONLIST) : nullptr;
+  const std::string optionList = supportedOptions != nullptr ? supportedOptions : "";
+
+  if (!m_CompressionPreset.empty() && !CreationOptionContains("COMPRESS="))
+  {
+    if (driverShortName != "GTiff")
+    {
+      itkWarningMacro(<< "Compression presets are only available for GeoTIFF files, " << m_FileName << " is written with the default compression");
+    }
+    else if (m_CompressionPreset == "none")
+    {
+      creationOptions.push_back("COMPRESS=NONE");
+    }
+    else if (m_CompressionPreset == "lzw")
+    {
+      creationOptions.push_back("COMPRESS=LZW");
+    }
+    else if (m_CompressionPreset == "deflate")
+    {
+      creationOptions.push_back("COMPRESS=DEFLATE");
+      creationOptions.push_back("ZLEVEL=6");
+    }
+    else if ((m_CompressionPreset == "zstd" || m_CompressionPreset == "fast") && optionList.find("ZSTD") != std::string::npos)
+    {
+      creationOptions.push_back("COMPRESS=ZSTD");
+      creationOptions.push_back(m_CompressionPreset == "fast" ? "ZSTD_LEVEL=1" : "ZSTD_LEVEL=9");
+    }
+    else
+    {
+      // GDAL built without ZSTD
+      creationOptions.push_back("COMPRESS=DEFLATE");
+      creationOptions.push_back(m_CompressionPreset == "fast" ? "ZLEVEL=1" : "ZLEVEL=6");
+    }
+  }
+
+  // Blocks are compressed in parallel by the driver when it is supported
+  bool compressed = false;
+  for (const auto& option : creationOptions)
+  {
+    if (boost::algorithm::istarts_with(option, "COMPRESS="))
+    {
+      compressed = !boost::algorithm::iequals(option, "COMPRESS=NONE");
+    }
+  }
+  if (compressed && !CreationOptionContains("NUM_THREADS=") && optionList.find("NUM_THREADS") != std::string::npos)
+  {
+    const unsigned int nbThreads =
+        m_NumberOfCompressionThreads != 0 ? m_NumberOfCompressionThreads : static_cast<unsigned int>(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
+    if (nbThreads > 1)
+    {
+      creationOptions.push_back("NUM_THREADS=" + std::to_string(nbThreads));
+    }
+  }
+  return creationOptions;
+}
+
 std::string GDALImageIO::GetGdalPixelTypeAsString() const
 {
   std::string name = GDALGetDataTypeName(m_PxType->pixType);
@@ -1833,6 +2564,7 @@ std::string GDALImageIO::GetGdalPixelTypeAsString() const
 
 int GDALImageIO::GetNbBands() const
 {
+  GDALDatasetPool::ScopedAccess access(this);
   return m_Dataset->GetDataSet()->GetRasterCount();
 }
 
@@ -1852,6 +2584,7 @@ std::string GDALImageIO::GetResourceFile(std::string const& str) const
 
 std::vector<std::string> GDALImageIO::GetResourceFiles() const
 {
+  GDALDatasetPool::ScopedAccess access(this);
   std::vector<std::string> result;
   for (char ** file = this->m_Dataset->GetDataSet()->GetFileList() ; *file != nullptr ; ++ file)
     result.push_back(*file);
@@ -1860,6 +2593,7 @@ std::vector<std::string> GDALImageIO::GetResourceFiles() const
 
 std::string GDALImageIO::GetMetadataValue(std::string const& path, bool& hasValue, int band) const
 {
+  GDALDatasetPool::ScopedAccess access(this);
   // detect namespace if any
   std::string domain("");
   std::string key(path);
@@ -1934,6 +2668,7 @@ void GDALImageIO::ExportMetadata()
 
 void GDALImageIO::ImportMetadata()
 {
+  GDALDatasetPool::ScopedAccess access(this);
   // TODO
   // Check special value METADATATYPE=OTB before continue processing
   // Keys Starting with: MDGeomNames[MDGeom::SensorGeometry] + '.' should
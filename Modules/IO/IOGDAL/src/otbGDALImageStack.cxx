@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGDALImageStack.h"
+#include "otbGDALDriverManagerWrapper.h"
+
+#include "itkMacro.h"
+
+#include "gdal.h"
+#include "gdal_priv.h"
+#include "vrtdataset.h"
+
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
+#include <sstream>
+
+namespace otb
+{
+
+GDALImageStack::GDALImageStack(const std::vector<std::string>& fileNames, bool asVRT) : m_FirstBand(1, 0), m_VRT(nullptr)
+{
+  if (fileNames.empty())
+  {
+    itkGenericExceptionMacro(<< "No image to stack");
+  }
+
+  for (const auto& fileName : fileNames)
+  {
+    GDALDatasetWrapper::Pointer dataset = GDALDriverManagerWrapper::GetInstance().Open(fileName);
+    if (dataset.IsNull())
+    {
+      itkGenericExceptionMacro(<< "Unable to open " << fileName);
+    }
+    if (!m_Datasets.empty() && (dataset->GetWidth() != GetWidth() || dataset->GetHeight() != GetHeight()))
+    {
+      itkGenericExceptionMacro(<< "Size of " << fileName << " (" << dataset->GetWidth() << "x" << dataset->GetHeight() << ") differs from the size of "
+                               << fileNames.front() << " (" << GetWidth() << "x" << GetHeight() << ")");
+    }
+    m_FirstBand.push_back(m_FirstBand.back() + dataset->GetDataSet()->GetRasterCount());
+    m_Datasets.push_back(dataset);
+  }
+
+  if (asVRT)
+  {
+    BuildVRT();
+  }
+}
+
+GDALImageStack::~GDALImageStack()
+{
+  if (m_VRT)
+  {
+    GDALClose(m_VRT);
+  }
+}
+
+unsigned int GDALImageStack::GetWidth() const
+{
+  return m_Datasets.front()->GetWidth();
+}
+
+unsigned int GDALImageStack::GetHeight() const
+{
+  return m_Datasets.front()->GetHeight();
+}
+
+void GDALImageStack::BuildVRT()
+{
+  GDALDriver* driver = GDALDriverManagerWrapper::GetInstance().GetDriverByName("VRT");
+  if (driver == nullptr)
+  {
+    itkGenericExceptionMacro(<< "GDAL VRT driver not available");
+  }
+  m_VRT = driver->Create("", GetWidth(), GetHeight(), 0, GDT_Byte, nullptr);
+  if (m_VRT == nullptr)
+  {
+    itkGenericExceptionMacro(<< "Unable to create the VRT of the stack: " << CPLGetLastErrorMsg());
+  }
+
+  for (const auto& dataset : m_Datasets)
+  {
+    GDALDataset* source = dataset->GetDataSet();
+    for (int band = 1; band <= source->GetRasterCount(); ++band)
+    {
+      GDALRasterBand* sourceBand = source->GetRasterBand(band);
+      m_VRT->AddBand(sourceBand->GetRasterDataType(), nullptr);
+      VRTSourcedRasterBand* vrtBand = dynamic_cast<VRTSourcedRasterBand*>(m_VRT->GetRasterBand(m_VRT->GetRasterCount()));
+      vrtBand->AddSimpleSource(sourceBand, 0, 0, GetWidth(), GetHeight(), 0, 0, GetWidth(), GetHeight());
+    }
+  }
+}
+
+void GDALImageStack::Read(void* buffer, int dataType, int x, int y, int sizeX, int sizeY, unsigned int numberOfThreads) const
+{
+  const GDALDataType type      = static_cast<GDALDataType>(dataType);
+  const GSpacing     pixelSize = GDALGetDataTypeSizeBytes(type);
+  const GSpacing     pixelStep = pixelSize * GetNumberOfBands();
+  const GSpacing     lineStep  = pixelStep * sizeX;
+
+  // Read the bands of one dataset at their place in the interleaved buffer
+  auto readDataset = [=](GDALDataset* dataset, unsigned int firstBand) {
+    return dataset->RasterIO(GF_Read, x, y, sizeX, sizeY, static_cast<char*>(buffer) + firstBand * pixelSize, sizeX, sizeY, type, dataset->GetRasterCount(),
+                             nullptr, pixelStep, lineStep, pixelSize, nullptr);
+  };
+
+  if (m_VRT)
+  {
+    if (readDataset(m_VRT, 0) == CE_Failure)
+    {
+      itkGenericExceptionMacro(<< "Unable to read the VRT of the stack: " << CPLGetLastErrorMsg());
+    }
+    return;
+  }
+
+  std::atomic<unsigned int> next(0);
+  std::mutex                errorMutex;
+  std::ostringstream        errors;
+
+  auto worker = [&]() {
+    for (unsigned int image = next++; image < m_Datasets.size(); image = next++)
+    {
+      GDALDataset* dataset = m_Datasets[image]->GetDataSet();
+      if (readDataset(dataset, m_FirstBand[image]) == CE_Failure)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        errors << " " << dataset->GetDescription() << ": " << CPLGetLastErrorMsg() << ";";
+      }
+    }
+  };
+
+  // The calling thread takes its share of the datasets
+  const unsigned int             nbTasks = std::max(1u, std::min<unsigned int>(numberOfThreads, m_Datasets.size()));
+  std::vector<std::future<void>> tasks;
+  for (unsigned int task = 1; task < nbTasks; ++task)
+  {
+    tasks.push_back(std::async(std::launch::async, worker));
+  }
+  worker();
+  for (auto& task : tasks)
+  {
+    task.get();
+  }
+
+  if (!errors.str().empty())
+  {
+    itkGenericExceptionMacro(<< "Unable to read region [" << x << ", " << y << ", " << sizeX << ", " << sizeY << "] of the stack:" << errors.str());
+  }
+}
+
+} // namespace otb
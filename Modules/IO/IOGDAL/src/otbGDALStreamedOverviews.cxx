@@ -0,0 +1,279 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGDALStreamedOverviews.h"
+
+#include "itkMacro.h"
+
+#include "gdal.h"
+#include "gdal_priv.h"
+
+#include <algorithm>
+
+namespace otb
+{
+
+namespace
+{
+// Full resolution regions are averaged by chunks of rows aligned on this
+// size, which bounds the memory used by the conversion to double
+const int ChunkRows = 64;
+
+std::uint64_t PixelKey(int i, int j)
+{
+  return (static_cast<std::uint64_t>(j) << 32) | static_cast<std::uint32_t>(i);
+}
+}
+
+GDALStreamedOverviews::GDALStreamedOverviews(GDALDataset* dataset, unsigned int nbLevels)
+  : m_Dataset(dataset), m_NbBands(dataset->GetRasterCount()), m_NbLevels(nbLevels), m_Pending(nbLevels + 1)
+{
+  m_SizeX.push_back(dataset->GetRasterXSize());
+  m_SizeY.push_back(dataset->GetRasterYSize());
+
+  if (nbLevels == 0)
+  {
+    return;
+  }
+
+  // Create empty overview levels, their content is written by Emit()
+  std::vector<int> factors;
+  for (unsigned int level = 1; level <= nbLevels; ++level)
+  {
+    factors.push_back(1 << level);
+  }
+  if (m_Dataset->BuildOverviews("NONE", static_cast<int>(nbLevels), factors.data(), 0, nullptr, nullptr, nullptr) != CE_None)
+  {
+    itkGenericExceptionMacro(<< "Unable to create the overviews of " << m_Dataset->GetDescription() << ": " << CPLGetLastErrorMsg());
+  }
+
+  // Levels are halved with rounding up, as GDAL does
+  for (unsigned int level = 1; level <= nbLevels; ++level)
+  {
+    m_SizeX.push_back((m_SizeX.back() + 1) / 2);
+    m_SizeY.push_back((m_SizeY.back() + 1) / 2);
+
+    GDALRasterBand* overview = m_Dataset->GetRasterBand(1)->GetOverview(level - 1);
+    if (overview == nullptr || overview->GetXSize() != m_SizeX.back() || overview->GetYSize() != m_SizeY.back())
+    {
+      itkGenericExceptionMacro(<< "Unexpected overview level " << level << " in " << m_Dataset->GetDescription());
+    }
+  }
+
+  for (unsigned int band = 1; band <= m_NbBands; ++band)
+  {
+    int          hasNoData = FALSE;
+    const double noData    = m_Dataset->GetRasterBand(band)->GetNoDataValue(&hasNoData);
+    m_NoData.emplace_back(hasNoData != FALSE, noData);
+  }
+}
+
+void GDALStreamedOverviews::AddRegion(const void* buffer, int dataType, int x, int y, int sizeX, int sizeY)
+{
+  if (m_NbLevels == 0 || sizeX <= 0 || sizeY <= 0)
+  {
+    return;
+  }
+
+  const GDALDataType   type      = static_cast<GDALDataType>(dataType);
+  const int            typeSize  = GDALGetDataTypeSizeBytes(type);
+  const int            rowValues = sizeX * static_cast<int>(m_NbBands);
+  const unsigned char* input     = static_cast<const unsigned char*>(buffer);
+  std::vector<double>  rows;
+
+  for (int startY = y; startY < y + sizeY;)
+  {
+    const int endY = std::min(y + sizeY, (startY / ChunkRows + 1) * ChunkRows);
+    rows.resize(static_cast<std::size_t>(endY - startY) * rowValues);
+    for (int row = startY; row < endY; ++row)
+    {
+      GDALCopyWords(const_cast<unsigned char*>(input) + static_cast<std::size_t>(row - y) * rowValues * typeSize, type, typeSize,
+                    rows.data() + static_cast<std::size_t>(row - startY) * rowValues, GDT_Float64, sizeof(double), rowValues);
+    }
+    Decimate(0, rows.data(), x, startY, sizeX, endY - startY);
+    startY = endY;
+  }
+}
+
+std::size_t GDALStreamedOverviews::GetNumberOfPendingPixels() const
+{
+  std::size_t nbPixels = 0;
+  for (const auto& pending : m_Pending)
+  {
+    nbPixels += pending.size();
+  }
+  return nbPixels;
+}
+
+unsigned int GDALStreamedOverviews::ComputeNumberOfLevels(unsigned int sizeX, unsigned int sizeY, unsigned int blockSize)
+{
+  unsigned int nbLevels = 0;
+  while (std::max(sizeX, sizeY) > std::max(1u, blockSize))
+  {
+    sizeX = (sizeX + 1) / 2;
+    sizeY = (sizeY + 1) / 2;
+    ++nbLevels;
+  }
+  return nbLevels;
+}
+
+double GDALStreamedOverviews::Average(const std::vector<double>& sum, const std::vector<unsigned int>& count, unsigned int band) const
+{
+  if (count[band] == 0)
+  {
+    return m_NoData[band].first ? m_NoData[band].second : 0.;
+  }
+  return sum[band] / count[band];
+}
+
+void GDALStreamedOverviews::Decimate(unsigned int level, const double* data, int x, int y, int sizeX, int sizeY)
+{
+  const unsigned int nbBands = m_NbBands;
+  const int          srcX    = m_SizeX[level];
+  const int          srcY    = m_SizeY[level];
+  PendingMapType&    pending = m_Pending[level + 1];
+
+  // Overview pixels whose footprint lies entirely in the region
+  const int beginI = (x + 1) / 2;
+  const int endI   = (x + sizeX == srcX) ? m_SizeX[level + 1] : (x + sizeX) / 2;
+  const int beginJ = (y + 1) / 2;
+  const int endJ   = (y + sizeY == srcY) ? m_SizeY[level + 1] : (y + sizeY) / 2;
+  const int innerX = std::max(0, endI - beginI);
+  const int innerY = std::max(0, endJ - beginJ);
+
+  std::vector<double>        inner(static_cast<std::size_t>(innerX) * innerY * nbBands);
+  std::vector<std::uint64_t> completed;
+  std::vector<double>        sum(nbBands);
+  std::vector<unsigned int>  count(nbBands);
+
+  for (int j = y / 2; j <= (y + sizeY - 1) / 2; ++j)
+  {
+    for (int i = x / 2; i <= (x + sizeX - 1) / 2; ++i)
+    {
+      std::fill(sum.begin(), sum.end(), 0.);
+      std::fill(count.begin(), count.end(), 0);
+      unsigned int coverage = 0;
+
+      for (int sy = std::max(2 * j, y); sy < std::min(2 * j + 2, y + sizeY); ++sy)
+      {
+        for (int sx = std::max(2 * i, x); sx < std::min(2 * i + 2, x + sizeX); ++sx)
+        {
+          const double* pixel = data + (static_cast<std::size_t>(sy - y) * sizeX + (sx - x)) * nbBands;
+          ++coverage;
+          for (unsigned int band = 0; band < nbBands; ++band)
+          {
+            if (!m_NoData[band].first || pixel[band] != m_NoData[band].second)
+            {
+              sum[band] += pixel[band];
+              ++count[band];
+            }
+          }
+        }
+      }
+
+      if (i >= beginI && i < endI && j >= beginJ && j < endJ)
+      {
+        double* out = inner.data() + (static_cast<std::size_t>(j - beginJ) * innerX + (i - beginI)) * nbBands;
+        for (unsigned int band = 0; band < nbBands; ++band)
+        {
+          out[band] = Average(sum, count, band);
+        }
+      }
+      else
+      {
+        // Partial footprint: accumulate until the other regions arrive
+        PendingPixel& pixel = pending[PixelKey(i, j)];
+        if (pixel.Sum.empty())
+        {
+          pixel.Sum.assign(nbBands, 0.);
+          pixel.Count.assign(nbBands, 0);
+          pixel.Coverage = 0;
+        }
+        for (unsigned int band = 0; band < nbBands; ++band)
+        {
+          pixel.Sum[band] += sum[band];
+          pixel.Count[band] += count[band];
+        }
+        pixel.Coverage += coverage;
+
+        const unsigned int expected = std::min(2, srcX - 2 * i) * std::min(2, srcY - 2 * j);
+        if (pixel.Coverage == expected)
+        {
+          completed.push_back(PixelKey(i, j));
+        }
+      }
+    }
+  }
+
+  if (innerX > 0 && innerY > 0)
+  {
+    Emit(level + 1, inner.data(), beginI, beginJ, innerX, innerY);
+  }
+
+  // Completed pixels are emitted by runs along the lines, which is what
+  // the boundaries between strips produce
+  std::sort(completed.begin(), completed.end());
+  std::vector<double> run;
+  for (std::size_t first = 0; first < completed.size();)
+  {
+    std::size_t last = first + 1;
+    while (last < completed.size() && completed[last] == completed[last - 1] + 1)
+    {
+      ++last;
+    }
+
+    run.resize((last - first) * nbBands);
+    for (std::size_t k = first; k < last; ++k)
+    {
+      auto it = pending.find(completed[k]);
+      for (unsigned int band = 0; band < nbBands; ++band)
+      {
+        run[(k - first) * nbBands + band] = Average(it->second.Sum, it->second.Count, band);
+      }
+      pending.erase(it);
+    }
+
+    const int i = static_cast<int>(completed[first] & 0xFFFFFFFF);
+    const int j = static_cast<int>(completed[first] >> 32);
+    Emit(level + 1, run.data(), i, j, static_cast<int>(last - first), 1);
+    first = last;
+  }
+}
+
+void GDALStreamedOverviews::Emit(unsigned int level, const double* data, int x, int y, int sizeX, int sizeY)
+{
+  const int pixelSpace = static_cast<int>(m_NbBands * sizeof(double));
+  for (unsigned int band = 0; band < m_NbBands; ++band)
+  {
+    GDALRasterBand* overview = m_Dataset->GetRasterBand(band + 1)->GetOverview(level - 1);
+    if (overview->RasterIO(GF_Write, x, y, sizeX, sizeY, const_cast<double*>(data) + band, sizeX, sizeY, GDT_Float64, pixelSpace, pixelSpace * sizeX,
+                           nullptr) != CE_None)
+    {
+      itkGenericExceptionMacro(<< "Unable to write overview level " << level << " of " << m_Dataset->GetDescription() << ": " << CPLGetLastErrorMsg());
+    }
+  }
+
+  if (level < m_NbLevels)
+  {
+    Decimate(level, data, x, y, sizeX, sizeY);
+  }
+}
+
+} // end namespace otb
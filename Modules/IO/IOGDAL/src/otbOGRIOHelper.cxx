@@ -25,6 +25,9 @@
 #include "otbOGR.h"
 #include "otbStopwatch.h"
 
+#include <memory>
+#include <vector>
+
 namespace otb
 {
 
@@ -66,17 +69,12 @@ void OGRIOHelper::ConvertGeometryToLineNode(const OGRGeometry* ogrGeometry, Data
 
   LinePointerType line = LineType::New();
 
-  OGRPoint* ogrTmpPoint = (OGRPoint*)OGRGeometryFactory::createGeometry(wkbPoint);
-
   for (int pIndex = 0; pIndex < ogrLine->getNumPoints(); ++pIndex)
   {
-
-    ogrLine->getPoint(pIndex, ogrTmpPoint);
-
     LineType::VertexType vertex;
 
-    vertex[0] = ogrTmpPoint->getX();
-    vertex[1] = ogrTmpPoint->getY();
+    vertex[0] = ogrLine->getX(pIndex);
+    vertex[1] = ogrLine->getY(pIndex);
 
     if (DataNodeType::Dimension > 2)
     {
@@ -84,12 +82,11 @@ void OGRIOHelper::ConvertGeometryToLineNode(const OGRGeometry* ogrGeometry, Data
       {
         itkGenericExceptionMacro(<< "OTB vector data can't contain the OGR information (2D instead of 2.5D)");
       }
-      vertex[2] = ogrTmpPoint->getZ();
+      vertex[2] = ogrLine->getZ(pIndex);
     }
 
     line->AddVertex(vertex);
   }
-  OGRGeometryFactory::destroyGeometry(ogrTmpPoint);
 
   node->SetLine(line);
 }
@@ -104,17 +101,15 @@ void OGRIOHelper::ConvertGeometryToPolygonNode(const OGRGeometry* ogrGeometry, D
     itkGenericExceptionMacro(<< "Failed to convert OGRGeometry to OGRPolygon");
   }
 
-  OGRPoint*      ogrTmpPoint = (OGRPoint*)OGRGeometryFactory::createGeometry(wkbPoint);
-  OGRLinearRing* ogrRing     = ogrPolygon->getExteriorRing();
+  OGRLinearRing* ogrRing = ogrPolygon->getExteriorRing();
 
   PolygonPointerType extRing = PolygonType::New();
 
   for (int pIndex = 0; pIndex < ogrRing->getNumPoints(); ++pIndex)
   {
-    ogrRing->getPoint(pIndex, ogrTmpPoint);
     PolygonType::VertexType vertex;
-    vertex[0] = ogrTmpPoint->getX();
-    vertex[1] = ogrTmpPoint->getY();
+    vertex[0] = ogrRing->getX(pIndex);
+    vertex[1] = ogrRing->getY(pIndex);
 
     if (DataNodeType::Dimension > 2)
     {
@@ -122,7 +117,7 @@ void OGRIOHelper::ConvertGeometryToPolygonNode(const OGRGeometry* ogrGeometry, D
       {
         itkGenericExceptionMacro(<< "OTB vector data can't contain the OGR information (2D instead of 2.5D)");
       }
-      vertex[2] = ogrTmpPoint->getZ();
+      vertex[2] = ogrRing->getZ(pIndex);
     }
 
     extRing->AddVertex(vertex);
@@ -136,26 +131,23 @@ void OGRIOHelper::ConvertGeometryToPolygonNode(const OGRGeometry* ogrGeometry, D
     ogrRing                 = ogrPolygon->getInteriorRing(intRingIndex);
     for (int pIndex = 0; pIndex < ogrRing->getNumPoints(); ++pIndex)
     {
-      ogrRing->getPoint(pIndex, ogrTmpPoint);
       PolygonType::VertexType vertex;
 
-      vertex[0] = ogrTmpPoint->getX();
-      vertex[1] = ogrTmpPoint->getY();
+      vertex[0] = ogrRing->getX(pIndex);
+      vertex[1] = ogrRing->getY(pIndex);
       if (DataNodeType::Dimension > 2)
       {
         if (PolygonType::VertexType::PointDimension != 3)
         {
           itkGenericExceptionMacro(<< "OTB vector data can't contain the OGR information (2D instead of 2.5D)");
         }
-        vertex[2] = ogrTmpPoint->getZ();
+        vertex[2] = ogrRing->getZ(pIndex);
       }
       ring->AddVertex(vertex);
     }
     intRings->PushBack(ring);
   }
 
-  OGRGeometryFactory::destroyGeometry(ogrTmpPoint);
-
   node->SetPolygonExteriorRing(extRing);
   node->SetPolygonInteriorRings(intRings);
 }
@@ -192,6 +184,14 @@ void OGRIOHelper::ConvertOGRLayerToDataTreeNode(OGRLayer* layer, InternalTreeNod
   unsigned int   counter = 0;
   otb::Stopwatch chrono  = otb::Stopwatch::StartNew();
 
+  // The field definitions are shared by the keyword lists of all the features
+  OGRFeatureDefn*                            layerDefn = layer->GetLayerDefn();
+  std::vector<std::shared_ptr<OGRFieldDefn>> fieldDefns;
+  for (int fieldNum = 0; fieldNum < layerDefn->GetFieldCount(); ++fieldNum)
+  {
+    fieldDefns.push_back(std::make_shared<OGRFieldDefn>(layerDefn->GetFieldDefn(fieldNum)));
+  }
+
   while ((feature = layer->GetNextFeature()) != nullptr)
   {
 
@@ -213,7 +213,7 @@ void OGRIOHelper::ConvertOGRLayerToDataTreeNode(OGRLayer* layer, InternalTreeNod
     {
       if (ogr::IsFieldSetAndNotNull(feature, fieldNum))
       {
-        kwl.AddField(feature->GetFieldDefnRef(fieldNum), feature->GetRawFieldRef(fieldNum));
+        kwl.AddField(fieldDefns[fieldNum], feature->GetRawFieldRef(fieldNum));
       }
     }
 
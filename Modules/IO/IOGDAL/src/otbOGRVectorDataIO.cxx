@@ -30,6 +30,8 @@
 #include "otbStopwatch.h"
 #include "otbOGRIOHelper.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -138,6 +140,11 @@ void OGRVectorDataIO::Read(itk::DataObject* datag)
   {
     /** retrieving layer and property */
     OGRLayer* layer = m_DataSource->GetLayer(layerIndex);
+    if (m_UseSpatialFilter)
+    {
+      layer->SetSpatialFilterRect(std::min(m_SpatialFilterLower[0], m_SpatialFilterUpper[0]), std::min(m_SpatialFilterLower[1], m_SpatialFilterUpper[1]),
+                                  std::max(m_SpatialFilterLower[0], m_SpatialFilterUpper[0]), std::max(m_SpatialFilterLower[1], m_SpatialFilterUpper[1]));
+    }
     otbMsgDevMacro(<< "Number of features: " << layer->GetFeatureCount());
 
     OGRFeatureDefn* dfn = layer->GetLayerDefn();
@@ -0,0 +1,163 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbGDALStreamedOverviews.h"
+#include "otbGDALDriverManagerWrapper.h"
+
+#include "gdal_priv.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+#include <vector>
+
+// Write an image by irregular regions, in an order unrelated to the scan
+// order, and compare each overview level to the average of the previous one
+int otbGDALStreamedOverviews(int itkNotUsed(argc), char* argv[])
+{
+  const int          sizeX    = 37;
+  const int          sizeY    = 29;
+  const int          nbBands  = 2;
+  const double       noData   = 255.;
+  const unsigned int nbLevels = otb::GDALStreamedOverviews::ComputeNumberOfLevels(sizeX, sizeY, 4);
+
+  if (nbLevels != 4)
+  {
+    std::cerr << "Got " << nbLevels << " levels, expected 4" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string driverName = "GTiff";
+  auto        wrapper    = otb::GDALDriverManagerWrapper::GetInstance().Create(driverName, argv[1], sizeX, sizeY, nbBands, GDT_Byte, nullptr);
+  if (wrapper.IsNull())
+  {
+    std::cerr << "Unable to create " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+  GDALDataset* dataset = wrapper->GetDataSet();
+  for (int band = 1; band <= nbBands; ++band)
+  {
+    dataset->GetRasterBand(band)->SetNoDataValue(noData);
+  }
+
+  std::vector<unsigned char> image(sizeX * sizeY * nbBands);
+  for (std::size_t i = 0; i < image.size(); ++i)
+  {
+    image[i] = static_cast<unsigned char>((i * 7919) % 256);
+  }
+
+  otb::GDALStreamedOverviews overviews(dataset, nbLevels);
+
+  const int splitX[] = {0, 5, 18, sizeX};
+  const int splitY[] = {0, 3, 11, 12, sizeY};
+  for (int tileY = 3; tileY >= 0; --tileY)
+  {
+    for (int tileX = 0; tileX < 3; ++tileX)
+    {
+      const int x = splitX[tileX];
+      const int y = splitY[tileY];
+      const int w = splitX[tileX + 1] - x;
+      const int h = splitY[tileY + 1] - y;
+
+      std::vector<unsigned char> region(w * h * nbBands);
+      for (int row = 0; row < h; ++row)
+      {
+        std::copy_n(image.begin() + ((y + row) * sizeX + x) * nbBands, w * nbBands, region.begin() + row * w * nbBands);
+      }
+      dataset->RasterIO(GF_Write, x, y, w, h, region.data(), w, h, GDT_Byte, nbBands, nullptr, nbBands, nbBands * w, 1);
+      overviews.AddRegion(region.data(), GDT_Byte, x, y, w, h);
+    }
+  }
+
+  if (overviews.GetNumberOfPendingPixels() != 0)
+  {
+    std::cerr << overviews.GetNumberOfPendingPixels() << " overview pixels have not been written" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  int nbErrors = 0;
+  for (int band = 0; band < nbBands; ++band)
+  {
+    int                 levelX = sizeX;
+    int                 levelY = sizeY;
+    std::vector<double> level(sizeX * sizeY);
+    for (int i = 0; i < sizeX * sizeY; ++i)
+    {
+      level[i] = image[i * nbBands + band];
+    }
+
+    for (unsigned int l = 0; l < nbLevels; ++l)
+    {
+      const int           nextX = (levelX + 1) / 2;
+      const int           nextY = (levelY + 1) / 2;
+      std::vector<double> next(nextX * nextY);
+      for (int j = 0; j < nextY; ++j)
+      {
+        for (int i = 0; i < nextX; ++i)
+        {
+          double sum   = 0.;
+          int    count = 0;
+          for (int y = 2 * j; y < std::min(2 * j + 2, levelY); ++y)
+          {
+            for (int x = 2 * i; x < std::min(2 * i + 2, levelX); ++x)
+            {
+              if (level[y * levelX + x] != noData)
+              {
+                sum += level[y * levelX + x];
+                ++count;
+              }
+            }
+          }
+          next[j * nextX + i] = count > 0 ? sum / count : noData;
+        }
+      }
+
+      GDALRasterBand* overview = dataset->GetRasterBand(band + 1)->GetOverview(l);
+      if (overview == nullptr || overview->GetXSize() != nextX || overview->GetYSize() != nextY)
+      {
+        std::cerr << "Unexpected overview " << l << " of band " << band + 1 << std::endl;
+        return EXIT_FAILURE;
+      }
+
+      // Levels are averaged in double precision, then rounded when stored
+      std::vector<unsigned char> written(nextX * nextY);
+      overview->RasterIO(GF_Read, 0, 0, nextX, nextY, written.data(), nextX, nextY, GDT_Byte, 0, 0, nullptr);
+      for (int i = 0; i < nextX * nextY; ++i)
+      {
+        if (std::abs(written[i] - std::round(next[i])) > 1)
+        {
+          ++nbErrors;
+        }
+      }
+
+      level.swap(next);
+      levelX = nextX;
+      levelY = nextY;
+    }
+  }
+
+  if (nbErrors != 0)
+  {
+    std::cerr << nbErrors << " overview pixels differ from the expected average" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -26,6 +26,7 @@ void RegisterTests()
   REGISTER_TEST(otbGDALImageIOTest_uint16);
   REGISTER_TEST(otbGDALImageIOTestWriteMetadata);
   REGISTER_TEST(otbGDALOverviewsBuilder);
+  REGISTER_TEST(otbGDALStreamedOverviews);
   REGISTER_TEST(otbGDALImageIOTestCanWrite);
   REGISTER_TEST(otbOGRVectorDataIOCanWrite);
   REGISTER_TEST(otbGDALReadPxlComplexFloat);
@@ -22,6 +22,7 @@
 #define otbLUMImageIO_h
 
 #include "otbImageIOBase.h"
+#include "otbMappedFile.h"
 #include <string>
 #include <vector>
 #include <fstream>
@@ -187,6 +188,7 @@ private:
   std::string                 m_TypeLum;   // used for write
   otb::ImageIOBase::ByteOrder m_FileByteOrder;
   std::fstream                m_File;
+  MappedFile                  m_MappedFile;
 };
 
 } // end namespace otb
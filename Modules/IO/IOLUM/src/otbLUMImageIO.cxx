@@ -146,6 +146,27 @@ void LUMImageIO::Read(void* buffer)
   std::streamsize numberOfBytesToBeRead = static_cast<std::streamsize>(this->GetComponentSize() * lNbColumns);
   std::streamsize numberOfBytesRead;
   std::streamsize cpt = 0;
+
+  // Fast path: copy the lines straight from the mapped file, swapping the
+  // bytes on the fly
+  if (m_MappedFile.IsOpen())
+  {
+    const std::streamoff regionBegin = headerLength + numberOfBytesPerLines * lFirstLine + this->GetComponentSize() * lFirstColumn;
+    const std::streamoff regionEnd   = regionBegin + numberOfBytesPerLines * (lNbLines - 1) + numberOfBytesToBeRead;
+    if (regionEnd > static_cast<std::streamoff>(m_MappedFile.GetSize()))
+    {
+      itkExceptionMacro(<< "LUMImageIO::Read() Can Read the specified Region"); // read failed
+    }
+    m_MappedFile.WillNeed(regionBegin, regionEnd - regionBegin);
+    for (int LineNo = 0; LineNo < lNbLines; LineNo++)
+    {
+      MappedFile::CopyComponents(m_MappedFile.GetData() + regionBegin + numberOfBytesPerLines * LineNo, lNbColumns, this->GetComponentSize(), p + cpt,
+                                 this->GetComponentSize(), m_ByteOrder != m_FileByteOrder);
+      cpt += numberOfBytesToBeRead;
+    }
+    return;
+  }
+
   for (int LineNo = lFirstLine; LineNo < lFirstLine + lNbLines; LineNo++)
   {
     offset = headerLength + numberOfBytesPerLines * static_cast<std::streamoff>(LineNo);
@@ -198,6 +219,9 @@ void LUMImageIO::ReadImageInformation()
   // Read header information
   InternalReadHeaderInformation(m_File, true);
 
+  // Read() falls back to the stream if the file can not be mapped
+  m_MappedFile.Open(m_FileName);
+
   otbMsgDebugMacro(<< "Driver to read: LUM");
   otbMsgDebugMacro(<< "         Read  file         : " << m_FileName);
   otbMsgDebugMacro(<< "         Size               : " << m_Dimensions[0] << "," << m_Dimensions[1]);
@@ -391,6 +415,7 @@ void LUMImageIO::WriteImageInformation()
 
   // Open the new file for writing
   // Actually open the file
+  m_MappedFile.Close();
   m_File.open(m_FileName, std::ios::out | std::ios::trunc | std::ios::binary);
   if (m_File.fail())
   {
@@ -0,0 +1,130 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageFileCubeReader_h
+#define otbImageFileCubeReader_h
+
+#include "itkImageSource.h"
+#include "otbGDALDataCube.h"
+
+#include <memory>
+#include <string>
+
+namespace otb
+{
+
+/** \class ImageFileCubeReader
+ * \brief Read a chunked (time, band, y, x) data cube as a single
+ * multi-band image
+ *
+ * The data cube is an array of a Zarr or netCDF-4 file accessed through
+ * GDALDataCube. The components of the output pixels are the bands of
+ * each date, date after date, so that the time series of a pixel is
+ * contiguous. Each requested region is read straight into the output
+ * buffer by strided reads of the array, the chunk rows being
+ * decompressed concurrently.
+ *
+ * The chunk size of the array is published as the tile hint of the
+ * output, so that the streaming managers aligned on blocks (see
+ * BlockAlignedStreamingManager) request whole chunks.
+ *
+ * The origin and spacing come from the coordinates of the x and y
+ * dimensions when they are regularly spaced, and the no-data value of
+ * the array is set on all the bands.
+ *
+ * \sa GDALDataCube
+ * \sa ImageFileCubeWriter
+ *
+ * \ingroup OTBImageIO
+ */
+template <class TOutputImage>
+class ITK_EXPORT ImageFileCubeReader : public itk::ImageSource<TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageFileCubeReader            Self;
+  typedef itk::ImageSource<TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>        Pointer;
+  typedef itk::SmartPointer<const Self>  ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageFileCubeReader, itk::ImageSource);
+
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::InternalPixelType InternalPixelType;
+  typedef typename OutputImageType::RegionType        RegionType;
+
+  /** Set the file holding the data cube */
+  void SetFileName(const std::string& fileName);
+  itkGetStringMacro(FileName);
+
+  /** Set the name of the array to read, by default the first array of
+   * at least 2 dimensions */
+  void SetArrayName(const std::string& arrayName);
+  itkGetStringMacro(ArrayName);
+
+  /** Number of dates of the cube, available after
+   * UpdateOutputInformation() */
+  unsigned int GetNumberOfTimes() const
+  {
+    return m_Cube ? m_Cube->GetNumberOfTimes() : 0;
+  }
+
+  /** Number of bands per date, available after
+   * UpdateOutputInformation() */
+  unsigned int GetNumberOfBands() const
+  {
+    return m_Cube ? m_Cube->GetNumberOfBands() : 0;
+  }
+
+protected:
+  ImageFileCubeReader()
+  {
+  }
+  ~ImageFileCubeReader() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void GenerateData() override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ImageFileCubeReader(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  std::string m_FileName;
+  std::string m_ArrayName;
+
+  std::unique_ptr<GDALDataCube> m_Cube;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbImageFileCubeReader.hxx"
+#endif
+
+#endif
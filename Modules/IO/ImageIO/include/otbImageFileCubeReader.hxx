@@ -0,0 +1,145 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageFileCubeReader_hxx
+#define otbImageFileCubeReader_hxx
+
+#include "otbImageFileCubeReader.h"
+#include "otbGdalDataTypeBridge.h"
+#include "otbMetaDataKey.h"
+#include "itkMetaDataObject.h"
+
+namespace otb
+{
+
+template <class TOutputImage>
+void ImageFileCubeReader<TOutputImage>::SetFileName(const std::string& fileName)
+{
+  if (fileName != m_FileName)
+  {
+    m_FileName = fileName;
+    m_Cube.reset();
+    this->Modified();
+  }
+}
+
+template <class TOutputImage>
+void ImageFileCubeReader<TOutputImage>::SetArrayName(const std::string& arrayName)
+{
+  if (arrayName != m_ArrayName)
+  {
+    m_ArrayName = arrayName;
+    m_Cube.reset();
+    this->Modified();
+  }
+}
+
+template <class TOutputImage>
+void ImageFileCubeReader<TOutputImage>::GenerateOutputInformation()
+{
+  if (!m_Cube)
+  {
+    m_Cube.reset(new GDALDataCube(m_FileName, m_ArrayName));
+  }
+
+  const GDALDataType type = GdalDataTypeBridge::GetGDALDataType<InternalPixelType>();
+  if (static_cast<size_t>(GDALGetDataTypeSizeBytes(type)) != sizeof(InternalPixelType))
+  {
+    itkExceptionMacro(<< "Pixel type " << typeid(InternalPixelType).name() << " has no GDAL equivalent");
+  }
+
+  OutputImageType* output = this->GetOutput();
+
+  RegionType region;
+  region.SetSize(0, m_Cube->GetWidth());
+  region.SetSize(1, m_Cube->GetHeight());
+  output->SetLargestPossibleRegion(region);
+
+  // Without coordinates, pixel centers are at half-integer positions
+  double origin[2];
+  double spacing[2];
+  if (!m_Cube->GetGeoTransform(origin, spacing))
+  {
+    origin[0]  = 0.5;
+    origin[1]  = 0.5;
+    spacing[0] = 1.0;
+    spacing[1] = 1.0;
+  }
+  typename OutputImageType::PointType   outputOrigin;
+  typename OutputImageType::SpacingType outputSpacing;
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    outputOrigin[i]  = origin[i];
+    outputSpacing[i] = spacing[i];
+  }
+  output->SetOrigin(outputOrigin);
+  output->SetSignedSpacing(outputSpacing);
+  output->SetNumberOfComponentsPerPixel(m_Cube->GetNumberOfComponents());
+
+  ImageMetadata imd;
+  const std::string projection = m_Cube->GetProjectionRef();
+  if (!projection.empty())
+  {
+    imd.Add(MDGeom::ProjectionWKT, projection);
+  }
+
+  // Align the streaming on the chunks
+  itk::EncapsulateMetaData<unsigned int>(output->GetMetaDataDictionary(), MetaDataKey::TileHintX, m_Cube->GetChunkWidth());
+  itk::EncapsulateMetaData<unsigned int>(output->GetMetaDataDictionary(), MetaDataKey::TileHintY, m_Cube->GetChunkHeight());
+  imd.Add(MDNum::TileHintX, m_Cube->GetChunkWidth());
+  imd.Add(MDNum::TileHintY, m_Cube->GetChunkHeight());
+
+  imd.Bands.resize(m_Cube->GetNumberOfComponents());
+  double noData = 0.0;
+  if (m_Cube->GetNoDataValue(noData))
+  {
+    for (auto& band : imd.Bands)
+    {
+      band.Add(MDNum::NoData, noData);
+    }
+  }
+  output->SetImageMetadata(imd);
+}
+
+template <class TOutputImage>
+void ImageFileCubeReader<TOutputImage>::GenerateData()
+{
+  OutputImageType* output = this->GetOutput();
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->Allocate();
+
+  const RegionType region        = output->GetRequestedRegion();
+  const RegionType largestRegion = output->GetLargestPossibleRegion();
+
+  m_Cube->Read(output->GetBufferPointer(), GdalDataTypeBridge::GetGDALDataType<InternalPixelType>(), region.GetIndex(0) - largestRegion.GetIndex(0),
+               region.GetIndex(1) - largestRegion.GetIndex(1), region.GetSize(0), region.GetSize(1), this->GetNumberOfThreads());
+}
+
+template <class TOutputImage>
+void ImageFileCubeReader<TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "ArrayName: " << m_ArrayName << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageFileCubeWriter_h
+#define otbImageFileCubeWriter_h
+
+#include "itkProcessObject.h"
+
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class ImageFileCubeWriter
+ * \brief Write a multi-band image as a chunked (time, band, y, x) data
+ * cube
+ *
+ * The components of the input pixels are the bands of each date, date
+ * after date, NumberOfBands being the number of bands per date. The cube
+ * is created through GDALDataCube with the given GDAL driver ("Zarr" by
+ * default, or "netCDF"), chunked by ChunkSize pixels in x and y and by
+ * one date and one band. Array creation options of the driver, such as
+ * "COMPRESS=ZSTD" for Zarr, can be added.
+ *
+ * The input is streamed by divisions whose borders fall on the chunk
+ * borders (see BlockAlignedStreamingManager), each division being
+ * written by a single strided write, so that each chunk is encoded
+ * once.
+ *
+ * The origin, spacing and projection of the input are stored as the
+ * coordinates of the x and y dimensions and the spatial reference of the
+ * array, and the no-data value of the first band as the no-data value of
+ * the array.
+ *
+ * \sa GDALDataCube
+ * \sa ImageFileCubeReader
+ *
+ * \ingroup OTBImageIO
+ */
+template <class TInputImage>
+class ITK_EXPORT ImageFileCubeWriter : public itk::ProcessObject
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageFileCubeWriter           Self;
+  typedef itk::ProcessObject            Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageFileCubeWriter, itk::ProcessObject);
+
+  typedef TInputImage                                InputImageType;
+  typedef typename InputImageType::InternalPixelType InternalPixelType;
+  typedef typename InputImageType::RegionType        RegionType;
+  typedef typename RegionType::SizeType              SizeType;
+  typedef std::vector<std::string>                   CreationOptionsType;
+
+  using Superclass::SetInput;
+  virtual void SetInput(const InputImageType* input);
+  const InputImageType* GetInput();
+
+  /** The file to create */
+  itkSetStringMacro(FileName);
+  itkGetStringMacro(FileName);
+
+  /** GDAL driver supporting the multidimensional API, "Zarr" by default */
+  itkSetStringMacro(DriverName);
+  itkGetStringMacro(DriverName);
+
+  /** Name of the array, "data" by default */
+  itkSetStringMacro(ArrayName);
+  itkGetStringMacro(ArrayName);
+
+  /** Number of bands per date, the number of components of the input
+   * being a multiple of it (1 by default) */
+  itkSetMacro(NumberOfBands, unsigned int);
+  itkGetConstMacro(NumberOfBands, unsigned int);
+
+  /** Size of the chunks in x and y (256 x 256 by default) */
+  itkSetMacro(ChunkSize, SizeType);
+  itkGetConstReferenceMacro(ChunkSize, SizeType);
+
+  /** Array creation options of the driver, as "KEY=VALUE" strings */
+  void SetCreationOptions(const CreationOptionsType& options)
+  {
+    m_CreationOptions = options;
+    this->Modified();
+  }
+
+  const CreationOptionsType& GetCreationOptions() const
+  {
+    return m_CreationOptions;
+  }
+
+  /** The number of Megabytes available for streaming (if 0, the
+   * configuration option is used) */
+  itkSetMacro(AvailableRAMInMB, unsigned int);
+  itkGetConstMacro(AvailableRAMInMB, unsigned int);
+
+  /** Stream the input and write it to the cube */
+  void Update() override;
+
+protected:
+  ImageFileCubeWriter();
+  ~ImageFileCubeWriter() override
+  {
+  }
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ImageFileCubeWriter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  std::string         m_FileName;
+  std::string         m_DriverName;
+  std::string         m_ArrayName;
+  unsigned int        m_NumberOfBands;
+  SizeType            m_ChunkSize;
+  CreationOptionsType m_CreationOptions;
+  unsigned int        m_AvailableRAMInMB;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbImageFileCubeWriter.hxx"
+#endif
+
+#endif
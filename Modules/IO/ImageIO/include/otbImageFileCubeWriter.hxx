@@ -0,0 +1,173 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageFileCubeWriter_hxx
+#define otbImageFileCubeWriter_hxx
+
+#include "otbImageFileCubeWriter.h"
+#include "otbGDALDataCube.h"
+#include "otbGdalDataTypeBridge.h"
+#include "otbBlockAlignedStreamingManager.h"
+
+namespace otb
+{
+
+template <class TInputImage>
+ImageFileCubeWriter<TInputImage>::ImageFileCubeWriter() : m_DriverName("Zarr"), m_ArrayName("data"), m_NumberOfBands(1), m_AvailableRAMInMB(0)
+{
+  this->SetNumberOfRequiredInputs(1);
+  m_ChunkSize.Fill(256);
+}
+
+template <class TInputImage>
+void ImageFileCubeWriter<TInputImage>::SetInput(const InputImageType* input)
+{
+  this->ProcessObject::SetNthInput(0, const_cast<InputImageType*>(input));
+}
+
+template <class TInputImage>
+const TInputImage* ImageFileCubeWriter<TInputImage>::GetInput()
+{
+  if (this->GetNumberOfInputs() < 1)
+  {
+    return nullptr;
+  }
+
+  return static_cast<const InputImageType*>(this->ProcessObject::GetInput(0));
+}
+
+template <class TInputImage>
+void ImageFileCubeWriter<TInputImage>::Update()
+{
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (input == nullptr)
+  {
+    itkExceptionMacro(<< "No input to writer");
+  }
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro(<< "No filename was specified");
+  }
+
+  const GDALDataType type = GdalDataTypeBridge::GetGDALDataType<InternalPixelType>();
+  if (static_cast<size_t>(GDALGetDataTypeSizeBytes(type)) != sizeof(InternalPixelType))
+  {
+    itkExceptionMacro(<< "Pixel type " << typeid(InternalPixelType).name() << " has no GDAL equivalent");
+  }
+
+  input->UpdateOutputInformation();
+
+  const unsigned int nbComponents = input->GetNumberOfComponentsPerPixel();
+  if (m_NumberOfBands == 0 || nbComponents % m_NumberOfBands != 0)
+  {
+    itkExceptionMacro(<< "The " << nbComponents << " components of the input cannot be split in dates of " << m_NumberOfBands << " bands");
+  }
+
+  const RegionType largestRegion = input->GetLargestPossibleRegion();
+  GDALDataCube     cube(m_FileName, m_DriverName, m_ArrayName, largestRegion.GetSize(0), largestRegion.GetSize(1), nbComponents / m_NumberOfBands,
+                    m_NumberOfBands, type, m_ChunkSize[0], m_ChunkSize[1], m_CreationOptions);
+
+  double origin[2];
+  double spacing[2];
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    origin[i]  = input->GetOrigin()[i];
+    spacing[i] = input->GetSignedSpacing()[i];
+  }
+  cube.SetGeoTransform(origin, spacing);
+  cube.SetProjectionRef(input->GetProjectionRef());
+
+  const ImageMetadata& imd = input->GetImageMetadata();
+  if (!imd.Bands.empty() && imd.Bands[0].Has(MDNum::NoData))
+  {
+    cube.SetNoDataValue(imd.Bands[0][MDNum::NoData]);
+  }
+
+  // Stream by whole chunks of the cube
+  typedef BlockAlignedStreamingManager<InputImageType> StreamingManagerType;
+  typename StreamingManagerType::Pointer streamingManager = StreamingManagerType::New();
+  SizeType                               chunkSize;
+  chunkSize[0] = cube.GetChunkWidth();
+  chunkSize[1] = cube.GetChunkHeight();
+  streamingManager->SetAvailableRAMInMB(m_AvailableRAMInMB);
+  streamingManager->SetBlockSize(chunkSize);
+  streamingManager->PrepareStreaming(input, largestRegion);
+  const unsigned int nbDivisions = streamingManager->GetNumberOfSplits();
+
+  this->SetAbortGenerateData(0);
+  this->InvokeEvent(itk::StartEvent());
+  this->UpdateProgress(0);
+
+  for (unsigned int division = 0; division < nbDivisions && !this->GetAbortGenerateData(); ++division)
+  {
+    const RegionType region = streamingManager->GetSplit(division);
+    input->SetRequestedRegion(region);
+    input->PropagateRequestedRegion();
+    input->UpdateOutputData();
+
+    const int x = region.GetIndex(0) - largestRegion.GetIndex(0);
+    const int y = region.GetIndex(1) - largestRegion.GetIndex(1);
+    if (input->GetBufferedRegion() == region)
+    {
+      cube.Write(input->GetBufferPointer(), type, x, y, region.GetSize(0), region.GetSize(1));
+    }
+    else
+    {
+      // The buffer is larger than the division: write its rows one by one
+      typename RegionType::IndexType index = region.GetIndex();
+      for (unsigned int row = 0; row < region.GetSize(1); ++row, ++index[1])
+      {
+        cube.Write(input->GetBufferPointer() + input->ComputeOffset(index) * nbComponents, type, x, y + row, region.GetSize(0), 1);
+      }
+    }
+
+    this->UpdateProgress(static_cast<float>(division + 1) / nbDivisions);
+  }
+
+  if (this->GetAbortGenerateData())
+  {
+    itk::ProcessAborted e(__FILE__, __LINE__);
+    e.SetLocation(ITK_LOCATION);
+    e.SetDescription("Data cube writing has been aborted");
+    throw e;
+  }
+
+  this->InvokeEvent(itk::EndEvent());
+}
+
+template <class TInputImage>
+void ImageFileCubeWriter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "DriverName: " << m_DriverName << std::endl;
+  os << indent << "ArrayName: " << m_ArrayName << std::endl;
+  os << indent << "NumberOfBands: " << m_NumberOfBands << std::endl;
+  os << indent << "ChunkSize: " << m_ChunkSize << std::endl;
+  for (const auto& option : m_CreationOptions)
+  {
+    os << indent << "CreationOption: " << option << std::endl;
+  }
+  os << indent << "AvailableRAMInMB: " << m_AvailableRAMInMB << std::endl;
+}
+
+} // end namespace otb
+
+#endif
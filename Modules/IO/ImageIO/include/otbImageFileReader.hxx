@@ -39,8 +39,11 @@
 #include "otbMetaDataKey.h"
 #include "otbImageMetadata.h"
 #include "otbImageMetadataInterfaceFactory.h"
+#include "otbImageMetadataCache.h"
 #include "otbImageCommons.h"
 #include "otbGeomMetadataSupplier.h"
+#include "otbGDALImageIO.h"
+#include "otbNoDataRegion.h"
 
 #include "otbMacro.h"
 
@@ -181,12 +184,17 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::IOPixelType> ConvertIOPixelTraits;
   typedef otb::DefaultConvertPixelTraits<typename TOutputImage::PixelType>   ConvertOutputPixelTraits;
 
-  if (this->m_ImageIO->GetComponentTypeInfo() == typeid(typename ConvertOutputPixelTraits::ComponentType) &&
-      (this->m_ImageIO->GetNumberOfComponents() == ConvertIOPixelTraits::GetNumberOfComponents()) && !m_FilenameHelper->BandRangeIsSet())
+  // ImageIO buffers are pixel interleaved, which is also the VectorImage
+  // layout: if the component type and count match, no conversion is needed
+  const bool sameComponentType = (this->m_ImageIO->GetComponentTypeInfo() == typeid(typename ConvertOutputPixelTraits::ComponentType));
+  const bool sameVectorLayout  = (strcmp(output->GetNameOfClass(), "VectorImage") == 0) &&
+                                (this->m_ImageIO->GetNumberOfComponents() == output->GetNumberOfComponentsPerPixel());
+
+  if (sameComponentType && ((this->m_ImageIO->GetNumberOfComponents() == ConvertIOPixelTraits::GetNumberOfComponents()) || sameVectorLayout) &&
+      !m_FilenameHelper->BandRangeIsSet())
   {
     // Have the ImageIO read directly into the allocated buffer
     this->m_ImageIO->Read(buffer);
-    return;
   }
   else // a type conversion is necessary
   {
@@ -210,6 +218,16 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateData()
 
     delete[] loadBuffer;
   }
+
+  // Let the downstream filters skip the regions without valid pixels.
+  // Empty regions of sparse files read as the no-data value of the bands
+  GDALImageIO* gdalImageIO = dynamic_cast<GDALImageIO*>(this->m_ImageIO.GetPointer());
+  bool         isNoData    = false;
+  if (output->GetImageMetadata().HasBandMetadata(MDNum::NoData))
+  {
+    isNoData = (gdalImageIO != nullptr && gdalImageIO->GetIORegionIsEmpty()) || BufferHoldsOnlyNoData(output.GetPointer());
+  }
+  SetBufferedRegionIsNoData(output.GetPointer(), isNoData);
 }
 
 template <class TOutputImage, class ConvertPixelTraits>
@@ -274,6 +292,62 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformatio
 
   this->m_ImageIO->SetOutputImagePixelType(PixelIsComplex(dummy), lVectorImage);
 
+  // Enable read-ahead of streaming regions if requested
+  if (m_FilenameHelper->PrefetchIsSet())
+  {
+    GDALImageIO* gdalImageIO = dynamic_cast<GDALImageIO*>(this->m_ImageIO.GetPointer());
+    if (gdalImageIO != nullptr)
+    {
+      gdalImageIO->SetPrefetch(m_FilenameHelper->GetPrefetch());
+    }
+    else
+    {
+      otbLogMacro(Warning, << "Prefetch is only supported by GDALImageIO, option will be ignored for " << this->m_FileName);
+    }
+  }
+
+  // Set the resampling method of reads at a coarser resolution
+  if (m_FilenameHelper->ResamplingMethodIsSet())
+  {
+    GDALImageIO* gdalImageIO = dynamic_cast<GDALImageIO*>(this->m_ImageIO.GetPointer());
+    if (gdalImageIO != nullptr)
+    {
+      gdalImageIO->SetResamplingMethod(m_FilenameHelper->GetResamplingMethod());
+    }
+    else
+    {
+      otbLogMacro(Warning, << "Resampling method is only supported by GDALImageIO, option will be ignored for " << this->m_FileName);
+    }
+  }
+
+  // Read each region with several threads if requested
+  if (m_FilenameHelper->ReadThreadsIsSet())
+  {
+    GDALImageIO* gdalImageIO = dynamic_cast<GDALImageIO*>(this->m_ImageIO.GetPointer());
+    if (gdalImageIO != nullptr)
+    {
+      gdalImageIO->SetNumberOfReadThreads(m_FilenameHelper->GetReadThreads());
+    }
+    else
+    {
+      otbLogMacro(Warning, << "Parallel reads are only supported by GDALImageIO, option will be ignored for " << this->m_FileName);
+    }
+  }
+
+  // Announce the reads of the upcoming regions if requested
+  if (m_FilenameHelper->ReadAheadIsSet())
+  {
+    GDALImageIO* gdalImageIO = dynamic_cast<GDALImageIO*>(this->m_ImageIO.GetPointer());
+    if (gdalImageIO != nullptr)
+    {
+      gdalImageIO->SetNumberOfReadAheadRegions(m_FilenameHelper->GetReadAhead());
+    }
+    else
+    {
+      otbLogMacro(Warning, << "Read-ahead is only supported by GDALImageIO, option will be ignored for " << this->m_FileName);
+    }
+  }
+
   // Pass the dataset number (used for hdf files for example)
   if (m_FilenameHelper->SubDatasetIndexIsSet())
   {
@@ -481,29 +555,44 @@ void ImageFileReader<TOutputImage, ConvertPixelTraits>::GenerateOutputInformatio
   std::string DerivatedFileName = GetDerivedDatasetSourceFileName(m_FileName);
   std::string extension                 = itksys::SystemTools::GetFilenameLastExtension(DerivatedFileName);
   std::string attachedGeom              = DerivatedFileName.substr(0, DerivatedFileName.size() - extension.size()) + std::string(".geom");
+  // Products parsed by a previous reader are taken from the cache
+  ImageMetadataCache&      metadataCache = ImageMetadataCache::GetInstance();
+  const std::string        cacheKey      = m_FilenameHelper->GetExtendedFileName();
+  std::vector<std::string> parsedFiles(1, DerivatedFileName);
   // Case 1: external geom supplied through extended filename
   if (!m_FilenameHelper->GetSkipGeom() && m_FilenameHelper->ExtGEOMFileNameIsSet())
   {
-    GeomMetadataSupplier geomSupplier(m_FilenameHelper->GetExtGEOMFileName(), m_FileName);
-    ImageMetadataInterfaceFactory::CreateIMI(imd, geomSupplier);
-    geomSupplier.FetchRPC(imd);
-    geomSupplier.FetchGCP(imd);
+    parsedFiles.push_back(m_FilenameHelper->GetExtGEOMFileName());
+    if (!metadataCache.Get(cacheKey, parsedFiles, imd))
+    {
+      GeomMetadataSupplier geomSupplier(m_FilenameHelper->GetExtGEOMFileName(), m_FileName);
+      ImageMetadataInterfaceFactory::CreateIMI(imd, geomSupplier);
+      geomSupplier.FetchRPC(imd);
+      geomSupplier.FetchGCP(imd);
+      metadataCache.Set(cacheKey, parsedFiles, imd);
+    }
   }
   // Case 2: attached geom (if present)
   else if (!m_FilenameHelper->GetSkipGeom() && itksys::SystemTools::FileExists(attachedGeom))
   {
-    GeomMetadataSupplier geomSupplier(attachedGeom, m_FileName);
-    ImageMetadataInterfaceFactory::CreateIMI(imd, geomSupplier);
-    geomSupplier.FetchRPC(imd);
-    geomSupplier.FetchGCP(imd);
+    parsedFiles.push_back(attachedGeom);
+    if (!metadataCache.Get(cacheKey, parsedFiles, imd))
+    {
+      GeomMetadataSupplier geomSupplier(attachedGeom, m_FileName);
+      ImageMetadataInterfaceFactory::CreateIMI(imd, geomSupplier);
+      geomSupplier.FetchRPC(imd);
+      geomSupplier.FetchGCP(imd);
+      metadataCache.Set(cacheKey, parsedFiles, imd);
+    }
   }
   // Case 3: tags in file
   else
   {
     auto gdalMetadataSupplierPointer = dynamic_cast<MetadataSupplierInterface*>(m_ImageIO.GetPointer());
-    if (gdalMetadataSupplierPointer)
+    if (gdalMetadataSupplierPointer && !metadataCache.Get(cacheKey, parsedFiles, imd))
     {
       ImageMetadataInterfaceFactory::CreateIMI(imd, *gdalMetadataSupplierPointer);
+      metadataCache.Set(cacheKey, parsedFiles, imd);
     }
   }
 
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageFileStackReader_h
+#define otbImageFileStackReader_h
+
+#include "itkImageSource.h"
+#include "otbGDALImageStack.h"
+
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class ImageFileStackReader
+ * \brief Read several images of the same size as a single multi-band image
+ *
+ * The bands of the output are the bands of the images, in the order of
+ * the file names. Each requested region is read by GDALImageStack
+ * straight into the output buffer, the images being read concurrently,
+ * which avoids the per-band extraction and copy of a pipeline made of
+ * one reader per image followed by a concatenation filter.
+ *
+ * The output information and the image metadata are the ones of the
+ * first image, and the band metadata are the ones of all the images.
+ *
+ * With UseVRT on, the images are read through a single in-memory VRT
+ * dataset instead.
+ *
+ * Only the images readable by GDAL are supported, and the pixel type
+ * of the output must have a GDAL equivalent.
+ *
+ * \sa GDALImageStack
+ *
+ * \ingroup OTBImageIO
+ */
+template <class TOutputImage>
+class ITK_EXPORT ImageFileStackReader : public itk::ImageSource<TOutputImage>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ImageFileStackReader           Self;
+  typedef itk::ImageSource<TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>        Pointer;
+  typedef itk::SmartPointer<const Self>  ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(ImageFileStackReader, itk::ImageSource);
+
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::InternalPixelType InternalPixelType;
+  typedef typename OutputImageType::RegionType        RegionType;
+  typedef std::vector<std::string>                    FileNameListType;
+
+  /** Set the images to stack */
+  void SetFileNames(const FileNameListType& fileNames);
+
+  const FileNameListType& GetFileNames() const
+  {
+    return m_FileNames;
+  }
+
+  /** Read the images through an in-memory VRT */
+  itkSetMacro(UseVRT, bool);
+  itkGetConstMacro(UseVRT, bool);
+  itkBooleanMacro(UseVRT);
+
+protected:
+  ImageFileStackReader();
+  ~ImageFileStackReader() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void GenerateData() override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ImageFileStackReader(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  FileNameListType m_FileNames;
+
+  bool m_UseVRT;
+
+  std::unique_ptr<GDALImageStack> m_Stack;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbImageFileStackReader.hxx"
+#endif
+
+#endif
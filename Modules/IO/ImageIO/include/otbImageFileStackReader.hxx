@@ -0,0 +1,111 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageFileStackReader_hxx
+#define otbImageFileStackReader_hxx
+
+#include "otbImageFileStackReader.h"
+#include "otbImageFileReader.h"
+#include "otbGdalDataTypeBridge.h"
+
+namespace otb
+{
+
+template <class TOutputImage>
+ImageFileStackReader<TOutputImage>::ImageFileStackReader() : m_UseVRT(false)
+{
+}
+
+template <class TOutputImage>
+void ImageFileStackReader<TOutputImage>::SetFileNames(const FileNameListType& fileNames)
+{
+  if (fileNames != m_FileNames)
+  {
+    m_FileNames = fileNames;
+    m_Stack.reset();
+    this->Modified();
+  }
+}
+
+template <class TOutputImage>
+void ImageFileStackReader<TOutputImage>::GenerateOutputInformation()
+{
+  m_Stack.reset(new GDALImageStack(m_FileNames, m_UseVRT));
+
+  const GDALDataType type = GdalDataTypeBridge::GetGDALDataType<InternalPixelType>();
+  if (static_cast<size_t>(GDALGetDataTypeSizeBytes(type)) != sizeof(InternalPixelType))
+  {
+    itkExceptionMacro(<< "Pixel type " << typeid(InternalPixelType).name() << " has no GDAL equivalent");
+  }
+
+  OutputImageType* output = this->GetOutput();
+
+  // Take the information of the first image, and the band metadata of
+  // all of them
+  ImageMetadata::ImageMetadataBandsType bands;
+  for (unsigned int image = 0; image < m_Stack->GetNumberOfImages(); ++image)
+  {
+    typedef ImageFileReader<OutputImageType> ReaderType;
+    typename ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName(m_FileNames[image]);
+    reader->UpdateOutputInformation();
+
+    if (image == 0)
+    {
+      output->CopyInformation(reader->GetOutput());
+    }
+
+    auto imageBands = reader->GetOutput()->GetImageMetadata().Bands;
+    imageBands.resize(m_Stack->GetFirstBand(image + 1) - m_Stack->GetFirstBand(image));
+    bands.insert(bands.end(), imageBands.begin(), imageBands.end());
+  }
+
+  output->SetNumberOfComponentsPerPixel(m_Stack->GetNumberOfBands());
+  output->SetBandImageMetadata(bands);
+}
+
+template <class TOutputImage>
+void ImageFileStackReader<TOutputImage>::GenerateData()
+{
+  OutputImageType* output = this->GetOutput();
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->Allocate();
+
+  const RegionType region        = output->GetRequestedRegion();
+  const RegionType largestRegion = output->GetLargestPossibleRegion();
+
+  m_Stack->Read(output->GetBufferPointer(), GdalDataTypeBridge::GetGDALDataType<InternalPixelType>(), region.GetIndex(0) - largestRegion.GetIndex(0),
+                region.GetIndex(1) - largestRegion.GetIndex(1), region.GetSize(0), region.GetSize(1), this->GetNumberOfThreads());
+}
+
+template <class TOutputImage>
+void ImageFileStackReader<TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "UseVRT: " << m_UseVRT << std::endl;
+  for (const auto& fileName : m_FileNames)
+  {
+    os << indent << "FileName: " << fileName << std::endl;
+  }
+}
+
+} // end namespace otb
+
+#endif
@@ -26,8 +26,17 @@
 #include "itkProcessObject.h"
 #include "otbStreamingManager.h"
 #include "otbExtendedFilenameToWriterOptions.h"
+#include "otbStreamingJournal.h"
 #include "itkFastMutexLock.h"
 #include <string>
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
 #include "OTBImageIOExport.h"
 
 namespace otb
@@ -50,6 +59,37 @@ namespace otb
  * ImageFileWriter will write directly the streaming buffer in the image file, so
  * that the output image never needs to be completely allocated
  *
+ * Optionally (see SetWriteQueueDepth()), the streaming buffers are copied
+ * to a bounded queue and written by a dedicated thread, so that encoding
+ * and writing a block overlaps with the computation of the next ones.
+ * The queued blocks are accounted for by the streaming manager when
+ * estimating the number of divisions from the available RAM.
+ *
+ * Optionally (see SetPipelineFactory() and SetNumberOfConcurrentSplits()),
+ * several splits are processed at the same time by independent copies
+ * of the upstream pipeline, each worker thread picking the next pending
+ * split as soon as it is done with its current one. This is useful
+ * when the upstream filters do not scale well with the number of
+ * threads (serial BeforeThreadedGenerateData(), small splits...). Note
+ * that the memory print is then multiplied by the number of concurrent
+ * splits.
+ *
+ * Optionally (see the &resume extended filename option), the regions
+ * written are recorded in a journal next to the output file (see
+ * StreamingJournal). When an interrupted write is started again with the
+ * same input geometry and streaming splits, the regions already written
+ * are skipped and the existing file is updated. This is only available
+ * for files written by GDAL with streaming. The journal is removed once
+ * the whole image is written.
+ *
+ * In incremental mode (see the &incremental extended filename option),
+ * the journal is kept after the write, and records for each region the
+ * hash of the input pixels it has been computed from (see
+ * HashPipelineInputs()). When the image is written again, only the
+ * regions whose inputs changed are computed and updated in the file. The
+ * parameters of the filters are not seen by the hash: a signature of
+ * them should be given with SetParametersSignature().
+ *
  * ImageFileWriter supports extended filenames, which allow controlling
  * some properties of the output file. See
  * http://wiki.orfeo-toolbox.org/index.php/ExtendedFileName for more
@@ -100,6 +140,10 @@ public:
   typedef StreamingManager<InputImageType>       StreamingManagerType;
   typedef typename StreamingManagerType::Pointer StreamingManagerPointerType;
 
+  /** Function building an independent copy of the upstream pipeline and
+   * returning its output */
+  typedef std::function<InputImagePointer()> PipelineFactoryType;
+
   /**  Return the StreamingManager object responsible for dividing
    *   the region to write */
   StreamingManagerType* GetStreamingManager(void)
@@ -162,6 +206,15 @@ public:
    *   is set from the CMake configuration option */
   void SetAutomaticAdaptativeStreaming(unsigned int availableRAM = 0, double bias = 1.0);
 
+  /**  Set the streaming mode to 'aligned' and configure the number of MB
+   *   available. The actual number of divisions is computed automatically
+   *   by estimating the memory consumption of the pipeline.
+   *   Tiles are made of whole blocks of the input file, aligned on its
+   *   block grid, so that each block is read only once.
+   *   Setting the availableRAM parameter to 0 means that the available RAM
+   *   is set from the CMake configuration option */
+  void SetAutomaticBlockAlignedStreaming(unsigned int availableRAM = 0, double bias = 1.0);
+
   /** Set the only input of the writer */
   using Superclass::SetInput;
   virtual void SetInput(const InputImageType* input);
@@ -203,6 +256,39 @@ public:
 
   itkGetConstObjectMacro(FilenameHelper, FNameHelperType);
 
+  /** Set/Get the maximum number of streaming blocks waiting to be written
+   *  by the background writing thread. 0 (default) writes each block
+   *  synchronously. This can be overridden by the &writethreads extended
+   *  filename option */
+  itkSetMacro(WriteQueueDepth, unsigned int);
+  itkGetConstMacro(WriteQueueDepth, unsigned int);
+
+  /** Set the function used to build the independent pipelines needed to
+   *  process several splits concurrently. Each call must return the
+   *  output of a new pipeline that shares no filter with the others nor
+   *  with the writer input, and produces the same image as the writer
+   *  input. As an image does not hold its source, the filters must be
+   *  kept alive by the caller until Update() returns. The factory is only
+   *  called from the thread calling Update() */
+  void SetPipelineFactory(const PipelineFactoryType& factory)
+  {
+    m_PipelineFactory = factory;
+    this->Modified();
+  }
+
+  /** Set/Get the number of splits processed concurrently, when a pipeline
+   *  factory is set. 1 (default) processes the splits one after the other
+   *  with the writer input */
+  itkSetMacro(NumberOfConcurrentSplits, unsigned int);
+  itkGetConstMacro(NumberOfConcurrentSplits, unsigned int);
+
+  /** Set/Get a description of the parameters of the pipeline, written in
+   *  the fingerprint of the journal of resumed and incremental writes (see
+   *  the &resume and &incremental extended filename options), so that the
+   *  regions written with other parameters are computed again */
+  itkSetStringMacro(ParametersSignature);
+  itkGetStringMacro(ParametersSignature);
+
   /** This override doesn't return a const ref on the actual boolean */
   const bool& GetAbortGenerateData() const override;
 
@@ -244,6 +330,64 @@ private:
     this->UpdateProgress((m_DivisionProgress + m_CurrentDivision) / m_NumberOfDivisions);
   }
 
+  /** Set the pixel type and the number of components of the ImageIO, and
+   * resolve the band range, from the input image information */
+  void ConfigureImageIOPixelType(const InputImageType* input);
+
+  /** Return a copy of image restricted to ioRegion (with the number of
+   * components expected by the band range) if its buffer doesn't match,
+   * or a null pointer if the buffer can be written as is */
+  InputImagePointer MatchBufferToRegion(const InputImageType* image, const InputImageRegionType& ioRegion) const;
+
+  /** Process the splits concurrently with the pipelines built by the
+   * factory, and queue the resulting blocks to the writing thread */
+  void ConcurrentStreaming();
+
+  /** Write a buffer to the region of the output file, after remapping
+   * the bands if needed. Regions flagged as no-data (see
+   * IsBufferedRegionNoData()) may be left empty in sparse files */
+  void WriteToImageIO(const itk::ImageIORegion& region, void* buffer, size_t numberOfPixels, bool isNoData);
+
+  /** A streaming block waiting to be written */
+  struct WriteJob
+  {
+    itk::ImageIORegion region;
+    std::vector<char>  buffer;
+    size_t             numberOfPixels;
+    bool               isNoData;
+  };
+
+  /** Copy the buffer of image to a new block to be written in region */
+  static WriteJob MakeWriteJob(const InputImageType* image, const itk::ImageIORegion& region, bool isNoData);
+
+  /** Open the journal of the output file if the write can be resumed, and
+   * tell the ImageIO whether it updates the existing file */
+  void PrepareResume(const InputImageType* input, const InputImageRegionType& inputRegion);
+
+  /** Tell if the split has been written by a previous run (from inputs
+   * with the same hash in incremental mode). The last split is always
+   * written, as it closes the file */
+  bool IsSplitDone(const itk::ImageIORegion& ioRegion, unsigned int division, const std::string& inputHash) const;
+
+  /** Return the hash of the inputs of the split in incremental mode, and
+   * set it in the journal */
+  std::string HashSplitInputs(InputImageType* output, const InputImageRegionType& split, const itk::ImageIORegion& ioRegion);
+
+  /** Start the background writing thread */
+  void StartWriteThread();
+
+  /** Queue a block for writing, blocking while the queue is full. Errors
+   * raised by the writing thread are rethrown here */
+  void QueueWriteJob(WriteJob&& job);
+
+  /** Wait for the queued blocks to be written and stop the writing
+   * thread. If rethrow is true, an error raised by the writing thread
+   * is rethrown */
+  void StopWriteThread(bool rethrow);
+
+  /** Main loop of the background writing thread */
+  void WriteThreadLoop();
+
   unsigned int m_NumberOfDivisions;
   unsigned int m_CurrentDivision;
   float        m_DivisionProgress;
@@ -285,6 +429,36 @@ private:
 
   /** Lock to ensure thread-safety (added for the AbortGenerateData flag) */
   itk::SimpleFastMutexLock m_Lock;
+
+  /** Maximum number of blocks waiting to be written (0: synchronous) */
+  unsigned int m_WriteQueueDepth;
+
+  /** True while the blocks are written by the background thread */
+  bool m_UseWriteThread;
+
+  /** Background writing thread and its queue. A block stays in the queue
+   * until it is written, so that at most m_WriteQueueDepth copies are held */
+  std::thread             m_WriteThread;
+  std::mutex              m_WriteQueueMutex;
+  std::condition_variable m_WriteQueueCondition;
+  std::deque<WriteJob>    m_WriteQueue;
+  bool                    m_StopWriteThread;
+  std::exception_ptr      m_WriteError;
+
+  /** Builds the pipelines used to process splits concurrently */
+  PipelineFactoryType m_PipelineFactory;
+
+  /** Number of splits processed at the same time */
+  unsigned int m_NumberOfConcurrentSplits;
+
+  /** Journal of the written regions, when the write can be resumed */
+  std::unique_ptr<StreamingJournal> m_Journal;
+
+  /** True if the journal records the hash of the inputs of the regions */
+  bool m_IncrementalWrite;
+
+  /** Description of the parameters of the pipeline */
+  std::string m_ParametersSignature;
 };
 
 } // end namespace otb
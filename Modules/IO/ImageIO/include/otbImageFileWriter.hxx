@@ -36,6 +36,10 @@
 #include "otbImageKeywordlist.h"
 #include "otbMetaDataKey.h"
 #include "otbImageCommons.h"
+#include "otbGDALImageIO.h"
+#include "otbNoDataRegion.h"
+#include "otbGDALDriverManagerWrapper.h"
+#include "otbPipelineInputsHash.h"
 
 #include "otbConfigure.h"
 
@@ -46,12 +50,20 @@
 #include "otbTileDimensionTiledStreamingManager.h"
 #include "otbRAMDrivenTiledStreamingManager.h"
 #include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbBlockAlignedStreamingManager.h"
 
 #include "otb_boost_tokenizer_header.h"
 
 #include "otbStringUtils.h"
 #include "otbUtils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <functional>
+#include <iomanip>
+#include <sstream>
+
 namespace otb
 {
 
@@ -72,7 +84,15 @@ ImageFileWriter<TInputImage>::ImageFileWriter()
     m_FilenameHelper(),
     m_IsObserving(true),
     m_ObserverID(0),
-    m_IOComponents(0)
+    m_IOComponents(0),
+    m_WriteQueueDepth(0),
+    m_UseWriteThread(false),
+    m_StopWriteThread(false),
+    m_PipelineFactory(),
+    m_NumberOfConcurrentSplits(1),
+    m_Journal(),
+    m_IncrementalWrite(false),
+    m_ParametersSignature()
 {
   // Init output index shift
   m_ShiftOutputIndex.Fill(0);
@@ -90,6 +110,7 @@ ImageFileWriter<TInputImage>::ImageFileWriter()
 template <class TInputImage>
 ImageFileWriter<TInputImage>::~ImageFileWriter()
 {
+  this->StopWriteThread(false);
 }
 
 template <class TInputImage>
@@ -158,6 +179,16 @@ void ImageFileWriter<TInputImage>::SetAutomaticAdaptativeStreaming(unsigned int
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::SetAutomaticBlockAlignedStreaming(unsigned int availableRAM, double bias)
+{
+  typedef BlockAlignedStreamingManager<TInputImage>  BlockAlignedStreamingManagerType;
+  typename BlockAlignedStreamingManagerType::Pointer streamingManager = BlockAlignedStreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(availableRAM);
+  streamingManager->SetBias(bias);
+  m_StreamingManager = streamingManager;
+}
+
 /**
  *
  */
@@ -180,6 +211,10 @@ void ImageFileWriter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent inden
 
   os << indent << "IO Region: " << m_IORegion << "\n";
 
+  os << indent << "Write queue depth: " << m_WriteQueueDepth << "\n";
+
+  os << indent << "Number of concurrent splits: " << m_NumberOfConcurrentSplits << "\n";
+
   if (m_UseCompression)
   {
     os << indent << "Compression: On\n";
@@ -356,6 +391,19 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
         this->SetNumberOfLinesStrippedStreaming(sizevalue);
       }
     }
+    else if (type == "aligned")
+    {
+      if (sizemode != "auto")
+      {
+        otbLogMacro(Warning, << "In aligned streaming type, the sizemode option will be ignored.");
+      }
+      if (sizevalue == 0)
+      {
+        otbLogMacro(Warning, << "sizemode is auto but sizevalue is 0. Value will be fetched from the OTB_MAX_RAM_HINT environment variable if set, or else use "
+                                "the default value");
+      }
+      this->SetAutomaticBlockAlignedStreaming(sizevalue);
+    }
     else if (type == "none")
     {
       if (sizemode != "" || sizevalue != 0)
@@ -422,7 +470,8 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
 
   // Manage extended filename
   if ((strcmp(m_ImageIO->GetNameOfClass(), "GDALImageIO") == 0) &&
-      (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet() || m_FilenameHelper->NoDataValueIsSet() || m_FilenameHelper->SrsValueIsSet()))
+      (m_FilenameHelper->gdalCreationOptionsIsSet() || m_FilenameHelper->WriteRPCTagsIsSet() || m_FilenameHelper->NoDataValueIsSet() || m_FilenameHelper->SrsValueIsSet() ||
+       m_FilenameHelper->CloudOptimizedIsSet() || m_FilenameHelper->CompressionIsSet()))
   {
     typename GDALImageIO::Pointer imageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
 
@@ -441,11 +490,18 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
       imageIO->SetNoDataList(m_FilenameHelper->GetNoDataList());
     if  (m_FilenameHelper->SrsValueIsSet())
 	  imageIO->SetEpsgCode(m_FilenameHelper->GetSrsValue());
+    imageIO->SetCloudOptimized(m_FilenameHelper->GetCloudOptimized());
+    imageIO->SetCompressionPreset(m_FilenameHelper->GetCompression());
   }
 
 
   /** End of Prepare ImageIO  : create ImageFactory */
 
+  if (m_FilenameHelper->WriteThreadsIsSet())
+  {
+    m_WriteQueueDepth = m_FilenameHelper->GetWriteThreads();
+  }
+
   /**
    * Grab the input
    */
@@ -515,6 +571,7 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
     otbLogMacro(Debug, << "Buffered region is the largest possible region, there is no need for streaming.");
     this->SetNumberOfDivisionsStrippedStreaming(1);
   }
+  m_StreamingManager->SetNumberOfQueuedOutputBuffers(m_WriteQueueDepth);
   m_StreamingManager->PrepareStreaming(inputPtr, inputRegion);
   m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
 
@@ -566,6 +623,8 @@ void ImageFileWriter<TInputImage>::GenerateOutputInformation(void)
   //
   m_ImageIO->SetFileName(m_FileName);
 
+  this->PrepareResume(inputPtr, inputRegion);
+
   m_ImageIO->WriteImageInformation();
 }
 
@@ -618,29 +677,81 @@ void ImageFileWriter<TInputImage>::Update()
    */
   InputImageRegionType streamRegion;
 
-  for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
-       m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+  const bool         concurrentStreaming = m_PipelineFactory && (m_NumberOfConcurrentSplits > 1) && (m_NumberOfDivisions > 1);
+  const unsigned int writeQueueDepth     = m_WriteQueueDepth;
+  if (concurrentStreaming)
   {
-    streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    // Blocks are always handed to the writing thread, so that workers only
+    // wait for each other when the queue is full
+    m_WriteQueueDepth = std::max(m_WriteQueueDepth, m_NumberOfConcurrentSplits);
+  }
+
+  m_UseWriteThread = (m_WriteQueueDepth > 0) && (m_NumberOfDivisions > 1);
+  if (m_UseWriteThread)
+  {
+    otbLogMacro(Info, << "Up to " << m_WriteQueueDepth << " blocks will be queued to be written in the background");
+    // The ImageIO is set up once, before any block is queued
+    this->ConfigureImageIOPixelType(inputPtr);
+    this->StartWriteThread();
+  }
 
-    inputPtr->SetRequestedRegion(streamRegion);
-    inputPtr->PropagateRequestedRegion();
-    inputPtr->UpdateOutputData();
+  try
+  {
+    if (concurrentStreaming)
+    {
+      this->ConcurrentStreaming();
+    }
 
-    // Write the whole image
-    itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
-    for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+    for (m_CurrentDivision = concurrentStreaming ? m_NumberOfDivisions : 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
+         m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
     {
-      ioRegion.SetSize(i, streamRegion.GetSize(i));
-      // Set the ioRegion index using the shifted index ( (0,0 without box parameter))
-      ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+      streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+
+      // Write the whole image
+      itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
+      for (unsigned int i = 0; i < TInputImage::ImageDimension; ++i)
+      {
+        ioRegion.SetSize(i, streamRegion.GetSize(i));
+        // Set the ioRegion index using the shifted index ( (0,0 without box parameter))
+        ioRegion.SetIndex(i, streamRegion.GetIndex(i) - m_ShiftOutputIndex[i]);
+      }
+
+      // Skip the splits written by an interrupted run, or computed from the
+      // same inputs in incremental mode
+      const std::string inputHash = this->HashSplitInputs(inputPtr, streamRegion, ioRegion);
+      if (this->IsSplitDone(ioRegion, m_CurrentDivision, inputHash))
+      {
+        continue;
+      }
+
+      inputPtr->SetRequestedRegion(streamRegion);
+      inputPtr->PropagateRequestedRegion();
+      inputPtr->UpdateOutputData();
+
+      this->SetIORegion(ioRegion);
+
+      // The ImageIO region is set by the writing thread when it is used
+      if (!m_UseWriteThread)
+      {
+        m_ImageIO->SetIORegion(m_IORegion);
+      }
+
+      // Start writing stream region in the image file
+      this->GenerateData();
     }
-    this->SetIORegion(ioRegion);
-    m_ImageIO->SetIORegion(m_IORegion);
 
-    // Start writing stream region in the image file
-    this->GenerateData();
+    // Flush the blocks still waiting to be written
+    this->StopWriteThread(true);
+  }
+  catch (...)
+  {
+    this->StopWriteThread(false);
+    m_UseWriteThread  = false;
+    m_WriteQueueDepth = writeQueueDepth;
+    throw;
   }
+  m_UseWriteThread  = false;
+  m_WriteQueueDepth = writeQueueDepth;
 
   /**
    * If we ended due to aborting, push the progress up to 1.0 (since
@@ -649,6 +760,18 @@ void ImageFileWriter<TInputImage>::Update()
   if (!this->GetAbortGenerateData())
   {
     this->UpdateProgress(1.0);
+
+    // The journal is kept if the write is aborted, so that it can be
+    // resumed, and in incremental mode for the next writes
+    if (m_Journal && m_IncrementalWrite)
+    {
+      m_Journal->Close();
+    }
+    else if (m_Journal)
+    {
+      m_Journal->Remove();
+    }
+    m_Journal.reset();
   }
   else
   {
@@ -685,8 +808,42 @@ template <class TInputImage>
 void ImageFileWriter<TInputImage>::GenerateData(void)
 {
   const InputImageType* input = this->GetInput();
-  InputImagePointer     cacheImage;
 
+  // When the writing thread is running, the ImageIO is set up before the
+  // first block is queued
+  if (!m_UseWriteThread)
+  {
+    this->ConfigureImageIOPixelType(input);
+  }
+
+  // check that the image's buffered region is the same as
+  // ImageIO is expecting and we requested
+  InputImageRegionType ioRegion;
+
+  // No shift of the ioRegion from the buffered region is expected
+  itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(m_IORegion, ioRegion, m_ShiftOutputIndex);
+
+  InputImagePointer     cacheImage = this->MatchBufferToRegion(input, ioRegion);
+  const InputImageType* dataImage  = cacheImage.IsNotNull() ? cacheImage.GetPointer() : input;
+  const bool            isNoData   = IsBufferedRegionNoData(input);
+
+  if (m_UseWriteThread)
+  {
+    // The upstream buffer will be overwritten by the next block, so the
+    // writing thread gets its own copy
+    this->QueueWriteJob(MakeWriteJob(dataImage, m_IORegion, isNoData));
+  }
+  else
+  {
+    // okay, now extract the data as a raw buffer pointer
+    void* dataPtr = const_cast<void*>(static_cast<const void*>(dataImage->GetBufferPointer()));
+    this->WriteToImageIO(m_IORegion, dataPtr, dataImage->GetBufferedRegion().GetNumberOfPixels(), isNoData);
+  }
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::ConfigureImageIOPixelType(const InputImageType* input)
+{
   // Make sure that the image is the right type and no more than
   // four components.
   typedef typename InputImageType::PixelType ImagePixelType;
@@ -717,19 +874,14 @@ void ImageFileWriter<TInputImage>::GenerateData(void)
     // Set the pixel and component type; the number of components.
     m_ImageIO->SetPixelTypeInfo(typeid(ImagePixelType));
   }
+}
 
-  // Setup the image IO for writing.
-  //
-  // okay, now extract the data as a raw buffer pointer
-  const void* dataPtr = (const void*)input->GetBufferPointer();
-
-  // check that the image's buffered region is the same as
-  // ImageIO is expecting and we requested
-  InputImageRegionType ioRegion;
-
-  // No shift of the ioRegion from the buffered region is expected
-  itk::ImageIORegionAdaptor<TInputImage::ImageDimension>::Convert(m_ImageIO->GetIORegion(), ioRegion, m_ShiftOutputIndex);
-  InputImageRegionType bufferedRegion = input->GetBufferedRegion();
+template <class TInputImage>
+typename ImageFileWriter<TInputImage>::InputImagePointer ImageFileWriter<TInputImage>::MatchBufferToRegion(const InputImageType*       image,
+                                                                                                           const InputImageRegionType& ioRegion) const
+{
+  InputImagePointer    cacheImage;
+  InputImageRegionType bufferedRegion = image->GetBufferedRegion();
 
   // before this test, bad stuff would happened when they don't match.
   // In case of the buffer has not enough components, adapt the region.
@@ -738,7 +890,7 @@ void ImageFileWriter<TInputImage>::GenerateData(void)
     if (m_NumberOfDivisions > 1 || m_UserSpecifiedIORegion)
     {
       cacheImage = InputImageType::New();
-      cacheImage->CopyInformation(input);
+      cacheImage->CopyInformation(image);
 
       // set number of components at the band range size
       if (m_FilenameHelper->BandRangeIsSet() && (m_IOComponents < m_BandList.size()))
@@ -758,7 +910,7 @@ void ImageFileWriter<TInputImage>::GenerateData(void)
       typedef itk::ImageRegionConstIterator<TInputImage> ConstIteratorType;
       typedef itk::ImageRegionIterator<TInputImage>      IteratorType;
 
-      ConstIteratorType in(input, ioRegion);
+      ConstIteratorType in(image, ioRegion);
       IteratorType      out(cacheImage, ioRegion);
 
       // copy the data into a buffer to match the ioregion
@@ -766,8 +918,6 @@ void ImageFileWriter<TInputImage>::GenerateData(void)
       {
         out.Set(in.Get());
       }
-
-      dataPtr = (const void*)cacheImage->GetBufferPointer();
     }
     else
     {
@@ -783,16 +933,352 @@ void ImageFileWriter<TInputImage>::GenerateData(void)
       throw e;
     }
   }
+  return cacheImage;
+}
+
+template <class TInputImage>
+typename ImageFileWriter<TInputImage>::WriteJob ImageFileWriter<TInputImage>::MakeWriteJob(const InputImageType* image, const itk::ImageIORegion& region,
+                                                                                              bool isNoData)
+{
+  const char*  dataPtr = reinterpret_cast<const char*>(image->GetBufferPointer());
+  const size_t nbBytes = image->GetPixelContainer()->Size() * sizeof(typename InputImageType::PixelContainer::Element);
+
+  WriteJob job;
+  job.region         = region;
+  job.numberOfPixels = image->GetBufferedRegion().GetNumberOfPixels();
+  job.isNoData       = isNoData;
+  job.buffer.assign(dataPtr, dataPtr + nbBytes);
+  return job;
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::ConcurrentStreaming()
+{
+  const InputImageType* input = this->GetInput();
+
+  // The ImageIO is set up once, before any block is queued
+  this->ConfigureImageIOPixelType(input);
+
+  // Build the pipelines from this thread, as filters are usually not
+  // thread-safe while being set up
+  std::vector<InputImagePointer> pipelines;
+  for (unsigned int i = 0; i < m_NumberOfConcurrentSplits; ++i)
+  {
+    InputImagePointer output = m_PipelineFactory();
+    if (output.IsNull())
+    {
+      itkExceptionMacro(<< "The pipeline factory returned a null image.");
+    }
+    output->UpdateOutputInformation();
+    if (output->GetLargestPossibleRegion() != input->GetLargestPossibleRegion() ||
+        output->GetNumberOfComponentsPerPixel() != input->GetNumberOfComponentsPerPixel())
+    {
+      itkExceptionMacro(<< "The pipeline factory returned an image that does not match the writer input.");
+    }
+    pipelines.push_back(output);
+  }
+
+  // Compute the split map beforehand, as splitters are not all thread-safe
+  std::vector<InputImageRegionType> splits;
+  for (unsigned int i = 0; i < m_NumberOfDivisions; ++i)
+  {
+    splits.push_back(m_StreamingManager->GetSplit(i));
+  }
+
+  otbLogMacro(Info, << m_NumberOfConcurrentSplits << " blocks will be processed concurrently");
+
+  // Each worker takes the next pending split when it is done with the
+  // previous one, so that slow splits don't hold the others back
+  std::atomic<unsigned int> nextSplit(0);
+  unsigned int              doneSplits = 0;
+  std::exception_ptr        error;
+  std::mutex                progressMutex;
+  std::condition_variable   progressCondition;
+
+  auto worker = [&](InputImageType* output) {
+    try
+    {
+      unsigned int i;
+      while ((i = nextSplit++) < splits.size() && !this->GetAbortGenerateData())
+      {
+        itk::ImageIORegion ioRegion(TInputImage::ImageDimension);
+        for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+        {
+          ioRegion.SetSize(dim, splits[i].GetSize(dim));
+          ioRegion.SetIndex(dim, splits[i].GetIndex(dim) - m_ShiftOutputIndex[dim]);
+        }
+
+        // Skip the splits written by an interrupted run, or computed from
+        // the same inputs in incremental mode
+        const std::string inputHash = this->HashSplitInputs(output, splits[i], ioRegion);
+        if (!this->IsSplitDone(ioRegion, i, inputHash))
+        {
+          output->SetRequestedRegion(splits[i]);
+          output->PropagateRequestedRegion();
+          output->UpdateOutputData();
+
+          InputImagePointer cacheImage = this->MatchBufferToRegion(output, splits[i]);
+          this->QueueWriteJob(MakeWriteJob(cacheImage.IsNotNull() ? cacheImage.GetPointer() : output, ioRegion, IsBufferedRegionNoData(output)));
+        }
+
+        std::lock_guard<std::mutex> lock(progressMutex);
+        ++doneSplits;
+        progressCondition.notify_all();
+      }
+    }
+    catch (...)
+    {
+      std::lock_guard<std::mutex> lock(progressMutex);
+      if (error == nullptr)
+      {
+        error = std::current_exception();
+      }
+      // Stop the other workers
+      nextSplit = static_cast<unsigned int>(splits.size());
+      progressCondition.notify_all();
+    }
+  };
+
+  std::vector<std::thread> workers;
+  for (auto& output : pipelines)
+  {
+    workers.emplace_back(worker, output.GetPointer());
+  }
+
+  // Progress is reported from this thread only
+  {
+    std::unique_lock<std::mutex> lock(progressMutex);
+    while (doneSplits < splits.size() && error == nullptr && !this->GetAbortGenerateData())
+    {
+      progressCondition.wait_for(lock, std::chrono::milliseconds(100));
+      m_CurrentDivision = doneSplits;
+      lock.unlock();
+      this->UpdateFilterProgress();
+      lock.lock();
+    }
+  }
+
+  for (auto& thread : workers)
+  {
+    thread.join();
+  }
+
+  m_CurrentDivision = m_NumberOfDivisions;
+
+  if (error != nullptr)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::WriteToImageIO(const itk::ImageIORegion& region, void* buffer, size_t numberOfPixels, bool isNoData)
+{
+  m_ImageIO->SetIORegion(region);
+
+  GDALImageIO* gdalImageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
+  if (gdalImageIO != nullptr)
+  {
+    gdalImageIO->SetIORegionIsNoData(isNoData);
+  }
 
   if (m_FilenameHelper->BandRangeIsSet() && (!m_BandList.empty()))
   {
     // Adapt the image size with the region and take into account a potential
     // remapping of the components. m_BandList is empty if no band range is set
-    m_ImageIO->DoMapBuffer(const_cast<void*>(dataPtr), bufferedRegion.GetNumberOfPixels(), this->m_BandList);
+    m_ImageIO->SetNumberOfComponents(m_IOComponents);
+    m_ImageIO->DoMapBuffer(buffer, numberOfPixels, this->m_BandList);
     m_ImageIO->SetNumberOfComponents(m_BandList.size());
   }
 
-  m_ImageIO->Write(dataPtr);
+  m_ImageIO->Write(buffer);
+
+  if (m_Journal)
+  {
+    m_Journal->MarkDone(region);
+  }
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::PrepareResume(const InputImageType* input, const InputImageRegionType& inputRegion)
+{
+  m_Journal.reset();
+  m_IncrementalWrite = false;
+
+  GDALImageIO* gdalImageIO = dynamic_cast<GDALImageIO*>(m_ImageIO.GetPointer());
+  if (gdalImageIO != nullptr)
+  {
+    gdalImageIO->SetUpdateExistingFile(false);
+  }
+
+  const bool resume      = m_FilenameHelper->ResumeIsSet() && m_FilenameHelper->GetResume();
+  const bool incremental = m_FilenameHelper->IncrementalIsSet() && m_FilenameHelper->GetIncremental();
+  if (!resume && !incremental)
+  {
+    return;
+  }
+  if (gdalImageIO == nullptr || !gdalImageIO->CanStreamWrite() || gdalImageIO->GetCloudOptimized())
+  {
+    otbLogMacro(Warning, << "Resuming or updating the write of " << m_FileName
+                         << " is only available for files written by GDAL with streaming, and not as COG");
+    return;
+  }
+  if (m_NumberOfDivisions < 2)
+  {
+    return;
+  }
+
+  // The fingerprint changes with anything that changes the content or the
+  // layout of the splits. The input pixels are only checked, split by
+  // split, in incremental mode
+  std::ostringstream description;
+  description << std::setprecision(17) << (incremental ? "incremental " : "resume ") << typeid(typename InputImageType::InternalPixelType).name() << " "
+              << input->GetNumberOfComponentsPerPixel() << " " << m_FilenameHelper->GetBandRange() << " " << inputRegion << " " << input->GetOrigin() << " "
+              << input->GetSpacing() << " " << input->GetDirection() << " " << DescribePipeline(const_cast<InputImageType*>(input)) << " "
+              << m_ParametersSignature;
+  for (unsigned int i = 0; i < m_NumberOfDivisions; ++i)
+  {
+    description << " " << m_StreamingManager->GetSplit(i);
+  }
+  std::ostringstream fingerprint;
+  fingerprint << std::hex << std::hash<std::string>()(description.str());
+
+  m_Journal.reset(new StreamingJournal(m_FileName));
+  m_IncrementalWrite = incremental;
+  size_t doneRegions = m_Journal->Open(fingerprint.str());
+
+  // The regions of the journal are only valid while the file is there
+  if (doneRegions > 0)
+  {
+    GDALDatasetWrapper::Pointer existing = GDALDriverManagerWrapper::GetInstance().Open(m_FileName);
+    if (existing.IsNull() || existing->GetDataSet()->GetRasterXSize() != static_cast<int>(inputRegion.GetSize(0)) ||
+        existing->GetDataSet()->GetRasterYSize() != static_cast<int>(inputRegion.GetSize(1)))
+    {
+      otbLogMacro(Warning, << "The journal " << m_Journal->GetFileName() << " does not match the file " << m_FileName << ", the whole image is written");
+      m_Journal->Remove();
+      doneRegions = m_Journal->Open(fingerprint.str());
+    }
+  }
+
+  if (doneRegions > 0)
+  {
+    otbLogMacro(Info, << (incremental ? "Updating " : "Resuming the write of ") << m_FileName << ": " << doneRegions << " blocks out of "
+                      << m_NumberOfDivisions << " have already been written");
+  }
+  gdalImageIO->SetUpdateExistingFile(doneRegions > 0);
+}
+
+template <class TInputImage>
+bool ImageFileWriter<TInputImage>::IsSplitDone(const itk::ImageIORegion& ioRegion, unsigned int division, const std::string& inputHash) const
+{
+  // Splits whose inputs can't be hashed are always computed
+  if (!m_Journal || (division + 1 == m_NumberOfDivisions) || (m_IncrementalWrite && inputHash.empty()))
+  {
+    return false;
+  }
+  return m_Journal->IsDone(ioRegion, inputHash);
+}
+
+template <class TInputImage>
+std::string ImageFileWriter<TInputImage>::HashSplitInputs(InputImageType* output, const InputImageRegionType& split, const itk::ImageIORegion& ioRegion)
+{
+  if (!m_Journal || !m_IncrementalWrite)
+  {
+    return std::string();
+  }
+  const std::string inputHash = HashPipelineInputs(output, split);
+  m_Journal->SetInputHash(ioRegion, inputHash);
+  return inputHash;
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::StartWriteThread()
+{
+  m_WriteQueue.clear();
+  m_StopWriteThread = false;
+  m_WriteError      = nullptr;
+  m_WriteThread     = std::thread(&Self::WriteThreadLoop, this);
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::QueueWriteJob(WriteJob&& job)
+{
+  std::unique_lock<std::mutex> lock(m_WriteQueueMutex);
+  m_WriteQueueCondition.wait(lock, [this] { return m_WriteQueue.size() < m_WriteQueueDepth || m_WriteError != nullptr; });
+
+  if (m_WriteError != nullptr)
+  {
+    std::exception_ptr error = m_WriteError;
+    m_WriteError             = nullptr;
+    std::rethrow_exception(error);
+  }
+
+  m_WriteQueue.push_back(std::move(job));
+  m_WriteQueueCondition.notify_all();
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::StopWriteThread(bool rethrow)
+{
+  if (!m_WriteThread.joinable())
+  {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(m_WriteQueueMutex);
+    m_StopWriteThread = true;
+    // On error, don't bother writing the remaining blocks. The first one
+    // may be in the hands of the writing thread, it is left in the queue.
+    if (!rethrow && !m_WriteQueue.empty())
+    {
+      m_WriteQueue.erase(m_WriteQueue.begin() + 1, m_WriteQueue.end());
+    }
+  }
+  m_WriteQueueCondition.notify_all();
+  m_WriteThread.join();
+
+  std::exception_ptr error = m_WriteError;
+  m_WriteError             = nullptr;
+  if (rethrow && error)
+  {
+    std::rethrow_exception(error);
+  }
+}
+
+template <class TInputImage>
+void ImageFileWriter<TInputImage>::WriteThreadLoop()
+{
+  while (true)
+  {
+    std::unique_lock<std::mutex> lock(m_WriteQueueMutex);
+    m_WriteQueueCondition.wait(lock, [this] { return !m_WriteQueue.empty() || m_StopWriteThread; });
+    if (m_WriteQueue.empty())
+    {
+      return;
+    }
+
+    // The block is only removed from the queue once written
+    WriteJob& job = m_WriteQueue.front();
+    lock.unlock();
+
+    try
+    {
+      this->WriteToImageIO(job.region, job.buffer.data(), job.numberOfPixels, job.isNoData);
+    }
+    catch (...)
+    {
+      lock.lock();
+      m_WriteError = std::current_exception();
+      m_WriteQueue.clear();
+      m_WriteQueueCondition.notify_all();
+      return;
+    }
+
+    lock.lock();
+    m_WriteQueue.pop_front();
+    m_WriteQueueCondition.notify_all();
+  }
 }
 
 template <class TInputImage>
@@ -0,0 +1,214 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbPipelineInputsHash_h
+#define otbPipelineInputsHash_h
+
+#include "itkProcessObject.h"
+#include "otbImage.h"
+#include "otbVectorImage.h"
+
+#include <complex>
+#include <cstdint>
+#include <iomanip>
+#include <set>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+namespace pipeline_inputs_hash_details
+{
+// 64 bits FNV-1a, which is stable from one run to the other
+inline void HashBytes(const void* data, size_t size, uint64_t& hash)
+{
+  const unsigned char* bytes = static_cast<const unsigned char*>(data);
+  for (size_t i = 0; i < size; ++i)
+  {
+    hash ^= bytes[i];
+    hash *= 1099511628211ULL;
+  }
+}
+
+template <class TImage>
+bool HashRequestedRegion(const TImage* image, uint64_t& hash)
+{
+  typedef typename TImage::RegionType        RegionType;
+  typedef typename TImage::InternalPixelType InternalPixelType;
+
+  const RegionType   region     = image->GetRequestedRegion();
+  const unsigned int components = image->GetNumberOfComponentsPerPixel();
+  if (!image->GetBufferedRegion().IsInside(region))
+  {
+    return false;
+  }
+
+  for (unsigned int dim = 0; dim < TImage::ImageDimension; ++dim)
+  {
+    const long bounds[2] = {region.GetIndex(dim), static_cast<long>(region.GetSize(dim))};
+    HashBytes(bounds, sizeof(bounds), hash);
+  }
+  HashBytes(&components, sizeof(components), hash);
+
+  // Lines are contiguous in the buffer
+  typename TImage::IndexType index = region.GetIndex();
+  for (unsigned int line = 0; line < region.GetSize(1); ++line)
+  {
+    index[1] = region.GetIndex(1) + line;
+    const InternalPixelType* data = image->GetBufferPointer() + image->ComputeOffset(index) * components;
+    HashBytes(data, region.GetSize(0) * components * sizeof(InternalPixelType), hash);
+  }
+  return true;
+}
+
+template <class... TImages>
+struct ImageHasher
+{
+  static bool Hash(const itk::DataObject*, uint64_t&)
+  {
+    return false;
+  }
+};
+
+template <class TImage, class... TOthers>
+struct ImageHasher<TImage, TOthers...>
+{
+  static bool Hash(const itk::DataObject* object, uint64_t& hash)
+  {
+    const TImage* image = dynamic_cast<const TImage*>(object);
+    if (image != nullptr)
+    {
+      return HashRequestedRegion(image, hash);
+    }
+    return ImageHasher<TOthers...>::Hash(object, hash);
+  }
+};
+
+template <class TPixel>
+struct ScalarAndVectorImages
+{
+  typedef ImageHasher<Image<TPixel, 2>, VectorImage<TPixel, 2>> HasherType;
+};
+
+// Images of the usual pixel types, as read by ImageFileReader
+inline bool HashImage(const itk::DataObject* object, uint64_t& hash)
+{
+  return ScalarAndVectorImages<unsigned char>::HasherType::Hash(object, hash) || ScalarAndVectorImages<char>::HasherType::Hash(object, hash) ||
+         ScalarAndVectorImages<unsigned short>::HasherType::Hash(object, hash) || ScalarAndVectorImages<short>::HasherType::Hash(object, hash) ||
+         ScalarAndVectorImages<unsigned int>::HasherType::Hash(object, hash) || ScalarAndVectorImages<int>::HasherType::Hash(object, hash) ||
+         ScalarAndVectorImages<unsigned long>::HasherType::Hash(object, hash) || ScalarAndVectorImages<long>::HasherType::Hash(object, hash) ||
+         ScalarAndVectorImages<float>::HasherType::Hash(object, hash) || ScalarAndVectorImages<double>::HasherType::Hash(object, hash) ||
+         ScalarAndVectorImages<std::complex<short>>::HasherType::Hash(object, hash) ||
+         ScalarAndVectorImages<std::complex<int>>::HasherType::Hash(object, hash) ||
+         ScalarAndVectorImages<std::complex<float>>::HasherType::Hash(object, hash) ||
+         ScalarAndVectorImages<std::complex<double>>::HasherType::Hash(object, hash);
+}
+
+inline void CollectLeaves(itk::DataObject* object, std::vector<itk::DataObject*>& leaves, std::set<const itk::DataObject*>& visited)
+{
+  if (object == nullptr || !visited.insert(object).second)
+  {
+    return;
+  }
+  itk::ProcessObject* source = object->GetSource();
+  if (source == nullptr || source->GetNumberOfIndexedInputs() == 0)
+  {
+    leaves.push_back(object);
+    return;
+  }
+  for (const auto& input : source->GetInputs())
+  {
+    CollectLeaves(input, leaves, visited);
+  }
+}
+} // End namespace pipeline_inputs_hash_details
+
+/** Return the data objects the pipeline producing output starts from:
+ * the outputs of its readers (sources without inputs), and the images
+ * without source. Each one is returned once, in a stable order */
+inline std::vector<itk::DataObject*> GetPipelineLeaves(itk::DataObject* output)
+{
+  std::vector<itk::DataObject*>    leaves;
+  std::set<const itk::DataObject*> visited;
+  pipeline_inputs_hash_details::CollectLeaves(output, leaves, visited);
+  return leaves;
+}
+
+/** Describe the structure of the pipeline producing output, from the
+ * class names of its sources */
+inline std::string DescribePipeline(itk::DataObject* output)
+{
+  std::ostringstream                  description;
+  std::set<const itk::ProcessObject*> visited;
+  std::vector<itk::DataObject*>       pending(1, output);
+  while (!pending.empty())
+  {
+    itk::DataObject* object = pending.back();
+    pending.pop_back();
+    itk::ProcessObject* source = object != nullptr ? object->GetSource() : nullptr;
+    if (source != nullptr && visited.insert(source).second)
+    {
+      description << source->GetNameOfClass() << " ";
+      for (const auto& input : source->GetInputs())
+      {
+        pending.push_back(input);
+      }
+    }
+  }
+  return description.str();
+}
+
+/** Compute the hash of the pixels the pipeline producing output reads to
+ * compute region: the requested region is propagated up to the leaves of
+ * the pipeline (see GetPipelineLeaves()), which are updated, and their
+ * requested regions are hashed. Leaves which are not images (parameters
+ * stored in data objects for instance) are not hashed. Returns an empty
+ * string if an image leaf has a pixel type that cannot be hashed */
+template <class TImage>
+std::string HashPipelineInputs(TImage* output, const typename TImage::RegionType& region)
+{
+  output->SetRequestedRegion(region);
+  output->PropagateRequestedRegion();
+
+  uint64_t hash = 14695981039346656037ULL;
+  for (itk::DataObject* leaf : GetPipelineLeaves(output))
+  {
+    if (dynamic_cast<itk::ImageBase<TImage::ImageDimension>*>(leaf) == nullptr)
+    {
+      continue;
+    }
+    leaf->UpdateOutputData();
+    if (!pipeline_inputs_hash_details::HashImage(leaf, hash))
+    {
+      return std::string();
+    }
+  }
+
+  std::ostringstream oss;
+  oss << std::hex << std::setw(16) << std::setfill('0') << hash;
+  return oss.str();
+}
+
+} // End namespace otb
+
+#endif
@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbStreamingJournal_h
+#define otbStreamingJournal_h
+
+#include "itkImageIORegion.h"
+#include "OTBImageIOExport.h"
+#include <fstream>
+#include <map>
+#include <mutex>
+#include <string>
+
+namespace otb
+{
+
+/** \class StreamingJournal
+ *
+ * \brief Journal of the regions already written to an image file.
+ *
+ * The journal is a text file stored next to the image (its name with the
+ * ".journal" suffix). It starts with a fingerprint of the write (image
+ * geometry, pixel type, streaming splits...), followed by one line per
+ * region written. When an interrupted write is started again with the
+ * same fingerprint, the regions of the journal don't need to be written
+ * again. A journal with another fingerprint is discarded.
+ *
+ * Each region can also be recorded with a hash of the inputs it has been
+ * computed from, so that only the regions whose inputs changed are
+ * written again (see ImageFileWriter incremental mode). The hash of a
+ * region is given by SetInputHash() when the region is computed, and
+ * recorded by MarkDone() once it is written.
+ *
+ * SetInputHash() and MarkDone() can be called from several threads.
+ *
+ * \sa ImageFileWriter
+ *
+ * \ingroup OTBImageIO
+ */
+class OTBImageIO_EXPORT StreamingJournal
+{
+public:
+  explicit StreamingJournal(const std::string& imageFileName);
+
+  ~StreamingJournal();
+
+  /** Load the journal of the image if it has the given fingerprint,
+   * or start a new one. Returns the number of regions already written */
+  size_t Open(const std::string& fingerprint);
+
+  /** Tell if the region has been written by a previous run, from inputs
+   * with the given hash */
+  bool IsDone(const itk::ImageIORegion& region, const std::string& inputHash = std::string()) const;
+
+  /** Set the hash of the inputs of a region about to be written */
+  void SetInputHash(const itk::ImageIORegion& region, const std::string& inputHash);
+
+  /** Record that the region has been written, with the hash given by
+   * SetInputHash(). The journal is flushed so that it survives a crash */
+  void MarkDone(const itk::ImageIORegion& region);
+
+  /** Close the journal, and keep it for the next writes */
+  void Close();
+
+  /** Close and delete the journal, once the whole image is written */
+  void Remove();
+
+  const std::string& GetFileName() const
+  {
+    return m_FileName;
+  }
+
+private:
+  StreamingJournal(const StreamingJournal&) = delete;
+  void operator=(const StreamingJournal&) = delete;
+
+  static std::string RegionToString(const itk::ImageIORegion& region);
+
+  typedef std::map<std::string, std::string> RegionHashMapType;
+
+  std::string       m_FileName;
+  RegionHashMapType m_DoneRegions;
+  RegionHashMapType m_PendingHashes;
+  std::ofstream     m_Stream;
+  std::mutex        m_Mutex;
+};
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,148 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbStreamingJournal.h"
+#include "itkMacro.h"
+#include <cstdio>
+#include <sstream>
+
+namespace otb
+{
+
+namespace
+{
+const char* const JournalHeader = "OTB streaming journal 1";
+}
+
+StreamingJournal::StreamingJournal(const std::string& imageFileName) : m_FileName(imageFileName + ".journal")
+{
+}
+
+StreamingJournal::~StreamingJournal()
+{
+  if (m_Stream.is_open())
+  {
+    m_Stream.close();
+  }
+}
+
+size_t StreamingJournal::Open(const std::string& fingerprint)
+{
+  m_DoneRegions.clear();
+  m_PendingHashes.clear();
+
+  std::ifstream previous(m_FileName);
+  std::string   header, line;
+  if (std::getline(previous, header) && header == JournalHeader && std::getline(previous, line) && line == fingerprint)
+  {
+    // Only complete lines are kept, the last one may have been cut by
+    // the interruption
+    while (std::getline(previous, line))
+    {
+      // Lines are "done <region>;<input hash>", the last line of a region
+      // being the one of its last write
+      const size_t separator = line.find(';');
+      if (!previous.eof() && line.compare(0, 5, "done ") == 0 && separator != std::string::npos)
+      {
+        m_DoneRegions[line.substr(5, separator - 5)] = line.substr(separator + 1);
+      }
+    }
+  }
+  previous.close();
+
+  // The journal is written again, without the damaged lines
+  m_Stream.open(m_FileName, std::ios::out | std::ios::trunc);
+  if (!m_Stream)
+  {
+    itkGenericExceptionMacro(<< "Unable to write the streaming journal " << m_FileName);
+  }
+  m_Stream << JournalHeader << "\n" << fingerprint << "\n";
+  for (const auto& region : m_DoneRegions)
+  {
+    m_Stream << "done " << region.first << ";" << region.second << "\n";
+  }
+  m_Stream.flush();
+
+  return m_DoneRegions.size();
+}
+
+bool StreamingJournal::IsDone(const itk::ImageIORegion& region, const std::string& inputHash) const
+{
+  const auto it = m_DoneRegions.find(RegionToString(region));
+  return it != m_DoneRegions.end() && it->second == inputHash;
+}
+
+void StreamingJournal::SetInputHash(const itk::ImageIORegion& region, const std::string& inputHash)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_PendingHashes[RegionToString(region)] = inputHash;
+}
+
+void StreamingJournal::MarkDone(const itk::ImageIORegion& region)
+{
+  const std::string key = RegionToString(region);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::string                 inputHash;
+  const auto                  pending = m_PendingHashes.find(key);
+  if (pending != m_PendingHashes.end())
+  {
+    inputHash = pending->second;
+    m_PendingHashes.erase(pending);
+  }
+  if (m_Stream.is_open())
+  {
+    m_Stream << "done " << key << ";" << inputHash << std::endl;
+  }
+}
+
+void StreamingJournal::Close()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_Stream.is_open())
+  {
+    m_Stream.close();
+  }
+  m_DoneRegions.clear();
+  m_PendingHashes.clear();
+}
+
+void StreamingJournal::Remove()
+{
+  this->Close();
+  std::remove(m_FileName.c_str());
+}
+
+std::string StreamingJournal::RegionToString(const itk::ImageIORegion& region)
+{
+  std::ostringstream oss;
+  for (unsigned int dim = 0; dim < region.GetImageDimension(); ++dim)
+  {
+    oss << region.GetIndex(dim) << " ";
+  }
+  for (unsigned int dim = 0; dim < region.GetImageDimension(); ++dim)
+  {
+    oss << region.GetSize(dim) << (dim + 1 < region.GetImageDimension() ? " " : "");
+  }
+  return oss.str();
+}
+
+} // end namespace otb
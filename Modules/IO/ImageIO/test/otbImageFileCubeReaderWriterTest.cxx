@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileCubeReader.h"
+#include "otbImageFileCubeWriter.h"
+#include "itkImageRegionConstIterator.h"
+
+int otbImageFileCubeReaderWriterTest(int argc, char* argv[])
+{
+  if (argc < 5)
+  {
+    std::cerr << "Usage: " << argv[0] << " input cube driver numberOfBands" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  typedef otb::VectorImage<float, 2>               ImageType;
+  typedef otb::ImageFileReader<ImageType>          ReaderType;
+  typedef otb::ImageFileCubeWriter<ImageType>      CubeWriterType;
+  typedef otb::ImageFileCubeReader<ImageType>      CubeReaderType;
+  typedef itk::ImageRegionConstIterator<ImageType> IteratorType;
+
+  const unsigned int nbBands = atoi(argv[4]);
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  // Small chunks, so that the image is streamed in several divisions
+  CubeWriterType::Pointer  writer = CubeWriterType::New();
+  CubeWriterType::SizeType chunkSize;
+  chunkSize.Fill(64);
+  writer->SetInput(reader->GetOutput());
+  writer->SetFileName(argv[2]);
+  writer->SetDriverName(argv[3]);
+  writer->SetNumberOfBands(nbBands);
+  writer->SetChunkSize(chunkSize);
+  writer->Update();
+
+  CubeReaderType::Pointer cubeReader = CubeReaderType::New();
+  cubeReader->SetFileName(argv[2]);
+  cubeReader->UpdateOutputInformation();
+
+  const ImageType* image = reader->GetOutput();
+  const ImageType* cube  = cubeReader->GetOutput();
+  if (cube->GetLargestPossibleRegion().GetSize() != image->GetLargestPossibleRegion().GetSize() ||
+      cube->GetNumberOfComponentsPerPixel() != image->GetNumberOfComponentsPerPixel() || cubeReader->GetNumberOfBands() != nbBands ||
+      cubeReader->GetNumberOfTimes() * nbBands != image->GetNumberOfComponentsPerPixel())
+  {
+    std::cerr << "Unexpected size of the cube" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    if (std::abs(cube->GetOrigin()[i] - image->GetOrigin()[i]) > 1e-9 || std::abs(cube->GetSignedSpacing()[i] - image->GetSignedSpacing()[i]) > 1e-9)
+    {
+      std::cerr << "Unexpected origin or spacing of the cube: " << cube->GetOrigin() << " " << cube->GetSignedSpacing() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  if (cube->GetImageMetadata()[otb::MDNum::TileHintX] != 64 || cube->GetImageMetadata()[otb::MDNum::TileHintY] != 64)
+  {
+    std::cerr << "The chunk size is not published as tile hint" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Read a region across several chunks, away from the origin
+  ImageType::RegionType region = image->GetLargestPossibleRegion();
+  region.SetIndex(0, region.GetSize(0) / 4);
+  region.SetIndex(1, region.GetSize(1) / 3);
+  region.SetSize(0, region.GetSize(0) / 2);
+  region.SetSize(1, region.GetSize(1) / 2);
+  cubeReader->SetNumberOfThreads(4);
+  cubeReader->GetOutput()->SetRequestedRegion(region);
+  cubeReader->Update();
+  reader->GetOutput()->SetRequestedRegion(region);
+  reader->Update();
+
+  IteratorType cubeIt(cube, region);
+  IteratorType it(image, region);
+  for (cubeIt.GoToBegin(), it.GoToBegin(); !it.IsAtEnd(); ++cubeIt, ++it)
+  {
+    if (cubeIt.Get() != it.Get())
+    {
+      std::cerr << "Pixels differ at " << it.GetIndex() << ": " << it.Get() << " read, " << cubeIt.Get() << " in the cube" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileStackReader.h"
+#include "itkImageRegionConstIterator.h"
+
+int otbImageFileStackReaderTest(int argc, char* argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " useVRT image1 image2 ..." << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  typedef otb::VectorImage<float, 2>               ImageType;
+  typedef otb::ImageFileReader<ImageType>          ReaderType;
+  typedef otb::ImageFileStackReader<ImageType>     StackReaderType;
+  typedef itk::ImageRegionConstIterator<ImageType> IteratorType;
+
+  std::vector<std::string> fileNames(argv + 2, argv + argc);
+
+  StackReaderType::Pointer stackReader = StackReaderType::New();
+  stackReader->SetFileNames(fileNames);
+  stackReader->SetUseVRT(atoi(argv[1]) != 0);
+  stackReader->UpdateOutputInformation();
+
+  // Read a region away from the origin to check the offsets
+  ImageType::RegionType region = stackReader->GetOutput()->GetLargestPossibleRegion();
+  region.SetIndex(0, region.GetSize(0) / 4);
+  region.SetIndex(1, region.GetSize(1) / 3);
+  region.SetSize(0, region.GetSize(0) / 2);
+  region.SetSize(1, region.GetSize(1) / 2);
+  stackReader->GetOutput()->SetRequestedRegion(region);
+  stackReader->Update();
+
+  unsigned int firstBand = 0;
+  for (const auto& fileName : fileNames)
+  {
+    ReaderType::Pointer reader = ReaderType::New();
+    reader->SetFileName(fileName);
+    reader->GetOutput()->UpdateOutputInformation();
+    reader->GetOutput()->SetRequestedRegion(region);
+    reader->Update();
+
+    const unsigned int nbBands = reader->GetOutput()->GetNumberOfComponentsPerPixel();
+    IteratorType       stackIt(stackReader->GetOutput(), region);
+    IteratorType       it(reader->GetOutput(), region);
+    for (stackIt.GoToBegin(), it.GoToBegin(); !it.IsAtEnd(); ++stackIt, ++it)
+    {
+      for (unsigned int band = 0; band < nbBands; ++band)
+      {
+        if (stackIt.Get()[firstBand + band] != it.Get()[band])
+        {
+          std::cerr << "Band " << band + 1 << " of " << fileName << " differs at " << it.GetIndex() << ": " << it.Get()[band] << " read, "
+                    << stackIt.Get()[firstBand + band] << " stacked" << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+    firstBand += nbBands;
+  }
+
+  if (firstBand != stackReader->GetOutput()->GetNumberOfComponentsPerPixel() ||
+      stackReader->GetOutput()->GetImageMetadata().Bands.size() != firstBand)
+  {
+    std::cerr << "Unexpected number of bands in the stack" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbImageFileWriter.h"
+
+int otbImageFileWriterConcurrentStreamingTest(int itkNotUsed(argc), char* argv[])
+{
+  const char*  inputFilename      = argv[1];
+  const char*  outputFilename     = argv[2];
+  unsigned int nbConcurrentSplits = atoi(argv[3]);
+  unsigned int nbDivisions        = atoi(argv[4]);
+
+  typedef otb::VectorImage<unsigned short, 2> ImageType;
+  typedef otb::ImageFileReader<ImageType>     ReaderType;
+  typedef otb::ImageFileWriter<ImageType>     WriterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+
+  // Keep the readers of the concurrent pipelines alive
+  std::vector<ReaderType::Pointer> readers;
+
+  WriterType::Pointer writer = WriterType::New();
+  writer->SetFileName(outputFilename);
+  writer->SetInput(reader->GetOutput());
+  writer->SetNumberOfDivisionsTiledStreaming(nbDivisions);
+  writer->SetNumberOfConcurrentSplits(nbConcurrentSplits);
+  writer->SetPipelineFactory([&readers, inputFilename]() {
+    ReaderType::Pointer pipelineReader = ReaderType::New();
+    pipelineReader->SetFileName(inputFilename);
+    readers.push_back(pipelineReader);
+    return ImageType::Pointer(pipelineReader->GetOutput());
+  });
+  writer->Update();
+
+  if (readers.size() != nbConcurrentSplits)
+  {
+    std::cout << "Expected " << nbConcurrentSplits << " pipelines, got " << readers.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -97,6 +97,7 @@ void RegisterTests()
   REGISTER_TEST(otbVectorImageFileWriterComplexTestWithoutInputDouble);
   REGISTER_TEST(otbWritingComplexDataWithComplexImageTest);
   REGISTER_TEST(otbImageFileWriterWithFilterTest);
+  REGISTER_TEST(otbImageFileWriterConcurrentStreamingTest);
   REGISTER_TEST(otbImageFileReaderRADComplexDouble);
   REGISTER_TEST(otbPipeline);
   REGISTER_TEST(otbStreamingImageFilterTest);
@@ -151,5 +152,7 @@ void RegisterTests()
   REGISTER_TEST(otbImageFileReaderOptBandTest);
   REGISTER_TEST(otbImageFileWriterOptBandTest);
   REGISTER_TEST(otbMultiImageFileWriterTest);
+  REGISTER_TEST(otbImageFileStackReaderTest);
+  REGISTER_TEST(otbImageFileCubeReaderWriterTest);
   REGISTER_TEST(otbWriteGeomFile);
 }
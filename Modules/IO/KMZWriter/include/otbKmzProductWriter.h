@@ -64,6 +64,10 @@ namespace otb
  * SetTileSize(unsigned int), the user can also specify the name of
  * the output Kmz filename via SetPath().
  *
+ * Each level of the pyramid is computed by strips of tiles. The tiles of
+ * a strip are encoded to JPEG in parallel, in memory, and added to the
+ * kmz with their kml without going through temporary files.
+ *
  *
  *
  * \ingroup IO
@@ -111,6 +115,9 @@ public:
   // Writer
   typedef ImageFileWriter<VectorImage<OutputPixelType>> VectorWriterType;
 
+  // Strip of tiles to encode
+  typedef typename VectorImageExtractROIFilterType::OutputImageType StripImageType;
+
   // Resampler
   typedef StreamingShrinkImageFilter<InputImageType, InputImageType> StreamingShrinkImageFilterType;
 
@@ -210,16 +217,16 @@ private:
   void GenerateKMLRoot(const std::string& title, double north, double south, double east, double west, bool extended);
 
   /** KML generate  Filename - PathName - tile number - North - South - East - West */
-  void GenerateKML(const std::string& pathname, int depth, int x, int y, double north, double south, double east, double west);
+  void GenerateKML(int depth, int x, int y, double north, double south, double east, double west);
 
-  void GenerateKMLExtended(const std::string& pathname, int depth, int x, int y, OutputPointType lowerLeft, OutputPointType lowerRight,
-                           OutputPointType upperRight, OutputPointType upperLeft);
+  void GenerateKMLExtended(int depth, int x, int y, OutputPointType lowerLeft, OutputPointType lowerRight, OutputPointType upperRight,
+                           OutputPointType upperLeft);
 
   /** KML with link generate */
-  void GenerateKMLWithLink(const std::string& pathname, int depth, int x, int y, int tileStartX, int tileStartY, double north, double south, double east,
-                           double west, double centerLong, double centerLat);
-  void GenerateKMLExtendedWithLink(const std::string& pathname, int depth, int x, int y, int tileStartX, int tileStartY, OutputPointType lowerLeft,
-                                   OutputPointType lowerRight, OutputPointType upperRight, OutputPointType upperLeft, double centerLong, double centerLat);
+  void GenerateKMLWithLink(int depth, int x, int y, int tileStartX, int tileStartY, double north, double south, double east, double west, double centerLong,
+                           double centerLat);
+  void GenerateKMLExtendedWithLink(int depth, int x, int y, int tileStartX, int tileStartY, OutputPointType lowerLeft, OutputPointType lowerRight,
+                                   OutputPointType upperRight, OutputPointType upperLeft, double centerLong, double centerLat);
 
   /** Method to create the bounding kml of the "iteration" th product */
   void GenerateBoundingKML(double north, double south, double east, double west);
@@ -237,6 +244,9 @@ private:
    */
   virtual int AddFileToKMZ(const std::ostringstream& absolutePath, const std::ostringstream& kmz_in_path);
 
+  /** Encode the tiles of a strip to JPEG in memory, in parallel */
+  std::vector<std::string> EncodeTiles(const StripImageType* strip);
+
   /**Cut the image file name to built the directory name*/
   std::string GetCuttenFileName(const std::string& description, unsigned int idx);
 
@@ -278,6 +288,9 @@ private:
   int          m_CurrentDepth;
   unsigned int m_CurIdx;
 
+  // Kml of the last generated tile
+  std::string m_TileKml;
+
   // KMZ file
 
   kmlengine::KmzFilePtr m_KmzFile;
@@ -21,11 +21,19 @@
 #ifndef otbKmzProductWriter_hxx
 #define otbKmzProductWriter_hxx
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+#include <mutex>
 #include <string>
 
 #include "otbKmzProductWriter.h"
+#include "otbConfigurationManager.h"
 #include "itksys/SystemTools.hxx"
 
+#include "gdal_priv.h"
+#include "cpl_vsi.h"
+
 #include "otbMetaDataKey.h"
 #include "otbVectorDataKeywordlist.h"
 
@@ -275,6 +283,12 @@ void KmzProductWriter<TInputImage>::Tiling()
   SizeType  extractSize;
   IndexType extractIndex;
 
+  // The root and bounding box kml are written next to the kmz
+  if (!itksys::SystemTools::MakeDirectory(m_Path))
+  {
+    itkExceptionMacro(<< "Error while creating cache directory" << m_Path);
+  }
+
   for (unsigned int depth = 0; depth <= maxDepth; depth++)
   {
     // update the attribute value Current Depth
@@ -344,73 +358,39 @@ void KmzProductWriter<TInputImage>::Tiling()
     sizeX = size[0];
     sizeY = size[1];
 
-    // Tiling resample image
-    for (unsigned int tx = 0, x = 0; tx < sizeX; tx += m_TileSize, ++x)
+    // Tiling resample image by strips of tiles: each strip is computed by a
+    // single request, then its tiles are encoded in parallel
+    for (unsigned int ty = 0, y = 0; ty < sizeY; ty += m_TileSize, ++y)
     {
-      for (unsigned int ty = 0, y = 0; ty < sizeY; ty += m_TileSize, ++y)
-      {
-        if ((tx + m_TileSize) >= sizeX)
-        {
-          extractIndex[0] = tx;
-          extractSize[0]  = sizeX - tx;
-        }
-        else
-        {
-          extractIndex[0] = tx;
-          extractSize[0]  = m_TileSize;
-        }
+      // Extract ROI
+      m_VectorImageExtractROIFilter = VectorImageExtractROIFilterType::New();
 
-        if ((ty + m_TileSize) >= sizeY)
-        {
-          extractIndex[1] = ty;
-          extractSize[1]  = sizeY - ty;
-        }
-        else
-        {
-          extractIndex[1] = ty;
-          extractSize[1]  = m_TileSize;
-        }
+      // Set extract roi parameters
+      m_VectorImageExtractROIFilter->SetStartX(0);
+      m_VectorImageExtractROIFilter->SetStartY(ty);
+      m_VectorImageExtractROIFilter->SetSizeX(sizeX);
+      m_VectorImageExtractROIFilter->SetSizeY(std::min(m_TileSize, sizeY - ty));
 
-        // Generate pathname
-        if (!itksys::SystemTools::MakeDirectory(m_Path))
-        {
-          itkExceptionMacro(<< "Error while creating cache directory" << m_Path);
-        }
-        std::ostringstream path;
-        path << m_Path;
-
-        // Generate Tile filename
-        std::ostringstream ossFileName;
-        ossFileName << m_Path;
-        ossFileName << "/";
-        ossFileName << y;
-        ossFileName << ".jpg";
-
-        // Extract ROI
-        m_VectorImageExtractROIFilter = VectorImageExtractROIFilterType::New();
-
-        // Set extract roi parameters
-        m_VectorImageExtractROIFilter->SetStartX(extractIndex[0]);
-        m_VectorImageExtractROIFilter->SetStartY(extractIndex[1]);
-        m_VectorImageExtractROIFilter->SetSizeX(extractSize[0]);
-        m_VectorImageExtractROIFilter->SetSizeY(extractSize[1]);
-
-        // Set Channel to extract
-        if (m_VectorImage->GetNumberOfComponentsPerPixel() > 3)
-        {
-          m_VectorImageExtractROIFilter->SetChannel(1); // m_ProductVector[m_CurrentProduct].m_Composition[0] + 1);
-          m_VectorImageExtractROIFilter->SetChannel(2); // m_ProductVector[m_CurrentProduct].m_Composition[1] + 1);
-          m_VectorImageExtractROIFilter->SetChannel(3); // m_ProductVector[m_CurrentProduct].m_Composition[2] + 1);
-        }
+      // Set Channel to extract
+      if (m_VectorImage->GetNumberOfComponentsPerPixel() > 3)
+      {
+        m_VectorImageExtractROIFilter->SetChannel(1); // m_ProductVector[m_CurrentProduct].m_Composition[0] + 1);
+        m_VectorImageExtractROIFilter->SetChannel(2); // m_ProductVector[m_CurrentProduct].m_Composition[1] + 1);
+        m_VectorImageExtractROIFilter->SetChannel(3); // m_ProductVector[m_CurrentProduct].m_Composition[2] + 1);
+      }
+
+      // Set extract roi input
+      m_VectorImageExtractROIFilter->SetInput(m_ResampleVectorImage);
+      m_VectorImageExtractROIFilter->Update();
 
-        // Set extract roi input
-        m_VectorImageExtractROIFilter->SetInput(m_ResampleVectorImage);
+      const std::vector<std::string> jpegTiles = this->EncodeTiles(m_VectorImageExtractROIFilter->GetOutput());
 
-        // Configure writer
-        m_VectorWriter = VectorWriterType::New();
-        m_VectorWriter->SetFileName(ossFileName.str());
-        m_VectorWriter->SetInput(m_VectorImageExtractROIFilter->GetOutput());
-        m_VectorWriter->Update();
+      for (unsigned int tx = 0, x = 0; tx < sizeX; tx += m_TileSize, ++x)
+      {
+        extractIndex[0] = tx;
+        extractSize[0]  = std::min(m_TileSize, sizeX - tx);
+        extractIndex[1] = ty;
+        extractSize[1]  = std::min(m_TileSize, sizeY - ty);
 
         /** TODO : Generate KML for this tile */
         // Search Lat/Lon box
@@ -500,11 +480,11 @@ void KmzProductWriter<TInputImage>::Tiling()
         {
           if (!m_UseExtendMode) // Extended format
           {
-            this->GenerateKML(path.str(), depth, x, y, north, south, east, west);
+            this->GenerateKML(depth, x, y, north, south, east, west);
           }
           else
           {
-            this->GenerateKMLExtended(path.str(), depth, x, y, lowerLeftCorner, lowerRightCorner, upperRightCorner, upperLeftCorner);
+            this->GenerateKMLExtended(depth, x, y, lowerLeftCorner, lowerRightCorner, upperRightCorner, upperLeftCorner);
           }
         }
         else
@@ -516,11 +496,11 @@ void KmzProductWriter<TInputImage>::Tiling()
           // Create KML with link
           if (!m_UseExtendMode)
           {
-            this->GenerateKMLWithLink(path.str(), depth, x, y, tileXStart, tileYStart, north, south, east, west, centerLong, centerLat);
+            this->GenerateKMLWithLink(depth, x, y, tileXStart, tileYStart, north, south, east, west, centerLong, centerLat);
           }
           else
           {
-            this->GenerateKMLExtendedWithLink(path.str(), depth, x, y, tileXStart, tileYStart, lowerLeftCorner, lowerRightCorner, upperRightCorner,
+            this->GenerateKMLExtendedWithLink(depth, x, y, tileXStart, tileYStart, lowerLeftCorner, lowerRightCorner, upperRightCorner,
                                               upperLeftCorner, centerLong, centerLat);
           }
         }
@@ -537,26 +517,14 @@ void KmzProductWriter<TInputImage>::Tiling()
           this->BoundingBoxKmlProcess(north, south, east, west);
         }
 
-        // Add the files to the kmz file
+        // Add the tile and its kml to the kmz file
         // Relative path to the root directory  in the kmz file
         std::ostringstream jpg_in_kmz, kml_in_kmz;
         jpg_in_kmz << m_CurrentImageName << "/" << depth << "/" << x << "/" << y << ".jpg";
         kml_in_kmz << m_CurrentImageName << "/" << depth << "/" << x << "/" << y << m_KmlExtension;
 
-        // Absolute path where are stored the files
-        std::ostringstream jpg_absolute_path, kml_absolute_path;
-        jpg_absolute_path << m_Path << "/" << y << ".jpg";
-        kml_absolute_path << m_Path << "/" << y << m_KmlExtension;
-
-        // Add the files to the kmz
-        this->AddFileToKMZ(jpg_absolute_path, jpg_in_kmz);
-        this->AddFileToKMZ(kml_absolute_path, kml_in_kmz);
-
-        // Remove the unnecessary files with stdio method :remove
-        if (remove(kml_absolute_path.str().c_str()) || remove(jpg_absolute_path.str().c_str()))
-        {
-          itkExceptionMacro(<< "Error while deleting the file" << kml_absolute_path.str() << "or file " << jpg_absolute_path.str());
-        }
+        m_KmzFile->AddFile(jpegTiles[x], jpg_in_kmz.str());
+        m_KmzFile->AddFile(m_TileKml, kml_in_kmz.str());
       }
     }
   }
@@ -586,6 +554,77 @@ int KmzProductWriter<TInputImage>::AddFileToKMZ(const std::ostringstream& absolu
 }
 
 
+template <class TInputImage>
+std::vector<std::string> KmzProductWriter<TInputImage>::EncodeTiles(const StripImageType* strip)
+{
+  const unsigned int width   = strip->GetBufferedRegion().GetSize()[0];
+  const unsigned int height  = strip->GetBufferedRegion().GetSize()[1];
+  const unsigned int nbBands = strip->GetNumberOfComponentsPerPixel();
+  const unsigned int nbTiles = (width + m_TileSize - 1) / m_TileSize;
+  OutputPixelType*   buffer  = const_cast<OutputPixelType*>(strip->GetBufferPointer());
+
+  GDALDriver* memDriver  = GetGDALDriverManager()->GetDriverByName("MEM");
+  GDALDriver* jpegDriver = GetGDALDriverManager()->GetDriverByName("JPEG");
+  if (memDriver == nullptr || jpegDriver == nullptr)
+  {
+    itkExceptionMacro(<< "GDAL MEM and JPEG drivers are needed to encode the tiles");
+  }
+
+  std::vector<std::string>  tiles(nbTiles);
+  std::atomic<unsigned int> next(0);
+  std::mutex                errorMutex;
+  std::string               errors;
+
+  // Each tile is copied into a MEM dataset and encoded by the JPEG driver
+  // into a /vsimem/ file, whose buffer is then taken over
+  auto worker = [&]() {
+    for (unsigned int x = next++; x < nbTiles; x = next++)
+    {
+      const unsigned int tileWidth = std::min(m_TileSize, width - x * m_TileSize);
+      GDALDataset*       tile      = memDriver->Create("", tileWidth, height, nbBands, GDT_Byte, nullptr);
+      CPLErr             err       = tile->RasterIO(GF_Write, 0, 0, tileWidth, height, buffer + x * m_TileSize * nbBands, tileWidth, height, GDT_Byte, nbBands,
+                                                    nullptr, nbBands, static_cast<GSpacing>(nbBands) * width, 1, nullptr);
+
+      std::ostringstream jpegName;
+      jpegName << "/vsimem/kmz_" << this << "_" << x << ".jpg";
+      GDALDataset* jpeg = err == CE_None ? jpegDriver->CreateCopy(jpegName.str().c_str(), tile, FALSE, nullptr, nullptr, nullptr) : nullptr;
+      GDALClose(tile);
+      if (jpeg == nullptr)
+      {
+        std::lock_guard<std::mutex> lock(errorMutex);
+        errors += std::string(" ") + CPLGetLastErrorMsg();
+        continue;
+      }
+      GDALClose(jpeg);
+
+      vsi_l_offset length = 0;
+      GByte*       data   = VSIGetMemFileBuffer(jpegName.str().c_str(), &length, TRUE);
+      tiles[x].assign(reinterpret_cast<const char*>(data), length);
+      CPLFree(data);
+      VSIUnlink((jpegName.str() + ".aux.xml").c_str());
+    }
+  };
+
+  const unsigned int             nbTasks = std::max(1u, std::min<unsigned int>(ConfigurationManager::GetAvailableThreads(), nbTiles));
+  std::vector<std::future<void>> tasks;
+  for (unsigned int task = 1; task < nbTasks; ++task)
+  {
+    tasks.push_back(std::async(std::launch::async, worker));
+  }
+  worker();
+  for (auto& task : tasks)
+  {
+    task.get();
+  }
+
+  if (!errors.empty())
+  {
+    itkExceptionMacro(<< "Error while encoding the tiles:" << errors);
+  }
+  return tiles;
+}
+
+
 /**
  * Actually the root kml is not fully generated :
  * It generates only the part till the network link
@@ -824,14 +863,10 @@ void KmzProductWriter<TInputImage>::AddLegendToRootKml(double north, double sout
 
 
 template <class TInputImage>
-void KmzProductWriter<TInputImage>::GenerateKMLExtended(const std::string& pathname, int depth, int itkNotUsed(x), int y, OutputPointType lowerLeft,
-                                                        OutputPointType lowerRight, OutputPointType upperRight, OutputPointType upperLeft)
+void KmzProductWriter<TInputImage>::GenerateKMLExtended(int depth, int itkNotUsed(x), int y, OutputPointType lowerLeft, OutputPointType lowerRight,
+                                                        OutputPointType upperRight, OutputPointType upperLeft)
 {
-  std::ostringstream kmlname;
-  kmlname << pathname;
-  kmlname << "/";
-  kmlname << y << "xt.kml";
-  std::ofstream fileTest(kmlname.str());
+  std::ostringstream fileTest;
 
   fileTest << std::fixed << std::setprecision(6);
 
@@ -872,19 +907,14 @@ void KmzProductWriter<TInputImage>::GenerateKMLExtended(const std::string& pathn
   fileTest << "\t</Document>" << std::endl;
   fileTest << "</kml>" << std::endl;
 
-  fileTest.close();
+  m_TileKml = fileTest.str();
 }
 
 
 template <class TInputImage>
-void KmzProductWriter<TInputImage>::GenerateKML(const std::string& pathname, int depth, int itkNotUsed(x), int y, double north, double south, double east,
-                                                double west)
+void KmzProductWriter<TInputImage>::GenerateKML(int depth, int itkNotUsed(x), int y, double north, double south, double east, double west)
 {
-  std::ostringstream kmlname;
-  kmlname << pathname;
-  kmlname << "/";
-  kmlname << y << ".kml";
-  std::ofstream fileTest(kmlname.str());
+  std::ostringstream fileTest;
 
   fileTest << std::fixed << std::setprecision(6);
 
@@ -924,19 +954,15 @@ void KmzProductWriter<TInputImage>::GenerateKML(const std::string& pathname, int
   fileTest << "\t</Document>" << std::endl;
   fileTest << "</kml>" << std::endl;
 
-  fileTest.close();
+  m_TileKml = fileTest.str();
 }
 
 template <class TInputImage>
-void KmzProductWriter<TInputImage>::GenerateKMLExtendedWithLink(const std::string& pathname, int depth, int itkNotUsed(x), int y, int tileStartX,
-                                                                int tileStartY, OutputPointType lowerLeft, OutputPointType lowerRight,
-                                                                OutputPointType upperRight, OutputPointType upperLeft, double centerLong, double centerLat)
+void KmzProductWriter<TInputImage>::GenerateKMLExtendedWithLink(int depth, int itkNotUsed(x), int y, int tileStartX, int tileStartY, OutputPointType lowerLeft,
+                                                                OutputPointType lowerRight, OutputPointType upperRight, OutputPointType upperLeft,
+                                                                double centerLong, double centerLat)
 {
-  std::ostringstream kmlname;
-  kmlname << pathname;
-  kmlname << "/";
-  kmlname << y << "xt.kml";
-  std::ofstream fileTest(kmlname.str());
+  std::ostringstream fileTest;
 
   fileTest << std::fixed << std::setprecision(6);
 
@@ -1105,18 +1131,14 @@ void KmzProductWriter<TInputImage>::GenerateKMLExtendedWithLink(const std::strin
 
   fileTest << "\t</Document>" << std::endl;
   fileTest << "</kml>" << std::endl;
-  fileTest.close();
+  m_TileKml = fileTest.str();
 }
 
 template <class TInputImage>
-void KmzProductWriter<TInputImage>::GenerateKMLWithLink(const std::string& pathname, int depth, int itkNotUsed(x), int y, int tileStartX, int tileStartY,
-                                                        double north, double south, double east, double west, double centerLong, double centerLat)
+void KmzProductWriter<TInputImage>::GenerateKMLWithLink(int depth, int itkNotUsed(x), int y, int tileStartX, int tileStartY, double north, double south,
+                                                        double east, double west, double centerLong, double centerLat)
 {
-  std::ostringstream kmlname;
-  kmlname << pathname;
-  kmlname << "/";
-  kmlname << y << ".kml";
-  std::ofstream fileTest(kmlname.str());
+  std::ostringstream fileTest;
 
   fileTest << std::fixed << std::setprecision(6);
 
@@ -1289,7 +1311,7 @@ void KmzProductWriter<TInputImage>::GenerateKMLWithLink(const std::string& pathn
 
   fileTest << "\t</Document>" << std::endl;
   fileTest << "</kml>" << std::endl;
-  fileTest.close();
+  m_TileKml = fileTest.str();
 }
 
 
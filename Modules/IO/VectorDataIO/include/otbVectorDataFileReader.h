@@ -79,6 +79,11 @@ public:
  * raw binary format) have no accepted suffix, so you will have to
  * manually create the VectorDataIO instance of the write type.
  *
+ * As image readers only read the requested region, a spatial filter can
+ * restrict the reading to the features intersecting a rectangle, with
+ * VectorDataIO supporting it (OGR formats). Other formats read the whole
+ * file.
+ *
  * \sa VectorDataIOBase
  *
  */
@@ -119,6 +124,13 @@ public:
   void SetVectorDataIO(VectorDataIOBaseType* vectorDataIO);
   itkGetObjectMacro(VectorDataIO, VectorDataIOBaseType);
 
+  /** Only read the features intersecting the rectangle [lower, upper], in the
+   * coordinates of the file */
+  void SetSpatialFilter(const PointType& lower, const PointType& upper);
+
+  /** Read all the features (default) */
+  void ClearSpatialFilter();
+
   /** Prepare the allocation of the output vector data during the first back
    * propagation of the pipeline. */
   void GenerateOutputInformation(void) override;
@@ -138,6 +150,10 @@ protected:
 
   std::string m_FileName; // The file to be read
 
+  bool      m_UseSpatialFilter;
+  PointType m_SpatialFilterLower;
+  PointType m_SpatialFilterUpper;
+
 private:
   VectorDataFileReader(const Self&) = delete;
   void operator=(const Self&) = delete;
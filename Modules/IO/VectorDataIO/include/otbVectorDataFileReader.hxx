@@ -38,8 +38,30 @@ namespace otb
  * Constructor
  */
 template <class TOutputVectorData>
-VectorDataFileReader<TOutputVectorData>::VectorDataFileReader() : m_VectorDataIO(nullptr), m_UserSpecifiedVectorDataIO(false), m_FileName("")
+VectorDataFileReader<TOutputVectorData>::VectorDataFileReader()
+  : m_VectorDataIO(nullptr), m_UserSpecifiedVectorDataIO(false), m_FileName(""), m_UseSpatialFilter(false)
 {
+  m_SpatialFilterLower.Fill(0.);
+  m_SpatialFilterUpper.Fill(0.);
+}
+
+template <class TOutputVectorData>
+void VectorDataFileReader<TOutputVectorData>::SetSpatialFilter(const PointType& lower, const PointType& upper)
+{
+  m_UseSpatialFilter   = true;
+  m_SpatialFilterLower = lower;
+  m_SpatialFilterUpper = upper;
+  this->Modified();
+}
+
+template <class TOutputVectorData>
+void VectorDataFileReader<TOutputVectorData>::ClearSpatialFilter()
+{
+  if (m_UseSpatialFilter)
+  {
+    m_UseSpatialFilter = false;
+    this->Modified();
+  }
 }
 
 /**
@@ -188,6 +210,28 @@ void VectorDataFileReader<TOutputVectorData>::GenerateData()
 
   m_VectorDataIO->SetFileName(m_FileName);
 
+  if (m_UseSpatialFilter)
+  {
+    VectorDataIOBaseType::PointType lower, upper;
+    lower.Fill(0.);
+    upper.Fill(0.);
+    const unsigned int dimension = (VDimension < VectorDataIOBaseType::VDimension) ? VDimension : VectorDataIOBaseType::VDimension;
+    for (unsigned int i = 0; i < dimension; ++i)
+    {
+      lower[i] = m_SpatialFilterLower[i];
+      upper[i] = m_SpatialFilterUpper[i];
+    }
+    m_VectorDataIO->SetSpatialFilter(lower, upper);
+    if (!m_VectorDataIO->CanSpatialFilterRead())
+    {
+      otbWarningMacro(<< "The spatial filter is not supported by " << m_VectorDataIO->GetNameOfClass() << ", the whole file is read");
+    }
+  }
+  else
+  {
+    m_VectorDataIO->ClearSpatialFilter();
+  }
+
   // Tell the VectorDataIO to read the file
   //
 
@@ -0,0 +1,92 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbVectorDataFileReader.h"
+#include "otbVectorData.h"
+#include "itkPreOrderTreeIterator.h"
+
+namespace
+{
+typedef otb::VectorData<>                         VectorDataType;
+typedef otb::VectorDataFileReader<VectorDataType> VectorDataFileReaderType;
+typedef VectorDataType::DataTreeType              DataTreeType;
+
+// Count the geometries of the vector data, and get the first vertex of a line
+unsigned int CountFeatures(VectorDataType* data, VectorDataType::PointType& firstVertex, bool& foundVertex)
+{
+  unsigned int                            count = 0;
+  itk::PreOrderTreeIterator<DataTreeType> it(data->GetDataTree());
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    if (it.Get()->IsPointFeature() || it.Get()->IsLineFeature() || it.Get()->IsPolygonFeature())
+    {
+      ++count;
+    }
+    if (!foundVertex && it.Get()->IsLineFeature() && it.Get()->GetLine()->GetVertexList()->Size() > 0)
+    {
+      const VectorDataType::LineType::VertexType& vertex = it.Get()->GetLine()->GetVertexList()->GetElement(0);
+      firstVertex[0]                                     = vertex[0];
+      firstVertex[1]                                     = vertex[1];
+      foundVertex                                        = true;
+    }
+  }
+  return count;
+}
+}
+
+int otbVectorDataFileReaderSpatialFilter(int itkNotUsed(argc), char* argv[])
+{
+  VectorDataType::PointType         vertex;
+  bool                              foundVertex = false;
+  VectorDataFileReaderType::Pointer reader      = VectorDataFileReaderType::New();
+  reader->SetFileName(argv[1]);
+  reader->Update();
+  const unsigned int nbFeatures = CountFeatures(reader->GetOutput(), vertex, foundVertex);
+
+  if (!foundVertex)
+  {
+    std::cerr << "No line found in " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Read the features around a vertex of the first line only
+  const double              radius = atof(argv[2]);
+  VectorDataType::PointType lower, upper;
+  lower[0] = vertex[0] - radius;
+  lower[1] = vertex[1] - radius;
+  upper[0] = vertex[0] + radius;
+  upper[1] = vertex[1] + radius;
+
+  VectorDataFileReaderType::Pointer filteredReader = VectorDataFileReaderType::New();
+  filteredReader->SetFileName(argv[1]);
+  filteredReader->SetSpatialFilter(lower, upper);
+  filteredReader->Update();
+  bool               keepVertex         = true;
+  const unsigned int nbFilteredFeatures = CountFeatures(filteredReader->GetOutput(), vertex, keepVertex);
+
+  std::cout << nbFilteredFeatures << " of " << nbFeatures << " features read with the spatial filter" << std::endl;
+  if (nbFilteredFeatures == 0 || nbFilteredFeatures > nbFeatures)
+  {
+    std::cerr << "Wrong number of features read with the spatial filter" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,7 @@ void RegisterTests()
   REGISTER_TEST(otbVectorDataIOFactory);
   REGISTER_TEST(otbVectorDataFileWriterMultiPolygons);
   REGISTER_TEST(otbVectorDataFileReader);
+  REGISTER_TEST(otbVectorDataFileReaderSpatialFilter);
   REGISTER_TEST(otbVectorDataFileGeoReaderWriter);
   REGISTER_TEST(otbVectorDataFileWriter);
 }
@@ -57,6 +57,10 @@ namespace otb
  *       "Application of Dempster-Shafer theory in condition monitoring systems: A case study,"
  *        Pattern Recognition Letters, vol. 22 (6-7): pp. 777-785,
  *        2001.
+ *  The fused label only depends on the labels of the classifiers. When there are at most
+ *  MaximumLUTSize combinations of the labels of the universe and of the no data label, the fused
+ *  labels of all of them are computed once before the threads start. The other label vectors are
+ *  combined on the fly, and remembered in each thread region.
  *
  *
  *  \sa MassOfBelief
@@ -104,6 +108,10 @@ public:
   typedef typename std::map<LabelType, unsigned int> ClassifierHistogramType;
   typedef typename std::vector<LabelMassMapType> VectorOfMapOfMassesOfBeliefType;
 
+  /** Set/Get the maximum number of label combinations fused beforehand, 65536 by default */
+  itkSetMacro(MaximumLUTSize, unsigned long);
+  itkGetMacro(MaximumLUTSize, unsigned long);
+
 
   /** Set/Get the m_LabelForNoDataPixels */
   itkSetMacro(LabelForNoDataPixels, LabelType);
@@ -163,6 +171,13 @@ private:
   VectorOfMapOfMassesOfBeliefType m_VectorOfMapMOBs;
   std::vector<MassType>           m_VectorOfUniverseMOBs;
 
+  /** Index of each label of the universe and of the no data label in the LUT */
+  std::map<LabelType, unsigned int> m_LUTLabelIndices;
+  /** Fused label of each combination of the labels of m_LUTLabelIndices,
+   * empty if there are more than m_MaximumLUTSize combinations */
+  std::vector<LabelType> m_FusedLabelsLUT;
+  unsigned long          m_MaximumLUTSize;
+
   /** No Data label for invalid pixels (when using a mask) */
   LabelType m_LabelForNoDataPixels;
   /** Undecided label for pixels with NOT unique DS voting */
@@ -42,6 +42,7 @@ DSFusionOfClassifiersImageFilter<TInputImage, TOutputImage, TMaskImage>::DSFusio
   this->m_Universe.clear();
   this->m_LabelForNoDataPixels    = itk::NumericTraits<LabelType>::ZeroValue();
   this->m_LabelForUndecidedPixels = itk::NumericTraits<LabelType>::ZeroValue();
+  this->m_MaximumLUTSize          = 65536;
 }
 
 /* ************************************************************************************************************** */
@@ -144,6 +145,51 @@ void DSFusionOfClassifiersImageFilter<TInputImage, TOutputImage, TMaskImage>::Be
   }
 
   m_NumberOfClassesInUniverse = m_Universe.size();
+
+  // *****************************************************************************************************
+  // Fused label of each combination of the labels of the UNIVERSE and of the no data label
+  // *****************************************************************************************************
+  m_LUTLabelIndices.clear();
+  m_FusedLabelsLUT.clear();
+
+  std::vector<LabelType> lutLabels;
+  for (typename ClassifierHistogramType::const_iterator itUniverse = m_Universe.begin(); itUniverse != m_Universe.end(); ++itUniverse)
+  {
+    lutLabels.push_back(itUniverse->first);
+  }
+  if (m_Universe.count(m_LabelForNoDataPixels) == 0)
+  {
+    lutLabels.push_back(m_LabelForNoDataPixels);
+  }
+
+  unsigned long lutSize = m_NumberOfClassifiers > 0 ? 1 : 0;
+  for (unsigned int itClk = 0; itClk < m_NumberOfClassifiers && lutSize <= m_MaximumLUTSize; ++itClk)
+  {
+    lutSize *= lutLabels.size();
+  }
+  if (lutSize == 0 || lutSize > m_MaximumLUTSize)
+  {
+    return;
+  }
+
+  for (unsigned int index = 0; index < lutLabels.size(); ++index)
+  {
+    m_LUTLabelIndices[lutLabels[index]] = index;
+  }
+
+  // The first classifier varies the fastest
+  PixelType vectorPixelValue(m_NumberOfClassifiers);
+  m_FusedLabelsLUT.resize(lutSize);
+  for (unsigned long lutIndex = 0; lutIndex < lutSize; ++lutIndex)
+  {
+    unsigned long rest = lutIndex;
+    for (unsigned int itClk = 0; itClk < m_NumberOfClassifiers; ++itClk)
+    {
+      vectorPixelValue[itClk] = static_cast<InternalPixelType>(lutLabels[rest % lutLabels.size()]);
+      rest /= lutLabels.size();
+    }
+    m_FusedLabelsLUT[lutIndex] = this->OptimizedDSMassCombination(vectorPixelValue);
+  }
 }
 
 
@@ -179,7 +225,9 @@ DSFusionOfClassifiersImageFilter<TInputImage, TOutputImage, TMaskImage>::Optimiz
       // Extracting the masses of belief of the three focal elements {Ai}, {Ai_} and OMEGA = {Ai U Ai_} = UNIVERSE
       // of the k^th classifier itClk
       mUniverseClk  = m_VectorOfUniverseMOBs[itClk];         // MOB_Clk(OMEGA)
-      mLabelSetClk  = m_VectorOfMapMOBs[itClk][classLabelk]; // MOB_Clk({Ai})
+      // (no insertion in the map, since the threads share it)
+      typename LabelMassMapType::const_iterator itMOB = m_VectorOfMapMOBs[itClk].find(classLabelk);
+      mLabelSetClk  = (itMOB != m_VectorOfMapMOBs[itClk].end()) ? itMOB->second : 0.; // MOB_Clk({Ai})
       mLabelSetClk_ = 1 - mLabelSetClk - mUniverseClk;       // MOB_Clk({Ai_})
 
       /*std::cout << "vectorPixelValue[" << itClk << "] = " << classLabelk;
@@ -490,6 +538,10 @@ void DSFusionOfClassifiersImageFilter<TInputImage, TOutputImage, TMaskImage>::Th
 
   bool validPoint = true;
 
+  // Fused labels of the label vectors outside of the LUT
+  std::map<std::vector<LabelType>, LabelType> fusedLabelsCache;
+  std::vector<LabelType>                      labels(m_NumberOfClassifiers);
+
   // Walk the part of the image
   for (inIt.GoToBegin(), outIt.GoToBegin(); !inIt.IsAtEnd() && !outIt.IsAtEnd(); ++inIt, ++outIt)
   {
@@ -503,7 +555,33 @@ void DSFusionOfClassifiersImageFilter<TInputImage, TOutputImage, TMaskImage>::Th
     if (validPoint)
     {
       // Over ALL the i components inIt.Get()[i] of the input vector pixel (with i between 0 and m_NumberOfClassifiers)
-      outIt.Set(this->OptimizedDSMassCombination(inIt.Get()));
+      const PixelType vectorPixelValue = inIt.Get();
+      bool            inLUT            = !m_FusedLabelsLUT.empty();
+      unsigned long   lutIndex         = 0;
+      for (int itClk = m_NumberOfClassifiers - 1; itClk >= 0; --itClk)
+      {
+        labels[itClk] = vectorPixelValue[itClk];
+        if (inLUT)
+        {
+          typename std::map<LabelType, unsigned int>::const_iterator itIndex = m_LUTLabelIndices.find(labels[itClk]);
+          inLUT    = itIndex != m_LUTLabelIndices.end();
+          lutIndex = lutIndex * m_LUTLabelIndices.size() + (inLUT ? itIndex->second : 0);
+        }
+      }
+
+      if (inLUT)
+      {
+        outIt.Set(m_FusedLabelsLUT[lutIndex]);
+      }
+      else
+      {
+        typename std::map<std::vector<LabelType>, LabelType>::const_iterator itCache = fusedLabelsCache.find(labels);
+        if (itCache == fusedLabelsCache.end())
+        {
+          itCache = fusedLabelsCache.insert(std::make_pair(labels, this->OptimizedDSMassCombination(vectorPixelValue))).first;
+        }
+        outIt.Set(itCache->second);
+      }
     }
     else
     {
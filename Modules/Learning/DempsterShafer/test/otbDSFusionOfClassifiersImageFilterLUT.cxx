@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbDSFusionOfClassifiersImageFilter.h"
+#include "otbVectorImage.h"
+#include "otbImage.h"
+#include "itkImageRegionConstIterator.h"
+
+
+int otbDSFusionOfClassifiersImageFilterLUT(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef unsigned short                    LabelType;
+  typedef otb::VectorImage<LabelType, 2>    VectorImageType;
+  typedef otb::Image<LabelType, 2>          OutputImageType;
+  typedef otb::DSFusionOfClassifiersImageFilter<VectorImageType, OutputImageType, OutputImageType> DSFusionOfClassifiersImageFilterType;
+  typedef DSFusionOfClassifiersImageFilterType::VectorOfMapOfMassesOfBeliefType VectorOfMapOfMassesOfBeliefType;
+  typedef DSFusionOfClassifiersImageFilterType::LabelMassMapType LabelMassMapType;
+
+  const unsigned int nbClassifiers = 3;
+  const LabelType    noDataLabel   = 0;
+  const LabelType    undecidedLabel = 10;
+
+  // Labels 1, 2 and 3 in the universe, label 7 outside of it
+  const LabelType labels[5] = {noDataLabel, 1, 2, 3, 7};
+
+  VectorOfMapOfMassesOfBeliefType vectorOfMapOfMassesOfBelief(nbClassifiers);
+  for (unsigned int itClk = 0; itClk < nbClassifiers; ++itClk)
+  {
+    LabelMassMapType& masses = vectorOfMapOfMassesOfBelief[itClk];
+    masses[1]                = 0.9 - 0.2 * itClk;
+    masses[2]                = 0.5 + 0.15 * itClk;
+    masses[3]                = 0.7;
+  }
+
+  VectorImageType::Pointer    input = VectorImageType::New();
+  VectorImageType::RegionType region;
+  region.SetSize(0, 25);
+  region.SetSize(1, 5);
+  input->SetRegions(region);
+  input->SetNumberOfComponentsPerPixel(nbClassifiers);
+  input->Allocate();
+
+  // Every combination of the labels
+  VectorImageType::PixelType pixel(nbClassifiers);
+  for (unsigned int x = 0; x < 25; ++x)
+  {
+    for (unsigned int y = 0; y < 5; ++y)
+    {
+      pixel[0] = labels[x % 5];
+      pixel[1] = labels[x / 5];
+      pixel[2] = labels[y];
+
+      VectorImageType::IndexType index;
+      index[0] = x;
+      index[1] = y;
+      input->SetPixel(index, pixel);
+    }
+  }
+
+  OutputImageType::Pointer outputs[2];
+  for (unsigned int itLUT = 0; itLUT < 2; ++itLUT)
+  {
+    DSFusionOfClassifiersImageFilterType::Pointer filter = DSFusionOfClassifiersImageFilterType::New();
+    filter->SetInput(input);
+    filter->SetInputMapsOfMassesOfBelief(&vectorOfMapOfMassesOfBelief);
+    filter->SetLabelForNoDataPixels(noDataLabel);
+    filter->SetLabelForUndecidedPixels(undecidedLabel);
+    if (itLUT == 1)
+    {
+      filter->SetMaximumLUTSize(0);
+    }
+    filter->Update();
+    outputs[itLUT] = filter->GetOutput();
+
+    // Compare with the combination of each pixel
+    itk::ImageRegionConstIterator<VectorImageType> inIt(input, region);
+    itk::ImageRegionConstIterator<OutputImageType> outIt(outputs[itLUT], region);
+    for (inIt.GoToBegin(), outIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++outIt)
+    {
+      if (outIt.Get() != filter->OptimizedDSMassCombination(inIt.Get()))
+      {
+        std::cerr << "Wrong fused label " << outIt.Get() << " for the labels " << inIt.Get() << " at " << inIt.GetIndex() << " (LUT "
+                  << (itLUT == 0 ? "enabled" : "disabled") << ")" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  itk::ImageRegionConstIterator<OutputImageType> it0(outputs[0], region);
+  itk::ImageRegionConstIterator<OutputImageType> it1(outputs[1], region);
+  for (it0.GoToBegin(), it1.GoToBegin(); !it0.IsAtEnd(); ++it0, ++it1)
+  {
+    if (it0.Get() != it1.Get())
+    {
+      std::cerr << "The fused labels with and without the LUT differ at " << it0.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -31,6 +31,7 @@ void RegisterTests()
   REGISTER_TEST(otbDempsterShaferFusionOptRecConfMatFileTest);
   REGISTER_TEST(otbDempsterShaferFusionConfMatFileTest);
   REGISTER_TEST(otbDSFusionOfClassifiersImageFilterTest);
+  REGISTER_TEST(otbDSFusionOfClassifiersImageFilterLUT);
   REGISTER_TEST(otbJointMassOfBeliefFilter);
   REGISTER_TEST(otbJointMassOfBeliefFilterLimit);
   REGISTER_TEST(otbMassOfBelief);
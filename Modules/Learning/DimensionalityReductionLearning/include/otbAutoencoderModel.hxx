@@ -380,24 +380,21 @@ void AutoencoderModel<TInputValue, NeuronType>::DoPredictBatch(const InputListSa
                                                                TargetListSampleType* targets, ConfidenceListSampleType* /*quality*/,
                                                                ProbaListSampleType* /*proba*/) const
 {
-  std::vector<shark::RealVector> features;
-  Shark::ListSampleRangeToSharkVector(input, features, startIndex, size);
-  shark::Data<shark::RealVector> data = shark::createDataFromRange(features);
-  TargetSampleType               target;
-  // features layer for a network containing the encoder and decoder part
-  data = m_Encoder(data);
+  shark::RealMatrix batch;
+  Shark::ListSampleRangeToSharkMatrix(input, batch, startIndex, size);
+  // The whole range is evaluated as one batch: each layer is a single
+  // matrix product instead of one matrix-vector product per sample
+  const shark::RealMatrix features = m_Encoder(batch);
 
-  unsigned int id = startIndex;
+  TargetSampleType target;
   target.SetSize(this->m_Dimension);
-
-  for (const auto& p : data.elements())
+  for (unsigned int row = 0; row < size; ++row)
   {
     for (unsigned int a = 0; a < this->m_Dimension; ++a)
     {
-      target[a] = p[a];
+      target[a] = features(row, a);
     }
-    targets->SetMeasurementVector(id, target);
-    ++id;
+    targets->SetMeasurementVector(startIndex + row, target);
   }
 }
 
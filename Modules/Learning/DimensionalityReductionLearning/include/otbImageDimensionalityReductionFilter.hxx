@@ -21,6 +21,7 @@
 #define otbImageDimensionalityReductionFilter_hxx
 
 #include "otbImageDimensionalityReductionFilter.h"
+#include "otbConfigurationManager.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
 
@@ -184,6 +185,9 @@ template <class TInputImage, class TOutputImage, class TMaskImage>
 void ImageDimensionalityReductionFilter<TInputImage, TOutputImage, TMaskImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
                                                                                                      itk::ThreadIdType threadId)
 {
+  // Models threading internally get their share of the budget
+  ConfigurationManager::ThreadBudgetScope threadBudget(this->GetNumberOfThreads());
+
   if (m_BatchMode)
   {
     this->BatchThreadedGenerateData(outputRegionForThread, threadId);
@@ -173,21 +173,20 @@ template <class TInputValue>
 void PCAModel<TInputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex, const unsigned int& size,
                                            TargetListSampleType* targets, ConfidenceListSampleType* /*quality*/, ProbaListSampleType* /*proba*/) const
 {
-  std::vector<shark::RealVector> features;
-  Shark::ListSampleRangeToSharkVector(input, features, startIndex, size);
-  shark::Data<shark::RealVector> data = shark::createDataFromRange(features);
-  TargetSampleType               target;
-  data            = m_Encoder(data);
-  unsigned int id = startIndex;
+  shark::RealMatrix batch;
+  Shark::ListSampleRangeToSharkMatrix(input, batch, startIndex, size);
+  // The whole range is projected with a single matrix product
+  const shark::RealMatrix features = m_Encoder(batch);
+
+  TargetSampleType target;
   target.SetSize(this->m_Dimension);
-  for (const auto& p : data.elements())
+  for (unsigned int row = 0; row < size; ++row)
   {
     for (unsigned int a = 0; a < this->m_Dimension; ++a)
     {
-      target[a] = p[a];
+      target[a] = features(row, a);
     }
-    targets->SetMeasurementVector(id, target);
-    ++id;
+    targets->SetMeasurementVector(startIndex + row, target);
   }
 }
 
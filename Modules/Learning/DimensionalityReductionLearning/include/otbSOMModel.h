@@ -30,6 +30,8 @@
 #include "otbMachineLearningModelTraits.h"
 #include "otbMachineLearningModel.h"
 
+#include <vector>
+
 namespace otb
 {
 
@@ -111,6 +113,15 @@ private:
 
   virtual TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  virtual void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                              ConfidenceListSampleType* quality = nullptr, ProbaListSampleType* proba = nullptr) const override;
+
+  /** Copy the neuron weights into m_FlatWeights */
+  void FlattenMap();
+
+  /** Neuron weights, one row per neuron in the buffer order of the map */
+  std::vector<double> m_FlatWeights;
+
   /** Map size (width, height) */
   SizeType m_MapSize{0,0};
   /** Number of iterations */
@@ -78,6 +78,7 @@ void SOMModel<TInputValue, MapDimension>::Train()
   estimator->SetMaxWeight(m_MaxWeight);
   estimator->Update();
   m_SOMMap = estimator->GetOutput();
+  FlattenMap();
 }
 
 template <class TInputValue, unsigned int MapDimension>
@@ -201,6 +202,7 @@ void SOMModel<TInputValue, MapDimension>::Load(const std::string& filename, cons
   }
   ifs.close();
   this->m_Dimension = MapType::ImageDimension;
+  FlattenMap();
 }
 
 template <class TInputValue, unsigned int MapDimension>
@@ -218,5 +220,76 @@ SOMModel<TInputValue, MapDimension>::DoPredict(const InputSampleType& value, Con
   return target;
 }
 
+template <class TInputValue, unsigned int MapDimension>
+void SOMModel<TInputValue, MapDimension>::FlattenMap()
+{
+  const unsigned int nbNeurons  = m_SOMMap->GetLargestPossibleRegion().GetNumberOfPixels();
+  const unsigned int nbFeatures = m_SOMMap->GetNumberOfComponentsPerPixel();
+  m_FlatWeights.resize(static_cast<std::size_t>(nbNeurons) * nbFeatures);
+
+  itk::ImageRegionConstIterator<MapType> it(m_SOMMap, m_SOMMap->GetLargestPossibleRegion());
+  auto                                   weight = m_FlatWeights.begin();
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const InputSampleType neuron = it.Get();
+    for (unsigned int i = 0; i < nbFeatures; ++i, ++weight)
+    {
+      *weight = static_cast<double>(neuron[i]);
+    }
+  }
+}
+
+/**
+ * Same winner as SOMMap::GetWinner (the last neuron at minimum distance),
+ * searched over the flattened weights: the squared distances are computed
+ * with a contiguous loop the compiler vectorizes.
+ */
+template <class TInputValue, unsigned int MapDimension>
+void SOMModel<TInputValue, MapDimension>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex, const unsigned int& size,
+                                                         TargetListSampleType* targets, ConfidenceListSampleType* /*quality*/,
+                                                         ProbaListSampleType* /*proba*/) const
+{
+  const unsigned int nbFeatures = m_SOMMap->GetNumberOfComponentsPerPixel();
+  const std::size_t  nbNeurons  = m_FlatWeights.size() / nbFeatures;
+
+  std::vector<double> sample(nbFeatures);
+  TargetSampleType    target;
+  target.SetSize(this->m_Dimension);
+
+  for (unsigned int id = startIndex; id < startIndex + size; ++id)
+  {
+    const InputSampleType& value = input->GetMeasurementVector(id);
+    for (unsigned int i = 0; i < nbFeatures; ++i)
+    {
+      sample[i] = static_cast<double>(value[i]);
+    }
+
+    const double* weight      = m_FlatWeights.data();
+    std::size_t   winner      = 0;
+    double        minDistance = itk::NumericTraits<double>::max();
+    for (std::size_t n = 0; n < nbNeurons; ++n, weight += nbFeatures)
+    {
+      double distance = 0.0;
+      for (unsigned int i = 0; i < nbFeatures; ++i)
+      {
+        const double diff = sample[i] - weight[i];
+        distance += diff * diff;
+      }
+      if (distance <= minDistance)
+      {
+        minDistance = distance;
+        winner      = n;
+      }
+    }
+
+    const typename MapType::IndexType index = m_SOMMap->ComputeIndex(winner);
+    for (unsigned int i = 0; i < this->m_Dimension; i++)
+    {
+      target[i] = index[i];
+    }
+    targets->SetMeasurementVector(id, target);
+  }
+}
+
 } // namespace otb
 #endif
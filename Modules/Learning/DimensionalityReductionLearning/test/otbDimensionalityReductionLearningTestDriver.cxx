@@ -24,6 +24,7 @@ void RegisterTests()
 {
   REGISTER_TEST(otbSOMModelCanRead);
   REGISTER_TEST(otbSOMModeTrain);
+  REGISTER_TEST(otbSOMModelPredictBatch);
 
 #ifdef OTB_USE_SHARK
   REGISTER_TEST(otbAutoencoderModelCanRead);
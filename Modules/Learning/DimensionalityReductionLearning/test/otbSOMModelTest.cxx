@@ -156,3 +156,41 @@ int otbSOMModeTrain(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbSOMModelPredictBatch(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " letter.scale model2D" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer target  = TargetListSampleType::New();
+  if (!otb::ReadDataFile(argv[1], samples, target))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  SOMModel2D::Pointer model2D = SOMModel2D::New();
+  model2D->Load(std::string(argv[2]));
+
+  // The batch search over the flattened map must select the same winners as
+  // the per-sample search
+  TargetListSampleType::Pointer batchTargets = model2D->PredictBatch(samples);
+  for (unsigned int id = 0; id < samples->Size(); ++id)
+  {
+    const SOMModel2D::TargetSampleType expected = model2D->Predict(samples->GetMeasurementVector(id));
+    const SOMModel2D::TargetSampleType result   = batchTargets->GetMeasurementVector(id);
+    for (unsigned int i = 0; i < 2; ++i)
+    {
+      if (result[i] != expected[i])
+      {
+        std::cerr << "Sample " << id << ": batch winner " << result << " differs from " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDenseSampleMatrix_h
+#define otbDenseSampleMatrix_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "itkVariableLengthVector.h"
+#include "itkListSample.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class DenseSampleMatrix
+ *  \brief Contiguous row-major storage of training samples.
+ *
+ * All the samples share one buffer of GetNumberOfSamples() rows of
+ * GetNumberOfFeatures() values, instead of one heap allocation per
+ * sample as in itk::Statistics::ListSample<itk::VariableLengthVector>.
+ *
+ * The buffer is either owned by the matrix and grows with PushBack(), or
+ * provided by the caller with SetExternalBuffer() (for instance a memory
+ * mapped file), in which case the matrix cannot be resized.
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TValue>
+class ITK_EXPORT DenseSampleMatrix : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef DenseSampleMatrix             Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(DenseSampleMatrix, itk::Object);
+
+  typedef TValue                                             ValueType;
+  typedef unsigned long                                      SampleIdentifierType;
+  typedef itk::VariableLengthVector<ValueType>               MeasurementVectorType;
+  typedef itk::Statistics::ListSample<MeasurementVectorType> ListSampleType;
+
+  /** Number of values of each sample. Can only be changed while the
+   * matrix is empty. */
+  void SetNumberOfFeatures(unsigned int nbFeatures);
+  itkGetConstMacro(NumberOfFeatures, unsigned int);
+
+  SampleIdentifierType GetNumberOfSamples() const
+  {
+    return m_NumberOfSamples;
+  }
+
+  bool HasExternalBuffer() const
+  {
+    return m_ExternalBuffer != nullptr;
+  }
+
+  /** Preallocate room for nbSamples samples */
+  void Reserve(SampleIdentifierType nbSamples);
+
+  /** Set the number of samples. New samples are zero-filled. */
+  void Resize(SampleIdentifierType nbSamples);
+
+  /** Remove all the samples, and release an external buffer */
+  void Clear();
+
+  /** Use a buffer of nbSamples x nbFeatures values managed by the caller.
+   * The buffer must outlive the matrix or the next call to Clear(). */
+  void SetExternalBuffer(ValueType* buffer, SampleIdentifierType nbSamples, unsigned int nbFeatures);
+
+  ValueType* GetBufferPointer()
+  {
+    return m_ExternalBuffer ? m_ExternalBuffer : m_Buffer.data();
+  }
+
+  const ValueType* GetBufferPointer() const
+  {
+    return m_ExternalBuffer ? m_ExternalBuffer : m_Buffer.data();
+  }
+
+  /** Pointer to the first value of sample id. Pointers are invalidated
+   * when an owned buffer grows. */
+  ValueType* GetSample(SampleIdentifierType id)
+  {
+    return GetBufferPointer() + id * m_NumberOfFeatures;
+  }
+
+  const ValueType* GetSample(SampleIdentifierType id) const
+  {
+    return GetBufferPointer() + id * m_NumberOfFeatures;
+  }
+
+  /** Append a sample of GetNumberOfFeatures() values */
+  void PushBack(const ValueType* sample);
+
+  /** Append a zero-filled sample and return a pointer to its values */
+  ValueType* PushBack();
+
+  /** Center and reduce the samples in place: x = (x - shift) / scale.
+   * Components with a null scale are set to 0, as in
+   * ShiftScaleSampleListFilter. */
+  template <class TVector>
+  void ShiftScale(const TVector& shifts, const TVector& scales);
+
+  /** Copy the samples to a ListSample, for the APIs that still need one */
+  typename ListSampleType::Pointer ToListSample() const;
+
+protected:
+  DenseSampleMatrix();
+  ~DenseSampleMatrix() override = default;
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  DenseSampleMatrix(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  unsigned int           m_NumberOfFeatures;
+  SampleIdentifierType   m_NumberOfSamples;
+  std::vector<ValueType> m_Buffer;
+  ValueType*             m_ExternalBuffer;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbDenseSampleMatrix.hxx"
+#endif
+
+#endif
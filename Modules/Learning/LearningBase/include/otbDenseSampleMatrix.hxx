@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbDenseSampleMatrix_hxx
+#define otbDenseSampleMatrix_hxx
+
+#include "otbDenseSampleMatrix.h"
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TValue>
+DenseSampleMatrix<TValue>::DenseSampleMatrix() : m_NumberOfFeatures(0), m_NumberOfSamples(0), m_ExternalBuffer(nullptr)
+{
+}
+
+template <class TValue>
+void DenseSampleMatrix<TValue>::SetNumberOfFeatures(unsigned int nbFeatures)
+{
+  if (nbFeatures == m_NumberOfFeatures)
+    return;
+  if (m_NumberOfSamples > 0)
+    itkExceptionMacro(<< "Can not change the number of features of a non empty sample matrix");
+  m_NumberOfFeatures = nbFeatures;
+  this->Modified();
+}
+
+template <class TValue>
+void DenseSampleMatrix<TValue>::Reserve(SampleIdentifierType nbSamples)
+{
+  if (m_ExternalBuffer)
+    itkExceptionMacro(<< "Can not reserve samples in an external buffer");
+  m_Buffer.reserve(nbSamples * m_NumberOfFeatures);
+}
+
+template <class TValue>
+void DenseSampleMatrix<TValue>::Resize(SampleIdentifierType nbSamples)
+{
+  if (m_ExternalBuffer)
+    itkExceptionMacro(<< "Can not resize an external buffer");
+  m_Buffer.resize(nbSamples * m_NumberOfFeatures, ValueType(0));
+  m_NumberOfSamples = nbSamples;
+  this->Modified();
+}
+
+template <class TValue>
+void DenseSampleMatrix<TValue>::Clear()
+{
+  m_Buffer.clear();
+  m_Buffer.shrink_to_fit();
+  m_ExternalBuffer  = nullptr;
+  m_NumberOfSamples = 0;
+  this->Modified();
+}
+
+template <class TValue>
+void DenseSampleMatrix<TValue>::SetExternalBuffer(ValueType* buffer, SampleIdentifierType nbSamples, unsigned int nbFeatures)
+{
+  if (buffer == nullptr)
+    itkExceptionMacro(<< "Null external buffer");
+  m_Buffer.clear();
+  m_Buffer.shrink_to_fit();
+  m_ExternalBuffer   = buffer;
+  m_NumberOfSamples  = nbSamples;
+  m_NumberOfFeatures = nbFeatures;
+  this->Modified();
+}
+
+template <class TValue>
+void DenseSampleMatrix<TValue>::PushBack(const ValueType* sample)
+{
+  if (m_ExternalBuffer)
+    itkExceptionMacro(<< "Can not append samples to an external buffer");
+  m_Buffer.insert(m_Buffer.end(), sample, sample + m_NumberOfFeatures);
+  ++m_NumberOfSamples;
+}
+
+template <class TValue>
+typename DenseSampleMatrix<TValue>::ValueType* DenseSampleMatrix<TValue>::PushBack()
+{
+  if (m_ExternalBuffer)
+    itkExceptionMacro(<< "Can not append samples to an external buffer");
+  m_Buffer.resize(m_Buffer.size() + m_NumberOfFeatures, ValueType(0));
+  return GetSample(m_NumberOfSamples++);
+}
+
+template <class TValue>
+template <class TVector>
+void DenseSampleMatrix<TValue>::ShiftScale(const TVector& shifts, const TVector& scales)
+{
+  if (shifts.Size() != m_NumberOfFeatures || scales.Size() != m_NumberOfFeatures)
+    itkExceptionMacro(<< "Inconsistent measurement vector size : " << m_NumberOfFeatures << " features, scale measurement vector size " << scales.Size()
+                      << " shift measurement vector size " << shifts.Size());
+
+  std::vector<ValueType> shift(m_NumberOfFeatures);
+  std::vector<ValueType> invertedScale(m_NumberOfFeatures);
+  for (unsigned int idx = 0; idx < m_NumberOfFeatures; ++idx)
+  {
+    shift[idx]         = static_cast<ValueType>(shifts[idx]);
+    invertedScale[idx] = scales[idx] - 1e-10 < 0. ? ValueType(0) : static_cast<ValueType>(1. / scales[idx]);
+  }
+
+  ValueType* sample = GetBufferPointer();
+  for (SampleIdentifierType id = 0; id < m_NumberOfSamples; ++id, sample += m_NumberOfFeatures)
+  {
+    for (unsigned int idx = 0; idx < m_NumberOfFeatures; ++idx)
+    {
+      sample[idx] = (sample[idx] - shift[idx]) * invertedScale[idx];
+    }
+  }
+  this->Modified();
+}
+
+template <class TValue>
+typename DenseSampleMatrix<TValue>::ListSampleType::Pointer DenseSampleMatrix<TValue>::ToListSample() const
+{
+  typename ListSampleType::Pointer listSample = ListSampleType::New();
+  listSample->SetMeasurementVectorSize(m_NumberOfFeatures);
+  listSample->Resize(m_NumberOfSamples);
+
+  MeasurementVectorType mv(m_NumberOfFeatures);
+  for (SampleIdentifierType id = 0; id < m_NumberOfSamples; ++id)
+  {
+    const ValueType* sample = GetSample(id);
+    std::copy(sample, sample + m_NumberOfFeatures, mv.GetDataPointer());
+    listSample->SetMeasurementVector(id, mv);
+  }
+  return listSample;
+}
+
+template <class TValue>
+void DenseSampleMatrix<TValue>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfSamples: " << m_NumberOfSamples << std::endl;
+  os << indent << "NumberOfFeatures: " << m_NumberOfFeatures << std::endl;
+  os << indent << "ExternalBuffer: " << (m_ExternalBuffer != nullptr) << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -22,8 +22,11 @@
 #define otbImageClassificationFilter_hxx
 
 #include "otbImageClassificationFilter.h"
+#include "otbConfigurationManager.h"
 #include "itkImageRegionIterator.h"
 #include "itkProgressReporter.h"
+#include "itkImageScanlineConstIterator.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -217,6 +220,31 @@ void ImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::BatchThre
   ConfidenceImagePointerType confidencePtr = this->GetOutputConfidence();
   ProbaImagePointerType      probaPtr      = this->GetOutputProba();
 
+  // Without mask nor probability map, every pixel is classified: the model
+  // reads the pixels directly from the input buffer and writes the labels
+  // and confidences directly into the output buffers, line by line.
+  if (!inputMaskPtr && !computeProbaMap)
+  {
+    const unsigned int num_features = inputPtr->GetNumberOfComponentsPerPixel();
+    const unsigned int lineLength   = outputRegionForThread.GetSize()[0];
+
+    itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels() / std::max(lineLength, 1u));
+
+    typedef itk::ImageScanlineConstIterator<OutputImageType> OutputLineIteratorType;
+    for (OutputLineIteratorType lineIt(outputPtr, outputRegionForThread); !lineIt.IsAtEnd(); lineIt.NextLine())
+    {
+      const typename OutputImageType::IndexType index = lineIt.GetIndex();
+
+      const ValueType* inLine         = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(index) * num_features;
+      LabelType*       outLine        = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index);
+      double*          confidenceLine = computeConfidenceMap ? confidencePtr->GetBufferPointer() + confidencePtr->ComputeOffset(index) : nullptr;
+
+      m_Model->PredictBatch(inLine, lineLength, num_features, num_features, outLine, confidenceLine);
+      progress.CompletedPixel();
+    }
+    return;
+  }
+
   // Progress reporting
   itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
 
@@ -351,6 +379,9 @@ template <class TInputImage, class TOutputImage, class TMaskImage>
 void ImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
                                                                                             itk::ThreadIdType threadId)
 {
+  // Models threading internally get their share of the budget
+  ConfigurationManager::ThreadBudgetScope threadBudget(this->GetNumberOfThreads());
+
   if (m_BatchMode)
   {
     this->BatchThreadedGenerateData(outputRegionForThread, threadId);
@@ -24,6 +24,7 @@
 #include "itkInPlaceImageFilter.h"
 #include "itkListSample.h"
 #include "itkEuclideanDistanceMetric.h"
+#include <vector>
 
 namespace otb
 {
@@ -122,8 +123,11 @@ private:
   KMeansParametersType m_Centroids;
   /** Default label for invalid pixels (when using a mask) */
   LabelType m_DefaultLabel;
-  /** Centroids - labels map */
-  CentroidsMapType m_CentroidsMap;
+  /** Centroids of labels 1 to N, converted to ValueType then stored
+   * contiguously for NearestCentroid() */
+  std::vector<double> m_FlatCentroids;
+  /** Number of centroids in m_FlatCentroids */
+  unsigned int m_NumberOfCentroids;
 };
 } // End namespace otb
 #ifndef OTB_MANUAL_INSTANTIATION
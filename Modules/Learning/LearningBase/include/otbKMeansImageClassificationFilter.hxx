@@ -24,6 +24,7 @@
 #include "otbKMeansImageClassificationFilter.h"
 #include "itkImageRegionIterator.h"
 #include "itkNumericTraits.h"
+#include "otbNearestCentroid.h"
 
 namespace otb
 {
@@ -35,7 +36,8 @@ KMeansImageClassificationFilter<TInputImage, TOutputImage, VMaxSampleDimension,
 {
   this->SetNumberOfRequiredInputs(2);
   this->SetNumberOfRequiredInputs(1);
-  m_DefaultLabel = itk::NumericTraits<LabelType>::ZeroValue();
+  m_DefaultLabel      = itk::NumericTraits<LabelType>::ZeroValue();
+  m_NumberOfCentroids = 0;
 }
 
 template <class TInputImage, class TOutputImage, unsigned int VMaxSampleDimension, class TMaskImage>
@@ -59,18 +61,12 @@ template <class TInputImage, class TOutputImage, unsigned int VMaxSampleDimensio
 void KMeansImageClassificationFilter<TInputImage, TOutputImage, VMaxSampleDimension, TMaskImage>::BeforeThreadedGenerateData()
 {
   unsigned int sample_size = MaxSampleDimension;
-  unsigned int nb_classes  = m_Centroids.Size() / sample_size;
+  m_NumberOfCentroids      = m_Centroids.Size() / sample_size;
 
-  for (LabelType label = 1; label <= static_cast<LabelType>(nb_classes); ++label)
+  m_FlatCentroids.resize(m_NumberOfCentroids * MaxSampleDimension);
+  for (unsigned int i = 0; i < m_FlatCentroids.size(); ++i)
   {
-    SampleType new_centroid;
-    new_centroid.Fill(0);
-    m_CentroidsMap[label] = new_centroid;
-
-    for (unsigned int i = 0; i < MaxSampleDimension; ++i)
-    {
-      m_CentroidsMap[label][i] = static_cast<ValueType>(m_Centroids[MaxSampleDimension * (static_cast<unsigned int>(label) - 1) + i]);
-    }
+    m_FlatCentroids[i] = static_cast<ValueType>(m_Centroids[i]);
   }
 }
 
@@ -110,7 +106,8 @@ void KMeansImageClassificationFilter<TInputImage, TOutputImage, VMaxSampleDimens
 
   validPoint = true;
 
-  typename DistanceType::Pointer distance = DistanceType::New();
+  // Missing components are compared as zeros
+  double pixel[MaxSampleDimension] = {};
 
   while (!outIt.IsAtEnd() && (!inIt.IsAtEnd()))
   {
@@ -119,29 +116,15 @@ void KMeansImageClassificationFilter<TInputImage, TOutputImage, VMaxSampleDimens
       validPoint = maskIt.Get() > 0;
       ++maskIt;
     }
-    if (validPoint)
+    if (validPoint && m_NumberOfCentroids > 0)
     {
-      LabelType  label         = 1;
-      LabelType  current_label = 1;
-      SampleType pixel;
-      pixel.Fill(0);
+      const typename InputImageType::PixelType& value = inIt.Get();
       for (unsigned int i = 0; i < sampleSize; ++i)
       {
-        pixel[i] = inIt.Get()[i];
-      }
-
-      double current_distance = distance->Evaluate(pixel, m_CentroidsMap[label]);
-
-      for (label = 2; label <= static_cast<LabelType>(m_CentroidsMap.size()); ++label)
-      {
-        double tmp_dist = distance->Evaluate(pixel, m_CentroidsMap[label]);
-        if (tmp_dist < current_distance)
-        {
-          current_label    = label;
-          current_distance = tmp_dist;
-        }
+        pixel[i] = static_cast<ValueType>(value[i]);
       }
-      outIt.Set(current_label);
+      const unsigned int nearest = NearestCentroid(pixel, m_FlatCentroids.data(), m_NumberOfCentroids, MaxSampleDimension);
+      outIt.Set(static_cast<LabelType>(nearest + 1));
     }
     ++outIt;
     ++inIt;
@@ -24,6 +24,7 @@
 #include "itkObject.h"
 #include "itkListSample.h"
 #include "otbMachineLearningModelTraits.h"
+#include <cstddef>
 
 namespace otb
 {
@@ -60,6 +61,7 @@ namespace otb
  * \sa NeuralNetworkMachineLearningModel
  * \sa SharkRandomForestsMachineLearningModel
  * \sa SharkKMeansMachineLearningModel
+ * \sa ONNXMachineLearningModel
  * \sa ImageClassificationFilter
  *
  *
@@ -134,6 +136,21 @@ public:
   typename TargetListSampleType::Pointer PredictBatch(const InputListSampleType* input, ConfidenceListSampleType* quality = nullptr,
                                                       ProbaListSampleType* proba = nullptr) const;
 
+  /** Predict a batch of samples read directly from a memory buffer
+    * \param samples Pointer to the first feature of the first sample.
+    * Sample i is made of the nbFeatures contiguous values starting at
+    * samples + i * stride (e.g. the pixels of a VectorImage line, with
+    * stride equal to the number of components).
+    * \param labels Buffer of nbSamples values where to store the predicted
+    * labels (first component of the target)
+    * \param quality Buffer of nbSamples values where to store the
+    * confidence values, or NULL
+    * Unlike the list sample version, this method is not multi-threaded: it
+    * is meant to be called from already multi-threaded filters.
+     */
+  void PredictBatch(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                    ConfidenceValueType* quality = nullptr) const;
+
   /**\name Classification model file manipulation */
   //@{
   /** Save the model to file */
@@ -227,7 +244,6 @@ protected:
   /** Output Dimension of the model, used by Dimensionality Reduction models*/
   unsigned int m_Dimension;
 
-private:
   /**  Actual implementation of BatchPredicition
     *  Default implementation will call DoPredict iteratively
     *  \param input The input batch
@@ -246,6 +262,17 @@ private:
   virtual void DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType* target,
                               ConfidenceListSampleType* quality = nullptr, ProbaListSampleType* proba = nullptr) const;
 
+  /**  Actual implementation of buffer batch prediction
+    *  Default implementation copies the samples into a list sample and
+    *  calls DoPredictBatch().
+    *
+    * Override me if internal implementation can read samples directly
+    * from the buffer.
+    */
+  virtual void DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride,
+                               TargetValueType* labels, ConfidenceValueType* quality = nullptr) const;
+
+private:
   /** Actual implementation of single sample prediction
    *  \param input sample to predict
    *  \param quality Pointer to a variable to store confidence value,
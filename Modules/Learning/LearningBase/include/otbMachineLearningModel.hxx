@@ -26,6 +26,7 @@
 #endif
 
 #include "otbMachineLearningModel.h"
+#include "otbConfigurationManager.h"
 
 #include "itkMultiThreader.h"
 
@@ -98,12 +99,15 @@ MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::PredictBatch(
     // OpenMP threading here
     unsigned int nb_threads(0), threadId(0), nb_batches(0);
 
-#pragma omp parallel shared(nb_threads, nb_batches) private(threadId)
+    // Use the share of the thread budget of the calling thread, which is
+    // smaller than the ITK default when called from a threaded filter
+    const int budget = ConfigurationManager::GetAvailableThreads();
+
+#pragma omp parallel num_threads(budget) shared(nb_threads, nb_batches) private(threadId)
     {
-      // Get number of threads configured with ITK
-      omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
       nb_threads = omp_get_num_threads();
       threadId   = omp_get_thread_num();
+      ConfigurationManager::ThreadBudgetScope threadBudget(nb_threads, budget);
       nb_batches = std::min(nb_threads, (unsigned int)input->Size());
       // Ensure that we do not spawn unnecessary threads
       if (threadId < nb_batches)
@@ -177,6 +181,57 @@ void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::DoPredic
   }
 }
 
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::PredictBatch(const InputValueType* samples, unsigned int nbSamples,
+                                                                                     unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                                                                                     ConfidenceValueType* quality) const
+{
+  assert(labels != nullptr);
+  if (nbSamples == 0)
+    return;
+  assert(samples != nullptr);
+
+  // Call protected specialization entry point
+  this->DoPredictBuffer(samples, nbSamples, nbFeatures, stride, labels, quality);
+}
+
+template <class TInputValue, class TOutputValue, class TConfidenceValue>
+void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples,
+                                                                                        unsigned int nbFeatures, std::size_t stride,
+                                                                                        TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  // Default behaviour: go through the list sample batch prediction, so that
+  // models implementing only DoPredictBatch() keep their batch path
+  typename InputListSampleType::Pointer input = InputListSampleType::New();
+  input->SetMeasurementVectorSize(nbFeatures);
+
+  // The sample does not own its data: it is moved along the buffer
+  InputSampleType sample;
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    sample.SetData(const_cast<InputValueType*>(samples + i * stride), nbFeatures, false);
+    input->PushBack(sample);
+  }
+
+  typename TargetListSampleType::Pointer targets = TargetListSampleType::New();
+  targets->Resize(nbSamples);
+  typename ConfidenceListSampleType::Pointer confidences;
+  if (quality != nullptr)
+  {
+    confidences = ConfidenceListSampleType::New();
+    confidences->Resize(nbSamples);
+  }
+
+  this->DoPredictBatch(input, 0, nbSamples, targets, confidences);
+
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    labels[i] = targets->GetMeasurementVector(i)[0];
+    if (quality != nullptr)
+      quality[i] = confidences->GetMeasurementVector(i)[0];
+  }
+}
+
 template <class TInputValue, class TOutputValue, class TConfidenceValue>
 void MachineLearningModel<TInputValue, TOutputValue, TConfidenceValue>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
@@ -0,0 +1,156 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMultiModelImageClassificationFilter_h
+#define otbMultiModelImageClassificationFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbMachineLearningModel.h"
+#include "otbImage.h"
+#include <vector>
+
+namespace otb
+{
+/** \class MultiModelImageClassificationFilter
+ *  \brief Classify a VectorImage with several models in a single pass.
+ *
+ *  The first output is a VectorImage with one band per model, holding the
+ *  labels predicted by each model. Each tile of the input is read (and
+ *  normalized upstream) only once for all the models, instead of once per
+ *  ImageClassificationFilter.
+ *
+ *  The second output is the fusion of those labels by majority voting,
+ *  with the conventions of the FusionOfClassifications application: labels
+ *  equal to NoDataLabel do not vote, pixels where all the models voted
+ *  NoDataLabel keep it, and ties are given UndecidedLabel. The first output
+ *  can also be fed to DSFusionOfClassifiersImageFilter in the same pipeline.
+ *
+ *  Pixels outside the optional mask get the NoDataLabel in all the outputs.
+ *
+ *  With regression models, the first output holds one predicted variable
+ *  per band. The voting is then meaningless and can be switched off with
+ *  FuseLabels, the second output being filled with the NoDataLabel.
+ *
+ * \sa ImageClassificationFilter
+ * \ingroup Streamed
+ * \ingroup Threaded
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TInputImage, class TOutputImage, class TMaskImage = otb::Image<typename TOutputImage::InternalPixelType>>
+class ITK_EXPORT MultiModelImageClassificationFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef MultiModelImageClassificationFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(MultiModelImageClassificationFilter, ImageToImageFilter);
+
+  typedef TInputImage                                InputImageType;
+  typedef typename InputImageType::ConstPointer      InputImageConstPointerType;
+  typedef typename InputImageType::InternalPixelType ValueType;
+
+  typedef TMaskImage                           MaskImageType;
+  typedef typename MaskImageType::ConstPointer MaskImageConstPointerType;
+
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::Pointer           OutputImagePointerType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::InternalPixelType LabelType;
+
+  typedef otb::Image<LabelType>            FusedImageType;
+  typedef typename FusedImageType::Pointer FusedImagePointerType;
+
+  typedef MachineLearningModel<ValueType, LabelType> ModelType;
+  typedef typename ModelType::Pointer                ModelPointerType;
+  typedef std::vector<ModelPointerType>              ModelListType;
+
+  /** Append a model, its labels go to the next band of the output */
+  void AddModel(ModelType* model);
+
+  /** Remove all the models */
+  void ClearModels();
+
+  unsigned int GetNumberOfModels() const
+  {
+    return static_cast<unsigned int>(m_Models.size());
+  }
+
+  ModelType* GetModel(unsigned int i) const
+  {
+    return m_Models.at(i);
+  }
+
+  /** Set/Get the label of masked pixels, ignored by the fusion */
+  itkSetMacro(NoDataLabel, LabelType);
+  itkGetMacro(NoDataLabel, LabelType);
+
+  /** Set/Get the label of pixels with a tie in the majority voting */
+  itkSetMacro(UndecidedLabel, LabelType);
+  itkGetMacro(UndecidedLabel, LabelType);
+
+  /** Set/Get whether the labels are fused in the second output, true by default */
+  itkSetMacro(FuseLabels, bool);
+  itkGetMacro(FuseLabels, bool);
+  itkBooleanMacro(FuseLabels);
+
+  /** If set, only pixels with a mask value greater than 0 are classified */
+  void SetInputMask(const MaskImageType* mask);
+  const MaskImageType* GetInputMask();
+
+  /** Labels fused by majority voting */
+  FusedImageType* GetFusedOutput();
+
+protected:
+  MultiModelImageClassificationFilter();
+  ~MultiModelImageClassificationFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+  void BeforeThreadedGenerateData() override;
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Majority vote among the nbModels labels */
+  LabelType Vote(const LabelType* labels, unsigned int nbModels) const;
+
+private:
+  MultiModelImageClassificationFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  ModelListType m_Models;
+  LabelType     m_NoDataLabel;
+  LabelType     m_UndecidedLabel;
+  bool          m_FuseLabels;
+};
+} // End namespace otb
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbMultiModelImageClassificationFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,247 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMultiModelImageClassificationFilter_hxx
+#define otbMultiModelImageClassificationFilter_hxx
+
+#include "otbMultiModelImageClassificationFilter.h"
+#include "otbConfigurationManager.h"
+#include "itkImageScanlineConstIterator.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::MultiModelImageClassificationFilter()
+{
+  this->SetNumberOfIndexedInputs(2);
+  this->SetNumberOfRequiredInputs(1);
+
+  this->SetNumberOfRequiredOutputs(2);
+  this->SetNthOutput(0, TOutputImage::New());
+  this->SetNthOutput(1, FusedImageType::New());
+
+  m_NoDataLabel    = itk::NumericTraits<LabelType>::ZeroValue();
+  m_UndecidedLabel = itk::NumericTraits<LabelType>::ZeroValue();
+  m_FuseLabels     = true;
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+void MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::AddModel(ModelType* model)
+{
+  m_Models.push_back(model);
+  this->Modified();
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+void MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::ClearModels()
+{
+  m_Models.clear();
+  this->Modified();
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+void MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::SetInputMask(const MaskImageType* mask)
+{
+  this->itk::ProcessObject::SetNthInput(1, const_cast<MaskImageType*>(mask));
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+const typename MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::MaskImageType*
+MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::GetInputMask()
+{
+  if (this->GetNumberOfInputs() < 2)
+  {
+    return nullptr;
+  }
+  return static_cast<const MaskImageType*>(this->itk::ProcessObject::GetInput(1));
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+typename MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::FusedImageType*
+MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::GetFusedOutput()
+{
+  if (this->GetNumberOfOutputs() < 2)
+  {
+    return nullptr;
+  }
+  return static_cast<FusedImageType*>(this->itk::ProcessObject::GetOutput(1));
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+void MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  // One band per model
+  this->GetOutput()->SetNumberOfComponentsPerPixel(std::max(this->GetNumberOfModels(), 1u));
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+void MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::BeforeThreadedGenerateData()
+{
+  if (m_Models.empty())
+  {
+    itkExceptionMacro(<< "No model for classification");
+  }
+  for (unsigned int k = 0; k < m_Models.size(); ++k)
+  {
+    if (m_Models[k].IsNull())
+    {
+      itkExceptionMacro(<< "Model " << k << " is null");
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+typename MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::LabelType
+MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::Vote(const LabelType* labels, unsigned int nbModels) const
+{
+  // Few models: counting the votes by pairs is cheaper than a map
+  LabelType    best      = m_NoDataLabel;
+  unsigned int bestVotes = 0;
+  bool         tie       = false;
+  for (unsigned int i = 0; i < nbModels; ++i)
+  {
+    if (labels[i] == m_NoDataLabel)
+      continue;
+
+    bool counted = false;
+    for (unsigned int j = 0; j < i && !counted; ++j)
+      counted = labels[j] == labels[i];
+    if (counted)
+      continue;
+
+    unsigned int votes = 1;
+    for (unsigned int j = i + 1; j < nbModels; ++j)
+      votes += labels[j] == labels[i];
+
+    if (votes > bestVotes)
+    {
+      best      = labels[i];
+      bestVotes = votes;
+      tie       = false;
+    }
+    else if (votes == bestVotes)
+    {
+      tie = true;
+    }
+  }
+  return tie ? m_UndecidedLabel : best;
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+void MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                      itk::ThreadIdType threadId)
+{
+  // Models threading internally get their share of the budget
+  ConfigurationManager::ThreadBudgetScope threadBudget(this->GetNumberOfThreads());
+
+  InputImageConstPointerType inputPtr     = this->GetInput();
+  MaskImageConstPointerType  inputMaskPtr = this->GetInputMask();
+  OutputImagePointerType     outputPtr    = this->GetOutput();
+  FusedImagePointerType      fusedPtr     = this->GetFusedOutput();
+
+  const unsigned int nbModels   = this->GetNumberOfModels();
+  const unsigned int nbFeatures = inputPtr->GetNumberOfComponentsPerPixel();
+  const unsigned int lineLength = outputRegionForThread.GetSize()[0];
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels() / std::max(lineLength, 1u));
+
+  // Labels of the current line, model after model
+  std::vector<LabelType> labels(nbModels * lineLength);
+  // Valid pixels of the current line, packed when a mask is used
+  std::vector<ValueType>    samples;
+  std::vector<unsigned int> validPixels;
+  if (inputMaskPtr)
+  {
+    samples.resize(lineLength * nbFeatures);
+    validPixels.reserve(lineLength);
+  }
+
+  typedef itk::ImageScanlineConstIterator<FusedImageType> LineIteratorType;
+  for (LineIteratorType lineIt(fusedPtr, outputRegionForThread); !lineIt.IsAtEnd(); lineIt.NextLine())
+  {
+    const typename FusedImageType::IndexType index = lineIt.GetIndex();
+
+    const ValueType* inLine    = inputPtr->GetBufferPointer() + inputPtr->ComputeOffset(index) * nbFeatures;
+    LabelType*       outLine   = outputPtr->GetBufferPointer() + outputPtr->ComputeOffset(index) * nbModels;
+    LabelType*       fusedLine = fusedPtr->GetBufferPointer() + fusedPtr->ComputeOffset(index);
+
+    const ValueType* lineSamples = inLine;
+    unsigned int     nbSamples   = lineLength;
+    if (inputMaskPtr)
+    {
+      const typename MaskImageType::PixelType* maskLine = inputMaskPtr->GetBufferPointer() + inputMaskPtr->ComputeOffset(index);
+      validPixels.clear();
+      for (unsigned int i = 0; i < lineLength; ++i)
+      {
+        if (maskLine[i] > 0)
+        {
+          std::copy(inLine + i * nbFeatures, inLine + (i + 1) * nbFeatures, samples.begin() + validPixels.size() * nbFeatures);
+          validPixels.push_back(i);
+        }
+      }
+      lineSamples = samples.data();
+      nbSamples   = static_cast<unsigned int>(validPixels.size());
+    }
+
+    for (unsigned int k = 0; k < nbModels; ++k)
+    {
+      m_Models[k]->PredictBatch(lineSamples, nbSamples, nbFeatures, nbFeatures, labels.data() + k * lineLength);
+    }
+
+    if (inputMaskPtr)
+    {
+      std::fill(outLine, outLine + lineLength * nbModels, m_NoDataLabel);
+    }
+    if (inputMaskPtr || !m_FuseLabels)
+    {
+      std::fill(fusedLine, fusedLine + lineLength, m_NoDataLabel);
+    }
+    for (unsigned int j = 0; j < nbSamples; ++j)
+    {
+      const unsigned int i     = inputMaskPtr ? validPixels[j] : j;
+      LabelType*         pixel = outLine + i * nbModels;
+      for (unsigned int k = 0; k < nbModels; ++k)
+      {
+        pixel[k] = labels[k * lineLength + j];
+      }
+      if (m_FuseLabels)
+      {
+        fusedLine[i] = Vote(pixel, nbModels);
+      }
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TMaskImage>
+void MultiModelImageClassificationFilter<TInputImage, TOutputImage, TMaskImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "NumberOfModels: " << m_Models.size() << std::endl;
+  os << indent << "NoDataLabel: " << static_cast<typename itk::NumericTraits<LabelType>::PrintType>(m_NoDataLabel) << std::endl;
+  os << indent << "UndecidedLabel: " << static_cast<typename itk::NumericTraits<LabelType>::PrintType>(m_UndecidedLabel) << std::endl;
+  os << indent << "FuseLabels: " << m_FuseLabels << std::endl;
+}
+} // End namespace otb
+#endif
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbNearestCentroid_h
+#define otbNearestCentroid_h
+
+#include <limits>
+
+namespace otb
+{
+
+/** Index of the centroid closest to \c sample, in the Euclidean sense.
+ *
+ * \param centroids row-major array of \c nbCentroids centroids of
+ * \c dimension values each.
+ * \param distance if not null, receives the squared distance to the
+ * closest centroid.
+ *
+ * The first closest centroid is returned in case of ties. The distance
+ * is a plain reduction over contiguous arrays, which the compiler can
+ * vectorize when it is allowed to reorder floating point additions.
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TValue>
+unsigned int NearestCentroid(const TValue* sample, const TValue* centroids, unsigned int nbCentroids, unsigned int dimension, TValue* distance = nullptr)
+{
+  unsigned int best         = 0;
+  TValue       bestDistance = std::numeric_limits<TValue>::max();
+
+  const TValue* centroid = centroids;
+  for (unsigned int c = 0; c < nbCentroids; ++c, centroid += dimension)
+  {
+    TValue current = 0;
+    for (unsigned int i = 0; i < dimension; ++i)
+    {
+      const TValue diff = sample[i] - centroid[i];
+      current += diff * diff;
+    }
+    if (current < bestDistance)
+    {
+      best         = c;
+      bestDistance = current;
+    }
+  }
+
+  if (distance != nullptr)
+    *distance = bestDistance;
+  return best;
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,167 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbPatchInferenceImageFilter_h
+#define otbPatchInferenceImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbMachineLearningModel.h"
+
+namespace otb
+{
+/** \class PatchInferenceImageFilter
+ *  \brief Apply a model to the patches of a VectorImage
+ *
+ *  Unlike ImageClassificationFilter, which gives the pixels to the model
+ *  one by one, this filter gives it square patches of PatchSize pixels,
+ *  flattened band after band (the layout of a (C, H, W) tensor), as
+ *  needed by convolutional models.
+ *
+ *  With a dense output, the target of a patch is the flattened
+ *  prediction of all its pixels, band after band. The Margin pixels at
+ *  each border of a predicted patch, whose receptive field lies partly
+ *  outside of the patch, are discarded, so the patches are laid out
+ *  with an overlap of twice the margin. Neighbouring patches can overlap
+ *  Overlap pixels more: their predictions are then blended with weights
+ *  decreasing linearly towards the border of the kept window.
+ *
+ *  Without a dense output, the target of a patch is the value of its
+ *  center pixel, so that there is one patch per output pixel.
+ *
+ *  The requested regions are padded by the context needed around the
+ *  kept windows, and the pixels outside of the input image are zero.
+ *  The patches of each thread region are predicted by batches of
+ *  BatchSize patches.
+ *
+ * \sa ImageClassificationFilter
+ * \sa ONNXMachineLearningModel
+ * \ingroup Streamed
+ * \ingroup Threaded
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT PatchInferenceImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef PatchInferenceImageFilter                          Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>                            Pointer;
+  typedef itk::SmartPointer<const Self>                      ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(PatchInferenceImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                                InputImageType;
+  typedef typename InputImageType::ConstPointer      InputImageConstPointerType;
+  typedef typename InputImageType::InternalPixelType ValueType;
+  typedef typename InputImageType::SizeType          SizeType;
+  typedef typename InputImageType::IndexType         IndexType;
+
+  typedef TOutputImage                                OutputImageType;
+  typedef typename OutputImageType::Pointer           OutputImagePointerType;
+  typedef typename OutputImageType::RegionType        OutputImageRegionType;
+  typedef typename OutputImageType::InternalPixelType OutputValueType;
+
+  typedef MachineLearningModel<itk::VariableLengthVector<ValueType>, itk::VariableLengthVector<OutputValueType>> ModelType;
+  typedef typename ModelType::Pointer ModelPointerType;
+
+  /** Set/Get the model */
+  itkSetObjectMacro(Model, ModelType);
+  itkGetObjectMacro(Model, ModelType);
+
+  /** Size of the patches given to the model */
+  itkSetMacro(PatchSize, SizeType);
+  itkGetConstReferenceMacro(PatchSize, SizeType);
+
+  /** Pixels discarded at each border of the dense predictions */
+  itkSetMacro(Margin, SizeType);
+  itkGetConstReferenceMacro(Margin, SizeType);
+
+  /** Extra overlap between the kept windows of neighbouring patches,
+   * blended linearly */
+  itkSetMacro(Overlap, SizeType);
+  itkGetConstReferenceMacro(Overlap, SizeType);
+
+  /** Number of bands of the predictions, 1 by default */
+  itkSetMacro(NumberOfOutputComponents, unsigned int);
+  itkGetConstMacro(NumberOfOutputComponents, unsigned int);
+
+  /** Number of patches given to the model at once, 64 by default */
+  itkSetMacro(BatchSize, unsigned int);
+  itkGetConstMacro(BatchSize, unsigned int);
+
+  /** The model predicts all the pixels of a patch (default), or only
+   * its center pixel */
+  itkSetMacro(DenseOutput, bool);
+  itkGetConstMacro(DenseOutput, bool);
+  itkBooleanMacro(DenseOutput);
+
+protected:
+  /** Constructor */
+  PatchInferenceImageFilter();
+  /** Destructor */
+  ~PatchInferenceImageFilter() override = default;
+
+  /** Generate output information */
+  void GenerateOutputInformation() override;
+
+  /** Pad the requested region by the context of the kept windows */
+  void GenerateInputRequestedRegion() override;
+
+  /** Before threaded generate data */
+  void BeforeThreadedGenerateData() override;
+
+  /** Threaded generate data */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /**PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  PatchInferenceImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Offset and size of the kept window in a patch, along a dimension */
+  void GetWindow(unsigned int dim, long& offset, long& size) const;
+
+  /** Start of the kept windows covering [start, start + size) along a
+   * dimension */
+  std::vector<long> GetWindowStarts(unsigned int dim, long start, long size) const;
+
+  ModelPointerType m_Model;
+  SizeType         m_PatchSize;
+  SizeType         m_Margin;
+  SizeType         m_Overlap;
+  unsigned int     m_NumberOfOutputComponents;
+  unsigned int     m_BatchSize;
+  bool             m_DenseOutput;
+};
+} // End namespace otb
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbPatchInferenceImageFilter.hxx"
+#endif
+
+#endif
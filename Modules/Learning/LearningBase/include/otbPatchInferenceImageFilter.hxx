@@ -0,0 +1,287 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbPatchInferenceImageFilter_hxx
+#define otbPatchInferenceImageFilter_hxx
+
+#include "otbPatchInferenceImageFilter.h"
+#include "itkImageRegionIterator.h"
+
+#include <algorithm>
+#include <vector>
+
+namespace otb
+{
+template <class TInputImage, class TOutputImage>
+PatchInferenceImageFilter<TInputImage, TOutputImage>::PatchInferenceImageFilter()
+  : m_NumberOfOutputComponents(1), m_BatchSize(64), m_DenseOutput(true)
+{
+  m_PatchSize.Fill(64);
+  m_Margin.Fill(0);
+  m_Overlap.Fill(0);
+}
+
+template <class TInputImage, class TOutputImage>
+void PatchInferenceImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (m_NumberOfOutputComponents == 0)
+  {
+    itkExceptionMacro(<< "The number of output components must be positive");
+  }
+  this->GetOutput()->SetNumberOfComponentsPerPixel(m_NumberOfOutputComponents);
+}
+
+template <class TInputImage, class TOutputImage>
+void PatchInferenceImageFilter<TInputImage, TOutputImage>::GetWindow(unsigned int dim, long& offset, long& size) const
+{
+  if (m_DenseOutput)
+  {
+    offset = m_Margin[dim];
+    size   = static_cast<long>(m_PatchSize[dim]) - 2 * static_cast<long>(m_Margin[dim]);
+  }
+  else
+  {
+    offset = m_PatchSize[dim] / 2;
+    size   = 1;
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+std::vector<long> PatchInferenceImageFilter<TInputImage, TOutputImage>::GetWindowStarts(unsigned int dim, long start, long size) const
+{
+  long offset, windowSize;
+  this->GetWindow(dim, offset, windowSize);
+  const long step = m_DenseOutput ? windowSize - static_cast<long>(m_Overlap[dim]) : 1;
+
+  // The last window is moved back so that it ends with the region
+  std::vector<long> starts;
+  for (long windowStart = start;; windowStart += step)
+  {
+    if (windowStart + windowSize >= start + size)
+    {
+      starts.push_back(std::max(start, start + size - windowSize));
+      break;
+    }
+    starts.push_back(windowStart);
+  }
+  return starts;
+}
+
+template <class TInputImage, class TOutputImage>
+void PatchInferenceImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  // Context of the kept windows, and the windows which may extend past
+  // the end of a small region
+  typename InputImageType::RegionType inputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+  {
+    long offset, windowSize;
+    this->GetWindow(dim, offset, windowSize);
+    const long start = inputRequestedRegion.GetIndex(dim) - offset;
+    const long end   = inputRequestedRegion.GetIndex(dim) + std::max<long>(inputRequestedRegion.GetSize(dim), windowSize) - windowSize - offset + m_PatchSize[dim];
+    inputRequestedRegion.SetIndex(dim, start);
+    inputRequestedRegion.SetSize(dim, end - start);
+  }
+
+  // The pixels outside of the input are zero
+  if (!inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    inputPtr->SetRequestedRegion(inputRequestedRegion);
+
+    itk::InvalidRequestedRegionError e(__FILE__, __LINE__);
+    std::ostringstream               msg;
+    msg << this->GetNameOfClass() << "::GenerateInputRequestedRegion()";
+    e.SetLocation(msg.str());
+    e.SetDescription("Requested region is (at least partially) outside the largest possible region.");
+    e.SetDataObject(inputPtr);
+    throw e;
+  }
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void PatchInferenceImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  if (!m_Model)
+  {
+    itkExceptionMacro(<< "No model for inference");
+  }
+  for (unsigned int dim = 0; dim < InputImageType::ImageDimension; ++dim)
+  {
+    long offset, windowSize;
+    this->GetWindow(dim, offset, windowSize);
+    if (m_PatchSize[dim] == 0 || windowSize <= 0 || (m_DenseOutput && static_cast<long>(m_Overlap[dim]) >= windowSize))
+    {
+      itkExceptionMacro(<< "The margin and the overlap leave no pixel to keep in the patches of size " << m_PatchSize);
+    }
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void PatchInferenceImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                itk::ThreadIdType itkNotUsed(threadId))
+{
+  typedef typename ModelType::InputListSampleType  InputListSampleType;
+  typedef typename ModelType::InputSampleType      InputSampleType;
+  typedef typename ModelType::TargetListSampleType TargetListSampleType;
+
+  InputImageConstPointerType inputPtr     = this->GetInput();
+  OutputImagePointerType     outputPtr    = this->GetOutput();
+  const unsigned int         nbBands      = inputPtr->GetNumberOfComponentsPerPixel();
+  const unsigned int         nbComponents = m_NumberOfOutputComponents;
+  const long                 patchWidth   = m_PatchSize[0];
+  const long                 patchHeight  = m_PatchSize[1];
+  const long                 patchPixels  = patchWidth * patchHeight;
+
+  long offsetX, windowWidth, offsetY, windowHeight;
+  this->GetWindow(0, offsetX, windowWidth);
+  this->GetWindow(1, offsetY, windowHeight);
+
+  // Weighted sum of the predictions of the region
+  const IndexType     regionIndex  = outputRegionForThread.GetIndex();
+  const long          regionWidth  = outputRegionForThread.GetSize(0);
+  const long          regionHeight = outputRegionForThread.GetSize(1);
+  std::vector<double> sums(regionWidth * regionHeight * nbComponents, 0.);
+  std::vector<double> weights(regionWidth * regionHeight, 0.);
+
+  // Weight of a pixel of a kept window, decreasing linearly over the
+  // overlap
+  auto weight = [](long position, long size, long overlap) {
+    return std::min(1., std::min(position + 1, size - position) / static_cast<double>(overlap + 1));
+  };
+
+  const std::vector<long> startsX = this->GetWindowStarts(0, regionIndex[0], regionWidth);
+  const std::vector<long> startsY = this->GetWindowStarts(1, regionIndex[1], regionHeight);
+  std::vector<IndexType>  windows;
+  for (long startY : startsY)
+  {
+    for (long startX : startsX)
+    {
+      IndexType window;
+      window[0] = startX;
+      window[1] = startY;
+      windows.push_back(window);
+    }
+  }
+
+  const typename InputImageType::RegionType bufferedRegion = inputPtr->GetBufferedRegion();
+  const unsigned int                        batchSize      = std::max(1u, m_BatchSize);
+  for (std::size_t first = 0; first < windows.size(); first += batchSize)
+  {
+    const std::size_t last = std::min(windows.size(), first + batchSize);
+
+    // Flatten the patches band after band
+    typename InputListSampleType::Pointer samples = InputListSampleType::New();
+    samples->SetMeasurementVectorSize(nbBands * patchPixels);
+    for (std::size_t w = first; w < last; ++w)
+    {
+      InputSampleType sample(nbBands * patchPixels);
+      sample.Fill(0);
+      IndexType index;
+      for (long y = 0; y < patchHeight; ++y)
+      {
+        index[1] = windows[w][1] - offsetY + y;
+        for (long x = 0; x < patchWidth; ++x)
+        {
+          index[0] = windows[w][0] - offsetX + x;
+          if (!bufferedRegion.IsInside(index))
+            continue;
+          const typename InputImageType::PixelType pixel = inputPtr->GetPixel(index);
+          for (unsigned int band = 0; band < nbBands; ++band)
+          {
+            sample[band * patchPixels + y * patchWidth + x] = pixel[band];
+          }
+        }
+      }
+      samples->PushBack(sample);
+    }
+
+    typename TargetListSampleType::Pointer targets = m_Model->PredictBatch(samples);
+
+    // Accumulate the kept windows inside the region
+    const unsigned int expectedSize = m_DenseOutput ? nbComponents * patchPixels : nbComponents;
+    for (std::size_t w = first; w < last; ++w)
+    {
+      const typename ModelType::TargetSampleType& target = targets->GetMeasurementVector(w - first);
+      if (target.Size() != expectedSize)
+      {
+        itkExceptionMacro(<< "The model predicted " << target.Size() << " values for a patch, " << expectedSize << " were expected");
+      }
+      for (long y = 0; y < windowHeight; ++y)
+      {
+        const long regionY = windows[w][1] + y - regionIndex[1];
+        if (regionY < 0 || regionY >= regionHeight)
+          continue;
+        for (long x = 0; x < windowWidth; ++x)
+        {
+          const long regionX = windows[w][0] + x - regionIndex[0];
+          if (regionX < 0 || regionX >= regionWidth)
+            continue;
+          const double pixelWeight =
+              m_DenseOutput ? weight(x, windowWidth, m_Overlap[0]) * weight(y, windowHeight, m_Overlap[1]) : 1.;
+          const long pixel      = regionY * regionWidth + regionX;
+          const long patchPixel = (offsetY + y) * patchWidth + offsetX + x;
+          weights[pixel] += pixelWeight;
+          for (unsigned int comp = 0; comp < nbComponents; ++comp)
+          {
+            sums[pixel * nbComponents + comp] += pixelWeight * target[m_DenseOutput ? comp * patchPixels + patchPixel : comp];
+          }
+        }
+      }
+    }
+  }
+
+  typename OutputImageType::PixelType       outPixel(nbComponents);
+  itk::ImageRegionIterator<OutputImageType> outIt(outputPtr, outputRegionForThread);
+  long                                      pixel = 0;
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt, ++pixel)
+  {
+    for (unsigned int comp = 0; comp < nbComponents; ++comp)
+    {
+      outPixel[comp] = static_cast<OutputValueType>(weights[pixel] > 0 ? sums[pixel * nbComponents + comp] / weights[pixel] : 0.);
+    }
+    outIt.Set(outPixel);
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void PatchInferenceImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "PatchSize: " << m_PatchSize << std::endl;
+  os << indent << "Margin: " << m_Margin << std::endl;
+  os << indent << "Overlap: " << m_Overlap << std::endl;
+  os << indent << "NumberOfOutputComponents: " << m_NumberOfOutputComponents << std::endl;
+  os << indent << "BatchSize: " << m_BatchSize << std::endl;
+  os << indent << "DenseOutput: " << m_DenseOutput << std::endl;
+}
+
+} // End namespace otb
+#endif
@@ -0,0 +1,229 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingMiniBatchKMeansImageFilter_h
+#define otbStreamingMiniBatchKMeansImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "itkArray.h"
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentMiniBatchKMeansImageFilter
+ * \brief Mini-batch KMeans clustering of the pixels of a large image, using streaming
+ *
+ * Each streamed region is a mini-batch: its pixels are assigned to the
+ * closest current centroid, then each centroid moves towards the mean of
+ * its new pixels with a per-centroid learning rate equal to the number of
+ * new pixels over the number of pixels it has been assigned since Reset().
+ * A centroid is thus the mean of all the pixels it has been assigned so far,
+ * and the whole image is used to estimate the clusters with a memory
+ * footprint bounded by the size of the streamed regions.
+ *
+ * The starting centroids are given with SetInitialCentroids(). If they are
+ * not set, NumberOfClusters pixels evenly spread in the first streamed
+ * region are used.
+ *
+ * The input is expected to be a VectorImage. Centroids are stored row by
+ * row, one row of GetNumberOfComponentsPerPixel()
+ * values per cluster. Several passes over the image can be done by setting the
+ * result of a pass as the initial centroids of the next one.
+ *
+ * \sa KMeansImageClassificationFilter
+ * \sa StreamingMiniBatchKMeansImageFilter
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TInputImage>
+class ITK_EXPORT PersistentMiniBatchKMeansImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentMiniBatchKMeansImageFilter Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentMiniBatchKMeansImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                      ImageType;
+  typedef typename TInputImage::Pointer    InputImagePointer;
+  typedef typename TInputImage::RegionType RegionType;
+  typedef typename TInputImage::PixelType  PixelType;
+
+  typedef itk::Array<double>             CentroidsType;
+  typedef itk::Array<itk::SizeValueType> ClusterSizesType;
+
+  /** Number of clusters, deduced from the initial centroids when they are
+   * set */
+  itkSetMacro(NumberOfClusters, unsigned int);
+  itkGetMacro(NumberOfClusters, unsigned int);
+
+  /** Starting centroids, one row per cluster */
+  itkSetMacro(InitialCentroids, CentroidsType);
+  itkGetConstReferenceMacro(InitialCentroids, CentroidsType);
+
+  /** Current centroids, one row per cluster */
+  itkGetConstReferenceMacro(Centroids, CentroidsType);
+
+  /** Number of pixels assigned to each cluster since Reset() */
+  itkGetConstReferenceMacro(ClusterSizes, ClusterSizesType);
+
+  /** Pass the input through unmodified. Do this by Grafting in the
+   *  AllocateOutputs method.
+   */
+  void AllocateOutputs() override;
+  void GenerateOutputInformation() override;
+  void Synthetize(void) override;
+  void Reset(void) override;
+
+protected:
+  PersistentMiniBatchKMeansImageFilter();
+  ~PersistentMiniBatchKMeansImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Picks the starting centroids if needed, and clears the thread sums */
+  void BeforeThreadedGenerateData() override;
+
+  /** Assigns the pixels of the region to the current centroids */
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** Moves the centroids towards the mean of their new pixels */
+  void AfterThreadedGenerateData() override;
+
+private:
+  PersistentMiniBatchKMeansImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  unsigned int     m_NumberOfClusters;
+  CentroidsType    m_InitialCentroids;
+  CentroidsType    m_Centroids;
+  ClusterSizesType m_ClusterSizes;
+
+  /** Have the centroids been picked from the image yet? */
+  bool m_CentroidsInitialized;
+
+  /** Sum and number of the pixels assigned to each cluster by each thread
+   * in the current region */
+  std::vector<std::vector<double>>             m_ThreadSums;
+  std::vector<std::vector<itk::SizeValueType>> m_ThreadCounts;
+};
+
+/** \class StreamingMiniBatchKMeansImageFilter
+ * \brief This class streams the whole input image through the PersistentMiniBatchKMeansImageFilter.
+ *
+ * \sa PersistentMiniBatchKMeansImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBLearningBase
+ */
+template <class TInputImage>
+class ITK_EXPORT StreamingMiniBatchKMeansImageFilter : public PersistentFilterStreamingDecorator<PersistentMiniBatchKMeansImageFilter<TInputImage>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingMiniBatchKMeansImageFilter                                                   Self;
+  typedef PersistentFilterStreamingDecorator<PersistentMiniBatchKMeansImageFilter<TInputImage>> Superclass;
+  typedef itk::SmartPointer<Self>                                                               Pointer;
+  typedef itk::SmartPointer<const Self>                                                         ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingMiniBatchKMeansImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef TInputImage                                 InputImageType;
+  typedef typename Superclass::FilterType             KMeansFilterType;
+  typedef typename KMeansFilterType::CentroidsType    CentroidsType;
+  typedef typename KMeansFilterType::ClusterSizesType ClusterSizesType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType* input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+  const InputImageType* GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  void SetNumberOfClusters(unsigned int nbClusters)
+  {
+    this->GetFilter()->SetNumberOfClusters(nbClusters);
+  }
+  unsigned int GetNumberOfClusters()
+  {
+    return this->GetFilter()->GetNumberOfClusters();
+  }
+
+  void SetInitialCentroids(const CentroidsType& centroids)
+  {
+    this->GetFilter()->SetInitialCentroids(centroids);
+  }
+
+  /** Return the computed centroids, one row per cluster */
+  const CentroidsType& GetCentroids() const
+  {
+    return this->GetFilter()->GetCentroids();
+  }
+
+  /** Return the number of pixels assigned to each cluster */
+  const ClusterSizesType& GetClusterSizes() const
+  {
+    return this->GetFilter()->GetClusterSizes();
+  }
+
+protected:
+  /** Constructor */
+  StreamingMiniBatchKMeansImageFilter()
+  {
+  }
+  /** Destructor */
+  ~StreamingMiniBatchKMeansImageFilter() override
+  {
+  }
+
+private:
+  StreamingMiniBatchKMeansImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingMiniBatchKMeansImageFilter.hxx"
+#endif
+
+#endif
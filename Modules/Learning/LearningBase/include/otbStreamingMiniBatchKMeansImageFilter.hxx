@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingMiniBatchKMeansImageFilter_hxx
+#define otbStreamingMiniBatchKMeansImageFilter_hxx
+
+#include "otbStreamingMiniBatchKMeansImageFilter.h"
+#include "otbNearestCentroid.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+#include <functional>
+
+namespace otb
+{
+
+template <class TInputImage>
+PersistentMiniBatchKMeansImageFilter<TInputImage>::PersistentMiniBatchKMeansImageFilter() : m_NumberOfClusters(2), m_CentroidsInitialized(false)
+{
+}
+
+template <class TInputImage>
+void PersistentMiniBatchKMeansImageFilter<TInputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentMiniBatchKMeansImageFilter<TInputImage>::AllocateOutputs()
+{
+  // The output image of this filter is not intended to be used
+}
+
+template <class TInputImage>
+void PersistentMiniBatchKMeansImageFilter<TInputImage>::Reset()
+{
+  TInputImage* inputPtr = const_cast<TInputImage*>(this->GetInput());
+  inputPtr->UpdateOutputInformation();
+
+  const unsigned int nbComponents = inputPtr->GetNumberOfComponentsPerPixel();
+
+  if (m_InitialCentroids.Size() > 0)
+  {
+    if (m_InitialCentroids.Size() % nbComponents != 0)
+    {
+      itkExceptionMacro(<< "Initial centroids have " << m_InitialCentroids.Size() << " values, which is not a multiple of the " << nbComponents
+                        << " components of the input image");
+    }
+    m_Centroids            = m_InitialCentroids;
+    m_NumberOfClusters     = m_InitialCentroids.Size() / nbComponents;
+    m_CentroidsInitialized = true;
+  }
+  else
+  {
+    if (m_NumberOfClusters == 0)
+    {
+      itkExceptionMacro(<< "The number of clusters must be positive");
+    }
+    m_Centroids.SetSize(m_NumberOfClusters * nbComponents);
+    m_Centroids.Fill(0.);
+    m_CentroidsInitialized = false;
+  }
+
+  m_ClusterSizes.SetSize(m_NumberOfClusters);
+  m_ClusterSizes.Fill(0);
+}
+
+template <class TInputImage>
+void PersistentMiniBatchKMeansImageFilter<TInputImage>::Synthetize()
+{
+  // Centroids are updated after each streamed region
+}
+
+template <class TInputImage>
+void PersistentMiniBatchKMeansImageFilter<TInputImage>::BeforeThreadedGenerateData()
+{
+  const ImageType*   inputPtr     = this->GetInput();
+  const unsigned int nbComponents = inputPtr->GetNumberOfComponentsPerPixel();
+  const RegionType&  region       = this->GetOutput()->GetRequestedRegion();
+
+  if (!m_CentroidsInitialized)
+  {
+    const itk::SizeValueType nbPixels = region.GetNumberOfPixels();
+    if (nbPixels < m_NumberOfClusters)
+    {
+      itkExceptionMacro(<< "Cannot pick " << m_NumberOfClusters << " starting centroids in a region of " << nbPixels << " pixels");
+    }
+
+    // Pixels evenly spread in the region
+    itk::ImageRegionConstIterator<ImageType> it(inputPtr, region);
+    itk::SizeValueType                       position = 0;
+    for (unsigned int c = 0; c < m_NumberOfClusters; ++c)
+    {
+      const itk::SizeValueType target = c * nbPixels / m_NumberOfClusters;
+      for (; position < target; ++position)
+        ++it;
+      const PixelType& pixel = it.Get();
+      for (unsigned int i = 0; i < nbComponents; ++i)
+        m_Centroids[c * nbComponents + i] = static_cast<double>(pixel[i]);
+    }
+    m_CentroidsInitialized = true;
+  }
+
+  const unsigned int nbThreads = this->GetNumberOfThreads();
+  m_ThreadSums.assign(nbThreads, std::vector<double>(m_Centroids.Size(), 0.));
+  m_ThreadCounts.assign(nbThreads, std::vector<itk::SizeValueType>(m_NumberOfClusters, 0));
+}
+
+template <class TInputImage>
+void PersistentMiniBatchKMeansImageFilter<TInputImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  const unsigned int  nbComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+  const double*       centroids    = m_Centroids.data_block();
+  double*             sums         = m_ThreadSums[threadId].data();
+  itk::SizeValueType* counts       = m_ThreadCounts[threadId].data();
+
+  std::vector<double> sample(nbComponents);
+
+  itk::ImageRegionConstIterator<ImageType> it(this->GetInput(), outputRegionForThread);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const PixelType& pixel = it.Get();
+    for (unsigned int i = 0; i < nbComponents; ++i)
+      sample[i] = static_cast<double>(pixel[i]);
+
+    const unsigned int nearest = NearestCentroid(sample.data(), centroids, m_NumberOfClusters, nbComponents);
+
+    double* sum = sums + nearest * nbComponents;
+    for (unsigned int i = 0; i < nbComponents; ++i)
+      sum[i] += sample[i];
+    ++counts[nearest];
+
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage>
+void PersistentMiniBatchKMeansImageFilter<TInputImage>::AfterThreadedGenerateData()
+{
+  const unsigned int nbComponents = this->GetInput()->GetNumberOfComponentsPerPixel();
+
+  // Merge the threads in a fixed order, so that the result does not depend
+  // on which thread finished first
+  for (std::size_t t = 1; t < m_ThreadSums.size(); ++t)
+  {
+    std::transform(m_ThreadSums[0].begin(), m_ThreadSums[0].end(), m_ThreadSums[t].begin(), m_ThreadSums[0].begin(), std::plus<double>());
+    std::transform(m_ThreadCounts[0].begin(), m_ThreadCounts[0].end(), m_ThreadCounts[t].begin(), m_ThreadCounts[0].begin(),
+                   std::plus<itk::SizeValueType>());
+  }
+
+  for (unsigned int c = 0; c < m_NumberOfClusters; ++c)
+  {
+    const itk::SizeValueType count = m_ThreadCounts[0][c];
+    if (count == 0)
+      continue;
+
+    // Learning rate of the centroid: new pixels over all its pixels
+    m_ClusterSizes[c] += count;
+    const double rate = static_cast<double>(count) / m_ClusterSizes[c];
+    for (unsigned int i = 0; i < nbComponents; ++i)
+    {
+      const double mean = m_ThreadSums[0][c * nbComponents + i] / count;
+      m_Centroids[c * nbComponents + i] += rate * (mean - m_Centroids[c * nbComponents + i]);
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentMiniBatchKMeansImageFilter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of clusters: " << m_NumberOfClusters << std::endl;
+  os << indent << "Centroids: " << m_Centroids << std::endl;
+  os << indent << "Cluster sizes: " << m_ClusterSizes << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -27,6 +27,7 @@ otb_module(OTBLearningBase
     OTBCommon
     OTBImageBase
     OTBITK
+    OTBStreaming
 
     OPTIONAL_DEPENDS
     OTBShark
@@ -0,0 +1,95 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbDenseSampleMatrix.h"
+#include <iostream>
+
+int otbDenseSampleMatrix(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::DenseSampleMatrix<float>    MatrixType;
+  typedef itk::VariableLengthVector<double> VectorType;
+
+  const unsigned int nbFeatures = 3;
+  const unsigned int nbSamples  = 10;
+
+  MatrixType::Pointer matrix = MatrixType::New();
+  matrix->SetNumberOfFeatures(nbFeatures);
+  matrix->Reserve(nbSamples);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    float* sample = matrix->PushBack();
+    for (unsigned int j = 0; j < nbFeatures; ++j)
+      sample[j] = static_cast<float>(10 * i + j);
+  }
+
+  if (matrix->GetNumberOfSamples() != nbSamples || matrix->GetSample(3)[2] != 32.f)
+  {
+    std::cout << "Wrong matrix content" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The third component has a null scale and is set to 0
+  VectorType shifts(nbFeatures), scales(nbFeatures);
+  shifts[0] = 0.;
+  shifts[1] = 1.;
+  shifts[2] = 2.;
+  scales[0] = 10.;
+  scales[1] = 2.;
+  scales[2] = 0.;
+  matrix->ShiftScale(shifts, scales);
+
+  MatrixType::ListSampleType::Pointer listSample = matrix->ToListSample();
+  if (listSample->Size() != nbSamples || listSample->GetMeasurementVectorSize() != nbFeatures)
+  {
+    std::cout << "Wrong list sample size" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    const MatrixType::MeasurementVectorType& mv = listSample->GetMeasurementVector(i);
+    if (mv[0] != static_cast<float>(i) || mv[1] != static_cast<float>(5 * i) || mv[2] != 0.f)
+    {
+      std::cout << "Wrong sample " << i << ": " << mv << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // External buffers are used without copy and can not grow
+  std::vector<float> external(nbFeatures * 2, 1.f);
+  MatrixType::Pointer view = MatrixType::New();
+  view->SetExternalBuffer(external.data(), 2, nbFeatures);
+  view->GetSample(1)[0] = 4.f;
+  if (external[nbFeatures] != 4.f || view->GetNumberOfSamples() != 2)
+  {
+    std::cout << "Wrong external buffer content" << std::endl;
+    return EXIT_FAILURE;
+  }
+  try
+  {
+    view->PushBack();
+    std::cout << "An external buffer can not grow" << std::endl;
+    return EXIT_FAILURE;
+  }
+  catch (itk::ExceptionObject&)
+  {
+  }
+
+  return EXIT_SUCCESS;
+}
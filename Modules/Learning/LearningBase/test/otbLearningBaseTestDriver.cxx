@@ -25,6 +25,9 @@ void RegisterTests()
   REGISTER_TEST(otbDecisionTreeBuild);
   REGISTER_TEST(otbKMeansImageClassificationFilter);
   REGISTER_TEST(otbDecisionTreeWithRealValues);
+  REGISTER_TEST(otbStreamingMiniBatchKMeansImageFilter);
+  REGISTER_TEST(otbDenseSampleMatrix);
+  REGISTER_TEST(otbPatchInferenceImageFilter);
 #ifdef OTB_USE_SHARK
   REGISTER_TEST(otbSharkNormalizeLabels);
 #endif
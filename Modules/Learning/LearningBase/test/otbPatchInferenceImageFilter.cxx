@@ -0,0 +1,164 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbPatchInferenceImageFilter.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <cmath>
+
+namespace
+{
+/** Model predicting the bands of the pixels of the patches */
+class PatchIdentityModel : public otb::MachineLearningModel<itk::VariableLengthVector<float>, itk::VariableLengthVector<float>>
+{
+public:
+  typedef PatchIdentityModel Self;
+  typedef otb::MachineLearningModel<itk::VariableLengthVector<float>, itk::VariableLengthVector<float>> Superclass;
+  typedef itk::SmartPointer<Self> Pointer;
+  itkNewMacro(Self);
+  itkTypeMacro(PatchIdentityModel, MachineLearningModel);
+
+  void Train() override
+  {
+  }
+  void Save(const std::string&, const std::string&) override
+  {
+  }
+  void Load(const std::string&, const std::string&) override
+  {
+  }
+  bool CanReadFile(const std::string&) override
+  {
+    return false;
+  }
+  bool CanWriteFile(const std::string&) override
+  {
+    return false;
+  }
+
+  /** Center pixel of the patches, or all of their pixels */
+  bool         m_Dense       = true;
+  unsigned int m_PatchPixels = 1;
+  unsigned int m_PatchCenter = 0;
+
+protected:
+  TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* = nullptr, ProbaSampleType* = nullptr) const override
+  {
+    if (m_Dense)
+    {
+      return input;
+    }
+    const unsigned int nbBands = input.Size() / m_PatchPixels;
+    TargetSampleType   target(nbBands);
+    for (unsigned int band = 0; band < nbBands; ++band)
+    {
+      target[band] = input[band * m_PatchPixels + m_PatchCenter];
+    }
+    return target;
+  }
+};
+}
+
+int otbPatchInferenceImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::VectorImage<float, 2>                           ImageType;
+  typedef otb::PatchInferenceImageFilter<ImageType, ImageType> FilterType;
+
+  ImageType::SizeType size;
+  size[0] = 45;
+  size[1] = 37;
+  ImageType::RegionType region;
+  region.SetSize(size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(2);
+  image->Allocate();
+
+  itk::ImageRegionIterator<ImageType> it(image, region);
+  ImageType::PixelType                pixel(2);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    pixel[0] = it.GetIndex()[0] + 100 * it.GetIndex()[1];
+    pixel[1] = -pixel[0];
+    it.Set(pixel);
+  }
+
+  ImageType::SizeType patchSize;
+  patchSize.Fill(16);
+  ImageType::SizeType margin;
+  margin.Fill(3);
+  ImageType::SizeType overlap;
+  overlap.Fill(4);
+
+  // Whole image, then a streamed region, with dense predictions and then
+  // with center pixel predictions
+  ImageType::RegionType subRegion;
+  subRegion.SetIndex(0, 7);
+  subRegion.SetIndex(1, 30);
+  subRegion.SetSize(0, 20);
+  subRegion.SetSize(1, 7);
+  const ImageType::RegionType regions[2] = {region, subRegion};
+
+  bool failed = false;
+  for (bool dense : {true, false})
+  {
+    for (const ImageType::RegionType& requested : regions)
+    {
+      PatchIdentityModel::Pointer model = PatchIdentityModel::New();
+      model->m_Dense                    = dense;
+      model->m_PatchPixels              = patchSize[0] * patchSize[1];
+      model->m_PatchCenter              = patchSize[1] / 2 * patchSize[0] + patchSize[0] / 2;
+
+      FilterType::Pointer filter = FilterType::New();
+      filter->SetInput(image);
+      filter->SetModel(model);
+      filter->SetPatchSize(patchSize);
+      filter->SetMargin(margin);
+      filter->SetOverlap(overlap);
+      filter->SetNumberOfOutputComponents(2);
+      filter->SetBatchSize(5);
+      filter->SetDenseOutput(dense);
+      filter->UpdateOutputInformation();
+      filter->GetOutput()->SetRequestedRegion(requested);
+      filter->Update();
+
+      // The predictions of the identity model are the input pixels
+      itk::ImageRegionConstIteratorWithIndex<ImageType> outIt(filter->GetOutput(), requested);
+      for (outIt.GoToBegin(); !outIt.IsAtEnd() && !failed; ++outIt)
+      {
+        const ImageType::PixelType expected = image->GetPixel(outIt.GetIndex());
+        for (unsigned int band = 0; band < 2; ++band)
+        {
+          if (std::abs(outIt.Get()[band] - expected[band]) > 1e-3)
+          {
+            std::cout << "Pixel " << outIt.GetIndex() << " band " << band << " (dense: " << dense << "): got " << outIt.Get()[band] << ", expected "
+                      << expected[band] << std::endl;
+            failed = true;
+          }
+        }
+      }
+    }
+  }
+
+  return failed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
@@ -0,0 +1,106 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbStreamingMiniBatchKMeansImageFilter.h"
+#include "otbKMeansImageClassificationFilter.h"
+#include "otbVectorImage.h"
+#include "otbImage.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <cmath>
+
+int otbStreamingMiniBatchKMeansImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  const unsigned int     Dimension = 2;
+  typedef double         PixelType;
+  typedef unsigned short LabeledPixelType;
+
+  typedef otb::VectorImage<PixelType, Dimension>                               ImageType;
+  typedef otb::Image<LabeledPixelType, Dimension>                              LabeledImageType;
+  typedef otb::StreamingMiniBatchKMeansImageFilter<ImageType>                  KMeansFilterType;
+  typedef otb::KMeansImageClassificationFilter<ImageType, LabeledImageType, 2> ClassificationFilterType;
+
+  // Left half around (10, 20), right half around (200, 50)
+  ImageType::SizeType size;
+  size.Fill(64);
+  ImageType::RegionType region;
+  region.SetSize(size);
+
+  ImageType::Pointer image = ImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(2);
+  image->Allocate();
+
+  itk::ImageRegionIterator<ImageType> it(image, region);
+  ImageType::PixelType                pixel(2);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const bool   left  = it.GetIndex()[0] < 32;
+    const double noise = (it.GetIndex()[1] % 5) - 2.;
+    pixel[0]           = (left ? 10. : 200.) + noise;
+    pixel[1]           = (left ? 20. : 50.) - noise;
+    it.Set(pixel);
+  }
+
+  KMeansFilterType::CentroidsType initialCentroids(4);
+  initialCentroids[0] = 0.;
+  initialCentroids[1] = 0.;
+  initialCentroids[2] = 255.;
+  initialCentroids[3] = 100.;
+
+  KMeansFilterType::Pointer kmeans = KMeansFilterType::New();
+  kmeans->SetInput(image);
+  kmeans->SetInitialCentroids(initialCentroids);
+  kmeans->GetStreamer()->SetNumberOfLinesStrippedStreaming(10);
+  kmeans->Update();
+
+  const KMeansFilterType::CentroidsType& centroids = kmeans->GetCentroids();
+  std::cout << "Centroids: " << centroids << std::endl;
+  std::cout << "Cluster sizes: " << kmeans->GetClusterSizes() << std::endl;
+
+  // Centroids are the means of the pixels of each half
+  const double expected[4] = {10., 20., 200., 50.};
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    if (std::abs(centroids[i] - expected[i]) > 0.1)
+    {
+      std::cout << "Wrong centroid value " << centroids[i] << ", expected " << expected[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  ClassificationFilterType::Pointer classifier = ClassificationFilterType::New();
+  classifier->SetInput(image);
+  classifier->SetCentroids(centroids);
+  classifier->Update();
+
+  itk::ImageRegionConstIteratorWithIndex<LabeledImageType> labelIt(classifier->GetOutput(), region);
+  for (labelIt.GoToBegin(); !labelIt.IsAtEnd(); ++labelIt)
+  {
+    const LabeledPixelType expectedLabel = labelIt.GetIndex()[0] < 32 ? 1 : 2;
+    if (labelIt.Get() != expectedLabel)
+    {
+      std::cout << "Wrong label " << labelIt.Get() << " at " << labelIt.GetIndex() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -71,7 +71,7 @@ public:
     return this->m_Parameters;
   }
 
-  void SetParameters(const ParametersType& parameters)
+  virtual void SetParameters(const ParametersType& parameters)
   {
     if (parameters.Size() != m_NumberOfParameters)
     {
@@ -173,7 +173,7 @@ public:
     return this->m_Parameters;
   }
 
-  void SetParameters(const ParametersType& parameters)
+  virtual void SetParameters(const ParametersType& parameters)
   {
     if (parameters.Size() != m_NumberOfParameters)
     {
@@ -23,6 +23,7 @@
 
 #include "otbMRFEnergy.h"
 #include "otbMath.h"
+#include <vector>
 
 namespace otb
 {
@@ -68,9 +69,16 @@ public:
   {
     Superclass::SetNumberOfParameters(nParameters);
     this->m_Parameters.SetSize(nParameters);
+    this->UpdateClassTerms();
     this->Modified();
   }
 
+  void SetParameters(const ParametersType& parameters) override
+  {
+    Superclass::SetParameters(parameters);
+    this->UpdateClassTerms();
+  }
+
   double GetSingleValue(const InputImagePixelType& value1, const LabelledImagePixelType& value2) override
   {
     if ((unsigned int)value2 >= this->GetNumberOfParameters() / 2)
@@ -79,9 +87,8 @@ public:
     }
     double val1 = static_cast<double>(value1);
 
-    double result =
-        vnl_math_sqr(val1 - this->m_Parameters[2 * static_cast<int>(value2)]) / (2 * vnl_math_sqr(this->m_Parameters[2 * static_cast<int>(value2) + 1])) +
-        std::log(std::sqrt(CONST_2PI) * this->m_Parameters[2 * static_cast<int>(value2) + 1]);
+    const unsigned int label  = static_cast<unsigned int>(value2);
+    double             result = vnl_math_sqr(val1 - this->m_Parameters[2 * label]) / m_Denominators[label] + m_LogTerms[label];
 
     return static_cast<double>(result);
   }
@@ -92,6 +99,25 @@ protected:
   ~MRFEnergyGaussianClassification() override
   {
   }
+
+private:
+  /** Compute the terms of the energy which depend only on the class */
+  void UpdateClassTerms()
+  {
+    const unsigned int nbClasses = this->m_Parameters.Size() / 2;
+    m_Denominators.resize(nbClasses);
+    m_LogTerms.resize(nbClasses);
+    for (unsigned int label = 0; label < nbClasses; ++label)
+    {
+      m_Denominators[label] = 2 * vnl_math_sqr(this->m_Parameters[2 * label + 1]);
+      m_LogTerms[label]     = std::log(std::sqrt(CONST_2PI) * this->m_Parameters[2 * label + 1]);
+    }
+  }
+
+  /** 2 sigma^2 of each class */
+  std::vector<double> m_Denominators;
+  /** log(sqrt(2 pi) sigma) of each class */
+  std::vector<double> m_LogTerms;
 };
 }
 
@@ -62,10 +62,14 @@ public:
 
   typedef itk::Array<double> ParametersType;
 
+  typedef typename Superclass::LabelledNeighborhoodIterator LabelledNeighborhoodIterator;
+
   itkTypeMacro(MRFEnergyPotts, MRFEnergy);
 
   itkNewMacro(Self);
 
+  using Superclass::GetValue;
+
   double GetSingleValue(const InputImagePixelType& value1, const LabelledImagePixelType& value2) override
   {
     if (value1 != value2)
@@ -78,6 +82,32 @@ public:
     }
   }
 
+  /** Mean energy over the neighbors, from the number of neighbors with
+   * the same label */
+  double GetValue(const LabelledNeighborhoodIterator& it, const LabelledImagePixelType& value2) override
+  {
+    const unsigned int centerIndex     = it.GetCenterNeighborhoodIndex();
+    bool               isInside        = false;
+    int                insideNeighbors = 0;
+    int                sameNeighbors   = 0;
+    for (unsigned long pos = 0; pos < it.Size(); ++pos)
+    {
+      if (pos != centerIndex)
+      {
+        const LabelledImagePixelType value1 = it.GetPixel(pos, isInside);
+        if (isInside)
+        {
+          ++insideNeighbors;
+          if (value1 == value2)
+          {
+            ++sameNeighbors;
+          }
+        }
+      }
+    }
+    return this->m_Parameters[0] * (insideNeighbors - 2 * sameNeighbors) / insideNeighbors;
+  }
+
 protected:
   // The constructor and destructor.
   MRFEnergyPotts()
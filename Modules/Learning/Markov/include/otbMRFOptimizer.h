@@ -71,6 +71,11 @@ public:
 
   virtual bool Compute(double deltaEnergy) = 0;
 
+  /** Seed the random values of the optimizer, if any */
+  virtual void InitializeSeed(int itkNotUsed(seed))
+  {
+  }
+
 protected:
   MRFOptimizer() : m_NumberOfParameters(1), m_Parameters(1)
   {
@@ -78,6 +83,21 @@ protected:
   ~MRFOptimizer() override
   {
   }
+
+  /** Copy the parameters of the optimizer, so that each thread of the
+   * MarkovRandomFieldFilter has its own optimizer */
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    Self*                     rval  = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (rval == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    rval->m_NumberOfParameters = m_NumberOfParameters;
+    rval->m_Parameters         = m_Parameters;
+    return loPtr;
+  }
   unsigned int   m_NumberOfParameters;
   ParametersType m_Parameters;
 };
@@ -81,7 +81,30 @@ public:
 
   virtual int Compute(const InputImageNeighborhoodIterator& itData, const LabelledImageNeighborhoodIterator& itRegul) = 0;
 
+  /** Seed the random values of the sampler, if any */
+  virtual void InitializeSeed(int itkNotUsed(seed))
+  {
+  }
+
 protected:
+  /** Copy the settings of the sampler, sharing its energies, so that
+   * each thread of the MarkovRandomFieldFilter has its own sampler */
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    Self*                              rval  = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (rval == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    rval->SetNumberOfClasses(m_NumberOfClasses);
+    rval->SetLambda(m_Lambda);
+    rval->SetEnergyRegularization(m_EnergyRegularization);
+    rval->SetEnergyFidelity(m_EnergyFidelity);
+    return loPtr;
+  }
+
+
   unsigned int m_NumberOfClasses;
   double       m_EnergyBefore;
   double       m_EnergyAfter;
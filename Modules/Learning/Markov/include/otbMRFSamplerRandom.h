@@ -80,7 +80,7 @@ public:
   }
 
   /** Methods to cancel random effects.*/
-  void InitializeSeed(int seed)
+  void InitializeSeed(int seed) override
   {
     m_Generator->SetSeed(seed);
   }
@@ -100,6 +100,19 @@ protected:
   {
   }
 
+  /** The copy draws its values from its own generator */
+  itk::LightObject::Pointer InternalClone() const override
+  {
+    itk::LightObject::Pointer loPtr = Superclass::InternalClone();
+    Self*                              rval  = dynamic_cast<Self*>(loPtr.GetPointer());
+    if (rval == nullptr)
+    {
+      itkExceptionMacro(<< "downcast to type " << this->GetNameOfClass() << " failed.");
+    }
+    rval->m_Generator = RandomGeneratorType::New();
+    return loPtr;
+  }
+
 private:
   RandomGeneratorType::Pointer m_Generator;
 };
@@ -36,6 +36,8 @@
 #include "otbMRFOptimizer.h"
 #include "otbMRFSampler.h"
 
+#include <vector>
+
 namespace otb
 {
 /**
@@ -69,6 +71,17 @@ namespace otb
  *   markovFilter->SetSampler(sampler);
  * \endcode
  *
+ * By default the pixels are updated one after the other, in raster
+ * order. With CheckerboardUpdate on, the pixels are split in sets of
+ * pixels whose neighborhoods do not overlap: pixels whose indices are
+ * equal modulo the radius plus one along each dimension, like the two
+ * colors of a checkerboard for 4-connectivity. The sets are updated one
+ * after the other, and the pixels of a set are split between the
+ * threads, each one using its own copy of the sampler and the optimizer.
+ * The result does not depend on the number of threads with a
+ * deterministic sampler and optimizer, but differs from the raster order
+ * update.
+ *
  *
  * \ingroup Markov
  *
@@ -234,6 +247,12 @@ public:
   itkSetMacro(Lambda, double);
   itkGetMacro(Lambda, double);
 
+  /** Update the pixels by independent sets, in parallel, instead of in
+   * raster order. Off by default */
+  itkSetMacro(CheckerboardUpdate, bool);
+  itkGetMacro(CheckerboardUpdate, bool);
+  itkBooleanMacro(CheckerboardUpdate);
+
   /** Set the neighborhood radius */
   void SetNeighborhoodRadius(const NeighborhoodRadiusType&);
 
@@ -343,6 +362,7 @@ protected:
   double            m_Lambda;
   bool              m_ExternalClassificationSet;
   StopConditionType m_StopCondition;
+  bool              m_CheckerboardUpdate;
 
   TrainingImagePointer m_TrainingImage;
 
@@ -361,6 +381,17 @@ protected:
 
   virtual void MinimizeOnce();
 
+  /** Update the pixels of the set of the given color, from the begin-th
+   * to the end-th, with the sampler and the optimizer of a thread.
+   * Returns the number of changed pixels */
+  int MinimizeColor(unsigned int thread, const LabelledImageIndexType& first, const SizeType& counts, unsigned long begin, unsigned long end,
+                    double& deltaEnergy);
+
+  /** Copies of the sampler and the optimizer for each thread of the
+   * checkerboard update */
+  std::vector<SamplerPointer>   m_ThreadSamplers;
+  std::vector<OptimizerPointer> m_ThreadOptimizers;
+
 private:
 }; // class MarkovRandomFieldFilter
 
@@ -23,6 +23,9 @@
 #define otbMarkovRandomFieldFilter_hxx
 #include "otbMarkovRandomFieldFilter.h"
 
+#include <algorithm>
+#include <future>
+
 namespace otb
 {
 template <class TInputImage, class TClassifiedImage>
@@ -39,7 +42,8 @@ MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MarkovRandomFieldFilter(
     m_NumberOfIterations(0),
     m_Lambda(1.0),
     m_ExternalClassificationSet(false),
-    m_StopCondition(MaximumNumberOfIterations)
+    m_StopCondition(MaximumNumberOfIterations),
+    m_CheckerboardUpdate(false)
 {
   m_Generator = RandomGeneratorType::GetInstance();
   m_Generator->SetSeed();
@@ -101,6 +105,8 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::PrintSelf(std::ostr
   os << indent << " Number of iterations: " << m_NumberOfIterations << std::endl;
 
   os << indent << " Lambda: " << m_Lambda << std::endl;
+
+  os << indent << " Checkerboard update: " << m_CheckerboardUpdate << std::endl;
 } // end PrintSelf
 
 /**
@@ -300,6 +306,27 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::Initialize()
   m_Sampler->SetEnergyRegularization(m_EnergyRegularization);
   m_Sampler->SetEnergyFidelity(m_EnergyFidelity);
   m_Sampler->SetNumberOfClasses(m_NumberOfClasses);
+
+  // Copies of the sampler and the optimizer for each thread, seeded from
+  // the generator of the filter
+  m_ThreadSamplers.clear();
+  m_ThreadOptimizers.clear();
+  if (m_CheckerboardUpdate)
+  {
+    const unsigned int numberOfThreads = std::max<unsigned int>(1, this->GetNumberOfThreads());
+    std::vector<int>   seeds(2 * numberOfThreads);
+    for (auto& seed : seeds)
+    {
+      seed = static_cast<int>(m_Generator->GetIntegerVariate() >> 1);
+    }
+    for (unsigned int thread = 0; thread < numberOfThreads; ++thread)
+    {
+      m_ThreadSamplers.push_back(dynamic_cast<SamplerType*>(m_Sampler->Clone().GetPointer()));
+      m_ThreadOptimizers.push_back(dynamic_cast<OptimizerType*>(m_Optimizer->Clone().GetPointer()));
+      m_ThreadSamplers.back()->InitializeSeed(seeds[2 * thread]);
+      m_ThreadOptimizers.back()->InitializeSeed(seeds[2 * thread + 1]);
+    }
+  }
 }
 
 /**
@@ -350,6 +377,54 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::ApplyMarkovRandomFi
 template <class TInputImage, class TClassifiedImage>
 void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MinimizeOnce()
 {
+  if (m_CheckerboardUpdate)
+  {
+    // Pixels farther apart than the radius along a dimension do not
+    // share their neighborhoods: the pixels of a color have the same
+    // indices modulo the radius plus one
+    const LabelledImageRegionType region         = this->GetOutput()->GetLargestPossibleRegion();
+    unsigned int                  numberOfColors = 1;
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      numberOfColors *= m_LabelledImageNeighborhoodRadius[i] + 1;
+    }
+
+    m_ErrorCounter = 0;
+    for (unsigned int color = 0; color < numberOfColors; ++color)
+    {
+      LabelledImageIndexType first;
+      SizeType               counts;
+      unsigned long          numberOfPixels = 1;
+      unsigned int           code           = color;
+      for (unsigned int i = 0; i < InputImageDimension; ++i)
+      {
+        const unsigned long step   = m_LabelledImageNeighborhoodRadius[i] + 1;
+        const unsigned long offset = code % step;
+        code /= step;
+        first[i]  = region.GetIndex(i) + offset;
+        counts[i] = region.GetSize(i) > offset ? (region.GetSize(i) - offset + step - 1) / step : 0;
+        numberOfPixels *= counts[i];
+      }
+
+      const unsigned int            numberOfTasks = m_ThreadSamplers.size();
+      std::vector<double>           deltaEnergies(numberOfTasks, 0.);
+      std::vector<std::future<int>> tasks;
+      for (unsigned int thread = 0; thread < numberOfTasks; ++thread)
+      {
+        const unsigned long begin = numberOfPixels * thread / numberOfTasks;
+        const unsigned long end   = numberOfPixels * (thread + 1) / numberOfTasks;
+        tasks.push_back(std::async(std::launch::async, &Self::MinimizeColor, this, thread, std::cref(first), std::cref(counts), begin, end,
+                                   std::ref(deltaEnergies[thread])));
+      }
+      for (unsigned int thread = 0; thread < numberOfTasks; ++thread)
+      {
+        m_ErrorCounter += tasks[thread].get();
+        m_ImageDeltaEnergy += deltaEnergies[thread];
+      }
+    }
+    return;
+  }
+
   LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, this->GetOutput(), this->GetOutput()->GetLargestPossibleRegion());
   InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), this->GetInput()->GetLargestPossibleRegion());
   m_ErrorCounter = 0;
@@ -371,6 +446,40 @@ void MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MinimizeOnce()
   }
 }
 
+template <class TInputImage, class TClassifiedImage>
+int MarkovRandomFieldFilter<TInputImage, TClassifiedImage>::MinimizeColor(unsigned int thread, const LabelledImageIndexType& first, const SizeType& counts,
+                                                                          unsigned long begin, unsigned long end, double& deltaEnergy)
+{
+  SamplerType*   sampler   = m_ThreadSamplers[thread];
+  OptimizerType* optimizer = m_ThreadOptimizers[thread];
+
+  LabelledImageNeighborhoodIterator labelledIterator(m_LabelledImageNeighborhoodRadius, this->GetOutput(), this->GetOutput()->GetLargestPossibleRegion());
+  InputImageNeighborhoodIterator    dataIterator(m_InputImageNeighborhoodRadius, this->GetInput(), this->GetInput()->GetLargestPossibleRegion());
+  int                               errorCounter = 0;
+
+  LabelledImageIndexType index;
+  for (unsigned long pixel = begin; pixel < end; ++pixel)
+  {
+    unsigned long rest = pixel;
+    for (unsigned int i = 0; i < InputImageDimension; ++i)
+    {
+      index[i] = first[i] + (rest % counts[i]) * (m_LabelledImageNeighborhoodRadius[i] + 1);
+      rest /= counts[i];
+    }
+    labelledIterator.SetLocation(index);
+    dataIterator.SetLocation(index);
+
+    sampler->Compute(dataIterator, labelledIterator);
+    if (optimizer->Compute(sampler->GetDeltaEnergy()))
+    {
+      labelledIterator.SetCenterPixel(sampler->GetValue());
+      ++errorCounter;
+      deltaEnergy += sampler->GetDeltaEnergy();
+    }
+  }
+  return errorCounter;
+}
+
 } // namespace otb
 
 #endif
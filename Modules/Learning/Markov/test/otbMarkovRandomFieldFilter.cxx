@@ -30,6 +30,10 @@
 #include "otbMRFEnergyGaussianClassification.h"
 #include "otbMRFOptimizerMetropolis.h"
 #include "otbMRFSamplerRandom.h"
+#include "otbMRFOptimizerICM.h"
+#include "otbMRFSamplerMAP.h"
+#include "itkImageRegionIterator.h"
+#include "itkImageRegionConstIterator.h"
 
 int otbMarkovRandomFieldFilter(int itkNotUsed(argc), char* argv[])
 {
@@ -109,3 +113,94 @@ int otbMarkovRandomFieldFilter(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbMarkovRandomFieldFilterCheckerboard(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<double, 2>        InputImageType;
+  typedef otb::Image<unsigned char, 2> LabelledImageType;
+
+  typedef otb::MarkovRandomFieldFilter<InputImageType, LabelledImageType>         MarkovRandomFieldFilterType;
+  typedef otb::MRFSamplerMAP<InputImageType, LabelledImageType>                   SamplerType;
+  typedef otb::MRFOptimizerICM                                                    OptimizerType;
+  typedef otb::MRFEnergyPotts<LabelledImageType, LabelledImageType>               EnergyRegularizationType;
+  typedef otb::MRFEnergyGaussianClassification<InputImageType, LabelledImageType> EnergyFidelityType;
+
+  // Noisy image of class 0 on the left and of class 1 on the right
+  InputImageType::SizeType size;
+  size[0] = 60;
+  size[1] = 50;
+  InputImageType::RegionType region;
+  region.SetSize(size);
+
+  InputImageType::Pointer image = InputImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+  for (itk::ImageRegionIterator<InputImageType> it(image, region); !it.IsAtEnd(); ++it)
+  {
+    const InputImageType::IndexType index = it.GetIndex();
+    const double                    noise = (index[0] * 7 + index[1] * 13) % 61 - 30.;
+    it.Set((index[0] < 30 ? 50. : 150.) + noise);
+  }
+
+  // The result with the checkerboard update does not depend on the number
+  // of threads
+  LabelledImageType::Pointer outputs[2];
+  const unsigned int         numberOfThreads[2] = {1, 4};
+  for (unsigned int run = 0; run < 2; ++run)
+  {
+    MarkovRandomFieldFilterType::Pointer markovFilter         = MarkovRandomFieldFilterType::New();
+    EnergyRegularizationType::Pointer    energyRegularization = EnergyRegularizationType::New();
+    EnergyFidelityType::Pointer          energyFidelity       = EnergyFidelityType::New();
+    OptimizerType::Pointer               optimizer            = OptimizerType::New();
+    SamplerType::Pointer                 sampler              = SamplerType::New();
+    markovFilter->InitializeSeed(2);
+
+    energyFidelity->SetNumberOfParameters(4);
+    EnergyFidelityType::ParametersType parameters(4);
+    parameters[0] = 50.0;  // Class 0 mean
+    parameters[1] = 20.0;  // Class 0 stdev
+    parameters[2] = 150.0; // Class 1 mean
+    parameters[3] = 20.0;  // Class 1 stdev
+    energyFidelity->SetParameters(parameters);
+
+    markovFilter->SetNumberOfClasses(2);
+    markovFilter->SetMaximumNumberOfIterations(10);
+    markovFilter->SetErrorTolerance(0.0);
+    markovFilter->SetLambda(1.0);
+    markovFilter->SetNeighborhoodRadius(1);
+    markovFilter->SetEnergyRegularization(energyRegularization);
+    markovFilter->SetEnergyFidelity(energyFidelity);
+    markovFilter->SetOptimizer(optimizer);
+    markovFilter->SetSampler(sampler);
+    markovFilter->CheckerboardUpdateOn();
+    markovFilter->SetNumberOfThreads(numberOfThreads[run]);
+    markovFilter->SetInput(image);
+    markovFilter->Update();
+
+    outputs[run] = markovFilter->GetOutput();
+  }
+
+  unsigned int wrongLabels = 0;
+  itk::ImageRegionConstIterator<LabelledImageType> it1(outputs[0], region);
+  itk::ImageRegionConstIterator<LabelledImageType> it2(outputs[1], region);
+  for (; !it1.IsAtEnd(); ++it1, ++it2)
+  {
+    if (it1.Get() != it2.Get())
+    {
+      std::cout << "Labels differ at " << it1.GetIndex() << " with 1 and 4 threads" << std::endl;
+      return EXIT_FAILURE;
+    }
+    if (it1.Get() != (it1.GetIndex()[0] < 30 ? 0 : 1))
+    {
+      ++wrongLabels;
+    }
+  }
+
+  std::cout << "Wrong labels: " << wrongLabels << std::endl;
+  if (wrongLabels > region.GetNumberOfPixels() / 50)
+  {
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
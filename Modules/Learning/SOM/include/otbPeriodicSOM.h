@@ -83,6 +83,8 @@ public:
   typedef typename MapType::RegionType     RegionType;
   typedef typename MapType::Pointer        MapPointerType;
 
+  typedef typename Superclass::NeighborhoodType NeighborhoodType;
+
 protected:
   /** Constructor */
   PeriodicSOM()
@@ -115,6 +117,13 @@ protected:
   */
   void UpdateMap(const NeuronType& sample, double beta, SizeType& radius) override;
   /**
+  * Get the neurons of the elliptic neighborhood of a winner, on the torus.
+  * \param winner The index of the winner,
+  * \param radius The radius of the neighbourhood,
+  * \param neighborhood The neurons and their weights.
+  */
+  void GetNeighborhood(const IndexType& winner, const SizeType& radius, NeighborhoodType& neighborhood) const override;
+  /**
   * Step one iteration.
   */
   void Step(unsigned int currentIteration) override
@@ -97,6 +97,46 @@ void PeriodicSOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoo
   }
 }
 
+/**
+ * Get the neurons of the elliptic neighborhood of a winner, on the torus,
+ * as updated by UpdateMap().
+ */
+template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, class TSOMNeighborhoodBehaviorFunctor>
+void PeriodicSOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::GetNeighborhood(const IndexType& winner, const SizeType& radius,
+                                                                                                                   NeighborhoodType& neighborhood) const
+{
+  const SizeType mapSize = this->GetOutput()->GetLargestPossibleRegion().GetSize();
+
+  unsigned long neighborhoodSize = 1;
+  for (unsigned int j = 0; j < MapType::ImageDimension; ++j)
+  {
+    neighborhoodSize *= 2 * radius[j] + 1;
+  }
+
+  neighborhood.clear();
+  IndexType positionToUpdate;
+  for (unsigned long i = 0; i < neighborhoodSize; ++i)
+  {
+    // Offset of the i-th neuron of the neighborhood, first dimension first
+    unsigned long rest        = i;
+    double        theDistance = itk::NumericTraits<double>::Zero;
+    for (unsigned int j = 0; j < MapType::ImageDimension; ++j)
+    {
+      const int offset = static_cast<int>(rest % (2 * radius[j] + 1)) - static_cast<int>(radius[j]);
+      rest /= 2 * radius[j] + 1;
+      theDistance += pow(static_cast<double>(offset), 2.0) / pow(static_cast<double>(radius[j]), 2.0);
+
+      int pos             = offset + winner[j];
+      positionToUpdate[j] = (pos >= 0) ? pos % mapSize[j] : (mapSize[j] - ((-pos) % mapSize[j])) % mapSize[j];
+    }
+
+    if (theDistance <= 1.0)
+    {
+      neighborhood.push_back(std::make_pair(positionToUpdate, 1.0 / (1.0 + theDistance)));
+    }
+  }
+}
+
 } // end of namespace otb
 
 #endif
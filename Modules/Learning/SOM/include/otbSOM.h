@@ -28,6 +28,9 @@
 #include "otbCzihoSOMLearningBehaviorFunctor.h"
 #include "otbCzihoSOMNeighborhoodBehaviorFunctor.h"
 
+#include <utility>
+#include <vector>
+
 namespace otb
 {
 /**
@@ -48,6 +51,11 @@ namespace otb
  * The SOMMap produced as output can be either initialized with a constant custom value or randomly
  * generated following a normal law. The seed for the random initialization can be modified.
  *
+ * With BatchTraining on, the samples are learnt by epochs instead of one after the other: the
+ * winners of all the samples are searched in parallel on the map of the previous epoch, then each
+ * neuron moves by the learning coefficient towards the mean of the samples won by its neighborhood,
+ * weighted as in the sequential update. The missing (NaN) components of the samples are ignored.
+ *
  * \sa SOMMap
  * \sa SOMActivationBuilder
  * \sa CzihoSOMLearningBehaviorFunctor
@@ -109,6 +117,11 @@ public:
   itkGetObjectMacro(ListSample, ListSampleType);
   itkSetObjectMacro(ListSample, ListSampleType);
 
+  /** Learn the samples by epochs, in parallel. Off by default */
+  itkSetMacro(BatchTraining, bool);
+  itkGetMacro(BatchTraining, bool);
+  itkBooleanMacro(BatchTraining);
+
   void SetBetaFunctor(const SOMLearningBehaviorFunctorType& functor)
   {
     m_BetaFunctor = functor;
@@ -137,6 +150,24 @@ protected:
    * \param radius The radius of the nieghbourhood.
    */
   virtual void UpdateMap(const NeuronType& sample, double beta, SizeType& radius);
+
+  /** Neurons of a neighborhood, with their weights */
+  typedef std::vector<std::pair<IndexType, double>> NeighborhoodType;
+
+  /**
+   * Get the neurons updated with a winner, and the weight of their update.
+   * \param winner The index of the winner,
+   * \param radius The radius of the neighbourhood,
+   * \param neighborhood The neurons and their weights.
+   */
+  virtual void GetNeighborhood(const IndexType& winner, const SizeType& radius, NeighborhoodType& neighborhood) const;
+
+  /**
+   * Update the output map with all the samples at once.
+   * \param beta The learning coefficient,
+   * \param radius The radius of the neighbourhood.
+   */
+  virtual void UpdateMapBatch(double beta, const SizeType& radius);
   /**
    * Step one iteration.
    */
@@ -165,6 +196,8 @@ private:
   bool m_RandomInit;
   /** Seed for random initialization */
   unsigned int m_Seed;
+  /** Learn the samples by epochs */
+  bool m_BatchTraining;
   /** The input list sample */
   ListSamplePointerType m_ListSample;
   /** Behavior of the Learning weightening (link to the beta coefficient) */
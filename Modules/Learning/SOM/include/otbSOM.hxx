@@ -24,11 +24,17 @@
 
 #include "otbSOM.h"
 #include "itkImageRegionIteratorWithIndex.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkFixedArray.h"
 #include "otbMacro.h"
 #include "itkImageRegionIterator.h"
 #include "itkMersenneTwisterRandomVariateGenerator.h"
 
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <future>
+
 namespace otb
 {
 /**
@@ -49,6 +55,8 @@ SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunc
   m_MaxWeight  = static_cast<ValueType>(128.0);
   m_RandomInit = false;
   m_Seed       = 123574651;
+
+  m_BatchTraining = false;
 }
 /**
  * Destructor
@@ -116,6 +124,121 @@ void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehavio
     it.Set(newNeuron);
   }
 }
+/**
+ * Get the neurons updated with a winner: the square of the given radius
+ * around it, with weights decreasing with the distance.
+ */
+template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, class TSOMNeighborhoodBehaviorFunctor>
+void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::GetNeighborhood(const IndexType& winner, const SizeType& radius,
+                                                                                                           NeighborhoodType& neighborhood) const
+{
+  typedef itk::ImageRegionConstIteratorWithIndex<MapType> IteratorType;
+
+  const MapType* map = this->GetOutput();
+
+  RegionType localRegion;
+  SizeType   localSize;
+  for (unsigned int i = 0; i < MapType::ImageDimension; ++i)
+  {
+    localSize[i] = 2 * radius[i] + 1;
+  }
+  localRegion.SetIndex(winner - radius);
+  localRegion.SetSize(localSize);
+  localRegion.Crop(map->GetLargestPossibleRegion());
+
+  neighborhood.clear();
+  for (IteratorType it(map, localRegion); !it.IsAtEnd(); ++it)
+  {
+    double distance = 0.;
+    for (unsigned int i = 0; i < MapType::ImageDimension; ++i)
+    {
+      distance += vnl_math_sqr(static_cast<double>(it.GetIndex()[i] - winner[i]));
+    }
+    neighborhood.push_back(std::make_pair(it.GetIndex(), 1. / (1. + std::sqrt(distance))));
+  }
+}
+/**
+ * Update the output map with all the samples at once.
+ */
+template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, class TSOMNeighborhoodBehaviorFunctor>
+void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::UpdateMapBatch(double beta, const SizeType& radius)
+{
+  MapPointerType      map          = this->GetOutput(0);
+  const unsigned int  nbComponents = map->GetNumberOfComponentsPerPixel();
+  const unsigned long nbNeurons    = map->GetLargestPossibleRegion().GetNumberOfPixels();
+  const unsigned long nbSamples    = m_ListSample->Size();
+  const unsigned long nbTasks      = std::max<unsigned long>(1, std::min<unsigned long>(this->GetNumberOfThreads(), nbSamples));
+
+  // Sums and numbers of the components of the samples won by each neuron,
+  // without the missing components
+  std::vector<std::vector<double>> sums(nbTasks, std::vector<double>(nbNeurons * nbComponents, 0.));
+  std::vector<std::vector<double>> counts(nbTasks, std::vector<double>(nbNeurons * nbComponents, 0.));
+  std::vector<std::future<void>>   tasks;
+  for (unsigned long task = 0; task < nbTasks; ++task)
+  {
+    const unsigned long begin = nbSamples * task / nbTasks;
+    const unsigned long end   = nbSamples * (task + 1) / nbTasks;
+    tasks.push_back(std::async(std::launch::async, [this, &map, &sums, &counts, task, begin, end, nbComponents]() {
+      for (unsigned long id = begin; id < end; ++id)
+      {
+        const NeuronType    sample = m_ListSample->GetMeasurementVector(id);
+        const unsigned long offset = map->ComputeOffset(map->GetWinner(sample)) * nbComponents;
+        for (unsigned int i = 0; i < nbComponents; ++i)
+        {
+          const double value = static_cast<double>(sample[i]);
+          if (!std::isnan(value))
+          {
+            sums[task][offset + i] += value;
+            counts[task][offset + i] += 1.;
+          }
+        }
+      }
+    }));
+  }
+  for (unsigned long task = 0; task < nbTasks; ++task)
+  {
+    tasks[task].get();
+    if (task > 0)
+    {
+      std::transform(sums[task].begin(), sums[task].end(), sums[0].begin(), sums[0].begin(), std::plus<double>());
+      std::transform(counts[task].begin(), counts[task].end(), counts[0].begin(), counts[0].begin(), std::plus<double>());
+    }
+  }
+
+  // Spread the sums of each winner over its neighborhood
+  std::vector<double> numerators(nbNeurons * nbComponents, 0.);
+  std::vector<double> weights(nbNeurons * nbComponents, 0.);
+  NeighborhoodType    neighborhood;
+  for (unsigned long winner = 0; winner < nbNeurons; ++winner)
+  {
+    const double* winnerCounts = counts[0].data() + winner * nbComponents;
+    if (std::all_of(winnerCounts, winnerCounts + nbComponents, [](double count) { return count == 0.; }))
+    {
+      continue;
+    }
+    const double* winnerSums = sums[0].data() + winner * nbComponents;
+    this->GetNeighborhood(map->ComputeIndex(winner), radius, neighborhood);
+    for (const auto& neighbor : neighborhood)
+    {
+      const unsigned long offset = map->ComputeOffset(neighbor.first) * nbComponents;
+      for (unsigned int i = 0; i < nbComponents; ++i)
+      {
+        numerators[offset + i] += neighbor.second * winnerSums[i];
+        weights[offset + i] += neighbor.second * winnerCounts[i];
+      }
+    }
+  }
+
+  // Move the neurons towards the weighted means
+  ValueType* neurons = map->GetBufferPointer();
+  for (unsigned long i = 0; i < nbNeurons * nbComponents; ++i)
+  {
+    if (weights[i] > 0.)
+    {
+      neurons[i] += static_cast<ValueType>((numerators[i] / weights[i] - neurons[i]) * beta);
+    }
+  }
+}
 /**
  * Step one iteration.
  */
@@ -130,6 +253,11 @@ void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehavio
 
   // update the neurons map with each example of the training set.
   otbMsgDebugMacro(<< "Beta: " << newBeta << ", radius: " << newSize);
+  if (m_BatchTraining)
+  {
+    this->UpdateMapBatch(newBeta, newSize);
+    return;
+  }
   for (typename ListSampleType::Iterator it = m_ListSample->Begin(); it != m_ListSample->End(); ++it)
   {
     UpdateMap(it.GetMeasurementVector(), newBeta, newSize);
@@ -221,6 +349,7 @@ template <class TListSample, class TMap, class TSOMLearningBehaviorFunctor, clas
 void SOM<TListSample, TMap, TSOMLearningBehaviorFunctor, TSOMNeighborhoodBehaviorFunctor>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
   Superclass::PrintSelf(os, indent);
+  os << indent << "BatchTraining: " << m_BatchTraining << std::endl;
 }
 
 } // end namespace otb
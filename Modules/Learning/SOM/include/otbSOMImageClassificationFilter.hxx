@@ -25,6 +25,8 @@
 #include "itkImageRegionIterator.h"
 #include "itkNumericTraits.h"
 
+#include <vector>
+
 namespace otb
 {
 /**
@@ -75,9 +77,7 @@ void SOMImageClassificationFilter<TInputImage, TOutputImage, TSOMMap, TMaskImage
   typedef itk::ImageRegionConstIterator<InputImageType> InputIteratorType;
   typedef itk::ImageRegionConstIterator<MaskImageType>  MaskIteratorType;
   typedef itk::ImageRegionIterator<OutputImageType>     OutputIteratorType;
-
-  ListSamplePointerType listSample = ListSampleType::New();
-  listSample->SetMeasurementVectorSize(inputPtr->GetNumberOfComponentsPerPixel());
+  typedef typename SampleType::ComponentType            ComponentType;
 
   InputIteratorType inIt(inputPtr, outputRegionForThread);
 
@@ -91,6 +91,10 @@ void SOMImageClassificationFilter<TInputImage, TOutputImage, TSOMMap, TMaskImage
   unsigned int sampleSize   = std::min(inputPtr->GetNumberOfComponentsPerPixel(), maxDimension);
   bool         validPoint   = true;
 
+  // Gather the valid pixels, one after the other, to search all their
+  // winners at once
+  std::vector<ComponentType> samples;
+  samples.reserve(outputRegionForThread.GetNumberOfPixels() * sampleSize);
   for (inIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt)
   {
     if (inputMaskPtr)
@@ -100,36 +104,21 @@ void SOMImageClassificationFilter<TInputImage, TOutputImage, TSOMMap, TMaskImage
     }
     if (validPoint)
     {
-      SampleType sample;
-      sample.SetSize(sampleSize);
-      sample.Fill(itk::NumericTraits<ValueType>::ZeroValue());
       for (unsigned int i = 0; i < sampleSize; ++i)
       {
-        sample[i] = inIt.Get()[i];
+        samples.push_back(static_cast<ComponentType>(inIt.Get()[i]));
       }
-      listSample->PushBack(sample);
     }
   }
-  ClassifierPointerType classifier = ClassifierType::New();
-  classifier->SetMap(m_Map);
-  classifier->SetSample(listSample);
-  classifier->Update();
-
-  typename ClassifierType::OutputType::Pointer       membershipSample = classifier->GetOutput();
-  typename ClassifierType::OutputType::ConstIterator sampleIter       = membershipSample->Begin();
-  typename ClassifierType::OutputType::ConstIterator sampleLast       = membershipSample->End();
 
-  OutputIteratorType outIt(outputPtr, outputRegionForThread);
+  const unsigned int                          nbSamples = sampleSize > 0 ? samples.size() / sampleSize : 0;
+  std::vector<typename SOMMapType::IndexType> winners(nbSamples);
+  m_Map->GetWinners(samples.data(), nbSamples, sampleSize, winners.data());
 
-  outIt.GoToBegin();
+  // Same labels as SOMClassifier
+  const typename SOMMapType::SizeType size = m_Map->GetLargestPossibleRegion().GetSize();
 
-  while (!outIt.IsAtEnd() && (sampleIter != sampleLast))
-  {
-    outIt.Set(m_DefaultLabel);
-    ++outIt;
-  }
-
-  outIt.GoToBegin();
+  OutputIteratorType outIt(outputPtr, outputRegionForThread);
 
   if (inputMaskPtr)
   {
@@ -137,19 +126,23 @@ void SOMImageClassificationFilter<TInputImage, TOutputImage, TSOMMap, TMaskImage
   }
   validPoint = true;
 
-  while (!outIt.IsAtEnd() && (sampleIter != sampleLast))
+  unsigned int sample = 0;
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
   {
     if (inputMaskPtr)
     {
       validPoint = maskIt.Get() > 0;
       ++maskIt;
     }
-    if (validPoint)
+    if (validPoint && sample < nbSamples)
+    {
+      const typename SOMMapType::IndexType& index = winners[sample++];
+      outIt.Set(static_cast<LabelType>((index[1] * size[1]) + index[0]));
+    }
+    else
     {
-      outIt.Set(sampleIter.GetClassLabel());
-      ++sampleIter;
+      outIt.Set(m_DefaultLabel);
     }
-    ++outIt;
   }
 }
 /**
@@ -26,6 +26,8 @@
 #include "itkEuclideanDistanceMetric.h"
 #include "otbVectorImage.h"
 
+#include <type_traits>
+
 namespace otb
 {
 /**
@@ -43,6 +45,11 @@ namespace otb
  * The training is done via the SOM class, and the activation map can be produced with the SOMActivationBuilder
  * class.
  *
+ * With the default euclidean distance, the winners are searched on the squared distances, directly in the
+ * buffer of the map. GetWinners() searches the winners of many samples at once on a copy of the map stored
+ * component after component, so that the distances to all the neurons are accumulated by contiguous loops
+ * the compiler can vectorize.
+ *
  * \sa SOM
  * \sa SOMActivationBuilder
  *
@@ -86,6 +93,16 @@ public:
    */
   IndexType GetWinner(const NeuronType& sample);
 
+  /**
+   * Get the indices of the winning neurons of several samples.
+   * \param samples The samples, one after the other,
+   * \param nbSamples The number of samples,
+   * \param nbComponents The number of components of a sample, compared
+   * to the first components of the neurons,
+   * \param winners The indices of the winning neurons.
+   */
+  void GetWinners(const typename NeuronType::ComponentType* samples, unsigned int nbSamples, unsigned int nbComponents, IndexType* winners);
+
 protected:
   /** Constructor */
   SOMMap();
@@ -25,6 +25,10 @@
 #include "otbSOMMap.h"
 #include "itkImageRegionIteratorWithIndex.h"
 
+#include <algorithm>
+#include <limits>
+#include <vector>
+
 namespace otb
 {
 /**
@@ -49,6 +53,36 @@ SOMMap<TNeuron, TDistance, VMapDimension>::~SOMMap()
 template <class TNeuron, class TDistance, unsigned int        VMapDimension>
 typename SOMMap<TNeuron, TDistance, VMapDimension>::IndexType SOMMap<TNeuron, TDistance, VMapDimension>::GetWinner(const NeuronType& sample)
 {
+  // The squared euclidean distances give the same winner without the
+  // square roots
+  if (std::is_same<DistanceType, itk::Statistics::EuclideanDistanceMetric<NeuronType>>::value &&
+      this->GetBufferedRegion() == this->GetLargestPossibleRegion())
+  {
+    typedef typename NeuronType::ComponentType ComponentType;
+    const unsigned int                         nbComponents = this->GetNumberOfComponentsPerPixel();
+    const unsigned int                         sampleSize   = std::min<unsigned int>(sample.Size(), nbComponents);
+    const unsigned long                        nbNeurons    = this->GetLargestPossibleRegion().GetNumberOfPixels();
+    const ComponentType*                       neuron       = this->GetBufferPointer();
+
+    double        minDistance = std::numeric_limits<double>::max();
+    unsigned long minOffset   = 0;
+    for (unsigned long offset = 0; offset < nbNeurons; ++offset, neuron += nbComponents)
+    {
+      double distance = 0.;
+      for (unsigned int i = 0; i < sampleSize; ++i)
+      {
+        const double temp = sample[i] - neuron[i];
+        distance += temp * temp;
+      }
+      if (distance <= minDistance)
+      {
+        minDistance = distance;
+        minOffset   = offset;
+      }
+    }
+    return this->ComputeIndex(minOffset);
+  }
+
   // Some typedefs
   typedef itk::ImageRegionIteratorWithIndex<Self> IteratorType;
 
@@ -77,6 +111,71 @@ typename SOMMap<TNeuron, TDistance, VMapDimension>::IndexType SOMMap<TNeuron, TD
   // Return the index of the winner
   return minPos;
 }
+/**
+ * Get the indices of the winning neurons of several samples.
+ */
+template <class TNeuron, class TDistance, unsigned int VMapDimension>
+void SOMMap<TNeuron, TDistance, VMapDimension>::GetWinners(const typename NeuronType::ComponentType* samples, unsigned int nbSamples,
+                                                           unsigned int nbComponents, IndexType* winners)
+{
+  typedef typename NeuronType::ComponentType ComponentType;
+
+  if (!std::is_same<DistanceType, itk::Statistics::EuclideanDistanceMetric<NeuronType>>::value ||
+      this->GetBufferedRegion() != this->GetLargestPossibleRegion())
+  {
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const NeuronType sample(const_cast<ComponentType*>(samples + s * nbComponents), nbComponents, false);
+      winners[s] = this->GetWinner(sample);
+    }
+    return;
+  }
+
+  // Copy of the neurons, component after component
+  const unsigned int   mapComponents = this->GetNumberOfComponentsPerPixel();
+  const unsigned long  nbNeurons     = this->GetLargestPossibleRegion().GetNumberOfPixels();
+  const unsigned int   sampleSize    = std::min(nbComponents, mapComponents);
+  const ComponentType* buffer        = this->GetBufferPointer();
+
+  std::vector<ComponentType> components(sampleSize * nbNeurons);
+  for (unsigned long n = 0; n < nbNeurons; ++n)
+  {
+    for (unsigned int i = 0; i < sampleSize; ++i)
+    {
+      components[i * nbNeurons + n] = buffer[n * mapComponents + i];
+    }
+  }
+
+  std::vector<double> distances(nbNeurons);
+  for (unsigned int s = 0; s < nbSamples; ++s)
+  {
+    const ComponentType* sample = samples + s * nbComponents;
+    std::fill(distances.begin(), distances.end(), 0.);
+    for (unsigned int i = 0; i < sampleSize; ++i)
+    {
+      const ComponentType  value    = sample[i];
+      const ComponentType* neurons  = components.data() + i * nbNeurons;
+      double*              distance = distances.data();
+      for (unsigned long n = 0; n < nbNeurons; ++n)
+      {
+        const double temp = value - neurons[n];
+        distance[n] += temp * temp;
+      }
+    }
+
+    // The last neuron at the minimum distance wins, as in GetWinner()
+    unsigned long minOffset = 0;
+    for (unsigned long n = 1; n < nbNeurons; ++n)
+    {
+      if (distances[n] <= distances[minOffset])
+      {
+        minOffset = n;
+      }
+    }
+    winners[s] = this->ComputeIndex(minOffset);
+  }
+}
+
 template <class TNeuron, class TDistance, unsigned int VMapDimension>
 void SOMMap<TNeuron, TDistance, VMapDimension>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
@@ -27,7 +27,7 @@
 #include "itkListSample.h"
 #include "itkImageRegionIterator.h"
 
-int otbSOM(int itkNotUsed(argc), char* argv[])
+int otbSOM(int argc, char* argv[])
 {
   const unsigned int Dimension      = 2;
   char*              inputFileName  = argv[1];
@@ -40,6 +40,7 @@ int otbSOM(int itkNotUsed(argc), char* argv[])
   double             betaInit       = atof(argv[8]);
   double             betaEnd        = atof(argv[9]);
   double             initValue      = atof(argv[10]);
+  bool               batchTraining  = argc > 11 && atoi(argv[11]) != 0;
 
   typedef double                                              ComponentType;
   typedef itk::VariableLengthVector<ComponentType>            PixelType;
@@ -87,6 +88,7 @@ int otbSOM(int itkNotUsed(argc), char* argv[])
   som->SetBetaEnd(betaEnd);
   som->SetMaxWeight(initValue);
   som->SetRandomInit(false);
+  som->SetBatchTraining(batchTraining);
 
   WriterType::Pointer writer = WriterType::New();
   writer->SetFileName(outputFileName);
@@ -21,6 +21,7 @@
 #include "itkMacro.h"
 #include "otbSOMMap.h"
 #include "itkRGBPixel.h"
+#include <vector>
 
 int otbSOMMap(int itkNotUsed(argc), char* itkNotUsed(argv)[])
 {
@@ -66,5 +67,39 @@ int otbSOMMap(int itkNotUsed(argc), char* itkNotUsed(argv)[])
     return EXIT_FAILURE;
   }
 
+  // The winners of several samples at once are the same
+  for (unsigned int i = 0; i < 100; ++i)
+  {
+    index[0] = (i * 37) % 64;
+    index[1] = (i * 11) % 64;
+    PixelType neuron(3);
+    neuron[0] = i;
+    neuron[1] = 100 - i;
+    neuron[2] = 0.5 * i;
+    somMap->SetPixel(index, neuron);
+  }
+  std::vector<InternalPixelType> samples;
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    samples.push_back(2 * i + 0.3);
+    samples.push_back(90 - i);
+    samples.push_back(i);
+  }
+  std::vector<SOMMapType::IndexType> winners(50);
+  somMap->GetWinners(samples.data(), 50, 3, winners.data());
+  for (unsigned int i = 0; i < 50; ++i)
+  {
+    PixelType sample(3);
+    for (unsigned int j = 0; j < 3; ++j)
+    {
+      sample[j] = samples[3 * i + j];
+    }
+    if (winners[i] != somMap->GetWinner(sample))
+    {
+      std::cout << "Bad GetWinners function return for sample " << i << ": " << winners[i] << " instead of " << somMap->GetWinner(sample) << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
   return EXIT_SUCCESS;
 }
@@ -24,6 +24,7 @@
 #include "otbPersistentSamplingFilterBase.h"
 #include "otbPersistentFilterStreamingDecorator.h"
 #include "otbOGRDataSourceWrapper.h"
+#include "otbSampleTable.h"
 #include "otbImage.h"
 #include <string>
 
@@ -35,6 +36,12 @@ namespace otb
  *
  * \brief Persistent filter to extract sample values from an image
  *
+ * Samples are written either to an OGR container (SetOutputSamples()), or to
+ * a column-oriented SampleTable (SetOutputSampleTable()). In the latter case,
+ * each thread fills its own table, and the thread tables are gathered by
+ * Synthetize(). The columns of the table are the class field, when set, then
+ * the sample fields.
+ *
  * \ingroup OTBSampling
  */
 template <class TInputImage>
@@ -73,9 +80,14 @@ public:
   /** Get the output samples OGR container */
   ogr::DataSource* GetOutputSamples();
 
-  void Synthetize(void) override
-  {
-  }
+  /** Set the output sample table, used instead of an OGR container */
+  void SetOutputSampleTable(SampleTable* table);
+
+  /** Get the output sample table */
+  SampleTable* GetOutputSampleTable();
+
+  /** Gather the thread sample tables into the output one */
+  void Synthetize(void) override;
 
   /** Reset method called before starting the streaming*/
   void Reset(void) override;
@@ -117,6 +129,12 @@ private:
 
   /** List of field names for each component */
   std::vector<std::string> m_SampleFieldNames;
+
+  /** Output sample table, if any */
+  SampleTable::Pointer m_OutputSampleTable;
+
+  /** Samples extracted by each thread, when writing to a sample table */
+  std::vector<SampleTable::Pointer> m_ThreadSampleTables;
 };
 
 /**
@@ -160,6 +178,9 @@ public:
   void SetOutputSamples(OGRDataType::Pointer data);
   const otb::ogr::DataSource* GetOutputSamples();
 
+  void SetOutputSampleTable(SampleTable* table);
+  SampleTable* GetOutputSampleTable();
+
   void SetOutputFieldPrefix(const std::string& key);
   std::string GetOutputFieldPrefix();
 
@@ -52,6 +52,33 @@ ogr::DataSource* PersistentImageSampleExtractorFilter<TInputImage>::GetOutputSam
   return static_cast<ogr::DataSource*>(this->itk::ProcessObject::GetOutput(1));
 }
 
+template <class TInputImage>
+void PersistentImageSampleExtractorFilter<TInputImage>::SetOutputSampleTable(SampleTable* table)
+{
+  m_OutputSampleTable = table;
+  this->Modified();
+}
+
+template <class TInputImage>
+SampleTable* PersistentImageSampleExtractorFilter<TInputImage>::GetOutputSampleTable()
+{
+  return m_OutputSampleTable;
+}
+
+template <class TInputImage>
+void PersistentImageSampleExtractorFilter<TInputImage>::Synthetize(void)
+{
+  if (m_OutputSampleTable.IsNull())
+  {
+    return;
+  }
+  for (auto& table : m_ThreadSampleTables)
+  {
+    m_OutputSampleTable->Append(*table);
+  }
+  m_ThreadSampleTables.clear();
+}
+
 template <class TInputImage>
 void PersistentImageSampleExtractorFilter<TInputImage>::Reset(void)
 {
@@ -83,7 +110,29 @@ void PersistentImageSampleExtractorFilter<TInputImage>::Reset(void)
   // initialize output DataSource
   ogr::DataSource* inputDS = const_cast<ogr::DataSource*>(this->GetOGRData());
   ogr::DataSource* output  = this->GetOutputSamples();
-  this->InitializeOutputDataSource(inputDS, output);
+  if (output)
+  {
+    this->InitializeOutputDataSource(inputDS, output);
+  }
+
+  // initialize output and thread sample tables
+  m_ThreadSampleTables.clear();
+  if (m_OutputSampleTable.IsNotNull())
+  {
+    SampleTable::NameListType columns;
+    if (!this->GetFieldName().empty())
+    {
+      columns.push_back(this->GetFieldName());
+    }
+    columns.insert(columns.end(), m_SampleFieldNames.begin(), m_SampleFieldNames.end());
+    m_OutputSampleTable->SetColumnNames(columns);
+
+    for (unsigned int i = 0; i < this->GetNumberOfThreads(); ++i)
+    {
+      m_ThreadSampleTables.push_back(SampleTable::New());
+      m_ThreadSampleTables.back()->SetColumnNames(columns);
+    }
+  }
 }
 
 template <class TInputImage>
@@ -156,7 +205,15 @@ void PersistentImageSampleExtractorFilter<TInputImage>::ThreadedGenerateVectorDa
   TInputImage* inputImage = const_cast<TInputImage*>(this->GetInput());
   unsigned int nbBand     = inputImage->GetNumberOfComponentsPerPixel();
 
-  ogr::Layer outputLayer = this->GetInMemoryOutput(threadid);
+  // Either write into the thread sample table, or into the in-memory layer
+  SampleTable* table = m_OutputSampleTable.IsNotNull() ? m_ThreadSampleTables[threadid].GetPointer() : nullptr;
+  ogr::Layer   outputLayer(nullptr, false);
+  if (!table)
+  {
+    outputLayer = this->GetInMemoryOutput(threadid);
+  }
+  const bool                          hasClassColumn = table && !this->GetFieldName().empty();
+  std::vector<SampleTable::ValueType> row(table ? table->GetNumberOfColumns() : 0);
 
   itk::ProgressReporter progress(this, threadid, layerForThread.GetFeatureCount(true));
 
@@ -187,6 +244,21 @@ void PersistentImageSampleExtractorFilter<TInputImage>::ThreadedGenerateVectorDa
       inputImage->TransformPhysicalPointToIndex(imgPoint, imgIndex);
       imgPixel = inputImage->GetPixel(imgIndex);
 
+      if (table)
+      {
+        unsigned int column = 0;
+        if (hasClassColumn)
+        {
+          row[column++] = featIt->ogr().GetFieldAsDouble(this->GetFieldIndex());
+        }
+        for (unsigned int i = 0; i < nbBand; ++i)
+        {
+          row[column++] = static_cast<double>(itk::DefaultConvertPixelTraits<PixelType>::GetNthComponent(i, imgPixel));
+        }
+        table->AppendRow(row.data());
+        break;
+      }
+
       ogr::Feature dstFeature(outputLayer.GetLayerDefn());
       dstFeature.SetFrom(*featIt, TRUE);
       dstFeature.SetFID(featIt->GetFID());
@@ -258,6 +330,18 @@ const otb::ogr::DataSource* ImageSampleExtractorFilter<TInputImage>::GetOutputSa
   return this->GetFilter()->GetOutputSamples();
 }
 
+template <class TInputImage>
+void ImageSampleExtractorFilter<TInputImage>::SetOutputSampleTable(SampleTable* table)
+{
+  this->GetFilter()->SetOutputSampleTable(table);
+}
+
+template <class TInputImage>
+SampleTable* ImageSampleExtractorFilter<TInputImage>::GetOutputSampleTable()
+{
+  return this->GetFilter()->GetOutputSampleTable();
+}
+
 template <class TInputImage>
 void ImageSampleExtractorFilter<TInputImage>::SetOutputFieldPrefix(const std::string& key)
 {
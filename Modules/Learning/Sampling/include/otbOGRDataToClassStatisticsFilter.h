@@ -70,6 +70,12 @@ public:
   /** Reset method called before starting the streaming*/
   void Reset(void) override;
 
+  /** The counts are merged over the processes sharing the streaming */
+  bool SupportsDistributedStreaming() const override
+  {
+    return true;
+  }
+
   /** the class count map is stored as output #2 */
   const ClassCountObjectType* GetClassCountOutput() const;
   ClassCountObjectType*       GetClassCountOutput();
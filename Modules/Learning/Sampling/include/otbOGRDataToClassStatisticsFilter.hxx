@@ -23,6 +23,8 @@
 
 #include "otbOGRDataToClassStatisticsFilter.h"
 
+#include <sstream>
+
 namespace otb
 {
 // --------- otb::PersistentOGRDataToClassStatisticsFilter ---------------------
@@ -77,6 +79,46 @@ void PersistentOGRDataToClassStatisticsFilter<TInputImage, TMaskImage>::Syntheti
     }
   }
 
+  // Merge the counts of the processes which streamed the other splits
+  if (ProcessGroup* group = this->GetProcessGroup())
+  {
+    std::ostringstream oss;
+    oss << classCount.size() << " ";
+    for (const auto& count : classCount)
+    {
+      oss << count.first.size() << " " << count.first << " " << count.second << " ";
+    }
+    for (const auto& size : polygonSize)
+    {
+      oss << size.first << " " << size.second << " ";
+    }
+
+    classCount.clear();
+    polygonSize.clear();
+    for (const auto& buffer : group->AllGather(oss.str()))
+    {
+      std::istringstream iss(buffer);
+      std::size_t        nbClasses = 0;
+      iss >> nbClasses;
+      for (std::size_t i = 0; i < nbClasses; ++i)
+      {
+        std::size_t   length = 0;
+        unsigned long count  = 0;
+        iss >> length;
+        iss.ignore(1);
+        std::string className(length, ' ');
+        iss.read(&className[0], length);
+        iss >> count;
+        classCount[className] += count;
+      }
+      unsigned long fid = 0, size = 0;
+      while (iss >> fid >> size)
+      {
+        polygonSize[fid] += size;
+      }
+    }
+  }
+
   m_ElmtsInClassThread.clear();
   m_PolygonThread.clear();
   m_NbPixelsThread.clear();
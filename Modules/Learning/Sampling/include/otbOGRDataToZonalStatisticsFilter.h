@@ -0,0 +1,254 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbOGRDataToZonalStatisticsFilter_h
+#define otbOGRDataToZonalStatisticsFilter_h
+
+#include "otbPersistentSamplingFilterBase.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "otbStreamingStatisticsMapFromLabelImageFilter.h"
+#include <map>
+#include <vector>
+
+namespace otb
+{
+
+/**
+ * \class PersistentOGRDataToZonalStatisticsFilter
+ *
+ * \brief Persistent filter to compute the statistics of the pixels of an
+ * image inside each feature of a vector layer
+ *
+ * For each feature, the count of pixels, and the mean, unbiased standard
+ * deviation, min and max of each band are computed, indexed by the FID of
+ * the feature. This is what ZonalStatistics computes from a rasterization
+ * of the features, without rasterizing the whole image: each streamed tile
+ * only reads the features selected by the spatial filter of the layer
+ * (which uses the spatial index of the data source, if any), and the
+ * polygons are scan-converted over the tile. As the features are processed
+ * one by one, overlapping features all get the pixels they share.
+ *
+ * A pixel is inside a polygon when its center is inside, as in
+ * PersistentSamplingFilterBase. Points and lines are also supported. The
+ * vectors must be in the projection of the image.
+ *
+ * \sa PersistentStreamingStatisticsMapFromLabelImageFilter
+ *
+ * \ingroup OTBSampling
+ */
+template <class TInputImage, class TMaskImage = otb::Image<unsigned char, 2>>
+class ITK_EXPORT PersistentOGRDataToZonalStatisticsFilter : public PersistentSamplingFilterBase<TInputImage, TMaskImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentOGRDataToZonalStatisticsFilter Self;
+  typedef PersistentSamplingFilterBase<TInputImage, TMaskImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef TInputImage                         InputImageType;
+  typedef typename InputImageType::Pointer    InputImagePointer;
+  typedef typename InputImageType::RegionType RegionType;
+  typedef typename InputImageType::IndexType  IndexType;
+  typedef typename InputImageType::PointType  PointType;
+  typedef TMaskImage                          MaskImageType;
+
+  typedef itk::VariableLengthVector<double>          RealVectorPixelType;
+  typedef StatisticsAccumulator<RealVectorPixelType> AccumulatorType;
+  typedef std::map<unsigned long, AccumulatorType>   AccumulatorMapType;
+
+  /** Statistics maps, indexed by FID */
+  typedef std::map<unsigned long, RealVectorPixelType> PixelValueMapType;
+  typedef std::map<unsigned long, double>              FeaturePopulationMapType;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentOGRDataToZonalStatisticsFilter, PersistentSamplingFilterBase);
+
+  /** Set/Get the no-data value, ignored in the statistics of a band */
+  itkSetMacro(NoDataValue, double);
+  itkGetMacro(NoDataValue, double);
+  itkSetMacro(UseNoDataValue, bool);
+  itkGetMacro(UseNoDataValue, bool);
+
+  void Synthetize(void) override;
+
+  /** Reset method called before starting the streaming*/
+  void Reset(void) override;
+
+  /** Return the computed Mean for each feature */
+  PixelValueMapType GetMeanValueMap() const;
+
+  /** Return the computed Standard Deviation for each feature */
+  PixelValueMapType GetStandardDeviationValueMap() const;
+
+  /** Return the computed Min for each feature */
+  PixelValueMapType GetMinValueMap() const;
+
+  /** Return the computed Max for each feature */
+  PixelValueMapType GetMaxValueMap() const;
+
+  /** Return the computed number of pixels for each feature */
+  FeaturePopulationMapType GetFeaturePopulationMap() const;
+
+protected:
+  /** Constructor */
+  PersistentOGRDataToZonalStatisticsFilter();
+  /** Destructor */
+  ~PersistentOGRDataToZonalStatisticsFilter() override
+  {
+  }
+
+  /** The pixels of the requested region are needed */
+  void GenerateInputRequestedRegion() override;
+
+  /** Accumulate the pixels of the spans of the polygon */
+  void ProcessPolygon(const ogr::Feature& feature, OGRPolygon* polygon, RegionType& region, itk::ThreadIdType& threadid) override;
+
+  /** Accumulate a pixel of a point or a line */
+  void ProcessSample(const ogr::Feature& feature, typename TInputImage::IndexType& imgIndex, typename TInputImage::PointType& imgPoint,
+                     itk::ThreadIdType& threadid) override;
+
+  /** Select the accumulator of the current feature */
+  void PrepareFeature(const ogr::Feature& feature, itk::ThreadIdType& threadid) override;
+
+private:
+  PersistentOGRDataToZonalStatisticsFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  double m_NoDataValue;
+  bool   m_UseNoDataValue;
+
+  /** Accumulators of the features (per thread) */
+  std::vector<AccumulatorMapType> m_AccumulatorThread;
+  /** Accumulator of the current feature (per thread) */
+  std::vector<AccumulatorType*> m_CurrentAccumulator;
+
+  PixelValueMapType        m_MeanValues;
+  PixelValueMapType        m_StDevValues;
+  PixelValueMapType        m_MinValues;
+  PixelValueMapType        m_MaxValues;
+  FeaturePopulationMapType m_FeaturePopulation;
+};
+
+/**
+ * \class OGRDataToZonalStatisticsFilter
+ *
+ * \brief Computes the statistics of an image inside vector features using
+ * a persistent filter
+ *
+ * \sa PersistentOGRDataToZonalStatisticsFilter
+ *
+ * \ingroup OTBSampling
+ */
+template <class TInputImage, class TMaskImage = otb::Image<unsigned char, 2>>
+class ITK_EXPORT OGRDataToZonalStatisticsFilter
+    : public PersistentFilterStreamingDecorator<PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>>
+{
+public:
+  /** Standard Self typedef */
+  typedef OGRDataToZonalStatisticsFilter Self;
+  typedef PersistentFilterStreamingDecorator<PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef TInputImage          InputImageType;
+  typedef TMaskImage           MaskImageType;
+  typedef otb::ogr::DataSource OGRDataType;
+
+  typedef typename Superclass::FilterType               FilterType;
+  typedef typename FilterType::PixelValueMapType        PixelValueMapType;
+  typedef typename FilterType::FeaturePopulationMapType FeaturePopulationMapType;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(OGRDataToZonalStatisticsFilter, PersistentFilterStreamingDecorator);
+
+  using Superclass::SetInput;
+  virtual void SetInput(const TInputImage* image);
+
+  const TInputImage* GetInput();
+
+  void SetOGRData(const otb::ogr::DataSource* data);
+  const otb::ogr::DataSource* GetOGRData();
+
+  void SetMask(const TMaskImage* mask);
+  const TMaskImage* GetMask();
+
+  void SetLayerIndex(int index);
+  int GetLayerIndex();
+
+  void SetNoDataValue(double value);
+  double GetNoDataValue();
+
+  void SetUseNoDataValue(bool useNoDataValue);
+  bool GetUseNoDataValue();
+
+  PixelValueMapType GetMeanValueMap() const
+  {
+    return this->GetFilter()->GetMeanValueMap();
+  }
+
+  PixelValueMapType GetStandardDeviationValueMap() const
+  {
+    return this->GetFilter()->GetStandardDeviationValueMap();
+  }
+
+  PixelValueMapType GetMinValueMap() const
+  {
+    return this->GetFilter()->GetMinValueMap();
+  }
+
+  PixelValueMapType GetMaxValueMap() const
+  {
+    return this->GetFilter()->GetMaxValueMap();
+  }
+
+  FeaturePopulationMapType GetFeaturePopulationMap() const
+  {
+    return this->GetFilter()->GetFeaturePopulationMap();
+  }
+
+protected:
+  /** Constructor */
+  OGRDataToZonalStatisticsFilter()
+  {
+  }
+  /** Destructor */
+  ~OGRDataToZonalStatisticsFilter() override
+  {
+  }
+
+private:
+  OGRDataToZonalStatisticsFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end of namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbOGRDataToZonalStatisticsFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,306 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbOGRDataToZonalStatisticsFilter_hxx
+#define otbOGRDataToZonalStatisticsFilter_hxx
+
+#include "otbOGRDataToZonalStatisticsFilter.h"
+
+#include <cmath>
+
+namespace otb
+{
+// --------- otb::PersistentOGRDataToZonalStatisticsFilter ---------------------
+
+template <class TInputImage, class TMaskImage>
+PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::PersistentOGRDataToZonalStatisticsFilter()
+  : m_NoDataValue(0.0), m_UseNoDataValue(false)
+{
+  // No class field is needed
+  this->SetFieldName(std::string());
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::Synthetize(void)
+{
+  otb::ogr::DataSource* vectors = const_cast<otb::ogr::DataSource*>(this->GetOGRData());
+  vectors->GetLayer(this->GetLayerIndex()).SetSpatialFilter(nullptr);
+
+  // Merge the accumulators of the threads
+  AccumulatorMapType outputAcc;
+  for (auto const& threadAccMap : m_AccumulatorThread)
+  {
+    for (auto const& it : threadAccMap)
+    {
+      auto itAcc = outputAcc.find(it.first);
+      if (itAcc == outputAcc.end())
+      {
+        outputAcc.emplace(it.first, it.second);
+      }
+      else
+      {
+        itAcc->second.Update(it.second);
+      }
+    }
+  }
+
+  // Publish output maps (features whose bounding box met a tile without any
+  // pixel inside are skipped)
+  for (auto const& it : outputAcc)
+  {
+    if (it.second.GetCount() == 0)
+    {
+      continue;
+    }
+
+    const unsigned long fid       = it.first;
+    const auto&         bandCount = it.second.GetBandCount();
+    const auto&         sum       = it.second.GetSum();
+    const auto&         sqSum     = it.second.GetSqSum();
+
+    m_FeaturePopulation[fid] = it.second.GetCount();
+
+    RealVectorPixelType mean(sum);
+    RealVectorPixelType std(sqSum);
+    RealVectorPixelType min(it.second.GetMin());
+    RealVectorPixelType max(it.second.GetMax());
+    for (unsigned int band = 0; band < mean.GetSize(); band++)
+    {
+      // Number of valid pixels in band
+      auto count = bandCount[band];
+      mean[band] /= count;
+
+      // Unbiased standard deviation, as StreamingStatisticsMapFromLabelImageFilter
+      const double variance = (sqSum[band] - (sum[band] * mean[band])) / (count - 1);
+      std[band]             = std::sqrt(variance);
+
+      // Use the no data value when no valid pixels were found
+      if (m_UseNoDataValue && count == 0)
+      {
+        min[band] = m_NoDataValue;
+        max[band] = m_NoDataValue;
+      }
+    }
+    m_MeanValues[fid]  = mean;
+    m_StDevValues[fid] = std;
+    m_MinValues[fid]   = min;
+    m_MaxValues[fid]   = max;
+  }
+
+  m_AccumulatorThread.clear();
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::Reset(void)
+{
+  m_AccumulatorThread.clear();
+  m_MeanValues.clear();
+  m_StDevValues.clear();
+  m_MinValues.clear();
+  m_MaxValues.clear();
+  m_FeaturePopulation.clear();
+
+  m_AccumulatorThread.resize(this->GetNumberOfThreads());
+  m_CurrentAccumulator.assign(this->GetNumberOfThreads(), nullptr);
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::PixelValueMapType
+PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetMeanValueMap() const
+{
+  return m_MeanValues;
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::PixelValueMapType
+PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetStandardDeviationValueMap() const
+{
+  return m_StDevValues;
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::PixelValueMapType
+PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetMinValueMap() const
+{
+  return m_MinValues;
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::PixelValueMapType
+PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetMaxValueMap() const
+{
+  return m_MaxValues;
+}
+
+template <class TInputImage, class TMaskImage>
+typename PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::FeaturePopulationMapType
+PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetFeaturePopulationMap() const
+{
+  return m_FeaturePopulation;
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GenerateInputRequestedRegion()
+{
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  MaskImageType*  mask  = const_cast<MaskImageType*>(this->GetMask());
+
+  const RegionType requested = this->GetOutput()->GetRequestedRegion();
+  input->SetRequestedRegion(requested);
+  if (mask)
+  {
+    mask->SetRequestedRegion(requested);
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::PrepareFeature(const ogr::Feature& feature, itk::ThreadIdType& threadid)
+{
+  const unsigned long fid          = feature.ogr().GetFID();
+  AccumulatorMapType& accumulators = m_AccumulatorThread[threadid];
+
+  auto itAcc = accumulators.find(fid);
+  if (itAcc == accumulators.end())
+  {
+    // Empty accumulator
+    const unsigned int nbBands = this->GetInput()->GetNumberOfComponentsPerPixel();
+    typename AccumulatorType::PixelCountVectorType bandCount(nbBands);
+    RealVectorPixelType                            zero(nbBands), min(nbBands), max(nbBands);
+    bandCount.Fill(0);
+    zero.Fill(0.0);
+    min.Fill(itk::NumericTraits<double>::max());
+    max.Fill(itk::NumericTraits<double>::NonpositiveMin());
+    itAcc = accumulators.emplace(fid, AccumulatorType(m_NoDataValue, m_UseNoDataValue, 0, bandCount, zero, zero, min, max)).first;
+  }
+  m_CurrentAccumulator[threadid] = &itAcc->second;
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::ProcessSample(const ogr::Feature&, typename TInputImage::IndexType& imgIndex,
+                                                                                      typename TInputImage::PointType&, itk::ThreadIdType& threadid)
+{
+  // Points are not clipped to the region: keep those of the current tile only
+  if (this->GetOutput()->GetRequestedRegion().IsInside(imgIndex))
+  {
+    m_CurrentAccumulator[threadid]->Update(this->GetInput()->GetPixel(imgIndex));
+  }
+}
+
+template <class TInputImage, class TMaskImage>
+void PersistentOGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::ProcessPolygon(const ogr::Feature&, OGRPolygon* polygon, RegionType& region,
+                                                                                       itk::ThreadIdType& threadid)
+{
+  const TInputImage* img  = this->GetInput();
+  const TMaskImage*  mask = this->GetMask();
+  AccumulatorType&   acc  = *m_CurrentAccumulator[threadid];
+  IndexType          imgIndex;
+
+  for (imgIndex[1] = region.GetIndex(1); imgIndex[1] < region.GetIndex(1) + static_cast<long>(region.GetSize(1)); ++imgIndex[1])
+  {
+    for (const auto& span : this->ComputePolygonSpans(polygon, region, imgIndex[1], threadid))
+    {
+      for (imgIndex[0] = span.first; imgIndex[0] <= span.second; ++imgIndex[0])
+      {
+        if ((mask == nullptr) || mask->GetPixel(imgIndex))
+        {
+          acc.Update(img->GetPixel(imgIndex));
+        }
+      }
+    }
+  }
+}
+
+// -------------- otb::OGRDataToZonalStatisticsFilter --------------------------
+
+template <class TInputImage, class TMaskImage>
+void OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::SetInput(const TInputImage* image)
+{
+  this->GetFilter()->SetInput(image);
+}
+
+template <class TInputImage, class TMaskImage>
+const TInputImage* OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetInput()
+{
+  return this->GetFilter()->GetInput();
+}
+
+template <class TInputImage, class TMaskImage>
+void OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::SetOGRData(const otb::ogr::DataSource* data)
+{
+  this->GetFilter()->SetOGRData(data);
+}
+
+template <class TInputImage, class TMaskImage>
+const otb::ogr::DataSource* OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetOGRData()
+{
+  return this->GetFilter()->GetOGRData();
+}
+
+template <class TInputImage, class TMaskImage>
+void OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::SetMask(const TMaskImage* mask)
+{
+  this->GetFilter()->SetMask(mask);
+}
+
+template <class TInputImage, class TMaskImage>
+const TMaskImage* OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetMask()
+{
+  return this->GetFilter()->GetMask();
+}
+
+template <class TInputImage, class TMaskImage>
+void OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::SetLayerIndex(int index)
+{
+  this->GetFilter()->SetLayerIndex(index);
+}
+
+template <class TInputImage, class TMaskImage>
+int OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetLayerIndex()
+{
+  return this->GetFilter()->GetLayerIndex();
+}
+
+template <class TInputImage, class TMaskImage>
+void OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::SetNoDataValue(double value)
+{
+  this->GetFilter()->SetNoDataValue(value);
+}
+
+template <class TInputImage, class TMaskImage>
+double OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetNoDataValue()
+{
+  return this->GetFilter()->GetNoDataValue();
+}
+
+template <class TInputImage, class TMaskImage>
+void OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::SetUseNoDataValue(bool useNoDataValue)
+{
+  this->GetFilter()->SetUseNoDataValue(useNoDataValue);
+}
+
+template <class TInputImage, class TMaskImage>
+bool OGRDataToZonalStatisticsFilter<TInputImage, TMaskImage>::GetUseNoDataValue()
+{
+  return this->GetFilter()->GetUseNoDataValue();
+}
+
+} // end of namespace otb
+
+#endif
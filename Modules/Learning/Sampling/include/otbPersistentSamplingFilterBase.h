@@ -23,8 +23,11 @@
 
 #include "otbPersistentImageFilter.h"
 #include "otbOGRDataSourceWrapper.h"
+#include "otbEnvelopeSTRTree.h"
 #include "otbImage.h"
 #include <string>
+#include <utility>
+#include <vector>
 
 namespace otb
 {
@@ -33,6 +36,13 @@ namespace otb
  *
  *  \note This class contains pure virtual method, and can not be instantiated.
  *
+ *  When the input layer supports random reads, the features of each
+ *  streamed tile are selected with an STR-tree of the feature envelopes,
+ *  built once for the layer, instead of the spatial filter of the layer.
+ *  Polygons are scan-converted row by row: the pixels whose center is
+ *  inside are found as spans of columns, without testing each pixel of
+ *  the bounding region.
+ *
  * \sa PersistentOGRDataToClassStatisticsFilter
  * \sa PersistentOGRDataToSamplePositionFilter
  *
@@ -55,7 +65,12 @@ public:
   typedef TInputImage InputImageType;
   typedef TMaskImage  MaskImageType;
 
-  typedef typename TInputImage::RegionType RegionType;
+  typedef typename TInputImage::RegionType                RegionType;
+  typedef typename TInputImage::IndexType::IndexValueType IndexValueType;
+
+  /** Columns [first, second] of a row */
+  typedef std::pair<IndexValueType, IndexValueType> SpanType;
+  typedef std::vector<SpanType>                     SpanListType;
 
   typedef ogr::DataSource::Pointer OGRDataPointer;
 
@@ -78,7 +93,7 @@ public:
   const std::vector<std::string>& GetOGRLayerCreationOptions();
 
   /** Set/Get macro for the field name containing class names
-   * in the input vectors.*/
+   * in the input vectors (may be empty when no field is used).*/
   itkSetMacro(FieldName, std::string);
   itkGetMacro(FieldName, std::string);
 
@@ -134,6 +149,11 @@ protected:
   /** Generic method called once before processing each feature */
   virtual void PrepareFeature(const ogr::Feature& feature, itk::ThreadIdType& threadid);
 
+  /** Compute the spans of columns of a row of the region whose pixel centers
+   *  are inside the polygon (holes excluded). The list is a buffer of the
+   *  thread, overwritten by the next call. */
+  const SpanListType& ComputePolygonSpans(OGRPolygon* polygon, const RegionType& region, IndexValueType row, itk::ThreadIdType threadid);
+
   /** Common function to test if a point is inside a polygon */
   bool IsSampleInsidePolygon(OGRPolygon* poly, OGRPoint* tmpPoint);
 
@@ -148,6 +168,10 @@ protected:
    *  each thread.*/
   virtual void DispatchInputVectors(void);
 
+  /** Build the spatial index of the features of the layer, unless it is
+   *  already built for the current input */
+  void UpdateFeatureIndex(ogr::Layer& layer);
+
   /** Gather the content of in-memory output layer into the filter outputs */
   virtual void GatherOutputVectors(void);
 
@@ -216,6 +240,20 @@ private:
 
   /** In-memory containers storing position during iteration loop*/
   std::vector<std::vector<OGRDataPointer>> m_InMemoryOutputs;
+
+  /** Spatial index of the input features, the items are positions in
+   *  m_IndexedFIDs */
+  EnvelopeSTRTree      m_FeatureIndex;
+  std::vector<GIntBig> m_IndexedFIDs;
+
+  /** Input data, modification time and layer of the spatial index */
+  const ogr::DataSource* m_IndexedData;
+  itk::ModifiedTimeType  m_IndexedTime;
+  int                    m_IndexedLayer;
+
+  /** Scan-conversion buffers (per thread) */
+  std::vector<std::vector<double>> m_CrossingsThread;
+  std::vector<SpanListType>        m_SpansThread;
 };
 } // End namespace otb
 
@@ -28,6 +28,7 @@
 #include "otbMacro.h"
 #include "otbStopwatch.h"
 #include "itkProgressReporter.h"
+#include <algorithm>
 
 namespace otb
 {
@@ -41,7 +42,10 @@ PersistentSamplingFilterBase<TInputImage, TMaskImage>::PersistentSamplingFilterB
     m_OGRLayerCreationOptions(),
     m_AdditionalFields(),
     m_InMemoryInputs(),
-    m_InMemoryOutputs()
+    m_InMemoryOutputs(),
+    m_IndexedData(nullptr),
+    m_IndexedTime(0),
+    m_IndexedLayer(-1)
 {
   this->SetNthOutput(0, TInputImage::New());
 }
@@ -97,15 +101,19 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::GenerateOutputInform
 {
   Superclass::GenerateOutputInformation();
 
-  // Get OGR field index
-  const otb::ogr::DataSource*     vectors    = this->GetOGRData();
-  otb::ogr::Layer::const_iterator featIt     = vectors->GetLayer(m_LayerIndex).begin();
-  int                             fieldIndex = featIt->ogr().GetFieldIndex(this->m_FieldName.c_str());
-  if (fieldIndex < 0)
+  // Get OGR field index (filters which do not use a field leave it empty)
+  this->m_FieldIndex = -1;
+  if (!this->m_FieldName.empty())
   {
-    itkGenericExceptionMacro("Field named " << this->m_FieldName << " not found!");
+    const otb::ogr::DataSource*     vectors    = this->GetOGRData();
+    otb::ogr::Layer::const_iterator featIt     = vectors->GetLayer(m_LayerIndex).begin();
+    int                             fieldIndex = featIt->ogr().GetFieldIndex(this->m_FieldName.c_str());
+    if (fieldIndex < 0)
+    {
+      itkGenericExceptionMacro("Field named " << this->m_FieldName << " not found!");
+    }
+    this->m_FieldIndex = fieldIndex;
   }
-  this->m_FieldIndex = fieldIndex;
 
   const MaskImageType* mask = this->GetMask();
   if (mask)
@@ -183,6 +191,9 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::AllocateOutputs(void
 
   unsigned int numberOfThreads = this->GetNumberOfThreads();
 
+  m_CrossingsThread.resize(numberOfThreads);
+  m_SpansThread.resize(numberOfThreads);
+
   // Prepare temporary input
   this->m_InMemoryInputs.clear();
   this->m_InMemoryInputs.reserve(numberOfThreads);
@@ -486,50 +497,85 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::ProcessPolygon(const
                                                                            itk::ThreadIdType& threadid)
 {
   const TInputImage*              img  = this->GetInput();
-  TMaskImage*                     mask = const_cast<TMaskImage*>(this->GetMask());
+  const TMaskImage*               mask = this->GetMask();
   typename TInputImage::IndexType imgIndex;
   typename TInputImage::PointType imgPoint;
-  OGRPoint                        tmpPoint;
 
-  if (mask)
+  for (imgIndex[1] = region.GetIndex(1); imgIndex[1] < region.GetIndex(1) + static_cast<IndexValueType>(region.GetSize(1)); ++imgIndex[1])
   {
-    // For pixels in consideredRegion and not masked
-    typedef MaskedIteratorDecorator<itk::ImageRegionConstIterator<TMaskImage>, itk::ImageRegionConstIterator<TMaskImage>> MaskedIteratorType;
-    MaskedIteratorType it(mask, mask, region);
-    it.GoToBegin();
-    while (!it.IsAtEnd())
+    const SpanListType& spans = this->ComputePolygonSpans(polygon, region, imgIndex[1], threadid);
+    for (const SpanType& span : spans)
     {
-      imgIndex = it.GetIndex();
-      img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
-      tmpPoint.setX(imgPoint[0]);
-      tmpPoint.setY(imgPoint[1]);
-      bool isInside = this->IsSampleInsidePolygon(polygon, &tmpPoint);
-      if (isInside)
+      for (imgIndex[0] = span.first; imgIndex[0] <= span.second; ++imgIndex[0])
       {
-        this->ProcessSample(feature, imgIndex, imgPoint, threadid);
+        if ((mask == nullptr) || mask->GetPixel(imgIndex))
+        {
+          img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
+          this->ProcessSample(feature, imgIndex, imgPoint, threadid);
+        }
       }
-      ++it;
     }
   }
-  else
-  {
-    typedef itk::ImageRegionConstIteratorWithOnlyIndex<TInputImage> NoValueIteratorType;
-    NoValueIteratorType                                             it(img, region);
-    it.GoToBegin();
-    while (!it.IsAtEnd())
+}
+
+template <class TInputImage, class TMaskImage>
+const typename PersistentSamplingFilterBase<TInputImage, TMaskImage>::SpanListType&
+PersistentSamplingFilterBase<TInputImage, TMaskImage>::ComputePolygonSpans(OGRPolygon* polygon, const RegionType& region, IndexValueType row,
+                                                                           itk::ThreadIdType threadid)
+{
+  const TInputImage* img = this->GetInput();
+
+  // Physical position of the first pixel of the row, and column step
+  const IndexValueType            firstColumn = region.GetIndex(0);
+  const IndexValueType            lastColumn  = firstColumn + static_cast<IndexValueType>(region.GetSize(0)) - 1;
+  typename TInputImage::IndexType imgIndex;
+  typename TInputImage::PointType rowPoint, nextPoint;
+  imgIndex[0] = firstColumn;
+  imgIndex[1] = row;
+  img->TransformIndexToPhysicalPoint(imgIndex, rowPoint);
+  ++imgIndex[0];
+  img->TransformIndexToPhysicalPoint(imgIndex, nextPoint);
+  const double stepX = nextPoint[0] - rowPoint[0];
+  const double y     = rowPoint[1];
+
+  // Abscissae of the crossings of the row with the edges of all the rings:
+  // between two consecutive crossings, pixels alternate between inside and
+  // outside (holes included)
+  std::vector<double>& crossings = m_CrossingsThread[threadid];
+  crossings.clear();
+  for (int k = -1; k < polygon->getNumInteriorRings(); ++k)
+  {
+    const OGRLinearRing* ring     = (k < 0) ? polygon->getExteriorRing() : polygon->getInteriorRing(k);
+    const int            nbPoints = ring ? ring->getNumPoints() : 0;
+    for (int i = 0; i < nbPoints; ++i)
     {
-      imgIndex = it.GetIndex();
-      img->TransformIndexToPhysicalPoint(imgIndex, imgPoint);
-      tmpPoint.setX(imgPoint[0]);
-      tmpPoint.setY(imgPoint[1]);
-      bool isInside = this->IsSampleInsidePolygon(polygon, &tmpPoint);
-      if (isInside)
+      const int    j  = (i + 1) % nbPoints;
+      const double y1 = ring->getY(i);
+      const double y2 = ring->getY(j);
+      if ((y1 <= y) != (y2 <= y))
       {
-        this->ProcessSample(feature, imgIndex, imgPoint, threadid);
+        const double x1 = ring->getX(i);
+        crossings.push_back(x1 + (y - y1) * (ring->getX(j) - x1) / (y2 - y1));
       }
-      ++it;
     }
   }
+  std::sort(crossings.begin(), crossings.end());
+
+  SpanListType& spans = m_SpansThread[threadid];
+  spans.clear();
+  for (std::size_t k = 0; k + 1 < crossings.size(); k += 2)
+  {
+    // Columns whose center lies between the two crossings
+    const double         c1    = (crossings[k] - rowPoint[0]) / stepX;
+    const double         c2    = (crossings[k + 1] - rowPoint[0]) / stepX;
+    const IndexValueType start = std::max(firstColumn, firstColumn + static_cast<IndexValueType>(std::ceil(std::min(c1, c2))));
+    const IndexValueType end   = std::min(lastColumn, firstColumn + static_cast<IndexValueType>(std::floor(std::max(c1, c2))));
+    if (start <= end)
+    {
+      spans.push_back(SpanType(start, end));
+    }
+  }
+  return spans;
 }
 
 template <class TInputImage, class TMaskImage>
@@ -644,8 +690,6 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::DispatchInputVectors
   ring.addPoint(startPoint[0], startPoint[1], 0.0);
   tmpPolygon.addRing(&ring);
 
-  inLayer.SetSpatialFilter(&tmpPolygon);
-
   unsigned int            numberOfThreads = this->GetNumberOfThreads();
   std::vector<ogr::Layer> tmpLayers;
   tmpLayers.reserve(numberOfThreads);
@@ -654,13 +698,45 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::DispatchInputVectors
     tmpLayers.push_back(this->GetInMemoryInput(i));
   }
 
+  OGRFeatureDefn& layerDefn = inLayer.GetLayerDefn();
+  unsigned int    counter   = 0;
+  unsigned int    cptFeat   = 0;
+
+  if (inLayer.ogr().TestCapability(OLCRandomRead))
+  {
+    // Features of the tile from the spatial index
+    this->UpdateFeatureIndex(inLayer);
+    OGREnvelope tileEnvelope;
+    tileEnvelope.MinX = std::min(startPoint[0], endPoint[0]);
+    tileEnvelope.MaxX = std::max(startPoint[0], endPoint[0]);
+    tileEnvelope.MinY = std::min(startPoint[1], endPoint[1]);
+    tileEnvelope.MaxY = std::max(startPoint[1], endPoint[1]);
+    const EnvelopeSTRTree::ItemListType items = m_FeatureIndex.Query(tileEnvelope);
+
+    const unsigned int nbFeatThread = std::ceil(items.size() / (float)numberOfThreads);
+    for (EnvelopeSTRTree::ItemType item : items)
+    {
+      ogr::Feature srcFeature = inLayer.GetFeature(m_IndexedFIDs[item]);
+      ogr::Feature dstFeature(layerDefn);
+      dstFeature.SetFrom(srcFeature, TRUE);
+      dstFeature.SetFID(srcFeature.GetFID());
+      tmpLayers[counter].CreateFeature(dstFeature);
+      cptFeat++;
+      if (cptFeat > nbFeatThread && (counter + 1) < numberOfThreads)
+      {
+        counter++;
+        cptFeat = 0;
+      }
+    }
+    return;
+  }
+
+  inLayer.SetSpatialFilter(&tmpPolygon);
+
   const unsigned int nbFeatThread = std::ceil(inLayer.GetFeatureCount(true) / (float)numberOfThreads);
   // assert(nbFeatThread > 0);
 
-  OGRFeatureDefn&            layerDefn = inLayer.GetLayerDefn();
-  ogr::Layer::const_iterator featIt    = inLayer.begin();
-  unsigned int               counter   = 0;
-  unsigned int               cptFeat   = 0;
+  ogr::Layer::const_iterator featIt = inLayer.begin();
   for (; featIt != inLayer.end(); ++featIt)
   {
     ogr::Feature dstFeature(layerDefn);
@@ -678,6 +754,37 @@ void PersistentSamplingFilterBase<TInputImage, TMaskImage>::DispatchInputVectors
   inLayer.SetSpatialFilter(nullptr);
 }
 
+template <class TInputImage, class TMaskImage>
+void PersistentSamplingFilterBase<TInputImage, TMaskImage>::UpdateFeatureIndex(ogr::Layer& layer)
+{
+  const ogr::DataSource* vectors = this->GetOGRData();
+  if (vectors == m_IndexedData && vectors->GetMTime() == m_IndexedTime && m_LayerIndex == m_IndexedLayer)
+  {
+    return;
+  }
+
+  m_FeatureIndex.Clear();
+  m_IndexedFIDs.clear();
+  layer.SetSpatialFilter(nullptr);
+  for (ogr::Layer::const_iterator featIt = layer.cbegin(); featIt != layer.cend(); ++featIt)
+  {
+    OGRGeometry const* geometry = featIt->GetGeometry();
+    if (geometry == nullptr)
+    {
+      continue;
+    }
+    OGREnvelope envelope;
+    geometry->getEnvelope(&envelope);
+    m_FeatureIndex.Insert(envelope, m_IndexedFIDs.size());
+    m_IndexedFIDs.push_back(featIt->GetFID());
+  }
+  m_FeatureIndex.Build();
+
+  m_IndexedData  = vectors;
+  m_IndexedTime  = vectors->GetMTime();
+  m_IndexedLayer = m_LayerIndex;
+}
+
 template <class TInputImage, class TMaskImage>
 void PersistentSamplingFilterBase<TInputImage, TMaskImage>::InitializeOutputDataSource(ogr::DataSource* inputDS, ogr::DataSource* outputDS)
 {
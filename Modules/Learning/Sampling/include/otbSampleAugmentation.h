@@ -158,26 +158,157 @@ double ComputeSquareDistance(const SampleType& x, const SampleType& y)
 
 using NNIndicesType = std::vector<NeighborType>;
 using NNVectorType  = std::vector<NNIndicesType>;
+
+/** \class KDTree
+ * \brief Index of samples for exact nearest neighbors queries
+ *
+ * The samples are recursively split at the median of their component
+ * of largest spread, until leaves of a few samples. A query only visits
+ * the leaves which may hold a sample closer than the current k-th
+ * neighbor, and keeps the k best candidates in a bounded heap, so that
+ * the neighbors of n samples are found in O(n log n) for a small number
+ * of components instead of O(n^2).
+ *
+ * The samples are not copied and must outlive the tree.
+ *
+ * \ingroup OTBSampling
+ */
+class KDTree
+{
+public:
+  explicit KDTree(const SampleVectorType& samples, const size_t leafSize = 16) : m_Samples(samples), m_LeafSize(std::max<size_t>(leafSize, 1))
+  {
+    m_Indices.resize(samples.size());
+    for (size_t i = 0; i < m_Indices.size(); ++i)
+      m_Indices[i] = i;
+    if (!samples.empty())
+      Build(0, m_Indices.size());
+  }
+
+  /** Returns the nbNeighbors nearest samples of the query, sorted by
+   * increasing distance. The sample of index excluded is skipped, so that
+   * a sample of the tree is not its own neighbor. */
+  NNIndicesType FindNearest(const SampleType& query, const size_t nbNeighbors, const size_t excluded = static_cast<size_t>(-1)) const
+  {
+    NNIndicesType heap;
+    heap.reserve(nbNeighbors + 1);
+    if (!m_Nodes.empty() && nbNeighbors > 0)
+      Search(0, query, nbNeighbors, excluded, heap);
+    std::sort_heap(heap.begin(), heap.end(), NeighborSorter{});
+    return heap;
+  }
+
+private:
+  struct Node
+  {
+    size_t begin;
+    size_t end;
+    size_t splitComponent;
+    double splitValue;
+    // Indices of the children in m_Nodes, 0 for a leaf
+    size_t left;
+    size_t right;
+  };
+
+  size_t Build(const size_t begin, const size_t end)
+  {
+    const size_t nodeIdx = m_Nodes.size();
+    m_Nodes.push_back({begin, end, 0, 0., 0, 0});
+    if (end - begin <= m_LeafSize)
+      return nodeIdx;
+
+    // Split on the component of largest spread
+    const size_t nbComponents = m_Samples[m_Indices[begin]].size();
+    size_t       splitComponent{0};
+    double       largestSpread{-1.};
+    for (size_t j = 0; j < nbComponents; ++j)
+    {
+      double minValue = m_Samples[m_Indices[begin]][j];
+      double maxValue = minValue;
+      for (size_t i = begin + 1; i < end; ++i)
+      {
+        minValue = std::min(minValue, m_Samples[m_Indices[i]][j]);
+        maxValue = std::max(maxValue, m_Samples[m_Indices[i]][j]);
+      }
+      if (maxValue - minValue > largestSpread)
+      {
+        largestSpread  = maxValue - minValue;
+        splitComponent = j;
+      }
+    }
+    if (largestSpread <= 0.)
+      return nodeIdx;
+
+    const size_t middle = begin + (end - begin) / 2;
+    std::nth_element(m_Indices.begin() + begin, m_Indices.begin() + middle, m_Indices.begin() + end,
+                     [&](size_t a, size_t b) { return m_Samples[a][splitComponent] < m_Samples[b][splitComponent]; });
+
+    m_Nodes[nodeIdx].splitComponent = splitComponent;
+    m_Nodes[nodeIdx].splitValue     = m_Samples[m_Indices[middle]][splitComponent];
+    const size_t left               = Build(begin, middle);
+    const size_t right              = Build(middle, end);
+    m_Nodes[nodeIdx].left           = left;
+    m_Nodes[nodeIdx].right          = right;
+    return nodeIdx;
+  }
+
+  void Search(const size_t nodeIdx, const SampleType& query, const size_t nbNeighbors, const size_t excluded, NNIndicesType& heap) const
+  {
+    const Node& node = m_Nodes[nodeIdx];
+    if (node.left == 0)
+    {
+      for (size_t i = node.begin; i < node.end; ++i)
+      {
+        const size_t index = m_Indices[i];
+        if (index == excluded)
+          continue;
+        const double distance = ComputeSquareDistance(query, m_Samples[index]);
+        if (heap.size() < nbNeighbors)
+        {
+          heap.push_back({index, distance});
+          std::push_heap(heap.begin(), heap.end(), NeighborSorter{});
+        }
+        else if (distance < heap.front().distance)
+        {
+          std::pop_heap(heap.begin(), heap.end(), NeighborSorter{});
+          heap.back() = {index, distance};
+          std::push_heap(heap.begin(), heap.end(), NeighborSorter{});
+        }
+      }
+      return;
+    }
+
+    // Visit first the side of the query, and the other side only if it
+    // may hold a closer sample than the current k-th neighbor
+    const double offset = query[node.splitComponent] - node.splitValue;
+    const size_t nearSide = offset < 0 ? node.left : node.right;
+    const size_t farSide  = offset < 0 ? node.right : node.left;
+    Search(nearSide, query, nbNeighbors, excluded, heap);
+    // Same normalization as ComputeSquareDistance
+    const double planeDistance = offset * offset / (query.size() * query.size());
+    if (heap.size() < nbNeighbors || planeDistance < heap.front().distance)
+      Search(farSide, query, nbNeighbors, excluded, heap);
+  }
+
+  const SampleVectorType& m_Samples;
+  const size_t            m_LeafSize;
+  std::vector<size_t>     m_Indices;
+  std::vector<Node>       m_Nodes;
+};
+
 /** Returns the indices of the nearest neighbors for each input sample
 */
 void FindKNNIndices(const SampleVectorType& inSamples, const size_t nbNeighbors, NNVectorType& nnVector)
 {
   const long long nbSamples = static_cast<long long>(inSamples.size());
   nnVector.resize(nbSamples);
+  const KDTree tree(inSamples);
 #ifdef _OPENMP
 #pragma omp parallel for
 #endif
   for (long long sampleIdx = 0; sampleIdx < nbSamples; ++sampleIdx)
   {
-    NNIndicesType nns;
-    for (long long neighborIdx = 0; neighborIdx < nbSamples; ++neighborIdx)
-    {
-      if (sampleIdx != neighborIdx)
-        nns.push_back({static_cast<size_t>(neighborIdx), ComputeSquareDistance(inSamples[sampleIdx], inSamples[neighborIdx])});
-    }
-    std::partial_sort(nns.begin(), nns.begin() + nbNeighbors, nns.end(), NeighborSorter{});
-    nns.resize(nbNeighbors);
-    nnVector[sampleIdx] = std::move(nns);
+    nnVector[sampleIdx] = tree.FindNearest(inSamples[sampleIdx], nbNeighbors, static_cast<size_t>(sampleIdx));
   }
 }
 
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSampleTable_h
+#define otbSampleTable_h
+
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include <string>
+#include <vector>
+#include "OTBSamplingExport.h"
+
+namespace otb
+{
+/** \class SampleTable
+ *  \brief Column-oriented in-memory table of sample values
+ *
+ * Each column holds one named field (the class label, the value of a band...)
+ * for all the samples, stored as doubles. Rows are appended with AppendRow(),
+ * or by merging other tables with Append(). Appending to different tables
+ * from different threads needs no locking.
+ *
+ * The table can be written to and read from a binary ".samples" file: a
+ * signature, the column names, then each column as a contiguous array. This
+ * is much faster to write and read than an OGR layer with one field per
+ * value.
+ *
+ * \ingroup OTBSampling
+ */
+class OTBSampling_EXPORT SampleTable : public itk::Object
+{
+public:
+  /** Standard typedefs */
+  typedef SampleTable                   Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  typedef double                   ValueType;
+  typedef std::vector<ValueType>   ColumnType;
+  typedef std::vector<std::string> NameListType;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(SampleTable, itk::Object);
+
+  /** Set the column names, and remove all the rows */
+  void SetColumnNames(const NameListType& names);
+
+  const NameListType& GetColumnNames() const
+  {
+    return m_ColumnNames;
+  }
+
+  unsigned int GetNumberOfColumns() const
+  {
+    return m_ColumnNames.size();
+  }
+
+  unsigned long GetNumberOfRows() const
+  {
+    return m_Columns.empty() ? 0 : m_Columns[0].size();
+  }
+
+  /** Index of the column called name, -1 if there is none */
+  int GetColumnIndex(const std::string& name) const;
+
+  const ColumnType& GetColumn(unsigned int index) const
+  {
+    return m_Columns[index];
+  }
+
+  /** Appends one row of GetNumberOfColumns() values */
+  void AppendRow(const ValueType* values);
+
+  /** Appends the rows of another table having the same columns */
+  void Append(const SampleTable& other);
+
+  /** Remove all the rows, keeping the columns */
+  void ClearRows();
+
+  /** Write the table to a binary sample file */
+  void Write(const std::string& filename) const;
+
+  /** Read a binary sample file written by Write() */
+  void Read(const std::string& filename);
+
+  /** Read only the column names of a sample file */
+  static NameListType ReadColumnNames(const std::string& filename);
+
+  /** Does the file start with the signature of sample files ? */
+  static bool CanRead(const std::string& filename);
+
+protected:
+  SampleTable() = default;
+  ~SampleTable() override = default;
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  SampleTable(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  NameListType            m_ColumnNames;
+  std::vector<ColumnType> m_Columns;
+};
+
+} // end namespace otb
+
+#endif
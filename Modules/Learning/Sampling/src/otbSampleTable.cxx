@@ -0,0 +1,200 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSampleTable.h"
+#include "itkMacro.h"
+#include <algorithm>
+#include <cstdint>
+#include <fstream>
+
+namespace otb
+{
+
+namespace
+{
+/** File layout: signature, header, column names (length then characters),
+ * then the columns one after the other */
+const char SampleTableSignature[8] = {'O', 'T', 'B', 'S', 'M', 'P', 'L', 'S'};
+
+const std::uint32_t SampleTableVersion   = 1;
+const std::uint32_t SampleTableByteOrder = 0x01020304;
+
+struct Header
+{
+  std::uint32_t byteOrder;
+  std::uint32_t version;
+  std::uint32_t nbColumns;
+  std::uint32_t padding;
+  std::uint64_t nbRows;
+};
+
+/** Reads the signature, the header and the column names */
+void ReadHeader(std::istream& is, const std::string& filename, Header& header, SampleTable::NameListType& names)
+{
+  char signature[sizeof(SampleTableSignature)];
+  is.read(signature, sizeof(signature));
+  is.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!is || !std::equal(signature, signature + sizeof(signature), SampleTableSignature))
+  {
+    itkGenericExceptionMacro(<< filename << " is not a sample file");
+  }
+  if (header.byteOrder != SampleTableByteOrder || header.version != SampleTableVersion)
+  {
+    itkGenericExceptionMacro(<< "Unsupported version or byte order in sample file " << filename);
+  }
+
+  names.resize(header.nbColumns);
+  for (auto& name : names)
+  {
+    std::uint32_t length = 0;
+    is.read(reinterpret_cast<char*>(&length), sizeof(length));
+    if (!is || length > 4096)
+    {
+      itkGenericExceptionMacro(<< "Invalid column name in sample file " << filename);
+    }
+    name.resize(length);
+    is.read(&name[0], length);
+  }
+}
+} // end anonymous namespace
+
+void SampleTable::SetColumnNames(const NameListType& names)
+{
+  m_ColumnNames = names;
+  m_Columns.assign(names.size(), ColumnType());
+  this->Modified();
+}
+
+int SampleTable::GetColumnIndex(const std::string& name) const
+{
+  NameListType::const_iterator it = std::find(m_ColumnNames.begin(), m_ColumnNames.end(), name);
+  return it == m_ColumnNames.end() ? -1 : static_cast<int>(it - m_ColumnNames.begin());
+}
+
+void SampleTable::AppendRow(const ValueType* values)
+{
+  for (unsigned int c = 0; c < m_Columns.size(); ++c)
+  {
+    m_Columns[c].push_back(values[c]);
+  }
+}
+
+void SampleTable::Append(const SampleTable& other)
+{
+  if (other.m_ColumnNames != m_ColumnNames)
+  {
+    itkExceptionMacro(<< "Cannot append a sample table with different columns");
+  }
+  for (unsigned int c = 0; c < m_Columns.size(); ++c)
+  {
+    m_Columns[c].insert(m_Columns[c].end(), other.m_Columns[c].begin(), other.m_Columns[c].end());
+  }
+  this->Modified();
+}
+
+void SampleTable::ClearRows()
+{
+  for (auto& column : m_Columns)
+  {
+    ColumnType().swap(column);
+  }
+  this->Modified();
+}
+
+void SampleTable::Write(const std::string& filename) const
+{
+  std::ofstream ofs(filename, std::ios::out | std::ios::binary);
+  if (!ofs)
+  {
+    itkExceptionMacro(<< "Could not open sample file " << filename << " for writing");
+  }
+
+  Header header;
+  header.byteOrder = SampleTableByteOrder;
+  header.version   = SampleTableVersion;
+  header.nbColumns = m_ColumnNames.size();
+  header.padding   = 0;
+  header.nbRows    = GetNumberOfRows();
+
+  ofs.write(SampleTableSignature, sizeof(SampleTableSignature));
+  ofs.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  for (const auto& name : m_ColumnNames)
+  {
+    const std::uint32_t length = name.size();
+    ofs.write(reinterpret_cast<const char*>(&length), sizeof(length));
+    ofs.write(name.data(), length);
+  }
+  for (const auto& column : m_Columns)
+  {
+    ofs.write(reinterpret_cast<const char*>(column.data()), column.size() * sizeof(ValueType));
+  }
+
+  if (!ofs)
+  {
+    itkExceptionMacro(<< "Error while writing sample file " << filename);
+  }
+}
+
+void SampleTable::Read(const std::string& filename)
+{
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  Header        header;
+  NameListType  names;
+  ReadHeader(ifs, filename, header, names);
+
+  SetColumnNames(names);
+  for (auto& column : m_Columns)
+  {
+    column.resize(header.nbRows);
+    ifs.read(reinterpret_cast<char*>(column.data()), column.size() * sizeof(ValueType));
+  }
+
+  if (!ifs)
+  {
+    ClearRows();
+    itkExceptionMacro(<< "Truncated sample file " << filename);
+  }
+}
+
+SampleTable::NameListType SampleTable::ReadColumnNames(const std::string& filename)
+{
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  Header        header;
+  NameListType  names;
+  ReadHeader(ifs, filename, header, names);
+  return names;
+}
+
+bool SampleTable::CanRead(const std::string& filename)
+{
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  char          signature[sizeof(SampleTableSignature)];
+  ifs.read(signature, sizeof(signature));
+  return ifs && std::equal(signature, signature + sizeof(signature), SampleTableSignature);
+}
+
+void SampleTable::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Number of columns: " << GetNumberOfColumns() << std::endl;
+  os << indent << "Number of rows: " << GetNumberOfRows() << std::endl;
+}
+
+} // end namespace otb
@@ -25,6 +25,7 @@
 #include "otbStopwatch.h"
 #include "itkPhysicalPointImageSource.h"
 #include <fstream>
+#include <cmath>
 
 
 int otbImageSampleExtractorFilter(int argc, char* argv[])
@@ -173,3 +174,86 @@ int otbImageSampleExtractorFilterUpdate(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbImageSampleExtractorFilterSampleTable(int argc, char* argv[])
+{
+  typedef otb::VectorImage<float>                         InputImageType;
+  typedef otb::ImageSampleExtractorFilter<InputImageType> FilterType;
+
+  if (argc < 3)
+  {
+    std::cout << "Usage : " << argv[0] << "  input_vector  output" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string vectorPath(argv[1]);
+  std::string outputPath(argv[2]);
+
+  otb::ogr::DataSource::Pointer vectors = otb::ogr::DataSource::New(vectorPath);
+  otb::SampleTable::Pointer     table   = otb::SampleTable::New();
+
+  InputImageType::RegionType region;
+  region.SetSize(0, 99);
+  region.SetSize(1, 50);
+
+  InputImageType::PointType origin;
+  origin.Fill(0.5);
+
+  InputImageType::SpacingType spacing;
+  spacing[0] = 1.0;
+  spacing[1] = -1.0;
+
+  typedef itk::PhysicalPointImageSource<InputImageType> ImageSourceType;
+  ImageSourceType::Pointer                              imgSource = ImageSourceType::New();
+  imgSource->SetSize(region.GetSize());
+  imgSource->SetSpacing(spacing);
+  imgSource->SetOrigin(origin);
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(imgSource->GetOutput());
+  filter->SetLayerIndex(2);
+  filter->SetSamplePositions(vectors);
+  filter->SetOutputSampleTable(table);
+  filter->SetClassFieldName("label");
+  filter->SetOutputFieldPrefix("measure_");
+  filter->Update();
+
+  table->Write(outputPath);
+
+  otb::SampleTable::Pointer readTable = otb::SampleTable::New();
+  if (!otb::SampleTable::CanRead(outputPath))
+  {
+    std::cout << "The sample file is not recognized" << std::endl;
+    return EXIT_FAILURE;
+  }
+  readTable->Read(outputPath);
+
+  if (readTable->GetColumnNames() != table->GetColumnNames() || readTable->GetNumberOfRows() != table->GetNumberOfRows() ||
+      table->GetNumberOfRows() == 0)
+  {
+    std::cout << "Wrong sample file: " << readTable->GetNumberOfRows() << " rows read for " << table->GetNumberOfRows() << " extracted" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The image values are the coordinates of the pixel centers
+  const int x = readTable->GetColumnIndex("measure_0");
+  const int y = readTable->GetColumnIndex("measure_1");
+  if (readTable->GetColumnIndex("label") != 0 || x < 0 || y < 0)
+  {
+    std::cout << "Missing columns in the sample file" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned long row = 0; row < readTable->GetNumberOfRows(); ++row)
+  {
+    const double valueX = readTable->GetColumn(x)[row];
+    const double valueY = readTable->GetColumn(y)[row];
+    if (valueX != table->GetColumn(x)[row] || valueY != table->GetColumn(y)[row] || valueX - std::floor(valueX) != 0.5 ||
+        valueY - std::floor(valueY) != 0.5)
+    {
+      std::cout << "Wrong sample value at row " << row << ": " << valueX << " " << valueY << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
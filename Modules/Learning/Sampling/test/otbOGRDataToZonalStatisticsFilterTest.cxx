@@ -0,0 +1,152 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbOGRDataToZonalStatisticsFilter.h"
+#include "otbVectorImage.h"
+#include "otbImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <cmath>
+#include <iterator>
+
+namespace
+{
+// Rectangle [x0, x1] x [y0, y1]
+OGRPolygon MakeRectangle(double x0, double y0, double x1, double y1)
+{
+  OGRPolygon    polygon;
+  OGRLinearRing ring;
+  ring.addPoint(x0, y0, 0.0);
+  ring.addPoint(x1, y0, 0.0);
+  ring.addPoint(x1, y1, 0.0);
+  ring.addPoint(x0, y1, 0.0);
+  ring.addPoint(x0, y0, 0.0);
+  polygon.addRing(&ring);
+  return polygon;
+}
+}
+
+int otbOGRDataToZonalStatisticsFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::VectorImage<float>   InputImageType;
+  typedef otb::Image<unsigned char> MaskImageType;
+  typedef otb::OGRDataToZonalStatisticsFilter<InputImageType, MaskImageType> FilterType;
+
+  // Pixel (x, y) is centered on (x, y) and holds (x, y)
+  InputImageType::RegionType region;
+  region.SetSize(0, 60);
+  region.SetSize(1, 40);
+
+  InputImageType::PointType origin;
+  origin.Fill(0.0);
+  InputImageType::SpacingType spacing;
+  spacing.Fill(1.0);
+
+  InputImageType::Pointer inputImage = InputImageType::New();
+  inputImage->SetNumberOfComponentsPerPixel(2);
+  inputImage->SetRegions(region);
+  inputImage->SetOrigin(origin);
+  inputImage->SetSignedSpacing(spacing);
+  inputImage->Allocate();
+
+  InputImageType::PixelType                          pixel(2);
+  itk::ImageRegionIteratorWithIndex<InputImageType> it(inputImage, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    pixel[0] = it.GetIndex()[0];
+    pixel[1] = it.GetIndex()[1];
+    it.Set(pixel);
+  }
+
+  // Two overlapping rectangles, the second one with a hole
+  otb::ogr::DataSource::Pointer vectors = otb::ogr::DataSource::New();
+  otb::ogr::Layer               layer   = vectors->CreateLayer("polygons", nullptr, wkbPolygon);
+
+  OGRPolygon first = MakeRectangle(4.5, 2.5, 20.5, 30.5);
+  otb::ogr::Feature firstFeature(layer.GetLayerDefn());
+  firstFeature.SetGeometry(&first);
+  layer.CreateFeature(firstFeature);
+
+  OGRPolygon    second = MakeRectangle(10.5, 10.5, 50.5, 35.5);
+  OGRLinearRing hole;
+  hole.addPoint(30.5, 20.5, 0.0);
+  hole.addPoint(40.5, 20.5, 0.0);
+  hole.addPoint(40.5, 25.5, 0.0);
+  hole.addPoint(30.5, 25.5, 0.0);
+  hole.addPoint(30.5, 20.5, 0.0);
+  second.addRing(&hole);
+  otb::ogr::Feature secondFeature(layer.GetLayerDefn());
+  secondFeature.SetGeometry(&second);
+  layer.CreateFeature(secondFeature);
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(inputImage);
+  filter->SetOGRData(vectors);
+  filter->SetLayerIndex(0);
+  // Several tiles, so that the polygons are split between them
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(7);
+  filter->Update();
+
+  FilterType::FeaturePopulationMapType counts = filter->GetFeaturePopulationMap();
+  FilterType::PixelValueMapType        means  = filter->GetMeanValueMap();
+  FilterType::PixelValueMapType        mins   = filter->GetMinValueMap();
+  FilterType::PixelValueMapType        maxs   = filter->GetMaxValueMap();
+
+  if (counts.size() != 2)
+  {
+    std::cerr << "Expected 2 features, got " << counts.size() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Expected values: pixels of columns [5, 20] x rows [3, 30], and of
+  // columns [11, 50] x rows [11, 35] minus [31, 40] x [21, 25]
+  const unsigned long fids[2]      = {counts.begin()->first, std::next(counts.begin())->first};
+  const double        expCount[2]  = {16 * 28, 40 * 25 - 10 * 5};
+  const double        expSumX[2]   = {28 * (16 * 12.5), 25 * (40 * 30.5) - 5 * (10 * 35.5)};
+  const double        expSumY[2]   = {16 * (28 * 16.5), 40 * (25 * 23.0) - 10 * (5 * 23.0)};
+  const double        expMin[2][2] = {{5, 3}, {11, 11}};
+  const double        expMax[2][2] = {{20, 30}, {50, 35}};
+  bool                ok           = true;
+  for (unsigned int f = 0; f < 2; ++f)
+  {
+    const unsigned long fid = fids[f];
+    if (counts[fid] != expCount[f])
+    {
+      std::cerr << "Feature " << fid << ": count " << counts[fid] << " instead of " << expCount[f] << std::endl;
+      ok = false;
+      continue;
+    }
+    if (std::abs(means[fid][0] - expSumX[f] / expCount[f]) > 1e-6 || std::abs(means[fid][1] - expSumY[f] / expCount[f]) > 1e-6)
+    {
+      std::cerr << "Feature " << fid << ": wrong mean " << means[fid] << std::endl;
+      ok = false;
+    }
+    for (unsigned int band = 0; band < 2; ++band)
+    {
+      if (mins[fid][band] != expMin[f][band] || maxs[fid][band] != expMax[f][band])
+      {
+        std::cerr << "Feature " << fid << ": wrong min/max " << mins[fid] << " " << maxs[fid] << std::endl;
+        ok = false;
+      }
+    }
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
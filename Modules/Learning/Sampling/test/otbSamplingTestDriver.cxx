@@ -26,7 +26,9 @@ void RegisterTests()
   REGISTER_TEST(otbOGRDataToSamplePositionFilter);
   REGISTER_TEST(otbOGRDataToSamplePositionFilterPattern);
   REGISTER_TEST(otbOGRDataToClassStatisticsFilter);
+  REGISTER_TEST(otbOGRDataToZonalStatisticsFilter);
   REGISTER_TEST(otbImageSampleExtractorFilter);
   REGISTER_TEST(otbImageSampleExtractorFilterUpdate);
+  REGISTER_TEST(otbImageSampleExtractorFilterSampleTable);
   REGISTER_TEST(otbSamplingRateCalculatorList);
 }
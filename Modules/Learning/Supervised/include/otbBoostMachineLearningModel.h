@@ -28,6 +28,7 @@
 #include "otbMachineLearningModel.h"
 
 #include "otbOpenCVUtils.h"
+#include "otbFlatRandomForest.h"
 
 namespace otb
 {
@@ -41,14 +42,16 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   /** Run-time type information (and related methods). */
   itkNewMacro(Self);
   itkTypeMacro(BoostMachineLearningModel, MachineLearningModel);
@@ -85,13 +88,20 @@ public:
   itkGetMacro(MaxDepth, int);
   itkSetMacro(MaxDepth, int);
 
+  /** Save the model in the compact binary format of FlatRandomForest: much
+   * faster to load, but only usable for classification */
+  itkGetMacro(BinaryModel, bool);
+  itkSetMacro(BinaryModel, bool);
+  itkBooleanMacro(BinaryModel);
+
   /** Train the machine learning model */
   void Train() override;
 
-  /** Save the model to file */
+  /** Save the model to file, in the binary format of FlatRandomForest if
+   * BinaryModel is on (classification only) */
   void Save(const std::string& filename, const std::string& name = "") override;
 
-  /** Load the model from file */
+  /** Load the model from file, either an OpenCV model or a binary one */
   void Load(const std::string& filename, const std::string& name = "") override;
 
   /**\name Classification model file compatibility tests */
@@ -113,6 +123,16 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict values by blocks of samples, with the flattened trees when
+   * available */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
+  /** Predict values for samples read from a buffer, with the flattened
+   * trees when available */
+  void DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                       ConfidenceValueType* quality = nullptr) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -120,12 +140,22 @@ private:
   BoostMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Can the flattened trees predict samples of nbFeatures features ? */
+  bool UseFlatBoost(unsigned int nbFeatures, bool withQuality) const;
+
+  /** Labels (and optionally confidences) of a block of float samples, with
+   * the flattened trees */
+  void PredictBlock(const float* samples, std::size_t nbSamples, std::size_t stride, TargetValueType* labels, ConfidenceValueType* quality) const;
+
   cv::Ptr<cv::ml::Boost> m_BoostModel;
+  /** Flattened copy of m_BoostModel, rebuilt after Train() and Load() */
+  FlatRandomForest m_FlatBoost;
 
   int    m_BoostType;
   int    m_WeakCount;
   double m_WeightTrimRate;
   int    m_MaxDepth;
+  bool   m_BinaryModel;
 };
 } // end namespace otb
 
@@ -25,6 +25,9 @@
 #include "otbOpenCVUtils.h"
 
 #include <fstream>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 #include "itkMacro.h"
 
 namespace otb
@@ -36,7 +39,8 @@ BoostMachineLearningModel<TInputValue, TOutputValue>::BoostMachineLearningModel(
     m_BoostType(CvBoost::REAL),
     m_WeakCount(100),
     m_WeightTrimRate(0.95),
-    m_MaxDepth(1)
+    m_MaxDepth(1),
+    m_BinaryModel(false)
 {
   this->m_ConfidenceIndex = true;
 }
@@ -63,6 +67,7 @@ void BoostMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_BoostModel->setUseSurrogates(false);
   m_BoostModel->setPriors(cv::Mat());
   m_BoostModel->train(cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels, cv::noArray(), cv::noArray(), cv::noArray(), var_type));
+  m_FlatBoost.BuildBoost(*m_BoostModel);
 }
 
 template <class TInputValue, class TOutputValue>
@@ -71,6 +76,25 @@ BoostMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampl
 {
   TargetSampleType target;
 
+  if (this->UseFlatBoost(input.Size(), quality != nullptr))
+  {
+    if (proba != nullptr && !this->m_ProbaIndex)
+      itkExceptionMacro("Probability per class not available for this classifier !");
+
+    std::vector<float> flatSample(input.Size());
+    for (unsigned int i = 0; i < input.Size(); ++i)
+      flatSample[i] = static_cast<float>(input[i]);
+
+    TargetValueType label;
+    this->PredictBlock(flatSample.data(), 1, flatSample.size(), &label, quality);
+    target[0] = label;
+    return target;
+  }
+
+  // Models loaded from the binary format only have the flat trees
+  if (!m_BoostModel->isTrained())
+    itkExceptionMacro("Sample has " << input.Size() << " features, the binary model expects " << m_FlatBoost.GetNumberOfFeatures());
+
   // convert listsample to Mat
   cv::Mat sample;
 
@@ -90,9 +114,128 @@ BoostMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampl
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+bool BoostMachineLearningModel<TInputValue, TOutputValue>::UseFlatBoost(unsigned int nbFeatures, bool withQuality) const
+{
+  // The confidence is left to OpenCV when its model is available
+  return m_FlatBoost.IsValid() && nbFeatures >= m_FlatBoost.GetNumberOfFeatures() && (!withQuality || !m_BoostModel->isTrained());
+}
+
+template <class TInputValue, class TOutputValue>
+void BoostMachineLearningModel<TInputValue, TOutputValue>::PredictBlock(const float* samples, std::size_t nbSamples, std::size_t stride,
+                                                                        TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  // Only the sign of the sums matters
+  std::vector<double> sums(nbSamples, 0.);
+  m_FlatBoost.SumUntilDecided(samples, nbSamples, stride, sums.data());
+  for (std::size_t s = 0; s < nbSamples; ++s)
+  {
+    const unsigned int classIdx = m_FlatBoost.GetBoostedClass(sums[s]);
+    labels[s]                   = static_cast<TargetValueType>(m_FlatBoost.GetClassLabel(classIdx));
+    // Same as cv::ml::Boost::predict() with RAW_OUTPUT: index of the decided class
+    if (quality != nullptr)
+      quality[s] = static_cast<ConfidenceValueType>(classIdx);
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void BoostMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                          const unsigned int& size, TargetListSampleType* targets,
+                                                                          ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (!this->UseFlatBoost(input->GetMeasurementVectorSize(), quality != nullptr))
+  {
+    Superclass::DoPredictBatch(input, startIndex, size, targets, quality, proba);
+    return;
+  }
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  const unsigned int blockSize  = 256;
+  const unsigned int nbFeatures = input->GetMeasurementVectorSize();
+
+  std::vector<float>               block(blockSize * nbFeatures);
+  std::vector<TargetValueType>     labels(blockSize);
+  std::vector<ConfidenceValueType> confidences(blockSize);
+
+  for (unsigned int blockStart = startIndex; blockStart < startIndex + size; blockStart += blockSize)
+  {
+    const unsigned int nbSamples = std::min(blockSize, startIndex + size - blockStart);
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const InputSampleType& sample = input->GetMeasurementVector(blockStart + s);
+      float*                 dest   = block.data() + s * nbFeatures;
+      for (unsigned int i = 0; i < nbFeatures; ++i)
+        dest[i] = static_cast<float>(sample[i]);
+    }
+
+    this->PredictBlock(block.data(), nbSamples, nbFeatures, labels.data(), quality != nullptr ? confidences.data() : nullptr);
+
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      TargetSampleType target;
+      target[0] = labels[s];
+      targets->SetMeasurementVector(blockStart + s, target);
+      if (quality != nullptr)
+        quality->SetMeasurementVector(blockStart + s, confidences[s]);
+    }
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void BoostMachineLearningModel<TInputValue, TOutputValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures,
+                                                                           std::size_t stride, TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  if (!this->UseFlatBoost(nbFeatures, quality != nullptr))
+  {
+    Superclass::DoPredictBuffer(samples, nbSamples, nbFeatures, stride, labels, quality);
+    return;
+  }
+
+  // Float samples are read in place, other types are converted block by block
+  if (std::is_same<InputValueType, float>::value)
+  {
+    this->PredictBlock(reinterpret_cast<const float*>(samples), nbSamples, stride, labels, quality);
+    return;
+  }
+
+  const unsigned int blockSize = 256;
+  std::vector<float> block(blockSize * nbFeatures);
+  for (unsigned int blockStart = 0; blockStart < nbSamples; blockStart += blockSize)
+  {
+    const unsigned int nbBlockSamples = std::min(blockSize, nbSamples - blockStart);
+    for (unsigned int s = 0; s < nbBlockSamples; ++s)
+    {
+      const InputValueType* sample = samples + (blockStart + s) * stride;
+      float*                dest   = block.data() + s * nbFeatures;
+      for (unsigned int i = 0; i < nbFeatures; ++i)
+        dest[i] = static_cast<float>(sample[i]);
+    }
+    this->PredictBlock(block.data(), nbBlockSamples, nbFeatures, labels + blockStart, quality != nullptr ? quality + blockStart : nullptr);
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void BoostMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
+  if (m_BinaryModel)
+  {
+    if (!m_FlatBoost.IsValid())
+      itkExceptionMacro("Only boosted trees on numerical features can be saved in binary format");
+
+    std::ofstream ofs(filename, std::ios::out | std::ios::binary);
+    if (!m_FlatBoost.Write(ofs))
+      itkExceptionMacro("Could not write binary model file " << filename);
+    return;
+  }
+
   cv::FileStorage fs(filename, cv::FileStorage::WRITE);
   fs << (name.empty() ? m_BoostModel->getDefaultName() : cv::String(name)) << "{";
   m_BoostModel->write(fs);
@@ -103,15 +246,30 @@ void BoostMachineLearningModel<TInputValue, TOutputValue>::Save(const std::strin
 template <class TInputValue, class TOutputValue>
 void BoostMachineLearningModel<TInputValue, TOutputValue>::Load(const std::string& filename, const std::string& name)
 {
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  if (ifs && FlatRandomForest::CanRead(ifs, true))
+  {
+    // The OpenCV model is not available anymore
+    m_BoostModel = cv::ml::Boost::create();
+    if (!m_FlatBoost.Read(ifs) || !m_FlatBoost.IsBoosted())
+    {
+      m_FlatBoost.Clear();
+      itkExceptionMacro("Invalid binary model file " << filename);
+    }
+    return;
+  }
+  ifs.close();
+
   cv::FileStorage fs(filename, cv::FileStorage::READ);
   m_BoostModel->read(name.empty() ? fs.getFirstTopLevelNode() : fs[name]);
+  m_FlatBoost.BuildBoost(*m_BoostModel);
 }
 
 template <class TInputValue, class TOutputValue>
 bool BoostMachineLearningModel<TInputValue, TOutputValue>::CanReadFile(const std::string& file)
 {
   std::ifstream ifs;
-  ifs.open(file);
+  ifs.open(file, std::ios::in | std::ios::binary);
 
   if (!ifs)
   {
@@ -119,6 +277,9 @@ bool BoostMachineLearningModel<TInputValue, TOutputValue>::CanReadFile(const std
     return false;
   }
 
+  if (FlatRandomForest::CanRead(ifs, true))
+    return true;
+
   while (!ifs.eof())
   {
     std::string line;
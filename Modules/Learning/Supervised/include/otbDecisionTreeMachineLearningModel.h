@@ -28,6 +28,7 @@
 #include "otbMachineLearningModel.h"
 
 #include "otbOpenCVUtils.h"
+#include "otbFlatRandomForest.h"
 
 namespace otb
 {
@@ -41,14 +42,16 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   /** Run-time type information (and related methods). */
   itkNewMacro(Self);
   itkTypeMacro(DecisionTreeMachineLearningModel, MachineLearningModel);
@@ -120,6 +123,12 @@ public:
   itkGetMacro(TruncatePrunedTree, bool);
   itkSetMacro(TruncatePrunedTree, bool);
 
+  /** Save the model in the compact binary format of FlatRandomForest: much
+   * faster to load, but only usable for classification */
+  itkGetMacro(BinaryModel, bool);
+  itkSetMacro(BinaryModel, bool);
+  itkBooleanMacro(BinaryModel);
+
 
   /*  The array of a priori class probabilities, sorted by the class label
   * value. The parameter can be used to tune the decision tree preferences toward
@@ -144,10 +153,11 @@ public:
   /** Train the machine learning model */
   void Train() override;
 
-  /** Save the model to file */
+  /** Save the model to file, in the binary format of FlatRandomForest if
+   * BinaryModel is on (classification only) */
   void Save(const std::string& filename, const std::string& name = "") override;
 
-  /** Load the model from file */
+  /** Load the model from file, either an OpenCV model or a binary one */
   void Load(const std::string& filename, const std::string& name = "") override;
 
   /**\name Classification model file compatibility tests */
@@ -169,6 +179,16 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict values by blocks of samples, with the flattened tree when
+   * available */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
+  /** Predict values for samples read from a buffer, with the flattened
+   * tree when available */
+  void DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                       ConfidenceValueType* quality = nullptr) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -176,7 +196,13 @@ private:
   DecisionTreeMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Labels of a block of float samples, with the flattened tree */
+  void PredictBlock(const float* samples, std::size_t nbSamples, std::size_t stride, TargetValueType* labels) const;
+
   cv::Ptr<cv::ml::DTrees> m_DTreeModel;
+  /** Flattened copy of m_DTreeModel used for classification, rebuilt after
+   * Train() and Load() */
+  FlatRandomForest m_FlatTree;
 
   int                m_MaxDepth;
   int                m_MinSampleCount;
@@ -186,6 +212,7 @@ private:
   bool               m_Use1seRule;
   bool               m_TruncatePrunedTree;
   std::vector<float> m_Priors;
+  bool               m_BinaryModel;
 };
 } // end namespace otb
 
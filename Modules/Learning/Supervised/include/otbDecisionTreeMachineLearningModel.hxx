@@ -25,6 +25,9 @@
 #include "otbOpenCVUtils.h"
 
 #include <fstream>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 #include "itkMacro.h"
 
 namespace otb
@@ -40,7 +43,8 @@ DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::DecisionTreeMachine
     m_UseSurrogates(false),
     m_MaxCategories(10),
     m_Use1seRule(true),
-    m_TruncatePrunedTree(true)
+    m_TruncatePrunedTree(true),
+    m_BinaryModel(false)
 {
   this->m_IsRegressionSupported = true;
 }
@@ -73,6 +77,7 @@ void DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_DTreeModel->setTruncatePrunedTree(m_TruncatePrunedTree);
   m_DTreeModel->setPriors(cv::Mat(m_Priors));
   m_DTreeModel->train(cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels, cv::noArray(), cv::noArray(), cv::noArray(), var_type));
+  m_FlatTree.Build(*m_DTreeModel);
 }
 
 template <class TInputValue, class TOutputValue>
@@ -81,6 +86,32 @@ DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const Inp
 {
   TargetSampleType target;
 
+  if (quality != nullptr)
+  {
+    if (!this->m_ConfidenceIndex)
+    {
+      itkExceptionMacro("Confidence index not available for this classifier !");
+    }
+  }
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  if (m_FlatTree.IsValid() && input.Size() >= m_FlatTree.GetNumberOfFeatures())
+  {
+    std::vector<float> flatSample(input.Size());
+    for (unsigned int i = 0; i < input.Size(); ++i)
+      flatSample[i] = static_cast<float>(input[i]);
+
+    TargetValueType label;
+    this->PredictBlock(flatSample.data(), 1, flatSample.size(), &label);
+    target[0] = label;
+    return target;
+  }
+
+  // Models loaded from the binary format only have the flat tree
+  if (!m_DTreeModel->isTrained())
+    itkExceptionMacro("Sample has " << input.Size() << " features, the binary model expects " << m_FlatTree.GetNumberOfFeatures());
+
   // convert listsample to Mat
   cv::Mat sample;
 
@@ -89,22 +120,121 @@ DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const Inp
 
   target[0] = static_cast<TOutputValue>(result);
 
-  if (quality != nullptr)
+  return target;
+}
+
+template <class TInputValue, class TOutputValue>
+void DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::PredictBlock(const float* samples, std::size_t nbSamples, std::size_t stride,
+                                                                               TargetValueType* labels) const
+{
+  const unsigned int        nbClasses = m_FlatTree.GetNumberOfClasses();
+  std::vector<unsigned int> votes(nbSamples * nbClasses, 0);
+  m_FlatTree.Vote(samples, nbSamples, stride, votes.data());
+  for (std::size_t s = 0; s < nbSamples; ++s)
+    labels[s] = static_cast<TargetValueType>(m_FlatTree.GetClassLabel(m_FlatTree.GetMostVotedClass(votes.data() + s * nbClasses)));
+}
+
+template <class TInputValue, class TOutputValue>
+void DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                 const unsigned int& size, TargetListSampleType* targets,
+                                                                                 ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (!m_FlatTree.IsValid() || input->GetMeasurementVectorSize() < m_FlatTree.GetNumberOfFeatures())
   {
-    if (!this->m_ConfidenceIndex)
-    {
-      itkExceptionMacro("Confidence index not available for this classifier !");
-    }
+    Superclass::DoPredictBatch(input, startIndex, size, targets, quality, proba);
+    return;
+  }
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
   }
+
+  if (quality != nullptr && !this->m_ConfidenceIndex)
+    itkExceptionMacro("Confidence index not available for this classifier !");
   if (proba != nullptr && !this->m_ProbaIndex)
     itkExceptionMacro("Probability per class not available for this classifier !");
 
-  return target;
+  const unsigned int blockSize  = 256;
+  const unsigned int nbFeatures = input->GetMeasurementVectorSize();
+
+  std::vector<float>           block(blockSize * nbFeatures);
+  std::vector<TargetValueType> labels(blockSize);
+
+  for (unsigned int blockStart = startIndex; blockStart < startIndex + size; blockStart += blockSize)
+  {
+    const unsigned int nbSamples = std::min(blockSize, startIndex + size - blockStart);
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const InputSampleType& sample = input->GetMeasurementVector(blockStart + s);
+      float*                 dest   = block.data() + s * nbFeatures;
+      for (unsigned int i = 0; i < nbFeatures; ++i)
+        dest[i] = static_cast<float>(sample[i]);
+    }
+
+    this->PredictBlock(block.data(), nbSamples, nbFeatures, labels.data());
+
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      TargetSampleType target;
+      target[0] = labels[s];
+      targets->SetMeasurementVector(blockStart + s, target);
+    }
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples,
+                                                                                  unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                                                                                  ConfidenceValueType* quality) const
+{
+  if (!m_FlatTree.IsValid() || nbFeatures < m_FlatTree.GetNumberOfFeatures())
+  {
+    Superclass::DoPredictBuffer(samples, nbSamples, nbFeatures, stride, labels, quality);
+    return;
+  }
+
+  if (quality != nullptr && !this->m_ConfidenceIndex)
+    itkExceptionMacro("Confidence index not available for this classifier !");
+
+  // Float samples are read in place, other types are converted block by block
+  if (std::is_same<InputValueType, float>::value)
+  {
+    this->PredictBlock(reinterpret_cast<const float*>(samples), nbSamples, stride, labels);
+    return;
+  }
+
+  const unsigned int blockSize = 256;
+  std::vector<float> block(blockSize * nbFeatures);
+  for (unsigned int blockStart = 0; blockStart < nbSamples; blockStart += blockSize)
+  {
+    const unsigned int nbBlockSamples = std::min(blockSize, nbSamples - blockStart);
+    for (unsigned int s = 0; s < nbBlockSamples; ++s)
+    {
+      const InputValueType* sample = samples + (blockStart + s) * stride;
+      float*                dest   = block.data() + s * nbFeatures;
+      for (unsigned int i = 0; i < nbFeatures; ++i)
+        dest[i] = static_cast<float>(sample[i]);
+    }
+    this->PredictBlock(block.data(), nbBlockSamples, nbFeatures, labels + blockStart);
+  }
 }
 
 template <class TInputValue, class TOutputValue>
 void DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
+  if (m_BinaryModel)
+  {
+    if (!m_FlatTree.IsValid())
+      itkExceptionMacro("Only classification trees on numerical features can be saved in binary format");
+
+    std::ofstream ofs(filename, std::ios::out | std::ios::binary);
+    if (!m_FlatTree.Write(ofs))
+      itkExceptionMacro("Could not write binary model file " << filename);
+    return;
+  }
+
   cv::FileStorage fs(filename, cv::FileStorage::WRITE);
   fs << (name.empty() ? m_DTreeModel->getDefaultName() : cv::String(name)) << "{";
   m_DTreeModel->write(fs);
@@ -115,15 +245,27 @@ void DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::Save(const std
 template <class TInputValue, class TOutputValue>
 void DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::Load(const std::string& filename, const std::string& name)
 {
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  if (ifs && FlatRandomForest::CanRead(ifs))
+  {
+    // The OpenCV model is not available anymore
+    m_DTreeModel = cv::ml::DTrees::create();
+    if (!m_FlatTree.Read(ifs))
+      itkExceptionMacro("Invalid binary model file " << filename);
+    return;
+  }
+  ifs.close();
+
   cv::FileStorage fs(filename, cv::FileStorage::READ);
   m_DTreeModel->read(name.empty() ? fs.getFirstTopLevelNode() : fs[name]);
+  m_FlatTree.Build(*m_DTreeModel);
 }
 
 template <class TInputValue, class TOutputValue>
 bool DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::CanReadFile(const std::string& file)
 {
   std::ifstream ifs;
-  ifs.open(file);
+  ifs.open(file, std::ios::in | std::ios::binary);
 
   if (!ifs)
   {
@@ -131,6 +273,9 @@ bool DecisionTreeMachineLearningModel<TInputValue, TOutputValue>::CanReadFile(co
     return false;
   }
 
+  if (FlatRandomForest::CanRead(ifs))
+    return true;
+
   while (!ifs.eof())
   {
     std::string line;
@@ -40,6 +40,12 @@ namespace otb
  * This optimizer can be use to perform a preliminary coarse search on
  * the search space.
  *
+ * When NumberOfThreads is larger than 1, the grid positions are
+ * evaluated concurrently by as many threads, which requires a cost
+ * function whose GetValue() can be called from several threads. The
+ * results are then the same as a sequential walk, but the iteration
+ * events are only invoked once all the positions have been evaluated.
+ *
  * \ingroup Numerics Optimizers
  *
  * \ingroup OTBSupervised
@@ -69,6 +75,9 @@ public:
   itkSetMacro(GeometricProgression, double);
   itkSetMacro(NumberOfSteps, StepsType);
   itkSetMacro(StepLength, double);
+  /** Number of threads evaluating the grid positions, 1 by default */
+  itkSetMacro(NumberOfThreads, unsigned int);
+  itkGetConstMacro(NumberOfThreads, unsigned int);
   itkGetConstReferenceMacro(GeometricProgression, double);
   itkGetConstReferenceMacro(NumberOfSteps, StepsType);
   itkGetConstReferenceMacro(StepLength, double);
@@ -91,6 +100,9 @@ protected:
   void AdvanceOneStep(void);
   void IncrementIndex(ParametersType& param);
 
+  /** Evaluate all the remaining grid positions with several threads */
+  void WalkConcurrently(void);
+
 protected:
   MeasureType    m_CurrentValue;
   StepsType      m_NumberOfSteps;
@@ -105,6 +117,7 @@ protected:
   MeasureType    m_MinimumMetricValue;
   ParametersType m_MinimumMetricValuePosition;
   ParametersType m_MaximumMetricValuePosition;
+  unsigned int   m_NumberOfThreads;
 
 private:
   ExhaustiveExponentialOptimizer(const Self&) = delete;
@@ -0,0 +1,209 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbFlatRandomForest_h
+#define otbFlatRandomForest_h
+
+#include "otbOpenCVUtils.h"
+#include <cstddef>
+#include <iosfwd>
+#include <vector>
+
+namespace otb
+{
+
+/** \class FlatRandomForest
+ * \brief Flat, block-oriented inference engine for OpenCV random forests,
+ * decision trees and boosted trees
+ *
+ * The trees of a trained (or loaded) classification forest are converted
+ * into a single structure-of-arrays node table: for each node, the index of
+ * the tested feature, the threshold and the offset of its children. Nodes of
+ * a tree are stored contiguously in breadth-first order, and the two children
+ * of a node are stored side by side, so that only one child offset is kept.
+ *
+ * Samples are then evaluated by blocks, tree by tree: the nodes of a tree stay
+ * in cache while the whole block goes through it.
+ *
+ * Only classification forests on ordered (numerical) variables are
+ * supported, which is what RandomForestsMachineLearningModel trains. Build()
+ * returns false for any other model, and the caller is expected to fall back
+ * to the OpenCV prediction.
+ *
+ * The decisions match cv::ml::RTrees::predict(): a sample goes to the left
+ * child when its value is lower or equal to the split threshold (to the right
+ * one for inversed splits), and the predicted class is the first most voted
+ * one.
+ *
+ * A decision tree is handled as a forest of a single tree.
+ *
+ * Boosted trees (see BuildBoost()) are stored in the same node table, the
+ * thresholds of the leaves holding their weak responses. The decision
+ * matches cv::ml::Boost::predict(): the second class when the sum of the
+ * responses of the trees is positive, the first one otherwise. Since the
+ * responses are stored as single precision floats, samples whose sum is very
+ * close to zero may get the other class.
+ *
+ * The node table can also be written to and read from a compact binary
+ * stream (see Write() and Read()), which loads much faster than the text
+ * serialisation of the OpenCV model. Thresholds can optionally be stored as
+ * half precision floats, halving the size of this array at the cost of
+ * possibly different decisions for values very close to a threshold.
+ *
+ * \ingroup OTBSupervised
+ */
+class OTBSupervised_EXPORT FlatRandomForest
+{
+public:
+  typedef std::vector<unsigned int> VotesVectorType;
+
+  /** Converts the trees of \c model.
+   * \return false if the model cannot be handled, in which case the engine
+   * is left empty.
+   */
+  bool Build(const cv::ml::DTrees& model);
+
+  /** Converts the trees of a two-class boosted model.
+   * \return false if the model cannot be handled, in which case the engine
+   * is left empty.
+   */
+  bool BuildBoost(const cv::ml::Boost& model);
+
+  /** Empties the engine */
+  void Clear();
+
+  /** Has a forest been successfully converted ? */
+  bool IsValid() const
+  {
+    return !m_Roots.empty();
+  }
+
+  /** Is the engine holding boosted trees ? In that case, use Sum() instead
+   * of Vote() */
+  bool IsBoosted() const
+  {
+    return m_Boosted;
+  }
+
+  unsigned int GetNumberOfTrees() const
+  {
+    return m_Roots.size();
+  }
+
+  unsigned int GetNumberOfClasses() const
+  {
+    return m_ClassLabels.size();
+  }
+
+  /** Number of features expected in each sample */
+  unsigned int GetNumberOfFeatures() const
+  {
+    return m_NumberOfFeatures;
+  }
+
+  /** Label of the class at index \c classIdx in the votes */
+  float GetClassLabel(unsigned int classIdx) const
+  {
+    return m_ClassLabels[classIdx];
+  }
+
+  /** Accumulates the votes of all the trees for a block of samples.
+   * \param samples row-major block of \c nbSamples samples, the first
+   * feature of consecutive samples being \c stride values apart.
+   * \param votes \c nbSamples x GetNumberOfClasses() vote counters,
+   * incremented (not reset) by this method.
+   */
+  void Vote(const float* samples, std::size_t nbSamples, std::size_t stride, unsigned int* votes) const;
+
+  /** Same as Vote(), but stops evaluating the trees for a sample as soon as
+   * the remaining trees can no longer change its most voted class. The
+   * decided class is the one Vote() would give.
+   * \param nbVotingTrees receives, for each sample, the number of trees
+   * that actually voted.
+   */
+  void VoteUntilDecided(const float* samples, std::size_t nbSamples, std::size_t stride, unsigned int* votes, unsigned int* nbVotingTrees) const;
+
+  /** Index of the first most voted class in \c votes */
+  unsigned int GetMostVotedClass(const unsigned int* votes) const;
+
+  /** Accumulates the responses of all the boosted trees for a block of
+   * samples, in \c nbSamples sums incremented (not reset) by this method.
+   */
+  void Sum(const float* samples, std::size_t nbSamples, std::size_t stride, double* sums) const;
+
+  /** Same as Sum(), but stops evaluating the trees for a sample as soon as
+   * the remaining trees can no longer change the sign of its sum. */
+  void SumUntilDecided(const float* samples, std::size_t nbSamples, std::size_t stride, double* sums) const;
+
+  /** Index of the class decided by the sum of the boosted responses */
+  unsigned int GetBoostedClass(double sum) const
+  {
+    return sum > 0 ? 1 : 0;
+  }
+
+  /** Writes the engine in binary form.
+   * \param halfThresholds store the thresholds as half precision floats,
+   * ignored for boosted trees whose leaf responses share this array
+   * \return false if the engine is empty or the stream could not be written
+   */
+  bool Write(std::ostream& os, bool halfThresholds = false) const;
+
+  /** Reads an engine written by Write().
+   * \return false if the stream does not hold a valid engine, in which case
+   * the engine is left empty.
+   */
+  bool Read(std::istream& is);
+
+  /** Does the stream start with the signature written by Write(), for
+   * boosted trees or not ? The stream position is restored. */
+  static bool CanRead(std::istream& is, bool boosted = false);
+
+private:
+  /** Breadth-first conversion of the trees of \c model into the node table.
+   * Leaves hold their class index, or their response in the thresholds
+   * array if \c leafValues is set. */
+  bool FlattenTrees(const cv::ml::DTrees& model, bool leafValues);
+
+  /** Computes m_RemainingSumBounds from the leaf responses */
+  void ComputeSumBounds();
+
+  /** Tested feature, -1 for leaves */
+  std::vector<int> m_Feature;
+  /** Split threshold */
+  std::vector<float> m_Threshold;
+  /** Index of the child taken when the value is lower or equal to the
+   * threshold, the other child being just after it. For leaves, index of the
+   * voted class. */
+  std::vector<int> m_Child;
+  /** Index of the root node of each tree */
+  std::vector<int> m_Roots;
+  /** Label of each class index */
+  std::vector<float> m_ClassLabels;
+  /** For boosted trees, bound of the absolute sum of the responses of the
+   * trees from each index to the last one */
+  std::vector<double> m_RemainingSumBounds;
+
+  unsigned int m_NumberOfFeatures = 0;
+  bool         m_Boosted          = false;
+};
+
+} // end namespace otb
+
+#endif
@@ -41,14 +41,16 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   /** Run-time type information (and related methods). */
   itkNewMacro(Self);
   itkTypeMacro(KNearestNeighborsMachineLearningModel, MachineLearningModel);
@@ -78,6 +80,15 @@ public:
   itkGetMacro(DecisionRule, int);
   itkSetMacro(DecisionRule, int);
 
+  /** Index the training samples in a KD-tree instead of searching the
+   *  neighbors by brute force. The search is still exact, and much faster
+   *  for a large number of training samples with few features.
+   *  Default is false
+   */
+  itkGetMacro(UseKDTree, bool);
+  itkSetMacro(UseKDTree, bool);
+  itkBooleanMacro(UseKDTree);
+
   /** Train the machine learning model */
   void Train() override;
 
@@ -106,6 +117,14 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict values for a range of samples at once */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
+  /** Predict values for samples read from a buffer, wrapped in a matrix */
+  void DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                       ConfidenceValueType* quality = nullptr) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -113,11 +132,19 @@ private:
   KNearestNeighborsMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Predict the samples stored as the rows of a CV_32FC1 matrix */
+  void PredictMat(const cv::Mat& samples, TargetValueType* labels, ConfidenceValueType* quality) const;
+
+  /** Applies the decision rule to the responses of the nearest neighbors */
+  TargetSampleType NeighborsToTarget(float result, const float* nearest, ConfidenceValueType* quality) const;
+
   cv::Ptr<cv::ml::KNearest> m_KNearestModel;
 
   int m_K;
 
   int m_DecisionRule;
+
+  bool m_UseKDTree;
 };
 } // end namespace otb
 
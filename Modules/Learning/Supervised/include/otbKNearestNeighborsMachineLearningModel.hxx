@@ -26,6 +26,7 @@
 #include "otbOpenCVUtils.h"
 
 #include <fstream>
+#include <vector>
 #include <set>
 #include "itkMacro.h"
 
@@ -37,7 +38,8 @@ KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::KNearestNeighb
   :
     m_KNearestModel(cv::ml::KNearest::create()),
     m_K(32),
-    m_DecisionRule(KNN_VOTING)
+    m_DecisionRule(KNN_VOTING),
+    m_UseKDTree(false)
 {
   this->m_ConfidenceIndex       = true;
   this->m_IsRegressionSupported = true;
@@ -71,8 +73,7 @@ void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::Train()
   }
 
   m_KNearestModel->setDefaultK(m_K);
-  // would be nice to expose KDTree mode ( maybe in a different classifier)
-  m_KNearestModel->setAlgorithmType(cv::ml::KNearest::BRUTE_FORCE);
+  m_KNearestModel->setAlgorithmType(m_UseKDTree ? cv::ml::KNearest::KDTREE : cv::ml::KNearest::BRUTE_FORCE);
   m_KNearestModel->setIsClassifier(!this->m_RegressionMode);
   // setEmax() ?
   m_KNearestModel->train(cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels));
@@ -83,8 +84,6 @@ typename KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::Targe
 KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredict(const InputSampleType& input, ConfidenceValueType* quality,
                                                                             ProbaSampleType* proba) const
 {
-  TargetSampleType target;
-
   // convert listsample to Mat
   cv::Mat sample;
   otb::SampleToMat<InputSampleType>(input, sample);
@@ -93,6 +92,73 @@ KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredict(cons
   cv::Mat nearest(1, m_K, CV_32FC1);
   result = m_KNearestModel->findNearest(sample, m_K, cv::noArray(), nearest, cv::noArray());
 
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  return this->NeighborsToTarget(result, nearest.ptr<float>(0), quality);
+}
+
+template <class TInputValue, class TTargetValue>
+void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                      const unsigned int& size, TargetListSampleType* targets,
+                                                                                      ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+  if (size == 0)
+    return;
+
+  // Search the neighbors of the whole range at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  std::vector<TargetValueType>     labels(size);
+  std::vector<ConfidenceValueType> confidences(quality != nullptr ? size : 0);
+  this->PredictMat(samples, labels.data(), quality != nullptr ? confidences.data() : nullptr);
+
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    TargetSampleType target;
+    target[0] = labels[i];
+    targets->SetMeasurementVector(startIndex + i, target);
+    if (quality != nullptr)
+      quality->SetMeasurementVector(startIndex + i, confidences[i]);
+  }
+}
+
+template <class TInputValue, class TTargetValue>
+void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples,
+                                                                                       unsigned int nbFeatures, std::size_t stride,
+                                                                                       TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  cv::Mat mat;
+  otb::BufferToMat(samples, nbSamples, nbFeatures, stride, mat);
+  this->PredictMat(mat, labels, quality);
+}
+
+template <class TInputValue, class TTargetValue>
+void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::PredictMat(const cv::Mat& samples, TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  cv::Mat results;
+  cv::Mat nearest;
+  m_KNearestModel->findNearest(samples, m_K, results, nearest, cv::noArray());
+  for (int i = 0; i < samples.rows; ++i)
+  {
+    labels[i] = this->NeighborsToTarget(results.at<float>(i, 0), nearest.ptr<float>(i), quality != nullptr ? quality + i : nullptr)[0];
+  }
+}
+
+template <class TInputValue, class TTargetValue>
+typename KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::TargetSampleType
+KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::NeighborsToTarget(float result, const float* nearest, ConfidenceValueType* quality) const
+{
+  TargetSampleType target;
+
   // compute quality if asked (only happens in classification mode)
   if (quality != nullptr)
   {
@@ -100,15 +166,13 @@ KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredict(cons
     unsigned int accuracy = 0;
     for (int k = 0; k < m_K; ++k)
     {
-      if (nearest.at<float>(0, k) == result)
+      if (nearest[k] == result)
       {
         accuracy++;
       }
     }
     (*quality) = static_cast<ConfidenceValueType>(accuracy);
   }
-  if (proba != nullptr && !this->m_ProbaIndex)
-    itkExceptionMacro("Probability per class not available for this classifier !");
 
   // Decision rule :
   //  VOTING is OpenCV default behaviour for classification
@@ -119,7 +183,7 @@ KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::DoPredict(cons
     std::multiset<float> values;
     for (int k = 0; k < m_K; ++k)
     {
-      values.insert(nearest.at<float>(0, k));
+      values.insert(nearest[k]);
     }
     std::multiset<float>::iterator median = values.begin();
     int                            pos    = (m_K >> 1);
@@ -171,6 +235,7 @@ void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::Load(cons
     m_KNearestModel->read(fs.getFirstTopLevelNode());
     m_DecisionRule = (int)(fs.getFirstTopLevelNode()["DecisionRule"]);
     m_K = m_KNearestModel->getDefaultK();
+    m_UseKDTree = (m_KNearestModel->getAlgorithmType() == cv::ml::KNearest::KDTREE);
     return;
   }
   ifs.open(filename);
@@ -278,6 +343,8 @@ void KNearestNeighborsMachineLearningModel<TInputValue, TTargetValue>::PrintSelf
 {
   // Call superclass implementation
   Superclass::PrintSelf(os, indent);
+  os << indent << "K: " << m_K << std::endl;
+  os << indent << "UseKDTree: " << m_UseKDTree << std::endl;
 }
 
 } // end namespace otb
@@ -39,14 +39,16 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   /** enum to choose the way confidence is computed
    *   CM_INDEX : compute the difference between highest and second highest probability
    *   CM_PROBA : returns probabilities for all classes
@@ -250,6 +252,11 @@ public:
 
   double CrossValidation(void);
 
+  /** Cross validation accuracy of the model trained with the given C,
+   * kernel gamma and kernel coef0. The model is not modified, so that
+   * several parameters can be evaluated concurrently */
+  double CrossValidation(double c, double gamma, double coef0) const;
+
   /** Return number of support vectors */
   unsigned int GetNumberOfSupportVectors(void) const
   {
@@ -275,6 +282,14 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict values for a range of samples at once */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
+  /** Predict values for samples read from a buffer */
+  void DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                       ConfidenceValueType* quality = nullptr) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -282,6 +297,10 @@ private:
   LibSVMMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Predicts one sample, already converted to LibSVM nodes.
+   * \c prob_estimates must hold one value per class. */
+  TargetSampleType PredictNodes(const struct svm_node* x, ConfidenceValueType* quality, double* prob_estimates) const;
+
   void BuildProblem(void);
 
   void ConsistencyCheck(void);
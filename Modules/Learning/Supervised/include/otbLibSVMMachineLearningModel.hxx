@@ -22,9 +22,12 @@
 #define otbLibSVMMachineLearningModel_hxx
 
 #include <fstream>
+#include <algorithm>
+#include <vector>
 #include "otbLibSVMMachineLearningModel.h"
 #include "otbSVMCrossValidationCostFunction.h"
 #include "otbExhaustiveExponentialOptimizer.h"
+#include "itkMultiThreader.h"
 #include "otbMacro.h"
 #include "otbUtils.h"
 
@@ -102,17 +105,11 @@ template <class TInputValue, class TOutputValue>
 typename LibSVMMachineLearningModel<TInputValue, TOutputValue>::TargetSampleType
 LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampleType& input, ConfidenceValueType* quality, ProbaSampleType* proba) const
 {
-  TargetSampleType target;
-  target.Fill(0);
-
-  // Get type and number of classes
-  int svm_type = svm_get_svm_type(m_Model);
-
-  // Allocate nodes (/TODO if performances problems are related to too
-  // many allocations, a cache approach can be set)
-  struct svm_node* x = new struct svm_node[input.Size() + 1];
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
 
-  // Fill the node
+  // Allocate and fill the nodes
+  std::vector<struct svm_node> x(input.Size() + 1);
   for (unsigned int i = 0; i < input.Size(); i++)
   {
     x[i].index = i + 1;
@@ -122,9 +119,98 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
   // terminate node
   x[input.Size()].index = -1;
   x[input.Size()].value = 0;
+
+  std::vector<double> prob_estimates(svm_get_nr_class(m_Model));
+  return this->PredictNodes(x.data(), quality, prob_estimates.data());
+}
+
+template <class TInputValue, class TOutputValue>
+void LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                           const unsigned int& size, TargetListSampleType* targets,
+                                                                           ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
   if (proba != nullptr && !this->m_ProbaIndex)
     itkExceptionMacro("Probability per class not available for this classifier !");
 
+  // The nodes, probability estimates and confidence buffers are allocated
+  // once for the whole range: only the node values change between samples
+  const unsigned int           nbFeatures = input->GetMeasurementVectorSize();
+  std::vector<struct svm_node> x(nbFeatures + 1);
+  for (unsigned int i = 0; i < nbFeatures; i++)
+  {
+    x[i].index = i + 1;
+  }
+  x[nbFeatures].index = -1;
+  x[nbFeatures].value = 0;
+
+  const unsigned int  nr_class = std::max(svm_get_nr_class(m_Model), 2);
+  std::vector<double> prob_estimates(nr_class);
+  // Some confidence modes output one value per class, or per pair of classes
+  std::vector<ConfidenceValueType> confidence(nr_class * (nr_class - 1) / 2 + nr_class, 0);
+
+  for (unsigned int id = startIndex; id < startIndex + size; ++id)
+  {
+    const InputSampleType& sample = input->GetMeasurementVector(id);
+    for (unsigned int i = 0; i < nbFeatures; i++)
+    {
+      x[i].value = sample[i];
+    }
+
+    const TargetSampleType target = this->PredictNodes(x.data(), quality != nullptr ? confidence.data() : nullptr, prob_estimates.data());
+    targets->SetMeasurementVector(id, target);
+    if (quality != nullptr)
+      quality->SetMeasurementVector(id, confidence[0]);
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples,
+                                                                            unsigned int nbFeatures, std::size_t stride,
+                                                                            TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  // Same buffers reuse as DoPredictBatch(), the node values being read from
+  // the sample buffer
+  std::vector<struct svm_node> x(nbFeatures + 1);
+  for (unsigned int i = 0; i < nbFeatures; i++)
+  {
+    x[i].index = i + 1;
+  }
+  x[nbFeatures].index = -1;
+  x[nbFeatures].value = 0;
+
+  const unsigned int               nr_class = std::max(svm_get_nr_class(m_Model), 2);
+  std::vector<double>              prob_estimates(nr_class);
+  std::vector<ConfidenceValueType> confidence(nr_class * (nr_class - 1) / 2 + nr_class, 0);
+
+  for (unsigned int id = 0; id < nbSamples; ++id)
+  {
+    const InputValueType* sample = samples + id * stride;
+    for (unsigned int i = 0; i < nbFeatures; i++)
+    {
+      x[i].value = sample[i];
+    }
+
+    labels[id] = this->PredictNodes(x.data(), quality != nullptr ? confidence.data() : nullptr, prob_estimates.data())[0];
+    if (quality != nullptr)
+      quality[id] = confidence[0];
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+typename LibSVMMachineLearningModel<TInputValue, TOutputValue>::TargetSampleType
+LibSVMMachineLearningModel<TInputValue, TOutputValue>::PredictNodes(const struct svm_node* x, ConfidenceValueType* quality, double* prob_estimates) const
+{
+  TargetSampleType target;
+  target.Fill(0);
+
+  // Get type and number of classes
+  int svm_type = svm_get_svm_type(m_Model);
+
   if (quality != nullptr)
   {
     if (!this->m_ConfidenceIndex)
@@ -135,10 +221,7 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
     {
       if (svm_type == C_SVC || svm_type == NU_SVC)
       {
-        // Eventually allocate space for probabilities
-        unsigned int nr_class       = svm_get_nr_class(m_Model);
-        double*      prob_estimates = new double[nr_class];
-        // predict
+        unsigned int nr_class = svm_get_nr_class(m_Model);
         target[0]      = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, prob_estimates));
         double maxProb = 0.0;
         double secProb = 0.0;
@@ -155,8 +238,6 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
           }
         }
         (*quality) = static_cast<ConfidenceValueType>(maxProb - secProb);
-
-        delete[] prob_estimates;
       }
       else
       {
@@ -182,10 +263,7 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
     // which gives different results than svm_predict()
     if (svm_check_probability_model(m_Model))
     {
-      unsigned int nr_class       = svm_get_nr_class(m_Model);
-      double*      prob_estimates = new double[nr_class];
-      target[0]                   = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, prob_estimates));
-      delete[] prob_estimates;
+      target[0] = static_cast<TargetValueType>(svm_predict_probability(m_Model, x, prob_estimates));
     }
     else
     {
@@ -193,9 +271,6 @@ LibSVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSamp
     }
   }
 
-  // Free allocated memory
-  delete[] x;
-
   return target;
 }
 
@@ -448,6 +523,32 @@ double LibSVMMachineLearningModel<TInputValue, TOutputValue>::CrossValidation(vo
   return accuracy;
 }
 
+template <class TInputValue, class TOutputValue>
+double LibSVMMachineLearningModel<TInputValue, TOutputValue>::CrossValidation(double c, double gamma, double coef0) const
+{
+  const unsigned int length = m_Problem.l;
+  if (length == 0)
+    return 0.;
+
+  struct svm_parameter parameters = m_Parameters;
+  parameters.C                    = c;
+  parameters.gamma                = gamma;
+  parameters.coef0                = coef0;
+
+  std::vector<double> target(length);
+  svm_cross_validation(&m_Problem, &parameters, m_CVFolders, target.data());
+
+  double total_correct = 0.;
+  for (unsigned int i = 0; i < length; ++i)
+  {
+    if (target[i] == m_Problem.y[i])
+    {
+      ++total_correct;
+    }
+  }
+  return total_correct / length;
+}
+
 template <class TInputValue, class TOutputValue>
 void LibSVMMachineLearningModel<TInputValue, TOutputValue>::OptimizeParameters()
 {
@@ -477,6 +578,8 @@ void LibSVMMachineLearningModel<TInputValue, TOutputValue>::OptimizeParameters()
     typename ExhaustiveExponentialOptimizer::StepsType coarseNbSteps(initialParameters.Size());
     coarseNbSteps.Fill(m_CoarseOptimizationNumberOfSteps);
 
+    // The grid points are cross validated concurrently
+    coarseOptimizer->SetNumberOfThreads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
     coarseOptimizer->SetNumberOfSteps(coarseNbSteps);
     coarseOptimizer->SetCostFunction(crossValidationFunction);
     coarseOptimizer->SetInitialPosition(initialParameters);
@@ -493,6 +596,7 @@ void LibSVMMachineLearningModel<TInputValue, TOutputValue>::OptimizeParameters()
 
     double stepLength = 1. / static_cast<double>(m_FineOptimizationNumberOfSteps);
 
+    fineOptimizer->SetNumberOfThreads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
     fineOptimizer->SetNumberOfSteps(fineNbSteps);
     fineOptimizer->SetStepLength(stepLength);
     fineOptimizer->SetCostFunction(crossValidationFunction);
@@ -38,6 +38,10 @@
 #include "otbLibSVMMachineLearningModelFactory.h"
 #endif
 
+#ifdef OTB_USE_ONNXRUNTIME
+#include "otbONNXMachineLearningModelFactory.h"
+#endif
+
 #ifdef OTB_USE_SHARK
 #include "otbSharkRandomForestsMachineLearningModelFactory.h"
 #include "otbSharkKMeansMachineLearningModelFactory.h"
@@ -97,6 +101,10 @@ void MachineLearningModelFactory<TInputValue, TOutputValue>::RegisterBuiltInFact
   RegisterFactory(LibSVMMachineLearningModelFactory<TInputValue, TOutputValue>::New());
 #endif
 
+#ifdef OTB_USE_ONNXRUNTIME
+  RegisterFactory(ONNXMachineLearningModelFactory<TInputValue, TOutputValue>::New());
+#endif
+
 #ifdef OTB_USE_SHARK
   RegisterFactory(SharkRandomForestsMachineLearningModelFactory<TInputValue, TOutputValue>::New());
   RegisterFactory(SharkKMeansMachineLearningModelFactory<TInputValue, TOutputValue>::New());
@@ -143,6 +151,16 @@ void MachineLearningModelFactory<TInputValue, TOutputValue>::CleanFactories()
     }
 #endif
 
+#ifdef OTB_USE_ONNXRUNTIME
+    ONNXMachineLearningModelFactory<TInputValue, TOutputValue>* onnxFactory =
+        dynamic_cast<ONNXMachineLearningModelFactory<TInputValue, TOutputValue>*>(*itFac);
+    if (onnxFactory)
+    {
+      itk::ObjectFactoryBase::UnRegisterFactory(onnxFactory);
+      continue;
+    }
+#endif
+
 #ifdef OTB_USE_SHARK
     SharkRandomForestsMachineLearningModelFactory<TInputValue, TOutputValue>* sharkRFFactory =
         dynamic_cast<SharkRandomForestsMachineLearningModelFactory<TInputValue, TOutputValue>*>(*itFac);
@@ -40,14 +40,16 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   typedef std::map<TargetValueType, unsigned int> MapOfLabelsType;
 
   /** Run-time type information (and related methods). */
@@ -179,6 +181,14 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict values for a range of samples at once */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
+  /** Predict values for samples read from a buffer, wrapped in a matrix */
+  void DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                       ConfidenceValueType* quality = nullptr) const override;
+
   void LabelsToMat(const TargetListSampleType* listSample, cv::Mat& output);
 
   /** PrintSelf method */
@@ -188,6 +198,12 @@ private:
   NeuralNetworkMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Predict the samples stored as the rows of a CV_32FC1 matrix */
+  void PredictMat(const cv::Mat& samples, TargetValueType* labels, ConfidenceValueType* quality) const;
+
+  /** Label (or value) and confidence from the response of the output layer */
+  TargetSampleType ResponseToTarget(const float* response, ConfidenceValueType* quality) const;
+
   void CreateNetwork();
   void SetupNetworkAndTrain(cv::Mat& labels);
   cv::Ptr<cv::ml::ANN_MLP> m_ANNModel;
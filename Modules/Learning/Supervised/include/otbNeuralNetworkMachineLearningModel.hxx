@@ -22,6 +22,7 @@
 #define otbNeuralNetworkMachineLearningModel_hxx
 
 #include <fstream>
+#include <vector>
 #include "otbNeuralNetworkMachineLearningModel.h"
 #include "itkMacro.h" // itkExceptionMacro
 
@@ -184,7 +185,6 @@ typename NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::TargetSam
 NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampleType& input, ConfidenceValueType* quality,
                                                                         ProbaSampleType* proba) const
 {
-  TargetSampleType target;
   // convert listsample to Mat
   cv::Mat sample;
 
@@ -193,8 +193,74 @@ NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const In
   cv::Mat response; //(1, 1, CV_32FC1);
   m_ANNModel->predict(sample, response);
 
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  return this->ResponseToTarget(response.ptr<float>(0), quality);
+}
+
+template <class TInputValue, class TOutputValue>
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                  const unsigned int& size, TargetListSampleType* targets,
+                                                                                  ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+  if (size == 0)
+    return;
+
+  // Forward the whole range through the network at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  std::vector<TargetValueType>     labels(size);
+  std::vector<ConfidenceValueType> confidences(quality != nullptr ? size : 0);
+  this->PredictMat(samples, labels.data(), quality != nullptr ? confidences.data() : nullptr);
+
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    TargetSampleType target;
+    target[0] = labels[i];
+    targets->SetMeasurementVector(startIndex + i, target);
+    if (quality != nullptr)
+      quality->SetMeasurementVector(startIndex + i, confidences[i]);
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples,
+                                                                                   unsigned int nbFeatures, std::size_t stride,
+                                                                                   TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  cv::Mat mat;
+  otb::BufferToMat(samples, nbSamples, nbFeatures, stride, mat);
+  this->PredictMat(mat, labels, quality);
+}
+
+template <class TInputValue, class TOutputValue>
+void NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::PredictMat(const cv::Mat& samples, TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  cv::Mat responses;
+  m_ANNModel->predict(samples, responses);
+  for (int i = 0; i < samples.rows; ++i)
+  {
+    labels[i] = this->ResponseToTarget(responses.ptr<float>(i), quality != nullptr ? quality + i : nullptr)[0];
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+typename NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::TargetSampleType
+NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::ResponseToTarget(const float* response, ConfidenceValueType* quality) const
+{
+  TargetSampleType target;
+
   float currentResponse = 0;
-  float maxResponse     = response.at<float>(0, 0);
+  float maxResponse     = response[0];
 
   if (this->m_RegressionMode)
   {
@@ -211,7 +277,7 @@ NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const In
 
   for (unsigned itLabel = 1; itLabel < nbClasses; ++itLabel)
   {
-    currentResponse = response.at<float>(0, itLabel);
+    currentResponse = response[itLabel];
     if (currentResponse > maxResponse)
     {
       secondResponse = maxResponse;
@@ -232,8 +298,6 @@ NeuralNetworkMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const In
   {
     (*quality) = static_cast<ConfidenceValueType>(maxResponse) - static_cast<ConfidenceValueType>(secondResponse);
   }
-  if (proba != nullptr && !this->m_ProbaIndex)
-    itkExceptionMacro("Probability per class not available for this classifier !");
 
   return target;
 }
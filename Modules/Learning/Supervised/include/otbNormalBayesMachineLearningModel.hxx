@@ -22,6 +22,7 @@
 #define otbNormalBayesMachineLearningModel_hxx
 
 #include <fstream>
+#include <vector>
 #include "itkMacro.h"
 #include "otbNormalBayesMachineLearningModel.h"
 #include "otbOpenCVUtils.h"
@@ -83,6 +84,67 @@ NormalBayesMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const Inpu
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void NormalBayesMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                const unsigned int& size, TargetListSampleType* targets,
+                                                                                ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+  if (quality != nullptr && !this->HasConfidenceIndex())
+    itkExceptionMacro("Confidence index not available for this classifier !");
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+  if (size == 0)
+    return;
+
+  // Predict the whole range at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  std::vector<TargetValueType>     labels(size);
+  std::vector<ConfidenceValueType> confidences(quality != nullptr ? size : 0);
+  this->PredictMat(samples, labels.data(), quality != nullptr ? confidences.data() : nullptr);
+
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    TargetSampleType target;
+    target[0] = labels[i];
+    targets->SetMeasurementVector(startIndex + i, target);
+    if (quality != nullptr)
+      quality->SetMeasurementVector(startIndex + i, confidences[i]);
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void NormalBayesMachineLearningModel<TInputValue, TOutputValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples,
+                                                                                 unsigned int nbFeatures, std::size_t stride,
+                                                                                 TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  if (quality != nullptr && !this->HasConfidenceIndex())
+    itkExceptionMacro("Confidence index not available for this classifier !");
+
+  cv::Mat mat;
+  otb::BufferToMat(samples, nbSamples, nbFeatures, stride, mat);
+  this->PredictMat(mat, labels, quality);
+}
+
+template <class TInputValue, class TOutputValue>
+void NormalBayesMachineLearningModel<TInputValue, TOutputValue>::PredictMat(const cv::Mat& samples, TargetValueType* labels,
+                                                                            ConfidenceValueType* itkNotUsed(quality)) const
+{
+  cv::Mat results;
+  m_NormalBayesModel->predict(samples, results);
+  results.convertTo(results, CV_32F);
+  for (int i = 0; i < samples.rows; ++i)
+  {
+    labels[i] = static_cast<TOutputValue>(results.at<float>(i, 0));
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void NormalBayesMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
@@ -0,0 +1,201 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbONNXMachineLearningModel_h
+#define otbONNXMachineLearningModel_h
+
+#include "otbMachineLearningModel.h"
+
+#include <memory>
+#include <string>
+#include <cstdint>
+#include <vector>
+
+namespace Ort
+{
+struct Session;
+}
+
+namespace otb
+{
+
+/** \class ONNXMachineLearningModel
+ * \brief Classification or regression model in the ONNX format, run with
+ * ONNX Runtime
+ *
+ * The model is trained outside of OTB, for instance with a deep learning
+ * framework, and exported to a .onnx file. Its first input is a float
+ * tensor of shape (N, nbFeatures), N being the number of samples of a
+ * batch and nbFeatures the number of components of the samples.
+ *
+ * The outputs are interpreted as follows:
+ * - a first output of shape (N) or (N, 1) holds the labels or the
+ *   regression values. A second float output of shape (N, nbClasses),
+ *   if any, holds the probabilities of the classes: their maximum is
+ *   the confidence, and they are the probabilities of the samples.
+ * - a first float output of shape (N, nbClasses) holds the scores of the
+ *   classes: the label is the index of the highest score, which is the
+ *   confidence, and the scores are the probabilities of the samples.
+ *
+ * Models exported from scikit-learn must be converted without the
+ * ZipMap operator, so that the probabilities are a tensor.
+ *
+ * Convolutional models can take a float tensor of shape (N, C, H, W)
+ * instead: each sample is then a flattened patch of C*H*W features,
+ * channel after channel, as built by PatchInferenceImageFilter. A first
+ * output of 3 dimensions or more, such as (N, C', H, W), is a dense
+ * output: the target of a sample is the whole flattened output of its
+ * patch, which requires a model with variable length targets.
+ *
+ * The samples of DoPredictBatch() and of the buffer batch path of
+ * ImageClassificationFilter are given to ONNX Runtime as a single tensor,
+ * so that a whole line of a streamed region is inferred at once. The
+ * session can be run on a GPU by the CUDA execution provider when
+ * available, and falls back to the CPU otherwise.
+ *
+ * Training and saving are not supported: Save() copies the loaded model.
+ *
+ * \ingroup OTBSupervised
+ */
+template <class TInputValue, class TTargetValue>
+class ITK_EXPORT ONNXMachineLearningModel : public MachineLearningModel<TInputValue, TTargetValue>
+{
+public:
+  /** Standard class typedefs. */
+  typedef ONNXMachineLearningModel                        Self;
+  typedef MachineLearningModel<TInputValue, TTargetValue> Superclass;
+  typedef itk::SmartPointer<Self>                         Pointer;
+  typedef itk::SmartPointer<const Self>                   ConstPointer;
+
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
+
+  /** Run-time type information (and related methods). */
+  itkNewMacro(Self);
+  itkTypeMacro(ONNXMachineLearningModel, MachineLearningModel);
+
+  /** Run the model on a GPU with the CUDA execution provider, if
+   * available. Must be set before Load(). Default is false */
+  itkGetMacro(UseGPU, bool);
+  itkSetMacro(UseGPU, bool);
+  itkBooleanMacro(UseGPU);
+
+  /** Device used by the CUDA execution provider, 0 by default */
+  itkGetMacro(GPUDeviceId, int);
+  itkSetMacro(GPUDeviceId, int);
+
+  /** Number of threads of ONNX Runtime for each inference. Must be set
+   * before Load(). The default is 1, since the batches are usually
+   * inferred by the threads of the streaming filters */
+  itkGetMacro(NumberOfThreads, unsigned int);
+  itkSetMacro(NumberOfThreads, unsigned int);
+
+  /** Training is not supported: throws an exception */
+  void Train() override;
+
+  /** Copy the loaded model file */
+  void Save(const std::string& filename, const std::string& name = "") override;
+
+  /** Load the model from file */
+  void Load(const std::string& filename, const std::string& name = "") override;
+
+  /**\name Classification model file compatibility tests */
+  //@{
+  /** Is the input model file readable and compatible with the corresponding classifier ? */
+  bool CanReadFile(const std::string&) override;
+
+  /** Is the input model file writable and compatible with the corresponding classifier ? */
+  bool CanWriteFile(const std::string&) override;
+  //@}
+
+protected:
+  /** Constructor */
+  ONNXMachineLearningModel();
+
+  /** Destructor */
+  ~ONNXMachineLearningModel() override;
+
+  /** Predict values using the model */
+  TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
+
+  /** Predict values for a range of samples at once */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
+  /** Predict values for samples read from a buffer */
+  void DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                       ConfidenceValueType* quality = nullptr) const override;
+
+  /** PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ONNXMachineLearningModel(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Run the model on nbSamples samples stored as the rows of a float
+   * matrix. The probabilities are stored as nbSamples rows of
+   * m_NumberOfClasses values */
+  void Run(std::vector<float>& samples, unsigned int nbSamples, unsigned int nbFeatures, TargetValueType* labels, ConfidenceValueType* quality,
+           std::vector<float>* probas, std::vector<float>* dense = nullptr) const;
+
+  std::unique_ptr<Ort::Session> m_Session;
+
+  std::string              m_FileName;
+  std::string              m_InputName;
+  std::vector<std::string> m_OutputNames;
+
+  /** Number of features expected by the model, 0 if dynamic */
+  long m_NumberOfFeatures;
+
+  /** Shape (C, H, W) of the patches of a model taking 4 dimensional
+   * inputs, empty otherwise */
+  std::vector<int64_t> m_PatchShape;
+
+  /** True if the first output has 3 dimensions or more */
+  bool m_OutputIsDense;
+
+  /** Number of classes of the scores or probabilities output, 0 if none */
+  long m_NumberOfClasses;
+
+  /** True if the first output holds the scores of the classes */
+  bool m_OutputIsScores;
+
+  bool         m_UseGPU;
+  int          m_GPUDeviceId;
+  unsigned int m_NumberOfThreads;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbONNXMachineLearningModel.hxx"
+#endif
+
+#endif
@@ -0,0 +1,458 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbONNXMachineLearningModel_hxx
+#define otbONNXMachineLearningModel_hxx
+
+#include "otbONNXMachineLearningModel.h"
+#include "otbMacro.h"
+#include "itksys/SystemTools.hxx"
+
+#include <onnxruntime_cxx_api.h>
+
+#include <algorithm>
+#include <fstream>
+
+namespace otb
+{
+
+namespace onnx_details
+{
+/** The ONNX Runtime environment, shared by all the sessions */
+inline Ort::Env& GetEnvironment()
+{
+  static Ort::Env env(ORT_LOGGING_LEVEL_WARNING, "OTB");
+  return env;
+}
+
+/** Store the values of a sample in its target: all of them in a
+ * variable length target, the first one in a scalar target */
+template <class T, class V>
+void AssignTarget(itk::VariableLengthVector<T>& target, const V* values, std::size_t size)
+{
+  target.SetSize(size);
+  for (std::size_t k = 0; k < size; ++k)
+    target[k] = static_cast<T>(values[k]);
+}
+
+template <class T, unsigned int N, class V>
+void AssignTarget(itk::FixedArray<T, N>& target, const V* values, std::size_t itkNotUsed(size))
+{
+  target[0] = static_cast<T>(values[0]);
+}
+}
+
+template <class TInputValue, class TTargetValue>
+ONNXMachineLearningModel<TInputValue, TTargetValue>::ONNXMachineLearningModel()
+  : m_NumberOfFeatures(0), m_OutputIsDense(false), m_NumberOfClasses(0), m_OutputIsScores(false), m_UseGPU(false), m_GPUDeviceId(0), m_NumberOfThreads(1)
+{
+  this->m_IsRegressionSupported = true;
+  // Sessions can be run concurrently: the list sample batches are split
+  // between the OpenMP threads
+  this->m_IsDoPredictBatchMultiThreaded = false;
+}
+
+template <class TInputValue, class TTargetValue>
+ONNXMachineLearningModel<TInputValue, TTargetValue>::~ONNXMachineLearningModel() = default;
+
+template <class TInputValue, class TTargetValue>
+void ONNXMachineLearningModel<TInputValue, TTargetValue>::Train()
+{
+  itkExceptionMacro(<< "ONNX models are trained outside of OTB");
+}
+
+template <class TInputValue, class TTargetValue>
+void ONNXMachineLearningModel<TInputValue, TTargetValue>::Save(const std::string& filename, const std::string& itkNotUsed(name))
+{
+  if (m_FileName.empty())
+  {
+    itkExceptionMacro(<< "No ONNX model loaded, nothing to save");
+  }
+  if (!itksys::SystemTools::CopyFileAlways(m_FileName, filename))
+  {
+    itkExceptionMacro(<< "Could not copy " << m_FileName << " to " << filename);
+  }
+}
+
+template <class TInputValue, class TTargetValue>
+void ONNXMachineLearningModel<TInputValue, TTargetValue>::Load(const std::string& filename, const std::string& itkNotUsed(name))
+{
+  Ort::SessionOptions options;
+  options.SetIntraOpNumThreads(std::max(1u, m_NumberOfThreads));
+  options.SetGraphOptimizationLevel(GraphOptimizationLevel::ORT_ENABLE_ALL);
+  if (m_UseGPU)
+  {
+    try
+    {
+      OrtCUDAProviderOptions cudaOptions{};
+      cudaOptions.device_id = m_GPUDeviceId;
+      options.AppendExecutionProvider_CUDA(cudaOptions);
+    }
+    catch (Ort::Exception& e)
+    {
+      otbLogMacro(Warning, << "The CUDA execution provider is not available, the model is run on the CPU: " << e.what());
+    }
+  }
+
+  try
+  {
+#ifdef _WIN32
+    const std::wstring path(filename.begin(), filename.end());
+    m_Session.reset(new Ort::Session(onnx_details::GetEnvironment(), path.c_str(), options));
+#else
+    m_Session.reset(new Ort::Session(onnx_details::GetEnvironment(), filename.c_str(), options));
+#endif
+  }
+  catch (Ort::Exception& e)
+  {
+    m_Session.reset();
+    itkExceptionMacro(<< "Could not load ONNX model " << filename << ": " << e.what());
+  }
+
+  Ort::AllocatorWithDefaultOptions allocator;
+  if (m_Session->GetInputCount() != 1)
+  {
+    itkExceptionMacro(<< "ONNX model " << filename << " has " << m_Session->GetInputCount() << " inputs, only models with one input are supported");
+  }
+  m_InputName = m_Session->GetInputNameAllocated(0, allocator).get();
+
+  const Ort::TypeInfo        inputInfo  = m_Session->GetInputTypeInfo(0);
+  const std::vector<int64_t> inputShape = inputInfo.GetTensorTypeAndShapeInfo().GetShape();
+  if (inputInfo.GetONNXType() != ONNX_TYPE_TENSOR || inputInfo.GetTensorTypeAndShapeInfo().GetElementType() != ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT ||
+      (inputShape.size() != 2 && inputShape.size() != 4))
+  {
+    itkExceptionMacro(<< "The input of ONNX model " << filename << " must be a float tensor of shape (N, nbFeatures) or (N, C, H, W)");
+  }
+  m_PatchShape.clear();
+  if (inputShape.size() == 4)
+  {
+    if (inputShape[1] <= 0 || inputShape[2] <= 0 || inputShape[3] <= 0)
+    {
+      itkExceptionMacro(<< "The C, H and W dimensions of the input of ONNX model " << filename << " must be fixed");
+    }
+    m_PatchShape.assign(inputShape.begin() + 1, inputShape.end());
+    m_NumberOfFeatures = inputShape[1] * inputShape[2] * inputShape[3];
+  }
+  else
+  {
+    m_NumberOfFeatures = std::max<int64_t>(0, inputShape[1]);
+  }
+
+  // Interpretation of the outputs
+  m_OutputNames.clear();
+  m_NumberOfClasses = 0;
+  m_OutputIsScores  = false;
+  m_OutputIsDense   = false;
+  for (size_t i = 0; i < std::min<size_t>(m_Session->GetOutputCount(), 2); ++i)
+  {
+    const Ort::TypeInfo outputInfo = m_Session->GetOutputTypeInfo(i);
+    if (outputInfo.GetONNXType() != ONNX_TYPE_TENSOR)
+    {
+      if (i == 0)
+      {
+        itkExceptionMacro(<< "The first output of ONNX model " << filename << " is not a tensor");
+      }
+      otbLogMacro(Warning, << "The second output of ONNX model " << filename << " is not a tensor and is ignored");
+      break;
+    }
+    const std::vector<int64_t> shape  = outputInfo.GetTensorTypeAndShapeInfo().GetShape();
+    const bool                 isFloat = outputInfo.GetTensorTypeAndShapeInfo().GetElementType() == ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT;
+    const long                 width   = shape.size() > 1 ? shape[1] : 1;
+    if (i == 0 && shape.size() > 2)
+    {
+      // Dense output of the patches
+      m_OutputIsDense = true;
+      m_OutputNames.push_back(m_Session->GetOutputNameAllocated(i, allocator).get());
+      break;
+    }
+    if (shape.size() > 2 || (width != 1 && !isFloat))
+    {
+      itkExceptionMacro(<< "Output " << i << " of ONNX model " << filename << " must be of shape (N), (N, 1) or (N, nbClasses)");
+    }
+    if (i == 0)
+    {
+      m_OutputIsScores  = (width != 1);
+      m_NumberOfClasses = m_OutputIsScores ? width : 0;
+      m_OutputNames.push_back(m_Session->GetOutputNameAllocated(i, allocator).get());
+      if (m_OutputIsScores)
+        break;
+    }
+    else if (isFloat && width > 1)
+    {
+      m_NumberOfClasses = width;
+      m_OutputNames.push_back(m_Session->GetOutputNameAllocated(i, allocator).get());
+    }
+  }
+
+  this->m_ConfidenceIndex = (m_NumberOfClasses > 0);
+  this->m_ProbaIndex      = (m_NumberOfClasses > 0);
+  m_FileName              = filename;
+}
+
+template <class TInputValue, class TTargetValue>
+bool ONNXMachineLearningModel<TInputValue, TTargetValue>::CanReadFile(const std::string& file)
+{
+  if (itksys::SystemTools::LowerCase(itksys::SystemTools::GetFilenameLastExtension(file)) != ".onnx")
+  {
+    return false;
+  }
+  try
+  {
+    this->Load(file);
+  }
+  catch (...)
+  {
+    return false;
+  }
+  return true;
+}
+
+template <class TInputValue, class TTargetValue>
+bool ONNXMachineLearningModel<TInputValue, TTargetValue>::CanWriteFile(const std::string& itkNotUsed(file))
+{
+  return false;
+}
+
+template <class TInputValue, class TTargetValue>
+void ONNXMachineLearningModel<TInputValue, TTargetValue>::Run(std::vector<float>& samples, unsigned int nbSamples, unsigned int nbFeatures,
+                                                              TargetValueType* labels, ConfidenceValueType* quality, std::vector<float>* probas,
+                                                              std::vector<float>* dense) const
+{
+  if (!m_Session)
+  {
+    itkExceptionMacro(<< "No ONNX model loaded");
+  }
+  if (m_NumberOfFeatures != 0 && m_NumberOfFeatures != static_cast<long>(nbFeatures))
+  {
+    itkExceptionMacro(<< "The ONNX model expects " << m_NumberOfFeatures << " features, the samples have " << nbFeatures);
+  }
+  if (nbSamples == 0)
+  {
+    return;
+  }
+
+  const Ort::MemoryInfo      memoryInfo = Ort::MemoryInfo::CreateCpu(OrtArenaAllocator, OrtMemTypeDefault);
+  std::vector<int64_t> shape{nbSamples, nbFeatures};
+  if (!m_PatchShape.empty())
+  {
+    shape.resize(1);
+    shape.insert(shape.end(), m_PatchShape.begin(), m_PatchShape.end());
+  }
+  Ort::Value                 input = Ort::Value::CreateTensor<float>(memoryInfo, samples.data(), samples.size(), shape.data(), shape.size());
+
+  const char*              inputName = m_InputName.c_str();
+  std::vector<const char*> outputNames;
+  for (const auto& name : m_OutputNames)
+  {
+    outputNames.push_back(name.c_str());
+  }
+
+  std::vector<Ort::Value> outputs;
+  try
+  {
+    outputs = m_Session->Run(Ort::RunOptions{nullptr}, &inputName, &input, 1, outputNames.data(), outputNames.size());
+  }
+  catch (Ort::Exception& e)
+  {
+    itkExceptionMacro(<< "Inference of ONNX model " << m_FileName << " failed: " << e.what());
+  }
+
+  if (m_OutputIsDense)
+  {
+    // Whole flattened output of each patch
+    const std::size_t size = outputs.front().GetTensorTypeAndShapeInfo().GetElementCount();
+    const float*      data = outputs.front().GetTensorData<float>();
+    for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+      labels[i] = static_cast<TargetValueType>(data[i * (size / nbSamples)]);
+      if (quality != nullptr)
+        quality[i] = ConfidenceValueType(0);
+    }
+    if (dense != nullptr)
+    {
+      dense->assign(data, data + size);
+    }
+    return;
+  }
+
+  // Scores or probabilities of the classes
+  const float* scores = nullptr;
+  if (m_NumberOfClasses > 0)
+  {
+    scores = outputs.back().GetTensorData<float>();
+    if (probas != nullptr)
+    {
+      probas->assign(scores, scores + nbSamples * m_NumberOfClasses);
+    }
+  }
+
+  if (m_OutputIsScores)
+  {
+    for (unsigned int i = 0; i < nbSamples; ++i)
+    {
+      const float* row  = scores + i * m_NumberOfClasses;
+      const float* best = std::max_element(row, row + m_NumberOfClasses);
+      labels[i]         = static_cast<TargetValueType>(best - row);
+      if (quality != nullptr)
+        quality[i] = static_cast<ConfidenceValueType>(*best);
+    }
+    return;
+  }
+
+  const Ort::Value& values = outputs.front();
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    switch (values.GetTensorTypeAndShapeInfo().GetElementType())
+    {
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT64:
+      labels[i] = static_cast<TargetValueType>(values.GetTensorData<int64_t>()[i]);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_INT32:
+      labels[i] = static_cast<TargetValueType>(values.GetTensorData<int32_t>()[i]);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_DOUBLE:
+      labels[i] = static_cast<TargetValueType>(values.GetTensorData<double>()[i]);
+      break;
+    case ONNX_TENSOR_ELEMENT_DATA_TYPE_FLOAT:
+      labels[i] = static_cast<TargetValueType>(values.GetTensorData<float>()[i]);
+      break;
+    default:
+      itkExceptionMacro(<< "Unsupported element type of the first output of ONNX model " << m_FileName);
+    }
+    if (quality != nullptr)
+    {
+      quality[i] = scores != nullptr ? static_cast<ConfidenceValueType>(*std::max_element(scores + i * m_NumberOfClasses, scores + (i + 1) * m_NumberOfClasses))
+                                     : ConfidenceValueType(0);
+    }
+  }
+}
+
+template <class TInputValue, class TTargetValue>
+typename ONNXMachineLearningModel<TInputValue, TTargetValue>::TargetSampleType
+ONNXMachineLearningModel<TInputValue, TTargetValue>::DoPredict(const InputSampleType& input, ConfidenceValueType* quality, ProbaSampleType* proba) const
+{
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  std::vector<float> sample(input.Size());
+  for (unsigned int j = 0; j < input.Size(); ++j)
+  {
+    sample[j] = static_cast<float>(input[j]);
+  }
+
+  TargetValueType    label;
+  std::vector<float> probas, dense;
+  this->Run(sample, 1, input.Size(), &label, quality, proba != nullptr ? &probas : nullptr, &dense);
+
+  if (proba != nullptr)
+  {
+    proba->SetSize(m_NumberOfClasses);
+    for (long k = 0; k < m_NumberOfClasses; ++k)
+      (*proba)[k] = probas[k];
+  }
+  TargetSampleType target;
+  if (m_OutputIsDense)
+    onnx_details::AssignTarget(target, dense.data(), dense.size());
+  else
+    onnx_details::AssignTarget(target, &label, 1);
+  return target;
+}
+
+template <class TInputValue, class TTargetValue>
+void ONNXMachineLearningModel<TInputValue, TTargetValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                         const unsigned int& size, TargetListSampleType* targets,
+                                                                         ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+  if (size == 0)
+    return;
+
+  // Infer the whole range at once
+  const unsigned int nbFeatures = input->GetMeasurementVectorSize();
+  std::vector<float> samples(static_cast<std::size_t>(size) * nbFeatures);
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    const InputSampleType& sample = input->GetMeasurementVector(startIndex + i);
+    for (unsigned int j = 0; j < nbFeatures; ++j)
+    {
+      samples[i * nbFeatures + j] = static_cast<float>(sample[j]);
+    }
+  }
+
+  std::vector<TargetValueType>     labels(size);
+  std::vector<ConfidenceValueType> confidences(quality != nullptr ? size : 0);
+  std::vector<float>               probas, dense;
+  this->Run(samples, size, nbFeatures, labels.data(), quality != nullptr ? confidences.data() : nullptr, proba != nullptr ? &probas : nullptr, &dense);
+
+  const std::size_t denseSize = dense.size() / size;
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    TargetSampleType target;
+    if (m_OutputIsDense)
+      onnx_details::AssignTarget(target, dense.data() + i * denseSize, denseSize);
+    else
+      onnx_details::AssignTarget(target, &labels[i], 1);
+    targets->SetMeasurementVector(startIndex + i, target);
+    if (quality != nullptr)
+      quality->SetMeasurementVector(startIndex + i, confidences[i]);
+    if (proba != nullptr)
+    {
+      ProbaSampleType sampleProba(m_NumberOfClasses);
+      for (long k = 0; k < m_NumberOfClasses; ++k)
+        sampleProba[k] = probas[i * m_NumberOfClasses + k];
+      proba->SetMeasurementVector(startIndex + i, sampleProba);
+    }
+  }
+}
+
+template <class TInputValue, class TTargetValue>
+void ONNXMachineLearningModel<TInputValue, TTargetValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures,
+                                                                          std::size_t stride, TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  std::vector<float> matrix(static_cast<std::size_t>(nbSamples) * nbFeatures);
+  for (unsigned int i = 0; i < nbSamples; ++i)
+  {
+    std::transform(samples + i * stride, samples + i * stride + nbFeatures, matrix.begin() + i * nbFeatures,
+                   [](InputValueType value) { return static_cast<float>(value); });
+  }
+  this->Run(matrix, nbSamples, nbFeatures, labels, quality, nullptr);
+}
+
+template <class TInputValue, class TTargetValue>
+void ONNXMachineLearningModel<TInputValue, TTargetValue>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  // Call superclass implementation
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FileName: " << m_FileName << std::endl;
+  os << indent << "NumberOfFeatures: " << m_NumberOfFeatures << std::endl;
+  os << indent << "NumberOfClasses: " << m_NumberOfClasses << std::endl;
+  os << indent << "UseGPU: " << m_UseGPU << std::endl;
+}
+
+} // end namespace otb
+
+#endif
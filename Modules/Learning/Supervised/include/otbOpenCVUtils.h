@@ -119,6 +119,51 @@ void ListSampleToMat(const T* listSample, cv::Mat& output)
   }
 }
 
+/** Converts the samples [startIndex, startIndex + size[ of a ListSample of
+ *  VariableLengthVector to a contiguous CV_32FC1 matrix, one sample per
+ *  row. The output matrix is only reallocated if its size or type differ.
+ */
+template <class T>
+void ListSampleRangeToMat(const T* listSample, unsigned int startIndex, unsigned int size, cv::Mat& output)
+{
+  const unsigned int sampleSize = listSample->GetMeasurementVectorSize();
+  output.create(size, sampleSize, CV_32FC1);
+
+  for (unsigned int sampleIdx = 0; sampleIdx < size; ++sampleIdx)
+  {
+    const typename T::MeasurementVectorType& sample = listSample->GetMeasurementVector(startIndex + sampleIdx);
+    float*                                   row    = output.ptr<float>(sampleIdx);
+    for (unsigned int i = 0; i < sampleSize; ++i)
+    {
+      row[i] = sample[i];
+    }
+  }
+}
+
+/** Converts a buffer of samples to a CV_32FC1 matrix, one sample per row.
+ *  Sample i is made of the nbFeatures values starting at buffer + i * stride.
+ */
+template <class T>
+void BufferToMat(const T* buffer, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, cv::Mat& output)
+{
+  output.create(nbSamples, nbFeatures, CV_32FC1);
+  for (unsigned int sampleIdx = 0; sampleIdx < nbSamples; ++sampleIdx)
+  {
+    const T* sample = buffer + sampleIdx * stride;
+    float*   row    = output.ptr<float>(sampleIdx);
+    for (unsigned int i = 0; i < nbFeatures; ++i)
+    {
+      row[i] = sample[i];
+    }
+  }
+}
+
+/** Float buffers are wrapped without any copy */
+inline void BufferToMat(const float* buffer, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, cv::Mat& output)
+{
+  output = cv::Mat(nbSamples, nbFeatures, CV_32FC1, const_cast<float*>(buffer), stride * sizeof(float));
+}
+
 template <typename T>
 void ListSampleToMat(typename T::Pointer listSample, cv::Mat& output)
 {
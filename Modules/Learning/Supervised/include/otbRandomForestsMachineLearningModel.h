@@ -28,6 +28,7 @@
 #include "otbMachineLearningModel.h"
 #include "itkVariableSizeMatrix.h"
 #include "otbCvRTreesWrapper.h"
+#include "otbFlatRandomForest.h"
 
 namespace otb
 {
@@ -42,14 +43,16 @@ public:
   typedef itk::SmartPointer<Self>       Pointer;
   typedef itk::SmartPointer<const Self> ConstPointer;
 
-  typedef typename Superclass::InputValueType       InputValueType;
-  typedef typename Superclass::InputSampleType      InputSampleType;
-  typedef typename Superclass::InputListSampleType  InputListSampleType;
-  typedef typename Superclass::TargetValueType      TargetValueType;
-  typedef typename Superclass::TargetSampleType     TargetSampleType;
-  typedef typename Superclass::TargetListSampleType TargetListSampleType;
-  typedef typename Superclass::ConfidenceValueType  ConfidenceValueType;
-  typedef typename Superclass::ProbaSampleType      ProbaSampleType;
+  typedef typename Superclass::InputValueType           InputValueType;
+  typedef typename Superclass::InputSampleType          InputSampleType;
+  typedef typename Superclass::InputListSampleType      InputListSampleType;
+  typedef typename Superclass::TargetValueType          TargetValueType;
+  typedef typename Superclass::TargetSampleType         TargetSampleType;
+  typedef typename Superclass::TargetListSampleType     TargetListSampleType;
+  typedef typename Superclass::ConfidenceValueType      ConfidenceValueType;
+  typedef typename Superclass::ProbaSampleType          ProbaSampleType;
+  typedef typename Superclass::ConfidenceListSampleType ConfidenceListSampleType;
+  typedef typename Superclass::ProbaListSampleType      ProbaListSampleType;
   // Other
   typedef itk::VariableSizeMatrix<float> VariableImportanceMatrixType;
 
@@ -64,10 +67,11 @@ public:
   /** Train the machine learning model */
   void Train() override;
 
-  /** Save the model to file */
+  /** Save the model to file, in the binary format of FlatRandomForest if
+   * BinaryModel is on (classification forests only) */
   void Save(const std::string& filename, const std::string& name = "") override;
 
-  /** Load the model from file */
+  /** Load the model from file, either an OpenCV model or a binary one */
   void Load(const std::string& filename, const std::string& name = "") override;
 
   /**\name Classification model file compatibility tests */
@@ -123,6 +127,24 @@ public:
   itkGetMacro(ComputeMargin, bool);
   itkSetMacro(ComputeMargin, bool);
 
+  /** Stop evaluating the trees for a sample once its label is decided.
+   * Labels are unchanged, but the confidence (or margin) is then computed
+   * on the trees evaluated so far. Only used with the flattened forest. */
+  itkGetMacro(EarlyTermination, bool);
+  itkSetMacro(EarlyTermination, bool);
+  itkBooleanMacro(EarlyTermination);
+
+  /** Save the model in the compact binary format: much faster to load, but
+   * only usable for classification */
+  itkGetMacro(BinaryModel, bool);
+  itkSetMacro(BinaryModel, bool);
+  itkBooleanMacro(BinaryModel);
+
+  /** Store the thresholds of a binary model as half precision floats */
+  itkGetMacro(HalfPrecisionThresholds, bool);
+  itkSetMacro(HalfPrecisionThresholds, bool);
+  itkBooleanMacro(HalfPrecisionThresholds);
+
   /** Returns a matrix containing variable importance */
   VariableImportanceMatrixType GetVariableImportance();
 
@@ -138,6 +160,16 @@ protected:
   /** Predict values using the model */
   TargetSampleType DoPredict(const InputSampleType& input, ConfidenceValueType* quality = nullptr, ProbaSampleType* proba = nullptr) const override;
 
+  /** Predict values by blocks of samples, with the flattened forest when
+   * available */
+  void DoPredictBatch(const InputListSampleType*, const unsigned int& startIndex, const unsigned int& size, TargetListSampleType*,
+                      ConfidenceListSampleType* = nullptr, ProbaListSampleType* = nullptr) const override;
+
+  /** Predict values for samples read from a buffer, with the flattened
+   * forest when available */
+  void DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples, unsigned int nbFeatures, std::size_t stride, TargetValueType* labels,
+                       ConfidenceValueType* quality = nullptr) const override;
+
   /** PrintSelf method */
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
@@ -151,7 +183,18 @@ private:
   RandomForestsMachineLearningModel(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Label and confidence (or margin) from the votes of nbVotingTrees
+   * trees of the flat forest */
+  TargetSampleType VotesToTarget(const unsigned int* votes, unsigned int nbVotingTrees, ConfidenceValueType* quality) const;
+
+  /** Votes of the flat forest for a block of samples, with or without early
+   * termination */
+  void VoteBlock(const float* samples, std::size_t nbSamples, std::size_t stride, unsigned int* votes, unsigned int* nbVotingTrees) const;
+
   cv::Ptr<CvRTreesWrapper> m_RFModel;
+  /** Flattened copy of m_RFModel used for classification, rebuilt after
+   * Train() and Load() */
+  FlatRandomForest m_FlatForest;
 
   /** The depth of the tree. A low value will likely underfit and conversely a
    * high value will likely overfit. The optimal value can be obtained using cross
@@ -216,6 +259,12 @@ private:
    * 2 most voted classes) instead of confidence (probability of the most
    * voted class) in prediction*/
   bool m_ComputeMargin;
+  /** Whether the vote of a sample stops once its label is decided */
+  bool m_EarlyTermination;
+  /** Whether Save() writes the binary format of the flat forest */
+  bool m_BinaryModel;
+  /** Whether the binary format stores half precision thresholds */
+  bool m_HalfPrecisionThresholds;
 };
 } // end namespace otb
 
@@ -22,6 +22,9 @@
 #define otbRandomForestsMachineLearningModel_hxx
 
 #include <fstream>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
 #include "itkMacro.h"
 #include "otbRandomForestsMachineLearningModel.h"
 #include "otbOpenCVUtils.h"
@@ -43,7 +46,10 @@ RandomForestsMachineLearningModel<TInputValue, TOutputValue>::RandomForestsMachi
     m_MaxNumberOfTrees(100),
     m_ForestAccuracy(0.01),
     m_TerminationCriteria(CV_TERMCRIT_ITER | CV_TERMCRIT_EPS), // identic for v3 ?
-    m_ComputeMargin(false)
+    m_ComputeMargin(false),
+    m_EarlyTermination(false),
+    m_BinaryModel(false),
+    m_HalfPrecisionThresholds(false)
 {
   this->m_ConfidenceIndex       = true;
   this->m_ProbaIndex            = false;
@@ -105,6 +111,7 @@ void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Train()
   m_RFModel->setActiveVarCount(m_MaxNumberOfVariables);
   m_RFModel->setTermCriteria(cv::TermCriteria(m_TerminationCriteria, m_MaxNumberOfTrees, m_ForestAccuracy));
   m_RFModel->train(cv::ml::TrainData::create(samples, cv::ml::ROW_SAMPLE, labels, cv::noArray(), cv::noArray(), cv::noArray(), var_type));
+  m_FlatForest.Build(*m_RFModel);
 }
 
 template <class TInputValue, class TOutputValue>
@@ -117,6 +124,25 @@ RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const In
   // convert listsample to Mat
   cv::Mat sample;
 
+  if (m_FlatForest.IsValid() && value.Size() >= m_FlatForest.GetNumberOfFeatures())
+  {
+    if (proba != nullptr && !this->m_ProbaIndex)
+      itkExceptionMacro("Probability per class not available for this classifier !");
+
+    std::vector<float> flatSample(value.Size());
+    for (unsigned int i = 0; i < value.Size(); ++i)
+      flatSample[i] = static_cast<float>(value[i]);
+
+    std::vector<unsigned int> votes(m_FlatForest.GetNumberOfClasses(), 0);
+    unsigned int              nbVotingTrees = 0;
+    this->VoteBlock(flatSample.data(), 1, flatSample.size(), votes.data(), &nbVotingTrees);
+    return this->VotesToTarget(votes.data(), nbVotingTrees, quality);
+  }
+
+  // Models loaded from the binary format only have the flat forest
+  if (!m_RFModel->isTrained())
+    itkExceptionMacro("Sample has " << value.Size() << " features, the binary model expects " << m_FlatForest.GetNumberOfFeatures());
+
   otb::SampleToMat<InputSampleType>(value, sample);
 
   double result = m_RFModel->predict(sample);
@@ -137,9 +163,175 @@ RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const In
   return target[0];
 }
 
+template <class TInputValue, class TOutputValue>
+typename RandomForestsMachineLearningModel<TInputValue, TOutputValue>::TargetSampleType
+RandomForestsMachineLearningModel<TInputValue, TOutputValue>::VotesToTarget(const unsigned int* votes, unsigned int nbVotingTrees,
+                                                                            ConfidenceValueType* quality) const
+{
+  const unsigned int nbClasses = m_FlatForest.GetNumberOfClasses();
+  const unsigned int nbTrees   = std::max(nbVotingTrees, 1u);
+  const unsigned int best      = m_FlatForest.GetMostVotedClass(votes);
+
+  TargetSampleType target;
+  target[0] = static_cast<TOutputValue>(m_FlatForest.GetClassLabel(best));
+
+  if (quality != nullptr)
+  {
+    if (m_ComputeMargin)
+    {
+      // Votes of the second most voted class
+      unsigned int second = 0;
+      for (unsigned int c = 0; c < nbClasses; ++c)
+      {
+        if (c != best)
+          second = std::max(second, votes[c]);
+      }
+      (*quality) = static_cast<float>(votes[best] - second) / nbTrees;
+    }
+    else
+    {
+      (*quality) = static_cast<float>(votes[best]) / nbTrees;
+    }
+  }
+  return target;
+}
+
+template <class TInputValue, class TOutputValue>
+void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::VoteBlock(const float* samples, std::size_t nbSamples, std::size_t stride,
+                                                                             unsigned int* votes, unsigned int* nbVotingTrees) const
+{
+  if (m_EarlyTermination)
+  {
+    m_FlatForest.VoteUntilDecided(samples, nbSamples, stride, votes, nbVotingTrees);
+  }
+  else
+  {
+    m_FlatForest.Vote(samples, nbSamples, stride, votes);
+    std::fill(nbVotingTrees, nbVotingTrees + nbSamples, m_FlatForest.GetNumberOfTrees());
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                                  const unsigned int& size, TargetListSampleType* targets,
+                                                                                  ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (!m_FlatForest.IsValid() || input->GetMeasurementVectorSize() < m_FlatForest.GetNumberOfFeatures())
+  {
+    Superclass::DoPredictBatch(input, startIndex, size, targets, quality, proba);
+    return;
+  }
+
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+
+  // Samples go through the forest by blocks: each tree is applied to the
+  // whole block before moving to the next one
+  const unsigned int blockSize  = 256;
+  const unsigned int nbFeatures = input->GetMeasurementVectorSize();
+  const unsigned int nbClasses  = m_FlatForest.GetNumberOfClasses();
+
+  std::vector<float>        block(blockSize * nbFeatures);
+  std::vector<unsigned int> votes(blockSize * nbClasses);
+  std::vector<unsigned int> nbVotingTrees(blockSize);
+
+  for (unsigned int blockStart = startIndex; blockStart < startIndex + size; blockStart += blockSize)
+  {
+    const unsigned int nbSamples = std::min(blockSize, startIndex + size - blockStart);
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      const InputSampleType& sample = input->GetMeasurementVector(blockStart + s);
+      float*                 dest   = block.data() + s * nbFeatures;
+      for (unsigned int i = 0; i < nbFeatures; ++i)
+        dest[i] = static_cast<float>(sample[i]);
+    }
+
+    std::fill(votes.begin(), votes.end(), 0);
+    this->VoteBlock(block.data(), nbSamples, nbFeatures, votes.data(), nbVotingTrees.data());
+
+    for (unsigned int s = 0; s < nbSamples; ++s)
+    {
+      ConfidenceValueType    confidence = 0;
+      const TargetSampleType target =
+          this->VotesToTarget(votes.data() + s * nbClasses, nbVotingTrees[s], quality != nullptr ? &confidence : nullptr);
+      targets->SetMeasurementVector(blockStart + s, target);
+      if (quality != nullptr)
+        quality->SetMeasurementVector(blockStart + s, confidence);
+    }
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples,
+                                                                                   unsigned int nbFeatures, std::size_t stride,
+                                                                                   TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  if (!m_FlatForest.IsValid() || nbFeatures < m_FlatForest.GetNumberOfFeatures())
+  {
+    Superclass::DoPredictBuffer(samples, nbSamples, nbFeatures, stride, labels, quality);
+    return;
+  }
+
+  // Float samples are read in place, other types are converted block by block
+  const bool         inPlace    = std::is_same<InputValueType, float>::value;
+  const unsigned int blockSize = 256;
+  const unsigned int nbClasses = m_FlatForest.GetNumberOfClasses();
+
+  std::vector<float>        block(inPlace ? 0 : blockSize * nbFeatures);
+  std::vector<unsigned int> votes(blockSize * nbClasses);
+  std::vector<unsigned int> nbVotingTrees(blockSize);
+
+  for (unsigned int blockStart = 0; blockStart < nbSamples; blockStart += blockSize)
+  {
+    const unsigned int    nbBlockSamples = std::min(blockSize, nbSamples - blockStart);
+    const InputValueType* blockSamples   = samples + blockStart * stride;
+
+    if (inPlace)
+    {
+      std::fill(votes.begin(), votes.end(), 0);
+      this->VoteBlock(reinterpret_cast<const float*>(blockSamples), nbBlockSamples, stride, votes.data(), nbVotingTrees.data());
+    }
+    else
+    {
+      for (unsigned int s = 0; s < nbBlockSamples; ++s)
+      {
+        const InputValueType* sample = blockSamples + s * stride;
+        float*                dest   = block.data() + s * nbFeatures;
+        for (unsigned int i = 0; i < nbFeatures; ++i)
+          dest[i] = static_cast<float>(sample[i]);
+      }
+      std::fill(votes.begin(), votes.end(), 0);
+      this->VoteBlock(block.data(), nbBlockSamples, nbFeatures, votes.data(), nbVotingTrees.data());
+    }
+
+    for (unsigned int s = 0; s < nbBlockSamples; ++s)
+    {
+      const unsigned int id = blockStart + s;
+      labels[id] = this->VotesToTarget(votes.data() + s * nbClasses, nbVotingTrees[s], quality != nullptr ? quality + id : nullptr)[0];
+    }
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
+  if (m_BinaryModel)
+  {
+    if (!m_FlatForest.IsValid())
+      itkExceptionMacro("Only classification forests on numerical features can be saved in binary format");
+
+    std::ofstream ofs(filename, std::ios::out | std::ios::binary);
+    if (!m_FlatForest.Write(ofs, m_HalfPrecisionThresholds))
+      itkExceptionMacro("Could not write binary model file " << filename);
+    return;
+  }
+
   cv::FileStorage fs(filename, cv::FileStorage::WRITE);
   fs << (name.empty() ? m_RFModel->getDefaultName() : cv::String(name)) << "{";
   m_RFModel->write(fs);
@@ -150,15 +342,27 @@ void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Save(const st
 template <class TInputValue, class TOutputValue>
 void RandomForestsMachineLearningModel<TInputValue, TOutputValue>::Load(const std::string& filename, const std::string& name)
 {
+  std::ifstream ifs(filename, std::ios::in | std::ios::binary);
+  if (ifs && FlatRandomForest::CanRead(ifs))
+  {
+    // The OpenCV model is not available anymore
+    m_RFModel = CvRTreesWrapper::create();
+    if (!m_FlatForest.Read(ifs))
+      itkExceptionMacro("Invalid binary model file " << filename);
+    return;
+  }
+  ifs.close();
+
   cv::FileStorage fs(filename, cv::FileStorage::READ);
   m_RFModel->read(name.empty() ? fs.getFirstTopLevelNode() : fs[name]);
+  m_FlatForest.Build(*m_RFModel);
 }
 
 template <class TInputValue, class TOutputValue>
 bool RandomForestsMachineLearningModel<TInputValue, TOutputValue>::CanReadFile(const std::string& file)
 {
   std::ifstream ifs;
-  ifs.open(file);
+  ifs.open(file, std::ios::in | std::ios::binary);
 
   if (!ifs)
   {
@@ -166,6 +370,8 @@ bool RandomForestsMachineLearningModel<TInputValue, TOutputValue>::CanReadFile(c
     return false;
   }
 
+  if (FlatRandomForest::CanRead(ifs))
+    return true;
 
   while (!ifs.eof())
   {
@@ -42,6 +42,9 @@ namespace otb
  *
  * Please note that this function is only defined on \f$ R_{+}^{*} \f$.
  *
+ * GetValue() does not modify the model and can be called from several
+ * threads at once.
+ *
  * The GetDerivative() uses the GetValue() function to
  * compute the partial derivatives. as such, it can be quite intensive.
  *
@@ -49,10 +49,11 @@ typename SVMCrossValidationCostFunction<TModel>::MeasureType SVMCrossValidationC
     return 0;
   }
 
-  // Updates vm_parameters according to current parameters
-  this->UpdateParameters(parameters);
-
-  return m_Model->CrossValidation();
+  // The model is not modified, so that the parameters can be evaluated
+  // concurrently
+  const unsigned int nbParams = m_Model->GetNumberOfKernelParameters();
+  return m_Model->CrossValidation(parameters[0], nbParams > 1 ? parameters[1] : m_Model->GetKernelGamma(),
+                                  nbParams > 2 ? parameters[2] : m_Model->GetKernelCoef0());
 }
 
 template <class TModel>
@@ -22,6 +22,7 @@
 #define otbSVMMachineLearningModel_hxx
 
 #include <fstream>
+#include <vector>
 #include "itkMacro.h"
 #include "otbSVMMachineLearningModel.h"
 #include "otbOpenCVUtils.h"
@@ -133,6 +134,72 @@ SVMMachineLearningModel<TInputValue, TOutputValue>::DoPredict(const InputSampleT
   return target;
 }
 
+template <class TInputValue, class TOutputValue>
+void SVMMachineLearningModel<TInputValue, TOutputValue>::DoPredictBatch(const InputListSampleType* input, const unsigned int& startIndex,
+                                                                        const unsigned int& size, TargetListSampleType* targets,
+                                                                        ConfidenceListSampleType* quality, ProbaListSampleType* proba) const
+{
+  if (startIndex + size > input->Size())
+  {
+    itkExceptionMacro(<< "requested range [" << startIndex << ", " << startIndex + size << "[ partially outside input sample list range.[0," << input->Size()
+                      << "[");
+  }
+  if (proba != nullptr && !this->m_ProbaIndex)
+    itkExceptionMacro("Probability per class not available for this classifier !");
+  if (size == 0)
+    return;
+
+  // Predict the whole range at once
+  cv::Mat samples;
+  otb::ListSampleRangeToMat(input, startIndex, size, samples);
+
+  std::vector<TargetValueType>     labels(size);
+  std::vector<ConfidenceValueType> confidences(quality != nullptr ? size : 0);
+  this->PredictMat(samples, labels.data(), quality != nullptr ? confidences.data() : nullptr);
+
+  for (unsigned int i = 0; i < size; ++i)
+  {
+    TargetSampleType target;
+    target[0] = labels[i];
+    targets->SetMeasurementVector(startIndex + i, target);
+    if (quality != nullptr)
+      quality->SetMeasurementVector(startIndex + i, confidences[i]);
+  }
+}
+
+template <class TInputValue, class TOutputValue>
+void SVMMachineLearningModel<TInputValue, TOutputValue>::DoPredictBuffer(const InputValueType* samples, unsigned int nbSamples,
+                                                                         unsigned int nbFeatures, std::size_t stride,
+                                                                         TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  cv::Mat mat;
+  otb::BufferToMat(samples, nbSamples, nbFeatures, stride, mat);
+  this->PredictMat(mat, labels, quality);
+}
+
+template <class TInputValue, class TOutputValue>
+void SVMMachineLearningModel<TInputValue, TOutputValue>::PredictMat(const cv::Mat& samples, TargetValueType* labels, ConfidenceValueType* quality) const
+{
+  cv::Mat results;
+  m_SVMModel->predict(samples, results);
+  results.convertTo(results, CV_32F);
+  for (int i = 0; i < samples.rows; ++i)
+  {
+    labels[i] = static_cast<TOutputValue>(results.at<float>(i, 0));
+  }
+
+  if (quality != nullptr)
+  {
+    cv::Mat rawResults;
+    m_SVMModel->predict(samples, rawResults, cv::ml::StatModel::RAW_OUTPUT);
+    rawResults.convertTo(rawResults, CV_32F);
+    for (int i = 0; i < samples.rows; ++i)
+    {
+      quality[i] = static_cast<ConfidenceValueType>(rawResults.at<float>(i, 0));
+    }
+  }
+}
+
 template <class TInputValue, class TOutputValue>
 void SVMMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& name)
 {
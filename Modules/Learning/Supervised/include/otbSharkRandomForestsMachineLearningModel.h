@@ -184,6 +184,9 @@ private:
 
   /** Confidence list sample */
   ConfidenceValueType ComputeConfidence(shark::RealVector& probas, bool computeMargin) const;
+
+  /** Set the label of the class of index classIndex to targets[id] */
+  void SetTarget(TargetListSampleType* targets, unsigned int id, unsigned int classIndex) const;
 };
 } // end namespace otb
 
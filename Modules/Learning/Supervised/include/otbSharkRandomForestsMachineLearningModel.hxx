@@ -24,6 +24,7 @@
 #include <fstream>
 #include "itkMacro.h"
 #include "otbSharkRandomForestsMachineLearningModel.h"
+#include "otbConfigurationManager.h"
 
 #if defined(__GNUC__) || defined(__clang__)
 #pragma GCC diagnostic push
@@ -59,7 +60,7 @@ template <class TInputValue, class TOutputValue>
 void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::Train()
 {
 #ifdef _OPENMP
-  omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
+  omp_set_num_threads(ConfigurationManager::GetAvailableThreads());
 #endif
 
   std::vector<shark::RealVector> features;
@@ -112,13 +113,13 @@ SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredict(con
   {
     samples.push_back(value[i]);
   }
+  unsigned int res{0};
   if (quality != nullptr || proba != nullptr)
   {
+    // The label is the first most voted class: the forest is only evaluated
+    // once
     shark::RealVector probas = m_RFModel.decisionFunction()(samples);
-    if (quality != nullptr)
-    {
-      (*quality) = ComputeConfidence(probas, m_ComputeMargin);
-    }
+    res                      = static_cast<unsigned int>(std::max_element(probas.begin(), probas.end()) - probas.begin());
     if (proba != nullptr)
     {
       for (size_t i = 0; i < probas.size(); i++)
@@ -127,9 +128,15 @@ SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredict(con
         (*proba)[i] = static_cast<unsigned int>(probas[i] * 1000);
       }
     }
+    if (quality != nullptr)
+    {
+      (*quality) = ComputeConfidence(probas, m_ComputeMargin);
+    }
+  }
+  else
+  {
+    m_RFModel.eval(samples, res);
   }
-  unsigned int res{0};
-  m_RFModel.eval(samples, res);
 
   TargetSampleType target;
   if (m_NormalizeClassLabels)
@@ -167,7 +174,7 @@ void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredic
   shark::Data<shark::RealVector> inputSamples = shark::createDataFromRange(features);
 
 #ifdef _OPENMP
-  omp_set_num_threads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads());
+  omp_set_num_threads(ConfigurationManager::GetAvailableThreads());
 
 #endif
   if (proba != nullptr || quality != nullptr)
@@ -187,38 +194,48 @@ void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::DoPredic
         ++id;
       }
     }
-    if (quality != nullptr)
+    // The labels are the first most voted classes: the forest is only
+    // evaluated once
+    unsigned int id = startIndex;
+    for (shark::RealVector&& p : probas.elements())
     {
-      unsigned int id = startIndex;
-      for (shark::RealVector&& p : probas.elements())
+      this->SetTarget(targets, id, static_cast<unsigned int>(std::max_element(p.begin(), p.end()) - p.begin()));
+      if (quality != nullptr)
       {
         ConfidenceSampleType confidence;
         auto                 conf = ComputeConfidence(p, m_ComputeMargin);
         confidence[0]             = static_cast<ConfidenceValueType>(conf);
         quality->SetMeasurementVector(id, confidence);
-        ++id;
       }
+      ++id;
     }
+    return;
   }
 
   auto         prediction = m_RFModel(inputSamples);
   unsigned int id         = startIndex;
   for (const auto& p : prediction.elements())
   {
-    TargetSampleType target;
-    if (m_NormalizeClassLabels)
-    {
-      target[0] = m_ClassDictionary[static_cast<TOutputValue>(p)];
-    }
-    else
-    {
-      target[0] = static_cast<TOutputValue>(p);
-    }
-    targets->SetMeasurementVector(id, target);
+    this->SetTarget(targets, id, static_cast<unsigned int>(p));
     ++id;
   }
 }
 
+template <class TInputValue, class TOutputValue>
+void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::SetTarget(TargetListSampleType* targets, unsigned int id, unsigned int classIndex) const
+{
+  TargetSampleType target;
+  if (m_NormalizeClassLabels)
+  {
+    target[0] = m_ClassDictionary[static_cast<TOutputValue>(classIndex)];
+  }
+  else
+  {
+    target[0] = static_cast<TOutputValue>(classIndex);
+  }
+  targets->SetMeasurementVector(id, target);
+}
+
 template <class TInputValue, class TOutputValue>
 void SharkRandomForestsMachineLearningModel<TInputValue, TOutputValue>::Save(const std::string& filename, const std::string& itkNotUsed(name))
 {
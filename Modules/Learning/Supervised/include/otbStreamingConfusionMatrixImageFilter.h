@@ -0,0 +1,300 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingConfusionMatrixImageFilter_h
+#define otbStreamingConfusionMatrixImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include "itkVariableSizeMatrix.h"
+#include <map>
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentConfusionMatrixImageFilter
+ * \brief Confusion matrix between a produced label image and a reference one.
+ *
+ * The first input is the produced (classified) image, the second one the
+ * reference image. Pixels equal to the no-data value of either image (when
+ * enabled) are ignored.
+ *
+ * Each thread accumulates its own dense matrix. Labels are mapped once to
+ * matrix indices: through a lookup table for labels in [0, 65536), which
+ * covers the usual 8 and 16 bits classification maps, and through a map for
+ * the other ones. The thread matrices are merged by Synthetize().
+ *
+ * After Synthetize(), the rows of GetMatrix() are the sorted reference labels
+ * and its columns the sorted produced labels.
+ *
+ * This filter persists its temporary data. It means that if you Update it n
+ * times on n different requested regions, the output matrix is the one of
+ * the whole set of n regions. To reset the temporary data, one should call
+ * the Reset() function.
+ *
+ * \sa PersistentImageFilter
+ * \sa ConfusionMatrixCalculator
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBSupervised
+ */
+template <class TInputImage, class TReferenceImage = TInputImage>
+class ITK_EXPORT PersistentConfusionMatrixImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentConfusionMatrixImageFilter Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentConfusionMatrixImageFilter, PersistentImageFilter);
+
+  typedef TInputImage                      InputImageType;
+  typedef TReferenceImage                  ReferenceImageType;
+  typedef typename TInputImage::RegionType RegionType;
+  typedef typename TInputImage::PixelType  LabelType;
+
+  typedef unsigned long                    CountType;
+  typedef itk::VariableSizeMatrix<CountType> MatrixType;
+  typedef std::vector<LabelType>           LabelListType;
+
+  /** Connect the reference image */
+  void SetReferenceImage(const ReferenceImageType* image);
+  const ReferenceImageType* GetReferenceImage();
+
+  /** No-data label of the produced image */
+  itkSetMacro(NoDataLabel, LabelType);
+  itkGetMacro(NoDataLabel, LabelType);
+  itkSetMacro(UseNoDataLabel, bool);
+  itkGetMacro(UseNoDataLabel, bool);
+
+  /** No-data label of the reference image */
+  itkSetMacro(ReferenceNoDataLabel, LabelType);
+  itkGetMacro(ReferenceNoDataLabel, LabelType);
+  itkSetMacro(UseReferenceNoDataLabel, bool);
+  itkGetMacro(UseReferenceNoDataLabel, bool);
+
+  /** Sorted labels of the rows of the matrix */
+  const LabelListType& GetReferenceLabels() const
+  {
+    return m_ReferenceLabels;
+  }
+
+  /** Sorted labels of the columns of the matrix */
+  const LabelListType& GetProducedLabels() const
+  {
+    return m_ProducedLabels;
+  }
+
+  /** Counts of the (reference, produced) label pairs */
+  const MatrixType& GetMatrix() const
+  {
+    return m_Matrix;
+  }
+
+  void AllocateOutputs() override;
+  void GenerateOutputInformation() override;
+  void Synthetize(void) override;
+  void Reset(void) override;
+
+protected:
+  PersistentConfusionMatrixImageFilter();
+  ~PersistentConfusionMatrixImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** The reference may be a rasterization of the produced image grid,
+   * with slightly different origin or spacing: no check. */
+  void VerifyInputInformation() override
+  {
+  }
+
+private:
+  PersistentConfusionMatrixImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Dense confusion matrix of one thread, on the labels it has seen */
+  class ThreadMatrix
+  {
+  public:
+    ThreadMatrix();
+
+    void Add(LabelType reference, LabelType produced)
+    {
+      const unsigned int r = Index(reference);
+      const unsigned int p = Index(produced);
+      ++m_Counts[r * m_Capacity + p];
+    }
+
+    /** Index of label in the matrix, added if needed */
+    unsigned int Index(LabelType label)
+    {
+      if (label >= 0 && label < LabelType(LookupTableSize))
+      {
+        int& index = m_LookupTable[static_cast<std::size_t>(label)];
+        if (index < 0)
+          index = AddLabel(label);
+        return index;
+      }
+      typename std::map<LabelType, unsigned int>::const_iterator it = m_OtherLabels.find(label);
+      if (it != m_OtherLabels.end())
+        return it->second;
+      const unsigned int index = AddLabel(label);
+      m_OtherLabels[label]     = index;
+      return index;
+    }
+
+    LabelListType          m_Labels;
+    std::vector<CountType> m_Counts;
+    unsigned int           m_Capacity;
+
+  private:
+    static const std::size_t LookupTableSize = 65536;
+
+    unsigned int AddLabel(LabelType label);
+
+    std::vector<int>                    m_LookupTable;
+    std::map<LabelType, unsigned int>   m_OtherLabels;
+  };
+
+  std::vector<ThreadMatrix> m_ThreadMatrices;
+
+  LabelType m_NoDataLabel;
+  bool      m_UseNoDataLabel;
+  LabelType m_ReferenceNoDataLabel;
+  bool      m_UseReferenceNoDataLabel;
+
+  LabelListType m_ReferenceLabels;
+  LabelListType m_ProducedLabels;
+  MatrixType    m_Matrix;
+};
+
+/*===========================================================================*/
+
+/** \class StreamingConfusionMatrixImageFilter
+ * \brief Streams a produced and a reference label images through
+ * PersistentConfusionMatrixImageFilter.
+ *
+ * \code
+ * typedef otb::StreamingConfusionMatrixImageFilter<LabelImageType> ConfusionMatrixFilterType;
+ * ConfusionMatrixFilterType::Pointer filter = ConfusionMatrixFilterType::New();
+ * filter->SetInput(classification);
+ * filter->SetReferenceImage(reference);
+ * filter->Update();
+ * filter->GetMatrix();
+ * \endcode
+ *
+ * \sa PersistentConfusionMatrixImageFilter
+ * \sa PersistentFilterStreamingDecorator
+ *
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBSupervised
+ */
+template <class TInputImage, class TReferenceImage = TInputImage>
+class ITK_EXPORT StreamingConfusionMatrixImageFilter
+    : public PersistentFilterStreamingDecorator<PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingConfusionMatrixImageFilter Self;
+  typedef PersistentFilterStreamingDecorator<PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingConfusionMatrixImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef typename Superclass::FilterType    ConfusionMatrixFilterType;
+  typedef typename ConfusionMatrixFilterType::LabelType     LabelType;
+  typedef typename ConfusionMatrixFilterType::LabelListType LabelListType;
+  typedef typename ConfusionMatrixFilterType::MatrixType    MatrixType;
+
+  void SetInput(const TInputImage* input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+
+  void SetReferenceImage(const TReferenceImage* image)
+  {
+    this->GetFilter()->SetReferenceImage(image);
+  }
+
+  void SetNoDataLabel(LabelType label)
+  {
+    this->GetFilter()->SetNoDataLabel(label);
+    this->GetFilter()->SetUseNoDataLabel(true);
+  }
+
+  void SetReferenceNoDataLabel(LabelType label)
+  {
+    this->GetFilter()->SetReferenceNoDataLabel(label);
+    this->GetFilter()->SetUseReferenceNoDataLabel(true);
+  }
+
+  const LabelListType& GetReferenceLabels() const
+  {
+    return this->GetFilter()->GetReferenceLabels();
+  }
+
+  const LabelListType& GetProducedLabels() const
+  {
+    return this->GetFilter()->GetProducedLabels();
+  }
+
+  const MatrixType& GetMatrix() const
+  {
+    return this->GetFilter()->GetMatrix();
+  }
+
+protected:
+  StreamingConfusionMatrixImageFilter()
+  {
+  }
+  ~StreamingConfusionMatrixImageFilter() override
+  {
+  }
+
+private:
+  StreamingConfusionMatrixImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingConfusionMatrixImageFilter.hxx"
+#endif
+
+#endif
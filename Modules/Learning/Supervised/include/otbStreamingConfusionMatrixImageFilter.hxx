@@ -0,0 +1,225 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingConfusionMatrixImageFilter_hxx
+#define otbStreamingConfusionMatrixImageFilter_hxx
+
+#include "otbStreamingConfusionMatrixImageFilter.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkProgressReporter.h"
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TInputImage, class TReferenceImage>
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::ThreadMatrix::ThreadMatrix()
+  : m_Capacity(0), m_LookupTable(LookupTableSize, -1)
+{
+}
+
+template <class TInputImage, class TReferenceImage>
+unsigned int PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::ThreadMatrix::AddLabel(LabelType label)
+{
+  const unsigned int index = m_Labels.size();
+  m_Labels.push_back(label);
+
+  if (m_Labels.size() > m_Capacity)
+  {
+    // Double the capacity and move the counts to the new layout
+    const unsigned int     capacity = std::max(2 * m_Capacity, 16u);
+    std::vector<CountType> counts(capacity * capacity, 0);
+    for (unsigned int r = 0; r < m_Capacity; ++r)
+    {
+      std::copy(m_Counts.begin() + r * m_Capacity, m_Counts.begin() + (r + 1) * m_Capacity, counts.begin() + r * capacity);
+    }
+    m_Counts.swap(counts);
+    m_Capacity = capacity;
+  }
+  return index;
+}
+
+template <class TInputImage, class TReferenceImage>
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::PersistentConfusionMatrixImageFilter()
+  : m_NoDataLabel(0), m_UseNoDataLabel(false), m_ReferenceNoDataLabel(0), m_UseReferenceNoDataLabel(false)
+{
+  this->SetNumberOfRequiredInputs(2);
+  this->Reset();
+}
+
+template <class TInputImage, class TReferenceImage>
+void PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::SetReferenceImage(const ReferenceImageType* image)
+{
+  // The ProcessObject is not const-correct so the const_cast is required here
+  this->itk::ProcessObject::SetNthInput(1, const_cast<ReferenceImageType*>(image));
+}
+
+template <class TInputImage, class TReferenceImage>
+const typename PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::ReferenceImageType*
+PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::GetReferenceImage()
+{
+  if (this->GetNumberOfInputs() < 2)
+  {
+    return nullptr;
+  }
+  return static_cast<const ReferenceImageType*>(this->itk::ProcessObject::GetInput(1));
+}
+
+template <class TInputImage, class TReferenceImage>
+void PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage, class TReferenceImage>
+void PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::AllocateOutputs()
+{
+  // Nothing that needs to be allocated: the output image is not intended to be used
+}
+
+template <class TInputImage, class TReferenceImage>
+void PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::Reset()
+{
+  m_ThreadMatrices.clear();
+  m_ThreadMatrices.resize(this->GetNumberOfThreads());
+
+  m_ReferenceLabels.clear();
+  m_ProducedLabels.clear();
+  m_Matrix.SetSize(0, 0);
+}
+
+template <class TInputImage, class TReferenceImage>
+void PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::Synthetize()
+{
+  // Sorted union of the labels seen by all threads
+  LabelListType labels;
+  for (const auto& threadMatrix : m_ThreadMatrices)
+  {
+    labels.insert(labels.end(), threadMatrix.m_Labels.begin(), threadMatrix.m_Labels.end());
+  }
+  std::sort(labels.begin(), labels.end());
+  labels.erase(std::unique(labels.begin(), labels.end()), labels.end());
+
+  const unsigned int     nbLabels = labels.size();
+  std::vector<CountType> counts(nbLabels * nbLabels, 0);
+  for (const auto& threadMatrix : m_ThreadMatrices)
+  {
+    const unsigned int        nbLocal = threadMatrix.m_Labels.size();
+    std::vector<unsigned int> global(nbLocal);
+    for (unsigned int i = 0; i < nbLocal; ++i)
+    {
+      global[i] = std::lower_bound(labels.begin(), labels.end(), threadMatrix.m_Labels[i]) - labels.begin();
+    }
+    for (unsigned int r = 0; r < nbLocal; ++r)
+    {
+      const CountType* row = &threadMatrix.m_Counts[r * threadMatrix.m_Capacity];
+      for (unsigned int p = 0; p < nbLocal; ++p)
+      {
+        counts[global[r] * nbLabels + global[p]] += row[p];
+      }
+    }
+  }
+
+  // Keep the rows of the reference labels and the columns of the produced labels
+  std::vector<unsigned int> rows, cols;
+  m_ReferenceLabels.clear();
+  m_ProducedLabels.clear();
+  for (unsigned int i = 0; i < nbLabels; ++i)
+  {
+    CountType rowSum = 0, colSum = 0;
+    for (unsigned int j = 0; j < nbLabels; ++j)
+    {
+      rowSum += counts[i * nbLabels + j];
+      colSum += counts[j * nbLabels + i];
+    }
+    if (rowSum > 0)
+    {
+      rows.push_back(i);
+      m_ReferenceLabels.push_back(labels[i]);
+    }
+    if (colSum > 0)
+    {
+      cols.push_back(i);
+      m_ProducedLabels.push_back(labels[i]);
+    }
+  }
+
+  m_Matrix.SetSize(rows.size(), cols.size());
+  for (unsigned int r = 0; r < rows.size(); ++r)
+  {
+    for (unsigned int p = 0; p < cols.size(); ++p)
+    {
+      m_Matrix(r, p) = counts[rows[r] * nbLabels + cols[p]];
+    }
+  }
+}
+
+template <class TInputImage, class TReferenceImage>
+void PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::ThreadedGenerateData(const RegionType& outputRegionForThread,
+                                                                                               itk::ThreadIdType threadId)
+{
+  const InputImageType*     producedPtr  = this->GetInput();
+  const ReferenceImageType* referencePtr = this->GetReferenceImage();
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+  ThreadMatrix& threadMatrix = m_ThreadMatrices[threadId];
+
+  itk::ImageRegionConstIterator<InputImageType>     itProd(producedPtr, outputRegionForThread);
+  itk::ImageRegionConstIterator<ReferenceImageType> itRef(referencePtr, outputRegionForThread);
+
+  for (itProd.GoToBegin(), itRef.GoToBegin(); !itProd.IsAtEnd() && !itRef.IsAtEnd(); ++itProd, ++itRef)
+  {
+    const LabelType produced  = itProd.Get();
+    const LabelType reference = static_cast<LabelType>(itRef.Get());
+
+    if (!(m_UseNoDataLabel && produced == m_NoDataLabel) && !(m_UseReferenceNoDataLabel && reference == m_ReferenceNoDataLabel))
+    {
+      threadMatrix.Add(reference, produced);
+    }
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TReferenceImage>
+void PersistentConfusionMatrixImageFilter<TInputImage, TReferenceImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "Reference labels: " << m_ReferenceLabels.size() << std::endl;
+  os << indent << "Produced labels: " << m_ProducedLabels.size() << std::endl;
+  os << indent << "Matrix: " << m_Matrix << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -31,12 +31,14 @@ ENABLE_SHARED
     OTBImageBase
     OTBLabelMap
     OTBLearningBase
+    OTBStreaming
     OTBUnsupervised
 
   OPTIONAL_DEPENDS
     OTBOpenCV
     OTBLibSVM
     OTBShark
+    OTBONNXRuntime
 
   TEST_DEPENDS
     OTBTestKernel
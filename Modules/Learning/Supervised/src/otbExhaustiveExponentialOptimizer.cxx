@@ -22,6 +22,10 @@
 #include "itkCommand.h"
 #include "itkEventObject.h"
 
+#include <algorithm>
+#include <atomic>
+#include <future>
+
 namespace otb
 {
 
@@ -40,6 +44,7 @@ ExhaustiveExponentialOptimizer::ExhaustiveExponentialOptimizer()
   m_CurrentIndex.Fill(0);
   m_Stop = false;
   m_NumberOfSteps.Fill(0);
+  m_NumberOfThreads = 1;
 }
 
 /**
@@ -93,11 +98,78 @@ void ExhaustiveExponentialOptimizer::StartWalking(void)
   }
   this->SetCurrentPosition(position);
 
+  if (m_NumberOfThreads > 1)
+  {
+    this->WalkConcurrently();
+    return;
+  }
+
   itkDebugMacro("Calling ResumeWalking");
 
   this->ResumeWalking();
 }
 
+void ExhaustiveExponentialOptimizer::WalkConcurrently(void)
+{
+  itkDebugMacro("WalkConcurrently");
+  m_Stop = false;
+
+  // Enumerate the grid positions in the order of the sequential walk
+  std::vector<ParametersType> positions(1, this->GetCurrentPosition());
+  const unsigned int          spaceDimension = m_CostFunction->GetNumberOfParameters();
+  while (true)
+  {
+    ParametersType newPosition(spaceDimension);
+    IncrementIndex(newPosition);
+    if (m_Stop)
+    {
+      break;
+    }
+    positions.push_back(newPosition);
+  }
+
+  std::vector<MeasureType> values(positions.size());
+  std::atomic<std::size_t> nextPosition(0);
+  auto                     worker = [&]() {
+    for (std::size_t i = nextPosition++; i < positions.size(); i = nextPosition++)
+    {
+      values[i] = m_CostFunction->GetValue(positions[i]);
+    }
+  };
+  const unsigned int             nbThreads = std::min<std::size_t>(m_NumberOfThreads, positions.size());
+  std::vector<std::future<void>> tasks;
+  for (unsigned int thread = 1; thread < nbThreads; ++thread)
+  {
+    tasks.push_back(std::async(std::launch::async, worker));
+  }
+  worker();
+  // Rethrows the exceptions of the cost function
+  for (auto& task : tasks)
+  {
+    task.get();
+  }
+
+  for (std::size_t i = 0; i < positions.size(); ++i)
+  {
+    this->SetCurrentPosition(positions[i]);
+    m_CurrentValue = values[i];
+
+    if (m_CurrentValue > m_MaximumMetricValue)
+    {
+      m_MaximumMetricValue         = m_CurrentValue;
+      m_MaximumMetricValuePosition = positions[i];
+    }
+    if (m_CurrentValue < m_MinimumMetricValue)
+    {
+      m_MinimumMetricValue         = m_CurrentValue;
+      m_MinimumMetricValuePosition = positions[i];
+    }
+
+    this->InvokeEvent(itk::IterationEvent());
+    m_CurrentIteration++;
+  }
+}
+
 /**
  * Resume the optimization
  */
@@ -211,6 +283,7 @@ void ExhaustiveExponentialOptimizer::PrintSelf(std::ostream& os, itk::Indent ind
   os << indent << "MinimumMetricValue = " << m_MinimumMetricValue << std::endl;
   os << indent << "MinimumMetricValuePosition = " << m_MinimumMetricValuePosition << std::endl;
   os << indent << "MaximumMetricValuePosition = " << m_MaximumMetricValuePosition << std::endl;
+  os << indent << "NumberOfThreads = " << m_NumberOfThreads << std::endl;
 }
 
 } // end namespace itk
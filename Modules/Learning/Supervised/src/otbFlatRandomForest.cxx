@@ -0,0 +1,582 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbFlatRandomForest.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <ostream>
+
+namespace otb
+{
+
+namespace
+{
+/** Binary stream layout: signature, then the Header, then the node arrays
+ * (features, thresholds, children), the roots and the class labels */
+const char FlatForestSignature[8] = {'O', 'T', 'B', 'F', 'L', 'A', 'T', 'F'};
+
+const std::uint32_t FlatForestVersion   = 2;
+const std::uint32_t FlatForestByteOrder = 0x01020304;
+/** Thresholds are stored as half precision floats */
+const std::uint32_t HalfThresholdsFlag = 1;
+/** Boosted trees, the thresholds of the leaves hold their responses (version 2) */
+const std::uint32_t BoostedFlag = 2;
+
+struct Header
+{
+  std::uint32_t byteOrder;
+  std::uint32_t version;
+  std::uint32_t flags;
+  std::uint32_t nbFeatures;
+  std::uint32_t nbNodes;
+  std::uint32_t nbRoots;
+  std::uint32_t nbClasses;
+};
+
+/** IEEE 754 binary32 to binary16 conversion, rounding to nearest even */
+std::uint16_t FloatToHalf(float value)
+{
+  std::uint32_t bits;
+  std::memcpy(&bits, &value, sizeof(bits));
+  const std::uint16_t sign    = (bits >> 16) & 0x8000;
+  const std::uint32_t absBits = bits & 0x7fffffff;
+
+  // Infinity and NaN
+  if (absBits >= 0x7f800000)
+    return sign | 0x7c00 | (absBits > 0x7f800000 ? 0x0200 : 0);
+  // Rounds above the largest half (65504)
+  if (absBits >= 0x477ff000)
+    return sign | 0x7c00;
+  // Subnormal halves, below 2^-14
+  if (absBits < 0x38800000)
+  {
+    if (absBits < 0x33000000)
+      return sign;
+    const std::uint32_t exponent  = absBits >> 23;
+    const std::uint32_t mantissa  = (absBits & 0x7fffff) | 0x800000;
+    const std::uint32_t shift     = 126 - exponent;
+    const std::uint32_t remainder = mantissa & ((1u << shift) - 1);
+    const std::uint32_t halfway   = 1u << (shift - 1);
+    std::uint32_t       half      = mantissa >> shift;
+    if (remainder > halfway || (remainder == halfway && (half & 1)))
+      ++half;
+    return sign | half;
+  }
+  // Normal halves: rebias the exponent, a carry in the mantissa rounding
+  // correctly increments the exponent
+  std::uint32_t       half      = (absBits - 0x38000000) >> 13;
+  const std::uint32_t remainder = absBits & 0x1fff;
+  if (remainder > 0x1000 || (remainder == 0x1000 && (half & 1)))
+    ++half;
+  return sign | half;
+}
+
+float HalfToFloat(std::uint16_t half)
+{
+  const std::uint32_t sign     = static_cast<std::uint32_t>(half & 0x8000) << 16;
+  std::uint32_t       exponent = (half >> 10) & 0x1f;
+  std::uint32_t       mantissa = half & 0x3ff;
+  std::uint32_t       bits;
+
+  if (exponent == 0x1f)
+    bits = sign | 0x7f800000 | (mantissa << 13);
+  else if (exponent != 0)
+    bits = sign | ((exponent + 112) << 23) | (mantissa << 13);
+  else if (mantissa == 0)
+    bits = sign;
+  else
+  {
+    // Subnormal half: normalize the mantissa
+    exponent = 113;
+    while (!(mantissa & 0x400))
+    {
+      mantissa <<= 1;
+      --exponent;
+    }
+    bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+  }
+
+  float value;
+  std::memcpy(&value, &bits, sizeof(value));
+  return value;
+}
+
+template <class T>
+void WriteArray(std::ostream& os, const std::vector<T>& array)
+{
+  os.write(reinterpret_cast<const char*>(array.data()), array.size() * sizeof(T));
+}
+
+template <class T>
+bool ReadArray(std::istream& is, std::vector<T>& array, std::size_t size)
+{
+  array.resize(size);
+  is.read(reinterpret_cast<char*>(array.data()), size * sizeof(T));
+  return static_cast<bool>(is);
+}
+} // end anonymous namespace
+
+void FlatRandomForest::Clear()
+{
+  m_Feature.clear();
+  m_Threshold.clear();
+  m_Child.clear();
+  m_Roots.clear();
+  m_ClassLabels.clear();
+  m_RemainingSumBounds.clear();
+  m_NumberOfFeatures = 0;
+  m_Boosted          = false;
+}
+
+bool FlatRandomForest::Build(const cv::ml::DTrees& model)
+{
+  Clear();
+
+  if (!model.isTrained() || !model.isClassifier())
+    return false;
+
+  const std::vector<cv::ml::DTrees::Node>& nodes = model.getNodes();
+
+  // Retrieve the label of each class index from the leaves
+  int nbClasses = 0;
+  for (const auto& node : nodes)
+  {
+    if (node.split < 0)
+    {
+      if (node.classIdx < 0)
+        return false;
+      nbClasses = std::max(nbClasses, node.classIdx + 1);
+    }
+  }
+  std::vector<float> classLabels(nbClasses, 0.f);
+  for (const auto& node : nodes)
+  {
+    if (node.split < 0)
+      classLabels[node.classIdx] = static_cast<float>(node.value);
+  }
+
+  if (!FlattenTrees(model, false))
+    return false;
+
+  m_ClassLabels = classLabels;
+  return true;
+}
+
+bool FlatRandomForest::BuildBoost(const cv::ml::Boost& model)
+{
+  Clear();
+
+  if (!model.isTrained() || !model.isClassifier())
+    return false;
+
+  // The labels of the two classes are not exposed by cv::ml::Boost, they are
+  // read back from its serialisation
+  cv::FileStorage fs(".yml", cv::FileStorage::WRITE | cv::FileStorage::MEMORY);
+  fs << "boost"
+     << "{";
+  model.write(fs);
+  fs << "}";
+  cv::FileStorage params(fs.releaseAndGetString(), cv::FileStorage::READ | cv::FileStorage::MEMORY);
+  cv::Mat         classLabels;
+  params["boost"]["class_labels"] >> classLabels;
+  if (classLabels.total() != 2)
+    return false;
+  classLabels.convertTo(classLabels, CV_32F);
+
+  if (!FlattenTrees(model, true))
+    return false;
+
+  m_ClassLabels.assign(classLabels.begin<float>(), classLabels.end<float>());
+  m_Boosted = true;
+  ComputeSumBounds();
+  return true;
+}
+
+bool FlatRandomForest::FlattenTrees(const cv::ml::DTrees& model, bool leafValues)
+{
+  const std::vector<cv::ml::DTrees::Node>&  nodes  = model.getNodes();
+  const std::vector<cv::ml::DTrees::Split>& splits = model.getSplits();
+  const std::vector<int>&                   roots  = model.getRoots();
+  const int                                 nbVars = model.getVarCount();
+
+  if (roots.empty() || nbVars <= 0)
+    return false;
+
+  m_Feature.reserve(nodes.size());
+  m_Threshold.reserve(nodes.size());
+  m_Child.reserve(nodes.size());
+  m_Roots.reserve(roots.size());
+
+  // Breadth-first renumbering of each tree: queue[q] is the OpenCV index of
+  // the node stored at base + q
+  std::vector<int> queue;
+  for (int root : roots)
+  {
+    const int base = m_Feature.size();
+    m_Roots.push_back(base);
+
+    queue.assign(1, root);
+    m_Feature.push_back(-1);
+    m_Threshold.push_back(0.f);
+    m_Child.push_back(0);
+
+    for (std::size_t q = 0; q < queue.size(); ++q)
+    {
+      const int slot = base + q;
+      if (queue[q] < 0 || queue[q] >= static_cast<int>(nodes.size()))
+      {
+        Clear();
+        return false;
+      }
+      const cv::ml::DTrees::Node& node = nodes[queue[q]];
+      if (node.split < 0)
+      {
+        if (leafValues)
+          m_Threshold[slot] = static_cast<float>(node.value);
+        else
+          m_Child[slot] = node.classIdx;
+        continue;
+      }
+
+      const cv::ml::DTrees::Split& split = splits[node.split];
+      // Categorical splits (subsets) are not supported
+      if (split.subsetOfs >= 0 || split.varIdx < 0 || split.varIdx >= nbVars)
+      {
+        Clear();
+        return false;
+      }
+
+      m_Feature[slot]   = split.varIdx;
+      m_Threshold[slot] = split.c;
+      m_Child[slot]     = base + queue.size();
+
+      // The child taken when the value is lower or equal to the threshold is
+      // stored first
+      queue.push_back(split.inversed ? node.right : node.left);
+      queue.push_back(split.inversed ? node.left : node.right);
+      for (int i = 0; i < 2; ++i)
+      {
+        m_Feature.push_back(-1);
+        m_Threshold.push_back(0.f);
+        m_Child.push_back(0);
+      }
+    }
+  }
+
+  m_NumberOfFeatures = nbVars;
+  return true;
+}
+
+void FlatRandomForest::ComputeSumBounds()
+{
+  // The nodes of a tree are stored between its root and the next one
+  const std::size_t nbTrees = m_Roots.size();
+  m_RemainingSumBounds.assign(nbTrees + 1, 0.);
+  for (std::size_t t = nbTrees; t-- > 0;)
+  {
+    const std::size_t end      = t + 1 < nbTrees ? m_Roots[t + 1] : m_Feature.size();
+    double            maxValue = 0.;
+    for (std::size_t n = m_Roots[t]; n < end; ++n)
+    {
+      if (m_Feature[n] < 0)
+        maxValue = std::max(maxValue, std::abs(static_cast<double>(m_Threshold[n])));
+    }
+    m_RemainingSumBounds[t] = m_RemainingSumBounds[t + 1] + maxValue;
+  }
+}
+
+void FlatRandomForest::Vote(const float* samples, std::size_t nbSamples, std::size_t stride, unsigned int* votes) const
+{
+  const int*        feature   = m_Feature.data();
+  const float*      threshold = m_Threshold.data();
+  const int*        child     = m_Child.data();
+  const std::size_t nbClasses = m_ClassLabels.size();
+
+  // Tree by tree, so that the nodes of the current tree stay in cache while
+  // the whole block of samples goes through it
+  for (int root : m_Roots)
+  {
+    const float*  sample      = samples;
+    unsigned int* sampleVotes = votes;
+    for (std::size_t s = 0; s < nbSamples; ++s, sample += stride, sampleVotes += nbClasses)
+    {
+      int n = root;
+      while (feature[n] >= 0)
+      {
+        // NaN values go to the second child, as in OpenCV
+        n = child[n] + !(sample[feature[n]] <= threshold[n]);
+      }
+      ++sampleVotes[child[n]];
+    }
+  }
+}
+
+void FlatRandomForest::VoteUntilDecided(const float* samples, std::size_t nbSamples, std::size_t stride, unsigned int* votes,
+                                        unsigned int* nbVotingTrees) const
+{
+  // The decided samples are checked every few trees only, so that the trees
+  // are still applied to blocks of samples
+  const std::size_t checkInterval = 8;
+
+  const int*        feature   = m_Feature.data();
+  const float*      threshold = m_Threshold.data();
+  const int*        child     = m_Child.data();
+  const std::size_t nbClasses = m_ClassLabels.size();
+  const std::size_t nbTrees   = m_Roots.size();
+
+  std::vector<std::size_t> active(nbSamples);
+  for (std::size_t s = 0; s < nbSamples; ++s)
+    active[s] = s;
+
+  std::size_t tree = 0;
+  while (tree < nbTrees && !active.empty())
+  {
+    const std::size_t lastTree = std::min(tree + checkInterval, nbTrees);
+    for (; tree < lastTree; ++tree)
+    {
+      const int root = m_Roots[tree];
+      for (std::size_t s : active)
+      {
+        const float* sample = samples + s * stride;
+        int          n      = root;
+        while (feature[n] >= 0)
+        {
+          n = child[n] + !(sample[feature[n]] <= threshold[n]);
+        }
+        ++votes[s * nbClasses + child[n]];
+      }
+    }
+
+    // A sample is decided when no other class can catch up with the most
+    // voted one, even with all the remaining trees
+    const unsigned int remaining = nbTrees - tree;
+    std::size_t        kept      = 0;
+    for (std::size_t s : active)
+    {
+      const unsigned int* sampleVotes = votes + s * nbClasses;
+      const unsigned int  best        = GetMostVotedClass(sampleVotes);
+      bool                decided     = true;
+      for (std::size_t c = 0; c < nbClasses && decided; ++c)
+        decided = c == best || sampleVotes[c] + remaining < sampleVotes[best];
+
+      if (decided)
+        nbVotingTrees[s] = tree;
+      else
+        active[kept++] = s;
+    }
+    active.resize(kept);
+  }
+
+  for (std::size_t s : active)
+    nbVotingTrees[s] = nbTrees;
+}
+
+unsigned int FlatRandomForest::GetMostVotedClass(const unsigned int* votes) const
+{
+  return std::max_element(votes, votes + m_ClassLabels.size()) - votes;
+}
+
+void FlatRandomForest::Sum(const float* samples, std::size_t nbSamples, std::size_t stride, double* sums) const
+{
+  const int*   feature   = m_Feature.data();
+  const float* threshold = m_Threshold.data();
+  const int*   child     = m_Child.data();
+
+  for (int root : m_Roots)
+  {
+    const float* sample = samples;
+    for (std::size_t s = 0; s < nbSamples; ++s, sample += stride)
+    {
+      int n = root;
+      while (feature[n] >= 0)
+      {
+        n = child[n] + !(sample[feature[n]] <= threshold[n]);
+      }
+      sums[s] += threshold[n];
+    }
+  }
+}
+
+void FlatRandomForest::SumUntilDecided(const float* samples, std::size_t nbSamples, std::size_t stride, double* sums) const
+{
+  const std::size_t checkInterval = 8;
+
+  const int*        feature   = m_Feature.data();
+  const float*      threshold = m_Threshold.data();
+  const int*        child     = m_Child.data();
+  const std::size_t nbTrees   = m_Roots.size();
+
+  std::vector<std::size_t> active(nbSamples);
+  for (std::size_t s = 0; s < nbSamples; ++s)
+    active[s] = s;
+
+  std::size_t tree = 0;
+  while (tree < nbTrees && !active.empty())
+  {
+    const std::size_t lastTree = std::min(tree + checkInterval, nbTrees);
+    for (; tree < lastTree; ++tree)
+    {
+      const int root = m_Roots[tree];
+      for (std::size_t s : active)
+      {
+        const float* sample = samples + s * stride;
+        int          n      = root;
+        while (feature[n] >= 0)
+        {
+          n = child[n] + !(sample[feature[n]] <= threshold[n]);
+        }
+        sums[s] += threshold[n];
+      }
+    }
+
+    // A sample is decided when the remaining trees cannot change the sign of
+    // its sum
+    const double bound = m_RemainingSumBounds[tree];
+    std::size_t  kept  = 0;
+    for (std::size_t s : active)
+    {
+      if (std::abs(sums[s]) <= bound)
+        active[kept++] = s;
+    }
+    active.resize(kept);
+  }
+}
+
+bool FlatRandomForest::Write(std::ostream& os, bool halfThresholds) const
+{
+  if (!IsValid())
+    return false;
+
+  // The thresholds of boosted trees also hold the leaf responses
+  halfThresholds = halfThresholds && !m_Boosted;
+
+  Header header;
+  header.byteOrder  = FlatForestByteOrder;
+  header.version    = FlatForestVersion;
+  header.flags      = (halfThresholds ? HalfThresholdsFlag : 0) | (m_Boosted ? BoostedFlag : 0);
+  header.nbFeatures = m_NumberOfFeatures;
+  header.nbNodes    = m_Feature.size();
+  header.nbRoots    = m_Roots.size();
+  header.nbClasses  = m_ClassLabels.size();
+
+  os.write(FlatForestSignature, sizeof(FlatForestSignature));
+  os.write(reinterpret_cast<const char*>(&header), sizeof(header));
+
+  WriteArray(os, m_Feature);
+  if (halfThresholds)
+  {
+    std::vector<std::uint16_t> thresholds(m_Threshold.size());
+    std::transform(m_Threshold.begin(), m_Threshold.end(), thresholds.begin(), FloatToHalf);
+    WriteArray(os, thresholds);
+  }
+  else
+  {
+    WriteArray(os, m_Threshold);
+  }
+  WriteArray(os, m_Child);
+  WriteArray(os, m_Roots);
+  WriteArray(os, m_ClassLabels);
+
+  return static_cast<bool>(os);
+}
+
+bool FlatRandomForest::CanRead(std::istream& is, bool boosted)
+{
+  const std::streampos pos = is.tellg();
+  char                 signature[sizeof(FlatForestSignature)];
+  Header               header;
+  is.read(signature, sizeof(signature));
+  is.read(reinterpret_cast<char*>(&header), sizeof(header));
+  const bool found = is && std::equal(signature, signature + sizeof(signature), FlatForestSignature) &&
+                     ((header.flags & BoostedFlag) != 0) == boosted;
+  is.clear();
+  is.seekg(pos);
+  return found;
+}
+
+bool FlatRandomForest::Read(std::istream& is)
+{
+  Clear();
+
+  char   signature[sizeof(FlatForestSignature)];
+  Header header;
+  is.read(signature, sizeof(signature));
+  is.read(reinterpret_cast<char*>(&header), sizeof(header));
+  if (!is || !std::equal(signature, signature + sizeof(signature), FlatForestSignature) || header.byteOrder != FlatForestByteOrder ||
+      header.version < 1 || header.version > FlatForestVersion || header.nbRoots == 0 || header.nbNodes == 0 || header.nbClasses == 0)
+    return false;
+
+  const bool boosted = (header.flags & BoostedFlag) != 0;
+  if (boosted && header.nbClasses != 2)
+    return false;
+
+  bool ok = ReadArray(is, m_Feature, header.nbNodes);
+  if (ok && (header.flags & HalfThresholdsFlag))
+  {
+    std::vector<std::uint16_t> thresholds;
+    ok = ReadArray(is, thresholds, header.nbNodes);
+    m_Threshold.resize(thresholds.size());
+    std::transform(thresholds.begin(), thresholds.end(), m_Threshold.begin(), HalfToFloat);
+  }
+  else if (ok)
+  {
+    ok = ReadArray(is, m_Threshold, header.nbNodes);
+  }
+  ok = ok && ReadArray(is, m_Child, header.nbNodes) && ReadArray(is, m_Roots, header.nbRoots) && ReadArray(is, m_ClassLabels, header.nbClasses);
+
+  // Check the node table, so that Vote() never reads out of bounds nor loops:
+  // children are always stored after their parent
+  const int nbNodes    = header.nbNodes;
+  const int nbClasses  = header.nbClasses;
+  const int nbFeatures = header.nbFeatures;
+  for (int n = 0; ok && n < nbNodes; ++n)
+  {
+    if (m_Feature[n] < 0)
+      ok = m_Feature[n] == -1 && m_Child[n] >= 0 && m_Child[n] < nbClasses;
+    else
+      ok = m_Feature[n] < nbFeatures && m_Child[n] > n && m_Child[n] < nbNodes - 1;
+  }
+  for (std::size_t r = 0; ok && r < m_Roots.size(); ++r)
+    ok = m_Roots[r] >= 0 && m_Roots[r] < nbNodes;
+
+  if (ok)
+  {
+    // Roots are stored in increasing order, so that ComputeSumBounds() can
+    // find the nodes of each tree
+    for (std::size_t r = 1; ok && r < m_Roots.size(); ++r)
+      ok = !boosted || m_Roots[r] > m_Roots[r - 1];
+  }
+
+  if (!ok)
+  {
+    Clear();
+    return false;
+  }
+  m_NumberOfFeatures = header.nbFeatures;
+  m_Boosted          = boosted;
+  if (m_Boosted)
+    ComputeSumBounds();
+  return true;
+}
+
+} // end namespace otb
@@ -20,6 +20,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <cstdlib>
 
 #include "otbExhaustiveExponentialOptimizer.h"
 
@@ -109,8 +110,11 @@ private:
 }; // class Quadratic2DCostFunction
 
 
-int otbExhaustiveExponentialOptimizerTest(int itkNotUsed(argc), char* argv[])
+int otbExhaustiveExponentialOptimizerTest(int argc, char* argv[])
 {
+  // Optional number of threads evaluating the grid
+  const unsigned int nbThreads = argc > 2 ? std::atoi(argv[2]) : 1;
+
   Quadratic2DCostFunction::Pointer costFunction = Quadratic2DCostFunction::New();
 
   costFunction->SetFunctionInternalParameters(1.0, 1.0, 0.0, -6.0, 4.0, 13.0); // (x-3)^2 + (y+2)^2 => solution: x=3 and y=-2
@@ -127,6 +131,7 @@ int otbExhaustiveExponentialOptimizerTest(int itkNotUsed(argc), char* argv[])
   StepOptimizerType                                      nbSteps(initialPosition.Size());
   nbSteps.Fill(5);
 
+  optimizer->SetNumberOfThreads(nbThreads);
   optimizer->SetNumberOfSteps(nbSteps);
   optimizer->SetCostFunction(costFunction);
   optimizer->SetInitialPosition(initialPosition);
@@ -139,6 +144,7 @@ int otbExhaustiveExponentialOptimizerTest(int itkNotUsed(argc), char* argv[])
 
   double stepLength = 1. / static_cast<double>(5);
 
+  fineoptimizer->SetNumberOfThreads(nbThreads);
   fineoptimizer->SetNumberOfSteps(nbSteps);
   fineoptimizer->SetStepLength(stepLength);
   fineoptimizer->SetCostFunction(costFunction);
@@ -0,0 +1,117 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbImage.h"
+#include "otbStreamingConfusionMatrixImageFilter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <map>
+
+int otbStreamingConfusionMatrixImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef int                                                        LabelType;
+  typedef otb::Image<LabelType, 2>                                   LabelImageType;
+  typedef otb::StreamingConfusionMatrixImageFilter<LabelImageType> FilterType;
+
+  const LabelType noData = 0;
+
+  LabelImageType::RegionType region;
+  LabelImageType::SizeType   size = {{37, 23}};
+  region.SetSize(size);
+
+  LabelImageType::Pointer produced  = LabelImageType::New();
+  LabelImageType::Pointer reference = LabelImageType::New();
+  produced->SetRegions(region);
+  produced->Allocate();
+  reference->SetRegions(region);
+  reference->Allocate();
+
+  // Reference labels cycle through {0 (nodata), 1, 2, 3, 100000}, the produced
+  // ones are wrong every 7 pixels, and use a label absent from the reference.
+  const LabelType refCycle[5] = {0, 1, 2, 3, 100000};
+  std::map<LabelType, std::map<LabelType, unsigned long>> expected;
+
+  itk::ImageRegionIteratorWithIndex<LabelImageType> itProd(produced, region);
+  itk::ImageRegionIteratorWithIndex<LabelImageType> itRef(reference, region);
+  unsigned int                                      k = 0;
+  for (itProd.GoToBegin(), itRef.GoToBegin(); !itProd.IsAtEnd(); ++itProd, ++itRef, ++k)
+  {
+    const LabelType ref  = refCycle[(k / 3) % 5];
+    const LabelType prod = (k % 7 == 0) ? 70000 : (k % 11 == 0 ? refCycle[(k / 3 + 1) % 5] : ref);
+    itRef.Set(ref);
+    itProd.Set(prod);
+    if (ref != noData && prod != noData)
+    {
+      ++expected[ref][prod];
+    }
+  }
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(produced);
+  filter->SetReferenceImage(reference);
+  filter->SetNoDataLabel(noData);
+  filter->SetReferenceNoDataLabel(noData);
+  filter->GetStreamer()->SetNumberOfLinesStrippedStreaming(5);
+  filter->Update();
+
+  const FilterType::LabelListType& refLabels  = filter->GetReferenceLabels();
+  const FilterType::LabelListType& prodLabels = filter->GetProducedLabels();
+  const FilterType::MatrixType&    matrix     = filter->GetMatrix();
+
+  std::cout << "Confusion matrix:" << std::endl << matrix << std::endl;
+
+  if (refLabels.size() != expected.size() || matrix.Rows() != refLabels.size() || matrix.Cols() != prodLabels.size())
+  {
+    std::cerr << "Wrong number of labels: " << refLabels.size() << " reference, " << prodLabels.size() << " produced" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  unsigned long total = 0;
+  for (unsigned int r = 0; r < refLabels.size(); ++r)
+  {
+    for (unsigned int p = 0; p < prodLabels.size(); ++p)
+    {
+      const unsigned long count = expected[refLabels[r]][prodLabels[p]];
+      if (matrix(r, p) != count)
+      {
+        std::cerr << "Wrong count for (" << refLabels[r] << ", " << prodLabels[p] << "): " << matrix(r, p) << " instead of " << count << std::endl;
+        return EXIT_FAILURE;
+      }
+      total += count;
+    }
+  }
+
+  // Every non-nodata pair must have been seen
+  unsigned long expectedTotal = 0;
+  for (const auto& row : expected)
+  {
+    for (const auto& cell : row.second)
+    {
+      expectedTotal += cell.second;
+    }
+  }
+  if (total != expectedTotal)
+  {
+    std::cerr << "Wrong total: " << total << " instead of " << expectedTotal << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
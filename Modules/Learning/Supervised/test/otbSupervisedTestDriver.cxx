@@ -32,6 +32,7 @@ void RegisterTests()
   REGISTER_TEST(otbConfusionMatrixCalculatorComputeWithBaseline);
   REGISTER_TEST(otbConfusionMatrixMeasurementsTest);
   REGISTER_TEST(otbConfusionMatrixConcatenateTest);
+  REGISTER_TEST(otbStreamingConfusionMatrixImageFilter);
   REGISTER_TEST(otbExhaustiveExponentialOptimizerTest);
 
 #ifdef OTB_USE_LIBSVM
@@ -54,6 +55,10 @@ void RegisterTests()
   REGISTER_TEST(otbSVMMachineLearningModel);
   REGISTER_TEST(otbKNearestNeighborsMachineLearningModel);
   REGISTER_TEST(otbRandomForestsMachineLearningModel);
+  REGISTER_TEST(otbRandomForestsFlatInference);
+  REGISTER_TEST(otbRandomForestsBinaryModel);
+  REGISTER_TEST(otbBoostBinaryModel);
+  REGISTER_TEST(otbDecisionTreeBinaryModel);
   REGISTER_TEST(otbBoostMachineLearningModel);
   REGISTER_TEST(otbANNMachineLearningModel);
   REGISTER_TEST(otbNormalBayesMachineLearningModel);
@@ -227,6 +227,148 @@ void SetupModel(RandomForestType* model)
   model->SetPriors(priors);
 }
 
+int otbRandomForestsFlatInference(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::cout << "Wrong number of arguments " << std::endl;
+    std::cout << "Usage : sample file, output file " << std::endl;
+    return EXIT_FAILURE;
+  }
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  if (!otb::ReadDataFile(argv[1], samples, labels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  RandomForestType::Pointer classifier = RandomForestType::New();
+  classifier->SetInputListSample(samples);
+  classifier->SetTargetListSample(labels);
+  SetupModel<RandomForestType>(classifier);
+  classifier->Train();
+  classifier->Save(argv[2]);
+
+  // Predictions of the flattened forest
+  RandomForestType::Pointer classifierLoad = RandomForestType::New();
+  classifierLoad->Load(argv[2]);
+  TargetListSampleType::Pointer predicted = classifierLoad->PredictBatch(samples, NULL);
+
+  // Reference predictions from OpenCV
+  cv::Ptr<otb::CvRTreesWrapper> reference = otb::CvRTreesWrapper::create();
+  cv::FileStorage               fs(argv[2], cv::FileStorage::READ);
+  reference->read(fs.getFirstTopLevelNode());
+
+  otb::FlatRandomForest flatForest;
+  if (!flatForest.Build(*reference))
+  {
+    std::cout << "The forest could not be flattened" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  unsigned int nbErrors = 0;
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    cv::Mat sample;
+    otb::SampleToMat<InputSampleType>(samples->GetMeasurementVector(i), sample);
+    const TargetValueType expected = static_cast<TargetValueType>(reference->predict(sample));
+    if (predicted->GetMeasurementVector(i)[0] != expected)
+      ++nbErrors;
+  }
+
+  if (nbErrors != 0)
+  {
+    std::cout << nbErrors << " predictions of the flat forest differ from OpenCV ones" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Same predictions when the samples are read from a contiguous buffer
+  const unsigned int           nbFeatures = samples->GetMeasurementVectorSize();
+  std::vector<InputValueType>  buffer(samples->Size() * nbFeatures);
+  std::vector<TargetValueType> bufferLabels(samples->Size());
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    const InputSampleType& sample = samples->GetMeasurementVector(i);
+    for (unsigned int j = 0; j < nbFeatures; ++j)
+      buffer[i * nbFeatures + j] = sample[j];
+  }
+  classifierLoad->PredictBatch(buffer.data(), samples->Size(), nbFeatures, nbFeatures, bufferLabels.data());
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    if (predicted->GetMeasurementVector(i)[0] != bufferLabels[i])
+    {
+      std::cout << "Buffer prediction of sample " << i << " differs from the list sample one" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Early termination only skips trees that can not change the labels
+  classifierLoad->EarlyTerminationOn();
+  std::vector<RandomForestType::ConfidenceValueType> confidences(samples->Size());
+  classifierLoad->PredictBatch(buffer.data(), samples->Size(), nbFeatures, nbFeatures, bufferLabels.data(), confidences.data());
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    if (predicted->GetMeasurementVector(i)[0] != bufferLabels[i] || confidences[i] <= 0. || confidences[i] > 1.)
+    {
+      std::cout << "Early terminated prediction of sample " << i << " differs from the full one" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int otbRandomForestsBinaryModel(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::cout << "Wrong number of arguments " << std::endl;
+    std::cout << "Usage : sample file, output file " << std::endl;
+    return EXIT_FAILURE;
+  }
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  if (!otb::ReadDataFile(argv[1], samples, labels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  RandomForestType::Pointer classifier = RandomForestType::New();
+  classifier->SetInputListSample(samples);
+  classifier->SetTargetListSample(labels);
+  SetupModel<RandomForestType>(classifier);
+  classifier->Train();
+  classifier->BinaryModelOn();
+  classifier->Save(argv[2]);
+  TargetListSampleType::Pointer expected = classifier->PredictBatch(samples, NULL);
+
+  RandomForestType::Pointer classifierLoad = RandomForestType::New();
+  if (!classifierLoad->CanReadFile(argv[2]))
+  {
+    std::cout << "The binary model is not recognized" << std::endl;
+    return EXIT_FAILURE;
+  }
+  classifierLoad->Load(argv[2]);
+  TargetListSampleType::Pointer predicted = classifierLoad->PredictBatch(samples, NULL);
+
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    if (predicted->GetMeasurementVector(i)[0] != expected->GetMeasurementVector(i)[0])
+    {
+      std::cout << "Prediction of sample " << i << " differs after reloading the binary model" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // Half precision thresholds only need to give a readable model
+  classifier->HalfPrecisionThresholdsOn();
+  classifier->Save(argv[2]);
+  classifierLoad->Load(argv[2]);
+  classifierLoad->PredictBatch(samples, NULL);
+  return EXIT_SUCCESS;
+}
+
 using BoostType = otb::BoostMachineLearningModel<InputValueType, TargetValueType>;
 int otbBoostMachineLearningModel(int argc, char* argv[])
 {
@@ -248,6 +390,97 @@ void SetupModel(BoostType* model)
   model->SetTargetListSample(labels);
 }
 
+using DecisionTreeType = otb::DecisionTreeMachineLearningModel<InputValueType, TargetValueType>;
+
+// Check the flattened trees against OpenCV, then the binary model against the flattened trees
+template <class TModel, class TCvModel>
+int otbFlatTreesBinaryModel(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::cout << "Wrong number of arguments " << std::endl;
+    std::cout << "Usage : sample file, output file, binary output file " << std::endl;
+    return EXIT_FAILURE;
+  }
+  InputListSampleType::Pointer  samples = InputListSampleType::New();
+  TargetListSampleType::Pointer labels  = TargetListSampleType::New();
+  if (!otb::ReadDataFile(argv[1], samples, labels))
+  {
+    std::cout << "Failed to read samples file " << argv[1] << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  typename TModel::Pointer classifier = TModel::New();
+  classifier->SetInputListSample(samples);
+  classifier->SetTargetListSample(labels);
+  SetupModel<TModel>(classifier);
+  classifier->Train();
+  classifier->Save(argv[2]);
+  TargetListSampleType::Pointer predicted = classifier->PredictBatch(samples, NULL);
+
+  // Reference predictions from OpenCV
+  cv::Ptr<TCvModel> reference = TCvModel::create();
+  cv::FileStorage   fs(argv[2], cv::FileStorage::READ);
+  reference->read(fs.getFirstTopLevelNode());
+
+  unsigned int nbErrors = 0;
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    cv::Mat sample;
+    otb::SampleToMat<InputSampleType>(samples->GetMeasurementVector(i), sample);
+    const TargetValueType expected = static_cast<TargetValueType>(reference->predict(sample));
+    if (predicted->GetMeasurementVector(i)[0] != expected)
+      ++nbErrors;
+  }
+  if (nbErrors != 0)
+  {
+    std::cout << nbErrors << " predictions of the flat trees differ from OpenCV ones" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  classifier->BinaryModelOn();
+  classifier->Save(argv[3]);
+
+  typename TModel::Pointer classifierLoad = TModel::New();
+  if (!classifierLoad->CanReadFile(argv[3]))
+  {
+    std::cout << "The binary model is not recognized" << std::endl;
+    return EXIT_FAILURE;
+  }
+  classifierLoad->Load(argv[3]);
+
+  // Buffer predictions of the reloaded binary model
+  const unsigned int           nbFeatures = samples->GetMeasurementVectorSize();
+  std::vector<InputValueType>  buffer(samples->Size() * nbFeatures);
+  std::vector<TargetValueType> bufferLabels(samples->Size());
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    const InputSampleType& sample = samples->GetMeasurementVector(i);
+    for (unsigned int j = 0; j < nbFeatures; ++j)
+      buffer[i * nbFeatures + j] = sample[j];
+  }
+  classifierLoad->PredictBatch(buffer.data(), samples->Size(), nbFeatures, nbFeatures, bufferLabels.data());
+  for (unsigned int i = 0; i < samples->Size(); ++i)
+  {
+    if (predicted->GetMeasurementVector(i)[0] != bufferLabels[i])
+    {
+      std::cout << "Prediction of sample " << i << " differs after reloading the binary model" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+  return EXIT_SUCCESS;
+}
+
+int otbBoostBinaryModel(int argc, char* argv[])
+{
+  return otbFlatTreesBinaryModel<BoostType, cv::ml::Boost>(argc, argv);
+}
+
+int otbDecisionTreeBinaryModel(int argc, char* argv[])
+{
+  return otbFlatTreesBinaryModel<DecisionTreeType, cv::ml::DTrees>(argc, argv);
+}
+
 using ANNType = otb::NeuralNetworkMachineLearningModel<InputValueType, TargetValueType>;
 int otbANNMachineLearningModel(int argc, char* argv[])
 {
@@ -271,7 +504,6 @@ int otbNormalBayesMachineLearningModel(int argc, char* argv[])
   return otbGenericMachineLearningModel<NormalBayesType>(argc, argv);
 }
 
-using DecisionTreeType = otb::DecisionTreeMachineLearningModel<InputValueType, TargetValueType>;
 int otbDecisionTreeMachineLearningModel(int argc, char* argv[])
 {
   return otbGenericMachineLearningModel<DecisionTreeType>(argc, argv);
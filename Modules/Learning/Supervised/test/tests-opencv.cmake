@@ -70,6 +70,18 @@ otb_add_test(NAME leTvRandomForestsMachineLearningModel COMMAND otbSupervisedTes
   ${TEMP}/rf_model.txt
   )
 
+otb_add_test(NAME leTvRandomForestsFlatInference COMMAND otbSupervisedTestDriver
+  otbRandomForestsFlatInference
+  ${INPUTDATA}/letter_light.scale
+  ${TEMP}/rf_flat_model.txt
+  )
+
+otb_add_test(NAME leTvRandomForestsBinaryModel COMMAND otbSupervisedTestDriver
+  otbRandomForestsBinaryModel
+  ${INPUTDATA}/letter_light.scale
+  ${TEMP}/rf_binary_model.rfb
+  )
+
 otb_add_test(NAME leTvKNearestNeighborsMachineLearningModel COMMAND otbSupervisedTestDriver
   otbKNearestNeighborsMachineLearningModel
   ${INPUTDATA}/letter_light.scale
@@ -88,6 +100,20 @@ otb_add_test(NAME leTvBoostMachineLearningModel COMMAND otbSupervisedTestDriver
   ${TEMP}/boost_model.txt
   )
 
+otb_add_test(NAME leTvDecisionTreeBinaryModel COMMAND otbSupervisedTestDriver
+  otbDecisionTreeBinaryModel
+  ${INPUTDATA}/letter_light.scale
+  ${TEMP}/decisiontree_flat_model.txt
+  ${TEMP}/decisiontree_binary_model.dtb
+  )
+
+otb_add_test(NAME leTvBoostBinaryModel COMMAND otbSupervisedTestDriver
+  otbBoostBinaryModel
+  ${INPUTDATA}/letter_light.scale
+  ${TEMP}/boost_flat_model.txt
+  ${TEMP}/boost_binary_model.bb
+  )
+
 otb_add_test(NAME leTvImageClassificationFilterSVM COMMAND otbSupervisedTestDriver
   --compare-image ${NOTOL}
   ${BASELINE}/leImageClassificationFilterSVMOutput.tif
@@ -26,6 +26,9 @@
 #include "itkMacro.h"
 #include "itkObjectFactory.h"
 
+#include <string>
+#include <vector>
+
 namespace otb
 {
 
@@ -67,6 +70,16 @@ public:
   /** Blocks until all processes have reached this routine */
   void barrier();
 
+  /** Gathers a buffer from every process on the root process. The root
+   * gets the buffers ordered by rank, the other processes an empty list. */
+  std::vector<std::string> gather(const std::string& buffer, unsigned int root = 0);
+
+  /** Gathers a buffer from every process on all of them, ordered by rank */
+  std::vector<std::string> allGather(const std::string& buffer);
+
+  /** Sends the buffer of the root process to all the other ones */
+  void broadcast(std::string& buffer, unsigned int root = 0);
+
   /** Log error */
   void logError(const std::string& message);
 
@@ -0,0 +1,88 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMPITaskScheduler_h
+#define otbMPITaskScheduler_h
+
+#include "itkObject.h"
+#include "itkMacro.h"
+#include "itkObjectFactory.h"
+
+#include <memory>
+
+namespace otb
+{
+
+/** \class MPITaskScheduler
+ *  \brief Hands out task indices to the MPI processes on demand
+ *
+ * Instead of a static round-robin assignment, each process claims the next
+ * task when it is done with the previous one, so that processes getting
+ * cheap tasks take more of them. The task counter lives on the root
+ * process and is incremented with one-sided atomic operations (MPI-3),
+ * which avoids dedicating a process to the distribution.
+ *
+ * Start() and Stop() must be called by all the processes. Stop() logs the
+ * number of tasks and the time spent on them by each process.
+ *
+ * \ingroup OTBMPIConfig
+ */
+class MPITaskScheduler : public itk::LightObject
+{
+public:
+  /** Standard class typedefs. */
+  typedef MPITaskScheduler              Self;
+  typedef itk::LightObject              Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(MPITaskScheduler, itk::LightObject);
+
+  /** Start handing out the tasks 0 to numberOfTasks - 1 */
+  void Start(unsigned long numberOfTasks);
+
+  /** Claim the next task. Returns the number of tasks once all of them
+   *  have been claimed */
+  unsigned long Next();
+
+  /** Stop handing out tasks */
+  void Stop();
+
+  /** Number of tasks claimed by this process since Start() */
+  unsigned long GetNumberOfClaimedTasks() const;
+
+protected:
+  MPITaskScheduler();
+  virtual ~MPITaskScheduler();
+
+private:
+  MPITaskScheduler(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  struct Internals;
+  std::unique_ptr<Internals> m_Internals;
+};
+
+} // End namespace otb
+
+#endif
@@ -31,6 +31,7 @@ otb_module(OTBMPIConfig
     OTBImageBase
     OTBImageManipulation
     OTBMPITiffWriter
+    OTBStatistics
     OTBTestKernel
   DESCRIPTION
     "${DOCUMENTATION}"
@@ -19,6 +19,7 @@
  */
 
 #include "otbMPIConfig.h"
+#include "otbProcessGroup.h"
 
 #include <exception>
 #include <cstdlib>
@@ -58,6 +59,51 @@
 namespace otb
 {
 
+namespace
+{
+/** Processes of MPI_COMM_WORLD, used to distribute persistent filters */
+class MPIProcessGroup : public ProcessGroup
+{
+public:
+  typedef MPIProcessGroup         Self;
+  typedef itk::SmartPointer<Self> Pointer;
+
+  itkNewMacro(Self);
+
+  itkTypeMacro(MPIProcessGroup, ProcessGroup);
+
+  unsigned int GetRank() const override
+  {
+    return MPIConfig::Instance()->GetMyRank();
+  }
+
+  unsigned int GetSize() const override
+  {
+    return MPIConfig::Instance()->GetNbProcs();
+  }
+
+  void AllReduceSum(double* buffer, std::size_t size) override
+  {
+    OTB_MPI_CHECK_RESULT(MPI_Allreduce, (MPI_IN_PLACE, buffer, static_cast<int>(size), MPI_DOUBLE, MPI_SUM, MPI_COMM_WORLD));
+  }
+
+  void AllReduceMin(double* buffer, std::size_t size) override
+  {
+    OTB_MPI_CHECK_RESULT(MPI_Allreduce, (MPI_IN_PLACE, buffer, static_cast<int>(size), MPI_DOUBLE, MPI_MIN, MPI_COMM_WORLD));
+  }
+
+  void AllReduceMax(double* buffer, std::size_t size) override
+  {
+    OTB_MPI_CHECK_RESULT(MPI_Allreduce, (MPI_IN_PLACE, buffer, static_cast<int>(size), MPI_DOUBLE, MPI_MAX, MPI_COMM_WORLD));
+  }
+
+  std::vector<std::string> AllGather(const std::string& buffer) override
+  {
+    return MPIConfig::Instance()->allGather(buffer);
+  }
+};
+}
+
 /** Initialize the singleton */
 MPIConfig::Pointer MPIConfig::m_Singleton = NULL;
 
@@ -130,6 +176,12 @@ void MPIConfig::Init(int& argc, char**& argv, bool abortOnException)
     }
 
     m_NbProcs = static_cast<unsigned int>(inbprocs);
+
+    // Persistent filters share the streaming among the processes
+    if (m_NbProcs > 1)
+    {
+      ProcessGroup::SetDefault(MPIProcessGroup::New());
+    }
   }
 }
 
@@ -138,6 +190,7 @@ void MPIConfig::terminate()
 {
   if (m_initialized && !m_terminated)
   {
+    ProcessGroup::SetDefault(nullptr);
     if (std::uncaught_exception() && m_abortOnException)
     {
       abort(EXIT_FAILURE);
@@ -165,6 +218,68 @@ void MPIConfig::barrier()
   OTB_MPI_CHECK_RESULT(MPI_Barrier, (MPI_COMM_WORLD));
 }
 
+std::vector<std::string> MPIConfig::gather(const std::string& buffer, unsigned int root)
+{
+  int size = static_cast<int>(buffer.size());
+
+  std::vector<int> sizes(m_MyRank == root ? m_NbProcs : 0);
+  OTB_MPI_CHECK_RESULT(MPI_Gather, (&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, static_cast<int>(root), MPI_COMM_WORLD));
+
+  std::vector<int> displacements(sizes.size(), 0);
+  for (std::size_t i = 1; i < sizes.size(); ++i)
+  {
+    displacements[i] = displacements[i - 1] + sizes[i - 1];
+  }
+  std::vector<char> data(sizes.empty() ? 0 : displacements.back() + sizes.back());
+
+  OTB_MPI_CHECK_RESULT(MPI_Gatherv, (const_cast<char*>(buffer.data()), size, MPI_CHAR, data.data(), sizes.data(), displacements.data(), MPI_CHAR,
+                                     static_cast<int>(root), MPI_COMM_WORLD));
+
+  std::vector<std::string> buffers;
+  for (std::size_t i = 0; i < sizes.size(); ++i)
+  {
+    buffers.emplace_back(data.data() + displacements[i], sizes[i]);
+  }
+  return buffers;
+}
+
+std::vector<std::string> MPIConfig::allGather(const std::string& buffer)
+{
+  int size = static_cast<int>(buffer.size());
+
+  std::vector<int> sizes(m_NbProcs);
+  OTB_MPI_CHECK_RESULT(MPI_Allgather, (&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, MPI_COMM_WORLD));
+
+  std::vector<int> displacements(sizes.size(), 0);
+  for (std::size_t i = 1; i < sizes.size(); ++i)
+  {
+    displacements[i] = displacements[i - 1] + sizes[i - 1];
+  }
+  std::vector<char> data(displacements.back() + sizes.back());
+
+  OTB_MPI_CHECK_RESULT(MPI_Allgatherv,
+                       (const_cast<char*>(buffer.data()), size, MPI_CHAR, data.data(), sizes.data(), displacements.data(), MPI_CHAR, MPI_COMM_WORLD));
+
+  std::vector<std::string> buffers;
+  for (std::size_t i = 0; i < sizes.size(); ++i)
+  {
+    buffers.emplace_back(data.data() + displacements[i], sizes[i]);
+  }
+  return buffers;
+}
+
+void MPIConfig::broadcast(std::string& buffer, unsigned int root)
+{
+  int size = static_cast<int>(buffer.size());
+  OTB_MPI_CHECK_RESULT(MPI_Bcast, (&size, 1, MPI_INT, static_cast<int>(root), MPI_COMM_WORLD));
+
+  buffer.resize(size);
+  if (size > 0)
+  {
+    OTB_MPI_CHECK_RESULT(MPI_Bcast, (&buffer[0], size, MPI_CHAR, static_cast<int>(root), MPI_COMM_WORLD));
+  }
+}
+
 void MPIConfig::logError(const std::string& message)
 {
   if (m_MyRank == 0)
@@ -0,0 +1,177 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMPITaskScheduler.h"
+#include "otbMPIConfig.h"
+#include "otbStopwatch.h"
+
+#include <algorithm>
+#include <sstream>
+
+#if defined(__GNUC__) || defined(__clang__)
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wunused-parameter"
+#pragma GCC diagnostic ignored "-Wcast-align"
+#include <mpi.h>
+#pragma GCC diagnostic pop
+#else
+#include <mpi.h>
+#endif
+
+/**
+  * Call the MPI routine MPIFunc with arguments Args (surrounded by
+  * parentheses). If the result is not MPI_SUCCESS, throw an exception.
+  */
+#define OTB_MPI_CHECK_RESULT(MPIFunc, Args)                                 \
+  {                                                                         \
+    int _result = MPIFunc Args;                                             \
+    if (_result != MPI_SUCCESS)                                             \
+    {                                                                       \
+      std::stringstream message;                                            \
+      message << "otb::ERROR: " << #MPIFunc << " (Code = " << _result;      \
+      ::itk::ExceptionObject _e(__FILE__, __LINE__, message.str().c_str()); \
+      throw _e;                                                             \
+    }                                                                       \
+  }
+
+namespace otb
+{
+
+struct MPITaskScheduler::Internals
+{
+  // Window exposing the counter of the root process
+  MPI_Win window = MPI_WIN_NULL;
+  // Next task to claim (only used on the root process)
+  unsigned long counter = 0;
+
+  unsigned long  numberOfTasks = 0;
+  unsigned long  claimedTasks  = 0;
+  otb::Stopwatch chrono;
+  bool           started = false;
+  bool           done    = false;
+};
+
+MPITaskScheduler::MPITaskScheduler() : m_Internals(new Internals)
+{
+}
+
+MPITaskScheduler::~MPITaskScheduler()
+{
+  if (m_Internals->window != MPI_WIN_NULL)
+  {
+    MPI_Win_free(&m_Internals->window);
+  }
+}
+
+void MPITaskScheduler::Start(unsigned long numberOfTasks)
+{
+  const bool isRoot = MPIConfig::Instance()->GetMyRank() == 0;
+
+  m_Internals->counter       = 0;
+  m_Internals->numberOfTasks = numberOfTasks;
+  m_Internals->claimedTasks  = 0;
+  m_Internals->started       = true;
+  m_Internals->done          = false;
+  m_Internals->chrono        = otb::Stopwatch::StartNew();
+
+  // A single process does not need a window
+  if (MPIConfig::Instance()->GetNbProcs() > 1)
+  {
+    OTB_MPI_CHECK_RESULT(MPI_Win_create, (isRoot ? &m_Internals->counter : nullptr, isRoot ? sizeof(unsigned long) : 0, sizeof(unsigned long),
+                                          MPI_INFO_NULL, MPI_COMM_WORLD, &m_Internals->window));
+  }
+}
+
+unsigned long MPITaskScheduler::Next()
+{
+  if (!m_Internals->started)
+  {
+    itkExceptionMacro(<< "Tasks are claimed before Start()");
+  }
+
+  unsigned long task = m_Internals->numberOfTasks;
+  if (!m_Internals->done && m_Internals->window == MPI_WIN_NULL)
+  {
+    task = m_Internals->counter++;
+  }
+  else if (!m_Internals->done)
+  {
+    const unsigned long one = 1;
+    OTB_MPI_CHECK_RESULT(MPI_Win_lock, (MPI_LOCK_SHARED, 0, 0, m_Internals->window));
+    OTB_MPI_CHECK_RESULT(MPI_Fetch_and_op, (&one, &task, MPI_UNSIGNED_LONG, 0, 0, MPI_SUM, m_Internals->window));
+    OTB_MPI_CHECK_RESULT(MPI_Win_unlock, (0, m_Internals->window));
+  }
+
+  if (task < m_Internals->numberOfTasks)
+  {
+    ++m_Internals->claimedTasks;
+    return task;
+  }
+
+  // All the tasks are claimed, this process is done
+  if (!m_Internals->done)
+  {
+    m_Internals->chrono.Stop();
+    m_Internals->done = true;
+  }
+  return m_Internals->numberOfTasks;
+}
+
+void MPITaskScheduler::Stop()
+{
+  if (!m_Internals->started)
+  {
+    return;
+  }
+
+  if (m_Internals->window != MPI_WIN_NULL)
+  {
+    OTB_MPI_CHECK_RESULT(MPI_Win_free, (&m_Internals->window));
+    m_Internals->window = MPI_WIN_NULL;
+  }
+  m_Internals->started = false;
+  m_Internals->chrono.Stop();
+
+  // Report the balance between processes
+  std::ostringstream oss;
+  oss << m_Internals->claimedTasks << " " << m_Internals->chrono.GetElapsedMilliseconds();
+  std::vector<std::string> reports = MPIConfig::Instance()->gather(oss.str(), 0);
+
+  std::ostringstream message;
+  message << "Dynamic assignment of " << m_Internals->numberOfTasks << " tasks:";
+  for (std::size_t rank = 0; rank < reports.size(); ++rank)
+  {
+    std::istringstream iss(reports[rank]);
+    unsigned long      tasks = 0, duration = 0;
+    iss >> tasks >> duration;
+    message << "\n  rank " << rank << ": " << tasks << " tasks, done after " << duration << " ms";
+  }
+  if (!reports.empty())
+  {
+    MPIConfig::Instance()->logInfo(message.str());
+  }
+}
+
+unsigned long MPITaskScheduler::GetNumberOfClaimedTasks() const
+{
+  return m_Internals->claimedTasks;
+}
+
+} // End namespace otb
@@ -0,0 +1,71 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMPIConfig.h"
+#include <iostream>
+#include <sstream>
+
+int otbMPIConfigCollectiveTest(int argc, char* argv[])
+{
+  otb::MPIConfig::Pointer config = otb::MPIConfig::Instance();
+  config->Init(argc, argv, true);
+
+  const unsigned int rank    = config->GetMyRank();
+  const unsigned int nbProcs = config->GetNbProcs();
+
+  // Buffers of different sizes, including an empty one on rank 0
+  const std::string buffer(rank, static_cast<char>('a' + rank % 26));
+
+  std::vector<std::string> all = config->allGather(buffer);
+  if (all.size() != nbProcs)
+  {
+    std::cerr << "Rank " << rank << ": allGather returned " << all.size() << " buffers" << std::endl;
+    return EXIT_FAILURE;
+  }
+  for (unsigned int r = 0; r < nbProcs; ++r)
+  {
+    if (all[r] != std::string(r, static_cast<char>('a' + r % 26)))
+    {
+      std::cerr << "Rank " << rank << ": wrong buffer from rank " << r << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::vector<std::string> gathered = config->gather(buffer, 0);
+  if ((rank == 0 && gathered != all) || (rank != 0 && !gathered.empty()))
+  {
+    std::cerr << "Rank " << rank << ": wrong gathered buffers" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  std::string message;
+  if (rank == 0)
+  {
+    message = "hello";
+  }
+  config->broadcast(message, 0);
+  if (message != "hello")
+  {
+    std::cerr << "Rank " << rank << ": wrong broadcast message " << message << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
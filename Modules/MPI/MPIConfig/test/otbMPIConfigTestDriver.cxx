@@ -23,4 +23,7 @@
 void RegisterTests()
 {
   REGISTER_TEST(otbMPIConfigTest);
+  REGISTER_TEST(otbMPIConfigCollectiveTest);
+  REGISTER_TEST(otbMPITaskSchedulerTest);
+  REGISTER_TEST(otbMPIDistributedStatisticsTest);
 }
@@ -0,0 +1,102 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMPIConfig.h"
+#include "otbProcessGroup.h"
+#include "otbVectorImage.h"
+#include "otbImageFileReader.h"
+#include "otbStreamingStatisticsVectorImageFilter.h"
+
+#include <cmath>
+#include <iostream>
+
+typedef otb::VectorImage<float>                                      ImageType;
+typedef otb::ImageFileReader<ImageType>                              ReaderType;
+typedef otb::StreamingStatisticsVectorImageFilter<ImageType, double> StatisticsFilterType;
+
+namespace
+{
+StatisticsFilterType::Pointer ComputeStatistics(ImageType* image)
+{
+  StatisticsFilterType::Pointer filter = StatisticsFilterType::New();
+  filter->SetInput(image);
+  filter->GetStreamer()->SetNumberOfDivisionsStrippedStreaming(7);
+  filter->Update();
+  return filter;
+}
+
+bool AreClose(double a, double b)
+{
+  return std::abs(a - b) <= 1e-9 * std::max(1., std::abs(b));
+}
+}
+
+int otbMPIDistributedStatisticsTest(int argc, char* argv[])
+{
+  otb::MPIConfig::Pointer config = otb::MPIConfig::Instance();
+  config->Init(argc, argv, true);
+
+  if (argc != 2)
+  {
+    std::cerr << "Usage: " << argv[0] << " inputImageFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  otb::ProcessGroup::Pointer group = otb::ProcessGroup::GetDefault();
+  if (config->GetNbProcs() > 1 && (group.IsNull() || group->GetSize() != config->GetNbProcs()))
+  {
+    std::cerr << "Rank " << config->GetMyRank() << ": no process group for " << config->GetNbProcs() << " processes" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  // Each process streams a part of the splits
+  StatisticsFilterType::Pointer distributed = ComputeStatistics(reader->GetOutput());
+
+  // Reference computed on the whole image by each process
+  otb::ProcessGroup::SetDefault(nullptr);
+  StatisticsFilterType::Pointer reference = ComputeStatistics(reader->GetOutput());
+  otb::ProcessGroup::SetDefault(group);
+
+  bool               ok      = true;
+  const unsigned int nbBands = reader->GetOutput()->GetNumberOfComponentsPerPixel();
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    ok = ok && distributed->GetMinimum()[band] == reference->GetMinimum()[band];
+    ok = ok && distributed->GetMaximum()[band] == reference->GetMaximum()[band];
+    ok = ok && AreClose(distributed->GetMean()[band], reference->GetMean()[band]);
+    for (unsigned int other = 0; other < nbBands; ++other)
+    {
+      ok = ok && AreClose(distributed->GetCovariance()(band, other), reference->GetCovariance()(band, other));
+    }
+  }
+
+  if (!ok)
+  {
+    std::cerr << "Rank " << config->GetMyRank() << ": distributed statistics differ from the reference" << std::endl;
+    std::cerr << "Mean: " << distributed->GetMean() << " instead of " << reference->GetMean() << std::endl;
+    std::cerr << "Covariance: " << distributed->GetCovariance() << " instead of " << reference->GetCovariance() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
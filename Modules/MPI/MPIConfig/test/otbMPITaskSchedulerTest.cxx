@@ -0,0 +1,84 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMPIConfig.h"
+#include "otbMPITaskScheduler.h"
+#include <chrono>
+#include <iostream>
+#include <sstream>
+#include <thread>
+
+int otbMPITaskSchedulerTest(int argc, char* argv[])
+{
+  otb::MPIConfig::Pointer config = otb::MPIConfig::Instance();
+  config->Init(argc, argv, true);
+
+  const unsigned int  rank          = config->GetMyRank();
+  const unsigned int  nbProcs       = config->GetNbProcs();
+  const unsigned long numberOfTasks = 12 * nbProcs;
+
+  otb::MPITaskScheduler::Pointer scheduler = otb::MPITaskScheduler::New();
+  scheduler->Start(numberOfTasks);
+
+  // The last process is slow: it should claim fewer tasks than the others
+  std::ostringstream claimed;
+  for (unsigned long task = scheduler->Next(); task < numberOfTasks; task = scheduler->Next())
+  {
+    claimed << task << " ";
+    const int duration = (nbProcs > 1 && rank == nbProcs - 1) ? 40 : 5;
+    std::this_thread::sleep_for(std::chrono::milliseconds(duration));
+  }
+  const unsigned long nbClaimed = scheduler->GetNumberOfClaimedTasks();
+  scheduler->Stop();
+
+  // Each task must have been claimed exactly once
+  std::vector<std::string>  all = config->allGather(claimed.str());
+  std::vector<unsigned int> counts(numberOfTasks, 0);
+  for (const auto& buffer : all)
+  {
+    std::istringstream iss(buffer);
+    unsigned long      task;
+    while (iss >> task)
+    {
+      if (task >= numberOfTasks)
+      {
+        std::cerr << "Rank " << rank << ": invalid task " << task << std::endl;
+        return EXIT_FAILURE;
+      }
+      ++counts[task];
+    }
+  }
+  for (unsigned long task = 0; task < numberOfTasks; ++task)
+  {
+    if (counts[task] != 1)
+    {
+      std::cerr << "Rank " << rank << ": task " << task << " claimed " << counts[task] << " times" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  if (nbProcs > 1 && rank == nbProcs - 1 && nbClaimed >= numberOfTasks / nbProcs)
+  {
+    std::cerr << "Rank " << rank << ": the slow process claimed " << nbClaimed << " tasks" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -27,6 +27,7 @@
 #include "otbStreamingManager.h"
 #include "otbExtendedFilenameToWriterOptions.h"
 #include "otbMPIConfig.h"
+#include "otbMPITaskScheduler.h"
 
 #include "itkImageFileWriter.h"
 
@@ -97,6 +98,15 @@ namespace otb
  * SimpleParallelTiffWriter implements a version of Simple Parallel Tiff Writer (SPTW,
  * D.M. Mattli, USGS)
  *
+ * Regions are written with independent MPI-IO operations by default, or with
+ * collective ones (see SetCollectiveWrite). DEFLATE compressed GeoTiff can be
+ * written as well (see SetTiffDeflateCompression): the streaming regions are
+ * then aligned on the GeoTiff blocks, so that each block is compressed by a
+ * single process.
+ *
+ * Streaming divisions are assigned in turn to the processes, or on demand
+ * (see SetDynamicSplitAssignment) when their cost is not uniform.
+ *
  * Splitting strategies are close to those implemented in ImageFileWriter, except
  * layout is optimized for the number of MPI processes for stripped regions.
  * TODO: optimize the splitting layout for tiled regions
@@ -251,6 +261,36 @@ public:
   itkSetMacro(TiffTiledMode, bool);
   itkGetMacro(TiffTiledMode, bool);
 
+  /** Rows per strip of DEFLATE compressed stripped GeoTiff */
+  itkSetMacro(TiffStripHeight, int);
+  itkGetMacro(TiffStripHeight, int);
+
+  /** Set/Get whether the GeoTiff blocks are DEFLATE compressed. Each
+   *  process compresses the blocks of its regions, which are appended with
+   *  collective writes and indexed in a shared offset table. Can also be
+   *  enabled with the gdal:co:COMPRESS=DEFLATE extended filename option */
+  itkSetMacro(TiffDeflateCompression, bool);
+  itkGetMacro(TiffDeflateCompression, bool);
+  itkSetMacro(TiffCompressionLevel, int);
+  itkGetMacro(TiffCompressionLevel, int);
+
+  /** Set/Get whether the regions are written with collective MPI-IO
+   *  operations: at each round, all the processes write their region in a
+   *  single call, letting MPI-IO aggregate the writes. Always used with
+   *  compression */
+  itkSetMacro(CollectiveWrite, bool);
+  itkGetMacro(CollectiveWrite, bool);
+  itkBooleanMacro(CollectiveWrite);
+
+  /** Set/Get whether each process claims the next streaming division when
+   *  it is done with the previous one, instead of the static round-robin
+   *  assignment. Defaults to the OTB_MPI_SPLIT_SCHEDULING environment
+   *  variable. Ignored with collective writes and compression, which need
+   *  the same number of rounds on all the processes */
+  itkSetMacro(DynamicSplitAssignment, bool);
+  itkGetMacro(DynamicSplitAssignment, bool);
+  itkBooleanMacro(DynamicSplitAssignment);
+
   /** This override doesn't return a const ref on the actual boolean */
   const bool& GetAbortGenerateData() const override;
 
@@ -296,6 +336,17 @@ private:
    */
   unsigned int OptimizeStrippedSplittingLayout(unsigned int n);
 
+  /*
+   * Apply the GeoTiff creation options of the extended filename
+   */
+  void ParseCreationOptions();
+
+  /*
+   * Writes a region (or nothing, if buffer is null, to take part in the
+   * collective operations) in the output raster
+   */
+  void WriteRegion(sptw::PTIFF* output_raster, void* buffer, const InputImageRegionType& region);
+
   unsigned int m_NumberOfDivisions;
   unsigned int m_CurrentDivision;
   float        m_DivisionProgress;
@@ -329,6 +380,14 @@ private:
   bool m_Verbose;
   bool m_VirtualMode;
   bool m_TiffTiledMode;
+  int  m_TiffStripHeight;
+  bool m_TiffDeflateCompression;
+  int  m_TiffCompressionLevel;
+  bool m_CollectiveWrite;
+  bool m_DynamicSplitAssignment;
+
+  /** Height of the GeoTiff blocks of the file being written */
+  int m_TiffBlockHeight;
 
   /** Lock to ensure thread-safety (added for the AbortGenerateData flag) */
   itk::SimpleFastMutexLock m_Lock;
@@ -24,6 +24,7 @@
 #include "otbSimpleParallelTiffWriter.h"
 #include "otbStopwatch.h"
 #include "otbUtils.h"
+#include "otbConfigurationManager.h"
 
 using std::vector;
 
@@ -61,6 +62,18 @@ SimpleParallelTiffWriter<TInputImage>::SimpleParallelTiffWriter()
   // Strip blocks
   m_TiffTiledMode = false;
 
+  // No compression, rows per strip when compressed
+  m_TiffDeflateCompression = false;
+  m_TiffCompressionLevel   = 6;
+  m_TiffStripHeight        = 64;
+  m_TiffBlockHeight        = 0;
+
+  // Independent writes
+  m_CollectiveWrite = false;
+
+  // Round-robin assignment of the divisions, unless configured otherwise
+  m_DynamicSplitAssignment = (otb::ConfigurationManager::GetMPISplitScheduling() == "dynamic");
+
   // Verbose
   m_Verbose = false;
 
@@ -180,6 +193,83 @@ void SimpleParallelTiffWriter<TInputImage>::SetAutomaticAdaptativeStreaming(unsi
   m_StreamingManager = streamingManager;
 }
 
+template <class TInputImage>
+void SimpleParallelTiffWriter<TInputImage>::ParseCreationOptions()
+{
+  for (const auto& option : m_FilenameHelper->GetgdalCreationOptions())
+  {
+    const std::string::size_type pos   = option.find('=');
+    const std::string            key   = boost::algorithm::to_upper_copy(option.substr(0, pos));
+    const std::string            value = pos == std::string::npos ? "" : option.substr(pos + 1);
+
+    if (key == "COMPRESS")
+    {
+      if (boost::iequals(value, "DEFLATE"))
+      {
+        m_TiffDeflateCompression = true;
+      }
+      else if (boost::iequals(value, "NONE"))
+      {
+        m_TiffDeflateCompression = false;
+      }
+      else
+      {
+        itkExceptionMacro(<< "Compression " << value << " is not supported for parallel writing, use DEFLATE or NONE");
+      }
+    }
+    else if (key == "ZLEVEL")
+    {
+      m_TiffCompressionLevel = std::max(1, std::min(9, atoi(value.c_str())));
+    }
+    else if (key == "TILED")
+    {
+      m_TiffTiledMode = boost::iequals(value, "YES") || boost::iequals(value, "TRUE") || value == "1";
+    }
+    else if (key == "BLOCKXSIZE")
+    {
+      m_TiffTileSize = atoi(value.c_str());
+    }
+    else if (key == "BLOCKYSIZE")
+    {
+      m_TiffStripHeight = atoi(value.c_str());
+    }
+    else
+    {
+      itkWarningMacro(<< "Creation option " << option << " is not supported for parallel writing, it will be ignored");
+    }
+  }
+}
+
+template <class TInputImage>
+void SimpleParallelTiffWriter<TInputImage>::WriteRegion(PTIFF* output_raster, void* buffer, const InputImageRegionType& region)
+{
+  // The raster only covers the written box
+  const int64_t ul_x = region.GetIndex()[0] - m_ShiftOutputIndex[0];
+  const int64_t ul_y = region.GetIndex()[1] - m_ShiftOutputIndex[1];
+  const int64_t lr_x = ul_x + region.GetSize()[0] - 1;
+  const int64_t lr_y = ul_y + region.GetSize()[1] - 1;
+
+  SPTW_ERROR sperr = sptw::SP_None;
+  if (m_TiffDeflateCompression)
+  {
+    sperr = sptw::write_compressed_area(output_raster, buffer, ul_x, ul_y, lr_x, lr_y, m_TiffBlockHeight, m_TiffBlockHeight, m_TiffTiledMode,
+                                        m_TiffCompressionLevel);
+  }
+  else if (m_CollectiveWrite)
+  {
+    sperr = sptw::write_area_collective(output_raster, buffer, ul_x, ul_y, lr_x, lr_y);
+  }
+  else if (buffer != nullptr)
+  {
+    sperr = sptw::write_area(output_raster, buffer, ul_x, ul_y, lr_x, lr_y);
+  }
+
+  if (sperr != sptw::SP_None)
+  {
+    itkExceptionMacro(<< "Error writing region " << region << " in " << m_FileName);
+  }
+}
+
 /**
  *
  */
@@ -390,6 +480,12 @@ void SimpleParallelTiffWriter<TInputImage>::Update()
     }
   }
 
+  /** Parse GeoTiff creation options */
+  if (m_FilenameHelper->gdalCreationOptionsIsSet())
+  {
+    this->ParseCreationOptions();
+  }
+
   this->SetAbortGenerateData(0);
   this->SetProgress(0.0);
 
@@ -508,7 +604,7 @@ void SimpleParallelTiffWriter<TInputImage>::Update()
    ************************************************************************/
 
   // First, compute the block size
-  int block_size_x = m_TiffTiledMode;
+  int block_size_x = m_TiffTileSize;
 
   if (m_TiffTiledMode)
   {
@@ -527,6 +623,9 @@ void SimpleParallelTiffWriter<TInputImage>::Update()
     block_size_x = inputRegion.GetSize()[0];
   }
 
+  // Height of the blocks, used to align compressed writes
+  m_TiffBlockHeight = m_TiffTiledMode ? block_size_x : std::max(1, std::min(m_TiffStripHeight, static_cast<int>(inputRegion.GetSize()[1])));
+
   // Master process (Rank 0) is responsible for the creation of the output raster.
   if (otb::MPIConfig::Instance()->GetMyRank() == 0 && !m_VirtualMode)
   {
@@ -540,7 +639,18 @@ void SimpleParallelTiffWriter<TInputImage>::Update()
     geotransform[5] = inputPtr->GetSignedSpacing()[1];
 
     // Call SPTW routine that creates the output raster
-    if (!m_TiffTiledMode)
+    if (m_TiffDeflateCompression)
+    {
+      SPTW_ERROR sperr = sptw::create_compressed_raster(m_FileName, inputRegion.GetSize()[0], inputRegion.GetSize()[1], nBands, dataType, geotransform,
+                                                        inputPtr->GetProjectionRef(), block_size_x, m_TiffBlockHeight, m_TiffTiledMode,
+                                                        m_TiffCompressionLevel);
+      if (sperr != sptw::SP_None)
+      {
+        itkExceptionMacro(<< "Error creating raster");
+        otb::MPIConfig::Instance()->abort(EXIT_FAILURE);
+      }
+    }
+    else if (!m_TiffTiledMode)
     {
       SPTW_ERROR sperr =
           sptw::create_raster(m_FileName, inputRegion.GetSize()[0], inputRegion.GetSize()[1], nBands, dataType, geotransform, inputPtr->GetProjectionRef());
@@ -575,8 +685,8 @@ void SimpleParallelTiffWriter<TInputImage>::Update()
   {
     output_raster = open_raster(m_FileName);
 
-    // First, populate blocks offsets
-    if (otb::MPIConfig::Instance()->GetMyRank() == 0)
+    // First, populate blocks offsets (compressed blocks are indexed once written)
+    if (otb::MPIConfig::Instance()->GetMyRank() == 0 && !m_TiffDeflateCompression)
     {
       SPTW_ERROR sperr = populate_tile_offsets(output_raster, block_size_x, m_TiffTiledMode);
       if (sperr != sptw::SP_None)
@@ -622,6 +732,36 @@ void SimpleParallelTiffWriter<TInputImage>::Update()
   m_NumberOfDivisions = m_StreamingManager->GetNumberOfSplits();
   // [/dirtycode]
 
+  // Compressed blocks must be written by a single process: align the strips
+  // on the GeoTiff blocks
+  unsigned int linesPerDivision = 0;
+  if (m_TiffDeflateCompression)
+  {
+    const unsigned int nbLines = inputRegion.GetSize()[1];
+    linesPerDivision           = (nbLines + m_NumberOfDivisions - 1) / m_NumberOfDivisions;
+    linesPerDivision           = (linesPerDivision + m_TiffBlockHeight - 1) / m_TiffBlockHeight * m_TiffBlockHeight;
+    m_NumberOfDivisions        = (nbLines + linesPerDivision - 1) / linesPerDivision;
+  }
+
+  // With collective writes, every process takes part in each round of
+  // writes, even when it has no region left
+  const bool         collectiveWrite = !m_VirtualMode && (m_CollectiveWrite || m_TiffDeflateCompression);
+  const unsigned int nbProcs         = std::max(otb::MPIConfig::Instance()->GetNbProcs(), 1u);
+  const unsigned int numberOfRounds  = (m_NumberOfDivisions + nbProcs - 1) / nbProcs;
+  unsigned int       processedRounds = 0;
+
+  // Divisions are claimed on demand when dynamic assignment is enabled
+  MPITaskScheduler::Pointer scheduler;
+  if (m_DynamicSplitAssignment && collectiveWrite)
+  {
+    itkWarningMacro(<< "Dynamic assignment of the divisions is not available with collective writes or compression. Using static assignment.");
+  }
+  else if (m_DynamicSplitAssignment && nbProcs > 1)
+  {
+    scheduler = MPITaskScheduler::New();
+    scheduler->Start(m_NumberOfDivisions);
+  }
+
   // Configure process objects
   this->UpdateProgress(0);
   m_CurrentDivision  = 0;
@@ -652,12 +792,21 @@ void SimpleParallelTiffWriter<TInputImage>::Update()
   // Loop on streaming tiles
   double               processDuration(0), writeDuration(0), numberOfProcessedRegions(0);
   InputImageRegionType streamRegion;
-  for (m_CurrentDivision = 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
-       m_CurrentDivision++, m_DivisionProgress = 0, this->UpdateFilterProgress())
+  for (m_CurrentDivision = scheduler ? scheduler->Next() : 0; m_CurrentDivision < m_NumberOfDivisions && !this->GetAbortGenerateData();
+       m_CurrentDivision = scheduler ? scheduler->Next() : m_CurrentDivision + 1, m_DivisionProgress = 0, this->UpdateFilterProgress())
   {
-    streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    if (m_TiffDeflateCompression)
+    {
+      streamRegion = inputRegion;
+      streamRegion.SetIndex(1, inputRegion.GetIndex()[1] + m_CurrentDivision * linesPerDivision);
+      streamRegion.SetSize(1, std::min(linesPerDivision, static_cast<unsigned int>(inputRegion.GetSize()[1] - m_CurrentDivision * linesPerDivision)));
+    }
+    else
+    {
+      streamRegion = m_StreamingManager->GetSplit(m_CurrentDivision);
+    }
 
-    if (GetProcFromDivision(m_CurrentDivision) == otb::MPIConfig::Instance()->GetMyRank())
+    if (scheduler || GetProcFromDivision(m_CurrentDivision) == otb::MPIConfig::Instance()->GetMyRank())
     {
       /*
        * Processing
@@ -674,11 +823,25 @@ void SimpleParallelTiffWriter<TInputImage>::Update()
       otb::Stopwatch writingTime = otb::Stopwatch::StartNew();
       if (!m_VirtualMode)
       {
-        sptw::write_area(output_raster, inputPtr->GetBufferPointer(), streamRegion.GetIndex()[0], streamRegion.GetIndex()[1],
-                         streamRegion.GetIndex()[0] + streamRegion.GetSize()[0] - 1, streamRegion.GetIndex()[1] + streamRegion.GetSize()[1] - 1);
+        this->WriteRegion(output_raster, inputPtr->GetBufferPointer(), streamRegion);
       }
       writeDuration += writingTime.GetElapsedMilliseconds();
       numberOfProcessedRegions += 1;
+      ++processedRounds;
+    }
+  }
+
+  if (scheduler)
+  {
+    scheduler->Stop();
+  }
+
+  // Take part in the remaining collective writes
+  if (collectiveWrite && !this->GetAbortGenerateData())
+  {
+    for (; processedRounds < numberOfRounds; ++processedRounds)
+    {
+      this->WriteRegion(output_raster, nullptr, streamRegion);
     }
   }
 
@@ -692,6 +855,15 @@ void SimpleParallelTiffWriter<TInputImage>::Update()
     otb::MPIConfig::Instance()->abort(EXIT_FAILURE);
   }
 
+  // Reference the compressed blocks of all the processes
+  if (m_TiffDeflateCompression && !m_VirtualMode)
+  {
+    if (sptw::write_block_table(output_raster) != sptw::SP_None)
+    {
+      itkExceptionMacro(<< "Error writing the blocks offsets of " << m_FileName);
+    }
+  }
+
   // Clean up
   close_raster(output_raster);
   output_raster = NULL;
@@ -36,10 +36,10 @@ int otbMPISPTWReadWriteTest(int argc, char* argv[])
   config->Init(argc, argv);
 
   // Get command line arguments
-  if (argc != 3)
+  if (argc != 3 && argc != 4)
   {
     std::cerr << "Usage: " << std::endl;
-    std::cerr << argv[0] << " inputImageFile outputImageFile " << std::endl;
+    std::cerr << argv[0] << " inputImageFile outputImageFile [collective]" << std::endl;
     return EXIT_SUCCESS;
   }
 
@@ -60,6 +60,7 @@ int otbMPISPTWReadWriteTest(int argc, char* argv[])
   std::string         outputFilename = std::string(argv[2]);
   writer->SetFileName(outputFilename);
   writer->SetInput(reader->GetOutput());
+  writer->SetCollectiveWrite(argc == 4 && std::string(argv[3]) == "collective");
 
   // Execute the MPI pipeline
   try
@@ -22,6 +22,7 @@
 #define otbMPIVrtWriter_h
 
 #include "otbMPIConfig.h"
+#include "otbMPITaskScheduler.h"
 #include "otbImageFileWriter.h"
 #include "itkRegionOfInterestImageFilter.h"
 #include "otbNumberOfDivisionsTiledStreamingManager.h"
@@ -96,6 +97,19 @@ public:
   itkSetMacro(AvailableRAM, unsigned int);
   itkGetMacro(AvailableRAM, unsigned int);
 
+  /** Set/Get whether each process claims the next tile when it is done
+   *  with the previous one, instead of the static round-robin assignment.
+   *  Defaults to the OTB_MPI_SPLIT_SCHEDULING environment variable */
+  itkSetMacro(DynamicSplitAssignment, bool);
+  itkGetMacro(DynamicSplitAssignment, bool);
+  itkBooleanMacro(DynamicSplitAssignment);
+
+  /** Set/Get the number of tiles per process. 0 (default) means one tile
+   *  per process with static assignment and four with dynamic assignment,
+   *  so that there is something to balance */
+  itkSetMacro(NumberOfDivisionsPerProcess, unsigned int);
+  itkGetMacro(NumberOfDivisionsPerProcess, unsigned int);
+
 protected:
   MPIVrtWriter();
   virtual ~MPIVrtWriter();
@@ -112,6 +126,10 @@ private:
   std::string m_Filename;
 
   bool m_WriteVRT;
+
+  bool m_DynamicSplitAssignment;
+
+  unsigned int m_NumberOfDivisionsPerProcess;
 };
 
 /**
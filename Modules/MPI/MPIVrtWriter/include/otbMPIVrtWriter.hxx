@@ -23,12 +23,19 @@
 
 #include "otbMPIVrtWriter.h"
 #include "otbMacro.h"
+#include "otbConfigurationManager.h"
 
 namespace otb
 {
 
 template <typename TImage>
-MPIVrtWriter<TImage>::MPIVrtWriter() : m_AvailableRAM(0), m_IORegion(), m_Filename(""), m_WriteVRT(true)
+MPIVrtWriter<TImage>::MPIVrtWriter()
+  : m_AvailableRAM(0),
+    m_IORegion(),
+    m_Filename(""),
+    m_WriteVRT(true),
+    m_DynamicSplitAssignment(otb::ConfigurationManager::GetMPISplitScheduling() == "dynamic"),
+    m_NumberOfDivisionsPerProcess(0)
 {
 }
 
@@ -86,6 +93,8 @@ void MPIVrtWriter<TImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
   os << indent << "File Name: " << m_Filename << std::endl;
   os << indent << "Available RAM: " << m_AvailableRAM << std::endl;
   os << indent << "Write VRT: " << m_WriteVRT << std::endl;
+  os << indent << "Dynamic split assignment: " << m_DynamicSplitAssignment << std::endl;
+  os << indent << "Number of divisions per process: " << m_NumberOfDivisionsPerProcess << std::endl;
 }
 
 template <typename TImage>
@@ -106,27 +115,16 @@ void MPIVrtWriter<TImage>::Update()
   std::string     output = GetFileName();
 
   // Configure streaming manager
+  unsigned int divisionsPerProcess = m_NumberOfDivisionsPerProcess;
+  if (divisionsPerProcess == 0)
+  {
+    divisionsPerProcess = m_DynamicSplitAssignment ? 4 : 1;
+  }
   typename StreamingManagerType::Pointer streamingManager = StreamingManagerType::New();
-  streamingManager->SetNumberOfDivisions(nbProcs);
+  streamingManager->SetNumberOfDivisions(nbProcs * divisionsPerProcess);
   streamingManager->PrepareStreaming(img, img->GetLargestPossibleRegion());
   unsigned int numberOfSplits = streamingManager->GetNumberOfSplits();
 
-  // This vector will hold all regions to write for current rank
-  std::vector<typename TImage::RegionType> regionsToWrite;
-
-  // Handle both cases when there are much more (resp. less) region to
-  // write than NbProcs
-  if (myRank < numberOfSplits)
-  {
-    unsigned int splitIdx = myRank;
-    while (splitIdx < numberOfSplits)
-    {
-      typename TImage::RegionType currentRegion = streamingManager->GetSplit(splitIdx);
-      regionsToWrite.push_back(currentRegion);
-      splitIdx += nbProcs;
-    }
-  }
-
   // Output prefix
   std::string extension = itksys::SystemTools::GetFilenameExtension(output);
   if (extension != ".vrt")
@@ -154,16 +152,30 @@ void MPIVrtWriter<TImage>::Update()
   std::string          dataTypeStr = "Float32";
   GDALImageIO::Pointer gdalImageIO;
 
+  // Tiles are assigned in turn to the processes, or claimed on demand when
+  // dynamic assignment is enabled. This also handles the case when there
+  // are less tiles than processes.
+  MPITaskScheduler::Pointer scheduler;
+  if (m_DynamicSplitAssignment && nbProcs > 1)
+  {
+    scheduler = MPITaskScheduler::New();
+    scheduler->Start(numberOfSplits);
+  }
+
   // Now write all the regions
-  for (typename std::vector<typename TImage::RegionType>::const_iterator it = regionsToWrite.begin(); it != regionsToWrite.end(); ++it)
+  for (unsigned int splitIdx = scheduler ? scheduler->Next() : myRank; splitIdx < numberOfSplits;
+       splitIdx = scheduler ? scheduler->Next() : splitIdx + nbProcs)
   {
+    const typename TImage::RegionType currentRegion = streamingManager->GetSplit(splitIdx);
+
     typename ExtractFilterType::Pointer extractFilter = ExtractFilterType::New();
     extractFilter->SetInput(img);
-    extractFilter->SetRegionOfInterest(*it);
+    extractFilter->SetRegionOfInterest(currentRegion);
     // Writer
     // Output Filename
     std::stringstream ss;
-    ss << prefix << "_" << it->GetIndex()[0] << "_" << it->GetIndex()[1] << "_" << it->GetSize()[0] << "_" << it->GetSize()[1] << ".tif";
+    ss << prefix << "_" << currentRegion.GetIndex()[0] << "_" << currentRegion.GetIndex()[1] << "_" << currentRegion.GetSize()[0] << "_"
+       << currentRegion.GetSize()[1] << ".tif";
     typename WriterType::Pointer writer = WriterType::New();
     writer->SetFileName(ss.str());
     writer->SetInput(extractFilter->GetOutput());
@@ -197,6 +209,11 @@ void MPIVrtWriter<TImage>::Update()
     }
   }
 
+  if (scheduler)
+  {
+    scheduler->Stop();
+  }
+
   // MPI process synchronization
   mpiConfig->barrier();
 
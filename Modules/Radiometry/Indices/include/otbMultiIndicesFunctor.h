@@ -0,0 +1,264 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbMultiIndicesFunctor_h
+#define otbMultiIndicesFunctor_h
+
+#include "otbRadiometricIndex.h"
+#include "otbSpan.h"
+#include <array>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+namespace Functor
+{
+/**
+ * \class MultiIndicesFunctor
+ * \brief A class to compute a stack of radiometric indices known at compile time
+ *
+ * This functor holds one instance of each radiometric index of
+ * TIndices, and computes those selected with SetSelectedIndices(),
+ * in selection order. Contrary to IndicesStackFunctor, index types
+ * are known at compile time: their operator() is called without
+ * virtual dispatch and can be inlined.
+ *
+ * The required bands of the selected indices are gathered once per
+ * pixel into a compact pixel, which all indices then read. Each
+ * index band indices are remapped to this compact pixel by
+ * SetBandsIndices().
+ *
+ * It can be used with otb::FunctorImageFilter, which will call
+ * ProcessLine() on whole lines of pixels.
+ *
+ * All TIndices must derive from RadiometricIndex with the same input
+ * and output types.
+ *
+ * \sa IndicesStackFunctor
+ * \sa FunctorImageFilter
+ *
+ * \ingroup OTBIndices
+ */
+template <typename... TIndices>
+class MultiIndicesFunctor
+{
+public:
+  using IndicesTupleType = std::tuple<TIndices...>;
+  using FirstIndiceType  = typename std::tuple_element<0, IndicesTupleType>::type;
+
+  /// Read input / output types from the first index
+  using InputType       = typename FirstIndiceType::InputType;
+  using PixelType       = typename FirstIndiceType::PixelType;
+  using OutputValueType = typename FirstIndiceType::OutputType;
+  using OutputType      = itk::VariableLengthVector<OutputValueType>;
+  using BandNameType    = typename FirstIndiceType::BandNameType;
+
+  static constexpr size_t NumberOfIndices = sizeof...(TIndices);
+  static constexpr size_t NumberOfBands   = FirstIndiceType::NumberOfBands;
+
+  MultiIndicesFunctor() : m_Indices(), m_OutputBands(), m_NumberOfOutputs(0), m_BandSources(), m_NumberOfRequiredBands(0)
+  {
+    m_OutputBands.fill(-1);
+    m_BandSources.fill(0);
+  }
+
+  /**
+   * \param selected Positions in TIndices of the indices to compute,
+   * in output order
+   * \throw std::runtime_error if selected is empty, or contains a
+   * position out of range or twice
+   */
+  void SetSelectedIndices(const std::vector<size_t>& selected)
+  {
+    if (selected.empty())
+    {
+      throw std::runtime_error("Can not build MultiIndicesFunctor from an empty list of indices.");
+    }
+
+    m_OutputBands.fill(-1);
+    for (size_t band = 0; band < selected.size(); ++band)
+    {
+      if (selected[band] >= NumberOfIndices || m_OutputBands[selected[band]] >= 0)
+      {
+        throw std::runtime_error("Invalid or duplicated index position in MultiIndicesFunctor selection.");
+      }
+      m_OutputBands[selected[band]] = static_cast<int>(band);
+    }
+    m_NumberOfOutputs = selected.size();
+  }
+
+  /**
+   * \return a set<CommonBandNames> containing the required bands of
+   * the selected indices
+   */
+  std::set<BandNameType> GetRequiredBands() const
+  {
+    std::set<BandNameType> required;
+    GetRequiredBandsImpl(required, std::index_sequence_for<TIndices...>{});
+    return required;
+  }
+
+  /**
+   * \param indicesMap a std::map<CommandBandName,size_t> containing the
+   * indices (starting at 1) of the required bands in the input pixel
+   * \throw runtime_error if a required band is missing from indicesMap
+   */
+  void SetBandsIndices(const std::map<BandNameType, size_t>& indicesMap)
+  {
+    std::map<BandNameType, size_t> compactMap;
+    m_NumberOfRequiredBands = 0;
+    for (auto band : GetRequiredBands())
+    {
+      auto it = indicesMap.find(band);
+      if (it == indicesMap.end() || it->second == 0)
+      {
+        throw std::runtime_error("Missing index for a band required by MultiIndicesFunctor.");
+      }
+      m_BandSources[m_NumberOfRequiredBands] = it->second - 1;
+      compactMap[band]                       = ++m_NumberOfRequiredBands;
+    }
+    SetBandsIndicesImpl(compactMap, std::index_sequence_for<TIndices...>{});
+  }
+
+  /**
+   * \return The instance of the index at position I in TIndices, for
+   * instance to set its parameters
+   */
+  template <size_t I>
+  typename std::tuple_element<I, IndicesTupleType>::type& GetIndice()
+  {
+    return std::get<I>(m_Indices);
+  }
+
+  /**
+   * \param input A itk::VariableLengthVector<TInput> holding the
+   * pixel values for each band
+   * \return A VariableLengthVector<TInput::OutputType> holding the
+   * selected indices values
+   */
+  void operator()(OutputType& out, const PixelType& in) const
+  {
+    std::array<InputType, NumberOfBands> bands;
+    for (size_t b = 0; b < m_NumberOfRequiredBands; ++b)
+    {
+      bands[b] = in[m_BandSources[b]];
+    }
+    Evaluate(out.GetDataPointer(), bands, std::index_sequence_for<TIndices...>{});
+  }
+
+  /**
+   * Compute the selected indices for a line of pixels, whose
+   * components are interleaved in out and in.
+   */
+  void ProcessLine(otb::Span<OutputValueType> out, otb::Span<const InputType> in) const
+  {
+    const size_t nbPixels = out.size() / m_NumberOfOutputs;
+    if (nbPixels == 0)
+    {
+      return;
+    }
+    const size_t                         nbInputBands = in.size() / nbPixels;
+    const InputType*                     inPtr        = in.data();
+    OutputValueType*                     outPtr       = out.data();
+    std::array<InputType, NumberOfBands> bands;
+    for (size_t p = 0; p < nbPixels; ++p, inPtr += nbInputBands, outPtr += m_NumberOfOutputs)
+    {
+      for (size_t b = 0; b < m_NumberOfRequiredBands; ++b)
+      {
+        bands[b] = inPtr[m_BandSources[b]];
+      }
+      Evaluate(outPtr, bands, std::index_sequence_for<TIndices...>{});
+    }
+  }
+
+  /**
+   * \return the number of selected indices (to be used by FunctorImageFilter)
+   */
+  size_t OutputSize(...) const
+  {
+    return m_NumberOfOutputs;
+  }
+
+private:
+  template <size_t... Is>
+  void GetRequiredBandsImpl(std::set<BandNameType>& required, std::index_sequence<Is...>) const
+  {
+    // Will be easier to write in c++17 with fold expressions
+    (void)std::initializer_list<int>{(AddRequiredBands<Is>(required), 0)...};
+  }
+
+  template <size_t I>
+  void AddRequiredBands(std::set<BandNameType>& required) const
+  {
+    if (m_OutputBands[I] >= 0)
+    {
+      const auto bands = std::get<I>(m_Indices).GetRequiredBands();
+      required.insert(bands.begin(), bands.end());
+    }
+  }
+
+  template <size_t... Is>
+  void SetBandsIndicesImpl(const std::map<BandNameType, size_t>& compactMap, std::index_sequence<Is...>)
+  {
+    // Will be easier to write in c++17 with fold expressions
+    (void)std::initializer_list<int>{(std::get<Is>(m_Indices).SetBandsIndices(compactMap), 0)...};
+  }
+
+  template <size_t... Is>
+  void Evaluate(OutputValueType* out, std::array<InputType, NumberOfBands>& bands, std::index_sequence<Is...>) const
+  {
+    // Non owning pixel over the gathered bands
+    const PixelType pixel(bands.data(), m_NumberOfRequiredBands, false);
+
+    // Will be easier to write in c++17 with fold expressions
+    (void)std::initializer_list<int>{(EvaluateIndice<Is>(out, pixel), 0)...};
+  }
+
+  template <size_t I>
+  void EvaluateIndice(OutputValueType* out, const PixelType& pixel) const
+  {
+    using IndiceType = typename std::tuple_element<I, IndicesTupleType>::type;
+    if (m_OutputBands[I] >= 0)
+    {
+      // Qualified call: no virtual dispatch
+      out[m_OutputBands[I]] = std::get<I>(m_Indices).IndiceType::operator()(pixel);
+    }
+  }
+
+  /// The indices instances
+  IndicesTupleType m_Indices;
+
+  /// The output band of each index, -1 if it is not selected
+  std::array<int, NumberOfIndices> m_OutputBands;
+  size_t                           m_NumberOfOutputs;
+
+  /// The input band of each band of the compact pixel
+  std::array<size_t, NumberOfBands> m_BandSources;
+  size_t                            m_NumberOfRequiredBands;
+};
+
+} // End namespace Functor
+
+} // End namespace otb
+
+#endif
@@ -49,4 +49,5 @@ void RegisterTests()
   REGISTER_TEST(otbSoilIndicesTest);
   REGISTER_TEST(otbRadiometricIndexTest);
   REGISTER_TEST(otbIndicesStackFunctorTest);
+  REGISTER_TEST(otbMultiIndicesFunctorTest);
 }
@@ -23,6 +23,7 @@
 #include "otbBuiltUpIndicesFunctor.h"
 #include "otbSoilIndicesFunctor.h"
 #include "otbIndicesStackFunctor.h"
+#include "otbMultiIndicesFunctor.h"
 
 #include <iomanip>
 
@@ -277,3 +278,69 @@ int otbIndicesStackFunctorTest(int, char** const)
     return EXIT_FAILURE;
   }
 }
+
+int otbMultiIndicesFunctorTest(int, char** const)
+{
+  using MultiFunctorType = MultiIndicesFunctor<NDVI<double, double>, NDWI<double, double>, BI2<double, double>, ISU<double, double>>;
+
+  // Compute ISU, NDVI and BI2, in this order
+  MultiFunctorType multi;
+  multi.SetSelectedIndices({3, 0, 2});
+
+  bool success = true;
+
+  if (multi.OutputSize() != 3)
+  {
+    std::cerr << "Size of output pixel for multi indices functor should be 3" << std::endl;
+    success = false;
+  }
+
+  if (multi.GetRequiredBands() != std::set<CommonBandNames>({CommonBandNames::GREEN, CommonBandNames::RED, CommonBandNames::NIR}))
+  {
+    std::cerr << "Required bands of multi indices functor should be green, red and nir" << std::endl;
+    success = false;
+  }
+
+  const std::map<CommonBandNames, size_t> bandMap = {
+      {CommonBandNames::BLUE, 1}, {CommonBandNames::GREEN, 2}, {CommonBandNames::RED, 3}, {CommonBandNames::NIR, 4}, {CommonBandNames::MIR, 5}};
+  multi.SetBandsIndices(bandMap);
+
+  auto ndvi = NDVI<double, double>();
+  auto bi2  = BI2<double, double>();
+  auto isu  = ISU<double, double>();
+  ndvi.SetBandsIndices(bandMap);
+  bi2.SetBandsIndices(bandMap);
+  isu.SetBandsIndices(bandMap);
+
+  // Per pixel and line by line evaluations
+  const double                 line[] = {1, 2, 3, 4, 5, 5, 7, 2, 9, 1};
+  MultiFunctorType::OutputType out(3);
+  double                       outLine[6];
+  multi.ProcessLine(otb::Span<double>(outLine, 6), otb::Span<const double>(line, 10));
+
+  for (unsigned int p = 0; p < 2; ++p)
+  {
+    auto in = build_pixel<double>({line[5 * p], line[5 * p + 1], line[5 * p + 2], line[5 * p + 3], line[5 * p + 4]});
+    multi(out, in);
+
+    const double expected[] = {isu(in), ndvi(in), bi2(in)};
+    for (unsigned int b = 0; b < 3; ++b)
+    {
+      if (out[b] != expected[b] || outLine[3 * p + b] != expected[b])
+      {
+        std::cerr << "Output band " << b << " of pixel " << p << " should be " << expected[b] << ", got " << out[b] << " per pixel and "
+                  << outLine[3 * p + b] << " by line" << std::endl;
+        success = false;
+      }
+    }
+  }
+
+  if (success)
+  {
+    return EXIT_SUCCESS;
+  }
+  else
+  {
+    return EXIT_FAILURE;
+  }
+}
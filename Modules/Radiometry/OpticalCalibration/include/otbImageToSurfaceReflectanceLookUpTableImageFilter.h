@@ -0,0 +1,210 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbImageToSurfaceReflectanceLookUpTableImageFilter_h
+#define otbImageToSurfaceReflectanceLookUpTableImageFilter_h
+
+#include "otbImageToReflectanceImageFilter.h"
+#include "otbReflectanceToSurfaceReflectanceImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include "itkProgressReporter.h"
+#include <cmath>
+#include <vector>
+
+namespace otb
+{
+
+/** \class ImageToSurfaceReflectanceLookUpTableImageFilter
+ *  \brief Convert raw values into TOA or TOC reflectance values with a lookup table
+ *
+ * The TOA conversion is configured as in ImageToReflectanceImageFilter. If
+ * the surface reflectance functors are given (one per band, for instance
+ * the functor vector of a ReflectanceToSurfaceReflectanceImageFilter after
+ * GenerateParameters()), the TOC conversion is applied too.
+ *
+ * Before processing, the conversion of every integer value in [0, 65535] is
+ * stored in a table for each band, so that a pixel of an integer image
+ * (UInt16 DN for instance) only costs one lookup per band. Other values are
+ * converted on the fly. The radiance is kept in double precision, and the
+ * null pixel rules of the filter chain (ImageToRadianceImageFilter,
+ * RadianceToReflectanceImageFilter, ReflectanceToSurfaceReflectanceImageFilter)
+ * are kept, so that the results are the same as the chain.
+ *
+ * \sa ImageToReflectanceImageFilter
+ * \sa ReflectanceToSurfaceReflectanceImageFilter
+ *
+ * \ingroup Radiometry
+ *
+ * \ingroup OTBOpticalCalibration
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT ImageToSurfaceReflectanceLookUpTableImageFilter : public ImageToReflectanceImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** "typedef" for standard classes. */
+  typedef ImageToSurfaceReflectanceLookUpTableImageFilter          Self;
+  typedef ImageToReflectanceImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>                                  Pointer;
+  typedef itk::SmartPointer<const Self>                            ConstPointer;
+
+  /** object factory method. */
+  itkNewMacro(Self);
+
+  /** return class name. */
+  itkTypeMacro(ImageToSurfaceReflectanceLookUpTableImageFilter, ImageToReflectanceImageFilter);
+
+  typedef typename Superclass::InputImageType        InputImageType;
+  typedef typename Superclass::OutputImageType       OutputImageType;
+  typedef typename Superclass::InputPixelType        InputPixelType;
+  typedef typename Superclass::OutputPixelType       OutputPixelType;
+  typedef typename Superclass::OutputImageRegionType OutputImageRegionType;
+
+  typedef Functor::ImageToRadianceImageFunctor<double, double>                 ImageToRadianceFunctorType;
+  typedef Functor::RadianceToReflectanceImageFunctor<double, double>           RadianceToReflectanceFunctorType;
+  typedef Functor::ReflectanceToSurfaceReflectanceImageFunctor<double, double> SurfaceReflectanceFunctorType;
+  typedef std::vector<SurfaceReflectanceFunctorType>                           SurfaceReflectanceFunctorVectorType;
+
+  /** Number of values stored in the table of each band */
+  itkStaticConstMacro(LookUpTableSize, unsigned int, 65536);
+
+  /** Set the surface reflectance functors (one per band). Leave it empty to
+   * compute the TOA reflectance only. */
+  void SetSurfaceReflectanceFunctorVector(const SurfaceReflectanceFunctorVectorType& functors)
+  {
+    m_SurfaceReflectanceFunctors = functors;
+    this->Modified();
+  }
+  const SurfaceReflectanceFunctorVectorType& GetSurfaceReflectanceFunctorVector() const
+  {
+    return m_SurfaceReflectanceFunctors;
+  }
+
+protected:
+  ImageToSurfaceReflectanceLookUpTableImageFilter()
+  {
+  }
+  ~ImageToSurfaceReflectanceLookUpTableImageFilter() override
+  {
+  }
+
+  /** Fill the lookup tables from the functors of the superclass */
+  void BeforeThreadedGenerateData(void) override
+  {
+    Superclass::BeforeThreadedGenerateData();
+
+    const unsigned int nbBands = this->GetInput()->GetNumberOfComponentsPerPixel();
+    if (!m_SurfaceReflectanceFunctors.empty() && m_SurfaceReflectanceFunctors.size() != nbBands)
+    {
+      itkExceptionMacro(<< "The number of surface reflectance functors (" << m_SurfaceReflectanceFunctors.size() << ") should be the number of bands ("
+                        << nbBands << ")");
+    }
+
+    m_RadianceFunctors.resize(nbBands);
+    m_ReflectanceFunctors.resize(nbBands);
+    m_ReflectanceTable.resize(nbBands * LookUpTableSize);
+    m_OutputTable.resize(nbBands * LookUpTableSize);
+
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      auto& functor = this->GetFunctorVector()[i];
+      m_RadianceFunctors[i].SetAlpha(functor.GetAlpha());
+      m_RadianceFunctors[i].SetBeta(functor.GetBeta());
+      m_ReflectanceFunctors[i].SetSolarIllumination(functor.GetSolarIllumination());
+      m_ReflectanceFunctors[i].SetIlluminationCorrectionCoefficient(functor.GetIlluminationCorrectionCoefficient());
+      m_ReflectanceFunctors[i].SetUseClamp(functor.GetUseClamp());
+
+      for (unsigned int value = 0; value < LookUpTableSize; ++value)
+      {
+        const unsigned int index  = i * LookUpTableSize + value;
+        m_ReflectanceTable[index] = m_ReflectanceFunctors[i](m_RadianceFunctors[i](value));
+        m_OutputTable[index] =
+            m_SurfaceReflectanceFunctors.empty() ? m_ReflectanceTable[index] : m_SurfaceReflectanceFunctors[i](m_ReflectanceTable[index]);
+      }
+    }
+  }
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override
+  {
+    const InputImageType* inputPtr  = this->GetInput();
+    OutputImageType*      outputPtr = this->GetOutput();
+
+    itk::ImageRegionConstIterator<InputImageType> inputIt(inputPtr, outputRegionForThread);
+    itk::ImageRegionIterator<OutputImageType>     outputIt(outputPtr, outputRegionForThread);
+
+    itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels());
+
+    const unsigned int nbBands    = inputPtr->GetNumberOfComponentsPerPixel();
+    const bool         useSurface = !m_SurfaceReflectanceFunctors.empty();
+
+    OutputPixelType outPixel(nbBands);
+
+    for (inputIt.GoToBegin(), outputIt.GoToBegin(); !inputIt.IsAtEnd(); ++inputIt, ++outputIt)
+    {
+      const InputPixelType& inPixel = inputIt.Get();
+
+      // As in UnaryImageFunctorWithVectorImageFilter, null pixels stay null at each step of the chain
+      bool nullInput       = true;
+      bool nullReflectance = true;
+      for (unsigned int i = 0; i < nbBands; ++i)
+      {
+        const double value = static_cast<double>(inPixel[i]);
+        nullInput          = nullInput && value == 0.;
+
+        double reflectance;
+        if (value >= 0. && value < LookUpTableSize && value == std::floor(value))
+        {
+          const unsigned int index = i * LookUpTableSize + static_cast<unsigned int>(value);
+          reflectance              = m_ReflectanceTable[index];
+          outPixel[i]              = m_OutputTable[index];
+        }
+        else
+        {
+          reflectance = m_ReflectanceFunctors[i](m_RadianceFunctors[i](value));
+          outPixel[i] = useSurface ? m_SurfaceReflectanceFunctors[i](reflectance) : reflectance;
+        }
+        nullReflectance = nullReflectance && reflectance == 0.;
+      }
+
+      if (nullInput || (useSurface && nullReflectance))
+      {
+        outPixel.Fill(0.);
+      }
+
+      outputIt.Set(outPixel);
+      progress.CompletedPixel();
+    }
+  }
+
+private:
+  ImageToSurfaceReflectanceLookUpTableImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  SurfaceReflectanceFunctorVectorType           m_SurfaceReflectanceFunctors;
+  std::vector<ImageToRadianceFunctorType>       m_RadianceFunctors;
+  std::vector<RadianceToReflectanceFunctorType> m_ReflectanceFunctors;
+
+  /** TOA reflectance and output values of each integer input, band after band */
+  std::vector<double> m_ReflectanceTable;
+  std::vector<double> m_OutputTable;
+};
+
+} // end namespace otb
+
+#endif
@@ -24,6 +24,7 @@
 #include "otbAtmosphericRadiativeTerms.h"
 #include "otbImageMetadataCorrectionParameters.h"
 #include "otbSIXSTraits.h"
+#include "otbSIXSRadiativeTermsCache.h"
 #include "otbMacro.h"
 
 namespace otb
@@ -41,8 +42,9 @@ namespace otb
 class RadiometryCorrectionParametersToAtmosphericRadiativeTerms
 {
 public:
-  /** Call the varSol function*/
-  static AtmosphericRadiativeTerms::Pointer Compute(AtmosphericCorrectionParameters* paramAtmo, ImageMetadataCorrectionParameters* paramAcqui)
+  /** Call the varSol function. If a cache is given, 6S is only run for the bands whose terms it does not hold. */
+  static AtmosphericRadiativeTerms::Pointer Compute(AtmosphericCorrectionParameters* paramAtmo, ImageMetadataCorrectionParameters* paramAcqui,
+                                                    SIXSRadiativeTermsCache* cache = nullptr)
   {
     AtmosphericRadiativeTerms::Pointer radTermsOut = AtmosphericRadiativeTerms::New();
 
@@ -73,30 +75,46 @@ public:
       upwardDirectTransmittance             = 0.;
       upwardDiffuseTransmittanceForRayleigh = 0.;
       upwardDiffuseTransmittanceForAerosol  = 0.;
-      SIXSTraits::ComputeAtmosphericParameters(
-          paramAcqui->GetSolarZenithalAngle(),   /** The Solar zenithal angle */
-          paramAcqui->GetSolarAzimutalAngle(),   /** The Solar azimutal angle */
-          paramAcqui->GetViewingZenithalAngle(), /** The Viewing zenithal angle */
-          paramAcqui->GetViewingAzimutalAngle(), /** The Viewing azimutal angle */
-          paramAcqui->GetMonth(),                /** The Month */
-          paramAcqui->GetDay(),                  /** The Day (in the month) */
-          paramAtmo->GetAtmosphericPressure(),   /** The Atmospheric pressure */
-          paramAtmo->GetWaterVaporAmount(),      /** The Water vapor amount (Total water vapor content over vertical atmospheric column) */
-          paramAtmo->GetOzoneAmount(),           /** The Ozone amount (Stratospheric ozone layer content) */
-          paramAtmo->GetAerosolModel(),          /** The Aerosol model */
-          paramAtmo->GetAerosolOptical(),        /** The Aerosol optical (radiative impact of aerosol for the reference wavelength 550-nm) */
-          paramAcqui->GetWavelengthSpectralBand()->GetNthElement(i), /** Wavelength for the spectral band definition */
-          /** Note : The Max wavelength spectral band value must be updated ! */
-          atmosphericReflectance,                /** Atmospheric reflectance */
-          atmosphericSphericalAlbedo,            /** atmospheric spherical albedo */
-          totalGaseousTransmission,              /** Total gaseous transmission */
-          downwardTransmittance,                 /** downward transmittance */
-          upwardTransmittance,                   /** upward transmittance */
-          upwardDiffuseTransmittance,            /** Upward diffuse transmittance */
-          upwardDirectTransmittance,             /** Upward direct transmittance */
-          upwardDiffuseTransmittanceForRayleigh, /** Upward diffuse transmittance for rayleigh */
-          upwardDiffuseTransmittanceForAerosol   /** Upward diffuse transmittance for aerosols */
-          );
+      if (cache != nullptr)
+      {
+        const SIXSRadiativeTermsCache::TermsType terms = cache->Compute(paramAtmo, paramAcqui, i);
+        atmosphericReflectance                         = terms[0];
+        atmosphericSphericalAlbedo                     = terms[1];
+        totalGaseousTransmission                       = terms[2];
+        downwardTransmittance                          = terms[3];
+        upwardTransmittance                            = terms[4];
+        upwardDiffuseTransmittance                     = terms[5];
+        upwardDirectTransmittance                      = terms[6];
+        upwardDiffuseTransmittanceForRayleigh          = terms[7];
+        upwardDiffuseTransmittanceForAerosol           = terms[8];
+      }
+      else
+      {
+        SIXSTraits::ComputeAtmosphericParameters(
+            paramAcqui->GetSolarZenithalAngle(),   /** The Solar zenithal angle */
+            paramAcqui->GetSolarAzimutalAngle(),   /** The Solar azimutal angle */
+            paramAcqui->GetViewingZenithalAngle(), /** The Viewing zenithal angle */
+            paramAcqui->GetViewingAzimutalAngle(), /** The Viewing azimutal angle */
+            paramAcqui->GetMonth(),                /** The Month */
+            paramAcqui->GetDay(),                  /** The Day (in the month) */
+            paramAtmo->GetAtmosphericPressure(),   /** The Atmospheric pressure */
+            paramAtmo->GetWaterVaporAmount(),      /** The Water vapor amount (Total water vapor content over vertical atmospheric column) */
+            paramAtmo->GetOzoneAmount(),           /** The Ozone amount (Stratospheric ozone layer content) */
+            paramAtmo->GetAerosolModel(),          /** The Aerosol model */
+            paramAtmo->GetAerosolOptical(),        /** The Aerosol optical (radiative impact of aerosol for the reference wavelength 550-nm) */
+            paramAcqui->GetWavelengthSpectralBand()->GetNthElement(i), /** Wavelength for the spectral band definition */
+            /** Note : The Max wavelength spectral band value must be updated ! */
+            atmosphericReflectance,                /** Atmospheric reflectance */
+            atmosphericSphericalAlbedo,            /** atmospheric spherical albedo */
+            totalGaseousTransmission,              /** Total gaseous transmission */
+            downwardTransmittance,                 /** downward transmittance */
+            upwardTransmittance,                   /** upward transmittance */
+            upwardDiffuseTransmittance,            /** Upward diffuse transmittance */
+            upwardDirectTransmittance,             /** Upward direct transmittance */
+            upwardDiffuseTransmittanceForRayleigh, /** Upward diffuse transmittance for rayleigh */
+            upwardDiffuseTransmittanceForAerosol   /** Upward diffuse transmittance for aerosols */
+            );
+      }
 
       radTermsOut->SetIntrinsicAtmosphericReflectance(i, atmosphericReflectance);
       radTermsOut->SetSphericalAlbedo(i, atmosphericSphericalAlbedo);
@@ -220,6 +220,11 @@ public:
   }
   itkGetObjectMacro(AcquiCorrectionParameters, AcquiCorrectionParametersType);
 
+  /** Set/Get the cache of 6S radiative terms used when they are computed from
+   *  the correction parameters (none by default). */
+  itkSetObjectMacro(RadiativeTermsCache, SIXSRadiativeTermsCache);
+  itkGetObjectMacro(RadiativeTermsCache, SIXSRadiativeTermsCache);
+
 
   /** Compute radiative terms if necessary and then update functors attributes. */
   void GenerateParameters();
@@ -269,6 +274,7 @@ private:
   AtmosphericRadiativeTermsPointerType m_AtmosphericRadiativeTerms;
   AtmoCorrectionParametersPointerType  m_AtmoCorrectionParameters;
   AcquiCorrectionParametersPointerType m_AcquiCorrectionParameters;
+  SIXSRadiativeTermsCache::Pointer     m_RadiativeTermsCache;
 };
 
 } // end namespace otb
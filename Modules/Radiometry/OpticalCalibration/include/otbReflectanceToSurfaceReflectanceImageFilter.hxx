@@ -155,7 +155,8 @@ void ReflectanceToSurfaceReflectanceImageFilter<TInputImage, TOutputImage>::Upda
   }
 
 
-  m_AtmosphericRadiativeTerms = CorrectionParametersToRadiativeTermsType::Compute(m_AtmoCorrectionParameters, m_AcquiCorrectionParameters);
+  m_AtmosphericRadiativeTerms =
+      CorrectionParametersToRadiativeTermsType::Compute(m_AtmoCorrectionParameters, m_AcquiCorrectionParameters, m_RadiativeTermsCache);
 }
 
 template <class TInputImage, class TOutputImage>
@@ -0,0 +1,195 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSIXSRadiativeTermsCache_h
+#define otbSIXSRadiativeTermsCache_h
+
+#include "OTBOpticalCalibrationExport.h"
+#include "itkObject.h"
+#include "itkObjectFactory.h"
+#include "otbAtmosphericCorrectionParameters.h"
+#include "otbImageMetadataCorrectionParameters.h"
+#include <array>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+
+/** \class SIXSRadiativeTermsCache
+ *  \brief Store the radiative terms computed by 6S to avoid running it twice.
+ *
+ * Entries are keyed by the acquisition geometry and date, the atmospheric
+ * parameters and the spectral sensitivity of the band. Angles,
+ * pressure, water vapor, ozone and aerosol optical thickness can be quantised
+ * with a step: 6S is then run at the nearest grid node, so that scenes with
+ * nearly identical conditions share their entries. A zero step (the default)
+ * keys on the exact value.
+ *
+ * When InterpolateAerosolOptical is on, a missing entry is linearly
+ * interpolated between the two nearest stored thicknesses sharing all other
+ * parameters. Such a grid can be filled with PrecomputeAerosolOpticalGrid()
+ * or read with Load(). Without bracketing entries, the thickness step defines
+ * a regular grid whose two surrounding nodes are computed and kept, so that a
+ * given geometry costs at most two 6S runs per band and per grid cell.
+ *
+ * The cache can be shared between filters and threads, and saved to a text
+ * file to persist across runs.
+ *
+ * \sa RadiometryCorrectionParametersToAtmosphericRadiativeTerms
+ *
+ * \ingroup OTBOpticalCalibration
+ */
+class OTBOpticalCalibration_EXPORT SIXSRadiativeTermsCache : public itk::Object
+{
+public:
+  /** Standard typedefs */
+  typedef SIXSRadiativeTermsCache       Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkTypeMacro(SIXSRadiativeTermsCache, Object);
+
+  /** Creation through object factory macro */
+  itkNewMacro(Self);
+
+  /** Radiative terms of one band, in the SIXSTraits::ComputeAtmosphericParameters output order */
+  typedef std::array<double, 9> TermsType;
+
+  /** Set/Get the quantisation step of the solar and viewing angles (in degrees) */
+  itkSetMacro(AngleStep, double);
+  itkGetConstMacro(AngleStep, double);
+
+  /** Set/Get the quantisation step of the atmospheric pressure (in hPa) */
+  itkSetMacro(AtmosphericPressureStep, double);
+  itkGetConstMacro(AtmosphericPressureStep, double);
+
+  /** Set/Get the quantisation step of the water vapor amount (in g/cm2) */
+  itkSetMacro(WaterVaporAmountStep, double);
+  itkGetConstMacro(WaterVaporAmountStep, double);
+
+  /** Set/Get the quantisation step of the ozone amount (in cm-atm) */
+  itkSetMacro(OzoneAmountStep, double);
+  itkGetConstMacro(OzoneAmountStep, double);
+
+  /** Set/Get the quantisation step of the aerosol optical thickness */
+  itkSetMacro(AerosolOpticalStep, double);
+  itkGetConstMacro(AerosolOpticalStep, double);
+
+  /** Interpolate the aerosol optical thickness between stored entries */
+  itkSetMacro(InterpolateAerosolOptical, bool);
+  itkGetConstMacro(InterpolateAerosolOptical, bool);
+  itkBooleanMacro(InterpolateAerosolOptical);
+
+  /** Get the radiative terms of a band, running 6S only if they are not
+   *  cached. The band spectral sensitivity is resampled for 6S as a side
+   *  effect, exactly as SIXSTraits::ComputeAtmosphericParameters does. */
+  TermsType Compute(AtmosphericCorrectionParameters* paramAtmo, ImageMetadataCorrectionParameters* paramAcqui, unsigned int band);
+
+  /** Run 6S for each band at each aerosol optical thickness node, all other
+   *  parameters being taken from paramAtmo and paramAcqui. */
+  void PrecomputeAerosolOpticalGrid(AtmosphericCorrectionParameters* paramAtmo, ImageMetadataCorrectionParameters* paramAcqui,
+                                    const std::vector<double>& aerosolOpticalNodes);
+
+  /** Number of stored entries */
+  std::size_t GetNumberOfEntries() const;
+
+  /** Number of times 6S has been run by this cache */
+  unsigned long GetNumberOfSIXSRuns() const;
+
+  /** Remove all entries */
+  void Clear();
+
+  /** Add the entries stored in a file */
+  void Load(const std::string& filename);
+
+  /** Write all entries to a file */
+  void Save(const std::string& filename) const;
+
+protected:
+  /** Constructor */
+  SIXSRadiativeTermsCache();
+  /** Destructor */
+  ~SIXSRadiativeTermsCache() override
+  {
+  }
+
+  /** PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  SIXSRadiativeTermsCache(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Parameters of a 6S run. The aerosol optical thickness is compared last,
+   *  so that entries differing only by it are adjacent in the map. */
+  struct KeyType
+  {
+    double             SolarZenithalAngle;
+    double             SolarAzimutalAngle;
+    double             ViewingZenithalAngle;
+    double             ViewingAzimutalAngle;
+    unsigned int       Month;
+    unsigned int       Day;
+    double             AtmosphericPressure;
+    double             WaterVaporAmount;
+    double             OzoneAmount;
+    int                AerosolModel;
+    float              MinSpectralValue;
+    float              MaxSpectralValue;
+    float              UserStep;
+    std::vector<float> SpectralValues;
+    double             AerosolOptical;
+
+    bool operator<(const KeyType& other) const;
+    bool SameButAerosolOptical(const KeyType& other) const;
+  };
+
+  typedef std::map<KeyType, TermsType> MapType;
+
+  /** Build the quantised key of a band */
+  KeyType MakeKey(AtmosphericCorrectionParameters* paramAtmo, ImageMetadataCorrectionParameters* paramAcqui, unsigned int band) const;
+
+  /** Return the stored terms of a key, running 6S if needed (m_Mutex must be locked) */
+  const TermsType& FindOrRun(const KeyType& key, FilterFunctionValues* wavelengthSpectralBand);
+
+  /** Run 6S with the key parameters on a band whose spectral sensitivity
+   *  matches the key (m_Mutex must be locked) */
+  TermsType Run(const KeyType& key, FilterFunctionValues* wavelengthSpectralBand);
+
+  double m_AngleStep;
+  double m_AtmosphericPressureStep;
+  double m_WaterVaporAmountStep;
+  double m_OzoneAmountStep;
+  double m_AerosolOpticalStep;
+  bool   m_InterpolateAerosolOptical;
+
+  MapType            m_Entries;
+  unsigned long      m_NumberOfSIXSRuns;
+  mutable std::mutex m_Mutex;
+};
+
+} // end namespace otb
+
+#endif
@@ -251,6 +251,11 @@ public:
   }
   itkGetObjectMacro(AcquiCorrectionParameters, AcquiCorrectionParametersType);
 
+  /** Set/Get the cache of 6S radiative terms used when they are computed from
+   *  the correction parameters (none by default). */
+  itkSetObjectMacro(RadiativeTermsCache, SIXSRadiativeTermsCache);
+  itkGetObjectMacro(RadiativeTermsCache, SIXSRadiativeTermsCache);
+
 
   /** Compute radiative terms if necessary and then update functors attibuts. */
   void GenerateParameters();
@@ -289,6 +294,7 @@ private:
   AtmosphericRadiativeTermsPointerType m_AtmosphericRadiativeTerms;
   AtmoCorrectionParametersPointerType  m_AtmoCorrectionParameters;
   AcquiCorrectionParametersPointerType m_AcquiCorrectionParameters;
+  SIXSRadiativeTermsCache::Pointer     m_RadiativeTermsCache;
 
   /** Size of the window. */
   unsigned int m_WindowRadius;
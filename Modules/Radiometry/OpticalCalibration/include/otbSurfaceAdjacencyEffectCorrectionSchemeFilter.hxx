@@ -133,7 +133,8 @@ void SurfaceAdjacencyEffectCorrectionSchemeFilter<TInputImage, TOutputImage>::Up
 
   }
 
-  m_AtmosphericRadiativeTerms = CorrectionParametersToRadiativeTermsType::Compute(m_AtmoCorrectionParameters, m_AcquiCorrectionParameters);
+  m_AtmosphericRadiativeTerms =
+      CorrectionParametersToRadiativeTermsType::Compute(m_AtmoCorrectionParameters, m_AcquiCorrectionParameters, m_RadiativeTermsCache);
 }
 
 template <class TInputImage, class TOutputImage>
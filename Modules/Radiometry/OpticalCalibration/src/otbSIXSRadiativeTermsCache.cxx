@@ -0,0 +1,305 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSIXSRadiativeTermsCache.h"
+#include "otbSIXSTraits.h"
+
+#include <cmath>
+#include <fstream>
+#include <iterator>
+#include <limits>
+#include <sstream>
+#include <tuple>
+
+namespace otb
+{
+
+namespace
+{
+// Same value as the resampling step used by SIXSTraits::ComputeAtmosphericParameters
+const float SIXSStepOfWavelengthSpectralBandValues = .0025;
+
+double Quantize(double value, double step)
+{
+  return step > 0. ? std::round(value / step) * step : value;
+}
+}
+
+bool SIXSRadiativeTermsCache::KeyType::operator<(const KeyType& other) const
+{
+  return std::tie(SolarZenithalAngle, SolarAzimutalAngle, ViewingZenithalAngle, ViewingAzimutalAngle, Month, Day, AtmosphericPressure, WaterVaporAmount,
+                  OzoneAmount, AerosolModel, MinSpectralValue, MaxSpectralValue, UserStep, SpectralValues, AerosolOptical) <
+         std::tie(other.SolarZenithalAngle, other.SolarAzimutalAngle, other.ViewingZenithalAngle, other.ViewingAzimutalAngle, other.Month, other.Day,
+                  other.AtmosphericPressure, other.WaterVaporAmount, other.OzoneAmount, other.AerosolModel, other.MinSpectralValue, other.MaxSpectralValue,
+                  other.UserStep, other.SpectralValues, other.AerosolOptical);
+}
+
+bool SIXSRadiativeTermsCache::KeyType::SameButAerosolOptical(const KeyType& other) const
+{
+  return std::tie(SolarZenithalAngle, SolarAzimutalAngle, ViewingZenithalAngle, ViewingAzimutalAngle, Month, Day, AtmosphericPressure, WaterVaporAmount,
+                  OzoneAmount, AerosolModel, MinSpectralValue, MaxSpectralValue, UserStep, SpectralValues) ==
+         std::tie(other.SolarZenithalAngle, other.SolarAzimutalAngle, other.ViewingZenithalAngle, other.ViewingAzimutalAngle, other.Month, other.Day,
+                  other.AtmosphericPressure, other.WaterVaporAmount, other.OzoneAmount, other.AerosolModel, other.MinSpectralValue, other.MaxSpectralValue,
+                  other.UserStep, other.SpectralValues);
+}
+
+SIXSRadiativeTermsCache::SIXSRadiativeTermsCache()
+  : m_AngleStep(0.),
+    m_AtmosphericPressureStep(0.),
+    m_WaterVaporAmountStep(0.),
+    m_OzoneAmountStep(0.),
+    m_AerosolOpticalStep(0.),
+    m_InterpolateAerosolOptical(false),
+    m_NumberOfSIXSRuns(0)
+{
+}
+
+SIXSRadiativeTermsCache::KeyType SIXSRadiativeTermsCache::MakeKey(AtmosphericCorrectionParameters* paramAtmo, ImageMetadataCorrectionParameters* paramAcqui,
+                                                                  unsigned int band) const
+{
+  FilterFunctionValues* wavelengthSpectralBand = paramAcqui->GetWavelengthSpectralBand()->GetNthElement(band);
+
+  KeyType key;
+  key.SolarZenithalAngle   = Quantize(paramAcqui->GetSolarZenithalAngle(), m_AngleStep);
+  key.SolarAzimutalAngle   = Quantize(paramAcqui->GetSolarAzimutalAngle(), m_AngleStep);
+  key.ViewingZenithalAngle = Quantize(paramAcqui->GetViewingZenithalAngle(), m_AngleStep);
+  key.ViewingAzimutalAngle = Quantize(paramAcqui->GetViewingAzimutalAngle(), m_AngleStep);
+  key.Month                = paramAcqui->GetMonth();
+  key.Day                  = paramAcqui->GetDay();
+  key.AtmosphericPressure  = Quantize(paramAtmo->GetAtmosphericPressure(), m_AtmosphericPressureStep);
+  key.WaterVaporAmount     = Quantize(paramAtmo->GetWaterVaporAmount(), m_WaterVaporAmountStep);
+  key.OzoneAmount          = Quantize(paramAtmo->GetOzoneAmount(), m_OzoneAmountStep);
+  key.AerosolModel         = static_cast<int>(paramAtmo->GetAerosolModel());
+  key.MinSpectralValue     = wavelengthSpectralBand->GetMinSpectralValue();
+  key.MaxSpectralValue     = wavelengthSpectralBand->GetMaxSpectralValue();
+  key.UserStep             = wavelengthSpectralBand->GetUserStep();
+  key.SpectralValues       = wavelengthSpectralBand->GetFilterFunctionValues();
+  key.AerosolOptical       = m_InterpolateAerosolOptical ? paramAtmo->GetAerosolOptical() : Quantize(paramAtmo->GetAerosolOptical(), m_AerosolOpticalStep);
+  return key;
+}
+
+SIXSRadiativeTermsCache::TermsType SIXSRadiativeTermsCache::Run(const KeyType& key, FilterFunctionValues* wavelengthSpectralBand)
+{
+  // 6S resampling updates the maximum spectral value, restore it so that
+  // successive runs on the same band see the same sensitivity
+  wavelengthSpectralBand->SetMaxSpectralValue(key.MaxSpectralValue);
+
+  TermsType terms;
+  SIXSTraits::ComputeAtmosphericParameters(key.SolarZenithalAngle, key.SolarAzimutalAngle, key.ViewingZenithalAngle, key.ViewingAzimutalAngle, key.Month,
+                                           key.Day, key.AtmosphericPressure, key.WaterVaporAmount, key.OzoneAmount,
+                                           static_cast<AtmosphericCorrectionParameters::AerosolModelType>(key.AerosolModel), key.AerosolOptical,
+                                           wavelengthSpectralBand, terms[0], terms[1], terms[2], terms[3], terms[4], terms[5], terms[6], terms[7], terms[8]);
+  ++m_NumberOfSIXSRuns;
+  return terms;
+}
+
+const SIXSRadiativeTermsCache::TermsType& SIXSRadiativeTermsCache::FindOrRun(const KeyType& key, FilterFunctionValues* wavelengthSpectralBand)
+{
+  MapType::iterator it = m_Entries.lower_bound(key);
+  if (it == m_Entries.end() || key < it->first)
+  {
+    it = m_Entries.emplace_hint(it, key, Run(key, wavelengthSpectralBand));
+  }
+  return it->second;
+}
+
+SIXSRadiativeTermsCache::TermsType SIXSRadiativeTermsCache::Compute(AtmosphericCorrectionParameters* paramAtmo, ImageMetadataCorrectionParameters* paramAcqui,
+                                                                    unsigned int band)
+{
+  FilterFunctionValues* wavelengthSpectralBand = paramAcqui->GetWavelengthSpectralBand()->GetNthElement(band);
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  const KeyType               key = MakeKey(paramAtmo, paramAcqui, band);
+
+  MapType::const_iterator it = m_Entries.lower_bound(key);
+  if (it != m_Entries.end() && !(key < it->first))
+  {
+    // Keep the side effect of a 6S run on the band
+    SIXSTraits::ComputeWavelengthSpectralBandValuesFor6S(SIXSStepOfWavelengthSpectralBandValues, wavelengthSpectralBand);
+    return it->second;
+  }
+
+  if (!m_InterpolateAerosolOptical)
+  {
+    return FindOrRun(key, wavelengthSpectralBand);
+  }
+
+  KeyType lowerKey = key;
+  KeyType upperKey = key;
+  if (it != m_Entries.end() && it != m_Entries.begin() && std::prev(it)->first.SameButAerosolOptical(key) && it->first.SameButAerosolOptical(key))
+  {
+    // Stored entries around the requested thickness
+    lowerKey.AerosolOptical = std::prev(it)->first.AerosolOptical;
+    upperKey.AerosolOptical = it->first.AerosolOptical;
+  }
+  else if (m_AerosolOpticalStep > 0.)
+  {
+    // Nodes of the regular grid around the requested thickness
+    lowerKey.AerosolOptical = std::floor(key.AerosolOptical / m_AerosolOpticalStep) * m_AerosolOpticalStep;
+    upperKey.AerosolOptical = lowerKey.AerosolOptical + m_AerosolOpticalStep;
+  }
+  if (lowerKey.AerosolOptical == key.AerosolOptical)
+  {
+    // Nothing to interpolate from, or the thickness is a grid node
+    return FindOrRun(key, wavelengthSpectralBand);
+  }
+
+  const TermsType lower  = FindOrRun(lowerKey, wavelengthSpectralBand);
+  const TermsType upper  = FindOrRun(upperKey, wavelengthSpectralBand);
+  const double    weight = (key.AerosolOptical - lowerKey.AerosolOptical) / (upperKey.AerosolOptical - lowerKey.AerosolOptical);
+  TermsType       terms;
+  for (unsigned int i = 0; i < terms.size(); ++i)
+  {
+    terms[i] = (1. - weight) * lower[i] + weight * upper[i];
+  }
+
+  // Leave the band as a single 6S run would
+  wavelengthSpectralBand->SetMaxSpectralValue(key.MaxSpectralValue);
+  SIXSTraits::ComputeWavelengthSpectralBandValuesFor6S(SIXSStepOfWavelengthSpectralBandValues, wavelengthSpectralBand);
+  return terms;
+}
+
+void SIXSRadiativeTermsCache::PrecomputeAerosolOpticalGrid(AtmosphericCorrectionParameters* paramAtmo, ImageMetadataCorrectionParameters* paramAcqui,
+                                                           const std::vector<double>& aerosolOpticalNodes)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  const unsigned int          nbBands = paramAcqui->GetWavelengthSpectralBand()->Size();
+  for (unsigned int band = 0; band < nbBands; ++band)
+  {
+    FilterFunctionValues* wavelengthSpectralBand = paramAcqui->GetWavelengthSpectralBand()->GetNthElement(band);
+    KeyType               key                    = MakeKey(paramAtmo, paramAcqui, band);
+    for (double aerosolOptical : aerosolOpticalNodes)
+    {
+      key.AerosolOptical = aerosolOptical;
+      FindOrRun(key, wavelengthSpectralBand);
+    }
+    // Leave the band as a single 6S run would
+    wavelengthSpectralBand->SetMaxSpectralValue(key.MaxSpectralValue);
+    SIXSTraits::ComputeWavelengthSpectralBandValuesFor6S(SIXSStepOfWavelengthSpectralBandValues, wavelengthSpectralBand);
+  }
+}
+
+std::size_t SIXSRadiativeTermsCache::GetNumberOfEntries() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_Entries.size();
+}
+
+unsigned long SIXSRadiativeTermsCache::GetNumberOfSIXSRuns() const
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  return m_NumberOfSIXSRuns;
+}
+
+void SIXSRadiativeTermsCache::Clear()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Entries.clear();
+}
+
+void SIXSRadiativeTermsCache::Load(const std::string& filename)
+{
+  std::ifstream file(filename);
+  if (!file)
+  {
+    itkExceptionMacro(<< "Unable to open radiative terms cache file " << filename);
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  std::string                 line;
+  unsigned int                lineNumber = 0;
+  while (std::getline(file, line))
+  {
+    ++lineNumber;
+    if (line.empty() || line[0] == '#')
+    {
+      continue;
+    }
+
+    std::istringstream iss(line);
+    KeyType            key;
+    std::size_t        nbValues = 0;
+    TermsType          terms;
+    iss >> key.SolarZenithalAngle >> key.SolarAzimutalAngle >> key.ViewingZenithalAngle >> key.ViewingAzimutalAngle >> key.Month >> key.Day >>
+        key.AtmosphericPressure >> key.WaterVaporAmount >> key.OzoneAmount >> key.AerosolModel >> key.AerosolOptical >> key.MinSpectralValue >>
+        key.MaxSpectralValue >> key.UserStep >> nbValues;
+    key.SpectralValues.resize(iss ? nbValues : 0);
+    for (float& value : key.SpectralValues)
+    {
+      iss >> value;
+    }
+    for (double& term : terms)
+    {
+      iss >> term;
+    }
+    if (!iss)
+    {
+      itkExceptionMacro(<< "Invalid entry at line " << lineNumber << " of radiative terms cache file " << filename);
+    }
+    m_Entries[key] = terms;
+  }
+}
+
+void SIXSRadiativeTermsCache::Save(const std::string& filename) const
+{
+  std::ofstream file(filename);
+  if (!file)
+  {
+    itkExceptionMacro(<< "Unable to write radiative terms cache file " << filename);
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  file << "# sza saa vza vaa month day pressure water ozone aerosolmodel aot min max step n values[n] terms[9]" << std::endl;
+  for (const auto& entry : m_Entries)
+  {
+    const KeyType& key = entry.first;
+    file.precision(std::numeric_limits<double>::max_digits10);
+    file << key.SolarZenithalAngle << " " << key.SolarAzimutalAngle << " " << key.ViewingZenithalAngle << " " << key.ViewingAzimutalAngle << " " << key.Month
+         << " " << key.Day << " " << key.AtmosphericPressure << " " << key.WaterVaporAmount << " " << key.OzoneAmount << " " << key.AerosolModel << " "
+         << key.AerosolOptical;
+    file.precision(std::numeric_limits<float>::max_digits10);
+    file << " " << key.MinSpectralValue << " " << key.MaxSpectralValue << " " << key.UserStep << " " << key.SpectralValues.size();
+    for (float value : key.SpectralValues)
+    {
+      file << " " << value;
+    }
+    file.precision(std::numeric_limits<double>::max_digits10);
+    for (double term : entry.second)
+    {
+      file << " " << term;
+    }
+    file << std::endl;
+  }
+}
+
+void SIXSRadiativeTermsCache::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Angle step                  : " << m_AngleStep << std::endl;
+  os << indent << "Atmospheric pressure step   : " << m_AtmosphericPressureStep << std::endl;
+  os << indent << "Water vapor amount step     : " << m_WaterVaporAmountStep << std::endl;
+  os << indent << "Ozone amount step           : " << m_OzoneAmountStep << std::endl;
+  os << indent << "Aerosol optical step        : " << m_AerosolOpticalStep << std::endl;
+  os << indent << "Interpolate aerosol optical : " << m_InterpolateAerosolOptical << std::endl;
+  os << indent << "Number of entries           : " << GetNumberOfEntries() << std::endl;
+  os << indent << "Number of 6S runs           : " << GetNumberOfSIXSRuns() << std::endl;
+}
+
+} // end namespace otb
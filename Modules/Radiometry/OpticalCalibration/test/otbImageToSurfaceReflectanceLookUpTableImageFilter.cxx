@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "itkMacro.h"
+
+#include "otbImageToSurfaceReflectanceLookUpTableImageFilter.h"
+#include "otbImageToRadianceImageFilter.h"
+#include "otbRadianceToReflectanceImageFilter.h"
+#include "otbVectorImage.h"
+#include "itkImageRegionIterator.h"
+
+int otbImageToSurfaceReflectanceLookUpTableImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  const unsigned int Dimension = 2;
+  typedef otb::VectorImage<float, Dimension>  InputImageType;
+  typedef otb::VectorImage<double, Dimension> OutputImageType;
+
+  typedef otb::ImageToRadianceImageFilter<InputImageType, OutputImageType>                      ImageToRadianceFilterType;
+  typedef otb::RadianceToReflectanceImageFilter<OutputImageType, OutputImageType>               RadianceToReflectanceFilterType;
+  typedef otb::ImageToSurfaceReflectanceLookUpTableImageFilter<InputImageType, OutputImageType> LookUpTableFilterType;
+  typedef LookUpTableFilterType::VectorType                                                     VectorType;
+
+  const unsigned int nbBands = 3;
+
+  InputImageType::RegionType region;
+  region.SetSize(0, 40);
+  region.SetSize(1, 10);
+
+  InputImageType::Pointer image = InputImageType::New();
+  image->SetRegions(region);
+  image->SetNumberOfComponentsPerPixel(nbBands);
+  image->Allocate();
+
+  // Integer DN, with null pixels, null bands, negative and non-integer values
+  unsigned int n = 0;
+  for (itk::ImageRegionIterator<InputImageType> it(image, region); !it.IsAtEnd(); ++it, ++n)
+  {
+    InputImageType::PixelType pixel(nbBands);
+    for (unsigned int i = 0; i < nbBands; ++i)
+    {
+      pixel[i] = static_cast<float>((n * 7919 + i * 104729) % 65536);
+    }
+    if (n % 50 == 0)
+      pixel.Fill(0.);
+    if (n % 50 == 1)
+      pixel[1] = 0.;
+    if (n % 50 == 2)
+      pixel[2] = 12.25;
+    if (n % 50 == 3)
+      pixel[0] = -3.;
+    if (n % 50 == 4)
+      pixel.Fill(1.);
+    it.Set(pixel);
+  }
+
+  VectorType alpha(nbBands), beta(nbBands), solarIllumination(nbBands);
+  for (unsigned int i = 0; i < nbBands; ++i)
+  {
+    alpha[i]             = 100. + 10. * i;
+    beta[i]              = -1. + 0.5 * i;
+    solarIllumination[i] = 1500. + 200. * i;
+  }
+
+  // Reference chain for the TOA reflectance
+  ImageToRadianceFilterType::Pointer       imageToRadiance       = ImageToRadianceFilterType::New();
+  RadianceToReflectanceFilterType::Pointer radianceToReflectance = RadianceToReflectanceFilterType::New();
+  imageToRadiance->SetInput(image);
+  imageToRadiance->SetAlpha(alpha);
+  imageToRadiance->SetBeta(beta);
+  radianceToReflectance->SetInput(imageToRadiance->GetOutput());
+  radianceToReflectance->SetSolarIllumination(solarIllumination);
+  radianceToReflectance->SetElevationSolarAngle(50.);
+  radianceToReflectance->SetDay(14);
+  radianceToReflectance->SetMonth(10);
+  radianceToReflectance->SetUseClamp(true);
+  radianceToReflectance->Update();
+
+  LookUpTableFilterType::SurfaceReflectanceFunctorVectorType surfaceFunctors(nbBands);
+  for (unsigned int i = 0; i < nbBands; ++i)
+  {
+    surfaceFunctors[i].SetCoefficient(1.2 + 0.1 * i);
+    surfaceFunctors[i].SetResidu(-0.05);
+    surfaceFunctors[i].SetSphericalAlbedo(0.1);
+  }
+
+  for (unsigned int surface = 0; surface < 2; ++surface)
+  {
+    LookUpTableFilterType::Pointer filter = LookUpTableFilterType::New();
+    filter->SetInput(image);
+    filter->SetAlpha(alpha);
+    filter->SetBeta(beta);
+    filter->SetSolarIllumination(solarIllumination);
+    filter->SetElevationSolarAngle(50.);
+    filter->SetDay(14);
+    filter->SetMonth(10);
+    filter->SetUseClamp(true);
+    if (surface)
+      filter->SetSurfaceReflectanceFunctorVector(surfaceFunctors);
+    filter->Update();
+
+    itk::ImageRegionConstIterator<OutputImageType> refIt(radianceToReflectance->GetOutput(), region);
+    itk::ImageRegionConstIterator<OutputImageType> lutIt(filter->GetOutput(), region);
+    for (; !refIt.IsAtEnd(); ++refIt, ++lutIt)
+    {
+      OutputImageType::PixelType expected = refIt.Get();
+      bool                       nullTOA  = true;
+      for (unsigned int i = 0; i < nbBands; ++i)
+      {
+        nullTOA = nullTOA && expected[i] == 0.;
+      }
+      if (surface && !nullTOA)
+      {
+        // Same as ReflectanceToSurfaceReflectanceImageFilter, null pixels stay null
+        for (unsigned int i = 0; i < nbBands; ++i)
+        {
+          expected[i] = surfaceFunctors[i](expected[i]);
+        }
+      }
+
+      for (unsigned int i = 0; i < nbBands; ++i)
+      {
+        if (std::abs(expected[i] - lutIt.Get()[i]) > 1e-12)
+        {
+          std::cout << "At " << refIt.GetIndex() << (surface ? " (TOC)" : " (TOA)") << ", the lookup table gives " << lutIt.Get() << " instead of "
+                    << expected << std::endl;
+          return EXIT_FAILURE;
+        }
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -34,6 +34,8 @@ void RegisterTests()
   REGISTER_TEST(otbImageToReflectanceImageFilterAuto);
   REGISTER_TEST(otbAtmosphericRadiativeTermsTest);
   REGISTER_TEST(otbImageToReflectanceImageFilter);
+  REGISTER_TEST(otbImageToSurfaceReflectanceLookUpTableImageFilter);
+  REGISTER_TEST(otbSIXSRadiativeTermsCache);
   REGISTER_TEST(otbRadianceToReflectanceImageFilter);
   REGISTER_TEST(otbReflectanceToImageImageFilterAuto);
   REGISTER_TEST(otbAeronetExtractData);
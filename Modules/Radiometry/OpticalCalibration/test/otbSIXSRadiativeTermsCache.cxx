@@ -0,0 +1,191 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSIXSRadiativeTermsCache.h"
+#include "otbRadiometryCorrectionParametersToAtmosphericRadiativeTerms.h"
+#include <cmath>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+namespace
+{
+typedef otb::AtmosphericCorrectionParameters        AtmoCorrectionParametersType;
+typedef otb::ImageMetadataCorrectionParameters      AcquiCorrectionParametersType;
+typedef otb::SIXSRadiativeTermsCache                CacheType;
+typedef otb::FilterFunctionValues::ValuesVectorType ValuesVectorType;
+
+struct SIXSInputs
+{
+  double           angles[4];
+  unsigned int     month;
+  unsigned int     day;
+  double           pressure;
+  double           water;
+  double           ozone;
+  unsigned int     aerosolModel;
+  double           aerosolOptical;
+  float            minSpectralValue;
+  float            maxSpectralValue;
+  ValuesVectorType values;
+};
+
+// Build fresh parameters, since 6S resampling updates the spectral band
+void MakeParameters(const SIXSInputs& in, AtmoCorrectionParametersType::Pointer& paramAtmo, AcquiCorrectionParametersType::Pointer& paramAcqui)
+{
+  paramAtmo  = AtmoCorrectionParametersType::New();
+  paramAcqui = AcquiCorrectionParametersType::New();
+
+  otb::FilterFunctionValues::Pointer functionValues = otb::FilterFunctionValues::New();
+  functionValues->SetFilterFunctionValues(in.values);
+  functionValues->SetMinSpectralValue(in.minSpectralValue);
+  functionValues->SetMaxSpectralValue(in.maxSpectralValue);
+  functionValues->SetUserStep(0.0025);
+  paramAcqui->SetWavelengthSpectralBandWithIndex(0, functionValues);
+
+  paramAcqui->SetSolarZenithalAngle(in.angles[0]);
+  paramAcqui->SetSolarAzimutalAngle(in.angles[1]);
+  paramAcqui->SetViewingZenithalAngle(in.angles[2]);
+  paramAcqui->SetViewingAzimutalAngle(in.angles[3]);
+  paramAcqui->SetMonth(in.month);
+  paramAcqui->SetDay(in.day);
+  paramAtmo->SetAtmosphericPressure(in.pressure);
+  paramAtmo->SetWaterVaporAmount(in.water);
+  paramAtmo->SetOzoneAmount(in.ozone);
+  paramAtmo->SetAerosolModel(static_cast<AtmoCorrectionParametersType::AerosolModelType>(in.aerosolModel));
+  paramAtmo->SetAerosolOptical(in.aerosolOptical);
+}
+
+CacheType::TermsType ComputeTerms(const SIXSInputs& in, CacheType* cache)
+{
+  AtmoCorrectionParametersType::Pointer  paramAtmo;
+  AcquiCorrectionParametersType::Pointer paramAcqui;
+  MakeParameters(in, paramAtmo, paramAcqui);
+
+  otb::AtmosphericRadiativeTerms::Pointer radiative = otb::RadiometryCorrectionParametersToAtmosphericRadiativeTerms::Compute(paramAtmo, paramAcqui, cache);
+
+  CacheType::TermsType terms = {{radiative->GetIntrinsicAtmosphericReflectance(0), radiative->GetSphericalAlbedo(0),
+                                 radiative->GetTotalGaseousTransmission(0), radiative->GetDownwardTransmittance(0), radiative->GetUpwardTransmittance(0),
+                                 radiative->GetUpwardDiffuseTransmittance(0), radiative->GetUpwardDirectTransmittance(0),
+                                 radiative->GetUpwardDiffuseTransmittanceForRayleigh(0), radiative->GetUpwardDiffuseTransmittanceForAerosol(0)}};
+  return terms;
+}
+
+bool Check(const std::string& what, const CacheType::TermsType& terms, const CacheType::TermsType& expected, double tolerance)
+{
+  for (unsigned int i = 0; i < terms.size(); ++i)
+  {
+    if (!(std::abs(terms[i] - expected[i]) <= tolerance))
+    {
+      std::cerr << what << ": term " << i << " is " << terms[i] << ", expected " << expected[i] << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+bool CheckRuns(const std::string& what, const CacheType* cache, unsigned long expected)
+{
+  if (cache->GetNumberOfSIXSRuns() != expected)
+  {
+    std::cerr << what << ": " << cache->GetNumberOfSIXSRuns() << " 6S runs, expected " << expected << std::endl;
+    return false;
+  }
+  return true;
+}
+}
+
+int otbSIXSRadiativeTermsCache(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " in6SFile cacheFile" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  SIXSInputs    in;
+  std::ifstream fin(argv[1]);
+  fin >> in.angles[0] >> in.angles[1] >> in.angles[2] >> in.angles[3] >> in.month >> in.day >> in.pressure >> in.water >> in.ozone >> in.aerosolModel >>
+      in.aerosolOptical >> in.minSpectralValue >> in.maxSpectralValue;
+  std::string line;
+  std::getline(fin, line);
+  while (std::getline(fin, line))
+  {
+    in.values.push_back(atof(line.c_str()));
+  }
+
+  bool ok = true;
+
+  // Exact keys give the plain 6S terms, and run 6S once
+  const CacheType::TermsType reference = ComputeTerms(in, nullptr);
+  CacheType::Pointer         cache     = CacheType::New();
+
+  ok = Check("first call", ComputeTerms(in, cache), reference, 0.) && ok;
+  ok = Check("cached call", ComputeTerms(in, cache), reference, 0.) && ok;
+  ok = CheckRuns("cached call", cache, 1) && ok;
+
+  // Entries survive a save / load cycle
+  cache->Save(argv[2]);
+  CacheType::Pointer loaded = CacheType::New();
+  loaded->Load(argv[2]);
+  ok = Check("loaded cache", ComputeTerms(in, loaded), reference, 0.) && ok;
+  ok = CheckRuns("loaded cache", loaded, 0) && ok;
+
+  // Quantised angles run 6S at the grid node
+  CacheType::Pointer quantised = CacheType::New();
+  quantised->SetAngleStep(5.);
+  SIXSInputs node = in;
+  for (double& angle : node.angles)
+  {
+    angle = std::round(angle / 5.) * 5.;
+  }
+  const CacheType::TermsType nodeReference = ComputeTerms(node, nullptr);
+
+  ok = Check("quantised angles", ComputeTerms(in, quantised), nodeReference, 0.) && ok;
+  ok = Check("grid node angles", ComputeTerms(node, quantised), nodeReference, 0.) && ok;
+  ok = CheckRuns("quantised angles", quantised, 1) && ok;
+
+  // Interpolation on a regular aerosol optical thickness grid
+  CacheType::Pointer interpolated = CacheType::New();
+  interpolated->SetAerosolOpticalStep(0.1);
+  interpolated->InterpolateAerosolOpticalOn();
+  SIXSInputs lower      = in;
+  SIXSInputs upper      = in;
+  SIXSInputs inside     = in;
+  lower.aerosolOptical  = 0.2;
+  upper.aerosolOptical  = 0.2 + 0.1;
+  inside.aerosolOptical = 0.23;
+
+  const CacheType::TermsType lowerTerms = ComputeTerms(lower, nullptr);
+  const CacheType::TermsType upperTerms = ComputeTerms(upper, nullptr);
+  CacheType::TermsType       expected;
+  for (unsigned int i = 0; i < expected.size(); ++i)
+  {
+    expected[i] = 0.7 * lowerTerms[i] + 0.3 * upperTerms[i];
+  }
+  ok = Check("interpolated thickness", ComputeTerms(inside, interpolated), expected, 1e-12) && ok;
+  ok = CheckRuns("interpolated thickness", interpolated, 2) && ok;
+  inside.aerosolOptical = 0.27;
+  ComputeTerms(inside, interpolated);
+  ok = CheckRuns("same grid cell", interpolated, 2) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,147 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSarCalibrationDeburstMultilookImageFilter_h
+#define otbSarCalibrationDeburstMultilookImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbSarRadiometricCalibrationFunction.h"
+
+namespace otb
+{
+/** \class SarCalibrationDeburstMultilookImageFilter
+ * \brief Calibrates, debursts and multilooks a SAR image in a single pass
+ *
+ * This filter chains the radiometric calibration of
+ * SarRadiometricCalibrationToImageFilter, the line selection of
+ * SarDeburstImageFilter and a multilook averaging of the calibrated
+ * intensity over AzimuthLooks lines and RangeLooks samples. Each output
+ * line is computed from the input lines it covers, which are calibrated
+ * once and accumulated directly: no intermediate calibrated or deburst
+ * image is allocated.
+ *
+ * The deburst step is optional (see SetDeburst()), so that detected
+ * products can also be calibrated and multilooked. When it is enabled, the
+ * input image has to fulfill the same requirements as for
+ * SarDeburstImageFilter.
+ *
+ * Output pixels only average complete looks: the output size is the deburst
+ * size divided by the number of looks. The output spacing is multiplied by
+ * the number of looks and the origin is moved to the center of the first
+ * look, so that the output stays consistent with the sensor model.
+ *
+ * \sa SarRadiometricCalibrationToImageFilter
+ * \sa SarDeburstImageFilter
+ *
+ * \ingroup OTBSARCalibration
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT SarCalibrationDeburstMultilookImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard class typedefs */
+  typedef SarCalibrationDeburstMultilookImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  itkNewMacro(Self);
+  itkTypeMacro(SarCalibrationDeburstMultilookImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                                    InputImageType;
+  typedef typename InputImageType::RegionType            InputImageRegionType;
+  typedef TOutputImage                                   OutputImageType;
+  typedef typename OutputImageType::RegionType           OutputImageRegionType;
+  typedef typename OutputImageType::PixelType            OutputImagePixelType;
+  typedef SarRadiometricCalibrationFunction<TInputImage> FunctionType;
+  typedef typename FunctionType::Pointer                 FunctionPointer;
+
+  typedef std::pair<unsigned long, unsigned long> RecordType;
+  typedef std::vector<RecordType> LinesRecordVectorType;
+
+  /** Enable/disable the noise removal */
+  itkSetMacro(EnableNoise, bool);
+  itkGetConstMacro(EnableNoise, bool);
+
+  /** Lookup used for calibration (see SarCalibrationLookupData) */
+  itkSetMacro(LookupSelected, short);
+  itkGetConstMacro(LookupSelected, short);
+
+  /** Enable/disable the removal of the lines between bursts */
+  itkSetMacro(Deburst, bool);
+  itkGetConstMacro(Deburst, bool);
+  itkBooleanMacro(Deburst);
+
+  /** Keep only the valid samples of the bursts (requires Deburst) */
+  itkSetMacro(OnlyValidSample, bool);
+  itkGetConstMacro(OnlyValidSample, bool);
+
+  /** Number of lines averaged in azimuth */
+  itkSetClampMacro(AzimuthLooks, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+  itkGetConstMacro(AzimuthLooks, unsigned int);
+
+  /** Number of samples averaged in range */
+  itkSetClampMacro(RangeLooks, unsigned int, 1, itk::NumericTraits<unsigned int>::max());
+  itkGetConstMacro(RangeLooks, unsigned int);
+
+protected:
+  SarCalibrationDeburstMultilookImageFilter();
+
+  ~SarCalibrationDeburstMultilookImageFilter() override
+  {
+  }
+
+  void GenerateOutputInformation() override;
+
+  void GenerateInputRequestedRegion() override;
+
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  SarCalibrationDeburstMultilookImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  FunctionPointer m_Function;
+
+  bool         m_EnableNoise;
+  short        m_LookupSelected;
+  bool         m_Deburst;
+  bool         m_OnlyValidSample;
+  unsigned int m_AzimuthLooks;
+  unsigned int m_RangeLooks;
+
+  /** Input line index of each deburst line */
+  std::vector<long> m_InputLines;
+
+  /** Input sample index of the first deburst sample */
+  long m_FirstInputSample;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSarCalibrationDeburstMultilookImageFilter.hxx"
+#endif
+
+#endif
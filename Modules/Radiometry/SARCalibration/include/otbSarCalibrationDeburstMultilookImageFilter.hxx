@@ -0,0 +1,255 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSarCalibrationDeburstMultilookImageFilter_hxx
+#define otbSarCalibrationDeburstMultilookImageFilter_hxx
+
+#include "otbSarCalibrationDeburstMultilookImageFilter.h"
+
+#include "otbSarSensorModel.h"
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+SarCalibrationDeburstMultilookImageFilter<TInputImage, TOutputImage>::SarCalibrationDeburstMultilookImageFilter()
+  : m_EnableNoise(false),
+    m_LookupSelected(0),
+    m_Deburst(true),
+    m_OnlyValidSample(false),
+    m_AzimuthLooks(1),
+    m_RangeLooks(1),
+    m_InputLines(),
+    m_FirstInputSample(0)
+{
+  m_Function = FunctionType::New();
+}
+
+template <class TInputImage, class TOutputImage>
+void SarCalibrationDeburstMultilookImageFilter<TInputImage, TOutputImage>::GenerateOutputInformation()
+{
+  // Call superclass implementation
+  Superclass::GenerateOutputInformation();
+
+  const InputImageType* inputPtr  = this->GetInput();
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  auto imd = inputPtr->GetImageMetadata();
+
+  const InputImageRegionType                      inputLargestRegion = inputPtr->GetLargestPossibleRegion();
+  const typename InputImageRegionType::IndexType& index              = inputLargestRegion.GetIndex();
+  typename InputImageRegionType::SizeType         size               = inputLargestRegion.GetSize();
+  typename InputImageType::PointType              origin             = inputPtr->GetOrigin();
+  typename InputImageType::SpacingType            spacing            = inputPtr->GetSignedSpacing();
+
+  m_InputLines.clear();
+  m_FirstInputSample = index[0];
+
+  if (m_Deburst)
+  {
+    // Same requirements and geometry as SarDeburstImageFilter
+    if (std::abs(spacing[1] - 1.) >= std::numeric_limits<double>::epsilon())
+      itkExceptionMacro("Can not perform deburst if input image azimuth spacing is not 1.");
+
+    if (std::abs(origin[1] - static_cast<long>(origin[1]) - 0.5) >= std::numeric_limits<double>::epsilon())
+      itkExceptionMacro("Can not perform deburst if input image azimuth origin is not N.5");
+
+    SarSensorModel        sarSensorModel(imd);
+    LinesRecordVectorType linesRecord;
+    RecordType            samplesRecord;
+
+    if (!sarSensorModel.Deburst(linesRecord, samplesRecord, m_OnlyValidSample) || linesRecord.empty())
+      itkExceptionMacro(<< "Could not deburst SAR sensor model from input image");
+
+    const long firstInputLine = static_cast<long>(origin[1] - 0.5);
+    const long lastInputLine  = firstInputLine + static_cast<long>(size[1]) - 1;
+
+    unsigned long outputOriginLine = 0;
+    SarSensorModel::ImageLineToDeburstLine(linesRecord, firstInputLine, outputOriginLine);
+    origin[1] = 0.5 + outputOriginLine;
+
+    // Kept lines of the input extract, in deburst order
+    for (const auto& record : linesRecord)
+    {
+      const long first = std::max(static_cast<long>(record.first), firstInputLine);
+      const long last  = std::min(static_cast<long>(record.second), lastInputLine);
+      for (long line = first; line <= last; ++line)
+      {
+        m_InputLines.push_back(line - firstInputLine + index[1]);
+      }
+    }
+
+    if (m_OnlyValidSample)
+    {
+      const long originOffsetSamples = static_cast<long>(origin[0] - 0.5);
+      const long firstSample         = std::max(static_cast<long>(samplesRecord.first), originOffsetSamples);
+      const long lastSample          = std::min(static_cast<long>(samplesRecord.second), static_cast<long>(size[0]) + originOffsetSamples - 1);
+
+      origin[0]          = 0.5 + (firstSample - static_cast<long>(samplesRecord.first));
+      size[0]            = lastSample - firstSample + 1;
+      m_FirstInputSample = firstSample - originOffsetSamples + index[0];
+    }
+
+    size[1] = m_InputLines.size();
+
+    imd.Add(MDNum::NumberOfLines, size[1]);
+    imd.Add(MDNum::NumberOfColumns, size[0]);
+  }
+  else
+  {
+    for (unsigned long line = 0; line < size[1]; ++line)
+    {
+      m_InputLines.push_back(index[1] + line);
+    }
+  }
+
+  // Multilook: only complete looks are kept
+  typename OutputImageRegionType::SizeType outputSize;
+  outputSize[0] = size[0] / m_RangeLooks;
+  outputSize[1] = size[1] / m_AzimuthLooks;
+
+  if (outputSize[0] == 0 || outputSize[1] == 0)
+  {
+    itkExceptionMacro(<< "Input image (" << size[0] << " x " << size[1] << " after deburst) is smaller than the number of looks (" << m_RangeLooks
+                      << " x " << m_AzimuthLooks << ")");
+  }
+
+  const unsigned int looks[2] = {m_RangeLooks, m_AzimuthLooks};
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    origin[dim] += 0.5 * (looks[dim] - 1) * spacing[dim];
+    spacing[dim] *= looks[dim];
+  }
+
+  OutputImageRegionType outputLargestRegion;
+  outputLargestRegion.SetIndex(index);
+  outputLargestRegion.SetSize(outputSize);
+
+  outputPtr->SetLargestPossibleRegion(outputLargestRegion);
+  outputPtr->SetOrigin(origin);
+  outputPtr->SetSignedSpacing(spacing);
+  outputPtr->SetImageMetadata(imd);
+}
+
+template <class TInputImage, class TOutputImage>
+void SarCalibrationDeburstMultilookImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  const OutputImageRegionType                      outputRequestedRegion = this->GetOutput()->GetRequestedRegion();
+  const typename OutputImageRegionType::IndexType& outputIndex           = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+
+  const long firstLine = (outputRequestedRegion.GetIndex()[1] - outputIndex[1]) * m_AzimuthLooks;
+  const long lastLine  = firstLine + outputRequestedRegion.GetSize()[1] * m_AzimuthLooks - 1;
+
+  typename InputImageRegionType::IndexType inputIndex;
+  typename InputImageRegionType::SizeType  inputSize;
+  inputIndex[0] = m_FirstInputSample + (outputRequestedRegion.GetIndex()[0] - outputIndex[0]) * m_RangeLooks;
+  inputIndex[1] = m_InputLines[firstLine];
+  inputSize[0]  = outputRequestedRegion.GetSize()[0] * m_RangeLooks;
+  inputSize[1]  = m_InputLines[lastLine] - m_InputLines[firstLine] + 1;
+
+  InputImageRegionType inputRequestedRegion(inputIndex, inputSize);
+
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion());
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void SarCalibrationDeburstMultilookImageFilter<TInputImage, TOutputImage>::BeforeThreadedGenerateData()
+{
+  const InputImageType* inputPtr = this->GetInput();
+
+  m_Function->SetInputImage(inputPtr);
+  m_Function->SetEnableNoise(m_EnableNoise);
+  m_Function->InitializeCalibration(inputPtr->GetImageMetadata(), m_LookupSelected);
+}
+
+template <class TInputImage, class TOutputImage>
+void SarCalibrationDeburstMultilookImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                   itk::ThreadIdType            threadId)
+{
+  typedef typename FunctionType::OutputType CalibratedValueType;
+
+  const typename OutputImageRegionType::IndexType& outputIndex = this->GetOutput()->GetLargestPossibleRegion().GetIndex();
+
+  itk::ImageScanlineIterator<OutputImageType> outputIt(this->GetOutput(), outputRegionForThread);
+
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize()[1]);
+
+  const unsigned int width     = outputRegionForThread.GetSize()[0];
+  const unsigned int nbSamples = width * m_RangeLooks;
+  const double       norm      = 1. / (m_AzimuthLooks * m_RangeLooks);
+
+  std::vector<CalibratedValueType> calibrated(nbSamples);
+  std::vector<double>              sums(width);
+
+  typename InputImageType::IndexType inputIndex;
+  inputIndex[0] = m_FirstInputSample + (outputRegionForThread.GetIndex()[0] - outputIndex[0]) * m_RangeLooks;
+
+  while (!outputIt.IsAtEnd())
+  {
+    const long firstLine = (outputIt.GetIndex()[1] - outputIndex[1]) * m_AzimuthLooks;
+
+    std::fill(sums.begin(), sums.end(), 0.);
+
+    // Each input line of the look is calibrated once and accumulated
+    for (unsigned int k = 0; k < m_AzimuthLooks; ++k)
+    {
+      inputIndex[1] = m_InputLines[firstLine + k];
+      m_Function->EvaluateAtLine(inputIndex, nbSamples, calibrated.data());
+
+      const CalibratedValueType* value = calibrated.data();
+      for (unsigned int i = 0; i < width; ++i)
+      {
+        for (unsigned int r = 0; r < m_RangeLooks; ++r, ++value)
+        {
+          sums[i] += *value;
+        }
+      }
+    }
+
+    for (unsigned int i = 0; !outputIt.IsAtEndOfLine(); ++outputIt, ++i)
+    {
+      outputIt.Set(static_cast<OutputImagePixelType>(sums[i] * norm));
+    }
+
+    outputIt.NextLine();
+    progress.CompletedPixel();
+  }
+}
+
+template <class TInputImage, class TOutputImage>
+void SarCalibrationDeburstMultilookImageFilter<TInputImage, TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+
+  os << indent << "EnableNoise: " << m_EnableNoise << std::endl;
+  os << indent << "LookupSelected: " << m_LookupSelected << std::endl;
+  os << indent << "Deburst: " << m_Deburst << std::endl;
+  os << indent << "OnlyValidSample: " << m_OnlyValidSample << std::endl;
+  os << indent << "AzimuthLooks: " << m_AzimuthLooks << std::endl;
+  os << indent << "RangeLooks: " << m_RangeLooks << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -25,6 +25,7 @@
 #include "otbSarCalibrationLookupData.h"
 
 #include "otbSentinel1ThermalNoiseLookupData.h"
+#include "otbImageMetadata.h"
 
 #include "otbMath.h"
 namespace otb
@@ -103,12 +104,22 @@ public:
     return this->EvaluateAtIndex(index);
   }
 
+  /** Evaluate the function at nbValues consecutive pixels of a line, starting
+   * at index. When the calibration only relies on lookup data, the lookup
+   * values are computed once for the whole line. */
+  void EvaluateAtLine(const IndexType& index, unsigned int nbValues, OutputType* values) const;
+
   /** Set the input image.
    * \warning this method caches BufferedRegion information.
    * If the BufferedRegion has changed, user must call
    * SetInputImage again to update cached values. */
   void SetInputImage(const InputImageType* ptr) override;
 
+  /** Set up the corrections, the lookup data and the noise from the SARCalib
+   * metadata of the image. lookupSelected is the lookup data used in
+   * calibration when it is available (see SarCalibrationLookupData). */
+  void InitializeCalibration(const ImageMetadata& imd, short lookupSelected);
+
 
   /** Get/Set the Scale value */
   itkSetMacro(Scale, RealType);
@@ -176,6 +187,17 @@ public:
     m_NoiseLut = lut;
   }
 
+  /** Get the calibration and noise lookup data instances */
+  const SarCalibrationLookupData* GetCalibrationLookupData() const
+  {
+    return m_Lut.GetPointer();
+  }
+
+  const SarCalibrationLookupData* GetNoiseLookupData() const
+  {
+    return m_NoiseLut.GetPointer();
+  }
+
 protected:
   /** ctor */
   SarRadiometricCalibrationFunction();
@@ -24,6 +24,8 @@
 
 #include "otbSarRadiometricCalibrationFunction.h"
 #include "itkNumericTraits.h"
+#include "otbSARMetadata.h"
+#include <boost/any.hpp>
 
 namespace otb
 {
@@ -70,6 +72,196 @@ void SarRadiometricCalibrationFunction<TInputImage, TCoordRep>::SetInputImage(co
   m_RangeSpreadLoss->SetInputImage(ptr);
 }
 
+/**
+ * Set up the calibration from the image metadata
+ */
+template <class TInputImage, class TCoordRep>
+void SarRadiometricCalibrationFunction<TInputImage, TCoordRep>::InitializeCalibration(const ImageMetadata& imd, short lookupSelected)
+{
+  /** Fetch the SARCalib */
+  std::unique_ptr<SARCalib> sarCalibPtr;
+  if (imd.Has(MDGeom::SARCalib))
+  {
+    sarCalibPtr = std::make_unique<SARCalib>(boost::any_cast<SARCalib>(imd[MDGeom::SARCalib]));
+  }
+  else if ((imd.Bands.size() > 0) && imd.Bands[0].Has(MDGeom::SARCalib))
+  {
+    sarCalibPtr = std::make_unique<SARCalib>(boost::any_cast<SARCalib>(imd.Bands[0][MDGeom::SARCalib]));
+  }
+  else
+      throw std::runtime_error("SarRadiometricCalibrationFunction was not able to fetch the SARCalib metadata.");
+
+  /** Check if a calibration lookupdata is available with the
+    * product. eg. Sentinel1. This means
+    * A. The computation of the backscatter is based on this lookup value which
+    * depends on the given product.*
+    * B. The other value such as antenna pattern gain, rangespread loss, incidence
+    * angle has no effect in calibration  */
+  bool apply = sarCalibPtr->calibrationLookupFlag;
+
+  /* Below lines will toggle the necessary flags which can help skip some
+   * computation. For example, if there is lookup value and ofcourse antenna
+   * pattern gain is not required. Even if we try to compute the value with
+   * sarCalibetricFunction we  get 1. This is the safe side. But as we are so sure
+   * we skip all those calls to EvaluateParametricCoefficient and also the
+   * Evaluate(). For the function the value is 1 by default.
+   */
+  this->SetApplyAntennaPatternGain(!apply);
+  this->SetApplyIncidenceAngleCorrection(!apply);
+  this->SetApplyRangeSpreadLossCorrection(!apply);
+  this->SetApplyRescalingFactor(!apply);
+  this->SetApplyLookupDataCorrection(apply);
+
+  if (imd.Has(MDNum::CalScale))
+    this->SetScale(imd[MDNum::CalScale]);
+  else if ((imd.Bands.size() > 0) && (imd.Bands[0].Has(MDNum::CalScale)))
+    this->SetScale(imd.Bands[0][MDNum::CalScale]);
+
+  /* Compute noise if enabled */
+  if (this->GetEnableNoise())
+  {
+    // Use a denoising LUT if available (e.g Sentinel 1 thermal noise LUT)
+    if (sarCalibPtr->calibrationLookupData.find(SarCalibrationLookupData::NOISE) 
+          != sarCalibPtr->calibrationLookupData.end())
+    {
+      this->SetNoiseLookupData(sarCalibPtr->calibrationLookupData[SarCalibrationLookupData::NOISE]);
+    }
+    // Use a parametric function instead
+    else
+    {
+      ParametricFunctionPointer noise;
+      noise = this->GetNoise();
+      noise->SetPointSet(sarCalibPtr->radiometricCalibrationNoise);
+      noise->SetPolynomalSize(sarCalibPtr->radiometricCalibrationNoisePolynomialDegree);
+      noise->EvaluateParametricCoefficient();
+    }
+  }
+
+  /* Compute old and new antenna pattern gain */
+  if (this->GetApplyAntennaPatternGain())
+  {
+    ParametricFunctionPointer antennaPatternNewGain;
+    antennaPatternNewGain = this->GetAntennaPatternNewGain();
+    antennaPatternNewGain->SetPointSet(sarCalibPtr->radiometricCalibrationAntennaPatternNewGain);
+    antennaPatternNewGain->SetPolynomalSize(sarCalibPtr->radiometricCalibrationAntennaPatternNewGainPolynomialDegree);
+    antennaPatternNewGain->EvaluateParametricCoefficient();
+
+    ParametricFunctionPointer antennaPatternOldGain;
+    antennaPatternOldGain = this->GetAntennaPatternOldGain();
+    antennaPatternOldGain->SetPointSet(sarCalibPtr->radiometricCalibrationAntennaPatternOldGain);
+    antennaPatternOldGain->SetPolynomalSize(sarCalibPtr->radiometricCalibrationAntennaPatternOldGainPolynomialDegree);
+    antennaPatternOldGain->EvaluateParametricCoefficient();
+  }
+
+  /* Compute incidence angle */
+  if (this->GetApplyIncidenceAngleCorrection())
+  {
+    ParametricFunctionPointer incidenceAngle;
+    incidenceAngle = this->GetIncidenceAngle();
+    incidenceAngle->SetPointSet(sarCalibPtr->radiometricCalibrationIncidenceAngle);
+    incidenceAngle->SetPolynomalSize(sarCalibPtr->radiometricCalibrationIncidenceAnglePolynomialDegree);
+    incidenceAngle->EvaluateParametricCoefficient();
+  }
+
+  /* Compute Range spread Loss */
+  if (this->GetApplyRangeSpreadLossCorrection())
+  {
+    ParametricFunctionPointer rangeSpreadLoss;
+    rangeSpreadLoss = this->GetRangeSpreadLoss();
+    rangeSpreadLoss->SetPointSet(sarCalibPtr->radiometricCalibrationRangeSpreadLoss);
+    rangeSpreadLoss->SetPolynomalSize(sarCalibPtr->radiometricCalibrationRangeSpreadLossPolynomialDegree);
+    rangeSpreadLoss->EvaluateParametricCoefficient();
+  }
+
+  /** Get the lookupdata instance. Unlike all the above this is not a
+   * parametricFunction instance. But rather an internal class in IMI called
+   * SarCalibrationLookupData.
+   *
+   * NOTE: As the computation of lookup data for sensors is not universal. One must
+   * provide a sub-class.
+   * See Also: otbSentinel1ImageMetadataInterface, otbTerraSarImageMetadataInterface,
+   * otbRadarsat2ImageMetadataInterface  
+   */
+  if (this->GetApplyLookupDataCorrection())
+  {
+    this->SetCalibrationLookupData(sarCalibPtr->calibrationLookupData[lookupSelected]);
+  }
+
+  /** This was introduced for cosmoskymed which required a rescaling factor */
+  if (this->GetApplyRescalingFactor())
+  {
+    this->SetRescalingFactor(sarCalibPtr->rescalingFactor);
+  }
+}
+
+/**
+ * Evaluate a run of pixels of a line
+ */
+template <class TInputImage, class TCoordRep>
+void SarRadiometricCalibrationFunction<TInputImage, TCoordRep>::EvaluateAtLine(const IndexType& index, unsigned int nbValues, OutputType* values) const
+{
+  // The line path only handles lookup based calibration with a constant
+  // parametric noise (zero when a noise lookup is used)
+  const bool parametricCorrections =
+      m_ApplyAntennaPatternGain || m_ApplyIncidenceAngleCorrection || m_ApplyRangeSpreadLossCorrection || m_ApplyRescalingFactor;
+  const bool constantNoise = !m_EnableNoise || m_Noise->GetCoeff().size() == 1;
+
+  if (!m_ApplyLookupDataCorrection || !m_Lut || parametricCorrections || !constantNoise)
+  {
+    IndexType currentIndex = index;
+    for (unsigned int i = 0; i < nbValues; ++i, ++currentIndex[0])
+    {
+      values[i] = this->EvaluateAtIndex(currentIndex);
+    }
+    return;
+  }
+
+  const bool useNoiseLut = m_EnableNoise && m_NoiseLut;
+
+  // A constant parametric function does not depend on the evaluated point
+  PointType origin;
+  origin.Fill(0.);
+  const RealType noise = m_EnableNoise ? static_cast<RealType>(m_Noise->Evaluate(origin)) : 0.;
+
+  std::vector<double> lutValues(nbValues);
+  std::vector<double> noiseValues(useNoiseLut ? nbValues : 0);
+  m_Lut->GetLineValues(index[0], index[1], nbValues, lutValues.data());
+  if (useNoiseLut)
+  {
+    m_NoiseLut->GetLineValues(index[0], index[1], nbValues, noiseValues.data());
+  }
+
+  // Same sequence of operations as EvaluateAtIndex()
+  const InputPixelType* inputPtr = &this->GetInputImage()->GetPixel(index);
+  for (unsigned int i = 0; i < nbValues; ++i)
+  {
+    const std::complex<float> pVal          = inputPtr[i];
+    const RealType            digitalNumber = std::sqrt((pVal.real() * pVal.real()) + (pVal.imag() * pVal.imag()));
+
+    RealType sigma = m_Scale * digitalNumber * digitalNumber;
+
+    if (m_EnableNoise)
+    {
+      sigma -= noise;
+    }
+
+    if (useNoiseLut)
+    {
+      sigma = std::max(0., sigma - noiseValues[i]);
+    }
+
+    const RealType lutVal = static_cast<RealType>(lutValues[i]);
+    sigma /= lutVal * lutVal;
+
+    if (sigma < 0.0)
+    {
+      sigma = 0.0;
+    }
+
+    values[i] = static_cast<OutputType>(sigma);
+  }
+}
+
 /**
  * Print
  */
@@ -116,6 +116,11 @@ protected:
   /** Update the function list and input parameters*/
   void BeforeThreadedGenerateData() override;
 
+  /** When the calibration only relies on lookup data, the lookup values are
+   * computed once per output line and applied to the whole scanline.
+   * Otherwise the function is evaluated at each pixel. */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
 private:
   SarRadiometricCalibrationToImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
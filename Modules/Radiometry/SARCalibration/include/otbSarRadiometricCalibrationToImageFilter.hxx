@@ -24,8 +24,8 @@
 
 #include "otbSarRadiometricCalibrationToImageFilter.h"
 #include "otbSarCalibrationLookupData.h"
-#include "otbSARMetadata.h"
-#include <boost/any.hpp>
+#include "itkImageScanlineIterator.h"
+#include "itkProgressReporter.h"
 
 namespace otb
 {
@@ -66,125 +66,35 @@ void SarRadiometricCalibrationToImageFilter<TInputImage, TOutputImage>::BeforeTh
   // will SetInputImage on the function
   Superclass::BeforeThreadedGenerateData();
   
-  /** Retrieve the ImageMetadata */
-  auto imd = this->GetInput()->GetImageMetadata();
-  
-  /** Fetch the SARCalib */
-  std::unique_ptr<SARCalib> sarCalibPtr;
-  if (imd.Has(MDGeom::SARCalib))
-  {
-    sarCalibPtr = std::make_unique<SARCalib>(boost::any_cast<SARCalib>(imd[MDGeom::SARCalib]));
-  }
-  else if ((imd.Bands.size() > 0) && imd.Bands[0].Has(MDGeom::SARCalib))
-  {
-    sarCalibPtr = std::make_unique<SARCalib>(boost::any_cast<SARCalib>(imd.Bands[0][MDGeom::SARCalib]));
-  }
-  else
-      throw std::runtime_error("otbSarRadiometricCalibrationToImageFilter was not able to fetch the SARCalib metadata.");
-
-  /** Get the SarRadiometricCalibrationFunction function instance.  */
-  FunctionPointer function = this->GetFunction();
-
-  /** Check if a calibration lookupdata is available with the
-    * product. eg. Sentinel1. This means
-    * A. The computation of the backscatter is based on this lookup value which
-    * depends on the given product.*
-    * B. The other value such as antenna pattern gain, rangespread loss, incidence
-    * angle has no effect in calibration  */
-  bool apply = sarCalibPtr->calibrationLookupFlag;
-
-  /* Below lines will toggle the necessary flags which can help skip some
-   * computation. For example, if there is lookup value and ofcourse antenna
-   * pattern gain is not required. Even if we try to compute the value with
-   * sarCalibetricFunction we  get 1. This is the safe side. But as we are so sure
-   * we skip all those calls to EvaluateParametricCoefficient and also the
-   * Evaluate(). For the function the value is 1 by default.
-   */
-  function->SetApplyAntennaPatternGain(!apply);
-  function->SetApplyIncidenceAngleCorrection(!apply);
-  function->SetApplyRangeSpreadLossCorrection(!apply);
-  function->SetApplyRescalingFactor(!apply);
-  function->SetApplyLookupDataCorrection(apply);
-
-  if (imd.Has(MDNum::CalScale))
-    function->SetScale(imd[MDNum::CalScale]);
-  else if ((imd.Bands.size() > 0) && (imd.Bands[0].Has(MDNum::CalScale)))
-    function->SetScale(imd.Bands[0][MDNum::CalScale]);
-
-  /* Compute noise if enabled */
-  if (function->GetEnableNoise())
-  {
-    // Use a denoising LUT if available (e.g Sentinel 1 thermal noise LUT)
-    if (sarCalibPtr->calibrationLookupData.find(SarCalibrationLookupData::NOISE) 
-          != sarCalibPtr->calibrationLookupData.end())
-    {
-      function->SetNoiseLookupData(sarCalibPtr->calibrationLookupData[SarCalibrationLookupData::NOISE]);
-    }
-    // Use a parametric function instead
-    else
-    {
-      ParametricFunctionPointer noise;
-      noise = function->GetNoise();
-      noise->SetPointSet(sarCalibPtr->radiometricCalibrationNoise);
-      noise->SetPolynomalSize(sarCalibPtr->radiometricCalibrationNoisePolynomialDegree);
-      noise->EvaluateParametricCoefficient();
-    }
-  }
+  this->GetFunction()->InitializeCalibration(this->GetInput()->GetImageMetadata(), this->GetLookupSelected());
+}
 
-  /* Compute old and new antenna pattern gain */
-  if (function->GetApplyAntennaPatternGain())
-  {
-    ParametricFunctionPointer antennaPatternNewGain;
-    antennaPatternNewGain = function->GetAntennaPatternNewGain();
-    antennaPatternNewGain->SetPointSet(sarCalibPtr->radiometricCalibrationAntennaPatternNewGain);
-    antennaPatternNewGain->SetPolynomalSize(sarCalibPtr->radiometricCalibrationAntennaPatternNewGainPolynomialDegree);
-    antennaPatternNewGain->EvaluateParametricCoefficient();
-
-    ParametricFunctionPointer antennaPatternOldGain;
-    antennaPatternOldGain = function->GetAntennaPatternOldGain();
-    antennaPatternOldGain->SetPointSet(sarCalibPtr->radiometricCalibrationAntennaPatternOldGain);
-    antennaPatternOldGain->SetPolynomalSize(sarCalibPtr->radiometricCalibrationAntennaPatternOldGainPolynomialDegree);
-    antennaPatternOldGain->EvaluateParametricCoefficient();
-  }
+template <class TInputImage, class TOutputImage>
+void SarRadiometricCalibrationToImageFilter<TInputImage, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                               itk::ThreadIdType            threadId)
+{
+  typedef typename FunctionType::OutputType CalibratedValueType;
 
-  /* Compute incidence angle */
-  if (function->GetApplyIncidenceAngleCorrection())
-  {
-    ParametricFunctionPointer incidenceAngle;
-    incidenceAngle = function->GetIncidenceAngle();
-    incidenceAngle->SetPointSet(sarCalibPtr->radiometricCalibrationIncidenceAngle);
-    incidenceAngle->SetPolynomalSize(sarCalibPtr->radiometricCalibrationIncidenceAnglePolynomialDegree);
-    incidenceAngle->EvaluateParametricCoefficient();
-  }
+  const FunctionType* function = this->GetFunction();
 
-  /* Compute Range spread Loss */
-  if (function->GetApplyRangeSpreadLossCorrection())
-  {
-    ParametricFunctionPointer rangeSpreadLoss;
-    rangeSpreadLoss = function->GetRangeSpreadLoss();
-    rangeSpreadLoss->SetPointSet(sarCalibPtr->radiometricCalibrationRangeSpreadLoss);
-    rangeSpreadLoss->SetPolynomalSize(sarCalibPtr->radiometricCalibrationRangeSpreadLossPolynomialDegree);
-    rangeSpreadLoss->EvaluateParametricCoefficient();
-  }
+  itk::ImageScanlineIterator<OutputImageType> outputIt(this->GetOutput(), outputRegionForThread);
 
-  /** Get the lookupdata instance. Unlike all the above this is not a
-   * parametricFunction instance. But rather an internal class in IMI called
-   * SarCalibrationLookupData.
-   *
-   * NOTE: As the computation of lookup data for sensors is not universal. One must
-   * provide a sub-class.
-   * See Also: otbSentinel1ImageMetadataInterface, otbTerraSarImageMetadataInterface,
-   * otbRadarsat2ImageMetadataInterface  
-   */
-  if (function->GetApplyLookupDataCorrection())
-  {
-    function->SetCalibrationLookupData(sarCalibPtr->calibrationLookupData[this->GetLookupSelected()]);
-  }
+  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetSize()[1]);
+
+  const unsigned int               width = outputRegionForThread.GetSize()[0];
+  std::vector<CalibratedValueType> values(width);
 
-  /** This was introduced for cosmoskymed which required a rescaling factor */
-  if (function->GetApplyRescalingFactor())
+  while (!outputIt.IsAtEnd())
   {
-    function->SetRescalingFactor(sarCalibPtr->rescalingFactor);
+    function->EvaluateAtLine(outputIt.GetIndex(), width, values.data());
+
+    for (unsigned int i = 0; !outputIt.IsAtEndOfLine(); ++outputIt, ++i)
+    {
+      outputIt.Set(static_cast<OutputImagePixelType>(values[i]));
+    }
+
+    outputIt.NextLine();
+    progress.CompletedPixel();
   }
 }
 
@@ -0,0 +1,115 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSarCalibrationDeburstMultilookImageFilter.h"
+#include "otbSarRadiometricCalibrationToImageFilter.h"
+#include "otbSarDeburstImageFilter.h"
+#include "otbImageFileReader.h"
+#include "otbImage.h"
+
+int otbSarCalibrationDeburstMultilookImageFilterTest(int argc, char* argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " input azimuthLooks rangeLooks [deburst]" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  typedef float                  RealType;
+  typedef std::complex<RealType> PixelType;
+  typedef otb::Image<PixelType>  InputImageType;
+  typedef otb::Image<RealType>   OutputImageType;
+
+  typedef otb::ImageFileReader<InputImageType>                                            ReaderType;
+  typedef otb::SarCalibrationDeburstMultilookImageFilter<InputImageType, OutputImageType> FilterType;
+  typedef otb::SarRadiometricCalibrationToImageFilter<InputImageType, OutputImageType>    CalibrationFilterType;
+  typedef otb::SarDeburstImageFilter<OutputImageType>                                     DeburstFilterType;
+
+  const unsigned int azimuthLooks = atoi(argv[2]);
+  const unsigned int rangeLooks   = atoi(argv[3]);
+  const bool         deburst      = argc > 4;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(argv[1]);
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(reader->GetOutput());
+  filter->SetAzimuthLooks(azimuthLooks);
+  filter->SetRangeLooks(rangeLooks);
+  filter->SetDeburst(deburst);
+  filter->Update();
+
+  // Reference: calibration and deburst filters, then the average of each look
+  CalibrationFilterType::Pointer calibration = CalibrationFilterType::New();
+  calibration->SetInput(reader->GetOutput());
+
+  DeburstFilterType::Pointer deburstFilter = DeburstFilterType::New();
+  OutputImageType*           reference     = calibration->GetOutput();
+  if (deburst)
+  {
+    deburstFilter->SetInput(calibration->GetOutput());
+    reference = deburstFilter->GetOutput();
+  }
+  reference->UpdateOutputInformation();
+  reference->SetRequestedRegionToLargestPossibleRegion();
+  reference->Update();
+
+  const OutputImageType::RegionType referenceRegion = reference->GetLargestPossibleRegion();
+  const OutputImageType::RegionType outputRegion    = filter->GetOutput()->GetLargestPossibleRegion();
+
+  if (outputRegion.GetSize()[0] != referenceRegion.GetSize()[0] / rangeLooks || outputRegion.GetSize()[1] != referenceRegion.GetSize()[1] / azimuthLooks)
+  {
+    std::cerr << "Unexpected output size " << outputRegion.GetSize() << " for a " << referenceRegion.GetSize() << " image and " << rangeLooks << " x "
+              << azimuthLooks << " looks" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  for (unsigned int y = 0; y < outputRegion.GetSize()[1]; ++y)
+  {
+    for (unsigned int x = 0; x < outputRegion.GetSize()[0]; ++x)
+    {
+      double sum = 0.;
+      for (unsigned int l = 0; l < azimuthLooks; ++l)
+      {
+        for (unsigned int s = 0; s < rangeLooks; ++s)
+        {
+          OutputImageType::IndexType index = referenceRegion.GetIndex();
+          index[0] += x * rangeLooks + s;
+          index[1] += y * azimuthLooks + l;
+          sum += reference->GetPixel(index);
+        }
+      }
+      const double expected = sum / (azimuthLooks * rangeLooks);
+
+      OutputImageType::IndexType index = outputRegion.GetIndex();
+      index[0] += x;
+      index[1] += y;
+      const double value = filter->GetOutput()->GetPixel(index);
+
+      if (std::abs(value - expected) > 1e-6 * std::max(1., std::abs(expected)))
+      {
+        std::cerr << "Multilooked value at " << index << " is " << value << " instead of " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -28,7 +28,10 @@
 #include "otbReduceSpectralResponse.h"
 #include "otbGaussianAdditiveNoiseSampleListFilter.h"
 #include "otbSatelliteRSR.h"
+#include <map>
+#include <mutex>
 #include <string>
+#include <vector>
 
 
 namespace otb
@@ -44,6 +47,10 @@ namespace otb
  * each pixel of the object. However the method used to add this noise (itk::Statistics::MersenneTwisterRandomVariateGenerator)
  * is not thread safe, and then (even if all the remaining is multithread) the number of thread must be set to 1.
  *
+ * The satellite RSR is loaded once per update, and the reduced response of
+ * each distinct spectrum (database path or simulation parameters) is computed
+ * only once and shared by all the objects using it.
+ *
  * \sa LabelMapFilter
  *
  * \ingroup OTBSimulation
@@ -94,6 +101,8 @@ public:
   typedef ReduceSpectralResponse<SpectralResponseType, SatelliteRSRType> ReduceSpectralResponseType;
   typedef typename ReduceSpectralResponseType::Pointer ReduceSpectralResponsePointer;
 
+  typedef std::vector<double> ReducedResponseType;
+
   typedef itk::Statistics::MersenneTwisterRandomVariateGenerator RandomGeneratorType;
   typedef typename RandomGeneratorType::Pointer                  RandomGeneratorPointer;
 
@@ -141,6 +150,17 @@ private:
   double m_Mean;
   /** Variance of gaussien noise for spectra simulation.*/
   double m_Variance;
+
+  /** Compute the reduced response of the spectrum associated to an object */
+  ReducedResponseType ComputeReducedResponse(LabelObjectType* labelObject, const std::string& path);
+
+  /** Satellite RSR, loaded once per update */
+  SatelliteRSRPointer m_SatRSR;
+
+  /** Reduced responses already computed, by database path and by simulation parameters */
+  std::map<std::string, ReducedResponseType>         m_PathReducedResponses;
+  std::map<std::vector<double>, ReducedResponseType> m_SimulatedReducedResponses;
+  std::mutex                                         m_ReducedResponsesMutex;
 };
 
 } // end namespace itk
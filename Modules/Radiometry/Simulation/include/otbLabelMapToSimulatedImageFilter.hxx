@@ -58,26 +58,43 @@ void LabelMapToSimulatedImageFilter<TInputLabelMap, TSimuStep1, TSimuStep2, TOut
 
   output->FillBuffer(pixel);
 
+  // Load the satellite RSR once for all the objects
+  m_SatRSR = SatelliteRSRType::New();
+  m_SatRSR->SetNbBands(m_NumberOfComponentsPerPixel);
+  m_SatRSR->Load(m_SatRSRFilename);
+  // Intervals are computed lazily: do it now, before the RSR is shared between threads
+  for (unsigned int i = 0; i < m_SatRSR->GetRSR().size(); ++i)
+  {
+    m_SatRSR->GetRSR()[i]->GetInterval();
+  }
+
+  m_PathReducedResponses.clear();
+  m_SimulatedReducedResponses.clear();
+
   Superclass::BeforeThreadedGenerateData();
 }
 
 template <class TInputLabelMap, class TSimuStep1, class TSimuStep2, class TOutputImage>
-void LabelMapToSimulatedImageFilter<TInputLabelMap, TSimuStep1, TSimuStep2, TOutputImage>::ThreadedProcessLabelObject(LabelObjectType* labelObject)
+typename LabelMapToSimulatedImageFilter<TInputLabelMap, TSimuStep1, TSimuStep2, TOutputImage>::ReducedResponseType
+LabelMapToSimulatedImageFilter<TInputLabelMap, TSimuStep1, TSimuStep2, TOutputImage>::ComputeReducedResponse(LabelObjectType* labelObject,
+                                                                                                            const std::string& path)
 {
   ReduceSpectralResponsePointer reduceSpectralResponse = ReduceSpectralResponseType::New();
-  SatelliteRSRPointer           satRSR                 = SatelliteRSRType::New();
-  // Compute the spectral response associated to this object.
-  SpectralResponsePointer readSpectrum = SpectralResponseType::New();
-  bool                    hasPath      = false;
+  SpectralResponsePointer       readSpectrum           = SpectralResponseType::New();
+  std::vector<double>           parameters;
+
   // Check if the spectrum associated to this object is given by a database.
-  for (unsigned int i = 0; i < labelObject->GetNumberOfAttributes(); ++i)
-  {
-    if (labelObject->GetAvailableAttributes()[i].compare("path") == 0)
-      hasPath = true;
-  }
-  if (hasPath == true)
+  if (!path.empty())
   {
-    readSpectrum->Load(m_PathRoot + labelObject->GetAttribute("path"), 100);
+    {
+      std::lock_guard<std::mutex> lock(m_ReducedResponsesMutex);
+      auto                        it = m_PathReducedResponses.find(path);
+      if (it != m_PathReducedResponses.end())
+      {
+        return it->second;
+      }
+    }
+    readSpectrum->Load(m_PathRoot + path, 100);
     reduceSpectralResponse->SetInputSpectralResponse(readSpectrum);
   }
   else // compute the spectrum using ProSail
@@ -90,21 +107,64 @@ void LabelMapToSimulatedImageFilter<TInputLabelMap, TSimuStep1, TSimuStep2, TOut
     labelToParams->SetLabel(labelObject->GetAttribute("area"));
     labelToParams->GenerateData();
 
-    simuStep1->SetInput(labelToParams->GetStep1Parameters());
+    // Objects sharing the same parameters share the same simulated spectrum
+    const auto& step1Parameters = labelToParams->GetStep1Parameters();
+    const auto& step2Parameters = labelToParams->GetStep2Parameters();
+    parameters.assign(step1Parameters.begin(), step1Parameters.end());
+    parameters.insert(parameters.end(), step2Parameters.begin(), step2Parameters.end());
+    {
+      std::lock_guard<std::mutex> lock(m_ReducedResponsesMutex);
+      auto                        it = m_SimulatedReducedResponses.find(parameters);
+      if (it != m_SimulatedReducedResponses.end())
+      {
+        return it->second;
+      }
+    }
+
+    simuStep1->SetInput(step1Parameters);
 
-    simuStep2->SetParameters(labelToParams->GetStep2Parameters());
+    simuStep2->SetParameters(step2Parameters);
     simuStep2->SetReflectance(simuStep1->GetReflectance());
     simuStep2->SetTransmittance(simuStep1->GetTransmittance());
     simuStep2->Update();
     reduceSpectralResponse->SetInputSpectralResponse(simuStep2->GetViewingReflectance());
   }
+
   // compute the satellite response of this spectrum
-  satRSR->Clear();
-  satRSR->SetNbBands(m_NumberOfComponentsPerPixel);
-  satRSR->Load(m_SatRSRFilename);
-  reduceSpectralResponse->SetInputSatRSR(satRSR);
+  reduceSpectralResponse->SetInputSatRSR(m_SatRSR);
   reduceSpectralResponse->CalculateResponse();
 
+  ReducedResponseType reducedResponse(m_NumberOfComponentsPerPixel);
+  for (unsigned int j = 0; j < m_NumberOfComponentsPerPixel; ++j)
+  {
+    reducedResponse[j] = reduceSpectralResponse->GetReduceResponse()->GetResponse()[j].second;
+  }
+
+  std::lock_guard<std::mutex> lock(m_ReducedResponsesMutex);
+  if (!path.empty())
+  {
+    m_PathReducedResponses[path] = reducedResponse;
+  }
+  else
+  {
+    m_SimulatedReducedResponses[parameters] = reducedResponse;
+  }
+  return reducedResponse;
+}
+
+template <class TInputLabelMap, class TSimuStep1, class TSimuStep2, class TOutputImage>
+void LabelMapToSimulatedImageFilter<TInputLabelMap, TSimuStep1, TSimuStep2, TOutputImage>::ThreadedProcessLabelObject(LabelObjectType* labelObject)
+{
+  std::string path;
+  for (unsigned int i = 0; i < labelObject->GetNumberOfAttributes(); ++i)
+  {
+    if (labelObject->GetAvailableAttributes()[i].compare("path") == 0)
+      path = labelObject->GetAttribute("path");
+  }
+
+  // Compute the spectral response associated to this object.
+  const ReducedResponseType reducedResponse = this->ComputeReducedResponse(labelObject, path);
+
   typename OutputImageType::PixelType pixel;
   pixel.SetSize(m_NumberOfComponentsPerPixel);
 
@@ -123,7 +183,7 @@ void LabelMapToSimulatedImageFilter<TInputLabelMap, TSimuStep1, TSimuStep2, TOut
       for (unsigned int j = 0; j < m_NumberOfComponentsPerPixel; ++j)
       {
         double ran = randomGen->GetNormalVariate(m_Mean, m_Variance);
-        pixel[j]   = static_cast<InternalPixelType>(reduceSpectralResponse->GetReduceResponse()->GetResponse()[j].second + ran);
+        pixel[j]   = static_cast<InternalPixelType>(reducedResponse[j] + ran);
       }
       this->GetOutput()->SetPixel(idx, pixel);
       idx[0]++;
@@ -87,6 +87,10 @@ public:
   // TODO need a specific class for the integration of stectral responses (now it is in the functor)
   typedef typename InputRSRType::RSRVectorType     RSRVectorType;
   typedef typename std::vector<ValuePrecisionType> ReduceSpectralResponseVectorType;
+
+  /** Sparse band weights: one row per sensor band, made of (sample index, weight) pairs */
+  typedef std::vector<std::pair<unsigned int, ValuePrecisionType>> WeightRowType;
+  typedef std::vector<WeightRowType>                               WeightMatrixType;
   /** Standard macros */
   itkNewMacro(Self);
   ;
@@ -110,6 +114,14 @@ public:
   itkSetMacro(ReflectanceMode, bool);
   itkGetConstMacro(ReflectanceMode, bool);
 
+  /** When enabled, CalculateResponse() reduces the input spectrum with a
+   * sparse weight matrix, which is only rebuilt when the wavelength grid of
+   * the input spectrum, the RSR or the reflectance mode change. This is much
+   * faster when many spectra sampled on the same grid are reduced. */
+  itkSetMacro(UseWeightMatrix, bool);
+  itkGetConstMacro(UseWeightMatrix, bool);
+  itkBooleanMacro(UseWeightMatrix);
+
   /** Clear the vector data  */
   virtual bool Clear();
 
@@ -125,6 +137,16 @@ public:
   /** Calculate the vector response for each band of the sensor*/
   void CalculateResponse();
 
+  /** Build the weight matrix for the current RSR, reflectance mode and
+   * wavelength grid of the input spectral response */
+  void ComputeWeightMatrix();
+
+  /** Get the weight matrix (empty until ComputeWeightMatrix() has been called) */
+  const WeightMatrixType& GetWeightMatrix() const
+  {
+    return m_WeightMatrix;
+  }
+
   /** Create and load Spectral response and satellite RSR from files*/
   void LoadInputsFromFiles(const std::string& spectralResponseFile, const std::string& RSRFile, const unsigned int nbRSRBands,
                            ValuePrecisionType coefNormSpectre = 1.0, ValuePrecisionType coefNormRSR = 1.0);
@@ -153,6 +175,22 @@ private:
 
   /** Choose between reflectance or radiance mode */
   bool m_ReflectanceMode;
+
+  /** Reduce through the precomputed weight matrix */
+  bool m_UseWeightMatrix;
+
+  /** Check that the weight matrix matches the current inputs */
+  bool IsWeightMatrixUpToDate();
+
+  /** Accumulate the interpolation weights of the input spectrum at lambda,
+   * following SpectralResponse::operator() */
+  void AddInterpolationWeights(PrecisionType lambda, unsigned int guess, ValuePrecisionType weight, std::vector<ValuePrecisionType>& row);
+
+  WeightMatrixType                                 m_WeightMatrix;
+  std::vector<PrecisionType>                       m_WeightMatrixLambdas;
+  typename InputSpectralResponseType::IntervalType m_WeightMatrixInterval;
+  const InputRSRType*                              m_WeightMatrixRSR;
+  bool                                             m_WeightMatrixReflectanceMode;
 };
 
 } // end namespace otb
@@ -29,7 +29,8 @@ namespace otb
 {
 
 template <class TSpectralResponse, class TRSR>
-ReduceSpectralResponse<TSpectralResponse, TRSR>::ReduceSpectralResponse() : m_ReflectanceMode(false)
+ReduceSpectralResponse<TSpectralResponse, TRSR>::ReduceSpectralResponse()
+  : m_ReflectanceMode(false), m_UseWeightMatrix(false), m_WeightMatrixRSR(nullptr), m_WeightMatrixReflectanceMode(false)
 {
   m_ReduceResponse = InputSpectralResponseType::New();
 }
@@ -129,6 +130,29 @@ template <class TSpectralResponse, class TRSR>
 void ReduceSpectralResponse<TSpectralResponse, TRSR>::CalculateResponse()
 {
   m_ReduceResponse->Clear();
+
+  if (m_UseWeightMatrix)
+  {
+    if (!this->IsWeightMatrixUpToDate())
+    {
+      this->ComputeWeightMatrix();
+    }
+    const VectorPairType& samples = m_InputSpectralResponse->GetResponse();
+    for (unsigned int i = 0; i < m_WeightMatrix.size(); ++i)
+    {
+      PairType pair;
+      pair.first  = ((this->m_InputSatRSR->GetRSR())[i]->GetInterval().first + (this->m_InputSatRSR->GetRSR())[i]->GetInterval().second);
+      pair.first  = pair.first / 2.0;
+      pair.second = itk::NumericTraits<ValuePrecisionType>::ZeroValue();
+      for (const auto& weight : m_WeightMatrix[i])
+      {
+        pair.second += weight.second * samples[weight.first].second;
+      }
+      m_ReduceResponse->GetResponse().push_back(pair);
+    }
+    return;
+  }
+
   // Compute the reduce response for each band of the sensor
   for (unsigned int i = 0; i < m_InputSatRSR->GetNbBands(); ++i)
   {
@@ -144,6 +168,145 @@ void ReduceSpectralResponse<TSpectralResponse, TRSR>::CalculateResponse()
   }
 }
 
+template <class TSpectralResponse, class TRSR>
+void ReduceSpectralResponse<TSpectralResponse, TRSR>::AddInterpolationWeights(PrecisionType lambda, unsigned int guess, ValuePrecisionType weight,
+                                                                              std::vector<ValuePrecisionType>& row)
+{
+  const VectorPairType& samples  = m_InputSpectralResponse->GetResponse();
+  const auto            interval = m_InputSpectralResponse->GetInterval();
+
+  if (lambda < interval.first || lambda > interval.second)
+  {
+    return;
+  }
+
+  unsigned int pos      = guess;
+  bool         advanced = false;
+  while (samples[pos].first < lambda)
+  {
+    ++pos;
+    advanced = true;
+    if (pos == samples.size())
+    {
+      return;
+    }
+  }
+
+  if (samples[pos].first == lambda)
+  {
+    row[pos] += weight;
+    return;
+  }
+
+  // Same linear combination as SpectralResponse::operator(), where the lower
+  // sample only contributes once the search has moved past the guess
+  const PrecisionType lambda1 = advanced ? samples[pos - 1].first : samples.front().first;
+  const PrecisionType ratio   = (lambda - lambda1) / (samples[pos].first - lambda1);
+  if (advanced)
+  {
+    row[pos - 1] += ratio * weight;
+  }
+  row[pos] += (1 - ratio) * weight;
+}
+
+template <class TSpectralResponse, class TRSR>
+void ReduceSpectralResponse<TSpectralResponse, TRSR>::ComputeWeightMatrix()
+{
+  const VectorPairType& samples = m_InputSpectralResponse->GetResponse();
+  if (samples.size() <= 1)
+  {
+    itkExceptionMacro(<< "ERROR spectral response need at least 2 value to perform interpolation.");
+  }
+
+  typename InputRSRType::SpectralResponseType* solarIrradiance = this->m_InputSatRSR->GetSolarIrradiance();
+  if (m_ReflectanceMode && solarIrradiance == nullptr)
+  {
+    itkExceptionMacro(<< "Error occurs getting solar irradiance. Solar irradiance is mandatory using the reflectance mode.");
+  }
+
+  const unsigned int nbBands = m_InputSatRSR->GetNbBands();
+  m_WeightMatrix.assign(nbBands, WeightRowType());
+
+  std::vector<ValuePrecisionType> row(samples.size());
+  for (unsigned int i = 0; i < nbBands; ++i)
+  {
+    // Same position guess as SpectralResponse::SetPosGuessMin() in the direct computation
+    unsigned int  guess = 0;
+    PrecisionType lower = (this->m_InputSatRSR->GetRSR())[i]->GetInterval().first;
+    if (lower <= m_InputSpectralResponse->GetInterval().second)
+    {
+      while (guess < samples.size() - 1 && samples[guess].first < lower)
+      {
+        ++guess;
+      }
+      if (guess > 0)
+      {
+        --guess;
+      }
+    }
+
+    std::fill(row.begin(), row.end(), itk::NumericTraits<ValuePrecisionType>::ZeroValue());
+    ValuePrecisionType    totalArea(0);
+    const VectorPairType& pairs = (m_InputSatRSR->GetRSR())[i]->GetResponse();
+    for (unsigned int j = 1; j < pairs.size(); ++j)
+    {
+      ValuePrecisionType rsr1 = pairs[j - 1].second;
+      ValuePrecisionType rsr2 = pairs[j].second;
+      if (rsr1 > 0 || rsr2 > 0)
+      {
+        PrecisionType lambda1 = pairs[j - 1].first;
+        PrecisionType lambda2 = pairs[j].first;
+        if (m_ReflectanceMode)
+        {
+          rsr1 *= (*solarIrradiance)(lambda1);
+          rsr2 *= (*solarIrradiance)(lambda2);
+        }
+        // trapezoid_area() is linear in the sampled values
+        const ValuePrecisionType halfWidth = (lambda2 - lambda1) * 0.5;
+        this->AddInterpolationWeights(lambda1, guess, halfWidth * rsr1, row);
+        this->AddInterpolationWeights(lambda2, guess, halfWidth * rsr2, row);
+        totalArea += trapezoid_area(lambda1, lambda2, rsr1, rsr2);
+      }
+    }
+
+    for (unsigned int k = 0; k < row.size(); ++k)
+    {
+      if (row[k] != 0)
+      {
+        m_WeightMatrix[i].push_back(std::make_pair(k, row[k] / totalArea));
+      }
+    }
+  }
+
+  m_WeightMatrixLambdas.resize(samples.size());
+  for (unsigned int k = 0; k < samples.size(); ++k)
+  {
+    m_WeightMatrixLambdas[k] = samples[k].first;
+  }
+  m_WeightMatrixInterval        = m_InputSpectralResponse->GetInterval();
+  m_WeightMatrixRSR             = m_InputSatRSR.GetPointer();
+  m_WeightMatrixReflectanceMode = m_ReflectanceMode;
+}
+
+template <class TSpectralResponse, class TRSR>
+bool ReduceSpectralResponse<TSpectralResponse, TRSR>::IsWeightMatrixUpToDate()
+{
+  const VectorPairType& samples = m_InputSpectralResponse->GetResponse();
+  if (m_WeightMatrixRSR != m_InputSatRSR.GetPointer() || m_WeightMatrixReflectanceMode != m_ReflectanceMode ||
+      m_WeightMatrix.size() != m_InputSatRSR->GetNbBands() || m_WeightMatrixLambdas.size() != samples.size() ||
+      m_WeightMatrixInterval != m_InputSpectralResponse->GetInterval())
+  {
+    return false;
+  }
+  for (unsigned int k = 0; k < samples.size(); ++k)
+  {
+    if (m_WeightMatrixLambdas[k] != samples[k].first)
+    {
+      return false;
+    }
+  }
+  return true;
+}
 
 template <class TSpectralResponse, class TRSR>
 void ReduceSpectralResponse<TSpectralResponse, TRSR>::LoadInputsFromFiles(const std::string& spectralResponseFile, const std::string& RSRFile,
@@ -170,6 +333,7 @@ void ReduceSpectralResponse<TSpectralResponse, TRSR>::PrintSelf(std::ostream& os
   os << std::endl;
   os << "spectre " << m_InputSpectralResponse << std::endl;
   os << "Sat RSR " << m_InputSatRSR << std::endl;
+  os << "Use weight matrix " << m_UseWeightMatrix << std::endl;
   os << std::endl;
 
   if (m_ReflectanceMode)
@@ -25,6 +25,8 @@
 #include "otb_boost_expint_header.h"
 #include "otbMath.h"
 
+#include <vector>
+
 // TODO check EPSILON matlab
 #define EPSILON 0.0000000000000000000000001
 
@@ -134,6 +136,22 @@ void ProspectModel::GenerateData()
   Cm     = leafParameters->GetCm();
 
   int nbdata = sizeof(DataSpecP5B) / sizeof(DataSpec);
+
+  // The interface transmissivities only depend on the refractive index of the
+  // spectral grid, not on the leaf parameters: tabulate them once.
+  static const std::vector<std::pair<double, double>> tavTable = [this, alpha, nbdata]() {
+    std::vector<std::pair<double, double>> table(nbdata);
+    for (int i = 0; i < nbdata; ++i)
+    {
+      table[i].first  = this->Tav(alpha, DataSpecP5B[i].refLeafMatInd);
+      table[i].second = this->Tav(90, DataSpecP5B[i].refLeafMatInd);
+    }
+    return table;
+  }();
+
+  outRefl->GetResponse().reserve(nbdata);
+  outTrans->GetResponse().reserve(nbdata);
+
   for (int i = 0; i < nbdata; ++i)
   {
     lambda = DataSpecP5B[i].lambda;
@@ -147,8 +165,8 @@ void ProspectModel::GenerateData()
 
     trans = (1. - k) * exp(-k) + k * k * boost::math::expint(1, k);
 
-    t12  = this->Tav(alpha, n);
-    temp = this->Tav(90, n);
+    t12  = tavTable[i].first;
+    temp = tavTable[i].second;
 
 
     t21 = temp / (n * n);
@@ -209,3 +209,65 @@ int otbReduceSpectralResponseSimpleValues(int argc, char* argv[])
   }
   return EXIT_SUCCESS;
 }
+
+int otbReduceSpectralResponseWeightMatrix(int argc, char* argv[])
+{
+  if (argc != 5)
+  {
+    std::cout << argv[0] << "\t <Spectral_response_filename>";
+    std::cout << "\t <RSR_filename>";
+    std::cout << "\t <Nb total satellite band>";
+    std::cout << "\t <reflectance mode>";
+    std::cout << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ResponsePointerType spectralResponse = ResponseType::New();
+  spectralResponse->Load(argv[1], 100.0);
+  SatRSRPointerType myRSR = SatRSRType::New();
+  myRSR->SetNbBands(atoi(argv[3]));
+  myRSR->Load(argv[2]);
+
+  ReduceResponseTypePointerType directReduce = ReduceResponseType::New();
+  directReduce->SetInputSatRSR(myRSR);
+  directReduce->SetInputSpectralResponse(spectralResponse);
+  directReduce->SetReflectanceMode(atoi(argv[4]));
+
+  ReduceResponseTypePointerType matrixReduce = ReduceResponseType::New();
+  matrixReduce->SetInputSatRSR(myRSR);
+  matrixReduce->SetInputSpectralResponse(spectralResponse);
+  matrixReduce->SetReflectanceMode(atoi(argv[4]));
+  matrixReduce->UseWeightMatrixOn();
+
+  const ResponseType::ValuePrecisionType tolerance = 10e-9;
+  // Second pass: same wavelength grid with other values, the weight matrix is reused
+  for (unsigned int pass = 0; pass < 2; ++pass)
+  {
+    if (pass == 1)
+    {
+      for (auto& sample : spectralResponse->GetResponse())
+      {
+        sample.second = 0.5 * sample.second + 0.1;
+      }
+    }
+    directReduce->CalculateResponse();
+    matrixReduce->CalculateResponse();
+
+    const SpectrumType& expected = directReduce->GetReduceResponse()->GetResponse();
+    const SpectrumType& actual   = matrixReduce->GetReduceResponse()->GetResponse();
+    if (expected.size() != actual.size() || matrixReduce->GetWeightMatrix().size() != expected.size())
+    {
+      std::cout << "Wrong number of bands: expected " << expected.size() << "; got " << actual.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int i = 0; i < expected.size(); ++i)
+    {
+      if (expected[i].first != actual[i].first || fabs(expected[i].second - actual[i].second) > tolerance)
+      {
+        std::cout << "Wrong value for B" << i << " (pass " << pass << "): expected " << expected[i].second << "; got " << actual[i].second << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  return EXIT_SUCCESS;
+}
@@ -33,6 +33,7 @@ void RegisterTests()
   REGISTER_TEST(otbImageSimulationMethodSVMClassif);
   REGISTER_TEST(otbReduceSpectralResponse);
   REGISTER_TEST(otbReduceSpectralResponseSimpleValues);
+  REGISTER_TEST(otbReduceSpectralResponseWeightMatrix);
   REGISTER_TEST(otbAtmosphericEffects);
   REGISTER_TEST(otbProspectReflTest);
   REGISTER_TEST(otbLabelMapToSimulatedImageFilterTest);
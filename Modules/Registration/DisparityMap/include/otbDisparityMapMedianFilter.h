@@ -44,6 +44,13 @@ namespace otb
  *
  * The median image is then computed again on incoherences using the updated disparity map and mask.
  *
+ * When a histogram bin size is set (SetHistogramBinSize()), the medians are computed on disparities
+ * quantised with this step, using a histogram that slides along each row (Huang's algorithm): moving
+ * to the next pixel only removes the leaving column and adds the entering one, so that the cost per
+ * pixel is linear in the radius instead of quadratic. The rows are processed by several threads.
+ * The median is then known up to the bin size. With a bin size of 0 (the default), the exact median
+ * is computed by sorting each neighborhood.
+ *
  * Inputs (with corresponding method):
  *  - disparity map  (SetInput())
  *  - associated mask (SetMaskInput())
@@ -136,6 +143,10 @@ public:
   itkSetMacro(IncoherenceThreshold, double);
   itkGetMacro(IncoherenceThreshold, double);
 
+  /** Set/Get the quantisation step of the sliding histogram median (0 to sort each neighborhood) */
+  itkSetMacro(HistogramBinSize, double);
+  itkGetMacro(HistogramBinSize, double);
+
 #ifdef ITK_USE_CONCEPT_CHECKING
   /** Begin concept checking */
   itkConceptMacro(SameDimensionCheck, (itk::Concept::SameDimension<InputImageDimension, OutputImageDimension>));
@@ -169,11 +180,81 @@ private:
   DisparityMapMedianFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
+  /** Histogram of quantised disparities that tracks the bin holding a given rank.
+   *  Below is the number of samples in the bins lower than Bin. */
+  struct SlidingHistogram
+  {
+    std::vector<unsigned int> Counts;
+    unsigned int              Total;
+    unsigned int              Bin;
+    unsigned int              Below;
+
+    void Add(unsigned int bin)
+    {
+      ++Counts[bin];
+      ++Total;
+      if (bin < Bin)
+      {
+        ++Below;
+      }
+    }
+
+    void Remove(unsigned int bin)
+    {
+      --Counts[bin];
+      --Total;
+      if (bin < Bin)
+      {
+        --Below;
+      }
+    }
+
+    /** Bin of the sample of the given rank (lower than Total) */
+    unsigned int Rank(unsigned int rank)
+    {
+      while (Below > rank)
+      {
+        --Bin;
+        Below -= Counts[Bin];
+      }
+      while (Below + Counts[Bin] <= rank)
+      {
+        Below += Counts[Bin];
+        ++Bin;
+      }
+      return Bin;
+    }
+  };
+
+  struct HistogramThreadStruct
+  {
+    Self*                      Filter;
+    unsigned int               Pass;
+    double                     MinValue;
+    double                     BinSize;
+    unsigned int               NumberOfBins;
+    std::vector<unsigned int>  Bins;
+    std::vector<unsigned char> Incoherences;
+  };
+
+  /** Sliding histogram version of GenerateData() */
+  void HistogramGenerateData();
+
+  /** Compute the medians of a band of output rows. The first pass detects the incoherences,
+   *  the second one computes the medians again around them. */
+  void HistogramFilterRows(HistogramThreadStruct& str, IndexValueType firstRow, IndexValueType lastRow);
+
+  /** Static function used as a "callback" by the MultiThreader to filter a band of rows */
+  static ITK_THREAD_RETURN_TYPE HistogramThreaderCallback(void* arg);
+
   /** Radius of median filter */
   SizeType m_Radius;
 
   /** Threshold of incoherence between original and filtered disparity */
   double m_IncoherenceThreshold;
+
+  /** Quantisation step of the sliding histogram median */
+  double m_HistogramBinSize;
 };
 
 } // end namespace otb
@@ -31,6 +31,9 @@
 #include "itkNeighborhoodAlgorithm.h"
 #include "itkProgressReporter.h"
 
+#include <algorithm>
+#include <limits>
+
 namespace otb
 {
 
@@ -44,6 +47,7 @@ DisparityMapMedianFilter<TInputImage, TOutputImage, TMask>::DisparityMapMedianFi
   this->SetNthOutput(3, TMask::New());
   m_Radius.Fill(3);
   m_IncoherenceThreshold = 1.0;
+  m_HistogramBinSize     = 0.0;
 }
 
 template <class TInputImage, class TOutputImage, class TMask>
@@ -194,6 +198,12 @@ void DisparityMapMedianFilter<TInputImage, TOutputImage, TMask>::GenerateData()
   // Allocate outputs
   this->AllocateOutputs();
 
+  if (m_HistogramBinSize > 0.0)
+  {
+    this->HistogramGenerateData();
+    return;
+  }
+
   // Get the image pointers
   typename OutputImageType::Pointer     output                 = this->GetOutput();
   typename InputImageType::ConstPointer input                  = this->GetInput();
@@ -410,6 +420,253 @@ void DisparityMapMedianFilter<TInputImage, TOutputImage, TMask>::GenerateData()
 }
 
 
+template <class TInputImage, class TOutputImage, class TMask>
+void DisparityMapMedianFilter<TInputImage, TOutputImage, TMask>::HistogramGenerateData()
+{
+  const InputImageType* input        = this->GetInput();
+  const TMask*          inputmaskPtr = this->GetMaskInput();
+
+  const InputImageRegionType inputRegion = input->GetBufferedRegion();
+  if (inputmaskPtr && inputmaskPtr->GetBufferedRegion() != inputRegion)
+  {
+    itkExceptionMacro(<< "Input image and mask image don't have the same buffered region ! Input image :" << inputRegion
+                      << "; Mask image :" << inputmaskPtr->GetBufferedRegion());
+  }
+
+  const InputPixelType*     inputBuffer = input->GetBufferPointer();
+  const MaskImagePixelType* maskBuffer  = inputmaskPtr ? inputmaskPtr->GetBufferPointer() : nullptr;
+  const std::size_t         nbPixels    = inputRegion.GetNumberOfPixels();
+
+  // Range of the disparities taken into account
+  double minValue = std::numeric_limits<double>::max();
+  double maxValue = std::numeric_limits<double>::lowest();
+  for (std::size_t i = 0; i < nbPixels; ++i)
+  {
+    if (!maskBuffer || maskBuffer[i] != 0)
+    {
+      minValue = std::min(minValue, static_cast<double>(inputBuffer[i]));
+      maxValue = std::max(maxValue, static_cast<double>(inputBuffer[i]));
+    }
+  }
+
+  HistogramThreadStruct str;
+  str.Filter       = this;
+  str.MinValue     = 0.0;
+  str.BinSize      = m_HistogramBinSize;
+  str.NumberOfBins = 1;
+  if (minValue <= maxValue)
+  {
+    // Bound the memory used by the histogram of each thread
+    const double maxNumberOfBins = 65536.0;
+    str.MinValue                 = minValue;
+    if ((maxValue - minValue) / str.BinSize + 1.0 > maxNumberOfBins)
+    {
+      str.BinSize = (maxValue - minValue) / (maxNumberOfBins - 1.0);
+      itkWarningMacro(<< "Disparity range [" << minValue << ", " << maxValue << "] is too large for bin size " << m_HistogramBinSize
+                      << ", bin size is set to " << str.BinSize);
+    }
+    str.NumberOfBins = static_cast<unsigned int>(std::floor((maxValue - minValue) / str.BinSize + 0.5)) + 1;
+  }
+
+  // Quantise the disparities once, masked pixels are flagged by an invalid bin
+  str.Bins.assign(nbPixels, std::numeric_limits<unsigned int>::max());
+  for (std::size_t i = 0; i < nbPixels; ++i)
+  {
+    if (!maskBuffer || maskBuffer[i] != 0)
+    {
+      const unsigned int bin = static_cast<unsigned int>(std::floor((inputBuffer[i] - str.MinValue) / str.BinSize + 0.5));
+      str.Bins[i]            = std::min(bin, str.NumberOfBins - 1);
+    }
+  }
+  str.Incoherences.assign(nbPixels, 0);
+
+  const IndexValueType nbRows = this->GetOutput()->GetRequestedRegion().GetSize(1);
+  if (nbRows == 0)
+  {
+    return;
+  }
+
+  // The second pass reads the incoherences of the neighbor rows, it starts once the first one is over
+  for (str.Pass = 0; str.Pass < 2; ++str.Pass)
+  {
+    this->GetMultiThreader()->SetNumberOfThreads(std::min(static_cast<IndexValueType>(this->GetNumberOfThreads()), nbRows));
+    this->GetMultiThreader()->SetSingleMethod(this->HistogramThreaderCallback, &str);
+    this->GetMultiThreader()->SingleMethodExecute();
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TMask>
+ITK_THREAD_RETURN_TYPE DisparityMapMedianFilter<TInputImage, TOutputImage, TMask>::HistogramThreaderCallback(void* arg)
+{
+  itk::ThreadIdType      threadId    = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  itk::ThreadIdType      threadCount = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->NumberOfThreads;
+  HistogramThreadStruct* str         = (HistogramThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+
+  const OutputImageRegionType region   = str->Filter->GetOutput()->GetRequestedRegion();
+  const IndexValueType        firstRow = region.GetIndex(1);
+  const IndexValueType        nbRows   = region.GetSize(1);
+
+  str->Filter->HistogramFilterRows(*str, firstRow + nbRows * threadId / threadCount, firstRow + nbRows * (threadId + 1) / threadCount);
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage, class TOutputImage, class TMask>
+void DisparityMapMedianFilter<TInputImage, TOutputImage, TMask>::HistogramFilterRows(HistogramThreadStruct& str, IndexValueType firstRow,
+                                                                                      IndexValueType lastRow)
+{
+  const InputImageType* input                  = this->GetInput();
+  OutputImageType*      output                 = this->GetOutput();
+  TMask*                outputmaskPtr          = this->GetOutputMask();
+  TOutputImage*         outputdisparitymapPtr  = this->GetOutputDisparityMap();
+  TMask*                outputdisparitymaskPtr = this->GetOutputDisparityMask();
+
+  const InputImageRegionType  inputRegion  = input->GetBufferedRegion();
+  const OutputImageRegionType outputRegion = output->GetRequestedRegion();
+  const SizeType              imgSize      = output->GetLargestPossibleRegion().GetSize();
+
+  const IndexValueType radiusX     = m_Radius[0];
+  const IndexValueType radiusY     = m_Radius[1];
+  const IndexValueType inputStartX = inputRegion.GetIndex(0);
+  const IndexValueType inputStartY = inputRegion.GetIndex(1);
+  const IndexValueType inputWidth  = inputRegion.GetSize(0);
+  const IndexValueType startX      = outputRegion.GetIndex(0);
+  const IndexValueType startY      = outputRegion.GetIndex(1);
+  const IndexValueType width       = outputRegion.GetSize(0);
+
+  // Columns where the whole neighborhood is inside the image
+  const IndexValueType firstColumn = std::max(startX, radiusX);
+  const IndexValueType lastColumn  = std::min(startX + width, static_cast<IndexValueType>(imgSize[0]) - radiusX);
+
+  const InputPixelType* inputBuffer         = input->GetBufferPointer();
+  OutputPixelType*      medianBuffer        = output->GetBufferPointer();
+  MaskImagePixelType*   medianMaskBuffer    = outputmaskPtr->GetBufferPointer();
+  OutputPixelType*      disparityBuffer     = outputdisparitymapPtr->GetBufferPointer();
+  MaskImagePixelType*   disparityMaskBuffer = outputdisparitymaskPtr->GetBufferPointer();
+  const TMask*          inputmaskPtr        = this->GetMaskInput();
+
+  const unsigned int invalidBin = std::numeric_limits<unsigned int>::max();
+  const bool         firstPass  = (str.Pass == 0);
+
+  SlidingHistogram histogram;
+  histogram.Counts.assign(str.NumberOfBins, 0);
+  histogram.Total = 0;
+  histogram.Bin   = 0;
+  histogram.Below = 0;
+
+  // Number of incoherences in the neighborhood, for the second pass
+  unsigned int nbIncoherences = 0;
+
+  for (IndexValueType y = firstRow; y < lastRow; ++y)
+  {
+    const IndexValueType outputRowOffset = (y - startY) * width - startX;
+
+    if (firstPass)
+    {
+      // Copy the input disparity map and mask, the median is null on the image borders
+      const IndexValueType inputRowOffset = (y - inputStartY) * inputWidth - inputStartX;
+      for (IndexValueType x = startX; x < startX + width; ++x)
+      {
+        disparityBuffer[outputRowOffset + x]     = static_cast<OutputPixelType>(inputBuffer[inputRowOffset + x]);
+        disparityMaskBuffer[outputRowOffset + x] = inputmaskPtr ? inputmaskPtr->GetBufferPointer()[inputRowOffset + x] : 1;
+        medianBuffer[outputRowOffset + x]        = 0.0;
+        medianMaskBuffer[outputRowOffset + x]    = 0;
+      }
+    }
+
+    if (y < radiusY || y >= static_cast<IndexValueType>(imgSize[1]) - radiusY || firstColumn >= lastColumn)
+    {
+      continue;
+    }
+
+    // Add or remove the samples of a column of the neighborhood. The incoherences are only
+    // read in the second pass, as the first one writes them.
+    auto updateColumn = [&](IndexValueType x, bool add) {
+      for (IndexValueType row = y - radiusY; row <= y + radiusY; ++row)
+      {
+        const IndexValueType q   = (row - inputStartY) * inputWidth + x - inputStartX;
+        const bool           inc = !firstPass && str.Incoherences[q] != 0;
+        if (inc)
+        {
+          nbIncoherences = add ? nbIncoherences + 1 : nbIncoherences - 1;
+        }
+        if (str.Bins[q] != invalidBin && !inc)
+        {
+          if (add)
+          {
+            histogram.Add(str.Bins[q]);
+          }
+          else
+          {
+            histogram.Remove(str.Bins[q]);
+          }
+        }
+      }
+    };
+
+    for (IndexValueType x = firstColumn - radiusX; x <= firstColumn + radiusX; ++x)
+    {
+      updateColumn(x, true);
+    }
+
+    for (IndexValueType x = firstColumn; x < lastColumn; ++x)
+    {
+      if (x > firstColumn)
+      {
+        updateColumn(x - radiusX - 1, false);
+        updateColumn(x + radiusX, true);
+      }
+
+      // Only the neighborhoods of the incoherences are computed again
+      if (!firstPass && nbIncoherences == 0)
+      {
+        continue;
+      }
+
+      double median = 0.0;
+      if (histogram.Total > 0)
+      {
+        const unsigned int p = histogram.Total;
+        if ((p & 0x1) == 0)
+        {
+          const double low  = str.MinValue + histogram.Rank(p / 2 - 1) * str.BinSize;
+          const double high = str.MinValue + histogram.Rank(p / 2) * str.BinSize;
+          median            = (low + high) / 2;
+        }
+        else
+        {
+          median = str.MinValue + histogram.Rank(p / 2) * str.BinSize;
+        }
+        medianBuffer[outputRowOffset + x]     = static_cast<OutputPixelType>(median);
+        medianMaskBuffer[outputRowOffset + x] = 1;
+      }
+      else
+      {
+        medianBuffer[outputRowOffset + x]     = 0.0;
+        medianMaskBuffer[outputRowOffset + x] = 0;
+      }
+
+      if (firstPass)
+      {
+        // Remove incoherences between disparity and median
+        const IndexValueType q = (y - inputStartY) * inputWidth + x - inputStartX;
+        if (str.Bins[q] != invalidBin && std::fabs(inputBuffer[q] - median) > m_IncoherenceThreshold)
+        {
+          disparityBuffer[outputRowOffset + x]     = 0.0;
+          disparityMaskBuffer[outputRowOffset + x] = 0;
+          str.Incoherences[q]                      = 1;
+        }
+      }
+    }
+
+    // Empty the histogram, keeping the median bin for the next row
+    for (IndexValueType x = lastColumn - radiusX - 1; x < lastColumn + radiusX; ++x)
+    {
+      updateColumn(x, false);
+    }
+  }
+}
+
 /**
  * Standard "PrintSelf" method
  */
@@ -418,6 +675,7 @@ void DisparityMapMedianFilter<TInputImage, TOutput, TMask>::PrintSelf(std::ostre
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "Histogram bin size: " << m_HistogramBinSize << std::endl;
 }
 
 } // end namespace otb
@@ -692,187 +692,216 @@ void DisparityMapToDEMFilter<TDisparityImage, TInputImage, TOutputDEMImage, TEpi
   TDPointType rightGroundHmin;
   TDPointType rightGroundHmax;
 
+  // The rays of a whole row are projected to ground with batched transforms. For
+  // each valid disparity, the sensor points at ElevationMin and ElevationMax are
+  // stored side by side.
+  const unsigned int       lineLength = disparityRegion.GetSize(0);
+  std::vector<TDPointType> leftSensorPoints;
+  std::vector<TDPointType> rightSensorPoints;
+  std::vector<TDPointType> leftGroundPoints(2 * lineLength);
+  std::vector<TDPointType> rightGroundPoints(2 * lineLength);
+  leftSensorPoints.reserve(2 * lineLength);
+  rightSensorPoints.reserve(2 * lineLength);
+
   while (!horizIt.IsAtEnd() && !vertiIt.IsAtEnd())
   {
-    // check mask value if any
-    if (useMask)
+    leftSensorPoints.clear();
+    rightSensorPoints.clear();
+
+    for (unsigned int i = 0; i < lineLength; ++i)
     {
-      if (!(maskIt.Get() > 0))
+      // check mask value if any
+      if (useMask)
       {
-        ++horizIt;
-        ++vertiIt;
-        ++maskIt;
-        continue;
+        if (!(maskIt.Get() > 0))
+        {
+          ++horizIt;
+          ++vertiIt;
+          ++maskIt;
+          continue;
+        }
       }
-    }
 
-    // compute left ray
-    horizDisp->TransformIndexToPhysicalPoint(horizIt.GetIndex(), epiPoint);
-    leftGrid->TransformPhysicalPointToContinuousIndex(epiPoint, gridIndexConti);
-
-    ulIndex[0] = static_cast<int>(std::floor(gridIndexConti[0]));
-    ulIndex[1] = static_cast<int>(std::floor(gridIndexConti[1]));
-    if (ulIndex[0] < gridRegion.GetIndex(0))
-      ulIndex[0] = gridRegion.GetIndex(0);
-    if (ulIndex[1] < gridRegion.GetIndex(1))
-      ulIndex[1] = gridRegion.GetIndex(1);
-    if (ulIndex[0] > (gridRegion.GetIndex(0) + static_cast<int>(gridRegion.GetSize(0)) - 2))
-    {
-      ulIndex[0] = gridRegion.GetIndex(0) + gridRegion.GetSize(0) - 2;
-    }
-    if (ulIndex[1] > (gridRegion.GetIndex(1) + static_cast<int>(gridRegion.GetSize(1)) - 2))
-    {
-      ulIndex[1] = gridRegion.GetIndex(1) + gridRegion.GetSize(1) - 2;
-    }
-    urIndex[0]     = ulIndex[0] + 1;
-    urIndex[1]     = ulIndex[1];
-    lrIndex[0]     = ulIndex[0] + 1;
-    lrIndex[1]     = ulIndex[1] + 1;
-    llIndex[0]     = ulIndex[0];
-    llIndex[1]     = ulIndex[1] + 1;
-    subPixIndex[0] = gridIndexConti[0] - static_cast<double>(ulIndex[0]);
-    subPixIndex[1] = gridIndexConti[1] - static_cast<double>(ulIndex[1]);
-
-    leftGrid->TransformIndexToPhysicalPoint(ulIndex, ulPoint);
-    leftGrid->TransformIndexToPhysicalPoint(urIndex, urPoint);
-    leftGrid->TransformIndexToPhysicalPoint(lrIndex, lrPoint);
-    leftGrid->TransformIndexToPhysicalPoint(llIndex, llPoint);
-
-    ulPixel[0] = (leftGrid->GetPixel(ulIndex))[0] + ulPoint[0];
-    ulPixel[1] = (leftGrid->GetPixel(ulIndex))[1] + ulPoint[1];
-    urPixel[0] = (leftGrid->GetPixel(urIndex))[0] + urPoint[0];
-    urPixel[1] = (leftGrid->GetPixel(urIndex))[1] + urPoint[1];
-    lrPixel[0] = (leftGrid->GetPixel(lrIndex))[0] + lrPoint[0];
-    lrPixel[1] = (leftGrid->GetPixel(lrIndex))[1] + lrPoint[1];
-    llPixel[0] = (leftGrid->GetPixel(llIndex))[0] + llPoint[0];
-    llPixel[1] = (leftGrid->GetPixel(llIndex))[1] + llPoint[1];
-    cPixel     = (ulPixel * (1.0 - subPixIndex[0]) + urPixel * subPixIndex[0]) * (1.0 - subPixIndex[1]) +
-             (llPixel * (1.0 - subPixIndex[0]) + lrPixel * subPixIndex[0]) * subPixIndex[1];
-
-    sensorPoint[0] = cPixel[0];
-    sensorPoint[1] = cPixel[1];
-    sensorPoint[2] = m_ElevationMin;
-    leftGroundHmin = m_LeftToGroundTransform->TransformPoint(sensorPoint);
-
-    sensorPoint[2] = m_ElevationMax;
-    leftGroundHmax = m_LeftToGroundTransform->TransformPoint(sensorPoint);
-
-    // compute right ray
-    itk::ContinuousIndex<double, 2> rightIndexEstimate;
-    rightIndexEstimate[0] = static_cast<double>((horizIt.GetIndex())[0]) + static_cast<double>(horizIt.Get());
-    rightIndexEstimate[1] = static_cast<double>((horizIt.GetIndex())[1]) + static_cast<double>(vertiIt.Get());
-
-    horizDisp->TransformContinuousIndexToPhysicalPoint(rightIndexEstimate, epiPoint);
-    rightGrid->TransformPhysicalPointToContinuousIndex(epiPoint, gridIndexConti);
-
-    ulIndex[0] = static_cast<int>(std::floor(gridIndexConti[0]));
-    ulIndex[1] = static_cast<int>(std::floor(gridIndexConti[1]));
-    if (ulIndex[0] < gridRegion.GetIndex(0))
-      ulIndex[0] = gridRegion.GetIndex(0);
-    if (ulIndex[1] < gridRegion.GetIndex(1))
-      ulIndex[1] = gridRegion.GetIndex(1);
-    if (ulIndex[0] > (gridRegion.GetIndex(0) + static_cast<int>(gridRegion.GetSize(0)) - 2))
-    {
-      ulIndex[0] = gridRegion.GetIndex(0) + gridRegion.GetSize(0) - 2;
-    }
-    if (ulIndex[1] > (gridRegion.GetIndex(1) + static_cast<int>(gridRegion.GetSize(1)) - 2))
-    {
-      ulIndex[1] = gridRegion.GetIndex(1) + gridRegion.GetSize(1) - 2;
-    }
-    urIndex[0]     = ulIndex[0] + 1;
-    urIndex[1]     = ulIndex[1];
-    lrIndex[0]     = ulIndex[0] + 1;
-    lrIndex[1]     = ulIndex[1] + 1;
-    llIndex[0]     = ulIndex[0];
-    llIndex[1]     = ulIndex[1] + 1;
-    subPixIndex[0] = gridIndexConti[0] - static_cast<double>(ulIndex[0]);
-    subPixIndex[1] = gridIndexConti[1] - static_cast<double>(ulIndex[1]);
-
-    rightGrid->TransformIndexToPhysicalPoint(ulIndex, ulPoint);
-    rightGrid->TransformIndexToPhysicalPoint(urIndex, urPoint);
-    rightGrid->TransformIndexToPhysicalPoint(lrIndex, lrPoint);
-    rightGrid->TransformIndexToPhysicalPoint(llIndex, llPoint);
-
-    ulPixel[0] = (rightGrid->GetPixel(ulIndex))[0] + ulPoint[0];
-    ulPixel[1] = (rightGrid->GetPixel(ulIndex))[1] + ulPoint[1];
-    urPixel[0] = (rightGrid->GetPixel(urIndex))[0] + urPoint[0];
-    urPixel[1] = (rightGrid->GetPixel(urIndex))[1] + urPoint[1];
-    lrPixel[0] = (rightGrid->GetPixel(lrIndex))[0] + lrPoint[0];
-    lrPixel[1] = (rightGrid->GetPixel(lrIndex))[1] + lrPoint[1];
-    llPixel[0] = (rightGrid->GetPixel(llIndex))[0] + llPoint[0];
-    llPixel[1] = (rightGrid->GetPixel(llIndex))[1] + llPoint[1];
-    cPixel     = (ulPixel * (1.0 - subPixIndex[0]) + urPixel * subPixIndex[0]) * (1.0 - subPixIndex[1]) +
-             (llPixel * (1.0 - subPixIndex[0]) + lrPixel * subPixIndex[0]) * subPixIndex[1];
-
-    sensorPoint[0]  = cPixel[0];
-    sensorPoint[1]  = cPixel[1];
-    sensorPoint[2]  = m_ElevationMin;
-    rightGroundHmin = m_RightToGroundTransform->TransformPoint(sensorPoint);
-
-    sensorPoint[2]  = m_ElevationMax;
-    rightGroundHmax = m_RightToGroundTransform->TransformPoint(sensorPoint);
-
-    // Compute ray intersection (mid-point method), TODO : implement non-iterative method from Hartley & Sturm
-    double a = (leftGroundHmax[0] - leftGroundHmin[0]) * (leftGroundHmax[0] - leftGroundHmin[0]) +
-               (leftGroundHmax[1] - leftGroundHmin[1]) * (leftGroundHmax[1] - leftGroundHmin[1]) +
-               (leftGroundHmax[2] - leftGroundHmin[2]) * (leftGroundHmax[2] - leftGroundHmin[2]);
-    double b = (rightGroundHmax[0] - rightGroundHmin[0]) * (rightGroundHmax[0] - rightGroundHmin[0]) +
-               (rightGroundHmax[1] - rightGroundHmin[1]) * (rightGroundHmax[1] - rightGroundHmin[1]) +
-               (rightGroundHmax[2] - rightGroundHmin[2]) * (rightGroundHmax[2] - rightGroundHmin[2]);
-    double c = -(leftGroundHmax[0] - leftGroundHmin[0]) * (rightGroundHmax[0] - rightGroundHmin[0]) -
-               (leftGroundHmax[1] - leftGroundHmin[1]) * (rightGroundHmax[1] - rightGroundHmin[1]) -
-               (leftGroundHmax[2] - leftGroundHmin[2]) * (rightGroundHmax[2] - rightGroundHmin[2]);
-    double g = (leftGroundHmax[0] - leftGroundHmin[0]) * (rightGroundHmin[0] - leftGroundHmin[0]) +
-               (leftGroundHmax[1] - leftGroundHmin[1]) * (rightGroundHmin[1] - leftGroundHmin[1]) +
-               (leftGroundHmax[2] - leftGroundHmin[2]) * (rightGroundHmin[2] - leftGroundHmin[2]);
-    double h = -(rightGroundHmax[0] - rightGroundHmin[0]) * (rightGroundHmin[0] - leftGroundHmin[0]) -
-               (rightGroundHmax[1] - rightGroundHmin[1]) * (rightGroundHmin[1] - leftGroundHmin[1]) -
-               (rightGroundHmax[2] - rightGroundHmin[2]) * (rightGroundHmin[2] - leftGroundHmin[2]);
-
-    double rLeft  = (b * g - c * h) / (a * b - c * c);
-    double rRight = (a * h - c * g) / (a * b - c * c);
-
-    TDPointType leftFoot;
-    leftFoot.SetToBarycentricCombination(leftGroundHmax, leftGroundHmin, rLeft);
-
-    TDPointType rightFoot;
-    rightFoot.SetToBarycentricCombination(rightGroundHmax, rightGroundHmin, rRight);
-
-    TDPointType midPoint3D;
-    midPoint3D.SetToMidPoint(leftFoot, rightFoot);
-
-    // Is point inside DEM area ?
-    typename DEMImageType::PointType midPoint2D;
-    midPoint2D[0] = midPoint3D[0];
-    midPoint2D[1] = midPoint3D[1];
-    itk::ContinuousIndex<double, 2> midIndex;
-    outputDEM->TransformPhysicalPointToContinuousIndex(midPoint2D, midIndex);
-    typename DEMImageType::IndexType cellIndex;
-
-    // TODO JGT check if cellIndex should be calculated from the center of the pixel
-    // TransformContinuousIndexToPhysicalPoint with index [0,0] returns Origin of image
-    // TransformContinuousIndexToPhysicalPoint with index [0.5,0.5] returns a slight difference from Origin of image
-    cellIndex[0] = static_cast<int>(std::floor(midIndex[0] + 0.5));
-    cellIndex[1] = static_cast<int>(std::floor(midIndex[1] + 0.5));
-
-    if (outputRequestedRegion.IsInside(cellIndex))
-    {
-      // Estimate local reference elevation (average, DEM or geoid) => NO NEED, ALREADY HAVE 3D RAYS
-      // double localElevation = demHandler->GetHeightAboveEllipsoid(midPoint2D);
-
-      // Add point to its corresponding cell (keep maximum)
-      DEMPixelType cellHeight = static_cast<DEMPixelType>(midPoint3D[2]);
-      if (cellHeight > tmpDEM->GetPixel(cellIndex) && cellHeight < static_cast<DEMPixelType>(m_ElevationMax))
+      // compute left ray
+      horizDisp->TransformIndexToPhysicalPoint(horizIt.GetIndex(), epiPoint);
+      leftGrid->TransformPhysicalPointToContinuousIndex(epiPoint, gridIndexConti);
+
+      ulIndex[0] = static_cast<int>(std::floor(gridIndexConti[0]));
+      ulIndex[1] = static_cast<int>(std::floor(gridIndexConti[1]));
+      if (ulIndex[0] < gridRegion.GetIndex(0))
+        ulIndex[0] = gridRegion.GetIndex(0);
+      if (ulIndex[1] < gridRegion.GetIndex(1))
+        ulIndex[1] = gridRegion.GetIndex(1);
+      if (ulIndex[0] > (gridRegion.GetIndex(0) + static_cast<int>(gridRegion.GetSize(0)) - 2))
+      {
+        ulIndex[0] = gridRegion.GetIndex(0) + gridRegion.GetSize(0) - 2;
+      }
+      if (ulIndex[1] > (gridRegion.GetIndex(1) + static_cast<int>(gridRegion.GetSize(1)) - 2))
+      {
+        ulIndex[1] = gridRegion.GetIndex(1) + gridRegion.GetSize(1) - 2;
+      }
+      urIndex[0]     = ulIndex[0] + 1;
+      urIndex[1]     = ulIndex[1];
+      lrIndex[0]     = ulIndex[0] + 1;
+      lrIndex[1]     = ulIndex[1] + 1;
+      llIndex[0]     = ulIndex[0];
+      llIndex[1]     = ulIndex[1] + 1;
+      subPixIndex[0] = gridIndexConti[0] - static_cast<double>(ulIndex[0]);
+      subPixIndex[1] = gridIndexConti[1] - static_cast<double>(ulIndex[1]);
+
+      leftGrid->TransformIndexToPhysicalPoint(ulIndex, ulPoint);
+      leftGrid->TransformIndexToPhysicalPoint(urIndex, urPoint);
+      leftGrid->TransformIndexToPhysicalPoint(lrIndex, lrPoint);
+      leftGrid->TransformIndexToPhysicalPoint(llIndex, llPoint);
+
+      ulPixel[0] = (leftGrid->GetPixel(ulIndex))[0] + ulPoint[0];
+      ulPixel[1] = (leftGrid->GetPixel(ulIndex))[1] + ulPoint[1];
+      urPixel[0] = (leftGrid->GetPixel(urIndex))[0] + urPoint[0];
+      urPixel[1] = (leftGrid->GetPixel(urIndex))[1] + urPoint[1];
+      lrPixel[0] = (leftGrid->GetPixel(lrIndex))[0] + lrPoint[0];
+      lrPixel[1] = (leftGrid->GetPixel(lrIndex))[1] + lrPoint[1];
+      llPixel[0] = (leftGrid->GetPixel(llIndex))[0] + llPoint[0];
+      llPixel[1] = (leftGrid->GetPixel(llIndex))[1] + llPoint[1];
+      cPixel     = (ulPixel * (1.0 - subPixIndex[0]) + urPixel * subPixIndex[0]) * (1.0 - subPixIndex[1]) +
+               (llPixel * (1.0 - subPixIndex[0]) + lrPixel * subPixIndex[0]) * subPixIndex[1];
+
+      sensorPoint[0] = cPixel[0];
+      sensorPoint[1] = cPixel[1];
+      sensorPoint[2] = m_ElevationMin;
+      leftSensorPoints.push_back(sensorPoint);
+
+      sensorPoint[2] = m_ElevationMax;
+      leftSensorPoints.push_back(sensorPoint);
+
+      // compute right ray
+      itk::ContinuousIndex<double, 2> rightIndexEstimate;
+      rightIndexEstimate[0] = static_cast<double>((horizIt.GetIndex())[0]) + static_cast<double>(horizIt.Get());
+      rightIndexEstimate[1] = static_cast<double>((horizIt.GetIndex())[1]) + static_cast<double>(vertiIt.Get());
+
+      horizDisp->TransformContinuousIndexToPhysicalPoint(rightIndexEstimate, epiPoint);
+      rightGrid->TransformPhysicalPointToContinuousIndex(epiPoint, gridIndexConti);
+
+      ulIndex[0] = static_cast<int>(std::floor(gridIndexConti[0]));
+      ulIndex[1] = static_cast<int>(std::floor(gridIndexConti[1]));
+      if (ulIndex[0] < gridRegion.GetIndex(0))
+        ulIndex[0] = gridRegion.GetIndex(0);
+      if (ulIndex[1] < gridRegion.GetIndex(1))
+        ulIndex[1] = gridRegion.GetIndex(1);
+      if (ulIndex[0] > (gridRegion.GetIndex(0) + static_cast<int>(gridRegion.GetSize(0)) - 2))
+      {
+        ulIndex[0] = gridRegion.GetIndex(0) + gridRegion.GetSize(0) - 2;
+      }
+      if (ulIndex[1] > (gridRegion.GetIndex(1) + static_cast<int>(gridRegion.GetSize(1)) - 2))
       {
-        tmpDEM->SetPixel(cellIndex, cellHeight);
+        ulIndex[1] = gridRegion.GetIndex(1) + gridRegion.GetSize(1) - 2;
       }
+      urIndex[0]     = ulIndex[0] + 1;
+      urIndex[1]     = ulIndex[1];
+      lrIndex[0]     = ulIndex[0] + 1;
+      lrIndex[1]     = ulIndex[1] + 1;
+      llIndex[0]     = ulIndex[0];
+      llIndex[1]     = ulIndex[1] + 1;
+      subPixIndex[0] = gridIndexConti[0] - static_cast<double>(ulIndex[0]);
+      subPixIndex[1] = gridIndexConti[1] - static_cast<double>(ulIndex[1]);
+
+      rightGrid->TransformIndexToPhysicalPoint(ulIndex, ulPoint);
+      rightGrid->TransformIndexToPhysicalPoint(urIndex, urPoint);
+      rightGrid->TransformIndexToPhysicalPoint(lrIndex, lrPoint);
+      rightGrid->TransformIndexToPhysicalPoint(llIndex, llPoint);
+
+      ulPixel[0] = (rightGrid->GetPixel(ulIndex))[0] + ulPoint[0];
+      ulPixel[1] = (rightGrid->GetPixel(ulIndex))[1] + ulPoint[1];
+      urPixel[0] = (rightGrid->GetPixel(urIndex))[0] + urPoint[0];
+      urPixel[1] = (rightGrid->GetPixel(urIndex))[1] + urPoint[1];
+      lrPixel[0] = (rightGrid->GetPixel(lrIndex))[0] + lrPoint[0];
+      lrPixel[1] = (rightGrid->GetPixel(lrIndex))[1] + lrPoint[1];
+      llPixel[0] = (rightGrid->GetPixel(llIndex))[0] + llPoint[0];
+      llPixel[1] = (rightGrid->GetPixel(llIndex))[1] + llPoint[1];
+      cPixel     = (ulPixel * (1.0 - subPixIndex[0]) + urPixel * subPixIndex[0]) * (1.0 - subPixIndex[1]) +
+               (llPixel * (1.0 - subPixIndex[0]) + lrPixel * subPixIndex[0]) * subPixIndex[1];
+
+      sensorPoint[0] = cPixel[0];
+      sensorPoint[1] = cPixel[1];
+      sensorPoint[2] = m_ElevationMin;
+      rightSensorPoints.push_back(sensorPoint);
+
+      sensorPoint[2] = m_ElevationMax;
+      rightSensorPoints.push_back(sensorPoint);
+
+      ++horizIt;
+      ++vertiIt;
+
+      if (useMask)
+        ++maskIt;
     }
 
-    ++horizIt;
-    ++vertiIt;
+    const unsigned int nbPoints = leftSensorPoints.size();
+    m_LeftToGroundTransform->TransformPoints(leftSensorPoints.data(), leftGroundPoints.data(), nbPoints);
+    m_RightToGroundTransform->TransformPoints(rightSensorPoints.data(), rightGroundPoints.data(), nbPoints);
 
-    if (useMask)
-      ++maskIt;
+    for (unsigned int j = 0; 2 * j < nbPoints; ++j)
+    {
+      leftGroundHmin  = leftGroundPoints[2 * j];
+      leftGroundHmax  = leftGroundPoints[2 * j + 1];
+      rightGroundHmin = rightGroundPoints[2 * j];
+      rightGroundHmax = rightGroundPoints[2 * j + 1];
+
+      // Compute ray intersection (mid-point method), TODO : implement non-iterative method from Hartley & Sturm
+      double a = (leftGroundHmax[0] - leftGroundHmin[0]) * (leftGroundHmax[0] - leftGroundHmin[0]) +
+                 (leftGroundHmax[1] - leftGroundHmin[1]) * (leftGroundHmax[1] - leftGroundHmin[1]) +
+                 (leftGroundHmax[2] - leftGroundHmin[2]) * (leftGroundHmax[2] - leftGroundHmin[2]);
+      double b = (rightGroundHmax[0] - rightGroundHmin[0]) * (rightGroundHmax[0] - rightGroundHmin[0]) +
+                 (rightGroundHmax[1] - rightGroundHmin[1]) * (rightGroundHmax[1] - rightGroundHmin[1]) +
+                 (rightGroundHmax[2] - rightGroundHmin[2]) * (rightGroundHmax[2] - rightGroundHmin[2]);
+      double c = -(leftGroundHmax[0] - leftGroundHmin[0]) * (rightGroundHmax[0] - rightGroundHmin[0]) -
+                 (leftGroundHmax[1] - leftGroundHmin[1]) * (rightGroundHmax[1] - rightGroundHmin[1]) -
+                 (leftGroundHmax[2] - leftGroundHmin[2]) * (rightGroundHmax[2] - rightGroundHmin[2]);
+      double g = (leftGroundHmax[0] - leftGroundHmin[0]) * (rightGroundHmin[0] - leftGroundHmin[0]) +
+                 (leftGroundHmax[1] - leftGroundHmin[1]) * (rightGroundHmin[1] - leftGroundHmin[1]) +
+                 (leftGroundHmax[2] - leftGroundHmin[2]) * (rightGroundHmin[2] - leftGroundHmin[2]);
+      double h = -(rightGroundHmax[0] - rightGroundHmin[0]) * (rightGroundHmin[0] - leftGroundHmin[0]) -
+                 (rightGroundHmax[1] - rightGroundHmin[1]) * (rightGroundHmin[1] - leftGroundHmin[1]) -
+                 (rightGroundHmax[2] - rightGroundHmin[2]) * (rightGroundHmin[2] - leftGroundHmin[2]);
+
+      double rLeft  = (b * g - c * h) / (a * b - c * c);
+      double rRight = (a * h - c * g) / (a * b - c * c);
+
+      TDPointType leftFoot;
+      leftFoot.SetToBarycentricCombination(leftGroundHmax, leftGroundHmin, rLeft);
+
+      TDPointType rightFoot;
+      rightFoot.SetToBarycentricCombination(rightGroundHmax, rightGroundHmin, rRight);
+
+      TDPointType midPoint3D;
+      midPoint3D.SetToMidPoint(leftFoot, rightFoot);
+
+      // Is point inside DEM area ?
+      typename DEMImageType::PointType midPoint2D;
+      midPoint2D[0] = midPoint3D[0];
+      midPoint2D[1] = midPoint3D[1];
+      itk::ContinuousIndex<double, 2> midIndex;
+      outputDEM->TransformPhysicalPointToContinuousIndex(midPoint2D, midIndex);
+      typename DEMImageType::IndexType cellIndex;
+
+      // TODO JGT check if cellIndex should be calculated from the center of the pixel
+      // TransformContinuousIndexToPhysicalPoint with index [0,0] returns Origin of image
+      // TransformContinuousIndexToPhysicalPoint with index [0.5,0.5] returns a slight difference from Origin of image
+      cellIndex[0] = static_cast<int>(std::floor(midIndex[0] + 0.5));
+      cellIndex[1] = static_cast<int>(std::floor(midIndex[1] + 0.5));
+
+      if (outputRequestedRegion.IsInside(cellIndex))
+      {
+        // Estimate local reference elevation (average, DEM or geoid) => NO NEED, ALREADY HAVE 3D RAYS
+        // double localElevation = demHandler->GetHeightAboveEllipsoid(midPoint2D);
+
+        // Add point to its corresponding cell (keep maximum)
+        DEMPixelType cellHeight = static_cast<DEMPixelType>(midPoint3D[2]);
+        if (cellHeight > tmpDEM->GetPixel(cellIndex) && cellHeight < static_cast<DEMPixelType>(m_ElevationMax))
+        {
+          tmpDEM->SetPixel(cellIndex, cellHeight);
+        }
+      }
+    }
   }
 }
 
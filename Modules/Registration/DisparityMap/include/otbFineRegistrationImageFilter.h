@@ -63,6 +63,11 @@ namespace otb
  *
  * The FineRegistrationImageFilter allows using the full range of itk::ImageToImageMetric provided by itk.
  *
+ * With UseFFTOn(), the metric is not used: the zero-mean normalized cross-correlation of each patch is computed
+ * over its whole search window at once with FFTs, and the best (pixel wise) offset is refined by fitting a parabola
+ * through its neighbours in each direction. The output metric is then the same as the one of
+ * itk::NormalizedCorrelationImageToImageMetric with SubtractMeanOn(), and this mode is much faster for large search radii.
+ *
  * \example DisparityMap/FineRegistrationImageFilterExample.cxx
  *
  * \sa      FastCorrelationImageFilter, DisparityMapEstimationMethod
@@ -181,6 +186,11 @@ public:
     m_GridStep.Fill(step);
   }
 
+  /** If true, compute the correlation surface of each patch with FFTs instead of optimizing the metric */
+  itkSetMacro(UseFFT, bool);
+  itkGetMacro(UseFFT, bool);
+  itkBooleanMacro(UseFFT);
+
   /** Set/Get the transform for the initial offset */
   itkSetObjectMacro(Transform, TransformType);
   itkGetConstObjectMacro(Transform, TransformType);
@@ -194,6 +204,9 @@ protected:
   /** Threaded generate data */
   void GenerateData() override;
 
+  /** Generate data with FFT correlation surfaces */
+  void GenerateDataFFT();
+
   /** Generate the input requested regions  */
   void GenerateInputRequestedRegion(void) override;
 
@@ -211,6 +224,9 @@ private:
                            double& out1, double& out2, double& out3, double& out4);                  // outputs
   inline void updateMinimize(double& a, double& b);
 
+  /** Smallest size larger than or equal to size which only has 2, 3 and 5 as prime factors, as required by vnl FFTs */
+  static unsigned int GetFFTSize(unsigned int size);
+
   /** The radius for correlation */
   SizeType m_Radius;
 
@@ -223,6 +239,9 @@ private:
   /** If true, displacement field uses spacing. Otherwise, uses pixel grid */
   bool m_UseSpacing;
 
+  /** If true, correlation surfaces are computed with FFTs */
+  bool m_UseFFT;
+
   /** Search step */
   double m_ConvergenceAccuracy;
   double m_SubPixelAccuracy;
@@ -28,6 +28,12 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkNormalizedCorrelationImageToImageMetric.h"
 #include "itkMacro.h"
+#include "vnl/algo/vnl_fft_2d.h"
+
+#include <algorithm>
+#include <cmath>
+#include <complex>
+#include <vector>
 
 namespace otb
 {
@@ -55,6 +61,7 @@ FineRegistrationImageFilter<TInputImage, T0utputCorrelation, TOutputDisplacement
   // Flags
   m_UseSpacing = true;
   m_Minimize   = true;
+  m_UseFFT     = false;
 
   // Default currentMetric
   m_Metric = itk::NormalizedCorrelationImageToImageMetric<TInputImage, TInputImage>::New();
@@ -337,6 +344,12 @@ void FineRegistrationImageFilter<TInputImage, TOutputCorrelation, TOutputDisplac
   // Allocate outputs
   this->AllocateOutputs();
 
+  if (m_UseFFT)
+  {
+    this->GenerateDataFFT();
+    return;
+  }
+
   // Get the image pointers
   const TInputImage*        fixedPtr    = this->GetFixedInput();
   const TInputImage*        movingPtr   = this->GetMovingInput();
@@ -560,6 +573,245 @@ void FineRegistrationImageFilter<TInputImage, TOutputCorrelation, TOutputDisplac
     progress.CompletedPixel();
   }
 }
+template <class TInputImage, class TOutputCorrelation, class TOutputDisplacementField>
+unsigned int FineRegistrationImageFilter<TInputImage, TOutputCorrelation, TOutputDisplacementField>::GetFFTSize(unsigned int size)
+{
+  for (unsigned int candidate = std::max(size, 1u);; ++candidate)
+  {
+    unsigned int remainder = candidate;
+    for (unsigned int factor : {2u, 3u, 5u})
+    {
+      while (remainder % factor == 0)
+      {
+        remainder /= factor;
+      }
+    }
+    if (remainder == 1)
+    {
+      return candidate;
+    }
+  }
+}
+
+template <class TInputImage, class TOutputCorrelation, class TOutputDisplacementField>
+void FineRegistrationImageFilter<TInputImage, TOutputCorrelation, TOutputDisplacementField>::GenerateDataFFT()
+{
+  typedef std::complex<float> ComplexType;
+
+  // Get the image pointers
+  const TInputImage*        fixedPtr    = this->GetFixedInput();
+  const TInputImage*        movingPtr   = this->GetMovingInput();
+  TOutputCorrelation*       outputPtr   = this->GetOutput();
+  TOutputDisplacementField* outputDfPtr = this->GetOutputDisplacementField();
+
+  m_Interpolator->SetInputImage(movingPtr);
+
+  const int         searchX      = m_SearchRadius[0];
+  const int         searchY      = m_SearchRadius[1];
+  const SpacingType fixedSpacing = fixedPtr->GetSignedSpacing();
+
+  // The largest search window fits in the FFT without wrapping, so that
+  // the same FFT sizes (and factorization) are used for every patch
+  const unsigned int fftX = GetFFTSize(2 * (m_Radius[0] + searchX) + 1);
+  const unsigned int fftY = GetFFTSize(2 * (m_Radius[1] + searchY) + 1);
+
+  vnl_fft_2d<float>         fft(fftY, fftX);
+  vnl_matrix<ComplexType>   patchSpectrum(fftY, fftX), windowSpectrum(fftY, fftX);
+  std::vector<double>       windowSum, windowSquareSum;
+  std::vector<unsigned int> windowInvalid;
+  std::vector<double>       surface((2 * searchX + 1) * (2 * searchY + 1));
+
+  /** Output iterators */
+  itk::ImageRegionIteratorWithIndex<TOutputCorrelation> outputIt(outputPtr, outputPtr->GetRequestedRegion());
+  itk::ImageRegionIterator<TOutputDisplacementField>    outputDfIt(outputDfPtr, outputPtr->GetRequestedRegion());
+
+  // support progress methods/callbacks
+  itk::ProgressReporter progress(this, 0, outputPtr->GetRequestedRegion().GetNumberOfPixels());
+
+  DisplacementValueType displacementValue;
+  SpacingType           localOffset = m_InitialOffset;
+
+  for (outputIt.GoToBegin(), outputDfIt.GoToBegin(); !outputIt.IsAtEnd() && !outputDfIt.IsAtEnd(); ++outputIt, ++outputDfIt)
+  {
+    // Build the patch region, applying grid step
+    IndexType currentIndex = outputIt.GetIndex();
+    for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+    {
+      currentIndex[dim] *= m_GridStep[dim];
+    }
+    InputImageRegionType patchRegion;
+    SizeType             size;
+    size.Fill(1);
+    patchRegion.SetIndex(currentIndex);
+    patchRegion.SetSize(size);
+    patchRegion.PadByRadius(m_Radius);
+    patchRegion.Crop(fixedPtr->GetLargestPossibleRegion());
+
+    // Compute the local offset if required (and the transform was specified)
+    if (m_Transform.IsNotNull())
+    {
+      PointType inputPoint, outputPoint;
+      for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+      {
+        inputPoint[dim] = currentIndex[dim];
+      }
+      outputPoint = m_Transform->TransformPoint(inputPoint);
+      for (unsigned int dim = 0; dim < TInputImage::ImageDimension; ++dim)
+      {
+        localOffset[dim] = outputPoint[dim] - inputPoint[dim];
+      }
+    }
+
+    const unsigned int patchX  = patchRegion.GetSize()[0];
+    const unsigned int patchY  = patchRegion.GetSize()[1];
+    const unsigned int windowX = patchX + 2 * searchX;
+    const unsigned int windowY = patchY + 2 * searchY;
+    const double       n       = patchX * patchY;
+
+    // Zero-mean fixed patch
+    double patchMean = 0;
+    for (unsigned int v = 0; v < patchY; ++v)
+    {
+      for (unsigned int u = 0; u < patchX; ++u)
+      {
+        IndexType index = {{patchRegion.GetIndex()[0] + u, patchRegion.GetIndex()[1] + v}};
+        patchMean += fixedPtr->GetPixel(index);
+      }
+    }
+    patchMean /= n;
+
+    double patchNorm = 0;
+    patchSpectrum.fill(ComplexType(0));
+    for (unsigned int v = 0; v < patchY; ++v)
+    {
+      for (unsigned int u = 0; u < patchX; ++u)
+      {
+        IndexType    index = {{patchRegion.GetIndex()[0] + u, patchRegion.GetIndex()[1] + v}};
+        const double value = fixedPtr->GetPixel(index) - patchMean;
+        patchSpectrum(v, u) = ComplexType(value);
+        patchNorm += value * value;
+      }
+    }
+
+    // Moving image over the search window, with summed area tables of its
+    // values, squared values and out of buffer samples
+    windowSpectrum.fill(ComplexType(0));
+    windowSum.assign((windowX + 1) * (windowY + 1), 0.);
+    windowSquareSum.assign((windowX + 1) * (windowY + 1), 0.);
+    windowInvalid.assign((windowX + 1) * (windowY + 1), 0);
+    for (unsigned int v = 0; v < windowY; ++v)
+    {
+      for (unsigned int u = 0; u < windowX; ++u)
+      {
+        IndexType index = {{patchRegion.GetIndex()[0] - searchX + u, patchRegion.GetIndex()[1] - searchY + v}};
+        PointType point;
+        fixedPtr->TransformIndexToPhysicalPoint(index, point);
+        point += localOffset;
+
+        double       value   = 0;
+        unsigned int invalid = 1;
+        if (m_Interpolator->IsInsideBuffer(point))
+        {
+          value   = m_Interpolator->Evaluate(point);
+          invalid = 0;
+        }
+        windowSpectrum(v, u) = ComplexType(value);
+
+        const unsigned int sat = (v + 1) * (windowX + 1) + u + 1;
+        const unsigned int up  = sat - (windowX + 1);
+        windowSum[sat]         = value + windowSum[sat - 1] + windowSum[up] - windowSum[up - 1];
+        windowSquareSum[sat]   = value * value + windowSquareSum[sat - 1] + windowSquareSum[up] - windowSquareSum[up - 1];
+        windowInvalid[sat]     = invalid + windowInvalid[sat - 1] + windowInvalid[up] - windowInvalid[up - 1];
+      }
+    }
+
+    // Cross-correlation of the patch with every position of the search window
+    fft.fwd_transform(patchSpectrum);
+    fft.fwd_transform(windowSpectrum);
+    for (unsigned int v = 0; v < fftY; ++v)
+    {
+      for (unsigned int u = 0; u < fftX; ++u)
+      {
+        windowSpectrum(v, u) *= std::conj(patchSpectrum(v, u));
+      }
+    }
+    fft.bwd_transform(windowSpectrum);
+
+    // Normalize, and find the correlation peak
+    const double lowest = itk::NumericTraits<double>::NonpositiveMin();
+    double       best   = lowest;
+    int          bestX  = 0;
+    int          bestY  = 0;
+    for (int j = 0; j <= 2 * searchY; ++j)
+    {
+      for (int i = 0; i <= 2 * searchX; ++i)
+      {
+        // Sum of a summed area table over the window of the patch at this position
+        auto windowValue = [&](const auto& table) {
+          const unsigned int first = j * (windowX + 1) + i;
+          const unsigned int last  = (j + patchY) * (windowX + 1) + i + patchX;
+          return table[last] - table[last - patchX] - table[first + patchX] + table[first];
+        };
+
+        double& value = surface[j * (2 * searchX + 1) + i];
+        value         = lowest;
+
+        const double sum      = windowValue(windowSum);
+        const double variance = windowValue(windowSquareSum) - sum * sum / n;
+        if (windowValue(windowInvalid) == 0 && variance > 0 && patchNorm > 0)
+        {
+          value = windowSpectrum(j, i).real() / (fftX * fftY) / std::sqrt(patchNorm * variance);
+          if (value > best)
+          {
+            best  = value;
+            bestX = i;
+            bestY = j;
+          }
+        }
+      }
+    }
+
+    // Parabolic fitting of the peak in each direction
+    const unsigned int peak    = bestY * (2 * searchX + 1) + bestX;
+    auto               fitPeak = [&](int position, int radius, int stride) {
+      if (position == 0 || position == 2 * radius)
+      {
+        return 0.;
+      }
+      const double previous = surface[peak - stride];
+      const double next     = surface[peak + stride];
+      const double curve    = previous - 2 * surface[peak] + next;
+      if (previous == lowest || next == lowest || curve >= 0)
+      {
+        return 0.;
+      }
+      return std::max(-0.5, std::min(0.5, 0.5 * (previous - next) / curve));
+    };
+
+    double shiftX = 0;
+    double shiftY = 0;
+    if (best > lowest)
+    {
+      shiftX = bestX - searchX + fitPeak(bestX, searchX, 1);
+      shiftY = bestY - searchY + fitPeak(bestY, searchY, 2 * searchX + 1);
+    }
+
+    // Store the offset and the correlation value, with the sign of the
+    // normalized correlation metric
+    outputIt.Set(best > lowest ? -best : 0);
+    displacementValue[0] = localOffset[0] + shiftX * fixedSpacing[0];
+    displacementValue[1] = localOffset[1] + shiftY * fixedSpacing[1];
+    if (!m_UseSpacing)
+    {
+      displacementValue[0] /= fixedSpacing[0];
+      displacementValue[1] /= fixedSpacing[1];
+    }
+    outputDfIt.Set(displacementValue);
+
+    progress.CompletedPixel();
+  }
+}
+
 } // end namespace otb
 
 #endif
@@ -25,6 +25,9 @@
 #include "itkImageRegionConstIteratorWithIndex.h"
 #include "itkImageRegionIterator.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace otb
 {
 
@@ -304,8 +307,6 @@ void MultiDisparityMapTo3DFilter<TDisparityImage, TOutputImage, TMaskImage, TRes
   itk::ImageRegionIteratorWithIndex<OutputImageType> outIt(outputPtr, outputRegionForThread);
   itk::ImageRegionIterator<ResidueImageType>         resIt(residuePtr, outputRegionForThread);
 
-  typename OptimizerType::Pointer optimizer = OptimizerType::New();
-
   DispMapIteratorList hDispIts;
   DispMapIteratorList vDispIts;
   MaskIteratorList    maskIts;
@@ -332,106 +333,179 @@ void MultiDisparityMapTo3DFilter<TDisparityImage, TOutputImage, TMaskImage, TRes
   outIt.GoToBegin();
   resIt.GoToBegin();
 
-  PrecisionType altiMin = 0;
-  PrecisionType altiMax = 500;
-
-  typename OutputImageType::PointType pointRef;
-  TDPointType                         currentPoint;
+  const PrecisionType altiMin = 0;
+  const PrecisionType altiMax = 500;
+
+  const unsigned int nbMoving   = this->m_MovingImageMetadatas.size();
+  const unsigned int lineLength = outputRegionForThread.GetSize(0);
+
+  // Lines of sight are computed for a whole row with batched transforms. For each
+  // pixel, the sensor points at altiMax and altiMin are stored side by side.
+  std::vector<TDPointType>               sensorPoints(2 * lineLength);
+  std::vector<TDPointType>               referenceGround(2 * lineLength);
+  std::vector<std::vector<TDPointType>>  movingGround(nbMoving, std::vector<TDPointType>(2 * lineLength));
+  std::vector<std::vector<unsigned int>> movingPixels(nbMoving);
+
+  // Normal equations of each pixel of the row : packed symmetric matrix and second member
+  std::vector<PrecisionType> normalMatrix(6 * lineLength);
+  std::vector<PrecisionType> secondMember(3 * lineLength);
+  std::vector<PrecisionType> intersections(3 * lineLength);
+  std::vector<PrecisionType> residues(lineLength);
+  std::vector<unsigned int>  nbLinesOfSight(lineLength);
+
+  std::vector<typename OutputImageType::PointType> pointsRef(lineLength);
+
+  // Add the line of sight (a, b) to the normal equations of a pixel
+  auto addLineOfSight = [&](unsigned int pixel, const TDPointType& a, const TDPointType& b) {
+    PrecisionType v[3]    = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    PrecisionType normInv = 1. / std::sqrt(v[0] * v[0] + v[1] * v[1] + v[2] * v[2]);
+    v[0] *= normInv;
+    v[1] *= normInv;
+    v[2] *= normInv;
+
+    PrecisionType* m = &normalMatrix[6 * pixel];
+    m[0] += 1. - v[0] * v[0];
+    m[1] -= v[0] * v[1];
+    m[2] -= v[0] * v[2];
+    m[3] += 1. - v[1] * v[1];
+    m[4] -= v[1] * v[2];
+    m[5] += 1. - v[2] * v[2];
+
+    const PrecisionType vDotA = v[0] * a[0] + v[1] * a[1] + v[2] * a[2];
+    PrecisionType*      sec   = &secondMember[3 * pixel];
+    sec[0] += a[0] - v[0] * vDotA;
+    sec[1] += a[1] - v[1] * vDotA;
+    sec[2] += a[2] - v[2] * vDotA;
+    ++nbLinesOfSight[pixel];
+  };
+
+  // Add the squared distance between the intersection of a pixel and the line of sight (a, b)
+  auto addResidue = [&](unsigned int pixel, const TDPointType& a, const TDPointType& b) {
+    const PrecisionType* c     = &intersections[3 * pixel];
+    const PrecisionType  ab[3] = {b[0] - a[0], b[1] - a[1], b[2] - a[2]};
+    const PrecisionType  ac[3] = {c[0] - a[0], c[1] - a[1], c[2] - a[2]};
+    const PrecisionType  abac  = ab[0] * ac[0] + ab[1] * ac[1] + ab[2] * ac[2];
+    const PrecisionType  acac  = ac[0] * ac[0] + ac[1] * ac[1] + ac[2] * ac[2];
+    const PrecisionType  abab  = ab[0] * ab[0] + ab[1] * ab[1] + ab[2] * ab[2];
+    residues[pixel] += std::max(0.0, acac - abac * abac / abab);
+  };
 
   typename OutputImageType::PixelType outPixel(3);
-  PrecisionType                       globalResidue;
-
-  typename PointSetType::Pointer pointSetA = PointSetType::New();
-  typename PointSetType::Pointer pointSetB = PointSetType::New();
+  typename OutputImageType::IndexType index;
 
   while (!outIt.IsAtEnd())
   {
-    pointSetA->Initialize();
-    pointSetB->Initialize();
-
-    // Compute reference line of sight
-    TDPointType pointA, pointB;
-
-    outputPtr->TransformIndexToPhysicalPoint(outIt.GetIndex(), pointRef);
+    std::fill(normalMatrix.begin(), normalMatrix.end(), 0.);
+    std::fill(secondMember.begin(), secondMember.end(), 0.);
+    std::fill(residues.begin(), residues.end(), 0.);
+    std::fill(nbLinesOfSight.begin(), nbLinesOfSight.end(), 0);
+
+    // Compute reference lines of sight
+    index = outIt.GetIndex();
+    for (unsigned int i = 0; i < lineLength; ++i, ++index[0])
+    {
+      outputPtr->TransformIndexToPhysicalPoint(index, pointsRef[i]);
+      sensorPoints[2 * i][0]     = pointsRef[i][0];
+      sensorPoints[2 * i][1]     = pointsRef[i][1];
+      sensorPoints[2 * i][2]     = altiMax;
+      sensorPoints[2 * i + 1][0] = pointsRef[i][0];
+      sensorPoints[2 * i + 1][1] = pointsRef[i][1];
+      sensorPoints[2 * i + 1][2] = altiMin;
+    }
+    referenceToGroundTransform->TransformPoints(sensorPoints.data(), referenceGround.data(), 2 * lineLength);
 
-    currentPoint[0] = pointRef[0];
-    currentPoint[1] = pointRef[1];
-    currentPoint[2] = altiMax;
+    for (unsigned int i = 0; i < lineLength; ++i)
+    {
+      addLineOfSight(i, referenceGround[2 * i], referenceGround[2 * i + 1]);
+    }
 
-    pointA          = referenceToGroundTransform->TransformPoint(currentPoint);
+    // Compute the N moving lines of sight, on the pixels not masked out
+    for (unsigned int k = 0; k < nbMoving; ++k)
+    {
+      itk::ImageRegionConstIterator<DisparityMapType>& hDispIt  = hDispIts[k];
+      const bool                                       useVDisp = vDispIts.count(k) > 0;
+      const bool                                       useMask  = maskIts.count(k) > 0;
 
-    currentPoint[2] = altiMin;
-    pointB          = referenceToGroundTransform->TransformPoint(currentPoint);
+      movingPixels[k].clear();
+      for (unsigned int i = 0; i < lineLength; ++i)
+      {
+        const PrecisionType hDisp = hDispIt.Get();
+        PrecisionType       vDisp = 0;
+        ++hDispIt;
+        if (useVDisp)
+        {
+          vDisp = vDispIts[k].Get();
+          ++vDispIts[k];
+        }
+        if (useMask)
+        {
+          const bool valid = maskIts[k].Get() > 0;
+          ++maskIts[k];
+          if (!valid)
+          {
+            continue;
+          }
+        }
 
-    pointSetA->SetPoint(0, pointA);
-    pointSetB->SetPoint(0, pointB);
-    pointSetA->SetPointData(0, 0);
-    pointSetB->SetPointData(0, 0);
+        const unsigned int pos = movingPixels[k].size();
 
-    unsigned int nbPoints = 1;
+        sensorPoints[2 * pos][0]     = pointsRef[i][0] + hDisp;
+        sensorPoints[2 * pos][1]     = pointsRef[i][1] + vDisp;
+        sensorPoints[2 * pos][2]     = altiMax;
+        sensorPoints[2 * pos + 1][0] = sensorPoints[2 * pos][0];
+        sensorPoints[2 * pos + 1][1] = sensorPoints[2 * pos][1];
+        sensorPoints[2 * pos + 1][2] = altiMin;
+        movingPixels[k].push_back(i);
+      }
 
-    for (unsigned int k = 0; k < this->m_MovingImageMetadatas.size(); ++k)
-    {
-      // Compute the N moving lines of sight
-      TDPointType pointAi, pointBi;
+      const unsigned int nbValid = movingPixels[k].size();
+      movingToGroundTransform[k]->TransformPoints(sensorPoints.data(), movingGround[k].data(), 2 * nbValid);
 
-      if (maskIts.count(k) && !(maskIts[k].Get() > 0))
+      for (unsigned int j = 0; j < nbValid; ++j)
       {
-        continue;
+        addLineOfSight(movingPixels[k][j], movingGround[k][2 * j], movingGround[k][2 * j + 1]);
       }
+    }
 
-      currentPoint[0] = pointRef[0] + hDispIts[k].Get();
-      currentPoint[1] = pointRef[1];
-      if (vDispIts.count(k))
+    // Solve the intersections where there are at least 2 lines of sight
+    for (unsigned int i = 0; i < lineLength; ++i)
+    {
+      if (nbLinesOfSight[i] >= 2)
       {
-        currentPoint[1] += vDispIts[k].Get();
+        OptimizerType::SolveNormalEquations(&normalMatrix[6 * i], &secondMember[3 * i], &intersections[3 * i]);
       }
-
-      currentPoint[2] = altiMax;
-      pointAi         = movingToGroundTransform[k]->TransformPoint(currentPoint);
-      currentPoint[2] = altiMin;
-      pointBi         = movingToGroundTransform[k]->TransformPoint(currentPoint);
-      pointSetA->SetPoint(nbPoints, pointAi);
-      pointSetB->SetPoint(nbPoints, pointBi);
-      pointSetA->SetPointData(nbPoints, k + 1);
-      pointSetB->SetPointData(nbPoints, k + 1);
-      ++nbPoints;
     }
 
-    // Check if there are at least 2 lines of sight, then compute intersection
-    if (nbPoints >= 2)
+    // Compute residues
+    for (unsigned int i = 0; i < lineLength; ++i)
     {
-      TDPointType intersection = optimizer->Compute(pointSetA, pointSetB);
-      outPixel[0]              = intersection[0];
-      outPixel[1]              = intersection[1];
-      outPixel[2]              = intersection[2];
-      globalResidue            = optimizer->GetGlobalResidue();
+      addResidue(i, referenceGround[2 * i], referenceGround[2 * i + 1]);
     }
-    else
+    for (unsigned int k = 0; k < nbMoving; ++k)
     {
-      outPixel.Fill(0);
-      globalResidue = 0;
+      for (unsigned int j = 0; j < movingPixels[k].size(); ++j)
+      {
+        addResidue(movingPixels[k][j], movingGround[k][2 * j], movingGround[k][2 * j + 1]);
+      }
     }
 
-    outIt.Set(outPixel);
-    resIt.Set(globalResidue);
-
-    // Increment all iterators
-    for (typename DispMapIteratorList::iterator hIt = hDispIts.begin(); hIt != hDispIts.end(); ++hIt)
-    {
-      ++hIt->second;
-    }
-    for (typename DispMapIteratorList::iterator vIt = vDispIts.begin(); vIt != vDispIts.end(); ++vIt)
+    for (unsigned int i = 0; i < lineLength; ++i, ++outIt, ++resIt)
     {
-      ++vIt->second;
-    }
-    for (typename MaskIteratorList::iterator mIt = maskIts.begin(); mIt != maskIts.end(); ++mIt)
-    {
-      ++mIt->second;
+      if (nbLinesOfSight[i] >= 2)
+      {
+        outPixel[0] = intersections[3 * i];
+        outPixel[1] = intersections[3 * i + 1];
+        outPixel[2] = intersections[3 * i + 2];
+        outIt.Set(outPixel);
+        resIt.Set(std::sqrt(residues[i]));
+      }
+      else
+      {
+        outPixel.Fill(0);
+        outIt.Set(outPixel);
+        resIt.Set(0);
+      }
     }
-
-    ++outIt;
-    ++resIt;
   }
 }
 }
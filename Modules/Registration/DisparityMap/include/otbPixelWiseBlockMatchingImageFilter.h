@@ -26,12 +26,57 @@
 #include "itkConstNeighborhoodIterator.h"
 #include "itkImageRegionIterator.h"
 #include "otbImage.h"
+#include <type_traits>
+#include <utility>
+#include <algorithm>
+#include <cmath>
+#include <vector>
 
 namespace otb
 {
 
 namespace Functor
 {
+/** \struct BlockMatchingWindowSums
+ *  \brief Sums over a pair of blocks, used by the cost-volume block-matching
+ *
+ *  Functors providing an operator() on this structure can be evaluated by
+ *  PixelWiseBlockMatchingImageFilter from box sums computed once per
+ *  disparity, instead of browsing both neighborhoods for each candidate.
+ *  The moments (SumA to SumAB) are filled if the functor defines
+ *  UseWindowMoments to true, otherwise only SumOfSquaredDifferences is.
+ *
+ * \ingroup OTBDisparityMap
+ */
+struct BlockMatchingWindowSums
+{
+  double Size;
+  double SumA;
+  double SumB;
+  double SumAA;
+  double SumBB;
+  double SumAB;
+  double SumOfSquaredDifferences;
+};
+
+/** \class SupportsWindowSums
+ *  \brief Tell if a block-matching functor can be evaluated from BlockMatchingWindowSums
+ *
+ * \ingroup OTBDisparityMap
+ */
+template <class TFunctor>
+class SupportsWindowSums
+{
+  template <class U>
+  static auto Test(int) -> decltype(std::declval<const U&>()(std::declval<const BlockMatchingWindowSums&>()), std::true_type());
+
+  template <class U>
+  static std::false_type Test(...);
+
+public:
+  static const bool value = decltype(Test<TFunctor>(0))::value;
+};
+
 /** \class SSDBlockMatching
  *  \brief Functor to perform simple SSD block-matching
  *
@@ -63,6 +108,15 @@ public:
 
     return ssd;
   }
+
+  // Only the sum of squared differences is needed
+  static const bool UseWindowMoments = false;
+
+  // Implement the SSD operator from window sums
+  inline MetricValueType operator()(const BlockMatchingWindowSums& sums) const
+  {
+    return static_cast<MetricValueType>(sums.SumOfSquaredDifferences);
+  }
 };
 
 
@@ -107,6 +161,19 @@ public:
 
     return ssd;
   }
+
+  static const bool UseWindowMoments = true;
+
+  // Implement the SSD DivMean operator from window sums
+  inline MetricValueType operator()(const BlockMatchingWindowSums& sums) const
+  {
+    const double meana = sums.SumA / sums.Size;
+    const double meanb = sums.SumB / sums.Size;
+
+    const double ssd = sums.SumAA / (meana * meana) - 2 * sums.SumAB / (meana * meanb) + sums.SumBB / (meanb * meanb);
+
+    return static_cast<MetricValueType>(std::max(ssd, 0.));
+  }
 };
 
 
@@ -178,6 +245,25 @@ public:
 
     return static_cast<MetricValueType>(ncc);
   }
+
+  static const bool UseWindowMoments = true;
+
+  // Implement the NCC operator from window sums
+  inline MetricValueType operator()(const BlockMatchingWindowSums& sums) const
+  {
+    // Covariance and variances, up to a common Size * (Size - 1) factor
+    const double norm   = sums.Size * (sums.Size - 1);
+    const double cov    = sums.Size * sums.SumAB - sums.SumA * sums.SumB;
+    const double sigmaA = sums.Size * sums.SumAA - sums.SumA * sums.SumA;
+    const double sigmaB = sums.Size * sums.SumBB - sums.SumB * sums.SumB;
+
+    // Flat blocks whose variance only comes from rounding errors give a null score
+    if (sigmaA > std::max(1e-40 * norm, 1e-12 * sums.Size * sums.SumAA) && sigmaB > std::max(1e-40 * norm, 1e-12 * sums.Size * sums.SumBB))
+    {
+      return static_cast<MetricValueType>(std::abs(cov) / std::sqrt(sigmaA * sigmaB));
+    }
+    return static_cast<MetricValueType>(0);
+  }
 };
 
 /** \class LPBlockMatching
@@ -255,6 +341,13 @@ private:
  *  flag to off using the MinimizeOff() method will make the filter
  *  try to maximize the metric.
  *
+ *  The SSD, SSDDivMean and NCC functors can also be evaluated from
+ *  sums over the blocks (see BlockMatchingWindowSums). For those, the
+ *  filter computes for each disparity a pixel-wise cost image, which is
+ *  aggregated over the blocks with running box sums: the cost of a
+ *  candidate no longer depends on the radius. This can be disabled with
+ *  UseCostVolumeOff().
+ *
  *  Only a user defined area of disparities between the two images is
  *  explored, which can be set by using the SetMinimumHorizontalDisparity()
  *  , SetMinimumVerticalDisparity(), SetMaximumHorizontalDisparity()
@@ -424,6 +517,14 @@ public:
   const TOutputDisparityImage* GetHorizontalDisparityInput() const;
   const TOutputDisparityImage* GetVerticalDisparityInput() const;
 
+  /** Set/Get the use of the cost-volume implementation (on by default).
+   *  When the functor supports it (see BlockMatchingWindowSums), the
+   *  metric of each disparity is aggregated with running box sums instead
+   *  of browsing both neighborhoods for each pixel. */
+  itkSetMacro(UseCostVolume, bool);
+  itkGetConstReferenceMacro(UseCostVolume, bool);
+  itkBooleanMacro(UseCostVolume);
+
   /** Set/Get macro for the subsampling step */
   itkSetMacro(Step, unsigned int);
   itkGetMacro(Step, unsigned int);
@@ -461,6 +562,30 @@ private:
   PixelWiseBlockMatchingImageFilter(const Self&) = delete;
   void operator                                  =(const Self&); // purposely not implemeFnted
 
+  typedef std::integral_constant<bool, Functor::SupportsWindowSums<TBlockMatchingFunctor>::value> CostVolumeSupportType;
+
+  /** Match by browsing both neighborhoods for each pixel and disparity */
+  void NeighborhoodThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId);
+
+  /** Match from box sums computed once per disparity */
+  void CostVolumeThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId, std::true_type);
+  void CostVolumeThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId, std::false_type);
+
+  /** Tell if a disparity is explored at a location, given its initial disparity */
+  bool IsExploredDisparity(int hdisparity, int vdisparity, DisparityPixelType initHDisparity, DisparityPixelType initVDisparity) const;
+
+  /** Union of the disparities explored by the valid pixels of a full
+   *  resolution region (empty if min > max) */
+  void ComputeExploredDisparityRange(const RegionType& fullRegion, int& minHDisparity, int& maxHDisparity, int& minVDisparity, int& maxVDisparity) const;
+
+  /** Copy a region of an image into a buffer, with zeros outside its buffered region */
+  template <class TImage>
+  static void CopyToBuffer(const TImage* image, const RegionType& region, std::vector<double>& buffer);
+
+  /** Sum a width x height buffer over (2*rx+1) x (2*ry+1) boxes, with running sums */
+  static void BoxSum(const double* in, unsigned int width, unsigned int height, unsigned int rx, unsigned int ry, std::vector<double>& rows,
+                     std::vector<double>& out);
+
   /** The radius of the blocks */
   SizeType m_Radius;
 
@@ -500,6 +625,9 @@ private:
    *  Each coordinate shall lie in [0, m_Step-1]
    */
   IndexType m_GridIndex;
+
+  /** Use the cost-volume implementation when the functor supports it */
+  bool m_UseCostVolume;
 };
 } // end namespace otb
 
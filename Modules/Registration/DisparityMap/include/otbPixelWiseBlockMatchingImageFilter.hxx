@@ -24,6 +24,8 @@
 #include "otbPixelWiseBlockMatchingImageFilter.h"
 #include "itkProgressReporter.h"
 #include "itkConstantBoundaryCondition.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include <limits>
 
 namespace otb
 {
@@ -66,6 +68,9 @@ PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDispar
   // Default grid index
   m_GridIndex[0] = 0;
   m_GridIndex[1] = 0;
+
+  // Use box sums when the functor supports it
+  m_UseCostVolume = true;
 }
 
 
@@ -443,9 +448,12 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
     inRightMaskPtr->SetRequestedRegion(inputRightRegion);
   }
 
-  if (inHDispPtr && inVDispPtr)
+  if (inHDispPtr)
   {
     inHDispPtr->SetRequestedRegion(inputLeftRegion);
+  }
+  if (inVDispPtr)
+  {
     inVDispPtr->SetRequestedRegion(inputLeftRegion);
   }
 }
@@ -471,6 +479,21 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
 template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
 void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::ThreadedGenerateData(
     const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  if (m_UseCostVolume)
+  {
+    this->CostVolumeThreadedGenerateData(outputRegionForThread, threadId, CostVolumeSupportType());
+  }
+  else
+  {
+    this->NeighborhoodThreadedGenerateData(outputRegionForThread, threadId);
+  }
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::NeighborhoodThreadedGenerateData(
+    const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
 {
   // Retrieve pointers
   const TInputImage*           inLeftPtr      = this->GetLeftInput();
@@ -483,13 +506,6 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
   TOutputDisparityImage*       outHDispPtr    = this->GetHorizontalDisparityOutput();
   TOutputDisparityImage*       outVDispPtr    = this->GetVerticalDisparityOutput();
 
-  // Set-up progress reporting (this is not exact, since we do not
-  // account for pixels that are out of range for a given disparity
-  itk::ProgressReporter progress(this, threadId, outputRegionForThread.GetNumberOfPixels() * (m_MaximumHorizontalDisparity - m_MinimumHorizontalDisparity + 1) *
-                                                     (m_MaximumVerticalDisparity - m_MinimumVerticalDisparity + 1),
-                                 100);
-
-
   // Handle initialization properly
   typename InputMaskImageType::Pointer initMaskPtr = InputMaskImageType::New();
   initMaskPtr->SetRegions(outputRegionForThread);
@@ -501,23 +517,35 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
 
   // Check if we use initial disparities and exploration radius
   bool useExplorationRadius = false;
-  bool useInitDispMaps      = false;
+  bool useInitHDispMap      = false;
+  bool useInitVDispMap      = false;
   if (m_ExplorationRadius[0] >= 1 || m_ExplorationRadius[1] >= 1)
   {
     useExplorationRadius = true;
-    if (inHDispPtr && inVDispPtr)
-    {
-      useInitDispMaps = true;
-    }
+    useInitHDispMap      = inHDispPtr != nullptr;
+    useInitVDispMap      = inVDispPtr != nullptr;
   }
 
+  // Only browse the disparities explored by at least one pixel
+  int minHDisparity, maxHDisparity, minVDisparity, maxVDisparity;
+  this->ComputeExploredDisparityRange(fullRegionForThread, minHDisparity, maxHDisparity, minVDisparity, maxVDisparity);
+  if (minHDisparity > maxHDisparity || minVDisparity > maxVDisparity)
+  {
+    return;
+  }
+
+  // Set-up progress reporting (this is not exact, since we do not
+  // account for pixels that are out of range for a given disparity
+  itk::ProgressReporter progress(this, threadId,
+                                 outputRegionForThread.GetNumberOfPixels() * (maxHDisparity - minHDisparity + 1) * (maxVDisparity - minVDisparity + 1), 100);
+
   // step value as disparityType
   DisparityPixelType stepDisparityInv = 1. / static_cast<DisparityPixelType>(this->m_Step);
 
   // We loop on disparities
-  for (int vdisparity = m_MinimumVerticalDisparity; vdisparity <= m_MaximumVerticalDisparity; ++vdisparity)
+  for (int vdisparity = minVDisparity; vdisparity <= maxVDisparity; ++vdisparity)
   {
-    for (int hdisparity = m_MinimumHorizontalDisparity; hdisparity <= m_MaximumHorizontalDisparity; ++hdisparity)
+    for (int hdisparity = minHDisparity; hdisparity <= maxHDisparity; ++hdisparity)
     {
       // First, we cast output region to the right image
       IndexType rightRequestedRegionIndex = fullRegionForThread.GetIndex();
@@ -573,11 +601,14 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
       }
 
       // If we use initial disparity maps, define the iterators
-      if (useInitDispMaps)
+      if (useInitHDispMap)
       {
         inHDispIt = itk::ImageRegionConstIterator<TOutputDisparityImage>(inHDispPtr, inputLeftRegion);
-        inVDispIt = itk::ImageRegionConstIterator<TOutputDisparityImage>(inVDispPtr, inputLeftRegion);
         inHDispIt.GoToBegin();
+      }
+      if (useInitVDispMap)
+      {
+        inVDispIt = itk::ImageRegionConstIterator<TOutputDisparityImage>(inVDispPtr, inputLeftRegion);
         inVDispIt.GoToBegin();
       }
 
@@ -602,39 +633,10 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
           {
             if (!inRightMaskPtr || (inRightMaskIt.Get() > 0))
             {
-              int estimatedMinHDisp = m_MinimumHorizontalDisparity;
-              int estimatedMinVDisp = m_MinimumVerticalDisparity;
-              int estimatedMaxHDisp = m_MaximumHorizontalDisparity;
-              int estimatedMaxVDisp = m_MaximumVerticalDisparity;
-              if (useExplorationRadius)
-              {
-                // compute disparity bounds from initial position and exploration radius
-                if (useInitDispMaps)
-                {
-                  estimatedMinHDisp = inHDispIt.Get() - m_ExplorationRadius[0];
-                  estimatedMinVDisp = inVDispIt.Get() - m_ExplorationRadius[1];
-                  estimatedMaxHDisp = inHDispIt.Get() + m_ExplorationRadius[0];
-                  estimatedMaxVDisp = inVDispIt.Get() + m_ExplorationRadius[1];
-                }
-                else
-                {
-                  estimatedMinHDisp = m_InitHorizontalDisparity - m_ExplorationRadius[0];
-                  estimatedMinVDisp = m_InitVerticalDisparity - m_ExplorationRadius[1];
-                  estimatedMaxHDisp = m_InitHorizontalDisparity + m_ExplorationRadius[0];
-                  estimatedMaxVDisp = m_InitVerticalDisparity + m_ExplorationRadius[1];
-                }
-                // clamp to the minimum disparities
-                if (estimatedMinHDisp < m_MinimumHorizontalDisparity)
-                {
-                  estimatedMinHDisp = m_MinimumHorizontalDisparity;
-                }
-                if (estimatedMinVDisp < m_MinimumVerticalDisparity)
-                {
-                  estimatedMinVDisp = m_MinimumVerticalDisparity;
-                }
-              }
+              DisparityPixelType initHDisparity = useInitHDispMap ? inHDispIt.Get() : m_InitHorizontalDisparity;
+              DisparityPixelType initVDisparity = useInitVDispMap ? inVDispIt.Get() : m_InitVerticalDisparity;
 
-              if (vdisparity >= estimatedMinVDisp && vdisparity <= estimatedMaxVDisp && hdisparity >= estimatedMinHDisp && hdisparity <= estimatedMaxHDisp)
+              if (!useExplorationRadius || this->IsExploredDisparity(hdisparity, vdisparity, initHDisparity, initVDisparity))
               {
                 // Compute the block matching value
                 double metric = m_Functor(leftIt, rightIt);
@@ -682,9 +684,12 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
           ++inRightMaskIt;
         }
 
-        if (useInitDispMaps)
+        if (useInitHDispMap)
         {
           ++inHDispIt;
+        }
+        if (useInitVDispMap)
+        {
           ++inVDispIt;
         }
       }
@@ -692,6 +697,472 @@ void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputD
   }
 }
 
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::CostVolumeThreadedGenerateData(
+    const RegionType& outputRegionForThread, itk::ThreadIdType threadId, std::false_type)
+{
+  // The functor can only be evaluated on neighborhoods
+  this->NeighborhoodThreadedGenerateData(outputRegionForThread, threadId);
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::CostVolumeThreadedGenerateData(
+    const RegionType& outputRegionForThread, itk::ThreadIdType threadId, std::true_type)
+{
+  // Retrieve pointers
+  const TInputImage*           inLeftPtr      = this->GetLeftInput();
+  const TInputImage*           inRightPtr     = this->GetRightInput();
+  const TMaskImage*            inLeftMaskPtr  = this->GetLeftMaskInput();
+  const TMaskImage*            inRightMaskPtr = this->GetRightMaskInput();
+  const TOutputDisparityImage* inHDispPtr     = this->GetHorizontalDisparityInput();
+  const TOutputDisparityImage* inVDispPtr     = this->GetVerticalDisparityInput();
+  TOutputMetricImage*          outMetricPtr   = this->GetMetricOutput();
+  TOutputDisparityImage*       outHDispPtr    = this->GetHorizontalDisparityOutput();
+  TOutputDisparityImage*       outVDispPtr    = this->GetVerticalDisparityOutput();
+
+  typename InputMaskImageType::Pointer initMaskPtr = InputMaskImageType::New();
+  initMaskPtr->SetRegions(outputRegionForThread);
+  initMaskPtr->Allocate();
+  initMaskPtr->FillBuffer(0);
+
+  RegionType fullRegionForThread = this->ConvertSubsampledToFullRegion(outputRegionForThread, this->m_Step, this->m_GridIndex);
+
+  bool useExplorationRadius = false;
+  bool useInitHDispMap      = false;
+  bool useInitVDispMap      = false;
+  if (m_ExplorationRadius[0] >= 1 || m_ExplorationRadius[1] >= 1)
+  {
+    useExplorationRadius = true;
+    useInitHDispMap      = inHDispPtr != nullptr;
+    useInitVDispMap      = inVDispPtr != nullptr;
+  }
+
+  int minHDisparity, maxHDisparity, minVDisparity, maxVDisparity;
+  this->ComputeExploredDisparityRange(fullRegionForThread, minHDisparity, maxHDisparity, minVDisparity, maxVDisparity);
+  if (minHDisparity > maxHDisparity || minVDisparity > maxVDisparity)
+  {
+    return;
+  }
+
+  itk::ProgressReporter progress(this, threadId,
+                                 outputRegionForThread.GetNumberOfPixels() * (maxHDisparity - minHDisparity + 1) * (maxVDisparity - minVDisparity + 1), 100);
+
+  DisparityPixelType stepDisparityInv = 1. / static_cast<DisparityPixelType>(this->m_Step);
+
+  const bool         useMoments = TBlockMatchingFunctor::UseWindowMoments;
+  const unsigned int rx         = m_Radius[0];
+  const unsigned int ry         = m_Radius[1];
+
+  // Block centers in the left image, and in the right image for all disparities
+  RegionType leftCenters = fullRegionForThread;
+
+  IndexType rightCentersIndex = fullRegionForThread.GetIndex();
+  rightCentersIndex[0] += minHDisparity;
+  rightCentersIndex[1] += minVDisparity;
+  SizeType rightCentersSize = fullRegionForThread.GetSize();
+  rightCentersSize[0] += maxHDisparity - minHDisparity;
+  rightCentersSize[1] += maxVDisparity - minVDisparity;
+  RegionType rightCenters(rightCentersIndex, rightCentersSize);
+
+  // Copy the blocks, padded with zeros like the neighborhood boundary condition
+  RegionType leftBlocks = leftCenters;
+  leftBlocks.PadByRadius(m_Radius);
+  RegionType rightBlocks = rightCenters;
+  rightBlocks.PadByRadius(m_Radius);
+
+  std::vector<double> leftValues;
+  std::vector<double> rightValues;
+  CopyToBuffer(inLeftPtr, leftBlocks, leftValues);
+  CopyToBuffer(inRightPtr, rightBlocks, rightValues);
+
+  const unsigned int leftWidth  = leftBlocks.GetSize(0);
+  const unsigned int rightWidth = rightBlocks.GetSize(0);
+
+  // Sums and sums of squares do not depend on the disparity
+  std::vector<double> rows;
+  std::vector<double> leftSum;
+  std::vector<double> leftSquareSum;
+  std::vector<double> rightSum;
+  std::vector<double> rightSquareSum;
+  if (useMoments)
+  {
+    std::vector<double> squares(leftValues.size());
+    std::transform(leftValues.begin(), leftValues.end(), squares.begin(), [](double v) { return v * v; });
+    BoxSum(leftValues.data(), leftWidth, leftBlocks.GetSize(1), rx, ry, rows, leftSum);
+    BoxSum(squares.data(), leftWidth, leftBlocks.GetSize(1), rx, ry, rows, leftSquareSum);
+
+    squares.resize(rightValues.size());
+    std::transform(rightValues.begin(), rightValues.end(), squares.begin(), [](double v) { return v * v; });
+    BoxSum(rightValues.data(), rightWidth, rightBlocks.GetSize(1), rx, ry, rows, rightSum);
+    BoxSum(squares.data(), rightWidth, rightBlocks.GetSize(1), rx, ry, rows, rightSquareSum);
+  }
+
+  Functor::BlockMatchingWindowSums sums;
+  sums.Size                    = (2 * rx + 1) * (2 * ry + 1);
+  sums.SumA                    = 0;
+  sums.SumB                    = 0;
+  sums.SumAA                   = 0;
+  sums.SumBB                   = 0;
+  sums.SumAB                   = 0;
+  sums.SumOfSquaredDifferences = 0;
+
+  std::vector<double> costs;
+  std::vector<double> costSums;
+
+  // We loop on disparities
+  for (int vdisparity = minVDisparity; vdisparity <= maxVDisparity; ++vdisparity)
+  {
+    for (int hdisparity = minHDisparity; hdisparity <= maxHDisparity; ++hdisparity)
+    {
+      // Same regions as the neighborhood implementation
+      IndexType rightRequestedRegionIndex = fullRegionForThread.GetIndex();
+      rightRequestedRegionIndex[0] += hdisparity;
+      rightRequestedRegionIndex[1] += vdisparity;
+
+      RegionType inputRightRegion;
+      inputRightRegion.SetIndex(rightRequestedRegionIndex);
+      inputRightRegion.SetSize(fullRegionForThread.GetSize());
+      inputRightRegion.Crop(inRightPtr->GetLargestPossibleRegion());
+
+      IndexType leftRequestedRegionIndex = inputRightRegion.GetIndex();
+      leftRequestedRegionIndex[0] -= hdisparity;
+      leftRequestedRegionIndex[1] -= vdisparity;
+
+      RegionType inputLeftRegion;
+      inputLeftRegion.SetIndex(leftRequestedRegionIndex);
+      inputLeftRegion.SetSize(inputRightRegion.GetSize());
+
+      RegionType outputRegion = this->ConvertFullToSubsampledRegion(inputLeftRegion, this->m_Step, this->m_GridIndex);
+
+      const unsigned int width  = inputLeftRegion.GetSize(0);
+      const unsigned int height = inputLeftRegion.GetSize(1);
+      if (width == 0 || height == 0)
+      {
+        continue;
+      }
+
+      // Pixel-wise cost of the blocks around inputLeftRegion, aggregated by box sums
+      const unsigned int costWidth   = width + 2 * rx;
+      const unsigned int costHeight  = height + 2 * ry;
+      const std::size_t  leftOffset  = (inputLeftRegion.GetIndex(1) - leftCenters.GetIndex(1)) * leftWidth + inputLeftRegion.GetIndex(0) -
+                                     leftCenters.GetIndex(0);
+      const std::size_t  rightOffset = (inputLeftRegion.GetIndex(1) + vdisparity - rightCenters.GetIndex(1)) * rightWidth + inputLeftRegion.GetIndex(0) +
+                                      hdisparity - rightCenters.GetIndex(0);
+
+      costs.resize(static_cast<std::size_t>(costWidth) * costHeight);
+      for (unsigned int j = 0; j < costHeight; ++j)
+      {
+        const double* a    = leftValues.data() + leftOffset + static_cast<std::size_t>(j) * leftWidth;
+        const double* b    = rightValues.data() + rightOffset + static_cast<std::size_t>(j) * rightWidth;
+        double*       cost = costs.data() + static_cast<std::size_t>(j) * costWidth;
+        if (useMoments)
+        {
+          for (unsigned int i = 0; i < costWidth; ++i)
+          {
+            cost[i] = a[i] * b[i];
+          }
+        }
+        else
+        {
+          for (unsigned int i = 0; i < costWidth; ++i)
+          {
+            cost[i] = (a[i] - b[i]) * (a[i] - b[i]);
+          }
+        }
+      }
+      BoxSum(costs.data(), costWidth, costHeight, rx, ry, rows, costSums);
+
+      itk::ImageRegionIterator<TOutputMetricImage>         outMetricIt(outMetricPtr, outputRegion);
+      itk::ImageRegionIterator<TOutputDisparityImage>      outHDispIt(outHDispPtr, outputRegion);
+      itk::ImageRegionIterator<TOutputDisparityImage>      outVDispIt(outVDispPtr, outputRegion);
+      itk::ImageRegionConstIterator<TMaskImage>            inLeftMaskIt;
+      itk::ImageRegionConstIterator<TMaskImage>            inRightMaskIt;
+      itk::ImageRegionConstIterator<TOutputDisparityImage> inHDispIt;
+      itk::ImageRegionConstIterator<TOutputDisparityImage> inVDispIt;
+      itk::ImageRegionIterator<TMaskImage>                 initIt(initMaskPtr, outputRegion);
+
+      if (inLeftMaskPtr)
+      {
+        inLeftMaskIt = itk::ImageRegionConstIterator<TMaskImage>(inLeftMaskPtr, inputLeftRegion);
+        inLeftMaskIt.GoToBegin();
+      }
+      if (inRightMaskPtr)
+      {
+        inRightMaskIt = itk::ImageRegionConstIterator<TMaskImage>(inRightMaskPtr, inputRightRegion);
+        inRightMaskIt.GoToBegin();
+      }
+      if (useInitHDispMap)
+      {
+        inHDispIt = itk::ImageRegionConstIterator<TOutputDisparityImage>(inHDispPtr, inputLeftRegion);
+        inHDispIt.GoToBegin();
+      }
+      if (useInitVDispMap)
+      {
+        inVDispIt = itk::ImageRegionConstIterator<TOutputDisparityImage>(inVDispPtr, inputLeftRegion);
+        inVDispIt.GoToBegin();
+      }
+
+      outMetricIt.GoToBegin();
+      outHDispIt.GoToBegin();
+      outVDispIt.GoToBegin();
+      initIt.GoToBegin();
+
+      // Loop on pixels
+      for (unsigned int j = 0; j < height; ++j)
+      {
+        const itk::IndexValueType y         = inputLeftRegion.GetIndex(1) + j;
+        const bool                onGridRow = (y - this->m_GridIndex[1] + this->m_Step) % this->m_Step == 0;
+
+        for (unsigned int i = 0; i < width; ++i)
+        {
+          const itk::IndexValueType x = inputLeftRegion.GetIndex(0) + i;
+          if (onGridRow && (x - this->m_GridIndex[0] + this->m_Step) % this->m_Step == 0)
+          {
+            if ((!inLeftMaskPtr || (inLeftMaskIt.Get() > 0)) && (!inRightMaskPtr || (inRightMaskIt.Get() > 0)))
+            {
+              DisparityPixelType initHDisparity = useInitHDispMap ? inHDispIt.Get() : m_InitHorizontalDisparity;
+              DisparityPixelType initVDisparity = useInitVDispMap ? inVDispIt.Get() : m_InitVerticalDisparity;
+
+              if (!useExplorationRadius || this->IsExploredDisparity(hdisparity, vdisparity, initHDisparity, initVDisparity))
+              {
+                const std::size_t costIndex = static_cast<std::size_t>(j) * width + i;
+                if (useMoments)
+                {
+                  const std::size_t leftIndex  = (y - leftCenters.GetIndex(1)) * leftCenters.GetSize(0) + x - leftCenters.GetIndex(0);
+                  const std::size_t rightIndex =
+                      (y + vdisparity - rightCenters.GetIndex(1)) * rightCenters.GetSize(0) + x + hdisparity - rightCenters.GetIndex(0);
+                  sums.SumA                    = leftSum[leftIndex];
+                  sums.SumAA                   = leftSquareSum[leftIndex];
+                  sums.SumB                    = rightSum[rightIndex];
+                  sums.SumBB                   = rightSquareSum[rightIndex];
+                  sums.SumAB                   = costSums[costIndex];
+                }
+                else
+                {
+                  sums.SumOfSquaredDifferences = costSums[costIndex];
+                }
+
+                double metric = m_Functor(sums);
+
+                // Keep the first candidate, then the best one
+                if (initIt.Get() == 0 || (m_Minimize && metric < outMetricIt.Get()) || (!m_Minimize && metric > outMetricIt.Get()))
+                {
+                  outHDispIt.Set(static_cast<DisparityPixelType>(hdisparity) * stepDisparityInv);
+                  outVDispIt.Set(static_cast<DisparityPixelType>(vdisparity) * stepDisparityInv);
+                  outMetricIt.Set(metric);
+                  initIt.Set(1);
+                }
+              }
+            }
+            ++outMetricIt;
+            ++outHDispIt;
+            ++outVDispIt;
+            ++initIt;
+            progress.CompletedPixel();
+          }
+
+          if (inLeftMaskPtr)
+          {
+            ++inLeftMaskIt;
+          }
+          if (inRightMaskPtr)
+          {
+            ++inRightMaskIt;
+          }
+          if (useInitHDispMap)
+          {
+            ++inHDispIt;
+          }
+          if (useInitVDispMap)
+          {
+            ++inVDispIt;
+          }
+        }
+      }
+    }
+  }
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+bool PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::IsExploredDisparity(
+    int hdisparity, int vdisparity, DisparityPixelType initHDisparity, DisparityPixelType initVDisparity) const
+{
+  // compute disparity bounds from initial position and exploration radius
+  int estimatedMinHDisp = initHDisparity - m_ExplorationRadius[0];
+  int estimatedMinVDisp = initVDisparity - m_ExplorationRadius[1];
+  int estimatedMaxHDisp = initHDisparity + m_ExplorationRadius[0];
+  int estimatedMaxVDisp = initVDisparity + m_ExplorationRadius[1];
+
+  // clamp to the minimum disparities
+  estimatedMinHDisp = std::max(estimatedMinHDisp, m_MinimumHorizontalDisparity);
+  estimatedMinVDisp = std::max(estimatedMinVDisp, m_MinimumVerticalDisparity);
+
+  return vdisparity >= estimatedMinVDisp && vdisparity <= estimatedMaxVDisp && hdisparity >= estimatedMinHDisp && hdisparity <= estimatedMaxHDisp;
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void
+PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::ComputeExploredDisparityRange(
+    const RegionType& fullRegion, int& minHDisparity, int& maxHDisparity, int& minVDisparity, int& maxVDisparity) const
+{
+  minHDisparity = m_MinimumHorizontalDisparity;
+  maxHDisparity = m_MaximumHorizontalDisparity;
+  minVDisparity = m_MinimumVerticalDisparity;
+  maxVDisparity = m_MaximumVerticalDisparity;
+
+  if (m_ExplorationRadius[0] < 1 && m_ExplorationRadius[1] < 1)
+  {
+    return;
+  }
+
+  const TMaskImage*            inLeftMaskPtr = this->GetLeftMaskInput();
+  const TOutputDisparityImage* inHDispPtr    = this->GetHorizontalDisparityInput();
+  const TOutputDisparityImage* inVDispPtr    = this->GetVerticalDisparityInput();
+
+  RegionType region = fullRegion;
+  if (!region.Crop(this->GetLeftInput()->GetLargestPossibleRegion()))
+  {
+    return;
+  }
+
+  // Same bounds as IsExploredDisparity(), gathered over the valid pixels
+  int exploredMinHDisp = std::numeric_limits<int>::max();
+  int exploredMaxHDisp = std::numeric_limits<int>::min();
+  int exploredMinVDisp = std::numeric_limits<int>::max();
+  int exploredMaxVDisp = std::numeric_limits<int>::min();
+
+  itk::ImageRegionConstIteratorWithIndex<TInputImage>  leftIt(this->GetLeftInput(), region);
+  itk::ImageRegionConstIterator<TMaskImage>            inLeftMaskIt;
+  itk::ImageRegionConstIterator<TOutputDisparityImage> inHDispIt;
+  itk::ImageRegionConstIterator<TOutputDisparityImage> inVDispIt;
+  if (inLeftMaskPtr)
+  {
+    inLeftMaskIt = itk::ImageRegionConstIterator<TMaskImage>(inLeftMaskPtr, region);
+    inLeftMaskIt.GoToBegin();
+  }
+  if (inHDispPtr)
+  {
+    inHDispIt = itk::ImageRegionConstIterator<TOutputDisparityImage>(inHDispPtr, region);
+    inHDispIt.GoToBegin();
+  }
+  if (inVDispPtr)
+  {
+    inVDispIt = itk::ImageRegionConstIterator<TOutputDisparityImage>(inVDispPtr, region);
+    inVDispIt.GoToBegin();
+  }
+
+  for (leftIt.GoToBegin(); !leftIt.IsAtEnd(); ++leftIt)
+  {
+    const IndexType& index = leftIt.GetIndex();
+    if ((index[0] - this->m_GridIndex[0] + this->m_Step) % this->m_Step == 0 && (index[1] - this->m_GridIndex[1] + this->m_Step) % this->m_Step == 0 &&
+        (!inLeftMaskPtr || inLeftMaskIt.Get() > 0))
+    {
+      DisparityPixelType initHDisparity = inHDispPtr ? inHDispIt.Get() : m_InitHorizontalDisparity;
+      DisparityPixelType initVDisparity = inVDispPtr ? inVDispIt.Get() : m_InitVerticalDisparity;
+
+      exploredMinHDisp = std::min(exploredMinHDisp, static_cast<int>(initHDisparity - m_ExplorationRadius[0]));
+      exploredMaxHDisp = std::max(exploredMaxHDisp, static_cast<int>(initHDisparity + m_ExplorationRadius[0]));
+      exploredMinVDisp = std::min(exploredMinVDisp, static_cast<int>(initVDisparity - m_ExplorationRadius[1]));
+      exploredMaxVDisp = std::max(exploredMaxVDisp, static_cast<int>(initVDisparity + m_ExplorationRadius[1]));
+    }
+
+    if (inLeftMaskPtr)
+    {
+      ++inLeftMaskIt;
+    }
+    if (inHDispPtr)
+    {
+      ++inHDispIt;
+    }
+    if (inVDispPtr)
+    {
+      ++inVDispIt;
+    }
+  }
+
+  minHDisparity = std::max(minHDisparity, exploredMinHDisp);
+  maxHDisparity = std::min(maxHDisparity, exploredMaxHDisp);
+  minVDisparity = std::max(minVDisparity, exploredMinVDisp);
+  maxVDisparity = std::min(maxVDisparity, exploredMaxVDisp);
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+template <class TImage>
+void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::CopyToBuffer(
+    const TImage* image, const RegionType& region, std::vector<double>& buffer)
+{
+  buffer.assign(region.GetNumberOfPixels(), 0.);
+
+  RegionType bufferedRegion = region;
+  if (!bufferedRegion.Crop(image->GetBufferedRegion()))
+  {
+    return;
+  }
+
+  itk::ImageRegionConstIterator<TImage> it(image, bufferedRegion);
+  it.GoToBegin();
+  for (unsigned int j = 0; j < bufferedRegion.GetSize(1); ++j)
+  {
+    double* row = buffer.data() + (bufferedRegion.GetIndex(1) - region.GetIndex(1) + j) * region.GetSize(0) + bufferedRegion.GetIndex(0) - region.GetIndex(0);
+    for (unsigned int i = 0; i < bufferedRegion.GetSize(0); ++i, ++it)
+    {
+      row[i] = static_cast<double>(it.Get());
+    }
+  }
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::BoxSum(
+    const double* in, unsigned int width, unsigned int height, unsigned int rx, unsigned int ry, std::vector<double>& rows, std::vector<double>& out)
+{
+  const unsigned int outWidth  = width - 2 * rx;
+  const unsigned int outHeight = height - 2 * ry;
+
+  // Horizontal running sums
+  rows.resize(static_cast<std::size_t>(outWidth) * height);
+  for (unsigned int j = 0; j < height; ++j)
+  {
+    const double* src = in + static_cast<std::size_t>(j) * width;
+    double*       dst = rows.data() + static_cast<std::size_t>(j) * outWidth;
+
+    double sum = 0;
+    for (unsigned int i = 0; i <= 2 * rx; ++i)
+    {
+      sum += src[i];
+    }
+    dst[0] = sum;
+    for (unsigned int i = 1; i < outWidth; ++i)
+    {
+      sum += src[i + 2 * rx] - src[i - 1];
+      dst[i] = sum;
+    }
+  }
+
+  // Vertical running sums, a whole row at a time so that the loops vectorize
+  out.assign(static_cast<std::size_t>(outWidth) * outHeight, 0.);
+  for (unsigned int j = 0; j <= 2 * ry; ++j)
+  {
+    const double* src = rows.data() + static_cast<std::size_t>(j) * outWidth;
+    for (unsigned int i = 0; i < outWidth; ++i)
+    {
+      out[i] += src[i];
+    }
+  }
+  for (unsigned int j = 1; j < outHeight; ++j)
+  {
+    const double* previous = out.data() + static_cast<std::size_t>(j - 1) * outWidth;
+    const double* entering = rows.data() + static_cast<std::size_t>(j + 2 * ry) * outWidth;
+    const double* leaving  = rows.data() + static_cast<std::size_t>(j - 1) * outWidth;
+    double*       dst      = out.data() + static_cast<std::size_t>(j) * outWidth;
+    for (unsigned int i = 0; i < outWidth; ++i)
+    {
+      dst[i] = previous[i] + entering[i] - leaving[i];
+    }
+  }
+}
+
 template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
 typename PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::RegionType
 PixelWiseBlockMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage, TBlockMatchingFunctor>::ConvertFullToSubsampledRegion(
@@ -0,0 +1,240 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSemiGlobalMatchingImageFilter_h
+#define otbSemiGlobalMatchingImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbImage.h"
+#include <cstdint>
+#include <vector>
+
+namespace otb
+{
+
+/** \class SemiGlobalMatchingImageFilter
+ *  \brief Estimate horizontal disparities between two epipolar images with Semi-Global Matching
+ *
+ *  This filter is an alternative to PixelWiseBlockMatchingImageFilter for
+ *  stereo pairs in epipolar geometry. The matching cost of each pixel and
+ *  each disparity is the Hamming distance between the census transforms of
+ *  the left and right images, over a window whose radius can be set with
+ *  SetRadius(). The costs are then aggregated along 4, 8 or 16 paths
+ *  crossing the image (see SetNumberOfPaths()), with a small penalty P1
+ *  for disparity changes of one pixel and a larger penalty P2 for bigger
+ *  changes, as described in: H. Hirschmuller, "Stereo Processing by
+ *  Semiglobal Matching and Mutual Information", IEEE TPAMI, 2008.
+ *
+ *  The requested region is processed by tiles (see SetTileSize()), in
+ *  parallel. Each tile is extended by an overlap (see SetTileOverlap())
+ *  so that the paths have some support before reaching the tile, which
+ *  also makes the output independent of the streaming as long as the
+ *  overlap is large enough.
+ *
+ *  Only the horizontal disparities between SetMinimumHorizontalDisparity()
+ *  and SetMaximumHorizontalDisparity() are explored. The outputs are the
+ *  same as PixelWiseBlockMatchingImageFilter: the metric image (aggregated
+ *  cost of the selected disparity divided by the number of paths, to be
+ *  minimized), the horizontal disparity map, refined with a parabola fit
+ *  unless SubPixelInterpolationOff() is called, and the vertical disparity
+ *  map, which is always null. A fourth output, GetOutputMask(), is 1 for
+ *  valid disparities and 0 where the left or right masks are null, and
+ *  where the left-right consistency check fails (disabled with
+ *  LeftRightCheckOff()). Invalid pixels have a null metric and the minimum
+ *  horizontal disparity.
+ *
+ *  \sa PixelWiseBlockMatchingImageFilter
+ *
+ *  \ingroup Streamed
+ *  \ingroup Threaded
+ *
+ * \ingroup OTBDisparityMap
+ */
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage = TOutputMetricImage, class TMaskImage = otb::Image<unsigned char>>
+class ITK_EXPORT SemiGlobalMatchingImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputDisparityImage>
+{
+public:
+  /** Standard class typedef */
+  typedef SemiGlobalMatchingImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputDisparityImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Run-time type information (and related methods). */
+  itkTypeMacro(SemiGlobalMatchingImageFilter, ImageToImageFilter);
+
+  /** Useful typedefs */
+  typedef TInputImage           InputImageType;
+  typedef TOutputMetricImage    OutputMetricImageType;
+  typedef TOutputDisparityImage OutputDisparityImageType;
+  typedef TMaskImage            MaskImageType;
+
+  typedef typename InputImageType::SizeType   SizeType;
+  typedef typename InputImageType::IndexType  IndexType;
+  typedef typename InputImageType::RegionType RegionType;
+
+  typedef typename TOutputMetricImage::ValueType       MetricValueType;
+  typedef typename OutputDisparityImageType::PixelType DisparityPixelType;
+
+  /** Type of the aggregated costs */
+  typedef uint16_t CostType;
+
+  /** Set left input */
+  void SetLeftInput(const TInputImage* image);
+
+  /** Set right input */
+  void SetRightInput(const TInputImage* image);
+
+  /** Set mask input (optional) */
+  void SetLeftMaskInput(const TMaskImage* image);
+
+  /** Set right mask input (optional) */
+  void SetRightMaskInput(const TMaskImage* image);
+
+  /** Get the inputs */
+  const TInputImage* GetLeftInput() const;
+  const TInputImage* GetRightInput() const;
+  const TMaskImage*  GetLeftMaskInput() const;
+  const TMaskImage*  GetRightMaskInput() const;
+
+  /** Get the metric output */
+  TOutputMetricImage* GetMetricOutput();
+
+  /** Get the disparity outputs */
+  TOutputDisparityImage* GetHorizontalDisparityOutput();
+  TOutputDisparityImage* GetVerticalDisparityOutput();
+
+  /** Get the mask of valid disparities */
+  TMaskImage* GetOutputMask();
+
+  /** Set unsigned int radius */
+  void SetRadius(unsigned int radius)
+  {
+    m_Radius.Fill(radius);
+    this->Modified();
+  }
+
+  /** Set/Get the radius of the census transform window (at most 64 neighbors) */
+  itkSetMacro(Radius, SizeType);
+  itkGetConstReferenceMacro(Radius, SizeType);
+
+  /*** Set/Get the minimum disparity to explore */
+  itkSetMacro(MinimumHorizontalDisparity, int);
+  itkGetConstReferenceMacro(MinimumHorizontalDisparity, int);
+
+  /*** Set/Get the maximum disparity to explore */
+  itkSetMacro(MaximumHorizontalDisparity, int);
+  itkGetConstReferenceMacro(MaximumHorizontalDisparity, int);
+
+  /** Set/Get the penalty for disparity changes of one pixel along a path */
+  itkSetMacro(P1, unsigned int);
+  itkGetConstReferenceMacro(P1, unsigned int);
+
+  /** Set/Get the penalty for larger disparity changes along a path */
+  itkSetMacro(P2, unsigned int);
+  itkGetConstReferenceMacro(P2, unsigned int);
+
+  /** Set/Get the number of aggregation paths (4, 8 or 16) */
+  itkSetMacro(NumberOfPaths, unsigned int);
+  itkGetConstReferenceMacro(NumberOfPaths, unsigned int);
+
+  /** Set/Get the size of the tiles processed in parallel */
+  itkSetMacro(TileSize, unsigned int);
+  itkGetConstReferenceMacro(TileSize, unsigned int);
+
+  /** Set/Get the margin added around each tile for the aggregation */
+  itkSetMacro(TileOverlap, unsigned int);
+  itkGetConstReferenceMacro(TileOverlap, unsigned int);
+
+  /** Reject disparities whose right to left match differs by more than one pixel */
+  itkSetMacro(LeftRightCheck, bool);
+  itkGetConstReferenceMacro(LeftRightCheck, bool);
+  itkBooleanMacro(LeftRightCheck);
+
+  /** Refine the disparities with a parabola fit on the aggregated costs */
+  itkSetMacro(SubPixelInterpolation, bool);
+  itkGetConstReferenceMacro(SubPixelInterpolation, bool);
+  itkBooleanMacro(SubPixelInterpolation);
+
+protected:
+  /** Constructor */
+  SemiGlobalMatchingImageFilter();
+
+  /** Destructor */
+  ~SemiGlobalMatchingImageFilter() override
+  {
+  }
+
+  /** Generate input requested region */
+  void GenerateInputRequestedRegion() override;
+
+  /** Generate data */
+  void GenerateData() override;
+
+  /** PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  SemiGlobalMatchingImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Compute the disparities of a tile of the output requested region */
+  void MatchTile(const RegionType& outputTile);
+
+  /** Census transform of an image region, with validity from the buffered region and the mask */
+  void CensusTransform(const TInputImage* image, const TMaskImage* mask, const RegionType& region, std::vector<uint64_t>& census,
+                       std::vector<unsigned char>& valid) const;
+
+  /** Add the costs aggregated along the direction (dx, dy) to the sums */
+  void AggregatePath(const std::vector<CostType>& costs, unsigned int width, unsigned int height, unsigned int nbDisparities, int dx, int dy,
+                     std::vector<CostType>& sums) const;
+
+  /** The radius of the census transform */
+  SizeType m_Radius;
+
+  /** The disparity range */
+  int m_MinimumHorizontalDisparity;
+  int m_MaximumHorizontalDisparity;
+
+  /** The aggregation penalties */
+  unsigned int m_P1;
+  unsigned int m_P2;
+
+  /** The number of aggregation paths */
+  unsigned int m_NumberOfPaths;
+
+  /** Tiling of the requested region */
+  unsigned int m_TileSize;
+  unsigned int m_TileOverlap;
+
+  /** Post-processing */
+  bool m_LeftRightCheck;
+  bool m_SubPixelInterpolation;
+};
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbSemiGlobalMatchingImageFilter.hxx"
+#endif
+
+#endif
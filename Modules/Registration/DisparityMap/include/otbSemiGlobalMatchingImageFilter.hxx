@@ -0,0 +1,602 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbSemiGlobalMatchingImageFilter_hxx
+#define otbSemiGlobalMatchingImageFilter_hxx
+
+#include "otbSemiGlobalMatchingImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include <algorithm>
+#include <atomic>
+#include <bitset>
+#include <cstdlib>
+#include <future>
+#include <limits>
+#include <sstream>
+#include <thread>
+
+namespace otb
+{
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::SemiGlobalMatchingImageFilter()
+{
+  this->SetNumberOfRequiredInputs(2);
+
+  // Metric, horizontal and vertical disparities, mask
+  this->SetNumberOfRequiredOutputs(4);
+  this->SetNthOutput(0, TOutputMetricImage::New());
+  this->SetNthOutput(1, TOutputDisparityImage::New());
+  this->SetNthOutput(2, TOutputDisparityImage::New());
+  this->SetNthOutput(3, TMaskImage::New());
+
+  m_Radius.Fill(2);
+
+  m_MinimumHorizontalDisparity = -10;
+  m_MaximumHorizontalDisparity = 10;
+
+  m_P1 = 8;
+  m_P2 = 64;
+
+  m_NumberOfPaths = 8;
+
+  m_TileSize    = 256;
+  m_TileOverlap = 64;
+
+  m_LeftRightCheck        = true;
+  m_SubPixelInterpolation = true;
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::SetLeftInput(const TInputImage* image)
+{
+  // Process object is not const-correct so the const casting is required.
+  this->SetNthInput(0, const_cast<TInputImage*>(image));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::SetRightInput(const TInputImage* image)
+{
+  this->SetNthInput(1, const_cast<TInputImage*>(image));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::SetLeftMaskInput(const TMaskImage* image)
+{
+  this->SetNthInput(2, const_cast<TMaskImage*>(image));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::SetRightMaskInput(const TMaskImage* image)
+{
+  this->SetNthInput(3, const_cast<TMaskImage*>(image));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+const TInputImage* SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GetLeftInput() const
+{
+  if (this->GetNumberOfInputs() < 1)
+  {
+    return nullptr;
+  }
+  return static_cast<const TInputImage*>(this->itk::ProcessObject::GetInput(0));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+const TInputImage* SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GetRightInput() const
+{
+  if (this->GetNumberOfInputs() < 2)
+  {
+    return nullptr;
+  }
+  return static_cast<const TInputImage*>(this->itk::ProcessObject::GetInput(1));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+const TMaskImage* SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GetLeftMaskInput() const
+{
+  if (this->GetNumberOfInputs() < 3)
+  {
+    return nullptr;
+  }
+  return static_cast<const TMaskImage*>(this->itk::ProcessObject::GetInput(2));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+const TMaskImage* SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GetRightMaskInput() const
+{
+  if (this->GetNumberOfInputs() < 4)
+  {
+    return nullptr;
+  }
+  return static_cast<const TMaskImage*>(this->itk::ProcessObject::GetInput(3));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+TOutputMetricImage* SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GetMetricOutput()
+{
+  return static_cast<TOutputMetricImage*>(this->itk::ProcessObject::GetOutput(0));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+TOutputDisparityImage* SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GetHorizontalDisparityOutput()
+{
+  return static_cast<TOutputDisparityImage*>(this->itk::ProcessObject::GetOutput(1));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+TOutputDisparityImage* SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GetVerticalDisparityOutput()
+{
+  return static_cast<TOutputDisparityImage*>(this->itk::ProcessObject::GetOutput(2));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+TMaskImage* SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GetOutputMask()
+{
+  return static_cast<TMaskImage*>(this->itk::ProcessObject::GetOutput(3));
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GenerateInputRequestedRegion()
+{
+  // Call superclass implementation
+  Superclass::GenerateInputRequestedRegion();
+
+  TInputImage* inLeftPtr      = const_cast<TInputImage*>(this->GetLeftInput());
+  TInputImage* inRightPtr     = const_cast<TInputImage*>(this->GetRightInput());
+  TMaskImage*  inLeftMaskPtr  = const_cast<TMaskImage*>(this->GetLeftMaskInput());
+  TMaskImage*  inRightMaskPtr = const_cast<TMaskImage*>(this->GetRightMaskInput());
+
+  if (!inLeftPtr || !inRightPtr)
+  {
+    return;
+  }
+
+  if (inLeftPtr->GetLargestPossibleRegion() != inRightPtr->GetLargestPossibleRegion())
+  {
+    itkExceptionMacro(<< "Left and right images do not have the same size ! Left largest region: " << inLeftPtr->GetLargestPossibleRegion()
+                      << ", right largest region: " << inRightPtr->GetLargestPossibleRegion());
+  }
+  if (inLeftMaskPtr && inLeftPtr->GetLargestPossibleRegion() != inLeftMaskPtr->GetLargestPossibleRegion())
+  {
+    itkExceptionMacro(<< "Left and mask images do not have the same size ! Left largest region: " << inLeftPtr->GetLargestPossibleRegion()
+                      << ", mask largest region: " << inLeftMaskPtr->GetLargestPossibleRegion());
+  }
+  if (inRightMaskPtr && inRightPtr->GetLargestPossibleRegion() != inRightMaskPtr->GetLargestPossibleRegion())
+  {
+    itkExceptionMacro(<< "Right and mask images do not have the same size ! Right largest region: " << inRightPtr->GetLargestPossibleRegion()
+                      << ", mask largest region: " << inRightMaskPtr->GetLargestPossibleRegion());
+  }
+
+  // The tiles are extended by the overlap, and the census transform needs its radius
+  RegionType inputLeftRegion = this->GetHorizontalDisparityOutput()->GetRequestedRegion();
+  SizeType   padding         = m_Radius;
+  padding[0] += m_TileOverlap;
+  padding[1] += m_TileOverlap;
+  inputLeftRegion.PadByRadius(padding);
+
+  // The right region is shifted by the disparity range
+  IndexType rightIndex = inputLeftRegion.GetIndex();
+  rightIndex[0] += m_MinimumHorizontalDisparity;
+  SizeType rightSize = inputLeftRegion.GetSize();
+  rightSize[0] += std::max(m_MaximumHorizontalDisparity - m_MinimumHorizontalDisparity, 0);
+  RegionType inputRightRegion(rightIndex, rightSize);
+
+  if (!inputLeftRegion.Crop(inLeftPtr->GetLargestPossibleRegion()))
+  {
+    inLeftPtr->SetRequestedRegion(inputLeftRegion);
+
+    itk::InvalidRequestedRegionError e(__FILE__, __LINE__);
+    std::ostringstream               msg;
+    msg << this->GetNameOfClass() << "::GenerateInputRequestedRegion()";
+    e.SetLocation(msg.str());
+    e.SetDescription("Requested region is (at least partially) outside the largest possible region of left image.");
+    e.SetDataObject(inLeftPtr);
+    throw e;
+  }
+  if (!inputRightRegion.Crop(inRightPtr->GetLargestPossibleRegion()))
+  {
+    inRightPtr->SetRequestedRegion(inputRightRegion);
+
+    itk::InvalidRequestedRegionError e(__FILE__, __LINE__);
+    std::ostringstream               msg;
+    msg << this->GetNameOfClass() << "::GenerateInputRequestedRegion()";
+    e.SetLocation(msg.str());
+    e.SetDescription("Requested region is (at least partially) outside the largest possible region of right image.");
+    e.SetDataObject(inRightPtr);
+    throw e;
+  }
+
+  inLeftPtr->SetRequestedRegion(inputLeftRegion);
+  inRightPtr->SetRequestedRegion(inputRightRegion);
+
+  if (inLeftMaskPtr)
+  {
+    inLeftMaskPtr->SetRequestedRegion(inputLeftRegion);
+  }
+  if (inRightMaskPtr)
+  {
+    inRightMaskPtr->SetRequestedRegion(inputRightRegion);
+  }
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::GenerateData()
+{
+  // Check the parameters
+  if (m_MaximumHorizontalDisparity < m_MinimumHorizontalDisparity)
+  {
+    itkExceptionMacro(<< "Maximum horizontal disparity (" << m_MaximumHorizontalDisparity << ") is lower than the minimum one ("
+                      << m_MinimumHorizontalDisparity << ")");
+  }
+  if (m_NumberOfPaths != 4 && m_NumberOfPaths != 8 && m_NumberOfPaths != 16)
+  {
+    itkExceptionMacro(<< "Number of paths should be 4, 8 or 16, not " << m_NumberOfPaths);
+  }
+  const unsigned int censusBits = (2 * m_Radius[0] + 1) * (2 * m_Radius[1] + 1) - 1;
+  if (censusBits > 64)
+  {
+    itkExceptionMacro(<< "Census transform radius " << m_Radius << " is too large: the window should have at most 65 pixels");
+  }
+  if (m_P2 < m_P1)
+  {
+    itkExceptionMacro(<< "P2 (" << m_P2 << ") should be greater than P1 (" << m_P1 << ")");
+  }
+  if (m_NumberOfPaths * (censusBits + m_P2) > std::numeric_limits<CostType>::max() / 2)
+  {
+    itkExceptionMacro(<< "P2 (" << m_P2 << ") is too large for the aggregation of " << m_NumberOfPaths << " paths");
+  }
+
+  this->AllocateOutputs();
+
+  TOutputMetricImage*    outMetricPtr = this->GetMetricOutput();
+  TOutputDisparityImage* outHDispPtr  = this->GetHorizontalDisparityOutput();
+  TOutputDisparityImage* outVDispPtr  = this->GetVerticalDisparityOutput();
+  TMaskImage*            outMaskPtr   = this->GetOutputMask();
+
+  outMetricPtr->FillBuffer(0.);
+  outHDispPtr->FillBuffer(static_cast<DisparityPixelType>(m_MinimumHorizontalDisparity));
+  outVDispPtr->FillBuffer(0.);
+  outMaskPtr->FillBuffer(0);
+
+  // Split the requested region in tiles
+  const RegionType        requestedRegion = outHDispPtr->GetRequestedRegion();
+  const unsigned int      tileSize        = std::max(m_TileSize, 1u);
+  std::vector<RegionType> tiles;
+  for (unsigned int y = 0; y < requestedRegion.GetSize(1); y += tileSize)
+  {
+    for (unsigned int x = 0; x < requestedRegion.GetSize(0); x += tileSize)
+    {
+      IndexType index = requestedRegion.GetIndex();
+      index[0] += x;
+      index[1] += y;
+      SizeType size;
+      size[0] = std::min<unsigned int>(tileSize, requestedRegion.GetSize(0) - x);
+      size[1] = std::min<unsigned int>(tileSize, requestedRegion.GetSize(1) - y);
+      tiles.push_back(RegionType(index, size));
+    }
+  }
+
+  // Process the tiles in parallel, the calling thread reports the progress
+  std::atomic<unsigned int> nextTile(0);
+  std::atomic<unsigned int> doneTiles(0);
+  const std::thread::id     callingThread = std::this_thread::get_id();
+  auto                      worker        = [&]() {
+    for (unsigned int tile = nextTile++; tile < tiles.size(); tile = nextTile++)
+    {
+      this->MatchTile(tiles[tile]);
+      ++doneTiles;
+      if (std::this_thread::get_id() == callingThread)
+      {
+        this->UpdateProgress(static_cast<float>(doneTiles) / static_cast<float>(tiles.size()));
+      }
+    }
+  };
+
+  const unsigned int             nbTasks = std::max(1u, std::min<unsigned int>(this->GetNumberOfThreads(), tiles.size()));
+  std::vector<std::future<void>> tasks;
+  for (unsigned int task = 1; task < nbTasks; ++task)
+  {
+    tasks.push_back(std::async(std::launch::async, worker));
+  }
+  worker();
+  for (auto& task : tasks)
+  {
+    task.get();
+  }
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::MatchTile(const RegionType& outputTile)
+{
+  const TInputImage* inLeftPtr      = this->GetLeftInput();
+  const TInputImage* inRightPtr     = this->GetRightInput();
+  const TMaskImage*  inLeftMaskPtr  = this->GetLeftMaskInput();
+  const TMaskImage*  inRightMaskPtr = this->GetRightMaskInput();
+
+  // Extend the tile by the overlap
+  RegionType tile = outputTile;
+  SizeType   overlap;
+  overlap.Fill(m_TileOverlap);
+  tile.PadByRadius(overlap);
+  tile.Crop(inLeftPtr->GetLargestPossibleRegion());
+
+  const unsigned int width         = tile.GetSize(0);
+  const unsigned int height        = tile.GetSize(1);
+  const unsigned int nbDisparities = m_MaximumHorizontalDisparity - m_MinimumHorizontalDisparity + 1;
+
+  // Right pixels matched by the tile
+  IndexType rightIndex = tile.GetIndex();
+  rightIndex[0] += m_MinimumHorizontalDisparity;
+  SizeType rightSize = tile.GetSize();
+  rightSize[0] += nbDisparities - 1;
+  const RegionType   rightTile(rightIndex, rightSize);
+  const unsigned int rightWidth = rightSize[0];
+
+  std::vector<uint64_t>      leftCensus;
+  std::vector<uint64_t>      rightCensus;
+  std::vector<unsigned char> leftValid;
+  std::vector<unsigned char> rightValid;
+  this->CensusTransform(inLeftPtr, inLeftMaskPtr, tile, leftCensus, leftValid);
+  this->CensusTransform(inRightPtr, inRightMaskPtr, rightTile, rightCensus, rightValid);
+
+  // Hamming distances between census transforms, unmatched right pixels get the maximum cost
+  const CostType        maxCost = (2 * m_Radius[0] + 1) * (2 * m_Radius[1] + 1) - 1;
+  std::vector<CostType> costs(static_cast<std::size_t>(width) * height * nbDisparities, 0);
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      const std::size_t pixel = static_cast<std::size_t>(y) * width + x;
+      if (!leftValid[pixel])
+      {
+        continue;
+      }
+      const std::size_t right = static_cast<std::size_t>(y) * rightWidth + x;
+      CostType*         cost  = costs.data() + pixel * nbDisparities;
+      for (unsigned int d = 0; d < nbDisparities; ++d)
+      {
+        cost[d] = rightValid[right + d] ? static_cast<CostType>(std::bitset<64>(leftCensus[pixel] ^ rightCensus[right + d]).count()) : maxCost;
+      }
+    }
+  }
+
+  // Aggregate along the paths
+  static const int directions[16][2] = {{1, 0}, {-1, 0}, {0, 1}, {0, -1}, {1, 1}, {-1, 1}, {1, -1}, {-1, -1},
+                                        {2, 1}, {-2, 1}, {2, -1}, {-2, -1}, {1, 2}, {-1, 2}, {1, -2}, {-1, -2}};
+
+  std::vector<CostType> sums(costs.size(), 0);
+  for (unsigned int path = 0; path < m_NumberOfPaths; ++path)
+  {
+    this->AggregatePath(costs, width, height, nbDisparities, directions[path][0], directions[path][1], sums);
+  }
+
+  // Winner takes all on the output tile
+  itk::ImageRegionIterator<TOutputMetricImage>    metricIt(this->GetMetricOutput(), outputTile);
+  itk::ImageRegionIterator<TOutputDisparityImage> hdispIt(this->GetHorizontalDisparityOutput(), outputTile);
+  itk::ImageRegionIterator<TMaskImage>            maskIt(this->GetOutputMask(), outputTile);
+
+  const unsigned int    offsetX = outputTile.GetIndex(0) - tile.GetIndex(0);
+  const unsigned int    offsetY = outputTile.GetIndex(1) - tile.GetIndex(1);
+  std::vector<unsigned> rightBest(rightWidth);
+  for (unsigned int y = offsetY; y < offsetY + outputTile.GetSize(1); ++y)
+  {
+    const CostType* rowSums = sums.data() + static_cast<std::size_t>(y) * width * nbDisparities;
+
+    // Best disparity of each right pixel of the row, for the consistency check
+    if (m_LeftRightCheck)
+    {
+      std::vector<CostType> rightMin(rightWidth, std::numeric_limits<CostType>::max());
+      for (unsigned int x = 0; x < width; ++x)
+      {
+        for (unsigned int d = 0; d < nbDisparities; ++d)
+        {
+          if (rowSums[x * nbDisparities + d] < rightMin[x + d])
+          {
+            rightMin[x + d]  = rowSums[x * nbDisparities + d];
+            rightBest[x + d] = d;
+          }
+        }
+      }
+    }
+
+    for (unsigned int x = offsetX; x < offsetX + outputTile.GetSize(0); ++x, ++metricIt, ++hdispIt, ++maskIt)
+    {
+      const std::size_t pixel = static_cast<std::size_t>(y) * width + x;
+      if (!leftValid[pixel])
+      {
+        continue;
+      }
+
+      const CostType*    sum  = rowSums + static_cast<std::size_t>(x) * nbDisparities;
+      const unsigned int best = std::min_element(sum, sum + nbDisparities) - sum;
+
+      if (!rightValid[static_cast<std::size_t>(y) * rightWidth + x + best])
+      {
+        continue;
+      }
+      if (m_LeftRightCheck && std::abs(static_cast<int>(rightBest[x + best]) - static_cast<int>(best)) > 1)
+      {
+        continue;
+      }
+
+      double disparity = m_MinimumHorizontalDisparity + static_cast<int>(best);
+      if (m_SubPixelInterpolation && best > 0 && best + 1 < nbDisparities)
+      {
+        const double previous  = sum[best - 1];
+        const double next      = sum[best + 1];
+        const double curvature = previous - 2. * sum[best] + next;
+        if (curvature > 0)
+        {
+          disparity += 0.5 * (previous - next) / curvature;
+        }
+      }
+
+      metricIt.Set(static_cast<MetricValueType>(static_cast<double>(sum[best]) / m_NumberOfPaths));
+      hdispIt.Set(static_cast<DisparityPixelType>(disparity));
+      maskIt.Set(1);
+    }
+  }
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::CensusTransform(
+    const TInputImage* image, const TMaskImage* mask, const RegionType& region, std::vector<uint64_t>& census, std::vector<unsigned char>& valid) const
+{
+  const RegionType   bufferedRegion = image->GetBufferedRegion();
+  const unsigned int width          = region.GetSize(0);
+  const unsigned int height         = region.GetSize(1);
+  const unsigned int rx             = m_Radius[0];
+  const unsigned int ry             = m_Radius[1];
+
+  census.assign(static_cast<std::size_t>(width) * height, 0);
+  valid.assign(static_cast<std::size_t>(width) * height, 0);
+
+  // Copy the region and its margin, replicating the edges of the buffered region
+  const unsigned int  paddedWidth  = width + 2 * rx;
+  const unsigned int  paddedHeight = height + 2 * ry;
+  std::vector<double> values(static_cast<std::size_t>(paddedWidth) * paddedHeight);
+  for (unsigned int j = 0; j < paddedHeight; ++j)
+  {
+    for (unsigned int i = 0; i < paddedWidth; ++i)
+    {
+      IndexType index;
+      index[0] = region.GetIndex(0) + static_cast<int>(i) - static_cast<int>(rx);
+      index[1] = region.GetIndex(1) + static_cast<int>(j) - static_cast<int>(ry);
+      for (unsigned int dim = 0; dim < 2; ++dim)
+      {
+        index[dim] = std::max<itk::IndexValueType>(index[dim], bufferedRegion.GetIndex(dim));
+        index[dim] = std::min<itk::IndexValueType>(index[dim], bufferedRegion.GetIndex(dim) + bufferedRegion.GetSize(dim) - 1);
+      }
+      values[static_cast<std::size_t>(j) * paddedWidth + i] = static_cast<double>(image->GetPixel(index));
+    }
+  }
+
+  for (unsigned int y = 0; y < height; ++y)
+  {
+    for (unsigned int x = 0; x < width; ++x)
+    {
+      IndexType index;
+      index[0] = region.GetIndex(0) + x;
+      index[1] = region.GetIndex(1) + y;
+      if (!bufferedRegion.IsInside(index) || (mask && mask->GetPixel(index) <= 0))
+      {
+        continue;
+      }
+
+      const double* center = values.data() + static_cast<std::size_t>(y + ry) * paddedWidth + x + rx;
+      uint64_t      bits   = 0;
+      for (int j = -static_cast<int>(ry); j <= static_cast<int>(ry); ++j)
+      {
+        const double* row = center + j * static_cast<std::ptrdiff_t>(paddedWidth);
+        for (int i = -static_cast<int>(rx); i <= static_cast<int>(rx); ++i)
+        {
+          if (i != 0 || j != 0)
+          {
+            bits = (bits << 1) | (row[i] < *center ? 1 : 0);
+          }
+        }
+      }
+      census[static_cast<std::size_t>(y) * width + x] = bits;
+      valid[static_cast<std::size_t>(y) * width + x]  = 1;
+    }
+  }
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::AggregatePath(
+    const std::vector<CostType>& costs, unsigned int width, unsigned int height, unsigned int nbDisparities, int dx, int dy, std::vector<CostType>& sums) const
+{
+  // Aggregated costs of the last rows, with a sentinel on each side of the disparities
+  const CostType     sentinel = std::numeric_limits<CostType>::max() / 2;
+  const unsigned int nbRows   = std::abs(dy) + 1;
+  const unsigned int stride   = nbDisparities + 2;
+
+  std::vector<CostType> rows(static_cast<std::size_t>(nbRows) * width * stride, sentinel);
+  std::vector<CostType> rowsMin(static_cast<std::size_t>(nbRows) * width, 0);
+  std::vector<CostType> start(stride, 0);
+  start.front() = sentinel;
+  start.back()  = sentinel;
+
+  const CostType p1 = m_P1;
+  const CostType p2 = m_P2;
+
+  // Scan so that the previous pixel along the path is always computed first
+  for (unsigned int row = 0; row < height; ++row)
+  {
+    const int y = dy < 0 ? height - 1 - row : row;
+    for (unsigned int column = 0; column < width; ++column)
+    {
+      const int         x     = dx < 0 ? width - 1 - column : column;
+      const std::size_t pixel = static_cast<std::size_t>(y) * width + x;
+
+      const int       px = x - dx;
+      const int       py = y - dy;
+      const CostType* previous;
+      CostType        previousMin;
+      if (px >= 0 && px < static_cast<int>(width) && py >= 0 && py < static_cast<int>(height))
+      {
+        const std::size_t slot = static_cast<std::size_t>(py % nbRows) * width + px;
+        previous               = rows.data() + slot * stride + 1;
+        previousMin            = rowsMin[slot];
+      }
+      else
+      {
+        previous    = start.data() + 1;
+        previousMin = 0;
+      }
+
+      const std::size_t slot    = static_cast<std::size_t>(y % nbRows) * width + x;
+      CostType*         current = rows.data() + slot * stride + 1;
+      const CostType*   cost    = costs.data() + pixel * nbDisparities;
+      CostType*         sum     = sums.data() + pixel * nbDisparities;
+      const CostType    jump    = previousMin + p2;
+
+      // Branch-free loop over the disparities so that the min operations vectorize
+      CostType currentMin = sentinel;
+      for (int d = 0; d < static_cast<int>(nbDisparities); ++d)
+      {
+        CostType best = std::min<CostType>(previous[d], jump);
+        best          = std::min<CostType>(best, previous[d - 1] + p1);
+        best          = std::min<CostType>(best, previous[d + 1] + p1);
+        current[d]    = cost[d] + best - previousMin;
+        sum[d] += current[d];
+        currentMin = std::min(currentMin, current[d]);
+      }
+      rowsMin[slot] = currentMin;
+    }
+  }
+}
+
+template <class TInputImage, class TOutputMetricImage, class TOutputDisparityImage, class TMaskImage>
+void SemiGlobalMatchingImageFilter<TInputImage, TOutputMetricImage, TOutputDisparityImage, TMaskImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Radius: " << m_Radius << std::endl;
+  os << indent << "Horizontal disparity range: [" << m_MinimumHorizontalDisparity << ", " << m_MaximumHorizontalDisparity << "]" << std::endl;
+  os << indent << "P1: " << m_P1 << ", P2: " << m_P2 << std::endl;
+  os << indent << "Number of paths: " << m_NumberOfPaths << std::endl;
+  os << indent << "Tile size: " << m_TileSize << ", overlap: " << m_TileOverlap << std::endl;
+  os << indent << "Left-right check: " << m_LeftRightCheck << std::endl;
+  os << indent << "Sub-pixel interpolation: " << m_SubPixelInterpolation << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -240,6 +240,11 @@ private:
   /** dichotomy refinement method */
   void DichotomyRefinement(const RegionType& outputRegionForThread, itk::ThreadIdType threadId);
 
+  /** Fill a (2*radius+1) window with the right image around a position, shifted by a
+   *  sub-pixel offset. Same values as a linear ResampleImageFilter, without building
+   *  a pipeline for each evaluated position. */
+  void ResampleShiftedWindow(const IndexType& centre, const TransformationType::OutputVectorType& offset, TInputImage* window) const;
+
   /** The radius of the blocks */
   SizeType m_Radius;
 
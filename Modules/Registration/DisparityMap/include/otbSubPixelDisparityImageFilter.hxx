@@ -23,6 +23,9 @@
 
 #include "otbSubPixelDisparityImageFilter.h"
 
+#include <algorithm>
+#include <cmath>
+
 namespace otb
 {
 template <class TInputImage, class TOutputMetricImage, class TDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
@@ -613,7 +616,19 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
   bool horizontalInterpolation = false;
   bool verticalInterpolation   = false;
 
-  typename ResamplerFilterType::Pointer resampler;
+  // right window resampled at sub-pixel positions, centred on the radius
+  typename TInputImage::Pointer shiftedWindowPtr = TInputImage::New();
+  RegionType                    shiftedWindowRegion;
+  shiftedWindowRegion.SetSize(0, 2 * m_Radius[0] + 1);
+  shiftedWindowRegion.SetSize(1, 2 * m_Radius[1] + 1);
+  shiftedWindowPtr->SetRegions(shiftedWindowRegion);
+  shiftedWindowPtr->Allocate();
+
+  RegionType tinyShiftedRegion;
+  tinyShiftedRegion.SetIndex(0, m_Radius[0]);
+  tinyShiftedRegion.SetIndex(1, m_Radius[1]);
+  tinyShiftedRegion.SetSize(0, 1);
+  tinyShiftedRegion.SetSize(1, 1);
 
   // step value as disparityType
   DisparityPixelType stepDisparity    = static_cast<DisparityPixelType>(this->m_Step);
@@ -877,45 +892,16 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
       }
       else
       {
-        // interpolation done, use a resampler to compute new score
-        typename TInputImage::Pointer fakeRightPtr = TInputImage::New();
-        fakeRightPtr->SetRegions(rightBufferedRegion);
-        fakeRightPtr->SetPixelContainer((const_cast<TInputImage*>(inRightPtr))->GetPixelContainer());
-
+        // interpolation done, resample the right window to compute new score
         itk::ConstNeighborhoodIterator<TInputImage> shiftedIt;
         itk::ConstantBoundaryCondition<TInputImage> nbc3;
         shiftedIt.OverrideBoundaryCondition(&nbc3);
 
-        SizeType windowSize;
-        windowSize[0] = 2 * m_Radius[0] + 1;
-        windowSize[1] = 2 * m_Radius[1] + 1;
-
-        IndexType upleftCorner;
-        upleftCorner[0] = curRightPos[0] - m_Radius[0];
-        upleftCorner[1] = curRightPos[1] - m_Radius[1];
-
-        TransformationType::Pointer          transfo = TransformationType::New();
-        TransformationType::OutputVectorType offsetTransfo(2);
-
-        RegionType tinyShiftedRegion;
-        tinyShiftedRegion.SetSize(0, 1);
-        tinyShiftedRegion.SetSize(1, 1);
-        tinyShiftedRegion.SetIndex(0, curRightPos[0]);
-        tinyShiftedRegion.SetIndex(1, curRightPos[1]);
-
-        resampler = ResamplerFilterType::New();
-        resampler->SetInput(fakeRightPtr);
-        resampler->SetSize(windowSize);
-        resampler->SetNumberOfThreads(1);
-        resampler->SetTransform(transfo);
-        resampler->SetOutputStartIndex(upleftCorner);
-
+        TransformationType::OutputVectorType offsetTransfo;
         offsetTransfo[0] = outHDispIt.Get() * stepDisparity - static_cast<double>(hDisp_i);
         offsetTransfo[1] = outVDispIt.Get() * stepDisparity - static_cast<double>(vDisp_i);
-        transfo->SetOffset(offsetTransfo);
-        resampler->Modified();
-        resampler->Update();
-        shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+        this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+        shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
         outMetricIt.Set(m_Functor(leftIt, shiftedIt));
 
         if ((outMetricIt.Get() > neighborsMetric[1][1] && m_Minimize) || (outMetricIt.Get() < neighborsMetric[1][1] && !m_Minimize))
@@ -1030,7 +1016,19 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
   bool horizontalInterpolation = false;
   bool verticalInterpolation   = false;
 
-  typename ResamplerFilterType::Pointer resampler;
+  // right window resampled at sub-pixel positions, centred on the radius
+  typename TInputImage::Pointer shiftedWindowPtr = TInputImage::New();
+  RegionType                    shiftedWindowRegion;
+  shiftedWindowRegion.SetSize(0, 2 * m_Radius[0] + 1);
+  shiftedWindowRegion.SetSize(1, 2 * m_Radius[1] + 1);
+  shiftedWindowPtr->SetRegions(shiftedWindowRegion);
+  shiftedWindowPtr->Allocate();
+
+  RegionType tinyShiftedRegion;
+  tinyShiftedRegion.SetIndex(0, m_Radius[0]);
+  tinyShiftedRegion.SetIndex(1, m_Radius[1]);
+  tinyShiftedRegion.SetSize(0, 1);
+  tinyShiftedRegion.SetSize(1, 1);
 
   // step value as disparityType
   DisparityPixelType stepDisparity    = static_cast<DisparityPixelType>(this->m_Step);
@@ -1315,45 +1313,16 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
       }
       else
       {
-        // interpolation done, use a resampler to compute new score
-        typename TInputImage::Pointer fakeRightPtr = TInputImage::New();
-        fakeRightPtr->SetRegions(rightBufferedRegion);
-        fakeRightPtr->SetPixelContainer((const_cast<TInputImage*>(inRightPtr))->GetPixelContainer());
-
+        // interpolation done, resample the right window to compute new score
         itk::ConstNeighborhoodIterator<TInputImage> shiftedIt;
         itk::ConstantBoundaryCondition<TInputImage> nbc3;
         shiftedIt.OverrideBoundaryCondition(&nbc3);
 
-        SizeType windowSize;
-        windowSize[0] = 2 * m_Radius[0] + 1;
-        windowSize[1] = 2 * m_Radius[1] + 1;
-
-        IndexType upleftCorner;
-        upleftCorner[0] = curRightPos[0] - m_Radius[0];
-        upleftCorner[1] = curRightPos[1] - m_Radius[1];
-
-        TransformationType::Pointer          transfo = TransformationType::New();
-        TransformationType::OutputVectorType offsetTransfo(2);
-
-        RegionType tinyShiftedRegion;
-        tinyShiftedRegion.SetSize(0, 1);
-        tinyShiftedRegion.SetSize(1, 1);
-        tinyShiftedRegion.SetIndex(0, curRightPos[0]);
-        tinyShiftedRegion.SetIndex(1, curRightPos[1]);
-
-        resampler = ResamplerFilterType::New();
-        resampler->SetInput(fakeRightPtr);
-        resampler->SetSize(windowSize);
-        resampler->SetNumberOfThreads(1);
-        resampler->SetTransform(transfo);
-        resampler->SetOutputStartIndex(upleftCorner);
-
+        TransformationType::OutputVectorType offsetTransfo;
         offsetTransfo[0] = outHDispIt.Get() * stepDisparity - static_cast<double>(hDisp_i);
         offsetTransfo[1] = outVDispIt.Get() * stepDisparity - static_cast<double>(vDisp_i);
-        transfo->SetOffset(offsetTransfo);
-        resampler->Modified();
-        resampler->Update();
-        shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+        this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+        shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
         outMetricIt.Set(m_Functor(leftIt, shiftedIt));
 
         if ((outMetricIt.Get() > neighborsMetric[1][1] && m_Minimize) || (outMetricIt.Get() < neighborsMetric[1][1] && !m_Minimize))
@@ -1465,10 +1434,6 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
   int   hDisp_i;
   int   vDisp_i;
 
-  typename TInputImage::Pointer fakeRightPtr = TInputImage::New();
-  fakeRightPtr->SetRegions(rightBufferedRegion);
-  fakeRightPtr->SetPixelContainer((const_cast<TInputImage*>(inRightPtr))->GetPixelContainer());
-
   // compute metric around current right position
   bool horizontalInterpolation = false;
   bool verticalInterpolation   = false;
@@ -1477,19 +1442,18 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
   double       neighborsMetric[3][3] = {{0, 0, 0}, {0, 0, 0}, {0, 0, 0}};
   unsigned int nbIterMax             = 10;
 
-  // set the output size and start index to the center position
-  // then set the smaller shift in the transform
-  IndexType upleftCorner;
-  SizeType  windowSize;
-  windowSize[0] = 2 * m_Radius[0] + 1;
-  windowSize[1] = 2 * m_Radius[1] + 1;
-
-  TransformationType::Pointer          transfo = TransformationType::New();
-  TransformationType::OutputVectorType offsetTransfo(2);
+  // sub-pixel shift of the right window
+  TransformationType::OutputVectorType offsetTransfo;
   offsetTransfo[0] = 0.0;
   offsetTransfo[1] = 0.0;
 
-  typename ResamplerFilterType::Pointer resampler;
+  // right window resampled at sub-pixel positions, centred on the radius
+  typename TInputImage::Pointer shiftedWindowPtr = TInputImage::New();
+  RegionType                    shiftedWindowRegion;
+  shiftedWindowRegion.SetSize(0, 2 * m_Radius[0] + 1);
+  shiftedWindowRegion.SetSize(1, 2 * m_Radius[1] + 1);
+  shiftedWindowPtr->SetRegions(shiftedWindowRegion);
+  shiftedWindowPtr->Allocate();
 
   // step value as disparityType
   DisparityPixelType stepDisparity    = static_cast<DisparityPixelType>(this->m_Step);
@@ -1546,21 +1510,6 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
         curRightPos[1] = curLeftPos[1];
       }
 
-      // update resampler input position
-      upleftCorner[0] = curRightPos[0] - m_Radius[0];
-      upleftCorner[1] = curRightPos[1] - m_Radius[1];
-
-      // resampler
-      resampler = ResamplerFilterType::New();
-      resampler->SetInput(fakeRightPtr);
-      resampler->SetSize(windowSize);
-      resampler->SetNumberOfThreads(1);
-      resampler->SetTransform(transfo);
-      resampler->SetOutputStartIndex(upleftCorner);
-
-      tinyShiftedRegion.SetIndex(0, curRightPos[0]);
-      tinyShiftedRegion.SetIndex(1, curRightPos[1]);
-
       // check if the current right position is inside the right image
       if (rightBufferedRegion.IsInside(curRightPos))
       {
@@ -1720,10 +1669,8 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
           {
             yd               = 0.5 * (yc + yb);
             offsetTransfo[1] = yd - static_cast<double>(vDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
             s_yd = m_Functor(leftIt, shiftedIt);
 
             if ((s_yd < s_yb && m_Minimize) || (s_yd > s_yb && !m_Minimize))
@@ -1742,10 +1689,8 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
           {
             yd               = 0.5 * (ya + yb);
             offsetTransfo[1] = yd - static_cast<double>(vDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
             s_yd = m_Functor(leftIt, shiftedIt);
 
             if ((s_yd < s_yb && m_Minimize) || (s_yd > s_yb && !m_Minimize))
@@ -1783,10 +1728,8 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
           {
             xd               = 0.5 * (xc + xb);
             offsetTransfo[0] = xd - static_cast<double>(hDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
             s_xd = m_Functor(leftIt, shiftedIt);
 
             if ((s_xd < s_xb && m_Minimize) || (s_xd > s_xb && !m_Minimize))
@@ -1805,10 +1748,8 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
           {
             xd               = 0.5 * (xa + xb);
             offsetTransfo[0] = xd - static_cast<double>(hDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
             s_xd = m_Functor(leftIt, shiftedIt);
 
             if ((s_xd < s_xb && m_Minimize) || (s_xd > s_xb && !m_Minimize))
@@ -1854,10 +1795,8 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
             yd               = 0.5 * (yc + yb);
             offsetTransfo[0] = xd - static_cast<double>(hDisp_i);
             offsetTransfo[1] = yd - static_cast<double>(vDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
             s_d = m_Functor(leftIt, shiftedIt);
 
             if ((s_d < s_b && m_Minimize) || (s_d > s_b && !m_Minimize))
@@ -1879,10 +1818,8 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
             yd               = 0.5 * (ya + yb);
             offsetTransfo[0] = xd - static_cast<double>(hDisp_i);
             offsetTransfo[1] = yd - static_cast<double>(vDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
             s_d = m_Functor(leftIt, shiftedIt);
 
             if ((s_d < s_b && m_Minimize) || (s_d > s_b && !m_Minimize))
@@ -1906,17 +1843,13 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
 
             offsetTransfo[0] = xe - static_cast<double>(hDisp_i);
             offsetTransfo[1] = ye - static_cast<double>(vDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
 
 
             offsetTransfo[0] = xf - static_cast<double>(hDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
           }
 
           // Horizontal step
@@ -1926,10 +1859,8 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
             xd               = 0.5 * (xf + xb);
             offsetTransfo[0] = xd - static_cast<double>(hDisp_i);
             offsetTransfo[1] = yd - static_cast<double>(vDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
             s_d = m_Functor(leftIt, shiftedIt);
 
             if ((s_d < s_b && m_Minimize) || (s_d > s_b && !m_Minimize))
@@ -1951,10 +1882,8 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
             xd               = 0.5 * (xe + xb);
             offsetTransfo[0] = xd - static_cast<double>(hDisp_i);
             offsetTransfo[1] = yd - static_cast<double>(vDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
             s_d = m_Functor(leftIt, shiftedIt);
 
             if ((s_d < s_b && m_Minimize) || (s_d > s_b && !m_Minimize))
@@ -1978,16 +1907,12 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
 
             offsetTransfo[0] = xa - static_cast<double>(hDisp_i);
             offsetTransfo[1] = ya - static_cast<double>(vDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
 
             offsetTransfo[1] = yc - static_cast<double>(vDisp_i);
-            transfo->SetOffset(offsetTransfo);
-            resampler->Modified();
-            resampler->Update();
-            shiftedIt.Initialize(m_Radius, resampler->GetOutput(), tinyShiftedRegion);
+            this->ResampleShiftedWindow(curRightPos, offsetTransfo, shiftedWindowPtr);
+            shiftedIt.Initialize(m_Radius, shiftedWindowPtr, tinyShiftedRegion);
           }
         }
 
@@ -2046,6 +1971,77 @@ void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityIma
   m_WrongExtrema[threadId] = static_cast<double>(nb_WrongExtrema) / static_cast<double>(outputRegionForThread.GetNumberOfPixels());
 }
 
+template <class TInputImage, class TOutputMetricImage, class TDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
+void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityImage, TMaskImage, TBlockMatchingFunctor>::ResampleShiftedWindow(
+    const IndexType& centre, const TransformationType::OutputVectorType& offset, TInputImage* window) const
+{
+  typedef typename TInputImage::PixelType PixelType;
+
+  const TInputImage* inRightPtr = this->GetRightInput();
+  const RegionType&  buffered   = inRightPtr->GetBufferedRegion();
+  const PixelType*   buffer     = inRightPtr->GetBufferPointer();
+
+  const itk::IndexValueType startX = buffered.GetIndex(0);
+  const itk::IndexValueType startY = buffered.GetIndex(1);
+  const itk::IndexValueType endX   = startX + static_cast<itk::IndexValueType>(buffered.GetSize(0)) - 1;
+  const itk::IndexValueType endY   = startY + static_cast<itk::IndexValueType>(buffered.GetSize(1)) - 1;
+  const itk::OffsetValueType stride = buffered.GetSize(0);
+
+  const double minValue = static_cast<double>(itk::NumericTraits<PixelType>::NonpositiveMin());
+  const double maxValue = static_cast<double>(itk::NumericTraits<PixelType>::max());
+
+  PixelType*         out    = window->GetBufferPointer();
+  const unsigned int width  = 2 * m_Radius[0] + 1;
+  const unsigned int height = 2 * m_Radius[1] + 1;
+
+  for (unsigned int j = 0; j < height; ++j)
+  {
+    const double y = static_cast<double>(centre[1] - static_cast<itk::IndexValueType>(m_Radius[1]) + j) + offset[1];
+    double       x = static_cast<double>(centre[0] - static_cast<itk::IndexValueType>(m_Radius[0])) + offset[0];
+
+    for (unsigned int i = 0; i < width; ++i, x += 1., ++out)
+    {
+      // Outside of the buffer (in the sense of ImageFunction::IsInsideBuffer)
+      if (!(x >= startX - 0.5 && x < endX + 0.5 && y >= startY - 0.5 && y < endY + 0.5))
+      {
+        *out = itk::NumericTraits<PixelType>::ZeroValue();
+        continue;
+      }
+
+      // Bilinear interpolation, with the neighbours clamped to the buffer like LinearInterpolateImageFunction
+      itk::IndexValueType baseX = std::max(static_cast<itk::IndexValueType>(std::floor(x)), startX);
+      itk::IndexValueType baseY = std::max(static_cast<itk::IndexValueType>(std::floor(y)), startY);
+      const double        dx    = x - static_cast<double>(baseX);
+      const double        dy    = y - static_cast<double>(baseY);
+
+      const PixelType* p00   = buffer + (baseY - startY) * stride + (baseX - startX);
+      const double     val00 = static_cast<double>(*p00);
+      const bool       nextX = dx > 0. && baseX < endX;
+      const bool       nextY = dy > 0. && baseY < endY;
+
+      double value = val00;
+      if (nextX && nextY)
+      {
+        const double valx0 = val00 + (static_cast<double>(p00[1]) - val00) * dx;
+        const double val01 = static_cast<double>(p00[stride]);
+        const double valx1 = val01 + (static_cast<double>(p00[stride + 1]) - val01) * dx;
+        value              = valx0 + (valx1 - valx0) * dy;
+      }
+      else if (nextX)
+      {
+        value = val00 + (static_cast<double>(p00[1]) - val00) * dx;
+      }
+      else if (nextY)
+      {
+        value = val00 + (static_cast<double>(p00[stride]) - val00) * dy;
+      }
+
+      // Same bounds checking as the resampler cast
+      *out = static_cast<PixelType>(std::min(std::max(value, minValue), maxValue));
+    }
+  }
+}
+
 template <class TInputImage, class TOutputMetricImage, class TDisparityImage, class TMaskImage, class TBlockMatchingFunctor>
 void SubPixelDisparityImageFilter<TInputImage, TOutputMetricImage, TDisparityImage, TMaskImage, TBlockMatchingFunctor>::AfterThreadedGenerateData()
 {
@@ -35,9 +35,9 @@ typedef otb::DisparityMapMedianFilter<FloatImageType, FloatImageType, FloatImage
 int otbDisparityMapMedianFilter(int argc, char* argv[])
 {
 
-  if ((argc != 5) && (argc != 6))
+  if ((argc < 5) || (argc > 7))
   {
-    std::cerr << "Usage: " << argv[0] << " hdispinput_fname output_fname radius incoherencethres (maskinput_fname) ";
+    std::cerr << "Usage: " << argv[0] << " hdispinput_fname output_fname radius incoherencethres (histogrambinsize) (maskinput_fname) ";
     return EXIT_FAILURE;
   }
 
@@ -55,7 +55,12 @@ int otbDisparityMapMedianFilter(int argc, char* argv[])
 
   if (argc > 5)
   {
-    maskReader->SetFileName(argv[5]);
+    filter->SetHistogramBinSize(atof(argv[5]));
+  }
+
+  if (argc > 6)
+  {
+    maskReader->SetFileName(argv[6]);
     filter->SetMaskInput(maskReader->GetOutput());
   }
 
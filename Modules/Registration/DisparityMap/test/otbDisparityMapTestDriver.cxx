@@ -33,4 +33,7 @@ void RegisterTests()
   REGISTER_TEST(otbNCCRegistrationFilter);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilter);
   REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterNCC);
+  REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterCostVolume);
+  REGISTER_TEST(otbPixelWiseBlockMatchingImageFilterInitDisparity);
+  REGISTER_TEST(otbSemiGlobalMatchingImageFilter);
 }
@@ -37,7 +37,7 @@ int otbFineRegistrationImageFilterTest(int argc, char* argv[])
   if (argc != 16)
   {
     std::cerr << "Usage: " << argv[0] << " fixed_fname moving_fname output_correl output_field radius search_radius ";
-    std::cerr << "subpixPrecision metric(0=CC, 1=NCC, 2=MeanSquare, 3=Mean reciprocal square difference) ";
+    std::cerr << "subpixPrecision metric(0=CC, 1=NCC, 2=MeanSquare, 3=Mean reciprocal square difference, 4=NCC with FFT) ";
     std::cerr << "gridStep offsetX offsetY" << std::endl;
     std::cerr << "ROI : indexX, indexY, startX, startY" << std::endl;
     return EXIT_FAILURE;
@@ -145,9 +145,15 @@ int otbFineRegistrationImageFilterTest(int argc, char* argv[])
     registration->MinimizeOff();
     break;
   }
+  case 4:
+  {
+    std::cout << "Metric: normalized correlation with FFT" << std::endl;
+    registration->UseFFTOn();
+    break;
+  }
   default:
   {
-    std::cerr << "Metric id should be between 0 and 3" << std::endl;
+    std::cerr << "Metric id should be between 0 and 4" << std::endl;
     return EXIT_FAILURE;
   }
   }
@@ -120,3 +120,113 @@ int otbPixelWiseBlockMatchingImageFilterNCC(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+template <class TFunctor>
+bool CompareCostVolumeToNeighborhoods(const char* name, ReaderType* leftReader, ReaderType* rightReader, unsigned int radius, int minHDisp, int maxHDisp,
+                                      bool minimize)
+{
+  typedef otb::PixelWiseBlockMatchingImageFilter<ImageType, FloatImageType, FloatImageType, ImageType, TFunctor> FilterType;
+
+  typename FilterType::Pointer filters[2] = {FilterType::New(), FilterType::New()};
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    filters[i]->SetLeftInput(leftReader->GetOutput());
+    filters[i]->SetRightInput(rightReader->GetOutput());
+    filters[i]->SetRadius(radius);
+    filters[i]->SetMinimumHorizontalDisparity(minHDisp);
+    filters[i]->SetMaximumHorizontalDisparity(maxHDisp);
+    filters[i]->SetMinimumVerticalDisparity(-1);
+    filters[i]->SetMaximumVerticalDisparity(1);
+    filters[i]->SetMinimize(minimize);
+    filters[i]->SetUseCostVolume(i == 0);
+    filters[i]->Update();
+  }
+
+  // Disparities may differ between equally good candidates, so only compare the metrics
+  itk::ImageRegionConstIterator<FloatImageType> metric1(filters[0]->GetMetricOutput(), filters[0]->GetMetricOutput()->GetBufferedRegion());
+  itk::ImageRegionConstIterator<FloatImageType> metric2(filters[1]->GetMetricOutput(), filters[1]->GetMetricOutput()->GetBufferedRegion());
+
+  unsigned int differences = 0;
+  for (; !metric1.IsAtEnd(); ++metric1, ++metric2)
+  {
+    if (std::abs(metric1.Get() - metric2.Get()) > 1e-4 * std::max(1.f, std::abs(metric2.Get())))
+    {
+      ++differences;
+    }
+  }
+
+  std::cout << name << ": " << differences << " different metrics" << std::endl;
+  return differences == 0;
+}
+
+int otbPixelWiseBlockMatchingImageFilterCostVolume(int itkNotUsed(argc), char* argv[])
+{
+  ReaderType::Pointer leftReader = ReaderType::New();
+  leftReader->SetFileName(argv[1]);
+
+  ReaderType::Pointer rightReader = ReaderType::New();
+  rightReader->SetFileName(argv[2]);
+
+  const unsigned int radius   = atoi(argv[3]);
+  const int          minHDisp = atoi(argv[4]);
+  const int          maxHDisp = atoi(argv[5]);
+
+  typedef otb::Functor::SSDBlockMatching<ImageType, FloatImageType>        SSDBlockMatchingFunctorType;
+  typedef otb::Functor::SSDDivMeanBlockMatching<ImageType, FloatImageType> SSDDivMeanBlockMatchingFunctorType;
+
+  bool ok = CompareCostVolumeToNeighborhoods<SSDBlockMatchingFunctorType>("SSD", leftReader, rightReader, radius, minHDisp, maxHDisp, true);
+  ok      = CompareCostVolumeToNeighborhoods<SSDDivMeanBlockMatchingFunctorType>("SSDDivMean", leftReader, rightReader, radius, minHDisp, maxHDisp, true) && ok;
+  ok      = CompareCostVolumeToNeighborhoods<NCCBlockMatchingFunctorType>("NCC", leftReader, rightReader, radius, minHDisp, maxHDisp, false) && ok;
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+int otbPixelWiseBlockMatchingImageFilterInitDisparity(int itkNotUsed(argc), char* argv[])
+{
+  typedef otb::Functor::SSDBlockMatching<ImageType, FloatImageType>                                                                 SSDBlockMatchingFunctorType;
+  typedef otb::PixelWiseBlockMatchingImageFilter<ImageType, FloatImageType, FloatImageType, ImageType, SSDBlockMatchingFunctorType> FilterType;
+
+  ReaderType::Pointer leftReader = ReaderType::New();
+  leftReader->SetFileName(argv[1]);
+
+  ReaderType::Pointer rightReader = ReaderType::New();
+  rightReader->SetFileName(argv[2]);
+
+  // Full range search, then search around its own disparities
+  FilterType::Pointer filters[2] = {FilterType::New(), FilterType::New()};
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    filters[i]->SetLeftInput(leftReader->GetOutput());
+    filters[i]->SetRightInput(rightReader->GetOutput());
+    filters[i]->SetRadius(atoi(argv[3]));
+    filters[i]->SetMinimumHorizontalDisparity(atoi(argv[4]));
+    filters[i]->SetMaximumHorizontalDisparity(atoi(argv[5]));
+    filters[i]->SetMinimumVerticalDisparity(0);
+    filters[i]->SetMaximumVerticalDisparity(0);
+    filters[i]->MinimizeOn();
+  }
+  filters[0]->Update();
+
+  FilterType::SizeType explorationRadius;
+  explorationRadius[0] = 1;
+  explorationRadius[1] = 0;
+  filters[1]->SetHorizontalDisparityInput(filters[0]->GetHorizontalDisparityOutput());
+  filters[1]->SetExplorationRadius(explorationRadius);
+  filters[1]->Update();
+
+  const FloatImageType::RegionType&             region = filters[0]->GetHorizontalDisparityOutput()->GetBufferedRegion();
+  itk::ImageRegionConstIterator<FloatImageType> disp1(filters[0]->GetHorizontalDisparityOutput(), region);
+  itk::ImageRegionConstIterator<FloatImageType> disp2(filters[1]->GetHorizontalDisparityOutput(), region);
+
+  unsigned int differences = 0;
+  for (; !disp1.IsAtEnd(); ++disp1, ++disp2)
+  {
+    if (disp1.Get() != disp2.Get())
+    {
+      ++differences;
+    }
+  }
+
+  std::cout << differences << " different disparities" << std::endl;
+  return differences == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,91 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbSemiGlobalMatchingImageFilter.h"
+#include "otbImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <cstdlib>
+
+int otbSemiGlobalMatchingImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<float>                                                             ImageType;
+  typedef otb::Image<unsigned char>                                                     MaskType;
+  typedef otb::SemiGlobalMatchingImageFilter<ImageType, ImageType, ImageType, MaskType> FilterType;
+
+  // The right image is the left one shifted by 3 pixels
+  const int             shift = 3;
+  ImageType::RegionType region;
+  ImageType::SizeType   size = {{120, 90}};
+  region.SetSize(size);
+
+  ImageType::Pointer left  = ImageType::New();
+  ImageType::Pointer right = ImageType::New();
+  left->SetRegions(region);
+  left->Allocate();
+  right->SetRegions(region);
+  right->Allocate();
+
+  std::srand(0);
+  itk::ImageRegionIteratorWithIndex<ImageType> leftIt(left, region);
+  for (leftIt.GoToBegin(); !leftIt.IsAtEnd(); ++leftIt)
+  {
+    leftIt.Set(std::rand() % 256);
+  }
+  itk::ImageRegionIteratorWithIndex<ImageType> rightIt(right, region);
+  for (rightIt.GoToBegin(); !rightIt.IsAtEnd(); ++rightIt)
+  {
+    ImageType::IndexType index = rightIt.GetIndex();
+    index[0] -= shift;
+    rightIt.Set(region.IsInside(index) ? left->GetPixel(index) : std::rand() % 256);
+  }
+
+  // Small tiles, so that the output goes through several of them
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetLeftInput(left);
+  filter->SetRightInput(right);
+  filter->SetRadius(2);
+  filter->SetMinimumHorizontalDisparity(-8);
+  filter->SetMaximumHorizontalDisparity(8);
+  filter->SetTileSize(40);
+  filter->SetTileOverlap(16);
+  filter->Update();
+
+  // Pixels matched inside the right image should have the right disparity
+  unsigned int nbPixels = 0;
+  unsigned int nbGood   = 0;
+
+  itk::ImageRegionIteratorWithIndex<ImageType> dispIt(filter->GetHorizontalDisparityOutput(), region);
+  itk::ImageRegionIteratorWithIndex<MaskType>  maskIt(filter->GetOutputMask(), region);
+  for (dispIt.GoToBegin(), maskIt.GoToBegin(); !dispIt.IsAtEnd(); ++dispIt, ++maskIt)
+  {
+    if (dispIt.GetIndex()[0] + shift >= static_cast<int>(size[0]))
+    {
+      continue;
+    }
+    ++nbPixels;
+    if (maskIt.Get() > 0 && std::abs(dispIt.Get() - shift) < 0.5)
+    {
+      ++nbGood;
+    }
+  }
+
+  std::cout << nbGood << " pixels out of " << nbPixels << " have the expected disparity" << std::endl;
+  return nbGood >= 0.95 * nbPixels ? EXIT_SUCCESS : EXIT_FAILURE;
+}
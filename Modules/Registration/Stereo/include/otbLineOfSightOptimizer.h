@@ -71,6 +71,11 @@ public:
    *  ending points are stored in 'pointB' (however, the computation is symmetrical)*/
   PointType Compute(PointSetPointerType pointA, PointSetPointerType pointB);
 
+  /** Solve the normal equations of a least-square intersection in closed form.
+   *  The symmetric matrix is packed as (xx, xy, xz, yy, yz, zz). Returns false
+   *  (and a null solution) if the matrix is singular. */
+  static bool SolveNormalEquations(const PrecisionType* matrix, const PrecisionType* second, PrecisionType* solution);
+
   /** Get the residues from last computation */
   // itkGetMacro(Residues,ResidueType);
   ResidueType GetResidues()
@@ -98,11 +103,6 @@ private:
 
   /** global residu from last computation */
   PrecisionType m_GlobalResidue;
-
-  /** Internal matrices for computation */
-  vnl_matrix<PrecisionType> m_InvCumul;
-  vnl_matrix<PrecisionType> m_Identity;
-  vnl_vector<PrecisionType> m_SecCumul;
 };
 } // end namespace otb
 
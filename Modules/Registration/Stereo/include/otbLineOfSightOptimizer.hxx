@@ -23,7 +23,8 @@
 
 #include "otbLineOfSightOptimizer.h"
 
-#include "vnl/vnl_inverse.h"
+#include <algorithm>
+#include <cmath>
 
 namespace otb
 {
@@ -34,14 +35,33 @@ LineOfSightOptimizer<TPrecision, TLabel>::LineOfSightOptimizer()
   m_Residues.clear();
 
   m_GlobalResidue = 0;
+}
 
-  m_InvCumul = vnl_matrix<PrecisionType>(3, 3);
-
-  m_Identity = vnl_matrix<PrecisionType>(3, 3);
-  m_Identity.fill(0);
-  m_Identity.fill_diagonal(1.);
+template <class TPrecision, class TLabel>
+bool LineOfSightOptimizer<TPrecision, TLabel>::SolveNormalEquations(const PrecisionType* matrix, const PrecisionType* second, PrecisionType* solution)
+{
+  // Cofactors of the symmetric matrix
+  const PrecisionType c00 = matrix[3] * matrix[5] - matrix[4] * matrix[4];
+  const PrecisionType c01 = matrix[2] * matrix[4] - matrix[1] * matrix[5];
+  const PrecisionType c02 = matrix[1] * matrix[4] - matrix[2] * matrix[3];
+  const PrecisionType c11 = matrix[0] * matrix[5] - matrix[2] * matrix[2];
+  const PrecisionType c12 = matrix[1] * matrix[2] - matrix[0] * matrix[4];
+  const PrecisionType c22 = matrix[0] * matrix[3] - matrix[1] * matrix[1];
+
+  const PrecisionType det = matrix[0] * c00 + matrix[1] * c01 + matrix[2] * c02;
+  if (det == 0)
+  {
+    solution[0] = 0;
+    solution[1] = 0;
+    solution[2] = 0;
+    return false;
+  }
 
-  m_SecCumul = vnl_vector<PrecisionType>(3);
+  const PrecisionType detInv = 1. / det;
+  solution[0]                = (c00 * second[0] + c01 * second[1] + c02 * second[2]) * detInv;
+  solution[1]                = (c01 * second[0] + c11 * second[1] + c12 * second[2]) * detInv;
+  solution[2]                = (c02 * second[0] + c12 * second[1] + c22 * second[2]) * detInv;
+  return true;
 }
 
 template <class TPrecision, class TLabel>
@@ -49,14 +69,10 @@ typename LineOfSightOptimizer<TPrecision, TLabel>::PointType LineOfSightOptimize
                                                                                                                PointSetPointerType pointB)
 {
   // First, empty the cumulators and residues
-  m_InvCumul.fill(0);
-  m_SecCumul.fill(0);
+  PrecisionType invCumul[6] = {0, 0, 0, 0, 0, 0};
+  PrecisionType secCumul[3] = {0, 0, 0};
   m_Residues.clear();
 
-  vnl_matrix<PrecisionType> idMinusViViT(3, 3);
-  vnl_matrix<PrecisionType> vi(3, 1);
-  vnl_vector<PrecisionType> si(3);
-
   PointType result;
 
   // check inputs
@@ -72,30 +88,38 @@ typename LineOfSightOptimizer<TPrecision, TLabel>::PointType LineOfSightOptimize
 
   while (itPointA != pointA->GetPoints()->End() && itPointB != pointB->GetPoints()->End())
   {
-    vi(0, 0) = itPointB.Value()[0] - itPointA.Value()[0];
-    vi(1, 0) = itPointB.Value()[1] - itPointA.Value()[1];
-    vi(2, 0) = itPointB.Value()[2] - itPointA.Value()[2];
+    const PointType& si = itPointA.Value();
 
-    PrecisionType norm_inv = 1. / std::sqrt(vi(0, 0) * vi(0, 0) + vi(1, 0) * vi(1, 0) + vi(2, 0) * vi(2, 0));
+    PrecisionType vi[3];
+    vi[0] = itPointB.Value()[0] - si[0];
+    vi[1] = itPointB.Value()[1] - si[1];
+    vi[2] = itPointB.Value()[2] - si[2];
 
-    vi(0, 0) *= norm_inv;
-    vi(1, 0) *= norm_inv;
-    vi(2, 0) *= norm_inv;
+    PrecisionType norm_inv = 1. / std::sqrt(vi[0] * vi[0] + vi[1] * vi[1] + vi[2] * vi[2]);
 
-    si(0) = itPointA.Value()[0];
-    si(1) = itPointA.Value()[1];
-    si(2) = itPointA.Value()[2];
+    vi[0] *= norm_inv;
+    vi[1] *= norm_inv;
+    vi[2] *= norm_inv;
 
-    idMinusViViT = m_Identity - (vi * vi.transpose());
+    // Accumulate (Id - vi.vi^T) and (Id - vi.vi^T).si
+    invCumul[0] += 1. - vi[0] * vi[0];
+    invCumul[1] -= vi[0] * vi[1];
+    invCumul[2] -= vi[0] * vi[2];
+    invCumul[3] += 1. - vi[1] * vi[1];
+    invCumul[4] -= vi[1] * vi[2];
+    invCumul[5] += 1. - vi[2] * vi[2];
 
-    m_InvCumul += idMinusViViT;
-    m_SecCumul += (idMinusViViT * si);
+    const PrecisionType viDotSi = vi[0] * si[0] + vi[1] * si[1] + vi[2] * si[2];
+    secCumul[0] += si[0] - vi[0] * viDotSi;
+    secCumul[1] += si[1] - vi[1] * viDotSi;
+    secCumul[2] += si[2] - vi[2] * viDotSi;
 
     ++itPointA;
     ++itPointB;
   }
 
-  vnl_vector<PrecisionType> intersection = vnl_inverse(m_InvCumul) * m_SecCumul;
+  PrecisionType intersection[3];
+  SolveNormalEquations(invCumul, secCumul, intersection);
 
   result[0] = intersection[0];
   result[1] = intersection[1];
@@ -104,22 +128,22 @@ typename LineOfSightOptimizer<TPrecision, TLabel>::PointType LineOfSightOptimize
   // Compute residues
   m_GlobalResidue = 0;
 
-  vnl_vector<PrecisionType> AB(3);
-  vnl_vector<PrecisionType> AC(3);
-  PrecisionType             res2;
   itPointA = pointA->GetPoints()->Begin();
   itPointB = pointB->GetPoints()->Begin();
   while (itPointA != pointA->GetPoints()->End() && itPointB != pointB->GetPoints()->End())
   {
-    AB[0] = itPointB.Value()[0] - itPointA.Value()[0];
-    AB[1] = itPointB.Value()[1] - itPointA.Value()[1];
-    AB[2] = itPointB.Value()[2] - itPointA.Value()[2];
-
-    AC[0] = intersection[0] - itPointA.Value()[0];
-    AC[1] = intersection[1] - itPointA.Value()[1];
-    AC[2] = intersection[2] - itPointA.Value()[2];
-
-    res2 = std::max(0.0, dot_product(AC, AC) - (dot_product(AB, AC) * dot_product(AB, AC)) / (dot_product(AB, AB)));
+    PrecisionType AB[3];
+    PrecisionType AC[3];
+    for (unsigned int i = 0; i < 3; ++i)
+    {
+      AB[i] = itPointB.Value()[i] - itPointA.Value()[i];
+      AC[i] = intersection[i] - itPointA.Value()[i];
+    }
+
+    const PrecisionType ABAC = AB[0] * AC[0] + AB[1] * AC[1] + AB[2] * AC[2];
+    const PrecisionType ACAC = AC[0] * AC[0] + AC[1] * AC[1] + AC[2] * AC[2];
+    const PrecisionType ABAB = AB[0] * AB[0] + AB[1] * AB[1] + AB[2] * AB[2];
+    PrecisionType       res2 = std::max(static_cast<PrecisionType>(0.0), ACAC - (ABAC * ABAC) / ABAB);
 
     m_Residues.push_back(std::sqrt(res2));
     m_GlobalResidue += res2;
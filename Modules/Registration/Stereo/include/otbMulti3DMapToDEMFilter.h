@@ -29,7 +29,10 @@
 #include "otbImage.h"
 #include "itkImageRegionSplitter.h"
 #include "otbObjectList.h"
+#include "otbRAMDrivenAdaptativeStreamingManager.h"
 #include <string>
+#include <atomic>
+#include <memory>
 
 namespace otb
 {
@@ -70,6 +73,12 @@ enum CellFusionMode
  *  Origin, Spacing, Size, StartIndex, ProjectionRef
  *  thus DEMGridStep parameter is ignored in this case (replaced by Spacing)
  *
+ *  With ScatterStreaming on, the input requested regions are no longer derived from each output
+ *  region: every 3D map is streamed once over its largest region, its points being scattered into
+ *  per-cell accumulators covering the whole DEM, and output regions are then read from these
+ *  accumulators. Each input is computed only once, at the cost of keeping the accumulators of the
+ *  whole DEM in memory.
+ *
  *  \sa FineRegistrationImageFilter
  *  \sa MultiDisparityMapTo3DFilter
  *
@@ -138,6 +147,8 @@ public:
   typedef itk::ImageRegionSplitter<2>   SplitterType;
   typedef otb::ObjectList<SplitterType> SplitterListType;
 
+  typedef RAMDrivenAdaptativeStreamingManager<InputMapType> StreamingManagerType;
+
   /** Set the number of 3D images (referred earlier as N) */
   void SetNumberOf3DMaps(unsigned int nb);
 
@@ -220,6 +231,11 @@ public:
   itkSetMacro(Margin, SizeType);
   itkGetConstReferenceMacro(Margin, SizeType);
 
+  /** Stream each 3D map once and scatter its points into accumulators of the whole DEM */
+  itkSetMacro(ScatterStreaming, bool);
+  itkGetConstReferenceMacro(ScatterStreaming, bool);
+  itkBooleanMacro(ScatterStreaming);
+
 
 protected:
   /** Constructor */
@@ -256,6 +272,27 @@ protected:
 private:
   void SetOutputParametersFromImage();
 
+  /** Stream every 3D map over its largest region and scatter its points into the DEM accumulators */
+  void ScatterInputs();
+
+  /** Scatter the points of a region of 3D map 'k' (already buffered) into the DEM accumulators, with all threads */
+  void ScatterRegion(unsigned int k, const typename InputMapType::RegionType& region);
+
+  /** Scatter the points of the split of a region of 3D map 'k' processed by one thread */
+  void ScatterSplit(unsigned int k, const typename InputMapType::RegionType& split);
+
+  /** Static function used as a "callback" by the MultiThreader to scatter a split of a 3D map region */
+  static ITK_THREAD_RETURN_TYPE ScatterThreaderCallback(void* arg);
+
+  /** Internal structure used for passing the region to scatter to the threading library */
+  struct ScatterThreadStruct
+  {
+    Pointer                           Filter;
+    unsigned int                      MapIndex;
+    typename InputMapType::RegionType Region;
+    unsigned int                      NumberOfSplits;
+  };
+
   Multi3DMapToDEMFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
@@ -308,6 +345,14 @@ private:
 
   /** internal transform between WGS84 and user's ProjRef */
   RSTransform2DType::Pointer m_GroundTransform;
+
+  bool m_ScatterStreaming;
+
+  /** Per-cell accumulators of the whole DEM, used in scatter streaming mode */
+  std::unique_ptr<std::atomic<DEMPixelType>[]>         m_ScatterValues;
+  std::unique_ptr<std::atomic<AccumulatorPixelType>[]> m_ScatterCounts;
+  RegionType                                           m_ScatterRegion;
+  itk::TimeStamp                                       m_ScatterTime;
 };
 } // end namespace otb
 
@@ -26,6 +26,8 @@
 #include "itkImageRegionIterator.h"
 #include "otbStreamingStatisticsVectorImageFilter.h"
 
+#include <algorithm>
+
 namespace otb
 {
 
@@ -49,6 +51,7 @@ Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::Multi3DMapToDEMFil
   m_CellFusionMode            = otb::CellFusionMode::MAX;
   m_OutputParametersFrom3DMap = -2;
   m_IsGeographic              = true;
+  m_ScatterStreaming          = false;
 
   m_Margin[0] = 10;
   m_Margin[1] = 10;
@@ -337,6 +340,33 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::GenerateOutpu
 template <class T3DImage, class TMaskImage, class TOutputDEMImage>
 void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::GenerateInputRequestedRegion()
 {
+  if (m_ScatterStreaming)
+  {
+    // The 3D maps are streamed by the filter itself (see ScatterInputs())
+    for (unsigned int k = 0; k < this->GetNumberOf3DMaps(); ++k)
+    {
+      T3DImage*  imgPtr  = const_cast<T3DImage*>(this->Get3DMapInput(k));
+      RegionType largest = imgPtr->GetLargestPossibleRegion();
+
+      RegionType emptyRegion;
+      emptyRegion.SetIndex(largest.GetIndex());
+      emptyRegion.SetSize(0, 0);
+      emptyRegion.SetSize(1, 0);
+      imgPtr->SetRequestedRegion(emptyRegion);
+
+      TMaskImage* mskPtr = const_cast<TMaskImage*>(this->GetMaskInput(k));
+      if (mskPtr)
+      {
+        if (mskPtr->GetLargestPossibleRegion() != largest)
+        {
+          itkExceptionMacro(<< "mask and map at position " << k << " have a different largest region");
+        }
+        mskPtr->SetRequestedRegion(emptyRegion);
+      }
+    }
+    return;
+  }
+
   const TOutputDEMImage* outputDEM = this->GetDEMOutput();
 
   typename TOutputDEMImage::RegionType  outRegion  = outputDEM->GetRequestedRegion();
@@ -468,6 +498,34 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::BeforeThreade
 {
   const TOutputDEMImage* outputDEM = this->GetDEMOutput();
 
+  if (!this->m_IsGeographic)
+  {
+    m_GroundTransform = RSTransform2DType::New();
+    m_GroundTransform->SetInputProjectionRef(static_cast<std::string>(otb::SpatialReference::FromWGS84().ToWkt()));
+    m_GroundTransform->SetOutputProjectionRef(m_ProjectionRef);
+    m_GroundTransform->InstantiateTransform();
+  }
+
+  if (m_ScatterStreaming)
+  {
+    // Scatter the 3D maps again only if the pipeline changed since the last pass
+    itk::ModifiedTimeType pipelineTime = this->GetMTime();
+    for (unsigned int k = 0; k < this->GetNumberOf3DMaps(); ++k)
+    {
+      pipelineTime = std::max(pipelineTime, this->Get3DMapInput(k)->GetPipelineMTime());
+      if (this->GetMaskInput(k))
+      {
+        pipelineTime = std::max(pipelineTime, this->GetMaskInput(k)->GetPipelineMTime());
+      }
+    }
+
+    if (!m_ScatterValues || m_ScatterTime.GetMTime() < pipelineTime || m_ScatterRegion != outputDEM->GetLargestPossibleRegion())
+    {
+      this->ScatterInputs();
+    }
+    return;
+  }
+
   // create splits
   // for each map we check if the input region can be split into threadNb
   m_NumberOfSplit.resize(this->GetNumberOf3DMaps());
@@ -517,19 +575,18 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::BeforeThreade
     m_TempDEMAccumulatorRegions.push_back(tmpImg2);
   }
 
-  if (!this->m_IsGeographic)
-  {
-    m_GroundTransform = RSTransform2DType::New();
-    m_GroundTransform->SetInputProjectionRef(static_cast<std::string>(otb::SpatialReference::FromWGS84().ToWkt()));
-    m_GroundTransform->SetOutputProjectionRef(m_ProjectionRef);
-    m_GroundTransform->InstantiateTransform();
-  }
 }
 
 template <class T3DImage, class TMaskImage, class TOutputDEMImage>
 void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedGenerateData(const RegionType& itkNotUsed(outputRegionForThread),
                                                                                         itk::ThreadIdType threadId)
 {
+  // Output is filled from the accumulators in AfterThreadedGenerateData()
+  if (m_ScatterStreaming)
+  {
+    return;
+  }
+
   TOutputDEMImage* outputPtr = this->GetOutput();
 
   typename OutputImageType::PointType  pointRef;
@@ -717,12 +774,221 @@ void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ThreadedGener
   }
 }
 
+template <class T3DImage, class TMaskImage, class TOutputDEMImage>
+void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ScatterInputs()
+{
+  if (m_CellFusionMode < otb::CellFusionMode::MIN || m_CellFusionMode > otb::CellFusionMode::ACC)
+  {
+    itkExceptionMacro(<< "Unexpected value cell fusion mode :" << this->m_CellFusionMode);
+  }
+
+  m_ScatterRegion = this->GetDEMOutput()->GetLargestPossibleRegion();
+
+  // Start from the neutral element of the fusion mode, so that cells can be updated in any order
+  DEMPixelType initialValue = 0;
+  if (m_CellFusionMode == otb::CellFusionMode::MIN)
+  {
+    initialValue = itk::NumericTraits<DEMPixelType>::max();
+  }
+  else if (m_CellFusionMode == otb::CellFusionMode::MAX)
+  {
+    initialValue = itk::NumericTraits<DEMPixelType>::NonpositiveMin();
+  }
+
+  const std::size_t nbCells = m_ScatterRegion.GetNumberOfPixels();
+  m_ScatterValues.reset(new std::atomic<DEMPixelType>[nbCells]);
+  m_ScatterCounts.reset(new std::atomic<AccumulatorPixelType>[nbCells]);
+  for (std::size_t cell = 0; cell < nbCells; ++cell)
+  {
+    m_ScatterValues[cell].store(initialValue, std::memory_order_relaxed);
+    m_ScatterCounts[cell].store(0, std::memory_order_relaxed);
+  }
+
+  for (unsigned int k = 0; k < this->GetNumberOf3DMaps(); ++k)
+  {
+    T3DImage*   imgPtr = const_cast<T3DImage*>(this->Get3DMapInput(k));
+    TMaskImage* mskPtr = const_cast<TMaskImage*>(this->GetMaskInput(k));
+
+    typename StreamingManagerType::Pointer streamingManager = StreamingManagerType::New();
+    streamingManager->PrepareStreaming(imgPtr, imgPtr->GetLargestPossibleRegion());
+
+    const unsigned int numberOfSplits = streamingManager->GetNumberOfSplits();
+    otbMsgDevMacro("map " << k << " will be streamed in " << numberOfSplits << " pieces");
+
+    for (unsigned int piece = 0; piece < numberOfSplits && !this->GetAbortGenerateData(); ++piece)
+    {
+      typename InputMapType::RegionType streamRegion = streamingManager->GetSplit(piece);
+
+      imgPtr->SetRequestedRegion(streamRegion);
+      imgPtr->PropagateRequestedRegion();
+      imgPtr->UpdateOutputData();
+      if (mskPtr)
+      {
+        mskPtr->SetRequestedRegion(streamRegion);
+        mskPtr->PropagateRequestedRegion();
+        mskPtr->UpdateOutputData();
+      }
+
+      this->ScatterRegion(k, streamRegion);
+    }
+  }
+
+  m_ScatterTime.Modified();
+}
+
+template <class T3DImage, class TMaskImage, class TOutputDEMImage>
+void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ScatterRegion(unsigned int k, const typename InputMapType::RegionType& region)
+{
+  typename SplitterType::Pointer splitter = SplitterType::New();
+
+  ScatterThreadStruct str;
+  str.Filter         = this;
+  str.MapIndex       = k;
+  str.Region         = region;
+  str.NumberOfSplits = splitter->GetNumberOfSplits(region, this->GetNumberOfThreads());
+
+  this->GetMultiThreader()->SetNumberOfThreads(this->GetNumberOfThreads());
+  this->GetMultiThreader()->SetSingleMethod(this->ScatterThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
+}
+
+template <class T3DImage, class TMaskImage, class TOutputDEMImage>
+ITK_THREAD_RETURN_TYPE Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ScatterThreaderCallback(void* arg)
+{
+  itk::ThreadIdType    threadId = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  ScatterThreadStruct* str      = (ScatterThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
+
+  if (threadId < str->NumberOfSplits)
+  {
+    typename SplitterType::Pointer splitter = SplitterType::New();
+    str->Filter->ScatterSplit(str->MapIndex, splitter->GetSplit(threadId, str->NumberOfSplits, str->Region));
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class T3DImage, class TMaskImage, class TOutputDEMImage>
+void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::ScatterSplit(unsigned int k, const typename InputMapType::RegionType& split)
+{
+  const TOutputDEMImage* outputPtr = this->GetDEMOutput();
+
+  itk::ImageRegionConstIterator<InputMapType>  mapIt(this->Get3DMapInput(k), split);
+  itk::ImageRegionConstIterator<MaskImageType> maskIt;
+  const bool                                   useMask = this->GetMaskInput(k) != nullptr;
+  if (useMask)
+  {
+    maskIt = itk::ImageRegionConstIterator<MaskImageType>(this->GetMaskInput(k), split);
+    maskIt.GoToBegin();
+  }
+
+  MapPixelType position;
+
+  for (mapIt.GoToBegin(); !mapIt.IsAtEnd(); ++mapIt)
+  {
+    // check mask value if any
+    if (useMask)
+    {
+      const bool valid = maskIt.Get() > 0;
+      ++maskIt;
+      if (!valid)
+      {
+        continue;
+      }
+    }
+
+    position = mapIt.Get();
+
+    if (!this->m_IsGeographic)
+    {
+      typename RSTransform2DType::InputPointType tmpPoint;
+      tmpPoint[0]                                       = position[0];
+      tmpPoint[1]                                       = position[1];
+      RSTransform2DType::OutputPointType groundPosition = m_GroundTransform->TransformPoint(tmpPoint);
+      position[0]                                       = groundPosition[0];
+      position[1]                                       = groundPosition[1];
+    }
+
+    // The DEM cell at index 'n' contains continuous indexes from 'n-0.5' to 'n+0.5'
+    typename OutputImageType::PointType point2D;
+    point2D[0] = position[0];
+    point2D[1] = position[1];
+    itk::ContinuousIndex<double, 2> continuousIndex;
+    outputPtr->TransformPhysicalPointToContinuousIndex(point2D, continuousIndex);
+    typename OutputImageType::IndexType cellIndex;
+    cellIndex[0] = static_cast<int>(std::floor(continuousIndex[0] + 0.5));
+    cellIndex[1] = static_cast<int>(std::floor(continuousIndex[1] + 0.5));
+
+    if (!m_ScatterRegion.IsInside(cellIndex))
+    {
+      continue;
+    }
+
+    const std::size_t  cell       = (cellIndex[1] - m_ScatterRegion.GetIndex(1)) * m_ScatterRegion.GetSize(0) + (cellIndex[0] - m_ScatterRegion.GetIndex(0));
+    const DEMPixelType cellHeight = static_cast<DEMPixelType>(position[2]);
+
+    m_ScatterCounts[cell].fetch_add(1, std::memory_order_relaxed);
+
+    std::atomic<DEMPixelType>& cellValue    = m_ScatterValues[cell];
+    DEMPixelType               currentValue = cellValue.load(std::memory_order_relaxed);
+    switch (this->m_CellFusionMode)
+    {
+    case otb::CellFusionMode::MIN:
+      while (cellHeight < currentValue && !cellValue.compare_exchange_weak(currentValue, cellHeight, std::memory_order_relaxed))
+      {
+      }
+      break;
+    case otb::CellFusionMode::MAX:
+      while (cellHeight > currentValue && !cellValue.compare_exchange_weak(currentValue, cellHeight, std::memory_order_relaxed))
+      {
+      }
+      break;
+    case otb::CellFusionMode::MEAN:
+      while (!cellValue.compare_exchange_weak(currentValue, currentValue + cellHeight, std::memory_order_relaxed))
+      {
+      }
+      break;
+    default:
+      break;
+    }
+  }
+}
+
 template <class T3DImage, class TMaskImage, class TOutputDEMImage>
 void Multi3DMapToDEMFilter<T3DImage, TMaskImage, TOutputDEMImage>::AfterThreadedGenerateData()
 {
 
   TOutputDEMImage* outputDEM = this->GetOutput();
 
+  if (m_ScatterStreaming)
+  {
+    itk::ImageRegionIteratorWithIndex<OutputImageType> outputDEMIt(outputDEM, outputDEM->GetRequestedRegion());
+    for (outputDEMIt.GoToBegin(); !outputDEMIt.IsAtEnd(); ++outputDEMIt)
+    {
+      const IndexType&  index = outputDEMIt.GetIndex();
+      const std::size_t cell  = (index[1] - m_ScatterRegion.GetIndex(1)) * m_ScatterRegion.GetSize(0) + (index[0] - m_ScatterRegion.GetIndex(0));
+
+      const AccumulatorPixelType accPixel = m_ScatterCounts[cell].load(std::memory_order_relaxed);
+      const DEMPixelType         value    = m_ScatterValues[cell].load(std::memory_order_relaxed);
+      if (accPixel == 0)
+      {
+        outputDEMIt.Set(m_NoDataValue);
+      }
+      else if (this->m_CellFusionMode == otb::CellFusionMode::MEAN)
+      {
+        outputDEMIt.Set(value / static_cast<DEMPixelType>(accPixel));
+      }
+      else if (this->m_CellFusionMode == otb::CellFusionMode::ACC)
+      {
+        outputDEMIt.Set(static_cast<DEMPixelType>(accPixel));
+      }
+      else
+      {
+        outputDEMIt.Set(value);
+      }
+    }
+    return;
+  }
+
   // check is that case can occur
   if (m_TempDEMRegions.size() < 1)
   {
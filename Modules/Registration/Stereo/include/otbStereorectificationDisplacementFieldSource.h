@@ -26,6 +26,7 @@
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkVector.h"
 #include "otbMacro.h"
+#include <vector>
 
 namespace otb
 {
@@ -60,6 +61,11 @@ namespace otb
  *  build a resampling grid by propagating along these locally
  *  estimated lines.
  *
+ *  The start of each grid row is first propagated from the previous
+ *  one. Rows are then walked in parallel, each thread advancing its
+ *  block of rows together so that the sensor models and the DEM are
+ *  queried in batches.
+ *
  *  Epipolar images will have a null origin and a size as given by the
  *  GetRectifiedImageSize() method. The deformation fields and size
  *  are derived to produce epipolar images covering the whole extent
@@ -113,6 +119,10 @@ public:
   typedef otb::GenericRSTransform<double, 3, 3> RSTransformType;
   typedef typename RSTransformType::Pointer RSTransformPointerType;
 
+  // 2D RS transform (left image to ground)
+  typedef otb::GenericRSTransform<double, 2, 2> RSTransform2DType;
+  typedef typename RSTransform2DType::Pointer   RSTransform2DPointerType;
+
   // 3D points
   typedef typename RSTransformType::InputPointType TDPointType;
 
@@ -185,6 +195,28 @@ private:
                                                            // implemented
   void operator=(const Self&) = delete;
 
+  /** Walk along the epipolar lines of the grid rows [firstRow, firstRow + numberOfRows), all rows
+   *  advancing together so that each step transforms them in one batch. Returns the sum of the
+   *  local baseline ratios. */
+  double GenerateRows(const std::vector<TDPointType>& rowStarts, unsigned int firstRow, unsigned int numberOfRows, itk::ThreadIdType threadId);
+
+  /** Set the elevation of left image points from the DEM, or to the default elevation */
+  void ComputeLocalElevations(TDPointType* points, std::size_t n) const;
+
+  /** Angle of the local epipolar line going from startLine to endLine, in left image physical space */
+  static double ComputeEpipolarAngle(const TDPointType& startLine, const TDPointType& endLine);
+
+  /** Static function used as a "callback" by the MultiThreader to compute a block of grid rows */
+  static ITK_THREAD_RETURN_TYPE RowsThreaderCallback(void* arg);
+
+  /** Internal structure used for passing the row starts to the threading library */
+  struct RowsThreadStruct
+  {
+    Pointer                  Filter;
+    std::vector<TDPointType> RowStarts;
+    std::vector<double>      BaselineRatioSums;
+  };
+
   /** This elevation offset is used to compute the epipolar direction */
   double m_ElevationOffset;
 
@@ -209,6 +241,9 @@ private:
   /** Right to left transform */
   RSTransformPointerType m_RightToLeftTransform;
 
+  /** Left image to ground transform, used to look up the DEM */
+  RSTransform2DPointerType m_LeftToGroundTransform;
+
   /** Size of the rectified images */
   SizeType m_RectifiedImageSize;
 
@@ -24,6 +24,7 @@
 #include "otbStereorectificationDisplacementFieldSource.h"
 #include "itkProgressReporter.h"
 #include "otbMath.h"
+#include <algorithm>
 
 // For partial specialization
 #include "otbVectorImage.h"
@@ -294,220 +295,209 @@ void StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::Gene
   // Allocate the output
   this->AllocateOutputs();
 
-  // Setup the DEM handler if needed
-  auto & demHandler = DEMHandler::GetInstance();
-
   // Set-up a transform to use the DEMHandler
-  typedef otb::GenericRSTransform<> RSTransform2DType;
-  RSTransform2DType::Pointer        leftToGroundTransform = RSTransform2DType::New();
+  m_LeftToGroundTransform = RSTransform2DType::New();
+  m_LeftToGroundTransform->SetInputImageMetadata(&(m_LeftImage->GetImageMetadata()));
+  m_LeftToGroundTransform->InstantiateTransform();
 
-  leftToGroundTransform->SetInputImageMetadata(&(m_LeftImage->GetImageMetadata()));
-
-  leftToGroundTransform->InstantiateTransform();
-
-  // Retrieve the output pointers
-  OutputImageType* leftDFPtr  = this->GetLeftDisplacementFieldOutput();
-  OutputImageType* rightDFPtr = this->GetRightDisplacementFieldOutput();
-
-  // Declare all the TDPoint variables we will need
-  TDPointType currentPoint1, currentPoint2, nextLineStart1, nextLineStart2, startLine1, endLine1, startLine2, endLine2, epiPoint1, epiPoint2;
-
-  // Then, we retrieve the origin of the left input image
-  double localElevation = demHandler.GetDefaultHeightAboveEllipsoid();
+  const OutputImageType* leftDFPtr    = this->GetLeftDisplacementFieldOutput();
+  const unsigned int     numberOfRows = leftDFPtr->GetLargestPossibleRegion().GetSize()[1];
 
   // Use the mean spacing as before
-  double mean_spacing = 0.5 * (std::abs(m_LeftImage->GetSignedSpacing()[0]) + std::abs(m_LeftImage->GetSignedSpacing()[1]));
-
-  // Initialize
-  currentPoint1 = m_OutputOriginInLeftImage;
-  if (m_UseDEM)
+  const double mean_spacing = 0.5 * (std::abs(m_LeftImage->GetSignedSpacing()[0]) + std::abs(m_LeftImage->GetSignedSpacing()[1]));
+  const double step         = m_Scale * m_GridStep * mean_spacing;
+
+  // Each row start is derived from the epipolar direction at the previous row start, so this
+  // chain is walked first. Rows are then independent.
+  RowsThreadStruct str;
+  str.Filter = this;
+  str.RowStarts.resize(numberOfRows);
+  str.RowStarts[0] = m_OutputOriginInLeftImage;
+  ComputeLocalElevations(&str.RowStarts[0], 1);
+
+  for (unsigned int row = 0; row + 1 < numberOfRows; ++row)
   {
-    RSTransform2DType::InputPointType tmpPoint;
-    tmpPoint[0]    = currentPoint1[0];
-    tmpPoint[1]    = currentPoint1[1];
-    localElevation = demHandler.GetHeightAboveEllipsoid(leftToGroundTransform->TransformPoint(tmpPoint));
+    const TDPointType& rowStart = str.RowStarts[row];
+    TDPointType        epiPoint = m_LeftToRightTransform->TransformPoint(rowStart);
+
+    epiPoint[2]                 = rowStart[2] - m_ElevationOffset;
+    const TDPointType startLine = m_RightToLeftTransform->TransformPoint(epiPoint);
+    epiPoint[2]                 = rowStart[2] + m_ElevationOffset;
+    const TDPointType endLine   = m_RightToLeftTransform->TransformPoint(epiPoint);
+
+    // We want to move 1 grid step away in the direction orthogonal to the epipolar line
+    const double alpha   = ComputeEpipolarAngle(startLine, endLine);
+    TDPointType& nextRow = str.RowStarts[row + 1];
+    nextRow[0]           = rowStart[0] - step * std::sin(alpha);
+    nextRow[1]           = rowStart[1] + step * std::cos(alpha);
+    ComputeLocalElevations(&nextRow, 1);
   }
-  currentPoint1[2] = localElevation;
-  currentPoint2    = m_LeftToRightTransform->TransformPoint(currentPoint1);
-  currentPoint2[2] = currentPoint1[2];
-
-  // These are the points were the next stereo-rectified image line starts
-  nextLineStart1 = currentPoint1;
-  nextLineStart2 = currentPoint2;
-
-  // We define the iterators we will use
-  typedef itk::ImageRegionIteratorWithIndex<OutputImageType> IteratorType;
 
-  IteratorType it1(leftDFPtr, leftDFPtr->GetLargestPossibleRegion());
-  IteratorType it2(rightDFPtr, rightDFPtr->GetLargestPossibleRegion());
+  const unsigned int numberOfThreads = std::max(1u, std::min(static_cast<unsigned int>(this->GetNumberOfThreads()), numberOfRows));
+  str.BaselineRatioSums.assign(numberOfThreads, 0.);
 
-  it1.GoToBegin();
-  it2.GoToBegin();
+  this->GetMultiThreader()->SetNumberOfThreads(numberOfThreads);
+  this->GetMultiThreader()->SetSingleMethod(this->RowsThreaderCallback, &str);
+  this->GetMultiThreader()->SingleMethodExecute();
 
-  // Reset the mean baseline ratio
+  // Compute the mean baseline ratio
   m_MeanBaselineRatio = 0;
-
-  // Set-up progress reporting
-  itk::ProgressReporter progress(this, 0, leftDFPtr->GetLargestPossibleRegion().GetNumberOfPixels());
-
-
-  // We loop on the deformation fields
-  while (!it1.IsAtEnd() && !it2.IsAtEnd())
+  for (double sum : str.BaselineRatioSums)
   {
-    // 1 - We start by handling the special case where we are at beginning
-    // of a new line
-    if (it1.GetIndex()[0] == 0 || it2.GetIndex()[0] == 0)
-    {
-      // In which case we reset the current points
-      currentPoint1 = nextLineStart1;
-      currentPoint2 = nextLineStart2;
-    }
+    m_MeanBaselineRatio += sum;
+  }
+  m_MeanBaselineRatio /= leftDFPtr->GetBufferedRegion().GetNumberOfPixels();
+}
 
-    // 2 - Next, we will fill the deformation fields
-    typename OutputImageType::PixelType dFValue1 = it1.Get();
-    typename OutputImageType::PixelType dFValue2 = it2.Get();
+template <class TInputImage, class TOutputImage>
+ITK_THREAD_RETURN_TYPE StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::RowsThreaderCallback(void* arg)
+{
+  itk::ThreadIdType threadId = ((itk::MultiThreader::ThreadInfoStruct*)(arg))->ThreadID;
+  RowsThreadStruct* str      = (RowsThreadStruct*)(((itk::MultiThreader::ThreadInfoStruct*)(arg))->UserData);
 
-    // We must cast iterators position to physical space
-    PointType currentDFPoint1, currentDFPoint2;
-    leftDFPtr->TransformIndexToPhysicalPoint(it1.GetIndex(), currentDFPoint1);
-    rightDFPtr->TransformIndexToPhysicalPoint(it2.GetIndex(), currentDFPoint2);
+  // Rows are split in contiguous blocks, one per thread
+  const unsigned int numberOfThreads = str->BaselineRatioSums.size();
+  if (threadId < numberOfThreads)
+  {
+    const unsigned int numberOfRows  = str->RowStarts.size();
+    const unsigned int firstRow      = threadId * numberOfRows / numberOfThreads;
+    const unsigned int endRow        = (threadId + 1) * numberOfRows / numberOfThreads;
+    str->BaselineRatioSums[threadId] = str->Filter->GenerateRows(str->RowStarts, firstRow, endRow - firstRow, threadId);
+  }
 
-    // Now we can compute the shifts
-    dFValue1[0] = currentPoint1[0] - currentDFPoint1[0];
-    dFValue1[1] = currentPoint1[1] - currentDFPoint1[1];
-    dFValue2[0] = currentPoint2[0] - currentDFPoint2[0];
-    dFValue2[1] = currentPoint2[1] - currentDFPoint2[1];
+  return ITK_THREAD_RETURN_VALUE;
+}
 
-    // And set the values
-    it1.Set(dFValue1);
-    it2.Set(dFValue2);
+template <class TInputImage, class TOutputImage>
+double StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::GenerateRows(const std::vector<TDPointType>& rowStarts, unsigned int firstRow,
+                                                                                           unsigned int numberOfRows, itk::ThreadIdType threadId)
+{
+  OutputImageType* leftDFPtr  = this->GetLeftDisplacementFieldOutput();
+  OutputImageType* rightDFPtr = this->GetRightDisplacementFieldOutput();
 
-    // 3 - Next, we will compute epipolar lines direction in both
-    // images
-    double a1;
+  const unsigned int numberOfColumns = leftDFPtr->GetLargestPossibleRegion().GetSize()[0];
 
-    // First, for image 1
+  const double mean_spacing = 0.5 * (std::abs(m_LeftImage->GetSignedSpacing()[0]) + std::abs(m_LeftImage->GetSignedSpacing()[1]));
+  const double step         = m_Scale * m_GridStep * mean_spacing;
 
-    // This point is the image of the left input image origin at the
-    // average elevation
-    epiPoint2 = m_LeftToRightTransform->TransformPoint(currentPoint1);
+  // Current positions in left and right images of every row of the block
+  std::vector<TDPointType> currentPoints1(rowStarts.begin() + firstRow, rowStarts.begin() + firstRow + numberOfRows);
+  std::vector<TDPointType> currentPoints2(numberOfRows), epiPoints(numberOfRows), startLines(numberOfRows), endLines(numberOfRows);
 
-    // The beginning of the epipolar line in the left image is the image
-    // of epiPoint2 at a lower elevation (using the offset)
-    epiPoint2[2] = localElevation - m_ElevationOffset;
-    startLine1   = m_RightToLeftTransform->TransformPoint(epiPoint2);
+  typename OutputImageType::PixelType dFValue1(2), dFValue2(2);
+  typename OutputImageType::IndexType index;
+  PointType                           currentDFPoint;
 
-    // The endning of the epipolar line in the left image is the image
-    // of epiPoint2 at a higher elevation (using the offset)
-    epiPoint2[2] = localElevation + m_ElevationOffset;
-    endLine1     = m_RightToLeftTransform->TransformPoint(epiPoint2);
+  itk::ProgressReporter progress(this, threadId, numberOfRows * numberOfColumns);
 
-    // Estimate the local baseline ratio
-    double localBaselineRatio =
-        std::sqrt((endLine1[0] - startLine1[0]) * (endLine1[0] - startLine1[0]) + (endLine1[1] - startLine1[1]) * (endLine1[1] - startLine1[1])) /
-        (2 * m_ElevationOffset);
+  double baselineRatioSum = 0;
 
-    m_MeanBaselineRatio += localBaselineRatio;
+  for (unsigned int column = 0; column < numberOfColumns; ++column)
+  {
+    // The position in the right image is also the image of the left
+    // point at its elevation, used to estimate the epipolar line
+    otb::TransformPoints(m_LeftToRightTransform.GetPointer(), currentPoints1.data(), currentPoints2.data(), numberOfRows);
 
-    // Now, we can compute the equation of the epipolar line y = a*x+b
-    // (compute angle in physical space)
-    double alpha1 = 0;
-    if (endLine1[0] == startLine1[0])
+    // The epipolar line in the left image goes from the image of
+    // currentPoint2 at a lower elevation to its image at a higher one
+    for (unsigned int i = 0; i < numberOfRows; ++i)
     {
-      if (endLine1[1] > startLine1[1])
-      {
-        alpha1 = 0.5 * otb::CONST_PI;
-      }
-      else
-      {
-        alpha1 = -0.5 * otb::CONST_PI;
-      }
+      epiPoints[i]    = currentPoints2[i];
+      epiPoints[i][2] = currentPoints1[i][2] - m_ElevationOffset;
     }
-    else
+    otb::TransformPoints(m_RightToLeftTransform.GetPointer(), epiPoints.data(), startLines.data(), numberOfRows);
+    for (unsigned int i = 0; i < numberOfRows; ++i)
     {
-      a1 = (endLine1[1] - startLine1[1]) / (endLine1[0] - startLine1[0]);
-      if (endLine1[0] > startLine1[0])
-      {
-        alpha1 = std::atan(a1);
-      }
-      else
-      {
-        alpha1 = otb::CONST_PI + std::atan(a1);
-      }
+      epiPoints[i][2] = currentPoints1[i][2] + m_ElevationOffset;
     }
+    otb::TransformPoints(m_RightToLeftTransform.GetPointer(), epiPoints.data(), endLines.data(), numberOfRows);
 
-    // We do the same for image 2
-    currentPoint2[2] = localElevation;
-    epiPoint1        = m_RightToLeftTransform->TransformPoint(currentPoint2);
-
-    epiPoint1[2] = localElevation - m_ElevationOffset;
-    startLine2   = m_LeftToRightTransform->TransformPoint(epiPoint1);
+    index[0] = column;
+    for (unsigned int i = 0; i < numberOfRows; ++i)
+    {
+      // Fill the deformation fields with the shifts from the grid
+      // position in physical space
+      index[1] = firstRow + i;
+      leftDFPtr->TransformIndexToPhysicalPoint(index, currentDFPoint);
+      dFValue1[0] = currentPoints1[i][0] - currentDFPoint[0];
+      dFValue1[1] = currentPoints1[i][1] - currentDFPoint[1];
+      leftDFPtr->SetPixel(index, dFValue1);
+
+      rightDFPtr->TransformIndexToPhysicalPoint(index, currentDFPoint);
+      dFValue2[0] = currentPoints2[i][0] - currentDFPoint[0];
+      dFValue2[1] = currentPoints2[i][1] - currentDFPoint[1];
+      rightDFPtr->SetPixel(index, dFValue2);
+
+      // Estimate the local baseline ratio
+      const double dx = endLines[i][0] - startLines[i][0];
+      const double dy = endLines[i][1] - startLines[i][1];
+      baselineRatioSum += std::sqrt(dx * dx + dy * dy) / (2 * m_ElevationOffset);
+
+      // We want to move one grid step away along the epipolar line
+      const double alpha = ComputeEpipolarAngle(startLines[i], endLines[i]);
+      currentPoints1[i][0] += step * std::cos(alpha);
+      currentPoints1[i][1] += step * std::sin(alpha);
+
+      progress.CompletedPixel();
+    }
 
-    epiPoint1[2] = localElevation + m_ElevationOffset;
-    endLine2     = m_LeftToRightTransform->TransformPoint(epiPoint1);
+    if (column + 1 < numberOfColumns)
+    {
+      ComputeLocalElevations(currentPoints1.data(), numberOfRows);
+    }
+  }
 
-    // 4 - Determine position of next points
+  return baselineRatioSum;
+}
 
-    // We want to move m_Scale pixels away in the epipolar line of the
-    // first image
-    // Take into account height direction
-    // double alpha1 = otb::CONST_PI - std::atan(a1);
-    double deltax1 = m_Scale * m_GridStep * mean_spacing * std::cos(alpha1);
-    double deltay1 = m_Scale * m_GridStep * mean_spacing * std::sin(alpha1);
+template <class TInputImage, class TOutputImage>
+void StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::ComputeLocalElevations(TDPointType* points, std::size_t n) const
+{
+  auto& demHandler = DEMHandler::GetInstance();
 
-    // Now we move currentPoint1
-    currentPoint1[0] += deltax1;
-    currentPoint1[1] += deltay1;
-    if (m_UseDEM)
+  if (!m_UseDEM)
+  {
+    const double defaultElevation = demHandler.GetDefaultHeightAboveEllipsoid();
+    for (std::size_t i = 0; i < n; ++i)
     {
-      RSTransform2DType::InputPointType tmpPoint;
-      tmpPoint[0]    = currentPoint1[0];
-      tmpPoint[1]    = currentPoint1[1];
-      localElevation = demHandler.GetHeightAboveEllipsoid(leftToGroundTransform->TransformPoint(tmpPoint));
+      points[i][2] = defaultElevation;
     }
-    currentPoint1[2] = localElevation;
+    return;
+  }
 
-    // And we compute the equivalent displacement in right image
-    currentPoint2 = m_LeftToRightTransform->TransformPoint(currentPoint1);
+  std::vector<typename RSTransform2DType::InputPointType>  imagePoints(n);
+  std::vector<typename RSTransform2DType::OutputPointType> groundPoints(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    imagePoints[i][0] = points[i][0];
+    imagePoints[i][1] = points[i][1];
+  }
+  otb::TransformPoints(m_LeftToGroundTransform.GetPointer(), imagePoints.data(), groundPoints.data(), n);
 
-    // 5 - Finally, we have to handle a special case for beginning of
-    // line, since at this position we are able to compute the
-    // position of the beginning of next line
-    if (it1.GetIndex()[0] == 0 || it2.GetIndex()[0] == 0)
-    {
-      // We want to move 1 pixel away in the direction orthogonal to
-      // epipolar line
-      double nextdeltax1 = -m_Scale * mean_spacing * m_GridStep * std::sin(alpha1);
-      double nextdeltay1 = m_Scale * mean_spacing * m_GridStep * std::cos(alpha1);
-
-      // We can then update nextLineStart1
-      nextLineStart1[0] = currentPoint1[0] - deltax1 + nextdeltax1;
-      nextLineStart1[1] = currentPoint1[1] - deltay1 + nextdeltay1;
-      nextLineStart1[2] = localElevation;
-      if (m_UseDEM)
-      {
-        RSTransform2DType::InputPointType tmpPoint;
-        tmpPoint[0]       = nextLineStart1[0];
-        tmpPoint[1]       = nextLineStart1[1];
-        nextLineStart1[2] = demHandler.GetHeightAboveEllipsoid(leftToGroundTransform->TransformPoint(tmpPoint));
-      }
-
-
-      // By construction, nextLineStart2 is always the image of
-      // nextLineStart1 by the left to right transform at the m_AverageElevation
-      nextLineStart2 = m_LeftToRightTransform->TransformPoint(nextLineStart1);
-    }
+  std::vector<double> lon(n), lat(n), heights(n);
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    lon[i] = groundPoints[i][0];
+    lat[i] = groundPoints[i][1];
+  }
+  demHandler.GetHeightAboveEllipsoid(lon.data(), lat.data(), heights.data(), n);
 
-    // Last, we move forward
-    ++it1;
-    ++it2;
+  for (std::size_t i = 0; i < n; ++i)
+  {
+    points[i][2] = heights[i];
+  }
+}
 
-    // Update progress
-    progress.CompletedPixel();
+template <class TInputImage, class TOutputImage>
+double StereorectificationDisplacementFieldSource<TInputImage, TOutputImage>::ComputeEpipolarAngle(const TDPointType& startLine, const TDPointType& endLine)
+{
+  if (endLine[0] == startLine[0])
+  {
+    return endLine[1] > startLine[1] ? 0.5 * otb::CONST_PI : -0.5 * otb::CONST_PI;
   }
 
-  // Compute the mean baseline ratio
-  m_MeanBaselineRatio /= leftDFPtr->GetBufferedRegion().GetNumberOfPixels();
+  const double a = (endLine[1] - startLine[1]) / (endLine[0] - startLine[0]);
+  return endLine[0] > startLine[0] ? std::atan(a) : otb::CONST_PI + std::atan(a);
 }
 
 template <class TInputImage, class TOutputImage>
@@ -240,7 +240,9 @@ int otbMulti3DMapToDEMFilterManual(int argc, char* argv[])
 }
 
 
-int otbMulti3DMapToDEMFilter(int argc, char* argv[])
+namespace
+{
+int Multi3DMapToDEMFilterTest(int argc, char* argv[], bool scatterStreaming)
 {
   typedef otb::ImageFileReader<ImageType> ReaderType;
 
@@ -300,6 +302,7 @@ int otbMulti3DMapToDEMFilter(int argc, char* argv[])
     multiFilter->SetMaskInput(i, maskReaderList->GetNthElement(i)->GetOutput());
   }
   multiFilter->SetOutputParametersFrom3DMap();
+  multiFilter->SetScatterStreaming(scatterStreaming);
 
   WriterType::Pointer writer = WriterType::New();
 
@@ -314,3 +317,14 @@ int otbMulti3DMapToDEMFilter(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+} // end anonymous namespace
+
+int otbMulti3DMapToDEMFilter(int argc, char* argv[])
+{
+  return Multi3DMapToDEMFilterTest(argc, argv, false);
+}
+
+int otbMulti3DMapToDEMFilterScatter(int argc, char* argv[])
+{
+  return Multi3DMapToDEMFilterTest(argc, argv, true);
+}
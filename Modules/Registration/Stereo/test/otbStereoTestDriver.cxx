@@ -26,6 +26,7 @@ void RegisterTests()
   REGISTER_TEST(otbMulti3DMapToDEMFilterEPSG);
   REGISTER_TEST(otbMulti3DMapToDEMFilterManual);
   REGISTER_TEST(otbMulti3DMapToDEMFilter);
+  REGISTER_TEST(otbMulti3DMapToDEMFilterScatter);
   REGISTER_TEST(otbAdhesionCorrectionFilter);
   REGISTER_TEST(otbStereoSensorModelToElevationMapFilter);
   REGISTER_TEST(otbStereorectificationDisplacementFieldSource);
@@ -52,6 +52,10 @@ namespace otb
  * OTB additional constants:
  * e - log2e - log10e - ln2 - ln10 - pi - euler
  *
+ * The label objects are evaluated by blocks of BulkSize objects, with the
+ * bulk mode of muParser (which evaluates a block in parallel when muParser
+ * is built with OpenMP). A BulkSize of 1 evaluates the objects one by one.
+ *
  *
  * \sa Parser
  *
@@ -101,6 +105,10 @@ public:
   /** Manual variables setting **/
   void SetAttributes(std::vector<std::string> shapeAttributes, std::vector<std::string> statAttributes, int nbOfBands);
 
+  /** Set/Get the number of label objects evaluated at once (default is 4096) */
+  itkSetMacro(BulkSize, unsigned int);
+  itkGetMacro(BulkSize, unsigned int);
+
   /** Display varname and address **/
   void DisplayVar() const;
 
@@ -129,8 +137,9 @@ private:
   LabelObjectOpeningMuParserFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  FunctorType m_Functor;
-  std::string m_Expression;
+  FunctorType  m_Functor;
+  std::string  m_Expression;
+  unsigned int m_BulkSize;
 };
 
 } // end namespace otb
@@ -24,6 +24,8 @@
 #include "otbLabelObjectOpeningMuParserFilter.h"
 #include <iostream>
 #include <string>
+#include <algorithm>
+#include <vector>
 
 #include "itkImageRegionIterator.h"
 #include "itkNumericTraits.h"
@@ -33,7 +35,7 @@ namespace otb
 
 // constructor
 template <class TImage, class TFunction>
-LabelObjectOpeningMuParserFilter<TImage, TFunction>::LabelObjectOpeningMuParserFilter()
+LabelObjectOpeningMuParserFilter<TImage, TFunction>::LabelObjectOpeningMuParserFilter() : m_BulkSize(4096)
 {
   // create the output image for the removed objects
   this->SetNumberOfRequiredOutputs(2);
@@ -51,6 +53,7 @@ void LabelObjectOpeningMuParserFilter<TImage, TFunction>::PrintSelf(std::ostream
 {
   Superclass::PrintSelf(os, indent);
   os << indent << "Expression: " << m_Expression << std::endl;
+  os << indent << "BulkSize: " << m_BulkSize << std::endl;
 }
 
 template <class TImage, class TFunction>
@@ -170,27 +173,33 @@ void LabelObjectOpeningMuParserFilter<TImage, TFunction>::GenerateData()
   // set the background value for the second output - this is not done in the superclasses
   output2->SetBackgroundValue(output->GetBackgroundValue());
 
-  itk::ProgressReporter        progress(this, 0, output->GetNumberOfLabelObjects());
-  typename ImageType::Iterator it(output);
+  itk::ProgressReporter progress(this, 0, output->GetNumberOfLabelObjects());
 
-  while (!it.IsAtEnd())
+  // The objects are evaluated before any of them is removed
+  std::vector<LabelObjectType*> labelObjects;
+  labelObjects.reserve(output->GetNumberOfLabelObjects());
+  for (typename ImageType::Iterator it(output); !it.IsAtEnd(); ++it)
   {
-    typename LabelObjectType::LabelType label       = it.GetLabel();
-    LabelObjectType*                    labelObject = it.GetLabelObject();
+    labelObjects.push_back(it.GetLabelObject());
+  }
 
-    if (!m_Functor(*labelObject))
-    {
-      // must increment the iterator before removing the object to avoid invalidating the iterator
-      ++it;
-      output2->AddLabelObject(labelObject);
-      output->RemoveLabel(label);
-    }
-    else
+  const std::size_t bulkSize = std::max(1u, m_BulkSize);
+  std::vector<bool> accepted;
+  for (std::size_t first = 0; first < labelObjects.size(); first += bulkSize)
+  {
+    const std::size_t nbObjects = std::min(bulkSize, labelObjects.size() - first);
+    m_Functor.EvaluateBulk(&labelObjects[first], nbObjects, accepted);
+
+    for (std::size_t i = 0; i < nbObjects; ++i)
     {
-      ++it;
+      if (!accepted[i])
+      {
+        LabelObjectType* labelObject = labelObjects[first + i];
+        output2->AddLabelObject(labelObject);
+        output->RemoveLabel(labelObject->GetLabel());
+      }
+      progress.CompletedPixel();
     }
-
-    progress.CompletedPixel();
   }
 }
 
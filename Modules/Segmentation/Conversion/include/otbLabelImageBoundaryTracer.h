@@ -0,0 +1,166 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLabelImageBoundaryTracer_h
+#define otbLabelImageBoundaryTracer_h
+
+#include "otbOGRGeometryWrapper.h"
+#include <istream>
+#include <ostream>
+#include <unordered_map>
+#include <vector>
+
+namespace otb
+{
+
+/** \class LabelImageBoundaryTracer
+ *
+ * Vectorizes a label image tile by tile, without polygon stitching.
+ *
+ * Each tile adds the boundary edges of its pixels to an edge table kept per
+ * label: the pixel sides separating two different labels, or lying on the
+ * image border. Edges of pixels across the right and bottom tile borders are
+ * computed from the neighbour pixels, so tiles must be buffered with one
+ * more column and one more row when they exist (as with
+ * LabelImageToOGRDataSourceFilter per tile).
+ *
+ * Once every tile containing a region has been added, its edges form closed
+ * rings, which are traced and organized into a polygon or a multipolygon by
+ * TakeGeometry(). Regions are assumed to be connected (as the segments of
+ * the LSMS workflow): when all the tiles up to a given row are processed,
+ * GetCompleteLabels() returns the labels absent from the last processed rows,
+ * whose geometry can be emitted right away. Pixels with the label 0 are not
+ * vectorized.
+ *
+ * Tracers working on different parts of the image can be combined: the
+ * regions crossing the limit of a part are exported with ExportLabel(), and
+ * imported by a single tracer with ImportLabels() before taking them.
+ *
+ * Rings follow pixel borders in 4-connectivity (pixels touching by a corner
+ * only are separate rings), with collinear vertices removed.
+ *
+ * \ingroup OTBConversion
+ */
+template <class TLabelImage>
+class LabelImageBoundaryTracer
+{
+public:
+  typedef TLabelImage                           LabelImageType;
+  typedef typename LabelImageType::PixelType    LabelType;
+  typedef typename LabelImageType::RegionType   RegionType;
+  typedef typename LabelImageType::IndexType    IndexType;
+  typedef typename IndexType::IndexValueType    IndexValueType;
+  typedef typename LabelImageType::PointType    PointType;
+  typedef typename LabelImageType::SpacingType  SpacingType;
+  typedef std::vector<LabelType>                LabelListType;
+
+  LabelImageBoundaryTracer();
+
+  /** Sets the largest possible region, origin and spacing of the whole label
+   * image. Must be called before adding tiles. */
+  void SetImageInformation(const LabelImageType* image);
+
+  /** Adds the boundary edges of the pixels of tile. The buffered region of
+   * labels must contain tile, plus one column on its right and one row below
+   * it when they are inside the image. */
+  void AddTile(const LabelImageType* labels, const RegionType& tile);
+
+  /** Sorted labels whose pixels all lie above the given row, i.e. that can
+   * be taken once every tile above this row has been added. */
+  LabelListType GetCompleteLabels(IndexValueType row) const;
+
+  /** Same as above, for regions added from a part of the image starting
+   * below startRow: labels touching startRow may extend above the part and
+   * are not returned. */
+  LabelListType GetCompleteLabels(IndexValueType row, IndexValueType startRow) const;
+
+  /** Sorted labels still in the edge table */
+  LabelListType GetOpenLabels() const;
+
+  /** Writes the edges of a label in a binary form and removes the label from
+   * the edge table */
+  void ExportLabel(LabelType label, std::ostream& os);
+
+  /** Adds the labels written by ExportLabel(), possibly by another tracer of
+   * the same image, merging them with the labels already in the table */
+  void ImportLabels(std::istream& is);
+
+  /** Traces the rings of a label, returns its geometry in physical
+   * coordinates and removes the label from the edge table. */
+  ogr::UniqueGeometryPtr TakeGeometry(LabelType label);
+
+  /** Number of labels in the edge table */
+  std::size_t GetNumberOfOpenLabels() const
+  {
+    return m_Labels.size();
+  }
+
+private:
+  /** Pixel side, or run of aligned pixel sides, between two pixel corners.
+   * Edges turn clockwise around the region (with y downwards). */
+  struct Edge
+  {
+    IndexValueType x;
+    IndexValueType y;
+    IndexValueType length;
+    unsigned int   direction; // 0: +x, 1: +y, 2: -x, 3: -y
+
+    bool operator<(const Edge& other) const
+    {
+      return (y < other.y) || (y == other.y && x < other.x);
+    }
+  };
+
+  struct LabelData
+  {
+    std::vector<Edge> edges;
+    IndexValueType    firstRow;
+    IndexValueType    lastRow;
+  };
+
+  /** Steps along x and y for each edge direction */
+  static IndexValueType Dx(unsigned int direction)
+  {
+    return (direction == 0) ? 1 : ((direction == 2) ? -1 : 0);
+  }
+  static IndexValueType Dy(unsigned int direction)
+  {
+    return (direction == 1) ? 1 : ((direction == 3) ? -1 : 0);
+  }
+
+  /** Appends an edge, extending the last edge of the label when aligned */
+  static void AddEdge(LabelData& data, IndexValueType x, IndexValueType y, unsigned int direction);
+
+  LabelData& GetLabelData(LabelType label);
+
+  RegionType  m_LargestRegion;
+  PointType   m_Origin;
+  SpacingType m_Spacing;
+
+  std::unordered_map<LabelType, LabelData> m_Labels;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbLabelImageBoundaryTracer.hxx"
+#endif
+
+#endif
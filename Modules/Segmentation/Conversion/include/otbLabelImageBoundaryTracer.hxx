@@ -0,0 +1,375 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLabelImageBoundaryTracer_hxx
+#define otbLabelImageBoundaryTracer_hxx
+
+#include "otbLabelImageBoundaryTracer.h"
+#include "itkMacro.h"
+#include "ogr_geometry.h"
+#include <algorithm>
+#include <cstdint>
+
+namespace otb
+{
+
+template <class TLabelImage>
+LabelImageBoundaryTracer<TLabelImage>::LabelImageBoundaryTracer()
+{
+  m_Origin.Fill(0);
+  m_Spacing.Fill(1);
+}
+
+template <class TLabelImage>
+void LabelImageBoundaryTracer<TLabelImage>::SetImageInformation(const LabelImageType* image)
+{
+  m_LargestRegion = image->GetLargestPossibleRegion();
+  m_Origin        = image->GetOrigin();
+  m_Spacing       = image->GetSignedSpacing();
+  m_Labels.clear();
+}
+
+template <class TLabelImage>
+typename LabelImageBoundaryTracer<TLabelImage>::LabelData& LabelImageBoundaryTracer<TLabelImage>::GetLabelData(LabelType label)
+{
+  auto it = m_Labels.find(label);
+  if (it == m_Labels.end())
+  {
+    it                  = m_Labels.emplace(label, LabelData()).first;
+    it->second.firstRow = m_LargestRegion.GetIndex()[1] + m_LargestRegion.GetSize()[1];
+    it->second.lastRow  = m_LargestRegion.GetIndex()[1];
+  }
+  return it->second;
+}
+
+template <class TLabelImage>
+void LabelImageBoundaryTracer<TLabelImage>::AddEdge(LabelData& data, IndexValueType x, IndexValueType y, unsigned int direction)
+{
+  if (!data.edges.empty())
+  {
+    Edge& last = data.edges.back();
+    if (last.direction == direction)
+    {
+      // New edge starting at the end of the last one
+      if (last.x + last.length * Dx(direction) == x && last.y + last.length * Dy(direction) == y)
+      {
+        ++last.length;
+        return;
+      }
+      // New edge ending at the start of the last one
+      if (x + Dx(direction) == last.x && y + Dy(direction) == last.y)
+      {
+        last.x = x;
+        last.y = y;
+        ++last.length;
+        return;
+      }
+    }
+  }
+  Edge edge;
+  edge.x         = x;
+  edge.y         = y;
+  edge.length    = 1;
+  edge.direction = direction;
+  data.edges.push_back(edge);
+}
+
+template <class TLabelImage>
+void LabelImageBoundaryTracer<TLabelImage>::AddTile(const LabelImageType* labels, const RegionType& tile)
+{
+  const IndexValueType xBegin = m_LargestRegion.GetIndex()[0];
+  const IndexValueType yBegin = m_LargestRegion.GetIndex()[1];
+  const IndexValueType xEnd   = xBegin + m_LargestRegion.GetSize()[0];
+  const IndexValueType yEnd   = yBegin + m_LargestRegion.GetSize()[1];
+
+  const IndexValueType tileXEnd = tile.GetIndex()[0] + tile.GetSize()[0];
+  const IndexValueType tileYEnd = tile.GetIndex()[1] + tile.GetSize()[1];
+
+  IndexType index;
+  for (IndexValueType y = tile.GetIndex()[1]; y < tileYEnd; ++y)
+  {
+    LabelType  previousLabel = 0;
+    LabelData* previousData  = nullptr;
+    for (IndexValueType x = tile.GetIndex()[0]; x < tileXEnd; ++x)
+    {
+      index[0]            = x;
+      index[1]            = y;
+      const LabelType  a  = labels->GetPixel(index);
+      LabelData*       da = nullptr;
+      if (a != 0)
+      {
+        da = (previousData && previousLabel == a) ? previousData : &GetLabelData(a);
+        da->firstRow  = std::min(da->firstRow, y);
+        da->lastRow   = std::max(da->lastRow, y);
+        previousLabel = a;
+        previousData  = da;
+
+        if (x == xBegin)
+          AddEdge(*da, x, y + 1, 3);
+        if (y == yBegin)
+          AddEdge(*da, x, y, 0);
+      }
+
+      // Vertical side shared with the right neighbour
+      if (x + 1 < xEnd)
+      {
+        index[0]          = x + 1;
+        const LabelType b = labels->GetPixel(index);
+        index[0]          = x;
+        if (a != b)
+        {
+          if (a != 0)
+            AddEdge(*da, x + 1, y, 1);
+          if (b != 0)
+          {
+            LabelData& db = GetLabelData(b);
+            db.firstRow   = std::min(db.firstRow, y);
+            db.lastRow    = std::max(db.lastRow, y);
+            AddEdge(db, x + 1, y + 1, 3);
+          }
+        }
+      }
+      else if (a != 0)
+      {
+        AddEdge(*da, x + 1, y, 1);
+      }
+
+      // Horizontal side shared with the bottom neighbour
+      if (y + 1 < yEnd)
+      {
+        index[1]          = y + 1;
+        const LabelType c = labels->GetPixel(index);
+        if (a != c)
+        {
+          if (a != 0)
+            AddEdge(*da, x + 1, y + 1, 2);
+          if (c != 0)
+          {
+            // The region continues below this row
+            LabelData& dc = GetLabelData(c);
+            dc.firstRow   = std::min(dc.firstRow, y + 1);
+            dc.lastRow    = std::max(dc.lastRow, y + 1);
+            AddEdge(dc, x, y + 1, 0);
+          }
+        }
+      }
+      else if (a != 0)
+      {
+        AddEdge(*da, x + 1, y + 1, 2);
+      }
+    }
+  }
+}
+
+template <class TLabelImage>
+typename LabelImageBoundaryTracer<TLabelImage>::LabelListType LabelImageBoundaryTracer<TLabelImage>::GetCompleteLabels(IndexValueType row) const
+{
+  return GetCompleteLabels(row, m_LargestRegion.GetIndex()[1] - 1);
+}
+
+template <class TLabelImage>
+typename LabelImageBoundaryTracer<TLabelImage>::LabelListType LabelImageBoundaryTracer<TLabelImage>::GetCompleteLabels(IndexValueType row,
+                                                                                                                       IndexValueType startRow) const
+{
+  LabelListType complete;
+  for (const auto& label : m_Labels)
+  {
+    if (label.second.lastRow < row && label.second.firstRow > startRow)
+    {
+      complete.push_back(label.first);
+    }
+  }
+  std::sort(complete.begin(), complete.end());
+  return complete;
+}
+
+template <class TLabelImage>
+typename LabelImageBoundaryTracer<TLabelImage>::LabelListType LabelImageBoundaryTracer<TLabelImage>::GetOpenLabels() const
+{
+  LabelListType open;
+  for (const auto& label : m_Labels)
+  {
+    open.push_back(label.first);
+  }
+  std::sort(open.begin(), open.end());
+  return open;
+}
+
+template <class TLabelImage>
+void LabelImageBoundaryTracer<TLabelImage>::ExportLabel(LabelType label, std::ostream& os)
+{
+  auto labelIt = m_Labels.find(label);
+  if (labelIt == m_Labels.end())
+  {
+    return;
+  }
+
+  const LabelData&    data     = labelIt->second;
+  const std::uint64_t nbEdges  = data.edges.size();
+  os.write(reinterpret_cast<const char*>(&label), sizeof(LabelType));
+  os.write(reinterpret_cast<const char*>(&data.firstRow), sizeof(IndexValueType));
+  os.write(reinterpret_cast<const char*>(&data.lastRow), sizeof(IndexValueType));
+  os.write(reinterpret_cast<const char*>(&nbEdges), sizeof(std::uint64_t));
+  if (nbEdges > 0)
+  {
+    os.write(reinterpret_cast<const char*>(data.edges.data()), nbEdges * sizeof(Edge));
+  }
+  m_Labels.erase(labelIt);
+}
+
+template <class TLabelImage>
+void LabelImageBoundaryTracer<TLabelImage>::ImportLabels(std::istream& is)
+{
+  LabelType label;
+  while (is.read(reinterpret_cast<char*>(&label), sizeof(LabelType)))
+  {
+    IndexValueType firstRow = 0;
+    IndexValueType lastRow  = 0;
+    std::uint64_t  nbEdges  = 0;
+    is.read(reinterpret_cast<char*>(&firstRow), sizeof(IndexValueType));
+    is.read(reinterpret_cast<char*>(&lastRow), sizeof(IndexValueType));
+    is.read(reinterpret_cast<char*>(&nbEdges), sizeof(std::uint64_t));
+
+    std::vector<Edge> edges(nbEdges);
+    if (nbEdges > 0)
+    {
+      is.read(reinterpret_cast<char*>(edges.data()), nbEdges * sizeof(Edge));
+    }
+    if (!is)
+    {
+      itkGenericExceptionMacro(<< "Truncated boundary data for label " << label);
+    }
+
+    LabelData& data = GetLabelData(label);
+    data.firstRow   = std::min(data.firstRow, firstRow);
+    data.lastRow    = std::max(data.lastRow, lastRow);
+    data.edges.insert(data.edges.end(), edges.begin(), edges.end());
+  }
+}
+
+template <class TLabelImage>
+ogr::UniqueGeometryPtr LabelImageBoundaryTracer<TLabelImage>::TakeGeometry(LabelType label)
+{
+  auto labelIt = m_Labels.find(label);
+  if (labelIt == m_Labels.end())
+  {
+    return ogr::UniqueGeometryPtr(nullptr);
+  }
+
+  std::vector<Edge> edges;
+  edges.swap(labelIt->second.edges);
+  m_Labels.erase(labelIt);
+
+  std::sort(edges.begin(), edges.end());
+  std::vector<bool> used(edges.size(), false);
+
+  std::vector<OGRGeometry*> rings;
+
+  for (std::size_t first = 0; first < edges.size(); ++first)
+  {
+    if (used[first])
+      continue;
+
+    // Corners where the ring changes direction
+    std::vector<std::pair<IndexValueType, IndexValueType>> corners;
+
+    const IndexValueType startX  = edges[first].x;
+    const IndexValueType startY  = edges[first].y;
+    std::size_t          current = first;
+    used[current]                = true;
+    corners.emplace_back(startX, startY);
+
+    while (true)
+    {
+      const Edge&          edge = edges[current];
+      const IndexValueType endX = edge.x + edge.length * Dx(edge.direction);
+      const IndexValueType endY = edge.y + edge.length * Dy(edge.direction);
+      if (endX == startX && endY == startY)
+        break;
+
+      // Unused edges leaving the end corner: at most two, when two pixels of
+      // the region touch by this corner. Turning right keeps them apart.
+      Edge key;
+      key.x         = endX;
+      key.y         = endY;
+      auto range    = std::equal_range(edges.begin(), edges.end(), key);
+      std::size_t next = edges.size();
+      for (unsigned int turn : {1u, 0u, 3u})
+      {
+        const unsigned int direction = (edge.direction + turn) % 4;
+        for (auto it = range.first; it != range.second; ++it)
+        {
+          const std::size_t candidate = it - edges.begin();
+          if (!used[candidate] && it->direction == direction)
+          {
+            next = candidate;
+            break;
+          }
+        }
+        if (next != edges.size())
+          break;
+      }
+      if (next == edges.size())
+      {
+        for (auto ring : rings)
+          OGRGeometryFactory::destroyGeometry(ring);
+        itkGenericExceptionMacro(<< "Open boundary for label " << label << " at (" << endX << ", " << endY << "): was every tile containing it added?");
+      }
+
+      if (edges[next].direction != edge.direction)
+      {
+        corners.emplace_back(endX, endY);
+      }
+      used[next] = true;
+      current    = next;
+    }
+
+    // The start corner is on a straight part when the ring ends in the
+    // direction it started with
+    if (edges[current].direction == edges[first].direction && corners.size() > 1)
+    {
+      corners.erase(corners.begin());
+    }
+
+    OGRLinearRing* ring = new OGRLinearRing();
+    for (const auto& corner : corners)
+    {
+      ring->addPoint(m_Origin[0] + (corner.first - 0.5) * m_Spacing[0], m_Origin[1] + (corner.second - 0.5) * m_Spacing[1]);
+    }
+    ring->closeRings();
+
+    OGRPolygon* polygon = static_cast<OGRPolygon*>(OGRGeometryFactory::createGeometry(wkbPolygon));
+    polygon->addRingDirectly(ring);
+    rings.push_back(polygon);
+  }
+
+  if (rings.empty())
+  {
+    return ogr::UniqueGeometryPtr(nullptr);
+  }
+
+  // Nest the holes in their outer rings
+  int isValid = 0;
+  return ogr::UniqueGeometryPtr(OGRGeometryFactory::organizePolygons(rings.data(), static_cast<int>(rings.size()), &isValid, nullptr));
+}
+
+} // end namespace otb
+
+#endif
@@ -24,8 +24,8 @@
 #include "otbImage.h"
 #include "otbVectorImage.h"
 #include "itkImageToImageFilter.h"
+#include "otbRegionAdjacencyGraph.h"
 
-#include <set>
 
 namespace otb
 {
@@ -86,9 +86,8 @@ public:
   itkStaticConstMacro(ImageDimension, unsigned int, InputLabelImageType::ImageDimension);
 
   /** Typedefs for region adjacency map */
-  typedef InputLabelType                           LabelType;
-  typedef std::set<LabelType>                      AdjacentLabelsContainerType;
-  typedef std::vector<AdjacentLabelsContainerType> RegionAdjacencyMapType;
+  typedef InputLabelType                  LabelType;
+  typedef RegionAdjacencyGraph<LabelType> RegionAdjacencyMapType;
 
 
   /** Setters / Getters */
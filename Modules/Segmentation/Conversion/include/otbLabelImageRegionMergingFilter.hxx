@@ -167,15 +167,18 @@ void LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutpu
   typename itk::ImageRegionIterator<OutputLabelImageType>     outputIt(outputLabelImage, outputLabelImage->GetRequestedRegion());
   inputIt.GoToBegin();
   outputIt.GoToBegin();
+  LabelType maxLabel = 0;
   while (!inputIt.IsAtEnd())
   {
-    outputIt.Set(inputIt.Get());
+    const LabelType label = inputIt.Get();
+    maxLabel              = std::max(maxLabel, label);
+    outputIt.Set(label);
     ++inputIt;
     ++outputIt;
   }
 
   RegionAdjacencyMapType regionAdjacencyMap = LabelImageToRegionAdjacencyMap(outputLabelImage);
-  unsigned int           regionCount        = regionAdjacencyMap.size() - 1;
+  unsigned int           regionCount        = maxLabel;
 
   // Initialize arrays for mode information
   m_CanonicalLabels.clear();
@@ -237,10 +240,8 @@ void LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutpu
       const SpectralPixelType& curSpectral = m_Modes[curLabel];
 
       // Iterate over all adjacent regions and check for merge
-      typename AdjacentLabelsContainerType::const_iterator adjIt = regionAdjacencyMap[curLabel].begin();
-      while (adjIt != regionAdjacencyMap[curLabel].end())
+      for (LabelType adjLabel : regionAdjacencyMap.GetNeighbours(curLabel))
       {
-        LabelType adjLabel = *adjIt;
         assert(adjLabel <= regionCount);
         const SpectralPixelType& adjSpectral = m_Modes[adjLabel];
         // Check condition to merge regions
@@ -281,7 +282,6 @@ void LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutpu
             m_CanonicalLabels[curCanLabel]                    = adjCanLabel;
           }
         }
-        ++adjIt;
       } // end of loop over adjacent labels
     }   // end of loop over labels
 
@@ -413,22 +413,10 @@ typename LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TO
 LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutputLabelImage, TOutputClusteredImage>::LabelImageToRegionAdjacencyMap(
     typename OutputLabelImageType::Pointer labelImage)
 {
-  // declare the output map
-  RegionAdjacencyMapType ram;
-
-  // Find the maximum label value
-  itk::ImageRegionConstIterator<OutputLabelImageType> it(labelImage, labelImage->GetRequestedRegion());
-  it.GoToBegin();
-  LabelType maxLabel = 0;
-  while (!it.IsAtEnd())
-  {
-    LabelType label = it.Get();
-    maxLabel        = std::max(maxLabel, label);
-    ++it;
-  }
-
-  // Set the size of the adjacency map
-  ram.resize(maxLabel + 1);
+  // declare the output map, and the list of pairs of adjacent labels it is
+  // built from
+  RegionAdjacencyMapType                          ram;
+  typename RegionAdjacencyMapType::EdgeListType edges;
 
   // set the image region without bottom and right borders so that bottom and
   // right neighbors always exist
@@ -456,13 +444,13 @@ LabelImageRegionMergingFilter<TInputLabelImage, TInputSpectralImage, TOutputLabe
       // add adjacency if different labels
       if (neighborLabel != label)
       {
-        ram[label].insert(neighborLabel);
-        ram[neighborLabel].insert(label);
+        edges.push_back(typename RegionAdjacencyMapType::EdgeType(label, neighborLabel));
       }
     }
     ++inputIt;
   }
 
+  ram.Build(edges, true);
   return ram;
 }
 
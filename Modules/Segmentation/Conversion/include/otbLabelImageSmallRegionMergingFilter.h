@@ -23,6 +23,7 @@
 
 #include "otbPersistentImageFilter.h"
 #include "otbPersistentFilterStreamingDecorator.h"
+#include "otbRegionAdjacencyGraph.h"
 
 #include <unordered_map>
 
@@ -72,7 +73,9 @@ public:
 
   typedef itk::VariableLengthVector<double> RealVectorPixelType;
 
-  typedef std::unordered_map<InputLabelType, std::set<InputLabelType>> NeighboursMapType;
+  typedef RegionAdjacencyGraph<InputLabelType>             RegionAdjacencyGraphType;
+  typedef typename RegionAdjacencyGraphType::EdgeType     EdgeType;
+  typedef typename RegionAdjacencyGraphType::EdgeListType EdgeListType;
 
   typedef std::unordered_map<InputLabelType, RealVectorPixelType> LabelStatisticType;
   typedef std::unordered_map<InputLabelType, double>              LabelPopulationType;
@@ -106,12 +109,12 @@ protected:
   void GenerateInputRequestedRegion() override;
 
   /** Threaded Generate Data : find the neighbours of each segments of size
-   * m_Size for each tile and store them in an accumulator */
+   * m_Size for each tile and store them as edges in an accumulator */
   void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
 
   /** Use the LUT recursively to find the label corresponding to the input
-   * label */
+   * label, and make the visited labels point directly to it */
   InputLabelType FindCorrespondingLabel(InputLabelType label);
 
   /** Constructor */
@@ -136,8 +139,8 @@ private:
   /** Map containing at key i the mean of element of the segment labelled i */
   LabelStatisticType m_LabelStatistic;
 
-  /** Neighbours maps for each thread */
-  std::vector<NeighboursMapType> m_NeighboursMapsTmp;
+  /** Edges (segment of size m_Size, neighbour segment) found by each thread */
+  std::vector<EdgeListType> m_EdgesTmp;
 
   /** LUT giving correspondence between labels in the original segmentation
    * and the merged labels */
@@ -76,35 +76,29 @@ PersistentLabelImageSmallRegionMergingFilter<TInputLabelImage>::GetLUT() const
 template <class TInputLabelImage>
 void PersistentLabelImageSmallRegionMergingFilter<TInputLabelImage>::Reset()
 {
-  m_NeighboursMapsTmp.clear();
-  m_NeighboursMapsTmp.resize(this->GetNumberOfThreads());
+  m_EdgesTmp.clear();
+  m_EdgesTmp.resize(this->GetNumberOfThreads());
 }
 
 template <class TInputLabelImage>
 void PersistentLabelImageSmallRegionMergingFilter<TInputLabelImage>::Synthetize()
 {
-  NeighboursMapType neighboursMap;
-
-  // Merge the neighbours maps from all threads
-  for (unsigned int threadId = 0; threadId < this->GetNumberOfThreads(); threadId++)
-  {
-    for (auto const& neighbours : m_NeighboursMapsTmp[threadId])
-    {
-      neighboursMap[neighbours.first].insert(neighbours.second.begin(), neighbours.second.end());
-    }
-  }
+  // Build the adjacency graph of the segments of size m_Size from the edges
+  // found by all threads
+  RegionAdjacencyGraphType graph;
+  graph.Build(m_EdgesTmp, false);
 
   // For each label of the label map, find the "closest" connected label,
   // according to the euclidian distance between the corresponding
   // m_labelStatistic elements.
-  for (auto const& neighbours : neighboursMap)
+  for (std::size_t region = 0; region < graph.GetNumberOfRegions(); ++region)
   {
     double         proximity        = itk::NumericTraits<double>::max();
-    InputLabelType label            = neighbours.first;
+    InputLabelType label            = graph.GetRegionLabels()[region];
     InputLabelType closestNeighbour = label;
     auto const&    statsLabel       = m_LabelStatistic[label];
 
-    for (auto const& neighbour : neighbours.second)
+    for (auto const& neighbour : graph.GetNeighboursOfRegion(region))
     {
       auto const& statsNeighbour = m_LabelStatistic[neighbour];
       assert(statsLabel.Size() == statsNeighbour.Size());
@@ -165,13 +159,20 @@ typename PersistentLabelImageSmallRegionMergingFilter<TInputLabelImage>::InputLa
 PersistentLabelImageSmallRegionMergingFilter<TInputLabelImage>::FindCorrespondingLabel(
     typename PersistentLabelImageSmallRegionMergingFilter<TInputLabelImage>::InputLabelType label)
 {
-  auto correspondingLabel = m_LUT[label];
-  while (label != correspondingLabel)
+  InputLabelType root = label;
+  while (m_LUT[root] != root)
   {
-    label              = correspondingLabel;
-    correspondingLabel = m_LUT[correspondingLabel];
+    root = m_LUT[root];
   }
-  return correspondingLabel;
+
+  // Path compression
+  while (label != root)
+  {
+    auto& next = m_LUT[label];
+    label      = next;
+    next       = root;
+  }
+  return root;
 }
 
 template <class TInputLabelImage>
@@ -238,6 +239,8 @@ void PersistentLabelImageSmallRegionMergingFilter<TInputLabelImage>::ThreadedGen
   typename IteratorType::OffsetType left = {{-1, 0}};
   itN.ActivateOffset(left);
 
+  EdgeListType& edges = m_EdgesTmp[threadId];
+
   for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++itN)
   {
     assert(!itN.IsAtEnd());
@@ -248,8 +251,10 @@ void PersistentLabelImageSmallRegionMergingFilter<TInputLabelImage>::ThreadedGen
       for (auto ci = itN.Begin(); !ci.IsAtEnd(); ci++)
       {
         int neighbourLabel = m_LUT[ci.Get()];
-        if (neighbourLabel != currentLabel)
-          m_NeighboursMapsTmp[threadId][currentLabel].insert(neighbourLabel);
+        // Consecutive pixels mostly give the same edge: skip these duplicates
+        // early, the other ones are removed when building the graph
+        if (neighbourLabel != currentLabel && (edges.empty() || edges.back() != EdgeType(currentLabel, neighbourLabel)))
+          edges.push_back(EdgeType(currentLabel, neighbourLabel));
       }
     }
   }
@@ -22,8 +22,12 @@
 #define otbLabelImageToOGRDataSourceFilter_h
 
 #include "itkProcessObject.h"
+#include "itkMultiThreader.h"
 #include "otbOGRDataSourceWrapper.h"
 #include <string>
+#include <vector>
+
+class GDALDataset;
 
 namespace otb
 {
@@ -38,6 +42,14 @@ namespace otb
  * \note The Use8Connected parameter can be turn on and it will be used in \c GDALPolygonize(). But be carreful, it
  * can create cross polygons !
  * \note It is a non-streamed version.
+ *
+ * The image is cut into horizontal strips, polygonized in parallel (one
+ * strip per thread, see SetNumberOfThreads()). The polygons of a same
+ * region split by the strip borders are then merged again: the pixels on
+ * both sides of a border tell which polygons are connected, and these are
+ * replaced by their union. The output thus holds the same regions as with a
+ * single strip, but not necessarily in the same order. Strips are at least
+ * MinimumStripHeight lines high.
  * \ingroup OBIA
  *
  *
@@ -106,6 +118,12 @@ public:
    */
   itkGetMacro(Use8Connected, bool);
 
+  /**
+   * Set/Get the minimum number of lines polygonized by a thread (default is 64)
+   */
+  itkSetMacro(MinimumStripHeight, unsigned int);
+  itkGetMacro(MinimumStripHeight, unsigned int);
+
   /**
    * Get the output \c ogr::DataSource which is a "memory" datasource.
    */
@@ -128,12 +146,40 @@ protected:
   DataObjectPointer MakeOutput(DataObjectPointerArraySizeType idx) override;
   using Superclass::MakeOutput;
 
+  /** Lines [FirstLine, FirstLine + NumberOfLines) of the input, and their polygons */
+  struct StripStruct
+  {
+    typename IndexType::IndexValueType FirstLine;
+    typename SizeType::SizeValueType   NumberOfLines;
+    OGRDataSourcePointerType           DataSource;
+  };
+
+  /** Wrap the lines [firstLine, firstLine + nbLines) of the buffer of an image
+   * in a GDAL MEM dataset */
+  GDALDataset* CreateGDALDataset(const InputImageType* image, typename IndexType::IndexValueType firstLine, typename SizeType::SizeValueType nbLines) const;
+
+  /** Polygonize a strip into the layer */
+  void PolygonizeStrip(const StripStruct& strip, OGRLayerType& layer);
+
+  /** Merge the polygons of the strips into the layer */
+  void MergeStrips(const std::vector<StripStruct>& strips, OGRLayerType& layer);
+
+  struct PolygonizeThreadStruct
+  {
+    Self*                     Filter;
+    std::vector<StripStruct>* Strips;
+    std::vector<std::string>* Errors;
+  };
+
+  static ITK_THREAD_RETURN_TYPE PolygonizeThreaderCallback(void* arg);
+
 private:
   LabelImageToOGRDataSourceFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  std::string m_FieldName;
-  bool        m_Use8Connected;
+  std::string  m_FieldName;
+  bool         m_Use8Connected;
+  unsigned int m_MinimumStripHeight;
 };
 
 
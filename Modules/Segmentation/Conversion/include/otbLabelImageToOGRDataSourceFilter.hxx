@@ -23,6 +23,8 @@
 
 #include "otbLabelImageToOGRDataSourceFilter.h"
 #include "otbGdalDataTypeBridge.h"
+#include "otbEnvelopeSTRTree.h"
+#include "otbOGRGeometryWrapper.h"
 
 // gdal libraries
 #include "gdal.h"
@@ -31,11 +33,12 @@
 #include "gdal_alg.h"
 
 #include "stdint.h" //needed for uintptr_t
+#include <algorithm>
 
 namespace otb
 {
 template <class TInputImage>
-LabelImageToOGRDataSourceFilter<TInputImage>::LabelImageToOGRDataSourceFilter() : m_FieldName("DN"), m_Use8Connected(false)
+LabelImageToOGRDataSourceFilter<TInputImage>::LabelImageToOGRDataSourceFilter() : m_FieldName("DN"), m_Use8Connected(false), m_MinimumStripHeight(64)
 {
   this->SetNumberOfRequiredInputs(2);
   this->SetNumberOfRequiredInputs(1);
@@ -121,21 +124,12 @@ void LabelImageToOGRDataSourceFilter<TInputImage>::GenerateInputRequestedRegion(
 
 
 template <class TInputImage>
-void LabelImageToOGRDataSourceFilter<TInputImage>::GenerateData(void)
+GDALDataset* LabelImageToOGRDataSourceFilter<TInputImage>::CreateGDALDataset(const InputImageType* image, typename IndexType::IndexValueType firstLine,
+                                                                            typename SizeType::SizeValueType nbLines) const
 {
-  if (this->GetInput()->GetRequestedRegion() != this->GetInput()->GetLargestPossibleRegion())
-  {
-    itkExceptionMacro(<< "Not streamed filter. ERROR : requested region is not the largest possible region.");
-  }
-
-  SizeType     size;
-  unsigned int nbBands      = 0;
-  unsigned int bytePerPixel = 0;
-
-  /* Convert the input image into a GDAL raster needed by GDALPolygonize */
-  size         = this->GetInput()->GetLargestPossibleRegion().GetSize();
-  nbBands      = this->GetInput()->GetNumberOfComponentsPerPixel();
-  bytePerPixel = sizeof(InputPixelType);
+  const SizeType     size         = image->GetBufferedRegion().GetSize();
+  const unsigned int nbBands      = image->GetNumberOfComponentsPerPixel();
+  const unsigned int bytePerPixel = sizeof(InputPixelType);
 
   // buffer casted in unsigned long cause under Win32 the address
   // don't begin with 0x, the address in not interpreted as
@@ -143,9 +137,9 @@ void LabelImageToOGRDataSourceFilter<TInputImage>::GenerateData(void)
   // integer make us pointing to an non allowed memory block => Crash.
   std::ostringstream stream;
   stream << "MEM:::"
-         << "DATAPOINTER=" << (uintptr_t)(this->GetInput()->GetBufferPointer()) << ","
+         << "DATAPOINTER=" << (uintptr_t)(image->GetBufferPointer() + firstLine * size[0] * nbBands) << ","
          << "PIXELS=" << size[0] << ","
-         << "LINES=" << size[1] << ","
+         << "LINES=" << nbLines << ","
          << "BANDS=" << nbBands << ","
          << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<InputPixelType>()) << ","
          << "PIXELOFFSET=" << bytePerPixel * nbBands << ","
@@ -155,21 +149,22 @@ void LabelImageToOGRDataSourceFilter<TInputImage>::GenerateData(void)
   GDALDataset* dataset = static_cast<GDALDataset*>(GDALOpen(stream.str().c_str(), GA_ReadOnly));
 
   // Set input Projection ref and Geo transform to the dataset.
-  dataset->SetProjection(this->GetInput()->GetProjectionRef().c_str());
+  dataset->SetProjection(image->GetProjectionRef().c_str());
 
-  unsigned int projSize = this->GetInput()->GetGeoTransform().size();
+  unsigned int projSize = image->GetGeoTransform().size();
   double       geoTransform[6];
 
   // Set the geo transform of the input image (if any)
-  // Reporting origin and spacing of the buffered region
+  // Reporting origin and spacing of the first line of the strip
   // the spacing is unchanged, the origin is relative to the buffered region
-  IndexType  bufferIndexOrigin = this->GetInput()->GetBufferedRegion().GetIndex();
+  IndexType bufferIndexOrigin = image->GetBufferedRegion().GetIndex();
+  bufferIndexOrigin[1] += firstLine;
   OriginType bufferOrigin;
-  this->GetInput()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
-  geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetInput()->GetSignedSpacing()[0];
-  geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetInput()->GetSignedSpacing()[1];
-  geoTransform[1] = this->GetInput()->GetSignedSpacing()[0];
-  geoTransform[5] = this->GetInput()->GetSignedSpacing()[1];
+  image->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
+  geoTransform[0] = bufferOrigin[0] - 0.5 * image->GetSignedSpacing()[0];
+  geoTransform[3] = bufferOrigin[1] - 0.5 * image->GetSignedSpacing()[1];
+  geoTransform[1] = image->GetSignedSpacing()[0];
+  geoTransform[5] = image->GetSignedSpacing()[1];
   // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
   if (projSize == 0)
   {
@@ -178,95 +173,297 @@ void LabelImageToOGRDataSourceFilter<TInputImage>::GenerateData(void)
   }
   else
   {
-    geoTransform[2] = this->GetInput()->GetGeoTransform()[2];
-    geoTransform[4] = this->GetInput()->GetGeoTransform()[4];
+    geoTransform[2] = image->GetGeoTransform()[2];
+    geoTransform[4] = image->GetGeoTransform()[4];
   }
   dataset->SetGeoTransform(geoTransform);
 
-  // Create the output layer for GDALPolygonize().
-  ogr::DataSource::Pointer ogrDS = ogr::DataSource::New();
-
-  OGRLayerType outputLayer = ogrDS->CreateLayer("layer", nullptr, wkbPolygon);
+  return dataset;
+}
 
-  OGRFieldDefn field(m_FieldName.c_str(), OFTInteger);
-  outputLayer.CreateField(field, true);
+template <class TInputImage>
+void LabelImageToOGRDataSourceFilter<TInputImage>::PolygonizeStrip(const StripStruct& strip, OGRLayerType& layer)
+{
+  GDALDataset* dataset = this->CreateGDALDataset(this->GetInput(), strip.FirstLine, strip.NumberOfLines);
 
   // Call GDALPolygonize()
   char** options;
   options         = nullptr;
   char* option[2] = {nullptr, nullptr};
+  std::string opt("8CONNECTED:8");
   if (m_Use8Connected == true)
   {
-    std::string opt("8CONNECTED:8");
     option[0] = const_cast<char*>(opt.c_str());
     options   = option;
   }
 
   /* Convert the mask input into a GDAL raster needed by GDALPolygonize */
-  typename InputImageType::ConstPointer inputMask = this->GetInputMask();
-  if (!inputMask.IsNull())
+  const InputImageType* inputMask = this->GetInputMask();
+  if (inputMask != nullptr)
+  {
+    GDALDataset* maskDataset = this->CreateGDALDataset(inputMask, strip.FirstLine, strip.NumberOfLines);
+    GDALPolygonize(dataset->GetRasterBand(1), maskDataset->GetRasterBand(1), &layer.ogr(), 0, options, nullptr, nullptr);
+    GDALClose(maskDataset);
+  }
+  else
+  {
+    GDALPolygonize(dataset->GetRasterBand(1), nullptr, &layer.ogr(), 0, options, nullptr, nullptr);
+  }
+
+  // Clear memory
+  GDALClose(dataset);
+}
+
+template <class TInputImage>
+ITK_THREAD_RETURN_TYPE LabelImageToOGRDataSourceFilter<TInputImage>::PolygonizeThreaderCallback(void* arg)
+{
+  itk::MultiThreader::ThreadInfoStruct* info = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+  PolygonizeThreadStruct*               str  = static_cast<PolygonizeThreadStruct*>(info->UserData);
+
+  const std::size_t threadId    = info->ThreadID;
+  const std::size_t threadCount = info->NumberOfThreads;
+
+  try
   {
-    size         = this->GetInputMask()->GetLargestPossibleRegion().GetSize();
-    nbBands      = this->GetInputMask()->GetNumberOfComponentsPerPixel();
-    bytePerPixel = sizeof(InputPixelType);
-    // buffer casted in unsigned long cause under Win32 the address
-    // don't begin with 0x, the address in not interpreted as
-    // hexadecimal but alpha numeric value, then the conversion to
-    // integer make us pointing to an non allowed memory block => Crash.
-    std::ostringstream maskstream;
-    maskstream << "MEM:::"
-               << "DATAPOINTER=" << (uintptr_t)(this->GetInputMask()->GetBufferPointer()) << ","
-               << "PIXELS=" << size[0] << ","
-               << "LINES=" << size[1] << ","
-               << "BANDS=" << nbBands << ","
-               << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<InputPixelType>()) << ","
-               << "PIXELOFFSET=" << bytePerPixel * nbBands << ","
-               << "LINEOFFSET=" << bytePerPixel * nbBands * size[0] << ","
-               << "BANDOFFSET=" << bytePerPixel;
-
-    GDALDataset* maskDataset = static_cast<GDALDataset*>(GDALOpen(maskstream.str().c_str(), GA_ReadOnly));
-
-    // Set input Projection ref and Geo transform to the dataset.
-    maskDataset->SetProjection(this->GetInputMask()->GetProjectionRef().c_str());
-
-    projSize = this->GetInputMask()->GetGeoTransform().size();
-
-    // Set the geo transform of the input mask image (if any)
-    // Reporting origin and spacing of the buffered region
-    // the spacing is unchanged, the origin is relative to the buffered region
-    bufferIndexOrigin = this->GetInputMask()->GetBufferedRegion().GetIndex();
-    this->GetInputMask()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
-    geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetInputMask()->GetSignedSpacing()[0];
-    geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetInputMask()->GetSignedSpacing()[1];
-    geoTransform[1] = this->GetInputMask()->GetSignedSpacing()[0];
-    geoTransform[5] = this->GetInputMask()->GetSignedSpacing()[1];
-    // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
-    if (projSize == 0)
+    for (std::size_t i = threadId; i < str->Strips->size(); i += threadCount)
     {
-      geoTransform[2] = 0.;
-      geoTransform[4] = 0.;
+      StripStruct& strip = (*str->Strips)[i];
+      OGRLayerType layer = strip.DataSource->GetLayerChecked(0);
+      str->Filter->PolygonizeStrip(strip, layer);
     }
-    else
+  }
+  catch (std::exception const& e)
+  {
+    (*str->Errors)[threadId] = e.what();
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TInputImage>
+void LabelImageToOGRDataSourceFilter<TInputImage>::MergeStrips(const std::vector<StripStruct>& strips, OGRLayerType& layer)
+{
+  const InputImageType* input     = this->GetInput();
+  const InputImageType* inputMask = this->GetInputMask();
+  const SizeType        size      = input->GetBufferedRegion().GetSize();
+  const unsigned int    nbBands   = input->GetNumberOfComponentsPerPixel();
+  const unsigned int    maskBands = inputMask ? inputMask->GetNumberOfComponentsPerPixel() : 0;
+  const long            width     = static_cast<long>(size[0]);
+
+  // Label of the first band, and validity in the mask, of a pixel of the buffer
+  auto label = [&](long x, long y) { return input->GetBufferPointer()[(y * width + x) * nbBands]; };
+  auto valid = [&](long x, long y) { return (inputMask == nullptr) || (inputMask->GetBufferPointer()[(y * width + x) * maskBands] != 0); };
+
+  // Features of all the strips, strip after strip
+  std::vector<ogr::Feature> features;
+  std::vector<std::size_t>  firstFeature;
+  for (const StripStruct& strip : strips)
+  {
+    firstFeature.push_back(features.size());
+    OGRLayerType stripLayer = strip.DataSource->GetLayerChecked(0);
+    for (OGRLayerType::const_iterator featIt = stripLayer.cbegin(); featIt != stripLayer.cend(); ++featIt)
+    {
+      features.push_back(*featIt);
+    }
+  }
+  firstFeature.push_back(features.size());
+
+  // Feature of strip k holding each valid pixel of a line of the strip
+  auto locateLine = [&](std::size_t k, long y) {
+    std::vector<long> owners(width, -1);
+
+    IndexType index = input->GetBufferedRegion().GetIndex();
+    index[1] += y;
+    OriginType       first, last;
+    OGREnvelope      lineEnvelope;
+    EnvelopeSTRTree  tree;
+    input->TransformIndexToPhysicalPoint(index, first);
+    index[0] += width - 1;
+    input->TransformIndexToPhysicalPoint(index, last);
+    lineEnvelope.MinX = std::min(first[0], last[0]);
+    lineEnvelope.MaxX = std::max(first[0], last[0]);
+    lineEnvelope.MinY = std::min(first[1], last[1]);
+    lineEnvelope.MaxY = std::max(first[1], last[1]);
+    for (std::size_t i = firstFeature[k]; i < firstFeature[k + 1]; ++i)
     {
-      geoTransform[2] = this->GetInputMask()->GetGeoTransform()[2];
-      geoTransform[4] = this->GetInputMask()->GetGeoTransform()[4];
+      OGREnvelope envelope;
+      features[i].GetGeometry()->getEnvelope(&envelope);
+      if (envelope.Intersects(lineEnvelope))
+      {
+        tree.Insert(envelope, i);
+      }
     }
-    maskDataset->SetGeoTransform(geoTransform);
+    tree.Build();
 
-    GDALPolygonize(dataset->GetRasterBand(1), maskDataset->GetRasterBand(1), &outputLayer.ogr(), 0, options, nullptr, nullptr);
-    GDALClose(maskDataset);
+    // Pixels of a run of a same label are all in the same polygon
+    long x = 0;
+    while (x < width)
+    {
+      if (!valid(x, y))
+      {
+        ++x;
+        continue;
+      }
+      long runEnd = x + 1;
+      while (runEnd < width && valid(runEnd, y) && label(runEnd, y) == label(x, y))
+      {
+        ++runEnd;
+      }
+
+      index[0] = input->GetBufferedRegion().GetIndex(0) + x;
+      OriginType center;
+      input->TransformIndexToPhysicalPoint(index, center);
+      OGRPoint    point(center[0], center[1]);
+      OGREnvelope pointEnvelope;
+      point.getEnvelope(&pointEnvelope);
+      for (std::size_t candidate : tree.Query(pointEnvelope))
+      {
+        // Pixel centers are never on the borders of the polygons
+        if (features[candidate].GetGeometry()->Intersects(&point))
+        {
+          std::fill(owners.begin() + x, owners.begin() + runEnd, static_cast<long>(candidate));
+          break;
+        }
+      }
+      x = runEnd;
+    }
+    return owners;
+  };
+
+  // Union-find of the features of a same region
+  std::vector<std::size_t> parent(features.size());
+  for (std::size_t i = 0; i < parent.size(); ++i)
+  {
+    parent[i] = i;
   }
-  else
+  auto find = [&](std::size_t i) {
+    while (parent[i] != i)
+    {
+      parent[i] = parent[parent[i]];
+      i         = parent[i];
+    }
+    return i;
+  };
+
+  const long neighbours = m_Use8Connected ? 1 : 0;
+  for (std::size_t k = 1; k < strips.size(); ++k)
   {
-    GDALPolygonize(dataset->GetRasterBand(1), nullptr, &outputLayer.ogr(), 0, options, nullptr, nullptr);
+    const long              yBelow = strips[k].FirstLine;
+    const long              yAbove = yBelow - 1;
+    const std::vector<long> above  = locateLine(k - 1, yAbove);
+    const std::vector<long> below  = locateLine(k, yBelow);
+    for (long x = 0; x < width; ++x)
+    {
+      if (above[x] < 0)
+      {
+        continue;
+      }
+      for (long xBelow = std::max(0L, x - neighbours); xBelow <= std::min(width - 1, x + neighbours); ++xBelow)
+      {
+        if (below[xBelow] >= 0 && label(xBelow, yBelow) == label(x, yAbove))
+        {
+          parent[find(above[x])] = find(below[xBelow]);
+        }
+      }
+    }
   }
 
-  this->SetNthOutput(0, ogrDS);
+  // Regions, in the order of their first feature
+  std::vector<std::vector<std::size_t>> regions;
+  std::vector<long>                     regionOfRoot(features.size(), -1);
+  for (std::size_t i = 0; i < features.size(); ++i)
+  {
+    const std::size_t root = find(i);
+    if (regionOfRoot[root] < 0)
+    {
+      regionOfRoot[root] = regions.size();
+      regions.emplace_back();
+    }
+    regions[regionOfRoot[root]].push_back(i);
+  }
 
-  // Clear memory
-  GDALClose(dataset);
+  for (const std::vector<std::size_t>& region : regions)
+  {
+    ogr::Feature dstFeature(layer.GetLayerDefn());
+    dstFeature.SetFrom(features[region.front()], TRUE);
+    if (region.size() > 1)
+    {
+      OGRMultiPolygon parts;
+      for (std::size_t i : region)
+      {
+        parts.addGeometry(features[i].GetGeometry());
+      }
+      dstFeature.SetGeometryDirectly(ogr::UnionCascaded(parts));
+    }
+    layer.CreateFeature(dstFeature);
+  }
 }
 
+template <class TInputImage>
+void LabelImageToOGRDataSourceFilter<TInputImage>::GenerateData(void)
+{
+  if (this->GetInput()->GetRequestedRegion() != this->GetInput()->GetLargestPossibleRegion())
+  {
+    itkExceptionMacro(<< "Not streamed filter. ERROR : requested region is not the largest possible region.");
+  }
+
+  // Create the output layer for GDALPolygonize().
+  ogr::DataSource::Pointer ogrDS = ogr::DataSource::New();
+
+  OGRLayerType outputLayer = ogrDS->CreateLayer("layer", nullptr, wkbPolygon);
+
+  OGRFieldDefn field(m_FieldName.c_str(), OFTInteger);
+  outputLayer.CreateField(field, true);
+
+  const typename SizeType::SizeValueType nbLines = this->GetInput()->GetLargestPossibleRegion().GetSize(1);
+
+  unsigned int nbStrips = std::max<itk::ThreadIdType>(1, this->GetNumberOfThreads());
+  nbStrips              = std::max<unsigned int>(1, std::min<typename SizeType::SizeValueType>(nbStrips, nbLines / std::max(1u, m_MinimumStripHeight)));
+
+  if (nbStrips == 1)
+  {
+    StripStruct strip;
+    strip.FirstLine     = 0;
+    strip.NumberOfLines = nbLines;
+    this->PolygonizeStrip(strip, outputLayer);
+  }
+  else
+  {
+    // Each strip is polygonized in its own memory layer
+    std::vector<StripStruct> strips(nbStrips);
+    for (unsigned int k = 0; k < nbStrips; ++k)
+    {
+      strips[k].FirstLine     = k * nbLines / nbStrips;
+      strips[k].NumberOfLines = (k + 1) * nbLines / nbStrips - strips[k].FirstLine;
+      strips[k].DataSource    = ogr::DataSource::New();
+      OGRLayerType stripLayer = strips[k].DataSource->CreateLayer("layer", nullptr, wkbPolygon);
+      stripLayer.CreateField(field, true);
+    }
+
+    std::vector<std::string> errors(nbStrips);
+    PolygonizeThreadStruct   str;
+    str.Filter = this;
+    str.Strips = &strips;
+    str.Errors = &errors;
+
+    itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+    threader->SetNumberOfThreads(nbStrips);
+    threader->SetSingleMethod(PolygonizeThreaderCallback, &str);
+    threader->SingleMethodExecute();
+
+    for (const std::string& error : errors)
+    {
+      if (!error.empty())
+      {
+        itkExceptionMacro(<< "Cannot polygonize the input image: " << error);
+      }
+    }
+
+    this->MergeStrips(strips, outputLayer);
+  }
+
+  this->SetNthOutput(0, ogrDS);
+}
 
 } // end namespace otb
 
@@ -52,6 +52,18 @@ namespace otb
  *    - Setting the Origin/Size/Spacing of the output image
  *    - Using an existing image as support via SetOutputParametersFromImage(ImageBase)
  *
+ *  The features intersecting the requested region are fetched once with
+ *  the spatial filter of the layers (which uses the spatial index of the
+ *  data source, if any) and reprojected to the output projection if
+ *  needed. Each thread then only rasterizes the features whose envelope
+ *  intersects its own region, in a GDAL MEM dataset wrapping the output
+ *  buffer.
+ *
+ *  In CoverageFractionMode, each pixel touched by the geometries gets the
+ *  foreground value multiplied by the fraction of its area they cover,
+ *  estimated on a grid of CoverageSubdivision x CoverageSubdivision
+ *  sub-pixels rasterized in the same pass. The burn attribute and the
+ *  AllTouchedMode are then ignored.
  *
  * \ingroup OTBConversion
  */
@@ -142,27 +154,57 @@ public:
   itkGetConstReferenceMacro(AllTouchedMode, bool);
   itkBooleanMacro(AllTouchedMode);
 
+  /** Set/Get the CoverageFractionMode flag */
+  itkSetMacro(CoverageFractionMode, bool);
+  itkGetConstReferenceMacro(CoverageFractionMode, bool);
+  itkBooleanMacro(CoverageFractionMode);
+
+  /** Set/Get the number of sub-pixels per pixel side used to estimate the
+   * coverage fractions */
+  itkSetMacro(CoverageSubdivision, unsigned int);
+  itkGetConstReferenceMacro(CoverageSubdivision, unsigned int);
+
   /** Useful to set the output parameters from an existing image*/
   void SetOutputParametersFromImage(const ImageBaseType* image);
 
 protected:
-  void GenerateData() override;
-
   OGRDataSourceToLabelImageFilter();
   ~OGRDataSourceToLabelImageFilter() override
   {
+    ClearGeometries();
   }
 
   void GenerateOutputInformation() override;
 
+  /** Fetch the geometries intersecting the requested region */
+  void BeforeThreadedGenerateData() override;
+
+  /** Rasterize the geometries intersecting the region of the thread */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  void AfterThreadedGenerateData() override;
+
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
 private:
   OGRDataSourceToLabelImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  std::vector<OGRLayerH> m_SrcDataSetLayers;
-  std::vector<int>       m_BandsToBurn;
+  /** Wrap a buffer into a GDAL MEM dataset whose upper left corner is at
+   * the given physical point */
+  static GDALDatasetH CreateMemDataset(void* buffer, GDALDataType dataType, unsigned int sizeX, unsigned int sizeY, unsigned int nbBands,
+                                       std::size_t pixelOffset, std::size_t lineOffset, std::size_t bandOffset, const OutputOriginType& corner,
+                                       const OutputSpacingType& spacing);
+
+  void ClearGeometries();
+
+  std::vector<int> m_BandsToBurn;
+
+  // Geometries of the requested region (owned), with their envelope and
+  // their burn value
+  std::vector<OGRGeometryH> m_Geometries;
+  std::vector<OGREnvelope>  m_Envelopes;
+  std::vector<double>       m_BurnValues;
 
   // Field used to extract the burn value
   std::string m_BurnAttribute;
@@ -177,6 +219,8 @@ private:
   OutputImageInternalPixelType m_ForegroundValue;
   bool                         m_BurnAttributeMode;
   bool                         m_AllTouchedMode;
+  bool                         m_CoverageFractionMode;
+  unsigned int                 m_CoverageSubdivision;
 }; // end of class VectorDataToLabelImageFilter
 
 } // end of namespace otb
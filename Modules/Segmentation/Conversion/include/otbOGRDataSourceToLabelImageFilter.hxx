@@ -23,6 +23,7 @@
 
 #include "otbOGRDataSourceToLabelImageFilter.h"
 #include "otbOGRIOHelper.h"
+#include "otbOGRHelpers.h"
 #include "otbGdalDataTypeBridge.h"
 #include "otbImageMetadataInterfaceFactory.h"
 #include "itkMetaDataObject.h"
@@ -30,13 +31,22 @@
 #include "otbImage.h"
 
 #include "gdal_alg.h"
+#include "ogr_spatialref.h"
 #include "stdint.h" //needed for uintptr_t
 
+#include <algorithm>
+
 namespace otb
 {
 template <class TOutputImage>
 OGRDataSourceToLabelImageFilter<TOutputImage>::OGRDataSourceToLabelImageFilter()
-  : m_BurnAttribute("DN"), m_BackgroundValue(0), m_ForegroundValue(255), m_BurnAttributeMode(true), m_AllTouchedMode(false)
+  : m_BurnAttribute("DN"),
+    m_BackgroundValue(0),
+    m_ForegroundValue(255),
+    m_BurnAttributeMode(true),
+    m_AllTouchedMode(false),
+    m_CoverageFractionMode(false),
+    m_CoverageSubdivision(4)
 {
   this->SetNumberOfRequiredInputs(1);
 
@@ -134,18 +144,6 @@ void OGRDataSourceToLabelImageFilter<TOutputImage>::GenerateOutputInformation()
   outputPtr->SetSignedSpacing(m_OutputSpacing);
   outputPtr->SetOrigin(m_OutputOrigin);
   outputPtr->SetProjectionRef(this->GetOutputProjectionRef());
- 
-  // Generate the OGRLayers from the input OGRDataSource
-  for (unsigned int idx = 0; idx < this->GetNumberOfInputs(); ++idx)
-  {
-    OGRDataSourcePointerType ogrDS    = dynamic_cast<OGRDataSourceType*>(this->itk::ProcessObject::GetInput(idx));
-    const unsigned int       nbLayers = ogrDS->GetLayersCount();
-
-    for (unsigned int layer = 0; layer < nbLayers; ++layer)
-    {
-      m_SrcDataSetLayers.push_back(&(ogrDS->GetLayer(layer).ogr()));
-    }
-  }
 
   // Set the NoData value using the background
   const unsigned int& nbBands = outputPtr->GetNumberOfComponentsPerPixel();
@@ -160,84 +158,289 @@ void OGRDataSourceToLabelImageFilter<TOutputImage>::GenerateOutputInformation()
 }
 
 template <class TOutputImage>
-void OGRDataSourceToLabelImageFilter<TOutputImage>::GenerateData()
+void OGRDataSourceToLabelImageFilter<TOutputImage>::ClearGeometries()
 {
-  // Call Superclass GenerateData
-  this->AllocateOutputs();
-
-  // Get the buffered region
-  OutputImageRegionType bufferedRegion = this->GetOutput()->GetBufferedRegion();
-
-  // nb bands
-  const unsigned int& nbBands = this->GetOutput()->GetNumberOfComponentsPerPixel();
-
-  // register drivers
-  GDALAllRegister();
+  for (OGRGeometryH geometry : m_Geometries)
+  {
+    OGR_G_DestroyGeometry(geometry);
+  }
+  m_Geometries.clear();
+  m_Envelopes.clear();
+  m_BurnValues.clear();
+}
 
+template <class TOutputImage>
+GDALDatasetH OGRDataSourceToLabelImageFilter<TOutputImage>::CreateMemDataset(void* buffer, GDALDataType dataType, unsigned int sizeX, unsigned int sizeY,
+                                                                             unsigned int nbBands, std::size_t pixelOffset, std::size_t lineOffset,
+                                                                             std::size_t bandOffset, const OutputOriginType& corner,
+                                                                             const OutputSpacingType& spacing)
+{
   std::ostringstream stream;
   stream << "MEM:::"
-         << "DATAPOINTER=" << (uintptr_t)(this->GetOutput()->GetBufferPointer()) << ","
-         << "PIXELS=" << bufferedRegion.GetSize()[0] << ","
-         << "LINES=" << bufferedRegion.GetSize()[1] << ","
+         << "DATAPOINTER=" << (uintptr_t)(buffer) << ","
+         << "PIXELS=" << sizeX << ","
+         << "LINES=" << sizeY << ","
          << "BANDS=" << nbBands << ","
-         << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>()) << ","
-         << "PIXELOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands << ","
-         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands * bufferedRegion.GetSize()[0] << ","
-         << "BANDOFFSET=" << sizeof(OutputImageInternalPixelType);
+         << "DATATYPE=" << GDALGetDataTypeName(dataType) << ","
+         << "PIXELOFFSET=" << pixelOffset << ","
+         << "LINEOFFSET=" << lineOffset << ","
+         << "BANDOFFSET=" << bandOffset;
 
   GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
+  if (dataset != nullptr)
+  {
+    // FIXME: Here component 2 and 4 should be replaced by the orientation parameters
+    double geoTransform[6] = {corner[0], spacing[0], 0., corner[1], 0., spacing[1]};
+    GDALSetGeoTransform(dataset, geoTransform);
+  }
+  return dataset;
+}
 
-  // Add the projection ref to the dataset
-  GDALSetProjection(dataset, this->GetOutput()->GetProjectionRef().c_str());
+template <class TOutputImage>
+void OGRDataSourceToLabelImageFilter<TOutputImage>::BeforeThreadedGenerateData()
+{
+  ClearGeometries();
+
+  // register drivers
+  GDALAllRegister();
 
-  // Set the nodata value
-  for (unsigned int band = 0; band < nbBands; ++band)
+  OutputImageType* outputPtr = this->GetOutput();
+  m_BandsToBurn.clear();
+  for (unsigned int band = 0; band < outputPtr->GetNumberOfComponentsPerPixel(); ++band)
   {
-    GDALRasterBandH hBand = GDALGetRasterBand(dataset, band + 1);
-    GDALFillRaster(hBand, m_BackgroundValue, 0);
+    m_BandsToBurn.push_back(band + 1);
   }
 
-  // add the geoTransform to the dataset
-  itk::VariableLengthVector<double> geoTransform(6);
-
-  // Reporting origin and spacing of the buffered region
-  // the spacing is unchanged, the origin is relative to the buffered region
-  OutputIndexType  bufferIndexOrigin = bufferedRegion.GetIndex();
-  OutputOriginType bufferOrigin;
-  this->GetOutput()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
-  geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetOutput()->GetSignedSpacing()[1];
-  geoTransform[1] = this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[5] = this->GetOutput()->GetSignedSpacing()[1];
-
-  // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
-  geoTransform[2] = 0.;
-  geoTransform[4] = 0.;
-  GDALSetGeoTransform(dataset, const_cast<double*>(geoTransform.GetDataPointer()));
-
-  // Burn the geometries into the dataset
-  if (dataset != nullptr)
+  // Extent of the requested region
+  const OutputImageRegionType& requestedRegion = outputPtr->GetRequestedRegion();
+  itk::ContinuousIndex<double> startIndex(requestedRegion.GetIndex());
+  itk::ContinuousIndex<double> endIndex(requestedRegion.GetUpperIndex());
+  startIndex[0] += -0.5;
+  startIndex[1] += -0.5;
+  endIndex[0] += 0.5;
+  endIndex[1] += 0.5;
+  itk::Point<double, 2> startPoint, endPoint;
+  outputPtr->TransformContinuousIndexToPhysicalPoint(startIndex, startPoint);
+  outputPtr->TransformContinuousIndexToPhysicalPoint(endIndex, endPoint);
+
+  OGRSpatialReference outputSRS;
+  const bool          hasOutputSRS = !m_OutputProjectionRef.empty() && outputSRS.SetFromUserInput(m_OutputProjectionRef.c_str()) == OGRERR_NONE;
+#if GDAL_VERSION_NUM >= 3000000
+  outputSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+
+  const bool burnAttribute = m_BurnAttributeMode && !m_CoverageFractionMode;
+  for (unsigned int idx = 0; idx < this->GetNumberOfInputs(); ++idx)
   {
-    std::vector<std::string> options;
+    OGRDataSourceType* ogrDS = dynamic_cast<OGRDataSourceType*>(this->itk::ProcessObject::GetInput(idx));
+    for (unsigned int layerIdx = 0; layerIdx < ogrDS->GetLayersCount(); ++layerIdx)
+    {
+      OGRLayerType layer = ogrDS->GetLayer(layerIdx);
+
+      // Geometries are reprojected to the output projection, as
+      // GDALRasterizeLayers does
+      OGRCoordinateTransformation* toOutput = nullptr;
+      OGRCoordinateTransformation* toLayer  = nullptr;
+      OGRSpatialReference const*   layerSRS = layer.GetSpatialRef();
+      if (hasOutputSRS && layerSRS && !layerSRS->IsSame(&outputSRS))
+      {
+        OGRSpatialReference sourceSRS(*layerSRS);
+#if GDAL_VERSION_NUM >= 3000000
+        sourceSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+        toOutput = OGRCreateCoordinateTransformation(&sourceSRS, &outputSRS);
+        toLayer  = OGRCreateCoordinateTransformation(&outputSRS, &sourceSRS);
+      }
+
+      // Only fetch the features of the requested region
+      double xs[4] = {startPoint[0], endPoint[0], endPoint[0], startPoint[0]};
+      double ys[4] = {startPoint[1], startPoint[1], endPoint[1], endPoint[1]};
+      if (toLayer && !toLayer->Transform(4, xs, ys))
+      {
+        OGRCoordinateTransformation::DestroyCT(toLayer);
+        toLayer = nullptr;
+      }
+      if (!toOutput || toLayer)
+      {
+        layer.SetSpatialFilterRect(*std::min_element(xs, xs + 4), *std::min_element(ys, ys + 4), *std::max_element(xs, xs + 4),
+                                   *std::max_element(ys, ys + 4));
+      }
+
+      int fieldIndex = -1;
+      if (burnAttribute)
+      {
+        fieldIndex = layer.GetLayerDefn().GetFieldIndex(m_BurnAttribute.c_str());
+        if (fieldIndex < 0)
+        {
+          itkExceptionMacro(<< "Field named " << m_BurnAttribute << " not found in layer " << layer.GetName());
+        }
+      }
+
+      for (typename OGRLayerType::const_iterator featIt = layer.cbegin(); featIt != layer.cend(); ++featIt)
+      {
+        OGRGeometry const* geometry = featIt->GetGeometry();
+        if (geometry == nullptr)
+        {
+          continue;
+        }
+        OGRGeometry* clone = geometry->clone();
+        if (toOutput && clone->transform(toOutput) != OGRERR_NONE)
+        {
+          OGRGeometryFactory::destroyGeometry(clone);
+          continue;
+        }
+        OGREnvelope envelope;
+        clone->getEnvelope(&envelope);
+        m_Geometries.push_back(reinterpret_cast<OGRGeometryH>(clone));
+        m_Envelopes.push_back(envelope);
+        const double burnValue = m_CoverageFractionMode ? 1. : (burnAttribute ? featIt->ogr().GetFieldAsDouble(fieldIndex) : m_ForegroundValue);
+        m_BurnValues.insert(m_BurnValues.end(), m_BandsToBurn.size(), burnValue);
+      }
+
+      layer.SetSpatialFilter(nullptr);
+      if (toOutput)
+      {
+        OGRCoordinateTransformation::DestroyCT(toOutput);
+      }
+      if (toLayer)
+      {
+        OGRCoordinateTransformation::DestroyCT(toLayer);
+      }
+    }
+  }
+}
 
-    std::vector<double> foreground(nbBands * m_SrcDataSetLayers.size(), m_ForegroundValue);
+template <class TOutputImage>
+void OGRDataSourceToLabelImageFilter<TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType)
+{
+  OutputImageType*             outputPtr      = this->GetOutput();
+  const OutputImageRegionType& bufferedRegion = outputPtr->GetBufferedRegion();
+  const unsigned int           nbBands        = outputPtr->GetNumberOfComponentsPerPixel();
+  const unsigned int           sizeX          = outputRegionForThread.GetSize(0);
+  const unsigned int           sizeY          = outputRegionForThread.GetSize(1);
+  const std::size_t            lineLength     = static_cast<std::size_t>(bufferedRegion.GetSize(0)) * nbBands;
+
+  // First pixel of the region of the thread
+  OutputImageInternalPixelType* regionBuffer =
+      outputPtr->GetBufferPointer() + ((outputRegionForThread.GetIndex(1) - bufferedRegion.GetIndex(1)) * lineLength +
+                                       (outputRegionForThread.GetIndex(0) - bufferedRegion.GetIndex(0)) * nbBands);
+
+  // Fill with the background
+  for (unsigned int y = 0; y < sizeY; ++y)
+  {
+    std::fill(regionBuffer + y * lineLength, regionBuffer + y * lineLength + sizeX * nbBands, m_BackgroundValue);
+  }
 
-    if (m_BurnAttributeMode)
+  // Extent of the region, and upper left corner of its first pixel
+  const OutputSpacingType      spacing = outputPtr->GetSignedSpacing();
+  itk::ContinuousIndex<double> startIndex(outputRegionForThread.GetIndex());
+  itk::ContinuousIndex<double> endIndex(outputRegionForThread.GetUpperIndex());
+  startIndex[0] += -0.5;
+  startIndex[1] += -0.5;
+  endIndex[0] += 0.5;
+  endIndex[1] += 0.5;
+  OutputOriginType corner, endPoint;
+  outputPtr->TransformContinuousIndexToPhysicalPoint(startIndex, corner);
+  outputPtr->TransformContinuousIndexToPhysicalPoint(endIndex, endPoint);
+  const double minX = std::min(corner[0], endPoint[0]);
+  const double maxX = std::max(corner[0], endPoint[0]);
+  const double minY = std::min(corner[1], endPoint[1]);
+  const double maxY = std::max(corner[1], endPoint[1]);
+
+  // Geometries of the region, in their original order
+  std::vector<OGRGeometryH> geometries;
+  std::vector<double>       burnValues;
+  for (std::size_t i = 0; i < m_Geometries.size(); ++i)
+  {
+    const OGREnvelope& envelope = m_Envelopes[i];
+    if (envelope.MaxX >= minX && envelope.MinX <= maxX && envelope.MaxY >= minY && envelope.MinY <= maxY)
+    {
+      geometries.push_back(m_Geometries[i]);
+      burnValues.insert(burnValues.end(), m_BurnValues.begin() + i * nbBands, m_BurnValues.begin() + (i + 1) * nbBands);
+    }
+  }
+  if (geometries.empty())
+  {
+    return;
+  }
+
+  if (!m_CoverageFractionMode)
+  {
+    GDALDatasetH dataset = CreateMemDataset(regionBuffer, GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>(), sizeX, sizeY, nbBands,
+                                            sizeof(OutputImageInternalPixelType) * nbBands, sizeof(OutputImageInternalPixelType) * lineLength,
+                                            sizeof(OutputImageInternalPixelType), corner, spacing);
+    if (dataset == nullptr)
     {
-      options.push_back("ATTRIBUTE=" + m_BurnAttribute);
+      itkExceptionMacro(<< "Unable to wrap the output buffer in a GDAL MEM dataset");
     }
+
+    std::vector<std::string> options;
     if (m_AllTouchedMode)
     {
       options.push_back("ALL_TOUCHED=TRUE");
     }
+    GDALRasterizeGeometries(dataset, nbBands, &m_BandsToBurn[0], geometries.size(), &geometries[0], nullptr, nullptr, &burnValues[0],
+                            ogr::StringListConverter(options).to_ogr(), nullptr, nullptr);
+    GDALClose(dataset);
+    return;
+  }
+
+  // Coverage fractions: rasterize sub-pixels by blocks of lines
+  const unsigned int         k         = std::max(1U, m_CoverageSubdivision);
+  const std::size_t          fineSizeX = static_cast<std::size_t>(sizeX) * k;
+  const unsigned int         blockY    = std::max<std::size_t>(1, (std::size_t(1) << 24) / (fineSizeX * k));
+  std::vector<unsigned char> fine;
+  OutputSpacingType          fineSpacing = spacing;
+  fineSpacing[0] /= k;
+  fineSpacing[1] /= k;
+  for (unsigned int y0 = 0; y0 < sizeY; y0 += blockY)
+  {
+    const unsigned int nbLines = std::min(blockY, sizeY - y0);
+    fine.assign(fineSizeX * nbLines * k, 0);
 
-    GDALRasterizeLayers(dataset, nbBands, &m_BandsToBurn[0], m_SrcDataSetLayers.size(), &(m_SrcDataSetLayers[0]), nullptr, nullptr, &foreground[0],
-                        ogr::StringListConverter(options).to_ogr(), nullptr, nullptr);
-    // release the dataset
+    OutputOriginType blockCorner = corner;
+    blockCorner[1] += y0 * spacing[1];
+    GDALDatasetH dataset = CreateMemDataset(&fine[0], GDT_Byte, fineSizeX, nbLines * k, 1, 1, fineSizeX, 1, blockCorner, fineSpacing);
+    if (dataset == nullptr)
+    {
+      itkExceptionMacro(<< "Unable to create a GDAL MEM dataset for the coverage fractions");
+    }
+    int band = 1;
+    GDALRasterizeGeometries(dataset, 1, &band, geometries.size(), &geometries[0], nullptr, nullptr, &burnValues[0], nullptr, nullptr, nullptr);
     GDALClose(dataset);
+
+    // burnValues holds nbBands values per geometry, the first one is used
+    // with the single band: burn values are all 1 in this mode
+    for (unsigned int y = 0; y < nbLines; ++y)
+    {
+      OutputImageInternalPixelType* outLine = regionBuffer + (y0 + y) * lineLength;
+      for (unsigned int x = 0; x < sizeX; ++x)
+      {
+        unsigned int covered = 0;
+        for (unsigned int j = 0; j < k; ++j)
+        {
+          const unsigned char* fineLine = &fine[(y * k + j) * fineSizeX + x * k];
+          for (unsigned int i = 0; i < k; ++i)
+          {
+            covered += fineLine[i];
+          }
+        }
+        if (covered > 0)
+        {
+          const double fraction = static_cast<double>(covered) / (k * k);
+          std::fill(outLine + x * nbBands, outLine + (x + 1) * nbBands, static_cast<OutputImageInternalPixelType>(fraction * m_ForegroundValue));
+        }
+      }
+    }
   }
 }
 
+template <class TOutputImage>
+void OGRDataSourceToLabelImageFilter<TOutputImage>::AfterThreadedGenerateData()
+{
+  ClearGeometries();
+}
+
 template <class TOutputImage>
 void OGRDataSourceToLabelImageFilter<TOutputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
 {
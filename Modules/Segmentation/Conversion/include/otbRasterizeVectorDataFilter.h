@@ -24,6 +24,7 @@
 #include "itkUnaryFunctorImageFilter.h"
 #include "itkImageToImageFilter.h"
 #include "itkCastImageFilter.h"
+#include "itkMultiThreader.h"
 #include "otbMacro.h"
 
 #include "otbVectorData.h"
@@ -31,6 +32,8 @@
 #include "gdal.h"
 #include "gdal_alg.h"
 #include "ogr_srs_api.h"
+#include <string>
+#include <vector>
 
 namespace otb
 {
@@ -53,9 +56,12 @@ namespace otb
  *  Again, the color will be duplicated if only one burnValuesPix
  *  is set.
  *
- *  Note : The VectorDatas and the input raster must be in the same
- *  projectionRef. Nothing is done in this class to reproject the
- *  VectorData into the image coordinate system.
+ *  The geometries are converted once, when the output information is
+ *  generated, and kept with their envelope. The output is then split
+ *  in one region per thread, and each thread only burns the geometries
+ *  intersecting its region. Geometries whose projectionRef differs
+ *  from the one of the image are reprojected, as GDALRasterizeLayers
+ *  does.
  *
  * \ingroup OTBConversion
  */
@@ -140,29 +146,45 @@ public:
   }
 
 protected:
+  /** Copy the input, then burn the geometries with one region per thread.
+   * The thread regions are handled here since CastImageFilter does not
+   * call ThreadedGenerateData() when running in place. */
   void GenerateData() override;
 
   RasterizeVectorDataFilter();
   ~RasterizeVectorDataFilter() override
   {
-    if (m_OGRDataSourcePointer != nullptr)
-    {
-      GDALClose(m_OGRDataSourcePointer);
-    }
+    ClearGeometries();
   }
 
+  /** Set the output information, and convert the geometries of the VectorDatas */
   void GenerateOutputInformation() override;
 
+  /** Burn the geometries intersecting a region of the output */
+  void RasterizeRegion(const OutputImageRegionType& region);
+
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
 
 private:
   RasterizeVectorDataFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  GDALDataset* m_OGRDataSourcePointer;
+  struct RasterizeThreadStruct
+  {
+    Self*                     Filter;
+    std::vector<std::string>* Errors;
+  };
+
+  static ITK_THREAD_RETURN_TYPE RasterizeThreaderCallback(void* arg);
+
+  /** Destroy the stored geometries */
+  void ClearGeometries();
 
-  // Vector Of LayersH
-  std::vector<OGRLayerH> m_SrcDataSetLayers;
+  // Vector Of OGRGeometryH (owned), with their envelope and their
+  // burn values (one per band to burn)
+  std::vector<OGRGeometryH> m_SrcDataSetGeometries;
+  std::vector<OGREnvelope>  m_SrcDataSetEnvelopes;
+  std::vector<double>       m_SrcDataSetBurnValues;
 
   std::vector<double> m_BurnValues;
   std::vector<double> m_FullBurnValues;
@@ -24,11 +24,14 @@
 #include "otbRasterizeVectorDataFilter.h"
 #include "otbOGRIOHelper.h"
 #include "otbGdalDataTypeBridge.h"
+#include "itkContinuousIndex.h"
+#include "ogrsf_frmts.h"
+#include <algorithm>
 
 namespace otb
 {
 template <class TVectorData, class TInputImage, class TOutputImage>
-RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::RasterizeVectorDataFilter() : m_OGRDataSourcePointer(nullptr), m_AllTouchedMode(false)
+RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::RasterizeVectorDataFilter() : m_AllTouchedMode(false)
 {
   this->SetNumberOfRequiredInputs(1);
 }
@@ -54,8 +57,20 @@ void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::Generate
 {
   Superclass::GenerateOutputInformation();
 
+  ClearGeometries();
+
+  // Geometries are reprojected to the projection of the image, as
+  // GDALRasterizeLayers does
+  OGRSpatialReference outputSRS;
+  const std::string   outputProjectionRef = this->GetOutput()->GetProjectionRef();
+  const bool          hasOutputSRS        = !outputProjectionRef.empty() && outputSRS.SetFromUserInput(outputProjectionRef.c_str()) == OGRERR_NONE;
+#if GDAL_VERSION_NUM >= 3000000
+  outputSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+
   // Generate the OGRLayers from the input VectorDatas
   // iteration begin from 1 cause the 0th input is a image
+  std::vector<std::vector<OGRGeometryH>> layerGeometries;
   for (unsigned int idx = 1; idx < this->GetNumberOfInputs(); ++idx)
   {
     const VectorDataType* vd = dynamic_cast<const VectorDataType*>(this->itk::ProcessObject::GetInput(idx));
@@ -87,15 +102,56 @@ void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::Generate
     otb::OGRIOHelper::Pointer IOConversion = otb::OGRIOHelper::New();
 
     // The method ConvertDataTreeNodeToOGRLayers create the
-    // OGRDataSource but don t release it. Destruction is done in the
-    // destructor
-    m_OGRDataSourcePointer = nullptr;
-    ogrLayerVector         = IOConversion->ConvertDataTreeNodeToOGRLayers(inputRoot, m_OGRDataSourcePointer, ogrCurrentLayer, oSRS);
+    // OGRDataSource but don t release it. It is closed once the
+    // geometries are cloned.
+    GDALDataset* ogrDataSource = nullptr;
+    ogrLayerVector             = IOConversion->ConvertDataTreeNodeToOGRLayers(inputRoot, ogrDataSource, ogrCurrentLayer, oSRS);
 
-    // Cast OGRLayer* to OGRLayerH
+    // Clone the geometries of each layer
     for (unsigned int idx2 = 0; idx2 < ogrLayerVector.size(); ++idx2)
     {
-      m_SrcDataSetLayers.push_back((OGRLayerH)(ogrLayerVector[idx2]));
+      OGRLayer* ogrLayer = ogrLayerVector[idx2];
+
+      OGRCoordinateTransformation* toOutput = nullptr;
+      OGRSpatialReference const*   layerSRS = ogrLayer->GetSpatialRef();
+      if (hasOutputSRS && layerSRS && !layerSRS->IsSame(&outputSRS))
+      {
+        OGRSpatialReference sourceSRS(*layerSRS);
+#if GDAL_VERSION_NUM >= 3000000
+        sourceSRS.SetAxisMappingStrategy(OAMS_TRADITIONAL_GIS_ORDER);
+#endif
+        toOutput = OGRCreateCoordinateTransformation(&sourceSRS, &outputSRS);
+      }
+
+      layerGeometries.emplace_back();
+      ogrLayer->ResetReading();
+      while (OGRFeature* feature = ogrLayer->GetNextFeature())
+      {
+        OGRGeometry const* geometry = feature->GetGeometryRef();
+        if (geometry != nullptr)
+        {
+          OGRGeometry* clone = geometry->clone();
+          if (toOutput && clone->transform(toOutput) != OGRERR_NONE)
+          {
+            OGRGeometryFactory::destroyGeometry(clone);
+          }
+          else
+          {
+            layerGeometries.back().push_back(reinterpret_cast<OGRGeometryH>(clone));
+          }
+        }
+        OGRFeature::DestroyFeature(feature);
+      }
+
+      if (toOutput)
+      {
+        OGRCoordinateTransformation::DestroyCT(toOutput);
+      }
+    }
+
+    if (ogrDataSource != nullptr)
+    {
+      GDALClose(ogrDataSource);
     }
 
     // Destroy the oSRS
@@ -110,22 +166,50 @@ void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::Generate
   // There should be "m_BandsToBurn.size()" burn values for each layer.
   // If not, burn values vector will be cloned as many time as the number of
   // OGRLayer we have
-  if (m_BurnValues.size() != m_BandsToBurn.size() * m_SrcDataSetLayers.size())
+  if (m_BurnValues.size() != m_BandsToBurn.size() * layerGeometries.size())
   {
     std::ostringstream oss;
-    oss << "Inconsistency detected : expected burn vector size to be equal to( bandToBurn * nb layers = " << m_BandsToBurn.size() * m_SrcDataSetLayers.size()
+    oss << "Inconsistency detected : expected burn vector size to be equal to( bandToBurn * nb layers = " << m_BandsToBurn.size() * layerGeometries.size()
         << " ), got :  " << m_BurnValues.size() << std::endl;
     itkWarningMacro(<< oss.str());
   }
 
   // Clone the burn values to fit the condition
-  for (unsigned int idx = 0; idx < m_SrcDataSetLayers.size(); ++idx)
+  m_FullBurnValues.clear();
+  for (unsigned int idx = 0; idx < layerGeometries.size(); ++idx)
   {
     for (unsigned int burnidx = 0; burnidx < m_BurnValues.size(); ++burnidx)
     {
       m_FullBurnValues.push_back(m_BurnValues[burnidx]);
     }
   }
+
+  // Each geometry gets the burn values of its layer
+  const std::size_t nbBandsToBurn = m_BandsToBurn.size();
+  for (unsigned int idx = 0; idx < layerGeometries.size(); ++idx)
+  {
+    for (OGRGeometryH geometry : layerGeometries[idx])
+    {
+      OGREnvelope envelope;
+      OGR_G_GetEnvelope(geometry, &envelope);
+      m_SrcDataSetGeometries.push_back(geometry);
+      m_SrcDataSetEnvelopes.push_back(envelope);
+      m_SrcDataSetBurnValues.insert(m_SrcDataSetBurnValues.end(), m_FullBurnValues.begin() + idx * nbBandsToBurn,
+                                    m_FullBurnValues.begin() + (idx + 1) * nbBandsToBurn);
+    }
+  }
+}
+
+template <class TVectorData, class TInputImage, class TOutputImage>
+void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::ClearGeometries()
+{
+  for (OGRGeometryH geometry : m_SrcDataSetGeometries)
+  {
+    OGR_G_DestroyGeometry(geometry);
+  }
+  m_SrcDataSetGeometries.clear();
+  m_SrcDataSetEnvelopes.clear();
+  m_SrcDataSetBurnValues.clear();
 }
 
 template <class TVectorData, class TInputImage, class TOutputImage>
@@ -134,48 +218,128 @@ void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::Generate
   // Call Superclass GenerateData
   Superclass::GenerateData();
 
-  // Get the buffered region
-  OutputImageRegionType bufferedRegion = this->GetOutput()->GetBufferedRegion();
-
-  // nb bands
-  unsigned int nbBands = this->GetOutput()->GetNumberOfComponentsPerPixel();
+  if (m_SrcDataSetGeometries.empty() || m_BandsToBurn.empty())
+  {
+    return;
+  }
 
   // register drivers
   GDALAllRegister();
 
+  std::vector<std::string> errors(this->GetNumberOfThreads());
+  RasterizeThreadStruct    str;
+  str.Filter = this;
+  str.Errors = &errors;
+
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(this->GetNumberOfThreads());
+  threader->SetSingleMethod(RasterizeThreaderCallback, &str);
+  threader->SingleMethodExecute();
+
+  for (const std::string& error : errors)
+  {
+    if (!error.empty())
+    {
+      itkExceptionMacro(<< "Cannot rasterize the vector data: " << error);
+    }
+  }
+}
+
+template <class TVectorData, class TInputImage, class TOutputImage>
+ITK_THREAD_RETURN_TYPE RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::RasterizeThreaderCallback(void* arg)
+{
+  itk::MultiThreader::ThreadInfoStruct* info = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+  RasterizeThreadStruct*                str  = static_cast<RasterizeThreadStruct*>(info->UserData);
+
+  const itk::ThreadIdType threadId    = info->ThreadID;
+  const itk::ThreadIdType threadCount = info->NumberOfThreads;
+
+  try
+  {
+    OutputImageRegionType splitRegion;
+    const itk::ThreadIdType total = str->Filter->SplitRequestedRegion(threadId, threadCount, splitRegion);
+    if (threadId < total)
+    {
+      str->Filter->RasterizeRegion(splitRegion);
+    }
+  }
+  catch (std::exception const& e)
+  {
+    (*str->Errors)[threadId] = e.what();
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+template <class TVectorData, class TInputImage, class TOutputImage>
+void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::RasterizeRegion(const OutputImageRegionType& region)
+{
+  OutputImageType*             outputPtr      = this->GetOutput();
+  const OutputImageRegionType& bufferedRegion = outputPtr->GetBufferedRegion();
+  const unsigned int           nbBands        = outputPtr->GetNumberOfComponentsPerPixel();
+  const std::size_t            lineLength     = static_cast<std::size_t>(bufferedRegion.GetSize(0)) * nbBands;
+
+  // Extent of the region, and upper left corner of its first pixel
+  itk::ContinuousIndex<double> startIndex(region.GetIndex());
+  itk::ContinuousIndex<double> endIndex(region.GetUpperIndex());
+  startIndex[0] += -0.5;
+  startIndex[1] += -0.5;
+  endIndex[0] += 0.5;
+  endIndex[1] += 0.5;
+  InputPointType corner, endPoint;
+  outputPtr->TransformContinuousIndexToPhysicalPoint(startIndex, corner);
+  outputPtr->TransformContinuousIndexToPhysicalPoint(endIndex, endPoint);
+  OGREnvelope regionEnvelope;
+  regionEnvelope.MinX = std::min(corner[0], endPoint[0]);
+  regionEnvelope.MaxX = std::max(corner[0], endPoint[0]);
+  regionEnvelope.MinY = std::min(corner[1], endPoint[1]);
+  regionEnvelope.MaxY = std::max(corner[1], endPoint[1]);
+
+  // Geometries of the region, in their original order
+  const std::size_t         nbBandsToBurn = m_BandsToBurn.size();
+  std::vector<OGRGeometryH> geometries;
+  std::vector<double>       burnValues;
+  for (std::size_t i = 0; i < m_SrcDataSetGeometries.size(); ++i)
+  {
+    if (m_SrcDataSetEnvelopes[i].Intersects(regionEnvelope))
+    {
+      geometries.push_back(m_SrcDataSetGeometries[i]);
+      burnValues.insert(burnValues.end(), m_SrcDataSetBurnValues.begin() + i * nbBandsToBurn, m_SrcDataSetBurnValues.begin() + (i + 1) * nbBandsToBurn);
+    }
+  }
+  if (geometries.empty())
+  {
+    return;
+  }
+
+  // First pixel of the region
+  OutputImageInternalPixelType* regionBuffer =
+      outputPtr->GetBufferPointer() +
+      ((region.GetIndex(1) - bufferedRegion.GetIndex(1)) * lineLength + (region.GetIndex(0) - bufferedRegion.GetIndex(0)) * nbBands);
+
   std::ostringstream stream;
   stream << "MEM:::"
-         << "DATAPOINTER=" << (uintptr_t)(this->GetOutput()->GetBufferPointer()) << ","
-         << "PIXELS=" << bufferedRegion.GetSize()[0] << ","
-         << "LINES=" << bufferedRegion.GetSize()[1] << ","
+         << "DATAPOINTER=" << (uintptr_t)(regionBuffer) << ","
+         << "PIXELS=" << region.GetSize()[0] << ","
+         << "LINES=" << region.GetSize()[1] << ","
          << "BANDS=" << nbBands << ","
          << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>()) << ","
          << "PIXELOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands << ","
-         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands * bufferedRegion.GetSize()[0] << ","
+         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * lineLength << ","
          << "BANDOFFSET=" << sizeof(OutputImageInternalPixelType);
 
   GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
+  if (dataset == nullptr)
+  {
+    itkExceptionMacro(<< "Unable to wrap the output buffer in a GDAL MEM dataset");
+  }
 
   // Add the projection ref to the dataset
-  GDALSetProjection(dataset, this->GetOutput()->GetProjectionRef().c_str());
-
-  // add the geoTransform to the dataset
-  itk::VariableLengthVector<double> geoTransform(6);
-
-  // Reporting origin and spacing of the buffered region
-  // the spacing is unchanged, the origin is relative to the buffered region
-  InputIndexType bufferIndexOrigin = bufferedRegion.GetIndex();
-  InputPointType bufferOrigin;
-  this->GetOutput()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
-  geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetOutput()->GetSignedSpacing()[1];
-  geoTransform[1] = this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[5] = this->GetOutput()->GetSignedSpacing()[1];
-
-  // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
-  geoTransform[2] = 0.;
-  geoTransform[4] = 0.;
-  GDALSetGeoTransform(dataset, const_cast<double*>(geoTransform.GetDataPointer()));
+  GDALSetProjection(dataset, outputPtr->GetProjectionRef().c_str());
+
+  // FIXME: Here component 2 and 4 should be replaced by the orientation parameters
+  double geoTransform[6] = {corner[0], outputPtr->GetSignedSpacing()[0], 0., corner[1], 0., outputPtr->GetSignedSpacing()[1]};
+  GDALSetGeoTransform(dataset, geoTransform);
 
   char** options = nullptr;
   if (m_AllTouchedMode)
@@ -184,16 +348,13 @@ void RasterizeVectorDataFilter<TVectorData, TInputImage, TOutputImage>::Generate
   }
 
   // Burn the geometries into the dataset
-  if (dataset != nullptr)
-  {
-    GDALRasterizeLayers(dataset, m_BandsToBurn.size(), &(m_BandsToBurn[0]), m_SrcDataSetLayers.size(), &(m_SrcDataSetLayers[0]), nullptr, nullptr,
-                        &(m_FullBurnValues[0]), options, GDALDummyProgress, nullptr);
+  GDALRasterizeGeometries(dataset, nbBandsToBurn, &(m_BandsToBurn[0]), geometries.size(), &(geometries[0]), nullptr, nullptr, &(burnValues[0]), options,
+                          GDALDummyProgress, nullptr);
 
-    CSLDestroy(options);
+  CSLDestroy(options);
 
-    // release the dataset
-    GDALClose(dataset);
-  }
+  // release the dataset
+  GDALClose(dataset);
 }
 
 template <class TVectorData, class TInputImage, class TOutputImage>
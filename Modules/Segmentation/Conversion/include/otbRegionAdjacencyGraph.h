@@ -0,0 +1,140 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRegionAdjacencyGraph_h
+#define otbRegionAdjacencyGraph_h
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class RegionAdjacencyGraph
+ *
+ * Compact adjacency graph between the regions of a label image.
+ *
+ * The graph is built once from a list of label pairs (edges), which may
+ * contain duplicates, for instance one pair per pair of neighbour pixels.
+ * It is then stored in compressed sparse row form: a sorted array of the
+ * labels having neighbours, and for each of them a sorted range of its
+ * neighbour labels in a single flat array. This costs two labels per edge
+ * instead of one tree node per edge with a std::set based adjacency, and
+ * neighbours are read contiguously.
+ *
+ * \ingroup OTBConversion
+ */
+template <class TLabel>
+class RegionAdjacencyGraph
+{
+public:
+  typedef TLabel                          LabelType;
+  typedef std::pair<LabelType, LabelType> EdgeType;
+  typedef std::vector<EdgeType>           EdgeListType;
+  typedef std::vector<LabelType>          LabelListType;
+
+  /** Range of the neighbour labels of a region */
+  class NeighbourRange
+  {
+  public:
+    NeighbourRange(const LabelType* first, const LabelType* last) : m_First(first), m_Last(last)
+    {
+    }
+    const LabelType* begin() const
+    {
+      return m_First;
+    }
+    const LabelType* end() const
+    {
+      return m_Last;
+    }
+    std::size_t size() const
+    {
+      return m_Last - m_First;
+    }
+    bool empty() const
+    {
+      return m_First == m_Last;
+    }
+
+  private:
+    const LabelType* m_First;
+    const LabelType* m_Last;
+  };
+
+  RegionAdjacencyGraph()
+  {
+  }
+
+  /** Builds the graph from the edges of each list. The lists are consumed.
+   * When symmetric is true, each edge (a, b) also makes b a neighbour of a,
+   * otherwise only b is added to the neighbours of a. */
+  void Build(std::vector<EdgeListType>& edgeLists, bool symmetric);
+
+  /** Same as above with a single list of edges */
+  void Build(EdgeListType& edges, bool symmetric);
+
+  /** Removes all regions and edges */
+  void Clear();
+
+  /** Number of regions having at least one neighbour */
+  std::size_t GetNumberOfRegions() const
+  {
+    return m_Labels.size();
+  }
+
+  /** Number of stored (directed) edges */
+  std::size_t GetNumberOfEdges() const
+  {
+    return m_Neighbours.size();
+  }
+
+  /** Sorted labels of the regions having at least one neighbour */
+  const LabelListType& GetRegionLabels() const
+  {
+    return m_Labels;
+  }
+
+  /** Neighbours of the i-th region of GetRegionLabels() */
+  NeighbourRange GetNeighboursOfRegion(std::size_t i) const
+  {
+    return NeighbourRange(m_Neighbours.data() + m_Offsets[i], m_Neighbours.data() + m_Offsets[i + 1]);
+  }
+
+  /** Neighbours of the region of the given label (empty if it has none) */
+  NeighbourRange GetNeighbours(LabelType label) const;
+
+private:
+  /** Sorted labels of the regions */
+  LabelListType m_Labels;
+  /** Start of the neighbours of each region in m_Neighbours, plus the end */
+  std::vector<std::size_t> m_Offsets;
+  /** Concatenated sorted neighbour labels */
+  LabelListType m_Neighbours;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbRegionAdjacencyGraph.hxx"
+#endif
+
+#endif
@@ -0,0 +1,104 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbRegionAdjacencyGraph_hxx
+#define otbRegionAdjacencyGraph_hxx
+
+#include "otbRegionAdjacencyGraph.h"
+#include <algorithm>
+
+namespace otb
+{
+
+template <class TLabel>
+void RegionAdjacencyGraph<TLabel>::Build(std::vector<EdgeListType>& edgeLists, bool symmetric)
+{
+  // Gather all edges in a single list
+  std::size_t nbEdges = 0;
+  for (const auto& edges : edgeLists)
+  {
+    nbEdges += edges.size();
+  }
+
+  EdgeListType allEdges;
+  allEdges.reserve(symmetric ? 2 * nbEdges : nbEdges);
+  for (auto& edges : edgeLists)
+  {
+    allEdges.insert(allEdges.end(), edges.begin(), edges.end());
+    EdgeListType().swap(edges);
+  }
+  this->Build(allEdges, symmetric);
+}
+
+template <class TLabel>
+void RegionAdjacencyGraph<TLabel>::Build(EdgeListType& edges, bool symmetric)
+{
+  this->Clear();
+
+  if (symmetric)
+  {
+    const std::size_t nbEdges = edges.size();
+    edges.reserve(2 * nbEdges);
+    for (std::size_t i = 0; i < nbEdges; ++i)
+    {
+      edges.push_back(EdgeType(edges[i].second, edges[i].first));
+    }
+  }
+
+  std::sort(edges.begin(), edges.end());
+  edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+
+  m_Neighbours.reserve(edges.size());
+  for (const auto& edge : edges)
+  {
+    if (m_Labels.empty() || m_Labels.back() != edge.first)
+    {
+      m_Labels.push_back(edge.first);
+      m_Offsets.push_back(m_Neighbours.size());
+    }
+    m_Neighbours.push_back(edge.second);
+  }
+  m_Offsets.push_back(m_Neighbours.size());
+
+  EdgeListType().swap(edges);
+}
+
+template <class TLabel>
+void RegionAdjacencyGraph<TLabel>::Clear()
+{
+  m_Labels.clear();
+  m_Offsets.clear();
+  m_Neighbours.clear();
+}
+
+template <class TLabel>
+typename RegionAdjacencyGraph<TLabel>::NeighbourRange RegionAdjacencyGraph<TLabel>::GetNeighbours(LabelType label) const
+{
+  const auto it = std::lower_bound(m_Labels.begin(), m_Labels.end(), label);
+  if (it == m_Labels.end() || *it != label)
+  {
+    return NeighbourRange(nullptr, nullptr);
+  }
+  return this->GetNeighboursOfRegion(it - m_Labels.begin());
+}
+
+} // end namespace otb
+
+#endif
@@ -30,6 +30,7 @@
 #include "gdal.h"
 #include "ogr_api.h"
 #include <string>
+#include <vector>
 
 namespace otb
 {
@@ -47,6 +48,11 @@ namespace otb
  *
  *  OGRRegisterAll() method must have been called before applying filter.
  *
+ *  The geometries are converted once, when the output information is
+ *  generated, and kept with their envelope. Each thread then only burns
+ *  the geometries intersecting its own region, which keeps the streaming
+ *  of small tiles over many geometries cheap.
+ *
  *
  * \ingroup OTBConversion
  */
@@ -137,23 +143,18 @@ public:
   void SetOutputParametersFromImage(const ImageBaseType* image);
 
 protected:
-  void GenerateData() override;
+  void BeforeThreadedGenerateData() override;
+
+  /** Burn the geometries intersecting the region of the thread */
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
 
   VectorDataToLabelImageFilter();
   ~VectorDataToLabelImageFilter() override
   {
-    // Destroy the geometries stored
-    for (unsigned int idx = 0; idx < m_SrcDataSetGeometries.size(); ++idx)
-    {
-      OGR_G_DestroyGeometry(m_SrcDataSetGeometries[idx]);
-    }
-
-    if (m_OGRDataSourcePointer != nullptr)
-    {
-      GDALClose(m_OGRDataSourcePointer);
-    }
+    ClearGeometries();
   }
 
+  /** Set the output information, and convert the geometries of the VectorDatas */
   void GenerateOutputInformation() override;
 
   void PrintSelf(std::ostream& os, itk::Indent indent) const override;
@@ -162,10 +163,12 @@ private:
   VectorDataToLabelImageFilter(const Self&) = delete;
   void operator=(const Self&) = delete;
 
-  GDALDataset* m_OGRDataSourcePointer;
+  /** Destroy the stored geometries */
+  void ClearGeometries();
 
-  // Vector Of OGRGeometyH
+  // Vector Of OGRGeometyH (owned), with their envelope
   std::vector<OGRGeometryH> m_SrcDataSetGeometries;
+  std::vector<OGREnvelope>  m_SrcDataSetEnvelopes;
 
   std::vector<double> m_BurnValues;
   std::vector<double> m_FullBurnValues;
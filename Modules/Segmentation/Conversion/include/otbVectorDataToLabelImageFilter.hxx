@@ -30,12 +30,14 @@
 #include "otbImageMetadataInterfaceBase.h"
 #include "otbImageMetadataInterfaceFactory.h"
 #include "otbImage.h"
+#include "itkContinuousIndex.h"
+#include <algorithm>
 
 namespace otb
 {
 template <class TVectorData, class TOutputImage>
 VectorDataToLabelImageFilter<TVectorData, TOutputImage>::VectorDataToLabelImageFilter()
-  : m_OGRDataSourcePointer(nullptr), m_BandsToBurn(1, 1), m_BurnAttribute("FID"), m_DefaultBurnValue(1.), m_BackgroundValue(0.), m_AllTouchedMode(false)
+  : m_BandsToBurn(1, 1), m_BurnAttribute("FID"), m_DefaultBurnValue(1.), m_BackgroundValue(0.), m_AllTouchedMode(false)
 {
   this->SetNumberOfRequiredInputs(1);
 
@@ -134,7 +136,7 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateOutputInfo
   itk::EncapsulateMetaData<std::string>(dict, MetaDataKey::ProjectionRefKey, static_cast<std::string>(this->GetOutputProjectionRef()));
 
   // Generate the OGRLayers from the input VectorDatas
-  // iteration begin from 1 cause the 0th input is a image
+  ClearGeometries();
   for (unsigned int idx = 0; idx < this->GetNumberOfInputs(); ++idx)
   {
     const VectorDataType* vd = dynamic_cast<const VectorDataType*>(this->itk::ProcessObject::GetInput(idx));
@@ -165,10 +167,10 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateOutputInfo
     otb::OGRIOHelper::Pointer IOConversion = otb::OGRIOHelper::New();
 
     // The method ConvertDataTreeNodeToOGRLayers create the
-    // OGRDataSource but don t release it. Destruction is done in the
-    // destructor
-    m_OGRDataSourcePointer = nullptr;
-    ogrLayerVector         = IOConversion->ConvertDataTreeNodeToOGRLayers(inputRoot, m_OGRDataSourcePointer, ogrCurrentLayer, oSRS);
+    // OGRDataSource but don t release it. It is closed once the
+    // geometries are cloned.
+    GDALDataset* ogrDataSource = nullptr;
+    ogrLayerVector             = IOConversion->ConvertDataTreeNodeToOGRLayers(inputRoot, ogrDataSource, ogrCurrentLayer, oSRS);
 
     // From OGRLayer* to OGRGeometryH vector
     for (unsigned int idx2 = 0; idx2 < ogrLayerVector.size(); ++idx2)
@@ -193,7 +195,10 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateOutputInfo
           }
 
           hGeom = OGR_G_Clone(OGR_F_GetGeometryRef(hFeat));
+          OGREnvelope envelope;
+          OGR_G_GetEnvelope(hGeom, &envelope);
           m_SrcDataSetGeometries.push_back(hGeom);
+          m_SrcDataSetEnvelopes.push_back(envelope);
 
           if (burnField == -1)
           {
@@ -211,67 +216,116 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateOutputInfo
           OGR_F_Destroy(hFeat);
         }
       }
+    }
 
-      // Destroy the oSRS
-      if (oSRS != nullptr)
-      {
-        OSRRelease(oSRS);
-      }
+    if (ogrDataSource != nullptr)
+    {
+      GDALClose(ogrDataSource);
+    }
+
+    // Destroy the oSRS
+    if (oSRS != nullptr)
+    {
+      OSRRelease(oSRS);
     }
   }
 }
 
 template <class TVectorData, class TOutputImage>
-void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateData()
+void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::ClearGeometries()
 {
-  // Call Superclass GenerateData
-  this->AllocateOutputs();
-
-  // Get the buffered region
-  OutputImageRegionType bufferedRegion = this->GetOutput()->GetBufferedRegion();
-
-  // Fill the buffer with the background value
-  this->GetOutput()->FillBuffer(m_BackgroundValue);
-
-  // nb bands
-  unsigned int nbBands = this->GetOutput()->GetNumberOfComponentsPerPixel();
+  for (OGRGeometryH geometry : m_SrcDataSetGeometries)
+  {
+    OGR_G_DestroyGeometry(geometry);
+  }
+  m_SrcDataSetGeometries.clear();
+  m_SrcDataSetEnvelopes.clear();
+  m_FullBurnValues.clear();
+}
 
+template <class TVectorData, class TOutputImage>
+void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::BeforeThreadedGenerateData()
+{
   // register drivers
   GDALAllRegister();
+}
+
+template <class TVectorData, class TOutputImage>
+void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType)
+{
+  OutputImageType*             outputPtr      = this->GetOutput();
+  const OutputImageRegionType& bufferedRegion = outputPtr->GetBufferedRegion();
+  const unsigned int           nbBands        = outputPtr->GetNumberOfComponentsPerPixel();
+  const unsigned int           sizeX          = outputRegionForThread.GetSize(0);
+  const unsigned int           sizeY          = outputRegionForThread.GetSize(1);
+  const std::size_t            lineLength     = static_cast<std::size_t>(bufferedRegion.GetSize(0)) * nbBands;
+
+  // First pixel of the region of the thread
+  OutputImageInternalPixelType* regionBuffer =
+      outputPtr->GetBufferPointer() + ((outputRegionForThread.GetIndex(1) - bufferedRegion.GetIndex(1)) * lineLength +
+                                       (outputRegionForThread.GetIndex(0) - bufferedRegion.GetIndex(0)) * nbBands);
+
+  // Fill the region with the background value
+  for (unsigned int y = 0; y < sizeY; ++y)
+  {
+    std::fill(regionBuffer + y * lineLength, regionBuffer + y * lineLength + sizeX * nbBands, m_BackgroundValue);
+  }
+
+  // Extent of the region, and upper left corner of its first pixel
+  itk::ContinuousIndex<double> startIndex(outputRegionForThread.GetIndex());
+  itk::ContinuousIndex<double> endIndex(outputRegionForThread.GetUpperIndex());
+  startIndex[0] += -0.5;
+  startIndex[1] += -0.5;
+  endIndex[0] += 0.5;
+  endIndex[1] += 0.5;
+  OutputOriginType corner, endPoint;
+  outputPtr->TransformContinuousIndexToPhysicalPoint(startIndex, corner);
+  outputPtr->TransformContinuousIndexToPhysicalPoint(endIndex, endPoint);
+  OGREnvelope regionEnvelope;
+  regionEnvelope.MinX = std::min(corner[0], endPoint[0]);
+  regionEnvelope.MaxX = std::max(corner[0], endPoint[0]);
+  regionEnvelope.MinY = std::min(corner[1], endPoint[1]);
+  regionEnvelope.MaxY = std::max(corner[1], endPoint[1]);
+
+  // Geometries of the region, in their original order
+  std::vector<OGRGeometryH> geometries;
+  std::vector<double>       burnValues;
+  for (std::size_t i = 0; i < m_SrcDataSetGeometries.size(); ++i)
+  {
+    if (m_SrcDataSetEnvelopes[i].Intersects(regionEnvelope))
+    {
+      geometries.push_back(m_SrcDataSetGeometries[i]);
+      burnValues.insert(burnValues.end(), m_BandsToBurn.size(), m_FullBurnValues[i]);
+    }
+  }
+  if (geometries.empty())
+  {
+    return;
+  }
 
   std::ostringstream stream;
   stream << "MEM:::"
-         << "DATAPOINTER=" << (uintptr_t)(this->GetOutput()->GetBufferPointer()) << ","
-         << "PIXELS=" << bufferedRegion.GetSize()[0] << ","
-         << "LINES=" << bufferedRegion.GetSize()[1] << ","
+         << "DATAPOINTER=" << (uintptr_t)(regionBuffer) << ","
+         << "PIXELS=" << sizeX << ","
+         << "LINES=" << sizeY << ","
          << "BANDS=" << nbBands << ","
          << "DATATYPE=" << GDALGetDataTypeName(GdalDataTypeBridge::GetGDALDataType<OutputImageInternalPixelType>()) << ","
          << "PIXELOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands << ","
-         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * nbBands * bufferedRegion.GetSize()[0] << ","
+         << "LINEOFFSET=" << sizeof(OutputImageInternalPixelType) * lineLength << ","
          << "BANDOFFSET=" << sizeof(OutputImageInternalPixelType);
 
   GDALDatasetH dataset = GDALOpen(stream.str().c_str(), GA_Update);
+  if (dataset == nullptr)
+  {
+    itkExceptionMacro(<< "Unable to wrap the output buffer in a GDAL MEM dataset");
+  }
 
   // Add the projection ref to the dataset
-  GDALSetProjection(dataset, this->GetOutput()->GetProjectionRef().c_str());
-
-  // add the geoTransform to the dataset
-  itk::VariableLengthVector<double> geoTransform(6);
-
-  // Reporting origin and spacing of the buffered region
-  // the spacing is unchanged, the origin is relative to the buffered region
-  OutputIndexType  bufferIndexOrigin = bufferedRegion.GetIndex();
-  OutputOriginType bufferOrigin;
-  this->GetOutput()->TransformIndexToPhysicalPoint(bufferIndexOrigin, bufferOrigin);
-  geoTransform[0] = bufferOrigin[0] - 0.5 * this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[3] = bufferOrigin[1] - 0.5 * this->GetOutput()->GetSignedSpacing()[1];
-  geoTransform[1] = this->GetOutput()->GetSignedSpacing()[0];
-  geoTransform[5] = this->GetOutput()->GetSignedSpacing()[1];
-
-  // FIXME: Here component 1 and 4 should be replaced by the orientation parameters
-  geoTransform[2] = 0.;
-  geoTransform[4] = 0.;
-  GDALSetGeoTransform(dataset, const_cast<double*>(geoTransform.GetDataPointer()));
+  GDALSetProjection(dataset, outputPtr->GetProjectionRef().c_str());
+
+  // FIXME: Here component 2 and 4 should be replaced by the orientation parameters
+  double geoTransform[6] = {corner[0], outputPtr->GetSignedSpacing()[0], 0., corner[1], 0., outputPtr->GetSignedSpacing()[1]};
+  GDALSetGeoTransform(dataset, geoTransform);
 
   char** options = nullptr;
   if (m_AllTouchedMode)
@@ -280,16 +334,13 @@ void VectorDataToLabelImageFilter<TVectorData, TOutputImage>::GenerateData()
   }
 
   // Burn the geometries into the dataset
-  if (dataset != nullptr)
-  {
-    GDALRasterizeGeometries(dataset, m_BandsToBurn.size(), &(m_BandsToBurn[0]), m_SrcDataSetGeometries.size(), &(m_SrcDataSetGeometries[0]), nullptr, nullptr,
-                            &(m_FullBurnValues[0]), options, GDALDummyProgress, nullptr);
+  GDALRasterizeGeometries(dataset, m_BandsToBurn.size(), &(m_BandsToBurn[0]), geometries.size(), &(geometries[0]), nullptr, nullptr, &(burnValues[0]),
+                          options, GDALDummyProgress, nullptr);
 
-    CSLDestroy(options);
+  CSLDestroy(options);
 
-    // release the dataset
-    GDALClose(dataset);
-  }
+  // release the dataset
+  GDALClose(dataset);
 }
 
 template <class TVectorData, class TOutputImage>
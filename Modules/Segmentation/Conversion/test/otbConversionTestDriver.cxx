@@ -24,12 +24,15 @@ void RegisterTests()
 {
   REGISTER_TEST(otbVectorDataToLabelMapFilter);
   REGISTER_TEST(otbOGRDataSourceToLabelImageFilter);
+  REGISTER_TEST(otbOGRDataSourceToLabelImageFilterCoverage);
   REGISTER_TEST(otbLabelImageToVectorDataFilter);
   REGISTER_TEST(otbLabelImageToOGRDataSourceFilter);
+  REGISTER_TEST(otbLabelImageToOGRDataSourceFilterStrips);
   REGISTER_TEST(otbVectorDataToLabelImageFilter);
   REGISTER_TEST(otbPolygonizationRasterizationTest);
   REGISTER_TEST(otbVectorDataRasterizeFilter);
   REGISTER_TEST(otbLabelImageRegionPruningFilter);
   REGISTER_TEST(otbLabelImageRegionMergingFilter);
+  REGISTER_TEST(otbRegionAdjacencyGraph);
   REGISTER_TEST(otbLabelMapToVectorDataFilter);
 }
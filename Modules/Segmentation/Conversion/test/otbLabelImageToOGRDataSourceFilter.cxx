@@ -23,6 +23,9 @@
 #include "otbImage.h"
 #include "otbImageFileReader.h"
 #include "otbVectorDataFileWriter.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <algorithm>
+#include <vector>
 
 
 int otbLabelImageToOGRDataSourceFilter(int argc, char* argv[])
@@ -54,3 +57,88 @@ int otbLabelImageToOGRDataSourceFilter(int argc, char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+namespace
+{
+typedef otb::Image<unsigned short, 2> StripsLabelImageType;
+
+// Labels and areas of the polygons, sorted
+std::vector<std::pair<int, double>> PolygonizeInStrips(StripsLabelImageType* image, unsigned int nbThreads, bool use8Connected)
+{
+  typedef otb::LabelImageToOGRDataSourceFilter<StripsLabelImageType> FilterType;
+  FilterType::Pointer                                                filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetUse8Connected(use8Connected);
+  filter->SetNumberOfThreads(nbThreads);
+  filter->SetMinimumStripHeight(3);
+  filter->Update();
+
+  std::vector<std::pair<int, double>> polygons;
+  otb::ogr::Layer layer = const_cast<otb::ogr::DataSource*>(filter->GetOutput())->GetLayerChecked(0);
+  for (otb::ogr::Layer::const_iterator it = layer.cbegin(); it != layer.cend(); ++it)
+  {
+    const OGRGeometry* geometry = it->GetGeometry();
+    double             area     = 0.0;
+    if (const OGRPolygon* polygon = dynamic_cast<const OGRPolygon*>(geometry))
+    {
+      area = polygon->get_Area();
+    }
+    else if (const OGRMultiPolygon* multiPolygon = dynamic_cast<const OGRMultiPolygon*>(geometry))
+    {
+      area = multiPolygon->get_Area();
+    }
+    polygons.push_back(std::make_pair((*it)["DN"].GetValue<int>(), area));
+  }
+  std::sort(polygons.begin(), polygons.end());
+  return polygons;
+}
+}
+
+int otbLabelImageToOGRDataSourceFilterStrips(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // Blocks of labels, and a U-shaped region only connected below the strips
+  // it crosses
+  StripsLabelImageType::RegionType region;
+  region.SetSize(0, 61);
+  region.SetSize(1, 47);
+  StripsLabelImageType::Pointer image = StripsLabelImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<StripsLabelImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const long x = it.GetIndex()[0];
+    const long y = it.GetIndex()[1];
+    if ((x == 40 || x == 50) && y >= 5 && y <= 40)
+    {
+      it.Set(9);
+    }
+    else if (x >= 40 && x <= 50 && y == 40)
+    {
+      it.Set(9);
+    }
+    else
+    {
+      it.Set((x / 7 + y / 5 + (x * y) % 3) % 4);
+    }
+  }
+
+  bool ok = true;
+  for (bool use8Connected : {false, true})
+  {
+    const std::vector<std::pair<int, double>> reference = PolygonizeInStrips(image, 1, use8Connected);
+    for (unsigned int nbThreads : {2, 5, 16})
+    {
+      const std::vector<std::pair<int, double>> polygons = PolygonizeInStrips(image, nbThreads, use8Connected);
+      if (polygons != reference)
+      {
+        std::cerr << polygons.size() << " polygons with " << nbThreads << " threads (8-connected: " << use8Connected << ") instead of " << reference.size()
+                  << ", or different areas" << std::endl;
+        ok = false;
+      }
+    }
+  }
+
+  return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -25,6 +25,7 @@
 
 #include "otbOGRDataSourceToLabelImageFilter.h"
 #include "otbStandardOneLineFilterWatcher.h"
+#include <cmath>
 
 typedef otb::Image<unsigned int, 2> ImageType;
 typedef otb::ImageFileReader<ImageType> ReaderType;
@@ -65,3 +66,61 @@ int otbOGRDataSourceToLabelImageFilter(int itkNotUsed(argc), char* argv[])
 
   return EXIT_SUCCESS;
 }
+
+int otbOGRDataSourceToLabelImageFilterCoverage(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::Image<float, 2> FloatImageType;
+  typedef otb::OGRDataSourceToLabelImageFilter<FloatImageType> CoverageFilterType;
+
+  // Rectangle [2, 6.5] x [3, 8.25]
+  otb::ogr::DataSource::Pointer ogrDS = otb::ogr::DataSource::New();
+  otb::ogr::Layer               layer = ogrDS->CreateLayer("polygons", nullptr, wkbPolygon);
+  OGRPolygon                    polygon;
+  OGRLinearRing                 ring;
+  ring.addPoint(2.0, 3.0, 0.0);
+  ring.addPoint(6.5, 3.0, 0.0);
+  ring.addPoint(6.5, 8.25, 0.0);
+  ring.addPoint(2.0, 8.25, 0.0);
+  ring.addPoint(2.0, 3.0, 0.0);
+  polygon.addRing(&ring);
+  otb::ogr::Feature feature(layer.GetLayerDefn());
+  feature.SetGeometry(&polygon);
+  layer.CreateFeature(feature);
+
+  // Pixel (x, y) covers [x, x + 1] x [y, y + 1]
+  CoverageFilterType::OutputSizeType size;
+  size.Fill(20);
+  CoverageFilterType::OutputOriginType origin;
+  origin.Fill(0.5);
+  CoverageFilterType::OutputSpacingType spacing;
+  spacing.Fill(1.0);
+
+  CoverageFilterType::Pointer rasterization = CoverageFilterType::New();
+  rasterization->AddOGRDataSource(ogrDS);
+  rasterization->SetOutputSize(size);
+  rasterization->SetOutputOrigin(origin);
+  rasterization->SetOutputSpacing(spacing);
+  rasterization->SetBackgroundValue(0);
+  rasterization->SetForegroundValue(1);
+  rasterization->CoverageFractionModeOn();
+  rasterization->SetCoverageSubdivision(4);
+  rasterization->Update();
+
+  FloatImageType::IndexType index;
+  const long                x[4]        = {1, 2, 6, 6};
+  const long                y[4]        = {5, 5, 5, 8};
+  const float               expected[4] = {0.f, 1.f, 0.5f, 0.125f};
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    index[0]          = x[i];
+    index[1]          = y[i];
+    const float value = rasterization->GetOutput()->GetPixel(index);
+    if (std::abs(value - expected[i]) > 1e-6)
+    {
+      std::cerr << "Pixel " << index << ": coverage " << value << " instead of " << expected[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbRegionAdjacencyGraph.h"
+#include <iostream>
+
+int otbRegionAdjacencyGraph(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  typedef otb::RegionAdjacencyGraph<unsigned int> GraphType;
+
+  // Two thread lists with duplicates: 1-2, 1-3, 2-3, 5-1
+  std::vector<GraphType::EdgeListType> edgeLists(2);
+  edgeLists[0].push_back(GraphType::EdgeType(1, 2));
+  edgeLists[0].push_back(GraphType::EdgeType(1, 2));
+  edgeLists[0].push_back(GraphType::EdgeType(3, 1));
+  edgeLists[1].push_back(GraphType::EdgeType(2, 3));
+  edgeLists[1].push_back(GraphType::EdgeType(2, 1));
+  edgeLists[1].push_back(GraphType::EdgeType(5, 1));
+
+  GraphType graph;
+  graph.Build(edgeLists, true);
+
+  const unsigned int expectedLabels[4]     = {1, 2, 3, 5};
+  const unsigned int expectedNeighbours[8] = {2, 3, 5, 1, 3, 1, 2, 1};
+  const unsigned int expectedCounts[4]     = {3, 2, 2, 1};
+
+  if (graph.GetNumberOfRegions() != 4 || graph.GetNumberOfEdges() != 8)
+  {
+    std::cerr << "Wrong graph size: " << graph.GetNumberOfRegions() << " regions, " << graph.GetNumberOfEdges() << " edges" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  unsigned int k = 0;
+  for (std::size_t i = 0; i < graph.GetNumberOfRegions(); ++i)
+  {
+    if (graph.GetRegionLabels()[i] != expectedLabels[i] || graph.GetNeighboursOfRegion(i).size() != expectedCounts[i])
+    {
+      std::cerr << "Wrong region " << i << ": label " << graph.GetRegionLabels()[i] << std::endl;
+      return EXIT_FAILURE;
+    }
+    for (unsigned int neighbour : graph.GetNeighbours(expectedLabels[i]))
+    {
+      if (neighbour != expectedNeighbours[k++])
+      {
+        std::cerr << "Wrong neighbour " << neighbour << " for label " << expectedLabels[i] << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  if (!graph.GetNeighbours(4).empty())
+  {
+    std::cerr << "Label 4 should have no neighbour" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Directed graph: only the first label of each edge has neighbours
+  GraphType::EdgeListType edges(1, GraphType::EdgeType(7, 8));
+  graph.Build(edges, false);
+  if (graph.GetNumberOfRegions() != 1 || graph.GetNeighbours(8).size() != 0 || graph.GetNeighbours(7).size() != 1)
+  {
+    std::cerr << "Wrong directed graph" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 1999-2011 Insight Software Consortium
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbConnectedComponentRelabelImageFilter_h
+#define otbConnectedComponentRelabelImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "otbStreamingConnectedComponentImageFilter.h"
+
+namespace otb
+{
+
+/** \class ConnectedComponentRelabelImageFilter
+ * \brief Second pass of a streamed connected component labelling.
+ *
+ * The input must be the image labelled by the
+ * PersistentConnectedComponentImageFilter given with
+ * SetLabellingFilter(), once synthetized. The regions of the first
+ * pass overlapping the requested region are labelled again, and their
+ * provisional labels are mapped to the final ones. The output labels
+ * are consistent across the whole image, whatever the streaming used.
+ *
+ * When the requested region is covered by a single region of the first
+ * pass, this costs one labelling of that region. Using the same
+ * streaming layout for both passes is then the cheapest.
+ *
+ * \sa PersistentConnectedComponentImageFilter
+ *
+ * \ingroup Streamed
+ *
+ * \ingroup OTBLabelling
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT ConnectedComponentRelabelImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef ConnectedComponentRelabelImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(ConnectedComponentRelabelImageFilter, ImageToImageFilter);
+
+  typedef TInputImage                           InputImageType;
+  typedef TOutputImage                          OutputImageType;
+  typedef typename OutputImageType::RegionType  RegionType;
+  typedef typename OutputImageType::PixelType   OutputPixelType;
+
+  typedef PersistentConnectedComponentImageFilter<TInputImage> LabellingFilterType;
+  typedef typename LabellingFilterType::LabelType              LabelType;
+  typedef typename LabellingFilterType::LabelVectorType        LabelVectorType;
+
+  /** Set/Get the first pass filter */
+  itkSetConstObjectMacro(LabellingFilter, LabellingFilterType);
+  itkGetConstObjectMacro(LabellingFilter, LabellingFilterType);
+
+protected:
+  ConnectedComponentRelabelImageFilter()
+  {
+  }
+  ~ConnectedComponentRelabelImageFilter() override
+  {
+  }
+
+  /** Request the bounding box of the first pass regions overlapping the
+   * output requested region */
+  void GenerateInputRequestedRegion() override;
+
+  void GenerateData() override;
+
+private:
+  ConnectedComponentRelabelImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  typename LabellingFilterType::ConstPointer m_LabellingFilter;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbConnectedComponentRelabelImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+/*
+ * Copyright (C) 1999-2011 Insight Software Consortium
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbConnectedComponentRelabelImageFilter_hxx
+#define otbConnectedComponentRelabelImageFilter_hxx
+
+#include "otbConnectedComponentRelabelImageFilter.h"
+#include "itkImageRegionIterator.h"
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputImage>
+void ConnectedComponentRelabelImageFilter<TInputImage, TOutputImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  if (m_LabellingFilter.IsNull())
+  {
+    itkExceptionMacro(<< "No labelling filter set");
+  }
+
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (!input)
+  {
+    return;
+  }
+
+  const RegionType requested = this->GetOutput()->GetRequestedRegion();
+
+  typename RegionType::IndexType start = requested.GetIndex();
+  typename RegionType::IndexType end   = requested.GetUpperIndex();
+  itk::SizeValueType             nbCoveredPixels = 0;
+  for (const auto& labelled : m_LabellingFilter->GetLabelledRegions())
+  {
+    RegionType overlap = labelled.region;
+    if (!overlap.Crop(requested))
+    {
+      continue;
+    }
+    nbCoveredPixels += overlap.GetNumberOfPixels();
+    const typename RegionType::IndexType upper = labelled.region.GetUpperIndex();
+    for (unsigned int dim = 0; dim < RegionType::ImageDimension; ++dim)
+    {
+      start[dim] = std::min(start[dim], labelled.region.GetIndex()[dim]);
+      end[dim]   = std::max(end[dim], upper[dim]);
+    }
+  }
+
+  if (nbCoveredPixels != requested.GetNumberOfPixels())
+  {
+    itkExceptionMacro(<< "Region " << requested << " has not been processed by the labelling filter");
+  }
+
+  RegionType inputRegion;
+  inputRegion.SetIndex(start);
+  inputRegion.SetUpperIndex(end);
+  input->SetRequestedRegion(inputRegion);
+}
+
+template <class TInputImage, class TOutputImage>
+void ConnectedComponentRelabelImageFilter<TInputImage, TOutputImage>::GenerateData()
+{
+  this->AllocateOutputs();
+
+  const InputImageType* input     = this->GetInput();
+  OutputImageType*      output    = this->GetOutput();
+  const RegionType      requested = output->GetRequestedRegion();
+
+  LabelVectorType labels;
+  for (const auto& labelled : m_LabellingFilter->GetLabelledRegions())
+  {
+    RegionType overlap = labelled.region;
+    if (!overlap.Crop(requested))
+    {
+      continue;
+    }
+
+    // The provisional labels of a region only depend on its content
+    LabellingFilterType::LabelRegion(input, labelled.region, m_LabellingFilter->GetBackgroundValue(), m_LabellingFilter->GetFullyConnected(),
+                                     labelled.firstLabel, labels, nullptr);
+
+    const itk::SizeValueType width = labelled.region.GetSize()[0];
+    itk::ImageRegionIterator<OutputImageType> outIt(output, overlap);
+    for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+    {
+      const typename RegionType::IndexType index = outIt.GetIndex();
+      const LabelType label = labels[(index[1] - labelled.region.GetIndex()[1]) * width + (index[0] - labelled.region.GetIndex()[0])];
+      outIt.Set(static_cast<OutputPixelType>(label == 0 ? 0 : m_LabellingFilter->GetFinalLabel(label)));
+    }
+  }
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,272 @@
+/*
+ * Copyright (C) 1999-2011 Insight Software Consortium
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingConnectedComponentImageFilter_h
+#define otbStreamingConnectedComponentImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include <cstdint>
+#include <vector>
+#include <unordered_map>
+
+namespace otb
+{
+
+/** \class PersistentConnectedComponentImageFilter
+ * \brief First pass of a streamed connected component labelling.
+ *
+ * Each streamed region is labelled in raster order. The provisional
+ * labels are numbered globally, one range per region, and their
+ * equivalences are stored in a union-find table kept across the
+ * streaming splits. The provisional labels of the pixels lying on
+ * the border of each region are also kept, so that the components
+ * crossing the region borders are merged when the neighbouring region
+ * is processed. Only the region borders are stored, never the full
+ * label image.
+ *
+ * Synthetize() resolves the equivalences into consecutive final labels
+ * (background is 0). The final label image is then produced by
+ * ConnectedComponentRelabelImageFilter, which labels its requested
+ * region again and maps the provisional labels to the final ones.
+ *
+ * As with itk::ConnectedComponentImageFilter, all the pixels different
+ * from the background value are foreground and connected to each other.
+ * Only 2D images are supported.
+ *
+ * \sa StreamingConnectedComponentImageFilter
+ * \sa ConnectedComponentRelabelImageFilter
+ *
+ * \ingroup Streamed
+ *
+ * \ingroup OTBLabelling
+ */
+template <class TInputImage>
+class ITK_EXPORT PersistentConnectedComponentImageFilter : public PersistentImageFilter<TInputImage, TInputImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentConnectedComponentImageFilter         Self;
+  typedef PersistentImageFilter<TInputImage, TInputImage> Superclass;
+  typedef itk::SmartPointer<Self>                         Pointer;
+  typedef itk::SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentConnectedComponentImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TInputImage                         ImageType;
+  typedef typename TInputImage::Pointer       InputImagePointer;
+  typedef typename TInputImage::RegionType    RegionType;
+  typedef typename TInputImage::IndexType     IndexType;
+  typedef typename TInputImage::OffsetType    OffsetType;
+  typedef typename TInputImage::PixelType     PixelType;
+
+  itkStaticConstMacro(InputImageDimension, unsigned int, TInputImage::ImageDimension);
+  static_assert(InputImageDimension == 2, "Only 2D images are supported");
+
+  /** Provisional and final label type */
+  typedef itk::SizeValueType     LabelType;
+  typedef std::vector<LabelType> LabelVectorType;
+
+  /** A labelled region, with its first provisional label */
+  struct LabelledRegionType
+  {
+    RegionType region;
+    LabelType  firstLabel;
+  };
+  typedef std::vector<LabelledRegionType> LabelledRegionVectorType;
+
+  /** Set/Get the background value */
+  itkSetMacro(BackgroundValue, PixelType);
+  itkGetConstMacro(BackgroundValue, PixelType);
+
+  /** Set/Get whether diagonal neighbours are connected */
+  itkSetMacro(FullyConnected, bool);
+  itkGetConstMacro(FullyConnected, bool);
+  itkBooleanMacro(FullyConnected);
+
+  /** Number of connected components, available after Synthetize() */
+  itkGetConstMacro(NumberOfObjects, LabelType);
+
+  /** Regions processed by the first pass */
+  const LabelledRegionVectorType& GetLabelledRegions() const
+  {
+    return m_LabelledRegions;
+  }
+
+  /** Final label of a provisional label, valid after Synthetize() */
+  LabelType GetFinalLabel(LabelType provisional) const
+  {
+    return m_FinalLabels[provisional];
+  }
+
+  /** Label a region in raster order, starting at firstLabel. Labels
+   * are written in raster order of region in labels, 0 for
+   * background. If parents is not null, the equivalences found are
+   * recorded in this union-find table. The labels only depend on the
+   * region content, so the second pass reproduces those of the first
+   * one. Returns the next free label. */
+  static LabelType LabelRegion(const ImageType* image, const RegionType& region, const PixelType& background, bool fullyConnected,
+                               LabelType firstLabel, LabelVectorType& labels, LabelVectorType* parents);
+
+  void GenerateOutputInformation() override;
+
+  void AllocateOutputs() override;
+
+  void Reset(void) override;
+
+  void Synthetize(void) override;
+
+protected:
+  PersistentConnectedComponentImageFilter();
+  ~PersistentConnectedComponentImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Labelling is sequential, each region is processed by one thread */
+  void GenerateData() override;
+
+private:
+  PersistentConnectedComponentImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  static LabelType FindRoot(LabelVectorType& parents, LabelType label);
+  static void Union(LabelVectorType& parents, LabelType a, LabelType b);
+
+  /** Offsets of the neighbours of a pixel */
+  std::vector<OffsetType> GetNeighbourOffsets() const;
+
+  PixelType m_BackgroundValue;
+  bool      m_FullyConnected;
+  LabelType m_NumberOfObjects;
+
+  /** Union-find table of the provisional labels */
+  LabelVectorType m_Parents;
+
+  /** Final label of each provisional label */
+  LabelVectorType m_FinalLabels;
+
+  /** Provisional labels of the foreground pixels on the region borders,
+   * indexed by linear index in the largest possible region */
+  std::unordered_map<uint64_t, LabelType> m_BorderLabels;
+
+  LabelledRegionVectorType m_LabelledRegions;
+};
+
+/** \class StreamingConnectedComponentImageFilter
+ * \brief Streams an image through PersistentConnectedComponentImageFilter.
+ *
+ * Once updated, GetFilter() can be given to
+ * ConnectedComponentRelabelImageFilter to produce the label image:
+ * \code
+ * labeller->SetInput(reader->GetOutput());
+ * labeller->Update();
+ * relabel->SetInput(reader->GetOutput());
+ * relabel->SetLabellingFilter(labeller->GetFilter());
+ * writer->SetInput(relabel->GetOutput());
+ * \endcode
+ * Using the same streaming layout for both passes avoids labelling
+ * some regions several times in the second pass.
+ *
+ * \ingroup Streamed
+ *
+ * \ingroup OTBLabelling
+ */
+template <class TInputImage>
+class ITK_EXPORT StreamingConnectedComponentImageFilter : public PersistentFilterStreamingDecorator<PersistentConnectedComponentImageFilter<TInputImage>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingConnectedComponentImageFilter Self;
+  typedef PersistentFilterStreamingDecorator<PersistentConnectedComponentImageFilter<TInputImage>> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingConnectedComponentImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef TInputImage                             InputImageType;
+  typedef typename Superclass::FilterType         PersistentFilterType;
+  typedef typename PersistentFilterType::LabelType LabelType;
+  typedef typename TInputImage::PixelType         PixelType;
+
+  using Superclass::SetInput;
+  void SetInput(InputImageType* input)
+  {
+    this->GetFilter()->SetInput(input);
+  }
+  const InputImageType* GetInput()
+  {
+    return this->GetFilter()->GetInput();
+  }
+
+  void SetBackgroundValue(const PixelType& value)
+  {
+    this->GetFilter()->SetBackgroundValue(value);
+  }
+  PixelType GetBackgroundValue() const
+  {
+    return this->GetFilter()->GetBackgroundValue();
+  }
+
+  void SetFullyConnected(bool flag)
+  {
+    this->GetFilter()->SetFullyConnected(flag);
+  }
+  bool GetFullyConnected() const
+  {
+    return this->GetFilter()->GetFullyConnected();
+  }
+
+  /** Number of connected components */
+  LabelType GetNumberOfObjects() const
+  {
+    return this->GetFilter()->GetNumberOfObjects();
+  }
+
+protected:
+  StreamingConnectedComponentImageFilter()
+  {
+  }
+  ~StreamingConnectedComponentImageFilter() override
+  {
+  }
+
+private:
+  StreamingConnectedComponentImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingConnectedComponentImageFilter.hxx"
+#endif
+
+#endif
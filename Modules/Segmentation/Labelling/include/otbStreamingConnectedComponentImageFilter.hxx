@@ -0,0 +1,273 @@
+/*
+ * Copyright (C) 1999-2011 Insight Software Consortium
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbStreamingConnectedComponentImageFilter_hxx
+#define otbStreamingConnectedComponentImageFilter_hxx
+
+#include "otbStreamingConnectedComponentImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+namespace otb
+{
+
+template <class TInputImage>
+PersistentConnectedComponentImageFilter<TInputImage>::PersistentConnectedComponentImageFilter()
+  : m_BackgroundValue(itk::NumericTraits<PixelType>::ZeroValue()), m_FullyConnected(false), m_NumberOfObjects(0)
+{
+  this->Reset();
+}
+
+template <class TInputImage>
+void PersistentConnectedComponentImageFilter<TInputImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  if (this->GetInput())
+  {
+    this->GetOutput()->CopyInformation(this->GetInput());
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput()->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentConnectedComponentImageFilter<TInputImage>::AllocateOutputs()
+{
+  // The output of this filter is not intended to be used
+}
+
+template <class TInputImage>
+void PersistentConnectedComponentImageFilter<TInputImage>::Reset()
+{
+  // Label 0 is the background
+  m_Parents.assign(1, 0);
+  m_FinalLabels.clear();
+  m_BorderLabels.clear();
+  m_LabelledRegions.clear();
+  m_NumberOfObjects = 0;
+}
+
+template <class TInputImage>
+void PersistentConnectedComponentImageFilter<TInputImage>::Synthetize()
+{
+  // Roots are the smallest label of their set, so they are numbered
+  // before the labels they absorb
+  m_FinalLabels.assign(m_Parents.size(), 0);
+  LabelType nbObjects = 0;
+  for (LabelType label = 1; label < m_Parents.size(); ++label)
+  {
+    const LabelType root = FindRoot(m_Parents, label);
+    m_FinalLabels[label] = (root == label) ? ++nbObjects : m_FinalLabels[root];
+  }
+  m_NumberOfObjects = nbObjects;
+
+  // Borders are only needed by the first pass
+  m_BorderLabels.clear();
+}
+
+template <class TInputImage>
+typename PersistentConnectedComponentImageFilter<TInputImage>::LabelType
+PersistentConnectedComponentImageFilter<TInputImage>::FindRoot(LabelVectorType& parents, LabelType label)
+{
+  while (parents[label] != label)
+  {
+    // Path halving
+    parents[label] = parents[parents[label]];
+    label          = parents[label];
+  }
+  return label;
+}
+
+template <class TInputImage>
+void PersistentConnectedComponentImageFilter<TInputImage>::Union(LabelVectorType& parents, LabelType a, LabelType b)
+{
+  const LabelType rootA = FindRoot(parents, a);
+  const LabelType rootB = FindRoot(parents, b);
+  if (rootA < rootB)
+  {
+    parents[rootB] = rootA;
+  }
+  else if (rootB < rootA)
+  {
+    parents[rootA] = rootB;
+  }
+}
+
+template <class TInputImage>
+typename PersistentConnectedComponentImageFilter<TInputImage>::LabelType
+PersistentConnectedComponentImageFilter<TInputImage>::LabelRegion(const ImageType* image, const RegionType& region, const PixelType& background,
+                                                                  bool fullyConnected, LabelType firstLabel, LabelVectorType& labels,
+                                                                  LabelVectorType* parents)
+{
+  labels.assign(region.GetNumberOfPixels(), 0);
+  const itk::SizeValueType width     = region.GetSize()[0];
+  LabelType                nextLabel = firstLabel;
+
+  itk::ImageRegionConstIterator<ImageType> it(image, region);
+  itk::SizeValueType                       i = 0;
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it, ++i)
+  {
+    if (it.Get() == background)
+    {
+      continue;
+    }
+
+    // Take the label of the first labelled neighbour, and record its
+    // equivalence with the other ones
+    LabelType current = 0;
+    auto      visit   = [&](LabelType neighbour) {
+      if (neighbour == 0 || neighbour == current)
+        return;
+      if (current == 0)
+        current = neighbour;
+      else if (parents)
+        Union(*parents, current, neighbour);
+    };
+
+    const itk::SizeValueType x = i % width;
+    if (x > 0)
+    {
+      visit(labels[i - 1]);
+    }
+    if (i >= width)
+    {
+      if (fullyConnected && x > 0)
+      {
+        visit(labels[i - width - 1]);
+      }
+      visit(labels[i - width]);
+      if (fullyConnected && x + 1 < width)
+      {
+        visit(labels[i - width + 1]);
+      }
+    }
+
+    if (current == 0)
+    {
+      current = nextLabel++;
+      if (parents)
+      {
+        parents->push_back(current);
+      }
+    }
+    labels[i] = current;
+  }
+  return nextLabel;
+}
+
+template <class TInputImage>
+std::vector<typename PersistentConnectedComponentImageFilter<TInputImage>::OffsetType>
+PersistentConnectedComponentImageFilter<TInputImage>::GetNeighbourOffsets() const
+{
+  std::vector<OffsetType> offsets;
+  for (int dy = -1; dy <= 1; ++dy)
+  {
+    for (int dx = -1; dx <= 1; ++dx)
+    {
+      if ((dx == 0 && dy == 0) || (!m_FullyConnected && dx != 0 && dy != 0))
+      {
+        continue;
+      }
+      OffsetType offset;
+      offset[0] = dx;
+      offset[1] = dy;
+      offsets.push_back(offset);
+    }
+  }
+  return offsets;
+}
+
+template <class TInputImage>
+void PersistentConnectedComponentImageFilter<TInputImage>::GenerateData()
+{
+  const ImageType* input   = this->GetInput();
+  const RegionType region  = this->GetOutput()->GetRequestedRegion();
+  const RegionType largest = input->GetLargestPossibleRegion();
+
+  LabelledRegionType labelledRegion;
+  labelledRegion.region     = region;
+  labelledRegion.firstLabel = m_Parents.size();
+  m_LabelledRegions.push_back(labelledRegion);
+
+  LabelVectorType labels;
+  LabelRegion(input, region, m_BackgroundValue, m_FullyConnected, labelledRegion.firstLabel, labels, &m_Parents);
+
+  // Merge with the components of the regions already processed, through
+  // the stored borders
+  const std::vector<OffsetType> offsets      = GetNeighbourOffsets();
+  const IndexType               largestStart = largest.GetIndex();
+  const uint64_t                largestWidth = largest.GetSize()[0];
+  auto                          linearIndex  = [&](const IndexType& index) {
+    return static_cast<uint64_t>(index[1] - largestStart[1]) * largestWidth + static_cast<uint64_t>(index[0] - largestStart[0]);
+  };
+
+  const itk::SizeValueType sizeX = region.GetSize()[0];
+  const itk::SizeValueType sizeY = region.GetSize()[1];
+  for (itk::SizeValueType y = 0; y < sizeY; ++y)
+  {
+    const bool               fullRow = (y == 0 || y + 1 == sizeY);
+    const itk::SizeValueType step    = (fullRow || sizeX < 2) ? 1 : sizeX - 1;
+    for (itk::SizeValueType x = 0; x < sizeX; x += step)
+    {
+      const LabelType label = labels[y * sizeX + x];
+      if (label == 0)
+      {
+        continue;
+      }
+      IndexType index = region.GetIndex();
+      index[0] += x;
+      index[1] += y;
+      for (const auto& offset : offsets)
+      {
+        const IndexType neighbour = index + offset;
+        if (region.IsInside(neighbour) || !largest.IsInside(neighbour))
+        {
+          continue;
+        }
+        auto found = m_BorderLabels.find(linearIndex(neighbour));
+        if (found != m_BorderLabels.end())
+        {
+          Union(m_Parents, label, found->second);
+        }
+      }
+      m_BorderLabels[linearIndex(index)] = label;
+    }
+  }
+}
+
+template <class TInputImage>
+void PersistentConnectedComponentImageFilter<TInputImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "BackgroundValue: " << static_cast<typename itk::NumericTraits<PixelType>::PrintType>(m_BackgroundValue) << std::endl;
+  os << indent << "FullyConnected: " << m_FullyConnected << std::endl;
+  os << indent << "Labelled regions: " << m_LabelledRegions.size() << std::endl;
+  os << indent << "Provisional labels: " << m_Parents.size() - 1 << std::endl;
+  os << indent << "NumberOfObjects: " << m_NumberOfObjects << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -24,13 +24,16 @@ include pixels in a growing region is to evaluate intensity value inside a speci
 interval, or to label pixels that are connected to a seed and lie within a
 neighbourhood. Remapping the labels is also possible, so that that the label numbers
 are consecutive with no gaps between the label numbers used. Finally, it is also
-possible to sort the labels based on the size of the object.")
+possible to sort the labels based on the size of the object. Connected
+components can also be labelled by streaming, with labels consistent across
+the whole image.")
 
 otb_module(OTBLabelling
   DEPENDS
     OTBITK
     OTBImageManipulation
     OTBPointSet
+    OTBStreaming
 
   TEST_DEPENDS
     OTBImageBase
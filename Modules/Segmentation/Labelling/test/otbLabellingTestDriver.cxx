@@ -26,4 +26,5 @@ void RegisterTests()
   REGISTER_TEST(otbLabelizeConnectedThresholdImageFilter);
   REGISTER_TEST(otbLabelizeNeighborhoodConnectedImageFilter);
   REGISTER_TEST(otbLabelToBoundaryImageFilter);
+  REGISTER_TEST(otbStreamingConnectedComponentImageFilter);
 }
@@ -0,0 +1,121 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbStreamingConnectedComponentImageFilter.h"
+#include "otbConnectedComponentRelabelImageFilter.h"
+#include "otbImage.h"
+#include "itkConnectedComponentImageFilter.h"
+#include "itkImageRegionIterator.h"
+#include <map>
+
+// Compare the streamed labelling of a synthetic mask with the one of
+// itk::ConnectedComponentImageFilter, up to a permutation of the labels
+int otbStreamingConnectedComponentImageFilter(int argc, char* argv[])
+{
+  typedef otb::Image<unsigned char, 2> MaskImageType;
+  typedef otb::Image<unsigned int, 2>  LabelImageType;
+
+  typedef otb::StreamingConnectedComponentImageFilter<MaskImageType>               LabellingFilterType;
+  typedef otb::ConnectedComponentRelabelImageFilter<MaskImageType, LabelImageType> RelabelFilterType;
+  typedef itk::ConnectedComponentImageFilter<MaskImageType, LabelImageType>        ReferenceFilterType;
+
+  if (argc != 4)
+  {
+    std::cerr << "Usage: " << argv[0] << " fullyConnected nbDivisions stripHeight" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const bool         fullyConnected = atoi(argv[1]) != 0;
+  const unsigned int nbDivisions    = atoi(argv[2]);
+  const unsigned int stripHeight    = atoi(argv[3]);
+
+  // Random blobs
+  MaskImageType::RegionType region;
+  region.SetSize(0, 211);
+  region.SetSize(1, 157);
+  MaskImageType::Pointer mask = MaskImageType::New();
+  mask->SetRegions(region);
+  mask->Allocate();
+  unsigned int                            seed = 12345;
+  itk::ImageRegionIterator<MaskImageType> maskIt(mask, region);
+  for (maskIt.GoToBegin(); !maskIt.IsAtEnd(); ++maskIt)
+  {
+    seed = seed * 1103515245 + 12345;
+    maskIt.Set(((seed >> 16) % 100) < 45 ? 1 : 0);
+  }
+
+  ReferenceFilterType::Pointer reference = ReferenceFilterType::New();
+  reference->SetInput(mask);
+  reference->SetFullyConnected(fullyConnected);
+  reference->Update();
+
+  LabellingFilterType::Pointer labelling = LabellingFilterType::New();
+  labelling->SetInput(mask);
+  labelling->SetFullyConnected(fullyConnected);
+  labelling->GetStreamer()->SetNumberOfDivisionsTiledStreaming(nbDivisions);
+  labelling->Update();
+
+  if (labelling->GetNumberOfObjects() != reference->GetObjectCount())
+  {
+    std::cerr << "Found " << labelling->GetNumberOfObjects() << " objects, expected " << reference->GetObjectCount() << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Second pass, streamed by strips unrelated to the first pass tiles
+  RelabelFilterType::Pointer relabel = RelabelFilterType::New();
+  relabel->SetInput(mask);
+  relabel->SetLabellingFilter(labelling->GetFilter());
+
+  std::map<unsigned int, unsigned int> toReference, fromReference;
+  for (unsigned int y = 0; y < region.GetSize(1); y += stripHeight)
+  {
+    LabelImageType::RegionType strip = region;
+    strip.SetIndex(1, y);
+    strip.SetSize(1, std::min<unsigned int>(stripHeight, region.GetSize(1) - y));
+    relabel->GetOutput()->SetRequestedRegion(strip);
+    relabel->Update();
+
+    itk::ImageRegionConstIterator<LabelImageType> outIt(relabel->GetOutput(), strip);
+    itk::ImageRegionConstIterator<LabelImageType> refIt(reference->GetOutput(), strip);
+    for (outIt.GoToBegin(), refIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt, ++refIt)
+    {
+      const unsigned int label    = outIt.Get();
+      const unsigned int expected = refIt.Get();
+      if ((label == 0) != (expected == 0))
+      {
+        std::cerr << "Background mismatch at " << outIt.GetIndex() << std::endl;
+        return EXIT_FAILURE;
+      }
+      if (label == 0)
+      {
+        continue;
+      }
+      auto to   = toReference.insert(std::make_pair(label, expected)).first;
+      auto from = fromReference.insert(std::make_pair(expected, label)).first;
+      if (to->second != expected || from->second != label)
+      {
+        std::cerr << "Label " << label << " at " << outIt.GetIndex() << " does not match reference label " << expected << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
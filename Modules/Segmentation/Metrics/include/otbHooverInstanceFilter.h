@@ -26,7 +26,10 @@
 #include "itkInPlaceLabelMapFilter.h"
 #include "itkVariableSizeMatrix.h"
 #include "itkVariableLengthVector.h"
+#include <map>
 #include <string>
+#include <unordered_map>
+#include <utility>
 
 namespace otb
 {
@@ -60,12 +63,17 @@ namespace otb
  *    - ATTRIBUTE_M (missed) : missed region own label (in GT)
  *    - ATTRIBUTE_N (noise) : noise region own label (in MS)
  *
+ * The confusion matrix is either dense, indexed by the rank of the label objects (see HooverMatrixFilter), or
+ * sparse, indexed by the labels themselves and only holding the intersecting couples (see
+ * StreamingHooverOverlapImageFilter). The sparse form is the one to use with large numbers of regions.
+ *
  * These attributes are handled in a different way than the Hoover scores. The simple presence of an extended attribute in a given region has a
  * meaning, regardless of its value. It is assumed that its value always corresponds to an existing region label. This is why these extended
  * attributes are not reset but removed before computing Hoover instances.
  * (see Hoover et al., "An experimental comparison of range image segmentation algorithms", IEEE PAMI vol. 18, no. 7, July 1996)
  *
  * \sa HooverMatrixFilter
+ * \sa StreamingHooverOverlapImageFilter
  *
  * \ingroup OTBMetrics
  */
@@ -107,6 +115,9 @@ public:
   typedef std::set<CoefficientType>                  RegionSetType;
   typedef std::vector<LabelObjectType*>              ObjectVectorType;
 
+  /** Sparse confusion matrix, indexed by GT label then MS label */
+  typedef std::map<std::pair<LabelType, LabelType>, CoefficientType> SparseMatrixType;
+
   void SetGroundTruthLabelMap(const LabelMapType* gt);
   void SetMachineSegmentationLabelMap(const LabelMapType* ms);
 
@@ -116,9 +127,27 @@ public:
   LabelMapType* GetOutputGroundTruthLabelMap();
   LabelMapType* GetOutputMachineSegmentationLabelMap();
 
-  itkSetMacro(HooverMatrix, MatrixType);
+  /** Set the dense confusion matrix */
+  void SetHooverMatrix(const MatrixType& matrix)
+  {
+    m_HooverMatrix    = matrix;
+    m_UseSparseMatrix = false;
+    this->Modified();
+  }
   itkGetMacro(HooverMatrix, MatrixType);
 
+  /** Set the sparse confusion matrix, used instead of the dense one */
+  void SetHooverSparseMatrix(const SparseMatrixType& matrix)
+  {
+    m_HooverSparseMatrix = matrix;
+    m_UseSparseMatrix    = true;
+    this->Modified();
+  }
+  const SparseMatrixType& GetHooverSparseMatrix() const
+  {
+    return m_HooverSparseMatrix;
+  }
+
   itkSetMacro(Threshold, double);
   itkGetMacro(Threshold, double);
 
@@ -266,9 +295,18 @@ private:
   /** List of labels in GT segmentation */
   LabelVectorType m_LabelsGT;
 
+  /** Index of each label in GT segmentation */
+  std::unordered_map<LabelType, unsigned long> m_IndicesGT;
+
   /** Hoover confusion matrix computed between GT and MS*/
   MatrixType m_HooverMatrix;
 
+  /** Sparse Hoover confusion matrix */
+  SparseMatrixType m_HooverSparseMatrix;
+
+  /** Flag to use the sparse matrix instead of the dense one */
+  bool m_UseSparseMatrix;
+
   /** List of region sizes in GT */
   CardinalVector m_CardRegGT;
 
@@ -29,7 +29,8 @@ namespace otb
 
 /** Constructor */
 template <class TLabelMap>
-HooverInstanceFilter<TLabelMap>::HooverInstanceFilter() : m_NumberOfRegionsGT(0), m_NumberOfRegionsMS(0), m_Threshold(0.8), m_UseExtendedAttributes(false)
+HooverInstanceFilter<TLabelMap>::HooverInstanceFilter()
+  : m_NumberOfRegionsGT(0), m_NumberOfRegionsMS(0), m_UseSparseMatrix(false), m_Threshold(0.8), m_UseExtendedAttributes(false)
 {
   this->SetNumberOfRequiredInputs(2);
   this->SetNumberOfRequiredOutputs(2);
@@ -165,7 +166,7 @@ void HooverInstanceFilter<TLabelMap>::BeforeThreadedGenerateData()
   }
 
   // Check the matrix size
-  if (m_NumberOfRegionsGT != m_HooverMatrix.Rows() || m_NumberOfRegionsMS != m_HooverMatrix.Cols())
+  if (!m_UseSparseMatrix && (m_NumberOfRegionsGT != m_HooverMatrix.Rows() || m_NumberOfRegionsMS != m_HooverMatrix.Cols()))
   {
     itkExceptionMacro("The given Hoover confusion matrix (" << m_HooverMatrix.Rows() << " x " << m_HooverMatrix.Cols()
                                                             << ") doesn't match with the input label maps (" << m_NumberOfRegionsGT << " x "
@@ -223,22 +224,19 @@ void HooverInstanceFilter<TLabelMap>::BeforeThreadedGenerateData()
   }
 
   m_LabelsGT = this->GetGroundTruthLabelMap()->GetLabels();
+  m_IndicesGT.clear();
+  m_IndicesGT.reserve(m_NumberOfRegionsGT);
+  for (unsigned long k = 0; k < m_NumberOfRegionsGT; k++)
+  {
+    m_IndicesGT[m_LabelsGT[k]] = k;
+  }
 }
 
 template <class TLabelMap>
 void HooverInstanceFilter<TLabelMap>::ThreadedProcessLabelObject(LabelObjectType* labelObject)
 {
   // Find the index corresponding to the current label object in GT
-  unsigned long currentRegionGT = 0;
-  LabelType     currentLabelGT  = labelObject->GetLabel();
-  for (unsigned long k = 0; k < m_NumberOfRegionsGT; k++)
-  {
-    if (currentLabelGT == m_LabelsGT[k])
-    {
-      currentRegionGT = k;
-      break;
-    }
-  }
+  const unsigned long currentRegionGT = m_IndicesGT.find(labelObject->GetLabel())->second;
 
   m_CardRegGT[currentRegionGT] = labelObject->Size();
   if (m_CardRegGT[currentRegionGT] == 0)
@@ -279,9 +277,68 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
   LabelMapType* outGT = this->GetOutput(0);
   LabelMapType* outMS = this->GetOutput(1);
 
-  // Iterators on label object container (to gain efficiency when accessing them)
-  IteratorType iterGT = IteratorType(outGT);
-  IteratorType iterMS = IteratorType(outMS);
+  // Label objects by index (to gain efficiency when accessing them)
+  ObjectVectorType objectsGT, objectsMS;
+  objectsGT.reserve(m_NumberOfRegionsGT);
+  objectsMS.reserve(m_NumberOfRegionsMS);
+  for (IteratorType iterGT = IteratorType(outGT); !iterGT.IsAtEnd(); ++iterGT)
+  {
+    objectsGT.push_back(iterGT.GetLabelObject());
+  }
+  for (IteratorType iterMS = IteratorType(outMS); !iterMS.IsAtEnd(); ++iterMS)
+  {
+    objectsMS.push_back(iterMS.GetLabelObject());
+  }
+
+  // Non-empty cells of the confusion matrix, by row and by column, in
+  // increasing order of index
+  typedef std::vector<std::pair<unsigned long, CoefficientType>> CellVectorType;
+  std::vector<CellVectorType> cellsByRow(m_NumberOfRegionsGT);
+  std::vector<CellVectorType> cellsByCol(m_NumberOfRegionsMS);
+  if (m_UseSparseMatrix)
+  {
+    std::unordered_map<LabelType, unsigned long> indicesMS;
+    indicesMS.reserve(m_NumberOfRegionsMS);
+    for (unsigned long col = 0; col < m_NumberOfRegionsMS; col++)
+    {
+      indicesMS[objectsMS[col]->GetLabel()] = col;
+    }
+    for (const auto& cell : m_HooverSparseMatrix)
+    {
+      auto rowIt = m_IndicesGT.find(cell.first.first);
+      auto colIt = indicesMS.find(cell.first.second);
+      if (rowIt == m_IndicesGT.end() || colIt == indicesMS.end())
+      {
+        itkExceptionMacro("Labels (" << cell.first.first << ", " << cell.first.second << ") of the sparse Hoover matrix are not in the input label maps");
+      }
+      if (cell.second > 0)
+      {
+        cellsByRow[rowIt->second].emplace_back(colIt->second, cell.second);
+      }
+    }
+  }
+  else
+  {
+    for (unsigned long row = 0; row < m_NumberOfRegionsGT; row++)
+    {
+      for (unsigned long col = 0; col < m_NumberOfRegionsMS; col++)
+      {
+        if (m_HooverMatrix(row, col) > 0)
+        {
+          cellsByRow[row].emplace_back(col, m_HooverMatrix(row, col));
+        }
+      }
+    }
+  }
+  // The sparse matrix is ordered by labels, as the label maps, so the
+  // cells are already sorted by index
+  for (unsigned long row = 0; row < m_NumberOfRegionsGT; row++)
+  {
+    for (const auto& cell : cellsByRow[row])
+    {
+      cellsByCol[cell.first].emplace_back(row, cell.second);
+    }
+  }
 
   // Set of classified regions
   RegionSetType GTindices;
@@ -301,7 +358,7 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
   double areaMS   = 0.0;
 
   // first pass : loop on GT regions first
-  for (unsigned int row = 0; row < m_NumberOfRegionsGT; row++, iterGT++)
+  for (unsigned long row = 0; row < m_NumberOfRegionsGT; row++)
   {
     double           sumOS      = 0.0; // sum of coefT for potential over-segmented regions
     double           sumScoreRF = 0.0; // temporary sum  of (Tij x (Tij - 1)) terms for the RF score
@@ -309,21 +366,12 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
     ObjectVectorType objectsOfMS;      // stores region pointers
 
     double tGT = static_cast<double>(m_CardRegGT[row]) * m_Threshold; // card Ri x t
-    IsRowEmpty = true;
-    iterMS.GoToBegin();
-    for (unsigned int col = 0; col < m_NumberOfRegionsMS; col++, iterMS++)
+    IsRowEmpty = cellsByRow[row].empty();
+    for (const auto& cell : cellsByRow[row])
     {
-      // Tij
-      double coefT = static_cast<double>(m_HooverMatrix(row, col));
-      if (coefT < 0.5)
-      {
-        // the regions Ri and ^Rj have an empty intersection : we can jump to the next matrix cell
-        continue;
-      }
-      else
-      {
-        IsRowEmpty = false;
-      }
+      // Tij (only non-empty intersections are stored)
+      const unsigned long col   = cell.first;
+      double              coefT = static_cast<double>(cell.second);
 
       double tMS = static_cast<double>(m_CardRegMS[col]) * m_Threshold; // card Rj x t
 
@@ -336,8 +384,8 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
         {
           otbDebugMacro(<< "1 coef[" << row << "," << col << "]=" << coefT << " #tGT=" << tGT << " #tMS=" << tMS << " -> CD");
 
-          LabelObjectType* regionGT = iterGT.GetLabelObject();
-          LabelObjectType* regionMS = iterMS.GetLabelObject();
+          LabelObjectType* regionGT = objectsGT[row];
+          LabelObjectType* regionMS = objectsMS[col];
           double           scoreRC  = m_Threshold * (std::min(coefT / tGT, coefT / tMS));
           bufferRC += scoreRC * static_cast<double>(m_CardRegGT[row]);
 
@@ -357,7 +405,7 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
         {
           otbDebugMacro(<< "2 coef[" << row << "," << col << "]=" << coefT << " #tGT=" << tGT << " #tMS=" << tMS << " -> OSmaybe");
         }
-        objectsOfMS.push_back(iterMS.GetLabelObject()); // candidate region for over-segmentation
+        objectsOfMS.push_back(objectsMS[col]); // candidate region for over-segmentation
         regionsOfMS.insert(col);
         sumOS += coefT;
         sumScoreRF += coefT * (coefT - 1.0);
@@ -376,7 +424,7 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
       else if (regionsOfMS.size() > 1)
       {
         otbDebugMacro(<< row << " OS by ");
-        LabelObjectType* regionGT = iterGT.GetLabelObject();
+        LabelObjectType* regionGT = objectsGT[row];
 
         double cardRegGT = static_cast<double>(m_CardRegGT[row]);
         double scoreRF   = 1.0 - sumScoreRF / (cardRegGT * (cardRegGT - 1.0));
@@ -426,8 +474,7 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
   } // end of line loop
 
   // second pass : loop on MS regions first
-  iterMS.GoToBegin();
-  for (unsigned int col = 0; col < m_NumberOfRegionsMS; col++, iterMS++)
+  for (unsigned long col = 0; col < m_NumberOfRegionsMS; col++)
   {
     double sumUS      = 0.0; // sum of coefT for potential under-segmented regions
     double sumScoreUS = 0.0; // temporary sum of the (Tij x (Tij - 1)) for RA score
@@ -437,20 +484,11 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
     ObjectVectorType objectsOfGT; // stores region pointers
 
     double tMS = static_cast<double>(m_CardRegMS[col]) * m_Threshold;
-    IsColEmpty = true;
-    iterGT.GoToBegin();
-    for (unsigned int row = 0; row < m_NumberOfRegionsGT; row++, iterGT++)
+    IsColEmpty = cellsByCol[col].empty();
+    for (const auto& cell : cellsByCol[col])
     {
-      double coefT = static_cast<double>(m_HooverMatrix(row, col));
-      if (coefT < 0.5)
-      {
-        // the regions Ri and ^Rj have an empty intersection : we can jump to the next matrix cell
-        continue;
-      }
-      else
-      {
-        IsColEmpty = false;
-      }
+      const unsigned long row   = cell.first;
+      double              coefT = static_cast<double>(cell.second);
 
       double tGT = static_cast<double>(m_CardRegGT[row]) * m_Threshold;
       // Looking for Under-Segmented regions
@@ -458,7 +496,7 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
       {
         otbDebugMacro(<< "3 coef[" << row << "," << col << "]=" << coefT << " #tGT=" << tGT << " #tMS=" << tMS << " -> USmaybe");
         regionsOfGT.insert(row);
-        objectsOfGT.push_back(iterGT.GetLabelObject());
+        objectsOfGT.push_back(objectsGT[row]);
         sumUS += coefT;
         sumScoreUS += coefT * (coefT - 1.0);
         sumCardUS += static_cast<double>(m_CardRegGT[row]);
@@ -474,7 +512,7 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
       }
       else if (regionsOfGT.size() > 1) // Under Segmentation
       {
-        LabelObjectType* regionMS = iterMS.GetLabelObject();
+        LabelObjectType* regionMS = objectsMS[col];
         double           scoreRA  = 1.0 - sumScoreUS / (sumCardUS * (sumCardUS - 1.0));
         bufferRA += scoreRA * sumCardUS;
 
@@ -523,13 +561,12 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
   } // end of column loop
 
   // check for Missed regions (unregistered regions in GT)
-  iterGT.GoToBegin();
-  for (unsigned int i = 0; i < m_NumberOfRegionsGT; ++i, ++iterGT)
+  for (unsigned long i = 0; i < m_NumberOfRegionsGT; ++i)
   {
     if (GTindices.count(i) == 0)
     {
       otbDebugMacro(<< "M " << i);
-      LabelObjectType* regionGT = iterGT.GetLabelObject();
+      LabelObjectType* regionGT = objectsGT[i];
 
       bufferRM += static_cast<double>(m_CardRegGT[i]);
 
@@ -543,12 +580,11 @@ void HooverInstanceFilter<TLabelMap>::AfterThreadedGenerateData()
   }
 
   // check for Noise regions (unregistered regions in MS)
-  iterMS.GoToBegin();
-  for (unsigned int i = 0; i < m_NumberOfRegionsMS; ++i, ++iterMS)
+  for (unsigned long i = 0; i < m_NumberOfRegionsMS; ++i)
   {
     if (MSindices.count(i) == 0)
     {
-      LabelObjectType* regionMS = iterMS.GetLabelObject();
+      LabelObjectType* regionMS = objectsMS[i];
 
       bufferRN += static_cast<double>(m_CardRegMS[i]);
 
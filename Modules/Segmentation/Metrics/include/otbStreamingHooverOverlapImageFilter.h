@@ -0,0 +1,206 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbStreamingHooverOverlapImageFilter_h
+#define otbStreamingHooverOverlapImageFilter_h
+
+#include "otbPersistentImageFilter.h"
+#include "otbPersistentFilterStreamingDecorator.h"
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+namespace otb
+{
+
+/** \class PersistentHooverOverlapImageFilter
+ * \brief Accumulates the sparse Hoover confusion matrix of two label images.
+ *
+ * For each couple of ground truth (GT) and machine segmentation (MS)
+ * labels, the number of pixels of their intersection is counted. Only
+ * the couples which actually intersect are stored, in one hash map per
+ * thread. The maps are merged by Synthetize(), so the images can be
+ * streamed and the memory only depends on the number of intersecting
+ * couples. Pixels labelled with the background value in either image
+ * are ignored.
+ *
+ * The result is meant for HooverInstanceFilter::SetHooverSparseMatrix().
+ *
+ * \sa HooverMatrixFilter
+ * \sa StreamingHooverOverlapImageFilter
+ *
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBMetrics
+ */
+template <class TLabelImage>
+class ITK_EXPORT PersistentHooverOverlapImageFilter : public PersistentImageFilter<TLabelImage, TLabelImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PersistentHooverOverlapImageFilter              Self;
+  typedef PersistentImageFilter<TLabelImage, TLabelImage> Superclass;
+  typedef itk::SmartPointer<Self>                         Pointer;
+  typedef itk::SmartPointer<const Self>                   ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PersistentHooverOverlapImageFilter, PersistentImageFilter);
+
+  /** Image related typedefs. */
+  typedef TLabelImage                      LabelImageType;
+  typedef typename TLabelImage::RegionType RegionType;
+  typedef typename TLabelImage::PixelType  LabelType;
+
+  typedef unsigned long                   CoefficientType;
+  typedef std::pair<LabelType, LabelType> LabelPairType;
+
+  /** Sparse matrix, ordered by GT label then MS label */
+  typedef std::map<LabelPairType, CoefficientType> SparseMatrixType;
+
+  /** Set/Get the ground truth label image */
+  void SetGroundTruthImage(const LabelImageType* gt);
+  const LabelImageType* GetGroundTruthImage();
+
+  /** Set/Get the machine segmentation label image */
+  void SetMachineSegmentationImage(const LabelImageType* ms);
+  const LabelImageType* GetMachineSegmentationImage();
+
+  /** Set/Get the background label */
+  itkSetMacro(BackgroundValue, LabelType);
+  itkGetConstMacro(BackgroundValue, LabelType);
+
+  /** Sparse confusion matrix, available after Synthetize() */
+  const SparseMatrixType& GetHooverSparseMatrix() const
+  {
+    return m_Matrix;
+  }
+
+  void GenerateOutputInformation() override;
+
+  void AllocateOutputs() override;
+
+  void Reset(void) override;
+
+  void Synthetize(void) override;
+
+protected:
+  PersistentHooverOverlapImageFilter();
+  ~PersistentHooverOverlapImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+private:
+  PersistentHooverOverlapImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  struct LabelPairHash
+  {
+    size_t operator()(const LabelPairType& p) const
+    {
+      return std::hash<LabelType>()(p.first) * 31 + std::hash<LabelType>()(p.second);
+    }
+  };
+  typedef std::unordered_map<LabelPairType, CoefficientType, LabelPairHash> OverlapMapType;
+
+  LabelType m_BackgroundValue;
+
+  std::vector<OverlapMapType> m_ThreadOverlaps;
+
+  SparseMatrixType m_Matrix;
+};
+
+/** \class StreamingHooverOverlapImageFilter
+ * \brief Streams two label images through PersistentHooverOverlapImageFilter.
+ *
+ * \ingroup Streamed
+ * \ingroup Multithreaded
+ *
+ * \ingroup OTBMetrics
+ */
+template <class TLabelImage>
+class ITK_EXPORT StreamingHooverOverlapImageFilter : public PersistentFilterStreamingDecorator<PersistentHooverOverlapImageFilter<TLabelImage>>
+{
+public:
+  /** Standard Self typedef */
+  typedef StreamingHooverOverlapImageFilter                                                   Self;
+  typedef PersistentFilterStreamingDecorator<PersistentHooverOverlapImageFilter<TLabelImage>> Superclass;
+  typedef itk::SmartPointer<Self>                                                             Pointer;
+  typedef itk::SmartPointer<const Self>                                                       ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(StreamingHooverOverlapImageFilter, PersistentFilterStreamingDecorator);
+
+  typedef TLabelImage                                       LabelImageType;
+  typedef typename Superclass::FilterType::LabelType        LabelType;
+  typedef typename Superclass::FilterType::SparseMatrixType SparseMatrixType;
+
+  void SetGroundTruthImage(const LabelImageType* gt)
+  {
+    this->GetFilter()->SetGroundTruthImage(gt);
+  }
+
+  void SetMachineSegmentationImage(const LabelImageType* ms)
+  {
+    this->GetFilter()->SetMachineSegmentationImage(ms);
+  }
+
+  void SetBackgroundValue(LabelType value)
+  {
+    this->GetFilter()->SetBackgroundValue(value);
+  }
+
+  const SparseMatrixType& GetHooverSparseMatrix() const
+  {
+    return this->GetFilter()->GetHooverSparseMatrix();
+  }
+
+protected:
+  StreamingHooverOverlapImageFilter()
+  {
+  }
+  ~StreamingHooverOverlapImageFilter() override
+  {
+  }
+
+private:
+  StreamingHooverOverlapImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbStreamingHooverOverlapImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,153 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbStreamingHooverOverlapImageFilter_hxx
+#define otbStreamingHooverOverlapImageFilter_hxx
+
+#include "otbStreamingHooverOverlapImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+
+namespace otb
+{
+
+template <class TLabelImage>
+PersistentHooverOverlapImageFilter<TLabelImage>::PersistentHooverOverlapImageFilter() : m_BackgroundValue(itk::NumericTraits<LabelType>::ZeroValue())
+{
+  this->SetNumberOfRequiredInputs(2);
+}
+
+template <class TLabelImage>
+void PersistentHooverOverlapImageFilter<TLabelImage>::SetGroundTruthImage(const LabelImageType* gt)
+{
+  this->SetNthInput(0, const_cast<LabelImageType*>(gt));
+}
+
+template <class TLabelImage>
+const TLabelImage* PersistentHooverOverlapImageFilter<TLabelImage>::GetGroundTruthImage()
+{
+  return this->GetInput(0);
+}
+
+template <class TLabelImage>
+void PersistentHooverOverlapImageFilter<TLabelImage>::SetMachineSegmentationImage(const LabelImageType* ms)
+{
+  this->SetNthInput(1, const_cast<LabelImageType*>(ms));
+}
+
+template <class TLabelImage>
+const TLabelImage* PersistentHooverOverlapImageFilter<TLabelImage>::GetMachineSegmentationImage()
+{
+  return this->GetInput(1);
+}
+
+template <class TLabelImage>
+void PersistentHooverOverlapImageFilter<TLabelImage>::GenerateOutputInformation()
+{
+  Superclass::GenerateOutputInformation();
+
+  if (this->GetInput(0) && this->GetInput(1))
+  {
+    if (this->GetInput(0)->GetLargestPossibleRegion() != this->GetInput(1)->GetLargestPossibleRegion())
+    {
+      itkExceptionMacro(<< "The ground truth and machine segmentation images have different sizes");
+    }
+    this->GetOutput()->CopyInformation(this->GetInput(0));
+    this->GetOutput()->SetLargestPossibleRegion(this->GetInput(0)->GetLargestPossibleRegion());
+
+    if (this->GetOutput()->GetRequestedRegion().GetNumberOfPixels() == 0)
+    {
+      this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+    }
+  }
+}
+
+template <class TLabelImage>
+void PersistentHooverOverlapImageFilter<TLabelImage>::AllocateOutputs()
+{
+  // The output of this filter is not intended to be used
+}
+
+template <class TLabelImage>
+void PersistentHooverOverlapImageFilter<TLabelImage>::Reset()
+{
+  m_ThreadOverlaps.clear();
+  m_ThreadOverlaps.resize(this->GetNumberOfThreads());
+  m_Matrix.clear();
+}
+
+template <class TLabelImage>
+void PersistentHooverOverlapImageFilter<TLabelImage>::Synthetize()
+{
+  m_Matrix.clear();
+  for (auto& overlaps : m_ThreadOverlaps)
+  {
+    for (const auto& overlap : overlaps)
+    {
+      m_Matrix[overlap.first] += overlap.second;
+    }
+    OverlapMapType().swap(overlaps);
+  }
+}
+
+template <class TLabelImage>
+void PersistentHooverOverlapImageFilter<TLabelImage>::ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId)
+{
+  OverlapMapType& overlaps = m_ThreadOverlaps[threadId];
+
+  itk::ImageRegionConstIterator<LabelImageType> gtIt(this->GetInput(0), outputRegionForThread);
+  itk::ImageRegionConstIterator<LabelImageType> msIt(this->GetInput(1), outputRegionForThread);
+
+  // Runs of identical couples are frequent, count them before hashing
+  LabelPairType   current(m_BackgroundValue, m_BackgroundValue);
+  CoefficientType count = 0;
+  bool            valid = false;
+  for (gtIt.GoToBegin(), msIt.GoToBegin(); !gtIt.IsAtEnd(); ++gtIt, ++msIt)
+  {
+    const LabelPairType couple(gtIt.Get(), msIt.Get());
+    if (couple != current)
+    {
+      if (valid)
+      {
+        overlaps[current] += count;
+      }
+      current = couple;
+      count   = 0;
+      valid   = (couple.first != m_BackgroundValue && couple.second != m_BackgroundValue);
+    }
+    ++count;
+  }
+  if (valid)
+  {
+    overlaps[current] += count;
+  }
+}
+
+template <class TLabelImage>
+void PersistentHooverOverlapImageFilter<TLabelImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "BackgroundValue: " << m_BackgroundValue << std::endl;
+  os << indent << "Number of intersecting couples: " << m_Matrix.size() << std::endl;
+}
+
+} // end namespace otb
+
+#endif
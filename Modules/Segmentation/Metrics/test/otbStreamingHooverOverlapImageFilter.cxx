@@ -0,0 +1,132 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbStreamingHooverOverlapImageFilter.h"
+#include "otbHooverMatrixFilter.h"
+#include "otbHooverInstanceFilter.h"
+#include "otbAttributesMapLabelObject.h"
+
+#include "otbImage.h"
+#include "otbImageFileReader.h"
+#include "itkLabelImageToLabelMapFilter.h"
+
+// Check the streamed sparse matrix against the dense one, and the
+// Hoover scores computed from both
+int otbStreamingHooverOverlapImageFilter(int argc, char* argv[])
+{
+  typedef otb::AttributesMapLabelObject<unsigned int, 2, float>    LabelObjectType;
+  typedef itk::LabelMap<LabelObjectType>                           LabelMapType;
+  typedef otb::HooverMatrixFilter<LabelMapType>                    HooverMatrixFilterType;
+  typedef otb::HooverInstanceFilter<LabelMapType>                  InstanceFilterType;
+  typedef otb::Image<unsigned int, 2>                              ImageType;
+  typedef otb::StreamingHooverOverlapImageFilter<ImageType>        HooverOverlapFilterType;
+  typedef itk::LabelImageToLabelMapFilter<ImageType, LabelMapType> ImageToLabelMapFilterType;
+  typedef otb::ImageFileReader<ImageType>                          ImageReaderType;
+
+  if (argc != 3)
+  {
+    std::cerr << "Usage: " << argv[0];
+    std::cerr << " segmentationGT segmentationMS" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  ImageReaderType::Pointer gt_reader = ImageReaderType::New();
+  gt_reader->SetFileName(argv[1]);
+
+  ImageReaderType::Pointer ms_reader = ImageReaderType::New();
+  ms_reader->SetFileName(argv[2]);
+
+  HooverOverlapFilterType::Pointer overlapFilter = HooverOverlapFilterType::New();
+  overlapFilter->SetGroundTruthImage(gt_reader->GetOutput());
+  overlapFilter->SetMachineSegmentationImage(ms_reader->GetOutput());
+  overlapFilter->SetBackgroundValue(0);
+  overlapFilter->GetStreamer()->SetNumberOfDivisionsStrippedStreaming(7);
+  overlapFilter->Update();
+
+  ImageToLabelMapFilterType::Pointer gt_filter = ImageToLabelMapFilterType::New();
+  gt_filter->SetInput(gt_reader->GetOutput());
+  gt_filter->SetBackgroundValue(0);
+  gt_filter->Update();
+
+  ImageToLabelMapFilterType::Pointer ms_filter = ImageToLabelMapFilterType::New();
+  ms_filter->SetInput(ms_reader->GetOutput());
+  ms_filter->SetBackgroundValue(0);
+  ms_filter->Update();
+
+  HooverMatrixFilterType::Pointer hooverFilter = HooverMatrixFilterType::New();
+  hooverFilter->SetGroundTruthLabelMap(gt_filter->GetOutput());
+  hooverFilter->SetMachineSegmentationLabelMap(ms_filter->GetOutput());
+  hooverFilter->Update();
+
+  const HooverMatrixFilterType::MatrixType&        dense  = hooverFilter->GetHooverConfusionMatrix();
+  const HooverOverlapFilterType::SparseMatrixType& sparse = overlapFilter->GetHooverSparseMatrix();
+
+  const LabelMapType::LabelVectorType labelsGT = gt_filter->GetOutput()->GetLabels();
+  const LabelMapType::LabelVectorType labelsMS = ms_filter->GetOutput()->GetLabels();
+  unsigned long                       nbCells  = 0;
+  for (unsigned int i = 0; i < dense.Rows(); i++)
+  {
+    for (unsigned int j = 0; j < dense.Cols(); j++)
+    {
+      if (dense(i, j) == 0)
+      {
+        continue;
+      }
+      ++nbCells;
+      auto it = sparse.find(std::make_pair(labelsGT[i], labelsMS[j]));
+      if (it == sparse.end() || it->second != dense(i, j))
+      {
+        std::cerr << "Overlap of GT " << labelsGT[i] << " and MS " << labelsMS[j] << " is " << dense(i, j) << " in the dense matrix, "
+                  << (it == sparse.end() ? 0 : it->second) << " in the sparse one" << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+  if (nbCells != sparse.size())
+  {
+    std::cerr << "The sparse matrix has " << sparse.size() << " cells, expected " << nbCells << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  InstanceFilterType::Pointer denseInstances = InstanceFilterType::New();
+  denseInstances->SetGroundTruthLabelMap(gt_filter->GetOutput());
+  denseInstances->SetMachineSegmentationLabelMap(ms_filter->GetOutput());
+  denseInstances->SetHooverMatrix(dense);
+  denseInstances->InPlaceOff();
+  denseInstances->Update();
+
+  InstanceFilterType::Pointer sparseInstances = InstanceFilterType::New();
+  sparseInstances->SetGroundTruthLabelMap(gt_filter->GetOutput());
+  sparseInstances->SetMachineSegmentationLabelMap(ms_filter->GetOutput());
+  sparseInstances->SetHooverSparseMatrix(sparse);
+  sparseInstances->InPlaceOff();
+  sparseInstances->Update();
+
+  if (denseInstances->GetMeanRC() != sparseInstances->GetMeanRC() || denseInstances->GetMeanRF() != sparseInstances->GetMeanRF() ||
+      denseInstances->GetMeanRA() != sparseInstances->GetMeanRA() || denseInstances->GetMeanRM() != sparseInstances->GetMeanRM() ||
+      denseInstances->GetMeanRN() != sparseInstances->GetMeanRN())
+  {
+    std::cerr << "Hoover scores differ between the dense and sparse matrices" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComponentTreeByReconstructionImageFilter_h
+#define otbComponentTreeByReconstructionImageFilter_h
+
+#include "otbComponentTreeReconstructionImageFilter.h"
+
+namespace otb
+{
+/** \class ComponentTreeByReconstructionImageFilter
+ *  \brief Base class of the openings and closings by reconstruction using the component tree of
+ *  the input.
+ *
+ * The input is first filtered by TMorphologyFilter, an erosion or a dilation by the structuring
+ * element. The result is the marker of a ComponentTreeReconstructionImageFilter comparing the
+ * values with TCompare, the input being the mask.
+ *
+ * The reconstruction filter is kept between the updates, and so is the component tree of the
+ * input: the profiles computed by ImageToProfileFilter with a single filter build one tree per
+ * profile, each element only costing an erosion (or a dilation) and two linear traversals of the tree.
+ *
+ * Like the reconstruction, this filter processes the largest possible region.
+ *
+ * \sa ComponentTreeOpeningByReconstructionImageFilter
+ * \sa ComponentTreeClosingByReconstructionImageFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TCompare>
+class ITK_EXPORT ComponentTreeByReconstructionImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef ComponentTreeByReconstructionImageFilter           Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>                            Pointer;
+  typedef itk::SmartPointer<const Self>                      ConstPointer;
+
+  /** Creation through object factory macro */
+  itkTypeMacro(ComponentTreeByReconstructionImageFilter, ImageToImageFilter);
+
+  /** Template parameters typedefs */
+  typedef TInputImage                                                                       InputImageType;
+  typedef TOutputImage                                                                      OutputImageType;
+  typedef TMorphologyFilter                                                                 MorphologyFilterType;
+  typedef typename MorphologyFilterType::KernelType                                         KernelType;
+  typedef ComponentTreeReconstructionImageFilter<InputImageType, OutputImageType, TCompare> ReconstructionFilterType;
+
+  /** Set/Get the structuring element */
+  void SetKernel(const KernelType& kernel)
+  {
+    m_Kernel = kernel;
+    this->Modified();
+  }
+  itkGetConstReferenceMacro(Kernel, KernelType);
+
+  /** Set/Get whether the reconstruction uses the full connectivity */
+  itkSetMacro(FullyConnected, bool);
+  itkGetConstReferenceMacro(FullyConnected, bool);
+  itkBooleanMacro(FullyConnected);
+
+protected:
+  /** Constructor */
+  ComponentTreeByReconstructionImageFilter();
+  /** Destructor */
+  ~ComponentTreeByReconstructionImageFilter() override = default;
+
+  /** The whole input is needed */
+  void GenerateInputRequestedRegion() override;
+  /** The whole output is produced */
+  void EnlargeOutputRequestedRegion(itk::DataObject* output) override;
+  /** GenerateData method */
+  void GenerateData() override;
+
+  /**PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ComponentTreeByReconstructionImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  KernelType m_Kernel;
+  bool       m_FullyConnected;
+
+  /** Reconstruction filter, keeping the tree of the input */
+  typename ReconstructionFilterType::Pointer m_Reconstruction;
+};
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbComponentTreeByReconstructionImageFilter.hxx"
+#endif
+
+#endif
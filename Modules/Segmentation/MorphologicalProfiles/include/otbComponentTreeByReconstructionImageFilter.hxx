@@ -0,0 +1,108 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComponentTreeByReconstructionImageFilter_hxx
+#define otbComponentTreeByReconstructionImageFilter_hxx
+
+#include "otbComponentTreeByReconstructionImageFilter.h"
+#include "itkProgressAccumulator.h"
+
+namespace otb
+{
+/**
+ * Constructor
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TCompare>
+ComponentTreeByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TCompare>::ComponentTreeByReconstructionImageFilter()
+  : m_FullyConnected(false), m_Reconstruction(ReconstructionFilterType::New())
+{
+}
+
+/**
+ * Generate input requested region
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TCompare>
+void ComponentTreeByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TCompare>::GenerateInputRequestedRegion()
+{
+  // Call the superclass' implementation of this method
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (inputPtr)
+  {
+    inputPtr->SetRequestedRegion(inputPtr->GetLargestPossibleRegion());
+  }
+}
+
+/**
+ * Enlarge output requested region
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TCompare>
+void ComponentTreeByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TCompare>::EnlargeOutputRequestedRegion(itk::DataObject*)
+{
+  this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+}
+
+/**
+ * GenerateData method
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TCompare>
+void ComponentTreeByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TCompare>::GenerateData()
+{
+  const InputImageType* inputPtr = this->GetInput();
+
+  itk::ProgressAccumulator::Pointer progress = itk::ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  typename MorphologyFilterType::Pointer morphology = MorphologyFilterType::New();
+  morphology->SetNumberOfThreads(this->GetNumberOfThreads());
+  morphology->SetInput(inputPtr);
+  morphology->SetKernel(m_Kernel);
+  progress->RegisterInternalFilter(morphology, 0.5f);
+  morphology->Update();
+
+  typename InputImageType::Pointer marker = morphology->GetOutput();
+  marker->DisconnectPipeline();
+
+  m_Reconstruction->SetMarkerImage(marker);
+  m_Reconstruction->SetMaskImage(inputPtr);
+  m_Reconstruction->SetFullyConnected(m_FullyConnected);
+  progress->RegisterInternalFilter(m_Reconstruction, 0.5f);
+  m_Reconstruction->GraftOutput(this->GetOutput());
+  m_Reconstruction->Update();
+  this->GraftOutput(m_Reconstruction->GetOutput());
+
+  // Release the marker, the tree is kept for the next update
+  m_Reconstruction->SetMarkerImage(nullptr);
+}
+
+/**
+ * PrintSelf Method
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TCompare>
+void ComponentTreeByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TCompare>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Kernel: " << m_Kernel << std::endl;
+  os << indent << "FullyConnected: " << m_FullyConnected << std::endl;
+}
+
+} // End namespace otb
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComponentTreeClosingByReconstructionImageFilter_h
+#define otbComponentTreeClosingByReconstructionImageFilter_h
+
+#include "otbComponentTreeByReconstructionImageFilter.h"
+#include "itkGrayscaleDilateImageFilter.h"
+
+namespace otb
+{
+/** \class ComponentTreeClosingByReconstructionImageFilter
+ *  \brief Closing by reconstruction using the component tree of the input.
+ *
+ * The dilation of the input by the structuring element is computed with the
+ * itk::GrayscaleDilateImageFilter, then reconstructed by erosion above the input with a
+ * ComponentTreeReconstructionImageFilter. It gives the results of
+ * itk::ClosingByReconstructionImageFilter without PreserveIntensities, and can replace it in the
+ * MorphologicalClosingProfileFilter, where the tree of the input is then built once for the whole
+ * profile.
+ *
+ * \sa ComponentTreeByReconstructionImageFilter
+ * \sa ComponentTreeOpeningByReconstructionImageFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage, class TStructuringElement>
+class ITK_EXPORT ComponentTreeClosingByReconstructionImageFilter
+    : public ComponentTreeByReconstructionImageFilter<TInputImage, TOutputImage, itk::GrayscaleDilateImageFilter<TInputImage, TInputImage, TStructuringElement>,
+                                                      std::less<typename TInputImage::PixelType>>
+{
+public:
+  /** Standard typedefs */
+  typedef ComponentTreeClosingByReconstructionImageFilter Self;
+  typedef ComponentTreeByReconstructionImageFilter<TInputImage, TOutputImage, itk::GrayscaleDilateImageFilter<TInputImage, TInputImage, TStructuringElement>,
+                                                   std::less<typename TInputImage::PixelType>>
+                                        Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(ComponentTreeClosingByReconstructionImageFilter, ComponentTreeByReconstructionImageFilter);
+
+  typedef typename Superclass::KernelType KernelType;
+
+protected:
+  /** Constructor */
+  ComponentTreeClosingByReconstructionImageFilter() = default;
+
+  /** Destructor */
+  ~ComponentTreeClosingByReconstructionImageFilter() override = default;
+
+private:
+  ComponentTreeClosingByReconstructionImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+} // End namespace otb
+
+#endif
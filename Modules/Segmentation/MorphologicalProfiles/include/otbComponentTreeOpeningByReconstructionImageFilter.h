@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComponentTreeOpeningByReconstructionImageFilter_h
+#define otbComponentTreeOpeningByReconstructionImageFilter_h
+
+#include "otbComponentTreeByReconstructionImageFilter.h"
+#include "itkGrayscaleErodeImageFilter.h"
+
+namespace otb
+{
+/** \class ComponentTreeOpeningByReconstructionImageFilter
+ *  \brief Opening by reconstruction using the component tree of the input.
+ *
+ * The erosion of the input by the structuring element is computed with the
+ * itk::GrayscaleErodeImageFilter, then reconstructed by dilation under the input with a
+ * ComponentTreeReconstructionImageFilter. It gives the results of
+ * itk::OpeningByReconstructionImageFilter without PreserveIntensities, and can replace it in the
+ * MorphologicalOpeningProfileFilter, where the tree of the input is then built once for the whole
+ * profile.
+ *
+ * \sa ComponentTreeByReconstructionImageFilter
+ * \sa ComponentTreeClosingByReconstructionImageFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage, class TStructuringElement>
+class ITK_EXPORT ComponentTreeOpeningByReconstructionImageFilter
+    : public ComponentTreeByReconstructionImageFilter<TInputImage, TOutputImage, itk::GrayscaleErodeImageFilter<TInputImage, TInputImage, TStructuringElement>,
+                                                      std::greater<typename TInputImage::PixelType>>
+{
+public:
+  /** Standard typedefs */
+  typedef ComponentTreeOpeningByReconstructionImageFilter Self;
+  typedef ComponentTreeByReconstructionImageFilter<TInputImage, TOutputImage, itk::GrayscaleErodeImageFilter<TInputImage, TInputImage, TStructuringElement>,
+                                                   std::greater<typename TInputImage::PixelType>>
+                                        Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(ComponentTreeOpeningByReconstructionImageFilter, ComponentTreeByReconstructionImageFilter);
+
+  typedef typename Superclass::KernelType KernelType;
+
+protected:
+  /** Constructor */
+  ComponentTreeOpeningByReconstructionImageFilter() = default;
+
+  /** Destructor */
+  ~ComponentTreeOpeningByReconstructionImageFilter() override = default;
+
+private:
+  ComponentTreeOpeningByReconstructionImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+} // End namespace otb
+
+#endif
@@ -0,0 +1,160 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComponentTreeReconstructionImageFilter_h
+#define otbComponentTreeReconstructionImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+#include <functional>
+#include <vector>
+
+namespace otb
+{
+/** \class ComponentTreeReconstructionImageFilter
+ *  \brief Morphological reconstruction of a marker image under (or above) a mask image, using
+ *  the component tree of the mask.
+ *
+ * With TCompare = std::greater, the default, this filter computes the reconstruction by dilation
+ * of the marker under the mask, like itk::ReconstructionByDilationImageFilter: the value of a
+ * pixel is the highest level \f$ h \f$ such that the connected component of the upper level set
+ * of the mask \f$ \{f \geq h\} \f$ containing it contains a pixel of the marker \f$ \{g \geq h\} \f$.
+ * With TCompare = std::less, the same holds for the lower level sets, and the filter computes the
+ * reconstruction by erosion of the marker above the mask, like itk::ReconstructionByErosionImageFilter.
+ *
+ * These components are the nodes of the max-tree (respectively the min-tree) of the mask, built by
+ * the union-find algorithm of Berger et al. The reconstruction is then derived from the extreme
+ * marker value of each subtree, with two linear traversals of the tree.
+ *
+ * The tree only depends on the mask and on the connectivity, and is kept between the updates:
+ * reconstructing several markers under the same mask, as the openings or closings by reconstruction
+ * of a morphological profile do, builds the tree once. The tree takes about 16 bytes per pixel.
+ *
+ * Like the ITK reconstruction filters, this filter processes the largest possible region. The
+ * marker is expected to be lower than the mask (respectively higher), and both images to be 2D.
+ *
+ * \sa itk::ReconstructionByDilationImageFilter
+ * \sa itk::ReconstructionByErosionImageFilter
+ * \sa ComponentTreeByReconstructionImageFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage, class TCompare = std::greater<typename TInputImage::PixelType>>
+class ITK_EXPORT ComponentTreeReconstructionImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef ComponentTreeReconstructionImageFilter             Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>                            Pointer;
+  typedef itk::SmartPointer<const Self>                      ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(ComponentTreeReconstructionImageFilter, ImageToImageFilter);
+
+  /** Template parameters typedefs */
+  typedef TInputImage                          InputImageType;
+  typedef TOutputImage                         OutputImageType;
+  typedef TCompare                             CompareType;
+  typedef typename InputImageType::PixelType   InputPixelType;
+  typedef typename OutputImageType::PixelType  OutputPixelType;
+  typedef typename InputImageType::RegionType  InputImageRegionType;
+  typedef typename OutputImageType::RegionType OutputImageRegionType;
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TInputImage::ImageDimension);
+  static_assert(ImageDimension == 2, "ComponentTreeReconstructionImageFilter only handles 2D images");
+
+  /** Set/Get the marker image */
+  void SetMarkerImage(const InputImageType* marker)
+  {
+    this->SetNthInput(0, const_cast<InputImageType*>(marker));
+  }
+  const InputImageType* GetMarkerImage() const
+  {
+    return static_cast<const InputImageType*>(this->itk::ProcessObject::GetInput(0));
+  }
+
+  /** Set/Get the mask image */
+  void SetMaskImage(const InputImageType* mask)
+  {
+    this->SetNthInput(1, const_cast<InputImageType*>(mask));
+  }
+  const InputImageType* GetMaskImage() const
+  {
+    return static_cast<const InputImageType*>(this->itk::ProcessObject::GetInput(1));
+  }
+
+  /** Set/Get whether the connected components use the full (8) connectivity */
+  itkSetMacro(FullyConnected, bool);
+  itkGetConstReferenceMacro(FullyConnected, bool);
+  itkBooleanMacro(FullyConnected);
+
+  /** True if the last update reused the tree of the previous one */
+  itkGetConstMacro(TreeReused, bool);
+
+protected:
+  /** Constructor */
+  ComponentTreeReconstructionImageFilter();
+  /** Destructor */
+  ~ComponentTreeReconstructionImageFilter() override = default;
+
+  /** The whole inputs are needed */
+  void GenerateInputRequestedRegion() override;
+  /** The whole output is produced */
+  void EnlargeOutputRequestedRegion(itk::DataObject* output) override;
+  /** GenerateData method */
+  void GenerateData() override;
+
+  /**PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  ComponentTreeReconstructionImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** Build the component tree of the mask */
+  void BuildTree();
+
+  bool m_FullyConnected;
+  bool m_TreeReused;
+
+  /** Pixels sorted from the leaves to the root, and parent of each pixel. The parent of a pixel
+   * is the canonical pixel of its node, or the canonical pixel of the parent node for the
+   * canonical pixels */
+  std::vector<std::size_t> m_Order;
+  std::vector<std::size_t> m_Parent;
+
+  /** Mask, mask state and connectivity the tree was built from */
+  const InputImageType* m_TreeMask;
+  itk::ModifiedTimeType m_TreeMaskMTime;
+  itk::ModifiedTimeType m_TreeMaskUpdateMTime;
+  InputImageRegionType  m_TreeRegion;
+  bool                  m_TreeFullyConnected;
+};
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbComponentTreeReconstructionImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,245 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbComponentTreeReconstructionImageFilter_hxx
+#define otbComponentTreeReconstructionImageFilter_hxx
+
+#include "otbComponentTreeReconstructionImageFilter.h"
+#include "itkProgressReporter.h"
+
+#include <algorithm>
+#include <numeric>
+
+namespace otb
+{
+/**
+ * Constructor
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::ComponentTreeReconstructionImageFilter()
+  : m_FullyConnected(false), m_TreeReused(false), m_TreeMask(nullptr), m_TreeMaskMTime(0), m_TreeMaskUpdateMTime(0), m_TreeFullyConnected(false)
+{
+  this->SetNumberOfRequiredInputs(2);
+}
+
+/**
+ * Generate input requested region
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateInputRequestedRegion()
+{
+  // Call the superclass' implementation of this method
+  Superclass::GenerateInputRequestedRegion();
+
+  for (unsigned int i = 0; i < 2; ++i)
+  {
+    InputImageType* inputPtr = const_cast<InputImageType*>(static_cast<const InputImageType*>(this->itk::ProcessObject::GetInput(i)));
+    if (inputPtr)
+    {
+      inputPtr->SetRequestedRegion(inputPtr->GetLargestPossibleRegion());
+    }
+  }
+}
+
+/**
+ * Enlarge output requested region
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::EnlargeOutputRequestedRegion(itk::DataObject*)
+{
+  this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+}
+
+/**
+ * Build the component tree of the mask
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::BuildTree()
+{
+  const InputImageType*       mask     = this->GetMaskImage();
+  const InputImageRegionType& region   = mask->GetBufferedRegion();
+  const long                  width    = region.GetSize()[0];
+  const long                  height   = region.GetSize()[1];
+  const std::size_t           nbPixels = region.GetNumberOfPixels();
+  const auto                  values   = mask->GetBufferPointer();
+  const CompareType           compare;
+
+  // The leaves, at the most extreme levels, are processed first
+  m_Order.resize(nbPixels);
+  std::iota(m_Order.begin(), m_Order.end(), 0);
+  std::sort(m_Order.begin(), m_Order.end(), [&](std::size_t a, std::size_t b) { return compare(values[a], values[b]); });
+
+  const long        nbNeighbors   = m_FullyConnected ? 8 : 4;
+  const long        neighborsX[8] = {-1, 1, 0, 0, -1, 1, -1, 1};
+  const long        neighborsY[8] = {0, 0, -1, 1, -1, -1, 1, 1};
+  const std::size_t unprocessed   = nbPixels;
+
+  // Union-find of the components, the root of each set being its
+  // lowest (respectively highest) pixel processed so far
+  std::vector<std::size_t> sets(nbPixels, unprocessed);
+  auto                     findRoot = [&sets](std::size_t p) {
+    std::size_t root = p;
+    while (sets[root] != root)
+    {
+      root = sets[root];
+    }
+    while (sets[p] != root)
+    {
+      const std::size_t next = sets[p];
+      sets[p]                = root;
+      p                      = next;
+    }
+    return root;
+  };
+
+  m_Parent.resize(nbPixels);
+  for (const std::size_t p : m_Order)
+  {
+    m_Parent[p] = p;
+    sets[p]     = p;
+
+    const long x = p % width;
+    const long y = p / width;
+    for (long k = 0; k < nbNeighbors; ++k)
+    {
+      const long nx = x + neighborsX[k];
+      const long ny = y + neighborsY[k];
+      if (nx < 0 || nx >= width || ny < 0 || ny >= height)
+      {
+        continue;
+      }
+      const std::size_t n = ny * width + nx;
+      if (sets[n] == unprocessed)
+      {
+        continue;
+      }
+      const std::size_t root = findRoot(n);
+      if (root != p)
+      {
+        m_Parent[root] = p;
+        sets[root]     = p;
+      }
+    }
+  }
+
+  // Link each pixel to the canonical pixel of its node, from the root to the leaves
+  for (auto it = m_Order.rbegin(); it != m_Order.rend(); ++it)
+  {
+    const std::size_t q = m_Parent[*it];
+    if (values[m_Parent[q]] == values[q])
+    {
+      m_Parent[*it] = m_Parent[q];
+    }
+  }
+}
+
+/**
+ * GenerateData method
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::GenerateData()
+{
+  const InputImageType* marker = this->GetMarkerImage();
+  const InputImageType* mask   = this->GetMaskImage();
+
+  if (marker->GetBufferedRegion() != mask->GetBufferedRegion())
+  {
+    itkExceptionMacro(<< "The marker and mask images must have the same region");
+  }
+
+  OutputImageType* output = this->GetOutput();
+  output->SetBufferedRegion(output->GetRequestedRegion());
+  output->Allocate();
+
+  const std::size_t     nbPixels = mask->GetBufferedRegion().GetNumberOfPixels();
+  itk::ProgressReporter progress(this, 0, 2 * nbPixels);
+
+  m_TreeReused = m_Order.size() == nbPixels && m_TreeMask == mask && m_TreeMaskMTime == mask->GetMTime() &&
+                 m_TreeMaskUpdateMTime == mask->GetUpdateMTime() && m_TreeRegion == mask->GetBufferedRegion() && m_TreeFullyConnected == m_FullyConnected;
+  if (!m_TreeReused)
+  {
+    this->BuildTree();
+    m_TreeMask            = mask;
+    m_TreeMaskMTime       = mask->GetMTime();
+    m_TreeMaskUpdateMTime = mask->GetUpdateMTime();
+    m_TreeRegion          = mask->GetBufferedRegion();
+    m_TreeFullyConnected  = m_FullyConnected;
+  }
+
+  const auto        values = mask->GetBufferPointer();
+  const CompareType compare;
+  auto              leastExtreme = [&compare](InputPixelType a, InputPixelType b) { return compare(a, b) ? b : a; };
+
+  // Most extreme marker value of each subtree, accumulated from the leaves
+  std::vector<InputPixelType> extremes(marker->GetBufferPointer(), marker->GetBufferPointer() + nbPixels);
+  for (const std::size_t p : m_Order)
+  {
+    const std::size_t q = m_Parent[p];
+    if (compare(extremes[p], extremes[q]))
+    {
+      extremes[q] = extremes[p];
+    }
+    progress.CompletedPixel();
+  }
+
+  // The reconstruction of a node is its level when its subtree reaches
+  // it, the subtree extreme when it lies between the levels of the node
+  // and of its parent, and the reconstruction of the parent otherwise
+  std::vector<InputPixelType> reconstruction(nbPixels);
+  for (auto it = m_Order.rbegin(); it != m_Order.rend(); ++it)
+  {
+    const std::size_t p = *it;
+    const std::size_t q = m_Parent[p];
+    if (q == p)
+    {
+      reconstruction[p] = leastExtreme(values[p], extremes[p]);
+    }
+    else if (values[q] == values[p])
+    {
+      reconstruction[p] = reconstruction[q];
+    }
+    else if (compare(extremes[p], values[q]))
+    {
+      reconstruction[p] = leastExtreme(values[p], extremes[p]);
+    }
+    else
+    {
+      reconstruction[p] = reconstruction[q];
+    }
+    progress.CompletedPixel();
+  }
+
+  std::transform(reconstruction.begin(), reconstruction.end(), output->GetBufferPointer(),
+                 [](InputPixelType value) { return static_cast<OutputPixelType>(value); });
+}
+
+/**
+ * PrintSelf Method
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, TCompare>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "FullyConnected: " << m_FullyConnected << std::endl;
+  os << indent << "TreeReused: " << m_TreeReused << std::endl;
+}
+
+} // End namespace otb
+#endif
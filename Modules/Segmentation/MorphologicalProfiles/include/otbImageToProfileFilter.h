@@ -38,6 +38,11 @@ namespace otb
  * by the type of the filter \f$ \phi \f$. The SetProfileParameter() is a virtual method meant to be
  * rewritten so that the filter can be correctly set up in sub-classes.
  *
+ * The same filter instance computes every element of the profile, for increasing parameters when
+ * the step is positive. Filters keeping an intermediate result between updates can thus derive
+ * the element of a parameter from the one of the previous parameter, as
+ * VanHerkGilWermanOpeningByReconstructionImageFilter does with nested structuring elements.
+ *
  * \sa MorphologicalOpeningProfileFilter
  * \sa MorhologicalClosingProfileFilter
  *
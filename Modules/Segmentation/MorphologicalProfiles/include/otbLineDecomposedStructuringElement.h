@@ -0,0 +1,150 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLineDecomposedStructuringElement_h
+#define otbLineDecomposedStructuringElement_h
+
+#include "itkMacro.h"
+#include "itkOffset.h"
+#include "itkSize.h"
+#include <vector>
+
+namespace otb
+{
+/** \class LineDecomposedStructuringElement
+ *  \brief Flat structuring element defined as the Minkowski sum of centered lines.
+ *
+ * Each line has a direction, whose components are in \f$ \{-1, 0, 1\} \f$, and a radius:
+ * it contains the \f$ 2r+1 \f$ points \f$ k \cdot d, k \in [-r, r] \f$. A direction and its opposite
+ * define the same line, and lines sharing a direction are merged by adding their radii.
+ *
+ * Three shapes are available:
+ *  - BOX: one line per axis, giving a rectangle,
+ *  - DISK: an octagonal approximation of a disk, made of the horizontal, vertical and both
+ *    diagonal lines (2D only),
+ *  - LINES: the lines given with AddLine(), CreateStructuringElement() leaves them unchanged.
+ *
+ * Like the ITK structuring elements, the element is set up with SetRadius() followed by
+ * CreateStructuringElement(). It is meant to be used with the VanHerkGilWermanErodeImageFilter
+ * and VanHerkGilWermanDilateImageFilter, whose cost per pixel does not depend on the radii.
+ *
+ * GetIncrement() tells whether an element contains this one line by line and, if so, gives the
+ * lines to apply to the result of this element to get the result of the larger one. Disks whose
+ * radii differ by an even number are always nested this way.
+ *
+ * \sa VanHerkGilWermanMorphologyImageFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <unsigned int VDimension = 2>
+class ITK_EXPORT LineDecomposedStructuringElement
+{
+public:
+  /** Standard typedefs */
+  typedef LineDecomposedStructuringElement Self;
+
+  itkStaticConstMacro(Dimension, unsigned int, VDimension);
+
+  typedef itk::Offset<VDimension> OffsetType;
+  typedef itk::Size<VDimension>   RadiusType;
+
+  /** A centered line of 2 * Radius + 1 points along Direction */
+  struct LineType
+  {
+    OffsetType   Direction;
+    unsigned int Radius;
+  };
+  typedef std::vector<LineType> LineListType;
+
+  enum ShapeType
+  {
+    BOX,
+    DISK,
+    LINES
+  };
+
+  LineDecomposedStructuringElement();
+
+  /** Box of the given radius */
+  static Self Box(const RadiusType& radius);
+  /** Octagonal approximation of a disk of the given radius */
+  static Self Disk(const RadiusType& radius);
+
+  void SetShape(ShapeType shape)
+  {
+    m_Shape = shape;
+  }
+  ShapeType GetShape() const
+  {
+    return m_Shape;
+  }
+
+  /** Radius of the shape, used by CreateStructuringElement() */
+  void SetRadius(const RadiusType& radius)
+  {
+    m_Radius = radius;
+  }
+  void SetRadius(itk::SizeValueType radius)
+  {
+    m_Radius.Fill(radius);
+  }
+  const RadiusType& GetRadius() const
+  {
+    return m_Radius;
+  }
+
+  /** Build the lines of the shape from the radius */
+  void CreateStructuringElement();
+
+  /** Add a line, merged with the line of same direction if any */
+  void AddLine(const OffsetType& direction, unsigned int radius);
+
+  /** Remove all lines */
+  void ClearLines()
+  {
+    m_Lines.clear();
+  }
+
+  const LineListType& GetLines() const
+  {
+    return m_Lines;
+  }
+
+  /** Radius of the bounding box of the element */
+  RadiusType GetBoundingRadius() const;
+
+  /** If each line of this element is contained in the line of same direction of other,
+   * fill increment with the lines to apply after this element to get other and return true.
+   * Return false otherwise. */
+  bool GetIncrement(const Self& other, Self& increment) const;
+
+private:
+  ShapeType    m_Shape;
+  RadiusType   m_Radius;
+  LineListType m_Lines;
+};
+
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbLineDecomposedStructuringElement.hxx"
+#endif
+
+#endif
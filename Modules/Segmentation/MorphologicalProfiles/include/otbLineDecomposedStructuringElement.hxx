@@ -0,0 +1,183 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbLineDecomposedStructuringElement_hxx
+#define otbLineDecomposedStructuringElement_hxx
+
+#include "otbLineDecomposedStructuringElement.h"
+#include <algorithm>
+#include <cmath>
+
+namespace otb
+{
+template <unsigned int VDimension>
+LineDecomposedStructuringElement<VDimension>::LineDecomposedStructuringElement() : m_Shape(DISK)
+{
+  m_Radius.Fill(0);
+}
+
+template <unsigned int VDimension>
+typename LineDecomposedStructuringElement<VDimension>::Self LineDecomposedStructuringElement<VDimension>::Box(const RadiusType& radius)
+{
+  Self element;
+  element.SetShape(BOX);
+  element.SetRadius(radius);
+  element.CreateStructuringElement();
+  return element;
+}
+
+template <unsigned int VDimension>
+typename LineDecomposedStructuringElement<VDimension>::Self LineDecomposedStructuringElement<VDimension>::Disk(const RadiusType& radius)
+{
+  Self element;
+  element.SetShape(DISK);
+  element.SetRadius(radius);
+  element.CreateStructuringElement();
+  return element;
+}
+
+template <unsigned int VDimension>
+void LineDecomposedStructuringElement<VDimension>::CreateStructuringElement()
+{
+  if (m_Shape == LINES)
+  {
+    return;
+  }
+  m_Lines.clear();
+
+  OffsetType direction;
+  if (m_Shape == BOX)
+  {
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      direction.Fill(0);
+      direction[dim] = 1;
+      AddLine(direction, m_Radius[dim]);
+    }
+    return;
+  }
+
+  if (VDimension != 2)
+  {
+    itkGenericExceptionMacro(<< "Disk structuring elements are only available in 2D");
+  }
+
+  // The diagonal lines give a diamond of radius 2*b with holes on odd
+  // positions, filled by axis lines of radius a >= 1. A regular octagon of
+  // radius a + 2*b has a = b*sqrt(2).
+  const itk::SizeValueType minRadius      = std::min(m_Radius[0], m_Radius[1]);
+  unsigned int             diagonalRadius = 0;
+  if (minRadius > 0)
+  {
+    diagonalRadius = std::min(static_cast<unsigned int>(std::floor(minRadius / (2. + std::sqrt(2.)) + 0.5)), static_cast<unsigned int>((minRadius - 1) / 2));
+  }
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    direction.Fill(0);
+    direction[dim] = 1;
+    AddLine(direction, m_Radius[dim] - 2 * diagonalRadius);
+  }
+  direction[0] = 1;
+  direction[1] = 1;
+  AddLine(direction, diagonalRadius);
+  direction[1] = -1;
+  AddLine(direction, diagonalRadius);
+}
+
+template <unsigned int VDimension>
+void LineDecomposedStructuringElement<VDimension>::AddLine(const OffsetType& direction, unsigned int radius)
+{
+  // Use the direction whose first non null component is positive
+  OffsetType canonical = direction;
+  int        sign      = 0;
+  for (unsigned int dim = 0; dim < VDimension; ++dim)
+  {
+    if (direction[dim] < -1 || direction[dim] > 1)
+    {
+      itkGenericExceptionMacro(<< "Line direction components must be -1, 0 or 1, got " << direction);
+    }
+    if (sign == 0 && direction[dim] != 0)
+    {
+      sign = direction[dim];
+    }
+  }
+  if (sign == 0)
+  {
+    itkGenericExceptionMacro(<< "Line direction must not be null");
+  }
+  for (unsigned int dim = 0; dim < VDimension; ++dim)
+  {
+    canonical[dim] *= sign;
+  }
+
+  if (radius == 0)
+  {
+    return;
+  }
+  for (auto& line : m_Lines)
+  {
+    if (line.Direction == canonical)
+    {
+      line.Radius += radius;
+      return;
+    }
+  }
+  m_Lines.push_back(LineType{canonical, radius});
+}
+
+template <unsigned int VDimension>
+typename LineDecomposedStructuringElement<VDimension>::RadiusType LineDecomposedStructuringElement<VDimension>::GetBoundingRadius() const
+{
+  RadiusType radius;
+  radius.Fill(0);
+  for (const auto& line : m_Lines)
+  {
+    for (unsigned int dim = 0; dim < VDimension; ++dim)
+    {
+      radius[dim] += std::abs(line.Direction[dim]) * line.Radius;
+    }
+  }
+  return radius;
+}
+
+template <unsigned int VDimension>
+bool LineDecomposedStructuringElement<VDimension>::GetIncrement(const Self& other, Self& increment) const
+{
+  increment = Self();
+  increment.SetShape(LINES);
+  for (const auto& line : m_Lines)
+  {
+    auto it = std::find_if(other.m_Lines.begin(), other.m_Lines.end(), [&line](const LineType& l) { return l.Direction == line.Direction; });
+    if (it == other.m_Lines.end() || it->Radius < line.Radius)
+    {
+      return false;
+    }
+  }
+  for (const auto& line : other.m_Lines)
+  {
+    auto it = std::find_if(m_Lines.begin(), m_Lines.end(), [&line](const LineType& l) { return l.Direction == line.Direction; });
+    increment.AddLine(line.Direction, it == m_Lines.end() ? line.Radius : line.Radius - it->Radius);
+  }
+  return true;
+}
+
+} // End namespace otb
+
+#endif
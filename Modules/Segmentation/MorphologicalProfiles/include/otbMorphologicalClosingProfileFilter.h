@@ -43,23 +43,29 @@ namespace otb
  * For more information on profiles please refer to the documentation of the otb::ImageToProfileFilter
  * class.
  *
+ * The filter computing each closing by reconstruction is itk::ClosingByReconstructionImageFilter by
+ * default. With a LineDecomposedStructuringElement, VanHerkGilWermanClosingByReconstructionImageFilter
+ * can be used instead: the cost of its dilation does not depend on the radius, and each dilation is
+ * computed from the previous one. ComponentTreeClosingByReconstructionImageFilter computes the same
+ * closings as the default filter, building the min-tree of the input once for the whole profile.
+ *
  * \sa ImageToProfileFilter
  * \sa itk::ClosingByReconstructionImageFilter
+ * \sa VanHerkGilWermanClosingByReconstructionImageFilter
+ * \sa ComponentTreeClosingByReconstructionImageFilter
  *
  * \ingroup OTBMorphologicalProfiles
  */
-template <class TInputImage, class TOutputImage, class TStructuringElement>
-class ITK_EXPORT MorphologicalClosingProfileFilter
-    : public ImageToProfileFilter<TInputImage, TOutputImage, itk::ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>,
-                                  unsigned int>
+template <class TInputImage, class TOutputImage, class TStructuringElement,
+          class TFilter = itk::ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>>
+class ITK_EXPORT MorphologicalClosingProfileFilter : public ImageToProfileFilter<TInputImage, TOutputImage, TFilter, unsigned int>
 {
 public:
   /** Standard typedefs */
-  typedef MorphologicalClosingProfileFilter Self;
-  typedef ImageToProfileFilter<TInputImage, TOutputImage, itk::ClosingByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>, unsigned int>
-                                        Superclass;
-  typedef itk::SmartPointer<Self>       Pointer;
-  typedef itk::SmartPointer<const Self> ConstPointer;
+  typedef MorphologicalClosingProfileFilter                                      Self;
+  typedef ImageToProfileFilter<TInputImage, TOutputImage, TFilter, unsigned int> Superclass;
+  typedef itk::SmartPointer<Self>                                                Pointer;
+  typedef itk::SmartPointer<const Self>                                          ConstPointer;
 
   /** Type macro */
   itkNewMacro(Self);
@@ -43,23 +43,29 @@ namespace otb
  * For more information on profiles please refer to the documentation of the otb::ImageToProfileFilter
  * class.
  *
+ * The filter computing each opening by reconstruction is itk::OpeningByReconstructionImageFilter by
+ * default. With a LineDecomposedStructuringElement, VanHerkGilWermanOpeningByReconstructionImageFilter
+ * can be used instead: the cost of its erosion does not depend on the radius, and each erosion is
+ * computed from the previous one. ComponentTreeOpeningByReconstructionImageFilter computes the same
+ * openings as the default filter, building the max-tree of the input once for the whole profile.
+ *
  * \sa ImageToProfileFilter
  * \sa itk::OpeningByReconstructionImageFilter
+ * \sa VanHerkGilWermanOpeningByReconstructionImageFilter
+ * \sa ComponentTreeOpeningByReconstructionImageFilter
  *
  * \ingroup OTBMorphologicalProfiles
  */
-template <class TInputImage, class TOutputImage, class TStructuringElement>
-class ITK_EXPORT MorphologicalOpeningProfileFilter
-    : public ImageToProfileFilter<TInputImage, TOutputImage, itk::OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>,
-                                  unsigned int>
+template <class TInputImage, class TOutputImage, class TStructuringElement,
+          class TFilter = itk::OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>>
+class ITK_EXPORT MorphologicalOpeningProfileFilter : public ImageToProfileFilter<TInputImage, TOutputImage, TFilter, unsigned int>
 {
 public:
   /** Standard typedefs */
-  typedef MorphologicalOpeningProfileFilter Self;
-  typedef ImageToProfileFilter<TInputImage, TOutputImage, itk::OpeningByReconstructionImageFilter<TInputImage, TOutputImage, TStructuringElement>, unsigned int>
-                                        Superclass;
-  typedef itk::SmartPointer<Self>       Pointer;
-  typedef itk::SmartPointer<const Self> ConstPointer;
+  typedef MorphologicalOpeningProfileFilter                                      Self;
+  typedef ImageToProfileFilter<TInputImage, TOutputImage, TFilter, unsigned int> Superclass;
+  typedef itk::SmartPointer<Self>                                                Pointer;
+  typedef itk::SmartPointer<const Self>                                          ConstPointer;
 
   /** Type macro */
   itkNewMacro(Self);
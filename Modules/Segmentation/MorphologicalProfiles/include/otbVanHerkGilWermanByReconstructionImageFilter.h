@@ -0,0 +1,133 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbVanHerkGilWermanByReconstructionImageFilter_h
+#define otbVanHerkGilWermanByReconstructionImageFilter_h
+
+#include "itkImageToImageFilter.h"
+
+namespace otb
+{
+/** \class VanHerkGilWermanByReconstructionImageFilter
+ *  \brief Base class of the openings and closings by reconstruction using a van Herk/Gil-Werman
+ *  erosion or dilation.
+ *
+ * The input is first filtered by TMorphologyFilter, an erosion or a dilation by a line
+ * decomposed structuring element. The result is the marker of TReconstructionFilter, the input
+ * being the mask.
+ *
+ * When ReuseMarker is on, the marker is kept after each update. If the input has not changed
+ * and the new structuring element contains the previous one line by line, the next update only
+ * filters the kept marker by the lines missing from the previous element. Profiles with
+ * increasing radii, computed by ImageToProfileFilter with a single filter, thus derive each
+ * marker from the previous one. The reconstruction filter is kept as well, so that a
+ * ComponentTreeReconstructionImageFilter builds the tree of the input once for the profile.
+ *
+ * Like the reconstruction, this filter processes the largest possible region.
+ *
+ * \sa VanHerkGilWermanOpeningByReconstructionImageFilter
+ * \sa VanHerkGilWermanClosingByReconstructionImageFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TReconstructionFilter>
+class ITK_EXPORT VanHerkGilWermanByReconstructionImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef VanHerkGilWermanByReconstructionImageFilter        Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>                            Pointer;
+  typedef itk::SmartPointer<const Self>                      ConstPointer;
+
+  /** Creation through object factory macro */
+  itkTypeMacro(VanHerkGilWermanByReconstructionImageFilter, ImageToImageFilter);
+
+  /** Template parameters typedefs */
+  typedef TInputImage                                    InputImageType;
+  typedef TOutputImage                                   OutputImageType;
+  typedef TMorphologyFilter                              MorphologyFilterType;
+  typedef TReconstructionFilter                          ReconstructionFilterType;
+  typedef typename MorphologyFilterType::KernelType      KernelType;
+  typedef typename MorphologyFilterType::OutputImageType MarkerImageType;
+
+  /** Set/Get the structuring element */
+  void SetKernel(const KernelType& kernel)
+  {
+    m_Kernel = kernel;
+    this->Modified();
+  }
+  itkGetConstReferenceMacro(Kernel, KernelType);
+
+  /** Set/Get whether the reconstruction uses the full connectivity */
+  itkSetMacro(FullyConnected, bool);
+  itkGetConstReferenceMacro(FullyConnected, bool);
+  itkBooleanMacro(FullyConnected);
+
+  /** Set/Get whether the marker is kept to compute the next one */
+  itkSetMacro(ReuseMarker, bool);
+  itkGetConstReferenceMacro(ReuseMarker, bool);
+  itkBooleanMacro(ReuseMarker);
+
+  /** True if the last update derived its marker from the previous one */
+  itkGetConstMacro(MarkerReused, bool);
+
+protected:
+  /** Constructor */
+  VanHerkGilWermanByReconstructionImageFilter();
+  /** Destructor */
+  ~VanHerkGilWermanByReconstructionImageFilter() override = default;
+
+  /** The whole input is needed */
+  void GenerateInputRequestedRegion() override;
+  /** The whole output is produced */
+  void EnlargeOutputRequestedRegion(itk::DataObject* output) override;
+  /** GenerateData method */
+  void GenerateData() override;
+
+  /**PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  VanHerkGilWermanByReconstructionImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  KernelType m_Kernel;
+  bool       m_FullyConnected;
+  bool       m_ReuseMarker;
+  bool       m_MarkerReused;
+
+  /** Reconstruction filter, kept between the updates */
+  typename ReconstructionFilterType::Pointer m_Reconstruction;
+
+  /** Marker of the last update, with the element and the input state it was computed from */
+  typename MarkerImageType::Pointer m_Marker;
+  KernelType                        m_MarkerKernel;
+  const InputImageType*             m_MarkerInput;
+  itk::ModifiedTimeType             m_MarkerInputMTime;
+  itk::ModifiedTimeType             m_MarkerInputUpdateMTime;
+};
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbVanHerkGilWermanByReconstructionImageFilter.hxx"
+#endif
+
+#endif
@@ -0,0 +1,144 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbVanHerkGilWermanByReconstructionImageFilter_hxx
+#define otbVanHerkGilWermanByReconstructionImageFilter_hxx
+
+#include "otbVanHerkGilWermanByReconstructionImageFilter.h"
+#include "itkProgressAccumulator.h"
+
+namespace otb
+{
+/**
+ * Constructor
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TReconstructionFilter>
+VanHerkGilWermanByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TReconstructionFilter>::VanHerkGilWermanByReconstructionImageFilter()
+  : m_FullyConnected(false),
+    m_ReuseMarker(true),
+    m_MarkerReused(false),
+    m_Reconstruction(ReconstructionFilterType::New()),
+    m_Marker(nullptr),
+    m_MarkerInput(nullptr),
+    m_MarkerInputMTime(0),
+    m_MarkerInputUpdateMTime(0)
+{
+}
+
+/**
+ * Generate input requested region
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TReconstructionFilter>
+void VanHerkGilWermanByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TReconstructionFilter>::GenerateInputRequestedRegion()
+{
+  // Call the superclass' implementation of this method
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (inputPtr)
+  {
+    inputPtr->SetRequestedRegion(inputPtr->GetLargestPossibleRegion());
+  }
+}
+
+/**
+ * Enlarge output requested region
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TReconstructionFilter>
+void VanHerkGilWermanByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TReconstructionFilter>::EnlargeOutputRequestedRegion(
+    itk::DataObject*)
+{
+  this->GetOutput()->SetRequestedRegion(this->GetOutput()->GetLargestPossibleRegion());
+}
+
+/**
+ * GenerateData method
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TReconstructionFilter>
+void VanHerkGilWermanByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TReconstructionFilter>::GenerateData()
+{
+  const InputImageType* inputPtr = this->GetInput();
+
+  itk::ProgressAccumulator::Pointer progress = itk::ProgressAccumulator::New();
+  progress->SetMiniPipelineFilter(this);
+
+  // The kept marker can be used if it was computed from the same input
+  // data, with an element contained in the current one
+  KernelType increment;
+  m_MarkerReused = m_ReuseMarker && m_Marker.IsNotNull() && m_MarkerInput == inputPtr && m_MarkerInputMTime == inputPtr->GetMTime() &&
+                   m_MarkerInputUpdateMTime == inputPtr->GetUpdateMTime() &&
+                   m_Marker->GetBufferedRegion() == inputPtr->GetLargestPossibleRegion() && m_MarkerKernel.GetIncrement(m_Kernel, increment);
+
+  typename MorphologyFilterType::Pointer morphology = MorphologyFilterType::New();
+  morphology->SetNumberOfThreads(this->GetNumberOfThreads());
+  if (m_MarkerReused)
+  {
+    morphology->SetInput(m_Marker);
+    morphology->SetKernel(increment);
+  }
+  else
+  {
+    morphology->SetInput(inputPtr);
+    morphology->SetKernel(m_Kernel);
+  }
+  progress->RegisterInternalFilter(morphology, 0.5f);
+  morphology->Update();
+
+  typename MarkerImageType::Pointer marker = morphology->GetOutput();
+  marker->DisconnectPipeline();
+
+  m_Reconstruction->SetMarkerImage(marker);
+  m_Reconstruction->SetMaskImage(inputPtr);
+  m_Reconstruction->SetFullyConnected(m_FullyConnected);
+  progress->RegisterInternalFilter(m_Reconstruction, 0.5f);
+  m_Reconstruction->GraftOutput(this->GetOutput());
+  m_Reconstruction->Update();
+  this->GraftOutput(m_Reconstruction->GetOutput());
+
+  if (m_ReuseMarker)
+  {
+    m_Marker                 = marker;
+    m_MarkerKernel           = m_Kernel;
+    m_MarkerInput            = inputPtr;
+    m_MarkerInputMTime       = inputPtr->GetMTime();
+    m_MarkerInputUpdateMTime = inputPtr->GetUpdateMTime();
+  }
+  else
+  {
+    m_Marker = nullptr;
+  }
+}
+
+/**
+ * PrintSelf Method
+ */
+template <class TInputImage, class TOutputImage, class TMorphologyFilter, class TReconstructionFilter>
+void VanHerkGilWermanByReconstructionImageFilter<TInputImage, TOutputImage, TMorphologyFilter, TReconstructionFilter>::PrintSelf(std::ostream& os,
+                                                                                                                               itk::Indent   indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Kernel lines: " << m_Kernel.GetLines().size() << std::endl;
+  os << indent << "FullyConnected: " << m_FullyConnected << std::endl;
+  os << indent << "ReuseMarker: " << m_ReuseMarker << std::endl;
+  os << indent << "MarkerReused: " << m_MarkerReused << std::endl;
+}
+
+} // End namespace otb
+#endif
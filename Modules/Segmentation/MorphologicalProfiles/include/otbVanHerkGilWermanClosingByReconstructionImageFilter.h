@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbVanHerkGilWermanClosingByReconstructionImageFilter_h
+#define otbVanHerkGilWermanClosingByReconstructionImageFilter_h
+
+#include "otbVanHerkGilWermanByReconstructionImageFilter.h"
+#include "otbVanHerkGilWermanDilateImageFilter.h"
+#include "otbComponentTreeReconstructionImageFilter.h"
+
+namespace otb
+{
+/** \class VanHerkGilWermanClosingByReconstructionImageFilter
+ *  \brief Closing by reconstruction with a line decomposed structuring element.
+ *
+ * The dilation of the input is computed with the VanHerkGilWermanDilateImageFilter, then
+ * reconstructed by erosion above the input with a ComponentTreeReconstructionImageFilter. It can
+ * replace itk::ClosingByReconstructionImageFilter in the MorphologicalClosingProfileFilter, where
+ * each marker is then derived from the previous one when the structuring elements are nested, and
+ * the min-tree of the input is built once.
+ *
+ * \sa VanHerkGilWermanByReconstructionImageFilter
+ * \sa VanHerkGilWermanOpeningByReconstructionImageFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT VanHerkGilWermanClosingByReconstructionImageFilter
+    : public VanHerkGilWermanByReconstructionImageFilter<TInputImage, TOutputImage, VanHerkGilWermanDilateImageFilter<TInputImage, TInputImage>,
+                                                         ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, std::less<typename TInputImage::PixelType>>>
+{
+public:
+  /** Standard typedefs */
+  typedef VanHerkGilWermanClosingByReconstructionImageFilter Self;
+  typedef VanHerkGilWermanByReconstructionImageFilter<TInputImage, TOutputImage, VanHerkGilWermanDilateImageFilter<TInputImage, TInputImage>,
+                                                      ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, std::less<typename TInputImage::PixelType>>>
+                                        Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(VanHerkGilWermanClosingByReconstructionImageFilter, VanHerkGilWermanByReconstructionImageFilter);
+
+  typedef typename Superclass::KernelType KernelType;
+
+protected:
+  /** Constructor */
+  VanHerkGilWermanClosingByReconstructionImageFilter() = default;
+
+  /** Destructor */
+  ~VanHerkGilWermanClosingByReconstructionImageFilter() override = default;
+
+private:
+  VanHerkGilWermanClosingByReconstructionImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+} // End namespace otb
+
+#endif
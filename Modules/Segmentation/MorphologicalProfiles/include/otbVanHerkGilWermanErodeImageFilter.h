@@ -0,0 +1,76 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbVanHerkGilWermanErodeImageFilter_h
+#define otbVanHerkGilWermanErodeImageFilter_h
+
+#include "otbVanHerkGilWermanMorphologyImageFilter.h"
+#include "itkNumericTraits.h"
+#include <functional>
+
+namespace otb
+{
+/** \class VanHerkGilWermanErodeImageFilter
+ *  \brief Flat erosion by a line decomposed structuring element, in constant time per pixel.
+ *
+ * Each output pixel is the minimum of the input over the structuring element. Pixels outside
+ * the image do not contribute.
+ *
+ * \sa VanHerkGilWermanMorphologyImageFilter
+ * \sa VanHerkGilWermanDilateImageFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT VanHerkGilWermanErodeImageFilter
+    : public VanHerkGilWermanMorphologyImageFilter<TInputImage, TOutputImage, std::less<typename TInputImage::PixelType>>
+{
+public:
+  /** Standard typedefs */
+  typedef VanHerkGilWermanErodeImageFilter Self;
+  typedef VanHerkGilWermanMorphologyImageFilter<TInputImage, TOutputImage, std::less<typename TInputImage::PixelType>> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(VanHerkGilWermanErodeImageFilter, VanHerkGilWermanMorphologyImageFilter);
+
+  typedef typename Superclass::KernelType KernelType;
+
+protected:
+  /** Constructor */
+  VanHerkGilWermanErodeImageFilter()
+  {
+    this->SetBoundary(itk::NumericTraits<typename Superclass::InputPixelType>::max());
+  }
+
+  /** Destructor */
+  ~VanHerkGilWermanErodeImageFilter() override = default;
+
+private:
+  VanHerkGilWermanErodeImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+} // End namespace otb
+
+#endif
@@ -0,0 +1,128 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbVanHerkGilWermanMorphologyImageFilter_h
+#define otbVanHerkGilWermanMorphologyImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include "itkImage.h"
+#include "otbLineDecomposedStructuringElement.h"
+#include <vector>
+
+namespace otb
+{
+/** \class VanHerkGilWermanMorphologyImageFilter
+ *  \brief Flat erosion or dilation by a line decomposed structuring element.
+ *
+ * The structuring element is applied line by line. Along each line, the van Herk/Gil-Werman
+ * algorithm computes the extremum over a window of \f$ 2r+1 \f$ pixels with three comparisons
+ * per pixel, whatever the radius \f$ r \f$, from prefix and suffix extrema over blocks of
+ * \f$ 2r+1 \f$ pixels.
+ *
+ * TCompare(a, b) returns true when a is kept rather than b: std::less gives an erosion and
+ * std::greater a dilation. Pixels outside the image take the Boundary value, which should be
+ * neutral for the extremum. The VanHerkGilWermanErodeImageFilter and
+ * VanHerkGilWermanDilateImageFilter classes set it.
+ *
+ * M. van Herk, A fast algorithm for local minimum and maximum filters on rectangular and
+ * octagonal kernels, Pattern Recognition Letters, 1992, vol. 13, p. 517-521.
+ *
+ * J. Gil and M. Werman, Computing 2-D min, median, and max filters, IEEE Transactions on
+ * Pattern Analysis and Machine Intelligence, 1993, vol. 15, p. 504-507.
+ *
+ * \sa LineDecomposedStructuringElement
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+class ITK_EXPORT VanHerkGilWermanMorphologyImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputImage>
+{
+public:
+  /** Standard typedefs */
+  typedef VanHerkGilWermanMorphologyImageFilter              Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputImage> Superclass;
+  typedef itk::SmartPointer<Self>                            Pointer;
+  typedef itk::SmartPointer<const Self>                      ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(VanHerkGilWermanMorphologyImageFilter, ImageToImageFilter);
+
+  itkStaticConstMacro(ImageDimension, unsigned int, TInputImage::ImageDimension);
+
+  /** Template parameters typedefs */
+  typedef TInputImage                                      InputImageType;
+  typedef TOutputImage                                     OutputImageType;
+  typedef typename InputImageType::PixelType               InputPixelType;
+  typedef typename OutputImageType::PixelType              OutputPixelType;
+  typedef typename OutputImageType::RegionType             OutputImageRegionType;
+  typedef TCompare                                         CompareType;
+  typedef LineDecomposedStructuringElement<ImageDimension> KernelType;
+  typedef typename KernelType::LineType                    LineType;
+
+  /** Set/Get the structuring element */
+  void SetKernel(const KernelType& kernel)
+  {
+    m_Kernel = kernel;
+    this->Modified();
+  }
+  itkGetConstReferenceMacro(Kernel, KernelType);
+
+  /** Set/Get the value of pixels outside the image */
+  itkSetMacro(Boundary, InputPixelType);
+  itkGetConstMacro(Boundary, InputPixelType);
+
+protected:
+  /** Constructor */
+  VanHerkGilWermanMorphologyImageFilter();
+  /** Destructor */
+  ~VanHerkGilWermanMorphologyImageFilter() override = default;
+
+  /** Pad the input requested region by the radius of the structuring element */
+  void GenerateInputRequestedRegion() override;
+
+  void ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** PrintSelf method */
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+private:
+  VanHerkGilWermanMorphologyImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  typedef itk::Image<InputPixelType, ImageDimension> BufferImageType;
+
+  /** Apply the extremum over one line of the structuring element to the whole buffer */
+  void ProcessLine(BufferImageType* buffer, const LineType& line, std::vector<InputPixelType>& extended, std::vector<InputPixelType>& prefix,
+                   std::vector<InputPixelType>& suffix) const;
+
+  KernelType     m_Kernel;
+  InputPixelType m_Boundary;
+  CompareType    m_Compare;
+};
+} // End namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbVanHerkGilWermanMorphologyImageFilter.hxx"
+#endif
+
+#endif
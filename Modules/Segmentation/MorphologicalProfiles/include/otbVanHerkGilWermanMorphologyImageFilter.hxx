@@ -0,0 +1,208 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbVanHerkGilWermanMorphologyImageFilter_hxx
+#define otbVanHerkGilWermanMorphologyImageFilter_hxx
+
+#include "otbVanHerkGilWermanMorphologyImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkNumericTraits.h"
+#include <algorithm>
+
+namespace otb
+{
+/**
+ * Constructor
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+VanHerkGilWermanMorphologyImageFilter<TInputImage, TOutputImage, TCompare>::VanHerkGilWermanMorphologyImageFilter()
+  : m_Boundary(itk::NumericTraits<InputPixelType>::Zero)
+{
+}
+
+/**
+ * Generate input requested region
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void VanHerkGilWermanMorphologyImageFilter<TInputImage, TOutputImage, TCompare>::GenerateInputRequestedRegion()
+{
+  // Call the superclass' implementation of this method
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* inputPtr = const_cast<InputImageType*>(this->GetInput());
+  if (!inputPtr)
+  {
+    return;
+  }
+
+  typename InputImageType::RegionType inputRequestedRegion = inputPtr->GetRequestedRegion();
+  inputRequestedRegion.PadByRadius(m_Kernel.GetBoundingRadius());
+
+  // Pixels outside the largest region are replaced by the boundary value
+  if (!inputRequestedRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    inputRequestedRegion.SetSize(typename InputImageType::SizeType());
+  }
+  inputPtr->SetRequestedRegion(inputRequestedRegion);
+}
+
+/**
+ * ThreadedGenerateData method
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void VanHerkGilWermanMorphologyImageFilter<TInputImage, TOutputImage, TCompare>::ThreadedGenerateData(const OutputImageRegionType& outputRegionForThread,
+                                                                                                      itk::ThreadIdType itkNotUsed(threadId))
+{
+  const InputImageType* inputPtr  = this->GetInput();
+  OutputImageType*      outputPtr = this->GetOutput();
+
+  // The buffer covers the output region with a margin of the radius of the
+  // structuring element: errors made at the buffer edges do not reach the
+  // output region
+  typename BufferImageType::RegionType bufferRegion = outputRegionForThread;
+  bufferRegion.PadByRadius(m_Kernel.GetBoundingRadius());
+  typename BufferImageType::Pointer buffer = BufferImageType::New();
+  buffer->SetRegions(bufferRegion);
+  buffer->Allocate();
+  buffer->FillBuffer(m_Boundary);
+
+  typename InputImageType::RegionType inputRegion = bufferRegion;
+  if (inputRegion.Crop(inputPtr->GetLargestPossibleRegion()))
+  {
+    itk::ImageRegionConstIterator<InputImageType> inIt(inputPtr, inputRegion);
+    itk::ImageRegionIterator<BufferImageType>     bufIt(buffer, inputRegion);
+    for (inIt.GoToBegin(), bufIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++bufIt)
+    {
+      bufIt.Set(inIt.Get());
+    }
+  }
+
+  std::vector<InputPixelType> extended, prefix, suffix;
+  for (const auto& line : m_Kernel.GetLines())
+  {
+    ProcessLine(buffer, line, extended, prefix, suffix);
+  }
+
+  itk::ImageRegionConstIterator<BufferImageType> bufIt(buffer, outputRegionForThread);
+  itk::ImageRegionIterator<OutputImageType>      outIt(outputPtr, outputRegionForThread);
+  for (bufIt.GoToBegin(), outIt.GoToBegin(); !outIt.IsAtEnd(); ++bufIt, ++outIt)
+  {
+    outIt.Set(static_cast<OutputPixelType>(bufIt.Get()));
+  }
+}
+
+template <class TInputImage, class TOutputImage, class TCompare>
+void VanHerkGilWermanMorphologyImageFilter<TInputImage, TOutputImage, TCompare>::ProcessLine(BufferImageType* buffer, const LineType& line,
+                                                                                             std::vector<InputPixelType>& extended,
+                                                                                             std::vector<InputPixelType>& prefix,
+                                                                                             std::vector<InputPixelType>& suffix) const
+{
+  const typename BufferImageType::RegionType& region = buffer->GetBufferedRegion();
+  const typename BufferImageType::IndexType&  first  = region.GetIndex();
+  const typename BufferImageType::SizeType&   size   = region.GetSize();
+
+  const typename KernelType::OffsetType& direction = line.Direction;
+  const itk::OffsetValueType             radius    = line.Radius;
+  const itk::OffsetValueType             window    = 2 * radius + 1;
+  const itk::OffsetValueType             step      = buffer->ComputeOffset(first + direction) - buffer->ComputeOffset(first);
+  InputPixelType*                        data      = buffer->GetBufferPointer();
+
+  auto extremum = [this](const InputPixelType& a, const InputPixelType& b) { return m_Compare(a, b) ? a : b; };
+
+  // Lines of the buffer start on pixels whose predecessor is outside
+  itk::ImageRegionConstIteratorWithIndex<BufferImageType> it(buffer, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    const typename BufferImageType::IndexType index = it.GetIndex();
+    if (region.IsInside(index - direction))
+    {
+      continue;
+    }
+
+    itk::OffsetValueType length = itk::NumericTraits<itk::OffsetValueType>::max();
+    for (unsigned int dim = 0; dim < ImageDimension; ++dim)
+    {
+      if (direction[dim] > 0)
+      {
+        length = std::min<itk::OffsetValueType>(length, first[dim] + size[dim] - index[dim]);
+      }
+      else if (direction[dim] < 0)
+      {
+        length = std::min<itk::OffsetValueType>(length, index[dim] - first[dim] + 1);
+      }
+    }
+
+    // Pad the line with radius boundary values before it, and after it up to
+    // a multiple of the window size
+    const itk::OffsetValueType nbBlocks = (length + 2 * radius + window - 1) / window;
+    const itk::OffsetValueType extendedLength = nbBlocks * window;
+    extended.assign(extendedLength, m_Boundary);
+    prefix.resize(extendedLength);
+    suffix.resize(extendedLength);
+
+    InputPixelType* lineData = data + buffer->ComputeOffset(index);
+    for (itk::OffsetValueType i = 0; i < length; ++i)
+    {
+      extended[radius + i] = lineData[i * step];
+    }
+
+    // Extrema from the start and from the end of each block
+    for (itk::OffsetValueType blockStart = 0; blockStart < extendedLength; blockStart += window)
+    {
+      prefix[blockStart] = extended[blockStart];
+      for (itk::OffsetValueType i = blockStart + 1; i < blockStart + window; ++i)
+      {
+        prefix[i] = extremum(prefix[i - 1], extended[i]);
+      }
+      suffix[blockStart + window - 1] = extended[blockStart + window - 1];
+      for (itk::OffsetValueType i = blockStart + window - 2; i >= blockStart; --i)
+      {
+        suffix[i] = extremum(suffix[i + 1], extended[i]);
+      }
+    }
+
+    // The window [i, i + 2 * radius] of the extended line spans at most two
+    // blocks: the end of the first one and the start of the second one
+    for (itk::OffsetValueType i = 0; i < length; ++i)
+    {
+      lineData[i * step] = extremum(suffix[i], prefix[i + 2 * radius]);
+    }
+  }
+}
+
+/**
+ * PrintSelf Method
+ */
+template <class TInputImage, class TOutputImage, class TCompare>
+void VanHerkGilWermanMorphologyImageFilter<TInputImage, TOutputImage, TCompare>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Boundary: " << static_cast<typename itk::NumericTraits<InputPixelType>::PrintType>(m_Boundary) << std::endl;
+  os << indent << "Kernel lines: " << m_Kernel.GetLines().size() << std::endl;
+  for (const auto& line : m_Kernel.GetLines())
+  {
+    os << indent.GetNextIndent() << "Direction: " << line.Direction << ", radius: " << line.Radius << std::endl;
+  }
+}
+
+} // End namespace otb
+#endif
@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbVanHerkGilWermanOpeningByReconstructionImageFilter_h
+#define otbVanHerkGilWermanOpeningByReconstructionImageFilter_h
+
+#include "otbVanHerkGilWermanByReconstructionImageFilter.h"
+#include "otbVanHerkGilWermanErodeImageFilter.h"
+#include "otbComponentTreeReconstructionImageFilter.h"
+
+namespace otb
+{
+/** \class VanHerkGilWermanOpeningByReconstructionImageFilter
+ *  \brief Opening by reconstruction with a line decomposed structuring element.
+ *
+ * The erosion of the input is computed with the VanHerkGilWermanErodeImageFilter, then
+ * reconstructed by dilation under the input with a ComponentTreeReconstructionImageFilter. It can
+ * replace itk::OpeningByReconstructionImageFilter in the MorphologicalOpeningProfileFilter, where
+ * each marker is then derived from the previous one when the structuring elements are nested, and
+ * the max-tree of the input is built once.
+ *
+ * \sa VanHerkGilWermanByReconstructionImageFilter
+ * \sa VanHerkGilWermanClosingByReconstructionImageFilter
+ *
+ * \ingroup OTBMorphologicalProfiles
+ */
+template <class TInputImage, class TOutputImage>
+class ITK_EXPORT VanHerkGilWermanOpeningByReconstructionImageFilter
+    : public VanHerkGilWermanByReconstructionImageFilter<TInputImage, TOutputImage, VanHerkGilWermanErodeImageFilter<TInputImage, TInputImage>,
+                                                         ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, std::greater<typename TInputImage::PixelType>>>
+{
+public:
+  /** Standard typedefs */
+  typedef VanHerkGilWermanOpeningByReconstructionImageFilter Self;
+  typedef VanHerkGilWermanByReconstructionImageFilter<TInputImage, TOutputImage, VanHerkGilWermanErodeImageFilter<TInputImage, TInputImage>,
+                                                      ComponentTreeReconstructionImageFilter<TInputImage, TOutputImage, std::greater<typename TInputImage::PixelType>>>
+                                        Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Type macro */
+  itkNewMacro(Self);
+
+  /** Creation through object factory macro */
+  itkTypeMacro(VanHerkGilWermanOpeningByReconstructionImageFilter, VanHerkGilWermanByReconstructionImageFilter);
+
+  typedef typename Superclass::KernelType KernelType;
+
+protected:
+  /** Constructor */
+  VanHerkGilWermanOpeningByReconstructionImageFilter() = default;
+
+  /** Destructor */
+  ~VanHerkGilWermanOpeningByReconstructionImageFilter() override = default;
+
+private:
+  VanHerkGilWermanOpeningByReconstructionImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+};
+} // End namespace otb
+
+#endif
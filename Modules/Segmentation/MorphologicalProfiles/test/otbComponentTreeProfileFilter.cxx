@@ -0,0 +1,116 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMorphologicalOpeningProfileFilter.h"
+#include "otbMorphologicalClosingProfileFilter.h"
+#include "otbComponentTreeOpeningByReconstructionImageFilter.h"
+#include "otbComponentTreeClosingByReconstructionImageFilter.h"
+#include "itkBinaryBallStructuringElement.h"
+#include "otbImageFileReader.h"
+#include "otbImage.h"
+#include "itkImageRegionConstIterator.h"
+
+typedef otb::Image<double, 2>                        ImageType;
+typedef itk::BinaryBallStructuringElement<double, 2> StructuringElementType;
+typedef otb::ImageList<ImageType>                    ImageListType;
+
+namespace
+{
+
+// Compare each element of a profile computed with the component tree with
+// the reference (ITK) profile
+bool CompareProfiles(const char* name, ImageListType* profile, ImageListType* reference)
+{
+  for (unsigned int i = 0; i < reference->Size(); ++i)
+  {
+    itk::ImageRegionConstIterator<ImageType> profileIt(profile->GetNthElement(i), reference->GetNthElement(i)->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> referenceIt(reference->GetNthElement(i), reference->GetNthElement(i)->GetLargestPossibleRegion());
+    for (profileIt.GoToBegin(), referenceIt.GoToBegin(); !referenceIt.IsAtEnd(); ++profileIt, ++referenceIt)
+    {
+      if (profileIt.Get() != referenceIt.Get())
+      {
+        std::cerr << name << " profile element " << i << " differs at " << referenceIt.GetIndex() << ": " << profileIt.Get() << " instead of "
+                  << referenceIt.Get() << std::endl;
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+template <class TProfileFilter>
+typename TProfileFilter::Pointer ComputeProfile(ImageType* image, unsigned int profileSize, unsigned int initialValue, unsigned int step)
+{
+  typename TProfileFilter::Pointer profileFilter = TProfileFilter::New();
+  profileFilter->SetInput(image);
+  profileFilter->SetProfileSize(profileSize);
+  profileFilter->SetInitialValue(initialValue);
+  profileFilter->SetStep(step);
+  profileFilter->Update();
+  return profileFilter;
+}
+
+} // end anonymous namespace
+
+int otbComponentTreeProfileFilter(int itkNotUsed(argc), char* argv[])
+{
+  const char*        inputFilename = argv[1];
+  const unsigned int profileSize   = atoi(argv[2]);
+  const unsigned int initialValue  = atoi(argv[3]);
+  const unsigned int step          = atoi(argv[4]);
+
+  typedef otb::ImageFileReader<ImageType> ReaderType;
+  typedef otb::MorphologicalOpeningProfileFilter<ImageType, ImageType, StructuringElementType> OpeningProfileFilterType;
+  typedef otb::MorphologicalClosingProfileFilter<ImageType, ImageType, StructuringElementType> ClosingProfileFilterType;
+  typedef otb::ComponentTreeOpeningByReconstructionImageFilter<ImageType, ImageType, StructuringElementType> TreeOpeningFilterType;
+  typedef otb::ComponentTreeClosingByReconstructionImageFilter<ImageType, ImageType, StructuringElementType> TreeClosingFilterType;
+  typedef otb::MorphologicalOpeningProfileFilter<ImageType, ImageType, StructuringElementType, TreeOpeningFilterType> TreeOpeningProfileFilterType;
+  typedef otb::MorphologicalClosingProfileFilter<ImageType, ImageType, StructuringElementType, TreeClosingFilterType> TreeClosingProfileFilterType;
+  typedef otb::ComponentTreeReconstructionImageFilter<ImageType, ImageType>                                           ReconstructionFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+  reader->Update();
+
+  // The profiles built with a single tree match the ITK reconstructions
+  auto opening     = ComputeProfile<OpeningProfileFilterType>(reader->GetOutput(), profileSize, initialValue, step);
+  auto treeOpening = ComputeProfile<TreeOpeningProfileFilterType>(reader->GetOutput(), profileSize, initialValue, step);
+  auto closing     = ComputeProfile<ClosingProfileFilterType>(reader->GetOutput(), profileSize, initialValue, step);
+  auto treeClosing = ComputeProfile<TreeClosingProfileFilterType>(reader->GetOutput(), profileSize, initialValue, step);
+  if (!CompareProfiles("Opening", treeOpening->GetOutput(), opening->GetOutput()) || !CompareProfiles("Closing", treeClosing->GetOutput(), closing->GetOutput()))
+  {
+    return EXIT_FAILURE;
+  }
+
+  // The tree of the mask is kept between updates
+  ReconstructionFilterType::Pointer reconstruction = ReconstructionFilterType::New();
+  reconstruction->SetMaskImage(reader->GetOutput());
+  reconstruction->SetMarkerImage(opening->GetOutput()->GetNthElement(0));
+  reconstruction->Update();
+  reconstruction->SetMarkerImage(opening->GetOutput()->GetNthElement(1));
+  reconstruction->Update();
+  if (!reconstruction->GetTreeReused())
+  {
+    std::cerr << "The tree of the mask was not reused" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -34,4 +34,7 @@ void RegisterTests()
   REGISTER_TEST(otbProfileDerivativeToMultiScaleCharacteristicsFilter);
   REGISTER_TEST(otbOpeningClosingMorphologicalFilter);
   REGISTER_TEST(otbMorphologicalClosingProfileFilter);
+  REGISTER_TEST(otbVanHerkGilWermanMorphologyImageFilter);
+  REGISTER_TEST(otbVanHerkGilWermanOpeningProfileFilter);
+  REGISTER_TEST(otbComponentTreeProfileFilter);
 }
@@ -0,0 +1,168 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbVanHerkGilWermanErodeImageFilter.h"
+#include "otbVanHerkGilWermanDilateImageFilter.h"
+#include "otbImage.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
+#include "itkImageRegionIterator.h"
+#include "itkMersenneTwisterRandomVariateGenerator.h"
+#include <algorithm>
+#include <set>
+
+namespace
+{
+const unsigned int Dimension = 2;
+typedef otb::Image<float, Dimension>                                 ImageType;
+typedef otb::VanHerkGilWermanErodeImageFilter<ImageType, ImageType>  ErodeFilterType;
+typedef otb::VanHerkGilWermanDilateImageFilter<ImageType, ImageType> DilateFilterType;
+typedef ErodeFilterType::KernelType                                  KernelType;
+
+/** Points of the structuring element, as the Minkowski sum of its lines */
+std::vector<ImageType::OffsetType> KernelOffsets(const KernelType& kernel)
+{
+  std::set<std::pair<long, long>> points{{0, 0}};
+  for (const auto& line : kernel.GetLines())
+  {
+    std::set<std::pair<long, long>> sum;
+    for (const auto& p : points)
+    {
+      for (long k = -static_cast<long>(line.Radius); k <= static_cast<long>(line.Radius); ++k)
+      {
+        sum.insert({p.first + k * line.Direction[0], p.second + k * line.Direction[1]});
+      }
+    }
+    points.swap(sum);
+  }
+  std::vector<ImageType::OffsetType> offsets;
+  for (const auto& p : points)
+  {
+    ImageType::OffsetType offset = {{p.first, p.second}};
+    offsets.push_back(offset);
+  }
+  return offsets;
+}
+
+/** Brute force erosion (erode true) or dilation, ignoring pixels outside the image */
+bool CheckFilter(const ImageType* input, const ImageType* output, const KernelType& kernel, bool erode)
+{
+  const std::vector<ImageType::OffsetType> offsets = KernelOffsets(kernel);
+  const ImageType::RegionType&             region  = input->GetLargestPossibleRegion();
+
+  itk::ImageRegionConstIteratorWithIndex<ImageType> it(output, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    float expected = input->GetPixel(it.GetIndex());
+    for (const auto& offset : offsets)
+    {
+      const ImageType::IndexType index = it.GetIndex() + offset;
+      if (region.IsInside(index))
+      {
+        expected = erode ? std::min(expected, input->GetPixel(index)) : std::max(expected, input->GetPixel(index));
+      }
+    }
+    if (it.Get() != expected)
+    {
+      std::cerr << (erode ? "Erosion" : "Dilation") << " with " << kernel.GetLines().size() << " lines: expected " << expected << " at " << it.GetIndex()
+                << ", got " << it.Get() << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+}
+
+int otbVanHerkGilWermanMorphologyImageFilter(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  // Random image
+  ImageType::Pointer    image = ImageType::New();
+  ImageType::RegionType region;
+  ImageType::SizeType   size = {{61, 47}};
+  region.SetSize(size);
+  image->SetRegions(region);
+  image->Allocate();
+
+  typedef itk::Statistics::MersenneTwisterRandomVariateGenerator RandomGeneratorType;
+  RandomGeneratorType::Pointer                                   randomGenerator = RandomGeneratorType::GetInstance();
+  randomGenerator->Initialize(42);
+  itk::ImageRegionIterator<ImageType> imageIt(image, region);
+  for (imageIt.GoToBegin(); !imageIt.IsAtEnd(); ++imageIt)
+  {
+    imageIt.Set(static_cast<float>(randomGenerator->GetIntegerVariate(255)));
+  }
+
+  KernelType::RadiusType boxRadius  = {{3, 1}};
+  KernelType::RadiusType diskRadius = {{7, 7}};
+  KernelType::RadiusType wideRadius = {{40, 2}};
+
+  KernelType lines;
+  lines.SetShape(KernelType::LINES);
+  KernelType::OffsetType direction = {{-1, 1}};
+  lines.AddLine(direction, 4);
+  direction[0] = 0;
+  lines.AddLine(direction, 2);
+  lines.AddLine(direction, 3);
+
+  std::vector<KernelType> kernels{KernelType::Box(boxRadius), KernelType::Disk(diskRadius), KernelType::Box(wideRadius), lines};
+
+  // Same lines given as a nested element and its increment
+  KernelType smallDisk = KernelType::Disk(boxRadius);
+  KernelType increment;
+  if (!smallDisk.GetIncrement(kernels[1], increment))
+  {
+    std::cerr << "Disk of radius 3x1 should be contained in the disk of radius 7" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  bool passed = true;
+  for (const auto& kernel : kernels)
+  {
+    ErodeFilterType::Pointer erode = ErodeFilterType::New();
+    erode->SetInput(image);
+    erode->SetKernel(kernel);
+    erode->SetNumberOfThreads(3);
+    erode->Update();
+    passed = CheckFilter(image, erode->GetOutput(), kernel, true) && passed;
+
+    DilateFilterType::Pointer dilate = DilateFilterType::New();
+    dilate->SetInput(image);
+    dilate->SetKernel(kernel);
+    dilate->SetNumberOfThreads(3);
+    dilate->Update();
+    passed = CheckFilter(image, dilate->GetOutput(), kernel, false) && passed;
+  }
+
+  // Eroding by the small disk then by the increment gives the large disk
+  ErodeFilterType::Pointer erodeSmall = ErodeFilterType::New();
+  erodeSmall->SetInput(image);
+  erodeSmall->SetKernel(smallDisk);
+  ErodeFilterType::Pointer erodeIncrement = ErodeFilterType::New();
+  erodeIncrement->SetInput(erodeSmall->GetOutput());
+  erodeIncrement->SetKernel(increment);
+  erodeIncrement->Update();
+  passed = CheckFilter(image, erodeIncrement->GetOutput(), kernels[1], true) && passed;
+
+  if (!passed)
+  {
+    std::cerr << "Test failed" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,97 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbMorphologicalOpeningProfileFilter.h"
+#include "otbVanHerkGilWermanOpeningByReconstructionImageFilter.h"
+#include "otbLineDecomposedStructuringElement.h"
+#include "otbImageFileReader.h"
+#include "otbImage.h"
+#include "itkImageRegionConstIterator.h"
+
+int otbVanHerkGilWermanOpeningProfileFilter(int itkNotUsed(argc), char* argv[])
+{
+  const char*        inputFilename = argv[1];
+  const unsigned int profileSize   = atoi(argv[2]);
+  const unsigned int initialValue  = atoi(argv[3]);
+  const unsigned int step          = atoi(argv[4]);
+
+  const unsigned int Dimension = 2;
+  typedef double     PixelType;
+
+  typedef otb::Image<PixelType, Dimension>                                              ImageType;
+  typedef otb::ImageFileReader<ImageType>                                               ReaderType;
+  typedef otb::LineDecomposedStructuringElement<Dimension>                              StructuringElementType;
+  typedef otb::VanHerkGilWermanOpeningByReconstructionImageFilter<ImageType, ImageType> OpeningFilterType;
+  typedef otb::MorphologicalOpeningProfileFilter<ImageType, ImageType, StructuringElementType, OpeningFilterType> OpeningProfileFilterType;
+
+  ReaderType::Pointer reader = ReaderType::New();
+  reader->SetFileName(inputFilename);
+  reader->Update();
+
+  // Each opening of the profile is derived from the previous one
+  OpeningProfileFilterType::Pointer profileFilter = OpeningProfileFilterType::New();
+  profileFilter->SetInput(reader->GetOutput());
+  profileFilter->SetProfileSize(profileSize);
+  profileFilter->SetInitialValue(initialValue);
+  profileFilter->SetStep(step);
+  profileFilter->Update();
+
+  // Compare with openings computed from the input
+  for (unsigned int i = 0; i < profileSize; ++i)
+  {
+    StructuringElementType se;
+    se.SetRadius(initialValue + i * step);
+    se.CreateStructuringElement();
+
+    OpeningFilterType::Pointer opening = OpeningFilterType::New();
+    opening->SetInput(reader->GetOutput());
+    opening->SetKernel(se);
+    opening->ReuseMarkerOff();
+    opening->Update();
+
+    itk::ImageRegionConstIterator<ImageType> profileIt(profileFilter->GetOutput()->GetNthElement(i), opening->GetOutput()->GetLargestPossibleRegion());
+    itk::ImageRegionConstIterator<ImageType> openingIt(opening->GetOutput(), opening->GetOutput()->GetLargestPossibleRegion());
+    for (profileIt.GoToBegin(), openingIt.GoToBegin(); !openingIt.IsAtEnd(); ++profileIt, ++openingIt)
+    {
+      if (profileIt.Get() != openingIt.Get())
+      {
+        std::cerr << "Profile element " << i << " differs from the opening of radius " << initialValue + i * step << " at " << openingIt.GetIndex() << ": "
+                  << profileIt.Get() << " instead of " << openingIt.Get() << std::endl;
+        return EXIT_FAILURE;
+      }
+    }
+  }
+
+  // A filter kept between updates reuses its marker for nested elements:
+  // disks whose radii differ by an even number are nested
+  OpeningFilterType::Pointer opening = OpeningFilterType::New();
+  opening->SetInput(reader->GetOutput());
+  opening->SetKernel(StructuringElementType::Disk(StructuringElementType::RadiusType{{initialValue, initialValue}}));
+  opening->Update();
+  opening->SetKernel(StructuringElementType::Disk(StructuringElementType::RadiusType{{initialValue + 2 * step, initialValue + 2 * step}}));
+  opening->Update();
+  if (!opening->GetMarkerReused())
+  {
+    std::cerr << "The marker of radius " << initialValue << " was not reused for radius " << initialValue + 2 * step << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
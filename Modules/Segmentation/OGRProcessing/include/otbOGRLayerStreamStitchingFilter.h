@@ -22,11 +22,16 @@
 #define otbOGRLayerStreamStitchingFilter_h
 
 #include "otbOGRDataSourceWrapper.h"
+#include "otbOGRGeometryWrapper.h"
+#include "otbEnvelopeSTRTree.h"
 #include "otbMacro.h"
 
 #include "itkProgressReporter.h"
+#include "itkMultiThreader.h"
 
 #include <algorithm>
+#include <map>
+#include <set>
 
 namespace otb
 {
@@ -43,6 +48,12 @@ namespace otb
  *  The input image is used to transform pixel coordinates of the streaming lines into
  *  coordinate system of the image, which must be the same as the one in the OGR input file.
  *  This filter is intended to be used after \c StreamingVectorizedSegmentationOGR.
+ *
+ *  The layer is read once per direction: the features touching a streaming
+ *  line are kept in memory and found through an STR-tree of the streaming
+ *  line neighbourhoods. Streaming lines which do not share any feature are
+ *  stitched concurrently, the others in the same order as a sequential
+ *  processing, so that the result does not depend on the number of threads.
  *  @see Example/StreamingMeanShiftSegmentation.cxx
  *
  *  \ingroup OBIA
@@ -114,13 +125,50 @@ protected:
     unsigned int indStream2;
     double       overlap;
   };
-  struct FeatureStruct
+  /** Position of a feature in the sequential processing order: features read
+   * from the layer come first (seam 0, in layer order), then the fusion
+   * results of each seam (seam index + 1, in fusion order). */
+  typedef std::pair<unsigned int, unsigned int> FeatureKeyType;
+
+  struct StitchedFeatureStruct
   {
-    FeatureStruct(OGRFeatureDefn& defn) : feat(defn), fusioned(false)
+    explicit StitchedFeatureStruct(const OGRFeatureType& f) : feat(f), validity(-1)
     {
     }
-    OGRFeatureType feat;
-    bool           fusioned;
+    OGRFeatureType            feat;
+    int                       validity; // -1 when not computed yet
+    std::vector<unsigned int> bands;    // seam index * 2 + side
+  };
+  /** Streaming line segment between two streams, and its neighbourhoods on
+   * the upper/left (0) and lower/right (1) sides */
+  struct SeamStruct
+  {
+    ogr::UniqueGeometryPtr   streamLine;
+    OGREnvelope              bandEnvelopes[2];
+    ogr::UniqueGeometryPtr   bandPolygons[2];
+    std::set<FeatureKeyType> features[2];
+  };
+  struct FusionResultStruct
+  {
+    unsigned int           indStream1;
+    unsigned int           indStream2;
+    ogr::UniqueGeometryPtr geometry;
+  };
+  struct SeamTaskStruct
+  {
+    unsigned int                        seam;
+    std::vector<FeatureKeyType>         upperKeys;
+    std::vector<FeatureKeyType>         lowerKeys;
+    std::vector<StitchedFeatureStruct*> upper;
+    std::vector<StitchedFeatureStruct*> lower;
+    std::vector<FusionResultStruct>     fusions;
+  };
+  struct StitchingThreadStruct
+  {
+    Self*                        Filter;
+    std::vector<SeamTaskStruct>* Tasks;
+    std::vector<SeamStruct>*     Seams;
+    std::vector<std::string>*    Errors;
   };
   struct SortFeatureStruct
   {
@@ -134,6 +182,13 @@ protected:
    Main computation method. if line is true process row part, else process column part.
    */
   void ProcessStreamingLine(bool line, itk::ProgressReporter& progress);
+  /** Computes the fusions of a seam, from its features only (thread safe
+   * for seams not sharing any feature) */
+  void ProcessSeam(SeamTaskStruct& task, const SeamStruct& seam) const;
+  /** Adds a feature to the in-memory features if it touches a seam */
+  void InsertFeature(const FeatureKeyType& key, const OGRFeatureType& feature, std::map<FeatureKeyType, StitchedFeatureStruct>& features,
+                     std::vector<SeamStruct>& seams, const EnvelopeSTRTree& bandTree) const;
+  static ITK_THREAD_RETURN_TYPE StitchingThreaderCallback(void* arg);
   /** get length in case of  OGRGeometryCollection.
    * This function recodes the get_lenght method available since gdal 1.8.0
    * in the case of OGRGeometryCollection. The aim is to allow accessing polygon stiching
@@ -27,6 +27,7 @@
 #include <iomanip>
 #include "ogrsf_frmts.h"
 #include <set>
+#include <initializer_list>
 
 namespace otb
 {
@@ -90,43 +91,177 @@ double OGRLayerStreamStitchingFilter<TInputImage>::GetLengthOGRGeometryCollectio
   return dfLength;
 }
 template <class TInputImage>
-void OGRLayerStreamStitchingFilter<TInputImage>::ProcessStreamingLine(bool line, itk::ProgressReporter& progress)
+void OGRLayerStreamStitchingFilter<TInputImage>::InsertFeature(const FeatureKeyType& key, const OGRFeatureType& feature,
+                                                                std::map<FeatureKeyType, StitchedFeatureStruct>& features, std::vector<SeamStruct>& seams,
+                                                                const EnvelopeSTRTree& bandTree) const
 {
-  typename InputImageType::ConstPointer inputImage = this->GetInput();
+  OGRGeometry const* geometry = feature.GetGeometry();
+  if (!geometry || geometry->IsEmpty())
+  {
+    return;
+  }
 
-  // compute the number of stream division in row and column
-  SizeType     imageSize   = this->GetInput()->GetLargestPossibleRegion().GetSize();
-  unsigned int nbRowStream = static_cast<unsigned int>(imageSize[1] / m_StreamSize[1] + 1);
-  unsigned int nbColStream = static_cast<unsigned int>(imageSize[0] / m_StreamSize[0] + 1);
+  OGREnvelope envelope;
+  geometry->getEnvelope(&envelope);
 
-  /*unsigned long startReporter;
-  unsigned long stopReporter;
-  if (!line)
+  StitchedFeatureStruct s(feature);
+  for (EnvelopeSTRTree::ItemType band : bandTree.Query(envelope))
   {
-    startReporter = 0;
-    stopReporter = 50;
+    SeamStruct&        seam         = seams[band / 2];
+    const OGREnvelope& bandEnvelope = seam.bandEnvelopes[band % 2];
+    // Same test as an OGR spatial filter on the band rectangle
+    const bool contained = envelope.MinX >= bandEnvelope.MinX && envelope.MaxX <= bandEnvelope.MaxX && envelope.MinY >= bandEnvelope.MinY &&
+                           envelope.MaxY <= bandEnvelope.MaxY;
+    if (contained || ogr::Intersects(*geometry, *seam.bandPolygons[band % 2]))
+    {
+      seam.features[band % 2].insert(key);
+      s.bands.push_back(band);
+    }
   }
-  else
+
+  if (!s.bands.empty())
   {
-    startReporter = 50;
-    stopReporter = 100;
+    features.insert(std::make_pair(key, s));
   }
-  itk::ProgressReporter progress(this,0,2*nbRowStream*nbColStream,100,startReporter); */
+}
 
-  for (unsigned int x = 1; x <= nbColStream; x++)
+template <class TInputImage>
+void OGRLayerStreamStitchingFilter<TInputImage>::ProcessSeam(SeamTaskStruct& task, const SeamStruct& seam) const
+{
+  std::vector<StitchedFeatureStruct*>& upperStreamFeatureList = task.upper;
+  std::vector<StitchedFeatureStruct*>& lowerStreamFeatureList = task.lower;
+
+  for (StitchedFeatureStruct* f : upperStreamFeatureList)
+  {
+    if (f->validity < 0)
+      f->validity = f->feat.GetGeometry()->IsValid() ? 1 : 0;
+  }
+  for (StitchedFeatureStruct* f : lowerStreamFeatureList)
+  {
+    if (f->validity < 0)
+      f->validity = f->feat.GetGeometry()->IsValid() ? 1 : 0;
+  }
+
+  unsigned int              nbUpperPolygons = upperStreamFeatureList.size();
+  unsigned int              nbLowerPolygons = lowerStreamFeatureList.size();
+  std::vector<FusionStruct> fusionList;
+  for (unsigned int u = 0; u < nbUpperPolygons; u++)
+  {
+    for (unsigned int l = 0; l < nbLowerPolygons; l++)
+    {
+      const StitchedFeatureStruct& upper = *upperStreamFeatureList[u];
+      const StitchedFeatureStruct& lower = *lowerStreamFeatureList[l];
+      if (upper.validity && lower.validity)
+      {
+        if (ogr::Intersects(*upper.feat.GetGeometry(), *lower.feat.GetGeometry()))
+        {
+          ogr::UniqueGeometryPtr intersection2 = ogr::Intersection(*upper.feat.GetGeometry(), *lower.feat.GetGeometry());
+          ogr::UniqueGeometryPtr intersection  = ogr::Intersection(*intersection2, *seam.streamLine);
+          if (intersection)
+          {
+            FusionStruct fusion;
+            fusion.indStream1 = u;
+            fusion.indStream2 = l;
+            fusion.overlap    = 0.;
+
+            if (intersection->getGeometryType() == wkbPolygon)
+            {
+              fusion.overlap = dynamic_cast<OGRPolygon*>(intersection.get())->get_Area();
+            }
+            else if (intersection->getGeometryType() == wkbMultiPolygon)
+            {
+              fusion.overlap = dynamic_cast<OGRMultiPolygon*>(intersection.get())->get_Area();
+            }
+            else if (intersection->getGeometryType() == wkbGeometryCollection)
+            {
+              fusion.overlap = dynamic_cast<OGRGeometryCollection*>(intersection.get())->get_Area();
+            }
+            else if (intersection->getGeometryType() == wkbLineString)
+            {
+              fusion.overlap = dynamic_cast<OGRLineString*>(intersection.get())->get_Length();
+            }
+            else if (intersection->getGeometryType() == wkbMultiLineString)
+            {
+              fusion.overlap = dynamic_cast<OGRMultiLineString*>(intersection.get())->get_Length();
+            }
+
+            fusionList.push_back(fusion);
+          }
+        }
+      }
+    }
+  }
+
+  std::sort(fusionList.begin(), fusionList.end(), SortFeature);
+
+  std::vector<bool> upperFusioned(nbUpperPolygons, false);
+  std::vector<bool> lowerFusioned(nbLowerPolygons, false);
+  for (const FusionStruct& fusion : fusionList)
   {
-    OGRErr errStart = m_OGRLayer.ogr().StartTransaction();
+    if (!upperFusioned[fusion.indStream1] && !lowerFusioned[fusion.indStream2])
+    {
+      upperFusioned[fusion.indStream1] = true;
+      lowerFusioned[fusion.indStream2] = true;
+
+      FusionResultStruct result;
+      result.indStream1 = fusion.indStream1;
+      result.indStream2 = fusion.indStream2;
+      result.geometry =
+          ogr::Union(*upperStreamFeatureList[fusion.indStream1]->feat.GetGeometry(), *lowerStreamFeatureList[fusion.indStream2]->feat.GetGeometry());
+      task.fusions.push_back(std::move(result));
+    }
+  }
+}
 
-    if (errStart != OGRERR_NONE)
+template <class TInputImage>
+ITK_THREAD_RETURN_TYPE OGRLayerStreamStitchingFilter<TInputImage>::StitchingThreaderCallback(void* arg)
+{
+  itk::MultiThreader::ThreadInfoStruct* info = static_cast<itk::MultiThreader::ThreadInfoStruct*>(arg);
+  StitchingThreadStruct*                str  = static_cast<StitchingThreadStruct*>(info->UserData);
+
+  const std::size_t threadId    = info->ThreadID;
+  const std::size_t threadCount = info->NumberOfThreads;
+
+  try
+  {
+    // Seams are interleaved between threads, as their costs vary a lot
+    for (std::size_t i = threadId; i < str->Tasks->size(); i += threadCount)
     {
-      itkExceptionMacro(<< "Unable to start transaction for OGR layer " << m_OGRLayer.ogr().GetName() << ".");
+      SeamTaskStruct& task = (*str->Tasks)[i];
+      str->Filter->ProcessSeam(task, (*str->Seams)[task.seam]);
     }
+  }
+  catch (std::exception const& e)
+  {
+    (*str->Errors)[threadId] = e.what();
+  }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
 
+template <class TInputImage>
+void OGRLayerStreamStitchingFilter<TInputImage>::ProcessStreamingLine(bool line, itk::ProgressReporter& progress)
+{
+  typename InputImageType::ConstPointer inputImage = this->GetInput();
+
+  // compute the number of stream division in row and column
+  SizeType     imageSize   = this->GetInput()->GetLargestPossibleRegion().GetSize();
+  unsigned int nbRowStream = static_cast<unsigned int>(imageSize[1] / m_StreamSize[1] + 1);
+  unsigned int nbColStream = static_cast<unsigned int>(imageSize[0] / m_StreamSize[0] + 1);
+
+  // Seams, in the order of the sequential processing
+  std::vector<SeamStruct> seams;
+  seams.reserve(nbColStream * nbRowStream);
+  EnvelopeSTRTree bandTree;
+
+  for (unsigned int x = 1; x <= nbColStream; x++)
+  {
     for (unsigned int y = 1; y <= nbRowStream; y++)
     {
+      SeamStruct seam;
 
       // Compute Stream line
-      OGRLineString streamLine;
+      OGRLineString*                  streamLine = static_cast<OGRLineString*>(OGRGeometryFactory::createGeometry(wkbLineString));
       itk::ContinuousIndex<double, 2> startIndex;
       itk::ContinuousIndex<double, 2> endIndex;
       if (!line)
@@ -148,204 +283,270 @@ void OGRLayerStreamStitchingFilter<TInputImage>::ProcessStreamingLine(bool line,
       inputImage->TransformContinuousIndexToPhysicalPoint(startIndex, startPoint);
       OriginType endPoint;
       inputImage->TransformContinuousIndexToPhysicalPoint(endIndex, endPoint);
-      streamLine.addPoint(startPoint[0], startPoint[1]);
-      streamLine.addPoint(endPoint[0], endPoint[1]);
+      streamLine->addPoint(startPoint[0], startPoint[1]);
+      streamLine->addPoint(endPoint[0], endPoint[1]);
+      seam.streamLine.reset(streamLine);
 
+      for (unsigned int side = 0; side < 2; ++side)
+      {
+        IndexType UpperLeftCorner;
+        IndexType LowerRightCorner;
 
-      // First we get all the feature that intersect the streaming line of the Upper/left stream
-      std::vector<FeatureStruct> upperStreamFeatureList;
-      upperStreamFeatureList.clear();
-      IndexType UpperLeftCorner;
-      IndexType LowerRightCorner;
+        if (!line && side == 0)
+        {
+          // Upper stream of a row
+          UpperLeftCorner[0] = x * m_StreamSize[0] - 1 - m_Radius;
+          UpperLeftCorner[1] = m_StreamSize[1] * (y - 1);
 
-      if (!line)
-      {
-        // Treat Row stream
-        // Compute the spatial filter of the upper stream
-        UpperLeftCorner[0] = x * m_StreamSize[0] - 1 - m_Radius;
-        UpperLeftCorner[1] = m_StreamSize[1] * (y - 1);
+          LowerRightCorner[0] = m_StreamSize[0] * x - 1;
+          LowerRightCorner[1] = m_StreamSize[1] * y - 1;
+        }
+        else if (!line)
+        {
+          // Lower stream of a row
+          UpperLeftCorner[0] = x * m_StreamSize[0];
+          UpperLeftCorner[1] = m_StreamSize[1] * (y - 1);
 
-        LowerRightCorner[0] = m_StreamSize[0] * x - 1;
-        LowerRightCorner[1] = m_StreamSize[1] * y - 1;
-      }
-      else
-      { // Treat Column stream
-        // Compute the spatial filter of the left stream
-        UpperLeftCorner[0] = (x - 1) * m_StreamSize[0];
-        UpperLeftCorner[1] = m_StreamSize[1] * y - 1 - m_Radius;
+          LowerRightCorner[0] = m_StreamSize[0] * x + m_Radius;
+          LowerRightCorner[1] = m_StreamSize[1] * y - 1;
+        }
+        else if (side == 0)
+        {
+          // Left stream of a column
+          UpperLeftCorner[0] = (x - 1) * m_StreamSize[0];
+          UpperLeftCorner[1] = m_StreamSize[1] * y - 1 - m_Radius;
+
+          LowerRightCorner[0] = m_StreamSize[0] * x - 1;
+          LowerRightCorner[1] = m_StreamSize[1] * y - 1; //-1 to stop just before stream line
+        }
+        else
+        {
+          // Right stream of a column
+          UpperLeftCorner[0] = (x - 1) * m_StreamSize[0];
+          UpperLeftCorner[1] = m_StreamSize[1] * y;
 
-        LowerRightCorner[0] = m_StreamSize[0] * x - 1;
-        LowerRightCorner[1] = m_StreamSize[1] * y - 1; //-1 to stop just before stream line
+          LowerRightCorner[0] = m_StreamSize[0] * x - 1;
+          LowerRightCorner[1] = m_StreamSize[1] * y + m_Radius;
+        }
+
+        OriginType ulCorner;
+        inputImage->TransformIndexToPhysicalPoint(UpperLeftCorner, ulCorner);
+        OriginType lrCorner;
+        inputImage->TransformIndexToPhysicalPoint(LowerRightCorner, lrCorner);
+
+        OGREnvelope& envelope = seam.bandEnvelopes[side];
+        envelope.MinX         = std::min(ulCorner[0], lrCorner[0]);
+        envelope.MaxX         = std::max(ulCorner[0], lrCorner[0]);
+        envelope.MinY         = std::min(ulCorner[1], lrCorner[1]);
+        envelope.MaxY         = std::max(ulCorner[1], lrCorner[1]);
+
+        OGRLinearRing* ring = static_cast<OGRLinearRing*>(OGRGeometryFactory::createGeometry(wkbLinearRing));
+        ring->addPoint(envelope.MinX, envelope.MinY);
+        ring->addPoint(envelope.MinX, envelope.MaxY);
+        ring->addPoint(envelope.MaxX, envelope.MaxY);
+        ring->addPoint(envelope.MaxX, envelope.MinY);
+        ring->addPoint(envelope.MinX, envelope.MinY);
+        OGRPolygon* polygon = static_cast<OGRPolygon*>(OGRGeometryFactory::createGeometry(wkbPolygon));
+        polygon->addRingDirectly(ring);
+        seam.bandPolygons[side].reset(polygon);
+
+        bandTree.Insert(envelope, 2 * seams.size() + side);
       }
 
-      OriginType ulCorner;
-      inputImage->TransformIndexToPhysicalPoint(UpperLeftCorner, ulCorner);
-      OriginType lrCorner;
-      inputImage->TransformIndexToPhysicalPoint(LowerRightCorner, lrCorner);
+      seams.push_back(std::move(seam));
+    }
+  }
+  bandTree.Build();
 
-      m_OGRLayer.SetSpatialFilterRect(ulCorner[0], lrCorner[1], lrCorner[0], ulCorner[1]);
+  OGRErr errStart = m_OGRLayer.ogr().StartTransaction();
 
-      std::set<unsigned int>       upperFIDs;
-      OGRLayerType::const_iterator featIt = m_OGRLayer.begin();
-      for (; featIt != m_OGRLayer.end(); ++featIt)
-      {
-        FeatureStruct s(m_OGRLayer.GetLayerDefn());
-        s.feat     = *featIt;
-        s.fusioned = false;
-        upperStreamFeatureList.push_back(s);
-        upperFIDs.insert((*featIt).GetFID());
-      }
+  if (errStart != OGRERR_NONE)
+  {
+    itkExceptionMacro(<< "Unable to start transaction for OGR layer " << m_OGRLayer.ogr().GetName() << ".");
+  }
 
-      // Do the same thing for the lower/right stream
-      std::vector<FeatureStruct> lowerStreamFeatureList;
-      lowerStreamFeatureList.clear();
+  // Read the features touching a seam, once
+  std::map<FeatureKeyType, StitchedFeatureStruct> features;
+  m_OGRLayer.SetSpatialFilter(nullptr);
+  unsigned int position = 0;
+  for (OGRLayerType::const_iterator featIt = m_OGRLayer.begin(); featIt != m_OGRLayer.end(); ++featIt, ++position)
+  {
+    this->InsertFeature(FeatureKeyType(0, position), *featIt, features, seams, bandTree);
+  }
 
-      if (!line)
-      {
-        // Compute the spatial filter of the lower stream
-        UpperLeftCorner[0] = x * m_StreamSize[0];
-        UpperLeftCorner[1] = m_StreamSize[1] * (y - 1);
+  // FIDs of the fusion results still in the layer
+  std::map<FeatureKeyType, long> fusionFIDs;
 
-        LowerRightCorner[0] = m_StreamSize[0] * x + m_Radius;
-        LowerRightCorner[1] = m_StreamSize[1] * y - 1;
-      }
-      else
-      {
-        // Compute the spatial filter of the right stream
-        UpperLeftCorner[0] = (x - 1) * m_StreamSize[0];
-        UpperLeftCorner[1] = m_StreamSize[1] * y;
+  const itk::ThreadIdType nbThreads = std::max<itk::ThreadIdType>(1, this->GetNumberOfThreads());
 
-        LowerRightCorner[0] = m_StreamSize[0] * x - 1;
-        LowerRightCorner[1] = m_StreamSize[1] * y + m_Radius;
-      }
+  std::vector<SeamTaskStruct> tasks;
+  std::vector<std::string>    errors(nbThreads);
 
-      inputImage->TransformIndexToPhysicalPoint(UpperLeftCorner, ulCorner);
-      inputImage->TransformIndexToPhysicalPoint(LowerRightCorner, lrCorner);
+  StitchingThreadStruct str;
+  str.Filter = this;
+  str.Tasks  = &tasks;
+  str.Seams  = &seams;
+  str.Errors = &errors;
 
-      m_OGRLayer.SetSpatialFilterRect(ulCorner[0], lrCorner[1], lrCorner[0], ulCorner[1]);
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads(nbThreads);
+  threader->SetSingleMethod(StitchingThreaderCallback, &str);
+
+  std::vector<unsigned int> pending(seams.size());
+  for (unsigned int i = 0; i < pending.size(); ++i)
+  {
+    pending[i] = i;
+  }
 
-      for (featIt = m_OGRLayer.begin(); featIt != m_OGRLayer.end(); ++featIt)
+  while (!pending.empty())
+  {
+    // A seam sharing a feature with a previous pending seam must wait for it,
+    // the selected seams do not share anything and commute.
+    std::vector<unsigned int> remaining;
+    std::set<FeatureKeyType>  claimed;
+    tasks.clear();
+    for (unsigned int index : pending)
+    {
+      const SeamStruct& seam     = seams[index];
+      bool              conflict = false;
+      for (unsigned int side = 0; side < 2 && !conflict; ++side)
       {
-        if (upperFIDs.find((*featIt).GetFID()) == upperFIDs.end())
+        for (const FeatureKeyType& key : seam.features[side])
         {
-          FeatureStruct s(m_OGRLayer.GetLayerDefn());
-          s.feat     = *featIt;
-          s.fusioned = false;
-          lowerStreamFeatureList.push_back(s);
+          if (claimed.find(key) != claimed.end())
+          {
+            conflict = true;
+            break;
+          }
         }
       }
+      claimed.insert(seam.features[0].begin(), seam.features[0].end());
+      claimed.insert(seam.features[1].begin(), seam.features[1].end());
 
-      unsigned int              nbUpperPolygons = upperStreamFeatureList.size();
-      unsigned int              nbLowerPolygons = lowerStreamFeatureList.size();
-      std::vector<FusionStruct> fusionList;
-      fusionList.clear();
-      for (unsigned int u = 0; u < nbUpperPolygons; u++)
+      if (conflict)
       {
-        for (unsigned int l = 0; l < nbLowerPolygons; l++)
+        remaining.push_back(index);
+        continue;
+      }
+
+      SeamTaskStruct task;
+      task.seam = index;
+      for (const FeatureKeyType& key : seam.features[0])
+      {
+        task.upperKeys.push_back(key);
+        task.upper.push_back(&features.find(key)->second);
+      }
+      for (const FeatureKeyType& key : seam.features[1])
+      {
+        if (seam.features[0].find(key) == seam.features[0].end())
         {
-          FeatureStruct upper = upperStreamFeatureList[u];
-          FeatureStruct lower = lowerStreamFeatureList[l];
-          if (!(upper.feat == lower.feat) && upper.feat.GetGeometry()->IsValid() && lower.feat.GetGeometry()->IsValid())
-          {
-            if (ogr::Intersects(*upper.feat.GetGeometry(), *lower.feat.GetGeometry()))
-            {
-              ogr::UniqueGeometryPtr intersection2 = ogr::Intersection(*upper.feat.GetGeometry(), *lower.feat.GetGeometry());
-              ogr::UniqueGeometryPtr intersection  = ogr::Intersection(*intersection2, streamLine);
-              // ogr::UniqueGeometryPtr intersection = ogr::Intersection(*upper.feat.GetGeometry(),*lower.feat.GetGeometry());
-              if (intersection)
-              {
-                FusionStruct fusion;
-                fusion.indStream1 = u;
-                fusion.indStream2 = l;
-                fusion.overlap    = 0.;
-
-                if (intersection->getGeometryType() == wkbPolygon)
-                {
-                  fusion.overlap = dynamic_cast<OGRPolygon*>(intersection.get())->get_Area();
-                }
-                else if (intersection->getGeometryType() == wkbMultiPolygon)
-                {
-                  fusion.overlap = dynamic_cast<OGRMultiPolygon*>(intersection.get())->get_Area();
-                }
-                else if (intersection->getGeometryType() == wkbGeometryCollection)
-                {
-                  fusion.overlap = dynamic_cast<OGRGeometryCollection*>(intersection.get())->get_Area();
-                }
-                else if (intersection->getGeometryType() == wkbLineString)
-                {
-                  fusion.overlap = dynamic_cast<OGRLineString*>(intersection.get())->get_Length();
-                }
-                else if (intersection->getGeometryType() == wkbMultiLineString)
-                {
-                  fusion.overlap = dynamic_cast<OGRMultiLineString*>(intersection.get())->get_Length();
-                }
-
-                /** -Wunused-variable
-                long upperFID = upper.feat.GetFID();
-                long lowerFID = lower.feat.GetFID();
-                **/
-                fusionList.push_back(fusion);
-              }
-            }
-          }
+          task.lowerKeys.push_back(key);
+          task.lower.push_back(&features.find(key)->second);
         }
       }
-      unsigned int fusionListSize = fusionList.size();
-      std::sort(fusionList.begin(), fusionList.end(), SortFeature);
-      for (unsigned int i = 0; i < fusionListSize; i++)
+      tasks.push_back(std::move(task));
+    }
+
+    threader->SingleMethodExecute();
+
+    for (itk::ThreadIdType t = 0; t < nbThreads; ++t)
+    {
+      if (!errors[t].empty())
+      {
+        itkExceptionMacro(<< "Cannot stitch the features of layer " << m_OGRLayer.ogr().GetName() << ": " << errors[t]);
+      }
+    }
+
+    // Apply the fusions sequentially, in the seams order
+    for (SeamTaskStruct& task : tasks)
+    {
+      for (unsigned int i = 0; i < task.fusions.size(); i++)
       {
-        FeatureStruct upper = upperStreamFeatureList.at(fusionList.at(i).indStream1);
-        FeatureStruct lower = lowerStreamFeatureList.at(fusionList.at(i).indStream2);
-        if (!upper.fusioned && !lower.fusioned)
+        FusionResultStruct&    fusion = task.fusions[i];
+        const FeatureKeyType   upperKey = task.upperKeys[fusion.indStream1];
+        const FeatureKeyType   lowerKey = task.lowerKeys[fusion.indStream2];
+        StitchedFeatureStruct& upper    = *task.upper[fusion.indStream1];
+        StitchedFeatureStruct& lower    = *task.lower[fusion.indStream2];
+
+        OGRFeatureType fusionFeature(m_OGRLayer.GetLayerDefn());
+        fusionFeature.SetGeometryDirectly(std::move(fusion.geometry));
+
+        ogr::Field field = upper.feat[0];
+        try
         {
-          upperStreamFeatureList[fusionList[i].indStream1].fusioned = true;
-          lowerStreamFeatureList[fusionList[i].indStream2].fusioned = true;
-          ogr::UniqueGeometryPtr fusionPolygon                      = ogr::Union(*upper.feat.GetGeometry(), *lower.feat.GetGeometry());
-          OGRFeatureType         fusionFeature(m_OGRLayer.GetLayerDefn());
-          fusionFeature.SetGeometry(fusionPolygon.get());
-
-          ogr::Field field = upper.feat[0];
-          try
+          switch (field.GetType())
           {
-            switch (field.GetType())
-            {
-            case OFTInteger64:
-            {
-              fusionFeature[0].SetValue(field.GetValue<GIntBig>());
-              break;
-            }
-            default:
-            {
-              fusionFeature[0].SetValue(field.GetValue<int>());
-            }
-            }
-            m_OGRLayer.CreateFeature(fusionFeature);
-            m_OGRLayer.DeleteFeature(lower.feat.GetFID());
-            m_OGRLayer.DeleteFeature(upper.feat.GetFID());
+          case OFTInteger64:
+          {
+            fusionFeature[0].SetValue(field.GetValue<GIntBig>());
+            break;
+          }
+          default:
+          {
+            fusionFeature[0].SetValue(field.GetValue<int>());
+          }
           }
-          catch (itk::ExceptionObject& err)
+          m_OGRLayer.CreateFeature(fusionFeature);
+          m_OGRLayer.DeleteFeature(lower.feat.GetFID());
+          m_OGRLayer.DeleteFeature(upper.feat.GetFID());
+        }
+        catch (itk::ExceptionObject& err)
+        {
+          otbWarningMacro(<< "An exception was caught during fusion: " << err);
+          continue;
+        }
+
+        for (const FeatureKeyType& key : {upperKey, lowerKey})
+        {
+          for (unsigned int band : features.find(key)->second.bands)
           {
-            otbWarningMacro(<< "An exception was caught during fusion: " << err);
+            seams[band / 2].features[band % 2].erase(key);
           }
+          features.erase(key);
+          fusionFIDs.erase(key);
         }
+
+        // Following seams see the geometry as stored by the driver
+        const FeatureKeyType fusionKey(task.seam + 1, i);
+        fusionFIDs[fusionKey] = fusionFeature.GetFID();
+        this->InsertFeature(fusionKey, m_OGRLayer.GetFeature(fusionFeature.GetFID()), features, seams, bandTree);
       }
 
       // Update progress
       progress.CompletedPixel();
+    }
 
-    } // end for x
+    pending.swap(remaining);
+  }
 
-    if (m_OGRLayer.ogr().TestCapability("Transactions"))
+  // Fusion results are appended in the sequential order, so that the layer
+  // features keep the same order whatever the schedule
+  bool inOrder = true;
+  long lastFID = -1;
+  for (const auto& fusion : fusionFIDs)
+  {
+    inOrder = inOrder && fusion.second > lastFID;
+    lastFID = fusion.second;
+    if (!inOrder)
     {
+      OGRFeatureType stored = m_OGRLayer.GetFeature(fusion.second);
+      OGRFeatureType copy(m_OGRLayer.GetLayerDefn());
+      copy.SetFrom(stored);
+      m_OGRLayer.CreateFeature(copy);
+      m_OGRLayer.DeleteFeature(fusion.second);
+    }
+  }
 
-      OGRErr errCommitX = m_OGRLayer.ogr().CommitTransaction();
-      if (errCommitX != OGRERR_NONE)
-      {
-        itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << m_OGRLayer.ogr().GetName() << ".");
-      }
+  if (m_OGRLayer.ogr().TestCapability("Transactions"))
+  {
+    OGRErr errCommit = m_OGRLayer.ogr().CommitTransaction();
+    if (errCommit != OGRERR_NONE)
+    {
+      itkExceptionMacro(<< "Unable to commit transaction for OGR layer " << m_OGRLayer.ogr().GetName() << ".");
     }
-  } // end for y
+  }
 }
+
 template <class TImage>
 void OGRLayerStreamStitchingFilter<TImage>::GenerateData(void)
 {
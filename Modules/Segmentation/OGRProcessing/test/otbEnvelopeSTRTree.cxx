@@ -0,0 +1,79 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbEnvelopeSTRTree.h"
+#include "itkMacro.h"
+#include <iostream>
+
+int otbEnvelopeSTRTree(int itkNotUsed(argc), char* itkNotUsed(argv)[])
+{
+  otb::EnvelopeSTRTree tree(4);
+
+  // 20 x 20 grid of unit cells, with gaps between them
+  std::vector<OGREnvelope> envelopes;
+  for (unsigned int y = 0; y < 20; ++y)
+  {
+    for (unsigned int x = 0; x < 20; ++x)
+    {
+      OGREnvelope envelope;
+      envelope.MinX = 2. * x;
+      envelope.MaxX = 2. * x + 1.;
+      envelope.MinY = 2. * y;
+      envelope.MaxY = 2. * y + 1.;
+      tree.Insert(envelope, envelopes.size());
+      envelopes.push_back(envelope);
+    }
+  }
+  tree.Build();
+
+  for (unsigned int q = 0; q < 50; ++q)
+  {
+    OGREnvelope query;
+    query.MinX = 0.7 * q - 3.;
+    query.MaxX = query.MinX + 0.3 * (q % 11) + 1.;
+    query.MinY = 0.9 * ((7 * q) % 50) - 3.;
+    query.MaxY = query.MinY + 0.4 * (q % 7);
+
+    otb::EnvelopeSTRTree::ItemListType expected;
+    for (std::size_t i = 0; i < envelopes.size(); ++i)
+    {
+      if (envelopes[i].Intersects(query))
+      {
+        expected.push_back(i);
+      }
+    }
+
+    if (tree.Query(query) != expected)
+    {
+      std::cerr << "Wrong items for query " << q << ": " << tree.Query(query).size() << " instead of " << expected.size() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  tree.Clear();
+  tree.Build();
+  if (!tree.Query(envelopes[0]).empty())
+  {
+    std::cerr << "Items found in an empty tree" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,143 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbPriorityFloodWatershedImageFilter_h
+#define otbPriorityFloodWatershedImageFilter_h
+
+#include "itkImageToImageFilter.h"
+#include <vector>
+#include <unordered_set>
+#include <utility>
+
+namespace otb
+{
+
+/** \class PriorityFloodWatershedImageFilter
+ * \brief Tiled and multi-threaded watershed by priority flood.
+ *
+ * Each thread floods its part of the requested region, padded by
+ * Margin pixels, from the regional minima found in the padded region.
+ * Basins meet without watershed lines. When Depth is positive, two
+ * basins meeting at a pass are merged if one of them is shallower than
+ * Depth below that pass, which plays the role of the flood level of
+ * itk::WatershedImageFilter but in input units, so that it does not
+ * depend on the tile content.
+ *
+ * A basin is labelled by the position of its minimum, so the labels
+ * are consistent between threads and streamed regions: the label is
+ * one plus the linear index of the first pixel of the minimum plateau
+ * in the largest possible region. The output pixel type must hold the
+ * number of pixels of the image.
+ *
+ * Minima touching the inner border of a padded region may be artefacts
+ * of the tiling. The basins flooded from them are relabelled after
+ * the threads complete, with the label most often given to the same
+ * pixels by the neighbouring threads. Across streamed regions, whose
+ * neighbours are not available, only the margin limits these
+ * artefacts.
+ *
+ * Only 2D images and face connectivity are supported.
+ *
+ * \sa WatershedSegmentationFilter
+ *
+ * \ingroup OTBWatersheds
+ */
+template <class TInputImage, class TOutputLabelImage>
+class ITK_EXPORT PriorityFloodWatershedImageFilter : public itk::ImageToImageFilter<TInputImage, TOutputLabelImage>
+{
+public:
+  /** Standard Self typedef */
+  typedef PriorityFloodWatershedImageFilter Self;
+  typedef itk::ImageToImageFilter<TInputImage, TOutputLabelImage> Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Method for creation through the object factory. */
+  itkNewMacro(Self);
+
+  /** Runtime information support. */
+  itkTypeMacro(PriorityFloodWatershedImageFilter, ImageToImageFilter);
+
+  /** Some convenient typedefs. */
+  typedef TInputImage                               InputImageType;
+  typedef TOutputLabelImage                         OutputLabelImageType;
+  typedef typename InputImageType::RegionType       RegionType;
+  typedef typename InputImageType::IndexType        IndexType;
+  typedef typename OutputLabelImageType::PixelType  LabelType;
+
+  /** ImageDimension constants */
+  itkStaticConstMacro(ImageDimension, unsigned int, TInputImage::ImageDimension);
+  static_assert(ImageDimension == 2, "Only 2D images are supported");
+
+  /** Depth below which a basin is merged into its neighbour (0 keeps
+   * all the regional minima) */
+  itkSetMacro(Depth, double);
+  itkGetConstMacro(Depth, double);
+
+  /** Padding of the region flooded by each thread */
+  itkSetMacro(Margin, unsigned int);
+  itkGetConstMacro(Margin, unsigned int);
+
+protected:
+  PriorityFloodWatershedImageFilter();
+  ~PriorityFloodWatershedImageFilter() override
+  {
+  }
+  void PrintSelf(std::ostream& os, itk::Indent indent) const override;
+
+  /** Pad the requested region by the margin */
+  void GenerateInputRequestedRegion() override;
+
+  void BeforeThreadedGenerateData() override;
+
+  void ThreadedGenerateData(const RegionType& outputRegionForThread, itk::ThreadIdType threadId) override;
+
+  /** Relabel the basins flooded from tiling artefacts */
+  void AfterThreadedGenerateData() override;
+
+private:
+  PriorityFloodWatershedImageFilter(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  /** What a thread leaves for the seam resolution */
+  struct ThreadResultType
+  {
+    RegionType core;
+    /** Labels given to the padding pixels */
+    std::vector<std::pair<IndexType, LabelType>> paddingLabels;
+    /** Labels of the basins flooded from a minimum touching the inner
+     * border of the padded region */
+    std::unordered_set<LabelType> borderLabels;
+  };
+
+  double       m_Depth;
+  unsigned int m_Margin;
+
+  std::vector<ThreadResultType> m_ThreadResults;
+};
+
+} // end namespace otb
+
+#ifndef OTB_MANUAL_INSTANTIATION
+#include "otbPriorityFloodWatershedImageFilter.hxx"
+#endif
+
+#endif
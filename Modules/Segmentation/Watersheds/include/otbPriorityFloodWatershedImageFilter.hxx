@@ -0,0 +1,376 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbPriorityFloodWatershedImageFilter_hxx
+#define otbPriorityFloodWatershedImageFilter_hxx
+
+#include "otbPriorityFloodWatershedImageFilter.h"
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+#include <algorithm>
+#include <queue>
+#include <map>
+#include <unordered_map>
+
+namespace otb
+{
+
+template <class TInputImage, class TOutputLabelImage>
+PriorityFloodWatershedImageFilter<TInputImage, TOutputLabelImage>::PriorityFloodWatershedImageFilter() : m_Depth(0.), m_Margin(32)
+{
+}
+
+template <class TInputImage, class TOutputLabelImage>
+void PriorityFloodWatershedImageFilter<TInputImage, TOutputLabelImage>::GenerateInputRequestedRegion()
+{
+  Superclass::GenerateInputRequestedRegion();
+
+  InputImageType* input = const_cast<InputImageType*>(this->GetInput());
+  if (!input)
+  {
+    return;
+  }
+
+  RegionType inputRegion = this->GetOutput()->GetRequestedRegion();
+  inputRegion.PadByRadius(m_Margin);
+  inputRegion.Crop(input->GetLargestPossibleRegion());
+  input->SetRequestedRegion(inputRegion);
+}
+
+template <class TInputImage, class TOutputLabelImage>
+void PriorityFloodWatershedImageFilter<TInputImage, TOutputLabelImage>::BeforeThreadedGenerateData()
+{
+  m_ThreadResults.clear();
+  m_ThreadResults.resize(this->GetNumberOfThreads());
+}
+
+template <class TInputImage, class TOutputLabelImage>
+void PriorityFloodWatershedImageFilter<TInputImage, TOutputLabelImage>::ThreadedGenerateData(const RegionType& outputRegionForThread,
+                                                                                             itk::ThreadIdType threadId)
+{
+  const InputImageType* input     = this->GetInput();
+  OutputLabelImageType* output    = this->GetOutput();
+  const RegionType      buffered  = input->GetBufferedRegion();
+  const RegionType      largest   = input->GetLargestPossibleRegion();
+  const RegionType      requested = output->GetRequestedRegion();
+
+  RegionType padded = outputRegionForThread;
+  padded.PadByRadius(m_Margin);
+  padded.Crop(buffered);
+
+  const IndexType          paddedStart = padded.GetIndex();
+  const IndexType          paddedEnd   = padded.GetUpperIndex();
+  const itk::SizeValueType width       = padded.GetSize()[0];
+  const itk::SizeValueType height      = padded.GetSize()[1];
+  const itk::SizeValueType nbPixels    = width * height;
+
+  std::vector<double>                           values(nbPixels);
+  itk::ImageRegionConstIterator<InputImageType> inIt(input, padded);
+  itk::SizeValueType                            i = 0;
+  for (inIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++i)
+  {
+    values[i] = static_cast<double>(inIt.Get());
+  }
+
+  auto forEachNeighbour = [width, height](itk::SizeValueType p, auto&& f) {
+    const itk::SizeValueType x = p % width;
+    const itk::SizeValueType y = p / width;
+    if (x > 0)
+      f(p - 1);
+    if (x + 1 < width)
+      f(p + 1);
+    if (y > 0)
+      f(p - width);
+    if (y + 1 < height)
+      f(p + width);
+  };
+
+  // A pixel is on the inner border when one of its neighbours is in the
+  // buffered region but outside the padded one
+  auto onInnerBorder = [&](itk::SizeValueType p) {
+    const itk::SizeValueType x = p % width;
+    const itk::SizeValueType y = p / width;
+    return (x == 0 && paddedStart[0] > buffered.GetIndex()[0]) || (x + 1 == width && paddedEnd[0] < buffered.GetUpperIndex()[0]) ||
+           (y == 0 && paddedStart[1] > buffered.GetIndex()[1]) || (y + 1 == height && paddedEnd[1] < buffered.GetUpperIndex()[1]);
+  };
+
+  struct BasinType
+  {
+    double             minValue;
+    LabelType          label;
+    bool               innerBorder;
+    itk::SizeValueType parent;
+  };
+  // Basin 0 stands for unflooded pixels
+  std::vector<BasinType>          basins(1);
+  std::vector<itk::SizeValueType> basinOf(nbPixels, 0);
+  auto                            findBasin = [&basins](itk::SizeValueType b) {
+    while (basins[b].parent != b)
+    {
+      basins[b].parent = basins[basins[b].parent].parent;
+      b                = basins[b].parent;
+    }
+    return b;
+  };
+
+  struct QueueElementType
+  {
+    double             value;
+    itk::SizeValueType order;
+    itk::SizeValueType pixel;
+    bool               operator<(const QueueElementType& other) const
+    {
+      // Lowest value first, then first pushed
+      return value > other.value || (value == other.value && order > other.order);
+    }
+  };
+  std::priority_queue<QueueElementType> queue;
+  itk::SizeValueType                    order = 0;
+
+  // Seed the flood with the regional minima
+  std::vector<char>               visited(nbPixels, 0);
+  std::vector<itk::SizeValueType> stack, plateau;
+  for (itk::SizeValueType p = 0; p < nbPixels; ++p)
+  {
+    if (visited[p])
+    {
+      continue;
+    }
+    const double value       = values[p];
+    bool         isMinimum   = true;
+    bool         innerBorder = false;
+    plateau.clear();
+    stack.assign(1, p);
+    visited[p] = 1;
+    while (!stack.empty())
+    {
+      const itk::SizeValueType q = stack.back();
+      stack.pop_back();
+      plateau.push_back(q);
+      innerBorder = innerBorder || onInnerBorder(q);
+      forEachNeighbour(q, [&](itk::SizeValueType n) {
+        if (values[n] < value)
+        {
+          isMinimum = false;
+        }
+        else if (values[n] == value && !visited[n])
+        {
+          visited[n] = 1;
+          stack.push_back(n);
+        }
+      });
+    }
+    if (!isMinimum)
+    {
+      continue;
+    }
+
+    // p is the first pixel of the plateau in raster order
+    BasinType basin;
+    basin.minValue    = value;
+    basin.innerBorder = innerBorder;
+    basin.parent      = basins.size();
+    basin.label       = static_cast<LabelType>(static_cast<itk::SizeValueType>(paddedStart[1] + p / width - largest.GetIndex()[1]) * largest.GetSize()[0] +
+                                         static_cast<itk::SizeValueType>(paddedStart[0] + p % width - largest.GetIndex()[0]) + 1);
+    basins.push_back(basin);
+    for (auto q : plateau)
+    {
+      basinOf[q] = basin.parent;
+      queue.push({value, order++, q});
+    }
+  }
+
+  // Flood
+  while (!queue.empty())
+  {
+    const QueueElementType element = queue.top();
+    queue.pop();
+    itk::SizeValueType current = findBasin(basinOf[element.pixel]);
+    forEachNeighbour(element.pixel, [&](itk::SizeValueType n) {
+      if (basinOf[n] == 0)
+      {
+        basinOf[n] = current;
+        queue.push({values[n], order++, n});
+      }
+      else if (m_Depth > 0.)
+      {
+        const itk::SizeValueType other = findBasin(basinOf[n]);
+        if (other == current)
+        {
+          return;
+        }
+        const double pass = std::max(values[element.pixel], values[n]);
+        if (pass - basins[current].minValue < m_Depth || pass - basins[other].minValue < m_Depth)
+        {
+          // The deepest basin absorbs the other one
+          const bool currentDeeper = basins[current].minValue < basins[other].minValue ||
+                                     (basins[current].minValue == basins[other].minValue && basins[current].label < basins[other].label);
+          if (currentDeeper)
+          {
+            basins[other].parent = current;
+          }
+          else
+          {
+            basins[current].parent = other;
+            current                = other;
+          }
+        }
+      }
+    });
+  }
+
+  // Write the core region, keep the padding for the seam resolution
+  ThreadResultType& result = m_ThreadResults[threadId];
+  result.core              = outputRegionForThread;
+  for (itk::SizeValueType b = 1; b < basins.size(); ++b)
+  {
+    if (basins[b].parent == b && basins[b].innerBorder)
+    {
+      result.borderLabels.insert(basins[b].label);
+    }
+  }
+
+  for (itk::SizeValueType p = 0; p < nbPixels; ++p)
+  {
+    IndexType index = paddedStart;
+    index[0] += p % width;
+    index[1] += p / width;
+    if (!outputRegionForThread.IsInside(index) && requested.IsInside(index))
+    {
+      result.paddingLabels.emplace_back(index, basins[findBasin(basinOf[p])].label);
+    }
+  }
+
+  itk::ImageRegionIterator<OutputLabelImageType> outIt(output, outputRegionForThread);
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    const IndexType          index = outIt.GetIndex();
+    const itk::SizeValueType p     = (index[1] - paddedStart[1]) * width + (index[0] - paddedStart[0]);
+    outIt.Set(basins[findBasin(basinOf[p])].label);
+  }
+}
+
+template <class TInputImage, class TOutputLabelImage>
+void PriorityFloodWatershedImageFilter<TInputImage, TOutputLabelImage>::AfterThreadedGenerateData()
+{
+  OutputLabelImageType* output = this->GetOutput();
+
+  // Count, for each basin flooded from the inner border of a padded
+  // region, the labels given to the same pixels by the owner thread
+  std::map<LabelType, std::map<LabelType, itk::SizeValueType>> votes;
+  for (const auto& result : m_ThreadResults)
+  {
+    for (const auto& padding : result.paddingLabels)
+    {
+      const ThreadResultType* owner = nullptr;
+      for (const auto& other : m_ThreadResults)
+      {
+        if (other.core.IsInside(padding.first))
+        {
+          owner = &other;
+          break;
+        }
+      }
+      if (!owner)
+      {
+        continue;
+      }
+      const LabelType label      = padding.second;
+      const LabelType ownerLabel = output->GetPixel(padding.first);
+      if (label == ownerLabel)
+      {
+        continue;
+      }
+      if (result.borderLabels.count(label))
+      {
+        ++votes[label][ownerLabel];
+      }
+      else if (owner->borderLabels.count(ownerLabel))
+      {
+        ++votes[ownerLabel][label];
+      }
+    }
+  }
+  m_ThreadResults.clear();
+
+  if (votes.empty())
+  {
+    return;
+  }
+
+  std::unordered_map<LabelType, LabelType> parents;
+  auto                                     findLabel = [&parents](LabelType label) {
+    auto it = parents.find(label);
+    while (it != parents.end())
+    {
+      label = it->second;
+      it    = parents.find(label);
+    }
+    return label;
+  };
+  for (const auto& vote : votes)
+  {
+    LabelType          target   = vote.first;
+    itk::SizeValueType maxCount = 0;
+    for (const auto& count : vote.second)
+    {
+      if (count.second > maxCount)
+      {
+        target   = count.first;
+        maxCount = count.second;
+      }
+    }
+    const LabelType root       = findLabel(vote.first);
+    const LabelType targetRoot = findLabel(target);
+    if (root != targetRoot)
+    {
+      parents[root] = targetRoot;
+    }
+  }
+
+  std::unordered_map<LabelType, LabelType> relabel;
+  for (const auto& parent : parents)
+  {
+    relabel[parent.first] = findLabel(parent.first);
+  }
+
+  itk::ImageRegionIterator<OutputLabelImageType> outIt(output, output->GetRequestedRegion());
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    auto it = relabel.find(outIt.Get());
+    if (it != relabel.end())
+    {
+      outIt.Set(it->second);
+    }
+  }
+}
+
+template <class TInputImage, class TOutputLabelImage>
+void PriorityFloodWatershedImageFilter<TInputImage, TOutputLabelImage>::PrintSelf(std::ostream& os, itk::Indent indent) const
+{
+  Superclass::PrintSelf(os, indent);
+  os << indent << "Depth: " << m_Depth << std::endl;
+  os << indent << "Margin: " << m_Margin << std::endl;
+}
+
+} // end namespace otb
+
+#endif
@@ -0,0 +1,112 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbPriorityFloodWatershedImageFilter.h"
+#include "otbImage.h"
+#include "itkImageRegionIteratorWithIndex.h"
+#include <set>
+#include <cmath>
+
+// Flood a field of cones: each basin must be labelled by its apex, on
+// both sides of the thread seams
+int otbPriorityFloodWatershedImageFilter(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " nbThreads margin" << std::endl;
+    return EXIT_FAILURE;
+  }
+  const unsigned int nbThreads = atoi(argv[1]);
+  const unsigned int margin    = atoi(argv[2]);
+
+  typedef otb::Image<float, 2>        InputImageType;
+  typedef otb::Image<unsigned int, 2> LabelImageType;
+  typedef otb::PriorityFloodWatershedImageFilter<InputImageType, LabelImageType> FilterType;
+
+  const unsigned int sizeX = 120, sizeY = 200;
+  const int          apexes[][2] = {{10, 15}, {90, 30}, {60, 70}, {20, 120}, {100, 140}, {50, 185}};
+  const unsigned int nbApexes    = sizeof(apexes) / sizeof(apexes[0]);
+
+  InputImageType::RegionType region;
+  region.SetSize(0, sizeX);
+  region.SetSize(1, sizeY);
+  InputImageType::Pointer image = InputImageType::New();
+  image->SetRegions(region);
+  image->Allocate();
+
+  itk::ImageRegionIteratorWithIndex<InputImageType> it(image, region);
+  for (it.GoToBegin(); !it.IsAtEnd(); ++it)
+  {
+    float distance = itk::NumericTraits<float>::max();
+    for (unsigned int a = 0; a < nbApexes; ++a)
+    {
+      distance = std::min(distance, static_cast<float>(std::hypot(it.GetIndex()[0] - apexes[a][0], it.GetIndex()[1] - apexes[a][1])));
+    }
+    it.Set(distance);
+  }
+
+  FilterType::Pointer filter = FilterType::New();
+  filter->SetInput(image);
+  filter->SetMargin(margin);
+  filter->SetNumberOfThreads(nbThreads);
+  filter->Update();
+
+  // Away from the basin boundaries, the label is the one of the nearest apex
+  std::set<unsigned int>                                labels;
+  unsigned int                                          nbChecked = 0, nbWrong = 0;
+  itk::ImageRegionConstIteratorWithIndex<LabelImageType> outIt(filter->GetOutput(), region);
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    labels.insert(outIt.Get());
+    double       first = itk::NumericTraits<double>::max(), second = first;
+    unsigned int nearest = 0;
+    for (unsigned int a = 0; a < nbApexes; ++a)
+    {
+      const double distance = std::hypot(outIt.GetIndex()[0] - apexes[a][0], outIt.GetIndex()[1] - apexes[a][1]);
+      if (distance < first)
+      {
+        second  = first;
+        first   = distance;
+        nearest = a;
+      }
+      else if (distance < second)
+      {
+        second = distance;
+      }
+    }
+    if (second - first < 3.)
+    {
+      continue;
+    }
+    ++nbChecked;
+    if (outIt.Get() != apexes[nearest][1] * sizeX + apexes[nearest][0] + 1)
+    {
+      ++nbWrong;
+    }
+  }
+
+  std::cout << labels.size() << " basins, " << nbWrong << " wrong labels out of " << nbChecked << " checked pixels" << std::endl;
+  if (labels.size() != nbApexes || nbWrong > nbChecked / 100)
+  {
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
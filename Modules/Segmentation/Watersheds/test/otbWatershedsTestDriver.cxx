@@ -23,4 +23,5 @@
 void RegisterTests()
 {
   REGISTER_TEST(otbWatershedSegmentationFilter);
+  REGISTER_TEST(otbPriorityFloodWatershedImageFilter);
 }
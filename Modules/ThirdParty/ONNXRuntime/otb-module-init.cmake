@@ -0,0 +1,28 @@
+#
+# Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+find_package(ONNXRuntime REQUIRED)
+
+mark_as_advanced(ONNXRUNTIME_INCLUDE_DIR)
+mark_as_advanced(ONNXRUNTIME_LIBRARY)
+
+if(NOT ONNXRUNTIME_FOUND)
+ message(FATAL_ERROR "Cannot find ONNX Runtime. Set ONNXRUNTIME_INCLUDE_DIR and ONNXRUNTIME_LIBRARY")
+endif()
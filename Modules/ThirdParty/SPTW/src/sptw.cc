@@ -18,6 +18,7 @@
 #include <fcntl.h>
 #include <gdal_priv.h>
 #include <cpl_string.h>
+#include <cpl_conv.h>
 #include <ogr_api.h>
 #include <ogr_spatialref.h>
 #include <mpi.h>
@@ -25,6 +26,7 @@
 #include <tiffio.h>
 
 #include <algorithm>
+#include <climits>
 #include <sstream>
 #include <iostream>
 #include <vector>
@@ -490,6 +492,74 @@ SPTW_ERROR create_tiled_raster(string filename,
   return SP_None;
 }
 
+SPTW_ERROR create_compressed_raster(string filename,
+                                    int64_t x_size,
+                                    int64_t y_size,
+                                    int band_count,
+                                    GDALDataType band_type,
+                                    double *geotransform,
+                                    string projection_srs,
+                                    int64_t block_x_size,
+                                    int64_t block_y_size,
+                                    bool tiled,
+                                    int zlevel) {
+  GDALDriver *gtiff_driver = NULL;
+  GDALDataset *ds = NULL;
+  char **options = NULL;
+
+  GDALAllRegister();
+
+  gtiff_driver = GetGDALDriverManager()->GetDriverByName("GTiff");
+
+  if (gtiff_driver == NULL) {
+    return SP_CreateError;
+  }
+
+  std::stringstream xs, ys, zs;
+  xs << block_x_size;
+  ys << block_y_size;
+  zs << zlevel;
+
+  options = CSLSetNameValue(options, "BIGTIFF", "YES");
+  options = CSLSetNameValue(options, "INTERLEAVE", "PIXEL");
+  options = CSLSetNameValue(options, "COMPRESS", "DEFLATE");
+  options = CSLSetNameValue(options, "ZLEVEL", zs.str().c_str());
+  // Blocks are never written by GDAL, they are appended later
+  options = CSLSetNameValue(options, "SPARSE_OK", "YES");
+  if (tiled) {
+    options = CSLSetNameValue(options, "TILED", "YES");
+    options = CSLSetNameValue(options, "BLOCKXSIZE", xs.str().c_str());
+  }
+  options = CSLSetNameValue(options, "BLOCKYSIZE", ys.str().c_str());
+
+  ds = gtiff_driver->Create(filename.c_str(),
+                            x_size,
+                            y_size,
+                            band_count,
+                            band_type,
+                            options);
+  // Clean up options
+  CSLDestroy(options);
+
+  if (ds == NULL) {
+    return SP_CreateError;
+  }
+
+  CPLErr err = ds->SetProjection(projection_srs.c_str());
+
+  if (err != CE_None) {
+    GDALClose((GDALDatasetH) ds);
+    return SP_BadArg;
+  }
+
+  ds->SetGeoTransform(geotransform);
+
+  // Close dataset
+  GDALClose((GDALDatasetH) ds);
+
+  return SP_None;
+}
+
 PTIFF* open_raster(string filename) {
   PTIFF *ptiff = new PTIFF();
   char *c_filename = strdup(filename.c_str());
@@ -597,6 +667,10 @@ PTIFF* open_raster(string filename) {
 
   MPI_File_set_atomicity(ptiff->fh, 0);
 
+  MPI_Offset file_size = 0;
+  MPI_File_get_size(ptiff->fh, &file_size);
+  ptiff->append_offset = file_size;
+
   if (c_filename != NULL) {
     free(c_filename);
   }
@@ -773,4 +847,361 @@ SPTW_ERROR write_area(PTIFF *ptiff,
   }
   return SP_None;
 }
+
+/*
+ * A contiguous piece of data to write: offset in the file, offset in the
+ * source buffer and size in bytes
+ */
+struct Run {
+  int64_t file_offset;
+  int64_t buffer_offset;
+  int64_t size;
+
+  bool operator<(const Run &other) const {
+    return file_offset < other.file_offset;
+  }
+};
+
+SPTW_ERROR write_area_collective(PTIFF *ptiff,
+                                 void *data,
+                                 int64_t ul_x,
+                                 int64_t ul_y,
+                                 int64_t lr_x,
+                                 int64_t lr_y) {
+  const int64_t pixel_size = ptiff->band_type_size * ptiff->band_count;
+  std::vector<Run> runs;
+
+  if (data != NULL) {
+    // Split the area along the blocks, as write_area does, and list the
+    // rows of each block-bound subset
+    std::vector<Area> write_stack;
+    write_stack.push_back(Area(ul_x, ul_y, lr_x, lr_y));
+
+    while (!write_stack.empty()) {
+      Area top = write_stack.back();
+      write_stack.pop_back();
+
+      Area subset = calculate_tile_intersection(ptiff, top);
+      fill_stack(&write_stack, top, subset);
+
+      const int64_t sub_ul_x = static_cast<int64_t>(subset.ul.x);
+      const int64_t sub_lr_x = static_cast<int64_t>(subset.lr.x);
+      for (int64_t y = static_cast<int64_t>(subset.ul.y);
+           y <= static_cast<int64_t>(subset.lr.y); ++y) {
+        Run run;
+        run.file_offset = calculate_file_offset(ptiff, sub_ul_x, y);
+        run.buffer_offset = ((y - ul_y) * (lr_x - ul_x + 1)
+                             + (sub_ul_x - ul_x)) * pixel_size;
+        run.size = (sub_lr_x - sub_ul_x + 1) * pixel_size;
+        runs.push_back(run);
+      }
+    }
+  }
+
+  // File views need increasing displacements: pack the runs in file order,
+  // merging the ones contiguous in the file
+  std::sort(runs.begin(), runs.end());
+
+  std::vector<int> lengths;
+  std::vector<MPI_Aint> displacements;
+  int64_t total_size = 0;
+  for (size_t i = 0; i < runs.size(); ++i) {
+    if (!displacements.empty()
+        && displacements.back() + lengths.back() == runs[i].file_offset
+        && lengths.back() + runs[i].size <= INT_MAX) {
+      lengths.back() += static_cast<int>(runs[i].size);
+    } else {
+      displacements.push_back(runs[i].file_offset);
+      lengths.push_back(static_cast<int>(runs[i].size));
+    }
+    total_size += runs[i].size;
+  }
+
+  // An error on one process must not leave the others in the collective call
+  int local_error = total_size > INT_MAX ? 1 : 0;
+  int error = 0;
+  MPI_Allreduce(&local_error, &error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  if (error != 0) {
+    return SP_BadArg;
+  }
+
+  std::vector<char> buffer(total_size);
+  int64_t packed = 0;
+  for (size_t i = 0; i < runs.size(); ++i) {
+    memcpy(&buffer[packed],
+           static_cast<char*>(data) + runs[i].buffer_offset,
+           runs[i].size);
+    packed += runs[i].size;
+  }
+
+  MPI_Datatype file_type = MPI_BYTE;
+  if (!lengths.empty()) {
+    MPI_Type_create_hindexed(static_cast<int>(lengths.size()),
+                             &lengths[0],
+                             &displacements[0],
+                             MPI_BYTE,
+                             &file_type);
+    MPI_Type_commit(&file_type);
+  }
+
+  MPI_Status status;
+  char native[] = "native";
+  MPI_File_set_view(ptiff->fh, 0, MPI_BYTE, file_type, native, MPI_INFO_NULL);
+  int rc = MPI_File_write_all(ptiff->fh,
+                              buffer.empty() ? NULL : &buffer[0],
+                              static_cast<int>(total_size),
+                              MPI_BYTE,
+                              &status);
+  MPI_File_set_view(ptiff->fh, 0, MPI_BYTE, MPI_BYTE, native, MPI_INFO_NULL);
+
+  if (file_type != MPI_BYTE) {
+    MPI_Type_free(&file_type);
+  }
+
+  return rc == MPI_SUCCESS ? SP_None : SP_WriteError;
+}
+
+SPTW_ERROR write_compressed_area(PTIFF *ptiff,
+                                 void *data,
+                                 int64_t ul_x,
+                                 int64_t ul_y,
+                                 int64_t lr_x,
+                                 int64_t lr_y,
+                                 int64_t block_x_size,
+                                 int64_t block_y_size,
+                                 bool tiled,
+                                 int zlevel) {
+  const int64_t pixel_size = ptiff->band_type_size * ptiff->band_count;
+  if (!tiled) {
+    block_x_size = ptiff->x_size;
+  }
+  const int64_t blocks_across = (ptiff->x_size + block_x_size - 1)
+      / block_x_size;
+
+  std::vector<char> payload;
+  std::vector<int64_t> indices;
+  std::vector<int64_t> sizes;
+  int local_error = 0;
+
+  if (data != NULL) {
+    // The area must be made of whole blocks
+    if (ul_x % block_x_size != 0 || ul_y % block_y_size != 0
+        || ((lr_x + 1) % block_x_size != 0 && lr_x + 1 != ptiff->x_size)
+        || ((lr_y + 1) % block_y_size != 0 && lr_y + 1 != ptiff->y_size)) {
+      local_error = 1;
+    }
+
+    const int64_t area_width = lr_x - ul_x + 1;
+    std::vector<char> block;
+
+    for (int64_t by = ul_y; by <= lr_y && local_error == 0;
+         by += block_y_size) {
+      for (int64_t bx = ul_x; bx <= lr_x && local_error == 0;
+           bx += block_x_size) {
+        // Tiles always have the full block size, the last strip only has
+        // the remaining rows
+        const int64_t width = std::min(block_x_size, lr_x - bx + 1);
+        const int64_t height = std::min(block_y_size, lr_y - by + 1);
+        const int64_t block_rows = tiled ? block_y_size : height;
+        block.assign(block_x_size * block_rows * pixel_size, 0);
+
+        for (int64_t y = 0; y < height; ++y) {
+          memcpy(&block[y * block_x_size * pixel_size],
+                 static_cast<char*>(data)
+                 + ((by - ul_y + y) * area_width + (bx - ul_x)) * pixel_size,
+                 width * pixel_size);
+        }
+
+        size_t compressed_size = 0;
+        void *compressed = CPLZLibDeflate(&block[0], block.size(), zlevel,
+                                          NULL, 0, &compressed_size);
+        if (compressed == NULL) {
+          local_error = 1;
+          break;
+        }
+        payload.insert(payload.end(),
+                       static_cast<char*>(compressed),
+                       static_cast<char*>(compressed) + compressed_size);
+        CPLFree(compressed);
+
+        indices.push_back(bx / block_x_size + (by / block_y_size) * blocks_across);
+        sizes.push_back(compressed_size);
+      }
+    }
+    if (payload.size() > INT_MAX) {
+      local_error = 1;
+    }
+  }
+
+  // An error on one process must not leave the others in the collective call
+  int error = 0;
+  MPI_Allreduce(&local_error, &error, 1, MPI_INT, MPI_MAX, MPI_COMM_WORLD);
+  if (error != 0) {
+    return SP_BadArg;
+  }
+
+  // Blocks of the lower ranks come first
+  int64_t local_size = payload.size();
+  int64_t rank_offset = 0;
+  int64_t total_size = 0;
+  int rank = 0;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Exscan(&local_size, &rank_offset, 1, MPI_INT64_T, MPI_SUM,
+             MPI_COMM_WORLD);
+  if (rank == 0) {
+    rank_offset = 0;
+  }
+  MPI_Allreduce(&local_size, &total_size, 1, MPI_INT64_T, MPI_SUM,
+                MPI_COMM_WORLD);
+
+  const int64_t offset = ptiff->append_offset + rank_offset;
+  MPI_Status status;
+  int rc = MPI_File_write_at_all(ptiff->fh,
+                                 offset,
+                                 payload.empty() ? NULL : &payload[0],
+                                 static_cast<int>(local_size),
+                                 MPI_BYTE,
+                                 &status);
+  ptiff->append_offset += total_size;
+
+  int64_t block_offset = offset;
+  for (size_t i = 0; i < indices.size(); ++i) {
+    ptiff->block_indices.push_back(indices[i]);
+    ptiff->block_offsets.push_back(block_offset);
+    ptiff->block_byte_counts.push_back(sizes[i]);
+    block_offset += sizes[i];
+  }
+
+  return rc == MPI_SUCCESS ? SP_None : SP_WriteError;
+}
+
+/*
+ * Write the value of a block of a TIFF directory entry of type SHORT,
+ * LONG or LONG8
+ */
+SPTW_ERROR write_entry_value(PTIFF *tiff_file,
+                             int64_t entry_offset,
+                             int16_t type,
+                             int64_t count,
+                             int64_t index,
+                             int64_t value,
+                             bool big_endian) {
+  int type_size = get_type_size(static_cast<TIFFDataType>(type));
+  if ((type != TIFF_SHORT && type != TIFF_LONG && type != TIFF_LONG8)
+      || index >= count
+      || (type_size < 8 && (value >> (8 * type_size)) != 0)) {
+    return SP_BadArg;
+  }
+
+  // Values are stored in the entry itself when they fit in it
+  int64_t values_offset = entry_offset + 12;
+  if (count * type_size > 8) {
+    values_offset = read_int64(tiff_file, entry_offset + 12, big_endian);
+  }
+
+  uint8_t buffer[8];
+  export_int64(value, buffer, big_endian);
+  MPI_File_write_at(tiff_file->fh,
+                    values_offset + index * type_size,
+                    big_endian ? buffer + 8 - type_size : buffer,
+                    type_size,
+                    MPI_BYTE,
+                    MPI_STATUS_IGNORE);
+  return SP_None;
+}
+
+SPTW_ERROR write_block_table(PTIFF *ptiff) {
+  int rank = 0;
+  int nb_procs = 1;
+  MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+  MPI_Comm_size(MPI_COMM_WORLD, &nb_procs);
+
+  // Gather the (index, offset, size) triplets on the master process
+  std::vector<int64_t> local;
+  for (size_t i = 0; i < ptiff->block_indices.size(); ++i) {
+    local.push_back(ptiff->block_indices[i]);
+    local.push_back(ptiff->block_offsets[i]);
+    local.push_back(ptiff->block_byte_counts[i]);
+  }
+
+  int local_count = static_cast<int>(local.size());
+  std::vector<int> counts(nb_procs);
+  MPI_Gather(&local_count, 1, MPI_INT, &counts[0], 1, MPI_INT, 0,
+             MPI_COMM_WORLD);
+
+  std::vector<int> displacements(nb_procs, 0);
+  for (int i = 1; i < nb_procs; ++i) {
+    displacements[i] = displacements[i - 1] + counts[i - 1];
+  }
+
+  std::vector<int64_t> table(rank == 0 ?
+                             displacements.back() + counts.back() : 0);
+  MPI_Gatherv(local.empty() ? NULL : &local[0], local_count, MPI_INT64_T,
+              table.empty() ? NULL : &table[0], &counts[0], &displacements[0],
+              MPI_INT64_T, 0, MPI_COMM_WORLD);
+
+  SPTW_ERROR result = SP_None;
+  if (rank == 0) {
+    uint8_t endian_flag[2] = { 0x49, 0x49 };
+    MPI_File_read_at(ptiff->fh, 0, endian_flag, 2, MPI_BYTE,
+                     MPI_STATUS_IGNORE);
+    const bool big_endian = endian_flag[0] == 0x4d;
+
+    // Locate the offsets and byte counts entries of the first directory
+    int64_t doffset = read_int64(ptiff, 8, big_endian);
+    int64_t entry_count = read_int64(ptiff, doffset, big_endian);
+    int64_t entry_offset = doffset + sizeof(int64_t);
+    int64_t offsets_entry = -1;
+    int64_t counts_entry = -1;
+
+    for (int64_t i = 0; i < entry_count; ++i, entry_offset += 20) {
+      uint8_t tag_buffer[2];
+      MPI_File_read_at(ptiff->fh, entry_offset, tag_buffer, 2, MPI_BYTE,
+                       MPI_STATUS_IGNORE);
+      const uint16_t entry_tag = parse_int16(tag_buffer, big_endian);
+      if (entry_tag == TIFFTAG_TILEOFFSETS
+          || entry_tag == TIFFTAG_STRIPOFFSETS) {
+        offsets_entry = entry_offset;
+      } else if (entry_tag == TIFFTAG_TILEBYTECOUNTS
+                 || entry_tag == TIFFTAG_STRIPBYTECOUNTS) {
+        counts_entry = entry_offset;
+      }
+    }
+
+    if (offsets_entry < 0 || counts_entry < 0) {
+      result = SP_BadArg;
+    }
+
+    uint8_t type_buffer[2];
+    int16_t offsets_type = 0;
+    int16_t counts_type = 0;
+    int64_t offsets_count = 0;
+    int64_t counts_count = 0;
+    if (result == SP_None) {
+      MPI_File_read_at(ptiff->fh, offsets_entry + 2, type_buffer, 2,
+                       MPI_BYTE, MPI_STATUS_IGNORE);
+      offsets_type = parse_int16(type_buffer, big_endian);
+      offsets_count = read_int64(ptiff, offsets_entry + 4, big_endian);
+      MPI_File_read_at(ptiff->fh, counts_entry + 2, type_buffer, 2,
+                       MPI_BYTE, MPI_STATUS_IGNORE);
+      counts_type = parse_int16(type_buffer, big_endian);
+      counts_count = read_int64(ptiff, counts_entry + 4, big_endian);
+    }
+
+    for (size_t i = 0; i + 2 < table.size() && result == SP_None; i += 3) {
+      result = write_entry_value(ptiff, offsets_entry, offsets_type,
+                                 offsets_count, table[i], table[i + 1],
+                                 big_endian);
+      if (result == SP_None) {
+        result = write_entry_value(ptiff, counts_entry, counts_type,
+                                   counts_count, table[i], table[i + 2],
+                                   big_endian);
+      }
+    }
+  }
+
+  int code = result;
+  MPI_Bcast(&code, 1, MPI_INT, 0, MPI_COMM_WORLD);
+  return static_cast<SPTW_ERROR>(code);
+}
 }
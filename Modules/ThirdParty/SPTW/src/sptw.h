@@ -23,6 +23,7 @@
 #include <mpi.h>
 
 #include <string>
+#include <vector>
 #if HAVE_STDINT_H == 0
 #include <cstdint>
 #else
@@ -91,6 +92,13 @@ namespace sptw {
         int64_t tiles_across;
         /* Number of tiles down raster */
         int64_t tiles_down;
+        /* End of the file, where compressed blocks are appended */
+        int64_t append_offset;
+        /* Compressed blocks written by this process: block index, file
+         * offset and size in bytes, see write_block_table */
+        std::vector<int64_t> block_indices;
+        std::vector<int64_t> block_offsets;
+        std::vector<int64_t> block_byte_counts;
     };
 
     SPTW_ERROR populate_tile_offsets(PTIFF *tiff_file,
@@ -123,6 +131,29 @@ namespace sptw {
             double *geotransform,
             string projection_srs,
             int64_t tile_size);
+    /**
+     * @brief
+     * Creates a DEFLATE compressed, tiled or stripped, BigTIFF raster. No
+     * block is allocated: the blocks are appended at the end of the file by
+     * write_compressed_area and referenced by write_block_table.
+     *
+     * @param block_x_size Width of the tiles (ignored for strips)
+     * @param block_y_size Height of the tiles, or number of rows per strip
+     * @param tiled Whether the raster is tiled or stripped
+     * @param zlevel DEFLATE compression level, from 1 to 9
+     */
+    SPTW_ERROR create_compressed_raster(string filename,
+            int64_t x_size,
+            int64_t y_size,
+            int band_count,
+            GDALDataType band_type,
+            double *geotransform,
+            string projection_srs,
+            int64_t block_x_size,
+            int64_t block_y_size,
+            bool tiled,
+            int zlevel);
+
     PTIFF* open_raster(string filename);
     SPTW_ERROR close_raster(PTIFF *ptiff);
 
@@ -152,6 +183,49 @@ namespace sptw {
             int64_t ul_y,
             int64_t lr_x,
             int64_t lr_y);
+
+    /**
+     * @brief
+     * Collective version of write_area: every process of the communicator
+     * must call it, the ones having nothing to write with a NULL buffer.
+     * The rows of the area are packed in file order and written with a
+     * single collective operation, letting MPI-IO aggregate the writes.
+     */
+    SPTW_ERROR write_area_collective(PTIFF *ptiff,
+            void *data,
+            int64_t ul_x,
+            int64_t ul_y,
+            int64_t lr_x,
+            int64_t lr_y);
+
+    /**
+     * @brief
+     * Compresses the blocks covered by the area and appends them to a raster
+     * created by create_compressed_raster. The area must be aligned on the
+     * blocks (or end at the raster border). Every process of the
+     * communicator must call it, the ones having nothing to write with a
+     * NULL buffer: the offset of each process is computed from the
+     * compressed sizes of the lower ranks and the data is written with a
+     * single collective operation.
+     */
+    SPTW_ERROR write_compressed_area(PTIFF *ptiff,
+            void *data,
+            int64_t ul_x,
+            int64_t ul_y,
+            int64_t lr_x,
+            int64_t lr_y,
+            int64_t block_x_size,
+            int64_t block_y_size,
+            bool tiled,
+            int zlevel);
+
+    /**
+     * @brief
+     * Gathers the offsets and sizes of the compressed blocks of all the
+     * processes and writes them in the TIFF directory. Collective, to be
+     * called once all the blocks are written and before close_raster.
+     */
+    SPTW_ERROR write_block_table(PTIFF *ptiff);
 }
 
 #endif  // SRC_DEMOS_SPTW_H_
@@ -139,6 +139,34 @@ void ListSampleRangeToSharkVector(const T* listSample, std::vector<unsigned int>
   }
 }
 
+/** Copy a range of samples into a single shark batch (one row per sample),
+ * which models evaluate with matrix products */
+template <class T>
+void ListSampleRangeToSharkMatrix(const T* listSample, shark::RealMatrix& output, unsigned int start, unsigned int size)
+{
+  assert(listSample != nullptr);
+
+  if (start + size > listSample->Size())
+  {
+    std::out_of_range e_(
+        std::string("otb::Shark::ListSampleRangeToSharkMatrix "
+                    ": Requested range is out of list sample bounds"));
+    throw e_;
+  }
+
+  const unsigned int sampleSize = size > 0 ? listSample->GetMeasurementVectorSize() : 0;
+  output = shark::RealMatrix(size, sampleSize);
+
+  for (unsigned int row = 0; row < size; ++row)
+  {
+    typename T::MeasurementVectorType const& sample = listSample->GetMeasurementVector(start + row);
+    for (unsigned int i = 0; i < sampleSize; ++i)
+    {
+      output(row, i) = sample[i];
+    }
+  }
+}
+
 template <class T>
 void ListSampleToSharkVector(const T* listSample, std::vector<shark::RealVector>& output)
 {
@@ -25,6 +25,7 @@
 #include <algorithm>
 
 #include "itkCenteredRigid2DTransform.h"
+#include "itkMultiThreader.h"
 
 #include "otbGenericRSTransform.h"
 #include "otbGeoInterface.h"
@@ -36,6 +37,7 @@
 #include "otbVectorImage.h"
 
 #include <string>
+#include <vector>
 
 
 namespace otb
@@ -131,6 +133,22 @@ public:
   itkSetMacro(TileSize,unsigned int);
   itkGetMacro(TileSize,unsigned int);
 
+  // Number of threads reading the missing tiles of the viewport
+  itkSetMacro(NumberOfLoaderThreads,unsigned int);
+  itkGetMacro(NumberOfLoaderThreads,unsigned int);
+
+  // GPU memory (in MB) of the tiles kept loaded outside of the
+  // viewport, so that panning back does not read them again
+  itkSetMacro(GPUMemoryBudget,unsigned int);
+  itkGetMacro(GPUMemoryBudget,unsigned int);
+
+  // In shader mode, images with at most this number of bands are
+  // uploaded with all their bands, and the shader selects the
+  // rendered ones: changing the band selection does not read the
+  // tiles again
+  itkSetMacro(MaximumNumberOfTextureBands,unsigned int);
+  itkGetMacro(MaximumNumberOfTextureBands,unsigned int);
+
   void CreateShader() override;
 
   void SetResolutionAlgorithm(ResolutionAlgorithm::type alg)
@@ -225,7 +243,7 @@ protected:
     Image() const noexcept
       { return m_Image; }
 
-    void Acquire() noexcept;
+    void Acquire( bool isArray ) noexcept;
     void Release();
 
     bool m_Loaded;
@@ -240,6 +258,9 @@ protected:
     unsigned int m_RedIdx;
     unsigned int m_GreenIdx;
     unsigned int m_BlueIdx;
+    // All the bands are read, not only m_RedIdx, m_GreenIdx and m_BlueIdx
+    bool m_AllBands;
+    unsigned long m_LastUsed;
     RescaleFilterType::Pointer m_RescaleFilter;
 
   private:
@@ -254,8 +275,25 @@ private:
   GlImageActor(const Self&);
   void operator=(const Self&);
 
+  struct DecodeTilesThreadStruct
+  {
+    GlImageActor * Actor;
+    std::vector< Tile > * Tiles;
+    std::vector< std::vector< float > > * Buffers;
+    std::vector< std::string > * Errors;
+  };
+
+  static ITK_THREAD_RETURN_TYPE DecodeTilesThreaderCallback( void * arg );
+
+  // Read the tiles in parallel, and load them to GPU
+  void LoadTiles(std::vector< Tile > & tiles);
+
+  // Read tile with the given reader (thread-safe, one reader per
+  // thread), and convert it to a texture buffer in shader mode
+  void DecodeTile(Tile& tile, ReaderType * reader, std::vector< float > & buffer) const;
+
   // Load tile to GPU
-  void LoadTile(Tile& tile);
+  void LoadTile(Tile& tile, const std::vector< float > & buffer);
 
   // Unload tile from GPU
   void UnloadTile(Tile& tile);
@@ -263,10 +301,23 @@ private:
   // Clean the loaded tiles, getting rid of unnecessary ones
   void CleanLoadedTiles();
 
+  // Unload the least recently used tiles outside of the viewport
+  // until the GPU memory budget is met
+  void ApplyGPUMemoryBudget();
+
+  // GPU memory used by the texture of a tile
+  std::size_t GetTileGPUMemory(const Tile& tile) const;
+
+  // Are the tiles read with all their bands ?
+  bool UseAllBandsTiles() const;
+
+  // Rendered (red, green, blue) pixel of a tile
+  PixelType GetTilePixel(const Tile& tile, const IndexType& index) const;
+
   // Clear all loaded tiles
   void ClearLoadedTiles();
 
-  // Is tile loaded ?
+  // Is tile loaded ? If so, it is marked as used by the current update
   bool TileAlreadyLoaded(const Tile& tile);
 
   void ImageRegionToViewportExtent(const RegionType& region, double & ulx, double & uly, double & lrx, double& lry) const;
@@ -285,6 +336,19 @@ private:
 
   TileVectorType m_LoadedTiles;
 
+  // One reader per loader thread
+  std::vector< ReaderType::Pointer > m_LoaderReaders;
+
+  unsigned int m_NumberOfLoaderThreads;
+
+  unsigned int m_GPUMemoryBudget;
+
+  unsigned int m_MaximumNumberOfTextureBands;
+
+  // Counter of the calls to UpdateData(), tiles of the viewport have
+  // their m_LastUsed equal to it
+  unsigned long m_UpdateCount;
+
   unsigned int m_RedIdx;
 
   unsigned int m_GreenIdx;
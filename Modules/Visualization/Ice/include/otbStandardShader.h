@@ -47,7 +47,8 @@ typedef enum
   SHADER_LUT_SUMMER,
   SHADER_LUT_LOCAL_SUMMER,
   SHADER_LUT_COOL,
-  SHADER_LUT_LOCAL_COOL
+  SHADER_LUT_LOCAL_COOL,
+  SHADER_NORMALIZED_DIFFERENCE
 } ShaderType;
 
 
@@ -92,6 +93,11 @@ public:
 
   void SetupShader() override;
 
+  // Select the layers of the texture array rendered as red, green
+  // and blue (0-based, default to 0, 1 and 2). Must be called while
+  // the shader is loaded, after SetupShader().
+  void SetTextureBands(int red, int green, int blue);
+
   itkNewMacro(Self);
 
 protected:
@@ -148,6 +154,7 @@ private:
     int chessboard_size;
     int slider_pos;
     int vertical_slider_flag;
+    int bands;
     };
 
   UniformLocs m_Loc;
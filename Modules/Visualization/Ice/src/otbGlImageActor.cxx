@@ -33,10 +33,12 @@
 #include "otbStandardShader.h"
 
 #include "itkListSample.h"
+#include "itkImageRegionConstIteratorWithIndex.h"
 #include "otbListSampleToHistogramListGenerator.h"
 #include "otbCast.h"
 
 #include <stdexcept>
+#include <cmath>
 
 namespace otb
 {
@@ -55,6 +57,8 @@ GlImageActor::Tile
   , m_RedIdx(1)
   , m_GreenIdx(2)
   , m_BlueIdx(3)
+  , m_AllBands(false)
+  , m_LastUsed(0)
   , m_RescaleFilter(nullptr)
 {
   m_UL.Fill(0);
@@ -70,8 +74,12 @@ GlImageActor::Tile
 
 void
 GlImageActor::Tile
-::Acquire() noexcept
+::Acquire( bool isArray ) noexcept
 {
+  // Multi-band tiles of the shader mode use a texture array, one band
+  // per layer
+  const GLenum target = isArray ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+
   // Now load the texture
   assert( m_TextureId==0 );
 
@@ -86,20 +94,20 @@ GlImageActor::Tile
 
   // std::cout << "Generated texture #" << m_TextureId << std::endl;
 
-  glBindTexture( GL_TEXTURE_2D, m_TextureId );
+  glBindTexture( target, m_TextureId );
 
 #if defined( GL_TEXTURE_BASE_LEVEL ) && defined( GL_TEXTURE_MAX_LEVEL )
-  glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_BASE_LEVEL, 0 );
-  glTexParameteri( GL_TEXTURE_2D, GL_TEXTURE_MAX_LEVEL, 0 );
+  glTexParameteri( target, GL_TEXTURE_BASE_LEVEL, 0 );
+  glTexParameteri( target, GL_TEXTURE_MAX_LEVEL, 0 );
 #endif
 
 #if 0
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
+  glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+  glTexParameteri(target, GL_TEXTURE_MAG_FILTER, GL_LINEAR);
 #endif
 
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S,GL_MIRRORED_REPEAT);
-  glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T,GL_MIRRORED_REPEAT);
+  glTexParameteri(target, GL_TEXTURE_WRAP_S,GL_MIRRORED_REPEAT);
+  glTexParameteri(target, GL_TEXTURE_WRAP_T,GL_MIRRORED_REPEAT);
 }
 
 
@@ -137,9 +145,17 @@ GlImageActor::Tile
 
   extract->SetExtractionRegion( m_ImageRegion );
 
-  extract->SetChannel( m_RedIdx );
-  extract->SetChannel( m_GreenIdx );
-  extract->SetChannel( m_BlueIdx );
+  if( m_AllBands )
+    {
+    for( unsigned int band = 1; band <= i->GetNumberOfComponentsPerPixel(); ++band )
+      extract->SetChannel( band );
+    }
+  else
+    {
+    extract->SetChannel( m_RedIdx );
+    extract->SetChannel( m_GreenIdx );
+    extract->SetChannel( m_BlueIdx );
+    }
 
   extract->Update();
 
@@ -152,6 +168,11 @@ GlImageActor::GlImageActor()
     m_FileName(),
     m_FileReader(),
     m_LoadedTiles(),
+    m_LoaderReaders(),
+    m_NumberOfLoaderThreads(itk::MultiThreader::GetGlobalDefaultNumberOfThreads()),
+    m_GPUMemoryBudget(256),
+    m_MaximumNumberOfTextureBands(16),
+    m_UpdateCount(0),
     m_RedIdx(1),
     m_GreenIdx(2),
     m_BlueIdx(3),
@@ -264,6 +285,7 @@ void GlImageActor::Initialize(const std::string & filename)
 
   // First, clean up any previous data
   this->ClearLoadedTiles();
+  m_LoaderReaders.clear();
 
   m_FileName = filename;
 
@@ -345,6 +367,8 @@ void GlImageActor::UpdateData()
   // First, clean existing tiles
   CleanLoadedTiles();
 
+  ++m_UpdateCount;
+
   // Retrieve settings
   ViewSettings::ConstPointer settings = GetSettings();
 
@@ -376,6 +400,8 @@ void GlImageActor::UpdateData()
   SizeType tileSize;
   tileSize.Fill(m_TileSize);
 
+  std::vector< Tile > missingTiles;
+
    for(unsigned int i = 0; i < nbTilesX; ++i)
     {
     for(unsigned int j = 0; j<nbTilesY; ++j)
@@ -397,16 +423,37 @@ void GlImageActor::UpdateData()
       newTile.m_RedIdx = m_RedIdx;
       newTile.m_GreenIdx = m_GreenIdx;
       newTile.m_BlueIdx = m_BlueIdx;
+      newTile.m_AllBands = UseAllBandsTiles();
       newTile.m_Resolution = m_CurrentResolution;
       newTile.m_TileSize = m_TileSize;
+      newTile.m_LastUsed = m_UpdateCount;
 
       if(!TileAlreadyLoaded(newTile))
         {
-        LoadTile(newTile);
+        missingTiles.push_back(newTile);
         }
       }
     }
 
+  // Tiles near the centre of the viewport are read first
+  const double centerX = requested.GetIndex()[0] + 0.5 * requested.GetSize()[0];
+  const double centerY = requested.GetIndex()[1] + 0.5 * requested.GetSize()[1];
+
+  std::stable_sort(
+    missingTiles.begin(), missingTiles.end(),
+    [ centerX, centerY ]( const Tile & a, const Tile & b )
+    {
+      const double ax = a.m_ImageRegion.GetIndex()[0] + 0.5 * a.m_ImageRegion.GetSize()[0] - centerX;
+      const double ay = a.m_ImageRegion.GetIndex()[1] + 0.5 * a.m_ImageRegion.GetSize()[1] - centerY;
+      const double bx = b.m_ImageRegion.GetIndex()[0] + 0.5 * b.m_ImageRegion.GetSize()[0] - centerX;
+      const double by = b.m_ImageRegion.GetIndex()[1] + 0.5 * b.m_ImageRegion.GetSize()[1] - centerY;
+      return ax * ax + ay * ay < bx * bx + by * by;
+    } );
+
+  LoadTiles(missingTiles);
+
+  // Then, free the GPU memory of the cached tiles if needed
+  ApplyGPUMemoryBudget();
 }
 
 bool GlImageActor::TileAlreadyLoaded(const Tile& tile)
@@ -417,10 +464,17 @@ bool GlImageActor::TileAlreadyLoaded(const Tile& tile)
     {
     if(it->m_ImageRegion == tile.m_ImageRegion)
       {
-      return (tile.m_Resolution ==  it->m_Resolution
-              && tile.m_RedIdx == it->m_RedIdx
-              && tile.m_GreenIdx == it->m_GreenIdx
-              && tile.m_BlueIdx == it->m_BlueIdx);
+      if(tile.m_Resolution ==  it->m_Resolution
+         && tile.m_AllBands == it->m_AllBands
+         && (tile.m_AllBands
+             || (tile.m_RedIdx == it->m_RedIdx
+                 && tile.m_GreenIdx == it->m_GreenIdx
+                 && tile.m_BlueIdx == it->m_BlueIdx)))
+        {
+        it->m_LastUsed = m_UpdateCount;
+        return true;
+        }
+      return false;
       }
     }
 
@@ -436,6 +490,8 @@ void GlImageActor::Render()
 
   bool isShaderMode = !m_Shader.IsNull();
 
+  StandardShader * standardShader = dynamic_cast< StandardShader * >( m_Shader.GetPointer() );
+
   if( isShaderMode )
   {
     m_Shader->LoadShader();
@@ -452,6 +508,10 @@ void GlImageActor::Render()
     for(TileVectorType::iterator it = m_LoadedTiles.begin();
         it != m_LoadedTiles.end(); ++it)
     {
+      // Cached tiles outside of the viewport are not rendered
+      if(it->m_LastUsed != m_UpdateCount)
+        continue;
+
       if(!it->m_RescaleFilter)
       {
         it->m_RescaleFilter = RescaleFilterType::New();
@@ -545,22 +605,36 @@ void GlImageActor::Render()
   for(TileVectorType::iterator it = m_LoadedTiles.begin();
       it != m_LoadedTiles.end(); ++it)
   {
+    if(it->m_LastUsed != m_UpdateCount)
+      continue;
+
     glEnable(GL_BLEND);
     glBlendFunc(GL_SRC_ALPHA,GL_ONE_MINUS_SRC_ALPHA);
 
+    const GLenum target = isShaderMode ? GL_TEXTURE_2D_ARRAY : GL_TEXTURE_2D;
+
     glEnable( GL_TEXTURE_2D );
-    glBindTexture(GL_TEXTURE_2D,it->m_TextureId);
+    glBindTexture(target,it->m_TextureId);
 
-    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
+    glTexParameteri(target, GL_TEXTURE_MIN_FILTER, GL_LINEAR);
 
     glTexParameteri(
-      GL_TEXTURE_2D,
+      target,
       GL_TEXTURE_MAG_FILTER,
       m_CurrentResolution ? GL_LINEAR : GL_NEAREST
       );
 
     if( isShaderMode )
     {
+      // Layers of the rendered bands
+      if( standardShader )
+      {
+        if( it->m_AllBands )
+          standardShader->SetTextureBands( m_RedIdx - 1, m_GreenIdx - 1, m_BlueIdx - 1 );
+        else
+          standardShader->SetTextureBands( 0, 1, 2 );
+      }
+
       GLfloat vertexPosition[ 8 ] = {
 	-1.0f, -1.0f,
 	1.0f, -1.0f,
@@ -607,11 +681,101 @@ void GlImageActor::Render()
     }
 }
 
-void GlImageActor::LoadTile(Tile& tile)
+ITK_THREAD_RETURN_TYPE
+GlImageActor
+::DecodeTilesThreaderCallback( void * arg )
 {
+  itk::MultiThreader::ThreadInfoStruct * info = static_cast< itk::MultiThreader::ThreadInfoStruct * >( arg );
+  DecodeTilesThreadStruct * str = static_cast< DecodeTilesThreadStruct * >( info->UserData );
+
+  const std::size_t threadId = info->ThreadID;
+  const std::size_t threadCount = info->NumberOfThreads;
+
+  try
+    {
+    for( std::size_t i = threadId; i < str->Tiles->size(); i += threadCount )
+      {
+      str->Actor->DecodeTile(
+        ( *str->Tiles )[ i ],
+        str->Actor->m_LoaderReaders[ threadId ],
+        ( *str->Buffers )[ i ]
+      );
+      }
+    }
+  catch( std::exception const & e )
+    {
+    ( *str->Errors )[ threadId ] = e.what();
+    }
+
+  return ITK_THREAD_RETURN_VALUE;
+}
+
+void GlImageActor::LoadTiles(std::vector< Tile > & tiles)
+{
+  if( tiles.empty() )
+    return;
+
   assert( !m_FileReader.IsNull() );
 
-  tile.Link( m_FileReader->GetOutput() );
+  const unsigned int nbThreads =
+    std::max( 1u, std::min( m_NumberOfLoaderThreads, static_cast< unsigned int >( tiles.size() ) ) );
+
+  // Readers are opened here, not by the loader threads, and kept
+  // until the resolution changes
+  if( m_LoaderReaders.size() < nbThreads )
+    m_LoaderReaders.resize( nbThreads );
+
+  for( unsigned int i = 0; i < nbThreads; ++i )
+    {
+    if( m_LoaderReaders[ i ].IsNull()
+        || m_LoaderReaders[ i ]->GetFileName() != m_FileReader->GetFileName() )
+      {
+      m_LoaderReaders[ i ] = ReaderType::New();
+      m_LoaderReaders[ i ]->SetFileName( m_FileReader->GetFileName() );
+      m_LoaderReaders[ i ]->GetOutput()->UpdateOutputInformation();
+      }
+    }
+
+  std::vector< std::vector< float > > buffers( tiles.size() );
+  std::vector< std::string > errors( nbThreads );
+
+  DecodeTilesThreadStruct str;
+  str.Actor = this;
+  str.Tiles = &tiles;
+  str.Buffers = &buffers;
+  str.Errors = &errors;
+
+  itk::MultiThreader::Pointer threader = itk::MultiThreader::New();
+  threader->SetNumberOfThreads( nbThreads );
+  threader->SetSingleMethod( DecodeTilesThreaderCallback, &str );
+  threader->SingleMethodExecute();
+
+  for( const std::string & error : errors )
+    {
+    if( !error.empty() )
+      {
+      itkExceptionMacro( << "Unable to read tile: " << error );
+      }
+    }
+
+  // Textures are uploaded by the OpenGL thread, in the order of
+  // priority of the tiles
+  for( std::size_t i = 0; i < tiles.size(); ++i )
+    {
+    LoadTile( tiles[ i ], buffers[ i ] );
+
+    // Free the buffer once uploaded
+    std::vector< float >().swap( buffers[ i ] );
+    }
+}
+
+void
+GlImageActor
+::DecodeTile(Tile& tile, ReaderType * reader, std::vector< float > & buffer) const
+{
+  assert( reader );
+
+  tile.Link( reader->GetOutput() );
 
   assert( tile.Image() );
 
@@ -621,43 +785,48 @@ void GlImageActor::LoadTile(Tile& tile)
       tile.Image(),
       tile.Image()->GetLargestPossibleRegion());
 
-    auto buffer =
-      std::make_unique< float[] >(
-      4 * tile.Image()->GetLargestPossibleRegion().GetNumberOfPixels()
-      );
+    const std::size_t nbPixels = tile.Image()->GetLargestPossibleRegion().GetNumberOfPixels();
+    const unsigned int nbBands = tile.Image()->GetNumberOfComponentsPerPixel();
 
-    assert( buffer );
+    // One layer per band
+    buffer.resize( nbBands * nbPixels );
 
-    unsigned int idx = 0;
+    std::size_t idx = 0;
 
-    for(it.GoToBegin();!it.IsAtEnd();++it)
+    for(it.GoToBegin();!it.IsAtEnd();++it, ++idx)
     {
-      buffer[idx] = static_cast<float>(it.Get()[2]);
-      ++idx;
-      buffer[idx] = static_cast<float>(it.Get()[1]);
-      ++idx;
-      buffer[idx] = static_cast<float>(it.Get()[0]);
-      ++idx;
-      buffer[idx] = 255.;
-      ++idx;
+      const VectorImageType::PixelType & pixel = it.Get();
+
+      for( unsigned int band = 0; band < nbBands; ++band )
+        buffer[ band * nbPixels + idx ] = static_cast< float >( pixel[ band ] );
     }
+  }
+}
 
+void GlImageActor::LoadTile(Tile& tile, const std::vector< float > & buffer)
+{
+  assert( tile.Image() );
+
+  if(!m_Shader.IsNull())
+  {
+    assert( !buffer.empty() );
 
-    tile.Acquire();
+    tile.Acquire( true );
 
-    glTexImage2D(
-      GL_TEXTURE_2D, 0, GL_RGB32F,
+    glTexImage3D(
+      GL_TEXTURE_2D_ARRAY, 0, GL_R32F,
       tile.Image()->GetLargestPossibleRegion().GetSize()[ 0 ],
       tile.Image()->GetLargestPossibleRegion().GetSize()[ 1 ],
-      0, GL_BGRA, GL_FLOAT,
-      buffer.get()
+      tile.Image()->GetNumberOfComponentsPerPixel(),
+      0, GL_RED, GL_FLOAT,
+      buffer.data()
       );
 
     tile.m_Loaded = true;
   }
   else
   {
-    tile.Acquire();
+    tile.Acquire( false );
   }
 
   // And push to loaded texture
@@ -675,29 +844,19 @@ void GlImageActor::CleanLoadedTiles()
 {
   TileVectorType newLoadedTiles;
 
-  // Retrieve settings
-  ViewSettings::ConstPointer settings = this->GetSettings();
-
-  double ulx, uly, lrx, lry;
-
-  settings->GetViewportExtent(ulx,uly,lrx,lry);
-
-  RegionType requested;
-
-  ViewportExtentToImageRegion( ulx, uly, lrx, lry, requested );
-
+  // Tiles outside of the viewport are kept in cache (see
+  // ApplyGPUMemoryBudget()), only the ones that cannot be rendered
+  // anymore are unloaded
   for( TileVectorType::iterator it = m_LoadedTiles.begin();
        it!=m_LoadedTiles.end();
        ++it )
     {
-    RegionType tileRegion = it->m_ImageRegion;
-
-    // Test if tileRegion intersects requested region
-    if(!tileRegion.Crop(requested)
-       || it->m_Resolution != m_CurrentResolution
-       || it->m_RedIdx != m_RedIdx
-       || it->m_GreenIdx != m_GreenIdx
-       || it->m_BlueIdx != m_BlueIdx
+    if(it->m_Resolution != m_CurrentResolution
+       || it->m_AllBands != UseAllBandsTiles()
+       || (!it->m_AllBands
+           && (it->m_RedIdx != m_RedIdx
+               || it->m_GreenIdx != m_GreenIdx
+               || it->m_BlueIdx != m_BlueIdx))
        // We need to compare with theoretical tile size as actual tile
        // size might be smaller at images borders
        || it->m_TileSize!=m_TileSize)
@@ -718,6 +877,78 @@ void GlImageActor::CleanLoadedTiles()
   m_LoadedTiles.swap(newLoadedTiles);
 }
 
+std::size_t GlImageActor::GetTileGPUMemory(const Tile& tile) const
+{
+  // GL_R32F texture arrays in shader mode, GL_RGBA8 otherwise
+  const std::size_t pixelSize =
+    m_Shader.IsNull()
+    ? 4
+    : ( tile.m_AllBands ? m_NumberOfComponents : 3 ) * sizeof( float );
+
+  return pixelSize * tile.m_ImageRegion.GetNumberOfPixels();
+}
+
+bool GlImageActor::UseAllBandsTiles() const
+{
+  return !m_Shader.IsNull() && m_NumberOfComponents <= m_MaximumNumberOfTextureBands;
+}
+
+GlImageActor::PixelType
+GlImageActor
+::GetTilePixel(const Tile& tile, const IndexType& index) const
+{
+  const PixelType & pixel = tile.Image()->GetPixel( index );
+
+  if( !tile.m_AllBands )
+    return pixel;
+
+  PixelType rgb( 3 );
+
+  rgb[ 0 ] = pixel[ m_RedIdx - 1 ];
+  rgb[ 1 ] = pixel[ m_GreenIdx - 1 ];
+  rgb[ 2 ] = pixel[ m_BlueIdx - 1 ];
+
+  return rgb;
+}
+
+void GlImageActor::ApplyGPUMemoryBudget()
+{
+  const std::size_t budget = static_cast< std::size_t >( m_GPUMemoryBudget ) * 1024 * 1024;
+
+  std::size_t cached = 0;
+
+  for( TileVectorType::const_iterator it = m_LoadedTiles.begin();
+       it!=m_LoadedTiles.end();
+       ++it )
+    {
+    if( it->m_LastUsed != m_UpdateCount )
+      cached += GetTileGPUMemory( *it );
+    }
+
+  while( cached > budget )
+    {
+    // Least recently used tile outside of the viewport
+    TileVectorType::iterator oldest = m_LoadedTiles.end();
+
+    for( TileVectorType::iterator it = m_LoadedTiles.begin();
+         it!=m_LoadedTiles.end();
+         ++it )
+      {
+      if( it->m_LastUsed != m_UpdateCount
+          && ( oldest == m_LoadedTiles.end() || it->m_LastUsed < oldest->m_LastUsed ) )
+        oldest = it;
+      }
+
+    assert( oldest != m_LoadedTiles.end() );
+
+    cached -= GetTileGPUMemory( *oldest );
+
+    UnloadTile( *oldest );
+
+    m_LoadedTiles.erase( oldest );
+    }
+}
+
 void GlImageActor::ClearLoadedTiles()
 {
   for(TileVectorType::iterator it = m_LoadedTiles.begin();
@@ -948,7 +1179,7 @@ GlImageActor
       idx[ 0 ] = ovrIndex[ 0 ] - it->m_ImageRegion.GetIndex()[ 0 ];
       idx[ 1 ] = ovrIndex[ 1 ] - it->m_ImageRegion.GetIndex()[ 1 ];
 
-      pixel = it->Image()->GetPixel( idx );
+      pixel = GetTilePixel( *it, idx );
 
       return true;
       }
@@ -1240,26 +1471,32 @@ void GlImageActor::AutoColorAdjustment(
     }
   else
     {
-    // Retrieve all tiles
+    // Retrieve the tiles of the viewport
     for(TileVectorType::iterator it = m_LoadedTiles.begin();it!=m_LoadedTiles.end();++it)
       {
-      itk::ImageRegionConstIterator< VectorImageType > imIt(
+      if(it->m_LastUsed != m_UpdateCount)
+        continue;
+
+      itk::ImageRegionConstIteratorWithIndex< VectorImageType > imIt(
         it->Image(),
         it->Image()->GetLargestPossibleRegion()
         );
 
       for(imIt.GoToBegin();!imIt.IsAtEnd();++imIt)
         {
+        // Rendered bands only
+        const PixelType pixel = GetTilePixel( *it, imIt.GetIndex() );
+
         bool nonan = true;
   
-        for(unsigned int i = 0; i < imIt.Get().Size();++i)
+        for(unsigned int i = 0; i < pixel.Size();++i)
           {
-          nonan = nonan && !vnl_math_isnan(imIt.Get()[i]);
+          nonan = nonan && !vnl_math_isnan(pixel[i]);
           }
 
         if(nonan)
           {
-          listSample->PushBack(imIt.Get());
+          listSample->PushBack(pixel);
           }
         }
       }
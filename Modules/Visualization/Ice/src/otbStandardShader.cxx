@@ -72,6 +72,7 @@ StandardShader::StandardShader() :
   m_Loc.chessboard_size = glGetUniformLocation(m_Program, "shader_chessboard_size");
   m_Loc.slider_pos = glGetUniformLocation(m_Program, "shader_slider_pos");
   m_Loc.vertical_slider_flag = glGetUniformLocation(m_Program, "shader_vertical_slider_flag");
+  m_Loc.bands = glGetUniformLocation(m_Program, "shader_bands");
 
   m_AttribIdx.push_back( glGetAttribLocation(m_Program, "position") );
   m_AttribIdx.push_back( glGetAttribLocation(m_Program , "in_coord") );
@@ -112,7 +113,8 @@ std::string StandardShader::GetFragmentSource() const
     }
 
   shader_source +=
-    "uniform sampler2D src;\n"                                          \
+    "uniform sampler2DArray src;\n"                                     \
+    "uniform ivec3 shader_bands;\n"                                     \
     "uniform vec4 shader_a;\n"                                          \
     "uniform vec4 shader_b;\n"                                          \
     "uniform int shader_use_no_data;\n"                                 \
@@ -130,8 +132,14 @@ std::string StandardShader::GetFragmentSource() const
     "uniform int shader_vertical_slider_flag;\n"                        \
     "in vec2 tex_coord;\n"                                              \
     "out vec4 out_color;\n"                                             \
+    "vec4 sample_bands(vec2 coord) {\n"                                 \
+    "return vec4(texture(src, vec3(coord, float(shader_bands[0]))).r,\n" \
+    "            texture(src, vec3(coord, float(shader_bands[1]))).r,\n" \
+    "            texture(src, vec3(coord, float(shader_bands[2]))).r,\n" \
+    "            1.0);\n"                                               \
+    "}\n"                                                               \
     "void main (void) {\n"                                              \
-    "vec4 p = texture(src, tex_coord);\n"                     \
+    "vec4 p = sample_bands(tex_coord);\n"                               \
     "vec4 colors = pow( clamp( ( p+shader_b ) * shader_a, 0.0, 1.0 ), shader_gamma );\n" \
     "out_color = colors;\n"                                          \
     "out_color[3] = clamp(shader_alpha,0.0,1.0);\n"                  \
@@ -311,6 +319,19 @@ std::string StandardShader::GetFragmentSource() const
     "out_color[1] = mapped[1];\n"                                    \
     "out_color[2] = mapped[2];\n"                                    \
     "}\n"                                                               \
+    "}\n"                                                               \
+    "else if(shader_type == 17)\n"                                      \
+    "{\n"                                                               \
+    "float sum = p[0]+p[1];\n"                                          \
+    "float color = sum != 0.0 ? clamp(0.5*((p[0]-p[1])/sum+1.0),0.0,1.0) : 0.5;\n" \
+    "vec3 mapped;\n"                                                    \
+    "mapped[0] = -abs( 3.95 * (color - 0.7460)) + 1.5;\n"              \
+    "mapped[1] = -abs( 3.95 * (color - 0.492)) + 1.5;\n"               \
+    "mapped[2] = -abs( 3.95 * (color - 0.2385)) + 1.5;\n"              \
+    "mapped = clamp(mapped,0.0,1.0);\n"                                 \
+    "out_color[0] = mapped[0];\n"                                    \
+    "out_color[1] = mapped[1];\n"                                    \
+    "out_color[2] = mapped[2];\n"                                    \
     "}\n";
 
   if( m_HasGLSL140 )
@@ -320,13 +341,13 @@ std::string StandardShader::GetFragmentSource() const
       "{\n"                                                               \
       "if(dist < shader_radius)\n"                                        \
       "{\n"                                                               \
-      "vec2 size = vec2(textureSize(src,0));\n"                           \
+      "vec2 size = vec2(textureSize(src,0).xy);\n"                        \
       "vec2 dx = tex_coord;\n"                              \
       "dx[0]+=1.0/size[0];\n"                                             \
       "vec2 dy = tex_coord;\n"                              \
       "dy[1]+=1.0/size[1];\n"                                             \
-      "vec4 pdx = texture2D(src, dx);\n"                                  \
-      "vec4 pdy = texture2D(src, dy);\n"                                  \
+      "vec4 pdx = sample_bands(dx);\n"                                    \
+      "vec4 pdy = sample_bands(dy);\n"                                    \
       "out_color = clamp(pow(5*shader_a*(0.5*abs((pdx-p))+ 0.5*abs((pdy-p))),shader_gamma),0.0,1.0);\n" \
       "out_color[3] = alpha;\n"                                        \
       "}\n"                                                               \
@@ -381,6 +402,12 @@ void StandardShader::SetupShader()
   glUniform1f(m_Loc.chessboard_size,m_ChessboardSize);
   glUniform1f(m_Loc.slider_pos,m_SliderPosition);
   glUniform1i(m_Loc.vertical_slider_flag,m_VerticalSlider);
+  glUniform3i(m_Loc.bands,0,1,2);
+}
+
+void StandardShader::SetTextureBands(int red, int green, int blue)
+{
+  glUniform3i(m_Loc.bands,red,green,blue);
 }
 
 } // End namespace otb
@@ -484,6 +484,9 @@ void IceViewer::DrawHud()
         case SHADER_LUT_LOCAL_COOL:
           oss << "Local Cool LUT" << std::endl;
           break;
+        case SHADER_NORMALIZED_DIFFERENCE:
+          oss << "Normalized difference of red and green" << std::endl;
+          break;
         }
       }
 
@@ -481,6 +481,12 @@ void HistogramModel::template_BuildModel_M(BuildContext*)
 
     lPass1.start();
 
+    // Read the pixels once: both passes then use the buffered
+    // quicklook, instead of reading it (or letting GDAL decimate the
+    // whole image on the fly, when it has no overviews) twice.
+    imageModel->ToImage()->SetRequestedRegionToLargestPossibleRegion();
+    imageModel->ToImage()->Update();
+
     // Define histogram-filter type.
     typedef otb::StreamingHistogramVectorImageFilter<typename TImageModel::SourceImageType> HistogramFilter;
 
@@ -285,9 +285,38 @@ public:
   static QString DatasetPathName(QString& name, const QString& imageFilename);
 
   /**
+   * \brief Load an image-model.
+   *
+   * The quicklook and the histogram of the image are stored into the
+   * image cache (see GetImageCacheDir()) the first time the image is
+   * loaded, and read back from there when loading it again.
    */
   static VectorImageModel* LoadImageModel(const QString& filename, int width, int height, QObject* p = NULL);
 
+  /**
+   * \brief Get the image cache directory of an image.
+   *
+   * The directory is named after the MD5 hash-code of the absolute
+   * pathname, the size and the last modification time of the image
+   * file, so that modifying the image file invalidates it. It is
+   * located in the user cache location, shared by all sessions.
+   *
+   * \param dir Resulting directory (created if needed).
+   * \param imageFilename The image filename.
+   *
+   * \return false if the directory could not be created.
+   */
+  static bool GetImageCacheDir(QDir& dir, const QString& imageFilename);
+
+  /**
+   * \brief Remove the least recently used image cache directories
+   * until the image cache fits in the given size.
+   *
+   * \param maxSize Maximum size of the image cache, in bytes.
+   * \param keep Name of a directory which is never removed.
+   */
+  static void PruneImageCache(qint64 maxSize, const QString& keep = QString());
+
   /**
    */
   static void DeleteDatasetModel(const QString& path, const QString& hash);
@@ -326,6 +355,16 @@ public:
    */
   static const char* DATASET_EXT;
 
+  /**
+   * Name of the image cache directory (in the user cache location)
+   */
+  static const char* DEFAULT_IMAGE_CACHE_DIR_NAME;
+
+  /**
+   * Maximum size of the image cache, in bytes
+   */
+  static const qint64 DEFAULT_IMAGE_CACHE_SIZE;
+
   /*-[ PUBLIC SLOTS SECTION ]-----------------------------------------------**/
 public Q_SLOTS:
   /**
@@ -427,6 +466,12 @@ private:
   Qstring has a constructor QString(const char *str) but I have no idea
   of the perf impact */
 
+  /**
+   * \brief Get the root of the image cache, where the image cache
+   * directories are stored.
+   */
+  static QString ImageCacheRoot();
+
   /**
    */
   virtual void virtual_InitializeCore() = 0;
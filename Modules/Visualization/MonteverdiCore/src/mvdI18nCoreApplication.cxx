@@ -71,10 +71,40 @@ const char* I18nCoreApplication::DEFAULT_CACHE_RESULT_DIR_NAME = "result";
 
 const char* I18nCoreApplication::DATASET_EXT = ".ds";
 
+const char* I18nCoreApplication::DEFAULT_IMAGE_CACHE_DIR_NAME = "images";
+
+const qint64 I18nCoreApplication::DEFAULT_IMAGE_CACHE_SIZE = 512 * 1024 * 1024;
+
 const char* I18nCoreApplication::SETTINGS_KEYS[SETTINGS_KEY_COUNT] = {
     "geoidPath", "geoidPathActive", "overviewsEnabled", "overviewsSize", "resolutionAlgorithm", "resultsDir", "srtmDir", "srtmDirActive", "tileSize",
 };
 
+namespace
+{
+/** Files of an image cache directory. */
+const char* IMAGE_CACHE_QUICKLOOK = "quicklook.tif";
+const char* IMAGE_CACHE_HISTOGRAM = "histogram.txt";
+// Touched each time the cache directory is used (LRU eviction).
+const char* IMAGE_CACHE_LAST_USED = "lastused";
+
+/*****************************************************************************/
+void TouchImageCache(const QDir& dir)
+{
+  QFile file(dir.filePath(IMAGE_CACHE_LAST_USED));
+
+  if (!file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    qWarning() << QString("Failed to update '%1'.").arg(file.fileName());
+}
+
+/*****************************************************************************/
+bool IsImageCacheComplete(const QDir& dir)
+{
+  return QFileInfo(dir.filePath(IMAGE_CACHE_QUICKLOOK)).isFile() && QFileInfo(dir.filePath(IMAGE_CACHE_HISTOGRAM)).isFile() &&
+         QFileInfo(dir.filePath(IMAGE_CACHE_LAST_USED)).isFile();
+}
+
+} // end of anonymous namespace.
+
 /*****************************************************************************/
 /* STATIC IMPLEMENTATION SECTION                                             */
 
@@ -155,10 +185,65 @@ VectorImageModel* I18nCoreApplication::LoadImageModel(const QString& filename, i
 
   VectorImageModel* imageModel = NULL;
 
+  //
+  // Image cache.
+  QDir cacheDir;
+
+  bool isCacheValid = GetImageCacheDir(cacheDir, filename);
+
+  //
+  // Load quicklook and histogram from the image cache, if stored.
+  if (isCacheValid && IsImageCacheComplete(cacheDir))
+  {
+    try
+    {
+      AbstractImageModel::BuildContext context(NULL, NULL);
+
+      context.m_Quicklook = cacheDir.filePath(IMAGE_CACHE_QUICKLOOK);
+      context.m_Histogram = cacheDir.filePath(IMAGE_CACHE_HISTOGRAM);
+
+      imageModel = new VectorImageModel(p);
+
+      imageModel->SetFilename(filename, width, height);
+
+      imageModel->BuildModel(&context);
+
+      TouchImageCache(cacheDir);
+
+      return imageModel;
+    }
+    catch (std::exception& exc)
+    {
+      delete imageModel;
+      imageModel = NULL;
+
+      qWarning() << QString("Failed to load '%1' from image cache: %2").arg(filename).arg(exc.what());
+    }
+  }
+
+  //
+  // Clear incomplete (or corrupted) image cache.
+  if (isCacheValid)
+  {
+    QFileInfoList fileInfos(cacheDir.entryInfoList(QDir::NoDotAndDotDot | QDir::Files));
+
+    for (QFileInfoList::const_iterator it(fileInfos.begin()); it != fileInfos.end(); ++it)
+      if (!cacheDir.remove(it->fileName()))
+        isCacheValid = false;
+  }
+
+  //
+  // Import image, storing quicklook and histogram into image cache.
   try
   {
     AbstractImageModel::BuildContext context(filename);
 
+    if (isCacheValid)
+    {
+      context.m_Quicklook = cacheDir.filePath(IMAGE_CACHE_QUICKLOOK);
+      context.m_Histogram = cacheDir.filePath(IMAGE_CACHE_HISTOGRAM);
+    }
+
     imageModel = new VectorImageModel(p);
 
     imageModel->SetFilename(filename, width, height);
@@ -173,9 +258,114 @@ VectorImageModel* I18nCoreApplication::LoadImageModel(const QString& filename, i
     throw;
   }
 
+  if (isCacheValid)
+  {
+    // Mark image cache as complete.
+    TouchImageCache(cacheDir);
+
+    PruneImageCache(DEFAULT_IMAGE_CACHE_SIZE, cacheDir.dirName());
+  }
+
   return imageModel;
 }
 
+/*****************************************************************************/
+QString I18nCoreApplication::ImageCacheRoot()
+{
+  QString location(QStandardPaths::writableLocation(QStandardPaths::CacheLocation));
+
+  if (location.isEmpty())
+    return QString();
+
+  return QDir(location).filePath(QString(DEFAULT_CACHE_DIR_NAME) + "/" + DEFAULT_IMAGE_CACHE_DIR_NAME);
+}
+
+/*****************************************************************************/
+bool I18nCoreApplication::GetImageCacheDir(QDir& dir, const QString& imageFilename)
+{
+  QString root(ImageCacheRoot());
+
+  if (root.isEmpty() || !QDir().mkpath(root))
+    return false;
+
+  QFileInfo fileInfo(imageFilename);
+
+  // Key of image cache: modifying the image file invalidates it.
+  QString key(QString("%1|%2|%3").arg(fileInfo.absoluteFilePath()).arg(fileInfo.size()).arg(fileInfo.lastModified().toMSecsSinceEpoch()));
+
+  QString hash(QCryptographicHash::hash(key.toUtf8(), QCryptographicHash::Md5).toHex());
+
+  try
+  {
+    MakeDirTree(root, hash, &dir);
+  }
+  catch (SystemError& exc)
+  {
+    qWarning() << QString("Failed to create image cache directory: %1").arg(exc.what());
+
+    return false;
+  }
+
+  return true;
+}
+
+/*****************************************************************************/
+void I18nCoreApplication::PruneImageCache(qint64 maxSize, const QString& keep)
+{
+  QString root(ImageCacheRoot());
+
+  if (root.isEmpty())
+    return;
+
+  QDir rootDir(root);
+
+  typedef QMultiMap<QDateTime, QString> DirMap;
+
+  // Image cache directories, sorted by last use.
+  DirMap dirs;
+
+  qint64 size = 0;
+
+  QFileInfoList dirInfos(rootDir.entryInfoList(QDir::NoDotAndDotDot | QDir::Dirs));
+
+  for (QFileInfoList::const_iterator it(dirInfos.begin()); it != dirInfos.end(); ++it)
+  {
+    QDir dir(it->filePath());
+
+    QFileInfoList fileInfos(dir.entryInfoList(QDir::NoDotAndDotDot | QDir::Files));
+
+    for (QFileInfoList::const_iterator fit(fileInfos.begin()); fit != fileInfos.end(); ++fit)
+      size += fit->size();
+
+    if (it->fileName() != keep)
+      dirs.insert(QFileInfo(dir.filePath(IMAGE_CACHE_LAST_USED)).lastModified(), it->fileName());
+  }
+
+  // Remove least recently used first.
+  for (DirMap::const_iterator it(dirs.begin()); it != dirs.end() && size > maxSize; ++it)
+  {
+    QDir dir(rootDir.filePath(it.value()));
+
+    QFileInfoList fileInfos(dir.entryInfoList(QDir::NoDotAndDotDot | QDir::Files));
+
+    qint64 dirSize = 0;
+
+    for (QFileInfoList::const_iterator fit(fileInfos.begin()); fit != fileInfos.end(); ++fit)
+      dirSize += fit->size();
+
+    try
+    {
+      DeleteDatasetModel(root, it.value());
+
+      size -= dirSize;
+    }
+    catch (SystemError& exc)
+    {
+      qWarning() << QString("Failed to prune image cache: %1").arg(exc.what());
+    }
+  }
+}
+
 /*****************************************************************************/
 void I18nCoreApplication::DeleteDatasetModel(const QString& path, const QString& hash)
 {
@@ -21,8 +21,10 @@
 #ifndef otbWrapperApplication_h
 #define otbWrapperApplication_h
 
+#include <map>
 #include <string>
 #include <set>
+#include <vector>
 #include "otbWrapperTypes.h"
 #include "otbWrapperTags.h"
 #include "otbWrapperParameterGroup.h"
@@ -118,6 +120,9 @@ public:
 
   /** write all of the output to disk
    * if they have an associated filename.
+   * Output images sharing the same largest possible region are written in
+   * a single streamed pass (all of them if multi-writing is enabled), so
+   * that their common upstream pipeline runs once.
    * This is a helper function for wrappers without pipeline support.
    */
   void WriteOutput();
@@ -829,6 +834,18 @@ public:
    * the index of the largest possible region starts at (0,0).*/
   ImageBaseType::RegionType GetImageRequestedRegion(const std::string& key, unsigned int idx = 0);
 
+  /** Compute the streaming splits of the output image parameter 'key' over
+   *  its largest possible region, as the writers would do it for the given
+   *  available RAM (in MB). A null RAM uses the value of the "ram" parameter
+   *  if the application has one, and the configuration otherwise. Returns
+   *  the number of splits. */
+  unsigned int PrepareStreaming(const std::string& key, unsigned int ram = 0);
+
+  /** Get the split 'i' computed by PrepareStreaming() for the output image
+   *  parameter 'key'. As for PropagateRequestedRegion(), the index assumes
+   *  that the largest possible region starts at (0,0). */
+  ImageBaseType::RegionType GetStreamingSplit(const std::string& key, unsigned int i);
+
   /** Returns a copy of the metadata dictionary of the image */
   itk::MetaDataDictionary GetImageMetaData(const std::string& key, unsigned int idx = 0);
 
@@ -953,7 +970,7 @@ protected:
   template <class TImageType>
   void SetParameterOutputImage(std::string const& parameter, TImageType* value);
 
-  /** Enable/Disable multiWriting */
+  /** Enable/Disable multiWriting of all the output images, whatever their regions */
   itkSetMacro(MultiWriting, bool);
 
   /* Enable in-application prevention of modifications to m_UserValue (default behaviour) */
@@ -1019,6 +1036,9 @@ private:
   /** Flag that determine if a multiWriter should be used to write output images */
   bool m_MultiWriting;
 
+  /** Streaming splits computed by PrepareStreaming(), by output image key */
+  std::map<std::string, std::vector<ImageBaseType::RegionType>> m_StreamingSplits;
+
   /**
     * Declare the class
     * - Wrapper::MapProjectionParametersHandler
@@ -64,6 +64,13 @@ public:
   /** Return the application search path */
   static std::string GetApplicationPath();
 
+  /** Set the file caching which library provides each application. An empty
+   *  name disables the cache. Relies on the OTB_APPLICATION_CACHE environment variable */
+  static void SetApplicationCacheFile(std::string filename);
+
+  /** Return the application cache file (empty if the cache is disabled) */
+  static std::string GetApplicationCacheFile();
+
   /** Return the list of available applications */
   static std::vector<std::string> GetAvailableApplications(bool useFactory = true);
 
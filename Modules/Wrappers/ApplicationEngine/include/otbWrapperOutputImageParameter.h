@@ -77,6 +77,11 @@ public:
   itkSetMacro(RAMValue, unsigned int);
   itkGetMacro(RAMValue, unsigned int);
 
+  /** Set/Get the signature of the parameters of the application, given to
+   *  the writer for resumed and incremental writes */
+  itkSetStringMacro(ParametersSignature);
+  itkGetStringMacro(ParametersSignature);
+
   /** Check if multi-writing is enabled (several output images written together)*/
   bool IsMultiWritingEnabled();
 
@@ -158,6 +163,8 @@ private:
 
   unsigned int m_RAMValue;
 
+  std::string m_ParametersSignature;
+
   /** Multi-writer, used in case several OutputImageParameter are written at once */
   otb::MultiImageFileWriter::Pointer m_MultiWriter;
 }; // End class OutputImage Parameter
@@ -0,0 +1,169 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#ifndef otbWrapperRegionServer_h
+#define otbWrapperRegionServer_h
+
+#include "otbWrapperApplication.h"
+#include "otbWrapperInputImageParameter.h"
+#include "otbMultiChannelExtractROI.h"
+
+#include <list>
+#include <map>
+#include <mutex>
+#include <tuple>
+
+namespace otb
+{
+namespace Wrapper
+{
+
+/** \class RegionServer
+ *  \brief Serve the output image of an application as a virtual raster
+ *  computed on demand
+ *
+ * Instead of writing the output image of an application, which may only
+ * be an intermediate result read once, the region server executes the
+ * application pipeline and answers GetRegion() requests by computing
+ * only the requested regions.
+ *
+ * The output image is served at several levels of a pyramid: level L
+ * has a pixel spacing 2^L times larger than the output image, and each
+ * of its pixels is the mean of the 2^L x 2^L pixels it covers. The
+ * regions are computed by tiles of TileSize x TileSize pixels of the
+ * requested level, and the most recently used tiles are kept in a cache
+ * of CacheSizeInMB megabytes, so that overlapping or repeated requests
+ * are answered without running the pipeline again.
+ *
+ * GetRegion() can be called from several threads: the requests are
+ * served one after the other.
+ *
+ * \ingroup OTBApplicationEngine
+ */
+class OTBApplicationEngine_EXPORT RegionServer : public itk::Object
+{
+public:
+  /** Standard class typedef */
+  typedef RegionServer                  Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Defining ::New() static method */
+  itkNewMacro(Self);
+
+  /** RTTI support */
+  itkTypeMacro(RegionServer, itk::Object);
+
+  typedef FloatVectorImageType::RegionType RegionType;
+  typedef FloatVectorImageType::Pointer    ImagePointerType;
+
+  /** Application whose output image is served. It is executed by
+   * Initialize() if needed */
+  itkSetObjectMacro(Application, Application);
+  itkGetObjectMacro(Application, Application);
+
+  /** Key of the output image parameter, "out" by default */
+  itkSetStringMacro(OutputKey);
+  itkGetStringMacro(OutputKey);
+
+  /** Size of the cached tiles, 256 by default */
+  itkSetMacro(TileSize, unsigned int);
+  itkGetConstMacro(TileSize, unsigned int);
+
+  /** Size of the tile cache in megabytes, 256 by default. 0 disables the
+   * cache */
+  itkSetMacro(CacheSizeInMB, unsigned int);
+  itkGetConstMacro(CacheSizeInMB, unsigned int);
+
+  /** Execute the application, without writing its outputs, and connect
+   * the region server to its output image */
+  void Initialize();
+
+  /** Largest region of the given level of the pyramid */
+  RegionType GetLargestPossibleRegion(unsigned int level = 0) const;
+
+  /** Number of bands of the served image */
+  unsigned int GetNumberOfComponentsPerPixel() const;
+
+  /** Compute a region of the given level of the pyramid. The region is
+   * cropped to the largest region of the level. The returned image has
+   * the origin and spacing of the level, and does not belong to any
+   * pipeline */
+  ImagePointerType GetRegion(const RegionType& region, unsigned int level = 0);
+
+  /** Remove all the tiles of the cache */
+  void ClearCache();
+
+  /** Number of tiles computed since the initialization, the others have
+   * been found in the cache */
+  itkGetConstMacro(NumberOfComputedTiles, unsigned long);
+
+protected:
+  RegionServer();
+  ~RegionServer() override = default;
+
+private:
+  RegionServer(const Self&) = delete;
+  void operator=(const Self&) = delete;
+
+  typedef MultiChannelExtractROI<FloatVectorImageType::InternalPixelType, FloatVectorImageType::InternalPixelType> ExtractROIFilterType;
+
+  /** Level, tile column and tile row */
+  typedef std::tuple<unsigned int, long, long> TileKeyType;
+
+  struct CachedTile
+  {
+    ImagePointerType                 Image;
+    std::list<TileKeyType>::iterator Usage;
+  };
+
+  /** Tile of the cache, computed if needed */
+  ImagePointerType GetTile(const TileKeyType& key);
+
+  /** Compute a region of a level, reading the region it covers in the
+   * output image */
+  ImagePointerType ComputeRegion(const RegionType& region, unsigned int level);
+
+  Application::Pointer          m_Application;
+  std::string                   m_OutputKey;
+  unsigned int                  m_TileSize;
+  unsigned int                  m_CacheSizeInMB;
+  unsigned long                 m_NumberOfComputedTiles;
+
+  /** Converts the output image, whatever its pixel type, into a
+   * FloatVectorImageType */
+  InputImageParameter::Pointer  m_Connection;
+  FloatVectorImageType::Pointer m_Image;
+  ExtractROIFilterType::Pointer m_Extractor;
+
+  /** Cached tiles, with the order of their last use, most recent first */
+  std::map<TileKeyType, CachedTile> m_Cache;
+  std::list<TileKeyType>            m_Usage;
+  std::size_t                       m_CacheSize;
+
+  std::mutex m_Mutex;
+};
+
+} // namespace Wrapper
+} // namespace otb
+
+#endif
@@ -41,10 +41,13 @@
 
 #include "otbWrapperAddProcessToWatchEvent.h"
 #include "otbExtendedFilenameToWriterOptions.h"
+#include "otbRAMDrivenAdaptativeStreamingManager.h"
+#include "otbPipelineTracer.h"
 
 #include "otbCast.h"
 #include "otbMacro.h"
 #include "otbWrapperTypes.h"
+#include <algorithm>
 #include <exception>
 #include "itkMacro.h"
 #include <stack>
@@ -884,19 +887,86 @@ void Application::WriteOutput()
     }
   }
   
-  otb::MultiImageFileWriter::Pointer multiWriter;
-  if (m_MultiWriting)
+  // Signature of the input parameters, so that the blocks of incremental
+  // writes are computed again when the parameters change. The RAM only
+  // changes the streaming splits, which are checked by the writer
+  std::ostringstream parametersSignature;
+  for (auto const & key : paramList)
+  {
+    Parameter* param = GetParameterByKey(key);
+    if (param->GetRole() == Role_Input && GetParameterType(key) != ParameterType_Group && GetParameterType(key) != ParameterType_RAM &&
+        IsParameterEnabled(key) && HasValue(key))
     {
-    multiWriter = otb::MultiImageFileWriter::New();
-    multiWriter->SetAutomaticStrippedStreaming(ram);
+      try
+      {
+        parametersSignature << key << "=" << param->ToString() << "\n";
+      }
+      catch (itk::ExceptionObject&)
+      {
+        try
+        {
+          parametersSignature << key << "=";
+          for (auto const & value : param->ToStringList())
+          {
+            parametersSignature << value << " ";
+          }
+          parametersSignature << "\n";
+        }
+        catch (itk::ExceptionObject&)
+        {
+          // Parameters without a string value are not in the signature
+        }
+      }
     }
-  
+  }
+
+  // Output images written in a single streamed pass, so that the shared
+  // upstream pipeline runs once: all of them if the application asks for
+  // multi-writing, otherwise the ones sharing the same largest possible region
+  std::map<std::string, otb::MultiImageFileWriter::Pointer> multiWriters;
+  std::vector<std::pair<ImageBaseType::RegionType, std::vector<std::string>>> outputGroups;
+  for (auto const & key : paramList)
+  {
+    if (GetParameterType(key) == ParameterType_OutputImage && IsParameterEnabled(key) && HasValue(key))
+    {
+      ImageBaseType* image = GetParameterOutputImage(key);
+      if (image == nullptr)
+      {
+        continue;
+      }
+      image->UpdateOutputInformation();
+      ImageBaseType::RegionType largest = m_MultiWriting ? ImageBaseType::RegionType() : image->GetLargestPossibleRegion();
+      auto group = std::find_if(outputGroups.begin(), outputGroups.end(), [&largest](const std::pair<ImageBaseType::RegionType, std::vector<std::string>>& g) {
+        return g.first == largest;
+      });
+      if (group == outputGroups.end())
+      {
+        outputGroups.emplace_back(largest, std::vector<std::string>());
+        group = outputGroups.end() - 1;
+      }
+      group->second.push_back(key);
+    }
+  }
+  for (auto const & group : outputGroups)
+  {
+    if (m_MultiWriting || group.second.size() > 1)
+    {
+      otb::MultiImageFileWriter::Pointer multiWriter = otb::MultiImageFileWriter::New();
+      multiWriter->SetAutomaticStrippedStreaming(ram);
+      for (auto const & key : group.second)
+      {
+        multiWriters[key] = multiWriter;
+      }
+    }
+  }
+
   for (auto const & key : paramList)
   {
     if (GetParameterType(key) == ParameterType_OutputImage && IsParameterEnabled(key) && HasValue(key))
     {
       Parameter*            param       = GetParameterByKey(key);
       OutputImageParameter* outputParam = dynamic_cast<OutputImageParameter*>(param);
+      auto                  multiWriter = multiWriters.find(key);
 
       if (outputParam != nullptr)
       {
@@ -910,7 +980,8 @@ void Application::WriteOutput()
           outputParam->SetRAMValue(ram);
         }
 
-        outputParam->InitializeWriters(multiWriter);
+        outputParam->SetParametersSignature(parametersSignature.str());
+        outputParam->InitializeWriters(multiWriter != multiWriters.end() ? multiWriter->second : otb::MultiImageFileWriter::Pointer());
         std::ostringstream progressId;
         
         if (!outputParam->IsMultiWritingEnabled())
@@ -936,12 +1007,16 @@ void Application::WriteOutput()
     }
   }
   
-  if (multiWriter && multiWriter->GetNumberOfInputs() > 0)
+  std::set<otb::MultiImageFileWriter*> updatedMultiWriters;
+  for (auto const & multiWriter : multiWriters)
   {
-    std::ostringstream progressId;
-    progressId << "Writing " << multiWriter->GetNumberOfInputs() << " output images ...";
-    AddProcess(multiWriter, progressId.str());
-    multiWriter->Update();
+    if (multiWriter.second->GetNumberOfInputs() > 0 && updatedMultiWriters.insert(multiWriter.second.GetPointer()).second)
+    {
+      std::ostringstream progressId;
+      progressId << "Writing " << multiWriter.second->GetNumberOfInputs() << " output images ...";
+      AddProcess(multiWriter.second, progressId.str());
+      multiWriter.second->Update();
+    }
   }
 }
 
@@ -963,6 +1038,19 @@ int Application::ExecuteAndWriteOutput()
   this->AfterExecuteAndWriteOutputs();
   m_Chrono.Stop();
 
+  PipelineTracer& tracer = PipelineTracer::GetInstance();
+  if (tracer.IsEnabled())
+  {
+    if (tracer.WriteTrace())
+    {
+      otbAppLogINFO("Pipeline trace written to " << tracer.GetTraceFile());
+    }
+    else
+    {
+      otbAppLogWARNING("Unable to write the pipeline trace to " << tracer.GetTraceFile());
+    }
+  }
+
   FreeRessources();
   m_Filters.clear();
   return status;
@@ -1590,6 +1678,9 @@ void Application::AddProcess(itk::ProcessObject* object, std::string description
   m_ProgressSource            = object;
   m_ProgressSourceDescription = description;
 
+  // Trace the whole pipeline feeding the process when instrumentation is enabled
+  PipelineTracer::GetInstance().WatchPipeline(object);
+
   AddProcessToWatchEvent event;
   event.SetProcess(object);
   event.SetProcessDescription(description);
@@ -1681,6 +1772,45 @@ ImageBaseType::RegionType Application::GetImageRequestedRegion(const std::string
   return requested;
 }
 
+unsigned int Application::PrepareStreaming(const std::string& key, unsigned int ram)
+{
+  ImageBaseType* image = this->GetParameterOutputImage(key);
+  image->UpdateOutputInformation();
+  if (ram == 0 && this->HasParameter("ram"))
+  {
+    ram = this->GetParameterInt("ram");
+  }
+
+  // Same streaming strategy as the default one of the image writers
+  typedef otb::RAMDrivenAdaptativeStreamingManager<FloatVectorImageType> StreamingManagerType;
+  StreamingManagerType::Pointer streamingManager = StreamingManagerType::New();
+  streamingManager->SetAvailableRAMInMB(ram);
+
+  ImageBaseType::RegionType largest = image->GetLargestPossibleRegion();
+  streamingManager->PrepareStreaming(image, largest);
+
+  std::vector<ImageBaseType::RegionType>& splits = m_StreamingSplits[key];
+  splits.resize(streamingManager->GetNumberOfSplits());
+  for (unsigned int i = 0; i < splits.size(); ++i)
+  {
+    splits[i] = streamingManager->GetSplit(i);
+    splits[i].SetIndex(0, splits[i].GetIndex(0) - largest.GetIndex(0));
+    splits[i].SetIndex(1, splits[i].GetIndex(1) - largest.GetIndex(1));
+  }
+  otbAppLogDEBUG("Output " << key << " streamed in " << splits.size() << " splits");
+  return splits.size();
+}
+
+ImageBaseType::RegionType Application::GetStreamingSplit(const std::string& key, unsigned int i)
+{
+  auto it = m_StreamingSplits.find(key);
+  if (it == m_StreamingSplits.end() || i >= it->second.size())
+  {
+    itkExceptionMacro("No streaming split " << i << " for parameter " << key << ", call PrepareStreaming() first");
+  }
+  return it->second[i];
+}
+
 itk::MetaDataDictionary Application::GetImageMetaData(const std::string& key, unsigned int idx)
 {
   ImageBaseType* image = this->GetParameterImageBase(key, idx);
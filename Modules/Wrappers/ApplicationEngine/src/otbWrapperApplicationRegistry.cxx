@@ -27,7 +27,11 @@
 #include "itkMutexLock.h"
 #include "itkMutexLockHolder.h"
 
+#include <cstdlib>
+#include <fstream>
 #include <iterator>
+#include <map>
+#include <random>
 
 namespace otb
 {
@@ -37,6 +41,9 @@ namespace Wrapper
 // Constant : environment variable for application path
 static const char OTB_APPLICATION_VAR[] = "OTB_APPLICATION_PATH";
 
+// Constant : environment variable for the application registry cache file
+static const char OTB_APPLICATION_CACHE_VAR[] = "OTB_APPLICATION_CACHE";
+
 class ApplicationPrivateRegistry
 {
 public:
@@ -117,6 +124,139 @@ private:
 // static finalizer to close opened libraries
 static ApplicationPrivateRegistry m_ApplicationPrivateRegistryGlobal;
 
+/** Persistent mapping between application names and the libraries providing them.
+ *
+ * The cache file starts with the application path it was built for, followed by
+ * one "name<TAB>modification time<TAB>library path" line per application. It is
+ * discarded when the application path changes, and an entry is only trusted while
+ * its library keeps the recorded modification time. */
+class ApplicationCache
+{
+public:
+  typedef std::pair<long int, std::string> EntryType;
+  typedef std::map<std::string, EntryType> EntryMapType;
+
+  /** Return the library recorded for an application, or an empty string if the
+   * entry is missing or outdated */
+  std::string Find(const std::string& name)
+  {
+    itk::MutexLockHolder<itk::SimpleMutexLock> mutexHolder(m_Mutex);
+    Synchronize();
+    EntryMapType::const_iterator it = m_Entries.find(name);
+    if (it != m_Entries.end() && IsUpToDate(it->second))
+    {
+      return it->second.second;
+    }
+    return std::string();
+  }
+
+  /** Tell if the library at path is known to provide the application */
+  bool Contains(const std::string& name, const std::string& path)
+  {
+    return !path.empty() && Find(name) == path;
+  }
+
+  /** Record the library providing an application */
+  void Insert(const std::string& name, const std::string& path)
+  {
+    itk::MutexLockHolder<itk::SimpleMutexLock> mutexHolder(m_Mutex);
+    Synchronize();
+    if (m_File.empty())
+    {
+      return;
+    }
+    EntryType entry(itksys::SystemTools::ModifiedTime(path), path);
+    if (m_Entries[name] != entry)
+    {
+      m_Entries[name] = entry;
+      m_Modified      = true;
+    }
+  }
+
+  /** Write the cache file if entries were added since it was read */
+  void Save()
+  {
+    itk::MutexLockHolder<itk::SimpleMutexLock> mutexHolder(m_Mutex);
+    if (!m_Modified || m_File.empty())
+    {
+      return;
+    }
+    m_Modified = false;
+
+    // Write to a temporary file first so that concurrent processes never read a partial cache
+    std::ostringstream tmpFile;
+    tmpFile << m_File << "." << std::random_device()() << ".tmp";
+    {
+      std::ofstream ofs(tmpFile.str().c_str());
+      if (!ofs)
+      {
+        otbLogMacro(Warning, << "Unable to write the application cache " << m_File);
+        return;
+      }
+      ofs << m_ApplicationPath << "\n";
+      for (const auto& entry : m_Entries)
+      {
+        ofs << entry.first << "\t" << entry.second.first << "\t" << entry.second.second << "\n";
+      }
+    }
+    if (!itksys::SystemTools::RenameFile(tmpFile.str(), m_File))
+    {
+      itksys::SystemTools::RemoveFile(tmpFile.str());
+      otbLogMacro(Warning, << "Unable to write the application cache " << m_File);
+    }
+  }
+
+private:
+  /** Reload the entries when the cache file or the application path changed */
+  void Synchronize()
+  {
+    std::string file    = ApplicationRegistry::GetApplicationCacheFile();
+    std::string appPath = ApplicationRegistry::GetApplicationPath();
+    if (m_Loaded && file == m_File && appPath == m_ApplicationPath)
+    {
+      return;
+    }
+    m_Loaded          = true;
+    m_Modified        = false;
+    m_File            = file;
+    m_ApplicationPath = appPath;
+    m_Entries.clear();
+
+    std::ifstream ifs(m_File.c_str());
+    std::string   line;
+    if (m_File.empty() || !std::getline(ifs, line) || line != m_ApplicationPath)
+    {
+      return;
+    }
+    while (std::getline(ifs, line))
+    {
+      std::vector<itksys::String> fields = itksys::SystemTools::SplitString(line, '\t', false);
+      if (fields.size() == 3 && !fields[0].empty())
+      {
+        m_Entries[fields[0]] = EntryType(std::atol(fields[1].c_str()), fields[2]);
+      }
+    }
+  }
+
+  static bool IsUpToDate(const EntryType& entry)
+  {
+    return itksys::SystemTools::FileExists(entry.second, true) && itksys::SystemTools::ModifiedTime(entry.second) == entry.first;
+  }
+
+  EntryMapType m_Entries;
+
+  std::string m_File;
+
+  std::string m_ApplicationPath;
+
+  bool m_Loaded = false;
+
+  bool m_Modified = false;
+
+  itk::SimpleMutexLock m_Mutex;
+};
+static ApplicationCache m_ApplicationCacheGlobal;
+
 // Define callbacks to unregister applications in ApplicationPrivateRegistry
 void DeleteAppCallback(itk::Object* obj, const itk::EventObject&, void*)
 {
@@ -183,6 +323,27 @@ std::string ApplicationRegistry::GetApplicationPath()
   return ret;
 }
 
+void ApplicationRegistry::SetApplicationCacheFile(std::string filename)
+{
+  std::ostringstream putEnvCache;
+  putEnvCache << OTB_APPLICATION_CACHE_VAR << "=" << filename;
+
+  // do NOT use putenv() directly, since the string memory must be managed carefully
+  itksys::SystemTools::PutEnv(putEnvCache.str());
+}
+
+std::string ApplicationRegistry::GetApplicationCacheFile()
+{
+  std::string ret;
+  // Can be NULL if the env var is not set
+  const char* currentEnv = itksys::SystemTools::GetEnv(OTB_APPLICATION_CACHE_VAR);
+  if (currentEnv)
+  {
+    ret = std::string(currentEnv);
+  }
+  return ret;
+}
+
 Application::Pointer ApplicationRegistry::CreateApplication(const std::string& name, bool useFactory)
 {
   ApplicationPointer appli;
@@ -219,6 +380,17 @@ Application::Pointer ApplicationRegistry::CreateApplicationFaster(const std::str
 {
   ApplicationPointer appli = nullptr;
 
+  // Try the library recorded in the cache before probing the search path
+  std::string cachedPath = m_ApplicationCacheGlobal.Find(name);
+  if (!cachedPath.empty())
+  {
+    appli = LoadApplicationFromPath(cachedPath, name);
+    if (appli.IsNotNull())
+    {
+      return appli;
+    }
+  }
+
   std::string appExtension = itksys::DynamicLoader::LibExtension();
 #ifdef __APPLE__
   appExtension = ".dylib";
@@ -256,6 +428,8 @@ Application::Pointer ApplicationRegistry::CreateApplicationFaster(const std::str
     appli = LoadApplicationFromPath(possiblePath, name);
     if (appli.IsNotNull())
     {
+      m_ApplicationCacheGlobal.Insert(name, possiblePath);
+      m_ApplicationCacheGlobal.Save();
       break;
     }
   }
@@ -316,15 +490,23 @@ std::vector<std::string> ApplicationRegistry::GetAvailableApplications(bool useF
           fullpath.push_back(sep);
         }
         fullpath.append(sfilename);
+        // Libraries known from the cache are not loaded again
+        if (m_ApplicationCacheGlobal.Contains(name, fullpath))
+        {
+          appSet.insert(name);
+          continue;
+        }
         appli = LoadApplicationFromPath(fullpath, name);
         if (appli.IsNotNull())
         {
           appSet.insert(name);
+          m_ApplicationCacheGlobal.Insert(name, fullpath);
         }
         appli = nullptr;
       }
     }
   }
+  m_ApplicationCacheGlobal.Save();
 
   if (useFactory)
   {
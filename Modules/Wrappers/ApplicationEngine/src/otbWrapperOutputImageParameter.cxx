@@ -250,6 +250,7 @@ void OutputImageParameter::ClampAndWriteVectorImage(TInputImage* in)
   writer->SetFileName(m_FileName);
   writer->SetInput(clamp.out);
   writer->GetStreamingManager()->SetDefaultRAM(m_RAMValue);
+  writer->SetParametersSignature(m_ParametersSignature);
 
   // Change internal state only when everything has been setup
   // without raising exception.
@@ -407,6 +408,7 @@ void OutputImageParameter::SwitchInput(UInt8RGBAImageType* img)
   writer->SetFileName(GetFileName());
   writer->SetInput(img);
   writer->GetStreamingManager()->SetDefaultRAM(m_RAMValue);
+  writer->SetParametersSignature(m_ParametersSignature);
 
   m_Writer = writer;
   if (IsMultiWritingEnabled())
@@ -427,6 +429,7 @@ void OutputImageParameter::SwitchInput(UInt8RGBImageType* img)
   writer->SetFileName(GetFileName());
   writer->SetInput(img);
   writer->GetStreamingManager()->SetDefaultRAM(m_RAMValue);
+  writer->SetParametersSignature(m_ParametersSignature);
 
   m_Writer = writer;
   if (IsMultiWritingEnabled())
@@ -0,0 +1,278 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbWrapperRegionServer.h"
+
+#include "itkImageRegionConstIterator.h"
+#include "itkImageRegionIterator.h"
+
+namespace otb
+{
+namespace Wrapper
+{
+
+RegionServer::RegionServer()
+  : m_OutputKey("out"), m_TileSize(256), m_CacheSizeInMB(256), m_NumberOfComputedTiles(0), m_CacheSize(0)
+{
+}
+
+void RegionServer::Initialize()
+{
+  if (m_Application.IsNull())
+  {
+    itkExceptionMacro(<< "No application to serve");
+  }
+  if (m_TileSize == 0)
+  {
+    itkExceptionMacro(<< "The tile size must be positive");
+  }
+  if (m_Application->GetParameterType(m_OutputKey) != ParameterType_OutputImage)
+  {
+    itkExceptionMacro(<< "Parameter " << m_OutputKey << " of application " << m_Application->GetName() << " is not an output image");
+  }
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_Application->IsExecuteDone() == false)
+  {
+    if (m_Application->Execute() != 0)
+    {
+      itkExceptionMacro(<< "Execution of application " << m_Application->GetName() << " failed");
+    }
+  }
+
+  m_Connection = InputImageParameter::New();
+  m_Connection->SetImage(m_Application->GetParameterOutputImage(m_OutputKey));
+  m_Image = m_Connection->GetFloatVectorImage();
+  m_Image->UpdateOutputInformation();
+
+  m_Extractor = ExtractROIFilterType::New();
+  m_Extractor->SetInput(m_Image);
+
+  m_Cache.clear();
+  m_Usage.clear();
+  m_CacheSize             = 0;
+  m_NumberOfComputedTiles = 0;
+}
+
+RegionServer::RegionType RegionServer::GetLargestPossibleRegion(unsigned int level) const
+{
+  if (m_Image.IsNull())
+  {
+    itkExceptionMacro(<< "The region server is not initialized");
+  }
+  const RegionType largest = m_Image->GetLargestPossibleRegion();
+  const long       factor  = 1L << level;
+
+  RegionType region;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    region.SetIndex(dim, 0);
+    region.SetSize(dim, (largest.GetSize(dim) + factor - 1) / factor);
+  }
+  return region;
+}
+
+unsigned int RegionServer::GetNumberOfComponentsPerPixel() const
+{
+  if (m_Image.IsNull())
+  {
+    itkExceptionMacro(<< "The region server is not initialized");
+  }
+  return m_Image->GetNumberOfComponentsPerPixel();
+}
+
+RegionServer::ImagePointerType RegionServer::GetRegion(const RegionType& requested, unsigned int level)
+{
+  RegionType region = requested;
+  if (!region.Crop(GetLargestPossibleRegion(level)))
+  {
+    itkExceptionMacro(<< "The requested region " << requested << " is outside of level " << level);
+  }
+
+  ImagePointerType output = FloatVectorImageType::New();
+  output->CopyInformation(m_Image);
+  output->SetNumberOfComponentsPerPixel(m_Image->GetNumberOfComponentsPerPixel());
+  const double factor = static_cast<double>(1L << level);
+  FloatVectorImageType::SpacingType spacing = m_Image->GetSignedSpacing();
+  FloatVectorImageType::PointType   origin  = m_Image->GetOrigin();
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    // Center of the first pixel of the level
+    origin[dim] += (0.5 * (factor - 1.) - m_Image->GetLargestPossibleRegion().GetIndex(dim)) * spacing[dim];
+    spacing[dim] *= factor;
+  }
+  output->SetSignedSpacing(spacing);
+  output->SetOrigin(origin);
+  output->SetRegions(region);
+  output->Allocate();
+
+  std::lock_guard<std::mutex> lock(m_Mutex);
+
+  // Copy the part of each tile covering the region
+  const long firstX = region.GetIndex(0) / m_TileSize;
+  const long firstY = region.GetIndex(1) / m_TileSize;
+  const long lastX  = (region.GetIndex(0) + region.GetSize(0) - 1) / m_TileSize;
+  const long lastY  = (region.GetIndex(1) + region.GetSize(1) - 1) / m_TileSize;
+  for (long tileY = firstY; tileY <= lastY; ++tileY)
+  {
+    for (long tileX = firstX; tileX <= lastX; ++tileX)
+    {
+      ImagePointerType tile = GetTile(TileKeyType(level, tileX, tileY));
+
+      RegionType overlap = tile->GetBufferedRegion();
+      overlap.Crop(region);
+      itk::ImageRegionConstIterator<FloatVectorImageType> inIt(tile, overlap);
+      itk::ImageRegionIterator<FloatVectorImageType>      outIt(output, overlap);
+      for (inIt.GoToBegin(), outIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++outIt)
+      {
+        outIt.Set(inIt.Get());
+      }
+    }
+  }
+  return output;
+}
+
+void RegionServer::ClearCache()
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  m_Cache.clear();
+  m_Usage.clear();
+  m_CacheSize = 0;
+}
+
+RegionServer::ImagePointerType RegionServer::GetTile(const TileKeyType& key)
+{
+  auto cached = m_Cache.find(key);
+  if (cached != m_Cache.end())
+  {
+    m_Usage.splice(m_Usage.begin(), m_Usage, cached->second.Usage);
+    return cached->second.Image;
+  }
+
+  RegionType region;
+  region.SetIndex(0, std::get<1>(key) * m_TileSize);
+  region.SetIndex(1, std::get<2>(key) * m_TileSize);
+  region.SetSize(0, m_TileSize);
+  region.SetSize(1, m_TileSize);
+  region.Crop(GetLargestPossibleRegion(std::get<0>(key)));
+
+  ImagePointerType tile = ComputeRegion(region, std::get<0>(key));
+  ++m_NumberOfComputedTiles;
+
+  const std::size_t tileSize = region.GetNumberOfPixels() * tile->GetNumberOfComponentsPerPixel() * sizeof(FloatVectorImageType::InternalPixelType);
+  const std::size_t maxSize  = static_cast<std::size_t>(m_CacheSizeInMB) * 1024 * 1024;
+  if (tileSize <= maxSize)
+  {
+    // Evict the least recently used tiles
+    while (m_CacheSize + tileSize > maxSize && !m_Usage.empty())
+    {
+      auto evicted = m_Cache.find(m_Usage.back());
+      m_CacheSize -= evicted->second.Image->GetBufferedRegion().GetNumberOfPixels() * evicted->second.Image->GetNumberOfComponentsPerPixel() *
+                     sizeof(FloatVectorImageType::InternalPixelType);
+      m_Cache.erase(evicted);
+      m_Usage.pop_back();
+    }
+    m_Usage.push_front(key);
+    m_Cache[key] = CachedTile{tile, m_Usage.begin()};
+    m_CacheSize += tileSize;
+  }
+  return tile;
+}
+
+RegionServer::ImagePointerType RegionServer::ComputeRegion(const RegionType& region, unsigned int level)
+{
+  const long       factor  = 1L << level;
+  const RegionType largest = m_Image->GetLargestPossibleRegion();
+
+  // Region of the output image covered by the region of the level
+  RegionType fullRegion;
+  for (unsigned int dim = 0; dim < 2; ++dim)
+  {
+    fullRegion.SetIndex(dim, largest.GetIndex(dim) + region.GetIndex(dim) * factor);
+    fullRegion.SetSize(dim, region.GetSize(dim) * factor);
+  }
+  fullRegion.Crop(largest);
+
+  m_Extractor->SetExtractionRegion(fullRegion);
+  m_Extractor->UpdateLargestPossibleRegion();
+  ImagePointerType full = m_Extractor->GetOutput();
+  // The extractor gets a new output for the next extractions
+  full->DisconnectPipeline();
+
+  ImagePointerType tile = FloatVectorImageType::New();
+  tile->SetNumberOfComponentsPerPixel(full->GetNumberOfComponentsPerPixel());
+  tile->SetRegions(region);
+  tile->Allocate();
+  if (level == 0)
+  {
+    // Same pixels, with the indices of the level
+    itk::ImageRegionConstIterator<FloatVectorImageType> inIt(full, full->GetBufferedRegion());
+    itk::ImageRegionIterator<FloatVectorImageType>      outIt(tile, region);
+    for (inIt.GoToBegin(), outIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt, ++outIt)
+    {
+      outIt.Set(inIt.Get());
+    }
+    return tile;
+  }
+
+  // Each pixel of the level is the mean of the pixels it covers
+  const unsigned int                   nbComponents = full->GetNumberOfComponentsPerPixel();
+  const FloatVectorImageType::IndexType fullStart   = full->GetBufferedRegion().GetIndex();
+  const FloatVectorImageType::SizeType  fullSize    = full->GetBufferedRegion().GetSize();
+  itk::VariableLengthVector<double>     sum(nbComponents);
+  FloatVectorImageType::PixelType       mean(nbComponents);
+
+  itk::ImageRegionIterator<FloatVectorImageType> outIt(tile, region);
+  for (outIt.GoToBegin(); !outIt.IsAtEnd(); ++outIt)
+  {
+    RegionType covered;
+    for (unsigned int dim = 0; dim < 2; ++dim)
+    {
+      covered.SetIndex(dim, largest.GetIndex(dim) + outIt.GetIndex()[dim] * factor);
+      covered.SetSize(dim, factor);
+    }
+    RegionType fullBuffer;
+    fullBuffer.SetIndex(fullStart);
+    fullBuffer.SetSize(fullSize);
+    covered.Crop(fullBuffer);
+
+    sum.Fill(0.);
+    itk::ImageRegionConstIterator<FloatVectorImageType> inIt(full, covered);
+    for (inIt.GoToBegin(); !inIt.IsAtEnd(); ++inIt)
+    {
+      const FloatVectorImageType::PixelType& pixel = inIt.Get();
+      for (unsigned int comp = 0; comp < nbComponents; ++comp)
+      {
+        sum[comp] += pixel[comp];
+      }
+    }
+    const double count = static_cast<double>(covered.GetNumberOfPixels());
+    for (unsigned int comp = 0; comp < nbComponents; ++comp)
+    {
+      mean[comp] = static_cast<FloatVectorImageType::InternalPixelType>(sum[comp] / count);
+    }
+    outIt.Set(mean);
+  }
+  return tile;
+}
+
+} // namespace Wrapper
+} // namespace otb
@@ -30,6 +30,7 @@ void RegisterTests()
   REGISTER_TEST(otbWrapperStringParameterTest1);
   REGISTER_TEST(otbWrapperChoiceParameterTest1);
   REGISTER_TEST(otbWrapperApplicationRegistry);
+  REGISTER_TEST(otbWrapperApplicationRegistryCache);
   REGISTER_TEST(otbWrapperStringListParameterTest1);
   REGISTER_TEST(otbWrapperDocExampleStructureTest);
   REGISTER_TEST(otbWrapperParameterKey);
@@ -41,4 +42,5 @@ void RegisterTests()
   //~ REGISTER_TEST(otbWrapperOutputImageParameterConversionTest);
   REGISTER_TEST(otbApplicationMemoryConnectTest);
   REGISTER_TEST(otbWrapperImageInterface);
+  REGISTER_TEST(otbWrapperRegionServerTest);
 }
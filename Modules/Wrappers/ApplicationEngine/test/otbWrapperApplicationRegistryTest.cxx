@@ -23,6 +23,8 @@
 #endif
 
 #include "otbWrapperApplicationRegistry.h"
+#include "otbStopwatch.h"
+#include "itksys/SystemTools.hxx"
 
 int otbWrapperApplicationRegistry(int itkNotUsed(argc), char* itkNotUsed(argv)[])
 {
@@ -37,3 +39,53 @@ int otbWrapperApplicationRegistry(int itkNotUsed(argc), char* itkNotUsed(argv)[]
   }
   return EXIT_SUCCESS;
 }
+
+int otbWrapperApplicationRegistryCache(int argc, char* argv[])
+{
+  if (argc < 4)
+  {
+    std::cerr << "Usage : " << argv[0] << " application_path cache_file application_name" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  using otb::Wrapper::ApplicationRegistry;
+  ApplicationRegistry::SetApplicationPath(argv[1]);
+  ApplicationRegistry::SetApplicationCacheFile(argv[2]);
+  itksys::SystemTools::RemoveFile(argv[2]);
+
+  // First listing loads every module and fills the cache
+  otb::Stopwatch           chrono = otb::Stopwatch::StartNew();
+  std::vector<std::string> cold   = ApplicationRegistry::GetAvailableApplications(false);
+  chrono.Stop();
+  std::cout << "Cold listing of " << cold.size() << " applications: " << chrono.GetElapsedMilliseconds() << " ms" << std::endl;
+
+  if (!itksys::SystemTools::FileExists(argv[2], true))
+  {
+    std::cerr << "The application cache " << argv[2] << " was not written" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Second listing is answered from the cache
+  chrono.Restart();
+  std::vector<std::string> warm = ApplicationRegistry::GetAvailableApplications(false);
+  chrono.Stop();
+  std::cout << "Cached listing of " << warm.size() << " applications: " << chrono.GetElapsedMilliseconds() << " ms" << std::endl;
+
+  if (cold != warm)
+  {
+    std::cerr << "Cached listing differs from the module scan" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  chrono.Restart();
+  otb::Wrapper::Application::Pointer app = ApplicationRegistry::CreateApplication(argv[3], false);
+  chrono.Stop();
+  std::cout << "Startup of " << argv[3] << ": " << chrono.GetElapsedMilliseconds() << " ms" << std::endl;
+
+  if (app.IsNull())
+  {
+    std::cerr << "Unable to create application " << argv[3] << " from the cache" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
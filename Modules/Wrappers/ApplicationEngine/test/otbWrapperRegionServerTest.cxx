@@ -0,0 +1,107 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+
+#include "otbWrapperApplicationRegistry.h"
+#include "otbWrapperRegionServer.h"
+
+#include <cmath>
+
+int otbWrapperRegionServerTest(int argc, char* argv[])
+{
+  if (argc < 3)
+  {
+    std::cerr << "Usage: " << argv[0] << " application_path infname" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  otb::Wrapper::ApplicationRegistry::SetApplicationPath(argv[1]);
+
+  otb::Wrapper::Application::Pointer app = otb::Wrapper::ApplicationRegistry::CreateApplication("Smoothing");
+  if (app.IsNull())
+  {
+    std::cerr << "Failed to create application" << std::endl;
+    return EXIT_FAILURE;
+  }
+  app->SetParameterString("in", argv[2]);
+
+  typedef otb::Wrapper::RegionServer RegionServerType;
+  RegionServerType::Pointer          server = RegionServerType::New();
+  server->SetApplication(app);
+  server->SetTileSize(64);
+  server->Initialize();
+
+  RegionServerType::RegionType region;
+  region.SetIndex(0, 30);
+  region.SetIndex(1, 40);
+  region.SetSize(0, 100);
+  region.SetSize(1, 80);
+
+  otb::Wrapper::FloatVectorImageType::Pointer full = server->GetRegion(region);
+  const unsigned long                         nbTiles = server->GetNumberOfComputedTiles();
+  if (full->GetBufferedRegion() != region || nbTiles != 6)
+  {
+    std::cerr << "Wrong region " << full->GetBufferedRegion() << " computed with " << nbTiles << " tiles" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // The same tiles are served from the cache
+  otb::Wrapper::FloatVectorImageType::Pointer again = server->GetRegion(region);
+  if (server->GetNumberOfComputedTiles() != nbTiles)
+  {
+    std::cerr << "The cached tiles have been computed again" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  // Each pixel of level 1 is the mean of 2x2 pixels of level 0
+  RegionServerType::RegionType halfRegion;
+  halfRegion.SetIndex(0, 15);
+  halfRegion.SetIndex(1, 20);
+  halfRegion.SetSize(0, 50);
+  halfRegion.SetSize(1, 40);
+  otb::Wrapper::FloatVectorImageType::Pointer half = server->GetRegion(halfRegion, 1);
+
+  otb::Wrapper::FloatVectorImageType::IndexType halfIndex, fullIndex;
+  halfIndex[0] = 40;
+  halfIndex[1] = 35;
+  fullIndex[0] = 2 * halfIndex[0];
+  fullIndex[1] = 2 * halfIndex[1];
+  for (unsigned int comp = 0; comp < server->GetNumberOfComponentsPerPixel(); ++comp)
+  {
+    double mean = 0.;
+    for (unsigned int dy = 0; dy < 2; ++dy)
+    {
+      for (unsigned int dx = 0; dx < 2; ++dx)
+      {
+        otb::Wrapper::FloatVectorImageType::IndexType index = fullIndex;
+        index[0] += dx;
+        index[1] += dy;
+        mean += 0.25 * full->GetPixel(index)[comp];
+      }
+    }
+    if (std::abs(mean - half->GetPixel(halfIndex)[comp]) > 1e-3 || again->GetPixel(fullIndex)[comp] != full->GetPixel(fullIndex)[comp])
+    {
+      std::cerr << "Wrong value of band " << comp << " at " << halfIndex << " of level 1" << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef otbWrapperCommandLineBatchLauncher_h
+#define otbWrapperCommandLineBatchLauncher_h
+
+#include "otbWrapperApplication.h"
+
+#include <istream>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace otb
+{
+namespace Wrapper
+{
+
+/** \class CommandLineBatchLauncher
+ *  \brief Run a stream of command line application jobs in a single process.
+ *
+ * Each non empty line of the job stream (lines starting with '#' are
+ * ignored) is a command line expression as accepted by CommandLineLauncher,
+ * for instance "Rescale -in image.tif -out out.tif" or
+ * "Rescale -inxml parameters.xml". Quotes can be used to protect spaces.
+ *
+ * Jobs are run by several workers sharing the ITK threads. Application
+ * modules stay loaded for the whole run, and so does the state of process
+ * wide singletons such as the DEM handler, which avoids paying the start up
+ * of a new process for each job.
+ *
+ * \ingroup OTBCommandLine
+ */
+class ITK_ABI_EXPORT CommandLineBatchLauncher : public itk::Object
+{
+public:
+  /** Standard class typedefs. */
+  typedef CommandLineBatchLauncher      Self;
+  typedef itk::Object                   Superclass;
+  typedef itk::SmartPointer<Self>       Pointer;
+  typedef itk::SmartPointer<const Self> ConstPointer;
+
+  /** Defining ::New() static method */
+  itkNewMacro(Self);
+
+  /** RTTI support */
+  itkTypeMacro(CommandLineBatchLauncher, itk::Object);
+
+  /** Number of jobs run concurrently */
+  itkSetMacro(NumberOfJobs, unsigned int);
+  itkGetConstMacro(NumberOfJobs, unsigned int);
+
+  /** Parse the batch expression : job file ("-" for the standard input),
+   * optional module paths and optional "-jobs N". Returns false if the
+   * expression is invalid. */
+  bool Load(const std::vector<std::string>& vexp);
+
+  /** Run the jobs of the file given to Load(). Returns the number of failed jobs. */
+  unsigned int Run();
+
+  /** Run the jobs read from a stream. Returns the number of failed jobs. */
+  unsigned int Run(std::istream& jobs);
+
+  /** Split a job line into a command line expression */
+  static std::vector<std::string> SplitExpression(const std::string& line);
+
+protected:
+  /** Constructor */
+  CommandLineBatchLauncher();
+
+  /** Destructor */
+  ~CommandLineBatchLauncher() override = default;
+
+private:
+  CommandLineBatchLauncher(const CommandLineBatchLauncher&) = delete;
+  void operator=(const CommandLineBatchLauncher&) = delete;
+
+  /** Worker loop : read and run jobs until the stream is exhausted */
+  void RunJobs(std::istream& jobs);
+
+  /** Keep an instance of the application so that its module stays loaded */
+  void KeepApplicationLoaded(const std::string& name);
+
+  std::string m_JobFile;
+
+  unsigned int m_NumberOfJobs;
+
+  unsigned int m_JobCount;
+
+  unsigned int m_FailureCount;
+
+  std::map<std::string, Application::Pointer> m_LoadedApplications;
+
+  std::mutex m_Mutex;
+
+}; // end class
+
+} // end namespace Wrapper
+} // end namespace otb
+
+#endif // otbWrapperCommandLineBatchLauncher_h
@@ -20,6 +20,7 @@
 
 
 #include "otbWrapperCommandLineLauncher.h"
+#include "otbWrapperCommandLineBatchLauncher.h"
 #include "otbConfigurationManager.h"
 #include "otb_tinyxml.h"
 #include <vector>
@@ -45,6 +46,7 @@ std::string CleanWord(const std::string& word)
 void ShowUsage(char* argv[])
 {
   std::cerr << "Usage: " << argv[0] << " module_name [MODULEPATH] [arguments]" << std::endl;
+  std::cerr << "       " << argv[0] << " -batch job_file|- [MODULEPATH] [-jobs N]" << std::endl;
 }
 
 int main(int argc, char* argv[])
@@ -83,6 +85,28 @@ int main(int argc, char* argv[])
 
   otb::ConfigurationManager::InitOpenMPThreads();
 
+  // Batch mode : run each line of the job file as an application expression
+  if (vexp[0] == "-batch")
+  {
+    typedef otb::Wrapper::CommandLineBatchLauncher BatchLauncherType;
+    BatchLauncherType::Pointer                     batchLauncher = BatchLauncherType::New();
+
+    bool batchSuccess = false;
+    if (batchLauncher->Load(std::vector<std::string>(vexp.begin() + 1, vexp.end())))
+    {
+      batchSuccess = batchLauncher->Run() == 0;
+    }
+    else
+    {
+      ShowUsage(argv);
+    }
+
+#ifdef OTB_USE_MPI
+    otb::MPIConfig::Instance()->terminate();
+#endif
+    return batchSuccess ? EXIT_SUCCESS : EXIT_FAILURE;
+  }
+
   typedef otb::Wrapper::CommandLineLauncher LauncherType;
   LauncherType::Pointer                     launcher = LauncherType::New();
 
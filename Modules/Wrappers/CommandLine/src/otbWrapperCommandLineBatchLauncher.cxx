@@ -0,0 +1,239 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperCommandLineBatchLauncher.h"
+#include "otbWrapperCommandLineLauncher.h"
+#include "otbWrapperApplicationRegistry.h"
+#include "itkMultiThreader.h"
+#include "itksys/SystemTools.hxx"
+
+#include <algorithm>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <thread>
+
+namespace otb
+{
+namespace Wrapper
+{
+
+CommandLineBatchLauncher::CommandLineBatchLauncher() : m_JobFile(), m_NumberOfJobs(1), m_JobCount(0), m_FailureCount(0)
+{
+}
+
+bool CommandLineBatchLauncher::Load(const std::vector<std::string>& vexp)
+{
+  if (vexp.empty() || (vexp[0] != "-" && vexp[0][0] == '-'))
+  {
+    std::cerr << "ERROR: Missing job file." << std::endl;
+    return false;
+  }
+
+  m_JobFile = vexp[0];
+  if (m_JobFile != "-" && !itksys::SystemTools::FileExists(m_JobFile, true))
+  {
+    std::cerr << "ERROR: Job file \"" << m_JobFile << "\" does not exist." << std::endl;
+    return false;
+  }
+
+  for (unsigned int i = 1; i < vexp.size(); ++i)
+  {
+    if (vexp[i] == "-jobs")
+    {
+      int nbJobs = (i + 1 < vexp.size()) ? std::atoi(vexp[i + 1].c_str()) : 0;
+      if (nbJobs <= 0)
+      {
+        std::cerr << "ERROR: Invalid value for parameter -jobs. It must be a positive integer." << std::endl;
+        return false;
+      }
+      m_NumberOfJobs = nbJobs;
+      ++i;
+    }
+    else if (vexp[i][0] == '-')
+    {
+      std::cerr << "ERROR: Unknown batch parameter " << vexp[i] << "." << std::endl;
+      return false;
+    }
+    else if (itksys::SystemTools::FileIsDirectory(vexp[i]))
+    {
+      ApplicationRegistry::AddApplicationPath(vexp[i]);
+    }
+    else
+    {
+      std::cerr << "ERROR: Module path \"" << vexp[i] << "\" is invalid or doesn't exist." << std::endl;
+      return false;
+    }
+  }
+  return true;
+}
+
+unsigned int CommandLineBatchLauncher::Run()
+{
+  if (m_JobFile == "-")
+  {
+    return this->Run(std::cin);
+  }
+  std::ifstream jobs(m_JobFile.c_str());
+  return this->Run(jobs);
+}
+
+unsigned int CommandLineBatchLauncher::Run(std::istream& jobs)
+{
+  m_JobCount     = 0;
+  m_FailureCount = 0;
+
+  const unsigned int      nbJobs    = std::max(1u, m_NumberOfJobs);
+  const itk::ThreadIdType nbThreads = itk::MultiThreader::GetGlobalDefaultNumberOfThreads();
+  if (nbJobs > 1)
+  {
+    // Share the ITK threads between the workers
+    itk::MultiThreader::SetGlobalDefaultNumberOfThreads(std::max<itk::ThreadIdType>(1, nbThreads / nbJobs));
+  }
+
+  std::vector<std::thread> workers;
+  for (unsigned int k = 1; k < nbJobs; ++k)
+  {
+    workers.emplace_back(&Self::RunJobs, this, std::ref(jobs));
+  }
+  this->RunJobs(jobs);
+  for (auto& worker : workers)
+  {
+    worker.join();
+  }
+
+  itk::MultiThreader::SetGlobalDefaultNumberOfThreads(nbThreads);
+
+  std::cout << "Batch completed: " << m_JobCount - m_FailureCount << " of " << m_JobCount << " jobs succeeded." << std::endl;
+  return m_FailureCount;
+}
+
+void CommandLineBatchLauncher::RunJobs(std::istream& jobs)
+{
+  while (true)
+  {
+    std::string  line;
+    unsigned int jobId = 0;
+    {
+      // The job stream is shared by the workers
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      while (std::getline(jobs, line))
+      {
+        std::string::size_type start = line.find_first_not_of(" \t\r");
+        if (start != std::string::npos && line[start] != '#')
+        {
+          break;
+        }
+        line.clear();
+      }
+      if (line.empty())
+      {
+        return;
+      }
+      jobId = ++m_JobCount;
+    }
+
+    bool success = false;
+    try
+    {
+      std::vector<std::string> vexp = SplitExpression(line);
+      if (!vexp.empty() && vexp[0][0] != '-')
+      {
+        this->KeepApplicationLoaded(vexp[0]);
+      }
+      CommandLineLauncher::Pointer launcher = CommandLineLauncher::New();
+      success                               = launcher->Load(vexp) && launcher->ExecuteAndWriteOutput();
+    }
+    catch (std::exception& err)
+    {
+      std::cerr << "ERROR: " << err.what() << std::endl;
+    }
+    catch (...)
+    {
+      std::cerr << "ERROR: Caught unknown exception." << std::endl;
+    }
+
+    if (!success)
+    {
+      std::lock_guard<std::mutex> lock(m_Mutex);
+      ++m_FailureCount;
+      std::cerr << "ERROR: Job " << jobId << " failed: " << line << std::endl;
+    }
+  }
+}
+
+void CommandLineBatchLauncher::KeepApplicationLoaded(const std::string& name)
+{
+  std::lock_guard<std::mutex> lock(m_Mutex);
+  if (m_LoadedApplications.count(name) == 0)
+  {
+    // A null pointer is kept as well, the launcher reports unknown applications
+    m_LoadedApplications[name] = ApplicationRegistry::CreateApplication(name);
+  }
+}
+
+std::vector<std::string> CommandLineBatchLauncher::SplitExpression(const std::string& line)
+{
+  std::vector<std::string> vexp;
+  std::string              word;
+  bool                     inWord = false;
+  char                     quote  = '\0';
+  for (char c : line)
+  {
+    if (quote != '\0')
+    {
+      if (c == quote)
+      {
+        quote = '\0';
+      }
+      else
+      {
+        word.push_back(c);
+      }
+    }
+    else if (c == '"' || c == '\'')
+    {
+      quote  = c;
+      inWord = true;
+    }
+    else if (c == ' ' || c == '\t' || c == '\r' || c == '\n')
+    {
+      if (inWord)
+      {
+        vexp.push_back(word);
+        word.clear();
+        inWord = false;
+      }
+    }
+    else
+    {
+      word.push_back(c);
+      inWord = true;
+    }
+  }
+  if (inWord)
+  {
+    vexp.push_back(word);
+  }
+  return vexp;
+}
+
+} // end namespace Wrapper
+} // end namespace otb
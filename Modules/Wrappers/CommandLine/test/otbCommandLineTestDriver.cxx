@@ -23,6 +23,7 @@
 void RegisterTests()
 {
   REGISTER_TEST(otbWrapperCommandLineLauncherTest);
+  REGISTER_TEST(otbWrapperCommandLineBatchLauncherTest);
   REGISTER_TEST(otbWrapperCommandLineParserTest1);
   REGISTER_TEST(otbWrapperCommandLineParserTest2);
   REGISTER_TEST(otbWrapperCommandLineParserTest3);
@@ -0,0 +1,85 @@
+/*
+ * Copyright (C) 2005-2020 Centre National d'Etudes Spatiales (CNES)
+ *
+ * This file is part of Orfeo Toolbox
+ *
+ *     https://www.orfeo-toolbox.org/
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "otbWrapperCommandLineBatchLauncher.h"
+#include "itksys/SystemTools.hxx"
+#include <fstream>
+#include <sstream>
+
+int otbWrapperCommandLineBatchLauncherTest(int argc, char* argv[])
+{
+  if (argc < 5)
+  {
+    std::cerr << "Usage : " << argv[0] << " module_path input_image job_file output_prefix" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  typedef otb::Wrapper::CommandLineBatchLauncher BatchLauncherType;
+
+  std::vector<std::string> words = BatchLauncherType::SplitExpression("Rescale  -in \"my image.tif\"\t-outmin 15");
+  if (words.size() != 5 || words[2] != "my image.tif" || words[4] != "15")
+  {
+    std::cerr << "Wrong split of a job line" << std::endl;
+    return EXIT_FAILURE;
+  }
+
+  const std::string prefix(argv[4]);
+  {
+    std::ofstream jobs(argv[3]);
+    jobs << "# Rescale the same image several times" << std::endl;
+    for (unsigned int i = 0; i < 4; ++i)
+    {
+      jobs << "Rescale -in \"" << argv[2] << "\" -out \"" << prefix << i << ".tif\" -outmin " << 10 * i << " -outmax 200" << std::endl;
+      jobs << std::endl;
+    }
+  }
+
+  BatchLauncherType::Pointer launcher = BatchLauncherType::New();
+  std::vector<std::string>   vexp     = {argv[3], argv[1], "-jobs", "2"};
+  if (!launcher->Load(vexp) || launcher->GetNumberOfJobs() != 2)
+  {
+    std::cerr << "Unable to load the batch expression" << std::endl;
+    return EXIT_FAILURE;
+  }
+  if (launcher->Run() != 0)
+  {
+    return EXIT_FAILURE;
+  }
+
+  for (unsigned int i = 0; i < 4; ++i)
+  {
+    std::ostringstream output;
+    output << prefix << i << ".tif";
+    if (!itksys::SystemTools::FileExists(output.str(), true))
+    {
+      std::cerr << "Missing batch output " << output.str() << std::endl;
+      return EXIT_FAILURE;
+    }
+  }
+
+  // A job with an unknown parameter is reported as failed
+  std::istringstream failingJob("Rescale -inn image");
+  if (launcher->Run(failingJob) != 1)
+  {
+    std::cerr << "The failing job was not reported" << std::endl;
+    return EXIT_FAILURE;
+  }
+  return EXIT_SUCCESS;
+}
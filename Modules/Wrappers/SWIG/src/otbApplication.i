@@ -347,6 +347,8 @@ public:
   otb::ImageKeywordlist GetImageKeywordlist(const std::string & key, unsigned int idx = 0);
   unsigned long PropagateRequestedRegion(const std::string & key, itk::ImageRegion<2> region, unsigned int idx = 0);
   itk::ImageRegion<2> GetImageRequestedRegion(const std::string & key, unsigned int idx = 0);
+  unsigned int PrepareStreaming(const std::string & key, unsigned int ram = 0);
+  itk::ImageRegion<2> GetStreamingSplit(const std::string & key, unsigned int i);
   itkMetaDataDictionary GetImageMetaData(const std::string & key, unsigned int idx = 0);
   otb::Wrapper::ImagePixelType GetImageBasePixelType(const std::string & key, unsigned int idx = 0);
 
@@ -523,6 +525,16 @@ public:
     return oss.str();
     }
 
+  itk::ImageRegion<2> GetImageBufferedRegion_(std::string pkey)
+    {
+    ImageBaseType *img = $self->GetParameterOutputImage(pkey);
+    itk::ImageRegion<2> largest = img->GetLargestPossibleRegion();
+    itk::ImageRegion<2> buffered = img->GetBufferedRegion();
+    buffered.SetIndex(0, buffered.GetIndex(0) - largest.GetIndex(0));
+    buffered.SetIndex(1, buffered.GetIndex(1) - largest.GetIndex(1));
+    return buffered;
+    }
+
   void SetupImageInformation(
     ImageBaseType* img,
     itk::Point<SpacePrecisionType,2> origin,
@@ -817,6 +829,19 @@ class ApplicationProxy(object):
       ImagePixelType_cdouble : SetVectorImageFromCDoubleNumpyArray_,
       }
 
+    def _KeepNumpyBuffer(self, paramKey, index, npArray):
+      """
+      The image imported from a numpy array uses the array memory without
+      copying it: keep a reference to the array as long as it is plugged in
+      the parameter. Arrays whose strides do not match the pixel interleaved
+      layout of otb::VectorImage (slices, transposed views...) are compacted
+      first, which is the only case where the data is copied.
+      """
+      if not npArray.flags['C_CONTIGUOUS']:
+        npArray = npArray.copy(order='C')
+      self.__dict__.setdefault("_numpyBuffers", {})[(paramKey, index)] = npArray
+      return npArray
+
     def SetImageFromNumpyArray(self, paramKey, npArray, index=0):
       """
       This method takes a numpy array and set ImageIOBase of
@@ -832,6 +857,7 @@ class ApplicationProxy(object):
                            "Cannot convert to Image, use SetVectorImageFromNumpyArray instead\n")
       else:
         raise ValueError( "Expected 2 or 3 dimensions for numpyarray\n")
+      npArray = self._KeepNumpyBuffer(paramKey, index, npArray)
       dt = npArray.dtype.name
       isFound = False
       for pixT in self.ImageImporterMap:
@@ -857,6 +883,7 @@ class ApplicationProxy(object):
         npArray = npArray.reshape((shp[0],shp[1],1))
       elif len(npArray.shape) != 3:
         raise ValueError( "Expected 2 or 3 dimensions for numpyarray")
+      npArray = self._KeepNumpyBuffer(paramKey, index, npArray)
       dt = npArray.dtype.name
       isFound = False
       for pixT in self.VectorImageImporterMap:
@@ -870,7 +897,7 @@ class ApplicationProxy(object):
         raise ValueError("Can't convert Numpy array of dtype "+dt)
       return img
 
-    def GetVectorImageAsNumpyArray(self, paramKey, dt='float'):
+    def GetVectorImageAsNumpyArray(self, paramKey, dt='float', region=None):
       """
       This function retrieves an output image parameter as a Numpy array.
       The array datatype is guessed automatically from the underlying
@@ -879,13 +906,26 @@ class ApplicationProxy(object):
       possible output datatypes are:
       int8, int16, int32, uint8, uint16, uint32, float, double, cint16, cint32,
       cfloat, cdouble.
+      The array is a view on the output buffer (no copy): it is valid as long
+      as the application is alive and not executed again. If a region
+      (itkRegion, relative to the largest possible region) is given, only this
+      region is requested and computed, and the view covers it.
       NOTE: This method always return an numpy array with 3 dimensions
       NOTE: cint16 and cint32 are not supported yet
       """
+      if region is not None:
+        self.PropagateRequestedRegion(paramKey, region)
       pixT = self.GetImageBasePixelType(paramKey)
-      return self.NumpyExporterMap[pixT](self,paramKey)
+      array = self.NumpyExporterMap[pixT](self,paramKey)
+      if region is not None:
+        # The buffer may be larger than the requested region
+        buffered = self.GetImageBufferedRegion_(paramKey)
+        x0 = region.GetIndex(0) - buffered.GetIndex(0)
+        y0 = region.GetIndex(1) - buffered.GetIndex(1)
+        array = array[y0:y0 + region.GetSize(1), x0:x0 + region.GetSize(0), :]
+      return array
 
-    def GetImageAsNumpyArray(self, paramKey, dt='float'):
+    def GetImageAsNumpyArray(self, paramKey, dt='float', region=None):
       """
       This function retrieves an output image parameter as a Numpy array.
       The array datatype is guessed automatically from the underlying
@@ -894,11 +934,11 @@ class ApplicationProxy(object):
       possible output datatypes are:
       int8, int16, int32, uint8, uint16, uint32, float, double, cint16, cint32,
       cfloat, cdouble.
+      See GetVectorImageAsNumpyArray for the region parameter.
       NOTE: This method always return an numpy array with 2 dimensions
       NOTE: cint16 and cint32 are not supported yet
       """
-      pixT = self.GetImageBasePixelType(paramKey)
-      array = self.NumpyExporterMap[pixT](self,paramKey)
+      array = self.GetVectorImageAsNumpyArray(paramKey, dt, region)
       if array.shape[2] > 1:
         raise ValueError("array.shape[2] > 1\n"
                          "Output image from application has more than 1 band.\n"
@@ -907,6 +947,19 @@ class ApplicationProxy(object):
       array = array[:,:,0]
       return array
 
+    def IterateVectorImageAsNumpyArrays(self, paramKey, ram=0):
+      """
+      This generator streams an output image parameter: it yields
+      (region, array) pairs, one for each split computed by PrepareStreaming
+      for the available RAM (in MB, 0 to use the "ram" parameter or the
+      configuration). Only the region of the current split is computed, and
+      the array is a view on it (see GetVectorImageAsNumpyArray): it is only
+      valid until the next split is requested, copy it to keep it.
+      """
+      for i in range(self.PrepareStreaming(paramKey, ram)):
+        region = self.GetStreamingSplit(paramKey, i)
+        yield region, self.GetVectorImageAsNumpyArray(paramKey, region=region)
+
     def ImportImage(self, paramKey, pyImg, index = 0):
       """
       Import an image into a parameter, from a Python dict. with the following
@@ -923,13 +976,15 @@ class ApplicationProxy(object):
       img = self.SetVectorImageFromNumpyArray(paramKey, pyImg["array"], index)
       self.SetupImageInformation(img, pyImg["origin"], pyImg["spacing"], pyImg["size"], pyImg["region"], pyImg["metadata"])
 
-    def ExportImage(self, paramKey):
+    def ExportImage(self, paramKey, region=None):
       """
       Export an output image from an otbApplication into a python dictionary with the
       following fields: array, origin, spacing, size, region, metadata
+      If a region is given, only this region is computed and exported (see
+      GetVectorImageAsNumpyArray).
       """
       output = {}
-      output["array"] = self.GetVectorImageAsNumpyArray(paramKey)
+      output["array"] = self.GetVectorImageAsNumpyArray(paramKey, region=region)
       output["origin"] = self.GetImageOrigin(paramKey)
       output["spacing"] = self.GetImageSpacing(paramKey)
       output["size"] = self.GetImageSize(paramKey)
@@ -0,0 +1,50 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) 2005-2019 CS Systemes d'Information (CS SI)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+#  Export a region of an output as a numpy view, and import strided arrays
+#
+
+import numpy as np
+
+def test(otbApplication, argv):
+	Smoothing = otbApplication.Registry.CreateApplication("Smoothing")
+	Smoothing.SetParameterString("in", argv[1])
+	Smoothing.SetParameterString("type", 'mean')
+	Smoothing.Execute()
+
+	# Only the requested region is computed and exposed
+	region = otbApplication.itkRegion()
+	region.GetIndex()[0] = 10
+	region.GetIndex()[1] = 20
+	region.GetSize()[0] = 30
+	region.GetSize()[1] = 15
+	roi = Smoothing.GetVectorImageAsNumpyArray("out", region=region)
+	if roi.shape[0] != 15 or roi.shape[1] != 30:
+		raise RuntimeError("Wrong shape for the exported region: " + str(roi.shape))
+
+	# A strided view is accepted, and keeps the same values
+	strided = roi[:, ::2, :]
+	Extract = otbApplication.Registry.CreateApplication("ExtractROI")
+	Extract.SetVectorImageFromNumpyArray("in", strided)
+	Extract.Execute()
+	out = Extract.GetVectorImageAsNumpyArray("out")
+	if out.shape != strided.shape or not np.array_equal(out, strided):
+		raise RuntimeError("Imported strided array does not match: " + str(out.shape))
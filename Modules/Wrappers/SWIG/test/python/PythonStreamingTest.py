@@ -0,0 +1,44 @@
+# -*- coding: utf-8 -*-
+#
+# Copyright (C) 2005-2019 CS Systemes d'Information (CS SI)
+#
+# This file is part of Orfeo Toolbox
+#
+#     https://www.orfeo-toolbox.org/
+#
+# Licensed under the Apache License, Version 2.0 (the "License");
+# you may not use this file except in compliance with the License.
+# You may obtain a copy of the License at
+#
+#     http://www.apache.org/licenses/LICENSE-2.0
+#
+# Unless required by applicable law or agreed to in writing, software
+# distributed under the License is distributed on an "AS IS" BASIS,
+# WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+# See the License for the specific language governing permissions and
+# limitations under the License.
+#
+
+#  Stream an application output split by split, as numpy arrays
+#
+
+import numpy as np
+
+def test(otbApplication, argv):
+	Smoothing = otbApplication.Registry.CreateApplication("Smoothing")
+	Smoothing.SetParameterString("in", argv[1])
+	Smoothing.SetParameterString("type", 'mean')
+	Smoothing.Execute()
+	full = np.copy(Smoothing.GetVectorImageAsNumpyArray("out"))
+
+	nbPixels = 0
+	for region, array in Smoothing.IterateVectorImageAsNumpyArrays("out", 1):
+		x0 = region.GetIndex(0)
+		y0 = region.GetIndex(1)
+		expected = full[y0:y0 + region.GetSize(1), x0:x0 + region.GetSize(0), :]
+		if not np.array_equal(array, expected):
+			raise RuntimeError("Split " + str(region) + " does not match the whole output")
+		nbPixels += array.shape[0] * array.shape[1]
+
+	if nbPixels != full.shape[0] * full.shape[1]:
+		raise RuntimeError("Splits cover " + str(nbPixels) + " pixels instead of " + str(full.shape[0] * full.shape[1]))